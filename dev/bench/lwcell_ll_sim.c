@@ -0,0 +1,415 @@
+/**
+ * \file            lwcell_ll_sim.c
+ * \brief           Simulated SIMCOM modem low-level driver
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 700
+#endif /* _XOPEN_SOURCE */
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lwcell/lwcell.h"
+#include "lwcell/lwcell_input.h"
+#include "lwcell_ll_sim.h"
+#include "system/lwcell_ll.h"
+
+/**
+ * \brief           Scheduled device output
+ */
+typedef struct sim_item {
+    struct sim_item* next; /*!< Next item in queue */
+    uint32_t delay_us;     /*!< Delay before output starts in units of microseconds */
+    size_t len;            /*!< Number of bytes in data array */
+    uint8_t data[];        /*!< Device output data */
+} sim_item_t;
+
+static pthread_mutex_t sim_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sim_cond = PTHREAD_COND_INITIALIZER;
+static sim_item_t *sim_head, *sim_tail;
+static uint8_t sim_busy, initialized;
+static lwcell_sim_cfg_t sim_cfg = {.chunk_size = 256};
+static size_t sim_tx_bytes;
+
+/* Command parser state, only used from producer thread */
+static char cmd_line[128];
+static size_t cmd_line_len;
+static size_t data_rem;
+static uint32_t data_conn;
+static uint8_t conn_active[LWCELL_CFG_MAX_CONNS];
+static size_t conn_rx_buff[LWCELL_CFG_MAX_CONNS]; /* Bytes waiting in device buffer for `AT+CIPRXGET=2` */
+
+/**
+ * \brief           Sleep for number of microseconds
+ * \param[in]       us: Time to sleep in units of microseconds
+ */
+static void
+prv_sleep_us(uint32_t us) {
+    struct timespec ts = {.tv_sec = us / 1000000, .tv_nsec = (long)(us % 1000000) * 1000};
+    nanosleep(&ts, NULL);
+}
+
+/**
+ * \brief           Device output thread, passes scheduled data to input processing
+ * \param[in]       arg: Thread argument
+ * \return          Always `NULL`
+ */
+static void*
+prv_sim_thread(void* arg) {
+    LWCELL_UNUSED(arg);
+    while (1) {
+        sim_item_t* item;
+
+        pthread_mutex_lock(&sim_mutex);
+        while (sim_head == NULL) {
+            sim_busy = 0;
+            pthread_cond_broadcast(&sim_cond);
+            pthread_cond_wait(&sim_cond, &sim_mutex);
+        }
+        item = sim_head;
+        sim_head = item->next;
+        if (sim_head == NULL) {
+            sim_tail = NULL;
+        }
+        sim_busy = 1;
+        pthread_mutex_unlock(&sim_mutex);
+
+        if (item->delay_us > 0) {
+            prv_sleep_us(item->delay_us);
+        }
+        for (size_t off = 0, len; off < item->len; off += len) {
+            len = LWCELL_MIN(sim_cfg.chunk_size, item->len - off);
+            lwcell_input_process(&item->data[off], len);
+            if (sim_cfg.rate > 0) {
+                prv_sleep_us((uint32_t)(((uint64_t)len * 1000000) / sim_cfg.rate));
+            }
+        }
+        free(item);
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Format and schedule device response
+ * \param[in]       delay_us: Delay before response in units of microseconds
+ * \param[in]       fmt: Format string
+ */
+static void
+prv_reply(uint32_t delay_us, const char* fmt, ...) {
+    char buff[512];
+    va_list va;
+    int len;
+
+    va_start(va, fmt);
+    len = vsnprintf(buff, sizeof(buff), fmt, va);
+    va_end(va);
+    if (len > 0) {
+        lwcell_sim_feed(buff, LWCELL_MIN((size_t)len, sizeof(buff) - 1), delay_us);
+    }
+}
+
+/**
+ * \brief           Process single command line received from host
+ */
+static void
+prv_process_cmd(void) {
+    if (sim_cfg.silent) {
+        return;
+    } else if (!strncmp(cmd_line, "AT+CIPSTATUS", 12)) {
+        char buff[512];
+        size_t len = 0;
+
+        len += snprintf(&buff[len], sizeof(buff) - len, "\r\nOK\r\n\r\nSTATE: IP PROCESSING\r\n\r\n");
+        for (size_t i = 0; i < LWCELL_CFG_MAX_CONNS && len < sizeof(buff); ++i) {
+            if (conn_active[i]) {
+                len += snprintf(&buff[len], sizeof(buff) - len,
+                                "C: %d,0,\"TCP\",\"10.0.0.1\",\"80\",\"CONNECTED\"\r\n", (int)i);
+            } else {
+                len += snprintf(&buff[len], sizeof(buff) - len, "C: %d,,\"\",\"\",\"\",\"INITIAL\"\r\n", (int)i);
+            }
+        }
+        lwcell_sim_feed(buff, LWCELL_MIN(len, sizeof(buff) - 1), 0);
+    } else if (!strncmp(cmd_line, "AT+CIPSTART=", 12)) {
+        uint32_t num = (uint32_t)strtoul(&cmd_line[12], NULL, 10);
+
+        if (num < LWCELL_CFG_MAX_CONNS) {
+            pthread_mutex_lock(&sim_mutex);
+            conn_active[num] = 1;
+            pthread_mutex_unlock(&sim_mutex);
+        }
+        prv_reply(0, "\r\nOK\r\n\r\n%u, CONNECT OK\r\n", (unsigned)num);
+    } else if (!strncmp(cmd_line, "AT+CIPSEND=", 11)) {
+        char* end;
+
+        data_conn = (uint32_t)strtoul(&cmd_line[11], &end, 10);
+        data_rem = (size_t)strtoul(end + 1, NULL, 10);
+        prv_reply(0, "\r\n> ");
+    } else if (!strncmp(cmd_line, "AT+CIPCLOSE=", 12)) {
+        uint32_t num = (uint32_t)strtoul(&cmd_line[12], NULL, 10);
+
+        if (num < LWCELL_CFG_MAX_CONNS) {
+            pthread_mutex_lock(&sim_mutex);
+            conn_active[num] = 0;
+            pthread_mutex_unlock(&sim_mutex);
+        }
+        prv_reply(0, "\r\n%u, CLOSE OK\r\n", (unsigned)num);
+    } else if (!strncmp(cmd_line, "AT+CIPRXGET=2,", 14)) {
+        char head[64];
+        uint8_t* buff;
+        size_t head_len, len, rem;
+        char* end;
+        uint32_t num = (uint32_t)strtoul(&cmd_line[14], &end, 10);
+
+        len = (size_t)strtoul(end + 1, NULL, 10);
+        if (num >= LWCELL_CFG_MAX_CONNS) {
+            prv_reply(0, "\r\nERROR\r\n");
+            return;
+        }
+        pthread_mutex_lock(&sim_mutex);
+        len = LWCELL_MIN(len, conn_rx_buff[num]);
+        conn_rx_buff[num] -= len;
+        rem = conn_rx_buff[num];
+        pthread_mutex_unlock(&sim_mutex);
+
+        head_len = (size_t)snprintf(head, sizeof(head), "\r\n+CIPRXGET: 2,%u,%u,%u\r\n", (unsigned)num,
+                                    (unsigned)len, (unsigned)rem);
+        if ((buff = malloc(head_len + len + 8)) == NULL) {
+            return;
+        }
+        memcpy(buff, head, head_len);
+        memset(&buff[head_len], 'a' + (int)(rem % 26), len);
+        memcpy(&buff[head_len + len], "\r\nOK\r\n", 6);
+        lwcell_sim_feed(buff, head_len + len + 6, 0);
+        free(buff);
+    } else {
+        prv_reply(0, "\r\nOK\r\n");
+    }
+}
+
+/**
+ * \brief           Receive data from host, function called from GSM stack when we have data to send
+ * \param[in]       data: Pointer to data to send
+ * \param[in]       len: Number of bytes to send
+ * \return          Number of bytes sent
+ */
+static size_t
+prv_send_data(const void* data, size_t len) {
+    const uint8_t* d = data;
+
+    if (d == NULL) {
+        return 0;
+    }
+    pthread_mutex_lock(&sim_mutex);
+    sim_tx_bytes += len;
+    pthread_mutex_unlock(&sim_mutex);
+    for (size_t i = 0; i < len; ++i) {
+        if (data_rem > 0) { /* Connection data after "> " prompt */
+            size_t n = LWCELL_MIN(data_rem, len - i);
+
+            data_rem -= n;
+            i += n - 1;
+            if (data_rem == 0 && !sim_cfg.silent) {
+                prv_reply(sim_cfg.send_ok_delay_us, "\r\n%u, SEND OK\r\n", (unsigned)data_conn);
+            }
+        } else if (d[i] == '\n') { /* Commands are terminated with CRLF */
+            cmd_line[cmd_line_len] = '\0';
+            if (cmd_line_len > 0) {
+                prv_process_cmd();
+            }
+            cmd_line_len = 0;
+        } else if (d[i] != '\r' && cmd_line_len < sizeof(cmd_line) - 1) {
+            cmd_line[cmd_line_len++] = (char)d[i];
+        }
+    }
+    return len;
+}
+
+/**
+ * \brief           Set simulator configuration
+ * \param[in]       cfg: New configuration
+ */
+void
+lwcell_sim_set_cfg(const lwcell_sim_cfg_t* cfg) {
+    pthread_mutex_lock(&sim_mutex);
+    sim_cfg = *cfg;
+    if (sim_cfg.chunk_size == 0) {
+        sim_cfg.chunk_size = 1;
+    }
+    pthread_mutex_unlock(&sim_mutex);
+}
+
+/**
+ * \brief           Schedule data to be sent by simulated device
+ * \param[in]       data: Data to send, copied to internal queue
+ * \param[in]       len: Number of bytes to send
+ * \param[in]       delay_us: Delay before output starts in units of microseconds
+ */
+void
+lwcell_sim_feed(const void* data, size_t len, uint32_t delay_us) {
+    sim_item_t* item = malloc(sizeof(*item) + len);
+
+    if (item == NULL) {
+        return;
+    }
+    item->next = NULL;
+    item->delay_us = delay_us;
+    item->len = len;
+    memcpy(item->data, data, len);
+
+    pthread_mutex_lock(&sim_mutex);
+    if (sim_tail != NULL) {
+        sim_tail->next = item;
+    } else {
+        sim_head = item;
+    }
+    sim_tail = item;
+    sim_busy = 1;
+    pthread_cond_broadcast(&sim_cond);
+    pthread_mutex_unlock(&sim_mutex);
+}
+
+/**
+ * \brief           Add data to device receive buffer of connection, read by host with `AT+CIPRXGET=2`
+ *
+ * Device notifies host with `+CIPRXGET: 1` when buffer was empty before
+ *
+ * \param[in]       num: Connection number
+ * \param[in]       len: Number of bytes to add
+ */
+void
+lwcell_sim_rx_push(uint32_t num, size_t len) {
+    uint8_t notify;
+
+    if (num >= LWCELL_CFG_MAX_CONNS || len == 0) {
+        return;
+    }
+    pthread_mutex_lock(&sim_mutex);
+    notify = conn_rx_buff[num] == 0;
+    conn_rx_buff[num] += len;
+    pthread_mutex_unlock(&sim_mutex);
+    if (notify) {
+        prv_reply(0, "\r\n+CIPRXGET: 1,%u\r\n", (unsigned)num);
+    }
+}
+
+/**
+ * \brief           Get number of bytes waiting in device receive buffer of connection
+ * \param[in]       num: Connection number
+ * \return          Number of bytes
+ */
+size_t
+lwcell_sim_rx_pending(uint32_t num) {
+    size_t res = 0;
+
+    if (num < LWCELL_CFG_MAX_CONNS) {
+        pthread_mutex_lock(&sim_mutex);
+        res = conn_rx_buff[num];
+        pthread_mutex_unlock(&sim_mutex);
+    }
+    return res;
+}
+
+/**
+ * \brief           Check if connection was started with `AT+CIPSTART` and not closed yet
+ * \param[in]       num: Connection number
+ * \return          `1` if active, `0` otherwise
+ */
+uint8_t
+lwcell_sim_conn_is_active(uint32_t num) {
+    uint8_t res = 0;
+
+    if (num < LWCELL_CFG_MAX_CONNS) {
+        pthread_mutex_lock(&sim_mutex);
+        res = conn_active[num];
+        pthread_mutex_unlock(&sim_mutex);
+    }
+    return res;
+}
+
+/**
+ * \brief           Wait until all scheduled data were processed by the library
+ */
+void
+lwcell_sim_wait_idle(void) {
+    pthread_mutex_lock(&sim_mutex);
+    while (sim_head != NULL || sim_busy) {
+        pthread_cond_wait(&sim_cond, &sim_mutex);
+    }
+    pthread_mutex_unlock(&sim_mutex);
+}
+
+/**
+ * \brief           Get number of bytes received from host
+ * \return          Number of bytes
+ */
+size_t
+lwcell_sim_get_tx_bytes(void) {
+    size_t res;
+
+    pthread_mutex_lock(&sim_mutex);
+    res = sim_tx_bytes;
+    pthread_mutex_unlock(&sim_mutex);
+    return res;
+}
+
+/**
+ * \brief           Callback function called from initialization process
+ * \param[in,out]   ll: Pointer to \ref lwcell_ll_t structure to fill data for communication functions
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ll_init(lwcell_ll_t* ll) {
+    if (!initialized) {
+        pthread_t thread;
+
+        if (pthread_create(&thread, NULL, prv_sim_thread, NULL) != 0) {
+            return lwcellERR;
+        }
+        pthread_detach(thread);
+    }
+    ll->send_fn = prv_send_data;
+    initialized = 1;
+    return lwcellOK;
+}
+
+/**
+ * \brief           Callback function to de-init low-level communication part
+ * \param[in,out]   ll: Pointer to \ref lwcell_ll_t structure to fill data for communication functions
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ll_deinit(lwcell_ll_t* ll) {
+    LWCELL_UNUSED(ll);
+    return lwcellOK;
+}
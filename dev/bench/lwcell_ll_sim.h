@@ -0,0 +1,66 @@
+/**
+ * \file            lwcell_ll_sim.h
+ * \brief           Simulated SIMCOM modem low-level driver
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_LL_SIM_HDR_H
+#define LWCELL_LL_SIM_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \brief           Simulator configuration
+ */
+typedef struct {
+    size_t chunk_size;         /*!< Maximal number of bytes passed to single input call */
+    uint32_t rate;             /*!< Output rate of device in units of bytes per second, `0` for unlimited */
+    uint32_t send_ok_delay_us; /*!< Delay between received data and `SEND OK` response in units of microseconds */
+    uint8_t silent;            /*!< Set to `1` to ignore commands from host without any response */
+} lwcell_sim_cfg_t;
+
+void lwcell_sim_set_cfg(const lwcell_sim_cfg_t* cfg);
+void lwcell_sim_feed(const void* data, size_t len, uint32_t delay_us);
+void lwcell_sim_rx_push(uint32_t num, size_t len);
+size_t lwcell_sim_rx_pending(uint32_t num);
+uint8_t lwcell_sim_conn_is_active(uint32_t num);
+void lwcell_sim_wait_idle(void);
+size_t lwcell_sim_get_tx_bytes(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_LL_SIM_HDR_H */
@@ -0,0 +1,187 @@
+/**
+ * \file            lwcell_sim_trace.c
+ * \brief           Timeline trace of simulated modem runs in Chrome trace format
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 700
+#endif /* _XOPEN_SOURCE */
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "lwcell/lwcell.h"
+#include "lwcell_sim_trace.h"
+
+/**
+ * \brief           Single recorded trace event
+ */
+typedef struct {
+    uint64_t ts_ns; /*!< Monotonic time in units of nanoseconds */
+    uint32_t val;   /*!< Operation specific value */
+    uint8_t point;  /*!< Member of \ref lwcell_trace_point_t enumeration */
+    uint8_t phase;  /*!< Member of \ref lwcell_trace_phase_t enumeration */
+    uint16_t tid;   /*!< Thread index, starting with `1` */
+} trace_event_t;
+
+/* Event names, indexed by trace point */
+static const char* const trace_names[] = {
+    [LWCELL_TRACE_MSG_ENQUEUE] = "enqueue", [LWCELL_TRACE_MSG] = "msg",         [LWCELL_TRACE_MSG_FN] = "msg_fn",
+    [LWCELL_TRACE_CMD_TX] = "cmd_tx",       [LWCELL_TRACE_INPUT] = "input",     [LWCELL_TRACE_URC] = "urc",
+    [LWCELL_TRACE_DATA_TX] = "data_tx",     [LWCELL_TRACE_EVT] = "evt",         [LWCELL_TRACE_SYNC] = "sync_release",
+    [LWCELL_TRACE_PARSE] = "parse",         [LWCELL_TRACE_SEND_FN] = "send_fn", [LWCELL_TRACE_MEM_ALLOC] = "mem_alloc",
+    [LWCELL_TRACE_MEM_FREE] = "mem_free",
+};
+
+static _Atomic(trace_event_t*) trace_events;
+static size_t trace_max;
+static atomic_size_t trace_cnt;
+static atomic_uint trace_tid_cnt;
+static FILE* trace_file;
+static _Thread_local uint16_t trace_tid;
+
+/**
+ * \brief           Open trace and start recording
+ * \param[in]       path: Path of output file, written by \ref lwcell_sim_trace_close
+ * \param[in]       max_events: Maximal number of recorded events, later events are dropped
+ * \return          `0` on success, `-1` otherwise
+ */
+int
+lwcell_sim_trace_open(const char* path, size_t max_events) {
+    trace_event_t* events;
+
+    if (atomic_load(&trace_events) != NULL || max_events == 0) {
+        return -1;
+    }
+    if ((trace_file = fopen(path, "w")) == NULL) {
+        return -1;
+    }
+    if ((events = calloc(max_events, sizeof(*events))) == NULL) {
+        fclose(trace_file);
+        trace_file = NULL;
+        return -1;
+    }
+    trace_max = max_events;
+    atomic_store(&trace_cnt, 0);
+    atomic_store(&trace_events, events);
+    return 0;
+}
+
+/**
+ * \brief           Record event, called from \ref LWCELL_TRACE_HOOK
+ * \param[in]       point: Member of \ref lwcell_trace_point_t enumeration
+ * \param[in]       phase: Member of \ref lwcell_trace_phase_t enumeration
+ * \param[in]       val: Operation specific value
+ */
+void
+lwcell_sim_trace_record(unsigned point, unsigned phase, uint32_t val) {
+    struct timespec ts;
+    trace_event_t *events = atomic_load(&trace_events), *ev;
+    size_t idx;
+
+    if (events == NULL) {
+        return;
+    }
+    if (trace_tid == 0) {
+        trace_tid = (uint16_t)(atomic_fetch_add(&trace_tid_cnt, 1) + 1);
+    }
+    if ((idx = atomic_fetch_add(&trace_cnt, 1)) >= trace_max) {
+        return; /* Buffer is full, event is only counted */
+    }
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    ev = &events[idx];
+    ev->ts_ns = (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+    ev->val = val;
+    ev->point = (uint8_t)point;
+    ev->phase = (uint8_t)phase;
+    ev->tid = trace_tid;
+}
+
+/**
+ * \brief           Stop recording and write events in Chrome trace JSON format
+ *
+ * Output may be opened with `chrome://tracing` or Perfetto UI
+ *
+ * \return          Number of dropped events, because buffer was full
+ */
+size_t
+lwcell_sim_trace_close(void) {
+    trace_event_t* events = atomic_exchange(&trace_events, NULL); /* Stop recording */
+    size_t cnt, dropped;
+    unsigned tids;
+
+    if (events == NULL) {
+        return 0;
+    }
+    cnt = atomic_load(&trace_cnt);
+    dropped = cnt > trace_max ? cnt - trace_max : 0;
+    cnt -= dropped;
+    tids = atomic_load(&trace_tid_cnt);
+
+    fprintf(trace_file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    for (unsigned tid = 1; tid <= tids; ++tid) {
+        const char* name = "application";
+
+        /* Library threads are recognized by operations they execute */
+        for (size_t i = 0; i < cnt; ++i) {
+            if (events[i].tid == tid && events[i].point == LWCELL_TRACE_MSG) {
+                name = "producer";
+                break;
+            } else if (events[i].tid == tid && events[i].point == LWCELL_TRACE_INPUT) {
+                name = "input";
+                break;
+            }
+        }
+        fprintf(trace_file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,", tid);
+        fprintf(trace_file, "\"args\":{\"name\":\"%s\"}},\n", name);
+    }
+    for (size_t i = 0; i < cnt; ++i) {
+        const trace_event_t* ev = &events[i];
+        uint64_t ts = ev->ts_ns - events[0].ts_ns;
+
+        fprintf(trace_file, "{\"name\":\"%s\",\"ph\":\"%s\",\"ts\":%llu.%03u,\"pid\":1,\"tid\":%u",
+                trace_names[ev->point],
+                ev->phase == LWCELL_TRACE_BEGIN ? "B" : (ev->phase == LWCELL_TRACE_END ? "E" : "i"),
+                (unsigned long long)(ts / 1000), (unsigned)(ts % 1000), (unsigned)ev->tid);
+        if (ev->phase == LWCELL_TRACE_INSTANT) {
+            fprintf(trace_file, ",\"s\":\"t\"");
+        }
+        if (ev->phase != LWCELL_TRACE_END) {
+            fprintf(trace_file, ",\"args\":{\"val\":%u}", (unsigned)ev->val);
+        }
+        fprintf(trace_file, "}%s\n", i + 1 < cnt ? "," : "");
+    }
+    fprintf(trace_file, "]}\n");
+    fclose(trace_file);
+    trace_file = NULL;
+    /* Events are not freed, library threads may still be writing last record */
+    return dropped;
+}
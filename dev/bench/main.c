@@ -0,0 +1,311 @@
+/*
+ * Host benchmark for LwCELL library with simulated SIMCOM modem
+ *
+ * Runs scripted scenarios and prints one result line per scenario:
+ *
+ *  - rx: Throughput of +RECEIVE bursts through input processing
+ *  - rx_manual: Throughput of AT+CIPRXGET=2 reads, when LWCELL_CFG_CONN_MANUAL_RECV is enabled
+ *  - urc: Throughput of unsolicited result code storm
+ *  - tx: Latency of blocking lwcell_conn_send calls
+ *  - mem: Allocator and library counters after all scenarios
+ *
+ * With `-t`, timeline of all scenarios is written in Chrome trace JSON format,
+ * with spans of producer messages, command transmission, input processing, URCs and event callbacks.
+ * Open it with `chrome://tracing` or Perfetto UI.
+ *
+ * Usage: lwcell_bench [-n count] [-s size] [-c chunk] [-r rate] [-d delay_us] [-t trace.json]
+ */
+#define _XOPEN_SOURCE 700
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "lwcell/lwcell.h"
+#include "lwcell/lwcell_mem.h"
+#include "lwcell_ll_sim.h"
+#include "lwcell_sim_trace.h"
+
+static uint8_t mem_region_data[0x40000];
+static const lwcell_mem_region_t mem_regions[] = {
+    {mem_region_data, sizeof(mem_region_data)},
+};
+
+static size_t bench_count = 1000;
+static size_t bench_size = 1024;
+static lwcell_sim_cfg_t sim_cfg = {.chunk_size = 256};
+static const char* trace_path;
+
+static lwcell_conn_p conn;
+static size_t conn_recv_bytes;
+
+/**
+ * \brief           Get monotonic time
+ * \return          Time in units of microseconds
+ */
+static uint64_t
+prv_now_us(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+/**
+ * \brief           Compare function for latency sort
+ */
+static int
+prv_cmp_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+
+    return x < y ? -1 : x > y;
+}
+
+/**
+ * \brief           Connection event callback
+ * \param[in]       evt: Event information
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+static lwcellr_t
+prv_conn_evt(lwcell_evt_t* evt) {
+    if (lwcell_evt_get_type(evt) == LWCELL_EVT_CONN_RECV) {
+        lwcell_pbuf_p pbuf = lwcell_evt_conn_recv_get_buff(evt);
+
+        conn_recv_bytes += lwcell_pbuf_length(pbuf, 1);
+        lwcell_conn_recved(lwcell_evt_conn_recv_get_conn(evt), pbuf);
+    }
+    return lwcellOK;
+}
+
+/**
+ * \brief           Global event callback
+ * \param[in]       evt: Event information
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+static lwcellr_t
+prv_evt(lwcell_evt_t* evt) {
+    LWCELL_UNUSED(evt);
+    return lwcellOK;
+}
+
+/**
+ * \brief           Feed +RECEIVE bursts and measure processing throughput
+ */
+static void
+prv_bench_rx(void) {
+    char head[32];
+    size_t head_len, script_len;
+    uint8_t* script;
+    uint64_t t;
+
+    head_len = (size_t)snprintf(head, sizeof(head), "\r\n+RECEIVE,%d,%d:\r\n", (int)lwcell_conn_getnum(conn),
+                                (int)bench_size);
+    script_len = bench_count * (head_len + bench_size);
+    if ((script = malloc(script_len)) == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < bench_count; ++i) {
+        uint8_t* d = &script[i * (head_len + bench_size)];
+
+        memcpy(d, head, head_len);
+        memset(&d[head_len], 'a' + (int)(i % 26), bench_size);
+    }
+
+    conn_recv_bytes = 0;
+    t = prv_now_us();
+    lwcell_sim_feed(script, script_len, 0);
+    lwcell_sim_wait_idle();
+    t = prv_now_us() - t;
+    free(script);
+
+    printf("rx: bursts=%zu size=%zu time_us=%llu input_bps=%.0f payload_bps=%.0f received=%zu\r\n", bench_count,
+           bench_size, (unsigned long long)t, (double)script_len * 1e6 / (double)(t ? t : 1),
+           (double)conn_recv_bytes * 1e6 / (double)(t ? t : 1), conn_recv_bytes);
+}
+
+#if LWCELL_CFG_CONN_MANUAL_RECV
+
+/**
+ * \brief           Fill device receive buffer and measure throughput of reads driven by receive window
+ */
+static void
+prv_bench_rx_manual(void) {
+    size_t total = bench_count * bench_size;
+    uint64_t t, t_end;
+
+    conn_recv_bytes = 0;
+    t = prv_now_us();
+    lwcell_sim_rx_push(lwcell_conn_getnum(conn), total);
+    t_end = t + 10000000;
+    while (conn_recv_bytes < total && prv_now_us() < t_end) {
+        struct timespec ts = {.tv_nsec = 100000};
+
+        lwcell_sim_wait_idle();
+        nanosleep(&ts, NULL);
+    }
+    t = prv_now_us() - t;
+
+    printf("rx_manual: bytes=%zu time_us=%llu payload_bps=%.0f received=%zu left=%zu\r\n", total,
+           (unsigned long long)t, (double)conn_recv_bytes * 1e6 / (double)(t ? t : 1), conn_recv_bytes,
+           lwcell_sim_rx_pending(lwcell_conn_getnum(conn)));
+}
+
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV */
+
+/**
+ * \brief           Feed storm of unsolicited result codes and measure processing throughput
+ */
+static void
+prv_bench_urc(void) {
+    static const char* const urcs[] = {
+        "+CSQ: 20,0\r\n",
+        "+QIND: \"csq\",20,99\r\n",
+        "+CTZV: 24/10/14,12:00:00,+8\r\n",
+    };
+    lwcell_stats_counters_t c0, c1;
+    size_t script_len = 0, off = 0;
+    char* script;
+    uint64_t t;
+
+    for (size_t i = 0; i < bench_count; ++i) {
+        script_len += strlen(urcs[i % LWCELL_ARRAYSIZE(urcs)]);
+    }
+    if ((script = malloc(script_len)) == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < bench_count; ++i) {
+        const char* u = urcs[i % LWCELL_ARRAYSIZE(urcs)];
+
+        memcpy(&script[off], u, strlen(u));
+        off += strlen(u);
+    }
+
+    lwcell_stats_get_counters(&c0);
+    t = prv_now_us();
+    lwcell_sim_feed(script, script_len, 0);
+    lwcell_sim_wait_idle();
+    t = prv_now_us() - t;
+    lwcell_stats_get_counters(&c1);
+    free(script);
+
+    printf("urc: lines=%u urc_lines=%u time_us=%llu lines_per_s=%.0f input_bps=%.0f\r\n",
+           (unsigned)(c1.lines - c0.lines), (unsigned)(c1.urc_lines - c0.urc_lines), (unsigned long long)t,
+           (double)(c1.lines - c0.lines) * 1e6 / (double)(t ? t : 1), (double)script_len * 1e6 / (double)(t ? t : 1));
+}
+
+/**
+ * \brief           Send data with blocking calls and measure latency of each call
+ */
+static void
+prv_bench_tx(void) {
+    uint64_t *lat, sum = 0;
+    uint8_t* data;
+    size_t ok = 0;
+
+    lat = calloc(bench_count, sizeof(*lat));
+    data = malloc(bench_size);
+    if (lat == NULL || data == NULL) {
+        free(lat);
+        free(data);
+        return;
+    }
+    memset(data, 'x', bench_size);
+
+    for (size_t i = 0; i < bench_count; ++i) {
+        uint64_t t = prv_now_us();
+
+        if (lwcell_conn_send(conn, data, bench_size, NULL, 1) == lwcellOK) {
+            ++ok;
+        }
+        lat[i] = prv_now_us() - t;
+        sum += lat[i];
+    }
+    qsort(lat, bench_count, sizeof(*lat), prv_cmp_u64);
+
+    printf("tx: sends=%zu ok=%zu size=%zu lat_us min=%llu avg=%llu p50=%llu p99=%llu max=%llu\r\n", bench_count, ok,
+           bench_size, (unsigned long long)lat[0], (unsigned long long)(sum / bench_count),
+           (unsigned long long)lat[bench_count / 2], (unsigned long long)lat[(bench_count * 99) / 100],
+           (unsigned long long)lat[bench_count - 1]);
+    free(lat);
+    free(data);
+}
+
+/**
+ * \brief           Print allocator statistics and library counters
+ */
+static void
+prv_bench_mem(void) {
+    lwcell_mem_stats_t m;
+    lwcell_stats_counters_t c;
+
+    lwcell_mem_get_stats(&m);
+    lwcell_stats_get_counters(&c);
+    printf("mem: allocs=%u frees=%u failed=%u min_avail=%zu avail=%zu largest_free=%zu free_blocks=%zu\r\n",
+           (unsigned)m.alloc_count, (unsigned)m.free_count, (unsigned)m.alloc_failed_count, m.min_ever_available_bytes,
+           m.available_bytes, m.largest_free_block, m.free_blocks);
+    printf("counters: rx_bytes=%u tx_bytes=%u lines=%u urc_lines=%u pbuf_failed=%u ipd_dropped=%u mbox_full=%u "
+           "line_overflows=%u\r\n",
+           (unsigned)c.rx_bytes, (unsigned)c.tx_bytes, (unsigned)c.lines, (unsigned)c.urc_lines,
+           (unsigned)c.pbuf_alloc_failed, (unsigned)c.ipd_dropped_bytes, (unsigned)c.mbox_full,
+           (unsigned)c.line_overflows);
+    for (size_t i = LWCELL_STATS_THREAD_PRODUCE; i <= LWCELL_STATS_THREAD_PROCESS; ++i) {
+        lwcell_sys_thread_info_t ti;
+
+        if (lwcell_stats_get_thread((lwcell_stats_thread_t)i, &ti) == lwcellOK && ti.run_time_valid) {
+            printf("thread: %s run_time_us=%llu load=%.2f%%\r\n", i == LWCELL_STATS_THREAD_PRODUCE ? "produce" : "process",
+                   (unsigned long long)ti.run_time,
+                   (double)ti.run_time * 100.0 / (double)(ti.run_time_total ? ti.run_time_total : 1));
+        }
+    }
+}
+
+int
+main(int argc, char** argv) {
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:s:c:r:d:t:")) != -1) {
+        switch (opt) {
+            case 'n': bench_count = (size_t)strtoul(optarg, NULL, 0); break;
+            case 's': bench_size = (size_t)strtoul(optarg, NULL, 0); break;
+            case 'c': sim_cfg.chunk_size = (size_t)strtoul(optarg, NULL, 0); break;
+            case 'r': sim_cfg.rate = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'd': sim_cfg.send_ok_delay_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 't': trace_path = optarg; break;
+            default:
+                printf("Usage: %s [-n count] [-s size] [-c chunk] [-r rate] [-d delay_us] [-t trace.json]\r\n",
+                       argv[0]);
+                return 1;
+        }
+    }
+    if (bench_count == 0 || bench_size == 0 || bench_size > LWCELL_CFG_CONN_MAX_DATA_LEN) {
+        printf("Count must be non-zero and size between 1 and %d bytes\r\n", (int)LWCELL_CFG_CONN_MAX_DATA_LEN);
+        return 1;
+    }
+    lwcell_sim_set_cfg(&sim_cfg);
+    if (trace_path != NULL && lwcell_sim_trace_open(trace_path, 1 << 20) != 0) {
+        printf("Cannot open trace file %s\r\n", trace_path);
+        return 1;
+    }
+
+    lwcell_mem_assignmemory(mem_regions, LWCELL_ARRAYSIZE(mem_regions));
+    if (lwcell_init(prv_evt, 1) != lwcellOK) {
+        printf("Cannot initialize library\r\n");
+        return 1;
+    }
+    if (lwcell_conn_start(&conn, LWCELL_CONN_TYPE_TCP, "10.0.0.1", 80, NULL, prv_conn_evt, 1) != lwcellOK) {
+        printf("Cannot start connection\r\n");
+        return 1;
+    }
+
+    prv_bench_rx();
+#if LWCELL_CFG_CONN_MANUAL_RECV
+    prv_bench_rx_manual();
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV */
+    prv_bench_urc();
+    prv_bench_tx();
+    prv_bench_mem();
+    if (trace_path != NULL) {
+        printf("trace: file=%s dropped=%zu\r\n", trace_path, lwcell_sim_trace_close());
+    }
+    return 0;
+}
@@ -0,0 +1,303 @@
+/*
+ * Host micro-benchmarks of LwCELL core data structures
+ *
+ * Every case runs with fixed parameter values and prints one result line:
+ *
+ *  - buff: Ring buffer write and read throughput, parameter is write size in bytes
+ *  - pbuf_cat: Chain build with lwcell_pbuf_cat, parameter is chain length
+ *  - pbuf_memfind: Search of pattern at the end of chain, parameter is chain length
+ *  - mem: Allocation and free with random sizes and random order, parameter is maximal block size
+ *  - timeout_start, timeout_stop: Timer insert and remove, parameter is number of scheduled timers
+ *
+ * Lines are formatted as `micro: case=<name> param=<value> ops=<count> ns_per_op=<time>`,
+ * followed by case specific `key=value` pairs, to allow comparison between builds with scripts.
+ *
+ * Usage: lwcell_micro [-n ops] [-c case]
+ */
+#define _XOPEN_SOURCE 700
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "lwcell/lwcell.h"
+#include "lwcell/lwcell_buff.h"
+#include "lwcell/lwcell_mem.h"
+#include "lwcell/lwcell_pbuf.h"
+#include "lwcell/lwcell_timeout.h"
+
+#define MEM_SLOTS 256
+
+static uint8_t mem_region_data[0x100000];
+static const lwcell_mem_region_t mem_regions[] = {
+    {mem_region_data, sizeof(mem_region_data)},
+};
+
+static size_t micro_ops = 100000;
+static const char* micro_case;
+static uint32_t rand_state = 0x12345678;
+
+/**
+ * \brief           Get monotonic time
+ * \return          Time in units of nanoseconds
+ */
+static uint64_t
+prv_now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * \brief           Get pseudo random number, same sequence on every run
+ * \return          Random number
+ */
+static uint32_t
+prv_rand(void) {
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 17;
+    rand_state ^= rand_state << 5;
+    return rand_state;
+}
+
+/**
+ * \brief           Check if case is selected with command line
+ * \param[in]       name: Case name
+ * \return          `1` if case shall run, `0` otherwise
+ */
+static uint8_t
+prv_selected(const char* name) {
+    return micro_case == NULL || strncmp(name, micro_case, strlen(micro_case)) == 0;
+}
+
+/**
+ * \brief           Print common part of result line
+ * \param[in]       name: Case name
+ * \param[in]       param: Case parameter value
+ * \param[in]       ops: Number of measured operations
+ * \param[in]       t: Total time in units of nanoseconds
+ */
+static void
+prv_report(const char* name, size_t param, size_t ops, uint64_t t) {
+    printf("micro: case=%s param=%zu ops=%zu ns_per_op=%.1f", name, param, ops, (double)t / (double)(ops ? ops : 1));
+}
+
+/**
+ * \brief           Global event callback
+ * \param[in]       evt: Event information
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+static lwcellr_t
+prv_evt(lwcell_evt_t* evt) {
+    LWCELL_UNUSED(evt);
+    return lwcellOK;
+}
+
+/**
+ * \brief           Timeout callback, never called as timers are stopped before expiration
+ */
+static void
+prv_timeout_fn(void* arg) {
+    LWCELL_UNUSED(arg);
+}
+
+/**
+ * \brief           Ring buffer throughput by write size
+ */
+static void
+prv_micro_buff(size_t size) {
+    lwcell_buff_t buff;
+    uint8_t data[1024];
+    size_t ops, bytes = 0;
+    uint64_t t;
+
+    if (!lwcell_buff_init(&buff, 4096)) {
+        return;
+    }
+    memset(data, 'a', sizeof(data));
+    ops = micro_ops;
+    t = prv_now_ns();
+    for (size_t i = 0; i < ops; ++i) {
+        bytes += lwcell_buff_write(&buff, data, size);
+        lwcell_buff_read(&buff, data, size);
+    }
+    t = prv_now_ns() - t;
+    lwcell_buff_free(&buff);
+
+    prv_report("buff", size, ops, t);
+    printf(" bytes=%zu mb_per_s=%.1f\r\n", bytes, (double)bytes * 1000.0 / (double)(t ? t : 1));
+}
+
+/**
+ * \brief           Packet buffer chain build and search by chain length
+ */
+static void
+prv_micro_pbuf(size_t len) {
+    static const char needle[] = "\r\nOK\r\n";
+    size_t rounds, found = 0;
+    uint64_t t_cat = 0, t_find = 0, t;
+
+    rounds = micro_ops / len;
+    if (rounds == 0) {
+        rounds = 1;
+    }
+    for (size_t r = 0; r < rounds; ++r) {
+        lwcell_pbuf_p head, p;
+
+        if ((head = lwcell_pbuf_new(64)) == NULL) {
+            return;
+        }
+        memset(lwcell_pbuf_data(head), 'a', 64);
+        t = prv_now_ns();
+        for (size_t i = 1; i < len; ++i) {
+            if ((p = lwcell_pbuf_new(64)) == NULL) {
+                break;
+            }
+            memset(lwcell_pbuf_data(p), 'a', 64);
+            lwcell_pbuf_cat(head, p);
+        }
+        t_cat += prv_now_ns() - t;
+
+        lwcell_pbuf_take(head, needle, sizeof(needle) - 1, lwcell_pbuf_length(head, 1) - (sizeof(needle) - 1));
+        t = prv_now_ns();
+        found += lwcell_pbuf_memfind(head, needle, sizeof(needle) - 1, 0) != LWCELL_SIZET_MAX;
+        t_find += prv_now_ns() - t;
+        lwcell_pbuf_free(head);
+    }
+
+    prv_report("pbuf_cat", len, rounds * len, t_cat);
+    printf("\r\n");
+    prv_report("pbuf_memfind", len, rounds, t_find);
+    printf(" found=%zu bytes=%zu\r\n", found, len * 64);
+}
+
+/**
+ * \brief           Allocator under fragmenting workload by maximal block size
+ */
+static void
+prv_micro_mem(size_t size) {
+    void* slots[MEM_SLOTS] = {0};
+    lwcell_mem_stats_t before, after;
+    size_t ops;
+    uint64_t t;
+
+    lwcell_mem_get_stats(&before);
+    ops = micro_ops;
+    t = prv_now_ns();
+    for (size_t i = 0; i < ops; ++i) {
+        void** s = &slots[prv_rand() % MEM_SLOTS];
+
+        if (*s != NULL) {
+            lwcell_mem_free_s(s);
+        } else {
+            *s = lwcell_mem_malloc(1 + prv_rand() % size);
+        }
+    }
+    t = prv_now_ns() - t;
+    lwcell_mem_get_stats(&after);
+    for (size_t i = 0; i < MEM_SLOTS; ++i) {
+        lwcell_mem_free_s(&slots[i]);
+    }
+
+    prv_report("mem", size, ops, t);
+    printf(" failed=%u free_blocks=%zu largest_free=%zu avail=%zu\r\n",
+           (unsigned)(after.alloc_failed_count - before.alloc_failed_count), after.free_blocks,
+           after.largest_free_block, after.available_bytes);
+}
+
+/**
+ * \brief           Timer insert and remove by number of scheduled timers
+ */
+static void
+prv_micro_timeout(size_t cnt) {
+    lwcell_timeout_t* tos;
+    size_t* order;
+    size_t rounds, failed = 0;
+    uint64_t t_start = 0, t_stop = 0, t;
+
+    tos = calloc(cnt, sizeof(*tos));
+    order = calloc(cnt, sizeof(*order));
+    if (tos == NULL || order == NULL) {
+        free(tos);
+        free(order);
+        return;
+    }
+    rounds = micro_ops / cnt;
+    if (rounds == 0) {
+        rounds = 1;
+    }
+    for (size_t r = 0; r < rounds; ++r) {
+        /* Random removal order */
+        for (size_t i = 0; i < cnt; ++i) {
+            order[i] = i;
+        }
+        for (size_t i = cnt - 1; i > 0; --i) {
+            size_t j = prv_rand() % (i + 1), x = order[i];
+
+            order[i] = order[j];
+            order[j] = x;
+        }
+
+        /* Expiration far in the future, timers never fire */
+        t = prv_now_ns();
+        for (size_t i = 0; i < cnt; ++i) {
+            failed += lwcell_timeout_start(&tos[i], 3600000 + prv_rand() % 3600000, prv_timeout_fn, NULL) != lwcellOK;
+        }
+        t_start += prv_now_ns() - t;
+        t = prv_now_ns();
+        for (size_t i = 0; i < cnt; ++i) {
+            lwcell_timeout_stop(&tos[order[i]]);
+        }
+        t_stop += prv_now_ns() - t;
+    }
+    free(tos);
+    free(order);
+
+    prv_report("timeout_start", cnt, rounds * cnt, t_start);
+    printf(" failed=%zu\r\n", failed);
+    prv_report("timeout_stop", cnt, rounds * cnt, t_stop);
+    printf("\r\n");
+}
+
+int
+main(int argc, char** argv) {
+    static const size_t buff_sizes[] = {1, 16, 64, 256, 1024};
+    static const size_t pbuf_lens[] = {1, 4, 16, 64};
+    static const size_t mem_sizes[] = {64, 512, 2048};
+    static const size_t timeout_cnts[] = {16, 128, 1024};
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:c:")) != -1) {
+        switch (opt) {
+            case 'n': micro_ops = (size_t)strtoul(optarg, NULL, 0); break;
+            case 'c': micro_case = optarg; break;
+            default: printf("Usage: %s [-n ops] [-c case]\r\n", argv[0]); return 1;
+        }
+    }
+    if (micro_ops == 0) {
+        printf("Number of operations must be non-zero\r\n");
+        return 1;
+    }
+
+    /* Library is initialized for core lock and allocator, simulated modem stays silent */
+    lwcell_mem_assignmemory(mem_regions, LWCELL_ARRAYSIZE(mem_regions));
+    if (lwcell_init(prv_evt, 1) != lwcellOK) {
+        printf("Cannot initialize library\r\n");
+        return 1;
+    }
+
+    for (size_t i = 0; prv_selected("buff") && i < LWCELL_ARRAYSIZE(buff_sizes); ++i) {
+        prv_micro_buff(buff_sizes[i]);
+    }
+    for (size_t i = 0; prv_selected("pbuf") && i < LWCELL_ARRAYSIZE(pbuf_lens); ++i) {
+        prv_micro_pbuf(pbuf_lens[i]);
+    }
+    for (size_t i = 0; prv_selected("mem") && i < LWCELL_ARRAYSIZE(mem_sizes); ++i) {
+        prv_micro_mem(mem_sizes[i]);
+    }
+    for (size_t i = 0; prv_selected("timeout") && i < LWCELL_ARRAYSIZE(timeout_cnts); ++i) {
+        prv_micro_timeout(timeout_cnts[i]);
+    }
+    return 0;
+}
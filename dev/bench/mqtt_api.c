@@ -0,0 +1,179 @@
+/*
+ * MQTT client API test with simulated SIMCOM modem
+ *
+ * Connects blocking MQTT client API to simulated broker and checks publish packets received by application:
+ *
+ *  - single: Packet fits to RX buffer of MQTT client
+ *  - stream: Packet is larger than RX buffer and is received in multiple parts,
+ *      when LWCELL_CFG_MQTT_RECV_STREAM is enabled
+ *
+ * Exit code is `0` when all checks pass.
+ *
+ * Usage: lwcell_mqtt_api
+ */
+#define _XOPEN_SOURCE 700
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "lwcell/apps/lwcell_mqtt_client_api.h"
+#include "lwcell/lwcell.h"
+#include "lwcell_ll_sim.h"
+
+#define MQTT_RX_BUFF_LEN 64
+#define MQTT_SEGMENT_LEN 100
+#define MQTT_TOPIC       "lwcell/test"
+
+static uint8_t mem_region_data[0x40000];
+static const lwcell_mem_region_t mem_regions[] = {
+    {mem_region_data, sizeof(mem_region_data)},
+};
+
+static uint8_t payload[600];
+static size_t failures;
+static uint32_t conn_num;
+
+/**
+ * \brief           Global event callback
+ */
+static lwcellr_t
+prv_evt(lwcell_evt_t* evt) {
+    LWCELL_UNUSED(evt);
+    return lwcellOK;
+}
+
+/**
+ * \brief           Feed MQTT packet from broker as connection data
+ *
+ * Packet is split to multiple receive notifications of up to \ref MQTT_SEGMENT_LEN bytes,
+ * hence MQTT client cannot parse packet larger than segment in place
+ *
+ * \param[in]       data: Packet data
+ * \param[in]       len: Length of packet in units of bytes
+ */
+static void
+prv_broker_send(const uint8_t* data, size_t len) {
+    static uint8_t buff[MQTT_SEGMENT_LEN + 64];
+    size_t head_len, seg_len;
+
+    for (size_t off = 0; off < len; off += seg_len) {
+        seg_len = LWCELL_MIN(len - off, (size_t)MQTT_SEGMENT_LEN);
+        head_len =
+            (size_t)snprintf((char*)buff, sizeof(buff), "\r\n+RECEIVE,%d,%d:\r\n", (int)conn_num, (int)seg_len);
+        memcpy(&buff[head_len], &data[off], seg_len);
+        lwcell_sim_feed(buff, head_len + seg_len, 0);
+    }
+}
+
+/**
+ * \brief           Broker thread, accepts connection once it is started by the client
+ *
+ * Connection active event is processed before connection data, as they are received in this order
+ */
+static void*
+prv_broker_thread(void* arg) {
+    static const uint8_t connack[] = {0x20, 0x02, 0x00, 0x00};
+    const struct timespec poll = {.tv_nsec = 1000000};
+
+    LWCELL_UNUSED(arg);
+    while (!lwcell_sim_conn_is_active(conn_num)) {
+        conn_num = (conn_num + 1) % LWCELL_CFG_MAX_CONNS;
+        if (conn_num == 0) {
+            nanosleep(&poll, NULL);
+        }
+    }
+    prv_broker_send(connack, sizeof(connack));
+    return NULL;
+}
+
+/**
+ * \brief           Send QoS `0` publish packet from broker
+ * \param[in]       len: Number of payload bytes
+ */
+static void
+prv_broker_publish(size_t len) {
+    static uint8_t pkt[sizeof(payload) + 32];
+    size_t rem_len = 2 + sizeof(MQTT_TOPIC) - 1 + len, pos = 0;
+
+    pkt[pos++] = 0x30;
+    do { /* Remaining length is variable length encoded */
+        pkt[pos++] = (uint8_t)((rem_len & 0x7F) | (rem_len > 0x7F ? 0x80 : 0x00));
+        rem_len >>= 7;
+    } while (rem_len > 0);
+    pkt[pos++] = 0x00;
+    pkt[pos++] = (uint8_t)(sizeof(MQTT_TOPIC) - 1);
+    memcpy(&pkt[pos], MQTT_TOPIC, sizeof(MQTT_TOPIC) - 1);
+    pos += sizeof(MQTT_TOPIC) - 1;
+    memcpy(&pkt[pos], payload, len);
+    prv_broker_send(pkt, pos + len);
+}
+
+/**
+ * \brief           Publish packet from broker and check packet received by application
+ * \param[in]       client: MQTT API client
+ * \param[in]       name: Name of the check
+ * \param[in]       len: Number of payload bytes
+ */
+static void
+prv_check_publish(lwcell_mqtt_client_api_p client, const char* name, size_t len) {
+    lwcell_mqtt_client_api_buf_p buf = NULL;
+    lwcellr_t res;
+    uint8_t ok;
+
+    prv_broker_publish(len);
+    res = lwcell_mqtt_client_api_receive(client, &buf, 1000);
+    ok = res == lwcellOK && buf != NULL && buf->topic_len == sizeof(MQTT_TOPIC) - 1
+         && !memcmp(buf->topic, MQTT_TOPIC, buf->topic_len) && buf->payload_len == len
+         && !memcmp(buf->payload, payload, len);
+    printf("%s: len=%zu res=%d received=%zu %s\r\n", name, len, (int)res, buf != NULL ? buf->payload_len : 0,
+           ok ? "ok" : "FAIL");
+    if (!ok) {
+        ++failures;
+    }
+    lwcell_mqtt_client_api_buf_free(buf);
+}
+
+int
+main(void) {
+    static const lwcell_mqtt_client_info_t info = {.id = "lwcell_test", .keep_alive = 60};
+    lwcell_mqtt_client_api_p client;
+    lwcell_mqtt_conn_status_t status;
+    pthread_t broker;
+
+    for (size_t i = 0; i < sizeof(payload); ++i) {
+        payload[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    lwcell_mem_assignmemory(mem_regions, LWCELL_ARRAYSIZE(mem_regions));
+    if (lwcell_init(prv_evt, 1) != lwcellOK) {
+        printf("Cannot initialize library\r\n");
+        return 1;
+    }
+    if (lwcell_network_attach("internet", NULL, NULL, NULL, NULL, 1) != lwcellOK) {
+        printf("Cannot attach to network\r\n");
+        return 1;
+    }
+    if ((client = lwcell_mqtt_client_api_new(256, MQTT_RX_BUFF_LEN)) == NULL) {
+        printf("Cannot create MQTT client\r\n");
+        return 1;
+    }
+    pthread_create(&broker, NULL, prv_broker_thread, NULL);
+    status = lwcell_mqtt_client_api_connect(client, "10.0.0.1", 1883, &info);
+    pthread_join(broker, NULL);
+    if (status != LWCELL_MQTT_CONN_STATUS_ACCEPTED) {
+        printf("Cannot connect to broker: %d\r\n", (int)status);
+        return 1;
+    }
+
+    prv_check_publish(client, "single", 16);
+    prv_check_publish(client, "single", MQTT_RX_BUFF_LEN - 16);
+#if LWCELL_CFG_MQTT_RECV_STREAM
+    prv_check_publish(client, "stream", sizeof(payload));
+    prv_check_publish(client, "stream", 3 * MQTT_RX_BUFF_LEN + 1);
+#endif /* LWCELL_CFG_MQTT_RECV_STREAM */
+    prv_check_publish(client, "single", 1);
+
+    lwcell_mqtt_client_api_close(client);
+    lwcell_mqtt_client_api_delete(client);
+    return failures > 0;
+}
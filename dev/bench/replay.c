@@ -0,0 +1,252 @@
+/*
+ * Replay of recorded AT port traffic through LwCELL input processing
+ *
+ * Capture is fed to input processing at maximal speed, without any port delays,
+ * to measure parser cost on real device traffic. Tool prints:
+ *
+ *  - replay: Throughput of recorded chunks through input processing
+ *  - line: Cost of each line type, where `+` lines are grouped by their prefix
+ *
+ * Capture file is written by win32 or posix low-level driver when capture file is defined.
+ * Every record holds 32-bit timestamp in milliseconds and 32-bit length in host byte order,
+ * followed by received bytes. Raw captures without headers, such as `log_file.txt`, are accepted with `-r`.
+ *
+ * Usage: lwcell_replay [-n passes] [-c chunk] [-r] file
+ */
+#define _XOPEN_SOURCE 700
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "lwcell/lwcell.h"
+#include "lwcell/lwcell_mem.h"
+#include "lwcell_ll_sim.h"
+
+#define MAX_CHUNKS     0x10000
+#define MAX_LINE_TYPES 64
+
+/**
+ * \brief           Part of capture received with single read
+ */
+typedef struct {
+    uint32_t time; /*!< Capture timestamp in units of milliseconds */
+    size_t off;    /*!< Offset of data in capture buffer */
+    size_t len;    /*!< Length of data in units of bytes */
+} chunk_t;
+
+/**
+ * \brief           Parsing cost of single line type
+ */
+typedef struct {
+    char name[16];    /*!< Line type name */
+    uint32_t count;   /*!< Number of lines */
+    uint64_t time_ns; /*!< Total processing time in units of nanoseconds */
+} line_type_t;
+
+static uint8_t mem_region_data[0x40000];
+static const lwcell_mem_region_t mem_regions[] = {
+    {mem_region_data, sizeof(mem_region_data)},
+};
+
+static uint8_t* data;
+static size_t data_len;
+static chunk_t chunks[MAX_CHUNKS];
+static size_t chunks_cnt;
+static line_type_t line_types[MAX_LINE_TYPES];
+static size_t line_types_cnt;
+
+/**
+ * \brief           Get monotonic time
+ * \return          Time in units of nanoseconds
+ */
+static uint64_t
+prv_now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * \brief           Compare function to sort line types by total time
+ */
+static int
+prv_cmp_line_type(const void* a, const void* b) {
+    const line_type_t *x = a, *y = b;
+
+    return x->time_ns < y->time_ns ? 1 : (x->time_ns > y->time_ns ? -1 : 0);
+}
+
+/**
+ * \brief           Split capture to chunks and remove record headers from data
+ * \param[in]       raw: Set to `1` if capture has no record headers
+ * \param[in]       chunk_size: Chunk size for raw capture
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_split_chunks(uint8_t raw, size_t chunk_size) {
+    size_t wr = 0;
+
+    for (size_t off = 0; off < data_len && chunks_cnt < MAX_CHUNKS; ++chunks_cnt) {
+        chunk_t* c = &chunks[chunks_cnt];
+
+        if (raw) {
+            c->time = 0;
+            c->len = LWCELL_MIN(chunk_size, data_len - off);
+        } else {
+            uint32_t hdr[2];
+
+            if (data_len - off < sizeof(hdr)) {
+                return 0;
+            }
+            memcpy(hdr, &data[off], sizeof(hdr));
+            off += sizeof(hdr);
+            if (hdr[1] == 0 || hdr[1] > data_len - off) {
+                return 0;
+            }
+            c->time = hdr[0];
+            c->len = hdr[1];
+        }
+        memmove(&data[wr], &data[off], c->len);
+        c->off = wr;
+        off += c->len;
+        wr += c->len;
+    }
+    data_len = wr;
+    return chunks_cnt > 0;
+}
+
+/**
+ * \brief           Get line type entry for line
+ * \param[in]       line: Line data
+ * \param[in]       len: Line length
+ * \return          Line type entry
+ */
+static line_type_t*
+prv_get_line_type(const uint8_t* line, size_t len) {
+    char name[sizeof(line_types[0].name)];
+    size_t n = 0;
+
+    if (line[0] == '+') {
+        for (; n < len && n < sizeof(name) - 1 && line[n] != ':' && line[n] != ',' && line[n] != '\r'; ++n) {
+            name[n] = (char)line[n];
+        }
+        name[n] = '\0';
+    } else if (len == 4 && !memcmp(line, "OK\r\n", 4)) {
+        strcpy(name, "OK");
+    } else if (len == 7 && !memcmp(line, "ERROR\r\n", 7)) {
+        strcpy(name, "ERROR");
+    } else if (len <= 2) {
+        strcpy(name, "empty");
+    } else {
+        strcpy(name, "other");
+    }
+
+    for (size_t i = 0; i < line_types_cnt; ++i) {
+        if (!strcmp(line_types[i].name, name)) {
+            return &line_types[i];
+        }
+    }
+    if (line_types_cnt == MAX_LINE_TYPES) {
+        return &line_types[MAX_LINE_TYPES - 1];
+    }
+    strcpy(line_types[line_types_cnt].name, name);
+    return &line_types[line_types_cnt++];
+}
+
+/**
+ * \brief           Event callback
+ * \param[in]       evt: Event information
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+static lwcellr_t
+prv_evt(lwcell_evt_t* evt) {
+    LWCELL_UNUSED(evt);
+    return lwcellOK;
+}
+
+int
+main(int argc, char** argv) {
+    static const lwcell_sim_cfg_t sim_cfg = {.chunk_size = 256, .silent = 1};
+    size_t passes = 10, chunk_size = 256;
+    uint8_t raw = 0;
+    uint64_t t;
+    FILE* f;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:c:r")) != -1) {
+        switch (opt) {
+            case 'n': passes = (size_t)strtoul(optarg, NULL, 0); break;
+            case 'c': chunk_size = (size_t)strtoul(optarg, NULL, 0); break;
+            case 'r': raw = 1; break;
+            default: optind = argc + 1; break;
+        }
+    }
+    if (optind != argc - 1 || passes == 0 || chunk_size == 0) {
+        printf("Usage: %s [-n passes] [-c chunk] [-r] file\r\n", argv[0]);
+        return 1;
+    }
+
+    /* Load entire capture to memory */
+    if ((f = fopen(argv[optind], "rb")) == NULL) {
+        printf("Cannot open %s\r\n", argv[optind]);
+        return 1;
+    }
+    fseek(f, 0, SEEK_END);
+    data_len = (size_t)ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if ((data = malloc(data_len + 1)) == NULL || fread(data, 1, data_len, f) != data_len) {
+        printf("Cannot read %s\r\n", argv[optind]);
+        return 1;
+    }
+    fclose(f);
+    if (!prv_split_chunks(raw, chunk_size)) {
+        printf("Invalid capture file, use -r for raw captures\r\n");
+        return 1;
+    }
+
+    lwcell_sim_set_cfg(&sim_cfg);
+    lwcell_mem_assignmemory(mem_regions, LWCELL_ARRAYSIZE(mem_regions));
+    if (lwcell_init(prv_evt, 1) != lwcellOK) {
+        printf("Cannot initialize library\r\n");
+        return 1;
+    }
+
+    /* Throughput with chunks as recorded */
+    t = prv_now_ns();
+    for (size_t p = 0; p < passes; ++p) {
+        for (size_t i = 0; i < chunks_cnt; ++i) {
+            lwcell_input_process(&data[chunks[i].off], chunks[i].len);
+        }
+    }
+    t = prv_now_ns() - t;
+    printf("replay: bytes=%zu chunks=%zu passes=%zu capture_ms=%u time_us=%llu mbytes_per_s=%.2f\r\n", data_len, chunks_cnt,
+           passes, (unsigned)(chunks[chunks_cnt - 1].time - chunks[0].time), (unsigned long long)(t / 1000),
+           (double)data_len * (double)passes * 1000.0 / (double)(t ? t : 1));
+
+    /* Cost per line type, each line is processed with separate call */
+    for (size_t p = 0; p < passes; ++p) {
+        const uint8_t* d = data;
+
+        for (size_t n, len = data_len; len > 0; d += n, len -= n) {
+            const uint8_t* nl = memchr(d, '\n', len);
+            line_type_t* lt;
+
+            n = nl != NULL ? (size_t)(nl - d) + 1 : len;
+            lt = prv_get_line_type(d, n);
+            t = prv_now_ns();
+            lwcell_input_process(d, n);
+            lt->time_ns += prv_now_ns() - t;
+            ++lt->count;
+        }
+    }
+    qsort(line_types, line_types_cnt, sizeof(line_types[0]), prv_cmp_line_type);
+    for (size_t i = 0; i < line_types_cnt; ++i) {
+        printf("line: type=%s count=%u avg_ns=%llu total_us=%llu\r\n", line_types[i].name,
+               (unsigned)line_types[i].count, (unsigned long long)(line_types[i].time_ns / line_types[i].count),
+               (unsigned long long)(line_types[i].time_ns / 1000));
+    }
+    free(data);
+    return 0;
+}
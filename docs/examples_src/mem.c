@@ -20,4 +20,13 @@ lwcell_mem_region_t mem_regions[] = {
 /* On startup, user must call function to assign memory regions */
 lwcell_mem_assignmemory(mem_regions, LWCELL_ARRAYSIZE(mem_regions));
 
+/*
+ * With LWCELL_CFG_MEM_CLASSES enabled, every region also sets classes it serves.
+ * Messages then use fast memory, while packet buffers never leave DMA-capable memory
+ */
+lwcell_mem_region_t mem_regions_classes[] = {
+    { (void *)0x20000000, 0x4000, LWCELL_MEM_CLASS_BIT(LWCELL_MEM_CLASS_FAST) },    /* DTCM, not reachable by DMA */
+    { (void *)0x24000000, 0x8000, LWCELL_MEM_CLASS_BIT(LWCELL_MEM_CLASS_DMA) | LWCELL_MEM_CLASS_BIT(LWCELL_MEM_CLASS_BULK) },
+};
+
 #endif /* !LWCELL_CFG_MEM_CUSTOM */
\ No newline at end of file
@@ -0,0 +1,116 @@
+/**
+  ******************************************************************************
+  * @file    stm32f4xx_it.c
+  * @brief   Interrupt Service Routines.
+  ******************************************************************************
+  *
+  * COPYRIGHT(c) 2018 STMicroelectronics
+  *
+  * Redistribution and use in source and binary forms, with or without modification,
+  * are permitted provided that the following conditions are met:
+  *   1. Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *   2. Redistributions in binary form must reproduce the above copyright notice,
+  *      this list of conditions and the following disclaimer in the documentation
+  *      and/or other materials provided with the distribution.
+  *   3. Neither the name of STMicroelectronics nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+  * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  ******************************************************************************
+  */
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx.h"
+#include "stm32f4xx_it.h"
+
+#include "cmsis_os.h"
+
+/******************************************************************************/
+/*            Cortex-M4 Processor Interruption and Exception Handlers         */ 
+/******************************************************************************/
+
+/**
+ * \brief           This function handles Non maskable interrupt.
+ */
+void NMI_Handler(void) {
+    while (1) {
+        
+    }
+}
+
+/**
+ * \brief           This function handles Hard fault interrupt.
+ */
+void
+HardFault_Handler(void) {
+    while (1) {
+        
+    }
+}
+
+/**
+ * \brief           This function handles Mem manage interrupt.
+ */
+void
+MemManage_Handler(void) {
+    while (1) {
+        
+    }
+}
+
+/**
+ * \brief           This function handles Bus fault interrupt.
+ */
+void
+BusFault_Handler(void) {
+    while (1) {
+        
+    }
+}
+
+/**
+ * \brief           This function handles Usage fault interrupt.
+ */
+void
+UsageFault_Handler(void) {
+    while (1) {
+        
+    }
+}
+
+/**
+ * \brief           This function handles Debug monitor interrupt.
+ */
+void
+DebugMon_Handler(void) {
+    while (1) {
+        
+    }
+}
+
+/**
+ * \brief           This function handles Systick interrupt.
+ */
+void
+SysTick_Handler(void) {
+    extern void xPortSysTickHandler(void);
+    xPortSysTickHandler();
+}
+
+/******************************************************************************/
+/* STM32F4xx Peripheral Interrupt Handlers                                    */
+/* Add here the Interrupt Handlers for the used peripherals.                  */
+/* For the available peripheral interrupt handler names,                      */
+/* please refer to the startup file (startup_stm32f4xx.s).                    */
+/******************************************************************************/
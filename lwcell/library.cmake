@@ -7,6 +7,8 @@
 # Before this file is included to the root CMakeLists file (using include() function), user can set some variables:
 #
 # LWCELL_SYS_PORT: If defined, it will include port source file from the library, and include the necessary header file.
+#                  Accepted values: win32, posix, cmsis_os, freeRTOS, threadx, baremetal. posix also adds termios low-level driver
+# LWCELL_LL_CUSTOM: If set to ON, port low-level driver is not added and user provides its own lwcell_ll_init
 # LWCELL_OPTS_FILE: If defined, it is the path to the user options file. If not defined, one will be generated for you automatically
 # LWCELL_COMPILE_OPTIONS: If defined, it provide compiler options for generated library.
 # LWCELL_COMPILE_DEFINITIONS: If defined, it provides "-D" definitions to the library build
@@ -20,10 +22,24 @@ set(lwcell_core_SRCS
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_buff.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_call.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_cell_info.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_cmux.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_compress.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_ppp.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_pwr.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_supervisor.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_snapshot.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_usage.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_metrics.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_conn.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_cq.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_debug.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_device_info.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_dns.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_evt.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_fs.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_ftp.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_gnss.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_http.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_input.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_int.c
@@ -34,9 +50,14 @@ set(lwcell_core_SRCS
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_parser.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_pbuf.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_phonebook.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_ping.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_sim.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_sms.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_sms_pdu.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_ssl.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_stats.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_threads.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_time.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_timeout.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_unicode.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwcell/lwcell_ussd.c
@@ -46,6 +67,7 @@ set(lwcell_core_SRCS
 # API sources
 set(lwcell_api_SRCS
     ${CMAKE_CURRENT_LIST_DIR}/src/api/lwcell_netconn.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/api/lwcell_netconn_pool.c
     ${CMAKE_CURRENT_LIST_DIR}/src/api/lwcell_network_api.c
 )
 
@@ -56,9 +78,33 @@ set(lwcell_mqtt_SRCS
     ${CMAKE_CURRENT_LIST_DIR}/src/apps/mqtt/lwcell_mqtt_client_evt.c
 )
 
+# CoAP
+set(lwcell_coap_SRCS
+    ${CMAKE_CURRENT_LIST_DIR}/src/apps/coap/lwcell_coap_client.c
+)
+
+# OTA
+set(lwcell_ota_SRCS
+    ${CMAKE_CURRENT_LIST_DIR}/src/apps/ota/lwcell_ota.c
+)
+
+# WebSocket
+set(lwcell_ws_SRCS
+    ${CMAKE_CURRENT_LIST_DIR}/src/apps/websocket/lwcell_ws_client.c
+)
+
+# HTTP client
+set(lwcell_http_client_SRCS
+    ${CMAKE_CURRENT_LIST_DIR}/src/apps/http/lwcell_http_client.c
+)
+
 # All apps source files
 set(lwcell_allapps_SRCS
     ${lwcell_mqtt_SRCS}
+    ${lwcell_coap_SRCS}
+    ${lwcell_ota_SRCS}
+    ${lwcell_ws_SRCS}
+    ${lwcell_http_client_SRCS}
 )
 
 # Setup include directories
@@ -71,6 +117,13 @@ set(lwcell_include_DIRS
 if(DEFINED LWCELL_SYS_PORT)
     set(lwcell_core_SRCS ${lwcell_core_SRCS} ${CMAKE_CURRENT_LIST_DIR}/src/system/lwcell_sys_${LWCELL_SYS_PORT}.c)
     set(lwcell_include_DIRS ${lwcell_include_DIRS} ${CMAKE_CURRENT_LIST_DIR}/src/include/system/port/${LWCELL_SYS_PORT})
+    if(LWCELL_SYS_PORT STREQUAL "posix")
+        if(NOT LWCELL_LL_CUSTOM)
+            set(lwcell_core_SRCS ${lwcell_core_SRCS} ${CMAKE_CURRENT_LIST_DIR}/src/system/lwcell_ll_posix.c)
+        endif()
+        find_package(Threads REQUIRED)
+        set(lwcell_link_LIBS Threads::Threads)
+    endif()
 endif()
 
 # Register core library to the system
@@ -79,6 +132,7 @@ target_sources(lwcell PRIVATE ${lwcell_core_SRCS})
 target_include_directories(lwcell PUBLIC ${lwcell_include_DIRS})
 target_compile_options(lwcell PRIVATE ${LWCELL_COMPILE_OPTIONS})
 target_compile_definitions(lwcell PRIVATE ${LWCELL_COMPILE_DEFINITIONS})
+target_link_libraries(lwcell PUBLIC ${lwcell_link_LIBS})
 
 # Register API to the system
 add_library(lwcell_api)
@@ -47,6 +47,10 @@
 #error "LWCELL_CFG_NETCONN_RECEIVE_QUEUE_LEN must be greater or equal to 2"
 #endif /* LWCELL_CFG_NETCONN_RECEIVE_QUEUE_LEN < 2 */
 
+#if LWCELL_CFG_CONN_SERVER && LWCELL_CFG_NETCONN_ACCEPT_QUEUE_LEN < 2
+#error "LWCELL_CFG_NETCONN_ACCEPT_QUEUE_LEN must be greater or equal to 2"
+#endif /* LWCELL_CFG_CONN_SERVER && LWCELL_CFG_NETCONN_ACCEPT_QUEUE_LEN < 2 */
+
 /**
  * \brief           Sequential API structure
  */
@@ -59,8 +63,18 @@ typedef struct lwcell_netconn {
     lwcell_conn_p conn;             /*!< Pointer to actual connection */
 
     lwcell_sys_mbox_t mbox_receive; /*!< Message queue for receive mbox */
+    lwcell_pbuf_p rd_pbuf;          /*!< Received packet partially consumed by \ref lwcell_netconn_read */
+#if LWCELL_CFG_CONN_SERVER || __DOXYGEN__
+    lwcell_sys_mbox_t mbox_accept; /*!< Message queue for accepting new connections */
+    lwcell_port_t listen_port;     /*!< Local port set with \ref lwcell_netconn_bind */
+    uint32_t last_activity;        /*!< Time of last data exchange, used for connection timeout */
+#endif                             /* LWCELL_CFG_CONN_SERVER || __DOXYGEN__ */
 
     lwcell_linbuff_t buff;          /*!< Linear buffer structure */
+#if LWCELL_CFG_NETCONN_WRITE_FLUSH_DELAY > 0 || __DOXYGEN__
+    lwcell_timeout_t wr_timeout; /*!< Write buffer flush timer */
+    uint8_t wr_busy;             /*!< Set to `1` when application thread uses write buffer, protected by core lock */
+#endif                           /* LWCELL_CFG_NETCONN_WRITE_FLUSH_DELAY > 0 || __DOXYGEN__ */
 
     uint16_t conn_timeout;         /*!< Connection timeout in units of seconds when
                                                     netconn is in server (listen) mode.
@@ -70,10 +84,23 @@ typedef struct lwcell_netconn {
 #if LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT || __DOXYGEN__
     uint32_t rcv_timeout; /*!< Receive timeout in unit of milliseconds */
 #endif
+#if LWCELL_CFG_NETCONN_POLL || __DOXYGEN__
+    size_t rcv_queued; /*!< Number of entries in receive mbox, protected by core lock */
+#endif                 /* LWCELL_CFG_NETCONN_POLL || __DOXYGEN__ */
+#if LWCELL_CFG_NETCONN_RECEIVE_COALESCE_LEN > 0 || __DOXYGEN__
+    lwcell_pbuf_p rcv_tail; /*!< Last pbuf in receive mbox, not yet read by application.
+                                    New data may be chained to it. Protected by core lock */
+#endif                      /* LWCELL_CFG_NETCONN_RECEIVE_COALESCE_LEN > 0 || __DOXYGEN__ */
 } lwcell_netconn_t;
 
 static uint8_t recv_closed = 0xFF;
 static lwcell_netconn_t* netconn_list; /*!< Linked list of netconn entries */
+#if LWCELL_CFG_CONN_SERVER
+static lwcell_netconn_t* listen_api; /*!< Netconn in listen mode, device supports single server */
+#endif                               /* LWCELL_CFG_CONN_SERVER */
+#if LWCELL_CFG_NETCONN_POLL
+static lwcell_sys_sem_t poll_sem; /*!< Shared poll notification, released on every receive mbox write */
+#endif                            /* LWCELL_CFG_NETCONN_POLL */
 
 /**
  * \brief           Flush all mboxes and clear possible used memories
@@ -95,11 +122,96 @@ flush_mboxes(lwcell_netconn_t* nc, uint8_t protect) {
         lwcell_sys_mbox_delete(&nc->mbox_receive);  /* Delete message queue */
         lwcell_sys_mbox_invalid(&nc->mbox_receive); /* Invalid handle */
     }
+    if (nc->rd_pbuf != NULL) {
+        lwcell_pbuf_free_s(&nc->rd_pbuf); /* Unread rest of packet */
+    }
+#if LWCELL_CFG_CONN_SERVER
+    if (lwcell_sys_mbox_isvalid(&nc->mbox_accept)) {
+        lwcell_netconn_t* new_nc;
+        while (lwcell_sys_mbox_getnow(&nc->mbox_accept, (void**)&new_nc)) {
+            if (new_nc != NULL) {
+                lwcell_conn_p conn = new_nc->conn;
+
+                /* Connection was never accepted by application, close it */
+                lwcell_conn_set_arg(conn, NULL);
+                lwcell_netconn_delete(new_nc);
+                lwcell_conn_close(conn, 0);
+            }
+        }
+        lwcell_sys_mbox_delete(&nc->mbox_accept);  /* Delete message queue */
+        lwcell_sys_mbox_invalid(&nc->mbox_accept); /* Invalid handle */
+    }
+#endif /* LWCELL_CFG_CONN_SERVER */
+#if LWCELL_CFG_NETCONN_POLL
+    nc->rcv_queued = 0;
+#endif /* LWCELL_CFG_NETCONN_POLL */
+#if LWCELL_CFG_NETCONN_RECEIVE_COALESCE_LEN > 0
+    nc->rcv_tail = NULL;
+#endif /* LWCELL_CFG_NETCONN_RECEIVE_COALESCE_LEN > 0 */
     if (protect) {
         lwcell_core_unlock();
     }
 }
 
+/**
+ * \brief           Put received packet buffer to netconn receive queue
+ * \param[in]       conn: Connection handle
+ * \param[in]       pbuf: Received packet buffer
+ * \param[in]       arg: Netconn handle, connection argument
+ * \return          \ref lwcellOK on success, \ref lwcellOKIGNOREMORE when data cannot be queued
+ */
+static lwcellr_t
+prv_netconn_recv(lwcell_conn_p conn, lwcell_pbuf_p pbuf, void* arg) {
+    lwcell_netconn_t* nc = arg;
+
+#if LWCELL_CFG_CONN_MANUAL_RECV
+    LWCELL_UNUSED(conn); /* Stack is notified when application reads data */
+#else  /* LWCELL_CFG_CONN_MANUAL_RECV */
+    lwcell_conn_recved(conn, pbuf); /* Notify stack about received data */
+#endif /* !LWCELL_CFG_CONN_MANUAL_RECV */
+#if LWCELL_CFG_CONN_SERVER
+    if (nc != NULL) {
+        nc->last_activity = lwcell_sys_now();
+    }
+#endif /* LWCELL_CFG_CONN_SERVER */
+
+#if LWCELL_CFG_NETCONN_RECEIVE_COALESCE_LEN > 0
+    /* Chain to last packet in queue when application did not read it yet */
+    if (nc != NULL && nc->rcv_tail != NULL
+        && lwcell_pbuf_length(nc->rcv_tail, 1) + lwcell_pbuf_length(pbuf, 1)
+               <= LWCELL_CFG_NETCONN_RECEIVE_COALESCE_LEN
+#if LWCELL_CFG_CONN_RECV_FROM
+        /* Packets from different peers must stay separate */
+        && nc->rcv_tail->port == pbuf->port && !memcmp(&nc->rcv_tail->ip, &pbuf->ip, sizeof(pbuf->ip))
+#endif /* LWCELL_CFG_CONN_RECV_FROM */
+    ) {
+        lwcell_pbuf_chain(nc->rcv_tail, pbuf); /* Reference is taken by tail pbuf */
+        ++nc->rcv_packets;
+        return lwcellOK;
+    }
+#endif /* LWCELL_CFG_NETCONN_RECEIVE_COALESCE_LEN > 0 */
+
+    lwcell_pbuf_ref(pbuf); /* Increase reference counter */
+    if (nc == NULL || !lwcell_sys_mbox_isvalid(&nc->mbox_receive)
+        || !lwcell_sys_mbox_putnow(&nc->mbox_receive, pbuf)) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_NETCONN, "[LWCELL NETCONN] Ignoring more data for receive!\r\n");
+        lwcell_pbuf_free_s(&pbuf); /* Free pbuf */
+        return lwcellOKIGNOREMORE; /* Return OK to free the memory and ignore further data */
+    }
+    ++nc->rcv_packets;         /* Increase number of received packets */
+#if LWCELL_CFG_NETCONN_RECEIVE_COALESCE_LEN > 0
+    nc->rcv_tail = pbuf; /* Following data may be chained to this packet */
+#endif /* LWCELL_CFG_NETCONN_RECEIVE_COALESCE_LEN > 0 */
+#if LWCELL_CFG_NETCONN_POLL
+    ++nc->rcv_queued;
+    lwcell_sys_sem_release(&poll_sem); /* Notify poller about readiness */
+#endif /* LWCELL_CFG_NETCONN_POLL */
+    LWCELL_DEBUGF(LWCELL_CFG_DBG_NETCONN | LWCELL_DBG_TYPE_TRACE,
+                 "[LWCELL NETCONN] Received pbuf contains %d bytes. Handle written to receive mbox\r\n",
+                 (int)lwcell_pbuf_length(pbuf, 0));
+    return lwcellOK;
+}
+
 /**
  * \brief           Callback function for every server connection
  * \param[in]       evt: Pointer to callback structure
@@ -121,16 +233,44 @@ netconn_evt(lwcell_evt_t* evt) {
             if (lwcell_conn_is_client(conn)) {  /* Was connection started by us? */
                 nc = lwcell_conn_get_arg(conn); /* Argument should be already set */
                 if (nc != NULL) {
-                    nc->conn = conn;           /* Save actual connection */
+                    nc->conn = conn;                        /* Save actual connection */
+                    lwcell_conn_set_poll_interval(conn, 0); /* Client netconn does not use poll */
+                } else {
+                    close = 1;                              /* Close this connection, invalid netconn */
+                }
+#if LWCELL_CFG_CONN_SERVER
+            } else if (listen_api != NULL && lwcell_sys_mbox_isvalid(&listen_api->mbox_accept)) {
+                /* Incoming connection, create new netconn and put it to accept queue */
+                nc = lwcell_netconn_new(LWCELL_NETCONN_TYPE_TCP);
+                if (nc != NULL) {
+                    nc->conn = conn;
+                    nc->conn_timeout = listen_api->conn_timeout; /* Inherit timeout from listening netconn */
+                    nc->last_activity = lwcell_sys_now();
+                    lwcell_conn_set_arg(conn, nc); /* Set argument for connection */
+                    if (nc->conn_timeout == 0) {
+                        lwcell_conn_set_poll_interval(conn, 0); /* Poll is only used for idle timeout */
+                    }
+                    if (!lwcell_sys_mbox_putnow(&listen_api->mbox_accept, nc)) {
+                        LWCELL_DEBUGF(LWCELL_CFG_DBG_NETCONN | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING,
+                                      "[LWCELL NETCONN] Accept queue is full, closing connection\r\n");
+                        close = 1;
+                    }
                 } else {
-                    close = 1;                 /* Close this connection, invalid netconn */
+                    close = 1;
                 }
+#endif /* LWCELL_CFG_CONN_SERVER */
             } else {
                 LWCELL_DEBUGF(LWCELL_CFG_DBG_NETCONN | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING,
                              "[LWCELL NETCONN] Closing connection, it is not in client mode!\r\n");
                 close = 1; /* Close the connection at this point */
             }
 
+#if LWCELL_CFG_CONN_RECV_FN
+            if (!close) {
+                lwcell_conn_set_recv_fn(conn, prv_netconn_recv); /* Queue data without event dispatch */
+            }
+#endif /* LWCELL_CFG_CONN_RECV_FN */
+
             /* Decide if some events want to close the connection */
             if (close) {
                 if (nc != NULL) {
@@ -148,25 +288,7 @@ netconn_evt(lwcell_evt_t* evt) {
          * should have netconn structure as argument
          */
         case LWCELL_EVT_CONN_RECV: {
-            lwcell_pbuf_p pbuf;
-
-            nc = lwcell_conn_get_arg(conn);            /* Get API from connection */
-            pbuf = lwcell_evt_conn_recv_get_buff(evt); /* Get received buff */
-
-            lwcell_conn_recved(conn, pbuf);            /* Notify stack about received data */
-
-            lwcell_pbuf_ref(pbuf);                     /* Increase reference counter */
-            if (nc == NULL || !lwcell_sys_mbox_isvalid(&nc->mbox_receive)
-                || !lwcell_sys_mbox_putnow(&nc->mbox_receive, pbuf)) {
-                LWCELL_DEBUGF(LWCELL_CFG_DBG_NETCONN, "[LWCELL NETCONN] Ignoring more data for receive!\r\n");
-                lwcell_pbuf_free_s(&pbuf); /* Free pbuf */
-                return lwcellOKIGNOREMORE; /* Return OK to free the memory and ignore further data */
-            }
-            ++nc->rcv_packets;            /* Increase number of received packets */
-            LWCELL_DEBUGF(LWCELL_CFG_DBG_NETCONN | LWCELL_DBG_TYPE_TRACE,
-                         "[LWCELL NETCONN] Received pbuf contains %d bytes. Handle written to receive mbox\r\n",
-                         (int)lwcell_pbuf_length(pbuf, 0));
-            break;
+            return prv_netconn_recv(conn, lwcell_evt_conn_recv_get_buff(evt), lwcell_conn_get_arg(conn));
         }
 
         /* Connection was just closed */
@@ -178,11 +300,44 @@ netconn_evt(lwcell_evt_t* evt) {
              * simply write pointer to received variable to indicate closed state
              */
             if (nc != NULL && lwcell_sys_mbox_isvalid(&nc->mbox_receive)) {
+#if LWCELL_CFG_NETCONN_RECEIVE_COALESCE_LEN > 0
+                nc->rcv_tail = NULL;
+#endif /* LWCELL_CFG_NETCONN_RECEIVE_COALESCE_LEN > 0 */
+#if LWCELL_CFG_NETCONN_POLL
+                if (lwcell_sys_mbox_putnow(&nc->mbox_receive, (void*)&recv_closed)) {
+                    ++nc->rcv_queued;
+                    lwcell_sys_sem_release(&poll_sem); /* Notify poller about readiness */
+                }
+#else  /* LWCELL_CFG_NETCONN_POLL */
                 lwcell_sys_mbox_putnow(&nc->mbox_receive, (void*)&recv_closed);
+#endif /* !LWCELL_CFG_NETCONN_POLL */
             }
 
             break;
         }
+
+#if LWCELL_CFG_CONN_SERVER
+        /* Data were sent, connection is in use */
+        case LWCELL_EVT_CONN_SEND: {
+            nc = lwcell_conn_get_arg(conn);
+            if (nc != NULL) {
+                nc->last_activity = lwcell_sys_now();
+            }
+            break;
+        }
+
+        /* Periodic poll, close accepted connection when idle for too long */
+        case LWCELL_EVT_CONN_POLL: {
+            nc = lwcell_conn_get_arg(conn);
+            if (nc != NULL && nc->conn_timeout > 0 && !lwcell_conn_is_client(conn)
+                && (lwcell_sys_now() - nc->last_activity) >= (uint32_t)nc->conn_timeout * 1000U) {
+                LWCELL_DEBUGF(LWCELL_CFG_DBG_NETCONN | LWCELL_DBG_TYPE_TRACE,
+                              "[LWCELL NETCONN] Closing idle server connection %d\r\n", (int)lwcell_conn_getnum(conn));
+                lwcell_conn_close(conn, 0);
+            }
+            break;
+        }
+#endif /* LWCELL_CFG_CONN_SERVER */
         default: return lwcellERR;
     }
     return lwcellOK;
@@ -214,11 +369,19 @@ lwcell_netconn_new(lwcell_netconn_type_t type) {
     /* Register only once! */
     lwcell_core_lock();
     if (first) {
+#if LWCELL_CFG_NETCONN_POLL
+        if (!lwcell_sys_sem_create(&poll_sem, 0)) {
+            lwcell_core_unlock();
+            LWCELL_DEBUGF(LWCELL_CFG_DBG_NETCONN | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_DANGER,
+                          "[LWCELL NETCONN] Cannot create poll semaphore\r\n");
+            return NULL;
+        }
+#endif /* LWCELL_CFG_NETCONN_POLL */
         first = 0;
         lwcell_evt_register(lwcell_evt); /* Register global event function */
     }
     lwcell_core_unlock();
-    a = lwcell_mem_calloc(1, sizeof(*a)); /* Allocate memory for core object */
+    a = lwcell_mem_calloc_tag(1, sizeof(*a), LWCELL_MEM_TAG_NETCONN); /* Allocate memory for core object */
     if (a != NULL) {
         a->type = type;                  /* Save netconn type */
         a->conn_timeout = 0;             /* Default connection timeout */
@@ -260,7 +423,16 @@ lwcell_netconn_delete(lwcell_netconn_p nc) {
     LWCELL_ASSERT(nc != NULL);
 
     lwcell_core_lock();
+#if LWCELL_CFG_CONN_SERVER
+    if (listen_api == nc) {
+        listen_api = NULL;                                /* Stop accepting new connections */
+        lwcell_conn_set_server(0, 0, NULL, NULL, NULL, 0); /* Stop server on device */
+    }
+#endif /* LWCELL_CFG_CONN_SERVER */
     flush_mboxes(nc, 0); /* Clear mboxes */
+#if LWCELL_CFG_NETCONN_WRITE_FLUSH_DELAY > 0
+    lwcell_timeout_stop(&nc->wr_timeout);
+#endif /* LWCELL_CFG_NETCONN_WRITE_FLUSH_DELAY > 0 */
 
     /* Remove netconn from linkedlist */
     if (netconn_list == nc) {
@@ -277,6 +449,7 @@ lwcell_netconn_delete(lwcell_netconn_p nc) {
     }
     lwcell_core_unlock();
 
+    lwcell_mem_free_s((void**)&nc->buff.buff); /* Unsent data of write buffer are dropped */
     lwcell_mem_free_s((void**)&nc);
     return lwcellOK;
 }
@@ -307,36 +480,136 @@ lwcell_netconn_connect(lwcell_netconn_p nc, const char* host, lwcell_port_t port
     return res;
 }
 
+#if LWCELL_CFG_CONN_SERVER || __DOXYGEN__
+
+/**
+ * \brief           Bind a connection to specific port, can be only used for server connections
+ * \param[in]       nc: Netconn handle
+ * \param[in]       port: Port used to bind a connection to
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_netconn_bind(lwcell_netconn_p nc, lwcell_port_t port) {
+    LWCELL_ASSERT(nc != NULL);
+    LWCELL_ASSERT(nc->type == LWCELL_NETCONN_TYPE_TCP);
+    LWCELL_ASSERT(port > 0);
+
+    nc->listen_port = port;
+    return lwcellOK;
+}
+
+/**
+ * \brief           Set timeout value in units of seconds when connection is in listening mode
+ *
+ * Accepted connections with no data exchange for `timeout` seconds are automatically closed
+ *
+ * \note            Value is applied to connections accepted after the call
+ * \param[in]       nc: Netconn handle used as listen connection
+ * \param[in]       timeout: Time in units of seconds. Set to `0` to disable timeout feature
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_netconn_set_listen_conn_timeout(lwcell_netconn_p nc, uint16_t timeout) {
+    LWCELL_ASSERT(nc != NULL);
+
+    lwcell_core_lock();
+    nc->conn_timeout = timeout;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+/**
+ * \brief           Listen on previously binded connection
+ * \note            Device supports single listening netconn at a time
+ * \param[in]       nc: Netconn handle used to listen for new connections
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_netconn_listen(lwcell_netconn_p nc) {
+    lwcellr_t res;
+
+    LWCELL_ASSERT(nc != NULL);
+    LWCELL_ASSERT(nc->type == LWCELL_NETCONN_TYPE_TCP);
+    LWCELL_ASSERT(nc->listen_port > 0);
+
+    lwcell_core_lock();
+    if (listen_api != NULL && listen_api != nc) {
+        lwcell_core_unlock();
+        return lwcellERR; /* Another netconn is already listening */
+    }
+    if (!lwcell_sys_mbox_isvalid(&nc->mbox_accept)
+        && !lwcell_sys_mbox_create(&nc->mbox_accept, LWCELL_CFG_NETCONN_ACCEPT_QUEUE_LEN)) {
+        lwcell_core_unlock();
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_NETCONN | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_DANGER,
+                      "[LWCELL NETCONN] Cannot create accept MBOX\r\n");
+        return lwcellERRMEM;
+    }
+    listen_api = nc; /* Set current listening API */
+    lwcell_core_unlock();
+
+    /* Enable server on device and use netconn callback for every accepted connection */
+    res = lwcell_conn_set_server(1, nc->listen_port, netconn_evt, NULL, NULL, 1);
+    if (res != lwcellOK) {
+        lwcell_core_lock();
+        listen_api = NULL;
+        lwcell_core_unlock();
+    }
+    return res;
+}
+
+/**
+ * \brief           Accept a new connection
+ * \param[in]       nc: Netconn handle used as base connection to accept new clients
+ * \param[out]      client: Pointer to netconn handle to save new connection to
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_netconn_accept(lwcell_netconn_p nc, lwcell_netconn_p* client) {
+    lwcell_netconn_t* tmp;
+    uint32_t time;
+
+    LWCELL_ASSERT(nc != NULL);
+    LWCELL_ASSERT(client != NULL);
+    LWCELL_ASSERT(nc->type == LWCELL_NETCONN_TYPE_TCP);
+    LWCELL_ASSERT(nc == listen_api);
+
+    *client = NULL;
+    time = lwcell_sys_mbox_get(&nc->mbox_accept, (void**)&tmp, 0);
+    if (time == LWCELL_SYS_TIMEOUT) {
+        return lwcellTIMEOUT;
+    }
+    *client = tmp; /* Set new pointer */
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_CONN_SERVER || __DOXYGEN__ */
+
 /**
  * \brief           Write data to connection output buffers
- * \note            This function may only be used on TCP or SSL connections
  * \param[in]       nc: Netconn handle used to write data to
  * \param[in]       data: Pointer to data to write
  * \param[in]       btw: Number of bytes to write
  * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
  */
-lwcellr_t
-lwcell_netconn_write(lwcell_netconn_p nc, const void* data, size_t btw) {
+static lwcellr_t
+prv_write(lwcell_netconn_p nc, const void* data, size_t btw) {
     size_t len, sent;
     const uint8_t* d = data;
     lwcellr_t res;
 
-    LWCELL_ASSERT(nc != NULL);
-    LWCELL_ASSERT(nc->type == LWCELL_NETCONN_TYPE_TCP || nc->type == LWCELL_NETCONN_TYPE_SSL);
-    LWCELL_ASSERT(lwcell_conn_is_active(nc->conn));
-
     /*
      * Several steps are done in write process
      *
      * 1. Check if buffer is set and check if there is something to write to it.
-     *    1. In case buffer will be full after copy, send it and free memory.
+     *    1. In case buffer will be full after copy, send it and free memory,
+     *       or only reset it when LWCELL_CFG_NETCONN_WRITE_BUFF_KEEP is enabled.
      * 2. Check how many bytes we can write directly without need to copy
      * 3. Try to allocate a new buffer and copy remaining input data to it
      * 4. In case buffer allocation fails, send data directly (may affect on speed and effectivenes)
      */
 
     /* Step 1 */
-    if (nc->buff.buff != NULL) {                           /* Is there a write buffer ready to accept more data? */
+    if (nc->buff.buff != NULL && nc->buff.ptr > 0) {       /* Is there a write buffer with data to accept more? */
         len = LWCELL_MIN(nc->buff.len - nc->buff.ptr, btw); /* Get number of bytes we can write to buffer */
         if (len > 0) {
             LWCELL_MEMCPY(&nc->buff.buff[nc->buff.ptr], data, len); /* Copy memory to temporary write buffer */
@@ -349,7 +622,11 @@ lwcell_netconn_write(lwcell_netconn_p nc, const void* data, size_t btw) {
         if (nc->buff.ptr == nc->buff.len) {
             res = lwcell_conn_send(nc->conn, nc->buff.buff, nc->buff.len, &sent, 1);
 
+#if LWCELL_CFG_NETCONN_WRITE_BUFF_KEEP
+            nc->buff.ptr = 0; /* Keep buffer for next write */
+#else  /* LWCELL_CFG_NETCONN_WRITE_BUFF_KEEP */
             lwcell_mem_free_s((void**)&nc->buff.buff);
+#endif /* !LWCELL_CFG_NETCONN_WRITE_BUFF_KEEP */
             if (res != lwcellOK) {
                 return res;
             }
@@ -376,7 +653,8 @@ lwcell_netconn_write(lwcell_netconn_p nc, const void* data, size_t btw) {
 
     /* Step 3 */
     if (nc->buff.buff == NULL) {                    /* Check if we should allocate a new buffer */
-        nc->buff.buff = lwcell_mem_malloc(sizeof(*nc->buff.buff) * LWCELL_CFG_CONN_MAX_DATA_LEN);
+        nc->buff.buff =
+            lwcell_mem_malloc_tag(sizeof(*nc->buff.buff) * LWCELL_CFG_CONN_MAX_DATA_LEN, LWCELL_MEM_TAG_NETCONN);
         nc->buff.len = LWCELL_CFG_CONN_MAX_DATA_LEN; /* Save buffer length */
         nc->buff.ptr = 0;                           /* Save buffer pointer */
     }
@@ -386,11 +664,114 @@ lwcell_netconn_write(lwcell_netconn_p nc, const void* data, size_t btw) {
         LWCELL_MEMCPY(&nc->buff.buff[nc->buff.ptr], d, btw);   /* Copy data to buffer */
         nc->buff.ptr += btw;
     } else {                                                  /* Still no memory available? */
-        return lwcell_conn_send(nc->conn, data, btw, NULL, 1); /* Simply send directly blocking */
+        return lwcell_conn_send(nc->conn, d, btw, NULL, 1);    /* Simply send directly blocking */
+    }
+    return lwcellOK;
+}
+
+/**
+ * \brief           Send data from write buffer
+ * \param[in]       nc: Netconn handle to flush data
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+prv_flush(lwcell_netconn_p nc) {
+    /*
+     * In case we have data in write buffer,
+     * flush them out to network
+     */
+    if (nc->buff.buff != NULL) {                                             /* Check remaining data */
+        if (nc->buff.ptr > 0) {                                              /* Do we have data in current buffer? */
+            lwcell_conn_send(nc->conn, nc->buff.buff, nc->buff.ptr, NULL, 1); /* Send data */
+        }
+#if LWCELL_CFG_NETCONN_WRITE_BUFF_KEEP
+        nc->buff.ptr = 0; /* Buffer stays allocated until netconn is deleted */
+#else  /* LWCELL_CFG_NETCONN_WRITE_BUFF_KEEP */
+        lwcell_mem_free_s((void**)&nc->buff.buff);
+#endif /* !LWCELL_CFG_NETCONN_WRITE_BUFF_KEEP */
     }
     return lwcellOK;
 }
 
+#if LWCELL_CFG_NETCONN_WRITE_FLUSH_DELAY > 0 || __DOXYGEN__
+
+/**
+ * \brief           Write buffer flush timer callback
+ *
+ * Buffer is copied to packet buffer and sent without blocking, as function is called from processing thread
+ *
+ * \param[in]       arg: Netconn handle
+ */
+static void
+prv_write_flush_timeout(void* arg) {
+    lwcell_netconn_p nc = arg;
+    lwcell_pbuf_p pbuf;
+
+    if (nc->wr_busy || nc->buff.buff == NULL || nc->buff.ptr == 0 || nc->conn == NULL
+        || !lwcell_conn_is_active(nc->conn)) {
+        return; /* Application thread takes care of buffer */
+    }
+    if ((pbuf = lwcell_pbuf_new(nc->buff.ptr)) != NULL) {
+        lwcell_pbuf_take(pbuf, nc->buff.buff, nc->buff.ptr, 0);
+        if (lwcell_conn_send_pbuf(nc->conn, pbuf, NULL, 0) == lwcellOK) {
+#if LWCELL_CFG_NETCONN_WRITE_BUFF_KEEP
+            nc->buff.ptr = 0;
+#else  /* LWCELL_CFG_NETCONN_WRITE_BUFF_KEEP */
+            lwcell_mem_free_s((void**)&nc->buff.buff);
+#endif /* !LWCELL_CFG_NETCONN_WRITE_BUFF_KEEP */
+        }
+        lwcell_pbuf_free_s(&pbuf); /* Stack keeps its own reference */
+    }
+    if (nc->buff.buff != NULL && nc->buff.ptr > 0) {
+        lwcell_timeout_start(&nc->wr_timeout, LWCELL_CFG_NETCONN_WRITE_FLUSH_DELAY, prv_write_flush_timeout, nc);
+    }
+}
+
+/**
+ * \brief           Mark write buffer as used by application thread
+ * \param[in]       nc: Netconn handle
+ */
+static void
+prv_write_begin(lwcell_netconn_p nc) {
+    lwcell_core_lock();
+    nc->wr_busy = 1;
+    lwcell_core_unlock();
+}
+
+/**
+ * \brief           Release write buffer and start or stop flush timer
+ * \param[in]       nc: Netconn handle
+ * \param[in]       arm: Set to `1` to start flush timer when buffer holds data
+ */
+static void
+prv_write_end(lwcell_netconn_p nc, uint8_t arm) {
+    lwcell_core_lock();
+    nc->wr_busy = 0;
+    if (arm && nc->buff.buff != NULL && nc->buff.ptr > 0) {
+        if (!lwcell_timeout_is_active(&nc->wr_timeout)) {
+            lwcell_timeout_start(&nc->wr_timeout, LWCELL_CFG_NETCONN_WRITE_FLUSH_DELAY, prv_write_flush_timeout, nc);
+        }
+    } else {
+        lwcell_timeout_stop(&nc->wr_timeout);
+    }
+    lwcell_core_unlock();
+}
+
+#endif /* LWCELL_CFG_NETCONN_WRITE_FLUSH_DELAY > 0 || __DOXYGEN__ */
+
+/**
+ * \brief           Write data to connection output buffers
+ * \note            This function may only be used on TCP or SSL connections
+ * \param[in]       nc: Netconn handle used to write data to
+ * \param[in]       data: Pointer to data to write
+ * \param[in]       btw: Number of bytes to write
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_netconn_write(lwcell_netconn_p nc, const void* data, size_t btw) {
+    return lwcell_netconn_write_ex(nc, data, btw, 0);
+}
+
 /**
  * \brief           Extended version of \ref lwcell_netconn_write with additional
  *                  option to set custom flags.
@@ -406,12 +787,26 @@ lwcell_netconn_write(lwcell_netconn_p nc, const void* data, size_t btw) {
  */
 lwcellr_t
 lwcell_netconn_write_ex(lwcell_netconn_p nc, const void* data, size_t btw, uint16_t flags) {
-    lwcellr_t res = lwcell_netconn_write(nc, data, btw);
+    lwcellr_t res;
+
+    LWCELL_ASSERT(nc != NULL);
+    LWCELL_ASSERT(nc->type == LWCELL_NETCONN_TYPE_TCP || nc->type == LWCELL_NETCONN_TYPE_SSL);
+    LWCELL_ASSERT(lwcell_conn_is_active(nc->conn));
+
+#if LWCELL_CFG_NETCONN_WRITE_FLUSH_DELAY > 0
+    prv_write_begin(nc);
+#endif /* LWCELL_CFG_NETCONN_WRITE_FLUSH_DELAY > 0 */
+    res = prv_write(nc, data, btw);
     if (res == lwcellOK) {
         if (flags & LWCELL_NETCONN_FLAG_FLUSH) {
-            res = lwcell_netconn_flush(nc);
+            res = prv_flush(nc);
         }
     }
+#if LWCELL_CFG_NETCONN_WRITE_FLUSH_DELAY > 0
+    prv_write_end(nc, !(flags & LWCELL_NETCONN_FLAG_MORE));
+#else  /* LWCELL_CFG_NETCONN_WRITE_FLUSH_DELAY > 0 */
+    LWCELL_UNUSED(flags);
+#endif /* !(LWCELL_CFG_NETCONN_WRITE_FLUSH_DELAY > 0) */
     return res;
 }
 
@@ -423,23 +818,59 @@ lwcell_netconn_write_ex(lwcell_netconn_p nc, const void* data, size_t btw, uint1
  */
 lwcellr_t
 lwcell_netconn_flush(lwcell_netconn_p nc) {
+    lwcellr_t res;
+
     LWCELL_ASSERT(nc != NULL);
     LWCELL_ASSERT(nc->type == LWCELL_NETCONN_TYPE_TCP || nc->type == LWCELL_NETCONN_TYPE_SSL);
     LWCELL_ASSERT(lwcell_conn_is_active(nc->conn));
 
-    /*
-     * In case we have data in write buffer,
-     * flush them out to network
-     */
-    if (nc->buff.buff != NULL) {                                             /* Check remaining data */
-        if (nc->buff.ptr > 0) {                                              /* Do we have data in current buffer? */
-            lwcell_conn_send(nc->conn, nc->buff.buff, nc->buff.ptr, NULL, 1); /* Send data */
-        }
-        lwcell_mem_free_s((void**)&nc->buff.buff);
+#if LWCELL_CFG_NETCONN_WRITE_FLUSH_DELAY > 0
+    prv_write_begin(nc);
+#endif /* LWCELL_CFG_NETCONN_WRITE_FLUSH_DELAY > 0 */
+    res = prv_flush(nc);
+#if LWCELL_CFG_NETCONN_WRITE_FLUSH_DELAY > 0
+    prv_write_end(nc, 0);
+#endif /* LWCELL_CFG_NETCONN_WRITE_FLUSH_DELAY > 0 */
+    return res;
+}
+
+#if LWCELL_CFG_COMPRESS || __DOXYGEN__
+
+/**
+ * \brief           Compress data and write frames to connection output buffers
+ *
+ * Data is split to blocks of \ref LWCELL_CFG_COMPRESS_BLOCK_LEN bytes and each block
+ * is written as single frame with \ref lwcell_netconn_write.
+ * Receiver restores data with \ref lwcell_decompress_feed_pbuf.
+ *
+ * \note            This function may only be used on TCP or SSL connections
+ * \param[in]       nc: Netconn handle used to write data to
+ * \param[in]       comp: Compressor state, used by one thread at a time
+ * \param[in]       data: Pointer to data to write
+ * \param[in]       btw: Number of bytes to write
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_netconn_write_compressed(lwcell_netconn_p nc, lwcell_compress_t* comp, const void* data, size_t btw) {
+    const uint8_t* d = data;
+    size_t len;
+    lwcellr_t res = lwcellOK;
+
+    LWCELL_ASSERT(nc != NULL);
+    LWCELL_ASSERT(comp != NULL);
+    LWCELL_ASSERT(data != NULL || btw == 0);
+
+    while (res == lwcellOK && btw > 0) {
+        len = LWCELL_MIN(btw, (size_t)LWCELL_CFG_COMPRESS_BLOCK_LEN);
+        res = lwcell_netconn_write(nc, comp->frame, lwcell_compress_frame(comp, d, len));
+        d += len;
+        btw -= len;
     }
-    return lwcellOK;
+    return res;
 }
 
+#endif /* LWCELL_CFG_COMPRESS || __DOXYGEN__ */
+
 /**
  * \brief           Send data on \e UDP connection to default IP and port
  * \param[in]       nc: Netconn handle used to send
@@ -475,8 +906,62 @@ lwcell_netconn_sendto(lwcell_netconn_p nc, const lwcell_ip_t* ip, lwcell_port_t
     return lwcell_conn_sendto(nc->conn, ip, port, data, btw, NULL, 1);
 }
 
+/**
+ * \brief           Get next packet from receive queue
+ * \param[in]       nc: Netconn handle used to receive from
+ * \param[out]      pbuf: Pointer to pointer to save new receive buffer to
+ * \param[in]       timeout: Maximal time to wait in units of milliseconds, `0` to wait forever
+ *                      or \ref LWCELL_NETCONN_RECEIVE_NO_WAIT to check queue only
+ * \return          \ref lwcellOK when new data ready,
+ * \return          \ref lwcellCLOSED when connection closed by remote side,
+ * \return          \ref lwcellTIMEOUT when receive timeout occurs
+ */
+static lwcellr_t
+prv_receive(lwcell_netconn_p nc, lwcell_pbuf_p* pbuf, uint32_t timeout) {
+    *pbuf = NULL;
+    if (timeout == LWCELL_NETCONN_RECEIVE_NO_WAIT) {
+        if (!lwcell_sys_mbox_getnow(&nc->mbox_receive, (void**)pbuf)) {
+            return lwcellTIMEOUT;
+        }
+    } else if (lwcell_sys_mbox_get(&nc->mbox_receive, (void**)pbuf, timeout) == LWCELL_SYS_TIMEOUT) {
+        return lwcellTIMEOUT;
+    }
+
+#if LWCELL_CFG_NETCONN_POLL || LWCELL_CFG_NETCONN_RECEIVE_COALESCE_LEN > 0
+    /* Packet left the queue, it must be detached before it is read */
+    lwcell_core_lock();
+#if LWCELL_CFG_NETCONN_POLL
+    if (nc->rcv_queued > 0) {
+        --nc->rcv_queued;
+    }
+#endif /* LWCELL_CFG_NETCONN_POLL */
+#if LWCELL_CFG_NETCONN_RECEIVE_COALESCE_LEN > 0
+    if (nc->rcv_tail == *pbuf) {
+        nc->rcv_tail = NULL; /* No more chaining to packet owned by application */
+    }
+#endif /* LWCELL_CFG_NETCONN_RECEIVE_COALESCE_LEN > 0 */
+    lwcell_core_unlock();
+#endif /* LWCELL_CFG_NETCONN_POLL || LWCELL_CFG_NETCONN_RECEIVE_COALESCE_LEN > 0 */
+
+    /* Check if connection closed */
+    if ((uint8_t*)(*pbuf) == (uint8_t*)&recv_closed) {
+        *pbuf = NULL; /* Reset pbuf */
+        return lwcellCLOSED;
+    }
+#if LWCELL_CFG_CONN_MANUAL_RECV
+    /* Data left receive queue, return window to connection */
+    if (nc->conn != NULL) {
+        lwcell_conn_recved(nc->conn, *pbuf);
+    }
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV */
+    return lwcellOK; /* We have data available */
+}
+
 /**
  * \brief           Receive data from connection
+ *
+ * Rest of packet partially consumed by \ref lwcell_netconn_read is returned first
+ *
  * \param[in]       nc: Netconn handle used to receive from
  * \param[in]       pbuf: Pointer to pointer to save new receive buffer to.
  *                     When function returns, user must check for valid pbuf value `pbuf != NULL`
@@ -490,30 +975,118 @@ lwcell_netconn_receive(lwcell_netconn_p nc, lwcell_pbuf_p* pbuf) {
     LWCELL_ASSERT(nc != NULL);
     LWCELL_ASSERT(pbuf != NULL);
 
-    *pbuf = NULL;
+    if (nc->rd_pbuf != NULL) {
+        *pbuf = nc->rd_pbuf;
+        nc->rd_pbuf = NULL;
+        return lwcellOK;
+    }
 #if LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT
     /*
      * Wait for new received data for up to specific timeout
      * or throw error for timeout notification
      */
-    if (nc->rcv_timeout == LWCELL_NETCONN_RECEIVE_NO_WAIT) {
-        if (!lwcell_sys_mbox_getnow(&nc->mbox_receive, (void**)pbuf)) {
-            return lwcellTIMEOUT;
-        }
-    } else if (lwcell_sys_mbox_get(&nc->mbox_receive, (void**)pbuf, nc->rcv_timeout) == LWCELL_SYS_TIMEOUT) {
-        return lwcellTIMEOUT;
-    }
+    return prv_receive(nc, pbuf, nc->rcv_timeout);
 #else  /* LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT */
     /* Forever wait for new receive packet */
-    lwcell_sys_mbox_get(&nc->mbox_receive, (void**)pbuf, 0);
+    return prv_receive(nc, pbuf, 0);
 #endif /* !LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT */
+}
 
-    /* Check if connection closed */
-    if ((uint8_t*)(*pbuf) == (uint8_t*)&recv_closed) {
-        *pbuf = NULL; /* Reset pbuf */
-        return lwcellCLOSED;
+/**
+ * \brief           Receive data from connection together with source address of packet
+ *
+ * Source address is reported by device when \ref LWCELL_CFG_CONN_RECV_FROM is enabled,
+ * allowing single UDP netconn to receive datagrams from many peers.
+ * Otherwise remote address of connection is returned
+ *
+ * \param[in]       nc: Netconn handle used to receive from
+ * \param[in]       pbuf: Pointer to pointer to save new receive buffer to
+ * \param[out]      ip: Pointer to output source IP address. Set to `NULL` if not used
+ * \param[out]      port: Pointer to output source port. Set to `NULL` if not used
+ * \return          \ref lwcellOK when new data ready, member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_netconn_receivefrom(lwcell_netconn_p nc, lwcell_pbuf_p* pbuf, lwcell_ip_t* ip, lwcell_port_t* port) {
+    lwcellr_t res;
+
+    res = lwcell_netconn_receive(nc, pbuf);
+    if (res == lwcellOK && *pbuf != NULL) {
+        if (ip != NULL) {
+            *ip = (*pbuf)->ip;
+        }
+        if (port != NULL) {
+            *port = (*pbuf)->port;
+        }
     }
-    return lwcellOK; /* We have data available */
+    return res;
+}
+
+/**
+ * \brief           Read exact number of bytes from connection
+ *
+ * Received packets are copied to linear buffer and freed as soon as they are consumed.
+ * Rest of last packet is kept for next read, that is useful for protocols with small records.
+ *
+ * \param[in]       nc: Netconn handle used to receive from
+ * \param[out]      buf: Buffer to copy data to
+ * \param[in]       len: Number of bytes to read
+ * \param[out]      br: Pointer to output variable to save number of bytes read. Set to `NULL` if not used
+ * \param[in]       timeout: Maximal time for complete read in units of milliseconds, `0` to wait forever
+ *                      or \ref LWCELL_NETCONN_RECEIVE_NO_WAIT to read data already received only
+ * \return          \ref lwcellOK when `len` bytes have been read,
+ * \return          \ref lwcellCLOSED when connection closed by remote side,
+ * \return          \ref lwcellTIMEOUT when not enough data have been received in time
+ */
+lwcellr_t
+lwcell_netconn_read(lwcell_netconn_p nc, void* buf, size_t len, size_t* br, uint32_t timeout) {
+    uint8_t* d = buf;
+    uint32_t start = lwcell_sys_now();
+    size_t rd = 0;
+    lwcellr_t res = lwcellOK;
+
+    LWCELL_ASSERT(nc != NULL);
+    LWCELL_ASSERT(buf != NULL || len == 0);
+
+    while (rd < len) {
+        lwcell_pbuf_p p;
+        const void* data;
+        size_t copy_len, p_len;
+
+        if (nc->rd_pbuf == NULL) {
+            uint32_t wait = timeout;
+
+            if (timeout > 0 && timeout != LWCELL_NETCONN_RECEIVE_NO_WAIT) {
+                uint32_t elapsed = lwcell_sys_now() - start;
+
+                if (elapsed >= timeout) {
+                    res = lwcellTIMEOUT;
+                    break;
+                }
+                wait = timeout - elapsed;
+            }
+            if ((res = prv_receive(nc, &nc->rd_pbuf, wait)) != lwcellOK) {
+                break;
+            }
+        }
+
+        /* Copy from first pbuf in chain and advance it */
+        p = nc->rd_pbuf;
+        data = lwcell_pbuf_get_linear_addr(p, 0, &p_len);
+        copy_len = LWCELL_MIN(len - rd, p_len);
+        if (copy_len > 0) {
+            LWCELL_MEMCPY(&d[rd], data, copy_len);
+            lwcell_pbuf_advance(p, (int)copy_len);
+            rd += copy_len;
+        }
+        if (copy_len == p_len) { /* First pbuf consumed, free it */
+            nc->rd_pbuf = lwcell_pbuf_unchain(p);
+            lwcell_pbuf_free(p);
+        }
+    }
+    if (br != NULL) {
+        *br = rd;
+    }
+    return res;
 }
 
 /**
@@ -552,6 +1125,88 @@ lwcell_netconn_getconnnum(lwcell_netconn_p nc) {
     return -1;
 }
 
+/**
+ * \brief           Check if netconn is connected to remote side
+ *
+ * Connection is considered closed as soon as close event is received,
+ * even if application did not yet read all received data
+ *
+ * \param[in]       nc: Netconn handle
+ * \return          `1` if connected, `0` otherwise
+ */
+uint8_t
+lwcell_netconn_is_connected(lwcell_netconn_p nc) {
+    uint8_t res;
+
+    lwcell_core_lock();
+    res = nc != NULL && nc->conn != NULL && lwcell_conn_is_active(nc->conn) && lwcell_conn_get_arg(nc->conn) == nc;
+    lwcell_core_unlock();
+    return res;
+}
+
+#if LWCELL_CFG_NETCONN_POLL || __DOXYGEN__
+
+/**
+ * \brief           Wait for receive readiness on multiple netconns
+ *
+ * Function returns as soon as at least one netconn has data or close event
+ * waiting in receive queue, so that \ref lwcell_netconn_receive does not block on it.
+ *
+ * \note            Only one thread shall poll at a time, as readiness notification is shared
+ * \param[in,out]   fds: Array of poll entries. `ready` member is updated for every entry
+ * \param[in]       fds_len: Number of entries in array
+ * \param[in]       timeout: Timeout in units of milliseconds.
+ *                      Set to `0` to wait until at least one netconn is ready.
+ *                      Set to \ref LWCELL_NETCONN_RECEIVE_NO_WAIT to only check current state
+ * \param[out]      ready_cnt: Optional pointer to output number of ready entries. Can be set to `NULL`
+ * \return          \ref lwcellOK when at least one netconn is ready,
+ *                  \ref lwcellTIMEOUT when none got ready in time,
+ *                  member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_netconn_poll(lwcell_netconn_poll_t* fds, size_t fds_len, uint32_t timeout, size_t* ready_cnt) {
+    uint32_t waited, remaining = timeout;
+    size_t cnt;
+
+    LWCELL_ASSERT(fds != NULL);
+    LWCELL_ASSERT(fds_len > 0);
+
+    while (1) {
+        cnt = 0;
+        lwcell_core_lock();
+        for (size_t i = 0; i < fds_len; ++i) {
+            fds[i].ready = fds[i].nc != NULL && (fds[i].nc->rcv_queued > 0 || fds[i].nc->rd_pbuf != NULL);
+            cnt += fds[i].ready;
+        }
+        lwcell_core_unlock();
+        if (cnt > 0 || timeout == LWCELL_NETCONN_RECEIVE_NO_WAIT) {
+            break;
+        }
+
+        /*
+         * Semaphore keeps token released between scan and wait,
+         * so no readiness change is lost. Stale token only causes another scan
+         */
+        waited = lwcell_sys_sem_wait(&poll_sem, remaining);
+        if (waited == LWCELL_SYS_TIMEOUT) {
+            break;
+        }
+        if (timeout > 0) {
+            if (waited >= remaining) {
+                timeout = LWCELL_NETCONN_RECEIVE_NO_WAIT; /* Time is up, scan once more without waiting */
+            } else {
+                remaining -= waited;
+            }
+        }
+    }
+    if (ready_cnt != NULL) {
+        *ready_cnt = cnt;
+    }
+    return cnt > 0 ? lwcellOK : lwcellTIMEOUT;
+}
+
+#endif /* LWCELL_CFG_NETCONN_POLL || __DOXYGEN__ */
+
 #if LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT || __DOXYGEN__
 
 /**
@@ -0,0 +1,355 @@
+/**
+ * \file            lwcell_netconn_pool.c
+ * \brief           Pool of persistent netconn connections
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include <string.h>
+#include "lwcell/lwcell_netconn_pool.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_NETCONN_POOL || __DOXYGEN__
+
+/* Check conditions */
+#if !LWCELL_CFG_NETCONN
+#error "LWCELL_CFG_NETCONN must be enabled for NETCONN pool API!"
+#endif /* !LWCELL_CFG_NETCONN */
+
+/**
+ * \brief           Pool entry structure
+ */
+typedef struct lwcell_netconn_pool {
+    const lwcell_netconn_pool_endpoint_t* ep; /*!< Endpoint description, `NULL` when entry is free */
+    lwcell_netconn_p nc;                      /*!< Netconn handle, `NULL` when not connected */
+    uint8_t in_use;                           /*!< Set to `1` when entry is acquired by application */
+} lwcell_netconn_pool_t;
+
+static lwcell_netconn_pool_t pool[LWCELL_CFG_NETCONN_POOL_SIZE];
+
+/**
+ * \brief           Find pool entry by endpoint name
+ * \note            Core must be locked before calling this function
+ * \param[in]       name: Endpoint name
+ * \return          Pool entry on success, `NULL` otherwise
+ */
+static lwcell_netconn_pool_t*
+pool_find(const char* name) {
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(pool); ++i) {
+        if (pool[i].ep != NULL && !strcmp(pool[i].ep->name, name)) {
+            return &pool[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Make sure entry has connected netconn
+ *
+ * Closed netconn is deleted and new one is connected to endpoint
+ *
+ * \param[in]       e: Pool entry, owned by caller
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+pool_connect(lwcell_netconn_pool_t* e) {
+    lwcellr_t res;
+
+    if (e->nc != NULL) {
+        if (lwcell_netconn_is_connected(e->nc)) {
+            return lwcellOK; /* Reuse existing connection */
+        }
+        lwcell_netconn_delete(e->nc); /* Drop closed connection with its pending data */
+        e->nc = NULL;
+    }
+    if ((e->nc = lwcell_netconn_new(e->ep->type)) == NULL) {
+        return lwcellERRMEM;
+    }
+#if LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT
+    lwcell_netconn_set_receive_timeout(e->nc, e->ep->rcv_timeout);
+#endif /* LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT */
+    LWCELL_DEBUGF(LWCELL_CFG_DBG_NETCONN | LWCELL_DBG_TYPE_TRACE, "[LWCELL NETCONN POOL] Connecting endpoint %s\r\n",
+                  e->ep->name);
+    if ((res = lwcell_netconn_connect(e->nc, e->ep->host, e->ep->port)) != lwcellOK) {
+        lwcell_netconn_delete(e->nc);
+        e->nc = NULL;
+    }
+    return res;
+}
+
+/**
+ * \brief           Close and delete netconn of pool entry
+ * \param[in]       e: Pool entry, owned by caller
+ */
+static void
+pool_disconnect(lwcell_netconn_pool_t* e) {
+    if (e->nc != NULL) {
+        if (lwcell_netconn_is_connected(e->nc)) {
+            lwcell_netconn_close(e->nc);
+        }
+        lwcell_netconn_delete(e->nc);
+        e->nc = NULL;
+    }
+}
+
+/**
+ * \brief           Add endpoint to pool
+ *
+ * When \ref lwcell_netconn_pool_endpoint_t::keep_warm is set, connection is opened immediately.
+ * Failed warm-up does not remove endpoint, connection is retried on first acquire.
+ *
+ * \param[in]       ep: Endpoint description. Must stay valid until endpoint is removed
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_netconn_pool_add(const lwcell_netconn_pool_endpoint_t* ep) {
+    lwcell_netconn_pool_t* e = NULL;
+
+    LWCELL_ASSERT(ep != NULL);
+    LWCELL_ASSERT(ep->name != NULL);
+    LWCELL_ASSERT(ep->host != NULL);
+    LWCELL_ASSERT(ep->port > 0);
+
+    lwcell_core_lock();
+    if (pool_find(ep->name) != NULL) {
+        lwcell_core_unlock();
+        return lwcellERRPAR; /* Name must be unique */
+    }
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(pool); ++i) {
+        if (pool[i].ep == NULL) {
+            e = &pool[i];
+            e->ep = ep;
+            e->in_use = ep->keep_warm; /* Keep entry for us during warm-up */
+            break;
+        }
+    }
+    lwcell_core_unlock();
+    if (e == NULL) {
+        return lwcellERRMEM;
+    }
+
+    if (ep->keep_warm) {
+        pool_connect(e); /* Ignore result, connection is retried lazily */
+        lwcell_core_lock();
+        e->in_use = 0;
+        lwcell_core_unlock();
+    }
+    return lwcellOK;
+}
+
+/**
+ * \brief           Remove endpoint from pool and close its connection
+ * \param[in]       name: Endpoint name
+ * \return          \ref lwcellOK on success, \ref lwcellINPROG when entry is acquired,
+ *                  member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_netconn_pool_remove(const char* name) {
+    lwcell_netconn_pool_t* e;
+
+    LWCELL_ASSERT(name != NULL);
+
+    lwcell_core_lock();
+    if ((e = pool_find(name)) == NULL) {
+        lwcell_core_unlock();
+        return lwcellERRPAR;
+    }
+    if (e->in_use) {
+        lwcell_core_unlock();
+        return lwcellINPROG;
+    }
+    e->in_use = 1;
+    lwcell_core_unlock();
+
+    pool_disconnect(e);
+
+    lwcell_core_lock();
+    e->ep = NULL;
+    e->in_use = 0;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+/**
+ * \brief           Acquire endpoint for exclusive use
+ *
+ * Idle connection is reused when still open, otherwise new connection is started.
+ * Function blocks until connection is ready.
+ *
+ * \param[in]       name: Endpoint name
+ * \param[out]      entry: Pointer to save pool entry handle to
+ * \return          \ref lwcellOK on success, \ref lwcellINPROG when entry is acquired by other thread,
+ *                  member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_netconn_pool_acquire(const char* name, lwcell_netconn_pool_p* entry) {
+    lwcell_netconn_pool_t* e;
+    lwcellr_t res;
+
+    LWCELL_ASSERT(name != NULL);
+    LWCELL_ASSERT(entry != NULL);
+
+    *entry = NULL;
+    lwcell_core_lock();
+    if ((e = pool_find(name)) == NULL) {
+        lwcell_core_unlock();
+        return lwcellERRPAR;
+    }
+    if (e->in_use) {
+        lwcell_core_unlock();
+        return lwcellINPROG;
+    }
+    e->in_use = 1;
+    lwcell_core_unlock();
+
+    if ((res = pool_connect(e)) == lwcellOK) {
+        *entry = e;
+    } else {
+        lwcell_core_lock();
+        e->in_use = 0;
+        lwcell_core_unlock();
+    }
+    return res;
+}
+
+/**
+ * \brief           Return entry back to pool
+ *
+ * Open connection stays open for next exchange.
+ * Unread received data are dropped, so next user does not read stale response.
+ * Closed connection of warm endpoint is reopened before function returns.
+ *
+ * \param[in]       entry: Pool entry handle
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_netconn_pool_release(lwcell_netconn_pool_p entry) {
+    LWCELL_ASSERT(entry != NULL);
+    LWCELL_ASSERT(entry->in_use);
+
+#if LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT
+    if (entry->nc != NULL && lwcell_netconn_is_connected(entry->nc)) {
+        lwcell_pbuf_p pbuf;
+
+        lwcell_netconn_set_receive_timeout(entry->nc, LWCELL_NETCONN_RECEIVE_NO_WAIT);
+        while (lwcell_netconn_receive(entry->nc, &pbuf) == lwcellOK) {
+            lwcell_pbuf_free_s(&pbuf);
+        }
+        lwcell_netconn_set_receive_timeout(entry->nc, entry->ep->rcv_timeout);
+    }
+#endif /* LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT */
+    if (entry->nc != NULL && !lwcell_netconn_is_connected(entry->nc)) {
+        lwcell_netconn_delete(entry->nc);
+        entry->nc = NULL;
+    }
+    if (entry->nc == NULL && entry->ep->keep_warm) {
+        pool_connect(entry); /* Ignore result, connection is retried lazily */
+    }
+
+    lwcell_core_lock();
+    entry->in_use = 0;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+/**
+ * \brief           Send data to endpoint
+ *
+ * When connection was closed by remote side, it is reopened
+ * and complete data buffer is sent again on new connection.
+ * Data are flushed to device before function returns.
+ *
+ * \param[in]       entry: Pool entry handle
+ * \param[in]       data: Data to send
+ * \param[in]       btw: Number of bytes to send
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_netconn_pool_send(lwcell_netconn_pool_p entry, const void* data, size_t btw) {
+    lwcellr_t res = lwcellERR;
+
+    LWCELL_ASSERT(entry != NULL);
+    LWCELL_ASSERT(entry->in_use);
+    LWCELL_ASSERT(data != NULL);
+    LWCELL_ASSERT(btw > 0);
+
+    /* Second attempt is allowed only when first one failed due to closed connection */
+    for (size_t i = 0; i < 2; ++i) {
+        if ((res = pool_connect(entry)) != lwcellOK) {
+            break;
+        }
+        if (entry->ep->type == LWCELL_NETCONN_TYPE_UDP) {
+            res = lwcell_netconn_send(entry->nc, data, btw);
+        } else {
+            res = lwcell_netconn_write_ex(entry->nc, data, btw, LWCELL_NETCONN_FLAG_FLUSH);
+        }
+        if (res == lwcellOK || lwcell_netconn_is_connected(entry->nc)) {
+            break;
+        }
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_NETCONN | LWCELL_DBG_TYPE_TRACE,
+                      "[LWCELL NETCONN POOL] Endpoint %s closed during send, replaying data\r\n", entry->ep->name);
+    }
+    return res;
+}
+
+/**
+ * \brief           Receive data from endpoint
+ *
+ * On \ref lwcellCLOSED result, connection is reopened on next send
+ *
+ * \param[in]       entry: Pool entry handle
+ * \param[out]      pbuf: Pointer to save received buffer to
+ * \return          Result of \ref lwcell_netconn_receive
+ */
+lwcellr_t
+lwcell_netconn_pool_receive(lwcell_netconn_pool_p entry, lwcell_pbuf_p* pbuf) {
+    LWCELL_ASSERT(entry != NULL);
+    LWCELL_ASSERT(entry->in_use);
+    LWCELL_ASSERT(pbuf != NULL);
+
+    if (entry->nc == NULL) {
+        *pbuf = NULL;
+        return lwcellCLOSED;
+    }
+    return lwcell_netconn_receive(entry->nc, pbuf);
+}
+
+/**
+ * \brief           Get netconn handle of acquired entry
+ * \note            Handle may change after \ref lwcell_netconn_pool_send reconnects
+ * \param[in]       entry: Pool entry handle
+ * \return          Netconn handle or `NULL` when not connected
+ */
+lwcell_netconn_p
+lwcell_netconn_pool_get_netconn(lwcell_netconn_pool_p entry) {
+    LWCELL_ASSERT0(entry != NULL);
+    return entry->nc;
+}
+
+#endif /* LWCELL_CFG_NETCONN_POOL || __DOXYGEN__ */
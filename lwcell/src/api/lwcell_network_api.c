@@ -42,6 +42,57 @@ static const char* network_apn;
 static const char* network_user;
 static const char* network_pass;
 static uint32_t network_counter;
+static uint8_t network_busy; /* Set to `1` while attach or detach command of manager is in progress */
+
+/**
+ * \brief           Wait for attach or detach command of manager to finish
+ * \note            Core must be locked when calling this function, it stays locked on return
+ */
+static void
+prv_wait_busy(void) {
+    while (network_busy) {
+        lwcell_core_unlock();
+        lwcell_delay(10);
+        lwcell_core_lock();
+    }
+}
+
+#if LWCELL_CFG_NETWORK_IDLE_DETACH_TIMEOUT > 0
+
+static void prv_busy_evt_fn(lwcellr_t res, void* arg);
+
+/**
+ * \brief           Idle timeout callback, detach when network is still not used
+ * \param[in]       arg: Unused
+ */
+static void
+prv_idle_detach_fn(void* arg) {
+    LWCELL_UNUSED(arg);
+    if (network_counter == 0 && !network_busy && lwcell_network_is_attached()) {
+        if (lwcell_network_detach(prv_busy_evt_fn, NULL, 0) == lwcellOK) {
+            network_busy = 1;
+        }
+    }
+}
+
+#endif /* LWCELL_CFG_NETWORK_IDLE_DETACH_TIMEOUT > 0 */
+
+/**
+ * \brief           Background attach or detach finished callback
+ * \param[in]       res: Command result
+ * \param[in]       arg: Unused
+ */
+static void
+prv_busy_evt_fn(lwcellr_t res, void* arg) {
+    LWCELL_UNUSED(res);
+    LWCELL_UNUSED(arg);
+    network_busy = 0;
+#if LWCELL_CFG_NETWORK_IDLE_DETACH_TIMEOUT > 0
+    if (network_counter == 0 && lwcell_network_is_attached()) {
+        lwcell_timeout_add(LWCELL_CFG_NETWORK_IDLE_DETACH_TIMEOUT, prv_idle_detach_fn, NULL);
+    }
+#endif /* LWCELL_CFG_NETWORK_IDLE_DETACH_TIMEOUT > 0 */
+}
 
 /**
  * \brief           Set system network credentials before asking for attach
@@ -61,6 +112,10 @@ lwcell_network_set_credentials(const char* apn, const char* user, const char* pa
 
 /**
  * \brief           Request manager to attach to network
+ *
+ * Every successful call takes one reference of network access,
+ * released with \ref lwcell_network_request_detach
+ *
  * \note            This function is blocking and cannot be called from event functions
  * \return          \ref lwcellOK on success (when attached), member of \ref lwcellr_t otherwise
  */
@@ -71,9 +126,14 @@ lwcell_network_request_attach(void) {
 
     /* Check if we need to connect */
     lwcell_core_lock();
+#if LWCELL_CFG_NETWORK_IDLE_DETACH_TIMEOUT > 0
+    lwcell_timeout_remove(prv_idle_detach_fn); /* Network is used again */
+#endif /* LWCELL_CFG_NETWORK_IDLE_DETACH_TIMEOUT > 0 */
+    prv_wait_busy();
     if (network_counter == 0) {
         if (!lwcell_network_is_attached()) {
             do_conn = 1;
+            network_busy = 1; /* Other threads wait for result */
         }
     }
     if (!do_conn) {
@@ -84,20 +144,49 @@ lwcell_network_request_attach(void) {
     /* Connect to network */
     if (do_conn) {
         res = lwcell_network_attach(network_apn, network_user, network_pass, NULL, NULL, 1);
+        lwcell_core_lock();
         if (res == lwcellOK) {
-            lwcell_core_lock();
             ++network_counter;
-            lwcell_core_unlock();
         }
+        network_busy = 0;
+        lwcell_core_unlock();
     }
     return res;
 }
 
+/**
+ * \brief           Request manager to attach to network in background, before network is needed
+ *
+ * PDP context is activated without taking a reference, so later \ref lwcell_network_request_attach
+ * returns without waiting for attach sequence.
+ * When \ref LWCELL_CFG_NETWORK_IDLE_DETACH_TIMEOUT is enabled and nobody requests network
+ * within the timeout after attach, manager detaches again
+ *
+ * \note            This function is non-blocking and can be called from event functions
+ * \return          \ref lwcellOK on success (attach started or already attached), member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_network_request_preattach(void) {
+    lwcellr_t res = lwcellOK;
+
+    lwcell_core_lock();
+    if (!network_busy && network_counter == 0 && !lwcell_network_is_attached()) {
+        res = lwcell_network_attach(network_apn, network_user, network_pass, prv_busy_evt_fn, NULL, 0);
+        if (res == lwcellOK) {
+            network_busy = 1;
+        }
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
 /**
  * \brief           Request manager to detach from network
  *
  * If other threads use network, manager will not disconnect from network
- * otherwise it will disable network access
+ * otherwise it will disable network access.
+ * When \ref LWCELL_CFG_NETWORK_IDLE_DETACH_TIMEOUT is enabled,
+ * network access is disabled after timeout if it is not requested again in the meantime
  *
  * \note            This function is blocking and cannot be called from event functions
  * \return          \ref lwcellOK on success (when attached), member of \ref lwcellr_t otherwise
@@ -109,23 +198,28 @@ lwcell_network_request_detach(void) {
 
     /* Check if we need to disconnect */
     lwcell_core_lock();
+    prv_wait_busy();
     if (network_counter > 0) {
-        if (network_counter == 1) {
+        if (--network_counter == 0) {
+#if LWCELL_CFG_NETWORK_IDLE_DETACH_TIMEOUT > 0
+            res = lwcell_timeout_add(LWCELL_CFG_NETWORK_IDLE_DETACH_TIMEOUT, prv_idle_detach_fn, NULL);
+#else  /* LWCELL_CFG_NETWORK_IDLE_DETACH_TIMEOUT > 0 */
             do_disconn = 1;
-        } else {
-            --network_counter;
+            network_busy = 1; /* Other threads wait for result */
+#endif /* !(LWCELL_CFG_NETWORK_IDLE_DETACH_TIMEOUT > 0) */
         }
     }
     lwcell_core_unlock();
 
-    /* Connect to network */
+    /* Disconnect from network */
     if (do_disconn) {
         res = lwcell_network_detach(NULL, NULL, 1);
-        if (res == lwcellOK) {
-            lwcell_core_lock();
-            --network_counter;
-            lwcell_core_unlock();
+        lwcell_core_lock();
+        if (res != lwcellOK) {
+            ++network_counter; /* Network is still attached */
         }
+        network_busy = 0;
+        lwcell_core_unlock();
     }
     return res;
 }
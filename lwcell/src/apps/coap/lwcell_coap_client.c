@@ -0,0 +1,759 @@
+/**
+ * \file            lwcell_coap_client.c
+ * \brief           CoAP client
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/apps/lwcell_coap_client.h"
+#include "lwcell/lwcell.h"
+#include "lwcell/lwcell_timeout.h"
+
+#if LWCELL_CFG_COAP || __DOXYGEN__
+
+/* Tracing debug message */
+#define LWCELL_CFG_DBG_COAP_TRACE         (LWCELL_CFG_DBG_COAP | LWCELL_DBG_TYPE_TRACE)
+#define LWCELL_CFG_DBG_COAP_TRACE_WARNING (LWCELL_CFG_DBG_COAP | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING)
+
+/* Message types */
+#define COAP_TYPE_CON              0x00
+#define COAP_TYPE_NON              0x01
+#define COAP_TYPE_ACK              0x02
+#define COAP_TYPE_RST              0x03
+
+/* Option numbers, in ascending order */
+#define COAP_OPT_OBSERVE           6
+#define COAP_OPT_URI_PATH          11
+#define COAP_OPT_CONTENT_FORMAT    12
+#define COAP_OPT_BLOCK2            23
+#define COAP_OPT_BLOCK1            27
+
+#define COAP_VERSION               0x40
+#define COAP_TOKEN_LEN             4
+#define COAP_PAYLOAD_MARKER        0xFF
+#define COAP_CODE_CONTINUE         LWCELL_COAP_CODE(2, 31)
+#define COAP_BLOCK_LEN(szx)        ((size_t)16 << (szx))
+
+/* Number of buffers for empty acknowledge and reset messages, sent without waiting */
+#define COAP_EMPTY_MSG_CNT         4
+
+/**
+ * \brief           Single request entry
+ */
+typedef struct {
+    struct lwcell_coap_client* client; /*!< Client owning the entry */
+    lwcell_coap_request_t req;         /*!< Request descriptor */
+    void* arg;                         /*!< Request argument */
+    lwcell_timeout_t to;               /*!< Retransmission and response timeout */
+    uint32_t token;                    /*!< Request token */
+    uint32_t timeout;                  /*!< Current retransmission timeout in units of milliseconds */
+    uint32_t block1_num;               /*!< Number of request block being sent */
+    uint32_t block2_num;               /*!< Number of response block requested */
+    uint16_t mid;                      /*!< Message ID of last sent message */
+    uint16_t rx_mid;                   /*!< Message ID of last processed response, to skip duplicates */
+    uint8_t block1_szx;                /*!< Size exponent of request blocks */
+    uint8_t block2_szx;                /*!< Size exponent of response blocks */
+    uint8_t in_use;                    /*!< Set to `1` when entry is used */
+    uint8_t wait_ack;                  /*!< Set to `1` while confirmable message is not acknowledged */
+    uint8_t retries;                   /*!< Number of retransmissions of current message */
+    uint8_t observing;                 /*!< Set to `1` when server accepted observation */
+    uint8_t rx_valid;                  /*!< Set to `1` when `rx_mid` is valid */
+    size_t msg_len;                    /*!< Length of encoded message */
+    uint8_t msg[LWCELL_CFG_COAP_MSG_LEN]; /*!< Encoded message, kept for retransmission */
+} lwcell_coap_req_t;
+
+/**
+ * \brief           CoAP client structure
+ */
+typedef struct lwcell_coap_client {
+    lwcell_conn_p conn;                                 /*!< UDP connection */
+    lwcell_coap_client_evt_fn evt_fn;                   /*!< Event callback function */
+    void* arg;                                          /*!< User argument */
+    uint32_t token;                                     /*!< Next token value */
+    uint16_t mid;                                       /*!< Next message ID */
+    uint8_t empty_msg[COAP_EMPTY_MSG_CNT][4];           /*!< Empty messages being sent */
+    uint8_t empty_idx;                                  /*!< Next empty message buffer */
+    lwcell_coap_req_t reqs[LWCELL_CFG_COAP_MAX_REQUESTS]; /*!< Request entries */
+} lwcell_coap_client_t;
+
+/**
+ * \brief           Parsed received message
+ */
+typedef struct {
+    uint8_t type;           /*!< Message type */
+    uint8_t code;           /*!< Message code */
+    uint16_t mid;           /*!< Message ID */
+    uint8_t tkl;            /*!< Token length */
+    uint32_t token;         /*!< Token value, valid when `tkl` equals \ref COAP_TOKEN_LEN */
+    uint32_t block1;        /*!< Value of `Block1` option */
+    uint32_t block2;        /*!< Value of `Block2` option */
+    uint8_t has_block1;     /*!< Set to `1` when `Block1` option is present */
+    uint8_t has_block2;     /*!< Set to `1` when `Block2` option is present */
+    uint8_t has_observe;    /*!< Set to `1` when `Observe` option is present */
+    size_t payload_off;     /*!< Offset of payload in packet buffer */
+    size_t payload_len;     /*!< Payload length */
+} lwcell_coap_msg_t;
+
+static void prv_req_timeout(void* arg);
+
+/**
+ * \brief           Encode option delta or length nibble and its extended bytes
+ * \param[in]       val: Value to encode
+ * \param[out]      ext: Extended bytes
+ * \param[out]      ext_len: Number of extended bytes
+ * \return          Nibble value
+ */
+static uint8_t
+prv_opt_nibble(size_t val, uint8_t* ext, size_t* ext_len) {
+    if (val < 13) {
+        return (uint8_t)val;
+    } else if (val < 269) {
+        ext[(*ext_len)++] = LWCELL_U8(val - 13);
+        return 13;
+    }
+    ext[(*ext_len)++] = LWCELL_U8((val - 269) >> 8);
+    ext[(*ext_len)++] = LWCELL_U8(val - 269);
+    return 14;
+}
+
+/**
+ * \brief           Add option to message
+ * \param[in]       req: Request entry with message
+ * \param[in,out]   last: Number of previous option
+ * \param[in]       num: Option number, not lower than previous one
+ * \param[in]       val: Option value
+ * \param[in]       len: Option value length
+ * \return          `1` on success, `0` when message buffer is full
+ */
+static uint8_t
+prv_put_option(lwcell_coap_req_t* req, uint16_t* last, uint16_t num, const void* val, size_t len) {
+    uint8_t ext[4], hdr;
+    size_t ext_len = 0;
+
+    hdr = LWCELL_U8(prv_opt_nibble(num - *last, ext, &ext_len) << 4);
+    hdr |= prv_opt_nibble(len, ext, &ext_len);
+    if (req->msg_len + 1 + ext_len + len > sizeof(req->msg)) {
+        return 0;
+    }
+    req->msg[req->msg_len++] = hdr;
+    LWCELL_MEMCPY(&req->msg[req->msg_len], ext, ext_len);
+    req->msg_len += ext_len;
+    LWCELL_MEMCPY(&req->msg[req->msg_len], val, len);
+    req->msg_len += len;
+    *last = num;
+    return 1;
+}
+
+/**
+ * \brief           Add unsigned integer option to message, with minimal length
+ * \param[in]       req: Request entry with message
+ * \param[in,out]   last: Number of previous option
+ * \param[in]       num: Option number
+ * \param[in]       val: Option value
+ * \return          `1` on success, `0` when message buffer is full
+ */
+static uint8_t
+prv_put_uint_option(lwcell_coap_req_t* req, uint16_t* last, uint16_t num, uint32_t val) {
+    uint8_t d[4];
+    size_t len = 0;
+
+    for (uint8_t shift = 24;; shift -= 8) {
+        if (len > 0 || (val >> shift) > 0) {
+            d[len++] = LWCELL_U8(val >> shift);
+        }
+        if (shift == 0) {
+            break;
+        }
+    }
+    return prv_put_option(req, last, num, d, len);
+}
+
+/**
+ * \brief           Encode current message of request, with new message ID
+ * \param[in]       req: Request entry
+ * \return          \ref lwcellOK on success, \ref lwcellERRMEM when message does not fit to buffer
+ */
+static lwcellr_t
+prv_build_msg(lwcell_coap_req_t* req) {
+    const lwcell_coap_request_t* r = &req->req;
+    const char* seg = r->path;
+    size_t chunk = 0, off = 0, seg_len;
+    uint16_t last = 0;
+    uint8_t ok = 1;
+
+    req->mid = req->client->mid++;
+    req->msg[0] = COAP_VERSION | ((r->confirmable ? COAP_TYPE_CON : COAP_TYPE_NON) << 4) | COAP_TOKEN_LEN;
+    req->msg[1] = (uint8_t)r->method;
+    req->msg[2] = LWCELL_U8(req->mid >> 8);
+    req->msg[3] = LWCELL_U8(req->mid);
+    for (size_t i = 0; i < COAP_TOKEN_LEN; ++i) {
+        req->msg[4 + i] = LWCELL_U8(req->token >> (8 * (COAP_TOKEN_LEN - 1 - i)));
+    }
+    req->msg_len = 4 + COAP_TOKEN_LEN;
+
+    /* Payload is sent only with first response block request */
+    if (r->payload != NULL && req->block2_num == 0) {
+        off = (size_t)req->block1_num * COAP_BLOCK_LEN(req->block1_szx);
+        chunk = LWCELL_MIN(r->payload_len - off, COAP_BLOCK_LEN(req->block1_szx));
+    }
+
+    /* Options in ascending order */
+    if (r->observe && req->block2_num == 0) {
+        ok = ok && prv_put_uint_option(req, &last, COAP_OPT_OBSERVE, 0);
+    }
+    while (ok && seg != NULL && *seg != '\0') {
+        if (*seg == '/') {
+            ++seg;
+            continue;
+        }
+        for (seg_len = 0; seg[seg_len] != '\0' && seg[seg_len] != '/'; ++seg_len) {}
+        ok = prv_put_option(req, &last, COAP_OPT_URI_PATH, seg, seg_len);
+        seg += seg_len;
+    }
+    if (chunk > 0 && r->content_format >= 0) {
+        ok = ok && prv_put_uint_option(req, &last, COAP_OPT_CONTENT_FORMAT, (uint32_t)r->content_format);
+    }
+    if (req->block2_num > 0) {
+        ok = ok && prv_put_uint_option(req, &last, COAP_OPT_BLOCK2, (req->block2_num << 4) | req->block2_szx);
+    }
+    if (chunk > 0 && r->payload_len > COAP_BLOCK_LEN(req->block1_szx)) {
+        ok = ok
+             && prv_put_uint_option(req, &last, COAP_OPT_BLOCK1,
+                                    (req->block1_num << 4) | ((off + chunk < r->payload_len) << 3) | req->block1_szx);
+    }
+    if (!ok || req->msg_len + 1 + chunk > sizeof(req->msg)) {
+        return lwcellERRMEM;
+    }
+    if (chunk > 0) {
+        req->msg[req->msg_len++] = COAP_PAYLOAD_MARKER;
+        LWCELL_MEMCPY(&req->msg[req->msg_len], (const uint8_t*)r->payload + off, chunk);
+        req->msg_len += chunk;
+    }
+    return lwcellOK;
+}
+
+/**
+ * \brief           Encode and send next message of request
+ * \param[in]       req: Request entry
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+static lwcellr_t
+prv_send_req(lwcell_coap_req_t* req) {
+    lwcellr_t res;
+
+    if ((res = prv_build_msg(req)) != lwcellOK) {
+        return res;
+    }
+    req->wait_ack = req->req.confirmable;
+    req->retries = 0;
+    req->timeout = LWCELL_CFG_COAP_ACK_TIMEOUT + (lwcell_sys_now() % (LWCELL_CFG_COAP_ACK_TIMEOUT / 2 + 1));
+    if ((res = lwcell_conn_sendto(req->client->conn, NULL, 0, req->msg, req->msg_len, NULL, 0)) == lwcellOK) {
+        lwcell_timeout_start(&req->to, req->wait_ack ? req->timeout : LWCELL_CFG_COAP_RESPONSE_TIMEOUT,
+                             prv_req_timeout, req);
+    }
+    return res;
+}
+
+/**
+ * \brief           Send empty acknowledge or reset message
+ * \param[in]       client: CoAP client handle
+ * \param[in]       type: \ref COAP_TYPE_ACK or \ref COAP_TYPE_RST
+ * \param[in]       mid: Message ID to answer
+ */
+static void
+prv_send_empty(lwcell_coap_client_p client, uint8_t type, uint16_t mid) {
+    uint8_t* m = client->empty_msg[client->empty_idx];
+
+    client->empty_idx = (client->empty_idx + 1) % COAP_EMPTY_MSG_CNT;
+    m[0] = COAP_VERSION | (type << 4);
+    m[1] = 0;
+    m[2] = LWCELL_U8(mid >> 8);
+    m[3] = LWCELL_U8(mid);
+    lwcell_conn_sendto(client->conn, NULL, 0, m, 4, NULL, 0);
+}
+
+/**
+ * \brief           Release request entry and report error to application
+ * \param[in]       req: Request entry
+ * \param[in]       res: Error result
+ */
+static void
+prv_req_error(lwcell_coap_req_t* req, lwcellr_t res) {
+    lwcell_coap_evt_t evt = {0};
+
+    lwcell_timeout_stop(&req->to);
+    req->in_use = 0;
+
+    LWCELL_DEBUGF(LWCELL_CFG_DBG_COAP_TRACE_WARNING, "[LWCELL COAP] Request failed with result %d\r\n", (int)res);
+    evt.type = LWCELL_COAP_EVT_ERROR;
+    evt.req_arg = req->arg;
+    evt.evt.error.res = res;
+    req->client->evt_fn(req->client, &evt);
+}
+
+/**
+ * \brief           Retransmission or response timeout of request
+ * \param[in]       arg: Request entry
+ */
+static void
+prv_req_timeout(void* arg) {
+    lwcell_coap_req_t* req = arg;
+
+    if (!req->in_use) {
+        return;
+    }
+    if (req->wait_ack && req->retries < LWCELL_CFG_COAP_MAX_RETRANSMIT && req->client->conn != NULL) {
+        ++req->retries;
+        req->timeout *= 2;
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_COAP_TRACE, "[LWCELL COAP] Retransmission %d of message %d\r\n",
+                      (int)req->retries, (int)req->mid);
+        lwcell_conn_sendto(req->client->conn, NULL, 0, req->msg, req->msg_len, NULL, 0);
+        lwcell_timeout_start(&req->to, req->timeout, prv_req_timeout, req);
+    } else {
+        prv_req_error(req, lwcellTIMEOUT);
+    }
+}
+
+/**
+ * \brief           Parse received message header and options
+ * \param[in]       pbuf: Received datagram
+ * \param[out]      msg: Parsed message
+ * \return          `1` on success, `0` for malformed message
+ */
+static uint8_t
+prv_parse_msg(lwcell_pbuf_p pbuf, lwcell_coap_msg_t* msg) {
+    size_t len = lwcell_pbuf_length(pbuf, 1), pos, opt_len, delta;
+    uint8_t b[4];
+    uint32_t val;
+    uint16_t opt = 0;
+
+    if (len < 4 || lwcell_pbuf_copy(pbuf, b, 4, 0) != 4 || (b[0] & 0xC0) != COAP_VERSION) {
+        return 0;
+    }
+    LWCELL_MEMSET(msg, 0x00, sizeof(*msg));
+    msg->type = (b[0] >> 4) & 0x03;
+    msg->tkl = b[0] & 0x0F;
+    msg->code = b[1];
+    msg->mid = (uint16_t)((b[2] << 8) | b[3]);
+    if (msg->tkl > 8 || len < 4U + msg->tkl) {
+        return 0;
+    }
+    pos = 4;
+    for (size_t i = 0; i < msg->tkl; ++i, ++pos) {
+        lwcell_pbuf_get_at(pbuf, pos, b);
+        msg->token = (msg->token << 8) | b[0];
+    }
+
+    /* Options until payload marker or end of message */
+    msg->payload_off = len;
+    while (pos < len) {
+        lwcell_pbuf_get_at(pbuf, pos++, b);
+        if (b[0] == COAP_PAYLOAD_MARKER) {
+            msg->payload_off = pos;
+            break;
+        }
+        delta = b[0] >> 4;
+        opt_len = b[0] & 0x0F;
+        for (size_t i = 0; i < 2; ++i) {
+            size_t* v = i == 0 ? &delta : &opt_len;
+
+            if (*v == 13) {
+                lwcell_pbuf_get_at(pbuf, pos++, b);
+                *v = 13 + b[0];
+            } else if (*v == 14) {
+                lwcell_pbuf_get_at(pbuf, pos++, &b[0]);
+                lwcell_pbuf_get_at(pbuf, pos++, &b[1]);
+                *v = 269 + ((size_t)b[0] << 8) + b[1];
+            } else if (*v == 15) {
+                return 0;
+            }
+        }
+        opt += (uint16_t)delta;
+        if (pos + opt_len > len) {
+            return 0;
+        }
+        val = 0;
+        for (size_t i = 0; i < opt_len && i < 4; ++i) {
+            lwcell_pbuf_get_at(pbuf, pos + i, b);
+            val = (val << 8) | b[0];
+        }
+        if (opt == COAP_OPT_OBSERVE) {
+            msg->has_observe = 1;
+        } else if (opt == COAP_OPT_BLOCK2) {
+            msg->has_block2 = 1;
+            msg->block2 = val;
+        } else if (opt == COAP_OPT_BLOCK1) {
+            msg->has_block1 = 1;
+            msg->block1 = val;
+        }
+        pos += opt_len;
+    }
+    msg->payload_len = len - msg->payload_off;
+    return 1;
+}
+
+/**
+ * \brief           Process response to request
+ * \param[in]       req: Request entry
+ * \param[in]       msg: Parsed response
+ * \param[in]       pbuf: Received datagram
+ */
+static void
+prv_process_response(lwcell_coap_req_t* req, const lwcell_coap_msg_t* msg, lwcell_pbuf_p pbuf) {
+    lwcell_coap_evt_t evt = {0};
+    uint8_t more;
+
+    /* Server is ready for next request block */
+    if (msg->code == COAP_CODE_CONTINUE && msg->has_block1) {
+        uint8_t szx = LWCELL_MIN(msg->block1 & 0x07, req->block1_szx);
+        size_t off = (size_t)((msg->block1 >> 4) + 1) * COAP_BLOCK_LEN(msg->block1 & 0x07);
+
+        if (off < req->req.payload_len) {
+            req->block1_szx = szx;
+            req->block1_num = (uint32_t)(off / COAP_BLOCK_LEN(szx));
+            if (prv_send_req(req) != lwcellOK) {
+                prv_req_error(req, lwcellERR);
+            }
+            return;
+        }
+    }
+
+    more = msg->has_block2 && (msg->block2 & 0x08);
+    if (msg->has_observe && req->req.observe && (msg->code >> 5) == 2) {
+        req->observing = 1;
+    }
+    evt.type = LWCELL_COAP_EVT_RESPONSE;
+    evt.req_arg = req->arg;
+    evt.evt.response.code = msg->code;
+    evt.evt.response.pbuf = pbuf;
+    evt.evt.response.offset = msg->payload_off;
+    evt.evt.response.len = msg->payload_len;
+    evt.evt.response.more = more;
+    evt.evt.response.notify = req->observing;
+    if (msg->has_block2) {
+        evt.evt.response.block_offset = (size_t)(msg->block2 >> 4) * COAP_BLOCK_LEN(msg->block2 & 0x07);
+    }
+
+    /* Request next block, keep observation or release entry before callback */
+    if (more) {
+        req->block2_num = (msg->block2 >> 4) + 1;
+        req->block2_szx = msg->block2 & 0x07;
+        if (prv_send_req(req) != lwcellOK) {
+            more = 0;
+        }
+    }
+    if (!more) {
+        lwcell_timeout_stop(&req->to);
+        if (!req->observing) {
+            req->in_use = 0;
+        }
+    }
+    req->client->evt_fn(req->client, &evt);
+}
+
+/**
+ * \brief           Process received datagram
+ * \param[in]       client: CoAP client handle
+ * \param[in]       pbuf: Received datagram
+ */
+static void
+prv_recv(lwcell_coap_client_p client, lwcell_pbuf_p pbuf) {
+    lwcell_coap_req_t* req = NULL;
+    lwcell_coap_msg_t msg;
+
+    if (!prv_parse_msg(pbuf, &msg)) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_COAP_TRACE_WARNING, "[LWCELL COAP] Malformed message dropped\r\n");
+        return;
+    }
+
+    if (msg.type == COAP_TYPE_ACK || msg.type == COAP_TYPE_RST) {
+        /* Match acknowledge by message ID */
+        for (size_t i = 0; i < LWCELL_ARRAYSIZE(client->reqs); ++i) {
+            if (client->reqs[i].in_use && client->reqs[i].wait_ack && client->reqs[i].mid == msg.mid) {
+                req = &client->reqs[i];
+                break;
+            }
+        }
+        if (req == NULL) {
+            return;
+        }
+        req->wait_ack = 0;
+        if (msg.type == COAP_TYPE_RST) {
+            prv_req_error(req, lwcellERR);
+            return;
+        } else if (msg.code == 0) {
+            /* Empty acknowledge, separate response follows */
+            lwcell_timeout_start(&req->to, LWCELL_CFG_COAP_RESPONSE_TIMEOUT, prv_req_timeout, req);
+            return;
+        }
+    } else {
+        /* Match separate response or notification by token */
+        for (size_t i = 0; msg.tkl == COAP_TOKEN_LEN && i < LWCELL_ARRAYSIZE(client->reqs); ++i) {
+            if (client->reqs[i].in_use && client->reqs[i].token == msg.token) {
+                req = &client->reqs[i];
+                break;
+            }
+        }
+        if (msg.type == COAP_TYPE_CON) {
+            prv_send_empty(client, req != NULL && msg.code != 0 ? COAP_TYPE_ACK : COAP_TYPE_RST, msg.mid);
+        }
+        if (req == NULL || msg.code == 0 || (req->rx_valid && req->rx_mid == msg.mid)) {
+            return; /* Unknown, empty or retransmitted message */
+        }
+        req->wait_ack = 0; /* Response implies acknowledge was lost */
+    }
+    req->rx_valid = 1;
+    req->rx_mid = msg.mid;
+    prv_process_response(req, &msg, pbuf);
+}
+
+/**
+ * \brief           Fail all requests in progress
+ * \param[in]       client: CoAP client handle
+ * \param[in]       res: Result to report
+ */
+static void
+prv_fail_all(lwcell_coap_client_p client, lwcellr_t res) {
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(client->reqs); ++i) {
+        if (client->reqs[i].in_use) {
+            prv_req_error(&client->reqs[i], res);
+        }
+    }
+}
+
+/**
+ * \brief           Connection callback
+ * \param[in]       evt: Callback parameters
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+prv_conn_evt(lwcell_evt_t* evt) {
+    lwcell_coap_client_p client;
+    lwcell_conn_p conn;
+
+    if ((conn = lwcell_conn_get_from_evt(evt)) == NULL || (client = lwcell_conn_get_arg(conn)) == NULL) {
+        return lwcellOK;
+    }
+    switch (lwcell_evt_get_type(evt)) {
+        case LWCELL_EVT_CONN_ACTIVE: {
+            client->conn = conn;
+            break;
+        }
+        case LWCELL_EVT_CONN_RECV: {
+            lwcell_pbuf_p pbuf = lwcell_evt_conn_recv_get_buff(evt);
+
+            prv_recv(client, pbuf);
+            lwcell_conn_recved(conn, pbuf);
+            break;
+        }
+        case LWCELL_EVT_CONN_CLOSE: {
+            client->conn = NULL;
+            prv_fail_all(client, lwcellCLOSED);
+            break;
+        }
+        default: break;
+    }
+    return lwcellOK;
+}
+
+/**
+ * \brief           Create new CoAP client
+ * \param[in]       evt_fn: Event callback function
+ * \param[in]       arg: User argument
+ * \return          Client handle on success, `NULL` otherwise
+ */
+lwcell_coap_client_p
+lwcell_coap_client_new(lwcell_coap_client_evt_fn evt_fn, void* arg) {
+    lwcell_coap_client_p client;
+
+    if (evt_fn == NULL) {
+        return NULL;
+    }
+    if ((client = lwcell_mem_calloc_tag(1, sizeof(*client), LWCELL_MEM_TAG_CONN)) != NULL) {
+        client->evt_fn = evt_fn;
+        client->arg = arg;
+        client->token = lwcell_sys_now() * 2654435761U; /* Tokens differ across restarts */
+        client->mid = (uint16_t)client->token;
+        for (size_t i = 0; i < LWCELL_ARRAYSIZE(client->reqs); ++i) {
+            client->reqs[i].client = client;
+        }
+    }
+    return client;
+}
+
+/**
+ * \brief           Delete client. Connection must be closed first
+ * \param[in]       client: CoAP client handle
+ */
+void
+lwcell_coap_client_delete(lwcell_coap_client_p client) {
+    if (client == NULL) {
+        return;
+    }
+    lwcell_core_lock();
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(client->reqs); ++i) {
+        lwcell_timeout_stop(&client->reqs[i].to);
+    }
+    lwcell_core_unlock();
+    lwcell_mem_free_s((void**)&client);
+}
+
+/**
+ * \brief           Open UDP connection to server
+ * \param[in]       client: CoAP client handle
+ * \param[in]       host: Server host name or IP address
+ * \param[in]       port: Server port, typically `5683`
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_coap_client_connect(lwcell_coap_client_p client, const char* host, lwcell_port_t port, const uint32_t blocking) {
+    lwcell_conn_p conn;
+    lwcellr_t res;
+
+    LWCELL_ASSERT(client != NULL && host != NULL && port > 0);
+
+    if ((res = lwcell_conn_start(&conn, LWCELL_CONN_TYPE_UDP, host, port, client, prv_conn_evt, blocking))
+        == lwcellOK && blocking) {
+        lwcell_core_lock();
+        client->conn = conn;
+        lwcell_core_unlock();
+    }
+    return res;
+}
+
+/**
+ * \brief           Close connection. Requests in progress are reported with \ref lwcellCLOSED error
+ * \param[in]       client: CoAP client handle
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_coap_client_disconnect(lwcell_coap_client_p client) {
+    lwcellr_t res = lwcellCLOSED;
+
+    LWCELL_ASSERT(client != NULL);
+
+    lwcell_core_lock();
+    if (client->conn != NULL) {
+        res = lwcell_conn_close(client->conn, 0);
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Send new request
+ *
+ * Request descriptor is copied, while path and payload it points to must stay valid until request finishes.
+ * Result is reported with \ref LWCELL_COAP_EVT_RESPONSE or \ref LWCELL_COAP_EVT_ERROR event
+ *
+ * \param[in]       client: CoAP client handle
+ * \param[in]       req: Request descriptor
+ * \param[in]       req_arg: Request argument, passed to events. It shall be unique to cancel request
+ * \return          \ref lwcellOK on success, \ref lwcellERRMEM when all entries are used,
+ *                      member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_coap_client_request(lwcell_coap_client_p client, const lwcell_coap_request_t* req, void* req_arg) {
+    lwcell_coap_req_t* r = NULL;
+    lwcellr_t res = lwcellERRMEM;
+
+    LWCELL_ASSERT(client != NULL && req != NULL);
+    LWCELL_ASSERT(req->payload != NULL || req->payload_len == 0);
+
+    lwcell_core_lock();
+    if (client->conn == NULL || !lwcell_conn_is_active(client->conn)) {
+        lwcell_core_unlock();
+        return lwcellCLOSED;
+    }
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(client->reqs); ++i) {
+        if (!client->reqs[i].in_use) {
+            r = &client->reqs[i];
+            break;
+        }
+    }
+    if (r != NULL) {
+        r->req = *req;
+        if (r->req.payload_len == 0) {
+            r->req.payload = NULL;
+        }
+        r->arg = req_arg;
+        r->token = client->token++;
+        r->block1_num = r->block2_num = 0;
+        r->block1_szx = r->block2_szx = LWCELL_CFG_COAP_BLOCK_SZX;
+        r->observing = r->rx_valid = 0;
+        r->in_use = 1;
+        if ((res = prv_send_req(r)) != lwcellOK) {
+            r->in_use = 0;
+        }
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Cancel request in progress or observation, without notifying application
+ *
+ * Next notification of cancelled observation is answered with reset message,
+ * so server removes the observer
+ *
+ * \param[in]       client: CoAP client handle
+ * \param[in]       req_arg: Request argument used with \ref lwcell_coap_client_request
+ * \return          \ref lwcellOK on success, \ref lwcellERR when request is not found
+ */
+lwcellr_t
+lwcell_coap_client_cancel(lwcell_coap_client_p client, void* req_arg) {
+    lwcellr_t res = lwcellERR;
+
+    LWCELL_ASSERT(client != NULL);
+
+    lwcell_core_lock();
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(client->reqs); ++i) {
+        if (client->reqs[i].in_use && client->reqs[i].arg == req_arg) {
+            lwcell_timeout_stop(&client->reqs[i].to);
+            client->reqs[i].in_use = 0;
+            res = lwcellOK;
+            break;
+        }
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Get user argument of client
+ * \param[in]       client: CoAP client handle
+ * \return          User argument
+ */
+void*
+lwcell_coap_client_get_arg(lwcell_coap_client_p client) {
+    return client != NULL ? client->arg : NULL;
+}
+
+#endif /* LWCELL_CFG_COAP || __DOXYGEN__ */
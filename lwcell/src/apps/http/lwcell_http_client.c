@@ -0,0 +1,588 @@
+/**
+ * \file            lwcell_http_client.c
+ * \brief           HTTP/1.1 client
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/apps/lwcell_http_client.h"
+#include "lwcell/lwcell.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_HTTP_CLIENT || __DOXYGEN__
+
+/* Tracing debug message */
+#define LWCELL_CFG_DBG_HTTP_CLIENT_TRACE (LWCELL_CFG_DBG_HTTP_CLIENT | LWCELL_DBG_TYPE_TRACE)
+#define LWCELL_CFG_DBG_HTTP_CLIENT_TRACE_WARNING                                                                       \
+    (LWCELL_CFG_DBG_HTTP_CLIENT | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING)
+
+/* Maximal length of header line part copied for parsing, longer values are cut */
+#define HTTP_LINE_LEN               64
+
+/* Maximal length of chunk size line, including extensions */
+#define HTTP_CHUNK_LINE_MAX_LEN     64
+
+/**
+ * \brief           HTTP client structure
+ */
+typedef struct lwcell_http_client {
+    lwcell_netconn_p nc;        /*!< Netconn handle, `NULL` when not connected */
+    lwcell_netconn_type_t type; /*!< Connection type */
+    lwcell_port_t port;         /*!< Server port */
+    const char* host;           /*!< Server host, stored after structure */
+    lwcell_pbuf_p rx;           /*!< Received data not yet processed */
+    size_t pending;             /*!< Number of requests sent and waiting for response */
+    uint32_t pending_no_body;   /*!< Bit mask of pending requests with response without body, first in bit `0` */
+} lwcell_http_client_t;
+
+/**
+ * \brief           Release bytes from the beginning of received data
+ * \param[in]       client: HTTP client handle
+ * \param[in]       len: Number of bytes to release
+ */
+static void
+prv_rx_release(lwcell_http_client_p client, size_t len) {
+    lwcell_pbuf_p next;
+    size_t n;
+
+    while (len > 0 && client->rx != NULL) {
+        n = lwcell_pbuf_length(client->rx, 0);
+        if (len < n) {
+            lwcell_pbuf_advance(client->rx, (int)len);
+            break;
+        }
+        next = lwcell_pbuf_unchain(client->rx); /* Free first packet buffer in chain */
+        lwcell_pbuf_free(client->rx);
+        client->rx = next;
+        len -= n;
+    }
+}
+
+/**
+ * \brief           Receive more data from connection and append it to received chain
+ * \param[in]       client: HTTP client handle
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+static lwcellr_t
+prv_rx_more(lwcell_http_client_p client) {
+    lwcell_pbuf_p pbuf;
+    lwcellr_t res;
+
+    if ((res = lwcell_netconn_receive(client->nc, &pbuf)) == lwcellOK) {
+        if (client->rx == NULL) {
+            client->rx = pbuf;
+        } else {
+            lwcell_pbuf_cat(client->rx, pbuf);
+        }
+    }
+    return res;
+}
+
+/**
+ * \brief           Wait until string is found in received data
+ *
+ * Only newly received data is searched after each receive
+ *
+ * \param[in]       client: HTTP client handle
+ * \param[in]       str: String to find
+ * \param[in]       max_len: Maximal number of bytes to keep before string is found
+ * \param[out]      pos: Position of string from the beginning of received data
+ * \return          \ref lwcellOK on success, \ref lwcellERRMEM when string is not within `max_len` bytes,
+ *                      member of \ref lwcellr_t otherwise
+ */
+static lwcellr_t
+prv_rx_find(lwcell_http_client_p client, const char* str, size_t max_len, size_t* pos) {
+    size_t off = 0, len, str_len = strlen(str);
+    lwcellr_t res;
+
+    while (1) {
+        if (client->rx != NULL) {
+            if ((*pos = lwcell_pbuf_strfind(client->rx, str, off)) != LWCELL_SIZET_MAX) {
+                return lwcellOK;
+            }
+            len = lwcell_pbuf_length(client->rx, 1);
+            if (len > max_len) {
+                return lwcellERRMEM;
+            }
+            off = len >= str_len ? (len - str_len + 1) : 0;
+        }
+        if ((res = prv_rx_more(client)) != lwcellOK) {
+            return res;
+        }
+    }
+}
+
+/**
+ * \brief           Close connection and drop all pending responses
+ * \param[in]       client: HTTP client handle
+ */
+static void
+prv_disconnect(lwcell_http_client_p client) {
+    if (client->nc != NULL) {
+        if (lwcell_netconn_is_connected(client->nc)) {
+            lwcell_netconn_close(client->nc);
+        }
+        lwcell_netconn_delete(client->nc);
+        client->nc = NULL;
+    }
+    lwcell_pbuf_free_s(&client->rx);
+    client->pending = 0;
+    client->pending_no_body = 0;
+}
+
+/**
+ * \brief           Write string to connection buffer
+ * \param[in]       client: HTTP client handle
+ * \param[in]       str: String to write
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+static lwcellr_t
+prv_write_str(lwcell_http_client_p client, const char* str) {
+    return lwcell_netconn_write(client->nc, str, strlen(str));
+}
+
+/**
+ * \brief           Check if header line starts with field name and get its value
+ * \param[in]       line: Header line, `NULL` terminated
+ * \param[in]       name: Lower-case field name, without colon
+ * \return          Pointer to value without leading spaces on match, `NULL` otherwise
+ */
+static const char*
+prv_hdr_value(const char* line, const char* name) {
+    for (; *name != '\0'; ++line, ++name) {
+        if ((*line | 0x20) != *name) {
+            return NULL;
+        }
+    }
+    if (*line++ != ':') {
+        return NULL;
+    }
+    while (*line == ' ' || *line == '\t') {
+        ++line;
+    }
+    return line;
+}
+
+/**
+ * \brief           Check if value contains token, case insensitive
+ * \param[in]       value: Header value, `NULL` terminated
+ * \param[in]       token: Lower-case token to find
+ * \return          `1` if found, `0` otherwise
+ */
+static uint8_t
+prv_hdr_has_token(const char* value, const char* token) {
+    size_t i;
+
+    for (; *value != '\0'; ++value) {
+        for (i = 0; token[i] != '\0' && (value[i] | 0x20) == token[i]; ++i) {}
+        if (token[i] == '\0') {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Wait for complete response header and parse it
+ * \param[in]       client: HTTP client handle
+ * \param[out]      resp: Response information to fill
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+static lwcellr_t
+prv_read_header(lwcell_http_client_p client, lwcell_http_client_resp_t* resp) {
+    char line[HTTP_LINE_LEN];
+    const char* v;
+    size_t hdr_end, off, end;
+    lwcellr_t res;
+
+    if ((res = prv_rx_find(client, "\r\n\r\n", LWCELL_CFG_HTTP_CLIENT_MAX_HEADER_LEN, &hdr_end)) != lwcellOK) {
+        return res;
+    }
+
+    /* Status line, such as "HTTP/1.1 200 OK" */
+    lwcell_pbuf_copy(client->rx, line, sizeof(line) - 1, 0);
+    line[sizeof(line) - 1] = '\0';
+    if (strncmp(line, "HTTP/1.", 7) != 0 || line[8] != ' ' || !LWCELL_CHARISNUM(line[9])
+        || !LWCELL_CHARISNUM(line[10]) || !LWCELL_CHARISNUM(line[11])) {
+        return lwcellERR;
+    }
+    LWCELL_MEMSET(resp, 0x00, sizeof(*resp));
+    resp->status = (uint16_t)(LWCELL_CHARTONUM(line[9]) * 100 + LWCELL_CHARTONUM(line[10]) * 10
+                              + LWCELL_CHARTONUM(line[11]));
+    resp->keep_alive = line[7] != '0'; /* HTTP/1.1 keeps connection open by default */
+    resp->content_length = LWCELL_SIZET_MAX;
+
+    /* Header fields, line by line up to empty line */
+    off = lwcell_pbuf_strfind(client->rx, "\r\n", 0) + 2;
+    for (; off < hdr_end + 2; off = end + 2) {
+        end = lwcell_pbuf_strfind(client->rx, "\r\n", off);
+        line[lwcell_pbuf_copy(client->rx, line, LWCELL_MIN(end - off, sizeof(line) - 1), off)] = '\0';
+        if ((v = prv_hdr_value(line, "content-length")) != NULL) {
+            resp->content_length = 0;
+            for (; LWCELL_CHARISNUM(*v); ++v) {
+                resp->content_length = resp->content_length * 10 + LWCELL_CHARTONUM(*v);
+            }
+        } else if ((v = prv_hdr_value(line, "transfer-encoding")) != NULL) {
+            resp->chunked = prv_hdr_has_token(v, "chunked");
+        } else if ((v = prv_hdr_value(line, "connection")) != NULL) {
+            if (prv_hdr_has_token(v, "close")) {
+                resp->keep_alive = 0;
+            } else if (prv_hdr_has_token(v, "keep-alive")) {
+                resp->keep_alive = 1;
+            }
+        }
+    }
+    prv_rx_release(client, hdr_end + 4); /* Body or next response may follow in the same packet */
+    return lwcellOK;
+}
+
+/**
+ * \brief           Pass body bytes to callback as they are received
+ * \param[in]       client: HTTP client handle
+ * \param[in]       len: Number of body bytes, `LWCELL_SIZET_MAX` to read until connection is closed
+ * \param[in]       body_fn: Body callback, may be `NULL` to discard body
+ * \param[in]       arg: User argument for callback
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+static lwcellr_t
+prv_read_body(lwcell_http_client_p client, size_t len, lwcell_http_client_body_fn body_fn, void* arg) {
+    const void* d;
+    size_t n;
+    lwcellr_t res;
+
+    while (len > 0) {
+        if (client->rx == NULL) {
+            if ((res = prv_rx_more(client)) != lwcellOK) {
+                return res == lwcellCLOSED && len == LWCELL_SIZET_MAX ? lwcellOK : res;
+            }
+            continue;
+        }
+        d = lwcell_pbuf_get_linear_addr(client->rx, 0, &n);
+        n = LWCELL_MIN(n, len);
+        if (body_fn != NULL && (res = body_fn(client, d, n, arg)) != lwcellOK) {
+            return res;
+        }
+        prv_rx_release(client, n);
+        if (len != LWCELL_SIZET_MAX) {
+            len -= n;
+        }
+    }
+    return lwcellOK;
+}
+
+/**
+ * \brief           Pass chunked body to callback, chunk by chunk
+ * \param[in]       client: HTTP client handle
+ * \param[in]       body_fn: Body callback, may be `NULL` to discard body
+ * \param[in]       arg: User argument for callback
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+static lwcellr_t
+prv_read_chunked(lwcell_http_client_p client, lwcell_http_client_body_fn body_fn, void* arg) {
+    char line[HTTP_LINE_LEN];
+    size_t pos, size;
+    lwcellr_t res;
+
+    while (1) {
+        /* Chunk size in hex, optionally followed by extensions */
+        if ((res = prv_rx_find(client, "\r\n", HTTP_CHUNK_LINE_MAX_LEN, &pos)) != lwcellOK) {
+            return res;
+        }
+        line[lwcell_pbuf_copy(client->rx, line, LWCELL_MIN(pos, sizeof(line) - 1), 0)] = '\0';
+        prv_rx_release(client, pos + 2);
+        if (!LWCELL_CHARISHEXNUM(line[0])) {
+            return lwcellERR;
+        }
+        size = 0;
+        for (const char* p = line; LWCELL_CHARISHEXNUM(*p); ++p) {
+            if (size > (LWCELL_SIZET_MAX >> 4)) {
+                return lwcellERR;
+            }
+            size = (size << 4) | LWCELL_CHARHEXTONUM(*p);
+        }
+        if (size == 0) {
+            break;
+        }
+        if ((res = prv_read_body(client, size, body_fn, arg)) != lwcellOK
+            || (res = prv_rx_find(client, "\r\n", 2, &pos)) != lwcellOK) {
+            return res;
+        }
+        if (pos != 0) {
+            return lwcellERR;
+        }
+        prv_rx_release(client, 2);
+    }
+
+    /* Trailer fields are skipped up to empty line */
+    do {
+        if ((res = prv_rx_find(client, "\r\n", LWCELL_CFG_HTTP_CLIENT_MAX_HEADER_LEN, &pos)) != lwcellOK) {
+            return res;
+        }
+        prv_rx_release(client, pos + 2);
+    } while (pos > 0);
+    return lwcellOK;
+}
+
+/**
+ * \brief           Create new HTTP client for single server
+ * \param[in]       type: Connection type, \ref LWCELL_NETCONN_TYPE_TCP or \ref LWCELL_NETCONN_TYPE_SSL
+ * \param[in]       host: Server host name or IP address, also sent in `Host` header. It is copied to client
+ * \param[in]       port: Server port, typically `80` or `443`
+ * \return          Client handle on success, `NULL` otherwise
+ */
+lwcell_http_client_p
+lwcell_http_client_new(lwcell_netconn_type_t type, const char* host, lwcell_port_t port) {
+    lwcell_http_client_p client;
+    size_t host_len;
+
+    LWCELL_ASSERT0(host != NULL);
+    LWCELL_ASSERT0(type != LWCELL_NETCONN_TYPE_UDP);
+
+    host_len = strlen(host) + 1;
+    if ((client = lwcell_mem_calloc_tag(1, sizeof(*client) + host_len, LWCELL_MEM_TAG_NETCONN)) != NULL) {
+        LWCELL_MEMCPY(&client[1], host, host_len);
+        client->host = (const char*)&client[1];
+        client->type = type;
+        client->port = port;
+    }
+    return client;
+}
+
+/**
+ * \brief           Delete client, close connection if still active
+ * \param[in]       client: HTTP client handle
+ */
+void
+lwcell_http_client_delete(lwcell_http_client_p client) {
+    if (client == NULL) {
+        return;
+    }
+    prv_disconnect(client);
+    lwcell_mem_free_s((void**)&client);
+}
+
+/**
+ * \brief           Send request without waiting for response
+ *
+ * Connection is opened when not active or when server closed idle connection.
+ * Response must be read with \ref lwcell_http_client_response, in the same order as requests were sent
+ *
+ * \note            This function may only be called from thread other than stack threads.
+ *                      On error, connection is closed and all pending requests are dropped
+ * \param[in]       client: HTTP client handle
+ * \param[in]       method: Request method, such as `GET` or `POST`
+ * \param[in]       path: Resource path, such as `/index.html`
+ * \param[in]       headers: Additional header lines, each terminated with `\r\n`. Set to `NULL` if not used
+ * \param[in]       body: Request body. Set to `NULL` when request has no body
+ * \param[in]       body_len: Body length in units of bytes, sent in `Content-Length` header
+ * \return          \ref lwcellOK on success, \ref lwcellERRMEM when \ref LWCELL_CFG_HTTP_CLIENT_PIPELINE_LEN
+ *                      requests are already pending, member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_http_client_request(lwcell_http_client_p client, const char* method, const char* path, const char* headers,
+                           const void* body, size_t body_len) {
+    char len_str[11];
+    lwcellr_t res = lwcellOK;
+
+    LWCELL_ASSERT(client != NULL);
+    LWCELL_ASSERT(method != NULL && path != NULL);
+    LWCELL_ASSERT(body != NULL || body_len == 0);
+
+    if (client->pending >= LWCELL_CFG_HTTP_CLIENT_PIPELINE_LEN) {
+        return lwcellERRMEM;
+    }
+
+    /* Reuse connection unless server closed it while idle */
+    if (client->nc != NULL && client->pending == 0 && !lwcell_netconn_is_connected(client->nc)) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_HTTP_CLIENT_TRACE, "[LWCELL HTTP CLIENT] Connection closed by server\r\n");
+        prv_disconnect(client);
+    }
+    if (client->nc == NULL) {
+        if ((client->nc = lwcell_netconn_new(client->type)) == NULL) {
+            return lwcellERRMEM;
+        }
+        res = lwcell_netconn_connect(client->nc, client->host, client->port);
+    }
+
+    if (res == lwcellOK && (res = prv_write_str(client, method)) == lwcellOK
+        && (res = prv_write_str(client, " ")) == lwcellOK && (res = prv_write_str(client, path)) == lwcellOK
+        && (res = prv_write_str(client, " HTTP/1.1\r\nHost: ")) == lwcellOK
+        && (res = prv_write_str(client, client->host)) == lwcellOK
+        && (res = prv_write_str(client, "\r\n")) == lwcellOK
+        && (headers == NULL || (res = prv_write_str(client, headers)) == lwcellOK)
+        && (body == NULL
+            || ((res = prv_write_str(client, "Content-Length: ")) == lwcellOK
+                && (res = prv_write_str(client, lwcell_u32_to_str((uint32_t)body_len, len_str))) == lwcellOK
+                && (res = prv_write_str(client, "\r\n")) == lwcellOK))
+        && (res = prv_write_str(client, "\r\n")) == lwcellOK
+        && (body_len == 0 || (res = lwcell_netconn_write(client->nc, body, body_len)) == lwcellOK)) {
+        res = lwcell_netconn_flush(client->nc);
+    }
+    if (res != lwcellOK) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_HTTP_CLIENT_TRACE_WARNING, "[LWCELL HTTP CLIENT] Cannot send request\r\n");
+        prv_disconnect(client);
+        return res;
+    }
+
+    /* Responses to HEAD requests never have body */
+    if (strcmp(method, "HEAD") == 0) {
+        client->pending_no_body |= LWCELL_U32(1) << client->pending;
+    }
+    ++client->pending;
+    return lwcellOK;
+}
+
+/**
+ * \brief           Read response to the oldest pending request
+ *
+ * Informational `1xx` responses are skipped. Body is passed to callback as it is received.
+ * When server does not keep connection alive, connection is closed after the response
+ * and remaining pending requests must be sent again.
+ *
+ * \note            On error, connection is closed and all pending requests are dropped
+ * \param[in]       client: HTTP client handle
+ * \param[out]      resp: Response information to fill
+ * \param[in]       body_fn: Body callback, set to `NULL` to discard body
+ * \param[in]       arg: User argument for callback
+ * \param[in]       timeout: Maximal time to wait for each received packet in units of milliseconds,
+ *                      `0` to wait forever
+ * \return          \ref lwcellOK on success, \ref lwcellCLOSED when no response can be received anymore,
+ *                      member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_http_client_response(lwcell_http_client_p client, lwcell_http_client_resp_t* resp,
+                            lwcell_http_client_body_fn body_fn, void* arg, uint32_t timeout) {
+    uint8_t no_body;
+    lwcellr_t res;
+
+    LWCELL_ASSERT(client != NULL && resp != NULL);
+
+    if (client->nc == NULL || client->pending == 0) {
+        return lwcellCLOSED;
+    }
+#if LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT
+    lwcell_netconn_set_receive_timeout(client->nc, timeout);
+#else  /* LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT */
+    LWCELL_UNUSED(timeout);
+#endif /* !LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT */
+
+    do {
+        res = prv_read_header(client, resp);
+    } while (res == lwcellOK && resp->status >= 100 && resp->status < 200);
+
+    if (res == lwcellOK) {
+        no_body = (client->pending_no_body & 0x01) || resp->status == 204 || resp->status == 304;
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_HTTP_CLIENT_TRACE, "[LWCELL HTTP CLIENT] Response status %d\r\n",
+                      (int)resp->status);
+        if (no_body) {
+            /* Nothing to read */
+        } else if (resp->chunked) {
+            res = prv_read_chunked(client, body_fn, arg);
+        } else if (resp->content_length != LWCELL_SIZET_MAX) {
+            res = prv_read_body(client, resp->content_length, body_fn, arg);
+        } else {
+            resp->keep_alive = 0; /* Body ends when connection is closed */
+            res = prv_read_body(client, LWCELL_SIZET_MAX, body_fn, arg);
+        }
+    }
+    if (res != lwcellOK || !resp->keep_alive) {
+        if (res != lwcellOK) {
+            LWCELL_DEBUGF(LWCELL_CFG_DBG_HTTP_CLIENT_TRACE_WARNING, "[LWCELL HTTP CLIENT] Response failed: %d\r\n",
+                          (int)res);
+        }
+        prv_disconnect(client);
+    } else {
+        --client->pending;
+        client->pending_no_body >>= 1;
+    }
+    return res;
+}
+
+/**
+ * \brief           Send request and read its response
+ * \note            This function may only be called from thread other than stack threads
+ * \param[in]       client: HTTP client handle
+ * \param[in]       method: Request method, such as `GET` or `POST`
+ * \param[in]       path: Resource path, such as `/index.html`
+ * \param[in]       headers: Additional header lines, each terminated with `\r\n`. Set to `NULL` if not used
+ * \param[in]       body: Request body. Set to `NULL` when request has no body
+ * \param[in]       body_len: Body length in units of bytes
+ * \param[out]      resp: Response information to fill
+ * \param[in]       body_fn: Body callback, set to `NULL` to discard body
+ * \param[in]       arg: User argument for callback
+ * \param[in]       timeout: Maximal time to wait for each received packet in units of milliseconds,
+ *                      `0` to wait forever
+ * \return          \ref lwcellOK on success, \ref lwcellERR when other responses are still pending,
+ *                      member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_http_client_execute(lwcell_http_client_p client, const char* method, const char* path, const char* headers,
+                           const void* body, size_t body_len, lwcell_http_client_resp_t* resp,
+                           lwcell_http_client_body_fn body_fn, void* arg, uint32_t timeout) {
+    lwcellr_t res;
+
+    LWCELL_ASSERT(client != NULL);
+
+    if (client->pending > 0) {
+        return lwcellERR;
+    }
+    if ((res = lwcell_http_client_request(client, method, path, headers, body, body_len)) == lwcellOK) {
+        res = lwcell_http_client_response(client, resp, body_fn, arg, timeout);
+    }
+    return res;
+}
+
+/**
+ * \brief           Get number of requests waiting for response
+ * \param[in]       client: HTTP client handle
+ * \return          Number of pending requests
+ */
+size_t
+lwcell_http_client_get_pending(lwcell_http_client_p client) {
+    LWCELL_ASSERT0(client != NULL);
+    return client->pending;
+}
+
+/**
+ * \brief           Close connection and drop pending responses
+ * \param[in]       client: HTTP client handle
+ * \return          \ref lwcellOK on success, \ref lwcellCLOSED when connection was not active
+ */
+lwcellr_t
+lwcell_http_client_close(lwcell_http_client_p client) {
+    LWCELL_ASSERT(client != NULL);
+
+    if (client->nc == NULL) {
+        return lwcellCLOSED;
+    }
+    prv_disconnect(client);
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_HTTP_CLIENT || __DOXYGEN__ */
@@ -34,6 +34,45 @@
 #include "lwcell/apps/lwcell_mqtt_client.h"
 #include "lwcell/lwcell.h"
 
+/**
+ * \brief           Payload referenced by publish packet, sent directly from application memory
+ */
+typedef struct {
+    const void* payload; /*!< Application payload */
+    uint16_t len;        /*!< Payload length */
+    uint32_t pos;        /*!< Position in output stream of TX buffer data, where payload is inserted */
+    void* arg;           /*!< User argument */
+} mqtt_ref_payload_t;
+
+#if LWCELL_CFG_MQTT_TOPIC_ROUTER || __DOXYGEN__
+
+/**
+ * \brief           Topic filter trie node, one node per topic level
+ */
+typedef struct mqtt_topic_node {
+    struct mqtt_topic_node* next;  /*!< Next node on the same level */
+    struct mqtt_topic_node* child; /*!< First node of next level */
+    lwcell_mqtt_topic_fn fn;       /*!< Callback for filter ending at this node, `NULL` if none */
+    void* arg;                     /*!< User argument for callback */
+    char* level;                   /*!< Level string, not `NULL` terminated. Stored after node structure */
+    size_t len;                    /*!< Length of level string */
+} mqtt_topic_node_t;
+
+#endif /* LWCELL_CFG_MQTT_TOPIC_ROUTER || __DOXYGEN__ */
+
+#if (LWCELL_CFG_MQTT_V5 && LWCELL_CFG_MQTT_V5_TOPIC_ALIAS) || __DOXYGEN__
+
+/**
+ * \brief           Outgoing topic alias entry, alias value is entry index plus `1`
+ */
+typedef struct {
+    char* topic;    /*!< Copy of topic, not `NULL` terminated. Set to `NULL` when entry is not used */
+    uint16_t len;   /*!< Length of topic */
+    uint32_t stamp; /*!< Last use stamp for least recently used replacement, `0` when not used */
+} mqtt_topic_alias_t;
+
+#endif /* (LWCELL_CFG_MQTT_V5 && LWCELL_CFG_MQTT_V5_TOPIC_ALIAS) || __DOXYGEN__ */
+
 /**
  * \brief           MQTT client connection
  */
@@ -42,7 +81,8 @@ typedef struct lwcell_mqtt_client {
     const lwcell_mqtt_client_info_t* info; /*!< Connection info */
     lwcell_mqtt_state_t conn_state;        /*!< MQTT connection state */
 
-    uint32_t poll_time; /*!< Poll time, increased every 500ms */
+    uint32_t last_tx_time; /*!< Time in milliseconds when last control packet was sent to server */
+    uint16_t keep_alive;   /*!< Keep alive in units of seconds, as requested by client or assigned by server */
 
     lwcell_mqtt_evt_t evt;     /*!< MQTT event callback */
     lwcell_mqtt_evt_fn evt_fn; /*!< Event callback function */
@@ -51,11 +91,23 @@ typedef struct lwcell_mqtt_client {
 
     uint8_t is_sending;     /*!< Flag if we are sending data currently */
     uint32_t sent_total;    /*!< Total number of bytes sent so far on connection */
+    uint8_t tx_cork;        /*!< Publish batch nesting level, output is held while greater than `0` */
     uint32_t written_total; /*!< Total number of bytes written into send buffer and queued for send */
 
+    mqtt_ref_payload_t refs[LWCELL_CFG_MQTT_MAX_REQUESTS]; /*!< Queue of referenced payloads waiting to be sent */
+    uint8_t refs_head;                                     /*!< Index of first referenced payload in queue */
+    uint8_t refs_cnt;                                      /*!< Number of referenced payloads in queue */
+    uint32_t tx_buff_pos;                                  /*!< Number of bytes ever sent from TX buffer */
+    size_t sending_buff_len;                               /*!< Number of TX buffer bytes in current send */
+    uint8_t sending_ref;                                   /*!< Set to `1` when current send ends with first payload */
+    lwcell_conn_iovec_t tx_iov[3];                         /*!< Fragments of current send, both TX buffer blocks
+                                                                and referenced payload */
+
     uint16_t last_packet_id; /*!< Packet ID used on last packet */
 
-    lwcell_mqtt_request_t requests[LWCELL_CFG_MQTT_MAX_REQUESTS]; /*!< List of requests */
+    lwcell_mqtt_request_t* requests; /*!< In-flight window of requests, indexed by packet ID modulo length */
+    uint16_t requests_len;           /*!< Number of entries in in-flight window */
+    uint8_t requests_full;           /*!< Set to `1` when request failed due to full window */
 
     uint8_t* rx_buff;   /*!< Raw RX buffer */
     size_t rx_buff_len; /*!< Length of raw RX buffer */
@@ -65,6 +117,36 @@ typedef struct lwcell_mqtt_client {
     uint32_t msg_rem_len;     /*!< Remaining length value of current message */
     uint8_t msg_rem_len_mult; /*!< Multiplier for remaining length */
     uint32_t msg_curr_pos;    /*!< Current buffer write pointer */
+#if LWCELL_CFG_MQTT_RECV_STREAM || __DOXYGEN__
+    uint16_t msg_hdr_len; /*!< Variable header length of streamed publish packet, `0` until known */
+#if LWCELL_CFG_MQTT_V5 || __DOXYGEN__
+    uint8_t msg_hdr_props; /*!< Set to `1` while property length of streamed publish packet is being received */
+#endif                     /* LWCELL_CFG_MQTT_V5 || __DOXYGEN__ */
+#endif                     /* LWCELL_CFG_MQTT_RECV_STREAM || __DOXYGEN__ */
+#if LWCELL_CFG_MQTT_V5 || __DOXYGEN__
+    uint8_t is_v5;      /*!< Set to `1` when connection uses MQTT 5 */
+    uint16_t recv_max;  /*!< Receive maximum of the server, limit of unacknowledged QoS `1` and `2` publish packets */
+    uint16_t recv_used; /*!< Number of QoS `1` and `2` publish packets not yet acknowledged by server */
+#if LWCELL_CFG_MQTT_V5_TOPIC_ALIAS || __DOXYGEN__
+    uint16_t alias_max;                                         /*!< Topic alias maximum of the server */
+    uint32_t alias_stamp;                                       /*!< Last used topic alias stamp */
+    mqtt_topic_alias_t aliases[LWCELL_CFG_MQTT_V5_TOPIC_ALIAS]; /*!< Outgoing topic alias cache */
+#endif /* LWCELL_CFG_MQTT_V5_TOPIC_ALIAS || __DOXYGEN__ */
+#endif /* LWCELL_CFG_MQTT_V5 || __DOXYGEN__ */
+#if LWCELL_CFG_MQTT_OFFLINE_QUEUE || __DOXYGEN__
+    uint8_t offline_en;                                   /*!< Set to `1` when offline queue is enabled */
+    lwcell_buff_t offline_buff;                           /*!< RAM tier of offline publish queue */
+    const lwcell_mqtt_offline_storage_t* offline_storage; /*!< Storage tier, used when RAM tier is full */
+    uint8_t tx_hold;                                      /*!< Set to `1` to delay send while queue is drained */
+#endif                                                    /* LWCELL_CFG_MQTT_OFFLINE_QUEUE || __DOXYGEN__ */
+#if LWCELL_CFG_MQTT_TOPIC_ROUTER || __DOXYGEN__
+    mqtt_topic_node_t* topics; /*!< First level of topic filter trie */
+#endif                         /* LWCELL_CFG_MQTT_TOPIC_ROUTER || __DOXYGEN__ */
+#if LWCELL_CFG_MQTT_SESSION || __DOXYGEN__
+    const lwcell_mqtt_session_storage_t* session; /*!< Session storage, `NULL` when session is not persistent */
+    uint16_t session_resend;                      /*!< Number of restored requests waiting to be sent again */
+    uint8_t session_dup; /*!< Set to `1` when server resumed session, resent publish packets have DUP flag */
+#endif                   /* LWCELL_CFG_MQTT_SESSION || __DOXYGEN__ */
 
     void* arg; /*!< User argument */
 } lwcell_mqtt_client_t;
@@ -76,6 +158,9 @@ typedef struct lwcell_mqtt_client {
 
 static lwcellr_t prv_mqtt_conn_cb(lwcell_evt_t* evt);
 static void prv_send_data(lwcell_mqtt_client_p client);
+#if LWCELL_CFG_MQTT_OFFLINE_QUEUE
+static void prv_offline_drain(lwcell_mqtt_client_p client);
+#endif /* LWCELL_CFG_MQTT_OFFLINE_QUEUE */
 
 /**
  * \brief           List of MQTT message types
@@ -97,6 +182,9 @@ typedef enum {
     MQTT_MSG_TYPE_DISCONNECT = 0x0E,  /*!< Disconnect notification */
 } mqtt_msg_type_t;
 
+/* Connection poll interval in units of milliseconds, used for keep-alive only */
+#define MQTT_POLL_INTERVAL              1000
+
 /* List of flags for CONNECT message type */
 #define MQTT_FLAG_CONNECT_USERNAME      0x80 /*!< Packet contains username */
 #define MQTT_FLAG_CONNECT_PASSWORD      0x40 /*!< Packet contains password */
@@ -108,6 +196,7 @@ typedef enum {
 #define MQTT_PARSER_STATE_INIT          0x00 /*!< MQTT parser in initialized state */
 #define MQTT_PARSER_STATE_CALC_REM_LEN  0x01 /*!< MQTT parser in calculating remaining length state */
 #define MQTT_PARSER_STATE_READ_REM      0x02 /*!< MQTT parser in reading remaining bytes state */
+#define MQTT_PARSER_STATE_READ_STREAM   0x03 /*!< MQTT parser in streaming publish payload state */
 
 /* Get packet type from incoming byte */
 #define MQTT_RCV_GET_PACKET_TYPE(d)     ((mqtt_msg_type_t)(((d) >> 0x04) & 0x0F))
@@ -120,6 +209,37 @@ typedef enum {
 #define MQTT_REQUEST_FLAG_PENDING       0x02 /*!< Request object is pending waiting for response from server */
 #define MQTT_REQUEST_FLAG_SUBSCRIBE     0x04 /*!< Request object has subscribe type */
 #define MQTT_REQUEST_FLAG_UNSUBSCRIBE   0x08 /*!< Request object has unsubscribe type */
+#define MQTT_REQUEST_FLAG_RESEND        0x10 /*!< Request restored from session, packet waits to be sent again */
+
+/* Check if request is QoS 1 or 2 publish, acknowledged by server */
+#define MQTT_REQUEST_IS_PUBLISH_QOS(r)                                                                                 \
+    ((r)->packet_id != 0 && !((r)->status & (MQTT_REQUEST_FLAG_SUBSCRIBE | MQTT_REQUEST_FLAG_UNSUBSCRIBE)))
+
+/* Check if client persists session */
+#if LWCELL_CFG_MQTT_SESSION
+#define MQTT_HAS_SESSION(client) ((client)->session != NULL)
+#else
+#define MQTT_HAS_SESSION(client) 0
+#endif /* LWCELL_CFG_MQTT_SESSION */
+
+/* MQTT 5 property identifiers used by client */
+#define MQTT_PROP_SESSION_EXPIRY        0x11 /*!< Session expiry interval in seconds, 4 bytes */
+#define MQTT_PROP_SERVER_KEEP_ALIVE     0x13 /*!< Keep alive assigned by server, 2 bytes */
+#define MQTT_PROP_RECEIVE_MAXIMUM       0x21 /*!< Maximal number of unacknowledged QoS > 0 publish packets, 2 bytes */
+#define MQTT_PROP_TOPIC_ALIAS_MAXIMUM   0x22 /*!< Highest accepted topic alias value, 2 bytes */
+#define MQTT_PROP_TOPIC_ALIAS           0x23 /*!< Topic alias of publish packet, 2 bytes */
+
+/* Reason code values from this one on indicate failure, in MQTT 5 acknowledges and MQTT 3.1.1 SUBACK */
+#define MQTT_REASON_FAILURE             0x80
+
+/* Check if connection uses MQTT 5 and if streamed publish header still waits for property length */
+#if LWCELL_CFG_MQTT_V5
+#define MQTT_IS_V5(client)            ((client)->is_v5)
+#define MQTT_STREAM_HDR_PROPS(client) ((client)->msg_hdr_props)
+#else
+#define MQTT_IS_V5(client)            0
+#define MQTT_STREAM_HDR_PROPS(client) 0
+#endif /* LWCELL_CFG_MQTT_V5 */
 
 #if LWCELL_CFG_DBG
 
@@ -170,29 +290,33 @@ prv_create_packet_id(lwcell_mqtt_client_p client) {
 
 /**
  * \brief           Create and return new request object
+ *
+ * New packet ID is created for every request, skipping IDs whose window slot is still in use.
+ * Request is stored at `packet_id % requests_len` position, so it can be found without a search
+ *
  * \param[in]       client: MQTT client
- * \param[in]       packet_id: Packet ID for QoS `1` or `2`
+ * \param[in]       with_id: Set to `1` for QoS `1` or `2` requests, acknowledged by server with packet ID.
+ *                      Packet ID of request is set to `0` otherwise
  * \param[in]       arg: User optional argument for identifying packets
- * \return          Pointer to new request ready to use or `NULL` if no available memory
+ * \return          Pointer to new request ready to use or `NULL` if window is full
  */
 static lwcell_mqtt_request_t*
-prv_request_create(lwcell_mqtt_client_p client, uint16_t packet_id, void* arg) {
+prv_request_create(lwcell_mqtt_client_p client, uint8_t with_id, void* arg) {
     lwcell_mqtt_request_t* request;
-    uint16_t i;
-
-    /* Try to find a new request which does not have IN_USE flag set */
-    for (request = NULL, i = 0; i < LWCELL_CFG_MQTT_MAX_REQUESTS; ++i) {
-        if (!(client->requests[i].status & MQTT_REQUEST_FLAG_IN_USE)) {
-            request = &client->requests[i]; /* We have empty request */
-            break;
+    uint16_t packet_id;
+
+    for (uint16_t i = 0; i < client->requests_len; ++i) {
+        packet_id = prv_create_packet_id(client);
+        request = &client->requests[packet_id % client->requests_len];
+        if (!(request->status & MQTT_REQUEST_FLAG_IN_USE)) {
+            request->packet_id = with_id ? packet_id : 0; /* Set request packet ID */
+            request->arg = arg;                           /* Set user argument */
+            request->status = MQTT_REQUEST_FLAG_IN_USE;   /* Reset everything at this point */
+            return request;
         }
     }
-    if (request != NULL) {
-        request->packet_id = packet_id;             /* Set request packet ID */
-        request->arg = arg;                         /* Set user argument */
-        request->status = MQTT_REQUEST_FLAG_IN_USE; /* Reset everything at this point */
-    }
-    return request;
+    client->requests_full = 1; /* Notify application when slot is released */
+    return NULL;
 }
 
 /**
@@ -226,10 +350,19 @@ prv_request_set_pending(lwcell_mqtt_client_p client, lwcell_mqtt_request_t* requ
  */
 static lwcell_mqtt_request_t*
 prv_request_get_pending(lwcell_mqtt_client_p client, int32_t pkt_id) {
-    /* Try to find a new request which does not have IN_USE flag set */
-    for (size_t i = 0; i < LWCELL_CFG_MQTT_MAX_REQUESTS; ++i) {
+    /* Acknowledged requests are stored at packet ID slot */
+    if (pkt_id > 0) {
+        lwcell_mqtt_request_t* request = &client->requests[(uint16_t)pkt_id % client->requests_len];
+        if ((request->status & MQTT_REQUEST_FLAG_PENDING) && request->packet_id == (uint16_t)pkt_id) {
+            return request;
+        }
+        return NULL;
+    }
+
+    /* Try to find first pending request, or first pending request without packet ID */
+    for (size_t i = 0; i < client->requests_len; ++i) {
         if ((client->requests[i].status & MQTT_REQUEST_FLAG_PENDING)
-            && (pkt_id == -1 || client->requests[i].packet_id == (uint16_t)pkt_id)) {
+            && (pkt_id == -1 || client->requests[i].packet_id == 0)) {
             return &client->requests[i];
         }
     }
@@ -262,6 +395,274 @@ prv_request_send_err_callback(lwcell_mqtt_client_p client, uint8_t status, void*
     client->evt_fn(client, &client->evt);
 }
 
+/**
+ * \brief           Notify application about free slot in in-flight window
+ *
+ * Event is sent only once after request failed because window was full
+ *
+ * \param[in]       client: MQTT client
+ */
+static void
+prv_request_window_notify(lwcell_mqtt_client_p client) {
+    if (client->requests_full) {
+        client->requests_full = 0;
+        client->evt.type = LWCELL_MQTT_EVT_WINDOW_FREE;
+        client->evt_fn(client, &client->evt);
+    }
+}
+
+#if LWCELL_CFG_PWR_RADIO_RELEASE || __DOXYGEN__
+
+/**
+ * \brief           Request early radio release when client expects nothing more from server
+ *
+ * Release is requested when all data are sent and no request waits for acknowledge
+ *
+ * \param[in]       client: MQTT client
+ */
+static void
+prv_radio_release_check(lwcell_mqtt_client_p client) {
+    if (client->conn_state != LWCELL_MQTT_CONNECTED || client->info == NULL || !client->info->radio_release
+        || client->written_total != client->sent_total) {
+        return;
+    }
+    for (size_t i = 0; i < client->requests_len; ++i) {
+        if (client->requests[i].status & MQTT_REQUEST_FLAG_IN_USE) {
+            return;
+        }
+    }
+    LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_TRACE, "[LWCELL MQTT] Requesting early radio release\r\n");
+    lwcell_pwr_radio_release(NULL, NULL, 0);
+}
+
+#endif /* LWCELL_CFG_PWR_RADIO_RELEASE || __DOXYGEN__ */
+
+#if LWCELL_CFG_MQTT_TOPIC_ROUTER || __DOXYGEN__
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/* MQTT topic router                                                                                  */
+/******************************************************************************************************/
+/******************************************************************************************************/
+
+/* Check if trie node is single or multi level wildcard */
+#define MQTT_TOPIC_NODE_IS(node, c) ((node)->len == 1 && (node)->level[0] == (c))
+
+/**
+ * \brief           Get length of first level in topic or filter
+ * \param[in]       str: Topic string
+ * \param[in]       len: Length of topic string
+ * \return          Number of characters before first `/` or full length
+ */
+static size_t
+prv_topic_level_len(const char* str, size_t len) {
+    size_t i;
+    for (i = 0; i < len && str[i] != '/'; ++i) {}
+    return i;
+}
+
+/**
+ * \brief           Call callbacks of all filters matching received topic
+ * \param[in]       client: MQTT client
+ * \param[in]       node: First node of trie level to match
+ * \param[in]       topic: Remaining topic levels
+ * \param[in]       len: Length of remaining topic
+ * \param[in]       is_first: Set to `1` for first topic level
+ * \return          Number of callbacks called
+ */
+static size_t
+prv_topic_dispatch(lwcell_mqtt_client_p client, mqtt_topic_node_t* node, const char* topic, size_t len,
+                   uint8_t is_first) {
+    size_t lvl = prv_topic_level_len(topic, len), cnt = 0;
+
+    for (; node != NULL; node = node->next) {
+        /* Topics starting with `$` are not matched by wildcards on first level */
+        if (is_first && len > 0 && topic[0] == '$'
+            && (MQTT_TOPIC_NODE_IS(node, '#') || MQTT_TOPIC_NODE_IS(node, '+'))) {
+            continue;
+        }
+        if (MQTT_TOPIC_NODE_IS(node, '#')) {
+            if (node->fn != NULL) {
+                node->fn(client, &client->evt, node->arg);
+                ++cnt;
+            }
+        } else if (MQTT_TOPIC_NODE_IS(node, '+') || (node->len == lvl && !strncmp(node->level, topic, lvl))) {
+            if (lvl == len) {
+                if (node->fn != NULL) {
+                    node->fn(client, &client->evt, node->arg);
+                    ++cnt;
+                }
+                /* Multi level wildcard also matches its parent level */
+                for (mqtt_topic_node_t* c = node->child; c != NULL; c = c->next) {
+                    if (MQTT_TOPIC_NODE_IS(c, '#') && c->fn != NULL) {
+                        c->fn(client, &client->evt, c->arg);
+                        ++cnt;
+                    }
+                }
+            } else {
+                cnt += prv_topic_dispatch(client, node->child, &topic[lvl + 1], len - lvl - 1, 0);
+            }
+        }
+    }
+    return cnt;
+}
+
+/**
+ * \brief           Remove nodes without callback and without children
+ * \param[in]       list: Pointer to first node of trie level
+ */
+static void
+prv_topic_prune(mqtt_topic_node_t** list) {
+    while (*list != NULL) {
+        mqtt_topic_node_t* node = *list;
+
+        prv_topic_prune(&node->child);
+        if (node->fn == NULL && node->child == NULL) {
+            *list = node->next;
+            lwcell_mem_free_s((void**)&node);
+        } else {
+            list = &node->next;
+        }
+    }
+}
+
+/**
+ * \brief           Free trie level with all its children
+ * \param[in]       node: First node of trie level
+ */
+static void
+prv_topic_free(mqtt_topic_node_t* node) {
+    while (node != NULL) {
+        mqtt_topic_node_t* next = node->next;
+
+        prv_topic_free(node->child);
+        lwcell_mem_free_s((void**)&node);
+        node = next;
+    }
+}
+
+/**
+ * \brief           Check topic filter validity
+ *
+ * Wildcard must occupy full level and multi level wildcard must be the last level
+ *
+ * \param[in]       filter: Topic filter
+ * \param[in]       len: Filter length
+ * \return          `1` if valid, `0` otherwise
+ */
+static uint8_t
+prv_topic_filter_is_valid(const char* filter, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        if ((filter[i] == '+' || filter[i] == '#') && ((i > 0 && filter[i - 1] != '/')
+                                                       || (i + 1 < len && filter[i + 1] != '/'))) {
+            return 0;
+        }
+        if (filter[i] == '#' && i + 1 != len) {
+            return 0;
+        }
+    }
+    return len > 0;
+}
+
+/**
+ * \brief           Add callback for incoming publish packets matching topic filter
+ *
+ * Received \ref LWCELL_MQTT_EVT_PUBLISH_RECV event is passed to all matching callbacks
+ * instead of client event function. Event function receives only packets without matching filter.
+ * Matching cost depends on topic depth, not on number of filters.
+ *
+ * \note            Callback is called from MQTT client event context
+ * \param[in]       client: MQTT client
+ * \param[in]       filter: Topic filter with optional `+` and `#` wildcards
+ * \param[in]       fn: Callback function. Replaces previous callback for the same filter
+ * \param[in]       arg: User argument passed to callback
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_mqtt_client_topic_add(lwcell_mqtt_client_p client, const char* filter, lwcell_mqtt_topic_fn fn, void* arg) {
+    mqtt_topic_node_t **list, *node = NULL;
+    size_t len, lvl;
+    lwcellr_t res = lwcellOK;
+
+    LWCELL_ASSERT(client != NULL);
+    LWCELL_ASSERT(filter != NULL);
+    LWCELL_ASSERT(fn != NULL);
+
+    len = strlen(filter);
+    if (!prv_topic_filter_is_valid(filter, len)) {
+        return lwcellERRPAR;
+    }
+
+    lwcell_core_lock();
+    for (list = &client->topics;; list = &node->child, filter += lvl + 1, len -= lvl + 1) {
+        lvl = prv_topic_level_len(filter, len);
+        for (node = *list; node != NULL && !(node->len == lvl && !strncmp(node->level, filter, lvl));
+             node = node->next) {}
+        if (node == NULL) {
+            if ((node = lwcell_mem_calloc_tag(1, sizeof(*node) + lvl, LWCELL_MEM_TAG_MQTT)) == NULL) {
+                res = lwcellERRMEM;
+                break;
+            }
+            node->level = (char*)node + sizeof(*node);
+            node->len = lvl;
+            LWCELL_MEMCPY(node->level, filter, lvl);
+            node->next = *list;
+            *list = node;
+        }
+        if (lvl == len) {
+            break;
+        }
+    }
+    if (res == lwcellOK) {
+        node->fn = fn;
+        node->arg = arg;
+    } else {
+        prv_topic_prune(&client->topics); /* Remove partially added levels */
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Remove callback of topic filter
+ * \param[in]       client: MQTT client
+ * \param[in]       filter: Topic filter, as passed to \ref lwcell_mqtt_client_topic_add
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_mqtt_client_topic_remove(lwcell_mqtt_client_p client, const char* filter) {
+    mqtt_topic_node_t* node;
+    mqtt_topic_node_t* list;
+    size_t len, lvl;
+    lwcellr_t res = lwcellERRPAR;
+
+    LWCELL_ASSERT(client != NULL);
+    LWCELL_ASSERT(filter != NULL);
+
+    len = strlen(filter);
+    lwcell_core_lock();
+    for (list = client->topics;; list = node->child, filter += lvl + 1, len -= lvl + 1) {
+        lvl = prv_topic_level_len(filter, len);
+        for (node = list; node != NULL && !(node->len == lvl && !strncmp(node->level, filter, lvl));
+             node = node->next) {}
+        if (node == NULL) {
+            break;
+        }
+        if (lvl == len) {
+            if (node->fn != NULL) {
+                node->fn = NULL;
+                res = lwcellOK;
+            }
+            break;
+        }
+    }
+    prv_topic_prune(&client->topics);
+    lwcell_core_unlock();
+    return res;
+}
+
+#endif /* LWCELL_CFG_MQTT_TOPIC_ROUTER || __DOXYGEN__ */
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /* MQTT buffer helper functions                                                                       */
@@ -352,10 +753,11 @@ prv_write_data(lwcell_mqtt_client_p client, const void* data, size_t len) {
  *                  remaining length itself + 1 byte for packet header
  * \param[in]       client: MQTT client
  * \param[in]       rem_len: Remaining length of packet
+ * \param[in]       ref_len: Number of packet bytes not written to output buffer, sent from referenced memory
  * \return          Number of required RAW bytes or `0` if no memory available
  */
 static uint16_t
-prv_output_check_enough_memory(lwcell_mqtt_client_p client, uint16_t rem_len) {
+prv_output_check_enough_memory(lwcell_mqtt_client_p client, uint16_t rem_len, uint16_t ref_len) {
     uint16_t total_len = rem_len + 1; /* Remaining length + first (packet start) byte */
 
     do { /* Calculate bytes for encoding remaining length itself */
@@ -363,7 +765,7 @@ prv_output_check_enough_memory(lwcell_mqtt_client_p client, uint16_t rem_len) {
         rem_len >>= 7; /* Encoded with 7 bits per byte */
     } while (rem_len > 0);
 
-    return LWCELL_U16(lwcell_buff_get_free(&client->tx_buff)) >= total_len ? total_len : 0;
+    return LWCELL_U16(lwcell_buff_get_free(&client->tx_buff)) >= (total_len - ref_len) ? total_len : 0;
 }
 
 /**
@@ -377,7 +779,7 @@ prv_output_check_enough_memory(lwcell_mqtt_client_p client, uint16_t rem_len) {
 static uint8_t
 prv_write_ack_rec_rel_resp(lwcell_mqtt_client_p client, mqtt_msg_type_t msg_type, uint16_t pkt_id,
                            lwcell_mqtt_qos_t qos) {
-    if (prv_output_check_enough_memory(client, 2)) {            /* Check memory for response packet */
+    if (prv_output_check_enough_memory(client, 2, 0)) {            /* Check memory for response packet */
         prv_write_fixed_header(client, msg_type, 0, qos, 0, 2); /* Write fixed header with 2 more bytes for packet id */
         prv_write_u16(client, pkt_id);                          /* Write packet ID */
         prv_send_data(client);                                  /* Flush data to output */
@@ -404,137 +806,660 @@ prv_write_string(lwcell_mqtt_client_p client, const char* str, uint16_t len) {
 }
 
 /**
- * \brief           Send the actual data to the remote
- * \param[in]       client: MQTT client
+ * \brief           Read variable byte integer, such as remaining length or property length
+ * \param[in]       data: Input data
+ * \param[in]       len: Length of input data
+ * \param[out]      val: Decoded value
+ * \return          Number of bytes used by the integer or `0` if data are incomplete or malformed
  */
-static void
-prv_send_data(lwcell_mqtt_client_p client) {
-    size_t len;
-    const void* addr;
-
-    if (client->is_sending) { /* We are currently sending data */
-        return;
-    }
-
-    len = lwcell_buff_get_linear_block_read_length(&client->tx_buff); /* Get length of linear memory */
-    if (len > 0) {                                                   /* Anything to send? */
-        lwcellr_t res;
-        addr = lwcell_buff_get_linear_block_read_address(&client->tx_buff); /* Get address of linear memory */
-        if ((res = lwcell_conn_send(client->conn, addr, len, NULL, 0)) == lwcellOK) {
-            client->written_total += len; /* Increase number of bytes written to queue */
-            client->is_sending = 1;       /* Remember active sending flag */
-        } else {
-            LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_TRACE_WARNING, "[LWCELL MQTT] Cannot send data with error: %d\r\n",
-                          (int)res);
+static size_t
+prv_varint_read(const uint8_t* data, size_t len, uint32_t* val) {
+    uint32_t v = 0;
+
+    for (size_t i = 0; i < len && i < 4; ++i) {
+        v |= LWCELL_U32(data[i] & 0x7F) << (7 * i);
+        if (!(data[i] & 0x80)) {
+            *val = v;
+            return i + 1;
         }
-    } else {
-        /*
-         * If buffer is empty, reset it to default state (read & write pointers)
-         * This is to make sure everytime function needs to send data,
-         * it can do it in single shot rather than in 2 attempts (when read > write pointer).
-         * Effectively this means faster transmission of MQTT packets and lower latency.
-         */
-        lwcell_buff_reset(&client->tx_buff);
     }
+    return 0;
 }
 
+#if LWCELL_CFG_MQTT_V5 || __DOXYGEN__
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/* MQTT 5 helper functions                                                                            */
+/******************************************************************************************************/
+/******************************************************************************************************/
+
 /**
- * \brief           Close a MQTT connection with server
- * \param[in]       client: MQTT client
- * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ * \brief           Get numeric property value from list of properties
+ * \param[in]       props: Properties, without property length
+ * \param[in]       len: Length of properties
+ * \param[in]       id: Property identifier to search for
+ * \param[out]      val: Property value
+ * \return          `1` if property was found, `0` otherwise
  */
-static lwcellr_t
-prv_mqtt_close(lwcell_mqtt_client_p client) {
-    lwcellr_t res = lwcellERR;
-    if (client->conn_state != LWCELL_MQTT_CONN_DISCONNECTED && client->conn_state != LWCELL_MQTT_CONN_DISCONNECTING) {
-
-        res = lwcell_conn_close(client->conn, 0); /* Close the connection in non-blocking mode */
-        if (res == lwcellOK) {
-            client->conn_state = LWCELL_MQTT_CONN_DISCONNECTING;
+static uint8_t
+prv_prop_get(const uint8_t* props, size_t len, uint8_t id, uint32_t* val) {
+    for (size_t i = 0, n; i < len; i += n) {
+        uint8_t prop_id = props[i++];
+        uint32_t v = 0;
+
+        /* Get size of property value from its type */
+        switch (prop_id) {
+            /* Byte */
+            case 0x01:
+            case 0x17:
+            case 0x19:
+            case 0x24:
+            case 0x25:
+            case 0x28:
+            case 0x29:
+            case 0x2A: n = 1; break;
+            /* Two byte integer */
+            case 0x13:
+            case 0x21:
+            case 0x22:
+            case 0x23: n = 2; break;
+            /* Four byte integer */
+            case 0x02:
+            case 0x11:
+            case 0x18:
+            case 0x27: n = 4; break;
+            /* Variable byte integer */
+            case 0x0B: {
+                if ((n = prv_varint_read(&props[i], len - i, &v)) == 0) {
+                    return 0;
+                }
+                break;
+            }
+            /* UTF-8 string, binary data or string pair */
+            case 0x03:
+            case 0x08:
+            case 0x09:
+            case 0x12:
+            case 0x15:
+            case 0x16:
+            case 0x1A:
+            case 0x1C:
+            case 0x1F:
+            case 0x26: {
+                if (i + 2 > len) {
+                    return 0;
+                }
+                n = 2 + LWCELL_SZ(props[i] << 8 | props[i + 1]);
+                if (prop_id == 0x26) { /* User property is pair of strings */
+                    if (i + n + 2 > len) {
+                        return 0;
+                    }
+                    n += 2 + LWCELL_SZ(props[i + n] << 8 | props[i + n + 1]);
+                }
+                break;
+            }
+            default: return 0; /* Unknown property, rest cannot be parsed */
+        }
+        if (i + n > len) {
+            return 0;
+        }
+        if (prop_id == id) {
+            if (prop_id != 0x0B) {
+                for (size_t k = 0; k < n && k < 4; ++k) {
+                    v = v << 8 | props[i + k];
+                }
+            }
+            *val = v;
+            return 1;
         }
     }
-    return res;
+    return 0;
 }
 
+#if LWCELL_CFG_MQTT_V5_TOPIC_ALIAS || __DOXYGEN__
+
 /**
- * \brief           Subscribe/Unsubscribe to/from MQTT topic
+ * \brief           Get topic alias for publish packet
+ *
+ * Alias of matching cache entry is returned when topic was already sent with alias.
+ * Otherwise alias of free or least recently used entry is returned,
+ * to be assigned with \ref prv_topic_alias_set once packet is written
+ *
  * \param[in]       client: MQTT client
- * \param[in]       topic: MQTT topic to (un)subscribe
- * \param[in]       qos: Quality of service, used only on subscribe part
- * \param[in]       arg: Custom argument
- * \param[in]       sub: Status set to `1` on subscribe or `0` on unsubscribe
- * \return          `1` on success, `0` otherwise
+ * \param[in]       topic: Publish topic
+ * \param[in]       len: Length of topic
+ * \param[out]      is_new: Set to `1` when alias must be sent together with topic, `0` when topic may be omitted
+ * \return          Topic alias or `0` if alias shall not be used
  */
-static uint8_t
-prv_sub_unsub(lwcell_mqtt_client_p client, const char* topic, lwcell_mqtt_qos_t qos, void* arg, uint8_t sub) {
-    lwcell_mqtt_request_t* request;
-    uint32_t rem_len;
-    uint16_t len_topic, pkt_id;
-    uint8_t ret = 0;
+static uint16_t
+prv_topic_alias_get(lwcell_mqtt_client_p client, const char* topic, uint16_t len, uint8_t* is_new) {
+    uint16_t cnt = LWCELL_MIN(client->alias_max, LWCELL_CFG_MQTT_V5_TOPIC_ALIAS), idx = 0;
 
-    if ((len_topic = LWCELL_U16(strlen(topic))) == 0) {
+    /* Alias property takes 3 bytes, shorter topics are sent as they are */
+    if (cnt == 0 || len <= 3) {
         return 0;
     }
+    for (uint16_t i = 0; i < cnt; ++i) {
+        mqtt_topic_alias_t* entry = &client->aliases[i];
 
-    /*
-     * Calculate remaining length of packet
-     *
-     * rem_len = 2 (topic_len) + topic_len + 2 (pkt_id) + qos (if sub)
-     */
-    rem_len = 2 + len_topic + 2;
-    if (sub) {
-        ++rem_len;
+        if (entry->topic != NULL && entry->len == len && !strncmp(entry->topic, topic, len)) {
+            entry->stamp = ++client->alias_stamp;
+            *is_new = 0;
+            return LWCELL_U16(i + 1);
+        }
+        if (entry->stamp < client->aliases[idx].stamp) {
+            idx = i;
+        }
     }
+    *is_new = 1;
+    return LWCELL_U16(idx + 1);
+}
 
-    lwcell_core_lock();
-    if (client->conn_state == LWCELL_MQTT_CONNECTED
-        && prv_output_check_enough_memory(client, rem_len)) { /* Check if enough memory to write packet data */
-        pkt_id = prv_create_packet_id(client);                /* Create new packet ID */
-        /* Create request for packet */
-        if ((request = prv_request_create(client, pkt_id, arg)) != NULL) { /* Do we have a request */
-            prv_write_fixed_header(client, sub ? MQTT_MSG_TYPE_SUBSCRIBE : MQTT_MSG_TYPE_UNSUBSCRIBE, 0,
-                                   (lwcell_mqtt_qos_t)1, 0, rem_len);
-            prv_write_u16(client, pkt_id);              /* Write packet ID */
-            prv_write_string(client, topic, len_topic); /* Write topic string to packet */
-            if (sub) {                                  /* Send quality of service only on subscribe */
-                prv_write_u8(client, LWCELL_MIN(LWCELL_U8(qos),
-                                               LWCELL_U8(LWCELL_MQTT_QOS_EXACTLY_ONCE))); /* Write quality of service */
-            }
-
-            request->status |= sub ? MQTT_REQUEST_FLAG_SUBSCRIBE : MQTT_REQUEST_FLAG_UNSUBSCRIBE;
-            prv_request_set_pending(client, request); /* Set request as pending waiting for server reply */
-            prv_send_data(client);                    /* Try to send data */
-            ret = 1;
-        }
+/**
+ * \brief           Assign topic to alias sent to server
+ * \note            When memory is not available, entry is cleared and topic is sent without alias next time
+ * \param[in]       client: MQTT client
+ * \param[in]       alias: Topic alias, as returned by \ref prv_topic_alias_get
+ * \param[in]       topic: Publish topic
+ * \param[in]       len: Length of topic
+ */
+static void
+prv_topic_alias_set(lwcell_mqtt_client_p client, uint16_t alias, const char* topic, uint16_t len) {
+    mqtt_topic_alias_t* entry = &client->aliases[alias - 1];
+
+    lwcell_mem_free_s((void**)&entry->topic);
+    entry->stamp = 0;
+    if ((entry->topic = lwcell_mem_malloc_tag(len, LWCELL_MEM_TAG_MQTT)) != NULL) {
+        LWCELL_MEMCPY(entry->topic, topic, len);
+        entry->len = len;
+        entry->stamp = ++client->alias_stamp;
     }
-    lwcell_core_unlock();
-    return ret;
 }
 
 /**
- * \brief           Process incoming fully received message
+ * \brief           Clear topic alias cache, aliases are valid for single connection only
  * \param[in]       client: MQTT client
- * \return          `1` on success, `0` otherwise
  */
-static uint8_t
-prv_mqtt_process_incoming_message(lwcell_mqtt_client_p client) {
-    mqtt_msg_type_t msg_type;
-    lwcell_mqtt_qos_t qos;
-    uint16_t pkt_id;
+static void
+prv_topic_alias_reset(lwcell_mqtt_client_p client) {
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(client->aliases); ++i) {
+        lwcell_mem_free_s((void**)&client->aliases[i].topic);
+        client->aliases[i].stamp = 0;
+    }
+    client->alias_max = 0;
+    client->alias_stamp = 0;
+}
 
-    msg_type = MQTT_RCV_GET_PACKET_TYPE(client->msg_hdr_byte); /* Get packet type from message header byte */
+#endif /* LWCELL_CFG_MQTT_V5_TOPIC_ALIAS || __DOXYGEN__ */
 
-    /* Debug message */
-    LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_STATE, "[LWCELL MQTT] Processing packet type %s\r\n",
-                  prv_mqtt_msg_type_to_str(msg_type));
+#endif /* LWCELL_CFG_MQTT_V5 || __DOXYGEN__ */
+
+#if LWCELL_CFG_MQTT_SESSION || __DOXYGEN__
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/* MQTT persistent session                                                                            */
+/******************************************************************************************************/
+/******************************************************************************************************/
+
+/**
+ * \brief           Save or remove session record of in-flight packet
+ * \param[in]       client: MQTT client
+ * \param[in]       pkt_id: Packet ID
+ * \param[in]       data: Raw packet to send again after reconnect, `NULL` to remove record
+ * \param[in]       len: Length of raw packet, `0` to remove record
+ */
+static void
+prv_session_save(lwcell_mqtt_client_p client, uint16_t pkt_id, const void* data, size_t len) {
+    if (client->session != NULL && client->session->write_fn(client->session->arg, pkt_id, data, len) != lwcellOK) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_TRACE_WARNING, "[LWCELL MQTT] Cannot save session record of pkt_id %d\r\n",
+                      (int)pkt_id);
+    }
+}
+
+/**
+ * \brief           Save publish packet written to output buffer to session storage
+ * \param[in]       client: MQTT client
+ * \param[in]       pkt_id: Packet ID
+ * \param[in]       pos: Position of packet in output buffer, relative to read pointer
+ * \param[in]       len: Number of packet bytes in output buffer
+ * \param[in]       ref: Referenced payload, sent after packet bytes. Set to `NULL` if not used
+ * \param[in]       ref_len: Length of referenced payload
+ */
+static void
+prv_session_save_publish(lwcell_mqtt_client_p client, uint16_t pkt_id, size_t pos, size_t len, const void* ref,
+                         size_t ref_len) {
+    uint8_t* rec;
+
+    if (client->session == NULL) {
+        return;
+    }
+    if ((rec = lwcell_mem_malloc_tag(len + ref_len, LWCELL_MEM_TAG_MQTT)) == NULL) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_TRACE_WARNING, "[LWCELL MQTT] No memory for session record\r\n");
+        return;
+    }
+    lwcell_buff_peek(&client->tx_buff, pos, rec, len);
+    if (ref_len > 0) {
+        LWCELL_MEMCPY(&rec[len], ref, ref_len);
+    }
+    prv_session_save(client, pkt_id, rec, len + ref_len);
+    lwcell_mem_free_s((void**)&rec);
+}
+
+/**
+ * \brief           Restore in-flight window from session storage, after connection is accepted
+ *
+ * Requests kept from previous connection keep their user argument,
+ * requests restored after device restart have `NULL` argument.
+ * Kept requests without session record cannot be sent again and fail.
+ *
+ * \param[in]       client: MQTT client
+ * \param[in]       session_present: Set to `1` when server resumed existing session
+ */
+static void
+prv_session_restore(lwcell_mqtt_client_p client, uint8_t session_present) {
+    lwcell_mqtt_request_t* request;
+    uint16_t pkt_id;
+
+    client->session_dup = session_present;
+    client->session_resend = 0;
+    for (size_t i = 0; client->session->read_fn(client->session->arg, i, &pkt_id, NULL, 0) > 0;) {
+        request = &client->requests[pkt_id % client->requests_len];
+        if (pkt_id == 0 || (request->status != 0 && request->packet_id != pkt_id)) {
+            LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_TRACE_WARNING,
+                          "[LWCELL MQTT] Session record of pkt_id %d does not fit in-flight window\r\n", (int)pkt_id);
+            prv_session_save(client, pkt_id, NULL, 0); /* Record at the same index is next one now */
+            continue;
+        }
+        if (request->status == 0) {
+            request->packet_id = pkt_id;
+            request->arg = NULL;
+        }
+        request->status = MQTT_REQUEST_FLAG_IN_USE | MQTT_REQUEST_FLAG_RESEND;
+        prv_request_set_pending(client, request);
+        client->last_packet_id = pkt_id; /* New packet IDs continue after newest record */
+        ++client->session_resend;
+#if LWCELL_CFG_MQTT_V5
+        ++client->recv_used;
+#endif /* LWCELL_CFG_MQTT_V5 */
+        ++i;
+    }
+
+    for (size_t i = 0; i < client->requests_len; ++i) {
+        request = &client->requests[i];
+        if (request->status == MQTT_REQUEST_FLAG_IN_USE) {
+            void* arg = request->arg;
+
+            prv_request_delete(client, request);
+            prv_request_send_err_callback(client, 0, arg);
+        }
+    }
+}
+
+/**
+ * \brief           Write packets of restored requests to output buffer, in session order
+ *
+ * Writing continues on next sent event when output buffer is full
+ *
+ * \param[in]       client: MQTT client
+ */
+static void
+prv_session_resend(lwcell_mqtt_client_p client) {
+    lwcell_mqtt_request_t* request;
+    uint16_t pkt_id;
+    uint8_t* rec;
+    size_t len;
+
+    for (size_t i = 0;
+         client->session_resend > 0 && (len = client->session->read_fn(client->session->arg, i, &pkt_id, NULL, 0)) > 0;
+         ++i) {
+        request = &client->requests[pkt_id % client->requests_len];
+        if (!(request->status & MQTT_REQUEST_FLAG_RESEND) || request->packet_id != pkt_id) {
+            continue;
+        }
+        if (lwcell_buff_get_free(&client->tx_buff) < len
+            || (rec = lwcell_mem_malloc_tag(len, LWCELL_MEM_TAG_MQTT)) == NULL) {
+            break;
+        }
+        client->session->read_fn(client->session->arg, i, &pkt_id, rec, len);
+        if (client->session_dup && MQTT_RCV_GET_PACKET_TYPE(rec[0]) == MQTT_MSG_TYPE_PUBLISH) {
+            rec[0] |= 0x08; /* Set DUP flag, server may have received packet before */
+        }
+        prv_write_data(client, rec, len);
+        lwcell_mem_free_s((void**)&rec);
+
+        request->status &= ~MQTT_REQUEST_FLAG_RESEND;
+        --client->session_resend;
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_TRACE, "[LWCELL MQTT] Session packet of pkt_id %d sent again\r\n",
+                      (int)pkt_id);
+    }
+    prv_send_data(client);
+}
+
+#endif /* LWCELL_CFG_MQTT_SESSION || __DOXYGEN__ */
+
+/**
+ * \brief           Send the actual data to the remote
+ * \param[in]       client: MQTT client
+ */
+static void
+prv_send_data(lwcell_mqtt_client_p client) {
+    lwcell_buff_vec_t vec[2];
+    size_t len, lim;
+    lwcellr_t res;
+
+    if (client->is_sending) { /* We are currently sending data */
+        return;
+    }
+#if LWCELL_CFG_MQTT_OFFLINE_QUEUE
+    if (client->tx_hold) { /* Offline queue is being drained, send all packets together */
+        return;
+    }
+#endif /* LWCELL_CFG_MQTT_OFFLINE_QUEUE */
+    /* Batch is open, hold data until it fills send chunk or half of buffer to leave space for more packets */
+    if (client->tx_cork > 0
+        && lwcell_buff_get_full(&client->tx_buff)
+               < LWCELL_MIN(LWCELL_CFG_CONN_MAX_DATA_LEN, client->tx_buff.size / 2)) {
+        return;
+    }
+
+    len = lwcell_buff_get_read_vec(&client->tx_buff, vec); /* Get both blocks, wrapped data are sent together */
+    lim = len;
+    client->sending_ref = 0;
+    if (client->refs_cnt > 0) {
+        const mqtt_ref_payload_t* ref = &client->refs[client->refs_head];
+
+        lim = LWCELL_SZ(ref->pos - client->tx_buff_pos); /* TX buffer bytes before payload */
+        client->sending_ref = len >= lim;                /* Send payload in the same command after buffer data */
+        lim = LWCELL_MIN(len, lim);
+        client->tx_iov[2].data = ref->payload;
+        client->tx_iov[2].len = client->sending_ref ? ref->len : 0;
+    } else {
+        client->tx_iov[2].data = NULL;
+        client->tx_iov[2].len = 0;
+    }
+    if (lim > 0 || client->sending_ref) { /* Anything to send? */
+        client->sending_buff_len = lim;
+        client->tx_iov[0].data = vec[0].data;
+        client->tx_iov[0].len = LWCELL_MIN(vec[0].len, lim);
+        client->tx_iov[1].data = vec[1].data;
+        client->tx_iov[1].len = lim - client->tx_iov[0].len;
+        if ((res = lwcell_conn_sendv(client->conn, client->tx_iov, LWCELL_ARRAYSIZE(client->tx_iov), NULL, 0))
+            == lwcellOK) {
+            client->written_total += LWCELL_U32(lim + client->tx_iov[2].len);
+            client->is_sending = 1; /* Remember active sending flag */
+        } else {
+            LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_TRACE_WARNING, "[LWCELL MQTT] Cannot send data with error: %d\r\n",
+                          (int)res);
+        }
+    } else {
+        /*
+         * If buffer is empty, reset it to default state (read & write pointers)
+         * This is to make sure everytime function needs to send data,
+         * it can do it in single shot rather than in 2 attempts (when read > write pointer).
+         * Effectively this means faster transmission of MQTT packets and lower latency.
+         */
+        lwcell_buff_reset(&client->tx_buff);
+    }
+}
+
+/**
+ * \brief           Remove first referenced payload from queue and notify application
+ * \param[in]       client: MQTT client
+ * \param[in]       res: Result of payload transmission
+ */
+static void
+prv_ref_release(lwcell_mqtt_client_p client, lwcellr_t res) {
+    mqtt_ref_payload_t* ref = &client->refs[client->refs_head];
+
+    client->refs_head = LWCELL_U8((client->refs_head + 1) % LWCELL_ARRAYSIZE(client->refs));
+    --client->refs_cnt;
+
+    client->evt.type = LWCELL_MQTT_EVT_PUBLISH_REF_RELEASE;
+    client->evt.evt.publish_ref_release.payload = ref->payload;
+    client->evt.evt.publish_ref_release.payload_len = ref->len;
+    client->evt.evt.publish_ref_release.arg = ref->arg;
+    client->evt.evt.publish_ref_release.res = res;
+    client->evt_fn(client, &client->evt);
+}
+
+/**
+ * \brief           Close a MQTT connection with server
+ * \param[in]       client: MQTT client
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+prv_mqtt_close(lwcell_mqtt_client_p client) {
+    lwcellr_t res = lwcellERR;
+    if (client->conn_state != LWCELL_MQTT_CONN_DISCONNECTED && client->conn_state != LWCELL_MQTT_CONN_DISCONNECTING) {
+
+        res = lwcell_conn_close(client->conn, 0); /* Close the connection in non-blocking mode */
+        if (res == lwcellOK) {
+            client->conn_state = LWCELL_MQTT_CONN_DISCONNECTING;
+        }
+    }
+    return res;
+}
+
+/**
+ * \brief           Subscribe/Unsubscribe to/from MQTT topic
+ * \param[in]       client: MQTT client
+ * \param[in]       topic: MQTT topic to (un)subscribe
+ * \param[in]       qos: Quality of service, used only on subscribe part
+ * \param[in]       arg: Custom argument
+ * \param[in]       sub: Status set to `1` on subscribe or `0` on unsubscribe
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_sub_unsub(lwcell_mqtt_client_p client, const char* topic, lwcell_mqtt_qos_t qos, void* arg, uint8_t sub) {
+    lwcell_mqtt_request_t* request;
+    uint32_t rem_len;
+    uint16_t len_topic, pkt_id;
+    uint8_t ret = 0;
+
+    if ((len_topic = LWCELL_U16(strlen(topic))) == 0) {
+        return 0;
+    }
+
+    /*
+     * Calculate remaining length of packet
+     *
+     * rem_len = 2 (topic_len) + topic_len + 2 (pkt_id) + qos (if sub) + 1 (property length, if MQTT 5)
+     */
+    rem_len = 2 + len_topic + 2;
+    if (sub) {
+        ++rem_len;
+    }
+
+    lwcell_core_lock();
+    if (MQTT_IS_V5(client)) {
+        ++rem_len;
+    }
+    if (client->conn_state == LWCELL_MQTT_CONNECTED
+        && prv_output_check_enough_memory(client, rem_len, 0)) { /* Check if enough memory to write packet data */
+        /* Create request for packet */
+        if ((request = prv_request_create(client, 1, arg)) != NULL) { /* Do we have a request */
+            pkt_id = request->packet_id;
+            prv_write_fixed_header(client, sub ? MQTT_MSG_TYPE_SUBSCRIBE : MQTT_MSG_TYPE_UNSUBSCRIBE, 0,
+                                   (lwcell_mqtt_qos_t)1, 0, rem_len);
+            prv_write_u16(client, pkt_id); /* Write packet ID */
+            if (MQTT_IS_V5(client)) {
+                prv_write_u8(client, 0); /* No properties */
+            }
+            prv_write_string(client, topic, len_topic); /* Write topic string to packet */
+            if (sub) {                                  /* Send quality of service only on subscribe */
+                prv_write_u8(client, LWCELL_MIN(LWCELL_U8(qos),
+                                               LWCELL_U8(LWCELL_MQTT_QOS_EXACTLY_ONCE))); /* Write quality of service */
+            }
+
+            request->status |= sub ? MQTT_REQUEST_FLAG_SUBSCRIBE : MQTT_REQUEST_FLAG_UNSUBSCRIBE;
+            prv_request_set_pending(client, request); /* Set request as pending waiting for server reply */
+            prv_send_data(client);                    /* Try to send data */
+            ret = 1;
+        }
+    }
+    lwcell_core_unlock();
+    return ret;
+}
+
+/**
+ * \brief           Write single SUBSCRIBE packet with all session topic filters
+ *
+ * Called right after CONNECT packet is written, so both are sent together.
+ * Server processes packets in order, there is no need to wait for CONNACK
+ *
+ * \param[in]       client: MQTT client
+ */
+static void
+prv_session_subscribe(lwcell_mqtt_client_p client) {
+    const lwcell_mqtt_client_info_t* info = client->info;
+    lwcell_mqtt_request_t* request = NULL;
+    uint32_t rem_len;
+
+    if (info->subs == NULL || info->subs_len == 0) {
+        return;
+    }
+
+    /* rem_len = 2 (pkt_id) + 1 (property length, if MQTT 5) + (2 (topic_len) + topic_len + 1 (qos)) per filter */
+    rem_len = 2 + (MQTT_IS_V5(client) ? 1 : 0);
+    for (size_t i = 0; i < info->subs_len; ++i) {
+        rem_len += 2 + LWCELL_U32(strlen(info->subs[i].topic)) + 1;
+    }
+    if (rem_len > 0xFFFF || !prv_output_check_enough_memory(client, LWCELL_U16(rem_len), 0)
+        || (request = prv_request_create(client, 1, (void*)info->subs)) == NULL) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_TRACE_WARNING, "[LWCELL MQTT] No memory to write session SUBSCRIBE\r\n");
+        prv_request_send_err_callback(client, MQTT_REQUEST_FLAG_SUBSCRIBE, (void*)info->subs);
+        return;
+    }
+
+    prv_write_fixed_header(client, MQTT_MSG_TYPE_SUBSCRIBE, 0, (lwcell_mqtt_qos_t)1, 0, LWCELL_U16(rem_len));
+    prv_write_u16(client, request->packet_id);
+    if (MQTT_IS_V5(client)) {
+        prv_write_u8(client, 0); /* No properties */
+    }
+    for (size_t i = 0; i < info->subs_len; ++i) {
+        prv_write_string(client, info->subs[i].topic, LWCELL_U16(strlen(info->subs[i].topic)));
+        prv_write_u8(client, LWCELL_MIN(LWCELL_U8(info->subs[i].qos), LWCELL_U8(LWCELL_MQTT_QOS_EXACTLY_ONCE)));
+    }
+    request->status |= MQTT_REQUEST_FLAG_SUBSCRIBE;
+    prv_request_set_pending(client, request);
+}
+
+/**
+ * \brief           Notify application about received publish packet or its payload part
+ * \note            Topic is read from RX buffer, flags from packet header byte
+ * \param[in]       client: MQTT client
+ * \param[in]       payload: Payload part
+ * \param[in]       payload_len: Length of payload part
+ * \param[in]       payload_offset: Offset of payload part in full payload
+ * \param[in]       total_len: Full payload length
+ */
+static void
+prv_mqtt_publish_recv_notify(lwcell_mqtt_client_p client, const void* payload, size_t payload_len,
+                             size_t payload_offset, size_t total_len) {
+    client->evt.type = LWCELL_MQTT_EVT_PUBLISH_RECV;
+    client->evt.evt.publish_recv.topic = &client->rx_buff[2];
+    client->evt.evt.publish_recv.topic_len = (client->rx_buff[0] << 8) | client->rx_buff[1];
+    client->evt.evt.publish_recv.payload = payload;
+    client->evt.evt.publish_recv.payload_len = payload_len;
+    client->evt.evt.publish_recv.payload_offset = payload_offset;
+    client->evt.evt.publish_recv.total_len = total_len;
+    client->evt.evt.publish_recv.dup = MQTT_RCV_GET_PACKET_DUP(client->msg_hdr_byte);
+    client->evt.evt.publish_recv.qos = MQTT_RCV_GET_PACKET_QOS(client->msg_hdr_byte);
+    client->evt.evt.publish_recv.retain = MQTT_RCV_GET_PACKET_RETAIN(client->msg_hdr_byte);
+#if LWCELL_CFG_MQTT_TOPIC_ROUTER
+    if (client->topics != NULL
+        && prv_topic_dispatch(client, client->topics, (const char*)client->evt.evt.publish_recv.topic,
+                              client->evt.evt.publish_recv.topic_len, 1)
+               > 0) {
+        return; /* Delivered to topic callbacks */
+    }
+#endif /* LWCELL_CFG_MQTT_TOPIC_ROUTER */
+    client->evt_fn(client, &client->evt);
+}
+
+/**
+ * \brief           Enable connection poll events only when keep-alive is used
+ * \param[in]       client: MQTT client
+ */
+static void
+prv_poll_update(lwcell_mqtt_client_p client) {
+    lwcell_conn_set_poll_interval(client->conn, client->keep_alive > 0 ? MQTT_POLL_INTERVAL : 0);
+}
+
+/**
+ * \brief           Process incoming fully received message
+ * \param[in]       client: MQTT client
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_mqtt_process_incoming_message(lwcell_mqtt_client_p client) {
+    mqtt_msg_type_t msg_type;
+    lwcell_mqtt_qos_t qos;
+    uint16_t pkt_id;
+
+    msg_type = MQTT_RCV_GET_PACKET_TYPE(client->msg_hdr_byte); /* Get packet type from message header byte */
+
+    /* Debug message */
+    LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_STATE, "[LWCELL MQTT] Processing packet type %s\r\n",
+                  prv_mqtt_msg_type_to_str(msg_type));
 
     /* Check received packet type */
     switch (msg_type) {
         case MQTT_MSG_TYPE_CONNACK: {
             lwcell_mqtt_conn_status_t err = (lwcell_mqtt_conn_status_t)client->rx_buff[1];
+#if LWCELL_CFG_MQTT_V5
+            if (client->is_v5) {
+                uint32_t prop_len, val;
+                size_t n;
+
+                /* Map reason codes to MQTT 3.1.1 return codes where possible */
+                switch (client->rx_buff[1]) {
+                    case 0x84: err = LWCELL_MQTT_CONN_STATUS_REFUSED_PROTOCOL_VERSION; break;
+                    case 0x85: err = LWCELL_MQTT_CONN_STATUS_REFUSED_ID; break;
+                    case 0x86: err = LWCELL_MQTT_CONN_STATUS_REFUSED_USER_PASS; break;
+                    case 0x87: err = LWCELL_MQTT_CONN_STATUS_REFUSED_NOT_AUTHORIZED; break;
+                    case 0x88:
+                    case 0x89: err = LWCELL_MQTT_CONN_STATUS_REFUSED_SERVER; break;
+                    default: break;
+                }
+
+                /* Connection limits of the server */
+                if (client->msg_rem_len > 2
+                    && (n = prv_varint_read(&client->rx_buff[2], client->msg_rem_len - 2, &prop_len)) > 0
+                    && 2 + n + prop_len <= client->msg_rem_len) {
+                    const uint8_t* props = &client->rx_buff[2 + n];
+
+                    if (prv_prop_get(props, prop_len, MQTT_PROP_RECEIVE_MAXIMUM, &val) && val > 0) {
+                        client->recv_max = LWCELL_U16(val);
+                    }
+                    if (prv_prop_get(props, prop_len, MQTT_PROP_SERVER_KEEP_ALIVE, &val)) {
+                        client->keep_alive = LWCELL_U16(val);
+                        prv_poll_update(client);
+                    }
+#if LWCELL_CFG_MQTT_V5_TOPIC_ALIAS
+                    if (prv_prop_get(props, prop_len, MQTT_PROP_TOPIC_ALIAS_MAXIMUM, &val)) {
+                        client->alias_max = LWCELL_U16(val);
+                    }
+#endif /* LWCELL_CFG_MQTT_V5_TOPIC_ALIAS */
+                }
+            }
+#endif /* LWCELL_CFG_MQTT_V5 */
             if (client->conn_state == LWCELL_MQTT_CONNECTING) {
                 if (err == LWCELL_MQTT_CONN_STATUS_ACCEPTED) {
                     client->conn_state = LWCELL_MQTT_CONNECTED;
+#if LWCELL_CFG_MQTT_SESSION
+                    if (client->session != NULL) {
+                        uint8_t session_present = client->rx_buff[0] & 0x01;
+
+                        prv_session_restore(client, session_present);
+                        if (!session_present) {
+                            prv_session_subscribe(client); /* Server has no subscriptions of the session */
+                        }
+                        prv_session_resend(client);
+                    }
+#endif /* LWCELL_CFG_MQTT_SESSION */
                 }
                 LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_TRACE, "[LWCELL MQTT] CONNACK received with result: %d\r\n", (int)err);
 
@@ -542,6 +1467,9 @@ prv_mqtt_process_incoming_message(lwcell_mqtt_client_p client) {
                 client->evt.type = LWCELL_MQTT_EVT_CONNECT;
                 client->evt.evt.connect.status = err;
                 client->evt_fn(client, &client->evt);
+#if LWCELL_CFG_MQTT_OFFLINE_QUEUE
+                prv_offline_drain(client); /* Send messages queued while disconnected */
+#endif /* LWCELL_CFG_MQTT_OFFLINE_QUEUE */
             } else {
                 /* Protocol violation here */
                 LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_TRACE,
@@ -551,11 +1479,9 @@ prv_mqtt_process_incoming_message(lwcell_mqtt_client_p client) {
         }
         case MQTT_MSG_TYPE_PUBLISH: {
             uint16_t topic_len, data_len;
-            uint8_t *topic, *data, dup, retain;
+            uint8_t *topic, *data;
 
-            qos = MQTT_RCV_GET_PACKET_QOS(client->msg_hdr_byte);       /* Get QoS from received packet */
-            dup = MQTT_RCV_GET_PACKET_DUP(client->msg_hdr_byte);       /* Get duplicate flag */
-            retain = MQTT_RCV_GET_PACKET_RETAIN(client->msg_hdr_byte); /* Get retain flag */
+            qos = MQTT_RCV_GET_PACKET_QOS(client->msg_hdr_byte); /* Get QoS from received packet */
 
             topic_len = (client->rx_buff[0] << 8) | client->rx_buff[1];
             topic = &client->rx_buff[2]; /* Start of topic */
@@ -569,6 +1495,21 @@ prv_mqtt_process_incoming_message(lwcell_mqtt_client_p client) {
             } else {
                 pkt_id = 0; /* No packet ID */
             }
+#if LWCELL_CFG_MQTT_V5
+            if (client->is_v5) { /* Skip properties */
+                uint32_t prop_len;
+                size_t pos = LWCELL_SZ(data - client->rx_buff), n;
+
+                if (pos >= client->msg_rem_len
+                    || (n = prv_varint_read(data, client->msg_rem_len - pos, &prop_len)) == 0
+                    || pos + n + prop_len > client->msg_rem_len) {
+                    LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_TRACE_WARNING,
+                                  "[LWCELL MQTT] Malformed publish properties. Packet discarded\r\n");
+                    return 0;
+                }
+                data += n + prop_len;
+            }
+#endif                                                             /* LWCELL_CFG_MQTT_V5 */
             data_len = client->msg_rem_len - (data - client->rx_buff); /* Calculate length of remaining data */
 
             LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_TRACE,
@@ -590,15 +1531,7 @@ prv_mqtt_process_incoming_message(lwcell_mqtt_client_p client) {
             }
 
             /* Notify application layer about received packet */
-            client->evt.type = LWCELL_MQTT_EVT_PUBLISH_RECV;
-            client->evt.evt.publish_recv.topic = topic;
-            client->evt.evt.publish_recv.topic_len = topic_len;
-            client->evt.evt.publish_recv.payload = data;
-            client->evt.evt.publish_recv.payload_len = data_len;
-            client->evt.evt.publish_recv.dup = dup;
-            client->evt.evt.publish_recv.qos = qos;
-            client->evt.evt.publish_recv.retain = retain;
-            client->evt_fn(client, &client->evt);
+            prv_mqtt_publish_recv_notify(client, data, data_len, 0, data_len);
             break;
         }
         case MQTT_MSG_TYPE_PINGRESP: { /* Respond to PINGREQ received */
@@ -614,16 +1547,53 @@ prv_mqtt_process_incoming_message(lwcell_mqtt_client_p client) {
         case MQTT_MSG_TYPE_PUBREL:
         case MQTT_MSG_TYPE_PUBACK:
         case MQTT_MSG_TYPE_PUBCOMP: {
+            uint8_t reason = 0;
+
             pkt_id = client->rx_buff[0] << 8 | client->rx_buff[1]; /* Get packet ID */
 
-            if (msg_type == MQTT_MSG_TYPE_PUBREC) { /* Publish record received from server */
+            /*
+             * Reason code is optional in MQTT 5 acknowledges.
+             * (UN)SUBACK has reason code per topic filter, after properties in MQTT 5,
+             * request fails if any of topic filters failed
+             */
+            if (client->msg_rem_len > 2) {
+                size_t pos = 2, end = 3;
+
+                if (msg_type == MQTT_MSG_TYPE_SUBACK || msg_type == MQTT_MSG_TYPE_UNSUBACK) {
+                    end = client->msg_rem_len;
+#if LWCELL_CFG_MQTT_V5
+                    if (client->is_v5) {
+                        uint32_t prop_len;
+                        size_t n = prv_varint_read(&client->rx_buff[2], client->msg_rem_len - 2, &prop_len);
+
+                        pos = n > 0 ? 2 + n + prop_len : end;
+                        if (pos >= end) {
+                            reason = MQTT_REASON_FAILURE;
+                        }
+                    }
+#endif /* LWCELL_CFG_MQTT_V5 */
+                }
+                for (; pos < end; ++pos) {
+                    reason = LWCELL_MAX(reason, client->rx_buff[pos]);
+                }
+            }
+
+            /* Failure reason code in PUBREC ends QoS 2 flow without PUBREL */
+            if (msg_type == MQTT_MSG_TYPE_PUBREC && reason < MQTT_REASON_FAILURE) {
                 prv_write_ack_rec_rel_resp(client, MQTT_MSG_TYPE_PUBREL, pkt_id,
                                            (lwcell_mqtt_qos_t)1); /* Send back publish release message */
+#if LWCELL_CFG_MQTT_SESSION
+                if (client->session != NULL && prv_request_get_pending(client, pkt_id) != NULL) {
+                    /* Server owns the message now, only release is sent again after reconnect */
+                    const uint8_t rel[] = {(uint8_t)(MQTT_MSG_TYPE_PUBREL << 4 | 0x02), 0x02, (uint8_t)(pkt_id >> 8),
+                                           (uint8_t)pkt_id};
+                    prv_session_save(client, pkt_id, rel, sizeof(rel));
+                }
+#endif /* LWCELL_CFG_MQTT_SESSION */
             } else if (msg_type == MQTT_MSG_TYPE_PUBREL) {       /* Publish release was received */
                 prv_write_ack_rec_rel_resp(client, MQTT_MSG_TYPE_PUBCOMP, pkt_id,
                                            (lwcell_mqtt_qos_t)0); /* Send back publish complete */
-            } else if (msg_type == MQTT_MSG_TYPE_SUBACK || msg_type == MQTT_MSG_TYPE_UNSUBACK
-                       || msg_type == MQTT_MSG_TYPE_PUBACK || msg_type == MQTT_MSG_TYPE_PUBCOMP) {
+            } else {
                 lwcell_mqtt_request_t* request;
 
                 /*
@@ -638,20 +1608,38 @@ prv_mqtt_process_incoming_message(lwcell_mqtt_client_p client) {
                         client->evt.type =
                             msg_type == MQTT_MSG_TYPE_SUBACK ? LWCELL_MQTT_EVT_SUBSCRIBE : LWCELL_MQTT_EVT_UNSUBSCRIBE;
                         client->evt.evt.sub_unsub_scribed.arg = request->arg;
-                        client->evt.evt.sub_unsub_scribed.res = client->rx_buff[2] < 3 ? lwcellOK : lwcellERR;
+                        client->evt.evt.sub_unsub_scribed.res = reason < MQTT_REASON_FAILURE ? lwcellOK : lwcellERR;
                         client->evt_fn(client, &client->evt);
 
                         /*
                          * Final acknowledge of packet received
                          * Ack type depends on QoS level being sent to server on request
                          */
-                    } else if (msg_type == MQTT_MSG_TYPE_PUBCOMP || msg_type == MQTT_MSG_TYPE_PUBACK) {
+                    } else {
                         client->evt.type = LWCELL_MQTT_EVT_PUBLISH;
                         client->evt.evt.publish.arg = request->arg;
-                        client->evt.evt.publish.res = lwcellOK;
+                        client->evt.evt.publish.res = reason < MQTT_REASON_FAILURE ? lwcellOK : lwcellERR;
                         client->evt_fn(client, &client->evt);
+#if LWCELL_CFG_MQTT_V5
+                        if (client->recv_used > 0) {
+                            --client->recv_used; /* Free slot of server receive maximum */
+                        }
+#endif /* LWCELL_CFG_MQTT_V5 */
+#if LWCELL_CFG_MQTT_SESSION
+                        prv_session_save(client, pkt_id, NULL, 0); /* Delivery finished */
+                        if (request->status & MQTT_REQUEST_FLAG_RESEND) {
+                            --client->session_resend;
+                        }
+#endif /* LWCELL_CFG_MQTT_SESSION */
                     }
                     prv_request_delete(client, request); /* Delete request object */
+                    prv_request_window_notify(client);
+#if LWCELL_CFG_MQTT_OFFLINE_QUEUE
+                    prv_offline_drain(client);
+#endif /* LWCELL_CFG_MQTT_OFFLINE_QUEUE */
+#if LWCELL_CFG_PWR_RADIO_RELEASE
+                    prv_radio_release_check(client); /* Acknowledge may be last expected packet */
+#endif                                               /* LWCELL_CFG_PWR_RADIO_RELEASE */
                 } else {
                     /* Protocol violation at this point! */
                     LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_TRACE,
@@ -666,10 +1654,32 @@ prv_mqtt_process_incoming_message(lwcell_mqtt_client_p client) {
 }
 
 /**
- * \brief           Parse incoming buffer data and try to construct clean packet from it
+ * \brief           Process complete packet directly from received memory, without copy to RX buffer
  * \param[in]       client: MQTT client
- * \param[in]       pbuf: Received packet buffer with data
- * \return          `1` on success, `0` otherwise
+ * \param[in]       data: Packet data after fixed header
+ * \param[in]       len: Remaining length of packet
+ */
+static void
+prv_mqtt_process_in_place(lwcell_mqtt_client_p client, uint8_t* data, size_t len) {
+    uint8_t* tmp_ptr = client->rx_buff;
+    size_t tmp_len = client->rx_buff_len;
+
+    /* Set new client pointer */
+    client->rx_buff = data;
+    client->rx_buff_len = len;
+
+    prv_mqtt_process_incoming_message(client); /* Process new message */
+
+    /* Reset to previous values */
+    client->rx_buff = tmp_ptr;
+    client->rx_buff_len = tmp_len;
+}
+
+/**
+ * \brief           Parse incoming buffer data and try to construct clean packet from it
+ * \param[in]       client: MQTT client
+ * \param[in]       pbuf: Received packet buffer with data
+ * \return          `1` on success, `0` otherwise
  */
 static uint8_t
 prv_mqtt_parse_incoming(lwcell_mqtt_client_p client, lwcell_pbuf_p pbuf) {
@@ -686,6 +1696,21 @@ prv_mqtt_parse_incoming(lwcell_mqtt_client_p client, lwcell_pbuf_p pbuf) {
             ch = d[idx];
             switch (client->parser_state) {    /* Check parser state */
                 case MQTT_PARSER_STATE_INIT: { /* We are waiting for start byte and packet type */
+                    uint32_t rem_len;
+                    size_t n;
+
+                    /*
+                     * Fast path: complete packet is part of current linear block.
+                     * Parse it in place and reassemble in RX buffer only packets spanning multiple pbufs
+                     */
+                    if ((n = prv_varint_read(&d[idx + 1], buff_len - idx - 1, &rem_len)) > 0
+                        && (buff_len - idx - 1 - n) >= rem_len) {
+                        client->msg_hdr_byte = ch;
+                        client->msg_rem_len = rem_len;
+                        prv_mqtt_process_in_place(client, &d[idx + 1 + n], rem_len);
+                        idx += n + rem_len; /* Skip length and data, idx is increased again in for loop */
+                        break;
+                    }
                     LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_STATE,
                                   "[LWCELL MQTT] Parser init state, received first byte of packet 0x%02X\r\n",
                                   (unsigned)ch);
@@ -715,22 +1740,18 @@ prv_mqtt_parse_incoming(lwcell_mqtt_client_p client, lwcell_pbuf_p pbuf) {
                              * Check must be "greater as" due to idx currently pointing to last length byte and not beginning of data
                              */
                             if ((buff_len - idx) > client->msg_rem_len) {
-                                void* tmp_ptr = client->rx_buff;
-                                size_t tmp_len = client->rx_buff_len;
-
-                                /* Set new client pointer */
-                                client->rx_buff = &d[idx + 1]; /* Data are one byte after */
-                                client->rx_buff_len = client->msg_rem_len;
-
-                                prv_mqtt_process_incoming_message(client); /* Process new message */
-
-                                /* Reset to previous values */
-                                client->rx_buff = tmp_ptr;
-                                client->rx_buff_len = tmp_len;
+                                /* Data are one byte after */
+                                prv_mqtt_process_in_place(client, &d[idx + 1], client->msg_rem_len);
                                 client->parser_state = MQTT_PARSER_STATE_INIT;
 
                                 idx +=
                                     client->msg_rem_len; /* Skip data part only, idx is increased again in for loop */
+#if LWCELL_CFG_MQTT_RECV_STREAM
+                            } else if (client->msg_rem_len > client->rx_buff_len
+                                       && MQTT_RCV_GET_PACKET_TYPE(client->msg_hdr_byte) == MQTT_MSG_TYPE_PUBLISH) {
+                                client->msg_hdr_len = 0;
+                                client->parser_state = MQTT_PARSER_STATE_READ_STREAM;
+#endif /* LWCELL_CFG_MQTT_RECV_STREAM */
                             } else {
                                 client->parser_state = MQTT_PARSER_STATE_READ_REM;
                             }
@@ -742,11 +1763,18 @@ prv_mqtt_parse_incoming(lwcell_mqtt_client_p client, lwcell_pbuf_p pbuf) {
                     break;
                 }
                 case MQTT_PARSER_STATE_READ_REM: { /* Read remaining bytes and write to RX buffer */
+                    /* Copy all packet bytes available in current linear block at once */
+                    size_t part_len = LWCELL_SZ(client->msg_rem_len - client->msg_curr_pos);
+
+                    part_len = LWCELL_MIN(part_len, buff_len - idx);
+
                     /* Process only if rx buff length is big enough */
                     if (client->msg_curr_pos < client->rx_buff_len) {
-                        client->rx_buff[client->msg_curr_pos] = ch; /* Write received character */
+                        LWCELL_MEMCPY(&client->rx_buff[client->msg_curr_pos], &d[idx],
+                                      LWCELL_MIN(part_len, client->rx_buff_len - client->msg_curr_pos));
                     }
-                    ++client->msg_curr_pos;
+                    client->msg_curr_pos += LWCELL_U32(part_len);
+                    idx += part_len - 1; /* idx is increased again in for loop */
 
                     /* We reached end of received characters? */
                     if (client->msg_curr_pos == client->msg_rem_len) {
@@ -765,6 +1793,78 @@ prv_mqtt_parse_incoming(lwcell_mqtt_client_p client, lwcell_pbuf_p pbuf) {
                     }
                     break;
                 }
+#if LWCELL_CFG_MQTT_RECV_STREAM
+                case MQTT_PARSER_STATE_READ_STREAM: { /* Read publish header to RX buffer, then stream payload */
+                    if (client->msg_hdr_len == 0 || client->msg_curr_pos < client->msg_hdr_len
+                        || MQTT_STREAM_HDR_PROPS(client)) {
+                        client->rx_buff[client->msg_curr_pos] = ch;
+                        ++client->msg_curr_pos;
+
+                        /* Topic length received, header consists of topic, optional packet ID and MQTT 5 properties */
+                        if (client->msg_curr_pos == 2) {
+                            uint16_t topic_len = (client->rx_buff[0] << 8) | client->rx_buff[1];
+
+                            client->msg_hdr_len =
+                                LWCELL_U16(2 + topic_len + (MQTT_RCV_GET_PACKET_QOS(client->msg_hdr_byte) > 0 ? 2 : 0));
+#if LWCELL_CFG_MQTT_V5
+                            client->msg_hdr_props = client->is_v5;
+#endif /* LWCELL_CFG_MQTT_V5 */
+                        }
+#if LWCELL_CFG_MQTT_V5
+                        else if (client->msg_hdr_props && client->msg_curr_pos > client->msg_hdr_len) {
+                            uint32_t prop_len;
+                            size_t n = prv_varint_read(&client->rx_buff[client->msg_hdr_len],
+                                                       client->msg_curr_pos - client->msg_hdr_len, &prop_len);
+
+                            /* Property length is complete, properties are part of header */
+                            if (n > 0) {
+                                client->msg_hdr_props = 0;
+                                client->msg_hdr_len =
+                                    LWCELL_U16(LWCELL_MIN(client->msg_hdr_len + n + prop_len, 0xFFFF));
+                            } else if (client->msg_curr_pos - client->msg_hdr_len >= 4) {
+                                client->msg_hdr_len = 0xFFFF; /* Malformed length, discard packet */
+                            }
+                        }
+#endif /* LWCELL_CFG_MQTT_V5 */
+                        if (client->msg_hdr_len > 0
+                            && (client->msg_hdr_len > client->rx_buff_len || client->msg_hdr_len >= client->msg_rem_len
+                                || (MQTT_STREAM_HDR_PROPS(client) && client->msg_curr_pos >= client->rx_buff_len))) {
+                            LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_TRACE_WARNING,
+                                          "[LWCELL MQTT] Publish header too big. Packet discarded\r\n");
+                            /* Read rest and discard it, unless header already consumed entire packet */
+                            client->parser_state = client->msg_curr_pos < client->msg_rem_len
+                                                       ? MQTT_PARSER_STATE_READ_REM
+                                                       : MQTT_PARSER_STATE_INIT;
+                        }
+                    } else {
+                        /* Deliver all payload bytes available in current linear block at once */
+                        size_t part_len = LWCELL_SZ(client->msg_rem_len - client->msg_curr_pos);
+
+                        part_len = LWCELL_MIN(part_len, buff_len - idx);
+
+                        prv_mqtt_publish_recv_notify(client, &d[idx], part_len,
+                                                     client->msg_curr_pos - client->msg_hdr_len,
+                                                     client->msg_rem_len - client->msg_hdr_len);
+                        client->msg_curr_pos += LWCELL_U32(part_len);
+                        idx += part_len - 1; /* idx is increased again in for loop */
+
+                        if (client->msg_curr_pos == client->msg_rem_len) {
+                            lwcell_mqtt_qos_t qos = MQTT_RCV_GET_PACKET_QOS(client->msg_hdr_byte);
+
+                            /* Acknowledge packet once entire payload was delivered */
+                            if (qos > 0) {
+                                size_t pos = 2 + LWCELL_SZ((client->rx_buff[0] << 8) | client->rx_buff[1]);
+                                uint16_t pkt_id = (client->rx_buff[pos] << 8) | client->rx_buff[pos + 1];
+                                prv_write_ack_rec_rel_resp(client,
+                                                           qos == 1 ? MQTT_MSG_TYPE_PUBACK : MQTT_MSG_TYPE_PUBREC,
+                                                           pkt_id, qos);
+                            }
+                            client->parser_state = MQTT_PARSER_STATE_INIT;
+                        }
+                    }
+                    break;
+                }
+#endif /* LWCELL_CFG_MQTT_RECV_STREAM */
                 default: client->parser_state = MQTT_PARSER_STATE_INIT;
             }
         }
@@ -787,7 +1887,17 @@ prv_mqtt_connected_cb(lwcell_mqtt_client_p client) {
     uint16_t rem_len, len_id, len_pass = 0, len_user = 0, len_will_topic = 0, len_will_message = 0;
     uint8_t flags = 0;
 
-    flags |= MQTT_FLAG_CONNECT_CLEAN_SESSION; /* Start as clean session */
+    if (!MQTT_HAS_SESSION(client)) {
+        flags |= MQTT_FLAG_CONNECT_CLEAN_SESSION; /* Start as clean session */
+    }
+
+#if LWCELL_CFG_MQTT_V5
+    client->is_v5 = client->info->version == 5;
+    client->recv_max = 0xFFFF; /* Default when server does not limit it */
+    client->recv_used = 0;
+#endif /* LWCELL_CFG_MQTT_V5 */
+    client->keep_alive = client->info->keep_alive;
+    prv_poll_update(client);
 
     /*
      * Remaining length consist of fixed header data
@@ -809,6 +1919,15 @@ prv_mqtt_connected_cb(lwcell_mqtt_client_p client) {
 
         rem_len += len_will_topic + 2;   /* Add will topic parameter */
         rem_len += len_will_message + 2; /* Add will message parameter */
+        if (MQTT_IS_V5(client)) {
+            ++rem_len; /* Will property length */
+        }
+    }
+    if (MQTT_IS_V5(client)) {
+        ++rem_len; /* Property length */
+        if (MQTT_HAS_SESSION(client)) {
+            rem_len += 5; /* Session expiry interval */
+        }
     }
 
     if (client->info->user != NULL) {        /* Check for username */
@@ -825,19 +1944,33 @@ prv_mqtt_connected_cb(lwcell_mqtt_client_p client) {
         rem_len += len_pass + 2;                          /* Add password length including length entries */
     }
 
-    if (!prv_output_check_enough_memory(client, rem_len)) { /* Is there enough memory to write everything? */
+    if (!prv_output_check_enough_memory(client, rem_len, 0)) { /* Is there enough memory to write everything? */
         return;
     }
 
     /* Write everything to output buffer */
     prv_write_fixed_header(client, MQTT_MSG_TYPE_CONNECT, 0, (lwcell_mqtt_qos_t)0, 0, rem_len);
     prv_write_string(client, "MQTT", 4);                                    /* Protocol name */
-    prv_write_u8(client, 4);                                                /* Protocol version */
+    prv_write_u8(client, MQTT_IS_V5(client) ? 5 : 4);                       /* Protocol version */
     prv_write_u8(client, flags);                                            /* Flags for CONNECT message */
     prv_write_u16(client, client->info->keep_alive);                        /* Keep alive timeout in units of seconds */
-    prv_write_string(client, client->info->id, len_id);                     /* This is client ID string */
-    if (flags & MQTT_FLAG_CONNECT_WILL) {                                   /* Check for will topic */
-        prv_write_string(client, client->info->will_topic, len_will_topic); /* Write topic to packet */
+#if LWCELL_CFG_MQTT_V5 && LWCELL_CFG_MQTT_SESSION
+    if (client->is_v5 && client->session != NULL) {
+        prv_write_u8(client, 5); /* Property length */
+        prv_write_u8(client, MQTT_PROP_SESSION_EXPIRY);
+        prv_write_u16(client, LWCELL_U16(client->session->expiry >> 16));
+        prv_write_u16(client, LWCELL_U16(client->session->expiry));
+    } else
+#endif /* LWCELL_CFG_MQTT_V5 && LWCELL_CFG_MQTT_SESSION */
+        if (MQTT_IS_V5(client)) {
+            prv_write_u8(client, 0); /* No properties, server limits are received in CONNACK */
+        }
+    prv_write_string(client, client->info->id, len_id); /* This is client ID string */
+    if (flags & MQTT_FLAG_CONNECT_WILL) {               /* Check for will topic */
+        if (MQTT_IS_V5(client)) {
+            prv_write_u8(client, 0); /* No will properties */
+        }
+        prv_write_string(client, client->info->will_topic, len_will_topic);     /* Write topic to packet */
         prv_write_string(client, client->info->will_message, len_will_message); /* Write message to packet */
     }
     if (flags & MQTT_FLAG_CONNECT_USERNAME) {                   /* Check for username */
@@ -847,9 +1980,13 @@ prv_mqtt_connected_cb(lwcell_mqtt_client_p client) {
         prv_write_string(client, client->info->pass, len_pass); /* Write password to packet */
     }
 
+    if (!MQTT_HAS_SESSION(client)) {
+        prv_session_subscribe(client); /* Pipeline session subscriptions with CONNECT packet */
+    }
+
     client->parser_state = MQTT_PARSER_STATE_INIT; /* Reset parser state */
 
-    client->poll_time = 0;                      /* Reset kep alive time */
+    client->last_tx_time = lwcell_sys_now();     /* Reset keep alive time */
     client->conn_state = LWCELL_MQTT_CONNECTING; /* MQTT is connecting to server */
 
     prv_send_data(client); /* Flush and send the actual data */
@@ -868,6 +2005,24 @@ prv_mqtt_data_recv_cb(lwcell_mqtt_client_p client, lwcell_pbuf_p pbuf) {
     return 1;
 }
 
+#if LWCELL_CFG_CONN_RECV_FN || __DOXYGEN__
+
+/**
+ * \brief           Receive function of connection, called without event dispatch
+ * \param[in]       conn: Connection handle
+ * \param[in]       pbuf: Received packet buffer
+ * \param[in]       arg: MQTT client, connection argument
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+prv_mqtt_conn_recv_fn(lwcell_conn_p conn, lwcell_pbuf_p pbuf, void* arg) {
+    LWCELL_UNUSED(conn);
+    prv_mqtt_data_recv_cb(arg, pbuf);
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_CONN_RECV_FN || __DOXYGEN__ */
+
 /**
  * \brief           Data sent callback
  * \param[in]       client: MQTT client
@@ -882,7 +2037,7 @@ prv_mqtt_data_sent_cb(lwcell_mqtt_client_p client, size_t sent_len, uint8_t succ
     client->is_sending = 0; /* We are not sending anymore */
     client->sent_total += sent_len;
 
-    client->poll_time = 0; /* Reset kep alive time */
+    client->last_tx_time = lwcell_sys_now(); /* Any sent packet satisfies keep alive */
 
     /*
      * In case transmit was not successful,
@@ -895,7 +2050,13 @@ prv_mqtt_data_sent_cb(lwcell_mqtt_client_p client, size_t sent_len, uint8_t succ
                       "[LWCELL MQTT] Failed to send %d bytes. Manually closing down..\r\n", (int)sent_len);
         return 0;
     }
-    lwcell_buff_skip(&client->tx_buff, sent_len); /* Skip buffer for actual sent data */
+    /* Skip buffer for actual sent data, referenced payload was sent from application memory */
+    lwcell_buff_skip(&client->tx_buff, client->sending_buff_len);
+    client->tx_buff_pos += LWCELL_U32(client->sending_buff_len);
+    if (client->sending_ref) {
+        client->sending_ref = 0;
+        prv_ref_release(client, lwcellOK);
+    }
 
     /*
      * Check pending publish requests without QoS because there is no confirmation received by server.
@@ -913,21 +2074,31 @@ prv_mqtt_data_sent_cb(lwcell_mqtt_client_p client, size_t sent_len, uint8_t succ
         client->evt.evt.publish.arg = arg;
         client->evt.evt.publish.res = lwcellOK;
         client->evt_fn(client, &client->evt);
+        prv_request_window_notify(client);
     }
+#if LWCELL_CFG_MQTT_SESSION
+    if (client->session_resend > 0) {
+        prv_session_resend(client); /* Continue with restored packets */
+    }
+#endif /* LWCELL_CFG_MQTT_SESSION */
+#if LWCELL_CFG_MQTT_OFFLINE_QUEUE
+    prv_offline_drain(client);
+#endif                     /* LWCELL_CFG_MQTT_OFFLINE_QUEUE */
     prv_send_data(client); /* Try to send more */
+#if LWCELL_CFG_PWR_RADIO_RELEASE
+    prv_radio_release_check(client); /* Publish without acknowledge may be last packet */
+#endif                               /* LWCELL_CFG_PWR_RADIO_RELEASE */
     return 1;
 }
 
 /**
  * \brief           Poll for client connection
- *                  Called every LWCELL_CFG_CONN_POLL_INTERVAL ms when MQTT client TCP connection is established
+ *                  Called every \ref MQTT_POLL_INTERVAL ms when keep-alive is used on established connection
  * \param[in]       client: MQTT client
  * \return          `1` on success, `0` otherwise
  */
 static uint8_t
 prv_mqtt_poll_cb(lwcell_mqtt_client_p client) {
-    ++client->poll_time;
-
     if (client->conn_state == LWCELL_MQTT_CONN_DISCONNECTING) {
         return 0;
     }
@@ -935,18 +2106,20 @@ prv_mqtt_poll_cb(lwcell_mqtt_client_p client) {
     /*
      * Check for keep-alive time if equal or greater than
      * keep alive time. In that case, send packet
-     * to make sure we are still alive
+     * to make sure we are still alive.
+     *
+     * Any control packet sent to server within keep alive interval is enough,
+     * and packet written to output but not yet sent resets the time once sent.
+     * Ping is therefore only sent on idle connection
      */
-    if (client->info->keep_alive /* Keep alive must be enabled */
-        /* Poll time is in units of LWCELL_CFG_CONN_POLL_INTERVAL milliseconds,
-           while keep_alive is in units of seconds */
-        && (client->poll_time * LWCELL_CFG_CONN_POLL_INTERVAL) >= (uint32_t)(client->info->keep_alive * 1000)) {
+    if (client->keep_alive /* Keep alive must be enabled */
+        && client->written_total == client->sent_total /* Nothing is waiting in output */
+        && (lwcell_sys_now() - client->last_tx_time) >= (uint32_t)client->keep_alive * 1000U) {
 
-        if (prv_output_check_enough_memory(client, 0)) { /* Check if memory available in output buffer */
+        if (prv_output_check_enough_memory(client, 0, 0)) { /* Check if memory available in output buffer */
             prv_write_fixed_header(client, MQTT_MSG_TYPE_PINGREQ, 0, (lwcell_mqtt_qos_t)0, 0,
                                    0); /* Write PINGREQ command to output buffer */
             prv_send_data(client);     /* Force send data */
-            client->poll_time = 0;     /* Reset polling time */
 
             LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_TRACE, "[LWCELL MQTT] Sending PINGREQ packet\r\n");
         } else {
@@ -992,13 +2165,36 @@ prv_mqtt_closed_cb(lwcell_mqtt_client_p client, lwcellr_t res, uint8_t forced) {
         uint8_t status = request->status;
         void* arg = request->arg;
 
+        if (MQTT_HAS_SESSION(client) && MQTT_REQUEST_IS_PUBLISH_QOS(request)) {
+            request->status = MQTT_REQUEST_FLAG_IN_USE; /* Keep slot, packet is sent again after reconnect */
+            continue;
+        }
         prv_request_delete(client, request);                /* Delete request */
         prv_request_send_err_callback(client, status, arg); /* Send error callback to user */
     }
-    LWCELL_MEMSET(client->requests, 0x00, sizeof(client->requests));
+    if (!MQTT_HAS_SESSION(client)) {
+        LWCELL_MEMSET(client->requests, 0x00, sizeof(*client->requests) * client->requests_len);
+    }
+    client->requests_full = 0;
+
+    /* Release all referenced payloads not sent */
+    while (client->refs_cnt > 0) {
+        prv_ref_release(client, lwcellCLOSED);
+    }
+    client->refs_head = client->sending_ref = 0;
+    client->tx_buff_pos = 0;
 
     client->is_sending = client->sent_total = client->written_total = 0;
     client->parser_state = MQTT_PARSER_STATE_INIT;
+#if LWCELL_CFG_MQTT_SESSION
+    client->session_resend = 0;
+#endif /* LWCELL_CFG_MQTT_SESSION */
+#if LWCELL_CFG_MQTT_V5
+    client->recv_used = 0;
+#if LWCELL_CFG_MQTT_V5_TOPIC_ALIAS
+    prv_topic_alias_reset(client);
+#endif /* LWCELL_CFG_MQTT_V5_TOPIC_ALIAS */
+#endif /* LWCELL_CFG_MQTT_V5 */
     lwcell_buff_reset(&client->tx_buff); /* Reset TX buffer */
 
     LWCELL_UNUSED(forced);
@@ -1047,6 +2243,9 @@ prv_mqtt_conn_cb(lwcell_evt_t* evt) {
 
         /* Connection active to MQTT server */
         case LWCELL_EVT_CONN_ACTIVE: {
+#if LWCELL_CFG_CONN_RECV_FN
+            lwcell_conn_set_recv_fn(conn, prv_mqtt_conn_recv_fn);
+#endif /* LWCELL_CFG_CONN_RECV_FN */
             prv_mqtt_connected_cb(client);
             break;
         }
@@ -1083,15 +2282,37 @@ prv_mqtt_conn_cb(lwcell_evt_t* evt) {
 
 /**
  * \brief           Allocate a new MQTT client structure
+ * \note            In-flight window has \ref LWCELL_CFG_MQTT_MAX_REQUESTS entries,
+ *                  use \ref lwcell_mqtt_client_new_ex to set different size
  * \param[in]       tx_buff_len: Length of raw data output buffer
  * \param[in]       rx_buff_len: Length of raw data input buffer
  * \return          Pointer to new allocated MQTT client structure or `NULL` on failure
  */
 lwcell_mqtt_client_t*
 lwcell_mqtt_client_new(size_t tx_buff_len, size_t rx_buff_len) {
+    return lwcell_mqtt_client_new_ex(tx_buff_len, rx_buff_len, LWCELL_CFG_MQTT_MAX_REQUESTS);
+}
+
+/**
+ * \brief           Allocate a new MQTT client structure with custom in-flight window
+ *
+ * Window defines maximal number of publish and (un)subscribe requests
+ * sent to server and not yet acknowledged or sent out.
+ * \ref LWCELL_MQTT_EVT_WINDOW_FREE event notifies application
+ * when request failed due to full window may be retried.
+ *
+ * \param[in]       tx_buff_len: Length of raw data output buffer
+ * \param[in]       rx_buff_len: Length of raw data input buffer
+ * \param[in]       max_requests: Number of entries in in-flight window
+ * \return          Pointer to new allocated MQTT client structure or `NULL` on failure
+ */
+lwcell_mqtt_client_t*
+lwcell_mqtt_client_new_ex(size_t tx_buff_len, size_t rx_buff_len, uint16_t max_requests) {
     lwcell_mqtt_client_p client;
 
-    if ((client = lwcell_mem_calloc(1, sizeof(*client))) != NULL) {
+    LWCELL_ASSERT0(max_requests > 0);
+
+    if ((client = lwcell_mem_calloc_tag(1, sizeof(*client), LWCELL_MEM_TAG_MQTT)) != NULL) {
         client->conn_state = LWCELL_MQTT_CONN_DISCONNECTED; /* Set to disconnected mode */
 
         if (!lwcell_buff_init(&client->tx_buff, tx_buff_len)) {
@@ -1099,7 +2320,16 @@ lwcell_mqtt_client_new(size_t tx_buff_len, size_t rx_buff_len) {
         }
         if (client != NULL) {
             client->rx_buff_len = rx_buff_len;
-            if ((client->rx_buff = lwcell_mem_malloc(rx_buff_len)) == NULL) {
+            if ((client->rx_buff = lwcell_mem_malloc_tag(rx_buff_len, LWCELL_MEM_TAG_MQTT)) == NULL) {
+                lwcell_buff_free(&client->tx_buff);
+                lwcell_mem_free_s((void**)&client);
+            }
+        }
+        if (client != NULL) {
+            client->requests_len = max_requests;
+            client->requests = lwcell_mem_calloc_tag(max_requests, sizeof(*client->requests), LWCELL_MEM_TAG_MQTT);
+            if (client->requests == NULL) {
+                lwcell_mem_free_s((void**)&client->rx_buff);
                 lwcell_buff_free(&client->tx_buff);
                 lwcell_mem_free_s((void**)&client);
             }
@@ -1116,6 +2346,16 @@ lwcell_mqtt_client_new(size_t tx_buff_len, size_t rx_buff_len) {
 void
 lwcell_mqtt_client_delete(lwcell_mqtt_client_p client) {
     if (client != NULL) {
+#if LWCELL_CFG_MQTT_OFFLINE_QUEUE
+        lwcell_buff_free(&client->offline_buff);
+#endif /* LWCELL_CFG_MQTT_OFFLINE_QUEUE */
+#if LWCELL_CFG_MQTT_TOPIC_ROUTER
+        prv_topic_free(client->topics);
+#endif /* LWCELL_CFG_MQTT_TOPIC_ROUTER */
+#if LWCELL_CFG_MQTT_V5 && LWCELL_CFG_MQTT_V5_TOPIC_ALIAS
+        prv_topic_alias_reset(client);
+#endif /* LWCELL_CFG_MQTT_V5 && LWCELL_CFG_MQTT_V5_TOPIC_ALIAS */
+        lwcell_mem_free_s((void**)&client->requests);
         lwcell_mem_free_s((void**)&client->rx_buff);
         lwcell_buff_free(&client->tx_buff);
         lwcell_mem_free_s((void**)&client);
@@ -1201,7 +2441,63 @@ lwcell_mqtt_client_unsubscribe(lwcell_mqtt_client_p client, const char* topic, v
 }
 
 /**
- * \brief           Publish a new message on specific topic
+ * \brief           Get number of bytes to encode remaining length of packet
+ * \param[in]       rem_len: Remaining length of packet
+ * \return          Number of bytes
+ */
+static uint8_t
+prv_rem_len_size(uint32_t rem_len) {
+    uint8_t size = 0;
+
+    do {
+        ++size;
+        rem_len >>= 7; /* Encoded with 7 bits per byte */
+    } while (rem_len > 0);
+    return size;
+}
+
+/**
+ * \brief           Let application write publish payload directly to output buffer
+ *
+ * Space for packet header is skipped first, as header depends on final payload length.
+ * On success, payload is placed right after header of its final length
+ * and write pointer is returned to the start of packet, to write header in front of payload.
+ * Payload is moved only when its length changes number of bytes of encoded remaining length
+ *
+ * \param[in]       client: MQTT client
+ * \param[in]       rem_len: Remaining length of packet with maximal payload length
+ * \param[in]       max_len: Maximal payload length
+ * \param[in]       payload_fn: Payload writer function
+ * \param[in]       payload_arg: User argument for writer function
+ * \param[out]      len: Output variable to save number of payload bytes written
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+prv_publish_write_payload(lwcell_mqtt_client_p client, uint16_t rem_len, uint16_t max_len,
+                          lwcell_mqtt_client_payload_fn payload_fn, void* payload_arg, uint16_t* len) {
+    lwcell_mqtt_client_writer_t w = {.client = client, .len = 0, .max_len = max_len};
+    size_t start = client->tx_buff.w, size = client->tx_buff.size, hdr_len, shift;
+    lwcellr_t res;
+
+    hdr_len = 1 + prv_rem_len_size(rem_len) + rem_len - max_len;
+    lwcell_buff_advance(&client->tx_buff, hdr_len);
+    res = payload_fn(&w, payload_arg);
+    client->tx_buff.w = start; /* Header is written from start of packet */
+    if (res != lwcellOK) {
+        return res;
+    }
+
+    /* Shorter remaining length is encoded with less bytes, move payload to the end of header */
+    shift = prv_rem_len_size(rem_len) - prv_rem_len_size(rem_len - (max_len - w.len));
+    for (size_t i = 0, from = start + hdr_len; shift > 0 && i < w.len; ++i, ++from) {
+        client->tx_buff.buff[(from - shift) % size] = client->tx_buff.buff[from % size];
+    }
+    *len = LWCELL_U16(w.len);
+    return lwcellOK;
+}
+
+/**
+ * \brief           Build and queue publish packet
  * \param[in]       client: MQTT client
  * \param[in]       topic: Topic to send message to
  * \param[in]       payload: Message data
@@ -1209,35 +2505,73 @@ lwcell_mqtt_client_unsubscribe(lwcell_mqtt_client_p client, const char* topic, v
  * \param[in]       qos: Quality of service. This parameter can be a value of \ref lwcell_mqtt_qos_t enumeration
  * \param[in]       retain: Retian parameter value
  * \param[in]       arg: User custom argument used in callback
+ * \param[in]       is_ref: Set to `1` to send payload from application memory instead of copying it to output buffer
+ * \param[in]       payload_fn: Function to write payload directly to output buffer, used when `payload` is `NULL`.
+ *                      `payload_len` is maximal payload length in this case
+ * \param[in]       payload_arg: User argument for payload writer function
  * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
  */
-lwcellr_t
-lwcell_mqtt_client_publish(lwcell_mqtt_client_p client, const char* topic, const void* payload, uint16_t payload_len,
-                           lwcell_mqtt_qos_t qos, uint8_t retain, void* arg) {
+static lwcellr_t
+prv_publish(lwcell_mqtt_client_p client, const char* topic, const void* payload, uint16_t payload_len,
+            lwcell_mqtt_qos_t qos, uint8_t retain, void* arg, uint8_t is_ref, lwcell_mqtt_client_payload_fn payload_fn,
+            void* payload_arg) {
     lwcellr_t res = lwcellOK;
     lwcell_mqtt_request_t* request = NULL;
     uint32_t rem_len, raw_len;
     uint16_t len_topic, pkt_id;
-    uint8_t qos_u8 = LWCELL_U8(qos);
+    uint8_t qos_u8 = LWCELL_U8(qos), alias_new = 1;
+#if LWCELL_CFG_MQTT_SESSION
+    size_t pkt_pos;
+#endif /* LWCELL_CFG_MQTT_SESSION */
+#if LWCELL_CFG_MQTT_V5
+    uint16_t alias = 0;
+#endif /* LWCELL_CFG_MQTT_V5 */
 
     if ((len_topic = LWCELL_U16(strlen(topic))) == 0) { /* Topic length */
         return lwcellERR;
     }
+    if (is_ref && (payload == NULL || payload_len == 0)) {
+        return lwcellERRPAR;
+    }
 
     /*
      * Calculate remaining length of packet
      *
      * rem_len = 2 (topic_len) + topic_len + payload_len + 2 (pkt_id, only if qos > 0)
+     *
+     * MQTT 5 adds properties with optional topic alias, topic is omitted when alias is already known to server
      */
-    rem_len = 2 + len_topic + (payload != NULL ? payload_len : 0) + (qos_u8 > 0 ? 2 : 0);
+    rem_len = 2 + len_topic + (payload != NULL || payload_fn != NULL ? payload_len : 0) + (qos_u8 > 0 ? 2 : 0);
 
     lwcell_core_lock();
+    if (MQTT_IS_V5(client)) {
+        ++rem_len; /* Property length */
+#if LWCELL_CFG_MQTT_V5 && LWCELL_CFG_MQTT_V5_TOPIC_ALIAS
+        /* Packets saved to session must not depend on aliases of current connection */
+        if (client->conn_state == LWCELL_MQTT_CONNECTED && (qos_u8 == 0 || !MQTT_HAS_SESSION(client))
+            && (alias = prv_topic_alias_get(client, topic, len_topic, &alias_new)) > 0) {
+            rem_len += 3;
+            if (!alias_new) {
+                rem_len -= len_topic;
+            }
+        }
+#endif /* LWCELL_CFG_MQTT_V5 && LWCELL_CFG_MQTT_V5_TOPIC_ALIAS */
+    }
     if (client->conn_state != LWCELL_MQTT_CONNECTED) {
         res = lwcellCLOSED;
-    } else if ((raw_len = prv_output_check_enough_memory(client, rem_len)) != 0) {
-        pkt_id = qos_u8 > 0 ? prv_create_packet_id(client) : 0; /* Create new packet ID */
-        request = prv_request_create(client, pkt_id, arg);      /* Create request for packet */
+#if LWCELL_CFG_MQTT_V5
+    } else if (qos_u8 > 0 && client->recv_used >= client->recv_max) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_TRACE, "[LWCELL MQTT] Receive maximum of server reached\r\n");
+        client->requests_full = 1; /* Notify application when server acknowledges packet */
+        res = lwcellERRMEM;
+#endif /* LWCELL_CFG_MQTT_V5 */
+    } else if (is_ref && client->refs_cnt >= LWCELL_ARRAYSIZE(client->refs)) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_TRACE, "[LWCELL MQTT] No free reference slot to publish message\r\n");
+        res = lwcellERRMEM;
+    } else if ((raw_len = prv_output_check_enough_memory(client, rem_len, is_ref ? payload_len : 0)) != 0) {
+        request = prv_request_create(client, qos_u8 > 0, arg); /* Create request for packet */
         if (request != NULL) {
+            pkt_id = request->packet_id;
             /*
              * Set expected number of bytes we should send before
              * we can say that this packet was sent.
@@ -1246,17 +2580,71 @@ lwcell_mqtt_client_publish(lwcell_mqtt_client_p client, const char* topic, const
              * number of bytes sent before notifying user about success
              */
             request->expected_sent_len = client->written_total + raw_len;
+#if LWCELL_CFG_MQTT_SESSION
+            pkt_pos = lwcell_buff_get_full(&client->tx_buff);
+#endif /* LWCELL_CFG_MQTT_SESSION */
+            if (payload_fn != NULL) {
+                uint16_t max_len = payload_len;
+
+                if ((res = prv_publish_write_payload(client, LWCELL_U16(rem_len), max_len, payload_fn, payload_arg,
+                                                     &payload_len))
+                    != lwcellOK) {
+                    prv_request_delete(client, request);
+                    lwcell_core_unlock();
+                    return res;
+                }
+                rem_len -= max_len - payload_len;
+                request->expected_sent_len = client->written_total + 1 + prv_rem_len_size(rem_len) + rem_len;
+            }
 
             prv_write_fixed_header(client, MQTT_MSG_TYPE_PUBLISH, 0,
                                    (lwcell_mqtt_qos_t)LWCELL_MIN(qos_u8, LWCELL_U8(LWCELL_MQTT_QOS_EXACTLY_ONCE)), retain,
                                    rem_len);
-            prv_write_string(client, topic, len_topic); /* Write topic string to packet */
+            if (alias_new) {
+                prv_write_string(client, topic, len_topic); /* Write topic string to packet */
+            } else {
+                prv_write_u16(client, 0); /* Empty topic, server uses topic of alias */
+            }
             if (qos_u8) {
                 prv_write_u16(client, pkt_id); /* Write packet ID */
             }
-            if (payload != NULL && payload_len) {
+#if LWCELL_CFG_MQTT_V5
+            if (client->is_v5) {
+                if (qos_u8) {
+                    ++client->recv_used;
+                }
+                prv_write_u8(client, alias > 0 ? 3 : 0); /* Property length */
+                if (alias > 0) {
+                    prv_write_u8(client, MQTT_PROP_TOPIC_ALIAS);
+                    prv_write_u16(client, alias);
+#if LWCELL_CFG_MQTT_V5_TOPIC_ALIAS
+                    if (alias_new) {
+                        prv_topic_alias_set(client, alias, topic, len_topic);
+                    }
+#endif /* LWCELL_CFG_MQTT_V5_TOPIC_ALIAS */
+                }
+            }
+#endif /* LWCELL_CFG_MQTT_V5 */
+            if (is_ref) {
+                /* Payload is sent from application memory, remember its position in output stream */
+                mqtt_ref_payload_t* ref =
+                    &client->refs[(client->refs_head + client->refs_cnt) % LWCELL_ARRAYSIZE(client->refs)];
+                ref->payload = payload;
+                ref->len = payload_len;
+                ref->pos = client->tx_buff_pos + LWCELL_U32(lwcell_buff_get_full(&client->tx_buff));
+                ref->arg = arg;
+                ++client->refs_cnt;
+            } else if (payload_fn != NULL) {
+                lwcell_buff_advance(&client->tx_buff, payload_len); /* Payload is already in place */
+            } else if (payload != NULL && payload_len) {
                 prv_write_data(client, payload, payload_len); /* Write RAW topic payload */
             }
+#if LWCELL_CFG_MQTT_SESSION
+            if (qos_u8 > 0) {
+                prv_session_save_publish(client, pkt_id, pkt_pos, lwcell_buff_get_full(&client->tx_buff) - pkt_pos,
+                                         is_ref ? payload : NULL, is_ref ? payload_len : 0);
+            }
+#endif /* LWCELL_CFG_MQTT_SESSION */
             prv_request_set_pending(client, request); /* Set request as pending waiting for server reply */
             prv_send_data(client);                    /* Try to send data */
             LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_TRACE, "[LWCELL MQTT] Pkt publish start. QoS: %d, pkt_id: %d\r\n",
@@ -1273,6 +2661,465 @@ lwcell_mqtt_client_publish(lwcell_mqtt_client_p client, const char* topic, const
     return res;
 }
 
+#if LWCELL_CFG_MQTT_OFFLINE_QUEUE || __DOXYGEN__
+
+/* Offline record header: flags (QoS and retain), topic length with NUL terminator and payload length */
+#define MQTT_OFFLINE_HDR_LEN          5
+#define MQTT_OFFLINE_HDR_TOPIC_LEN(h) LWCELL_U16(LWCELL_U16((h)[1]) | LWCELL_U16((h)[2]) << 8)
+#define MQTT_OFFLINE_HDR_DATA_LEN(h)  LWCELL_U16(LWCELL_U16((h)[3]) | LWCELL_U16((h)[4]) << 8)
+
+/**
+ * \brief           Check if storage tier of offline queue holds any message
+ * \param[in]       client: MQTT client
+ * \return          `1` if storage is used, `0` otherwise
+ */
+static uint8_t
+prv_offline_storage_used(lwcell_mqtt_client_p client) {
+    return client->offline_storage != NULL
+           && client->offline_storage->read_fn(client->offline_storage->arg, NULL, 0) > 0;
+}
+
+/**
+ * \brief           Put publish message to offline queue
+ *
+ * Message goes to storage tier when RAM tier is full,
+ * or when storage already holds older messages to keep them in order
+ *
+ * \param[in]       client: MQTT client
+ * \param[in]       topic: Topic to send message to
+ * \param[in]       payload: Message data
+ * \param[in]       payload_len: Length of payload data
+ * \param[in]       qos: Quality of service
+ * \param[in]       retain: Retain parameter value
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+prv_offline_push(lwcell_mqtt_client_p client, const char* topic, const void* payload, uint16_t payload_len,
+                 lwcell_mqtt_qos_t qos, uint8_t retain) {
+    uint8_t hdr[MQTT_OFFLINE_HDR_LEN], *rec;
+    size_t topic_len, rec_len;
+    lwcellr_t res;
+
+    topic_len = strlen(topic) + 1; /* Keep NUL terminator in the record */
+    if (topic_len == 1 || topic_len > 0xFFFF) {
+        return lwcellERR;
+    }
+    if (payload == NULL) {
+        payload_len = 0;
+    }
+    hdr[0] = LWCELL_U8(LWCELL_MIN(LWCELL_U8(qos), LWCELL_U8(LWCELL_MQTT_QOS_EXACTLY_ONCE)) | (retain ? 0x04 : 0x00));
+    hdr[1] = LWCELL_U8(topic_len);
+    hdr[2] = LWCELL_U8(topic_len >> 8);
+    hdr[3] = LWCELL_U8(payload_len);
+    hdr[4] = LWCELL_U8(payload_len >> 8);
+    rec_len = MQTT_OFFLINE_HDR_LEN + topic_len + payload_len;
+
+    if (!prv_offline_storage_used(client) && lwcell_buff_get_free(&client->offline_buff) >= rec_len) {
+        lwcell_buff_write(&client->offline_buff, hdr, sizeof(hdr));
+        lwcell_buff_write(&client->offline_buff, topic, topic_len);
+        lwcell_buff_write(&client->offline_buff, payload, payload_len);
+        return lwcellOK;
+    }
+    if (client->offline_storage == NULL) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_TRACE_WARNING, "[LWCELL MQTT] Offline queue is full\r\n");
+        return lwcellERRMEM;
+    }
+
+    /* Storage receives complete record in single write */
+    if ((rec = lwcell_mem_malloc_tag(rec_len, LWCELL_MEM_TAG_MQTT)) == NULL) {
+        return lwcellERRMEM;
+    }
+    LWCELL_MEMCPY(rec, hdr, sizeof(hdr));
+    LWCELL_MEMCPY(&rec[MQTT_OFFLINE_HDR_LEN], topic, topic_len);
+    if (payload_len > 0) {
+        LWCELL_MEMCPY(&rec[MQTT_OFFLINE_HDR_LEN + topic_len], payload, payload_len);
+    }
+    res = client->offline_storage->write_fn(client->offline_storage->arg, rec, rec_len);
+    lwcell_mem_free_s((void**)&rec);
+    return res;
+}
+
+/**
+ * \brief           Publish messages from offline queue, oldest first
+ *
+ * Packets are written to TX buffer back-to-back and sent together.
+ * Draining stops when TX buffer or in-flight window is full and continues on next sent or acknowledge event
+ *
+ * \param[in]       client: MQTT client
+ */
+static void
+prv_offline_drain(lwcell_mqtt_client_p client) {
+    uint8_t hdr[MQTT_OFFLINE_HDR_LEN], *rec, from_ram, alloc;
+    size_t rec_len, topic_len;
+    lwcellr_t res;
+
+    if (!client->offline_en || client->tx_hold || client->conn_state != LWCELL_MQTT_CONNECTED) {
+        return;
+    }
+    client->tx_hold = 1;
+    while (1) {
+        rec = NULL;
+        alloc = 0;
+        if (lwcell_buff_get_full(&client->offline_buff) >= MQTT_OFFLINE_HDR_LEN) {
+            lwcell_buff_peek(&client->offline_buff, 0, hdr, sizeof(hdr));
+            rec_len = MQTT_OFFLINE_HDR_LEN + MQTT_OFFLINE_HDR_TOPIC_LEN(hdr) + MQTT_OFFLINE_HDR_DATA_LEN(hdr);
+            if (lwcell_buff_get_linear_block_read_length(&client->offline_buff) >= rec_len) {
+                rec = lwcell_buff_get_linear_block_read_address(&client->offline_buff);
+            } else if ((rec = lwcell_mem_malloc_tag(rec_len, LWCELL_MEM_TAG_MQTT)) != NULL) {
+                lwcell_buff_peek(&client->offline_buff, 0, rec, rec_len); /* Record wraps around buffer end */
+                alloc = 1;
+            }
+            from_ram = 1;
+        } else if (client->offline_storage != NULL
+                   && (rec_len = client->offline_storage->read_fn(client->offline_storage->arg, NULL, 0)) > 0) {
+            if ((rec = lwcell_mem_malloc_tag(rec_len, LWCELL_MEM_TAG_MQTT)) != NULL) {
+                client->offline_storage->read_fn(client->offline_storage->arg, rec, rec_len);
+                alloc = 1;
+            }
+            from_ram = 0;
+        } else {
+            break; /* Queue is empty */
+        }
+        if (rec == NULL) {
+            break; /* Retry when memory is available */
+        }
+
+        /* Publish valid record, invalid one is dropped from queue */
+        topic_len = MQTT_OFFLINE_HDR_TOPIC_LEN(rec);
+        res = lwcellERR;
+        if (rec_len >= MQTT_OFFLINE_HDR_LEN && topic_len > 0
+            && rec_len == MQTT_OFFLINE_HDR_LEN + topic_len + MQTT_OFFLINE_HDR_DATA_LEN(rec)
+            && rec[MQTT_OFFLINE_HDR_LEN + topic_len - 1] == '\0') {
+            res = prv_publish(client, (const char*)&rec[MQTT_OFFLINE_HDR_LEN], &rec[MQTT_OFFLINE_HDR_LEN + topic_len],
+                              MQTT_OFFLINE_HDR_DATA_LEN(rec), (lwcell_mqtt_qos_t)(rec[0] & 0x03),
+                              LWCELL_U8((rec[0] & 0x04) != 0), NULL, 0, NULL, NULL);
+        }
+        if (alloc) {
+            lwcell_mem_free_s((void**)&rec);
+        }
+        if (res == lwcellERRMEM) {
+            break; /* No space in TX buffer or window, continue later */
+        }
+        if (from_ram) {
+            lwcell_buff_skip(&client->offline_buff, rec_len);
+        } else {
+            client->offline_storage->remove_fn(client->offline_storage->arg);
+        }
+    }
+    client->tx_hold = 0;
+    prv_send_data(client);
+}
+
+/**
+ * \brief           Enable offline publish queue
+ *
+ * When enabled, \ref lwcell_mqtt_client_publish called while client is not connected
+ * stores message to queue instead of failing.
+ * Queue is published in order after connection is accepted by server.
+ * Messages published while queue is not empty are queued too, to keep the order.
+ *
+ * Messages are first stored to RAM tier. When it is full, messages go to storage tier, if set.
+ * Messages already present in storage, for example after device reset, are published after RAM tier.
+ *
+ * \note            Queued messages are published with `NULL` user argument
+ * \note            \ref lwcell_mqtt_client_publish_ref does not use the queue
+ * \param[in]       client: MQTT client. Must be disconnected
+ * \param[in]       ram_len: Size of RAM tier in units of bytes. Set to `0` to use storage only
+ * \param[in]       storage: Storage tier callbacks. Set to `NULL` to use RAM tier only.
+ *                      Structure must stay valid while client is used
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_mqtt_client_set_offline_queue(lwcell_mqtt_client_p client, size_t ram_len,
+                                     const lwcell_mqtt_offline_storage_t* storage) {
+    lwcellr_t res = lwcellOK;
+
+    LWCELL_ASSERT(client != NULL);
+    LWCELL_ASSERT(storage == NULL
+                  || (storage->write_fn != NULL && storage->read_fn != NULL && storage->remove_fn != NULL));
+
+    lwcell_core_lock();
+    if (client->conn_state != LWCELL_MQTT_CONN_DISCONNECTED) {
+        res = lwcellERR;
+    } else {
+        lwcell_buff_free(&client->offline_buff);
+        LWCELL_MEMSET(&client->offline_buff, 0x00, sizeof(client->offline_buff));
+        if (ram_len > 0 && !lwcell_buff_init(&client->offline_buff, ram_len)) {
+            res = lwcellERRMEM;
+        }
+        client->offline_storage = storage;
+        client->offline_en = res == lwcellOK && (ram_len > 0 || storage != NULL);
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+#endif /* LWCELL_CFG_MQTT_OFFLINE_QUEUE || __DOXYGEN__ */
+
+#if LWCELL_CFG_MQTT_SESSION || __DOXYGEN__
+
+/**
+ * \brief           Enable persistent session
+ *
+ * When enabled, client connects without clean session flag and keeps
+ * QoS `1` and `2` publish packets in storage until delivery is finished.
+ * After connection is accepted, stored packets are sent again, before any new packet,
+ * also after device reset. Session subscriptions from \ref lwcell_mqtt_client_info_t
+ * are only sent when server has no session.
+ *
+ * \note            Publish packets saved to session do not use MQTT 5 topic aliases
+ * \note            Requests restored after device reset have `NULL` user argument
+ * \param[in]       client: MQTT client. Must be disconnected
+ * \param[in]       storage: Session storage callbacks. Set to `NULL` to start clean session on every connect.
+ *                      Structure must stay valid while client is used
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_mqtt_client_set_session(lwcell_mqtt_client_p client, const lwcell_mqtt_session_storage_t* storage) {
+    lwcellr_t res = lwcellOK;
+
+    LWCELL_ASSERT(client != NULL);
+    LWCELL_ASSERT(storage == NULL || (storage->write_fn != NULL && storage->read_fn != NULL));
+
+    lwcell_core_lock();
+    if (client->conn_state != LWCELL_MQTT_CONN_DISCONNECTED) {
+        res = lwcellERR;
+    } else {
+        /* Requests kept for previous session cannot be sent again anymore */
+        for (size_t i = 0; storage == NULL && i < client->requests_len; ++i) {
+            if (client->requests[i].status & MQTT_REQUEST_FLAG_IN_USE) {
+                void* arg = client->requests[i].arg;
+
+                prv_request_delete(client, &client->requests[i]);
+                prv_request_send_err_callback(client, 0, arg);
+            }
+        }
+        client->session = storage;
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+#endif /* LWCELL_CFG_MQTT_SESSION || __DOXYGEN__ */
+
+/**
+ * \brief           Publish a new message on specific topic
+ * \note            When offline queue is enabled with \ref lwcell_mqtt_client_set_offline_queue,
+ *                  message is queued while client is not connected
+ * \param[in]       client: MQTT client
+ * \param[in]       topic: Topic to send message to
+ * \param[in]       payload: Message data
+ * \param[in]       payload_len: Length of payload data
+ * \param[in]       qos: Quality of service. This parameter can be a value of \ref lwcell_mqtt_qos_t enumeration
+ * \param[in]       retain: Retian parameter value
+ * \param[in]       arg: User custom argument used in callback
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_mqtt_client_publish(lwcell_mqtt_client_p client, const char* topic, const void* payload, uint16_t payload_len,
+                           lwcell_mqtt_qos_t qos, uint8_t retain, void* arg) {
+#if LWCELL_CFG_MQTT_OFFLINE_QUEUE
+    lwcellr_t res;
+
+    lwcell_core_lock();
+    if (client->offline_en
+        && (client->conn_state != LWCELL_MQTT_CONNECTED || lwcell_buff_get_full(&client->offline_buff) > 0
+            || prv_offline_storage_used(client))) {
+        res = prv_offline_push(client, topic, payload, payload_len, qos, retain);
+        prv_offline_drain(client);
+        lwcell_core_unlock();
+        return res;
+    }
+    lwcell_core_unlock();
+#endif /* LWCELL_CFG_MQTT_OFFLINE_QUEUE */
+    return prv_publish(client, topic, payload, payload_len, qos, retain, arg, 0, NULL, NULL);
+}
+
+/**
+ * \brief           Publish a new message on specific topic without copying payload to output buffer
+ *
+ * Only packet header is written to output buffer, payload is sent directly from application memory.
+ * \ref LWCELL_MQTT_EVT_PUBLISH_REF_RELEASE event is called once payload memory is no longer used by the stack.
+ *
+ * \note            Payload memory must stay valid and unmodified until release event
+ * \param[in]       client: MQTT client
+ * \param[in]       topic: Topic to send message to
+ * \param[in]       payload: Message data. Must not be `NULL`
+ * \param[in]       payload_len: Length of payload data. Must be greater than `0`
+ * \param[in]       qos: Quality of service. This parameter can be a value of \ref lwcell_mqtt_qos_t enumeration
+ * \param[in]       retain: Retian parameter value
+ * \param[in]       arg: User custom argument used in callback
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise.
+ *                  Release event is not called if function does not return \ref lwcellOK
+ */
+lwcellr_t
+lwcell_mqtt_client_publish_ref(lwcell_mqtt_client_p client, const char* topic, const void* payload,
+                               uint16_t payload_len, lwcell_mqtt_qos_t qos, uint8_t retain, void* arg) {
+    return prv_publish(client, topic, payload, payload_len, qos, retain, arg, 1, NULL, NULL);
+}
+
+/**
+ * \brief           Publish a new message on specific topic, with payload serialized directly to output buffer
+ *
+ * Space for maximal payload is reserved in output buffer and writer function is called immediately,
+ * before this function returns. Application writes payload with \ref lwcell_mqtt_client_writer_get_buff
+ * and \ref lwcell_mqtt_client_writer_commit, or with \ref lwcell_mqtt_client_writer_write,
+ * without intermediate buffer. Packet header is written afterwards, with actual payload length.
+ *
+ * \note            Writer function is called with core locked and must not call other API functions.
+ *                  Message is not stored to offline queue
+ * \param[in]       client: MQTT client
+ * \param[in]       topic: Topic to send message to
+ * \param[in]       max_len: Maximal payload length
+ * \param[in]       payload_fn: Function to write payload
+ * \param[in]       payload_arg: User argument for writer function
+ * \param[in]       qos: Quality of service. This parameter can be a value of \ref lwcell_mqtt_qos_t enumeration
+ * \param[in]       retain: Retian parameter value
+ * \param[in]       arg: User custom argument used in callback
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise.
+ *                  Result of writer function is returned when it fails, message is not sent in this case
+ */
+lwcellr_t
+lwcell_mqtt_client_publish_writer(lwcell_mqtt_client_p client, const char* topic, uint16_t max_len,
+                                  lwcell_mqtt_client_payload_fn payload_fn, void* payload_arg, lwcell_mqtt_qos_t qos,
+                                  uint8_t retain, void* arg) {
+    LWCELL_ASSERT(payload_fn != NULL);
+
+    return prv_publish(client, topic, NULL, max_len, qos, retain, arg, 0, payload_fn, payload_arg);
+}
+
+/**
+ * \brief           Get linear part of output buffer to serialize payload to
+ * \note            Function may only be called from payload writer function
+ * \param[in]       w: Payload writer
+ * \param[out]      len: Output variable to save number of bytes available at returned address.
+ *                      It may be less than remaining payload length, when output buffer wraps around
+ * \return          Address to write payload to, or `NULL` when no more data can be written
+ */
+void*
+lwcell_mqtt_client_writer_get_buff(lwcell_mqtt_client_writer_t* w, size_t* len) {
+    *len = LWCELL_MIN(lwcell_buff_get_linear_block_write_length(&w->client->tx_buff), w->max_len - w->len);
+    return *len > 0 ? lwcell_buff_get_linear_block_write_address(&w->client->tx_buff) : NULL;
+}
+
+/**
+ * \brief           Confirm payload bytes written to address returned by \ref lwcell_mqtt_client_writer_get_buff
+ * \note            Function may only be called from payload writer function
+ * \param[in]       w: Payload writer
+ * \param[in]       len: Number of bytes written
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_mqtt_client_writer_commit(lwcell_mqtt_client_writer_t* w, size_t len) {
+    if (len > lwcell_buff_get_linear_block_write_length(&w->client->tx_buff) || len > w->max_len - w->len) {
+        return lwcellERRPAR;
+    }
+    lwcell_buff_advance(&w->client->tx_buff, len);
+    w->len += len;
+    return lwcellOK;
+}
+
+/**
+ * \brief           Write part of payload, for serializers producing small pieces of data
+ * \note            Function may only be called from payload writer function
+ * \param[in]       w: Payload writer
+ * \param[in]       data: Data to write
+ * \param[in]       len: Number of bytes to write
+ * \return          \ref lwcellOK on success, \ref lwcellERRMEM when maximal payload length would be exceeded
+ */
+lwcellr_t
+lwcell_mqtt_client_writer_write(lwcell_mqtt_client_writer_t* w, const void* data, size_t len) {
+    if (len > w->max_len - w->len) {
+        return lwcellERRMEM;
+    }
+    prv_write_data(w->client, data, len);
+    w->len += len;
+    return lwcellOK;
+}
+
+#if LWCELL_CFG_COMPRESS || __DOXYGEN__
+
+/**
+ * \brief           Compress payload and publish it as single frame on specific topic
+ *
+ * Payload is compressed to compressor state and copied to output buffer by \ref lwcell_mqtt_client_publish.
+ * Receiver restores payload with \ref lwcell_decompress_frame.
+ *
+ * \param[in]       client: MQTT client
+ * \param[in]       comp: Compressor state, used by one thread at a time
+ * \param[in]       topic: Topic to send message to
+ * \param[in]       payload: Message data
+ * \param[in]       payload_len: Length of payload data.
+ *                      Must not be greater than \ref LWCELL_CFG_COMPRESS_BLOCK_LEN
+ * \param[in]       qos: Quality of service. This parameter can be a value of \ref lwcell_mqtt_qos_t enumeration
+ * \param[in]       retain: Retian parameter value
+ * \param[in]       arg: User custom argument used in callback
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_mqtt_client_publish_compressed(lwcell_mqtt_client_p client, lwcell_compress_t* comp, const char* topic,
+                                      const void* payload, uint16_t payload_len, lwcell_mqtt_qos_t qos,
+                                      uint8_t retain, void* arg) {
+    size_t len;
+
+    LWCELL_ASSERT(comp != NULL);
+    LWCELL_ASSERT(payload != NULL || payload_len == 0);
+    LWCELL_ASSERT(payload_len <= LWCELL_CFG_COMPRESS_BLOCK_LEN);
+
+    len = lwcell_compress_frame(comp, payload, payload_len);
+    return lwcell_mqtt_client_publish(client, topic, comp->frame, (uint16_t)len, qos, retain, arg);
+}
+
+#endif /* LWCELL_CFG_COMPRESS || __DOXYGEN__ */
+
+/**
+ * \brief           Start publish batch
+ *
+ * Packets written by the client after this call are kept in output buffer
+ * and sent together with single send command on \ref lwcell_mqtt_client_publish_end.
+ * Data is sent earlier only when it fills maximal send chunk or half of TX buffer.
+ *
+ * \note            Calls can be nested, data is sent when last batch is closed
+ * \param[in]       client: MQTT client
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_mqtt_client_publish_begin(lwcell_mqtt_client_p client) {
+    lwcellr_t res = lwcellERR;
+
+    LWCELL_ASSERT(client != NULL);
+
+    lwcell_core_lock();
+    if (client->tx_cork < 0xFF) {
+        ++client->tx_cork;
+        res = lwcellOK;
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           End publish batch and send all packets written since \ref lwcell_mqtt_client_publish_begin
+ * \param[in]       client: MQTT client
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_mqtt_client_publish_end(lwcell_mqtt_client_p client) {
+    lwcellr_t res = lwcellERR;
+
+    LWCELL_ASSERT(client != NULL);
+
+    lwcell_core_lock();
+    if (client->tx_cork > 0) {
+        if (--client->tx_cork == 0 && client->conn_state == LWCELL_MQTT_CONNECTED) {
+            prv_send_data(client); /* Flush batched packets */
+        }
+        res = lwcellOK;
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
 /**
  * \brief           Test if client is connected to server and accepted to MQTT protocol
  * \note            Function will return error if TCP is connected but MQTT not accepted
@@ -1309,3 +3156,31 @@ void*
 lwcell_mqtt_client_get_arg(lwcell_mqtt_client_p client) {
     return client->arg;
 }
+
+/**
+ * \brief           Replace RX buffer with new one and take buffer holding received publish packet
+ *
+ * Topic and payload pointers of the event stay valid in returned buffer,
+ * so application may keep them without copying. New buffer is used for following packets.
+ *
+ * \note            Function may only be called from \ref LWCELL_MQTT_EVT_PUBLISH_RECV event
+ * \param[in]       client: MQTT client
+ * \param[in]       evt: Event handle
+ * \param[in]       buff: New RX buffer with at least RX buffer length, as passed to \ref lwcell_mqtt_client_new
+ * \return          Previous RX buffer or `NULL` when event data are not in RX buffer, such as streamed payload parts.
+ *                  Buffer was allocated with \ref lwcell_mem_malloc
+ */
+uint8_t*
+lwcell_mqtt_client_swap_rx_buff(lwcell_mqtt_client_p client, lwcell_mqtt_evt_t* evt, uint8_t* buff) {
+    uint8_t* old = client->rx_buff;
+    const uint8_t* payload = evt->evt.publish_recv.payload;
+
+    if (buff == NULL || evt != &client->evt || evt->type != LWCELL_MQTT_EVT_PUBLISH_RECV
+        || evt->evt.publish_recv.topic != &old[2]
+        || (evt->evt.publish_recv.payload_len > 0
+            && (payload < old || payload + evt->evt.publish_recv.payload_len > old + client->rx_buff_len))) {
+        return NULL;
+    }
+    client->rx_buff = buff;
+    return old;
+}
@@ -52,6 +52,15 @@ struct lwcell_mqtt_client_api {
     uint8_t release_sem;                   /*!< Set to `1` to release semaphore */
     lwcell_mqtt_conn_status_t connect_resp; /*!< Response when connecting to server */
     lwcellr_t sub_pub_resp;                 /*!< Subscribe/Unsubscribe/Publish response */
+#if LWCELL_CFG_MQTT_API_BUF_POOL_SIZE > 0 || __DOXYGEN__
+    size_t rx_buff_len;                                                       /*!< Length of pool buffer data */
+    lwcell_mqtt_client_api_buf_t pool[LWCELL_CFG_MQTT_API_BUF_POOL_SIZE];      /*!< Receive buffer pool */
+    lwcell_mqtt_client_api_buf_p pool_free[LWCELL_CFG_MQTT_API_BUF_POOL_SIZE]; /*!< Stack of free pool buffers */
+    size_t pool_free_cnt; /*!< Number of free buffers in pool, protected by core lock */
+#endif                    /* LWCELL_CFG_MQTT_API_BUF_POOL_SIZE > 0 || __DOXYGEN__ */
+#if LWCELL_CFG_MQTT_RECV_STREAM || __DOXYGEN__
+    lwcell_mqtt_client_api_buf_p stream_buf; /*!< Streamed publish packet, waiting for remaining parts */
+#endif                                       /* LWCELL_CFG_MQTT_RECV_STREAM || __DOXYGEN__ */
 } lwcell_mqtt_client_api_t;
 
 /**
@@ -71,6 +80,152 @@ prv_release_sem(lwcell_mqtt_client_api_p client) {
     }
 }
 
+#if LWCELL_CFG_MQTT_API_BUF_POOL_SIZE > 0 || __DOXYGEN__
+
+/**
+ * \brief           Get buffer from pool and fill it with received publish packet
+ * \param[in]       api_client: MQTT API client
+ * \param[in]       client: MQTT client
+ * \param[in]       evt: Publish receive event
+ * \return          Buffer on success, `NULL` when pool is empty or packet does not fit
+ */
+static lwcell_mqtt_client_api_buf_p
+prv_pool_buf_get(lwcell_mqtt_client_api_p api_client, lwcell_mqtt_client_p client, lwcell_mqtt_evt_t* evt) {
+    lwcell_mqtt_client_api_buf_p buf;
+    const char* topic = lwcell_mqtt_client_evt_publish_recv_get_topic(client, evt);
+    size_t topic_len = lwcell_mqtt_client_evt_publish_recv_get_topic_len(client, evt);
+    const uint8_t* payload = lwcell_mqtt_client_evt_publish_recv_get_payload(client, evt);
+    size_t payload_len = lwcell_mqtt_client_evt_publish_recv_get_payload_len(client, evt);
+
+    LWCELL_UNUSED(client); /* Not used by event macros */
+    if (api_client->pool_free_cnt == 0) {
+        return NULL;
+    }
+    buf = api_client->pool_free[api_client->pool_free_cnt - 1];
+#if LWCELL_CFG_MQTT_API_RX_REF
+    uint8_t* old = lwcell_mqtt_client_swap_rx_buff(client, evt, buf->pool_data);
+    if (old != NULL) {
+        /* Keep packet in place, client continues with pool memory */
+        buf->pool_data = old;
+        buf->topic = (char*)topic;
+        buf->payload = (uint8_t*)payload;
+    } else
+#endif /* LWCELL_CFG_MQTT_API_RX_REF */
+    {
+        if (topic_len + payload_len + 2 > api_client->rx_buff_len) {
+            return NULL;
+        }
+        buf->topic = (char*)buf->pool_data;
+        buf->payload = &buf->pool_data[topic_len + 1];
+        LWCELL_MEMCPY(buf->topic, topic, sizeof(*topic) * topic_len);
+        buf->topic[topic_len] = '\0';
+        LWCELL_MEMCPY(buf->payload, payload, sizeof(*payload) * payload_len);
+        buf->payload[payload_len] = 0;
+    }
+    buf->topic_len = topic_len;
+    buf->payload_len = payload_len;
+    buf->qos = lwcell_mqtt_client_evt_publish_recv_get_qos(client, evt);
+    buf->retain = lwcell_mqtt_client_evt_publish_recv_get_retain(client, evt);
+    --api_client->pool_free_cnt;
+    return buf;
+}
+
+#endif /* LWCELL_CFG_MQTT_API_BUF_POOL_SIZE > 0 || __DOXYGEN__ */
+
+/**
+ * \brief           Allocate buffer for received publish packet from heap and copy topic to it
+ * \param[in]       topic: Packet topic
+ * \param[in]       topic_len: Length of topic
+ * \param[in]       payload_len: Length of full payload, copied by caller
+ * \param[in]       qos: Packet quality of service
+ * \param[in]       retain: Packet retain status
+ * \return          Buffer on success, `NULL` otherwise
+ */
+static lwcell_mqtt_client_api_buf_p
+prv_heap_buf_alloc(const char* topic, size_t topic_len, size_t payload_len, lwcell_mqtt_qos_t qos, uint8_t retain) {
+    lwcell_mqtt_client_api_buf_p buf;
+    size_t size, buf_size, topic_size, payload_size;
+
+    /* Calculate memory sizes */
+    buf_size = LWCELL_MEM_ALIGN(sizeof(*buf));
+    topic_size = LWCELL_MEM_ALIGN(sizeof(*topic) * (topic_len + 1));
+    payload_size = LWCELL_MEM_ALIGN(sizeof(*buf->payload) * (payload_len + 1));
+
+    size = buf_size + topic_size + payload_size;
+    if ((buf = lwcell_mem_malloc_tag(size, LWCELL_MEM_TAG_MQTT)) == NULL) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_API_TRACE_WARNING,
+                      "[MQTT API] Cannot allocate memory for packet buffer of size %d bytes\r\n", (int)size);
+        return NULL;
+    }
+    LWCELL_MEMSET(buf, 0x00, size);
+    buf->topic = (void*)((uint8_t*)buf + buf_size);
+    buf->payload = (void*)((uint8_t*)buf + buf_size + topic_size);
+    buf->topic_len = topic_len;
+    buf->payload_len = payload_len;
+    buf->qos = qos;
+    buf->retain = retain;
+    LWCELL_MEMCPY(buf->topic, topic, sizeof(*topic) * topic_len);
+    return buf;
+}
+
+/**
+ * \brief           Write received publish packet to receive queue, or free it when queue is full
+ * \param[in]       api_client: MQTT API client
+ * \param[in]       buf: Buffer with received packet
+ */
+static void
+prv_rcv_put(lwcell_mqtt_client_api_p api_client, lwcell_mqtt_client_api_buf_p buf) {
+    if (!lwcell_sys_mbox_putnow(&api_client->rcv_mbox, buf)) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_API_TRACE_WARNING,
+                      "[MQTT API] Cannot put new received MQTT publish to queue\r\n");
+        lwcell_mqtt_client_api_buf_free(buf);
+    }
+}
+
+#if LWCELL_CFG_MQTT_RECV_STREAM || __DOXYGEN__
+
+/**
+ * \brief           Reassemble publish packet, received in multiple parts
+ *
+ * Heap buffer for full payload is allocated on first part
+ * and packet is written to receive queue after last part.
+ * When buffer cannot be allocated, all parts of the packet are discarded
+ *
+ * \param[in]       api_client: MQTT API client
+ * \param[in]       client: MQTT client
+ * \param[in]       evt: Publish receive event with payload part
+ */
+static void
+prv_stream_part(lwcell_mqtt_client_api_p api_client, lwcell_mqtt_client_p client, lwcell_mqtt_evt_t* evt) {
+    lwcell_mqtt_client_api_buf_p buf;
+    const uint8_t* payload = lwcell_mqtt_client_evt_publish_recv_get_payload(client, evt);
+    size_t payload_len = lwcell_mqtt_client_evt_publish_recv_get_payload_len(client, evt);
+    size_t offset = lwcell_mqtt_client_evt_publish_recv_get_payload_offset(client, evt);
+
+    LWCELL_UNUSED(client); /* Not used by event macros */
+    if (offset == 0) {
+        /* Previous packet cannot be completed anymore */
+        if (api_client->stream_buf != NULL) {
+            lwcell_mqtt_client_api_buf_free(api_client->stream_buf);
+        }
+        api_client->stream_buf = prv_heap_buf_alloc(lwcell_mqtt_client_evt_publish_recv_get_topic(client, evt),
+                                                    lwcell_mqtt_client_evt_publish_recv_get_topic_len(client, evt),
+                                                    lwcell_mqtt_client_evt_publish_recv_get_total_len(client, evt),
+                                                    lwcell_mqtt_client_evt_publish_recv_get_qos(client, evt),
+                                                    lwcell_mqtt_client_evt_publish_recv_get_retain(client, evt));
+    }
+    if ((buf = api_client->stream_buf) == NULL || offset + payload_len > buf->payload_len) {
+        return; /* Packet is discarded */
+    }
+    LWCELL_MEMCPY(&buf->payload[offset], payload, sizeof(*payload) * payload_len);
+    if (offset + payload_len == buf->payload_len) {
+        api_client->stream_buf = NULL;
+        prv_rcv_put(api_client, buf);
+    }
+}
+
+#endif /* LWCELL_CFG_MQTT_RECV_STREAM || __DOXYGEN__ */
+
 /**
  * \brief           MQTT event callback function
  */
@@ -108,8 +263,15 @@ prv_mqtt_evt(lwcell_mqtt_client_p client, lwcell_mqtt_evt_t* evt) {
             if (!lwcell_sys_mbox_isvalid(&api_client->rcv_mbox)) {
                 break;
             }
+#if LWCELL_CFG_MQTT_RECV_STREAM
+            /* Packet received in multiple parts is reassembled first */
+            if (lwcell_mqtt_client_evt_publish_recv_get_payload_len(client, evt)
+                != lwcell_mqtt_client_evt_publish_recv_get_total_len(client, evt)) {
+                prv_stream_part(api_client, client, evt);
+                break;
+            }
+#endif /* LWCELL_CFG_MQTT_RECV_STREAM */
             lwcell_mqtt_client_api_buf_p buf;
-            size_t size, buf_size, topic_size, payload_size;
 
             /* Get event data */
             const char* topic = lwcell_mqtt_client_evt_publish_recv_get_topic(client, evt);
@@ -123,34 +285,17 @@ prv_mqtt_evt(lwcell_mqtt_client_p client, lwcell_mqtt_evt_t* evt) {
             LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_API_TRACE, "[MQTT API] New publish received on topic %.*s\r\n",
                           (int)topic_len, topic);
 
-            /* Calculate memory sizes */
-            buf_size = LWCELL_MEM_ALIGN(sizeof(*buf));
-            topic_size = LWCELL_MEM_ALIGN(sizeof(*topic) * (topic_len + 1));
-            payload_size = LWCELL_MEM_ALIGN(sizeof(*payload) * (payload_len + 1));
-
-            size = buf_size + topic_size + payload_size;
-            if ((buf = lwcell_mem_malloc(size)) != NULL) {
-                LWCELL_MEMSET(buf, 0x00, size);
-                buf->topic = (void*)((uint8_t*)buf + buf_size);
-                buf->payload = (void*)((uint8_t*)buf + buf_size + topic_size);
-                buf->topic_len = topic_len;
-                buf->payload_len = payload_len;
-                buf->qos = qos;
-                buf->retain = retain;
-
-                /* Copy content to new memory */
-                LWCELL_MEMCPY(buf->topic, topic, sizeof(*topic) * topic_len);
-                LWCELL_MEMCPY(buf->payload, payload, sizeof(*payload) * payload_len);
+#if LWCELL_CFG_MQTT_API_BUF_POOL_SIZE > 0
+            /* Pool buffer is used first, heap only when pool is exhausted */
+            if ((buf = prv_pool_buf_get(api_client, client, evt)) != NULL) {
+                prv_rcv_put(api_client, buf);
+                break;
+            }
+#endif /* LWCELL_CFG_MQTT_API_BUF_POOL_SIZE > 0 */
 
-                /* Write to receive queue */
-                if (!lwcell_sys_mbox_putnow(&api_client->rcv_mbox, buf)) {
-                    LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_API_TRACE_WARNING,
-                                  "[MQTT API] Cannot put new received MQTT publish to queue\r\n");
-                    lwcell_mem_free_s((void**)&buf);
-                }
-            } else {
-                LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_API_TRACE_WARNING,
-                              "[MQTT API] Cannot allocate memory for packet buffer of size %d bytes\r\n", (int)size);
+            if ((buf = prv_heap_buf_alloc(topic, topic_len, payload_len, qos, retain)) != NULL) {
+                LWCELL_MEMCPY(buf->payload, payload, sizeof(*payload) * payload_len);
+                prv_rcv_put(api_client, buf);
             }
             break;
         }
@@ -183,6 +328,14 @@ prv_mqtt_evt(lwcell_mqtt_client_p client, lwcell_mqtt_evt_t* evt) {
             /* Print debug message */
             LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_API_TRACE, "[MQTT API] Disconnect event\r\n");
 
+#if LWCELL_CFG_MQTT_RECV_STREAM
+            /* Rest of streamed packet will not be received */
+            if (api_client->stream_buf != NULL) {
+                lwcell_mqtt_client_api_buf_free(api_client->stream_buf);
+                api_client->stream_buf = NULL;
+            }
+#endif /* LWCELL_CFG_MQTT_RECV_STREAM */
+
             /* Write to receive mbox to wakeup receive thread */
             if (is_accepted && lwcell_sys_mbox_isvalid(&api_client->rcv_mbox)) {
                 lwcell_sys_mbox_putnow(&api_client->rcv_mbox, &mqtt_closed);
@@ -205,7 +358,7 @@ lwcell_mqtt_client_api_new(size_t tx_buff_len, size_t rx_buff_len) {
     lwcell_mqtt_client_api_p client;
 
     /* Allocate client memory */
-    if ((client = lwcell_mem_calloc(1, LWCELL_MEM_ALIGN(sizeof(*client)))) != NULL) {
+    if ((client = lwcell_mem_calloc_tag(1, LWCELL_MEM_ALIGN(sizeof(*client)), LWCELL_MEM_TAG_MQTT)) != NULL) {
         /* Create MQTT raw client structure */
         if ((client->mc = lwcell_mqtt_client_new(tx_buff_len, rx_buff_len)) != NULL) {
             /* Create receive mbox queue */
@@ -214,6 +367,21 @@ lwcell_mqtt_client_api_new(size_t tx_buff_len, size_t rx_buff_len) {
                 if (lwcell_sys_sem_create(&client->sync_sem, 1)) {
                     /* Create mutex */
                     if (lwcell_sys_mutex_create(&client->mutex)) {
+#if LWCELL_CFG_MQTT_API_BUF_POOL_SIZE > 0
+                        /* Allocate pool buffers, each can hold packet of RX buffer length */
+                        client->rx_buff_len = rx_buff_len;
+                        for (size_t i = 0; i < LWCELL_ARRAYSIZE(client->pool); ++i) {
+                            client->pool[i].pool_owner = client;
+                            client->pool[i].pool_data = lwcell_mem_malloc_tag(rx_buff_len, LWCELL_MEM_TAG_MQTT);
+                            if (client->pool[i].pool_data == NULL) {
+                                LWCELL_DEBUGF(LWCELL_CFG_DBG_MQTT_API_TRACE_SEVERE,
+                                              "[MQTT API] Cannot allocate buffer pool\r\n");
+                                lwcell_mqtt_client_api_delete(client);
+                                return NULL;
+                            }
+                            client->pool_free[client->pool_free_cnt++] = &client->pool[i];
+                        }
+#endif /* LWCELL_CFG_MQTT_API_BUF_POOL_SIZE > 0 */
                         lwcell_mqtt_client_set_arg(client->mc, client); /* Set client to mqtt client argument */
                         return client;
                     } else {
@@ -267,6 +435,14 @@ lwcell_mqtt_client_api_delete(lwcell_mqtt_client_api_p client) {
         lwcell_mqtt_client_delete(client->mc);
         client->mc = NULL;
     }
+#if LWCELL_CFG_MQTT_RECV_STREAM
+    lwcell_mqtt_client_api_buf_free(client->stream_buf);
+#endif /* LWCELL_CFG_MQTT_RECV_STREAM */
+#if LWCELL_CFG_MQTT_API_BUF_POOL_SIZE > 0
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(client->pool); ++i) {
+        lwcell_mem_free_s((void**)&client->pool[i].pool_data);
+    }
+#endif /* LWCELL_CFG_MQTT_API_BUF_POOL_SIZE > 0 */
     lwcell_mem_free_s((void**)&client);
 }
 
@@ -479,9 +655,18 @@ lwcell_mqtt_client_api_receive(lwcell_mqtt_client_api_p client, lwcell_mqtt_clie
 
 /**
  * \brief           Free buffer memory after usage
+ * \note            Pool buffers must be freed before API client is deleted
  * \param[in]       p: Buffer to free
  */
 void
 lwcell_mqtt_client_api_buf_free(lwcell_mqtt_client_api_buf_p p) {
+#if LWCELL_CFG_MQTT_API_BUF_POOL_SIZE > 0
+    if (p != NULL && p->pool_owner != NULL) {
+        lwcell_core_lock();
+        p->pool_owner->pool_free[p->pool_owner->pool_free_cnt++] = p; /* Return buffer to its pool */
+        lwcell_core_unlock();
+        return;
+    }
+#endif /* LWCELL_CFG_MQTT_API_BUF_POOL_SIZE > 0 */
     lwcell_mem_free_s((void**)&p);
 }
@@ -0,0 +1,440 @@
+/**
+ * \file            lwcell_ota.c
+ * \brief           Resumable OTA download
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/apps/lwcell_ota.h"
+#include "lwcell/lwcell.h"
+#include "lwcell/lwcell_netconn.h"
+
+#if LWCELL_CFG_OTA || __DOXYGEN__
+
+/* Tracing debug message */
+#define LWCELL_CFG_DBG_OTA_TRACE         (LWCELL_CFG_DBG_OTA | LWCELL_DBG_TYPE_TRACE)
+#define LWCELL_CFG_DBG_OTA_TRACE_WARNING (LWCELL_CFG_DBG_OTA | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING)
+
+/**
+ * \brief           Single download attempt context
+ */
+typedef struct {
+    const lwcell_ota_cfg_t* cfg;              /*!< Download configuration */
+    lwcell_ota_state_t* state;                /*!< Download state */
+    char line[LWCELL_CFG_OTA_HEADER_LINE_LEN]; /*!< Current response header line */
+    size_t line_len;                          /*!< Length of current header line */
+    uint8_t header_done;                      /*!< Set to `1` when response header was received */
+    uint16_t status;                          /*!< HTTP response status code */
+    size_t range_start;                       /*!< First byte position of `Content-Range` */
+    size_t range_total;                       /*!< Complete length of `Content-Range` */
+    size_t content_len;                       /*!< Value of `Content-Length` */
+    size_t skip;                              /*!< Number of body bytes to skip, already written before */
+    size_t block_fill;                        /*!< Number of bytes in block buffer */
+    uint8_t failed;                           /*!< Set to `1` on server or flash error, not to be retried */
+} lwcell_ota_ctx_t;
+
+/* CRC-32 (IEEE 802.3, reflected) table for 4-bit index */
+static const uint32_t crc_table[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+};
+
+/**
+ * \brief           Update CRC-32 (IEEE 802.3) with new data
+ *
+ * Function is incremental, CRC of data split to multiple parts
+ * equals CRC of complete data, when result of previous call is passed as `crc` parameter
+ *
+ * \param[in]       crc: CRC of previous data, `0` for first call
+ * \param[in]       data: Data to add to CRC
+ * \param[in]       len: Length of data in units of bytes
+ * \return          CRC of all data
+ */
+uint32_t
+lwcell_ota_crc32(uint32_t crc, const void* data, size_t len) {
+    const uint8_t* d = data;
+
+    crc = ~crc;
+    for (; len > 0; --len, ++d) {
+        crc ^= *d;
+        crc = (crc >> 4) ^ crc_table[crc & 0x0F];
+        crc = (crc >> 4) ^ crc_table[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+/**
+ * \brief           Check if header line starts with field name, case insensitive
+ * \param[in]       line: Header line
+ * \param[in]       name: Lowercase field name including colon
+ * \return          Pointer to field value on match, `NULL` otherwise
+ */
+static const char*
+prv_header_value(const char* line, const char* name) {
+    for (; *name != '\0'; ++line, ++name) {
+        char ch = *line;
+
+        if (ch >= 'A' && ch <= 'Z') {
+            ch += 'a' - 'A';
+        }
+        if (ch != *name) {
+            return NULL;
+        }
+    }
+    while (*line == ' ') {
+        ++line;
+    }
+    return line;
+}
+
+/**
+ * \brief           Parse decimal number from string
+ * \param[in,out]   str: Pointer to string, moved after number
+ * \return          Parsed number
+ */
+static size_t
+prv_parse_size(const char** str) {
+    size_t num = 0;
+
+    for (; **str >= '0' && **str <= '9'; ++(*str)) {
+        num = 10 * num + (size_t)(**str - '0');
+    }
+    return num;
+}
+
+/**
+ * \brief           Process complete response header line
+ * \param[in]       ctx: Download context
+ */
+static void
+prv_process_header_line(lwcell_ota_ctx_t* ctx) {
+    const char* val;
+
+    if (ctx->status == 0) {
+        if ((val = prv_header_value(ctx->line, "http/1.")) != NULL && *val != '\0') {
+            ++val; /* Skip minor version */
+            while (*val == ' ') {
+                ++val;
+            }
+            ctx->status = (uint16_t)prv_parse_size(&val);
+        }
+    } else if ((val = prv_header_value(ctx->line, "content-length:")) != NULL) {
+        ctx->content_len = prv_parse_size(&val);
+    } else if ((val = prv_header_value(ctx->line, "content-range:")) != NULL) {
+        if ((val = prv_header_value(val, "bytes")) != NULL) {
+            ctx->range_start = prv_parse_size(&val);
+            while (*val != '\0' && *val != '/') {
+                ++val;
+            }
+            if (*val == '/') {
+                ++val;
+                ctx->range_total = prv_parse_size(&val);
+            }
+        }
+    }
+}
+
+/**
+ * \brief           Check response status and set download state from header
+ * \param[in]       ctx: Download context
+ * \return          \ref lwcellOK to receive body, \ref lwcellCLOSED when image is already complete,
+ *                      member of \ref lwcellr_t otherwise
+ */
+static lwcellr_t
+prv_process_header(lwcell_ota_ctx_t* ctx) {
+    lwcell_ota_state_t* state = ctx->state;
+    size_t total;
+
+    ctx->failed = 1; /* Cleared when response is accepted */
+    if (ctx->status == 206) {
+        if (ctx->range_start != state->offset || ctx->range_total == 0) {
+            return lwcellERR;
+        }
+        total = ctx->range_total;
+    } else if (ctx->status == 200) {
+        /* Server ignored range request, skip part already written */
+        if (ctx->content_len == 0) {
+            return lwcellERR;
+        }
+        total = ctx->content_len;
+        ctx->skip = state->offset;
+    } else if (ctx->status == 416 && state->total_len > 0 && state->offset == state->total_len) {
+        ctx->failed = 0;
+        return lwcellCLOSED;
+    } else {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_OTA_TRACE_WARNING, "[LWCELL OTA] Unexpected response status: %d\r\n",
+                      (int)ctx->status);
+        return lwcellERR;
+    }
+
+    /* Image changed on server since download started */
+    if (state->total_len > 0 && state->total_len != total) {
+        return lwcellERR;
+    }
+    state->total_len = total;
+    ctx->failed = 0;
+    return lwcellOK;
+}
+
+/**
+ * \brief           Write data to flash and store new state
+ * \param[in]       ctx: Download context
+ * \param[in]       data: Data to write
+ * \param[in]       len: Length of data
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+static lwcellr_t
+prv_write(lwcell_ota_ctx_t* ctx, const void* data, size_t len) {
+    const lwcell_ota_cfg_t* cfg = ctx->cfg;
+    lwcell_ota_state_t* state = ctx->state;
+    lwcellr_t res;
+
+    if ((res = cfg->write_fn(state->offset, data, len, cfg->arg)) != lwcellOK) {
+        ctx->failed = 1;
+        return res;
+    }
+    state->crc = lwcell_ota_crc32(state->crc, data, len);
+    state->offset += len;
+    if (cfg->state_fn != NULL) {
+        cfg->state_fn(state, 1, cfg->arg);
+    }
+    return lwcellOK;
+}
+
+/**
+ * \brief           Process received body data
+ * \param[in]       ctx: Download context
+ * \param[in]       data: Received data
+ * \param[in]       len: Length of data
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+static lwcellr_t
+prv_process_body(lwcell_ota_ctx_t* ctx, const uint8_t* data, size_t len) {
+    const lwcell_ota_cfg_t* cfg = ctx->cfg;
+    lwcell_ota_state_t* state = ctx->state;
+    size_t rem, n;
+    lwcellr_t res;
+
+    /* Never write past image end */
+    rem = state->total_len - state->offset - ctx->block_fill;
+    if (ctx->skip > 0) {
+        n = LWCELL_MIN(ctx->skip, len);
+        ctx->skip -= n;
+        data += n;
+        len -= n;
+    }
+    len = LWCELL_MIN(len, rem);
+
+    if (cfg->block == NULL) {
+        return len > 0 ? prv_write(ctx, data, len) : lwcellOK;
+    }
+    while (len > 0) {
+        n = LWCELL_MIN(len, cfg->block_len - ctx->block_fill);
+        LWCELL_MEMCPY(&cfg->block[ctx->block_fill], data, n);
+        ctx->block_fill += n;
+        data += n;
+        len -= n;
+
+        /* Write full block or last part of image */
+        if (ctx->block_fill == cfg->block_len || state->offset + ctx->block_fill == state->total_len) {
+            if ((res = prv_write(ctx, cfg->block, ctx->block_fill)) != lwcellOK) {
+                return res;
+            }
+            ctx->block_fill = 0;
+        }
+    }
+    return lwcellOK;
+}
+
+/**
+ * \brief           Process received data, response header first and body after it
+ * \param[in]       ctx: Download context
+ * \param[in]       data: Received data
+ * \param[in]       len: Length of data
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+static lwcellr_t
+prv_process_data(lwcell_ota_ctx_t* ctx, const uint8_t* data, size_t len) {
+    lwcellr_t res = lwcellOK;
+
+    for (; !ctx->header_done && len > 0; ++data, --len) {
+        if (*data == '\n') {
+            if (ctx->line_len > 0 && ctx->line[ctx->line_len - 1] == '\r') {
+                --ctx->line_len;
+            }
+            ctx->line[ctx->line_len] = '\0';
+            if (ctx->line_len == 0) {
+                ctx->header_done = 1; /* Empty line ends header */
+                res = prv_process_header(ctx);
+            } else {
+                prv_process_header_line(ctx);
+            }
+            ctx->line_len = 0;
+        } else if (ctx->line_len < sizeof(ctx->line) - 1) {
+            ctx->line[ctx->line_len++] = (char)*data;
+        }
+    }
+    if (res == lwcellOK && len > 0) {
+        res = prv_process_body(ctx, data, len);
+    }
+    return res;
+}
+
+/**
+ * \brief           Send range request for rest of image
+ * \param[in]       nc: Netconn handle
+ * \param[in]       ctx: Download context
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+static lwcellr_t
+prv_send_request(lwcell_netconn_p nc, lwcell_ota_ctx_t* ctx) {
+    char num[11];
+    lwcellr_t res;
+
+    lwcell_u32_to_str(ctx->state->offset, num);
+    if ((res = lwcell_netconn_write(nc, "GET ", 4)) != lwcellOK
+        || (res = lwcell_netconn_write(nc, ctx->cfg->path, strlen(ctx->cfg->path))) != lwcellOK
+        || (res = lwcell_netconn_write(nc, " HTTP/1.1\r\nHost: ", 17)) != lwcellOK
+        || (res = lwcell_netconn_write(nc, ctx->cfg->host, strlen(ctx->cfg->host))) != lwcellOK
+        || (res = lwcell_netconn_write(nc, "\r\nRange: bytes=", 15)) != lwcellOK
+        || (res = lwcell_netconn_write(nc, num, strlen(num))) != lwcellOK
+        || (res = lwcell_netconn_write(nc, "-\r\nConnection: close\r\n\r\n", 24)) != lwcellOK) {
+        return res;
+    }
+    return lwcell_netconn_flush(nc);
+}
+
+/**
+ * \brief           Single download attempt, from current offset until connection is closed
+ * \param[in]       ctx: Download context
+ * \return          \ref lwcellOK when image is complete, member of \ref lwcellr_t otherwise.
+ *                      Error is retried, unless `failed` flag is set in context
+ */
+static lwcellr_t
+prv_download(lwcell_ota_ctx_t* ctx) {
+    lwcell_ota_state_t* state = ctx->state;
+    lwcell_netconn_p nc;
+    lwcell_pbuf_p pbuf;
+    const uint8_t* data;
+    lwcellr_t res;
+
+    if ((nc = lwcell_netconn_new(LWCELL_NETCONN_TYPE_TCP)) == NULL) {
+        return lwcellERRMEM;
+    }
+#if LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT
+    lwcell_netconn_set_receive_timeout(nc, ctx->cfg->timeout);
+#endif /* LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT */
+    if ((res = lwcell_netconn_connect(nc, ctx->cfg->host, ctx->cfg->port)) == lwcellOK) {
+        res = prv_send_request(nc, ctx);
+    }
+    while (res == lwcellOK && (state->total_len == 0 || state->offset < state->total_len)) {
+        if ((res = lwcell_netconn_receive(nc, &pbuf)) != lwcellOK) {
+            break;
+        }
+
+        /*
+         * Packet buffer left receive queue and device already receives next one,
+         * while this one is written to flash
+         */
+        for (size_t off = 0, len; res == lwcellOK && (data = lwcell_pbuf_get_linear_addr(pbuf, off, &len)) != NULL;
+             off += len) {
+            res = prv_process_data(ctx, data, len);
+        }
+        lwcell_pbuf_free_s(&pbuf);
+    }
+    if (res == lwcellCLOSED && state->total_len > 0 && state->offset == state->total_len) {
+        res = lwcellOK; /* Image was already complete */
+    }
+    lwcell_netconn_close(nc);
+    lwcell_netconn_delete(nc);
+    return res;
+}
+
+/**
+ * \brief           Download image with resume after connection loss
+ *
+ * Function blocks until image is complete, download fails with error,
+ * or `max_retries` consecutive attempts ended without any new data written.
+ * When called again with the same state, download continues from last written offset
+ *
+ * \note            This function may only be called from thread other than stack threads
+ * \param[in]       cfg: Download configuration. Must stay valid until function returns
+ * \param[in,out]   state: Download state. When `state_fn` is set, it is loaded first,
+ *                      otherwise current value is used. Set to all zeros for new download
+ * \return          \ref lwcellOK when image is written and verified,
+ *                      \ref lwcellERR on server, flash or verification error,
+ *                      result of last connection attempt after `max_retries` failed attempts in a row
+ */
+lwcellr_t
+lwcell_ota_download(const lwcell_ota_cfg_t* cfg, lwcell_ota_state_t* state) {
+    lwcell_ota_ctx_t ctx;
+    uint16_t retries = 0;
+    size_t offset;
+    lwcellr_t res;
+
+    LWCELL_ASSERT(cfg != NULL && state != NULL);
+    LWCELL_ASSERT(cfg->host != NULL && cfg->path != NULL && cfg->write_fn != NULL);
+    LWCELL_ASSERT(cfg->block == NULL || cfg->block_len > 0);
+
+    if (cfg->state_fn != NULL && !cfg->state_fn(state, 0, cfg->arg)) {
+        LWCELL_MEMSET(state, 0x00, sizeof(*state));
+    }
+    res = lwcellOK;
+    while (state->total_len == 0 || state->offset < state->total_len) {
+        LWCELL_MEMSET(&ctx, 0x00, sizeof(ctx));
+        ctx.cfg = cfg;
+        ctx.state = state;
+        offset = state->offset;
+
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_OTA_TRACE, "[LWCELL OTA] Requesting image from offset %u\r\n",
+                      (unsigned)state->offset);
+        if ((res = prv_download(&ctx)) == lwcellOK || ctx.failed) {
+            break;
+        }
+        retries = state->offset != offset ? 0 : retries + 1;
+        if (retries >= cfg->max_retries) {
+            break;
+        }
+        lwcell_delay(cfg->retry_delay);
+    }
+
+    if (res == lwcellOK && cfg->verify && state->crc != cfg->crc32) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_OTA_TRACE_WARNING, "[LWCELL OTA] CRC mismatch, restarting download\r\n");
+
+        /* Written image is invalid, next download starts from beginning */
+        LWCELL_MEMSET(state, 0x00, sizeof(*state));
+        if (cfg->state_fn != NULL) {
+            cfg->state_fn(state, 1, cfg->arg);
+        }
+        res = lwcellERR;
+    }
+    return res;
+}
+
+#endif /* LWCELL_CFG_OTA || __DOXYGEN__ */
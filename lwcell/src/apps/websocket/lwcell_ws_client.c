@@ -0,0 +1,546 @@
+/**
+ * \file            lwcell_ws_client.c
+ * \brief           WebSocket client
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/apps/lwcell_ws_client.h"
+#include "lwcell/lwcell.h"
+#include "lwcell/lwcell_netconn.h"
+
+#if LWCELL_CFG_WS || __DOXYGEN__
+
+/* Tracing debug message */
+#define LWCELL_CFG_DBG_WS_TRACE         (LWCELL_CFG_DBG_WS | LWCELL_DBG_TYPE_TRACE)
+#define LWCELL_CFG_DBG_WS_TRACE_WARNING (LWCELL_CFG_DBG_WS | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING)
+
+/* Time to wait for handshake response, in units of milliseconds */
+#define WS_HANDSHAKE_TIMEOUT        10000
+
+/* Maximal payload length of control frame */
+#define WS_CONTROL_MAX_LEN          125
+
+/* Number of payload bytes masked at a time before written to netconn */
+#define WS_MASK_BLOCK_LEN           64
+
+/* Close status codes */
+#define WS_CLOSE_NORMAL             1000
+#define WS_CLOSE_PROTOCOL_ERROR     1002
+#define WS_CLOSE_TOO_BIG            1009
+
+/**
+ * \brief           WebSocket client structure
+ */
+typedef struct lwcell_ws_client {
+    lwcell_netconn_p nc;      /*!< Netconn handle, `NULL` when not connected */
+    lwcell_sys_mutex_t mutex; /*!< Mutex to protect frame writes */
+    lwcell_pbuf_p rx;         /*!< Received data not yet released */
+    size_t rx_used;           /*!< Number of bytes in `rx` handed to application, released on next receive */
+    uint8_t close_sent;       /*!< Set to `1` when close frame was sent */
+} lwcell_ws_client_t;
+
+static uint32_t random_state; /*!< Default random generator state */
+
+/**
+ * \brief           Default 32-bit pseudo random generator, used by \ref LWCELL_CFG_WS_RANDOM
+ * \return          Random value
+ */
+uint32_t
+lwcell_ws_client_random(void) {
+    uint32_t x = random_state;
+
+    if (x == 0) {
+        x = lwcell_sys_now() ^ 0x9E3779B9; /* Seed from time */
+    }
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    random_state = x;
+    return x;
+}
+
+/**
+ * \brief           Release bytes from the beginning of received data
+ * \param[in]       ws: WebSocket client handle
+ * \param[in]       len: Number of bytes to release
+ */
+static void
+prv_rx_release(lwcell_ws_client_p ws, size_t len) {
+    lwcell_pbuf_p next;
+    size_t n;
+
+    while (len > 0 && ws->rx != NULL) {
+        n = lwcell_pbuf_length(ws->rx, 0);
+        if (len < n) {
+            lwcell_pbuf_advance(ws->rx, (int)len);
+            break;
+        }
+        next = lwcell_pbuf_unchain(ws->rx); /* Free first packet buffer in chain */
+        lwcell_pbuf_free(ws->rx);
+        ws->rx = next;
+        len -= n;
+    }
+}
+
+/**
+ * \brief           Receive more data from connection and append it to received chain
+ * \param[in]       ws: WebSocket client handle
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+static lwcellr_t
+prv_rx_more(lwcell_ws_client_p ws) {
+    lwcell_pbuf_p pbuf;
+    lwcellr_t res;
+
+    if ((res = lwcell_netconn_receive(ws->nc, &pbuf)) == lwcellOK) {
+        if (ws->rx == NULL) {
+            ws->rx = pbuf;
+        } else {
+            lwcell_pbuf_cat(ws->rx, pbuf);
+        }
+    }
+    return res;
+}
+
+/**
+ * \brief           Write string to connection buffer
+ * \param[in]       ws: WebSocket client handle
+ * \param[in]       str: String to write
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+static lwcellr_t
+prv_write_str(lwcell_ws_client_p ws, const char* str) {
+    return lwcell_netconn_write(ws->nc, str, strlen(str));
+}
+
+/**
+ * \brief           Write single frame, masked with new key
+ * \param[in]       ws: WebSocket client handle
+ * \param[in]       opcode: Frame opcode
+ * \param[in]       data: Payload data
+ * \param[in]       len: Payload length
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+static lwcellr_t
+prv_write_frame(lwcell_ws_client_p ws, lwcell_ws_opcode_t opcode, const void* data, size_t len) {
+    uint8_t hdr[14], block[WS_MASK_BLOCK_LEN];
+    uint8_t* key;
+    const uint8_t* d = data;
+    size_t hdr_len = 2;
+    uint32_t mask;
+    lwcellr_t res;
+
+    hdr[0] = 0x80 | (uint8_t)opcode; /* Client always sends complete messages */
+    if (len < 126) {
+        hdr[1] = 0x80 | (uint8_t)len;
+    } else if (len <= 0xFFFF) {
+        hdr[1] = 0x80 | 126;
+        hdr[2] = LWCELL_U8(len >> 8);
+        hdr[3] = LWCELL_U8(len);
+        hdr_len = 4;
+    } else {
+        hdr[1] = 0x80 | 127;
+        for (size_t i = 0; i < 8; ++i) {
+            hdr[2 + i] = i < 4 ? 0 : LWCELL_U8((uint32_t)len >> (8 * (7 - i)));
+        }
+        hdr_len = 10;
+    }
+    mask = LWCELL_CFG_WS_RANDOM();
+    key = &hdr[hdr_len];
+    LWCELL_MEMCPY(key, &mask, 4);
+    hdr_len += 4;
+
+    lwcell_sys_mutex_lock(&ws->mutex);
+    res = lwcell_netconn_write(ws->nc, hdr, hdr_len);
+
+    /* Mask payload in blocks, written directly to connection buffer */
+    for (size_t off = 0, n; res == lwcellOK && off < len; off += n) {
+        n = LWCELL_MIN(len - off, sizeof(block));
+        for (size_t i = 0; i < n; ++i) {
+            block[i] = d[off + i] ^ key[(off + i) & 0x03];
+        }
+        res = lwcell_netconn_write(ws->nc, block, n);
+    }
+    if (res == lwcellOK) {
+        res = lwcell_netconn_flush(ws->nc);
+    }
+    lwcell_sys_mutex_unlock(&ws->mutex);
+    return res;
+}
+
+/**
+ * \brief           Send close frame with status code
+ * \param[in]       ws: WebSocket client handle
+ * \param[in]       code: Close status code
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+static lwcellr_t
+prv_send_close(lwcell_ws_client_p ws, uint16_t code) {
+    uint8_t payload[2] = {LWCELL_U8(code >> 8), LWCELL_U8(code)};
+
+    if (ws->close_sent) {
+        return lwcellOK;
+    }
+    ws->close_sent = 1;
+    return prv_write_frame(ws, LWCELL_WS_OPCODE_CLOSE, payload, sizeof(payload));
+}
+
+/**
+ * \brief           Close connection and release received data
+ * \param[in]       ws: WebSocket client handle
+ */
+static void
+prv_disconnect(lwcell_ws_client_p ws) {
+    if (ws->nc != NULL) {
+        lwcell_netconn_close(ws->nc);
+        lwcell_netconn_delete(ws->nc);
+        ws->nc = NULL;
+    }
+    lwcell_pbuf_free_s(&ws->rx);
+    ws->rx_used = 0;
+}
+
+/**
+ * \brief           Get byte from received data
+ * \param[in]       ws: WebSocket client handle
+ * \param[in]       pos: Byte position, which must be available
+ * \return          Byte value
+ */
+static uint8_t
+prv_rx_at(lwcell_ws_client_p ws, size_t pos) {
+    uint8_t el = 0;
+
+    lwcell_pbuf_get_at(ws->rx, pos, &el);
+    return el;
+}
+
+/**
+ * \brief           Parse frame at the beginning of received data
+ * \param[in]       ws: WebSocket client handle
+ * \param[out]      frame: Frame to fill
+ * \param[out]      frame_len: Total frame length, including header
+ * \return          \ref lwcellOK when complete frame is available, \ref lwcellCONT when more data is needed,
+ *                      \ref lwcellERRMEM when frame is too long, \ref lwcellERR on protocol error
+ */
+static lwcellr_t
+prv_parse_frame(lwcell_ws_client_p ws, lwcell_ws_frame_t* frame, size_t* frame_len) {
+    size_t tot_len, hdr_len = 2, len;
+    uint8_t b0, b1, key[4];
+
+    tot_len = ws->rx != NULL ? lwcell_pbuf_length(ws->rx, 1) : 0;
+    if (tot_len < 2) {
+        return lwcellCONT;
+    }
+    b0 = prv_rx_at(ws, 0);
+    b1 = prv_rx_at(ws, 1);
+    if (b0 & 0x70) {
+        return lwcellERR; /* No extension negotiated */
+    }
+
+    /* Extended payload length */
+    len = b1 & 0x7F;
+    if (len == 126) {
+        hdr_len = 4;
+    } else if (len == 127) {
+        hdr_len = 10;
+    }
+    if (tot_len < hdr_len) {
+        return lwcellCONT;
+    }
+    if (len >= 126) {
+        len = 0;
+        for (size_t i = 2; i < hdr_len; ++i) {
+            if (len > (LWCELL_CFG_WS_MAX_PAYLOAD_LEN >> 8)) {
+                return lwcellERRMEM;
+            }
+            len = (len << 8) | prv_rx_at(ws, i);
+        }
+    }
+    if (len > LWCELL_CFG_WS_MAX_PAYLOAD_LEN) {
+        return lwcellERRMEM;
+    }
+    if ((b0 & 0x08) && (len > WS_CONTROL_MAX_LEN || !(b0 & 0x80))) {
+        return lwcellERR; /* Control frames are short and never fragmented */
+    }
+    if (b1 & 0x80) {
+        hdr_len += 4;
+    }
+    if (tot_len < hdr_len + len) {
+        return lwcellCONT;
+    }
+
+    /* Unmask payload in place, segment by segment */
+    if (b1 & 0x80) {
+        uint8_t* d;
+        size_t n;
+
+        for (size_t i = 0; i < 4; ++i) {
+            key[i] = prv_rx_at(ws, hdr_len - 4 + i);
+        }
+        for (size_t off = 0; off < len; off += n) {
+            d = lwcell_pbuf_get_linear_addr(ws->rx, hdr_len + off, &n);
+            n = LWCELL_MIN(n, len - off);
+            for (size_t i = 0; i < n; ++i) {
+                d[i] ^= key[(off + i) & 0x03];
+            }
+        }
+    }
+
+    frame->opcode = (lwcell_ws_opcode_t)(b0 & 0x0F);
+    frame->fin = (b0 & 0x80) != 0;
+    frame->pbuf = ws->rx;
+    frame->offset = hdr_len;
+    frame->len = len;
+    *frame_len = hdr_len + len;
+    return lwcellOK;
+}
+
+/**
+ * \brief           Create new WebSocket client
+ * \return          Client handle on success, `NULL` otherwise
+ */
+lwcell_ws_client_p
+lwcell_ws_client_new(void) {
+    lwcell_ws_client_p ws;
+
+    if ((ws = lwcell_mem_calloc_tag(1, sizeof(*ws), LWCELL_MEM_TAG_NETCONN)) != NULL) {
+        if (!lwcell_sys_mutex_create(&ws->mutex)) {
+            LWCELL_DEBUGF(LWCELL_CFG_DBG_WS_TRACE_WARNING, "[LWCELL WS] Cannot allocate mutex\r\n");
+            lwcell_mem_free_s((void**)&ws);
+        }
+    }
+    return ws;
+}
+
+/**
+ * \brief           Delete client, close connection if still active
+ * \param[in]       ws: WebSocket client handle
+ */
+void
+lwcell_ws_client_delete(lwcell_ws_client_p ws) {
+    if (ws == NULL) {
+        return;
+    }
+    prv_disconnect(ws);
+    lwcell_sys_mutex_delete(&ws->mutex);
+    lwcell_mem_free_s((void**)&ws);
+}
+
+/**
+ * \brief           Connect to server and perform WebSocket handshake
+ * \note            This function may only be called from thread other than stack threads
+ * \param[in]       ws: WebSocket client handle
+ * \param[in]       host: Server host name or IP address
+ * \param[in]       port: Server port, typically `80`
+ * \param[in]       path: Resource path, such as `/ws`
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_ws_client_connect(lwcell_ws_client_p ws, const char* host, lwcell_port_t port, const char* path) {
+    static const char b64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    uint8_t nonce[18] = {0};
+    char key[25];
+    size_t pos;
+    lwcellr_t res;
+
+    LWCELL_ASSERT(ws != NULL && ws->nc == NULL);
+    LWCELL_ASSERT(host != NULL && path != NULL);
+
+    /* Handshake key is base64 of 16 random bytes */
+    for (size_t i = 0; i < 16; i += 4) {
+        uint32_t r = LWCELL_CFG_WS_RANDOM();
+        LWCELL_MEMCPY(&nonce[i], &r, 4);
+    }
+    for (size_t i = 0, k = 0; i < 18; i += 3) {
+        key[k++] = b64[nonce[i] >> 2];
+        key[k++] = b64[((nonce[i] & 0x03) << 4) | (nonce[i + 1] >> 4)];
+        key[k++] = b64[((nonce[i + 1] & 0x0F) << 2) | (nonce[i + 2] >> 6)];
+        key[k++] = b64[nonce[i + 2] & 0x3F];
+    }
+    key[22] = key[23] = '=';
+    key[24] = '\0';
+
+    if ((ws->nc = lwcell_netconn_new(LWCELL_NETCONN_TYPE_TCP)) == NULL) {
+        return lwcellERRMEM;
+    }
+    ws->close_sent = 0;
+    if ((res = lwcell_netconn_connect(ws->nc, host, port)) == lwcellOK) {
+        if ((res = prv_write_str(ws, "GET ")) == lwcellOK && (res = prv_write_str(ws, path)) == lwcellOK
+            && (res = prv_write_str(ws, " HTTP/1.1\r\nHost: ")) == lwcellOK
+            && (res = prv_write_str(ws, host)) == lwcellOK
+            && (res = prv_write_str(ws, "\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n")) == lwcellOK
+            && (res = prv_write_str(ws, "Sec-WebSocket-Key: ")) == lwcellOK
+            && (res = prv_write_str(ws, key)) == lwcellOK
+            && (res = prv_write_str(ws, "\r\nSec-WebSocket-Version: 13\r\n\r\n")) == lwcellOK) {
+            res = lwcell_netconn_flush(ws->nc);
+        }
+    }
+
+    /* Wait for complete response header */
+#if LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT
+    lwcell_netconn_set_receive_timeout(ws->nc, WS_HANDSHAKE_TIMEOUT);
+#endif /* LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT */
+    pos = LWCELL_SIZET_MAX;
+    while (res == lwcellOK
+           && (ws->rx == NULL || (pos = lwcell_pbuf_strfind(ws->rx, "\r\n\r\n", 0)) == LWCELL_SIZET_MAX)) {
+        res = prv_rx_more(ws);
+    }
+    if (res == lwcellOK) {
+        if (lwcell_pbuf_strcmp(ws->rx, "HTTP/1.1 101", 0) == 0) {
+            prv_rx_release(ws, pos + 4); /* Frames may follow header in the same packet */
+        } else {
+            LWCELL_DEBUGF(LWCELL_CFG_DBG_WS_TRACE_WARNING, "[LWCELL WS] Server refused upgrade\r\n");
+            res = lwcellERR;
+        }
+    }
+    if (res != lwcellOK) {
+        prv_disconnect(ws);
+    }
+    return res;
+}
+
+/**
+ * \brief           Send complete message in single frame
+ * \param[in]       ws: WebSocket client handle
+ * \param[in]       opcode: Message opcode, \ref LWCELL_WS_OPCODE_TEXT or \ref LWCELL_WS_OPCODE_BINARY.
+ *                      Control opcodes are allowed with payload up to `125` bytes
+ * \param[in]       data: Payload data
+ * \param[in]       len: Payload length in units of bytes
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_ws_client_send(lwcell_ws_client_p ws, lwcell_ws_opcode_t opcode, const void* data, size_t len) {
+    LWCELL_ASSERT(ws != NULL);
+    LWCELL_ASSERT(data != NULL || len == 0);
+    LWCELL_ASSERT(!(opcode & 0x08) || len <= WS_CONTROL_MAX_LEN);
+
+    if (ws->nc == NULL || ws->close_sent) {
+        return lwcellCLOSED;
+    }
+    return prv_write_frame(ws, opcode, data, len);
+}
+
+/**
+ * \brief           Receive next data frame
+ *
+ * Ping frames are answered with pong and pong frames are skipped.
+ * On close frame from server, close is confirmed and connection is closed.
+ * Payload of returned frame is valid until next call of this function
+ *
+ * \param[in]       ws: WebSocket client handle
+ * \param[out]      frame: Frame to fill with received data
+ * \param[in]       timeout: Maximal time to wait for frame in units of milliseconds, `0` to wait forever
+ * \return          \ref lwcellOK on success, \ref lwcellCLOSED when connection is closed,
+ *                      member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_ws_client_receive(lwcell_ws_client_p ws, lwcell_ws_frame_t* frame, uint32_t timeout) {
+    uint8_t payload[WS_CONTROL_MAX_LEN];
+    size_t frame_len;
+    lwcellr_t res;
+
+    LWCELL_ASSERT(ws != NULL && frame != NULL);
+
+    if (ws->nc == NULL) {
+        return lwcellCLOSED;
+    }
+#if LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT
+    lwcell_netconn_set_receive_timeout(ws->nc, timeout);
+#else  /* LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT */
+    LWCELL_UNUSED(timeout);
+#endif /* !LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT */
+
+    /* Previous frame is not used by application anymore */
+    prv_rx_release(ws, ws->rx_used);
+    ws->rx_used = 0;
+    while (1) {
+        res = prv_parse_frame(ws, frame, &frame_len);
+        if (res == lwcellCONT) {
+            if ((res = prv_rx_more(ws)) == lwcellOK) {
+                continue;
+            }
+            if (res == lwcellCLOSED) {
+                prv_disconnect(ws);
+            }
+            return res;
+        } else if (res != lwcellOK) {
+            LWCELL_DEBUGF(LWCELL_CFG_DBG_WS_TRACE_WARNING, "[LWCELL WS] Invalid frame received\r\n");
+            prv_send_close(ws, res == lwcellERRMEM ? WS_CLOSE_TOO_BIG : WS_CLOSE_PROTOCOL_ERROR);
+            prv_disconnect(ws);
+            return res;
+        }
+
+        switch (frame->opcode) {
+            case LWCELL_WS_OPCODE_PING: {
+                lwcell_pbuf_copy(frame->pbuf, payload, frame->len, frame->offset);
+                if (!ws->close_sent) {
+                    prv_write_frame(ws, LWCELL_WS_OPCODE_PONG, payload, frame->len);
+                }
+                prv_rx_release(ws, frame_len);
+                break;
+            }
+            case LWCELL_WS_OPCODE_PONG: {
+                prv_rx_release(ws, frame_len);
+                break;
+            }
+            case LWCELL_WS_OPCODE_CLOSE: {
+                LWCELL_DEBUGF(LWCELL_CFG_DBG_WS_TRACE, "[LWCELL WS] Close frame received\r\n");
+                prv_send_close(ws, WS_CLOSE_NORMAL);
+                prv_disconnect(ws);
+                return lwcellCLOSED;
+            }
+            default: {
+                ws->rx_used = frame_len;
+                return lwcellOK;
+            }
+        }
+    }
+}
+
+/**
+ * \brief           Send close frame and close connection
+ * \param[in]       ws: WebSocket client handle
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_ws_client_close(lwcell_ws_client_p ws) {
+    lwcellr_t res;
+
+    LWCELL_ASSERT(ws != NULL);
+
+    if (ws->nc == NULL) {
+        return lwcellCLOSED;
+    }
+    res = prv_send_close(ws, WS_CLOSE_NORMAL);
+    prv_disconnect(ws);
+    return res;
+}
+
+#endif /* LWCELL_CFG_WS || __DOXYGEN__ */
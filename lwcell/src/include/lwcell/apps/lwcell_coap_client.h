@@ -0,0 +1,155 @@
+/**
+ * \file            lwcell_coap_client.h
+ * \brief           CoAP client
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_APP_COAP_CLIENT_HDR_H
+#define LWCELL_APP_COAP_CLIENT_HDR_H
+
+#include "lwcell/lwcell_includes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL_APPS
+ * \defgroup        LWCELL_APP_COAP_CLIENT CoAP client
+ * \brief           CoAP client over UDP connection
+ * \{
+ *
+ * Client sends confirmable or non-confirmable requests and matches responses by token
+ * in fixed table of \ref LWCELL_CFG_COAP_MAX_REQUESTS entries. No memory is allocated per message.
+ *
+ * Request payload longer than block size is sent block by block with `Block1` option (RFC 7959).
+ * Response split with `Block2` option is requested block by block,
+ * each block is reported with \ref LWCELL_COAP_EVT_RESPONSE event directly from received packet buffer.
+ * Requests with `observe` flag stay registered and report every notification, until cancelled.
+ *
+ * Callback functions are called from stack thread and must not block
+ */
+
+/**
+ * \brief           CoAP request method
+ */
+typedef enum {
+    LWCELL_COAP_METHOD_GET = 0x01,    /*!< GET method */
+    LWCELL_COAP_METHOD_POST = 0x02,   /*!< POST method */
+    LWCELL_COAP_METHOD_PUT = 0x03,    /*!< PUT method */
+    LWCELL_COAP_METHOD_DELETE = 0x04, /*!< DELETE method */
+} lwcell_coap_method_t;
+
+/**
+ * \brief           Build response code from class and detail, such as `LWCELL_COAP_CODE(2, 5)` for `2.05 Content`
+ */
+#define LWCELL_COAP_CODE(c, d) ((uint8_t)(((c) << 5) | (d)))
+
+/**
+ * \brief           CoAP request descriptor
+ */
+typedef struct {
+    lwcell_coap_method_t method; /*!< Request method */
+    const char* path;            /*!< Resource path with segments separated by `/`, such as `sensors/temp` */
+    uint8_t confirmable;         /*!< Set to `1` to send confirmable request, retransmitted until acknowledged */
+    uint8_t observe;             /*!< Set to `1` to register for notifications, used with GET method */
+    int16_t content_format;      /*!< Payload content format, such as `0` for text, `-1` to omit option */
+    const void* payload;         /*!< Request payload, `NULL` for none */
+    size_t payload_len;          /*!< Payload length in units of bytes */
+} lwcell_coap_request_t;
+
+/**
+ * \brief           CoAP client event type
+ */
+typedef enum {
+    LWCELL_COAP_EVT_RESPONSE, /*!< Response, response block or notification received */
+    LWCELL_COAP_EVT_ERROR,    /*!< Request finished without response */
+} lwcell_coap_evt_type_t;
+
+/**
+ * \brief           CoAP client event
+ */
+typedef struct {
+    lwcell_coap_evt_type_t type; /*!< Event type */
+    void* req_arg;               /*!< Request argument, passed to \ref lwcell_coap_client_request */
+
+    union {
+        struct {
+            uint8_t code;        /*!< Response code, compare with \ref LWCELL_COAP_CODE */
+            lwcell_pbuf_p pbuf;  /*!< Received packet buffer. Valid only during callback */
+            size_t offset;       /*!< Offset of payload in `pbuf` */
+            size_t len;          /*!< Payload length in units of bytes */
+            size_t block_offset; /*!< Offset of payload in complete resource representation */
+            uint8_t more;        /*!< Set to `1` when more blocks follow */
+            uint8_t notify;      /*!< Set to `1` for response of observed resource */
+        } response;              /*!< Response event. Use with \ref LWCELL_COAP_EVT_RESPONSE event */
+
+        struct {
+            lwcellr_t res; /*!< \ref lwcellTIMEOUT when not answered, \ref lwcellERR on reset message,
+                                    \ref lwcellCLOSED when client disconnected */
+        } error;           /*!< Error event. Use with \ref LWCELL_COAP_EVT_ERROR event */
+    } evt;                 /*!< Event data */
+} lwcell_coap_evt_t;
+
+/**
+ * \brief           CoAP client structure
+ */
+struct lwcell_coap_client;
+
+/**
+ * \brief           Pointer to \ref lwcell_coap_client structure
+ */
+typedef struct lwcell_coap_client* lwcell_coap_client_p;
+
+/**
+ * \brief           CoAP client event callback function
+ * \param[in]       client: CoAP client handle
+ * \param[in]       evt: Event with data
+ */
+typedef void (*lwcell_coap_client_evt_fn)(lwcell_coap_client_p client, const lwcell_coap_evt_t* evt);
+
+lwcell_coap_client_p lwcell_coap_client_new(lwcell_coap_client_evt_fn evt_fn, void* arg);
+void lwcell_coap_client_delete(lwcell_coap_client_p client);
+lwcellr_t lwcell_coap_client_connect(lwcell_coap_client_p client, const char* host, lwcell_port_t port,
+                                     const uint32_t blocking);
+lwcellr_t lwcell_coap_client_disconnect(lwcell_coap_client_p client);
+lwcellr_t lwcell_coap_client_request(lwcell_coap_client_p client, const lwcell_coap_request_t* req, void* req_arg);
+lwcellr_t lwcell_coap_client_cancel(lwcell_coap_client_p client, void* req_arg);
+void* lwcell_coap_client_get_arg(lwcell_coap_client_p client);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_APP_COAP_CLIENT_HDR_H */
@@ -0,0 +1,115 @@
+/**
+ * \file            lwcell_http_client.h
+ * \brief           HTTP/1.1 client
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_APP_HTTP_CLIENT_HDR_H
+#define LWCELL_APP_HTTP_CLIENT_HDR_H
+
+#include "lwcell/lwcell_includes.h"
+#include "lwcell/lwcell_netconn.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL_APPS
+ * \defgroup        LWCELL_APP_HTTP_CLIENT HTTP/1.1 client
+ * \brief           Keep-alive HTTP/1.1 client on top of netconn
+ * \{
+ *
+ * Software HTTP client for servers that modem HTTP engine cannot reach, such as TLS endpoints over
+ * \ref LWCELL_NETCONN_TYPE_SSL connection.
+ *
+ * Connection is opened on first request and reused for next requests while server keeps it alive.
+ * Up to \ref LWCELL_CFG_HTTP_CLIENT_PIPELINE_LEN requests may be sent before first response is read,
+ * responses are then read in the same order with \ref lwcell_http_client_response.
+ *
+ * Response header is parsed directly in received packet buffer chain.
+ * Body, plain or with chunked transfer encoding, is passed to callback segment by segment
+ * as it is received and complete response is never kept in memory.
+ *
+ * \note            Client is not thread safe, requests and responses shall be processed by the same thread
+ */
+
+/**
+ * \brief           Received response information
+ */
+typedef struct {
+    uint16_t status;       /*!< Response status code */
+    uint8_t chunked;       /*!< Set to `1` when body uses chunked transfer encoding */
+    uint8_t keep_alive;    /*!< Set to `1` when connection stays open after response */
+    size_t content_length; /*!< Body length from `Content-Length` header, `LWCELL_SIZET_MAX` when not known */
+} lwcell_http_client_resp_t;
+
+/**
+ * \brief           HTTP client structure
+ */
+struct lwcell_http_client;
+
+/**
+ * \brief           Pointer to \ref lwcell_http_client structure
+ */
+typedef struct lwcell_http_client* lwcell_http_client_p;
+
+/**
+ * \brief           Response body callback
+ * \param[in]       client: HTTP client handle
+ * \param[in]       data: Body data, valid only during callback
+ * \param[in]       len: Data length in units of bytes
+ * \param[in]       arg: User argument
+ * \return          \ref lwcellOK to continue, any other value aborts response and closes connection
+ */
+typedef lwcellr_t (*lwcell_http_client_body_fn)(lwcell_http_client_p client, const void* data, size_t len, void* arg);
+
+lwcell_http_client_p lwcell_http_client_new(lwcell_netconn_type_t type, const char* host, lwcell_port_t port);
+void lwcell_http_client_delete(lwcell_http_client_p client);
+lwcellr_t lwcell_http_client_request(lwcell_http_client_p client, const char* method, const char* path,
+                                     const char* headers, const void* body, size_t body_len);
+lwcellr_t lwcell_http_client_response(lwcell_http_client_p client, lwcell_http_client_resp_t* resp,
+                                      lwcell_http_client_body_fn body_fn, void* arg, uint32_t timeout);
+lwcellr_t lwcell_http_client_execute(lwcell_http_client_p client, const char* method, const char* path,
+                                     const char* headers, const void* body, size_t body_len,
+                                     lwcell_http_client_resp_t* resp, lwcell_http_client_body_fn body_fn, void* arg,
+                                     uint32_t timeout);
+size_t lwcell_http_client_get_pending(lwcell_http_client_p client);
+lwcellr_t lwcell_http_client_close(lwcell_http_client_p client);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_APP_HTTP_CLIENT_HDR_H */
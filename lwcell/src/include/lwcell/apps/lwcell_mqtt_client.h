@@ -78,6 +78,14 @@ typedef enum {
     LWCELL_MQTT_CONNECTED,                /*!< MQTT is fully connected and ready to send data on topics */
 } lwcell_mqtt_state_t;
 
+/**
+ * \brief           Topic filter subscribed during session setup
+ */
+typedef struct {
+    const char* topic;     /*!< Topic filter */
+    lwcell_mqtt_qos_t qos; /*!< Maximal quality of service of messages received on topic filter */
+} lwcell_mqtt_client_sub_t;
+
 /**
  * \brief           MQTT client information structure
  */
@@ -93,6 +101,22 @@ typedef struct {
     const char* will_topic;     /*!< Will topic */
     const char* will_message;   /*!< Will message */
     lwcell_mqtt_qos_t will_qos; /*!< Will topic quality of service */
+
+    const lwcell_mqtt_client_sub_t* subs; /*!< Topic filters subscribed on every connection, in single SUBSCRIBE packet
+                                                    sent together with CONNECT, without waiting for CONNACK.
+                                                    Result is reported with \ref LWCELL_MQTT_EVT_SUBSCRIBE event,
+                                                    with `subs` as argument. With persistent session, sent after
+                                                    CONNACK only when server has no session.
+                                                    Set to `NULL` if not used */
+    size_t subs_len;                      /*!< Number of entries in `subs` array */
+
+#if LWCELL_CFG_MQTT_V5 || __DOXYGEN__
+    uint8_t version; /*!< Protocol version. Set to `5` for MQTT 5, any other value selects MQTT 3.1.1 */
+#endif               /* LWCELL_CFG_MQTT_V5 || __DOXYGEN__ */
+#if LWCELL_CFG_PWR_RADIO_RELEASE || __DOXYGEN__
+    uint8_t radio_release; /*!< Set to `1` to request early radio release with \ref lwcell_pwr_radio_release,
+                                once all data are sent and every request is acknowledged by server */
+#endif                     /* LWCELL_CFG_PWR_RADIO_RELEASE || __DOXYGEN__ */
 } lwcell_mqtt_client_info_t;
 
 /**
@@ -113,16 +137,20 @@ typedef struct {
  * \brief           MQTT event types
  */
 typedef enum {
-    LWCELL_MQTT_EVT_CONNECT,      /*!< MQTT client connect event */
-    LWCELL_MQTT_EVT_SUBSCRIBE,    /*!< MQTT client subscribed to specific topic */
-    LWCELL_MQTT_EVT_UNSUBSCRIBE,  /*!< MQTT client unsubscribed from specific topic */
-    LWCELL_MQTT_EVT_PUBLISH,      /*!< MQTT client publish message to server event.
+    LWCELL_MQTT_EVT_CONNECT,             /*!< MQTT client connect event */
+    LWCELL_MQTT_EVT_SUBSCRIBE,           /*!< MQTT client subscribed to specific topic */
+    LWCELL_MQTT_EVT_UNSUBSCRIBE,         /*!< MQTT client unsubscribed from specific topic */
+    LWCELL_MQTT_EVT_PUBLISH,             /*!< MQTT client publish message to server event.
                                                     \note   When publishing packet with quality of service \ref LWCELL_MQTT_QOS_AT_MOST_ONCE,
                                                             you may not receive event, even if packet was successfully sent,
                                                             thus do not rely on this event for packet with `qos = LWCELL_MQTT_QOS_AT_MOST_ONCE` */
-    LWCELL_MQTT_EVT_PUBLISH_RECV, /*!< MQTT client received a publish message from server */
-    LWCELL_MQTT_EVT_DISCONNECT,   /*!< MQTT client disconnected from MQTT server */
-    LWCELL_MQTT_EVT_KEEP_ALIVE,   /*!< MQTT keep-alive sent to server and reply received */
+    LWCELL_MQTT_EVT_PUBLISH_RECV,        /*!< MQTT client received a publish message from server */
+    LWCELL_MQTT_EVT_DISCONNECT,          /*!< MQTT client disconnected from MQTT server */
+    LWCELL_MQTT_EVT_KEEP_ALIVE,          /*!< MQTT keep-alive sent to server and reply received */
+    LWCELL_MQTT_EVT_PUBLISH_REF_RELEASE, /*!< Payload passed to \ref lwcell_mqtt_client_publish_ref
+                                                    is not referenced by client anymore and may be reused */
+    LWCELL_MQTT_EVT_WINDOW_FREE,         /*!< Request slot in in-flight window was released
+                                                    after request failed because window was full */
 } lwcell_mqtt_evt_type_t;
 
 /**
@@ -146,7 +174,9 @@ typedef struct {
 
     union {
         struct {
-            lwcell_mqtt_conn_status_t status; /*!< Connection status with MQTT */
+            lwcell_mqtt_conn_status_t status; /*!< Connection status with MQTT.
+                                                    MQTT 5 reason codes without MQTT 3.1.1 equivalent
+                                                    are reported as received, in range `0x80` to `0xFF` */
         } connect;                            /*!< Event for connecting to server */
 
         struct {
@@ -163,11 +193,20 @@ typedef struct {
             lwcellr_t res; /*!< Response status */
         } publish;         /*!< Published event */
 
+        struct {
+            const void* payload; /*!< Payload passed on publish */
+            size_t payload_len;  /*!< Length of payload */
+            void* arg;           /*!< User argument for callback function */
+            lwcellr_t res;       /*!< \ref lwcellOK when payload was sent, member of \ref lwcellr_t otherwise */
+        } publish_ref_release;   /*!< Referenced payload released event */
+
         struct {
             const uint8_t* topic;  /*!< Pointer to topic identifier */
             size_t topic_len;      /*!< Length of topic */
             const void* payload;   /*!< Topic payload */
             size_t payload_len;    /*!< Length of topic payload */
+            size_t payload_offset; /*!< Offset of payload part in full payload */
+            size_t total_len;      /*!< Full payload length. Greater than `payload_len` only for streamed packets */
             uint8_t dup;           /*!< Duplicate flag if message was sent again */
             lwcell_mqtt_qos_t qos; /*!< Received packet quality of service */
             uint8_t retain;        /*!< Retain status of the received packet */
@@ -182,7 +221,113 @@ typedef struct {
  */
 typedef void (*lwcell_mqtt_evt_fn)(lwcell_mqtt_client_p client, lwcell_mqtt_evt_t* evt);
 
+/**
+ * \brief           Topic filter callback function
+ * \param[in]       client: MQTT client
+ * \param[in]       evt: \ref LWCELL_MQTT_EVT_PUBLISH_RECV event with received packet
+ * \param[in]       arg: User argument passed to \ref lwcell_mqtt_client_topic_add
+ */
+typedef void (*lwcell_mqtt_topic_fn)(lwcell_mqtt_client_p client, lwcell_mqtt_evt_t* evt, void* arg);
+
+/**
+ * \brief           Writer of publish payload, used with \ref lwcell_mqtt_client_publish_writer
+ */
+typedef struct {
+    lwcell_mqtt_client_p client; /*!< MQTT client */
+    size_t len;                  /*!< Number of payload bytes written */
+    size_t max_len;              /*!< Maximal payload length */
+} lwcell_mqtt_client_writer_t;
+
+/**
+ * \brief           Payload writer callback function
+ * \param[in]       w: Payload writer
+ * \param[in]       arg: User argument passed to \ref lwcell_mqtt_client_publish_writer
+ * \return          \ref lwcellOK to publish written payload, member of \ref lwcellr_t to drop the message
+ */
+typedef lwcellr_t (*lwcell_mqtt_client_payload_fn)(lwcell_mqtt_client_writer_t* w, void* arg);
+
+#if LWCELL_CFG_MQTT_OFFLINE_QUEUE || __DOXYGEN__
+
+/**
+ * \brief           Append record to offline storage
+ * \param[in]       arg: User argument from \ref lwcell_mqtt_offline_storage_t
+ * \param[in]       data: Record data
+ * \param[in]       len: Record length in units of bytes
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration when storage is full
+ */
+typedef lwcellr_t (*lwcell_mqtt_offline_write_fn)(void* arg, const void* data, size_t len);
+
+/**
+ * \brief           Read oldest record from offline storage without removing it
+ * \note            Function is called with `data = NULL` to get record length only,
+ *                  it is called on every publish to check if storage is empty
+ * \param[in]       arg: User argument from \ref lwcell_mqtt_offline_storage_t
+ * \param[out]      data: Buffer to copy record to. May be `NULL`
+ * \param[in]       len: Length of buffer in units of bytes
+ * \return          Length of oldest record or `0` when storage is empty
+ */
+typedef size_t (*lwcell_mqtt_offline_read_fn)(void* arg, void* data, size_t len);
+
+/**
+ * \brief           Remove oldest record from offline storage, after it was published
+ * \param[in]       arg: User argument from \ref lwcell_mqtt_offline_storage_t
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+typedef lwcellr_t (*lwcell_mqtt_offline_remove_fn)(void* arg);
+
+/**
+ * \brief           Storage tier of offline publish queue, such as flash memory.
+ *                  Records are opaque to the storage and must be returned in the order they were written
+ */
+typedef struct {
+    lwcell_mqtt_offline_write_fn write_fn;   /*!< Append record callback */
+    lwcell_mqtt_offline_read_fn read_fn;     /*!< Read oldest record callback */
+    lwcell_mqtt_offline_remove_fn remove_fn; /*!< Remove oldest record callback */
+    void* arg;                               /*!< User argument passed to callbacks */
+} lwcell_mqtt_offline_storage_t;
+
+#endif /* LWCELL_CFG_MQTT_OFFLINE_QUEUE || __DOXYGEN__ */
+
+#if LWCELL_CFG_MQTT_SESSION || __DOXYGEN__
+
+/**
+ * \brief           Save or remove session record of in-flight packet
+ * \note            Record with the same packet ID is replaced and keeps its position in the order
+ * \param[in]       arg: User argument from \ref lwcell_mqtt_session_storage_t
+ * \param[in]       packet_id: Packet ID of the record
+ * \param[in]       data: Record data, raw packet to send again. `NULL` to remove record
+ * \param[in]       len: Record length in units of bytes, `0` to remove record
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+typedef lwcellr_t (*lwcell_mqtt_session_write_fn)(void* arg, uint16_t packet_id, const void* data, size_t len);
+
+/**
+ * \brief           Read session record
+ * \note            Function is called with `data = NULL` to get record length and packet ID only
+ * \param[in]       arg: User argument from \ref lwcell_mqtt_session_storage_t
+ * \param[in]       index: Record index, records must be indexed in the order they were first saved
+ * \param[out]      packet_id: Packet ID of the record
+ * \param[out]      data: Buffer to copy record to. May be `NULL`
+ * \param[in]       len: Length of buffer in units of bytes
+ * \return          Length of record or `0` if there is no record at index
+ */
+typedef size_t (*lwcell_mqtt_session_read_fn)(void* arg, size_t index, uint16_t* packet_id, void* data, size_t len);
+
+/**
+ * \brief           Persistent session storage, such as flash memory.
+ *                  Holds QoS `1` and `2` packets not yet acknowledged by server
+ */
+typedef struct {
+    lwcell_mqtt_session_write_fn write_fn; /*!< Save or remove record callback */
+    lwcell_mqtt_session_read_fn read_fn;   /*!< Read record callback */
+    uint32_t expiry;                       /*!< Session expiry interval in units of seconds, sent with MQTT 5 only */
+    void* arg;                             /*!< User argument passed to callbacks */
+} lwcell_mqtt_session_storage_t;
+
+#endif /* LWCELL_CFG_MQTT_SESSION || __DOXYGEN__ */
+
 lwcell_mqtt_client_p lwcell_mqtt_client_new(size_t tx_buff_len, size_t rx_buff_len);
+lwcell_mqtt_client_p lwcell_mqtt_client_new_ex(size_t tx_buff_len, size_t rx_buff_len, uint16_t max_requests);
 void lwcell_mqtt_client_delete(lwcell_mqtt_client_p client);
 
 lwcellr_t lwcell_mqtt_client_connect(lwcell_mqtt_client_p client, const char* host, lwcell_port_t port,
@@ -196,9 +341,37 @@ lwcellr_t lwcell_mqtt_client_unsubscribe(lwcell_mqtt_client_p client, const char
 
 lwcellr_t lwcell_mqtt_client_publish(lwcell_mqtt_client_p client, const char* topic, const void* payload, uint16_t len,
                                      lwcell_mqtt_qos_t qos, uint8_t retain, void* arg);
+lwcellr_t lwcell_mqtt_client_publish_ref(lwcell_mqtt_client_p client, const char* topic, const void* payload,
+                                         uint16_t len, lwcell_mqtt_qos_t qos, uint8_t retain, void* arg);
+lwcellr_t lwcell_mqtt_client_publish_writer(lwcell_mqtt_client_p client, const char* topic, uint16_t max_len,
+                                            lwcell_mqtt_client_payload_fn payload_fn, void* payload_arg,
+                                            lwcell_mqtt_qos_t qos, uint8_t retain, void* arg);
+void* lwcell_mqtt_client_writer_get_buff(lwcell_mqtt_client_writer_t* w, size_t* len);
+lwcellr_t lwcell_mqtt_client_writer_commit(lwcell_mqtt_client_writer_t* w, size_t len);
+lwcellr_t lwcell_mqtt_client_writer_write(lwcell_mqtt_client_writer_t* w, const void* data, size_t len);
+#if LWCELL_CFG_COMPRESS || __DOXYGEN__
+lwcellr_t lwcell_mqtt_client_publish_compressed(lwcell_mqtt_client_p client, lwcell_compress_t* comp, const char* topic,
+                                                const void* payload, uint16_t len, lwcell_mqtt_qos_t qos,
+                                                uint8_t retain, void* arg);
+#endif /* LWCELL_CFG_COMPRESS || __DOXYGEN__ */
+lwcellr_t lwcell_mqtt_client_publish_begin(lwcell_mqtt_client_p client);
+lwcellr_t lwcell_mqtt_client_publish_end(lwcell_mqtt_client_p client);
+#if LWCELL_CFG_MQTT_OFFLINE_QUEUE || __DOXYGEN__
+lwcellr_t lwcell_mqtt_client_set_offline_queue(lwcell_mqtt_client_p client, size_t ram_len,
+                                               const lwcell_mqtt_offline_storage_t* storage);
+#endif /* LWCELL_CFG_MQTT_OFFLINE_QUEUE || __DOXYGEN__ */
+#if LWCELL_CFG_MQTT_SESSION || __DOXYGEN__
+lwcellr_t lwcell_mqtt_client_set_session(lwcell_mqtt_client_p client, const lwcell_mqtt_session_storage_t* storage);
+#endif /* LWCELL_CFG_MQTT_SESSION || __DOXYGEN__ */
 
 void* lwcell_mqtt_client_get_arg(lwcell_mqtt_client_p client);
 void lwcell_mqtt_client_set_arg(lwcell_mqtt_client_p client, void* arg);
+uint8_t* lwcell_mqtt_client_swap_rx_buff(lwcell_mqtt_client_p client, lwcell_mqtt_evt_t* evt, uint8_t* buff);
+#if LWCELL_CFG_MQTT_TOPIC_ROUTER || __DOXYGEN__
+lwcellr_t lwcell_mqtt_client_topic_add(lwcell_mqtt_client_p client, const char* filter, lwcell_mqtt_topic_fn fn,
+                                       void* arg);
+lwcellr_t lwcell_mqtt_client_topic_remove(lwcell_mqtt_client_p client, const char* filter);
+#endif /* LWCELL_CFG_MQTT_TOPIC_ROUTER || __DOXYGEN__ */
 
 /**
  * \}
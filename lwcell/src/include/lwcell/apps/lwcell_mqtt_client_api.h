@@ -63,6 +63,10 @@ typedef struct lwcell_mqtt_client_api_buf {
     size_t payload_len;    /*!< Payload length */
     lwcell_mqtt_qos_t qos; /*!< Quality of service */
     uint8_t retain;        /*!< Retain status of the packet */
+#if LWCELL_CFG_MQTT_API_BUF_POOL_SIZE > 0 || __DOXYGEN__
+    struct lwcell_mqtt_client_api* pool_owner; /*!< Client owning pool buffer, `NULL` for heap buffer. Private */
+    uint8_t* pool_data;                        /*!< Memory of pool buffer. Private */
+#endif                                         /* LWCELL_CFG_MQTT_API_BUF_POOL_SIZE > 0 || __DOXYGEN__ */
 } lwcell_mqtt_client_api_buf_t;
 
 /**
@@ -192,6 +192,27 @@ extern "C" {
 #define lwcell_mqtt_client_evt_publish_recv_get_payload_len(client, evt)                                               \
     (LWCELL_SZ((evt)->evt.publish_recv.payload_len))
 
+/**
+ * \brief           Get offset of received payload part in full payload
+ * \note            Packets larger than RX buffer are delivered in multiple events
+ *                  when \ref LWCELL_CFG_MQTT_RECV_STREAM is enabled
+ * \param[in]       client: MQTT client
+ * \param[in]       evt: Event handle
+ * \return          Payload offset
+ * \hideinitializer
+ */
+#define lwcell_mqtt_client_evt_publish_recv_get_payload_offset(client, evt)                                            \
+    (LWCELL_SZ((evt)->evt.publish_recv.payload_offset))
+
+/**
+ * \brief           Get full payload length of received publish packet
+ * \param[in]       client: MQTT client
+ * \param[in]       evt: Event handle
+ * \return          Full payload length
+ * \hideinitializer
+ */
+#define lwcell_mqtt_client_evt_publish_recv_get_total_len(client, evt) (LWCELL_SZ((evt)->evt.publish_recv.total_len))
+
 /**
  * \brief           Check if packet is duplicated
  * \param[in]       client: MQTT client
@@ -199,7 +220,7 @@ extern "C" {
  * \return          `1` if duplicated, `0` otherwise
  * \hideinitializer
  */
-#define lwcell_mqtt_client_evt_publish_recv_is_duplicate(client, evt) (LWCELL_U8((evt)->evt.publish_recv.dup))
+#define lwcell_mqtt_client_evt_publish_recv_is_duplicate(client, evt)  (LWCELL_U8((evt)->evt.publish_recv.dup))
 
 /**
  * \brief           Get received quality of service
@@ -208,7 +229,7 @@ extern "C" {
  * \return          Member of \ref lwcell_mqtt_qos_t enumeration
  * \hideinitializer
  */
-#define lwcell_mqtt_client_evt_publish_recv_get_qos(client, evt)      ((evt)->evt.publish_recv.qos)
+#define lwcell_mqtt_client_evt_publish_recv_get_qos(client, evt)       ((evt)->evt.publish_recv.qos)
 
 /**
  * \brief           Get received retain
@@ -217,7 +238,7 @@ extern "C" {
  * \return          `1` if retained, `0` otherwise
  * \hideinitializer
  */
-#define lwcell_mqtt_client_evt_publish_recv_get_retain(client, evt)   ((evt)->evt.publish_recv.retain)
+#define lwcell_mqtt_client_evt_publish_recv_get_retain(client, evt)    ((evt)->evt.publish_recv.retain)
 
 /**
  * \}
@@ -249,6 +270,58 @@ extern "C" {
 */
 #define lwcell_mqtt_client_evt_publish_get_result(client, evt)        ((lwcellr_t)(evt)->evt.publish.res)
 
+/**
+ * \}
+ */
+
+/**
+ * \anchor          LWCELL_APP_MQTT_CLIENT_EVT_PUBLISH_REF_RELEASE
+ * \name            Referenced payload release event
+ * \{
+ *
+ * \note            Use these functions on \ref LWCELL_MQTT_EVT_PUBLISH_REF_RELEASE event
+ */
+
+/**
+ * \brief           Get payload used on \ref lwcell_mqtt_client_publish_ref
+ * \param[in]       client: MQTT client
+ * \param[in]       evt: Event handle
+ * \return          Payload memory, not referenced by client anymore
+ * \hideinitializer
+ */
+#define lwcell_mqtt_client_evt_publish_ref_release_get_payload(client, evt)                                            \
+    ((const void*)(evt)->evt.publish_ref_release.payload)
+
+/**
+ * \brief           Get payload length used on \ref lwcell_mqtt_client_publish_ref
+ * \param[in]       client: MQTT client
+ * \param[in]       evt: Event handle
+ * \return          Payload length in units of bytes
+ * \hideinitializer
+ */
+#define lwcell_mqtt_client_evt_publish_ref_release_get_payload_len(client, evt)                                        \
+    (LWCELL_SZ((evt)->evt.publish_ref_release.payload_len))
+
+/**
+ * \brief           Get user argument used on \ref lwcell_mqtt_client_publish_ref
+ * \param[in]       client: MQTT client
+ * \param[in]       evt: Event handle
+ * \return          User argument
+ * \hideinitializer
+ */
+#define lwcell_mqtt_client_evt_publish_ref_release_get_argument(client, evt)                                           \
+    ((void*)(evt)->evt.publish_ref_release.arg)
+
+/**
+ * \brief           Get result of payload transmission
+ * \param[in]       client: MQTT client
+ * \param[in]       evt: Event handle
+ * \return          \ref lwcellOK when payload was sent, member of \ref lwcellr_t otherwise
+ * \hideinitializer
+ */
+#define lwcell_mqtt_client_evt_publish_ref_release_get_result(client, evt)                                             \
+    ((lwcellr_t)(evt)->evt.publish_ref_release.res)
+
 /**
  * \}
  */
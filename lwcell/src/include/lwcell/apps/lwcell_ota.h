@@ -0,0 +1,120 @@
+/**
+ * \file            lwcell_ota.h
+ * \brief           Resumable OTA download
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_APP_OTA_HDR_H
+#define LWCELL_APP_OTA_HDR_H
+
+#include "lwcell/lwcell_includes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL_APPS
+ * \defgroup        LWCELL_APP_OTA OTA download
+ * \brief           Resumable firmware download with HTTP range requests
+ * \{
+ *
+ * Image is requested with `Range: bytes=<offset>-` header, starting at offset of last written data.
+ * Download state (offset, image length and running CRC-32 of written data) is handed to application
+ * after every write, so it can be kept in non-volatile memory and download continues after
+ * connection loss, or even after device restart, without transferring already written data again.
+ *
+ * Received packet buffer leaves netconn receive queue before its data are written to flash.
+ * Device keeps receiving next packet buffers meanwhile, with \ref LWCELL_CFG_CONN_MANUAL_RECV
+ * its window is returned before write starts, so flash write and erase overlap network transfer.
+ *
+ * \note            Only plain HTTP (`http://`) server with range request support is supported
+ */
+
+/**
+ * \brief           OTA download state, persisted by application
+ */
+typedef struct {
+    size_t offset;    /*!< Number of image bytes written to flash */
+    size_t total_len; /*!< Total image length, `0` when not yet known */
+    uint32_t crc;     /*!< CRC-32 of first `offset` image bytes */
+} lwcell_ota_state_t;
+
+/**
+ * \brief           Write image data to flash
+ * \param[in]       offset: Offset in image
+ * \param[in]       data: Data to write
+ * \param[in]       len: Length of data in units of bytes
+ * \param[in]       arg: User argument
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise to abort download
+ */
+typedef lwcellr_t (*lwcell_ota_write_fn)(size_t offset, const void* data, size_t len, void* arg);
+
+/**
+ * \brief           Load or store OTA download state in non-volatile memory
+ * \param[in,out]   state: State to store, or to fill when loading
+ * \param[in]       store: Set to `1` to store state, `0` to load it
+ * \param[in]       arg: User argument
+ * \return          `1` when state was loaded or stored, `0` otherwise
+ */
+typedef uint8_t (*lwcell_ota_state_fn)(lwcell_ota_state_t* state, uint8_t store, void* arg);
+
+/**
+ * \brief           OTA download configuration
+ */
+typedef struct {
+    const char* host;             /*!< Server host name or IP address */
+    lwcell_port_t port;           /*!< Server port, typically `80` */
+    const char* path;             /*!< Absolute path of image on server, such as `/fw/app.bin` */
+    uint8_t* block;               /*!< Optional buffer of `block_len` bytes to write data in flash sized blocks.
+                                        Set to `NULL` to write received packet buffers directly */
+    size_t block_len;             /*!< Length of `block` buffer, such as flash page size */
+    uint8_t verify;               /*!< Set to `1` to verify CRC-32 of complete image against `crc32` */
+    uint32_t crc32;               /*!< Expected CRC-32 (IEEE 802.3) of complete image */
+    uint32_t timeout;             /*!< Receive timeout in units of milliseconds, `0` to wait forever */
+    uint16_t max_retries;         /*!< Maximal number of retries in a row, when attempt wrote no new data */
+    uint32_t retry_delay;         /*!< Delay before next connection attempt in units of milliseconds */
+    lwcell_ota_write_fn write_fn; /*!< Function to write data to flash */
+    lwcell_ota_state_fn state_fn; /*!< Optional function to persist download state. Set to `NULL` if not used */
+    void* arg;                    /*!< User argument passed to callback functions */
+} lwcell_ota_cfg_t;
+
+lwcellr_t lwcell_ota_download(const lwcell_ota_cfg_t* cfg, lwcell_ota_state_t* state);
+uint32_t lwcell_ota_crc32(uint32_t crc, const void* data, size_t len);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_APP_OTA_HDR_H */
@@ -0,0 +1,106 @@
+/**
+ * \file            lwcell_ws_client.h
+ * \brief           WebSocket client
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_APP_WS_CLIENT_HDR_H
+#define LWCELL_APP_WS_CLIENT_HDR_H
+
+#include "lwcell/lwcell_includes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL_APPS
+ * \defgroup        LWCELL_APP_WS_CLIENT WebSocket client
+ * \brief           Sequential WebSocket client on top of netconn
+ * \{
+ *
+ * Received frames are parsed directly in packet buffer chain received from connection
+ * and payload is handed to application without copy, valid until next receive call.
+ * Sent payload is masked in small blocks straight to netconn write buffer, which is sent with `AT+CIPSEND`.
+ * Ping frames are answered and pong frames are consumed by client.
+ *
+ * \note            Handshake response is accepted on status `101` and `Sec-WebSocket-Accept` is not verified
+ */
+
+/**
+ * \brief           WebSocket frame opcode
+ */
+typedef enum {
+    LWCELL_WS_OPCODE_CONT = 0x00,   /*!< Continuation frame of fragmented message */
+    LWCELL_WS_OPCODE_TEXT = 0x01,   /*!< Text frame */
+    LWCELL_WS_OPCODE_BINARY = 0x02, /*!< Binary frame */
+    LWCELL_WS_OPCODE_CLOSE = 0x08,  /*!< Connection close frame */
+    LWCELL_WS_OPCODE_PING = 0x09,   /*!< Ping frame */
+    LWCELL_WS_OPCODE_PONG = 0x0A,   /*!< Pong frame */
+} lwcell_ws_opcode_t;
+
+/**
+ * \brief           Received WebSocket data frame
+ */
+typedef struct {
+    lwcell_ws_opcode_t opcode; /*!< Frame opcode */
+    uint8_t fin;               /*!< Set to `1` for last frame of message */
+    lwcell_pbuf_p pbuf;        /*!< Packet buffer chain holding payload. It is owned by client */
+    size_t offset;             /*!< Offset of payload in `pbuf` */
+    size_t len;                /*!< Payload length in units of bytes */
+} lwcell_ws_frame_t;
+
+/**
+ * \brief           WebSocket client structure
+ */
+struct lwcell_ws_client;
+
+/**
+ * \brief           Pointer to \ref lwcell_ws_client structure
+ */
+typedef struct lwcell_ws_client* lwcell_ws_client_p;
+
+lwcell_ws_client_p lwcell_ws_client_new(void);
+void lwcell_ws_client_delete(lwcell_ws_client_p ws);
+lwcellr_t lwcell_ws_client_connect(lwcell_ws_client_p ws, const char* host, lwcell_port_t port, const char* path);
+lwcellr_t lwcell_ws_client_send(lwcell_ws_client_p ws, lwcell_ws_opcode_t opcode, const void* data, size_t len);
+lwcellr_t lwcell_ws_client_receive(lwcell_ws_client_p ws, lwcell_ws_frame_t* frame, uint32_t timeout);
+lwcellr_t lwcell_ws_client_close(lwcell_ws_client_p ws);
+uint32_t lwcell_ws_client_random(void);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_APP_WS_CLIENT_HDR_H */
@@ -62,8 +62,18 @@ lwcellr_t lwcell_device_set_present(uint8_t present, const lwcell_api_cmd_evt_fn
                                   const uint32_t blocking);
 uint8_t lwcell_device_is_present(void);
 
+#if LWCELL_CFG_PRODUCER_ADMISSION || __DOXYGEN__
+lwcellr_t lwcell_producer_check(uint8_t prio, size_t* depth);
+lwcellr_t lwcell_producer_set_limit(uint8_t prio, size_t limit);
+lwcellr_t lwcell_producer_get_status(lwcell_producer_status_t* status, uint8_t reset);
+#endif /* LWCELL_CFG_PRODUCER_ADMISSION || __DOXYGEN__ */
+
 uint8_t lwcell_delay(uint32_t ms);
 
+#if !LWCELL_CFG_OS || __DOXYGEN__
+uint32_t lwcell_poll(void);
+#endif /* !LWCELL_CFG_OS || __DOXYGEN__ */
+
 /**
  * \}
  */
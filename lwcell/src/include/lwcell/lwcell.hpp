@@ -0,0 +1,701 @@
+/**
+ * \file            lwcell.hpp
+ * \brief           C++17 header-only wrapper
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_HPP_HDR_H
+#define LWCELL_HPP_HDR_H
+
+#if !defined(__cplusplus) || __cplusplus < 201703L
+#error "lwcell.hpp requires C++17 or newer"
+#endif /* !defined(__cplusplus) || __cplusplus < 201703L */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+#include <utility>
+#include "lwcell/lwcell.h"
+#if LWCELL_CFG_NETCONN || __DOXYGEN__
+#include "lwcell/apps/lwcell_mqtt_client_api.h"
+#include "lwcell/lwcell_netconn.h"
+#endif /* LWCELL_CFG_NETCONN || __DOXYGEN__ */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_CPP C++ wrapper
+ * \brief           Header-only C++17 wrapper with owning handles
+ *
+ * Wrapper does not use exceptions, RTTI or dynamic allocation on its own.
+ * Errors are reported with \ref lwcellr_t values, as in C API.
+ * Handle types own their C object, are move-only and release object in destructor.
+ * Data is passed as \ref lwcell::Span views and is never copied by wrapper.
+ *
+ * \{
+ */
+
+namespace lwcell {
+
+/**
+ * \brief           Non-owning view of contiguous memory
+ * \tparam          T: Element type, use `const` type for read-only view
+ */
+template <typename T>
+class Span {
+  public:
+    constexpr Span() noexcept : m_data(nullptr), m_size(0) {}
+
+    constexpr Span(T* data, size_t size) noexcept : m_data(data), m_size(size) {}
+
+    template <size_t N>
+    constexpr Span(T (&arr)[N]) noexcept : m_data(arr), m_size(N) {}
+
+    /**
+     * \brief           Create view of container with `data()` and `size()` members, such as `std::array`
+     */
+    template <typename C, typename = std::enable_if_t<std::is_convertible_v<
+                              std::remove_pointer_t<decltype(std::declval<C&>().data())> (*)[], T (*)[]>>>
+    constexpr Span(C& cont) noexcept : m_data(cont.data()), m_size(cont.size()) {}
+
+    /**
+     * \brief           Convert view of mutable elements to view of `const` elements
+     */
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(const Span<U>& other) noexcept : m_data(other.data()), m_size(other.size()) {}
+
+    constexpr T* data() const noexcept { return m_data; }
+    constexpr size_t size() const noexcept { return m_size; }
+    constexpr size_t size_bytes() const noexcept { return m_size * sizeof(T); }
+    constexpr bool empty() const noexcept { return m_size == 0; }
+    constexpr T* begin() const noexcept { return m_data; }
+    constexpr T* end() const noexcept { return m_data + m_size; }
+    constexpr T& operator[](size_t idx) const noexcept { return m_data[idx]; }
+
+    constexpr Span subspan(size_t offset, size_t count = static_cast<size_t>(-1)) const noexcept {
+        if (offset > m_size) {
+            offset = m_size;
+        }
+        if (count > m_size - offset) {
+            count = m_size - offset;
+        }
+        return Span(m_data + offset, count);
+    }
+
+  private:
+    T* m_data;
+    size_t m_size;
+};
+
+/**
+ * \brief           Read-only byte view, accepted by all send functions
+ */
+using ConstBytes = Span<const uint8_t>;
+
+/**
+ * \brief           Get read-only byte view of any view
+ * \param[in]       s: View of trivially copyable elements
+ * \return          Byte view of same memory
+ */
+template <typename T>
+inline ConstBytes
+as_bytes(Span<T> s) noexcept {
+    static_assert(std::is_trivially_copyable_v<std::remove_cv_t<T>>, "Elements must be trivially copyable");
+    return ConstBytes(reinterpret_cast<const uint8_t*>(s.data()), s.size_bytes());
+}
+
+/**
+ * \brief           Packet buffer with single owned reference
+ *
+ * Object holds one reference of packet buffer chain and releases it on destruction.
+ * It can be moved, but not copied. Use \ref share to take additional reference explicitly.
+ */
+class Pbuf {
+  public:
+    constexpr Pbuf() noexcept : m_p(nullptr) {}
+
+    Pbuf(const Pbuf&) = delete;
+    Pbuf& operator=(const Pbuf&) = delete;
+
+    Pbuf(Pbuf&& other) noexcept : m_p(other.release()) {}
+
+    Pbuf&
+    operator=(Pbuf&& other) noexcept {
+        if (this != &other) {
+            reset(other.release());
+        }
+        return *this;
+    }
+
+    ~Pbuf() { reset(); }
+
+    /**
+     * \brief           Allocate new packet buffer
+     * \param[in]       len: Payload length in units of bytes
+     * \return          Packet buffer, empty on allocation failure
+     */
+    static Pbuf
+    alloc(size_t len) noexcept {
+        return adopt(lwcell_pbuf_new(len));
+    }
+
+    /**
+     * \brief           Take ownership of reference, already held by caller
+     * \param[in]       p: Packet buffer, such as one returned by \ref lwcell_netconn_receive
+     * \return          Owning object
+     */
+    static Pbuf
+    adopt(lwcell_pbuf_p p) noexcept {
+        Pbuf b;
+        b.m_p = p;
+        return b;
+    }
+
+    /**
+     * \brief           Take new reference of packet buffer, owned by someone else
+     * \note            Use it in event callbacks, where library frees its reference after callback returns
+     * \param[in]       p: Packet buffer
+     * \return          Owning object, empty if `p` is `NULL`
+     */
+    static Pbuf
+    retain(lwcell_pbuf_p p) noexcept {
+        if (p != nullptr && lwcell_pbuf_ref(p) != lwcellOK) {
+            p = nullptr;
+        }
+        return adopt(p);
+    }
+
+    /**
+     * \brief           Take additional reference of same packet buffer
+     * \return          New owning object, empty if this object is empty
+     */
+    Pbuf
+    share() const noexcept {
+        return retain(m_p);
+    }
+
+    /**
+     * \brief           Give up ownership without releasing reference
+     * \return          Packet buffer, caller becomes responsible for freeing it
+     */
+    lwcell_pbuf_p
+    release() noexcept {
+        lwcell_pbuf_p p = m_p;
+        m_p = nullptr;
+        return p;
+    }
+
+    /**
+     * \brief           Release current reference and optionally own new one
+     * \param[in]       p: New packet buffer to own, already referenced by caller
+     */
+    void
+    reset(lwcell_pbuf_p p = nullptr) noexcept {
+        if (m_p != nullptr) {
+            lwcell_pbuf_free(m_p);
+        }
+        m_p = p;
+    }
+
+    lwcell_pbuf_p get() const noexcept { return m_p; }
+    explicit operator bool() const noexcept { return m_p != nullptr; }
+
+    size_t length() const noexcept { return m_p != nullptr ? lwcell_pbuf_length(m_p, 1) : 0; }
+
+    /**
+     * \brief           Get contiguous view of segment containing offset
+     * \param[in]       offset: Offset in chain in units of bytes
+     * \return          View from offset to end of its segment, empty when offset is out of range
+     */
+    ConstBytes
+    linear(size_t offset = 0) const noexcept {
+        size_t len = 0;
+        void* addr = m_p != nullptr ? lwcell_pbuf_get_linear_addr(m_p, offset, &len) : nullptr;
+        return addr != nullptr ? ConstBytes(static_cast<const uint8_t*>(addr), len) : ConstBytes();
+    }
+
+    /**
+     * \brief           Call function for every segment of chain, without copying data
+     * \param[in]       fn: Function or lambda, called with \ref ConstBytes argument
+     */
+    template <typename Fn>
+    void
+    for_each_segment(Fn&& fn) const {
+        size_t off = 0;
+        for (ConstBytes s = linear(0); !s.empty(); off += s.size(), s = linear(off)) {
+            fn(s);
+        }
+    }
+
+    /**
+     * \brief           Copy data from chain to application memory
+     * \param[out]      dst: Destination view
+     * \param[in]       offset: Start offset in chain
+     * \return          Number of bytes copied
+     */
+    size_t
+    copy_to(Span<uint8_t> dst, size_t offset = 0) const noexcept {
+        return m_p != nullptr ? lwcell_pbuf_copy(m_p, dst.data(), dst.size(), offset) : 0;
+    }
+
+    /**
+     * \brief           Find data in chain
+     * \param[in]       needle: Data to find
+     * \param[in]       offset: Start offset in chain
+     * \return          Position of first match or \ref LWCELL_SIZET_MAX if not found
+     */
+    size_t
+    find(ConstBytes needle, size_t offset = 0) const noexcept {
+        return m_p != nullptr ? lwcell_pbuf_memfind(m_p, needle.data(), needle.size(), offset) : LWCELL_SIZET_MAX;
+    }
+
+  private:
+    lwcell_pbuf_p m_p;
+};
+
+/**
+ * \brief           Register global event handler function
+ *
+ * Handler is bound at compile time and registered through single trampoline per handler,
+ * no memory is allocated to store it. Handler may return \ref lwcellr_t or `void`
+ *
+ * \code{.cpp}
+static lwcellr_t on_event(lwcell_evt_t& evt) { ... }
+...
+lwcell::evt_register<on_event>();
+\endcode
+ *
+ * \tparam          Fn: Function with `lwcellr_t (lwcell_evt_t&)` or `void (lwcell_evt_t&)` signature
+ * \param[in]       mask: Event subscription mask
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+template <auto Fn>
+inline lwcellr_t evt_register(lwcell_evt_mask_t mask = LWCELL_EVT_MASK_ALL) noexcept;
+
+/**
+ * \brief           Unregister global event handler, previously registered with \ref evt_register
+ * \tparam          Fn: Function used on registration
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+template <auto Fn>
+inline lwcellr_t evt_unregister() noexcept;
+
+/**
+ * \brief           Register member function of single object as global event handler
+ *
+ * Object pointer is kept in static storage, one per class and member function pair
+ *
+ * \tparam          T: Class type
+ * \tparam          M: Member function with `lwcellr_t (lwcell_evt_t&)` or `void (lwcell_evt_t&)` signature
+ * \param[in]       obj: Object to call function on. It must outlive registration
+ * \param[in]       mask: Event subscription mask
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+template <typename T, auto M>
+inline lwcellr_t evt_register(T& obj, lwcell_evt_mask_t mask = LWCELL_EVT_MASK_ALL) noexcept;
+
+/**
+ * \brief           Unregister member function, previously registered with \ref evt_register
+ * \tparam          T: Class type
+ * \tparam          M: Member function used on registration
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+template <typename T, auto M>
+inline lwcellr_t evt_unregister() noexcept;
+
+#if !__DOXYGEN__
+namespace detail {
+
+template <auto Fn>
+lwcellr_t
+evt_trampoline(lwcell_evt_t* evt) {
+    if constexpr (std::is_void_v<decltype(Fn(*evt))>) {
+        Fn(*evt);
+        return lwcellOK;
+    } else {
+        return Fn(*evt);
+    }
+}
+
+template <typename T, auto M>
+inline T* evt_obj = nullptr;
+
+template <typename T, auto M>
+lwcellr_t
+evt_member_trampoline(lwcell_evt_t* evt) {
+    T* obj = evt_obj<T, M>;
+    if (obj == nullptr) {
+        return lwcellOK;
+    }
+    if constexpr (std::is_void_v<decltype((obj->*M)(*evt))>) {
+        (obj->*M)(*evt);
+        return lwcellOK;
+    } else {
+        return (obj->*M)(*evt);
+    }
+}
+
+} /* namespace detail */
+
+template <auto Fn>
+inline lwcellr_t
+evt_register(lwcell_evt_mask_t mask) noexcept {
+    return lwcell_evt_register_ex(detail::evt_trampoline<Fn>, mask);
+}
+
+template <auto Fn>
+inline lwcellr_t
+evt_unregister() noexcept {
+    return lwcell_evt_unregister(detail::evt_trampoline<Fn>);
+}
+
+template <typename T, auto M>
+inline lwcellr_t
+evt_register(T& obj, lwcell_evt_mask_t mask) noexcept {
+    detail::evt_obj<T, M> = &obj;
+    return lwcell_evt_register_ex(detail::evt_member_trampoline<T, M>, mask);
+}
+
+template <typename T, auto M>
+inline lwcellr_t
+evt_unregister() noexcept {
+    lwcellr_t res = lwcell_evt_unregister(detail::evt_member_trampoline<T, M>);
+    detail::evt_obj<T, M> = nullptr;
+    return res;
+}
+#endif /* !__DOXYGEN__ */
+
+#if LWCELL_CFG_NETCONN || __DOXYGEN__
+
+/**
+ * \brief           Network connection handle
+ *
+ * Object owns netconn and deletes it on destruction. It can be moved, but not copied
+ */
+class Netconn {
+  public:
+    constexpr Netconn() noexcept : m_nc(nullptr) {}
+
+    /**
+     * \brief           Create new netconn
+     * \note            Check result with `operator bool`, object is empty on allocation failure
+     * \param[in]       type: Netconn type
+     */
+    explicit Netconn(lwcell_netconn_type_t type) noexcept : m_nc(lwcell_netconn_new(type)) {}
+
+    Netconn(const Netconn&) = delete;
+    Netconn& operator=(const Netconn&) = delete;
+
+    Netconn(Netconn&& other) noexcept : m_nc(other.release()) {}
+
+    Netconn&
+    operator=(Netconn&& other) noexcept {
+        if (this != &other) {
+            reset(other.release());
+        }
+        return *this;
+    }
+
+    ~Netconn() { reset(); }
+
+    /**
+     * \brief           Take ownership of existing netconn
+     * \param[in]       nc: Netconn handle
+     * \return          Owning object
+     */
+    static Netconn
+    adopt(lwcell_netconn_p nc) noexcept {
+        Netconn n;
+        n.m_nc = nc;
+        return n;
+    }
+
+    /**
+     * \brief           Give up ownership without deleting netconn
+     * \return          Netconn handle, caller becomes responsible for deleting it
+     */
+    lwcell_netconn_p
+    release() noexcept {
+        lwcell_netconn_p nc = m_nc;
+        m_nc = nullptr;
+        return nc;
+    }
+
+    /**
+     * \brief           Delete current netconn and optionally own new one
+     * \param[in]       nc: New netconn handle to own
+     */
+    void
+    reset(lwcell_netconn_p nc = nullptr) noexcept {
+        if (m_nc != nullptr) {
+            lwcell_netconn_delete(m_nc);
+        }
+        m_nc = nc;
+    }
+
+    lwcell_netconn_p get() const noexcept { return m_nc; }
+    explicit operator bool() const noexcept { return m_nc != nullptr; }
+
+    lwcellr_t connect(const char* host, lwcell_port_t port) noexcept { return lwcell_netconn_connect(m_nc, host, port); }
+    lwcellr_t close() noexcept { return lwcell_netconn_close(m_nc); }
+    bool is_connected() const noexcept { return m_nc != nullptr && lwcell_netconn_is_connected(m_nc); }
+    int8_t conn_num() const noexcept { return lwcell_netconn_getconnnum(m_nc); }
+    void set_receive_timeout(uint32_t timeout) noexcept { lwcell_netconn_set_receive_timeout(m_nc, timeout); }
+
+    /**
+     * \brief           Receive data
+     * \param[out]      pbuf: Received packet buffer, owned by caller
+     * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+     */
+    lwcellr_t
+    receive(Pbuf& pbuf) noexcept {
+        lwcell_pbuf_p p = nullptr;
+        lwcellr_t res = lwcell_netconn_receive(m_nc, &p);
+        pbuf.reset(res == lwcellOK ? p : nullptr);
+        return res;
+    }
+
+    /**
+     * \brief           Write data to TCP connection
+     * \param[in]       data: Data to write
+     * \param[in]       flags: Write flags, see \ref lwcell_netconn_write_ex
+     * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+     */
+    lwcellr_t
+    write(ConstBytes data, uint16_t flags = 0) noexcept {
+        return lwcell_netconn_write_ex(m_nc, data.data(), data.size(), flags);
+    }
+
+    lwcellr_t flush() noexcept { return lwcell_netconn_flush(m_nc); }
+
+    /**
+     * \brief           Send data on UDP connection
+     * \param[in]       data: Data to send
+     * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+     */
+    lwcellr_t
+    send(ConstBytes data) noexcept {
+        return lwcell_netconn_send(m_nc, data.data(), data.size());
+    }
+
+    /**
+     * \brief           Send data on UDP connection to specific address
+     * \param[in]       ip: Remote IP address
+     * \param[in]       port: Remote port
+     * \param[in]       data: Data to send
+     * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+     */
+    lwcellr_t
+    sendto(const lwcell_ip_t& ip, lwcell_port_t port, ConstBytes data) noexcept {
+        return lwcell_netconn_sendto(m_nc, &ip, port, data.data(), data.size());
+    }
+
+#if LWCELL_CFG_CONN_SERVER || __DOXYGEN__
+    lwcellr_t bind(lwcell_port_t port) noexcept { return lwcell_netconn_bind(m_nc, port); }
+    lwcellr_t listen() noexcept { return lwcell_netconn_listen(m_nc); }
+
+    /**
+     * \brief           Accept new client connection
+     * \param[out]      client: Accepted client, owned by caller
+     * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+     */
+    lwcellr_t
+    accept(Netconn& client) noexcept {
+        lwcell_netconn_p nc = nullptr;
+        lwcellr_t res = lwcell_netconn_accept(m_nc, &nc);
+        client.reset(res == lwcellOK ? nc : nullptr);
+        return res;
+    }
+#endif /* LWCELL_CFG_CONN_SERVER || __DOXYGEN__ */
+
+  private:
+    lwcell_netconn_p m_nc;
+};
+
+/**
+ * \brief           Received MQTT message, owned by application
+ *
+ * Object frees message buffer on destruction. It can be moved, but not copied
+ */
+class MqttMessage {
+  public:
+    constexpr MqttMessage() noexcept : m_buf(nullptr) {}
+
+    MqttMessage(const MqttMessage&) = delete;
+    MqttMessage& operator=(const MqttMessage&) = delete;
+
+    MqttMessage(MqttMessage&& other) noexcept : m_buf(other.m_buf) { other.m_buf = nullptr; }
+
+    MqttMessage&
+    operator=(MqttMessage&& other) noexcept {
+        if (this != &other) {
+            reset(other.m_buf);
+            other.m_buf = nullptr;
+        }
+        return *this;
+    }
+
+    ~MqttMessage() { reset(); }
+
+    /**
+     * \brief           Free current buffer and optionally own new one
+     * \param[in]       buf: New buffer to own
+     */
+    void
+    reset(lwcell_mqtt_client_api_buf_p buf = nullptr) noexcept {
+        if (m_buf != nullptr) {
+            lwcell_mqtt_client_api_buf_free(m_buf);
+        }
+        m_buf = buf;
+    }
+
+    explicit operator bool() const noexcept { return m_buf != nullptr; }
+
+    Span<const char>
+    topic() const noexcept {
+        return m_buf != nullptr ? Span<const char>(m_buf->topic, m_buf->topic_len) : Span<const char>();
+    }
+
+    ConstBytes
+    payload() const noexcept {
+        return m_buf != nullptr ? ConstBytes(m_buf->payload, m_buf->payload_len) : ConstBytes();
+    }
+
+    lwcell_mqtt_qos_t qos() const noexcept { return m_buf != nullptr ? m_buf->qos : LWCELL_MQTT_QOS_AT_MOST_ONCE; }
+    bool retain() const noexcept { return m_buf != nullptr && m_buf->retain; }
+
+  private:
+    lwcell_mqtt_client_api_buf_p m_buf;
+};
+
+/**
+ * \brief           Sequential MQTT client, built on top of netconn
+ *
+ * Object owns client and deletes it on destruction. It can be moved, but not copied
+ */
+class MqttClient {
+  public:
+    constexpr MqttClient() noexcept : m_client(nullptr) {}
+
+    /**
+     * \brief           Create new client
+     * \note            Check result with `operator bool`, object is empty on allocation failure
+     * \param[in]       tx_buff_len: Length of raw data output buffer
+     * \param[in]       rx_buff_len: Length of raw data input buffer
+     */
+    MqttClient(size_t tx_buff_len, size_t rx_buff_len) noexcept
+        : m_client(lwcell_mqtt_client_api_new(tx_buff_len, rx_buff_len)) {}
+
+    MqttClient(const MqttClient&) = delete;
+    MqttClient& operator=(const MqttClient&) = delete;
+
+    MqttClient(MqttClient&& other) noexcept : m_client(other.m_client) { other.m_client = nullptr; }
+
+    MqttClient&
+    operator=(MqttClient&& other) noexcept {
+        if (this != &other) {
+            reset();
+            m_client = other.m_client;
+            other.m_client = nullptr;
+        }
+        return *this;
+    }
+
+    ~MqttClient() { reset(); }
+
+    /**
+     * \brief           Delete client
+     */
+    void
+    reset() noexcept {
+        if (m_client != nullptr) {
+            lwcell_mqtt_client_api_delete(m_client);
+            m_client = nullptr;
+        }
+    }
+
+    lwcell_mqtt_client_api_p get() const noexcept { return m_client; }
+    explicit operator bool() const noexcept { return m_client != nullptr; }
+
+    lwcell_mqtt_conn_status_t
+    connect(const char* host, lwcell_port_t port, const lwcell_mqtt_client_info_t& info) noexcept {
+        return lwcell_mqtt_client_api_connect(m_client, host, port, &info);
+    }
+
+    lwcellr_t close() noexcept { return lwcell_mqtt_client_api_close(m_client); }
+    bool is_connected() const noexcept { return m_client != nullptr && lwcell_mqtt_client_api_is_connected(m_client); }
+
+    lwcellr_t
+    subscribe(const char* topic, lwcell_mqtt_qos_t qos) noexcept {
+        return lwcell_mqtt_client_api_subscribe(m_client, topic, qos);
+    }
+
+    lwcellr_t unsubscribe(const char* topic) noexcept { return lwcell_mqtt_client_api_unsubscribe(m_client, topic); }
+
+    /**
+     * \brief           Publish message
+     * \param[in]       topic: Topic to publish on
+     * \param[in]       payload: Message payload
+     * \param[in]       qos: Quality of service
+     * \param[in]       retain: Retain flag
+     * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+     */
+    lwcellr_t
+    publish(const char* topic, ConstBytes payload, lwcell_mqtt_qos_t qos, bool retain = false) noexcept {
+        return lwcell_mqtt_client_api_publish(m_client, topic, payload.data(), payload.size(), qos,
+                                              static_cast<uint8_t>(retain));
+    }
+
+    /**
+     * \brief           Receive message on subscribed topic
+     * \param[out]      msg: Received message, owned by caller
+     * \param[in]       timeout: Maximal time to wait in units of milliseconds, `0` to wait forever
+     * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+     */
+    lwcellr_t
+    receive(MqttMessage& msg, uint32_t timeout = 0) noexcept {
+        lwcell_mqtt_client_api_buf_p buf = nullptr;
+        lwcellr_t res = lwcell_mqtt_client_api_receive(m_client, &buf, timeout);
+        msg.reset(res == lwcellOK ? buf : nullptr);
+        return res;
+    }
+
+  private:
+    lwcell_mqtt_client_api_p m_client;
+};
+
+#endif /* LWCELL_CFG_NETCONN || __DOXYGEN__ */
+
+} /* namespace lwcell */
+
+/**
+ * \}
+ */
+
+#endif /* LWCELL_HPP_HDR_H */
@@ -82,6 +82,10 @@ void* BUF_PREF(buff_get_linear_block_write_address)(BUF_PREF(buff_t) * buff);
 size_t BUF_PREF(buff_get_linear_block_write_length)(BUF_PREF(buff_t) * buff);
 size_t BUF_PREF(buff_advance)(BUF_PREF(buff_t) * buff, size_t len);
 
+/* Vectored access to both linear blocks */
+size_t BUF_PREF(buff_get_read_vec)(BUF_PREF(buff_t) * buff, BUF_PREF(buff_vec_t) vec[2]);
+size_t BUF_PREF(buff_get_write_vec)(BUF_PREF(buff_t) * buff, BUF_PREF(buff_vec_t) vec[2]);
+
 #undef BUF_PREF /* Prefix not needed anymore */
 
 /**
@@ -0,0 +1,72 @@
+/**
+ * \file            lwcell_cell_info.h
+ * \brief           Cell info API
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_CELL_INFO_HDR_H
+#define LWCELL_CELL_INFO_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_CELL_INFO Cell info API
+ * \brief           Serving and neighbour cell measurements
+ * \{
+ *
+ * Engineering mode is enabled with `AT+CENG=2,1` and device then reports serving
+ * and neighbour cells periodically with `+CENG` unsolicited codes.
+ * Every line is parsed in place to single cell table, without memory allocation
+ * or command in producer queue. Serving cell line starts new report.
+ *
+ * Application reads copy of last measurements with \ref lwcell_cell_info_get,
+ * which is suitable for frequent polling as it does not communicate with device.
+ *
+ * \note            Supported on `SIM800` family
+ */
+
+lwcellr_t lwcell_cell_info_enable(uint8_t enable, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                                  const uint32_t blocking);
+lwcellr_t lwcell_cell_info_get(lwcell_cell_info_t* info);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_CELL_INFO_HDR_H */
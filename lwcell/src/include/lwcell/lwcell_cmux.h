@@ -0,0 +1,89 @@
+/**
+ * \file            lwcell_cmux.h
+ * \brief           GSM 07.10 multiplexer
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_CMUX_HDR_H
+#define LWCELL_CMUX_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_CMUX GSM 07.10 multiplexer
+ * \brief           Multiplexer with virtual channels over single AT port
+ * \{
+ *
+ * Multiplexer is started with `AT+CMUX` command in basic option mode.
+ * Stack keeps sending its commands and connection data on channel \ref LWCELL_CMUX_AT_DLCI,
+ * framing is done transparently between AT port and low-level driver.
+ *
+ * Additional channels start from DLCI `2` and are given to application.
+ * Application may use them for management commands, such as `AT+CSQ`,
+ * which are then answered while long data transfer is in progress on stack channel.
+ *
+ * \note            Multiplexer mode ends with device reset or \ref lwcell_cmux_stop
+ */
+
+/**
+ * \brief           DLCI of channel used by the stack
+ */
+#define LWCELL_CMUX_AT_DLCI 1
+
+/**
+ * \brief           Application channel data received callback
+ * \note            Function is called from processing thread with core locked
+ * \param[in]       dlci: Channel DLCI, starting with `2`
+ * \param[in]       data: Received data
+ * \param[in]       len: Length of received data
+ * \param[in]       arg: User argument passed to \ref lwcell_cmux_start
+ */
+typedef void (*lwcell_cmux_rx_fn)(uint8_t dlci, const void* data, size_t len, void* arg);
+
+lwcellr_t lwcell_cmux_start(uint8_t channels, lwcell_cmux_rx_fn rx_fn, void* rx_arg,
+                            const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_cmux_stop(void);
+lwcellr_t lwcell_cmux_channel_send(uint8_t dlci, const void* data, size_t len);
+uint8_t lwcell_cmux_is_active(void);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_CMUX_HDR_H */
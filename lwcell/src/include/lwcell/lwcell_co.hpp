@@ -0,0 +1,692 @@
+/**
+ * \file            lwcell_co.hpp
+ * \brief           C++20 coroutine adapter for non-blocking API
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_CO_HPP_HDR_H
+#define LWCELL_CO_HPP_HDR_H
+
+#if !defined(__cplusplus) || __cplusplus < 202002L
+#error "lwcell_co.hpp requires C++20 or newer"
+#endif /* !defined(__cplusplus) || __cplusplus < 202002L */
+
+#include <coroutine>
+#include "lwcell/lwcell.hpp"
+#include "lwcell/lwcell_mem.h"
+#include "lwcell/lwcell_timeout.h"
+#include "system/lwcell_sys.h"
+
+#if !LWCELL_CFG_OS
+#error "lwcell_co.hpp requires LWCELL_CFG_OS enabled"
+#endif /* !LWCELL_CFG_OS */
+
+/**
+ * \ingroup         LWCELL_CPP
+ * \defgroup        LWCELL_CPP_CO Coroutines
+ * \brief           C++20 awaitable adapter for non-blocking API calls
+ *
+ * Every non-blocking call takes completion callback, which is called from library thread.
+ * Awaitables in this module issue the call with `blocking = 0`, suspend the coroutine
+ * and let completion callback queue it back to \ref lwcell::co::Scheduler.
+ *
+ * Single thread runs \ref lwcell::co::Scheduler::run and resumes all coroutines, one at a time,
+ * hence many concurrent flows need one stack only. Coroutines shall not use blocking calls,
+ * as they would stall every other flow of the same scheduler.
+ *
+ * Coroutine frames are allocated with \ref lwcell_mem_malloc.
+ *
+ * \code{.cpp}
+lwcell::co::Task
+flow(lwcell::co::Scheduler& sched) {
+    lwcell::co::Conn conn;
+    static const char req[] = "GET / HTTP/1.1\r\nHost: example.com\r\n\r\n";
+
+    if (co_await conn.start(LWCELL_CONN_TYPE_TCP, "example.com", 80) != lwcellOK) {
+        co_return;
+    }
+    co_await conn.send(lwcell::ConstBytes(req, sizeof(req) - 1));
+    while (lwcell::Pbuf p = co_await conn.receive()) {
+        // Process data
+    }
+}
+
+// In application thread
+static lwcell::co::Scheduler sched(8);
+sched.spawn(flow(sched));
+sched.spawn(flow(sched));
+sched.run();
+ * \endcode
+ *
+ * \{
+ */
+
+namespace lwcell::co {
+
+class Scheduler;
+
+/**
+ * \brief           Fire-and-forget coroutine, started with \ref Scheduler::spawn
+ *
+ * Coroutine frame is released when coroutine returns.
+ * Task that was never spawned releases the frame in destructor.
+ */
+class Task {
+  public:
+    /**
+     * \brief           Coroutine promise
+     */
+    struct promise_type {
+        Scheduler* sched = nullptr; /*!< Scheduler resuming the coroutine */
+
+        static void*
+        operator new(size_t size) noexcept {
+            return lwcell_mem_malloc(size);
+        }
+
+        static void
+        operator delete(void* ptr) noexcept {
+            lwcell_mem_free(ptr);
+        }
+
+        static Task
+        get_return_object_on_allocation_failure() noexcept {
+            return Task();
+        }
+
+        Task
+        get_return_object() noexcept {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always
+        initial_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_never
+        final_suspend() noexcept {
+            return {};
+        }
+
+        void
+        return_void() noexcept {}
+
+        void
+        unhandled_exception() noexcept {}
+    };
+
+    Task() noexcept : m_h(nullptr) {}
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    Task(Task&& other) noexcept : m_h(other.m_h) { other.m_h = nullptr; }
+
+    Task&
+    operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (m_h) {
+                m_h.destroy();
+            }
+            m_h = other.m_h;
+            other.m_h = nullptr;
+        }
+        return *this;
+    }
+
+    ~Task() {
+        if (m_h) {
+            m_h.destroy();
+        }
+    }
+
+    /**
+     * \brief           Check if coroutine frame was allocated and not yet spawned
+     */
+    explicit
+    operator bool() const noexcept {
+        return static_cast<bool>(m_h);
+    }
+
+  private:
+    friend class Scheduler;
+
+    explicit Task(std::coroutine_handle<promise_type> h) noexcept : m_h(h) {}
+
+    std::coroutine_handle<promise_type> m_h;
+};
+
+/**
+ * \brief           Run queue of coroutines, ready to be resumed
+ *
+ * Completion callbacks queue coroutines from library thread, while \ref run resumes them in caller thread.
+ * Every coroutine has at most one entry in the queue, hence queue length should be at least
+ * number of concurrently spawned tasks, otherwise library thread waits for free slot.
+ */
+class Scheduler {
+  public:
+    /**
+     * \brief           Create scheduler
+     * \param[in]       queue_len: Run queue length, see class description
+     */
+    explicit Scheduler(size_t queue_len) noexcept : m_mbox(LWCELL_SYS_MBOX_NULL) {
+        if (!lwcell_sys_mbox_create(&m_mbox, queue_len)) {
+            m_mbox = LWCELL_SYS_MBOX_NULL;
+        }
+    }
+
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    ~Scheduler() {
+        if (lwcell_sys_mbox_isvalid(&m_mbox)) {
+            lwcell_sys_mbox_delete(&m_mbox);
+        }
+    }
+
+    /**
+     * \brief           Check if run queue was created
+     */
+    explicit
+    operator bool() noexcept {
+        return lwcell_sys_mbox_isvalid(&m_mbox);
+    }
+
+    /**
+     * \brief           Queue coroutine task for first run
+     * \param[in]       task: Task returned by coroutine function
+     * \return          \ref lwcellOK on success, \ref lwcellERRMEM if task frame was not allocated
+     */
+    lwcellr_t
+    spawn(Task&& task) noexcept {
+        if (!task || !*this) {
+            return lwcellERRMEM;
+        }
+        task.m_h.promise().sched = this;
+        post(task.m_h);
+        task.m_h = nullptr;
+        return lwcellOK;
+    }
+
+    /**
+     * \brief           Queue suspended coroutine to be resumed
+     * \note            Called by completion callbacks, from any thread
+     * \param[in]       h: Coroutine handle
+     */
+    void
+    post(std::coroutine_handle<> h) noexcept {
+        lwcell_sys_mbox_put(&m_mbox, h.address());
+    }
+
+    /**
+     * \brief           Resume next ready coroutine
+     * \param[in]       timeout: Maximal time to wait in units of milliseconds, `0` to wait forever
+     * \return          `true` if coroutine was resumed, `false` on timeout
+     */
+    bool
+    run_once(uint32_t timeout = 0) noexcept {
+        void* addr = nullptr;
+
+        if (lwcell_sys_mbox_get(&m_mbox, &addr, timeout) == LWCELL_SYS_TIMEOUT) {
+            return false;
+        }
+        std::coroutine_handle<>::from_address(addr).resume();
+        return true;
+    }
+
+    /**
+     * \brief           Resume coroutines forever
+     */
+    void
+    run() noexcept {
+        for (;;) {
+            run_once(0);
+        }
+    }
+
+  private:
+    lwcell_sys_mbox_t m_mbox;
+};
+
+namespace detail {
+
+/**
+ * \brief           Suspended coroutine, waiting for completion callback
+ */
+struct Waiter {
+    std::coroutine_handle<> h;      /*!< Coroutine to resume */
+    Scheduler* sched = nullptr;     /*!< Scheduler to resume it */
+    lwcellr_t res = lwcellOK;       /*!< Completion result */
+
+    void
+    suspend(std::coroutine_handle<Task::promise_type> coro) noexcept {
+        h = coro;
+        sched = coro.promise().sched;
+    }
+
+    void
+    complete(lwcellr_t r) noexcept {
+        res = r;
+        sched->post(h);
+        h = nullptr;
+    }
+
+    bool
+    pending() const noexcept {
+        return static_cast<bool>(h);
+    }
+};
+
+} /* namespace detail */
+
+/**
+ * \brief           Awaitable for API call with \ref lwcell_api_cmd_evt_fn completion callback
+ * \tparam          F: Callable type, see \ref call
+ */
+template <typename F>
+class CallAwaiter {
+  public:
+    explicit CallAwaiter(F fn) noexcept : m_fn(static_cast<F&&>(fn)) {}
+
+    bool
+    await_ready() const noexcept {
+        return false;
+    }
+
+    bool
+    await_suspend(std::coroutine_handle<Task::promise_type> h) noexcept {
+        lwcellr_t res;
+
+        m_w.suspend(h);
+        if ((res = m_fn(&CallAwaiter::prv_evt_fn, static_cast<void*>(&m_w))) != lwcellOK) {
+            m_w.res = res; /* Command not queued, callback will not be called */
+            return false;
+        }
+        return true;
+    }
+
+    lwcellr_t
+    await_resume() const noexcept {
+        return m_w.res;
+    }
+
+  private:
+    static void
+    prv_evt_fn(lwcellr_t res, void* arg) {
+        static_cast<detail::Waiter*>(arg)->complete(res);
+    }
+
+    F m_fn;
+    detail::Waiter m_w;
+};
+
+/**
+ * \brief           Await any API function with `evt_fn` and `evt_arg` parameters
+ *
+ * \code{.cpp}
+lwcellr_t res = co_await lwcell::co::call([&](lwcell_api_cmd_evt_fn fn, void* arg) {
+    return lwcell_network_attach(apn, user, pass, fn, arg, 0);
+});
+ * \endcode
+ *
+ * \param[in]       fn: Callable, issuing non-blocking call with passed `evt_fn` and `evt_arg`
+ * \return          Awaitable, resulting in command \ref lwcellr_t result
+ */
+template <typename F>
+CallAwaiter<F>
+call(F fn) noexcept {
+    return CallAwaiter<F>(static_cast<F&&>(fn));
+}
+
+/**
+ * \brief           Awaitable timer, based on \ref lwcell_timeout_add
+ */
+class DelayAwaiter {
+  public:
+    explicit DelayAwaiter(uint32_t ms) noexcept : m_ms(ms) {}
+
+    bool
+    await_ready() const noexcept {
+        return false;
+    }
+
+    bool
+    await_suspend(std::coroutine_handle<Task::promise_type> h) noexcept {
+        lwcellr_t res;
+
+        m_w.suspend(h);
+        if ((res = lwcell_timeout_add(m_ms, &DelayAwaiter::prv_timeout_fn, static_cast<void*>(&m_w))) != lwcellOK) {
+            m_w.res = res;
+            return false;
+        }
+        return true;
+    }
+
+    lwcellr_t
+    await_resume() const noexcept {
+        return m_w.res;
+    }
+
+  private:
+    static void
+    prv_timeout_fn(void* arg) {
+        static_cast<detail::Waiter*>(arg)->complete(lwcellOK);
+    }
+
+    uint32_t m_ms;
+    detail::Waiter m_w;
+};
+
+/**
+ * \brief           Suspend coroutine for specific time, without blocking scheduler
+ * \param[in]       ms: Time in units of milliseconds
+ * \return          Awaitable, resulting in \ref lwcellOK or error if timeout could not be added
+ */
+inline DelayAwaiter
+delay(uint32_t ms) noexcept {
+    return DelayAwaiter(ms);
+}
+
+#if LWCELL_CFG_CONN || __DOXYGEN__
+
+/**
+ * \brief           Connection driven by coroutine
+ *
+ * Object owns connection callback and routes its events to awaiting coroutine.
+ * Connection functions do not take completion callback, as their completion is reported
+ * with connection events, hence awaitables are members of this class.
+ *
+ * Object shall live in coroutine frame and only one send-type operation
+ * (start, send, close) may be awaited at a time. Receive may be awaited concurrently.
+ * Destroying object with active connection closes it in non-blocking way.
+ */
+class Conn {
+  public:
+    Conn() noexcept : m_conn(nullptr), m_rx(nullptr), m_sent(0) {}
+
+    Conn(const Conn&) = delete;
+    Conn& operator=(const Conn&) = delete;
+
+    ~Conn() {
+        lwcell_conn_p conn;
+
+        lwcell_core_lock();
+        if ((conn = m_conn) != nullptr) {
+            lwcell_conn_set_arg(conn, nullptr); /* Detach events from this object */
+            m_conn = nullptr;
+        }
+        if (m_rx != nullptr) {
+            lwcell_pbuf_free_s(&m_rx);
+        }
+        lwcell_core_unlock();
+        if (conn != nullptr) {
+            lwcell_conn_close(conn, 0);
+        }
+    }
+
+    /**
+     * \brief           Get raw connection handle
+     * \return          Connection handle or `NULL` when not connected
+     */
+    lwcell_conn_p
+    get() const noexcept {
+        return m_conn;
+    }
+
+    /**
+     * \brief           Check if connection is active
+     */
+    bool
+    is_connected() const noexcept {
+        return m_conn != nullptr;
+    }
+
+    /**
+     * \brief           Number of bytes sent by last completed send operation
+     */
+    size_t
+    sent() const noexcept {
+        return m_sent;
+    }
+
+    /**
+     * \brief           Awaitable for start, send and close operations
+     * \tparam          F: Callable issuing non-blocking call
+     */
+    template <typename F>
+    class OpAwaiter {
+      public:
+        OpAwaiter(Conn& conn, F fn) noexcept : m_c(conn), m_fn(static_cast<F&&>(fn)) {}
+
+        bool
+        await_ready() const noexcept {
+            return false;
+        }
+
+        bool
+        await_suspend(std::coroutine_handle<Task::promise_type> h) noexcept {
+            lwcellr_t res;
+
+            lwcell_core_lock(); /* Completion event cannot arrive before waiter is set */
+            m_c.m_op.suspend(h);
+            if ((res = m_fn()) != lwcellOK) {
+                m_c.m_op.h = nullptr;
+                m_c.m_op.res = res;
+            }
+            lwcell_core_unlock();
+            return res == lwcellOK;
+        }
+
+        lwcellr_t
+        await_resume() const noexcept {
+            return m_c.m_op.res;
+        }
+
+      private:
+        Conn& m_c;
+        F m_fn;
+    };
+
+    /**
+     * \brief           Start client connection
+     * \param[in]       type: Connection type
+     * \param[in]       host: Host name or IP address, shall be valid until operation completes
+     * \param[in]       port: Remote port
+     * \return          Awaitable, resulting in \ref lwcellOK when connection is active
+     */
+    auto
+    start(lwcell_conn_type_t type, const char* host, lwcell_port_t port) noexcept {
+        return OpAwaiter(*this, [this, type, host, port]() {
+            return m_conn != nullptr ? lwcellERR
+                                     : lwcell_conn_start(nullptr, type, host, port, this, &Conn::prv_evt_fn, 0);
+        });
+    }
+
+    /**
+     * \brief           Send data on active connection
+     * \param[in]       data: Data to send, shall be valid until operation completes
+     * \return          Awaitable, resulting in send result. Sent length is available with \ref sent
+     */
+    auto
+    send(ConstBytes data) noexcept {
+        return OpAwaiter(*this, [this, data]() {
+            m_sent = 0;
+            return m_conn == nullptr ? lwcellCLOSED : lwcell_conn_send(m_conn, data.data(), data.size(), nullptr, 0);
+        });
+    }
+
+    /**
+     * \brief           Close active connection
+     * \return          Awaitable, resulting in close result
+     */
+    auto
+    close() noexcept {
+        return OpAwaiter(*this, [this]() { return m_conn == nullptr ? lwcellCLOSED : lwcell_conn_close(m_conn, 0); });
+    }
+
+    /**
+     * \brief           Awaitable for received data
+     */
+    class RecvAwaiter {
+      public:
+        explicit RecvAwaiter(Conn& conn) noexcept : m_c(conn) {}
+
+        bool
+        await_ready() const noexcept {
+            return false;
+        }
+
+        bool
+        await_suspend(std::coroutine_handle<Task::promise_type> h) noexcept {
+            bool wait;
+
+            lwcell_core_lock();
+            if ((wait = m_c.m_rx == nullptr && m_c.m_conn != nullptr)) {
+                m_c.m_rx_w.suspend(h);
+            }
+            lwcell_core_unlock();
+            return wait;
+        }
+
+        Pbuf
+        await_resume() noexcept {
+            lwcell_pbuf_p p;
+            lwcell_conn_p conn;
+
+            lwcell_core_lock();
+            p = m_c.m_rx;
+            conn = m_c.m_conn;
+            m_c.m_rx = nullptr;
+            lwcell_core_unlock();
+            if (p != nullptr && conn != nullptr) {
+                lwcell_conn_recved(conn, p); /* Return receive credit in manual receive mode */
+            }
+            return Pbuf::adopt(p);
+        }
+
+      private:
+        Conn& m_c;
+    };
+
+    /**
+     * \brief           Receive data, queued since last receive
+     * \return          Awaitable, resulting in packet buffer chain.
+     *                  Empty packet buffer is returned when connection is closed
+     */
+    RecvAwaiter
+    receive() noexcept {
+        return RecvAwaiter(*this);
+    }
+
+  private:
+    /**
+     * \brief           Connection callback, called from library thread with core locked
+     */
+    static lwcellr_t
+    prv_evt_fn(lwcell_evt_t* evt) {
+        lwcell_conn_p conn = lwcell_conn_get_from_evt(evt);
+        Conn* self;
+
+        if (lwcell_evt_get_type(evt) == LWCELL_EVT_CONN_ERROR) {
+            self = static_cast<Conn*>(lwcell_evt_conn_error_get_arg(evt));
+        } else {
+            self = conn != nullptr ? static_cast<Conn*>(lwcell_conn_get_arg(conn)) : nullptr;
+        }
+        if (self == nullptr) {
+            return lwcellOK;
+        }
+        switch (lwcell_evt_get_type(evt)) {
+            case LWCELL_EVT_CONN_ACTIVE: {
+                self->m_conn = conn;
+                self->prv_op_complete(lwcellOK);
+                break;
+            }
+            case LWCELL_EVT_CONN_ERROR: {
+                self->prv_op_complete(lwcell_evt_conn_error_get_error(evt));
+                break;
+            }
+            case LWCELL_EVT_CONN_SEND: {
+                self->m_sent = lwcell_evt_conn_send_get_length(evt);
+                self->prv_op_complete(lwcell_evt_conn_send_get_result(evt));
+                break;
+            }
+            case LWCELL_EVT_CONN_RECV: {
+                lwcell_pbuf_p p = lwcell_evt_conn_recv_get_buff(evt);
+
+                if (lwcell_pbuf_ref(p) == lwcellOK) { /* Library frees its reference after callback */
+                    if (self->m_rx == nullptr) {
+                        self->m_rx = p;
+                    } else {
+                        lwcell_pbuf_cat(self->m_rx, p);
+                    }
+                }
+                if (self->m_rx_w.pending()) {
+                    self->m_rx_w.complete(lwcellOK);
+                }
+                break;
+            }
+            case LWCELL_EVT_CONN_CLOSE: {
+                self->m_conn = nullptr;
+                self->prv_op_complete(lwcell_evt_conn_close_is_forced(evt) ? lwcell_evt_conn_close_get_result(evt)
+                                                                           : lwcellCLOSED);
+                if (self->m_rx_w.pending()) {
+                    self->m_rx_w.complete(lwcellCLOSED);
+                }
+                break;
+            }
+            default: break;
+        }
+        return lwcellOK;
+    }
+
+    void
+    prv_op_complete(lwcellr_t res) noexcept {
+        if (m_op.pending()) {
+            m_op.complete(res);
+        }
+    }
+
+    lwcell_conn_p m_conn;
+    lwcell_pbuf_p m_rx;
+    size_t m_sent;
+    detail::Waiter m_op;
+    detail::Waiter m_rx_w;
+};
+
+#endif /* LWCELL_CFG_CONN || __DOXYGEN__ */
+
+} /* namespace lwcell::co */
+
+/**
+ * \}
+ */
+
+#endif /* LWCELL_CO_HPP_HDR_H */
@@ -0,0 +1,118 @@
+/**
+ * \file            lwcell_compress.h
+ * \brief           Payload compression
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_COMPRESS_HDR_H
+#define LWCELL_COMPRESS_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_COMPRESS Payload compression
+ * \brief           Constant memory LZ77 compression of application payload
+ * \{
+ *
+ * Data is split to blocks of up to \ref LWCELL_CFG_COMPRESS_BLOCK_LEN bytes.
+ * Each block is compressed independently and sent as frame with `2` bytes header in big-endian order:
+ * bit `15` is set when payload is compressed, bits `0..14` hold payload length.
+ * Block which does not compress is sent as raw payload, frame is never longer than block plus header.
+ *
+ * Compressed payload is sequence of tokens. High nibble of token is literal length and low nibble
+ * is match length minus `4`, value `15` continues with bytes added to length until byte is not `255`.
+ * Literals follow, then `2` bytes little-endian match offset and match length continuation.
+ * Last token has literals only.
+ *
+ * Compressor and decompressor state is owned by application, no memory is allocated.
+ * Functions are not thread safe, each thread shall use its own state.
+ */
+
+/**
+ * \brief           Length of frame header in units of bytes
+ */
+#define LWCELL_COMPRESS_FRAME_HDR_LEN 2
+
+/**
+ * \brief           Maximal frame length in units of bytes
+ */
+#define LWCELL_COMPRESS_FRAME_MAX_LEN (LWCELL_COMPRESS_FRAME_HDR_LEN + LWCELL_CFG_COMPRESS_BLOCK_LEN)
+
+/**
+ * \brief           Compressor state
+ */
+typedef struct {
+    uint16_t hash[1U << LWCELL_CFG_COMPRESS_HASH_BITS]; /*!< Match positions plus `1`, `0` for empty entry */
+    uint8_t frame[LWCELL_COMPRESS_FRAME_MAX_LEN];       /*!< Output frame of last compressed block */
+} lwcell_compress_t;
+
+/**
+ * \brief           Decompressed block callback function
+ * \param[in]       data: Decompressed data
+ * \param[in]       len: Length of data in units of bytes
+ * \param[in]       arg: Custom user argument
+ * \return          \ref lwcellOK to continue, member of \ref lwcellr_t enumeration to stop decompression
+ */
+typedef lwcellr_t (*lwcell_decompress_fn)(const void* data, size_t len, void* arg);
+
+/**
+ * \brief           Stream decompressor state
+ */
+typedef struct {
+    uint8_t frame[LWCELL_COMPRESS_FRAME_MAX_LEN]; /*!< Received part of current frame */
+    size_t frame_len;                             /*!< Number of valid bytes in frame buffer */
+    uint8_t block[LWCELL_CFG_COMPRESS_BLOCK_LEN]; /*!< Decompressed block */
+} lwcell_decompress_t;
+
+size_t lwcell_compress_block(lwcell_compress_t* comp, const void* data, size_t len, void* out, size_t out_size);
+size_t lwcell_decompress_block(const void* data, size_t len, void* out, size_t out_size);
+size_t lwcell_compress_frame(lwcell_compress_t* comp, const void* data, size_t len);
+size_t lwcell_decompress_frame(const void* frame, size_t frame_len, void* out, size_t out_size);
+
+void lwcell_decompress_init(lwcell_decompress_t* dec);
+lwcellr_t lwcell_decompress_feed(lwcell_decompress_t* dec, const void* data, size_t len, lwcell_decompress_fn fn,
+                                 void* arg);
+lwcellr_t lwcell_decompress_feed_pbuf(lwcell_decompress_t* dec, lwcell_pbuf_p pbuf, lwcell_decompress_fn fn,
+                                      void* arg);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_COMPRESS_HDR_H */
@@ -49,11 +49,59 @@ extern "C" {
 
 lwcellr_t lwcell_conn_start(lwcell_conn_p* conn, lwcell_conn_type_t type, const char* const host, lwcell_port_t port,
                           void* const arg, lwcell_evt_fn conn_evt_fn, const uint32_t blocking);
+#if LWCELL_CFG_NETWORK_CONTEXTS > 1 || __DOXYGEN__
+lwcellr_t lwcell_conn_start_ctx(lwcell_conn_p* conn, uint8_t ctx, lwcell_conn_type_t type, const char* const host,
+                                lwcell_port_t port, void* const arg, lwcell_evt_fn conn_evt_fn,
+                                const uint32_t blocking);
+uint8_t lwcell_conn_get_ctx(lwcell_conn_p conn);
+#endif /* LWCELL_CFG_NETWORK_CONTEXTS > 1 || __DOXYGEN__ */
 lwcellr_t lwcell_conn_close(lwcell_conn_p conn, const uint32_t blocking);
+#if LWCELL_CFG_CONN_SERVER || __DOXYGEN__
+lwcellr_t lwcell_conn_set_server(uint8_t en, lwcell_port_t port, lwcell_evt_fn server_evt_fn,
+                                 const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+#endif /* LWCELL_CFG_CONN_SERVER || __DOXYGEN__ */
 lwcellr_t lwcell_conn_send(lwcell_conn_p conn, const void* data, size_t btw, size_t* const bw, const uint32_t blocking);
+lwcellr_t lwcell_conn_send_owned(lwcell_conn_p conn, void* data, size_t btw, size_t* const bw, const uint32_t blocking);
 lwcellr_t lwcell_conn_sendto(lwcell_conn_p conn, const lwcell_ip_t* const ip, lwcell_port_t port, const void* data,
                            size_t btw, size_t* bw, const uint32_t blocking);
+lwcellr_t lwcell_conn_sendto_batch(lwcell_conn_p conn, const lwcell_ip_t* const ip, lwcell_port_t port,
+                                   const lwcell_conn_iovec_t* dgrams, size_t cnt, size_t* const bw,
+                                   const uint32_t blocking);
+lwcellr_t lwcell_conn_sendv(lwcell_conn_p conn, const lwcell_conn_iovec_t* iov, size_t iovcnt, size_t* const bw,
+                          const uint32_t blocking);
+lwcellr_t lwcell_conn_send_pbuf(lwcell_conn_p conn, lwcell_pbuf_p pbuf, size_t* const bw, const uint32_t blocking);
 lwcellr_t lwcell_conn_set_arg(lwcell_conn_p conn, void* const arg);
+lwcellr_t lwcell_conn_set_poll_interval(lwcell_conn_p conn, uint32_t interval);
+#if LWCELL_CFG_CONN_RECV_FN || __DOXYGEN__
+lwcellr_t lwcell_conn_set_recv_fn(lwcell_conn_p conn, lwcell_conn_recv_fn recv_fn);
+#if LWCELL_CFG_CONN_RECV_BATCH > 0 || __DOXYGEN__
+lwcellr_t lwcell_conn_set_recv_batch_fn(lwcell_conn_p conn, lwcell_conn_recv_batch_fn recv_batch_fn);
+#endif /* LWCELL_CFG_CONN_RECV_BATCH > 0 || __DOXYGEN__ */
+#endif /* LWCELL_CFG_CONN_RECV_FN || __DOXYGEN__ */
+#if LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__
+size_t lwcell_conn_get_rx_pending(lwcell_conn_p conn);
+lwcellr_t lwcell_conn_query_rx_pending(lwcell_conn_p conn, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                                       const uint32_t blocking);
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__ */
+#if LWCELL_CFG_CONN_SEND_FAIR || __DOXYGEN__
+lwcellr_t lwcell_conn_set_send_weight(lwcell_conn_p conn, uint8_t weight);
+#endif /* LWCELL_CFG_CONN_SEND_FAIR || __DOXYGEN__ */
+#if LWCELL_CFG_CONN_TX_WINDOW > 0 || __DOXYGEN__
+lwcellr_t lwcell_conn_set_tx_deferred(lwcell_conn_p conn, uint8_t deferred);
+lwcellr_t lwcell_conn_tx_window_open(void);
+#endif /* LWCELL_CFG_CONN_TX_WINDOW > 0 || __DOXYGEN__ */
+#if LWCELL_CFG_CONN_SEND_DEADLINE || __DOXYGEN__
+lwcellr_t lwcell_conn_send_deadline(lwcell_conn_p conn, const void* data, size_t btw, size_t* const bw,
+                                    uint32_t deadline_ms, lwcell_conn_send_id_t* const id, const uint32_t blocking);
+lwcellr_t lwcell_conn_send_cancel(lwcell_conn_send_id_t id);
+#endif /* LWCELL_CFG_CONN_SEND_DEADLINE || __DOXYGEN__ */
+#if LWCELL_CFG_CONN_SEND_STREAM || __DOXYGEN__
+lwcellr_t lwcell_conn_send_stream(lwcell_conn_p conn, lwcell_conn_read_fn read_fn, void* arg, size_t total_len,
+                                  size_t* const bw, const uint32_t blocking);
+#endif /* LWCELL_CFG_CONN_SEND_STREAM || __DOXYGEN__ */
+#if LWCELL_CFG_CONN_SEND_ADAPT || __DOXYGEN__
+lwcellr_t lwcell_conn_get_send_stats(lwcell_conn_p conn, lwcell_conn_send_stats_t* stats);
+#endif /* LWCELL_CFG_CONN_SEND_ADAPT || __DOXYGEN__ */
 void* lwcell_conn_get_arg(lwcell_conn_p conn);
 uint8_t lwcell_conn_is_client(lwcell_conn_p conn);
 uint8_t lwcell_conn_is_active(lwcell_conn_p conn);
@@ -68,6 +116,7 @@ size_t lwcell_conn_get_total_recved_count(lwcell_conn_p conn);
 uint8_t lwcell_conn_get_remote_ip(lwcell_conn_p conn, lwcell_ip_t* ip);
 lwcell_port_t lwcell_conn_get_remote_port(lwcell_conn_p conn);
 lwcell_port_t lwcell_conn_get_local_port(lwcell_conn_p conn);
+lwcell_conn_state_t lwcell_conn_get_state(lwcell_conn_p conn);
 
 /**
  * \}
@@ -0,0 +1,125 @@
+/**
+ * \file            lwcell_cq.h
+ * \brief           Batch command submission with completion queue
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_CQ_HDR_H
+#define LWCELL_CQ_HDR_H
+
+#include "lwcell/lwcell_types.h"
+#include "system/lwcell_sys.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_CQ Completion queue
+ * \brief           Batch command submission with completion queue
+ * \{
+ *
+ * Non-blocking API calls, made between \ref lwcell_cq_begin and \ref lwcell_cq_submit,
+ * are not put to producer queue one by one. Their messages are linked to one batch instead,
+ * which is put to producer queue with single call and executed back to back by producer thread.
+ *
+ * Result of every command is written to completion ring, provided by application,
+ * together with user data set by \ref lwcell_cq_set_data before the call.
+ * One semaphore per completion queue replaces semaphore or callback per command.
+ *
+ * \code{.c}
+lwcell_cq_t cq;
+lwcell_cqe_t ring[8], cqe;
+int16_t rssi;
+
+lwcell_cq_init(&cq, ring, LWCELL_ARRAYSIZE(ring));
+
+lwcell_cq_begin(&cq);
+lwcell_cq_set_data(&cq, "send");
+lwcell_conn_send(conn, data, len, NULL, 0);
+lwcell_cq_set_data(&cq, "rssi");
+lwcell_network_rssi(&rssi, NULL, NULL, 0);
+lwcell_cq_submit(&cq, NULL);
+
+while (lwcell_cq_wait(&cq, &cqe, 1000) == lwcellOK) {
+    printf("%s: %d\r\n", (const char*)cqe.data, (int)cqe.res);
+}
+ * \endcode
+ *
+ * \note            Core is locked from \ref lwcell_cq_begin until \ref lwcell_cq_submit,
+ *                  hence API calls in between shall be short and non-blocking.
+ *                  Batch is executed in order and is not interleaved with other commands,
+ *                  including data path commands from priority lane
+ */
+
+/**
+ * \brief           Completion queue entry
+ */
+typedef struct {
+    void* data;    /*!< User data, set with \ref lwcell_cq_set_data before command was added */
+    lwcellr_t res; /*!< Command result */
+} lwcell_cqe_t;
+
+/**
+ * \brief           Completion queue
+ * \note            Structure members are private and shall not be accessed by application
+ */
+typedef struct lwcell_cq {
+    lwcell_cqe_t* ring;        /*!< Completion ring, provided by application */
+    size_t size;               /*!< Number of entries in completion ring */
+    size_t w;                  /*!< Write index, advanced when command completes */
+    size_t r;                  /*!< Read index, advanced when application takes entry */
+    size_t ready;              /*!< Number of completed entries not yet taken */
+    size_t inflight;           /*!< Number of added commands whose entry was not yet taken */
+    struct lwcell_msg* first;  /*!< First message of batch being built */
+    struct lwcell_msg* last;   /*!< Last message of batch being built */
+    size_t cnt;                /*!< Number of messages in batch being built */
+    void* data;                /*!< User data for next added command */
+    lwcell_sys_sem_t sem;      /*!< Semaphore released on every new completion */
+} lwcell_cq_t;
+
+lwcellr_t lwcell_cq_init(lwcell_cq_t* cq, lwcell_cqe_t* ring, size_t size);
+lwcellr_t lwcell_cq_deinit(lwcell_cq_t* cq);
+lwcellr_t lwcell_cq_begin(lwcell_cq_t* cq);
+lwcellr_t lwcell_cq_set_data(lwcell_cq_t* cq, void* data);
+lwcellr_t lwcell_cq_submit(lwcell_cq_t* cq, size_t* cnt);
+uint8_t lwcell_cq_get(lwcell_cq_t* cq, lwcell_cqe_t* cqe);
+lwcellr_t lwcell_cq_wait(lwcell_cq_t* cq, lwcell_cqe_t* cqe, uint32_t timeout);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_CQ_HDR_H */
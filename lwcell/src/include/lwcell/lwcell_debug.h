@@ -34,6 +34,8 @@
 #ifndef LWCELL_DEBUG_HDR_H
 #define LWCELL_DEBUG_HDR_H
 
+#include <stddef.h>
+#include <stdint.h>
 #include "lwcell/lwcell_opt.h"
 
 #ifdef __cplusplus
@@ -52,6 +54,44 @@ extern "C" {
 #endif
 
 #if (LWCELL_CFG_DBG && defined(LWCELL_CFG_DBG_OUT)) || __DOXYGEN__
+
+#if LWCELL_CFG_DBG_DEFERRED || __DOXYGEN__
+/**
+ * \brief           Output function used by debug macros
+ *
+ * Records format and arguments to deferred ring buffer when \ref LWCELL_CFG_DBG_DEFERRED is enabled,
+ * or calls \ref LWCELL_CFG_DBG_OUT directly otherwise
+ */
+#define LWCELL_DEBUG_OUT(fmt, ...) lwcelli_debug_deferred_record(fmt, ##__VA_ARGS__)
+#else
+#define LWCELL_DEBUG_OUT(fmt, ...) LWCELL_CFG_DBG_OUT(fmt, ##__VA_ARGS__)
+#endif /* LWCELL_CFG_DBG_DEFERRED || __DOXYGEN__ */
+
+#if LWCELL_CFG_DBG_RUNTIME || __DOXYGEN__
+/*
+ * Runtime mask has one bit for every combination of debug types and level in condition:
+ * bits `[3:2]` of bit index are type bits, `[1:0]` are level.
+ * Bit of message condition is constant, so runtime check is single test of global mask
+ */
+#define LWCELL_DEBUG_RT_BIT(c) (1U << ((((c) >> 3) & 0x0C) | ((c) & LWCELL_DBG_LVL_MASK)))
+
+/**
+ * \brief           Get runtime mask for debug types and minimal level
+ * \param[in]       types: Enabled debug types, check \ref LWCELL_DBG_TYPE
+ * \param[in]       lvl: Minimal debug level, check \ref LWCELL_DBG_LVL
+ */
+#define LWCELL_DEBUG_RT_MASK(types, lvl)                                                                               \
+    (((((types) & LWCELL_DBG_TYPE_STATE) ? 0x00F0U : 0) | (((types) & LWCELL_DBG_TYPE_TRACE) ? 0x0F00U : 0)           \
+      | (((types) & LWCELL_DBG_TYPE_ALL) ? 0xF000U : 0))                                                               \
+     & (0x1111U * ((0x0FU << ((lvl) & LWCELL_DBG_LVL_MASK)) & 0x0FU)))
+
+extern uint16_t lwcelli_debug_mask;
+
+#define LWCELL_DEBUG_RT_ON(c) (lwcelli_debug_mask & LWCELL_DEBUG_RT_BIT(c))
+#else
+#define LWCELL_DEBUG_RT_ON(c) 1
+#endif /* LWCELL_CFG_DBG_RUNTIME || __DOXYGEN__ */
+
 /**
  * \brief           Print message to the debug "window" if enabled
  * \param[in]       c: Condition if debug of specific type is enabled
@@ -61,8 +101,9 @@ extern "C" {
 #define LWCELL_DEBUGF(c, fmt, ...)                                                                                      \
     do {                                                                                                               \
         if (((c) & (LWCELL_DBG_ON)) && ((c) & (LWCELL_CFG_DBG_TYPES_ON))                                                 \
-            && ((c)&LWCELL_DBG_LVL_MASK) >= (LWCELL_CFG_DBG_LVL_MIN)) {                                                  \
-            LWCELL_CFG_DBG_OUT(fmt, ##__VA_ARGS__);                                                                     \
+            && ((c)&LWCELL_DBG_LVL_MASK) >= (LWCELL_CFG_DBG_LVL_MIN)                                                    \
+            && LWCELL_DEBUG_RT_ON(c)) {                                                                                 \
+            LWCELL_DEBUG_OUT(fmt, ##__VA_ARGS__);                                                                       \
         }                                                                                                              \
     } while (0)
 
@@ -86,6 +127,34 @@ extern "C" {
 #define LWCELL_DEBUGW(c, cond, fmt, ...)
 #endif /* (LWCELL_CFG_DBG && defined(LWCELL_CFG_DBG_OUT)) || __DOXYGEN__ */
 
+#if (LWCELL_CFG_DBG && LWCELL_CFG_DBG_RUNTIME) || __DOXYGEN__
+
+void lwcell_debug_set_mask(uint8_t types, uint8_t lvl_min);
+void lwcell_debug_get_mask(uint8_t* types, uint8_t* lvl_min);
+
+#endif /* (LWCELL_CFG_DBG && LWCELL_CFG_DBG_RUNTIME) || __DOXYGEN__ */
+
+#if (LWCELL_CFG_DBG && LWCELL_CFG_DBG_DEFERRED) || __DOXYGEN__
+
+/**
+ * Deferred record layout in ring buffer, as exported with \ref lwcell_debug_deferred_read,
+ * all fields in native byte order and without padding:
+ *
+ *  - `uint16_t`: Total record length in units of bytes, including this field
+ *  - `const char*`: Format string address, used as format identifier on the host
+ *  - Arguments, in order of conversion specifiers in format string.
+ *      Integers, pointers and doubles are stored with their native (promoted) size,
+ *      strings are stored as `uint8_t` length followed by characters (no terminator)
+ */
+
+void lwcelli_debug_deferred_record(const char* fmt, ...);
+uint8_t lwcelli_debug_deferred_init(void);
+size_t lwcell_debug_deferred_flush(size_t max_records);
+size_t lwcell_debug_deferred_read(void* data, size_t len);
+uint32_t lwcell_debug_deferred_get_dropped(void);
+
+#endif /* (LWCELL_CFG_DBG && LWCELL_CFG_DBG_DEFERRED) || __DOXYGEN__ */
+
 /**
  * \}
  */
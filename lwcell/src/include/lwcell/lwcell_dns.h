@@ -0,0 +1,77 @@
+/**
+ * \file            lwcell_dns.h
+ * \brief           DNS API
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_DNS_HDR_H
+#define LWCELL_DNS_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_DNS DNS API
+ * \brief           Host name resolver with address cache
+ * \{
+ *
+ * Host names are resolved by device with `AT+CDNSGIP` command.
+ * Resolved addresses are kept in cache of \ref LWCELL_CFG_DNS_CACHE_SIZE entries
+ * for \ref LWCELL_CFG_DNS_CACHE_TTL milliseconds, least recently used entry is replaced first.
+ *
+ * When host used by \ref lwcell_conn_start is in cache, its address is passed to `AT+CIPSTART`
+ * and device does not resolve name again. If connection fails, next address of the same host is used
+ * on next attempt. When all addresses have failed, entry is removed and host name is used again.
+ *
+ * Lookups are independent from connections. They may be queued for several hosts ahead of
+ * connection burst, so that every \ref lwcell_conn_start sends IP address literal to device.
+ *
+ * \note            Device does not report record TTL, cache lifetime is fixed by configuration
+ */
+
+lwcellr_t lwcell_dns_gethostbyname(const char* host, lwcell_ip_t* ip, const lwcell_api_cmd_evt_fn evt_fn,
+                                   void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_dns_set_servers(const lwcell_ip_t* primary, const lwcell_ip_t* secondary,
+                                 const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_dns_cache_flush(void);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_DNS_HDR_H */
@@ -48,6 +48,9 @@ extern "C" {
  */
 
 lwcellr_t lwcell_evt_register(lwcell_evt_fn fn);
+lwcellr_t lwcell_evt_register_ex(lwcell_evt_fn fn, lwcell_evt_mask_t mask);
+lwcellr_t lwcell_evt_set_mask(lwcell_evt_fn fn, lwcell_evt_mask_t mask);
+lwcellr_t lwcell_evt_set_deferred(lwcell_evt_fn fn, uint8_t deferred);
 lwcellr_t lwcell_evt_unregister(lwcell_evt_fn fn);
 lwcell_evt_type_t lwcell_evt_get_type(lwcell_evt_t* cc);
 
@@ -154,6 +157,38 @@ lwcell_conn_p lwcell_evt_conn_poll_get_conn(lwcell_evt_t* cc);
  * \}
  */
 
+/**
+ * \anchor          LWCELL_EVT_CONN_STATUS_CHANGED
+ * \name            Connection status changed
+ * \brief           Event helper functions for \ref LWCELL_EVT_CONN_STATUS_CHANGED event
+ */
+
+lwcell_conn_p lwcell_evt_conn_status_changed_get_conn(lwcell_evt_t* cc);
+uint8_t lwcell_evt_conn_status_changed_get_flags(lwcell_evt_t* cc);
+lwcell_conn_state_t lwcell_evt_conn_status_changed_get_state(lwcell_evt_t* cc);
+lwcell_conn_state_t lwcell_evt_conn_status_changed_get_prev_state(lwcell_evt_t* cc);
+
+/**
+ * \}
+ */
+
+#if LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__
+
+/**
+ * \anchor          LWCELL_EVT_CONN_RX_PENDING
+ * \name            Connection data waiting in device
+ * \brief           Event helper functions for \ref LWCELL_EVT_CONN_RX_PENDING event
+ */
+
+lwcell_conn_p lwcell_evt_conn_rx_pending_get_conn(lwcell_evt_t* cc);
+size_t lwcell_evt_conn_rx_pending_get_length(lwcell_evt_t* cc);
+
+/**
+ * \}
+ */
+
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__ */
+
 /**
  * \anchor          LWCELL_EVT_CONN_ERROR
  * \name            Connection error
@@ -178,6 +213,18 @@ void* lwcell_evt_conn_error_get_arg(lwcell_evt_t* cc);
 
 int16_t lwcell_evt_signal_strength_get_rssi(lwcell_evt_t* cc);
 
+/**
+ * \}
+ */
+
+/**
+ * \anchor          LWCELL_EVT_MEM_POOL_EMPTY
+ * \name            Static pool empty
+ * \brief           Event helper functions for \ref LWCELL_EVT_MEM_POOL_EMPTY event
+ */
+
+size_t lwcell_evt_mem_pool_empty_get_size(lwcell_evt_t* cc);
+
 /**
  * \}
  */
@@ -190,6 +237,9 @@ int16_t lwcell_evt_signal_strength_get_rssi(lwcell_evt_t* cc);
 
 size_t lwcell_evt_sms_recv_get_pos(lwcell_evt_t* cc);
 lwcell_mem_t lwcell_evt_sms_recv_get_mem(lwcell_evt_t* cc);
+#if LWCELL_CFG_SMS_DIRECT || __DOXYGEN__
+lwcell_sms_entry_t* lwcell_evt_sms_recv_get_entry(lwcell_evt_t* cc);
+#endif /* LWCELL_CFG_SMS_DIRECT || __DOXYGEN__ */
 
 /**
  * \}
@@ -257,6 +307,19 @@ lwcellr_t lwcell_evt_operator_scan_get_result(lwcell_evt_t* cc);
 lwcell_operator_t* lwcell_evt_operator_scan_get_entries(lwcell_evt_t* cc);
 size_t lwcell_evt_operator_scan_get_length(lwcell_evt_t* cc);
 
+/**
+ * \}
+ */
+
+/**
+ * \anchor          LWCELL_EVT_OPERATOR_SCAN_ENTRY
+ * \name            Operator scan entry
+ * \brief           Event helper functions for \ref LWCELL_EVT_OPERATOR_SCAN_ENTRY event
+ */
+
+const lwcell_operator_t* lwcell_evt_operator_scan_entry_get_operator(lwcell_evt_t* cc);
+size_t lwcell_evt_operator_scan_entry_get_index(lwcell_evt_t* cc);
+
 /**
  * \}
  */
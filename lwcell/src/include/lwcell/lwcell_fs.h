@@ -0,0 +1,75 @@
+/**
+ * \file            lwcell_fs.h
+ * \brief           Device file system API
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_FS_HDR_H
+#define LWCELL_FS_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_FS Device file system
+ * \brief           Files in device file system
+ * \{
+ *
+ * Files are kept in `customer` directory of SIM7070 series file system and accessed with `AT+CFS*` commands.
+ *
+ * Large payloads are written to a file in chunks of up to \ref LWCELL_CFG_FS_CHUNK_LEN bytes,
+ * which device accepts at full UART speed regardless of network coverage.
+ * Application memory can be reused as soon as write command finishes,
+ * while file is later sent by FTP client of the device with \ref lwcell_ftp_put_file.
+ * Payloads larger than application memory are staged by multiple writes with `append` flag set.
+ */
+
+lwcellr_t lwcell_fs_write(const char* name, const void* data, size_t len, uint8_t append, size_t* bw,
+                          const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_fs_read(const char* name, size_t offset, lwcell_pbuf_p pbuf, size_t* br,
+                         const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_fs_get_size(const char* name, size_t* size, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                             const uint32_t blocking);
+lwcellr_t lwcell_fs_delete(const char* name, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                           const uint32_t blocking);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_FS_HDR_H */
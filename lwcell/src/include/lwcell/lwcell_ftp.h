@@ -44,12 +44,41 @@ extern "C" {
  * \ingroup         LWCELL
  * \defgroup        LWCELL_FTP File transfer protocol
  * \brief           File Transfer Protocol (FTP) manager
+ * \{
  *
- * Currently it is under development
+ * Transfer is executed by FTP client built into the device, using `AT+FTP` commands on SIM800/SIM900.
+ * Device supports single download or upload session at a time.
  *
- * \{
+ * Download is started with \ref lwcell_ftp_get_start and file is read in chunks of
+ * up to \ref LWCELL_CFG_FTP_CHUNK_LEN bytes with \ref lwcell_ftp_get_read.
+ * To keep the link busy while application processes previous chunk,
+ * call \ref lwcell_ftp_get_read in non-blocking mode for two packet buffers;
+ * producer queues second request and executes it as soon as first one finishes.
+ *
+ * Upload is started with \ref lwcell_ftp_put_start and data are written with \ref lwcell_ftp_put_write.
+ * File staged in device file system is uploaded at once with \ref lwcell_ftp_put_file.
+ *
+ * Interrupted transfer is resumed by starting new session with `offset` of last successful byte,
+ * reported by \ref LWCELL_EVT_FTP_DONE event.
+ * Download restarts at offset on server side, upload appends to remote file.
+ *
+ * \note            Network must be attached with \ref lwcell_network_attach before session is started
  */
 
+lwcellr_t lwcell_ftp_get_start(const lwcell_ftp_desc_t* desc, size_t offset, const lwcell_api_cmd_evt_fn evt_fn,
+                               void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_ftp_get_read(lwcell_pbuf_p pbuf, size_t* br, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                              const uint32_t blocking);
+lwcellr_t lwcell_ftp_put_start(const lwcell_ftp_desc_t* desc, size_t offset, const lwcell_api_cmd_evt_fn evt_fn,
+                               void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_ftp_put_write(const void* data, size_t len, size_t* bw, const lwcell_api_cmd_evt_fn evt_fn,
+                               void* const evt_arg, const uint32_t blocking);
+#if LWCELL_CFG_FS || __DOXYGEN__
+lwcellr_t lwcell_ftp_put_file(const lwcell_ftp_desc_t* desc, const char* fs_name, const lwcell_api_cmd_evt_fn evt_fn,
+                              void* const evt_arg, const uint32_t blocking);
+#endif /* LWCELL_CFG_FS || __DOXYGEN__ */
+lwcellr_t lwcell_ftp_close(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+
 /**
  * \}
  */
@@ -46,10 +46,22 @@ extern "C" {
  * \brief           Hyper Text Transfer Protocol (HTTP) manager
  * \{
  *
- * Currently it is under development
+ * Request is executed by HTTP stack built into the device.
+ * Response body stays in device memory and is read in chunks
+ * to application packet buffers with \ref lwcell_http_read.
  *
+ * `AT+HTTP` commands are used on SIM800/SIM900 and `AT+SH` commands on SIM7070.
+ * Device supports single HTTP session at a time.
+ *
+ * \note            Network must be attached with \ref lwcell_network_attach before request is started
  */
 
+lwcellr_t lwcell_http_get(const char* url, uint16_t* status, size_t* content_len, const lwcell_api_cmd_evt_fn evt_fn,
+                          void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_http_read(size_t offset, lwcell_pbuf_p pbuf, size_t* br, const lwcell_api_cmd_evt_fn evt_fn,
+                           void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_http_close(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+
 /**
  * \}
  */
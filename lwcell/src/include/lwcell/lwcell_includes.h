@@ -52,6 +52,9 @@
 #if LWCELL_CFG_SMS || __DOXYGEN__
 #include "lwcell/lwcell_sms.h"
 #endif /* LWCELL_CFG_SMS || __DOXYGEN__ */
+#if LWCELL_CFG_SMS_PDU || __DOXYGEN__
+#include "lwcell/lwcell_sms_pdu.h"
+#endif /* LWCELL_CFG_SMS_PDU || __DOXYGEN__ */
 #if LWCELL_CFG_CALL || __DOXYGEN__
 #include "lwcell/lwcell_call.h"
 #endif /* LWCELL_CFG_CALL || __DOXYGEN__ */
@@ -64,9 +67,72 @@
 #if LWCELL_CFG_NETCONN || __DOXYGEN__
 #include "lwcell/lwcell_netconn.h"
 #endif /* LWCELL_CFG_NETCONN || __DOXYGEN__ */
+#if LWCELL_CFG_NETCONN_POOL || __DOXYGEN__
+#include "lwcell/lwcell_netconn_pool.h"
+#endif /* LWCELL_CFG_NETCONN_POOL || __DOXYGEN__ */
 #if LWCELL_CFG_USSD || __DOXYGEN__
 #include "lwcell/lwcell_ussd.h"
 #endif /* LWCELL_CFG_USSD || __DOXYGEN__ */
+#if LWCELL_CFG_MQTT || __DOXYGEN__
+#include "lwcell/lwcell_mqtt.h"
+#endif /* LWCELL_CFG_MQTT || __DOXYGEN__ */
+#if LWCELL_CFG_HTTP || __DOXYGEN__
+#include "lwcell/lwcell_http.h"
+#endif /* LWCELL_CFG_HTTP || __DOXYGEN__ */
+#if LWCELL_CFG_SSL || __DOXYGEN__
+#include "lwcell/lwcell_ssl.h"
+#endif /* LWCELL_CFG_SSL || __DOXYGEN__ */
+#if LWCELL_CFG_GNSS || __DOXYGEN__
+#include "lwcell/lwcell_gnss.h"
+#endif /* LWCELL_CFG_GNSS || __DOXYGEN__ */
+#if LWCELL_CFG_CELL_INFO || __DOXYGEN__
+#include "lwcell/lwcell_cell_info.h"
+#endif /* LWCELL_CFG_CELL_INFO || __DOXYGEN__ */
+#if LWCELL_CFG_TIME || __DOXYGEN__
+#include "lwcell/lwcell_time.h"
+#endif /* LWCELL_CFG_TIME || __DOXYGEN__ */
+#if LWCELL_CFG_FTP || __DOXYGEN__
+#include "lwcell/lwcell_ftp.h"
+#endif /* LWCELL_CFG_FTP || __DOXYGEN__ */
+#if LWCELL_CFG_FS || __DOXYGEN__
+#include "lwcell/lwcell_fs.h"
+#endif /* LWCELL_CFG_FS || __DOXYGEN__ */
+#if LWCELL_CFG_PING || __DOXYGEN__
+#include "lwcell/lwcell_ping.h"
+#endif /* LWCELL_CFG_PING || __DOXYGEN__ */
+#if LWCELL_CFG_DNS || __DOXYGEN__
+#include "lwcell/lwcell_dns.h"
+#endif /* LWCELL_CFG_DNS || __DOXYGEN__ */
+#if LWCELL_CFG_CMUX || __DOXYGEN__
+#include "lwcell/lwcell_cmux.h"
+#endif /* LWCELL_CFG_CMUX || __DOXYGEN__ */
+#if LWCELL_CFG_PPP || __DOXYGEN__
+#include "lwcell/lwcell_ppp.h"
+#endif /* LWCELL_CFG_PPP || __DOXYGEN__ */
+#if LWCELL_CFG_PWR || __DOXYGEN__
+#include "lwcell/lwcell_pwr.h"
+#endif /* LWCELL_CFG_PWR || __DOXYGEN__ */
+#if LWCELL_CFG_SUPERVISOR || __DOXYGEN__
+#include "lwcell/lwcell_supervisor.h"
+#endif /* LWCELL_CFG_SUPERVISOR || __DOXYGEN__ */
+#if LWCELL_CFG_SNAPSHOT || __DOXYGEN__
+#include "lwcell/lwcell_snapshot.h"
+#endif /* LWCELL_CFG_SNAPSHOT || __DOXYGEN__ */
+#if LWCELL_CFG_USAGE || __DOXYGEN__
+#include "lwcell/lwcell_usage.h"
+#endif /* LWCELL_CFG_USAGE || __DOXYGEN__ */
+#if LWCELL_CFG_METRICS || __DOXYGEN__
+#include "lwcell/lwcell_metrics.h"
+#endif /* LWCELL_CFG_METRICS || __DOXYGEN__ */
+#if LWCELL_CFG_COMPRESS || __DOXYGEN__
+#include "lwcell/lwcell_compress.h"
+#endif /* LWCELL_CFG_COMPRESS || __DOXYGEN__ */
+#if LWCELL_CFG_CQ || __DOXYGEN__
+#include "lwcell/lwcell_cq.h"
+#endif /* LWCELL_CFG_CQ || __DOXYGEN__ */
+#if LWCELL_CFG_STATS || LWCELL_CFG_STATS_COUNTERS || __DOXYGEN__
+#include "lwcell/lwcell_stats.h"
+#endif /* LWCELL_CFG_STATS || LWCELL_CFG_STATS_COUNTERS || __DOXYGEN__ */
 
 #ifdef __cplusplus
 extern "C" {
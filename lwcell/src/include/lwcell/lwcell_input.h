@@ -48,8 +48,36 @@ extern "C" {
  * \{
  */
 
+/**
+ * \brief           Input buffer usage statistics
+ */
+typedef struct {
+    size_t size;             /*!< Current buffer size in units of bytes */
+    size_t used;             /*!< Number of bytes currently waiting to be processed */
+    size_t max_used;         /*!< High-water mark of bytes waiting to be processed */
+    size_t size_recommended; /*!< Minimal buffer size to avoid overflows seen so far, `0` if none */
+    uint32_t overflows;      /*!< Number of input calls, which could not write all data to buffer */
+    uint32_t overflow_bytes; /*!< Number of received bytes lost because of full buffer */
+    uint32_t grows;          /*!< Number of buffer enlargements, see \ref LWCELL_CFG_RCV_BUFF_AUTO_GROW */
+} lwcell_input_buff_stats_t;
+
 lwcellr_t lwcell_input(const void* data, size_t len);
+#if LWCELL_CFG_INPUT_FROM_ISR || __DOXYGEN__
+lwcellr_t lwcell_input_from_isr(const void* data, size_t len);
+#endif /* LWCELL_CFG_INPUT_FROM_ISR || __DOXYGEN__ */
+lwcellr_t lwcell_input_set_buff_size(size_t size);
+lwcellr_t lwcell_input_get_buff_stats(lwcell_input_buff_stats_t* stats);
+void lwcell_input_reset_buff_stats(void);
 lwcellr_t lwcell_input_process(const void* data, size_t len);
+#if LWCELL_CFG_INPUT_ZERO_COPY || __DOXYGEN__
+lwcellr_t lwcell_input_process_ref(const void* data, size_t len, lwcell_pbuf_release_fn release_fn, void* arg);
+#endif /* LWCELL_CFG_INPUT_ZERO_COPY || __DOXYGEN__ */
+#if LWCELL_CFG_RCV_LINE_STREAM || __DOXYGEN__
+lwcellr_t lwcell_input_set_line_stream_fn(lwcell_line_stream_fn fn, void* arg);
+#endif /* LWCELL_CFG_RCV_LINE_STREAM || __DOXYGEN__ */
+#if LWCELL_CFG_AT_ECHO_SKIP || __DOXYGEN__
+lwcellr_t lwcell_input_set_echo_tap_fn(lwcell_echo_tap_fn fn, void* arg);
+#endif /* LWCELL_CFG_AT_ECHO_SKIP || __DOXYGEN__ */
 
 /**
  * \}
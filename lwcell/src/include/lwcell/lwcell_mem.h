@@ -47,6 +47,46 @@ extern "C" {
  * \{
  */
 
+/**
+ * \brief           Subsystem tag of memory allocation
+ * \note            Tags are accounted only when \ref LWCELL_CFG_MEM_TAGS is enabled
+ */
+typedef enum {
+    LWCELL_MEM_TAG_OTHER = 0x00, /*!< Untagged allocation, used by \ref lwcell_mem_malloc and application */
+    LWCELL_MEM_TAG_MSG,          /*!< API command messages */
+    LWCELL_MEM_TAG_PBUF,         /*!< Packet buffers */
+    LWCELL_MEM_TAG_BUFF,         /*!< Ring buffers */
+    LWCELL_MEM_TAG_CONN,         /*!< Connection write buffers */
+    LWCELL_MEM_TAG_NETCONN,      /*!< Netconn objects and write buffers */
+    LWCELL_MEM_TAG_MQTT,         /*!< MQTT client objects, buffers and offline queue */
+    LWCELL_MEM_TAG_EVT,          /*!< Event callback registrations and deferred events */
+    LWCELL_MEM_TAG_TIMEOUT,      /*!< Timeout entries */
+    LWCELL_MEM_TAG_END,          /*!< Last tag entry, number of tags */
+} lwcell_mem_tag_t;
+
+/**
+ * \brief           Allocation class, describes type of memory allocation needs
+ *
+ * Every subsystem tag maps to one class. Allocation is served from region of its class first.
+ * \ref LWCELL_MEM_CLASS_FAST and \ref LWCELL_MEM_CLASS_BULK fall back to any region when class regions are full,
+ * \ref LWCELL_MEM_CLASS_DMA never does, as DMA may not reach other memory.
+ *
+ * \note            Classes are used only when \ref LWCELL_CFG_MEM_CLASSES is enabled
+ */
+typedef enum {
+    LWCELL_MEM_CLASS_ANY = 0x00, /*!< No preference, any region may serve allocation */
+    LWCELL_MEM_CLASS_FAST,       /*!< Fast, CPU-only memory, such as DTCM, for messages and parser state */
+    LWCELL_MEM_CLASS_DMA,        /*!< Memory reachable by DMA, for packet buffer payloads */
+    LWCELL_MEM_CLASS_BULK,       /*!< Large, slower memory, for application-level objects and buffers */
+    LWCELL_MEM_CLASS_END,        /*!< Last class entry, number of classes */
+} lwcell_mem_class_t;
+
+/**
+ * \brief           Get class bit for \ref lwcell_mem_region_t::classes mask
+ * \param[in]       cls: Member of \ref lwcell_mem_class_t enumeration
+ */
+#define LWCELL_MEM_CLASS_BIT(cls) ((uint8_t)(1U << (cls)))
+
 #if !LWCELL_CFG_MEM_CUSTOM || __DOXYGEN__
 
 /**
@@ -55,9 +95,53 @@ extern "C" {
 typedef struct {
     void* start_addr; /*!< Start address of region */
     size_t size;      /*!< Size in units of bytes of region */
+#if LWCELL_CFG_MEM_CLASSES || __DOXYGEN__
+    uint8_t classes; /*!< Mask of \ref LWCELL_MEM_CLASS_BIT values region serves, `0` to serve any class */
+#endif               /* LWCELL_CFG_MEM_CLASSES || __DOXYGEN__ */
 } lwcell_mem_region_t;
 
+/**
+ * \brief           Memory usage of single subsystem tag
+ */
+typedef struct {
+    size_t current_bytes; /*!< Number of currently allocated bytes, including tag overhead */
+    size_t peak_bytes;    /*!< Maximum number of allocated bytes since regions were assigned */
+    uint32_t alloc_count; /*!< Number of successful allocations */
+    uint32_t free_count;  /*!< Number of frees */
+} lwcell_mem_tag_stats_t;
+
+/**
+ * \brief           Memory manager statistics
+ *
+ * Ratio between \ref largest_free_block and \ref available_bytes indicates heap fragmentation
+ */
+typedef struct {
+    size_t total_bytes;              /*!< Number of bytes assigned to memory manager */
+    size_t available_bytes;          /*!< Number of currently available bytes */
+    size_t min_ever_available_bytes; /*!< Minimum number of available bytes since regions were assigned */
+    size_t largest_free_block;       /*!< Size of largest free block, including block metadata */
+    size_t free_blocks;              /*!< Number of free blocks */
+    uint32_t alloc_count;            /*!< Number of successful allocations */
+    uint32_t free_count;             /*!< Number of successful frees */
+    uint32_t alloc_failed_count;     /*!< Number of failed allocations */
+#if LWCELL_CFG_MEM_TAGS || __DOXYGEN__
+    lwcell_mem_tag_stats_t tags[LWCELL_MEM_TAG_END]; /*!< Usage per subsystem, indexed by \ref lwcell_mem_tag_t */
+#endif                                               /* LWCELL_CFG_MEM_TAGS || __DOXYGEN__ */
+} lwcell_mem_stats_t;
+
 uint8_t lwcell_mem_assignmemory(const lwcell_mem_region_t* regions, size_t size);
+uint8_t lwcell_mem_get_stats(lwcell_mem_stats_t* stats);
+void* lwcell_mem_malloc_tag(size_t size, lwcell_mem_tag_t tag);
+void* lwcell_mem_realloc_tag(void* ptr, size_t size, lwcell_mem_tag_t tag);
+void* lwcell_mem_calloc_tag(size_t num, size_t size, lwcell_mem_tag_t tag);
+lwcell_mem_class_t lwcell_mem_tag_class(lwcell_mem_tag_t tag);
+
+#else /* !LWCELL_CFG_MEM_CUSTOM || __DOXYGEN__ */
+
+/* Custom memory manager has no accounting, tag is ignored */
+#define lwcell_mem_malloc_tag(size, tag)       lwcell_mem_malloc(size)
+#define lwcell_mem_realloc_tag(ptr, size, tag) lwcell_mem_realloc((ptr), (size))
+#define lwcell_mem_calloc_tag(num, size, tag)  lwcell_mem_calloc((num), (size))
 
 #endif /* !LWCELL_CFG_MEM_CUSTOM || __DOXYGEN__ */
 
@@ -0,0 +1,104 @@
+/**
+ * \file            lwcell_metrics.h
+ * \brief           Metric time series
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_METRICS_HDR_H
+#define LWCELL_METRICS_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_METRICS Metric time series
+ * \brief           Fixed-memory time series of modem and link metrics
+ * \{
+ *
+ * Library samples its internal state every \ref LWCELL_CFG_METRICS_INTERVAL milliseconds,
+ * interval may be changed with \ref lwcell_metrics_set_interval.
+ * Sampling does not send any command to device, values are the ones library already knows,
+ * such as RSSI from last `+CSQ` response and counters of \ref LWCELL_CFG_STATS_COUNTERS.
+ *
+ * Samples are stored as differences to previous sample in \ref LWCELL_CFG_METRICS_BUFF_SIZE bytes,
+ * oldest samples are dropped when buffer is full.
+ * Counter metrics hold increase during sampling interval, other metrics hold current value.
+ *
+ * \ref lwcell_metrics_serialize writes all samples in compact format for upload:
+ *
+ *  - `1` byte: format version, currently `1`
+ *  - `1` byte: number of metrics per sample, \ref LWCELL_METRICS_END
+ *  - Varint: sampling interval in units of milliseconds
+ *  - Varint: number of samples
+ *  - Varint: age of newest sample in units of milliseconds
+ *  - Oldest sample: one zigzag varint per metric, in order of \ref lwcell_metrics_id_t
+ *  - Each following sample: one zigzag varint per metric, difference to previous sample
+ *
+ * Varint is unsigned value in little-endian groups of `7` bits, with bit `7` set when more bytes follow.
+ * Zigzag maps signed value `v` to unsigned `(v << 1) ^ (v >> 31)`, so that small negative values stay short.
+ */
+
+/**
+ * \brief           Sampled metrics, order of values in sample
+ */
+typedef enum {
+    LWCELL_METRICS_RSSI,        /*!< RSSI in units of dBm, `0` when unknown */
+    LWCELL_METRICS_NETWORK_REG, /*!< Network registration status, member of \ref lwcell_network_reg_status_t */
+    LWCELL_METRICS_RX_BYTES,    /*!< Number of bytes received from device during interval */
+    LWCELL_METRICS_TX_BYTES,    /*!< Number of bytes sent to device during interval */
+    LWCELL_METRICS_ATTACHES,    /*!< Number of network attaches during interval */
+    LWCELL_METRICS_CONN_OPENED, /*!< Number of connections which became active during interval */
+    LWCELL_METRICS_CONN_ERRORS, /*!< Number of failed connection starts during interval */
+    LWCELL_METRICS_CMD_ERRORS,  /*!< Number of commands finished with error or timeout during interval.
+                                        Requires \ref LWCELL_CFG_STATS, `0` otherwise */
+    LWCELL_METRICS_CMD_LATENCY, /*!< Average device turnaround time of commands finished during interval,
+                                        in units of milliseconds. Requires \ref LWCELL_CFG_STATS, `0` otherwise */
+    LWCELL_METRICS_END,         /*!< Number of metrics in sample */
+} lwcell_metrics_id_t;
+
+lwcellr_t lwcell_metrics_set_interval(uint32_t interval);
+size_t lwcell_metrics_get_count(void);
+lwcellr_t lwcell_metrics_get(size_t index, int32_t* values);
+lwcellr_t lwcell_metrics_serialize(void* data, size_t btw, size_t* bw);
+lwcellr_t lwcell_metrics_clear(void);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_METRICS_HDR_H */
@@ -32,11 +32,14 @@
  * Version:         v0.1.1
  */
 
-/* Order: Device name; Device model identification, Is_2G, Is_LTE */
-LWCELL_DEVICE_MODEL_ENTRY(SIM800x, "SIM800", 1, 0, 0)
-LWCELL_DEVICE_MODEL_ENTRY(SIM900x, "SIM900", 1, 0, 0)
-LWCELL_DEVICE_MODEL_ENTRY(SIM7070G, "7070G", 0, 1, 0)
-//LWCELL_DEVICE_MODEL_ENTRY(SIM7000x, "SIM7000", 1, 0)
-//LWCELL_DEVICE_MODEL_ENTRY(SIM7020x, "SIM7020", 1, 0)
+/*
+ * Order: Device name; Device model identification, Is_2G, Is_LTE, Has native MQTT,
+ * Has SH* HTTP commands (instead of HTTP*), Has CIPQSEND, Has CIPRXGET, Has CA* socket commands, Max CIPSEND length
+ */
+LWCELL_DEVICE_MODEL_ENTRY(SIM800x, "SIM800", 1, 0, 0, 0, 1, 1, 0, 1460)
+LWCELL_DEVICE_MODEL_ENTRY(SIM900x, "SIM900", 1, 0, 0, 0, 1, 1, 0, 1460)
+LWCELL_DEVICE_MODEL_ENTRY(SIM7070G, "7070G", 0, 1, 1, 1, 0, 0, 1, 1460)
+//LWCELL_DEVICE_MODEL_ENTRY(SIM7000x, "SIM7000", 1, 0, 0, 0, 1, 1, 0, 1460)
+//LWCELL_DEVICE_MODEL_ENTRY(SIM7020x, "SIM7020", 1, 0, 0, 0, 1, 1, 0, 1460)
 
 #undef LWCELL_DEVICE_MODEL_ENTRY
\ No newline at end of file
@@ -35,6 +35,9 @@
 #define LWCELL_NETCONN_HDR_H
 
 #include "lwcell/lwcell_types.h"
+#if LWCELL_CFG_COMPRESS || __DOXYGEN__
+#include "lwcell/lwcell_compress.h"
+#endif /* LWCELL_CFG_COMPRESS || __DOXYGEN__ */
 
 #ifdef __cplusplus
 extern "C" {
@@ -62,6 +65,19 @@ typedef struct lwcell_netconn* lwcell_netconn_p;
 
 /* Immediate flush for TCP write. Used with \ref lwcell_netconn_write_ex*/
 #define LWCELL_NETCONN_FLAG_FLUSH      ((uint16_t)0x0001) /*!< Immediate flush after netconn write */
+#define LWCELL_NETCONN_FLAG_MORE       ((uint16_t)0x0002) /*!< More data follow, hold data in write buffer */
+
+#if LWCELL_CFG_NETCONN_POLL || __DOXYGEN__
+
+/**
+ * \brief           Netconn poll entry, used with \ref lwcell_netconn_poll
+ */
+typedef struct {
+    lwcell_netconn_p nc; /*!< Netconn handle to poll. Entry is ignored when set to `NULL` */
+    uint8_t ready;       /*!< Output flag, set to `1` when \ref lwcell_netconn_receive will not block */
+} lwcell_netconn_poll_t;
+
+#endif /* LWCELL_CFG_NETCONN_POLL || __DOXYGEN__ */
 
 /**
  * \brief           Netconn connection type
@@ -76,9 +92,18 @@ typedef enum {
 lwcell_netconn_p lwcell_netconn_new(lwcell_netconn_type_t type);
 lwcellr_t lwcell_netconn_delete(lwcell_netconn_p nc);
 lwcellr_t lwcell_netconn_connect(lwcell_netconn_p nc, const char* host, lwcell_port_t port);
+#if LWCELL_CFG_CONN_SERVER || __DOXYGEN__
+lwcellr_t lwcell_netconn_bind(lwcell_netconn_p nc, lwcell_port_t port);
+lwcellr_t lwcell_netconn_listen(lwcell_netconn_p nc);
+lwcellr_t lwcell_netconn_set_listen_conn_timeout(lwcell_netconn_p nc, uint16_t timeout);
+lwcellr_t lwcell_netconn_accept(lwcell_netconn_p nc, lwcell_netconn_p* client);
+#endif /* LWCELL_CFG_CONN_SERVER || __DOXYGEN__ */
 lwcellr_t lwcell_netconn_receive(lwcell_netconn_p nc, lwcell_pbuf_p* pbuf);
+lwcellr_t lwcell_netconn_receivefrom(lwcell_netconn_p nc, lwcell_pbuf_p* pbuf, lwcell_ip_t* ip, lwcell_port_t* port);
+lwcellr_t lwcell_netconn_read(lwcell_netconn_p nc, void* buf, size_t len, size_t* br, uint32_t timeout);
 lwcellr_t lwcell_netconn_close(lwcell_netconn_p nc);
 int8_t lwcell_netconn_getconnnum(lwcell_netconn_p nc);
+uint8_t lwcell_netconn_is_connected(lwcell_netconn_p nc);
 void lwcell_netconn_set_receive_timeout(lwcell_netconn_p nc, uint32_t timeout);
 uint32_t lwcell_netconn_get_receive_timeout(lwcell_netconn_p nc);
 
@@ -86,12 +111,19 @@ uint32_t lwcell_netconn_get_receive_timeout(lwcell_netconn_p nc);
 lwcellr_t lwcell_netconn_write(lwcell_netconn_p nc, const void* data, size_t btw);
 lwcellr_t lwcell_netconn_write_ex(lwcell_netconn_p nc, const void* data, size_t btw, uint16_t flags);
 lwcellr_t lwcell_netconn_flush(lwcell_netconn_p nc);
+#if LWCELL_CFG_COMPRESS || __DOXYGEN__
+lwcellr_t lwcell_netconn_write_compressed(lwcell_netconn_p nc, lwcell_compress_t* comp, const void* data, size_t btw);
+#endif /* LWCELL_CFG_COMPRESS || __DOXYGEN__ */
 
 /* UDP only */
 lwcellr_t lwcell_netconn_send(lwcell_netconn_p nc, const void* data, size_t btw);
 lwcellr_t lwcell_netconn_sendto(lwcell_netconn_p nc, const lwcell_ip_t* ip, lwcell_port_t port, const void* data,
                               size_t btw);
 
+#if LWCELL_CFG_NETCONN_POLL || __DOXYGEN__
+lwcellr_t lwcell_netconn_poll(lwcell_netconn_poll_t* fds, size_t fds_len, uint32_t timeout, size_t* ready_cnt);
+#endif /* LWCELL_CFG_NETCONN_POLL || __DOXYGEN__ */
+
 /**
  * \}
  */
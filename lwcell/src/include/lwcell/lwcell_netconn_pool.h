@@ -0,0 +1,93 @@
+/**
+ * \file            lwcell_netconn_pool.h
+ * \brief           Pool of persistent netconn connections
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_NETCONN_POOL_HDR_H
+#define LWCELL_NETCONN_POOL_HDR_H
+
+#include "lwcell/lwcell_netconn.h"
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL_NETCONN
+ * \defgroup        LWCELL_NETCONN_POOL Netconn pool
+ * \brief           Named endpoints with persistent connections
+ * \{
+ *
+ * Pool keeps connections to named endpoints open between exchanges,
+ * so request does not wait for DNS and TCP setup every time.
+ * Closed connection is reopened on next acquire or send.
+ */
+
+struct lwcell_netconn_pool;
+
+/**
+ * \brief           Pool entry handle, returned by \ref lwcell_netconn_pool_acquire
+ */
+typedef struct lwcell_netconn_pool* lwcell_netconn_pool_p;
+
+/**
+ * \brief           Endpoint description
+ * \note            Structure and strings must stay valid until endpoint is removed from pool
+ */
+typedef struct {
+    const char* name;           /*!< Unique endpoint name used for lookup */
+    const char* host;           /*!< Host name or IP address in string format */
+    lwcell_port_t port;         /*!< Remote port */
+    lwcell_netconn_type_t type; /*!< Netconn connection type */
+    uint32_t rcv_timeout;       /*!< Receive timeout in units of milliseconds, `0` to wait forever.
+                                        Used only when \ref LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT is enabled */
+    uint8_t keep_warm;          /*!< Set to `1` to connect when endpoint is added
+                                        and to reconnect immediately when connection is released closed */
+} lwcell_netconn_pool_endpoint_t;
+
+lwcellr_t lwcell_netconn_pool_add(const lwcell_netconn_pool_endpoint_t* ep);
+lwcellr_t lwcell_netconn_pool_remove(const char* name);
+lwcellr_t lwcell_netconn_pool_acquire(const char* name, lwcell_netconn_pool_p* entry);
+lwcellr_t lwcell_netconn_pool_release(lwcell_netconn_pool_p entry);
+lwcellr_t lwcell_netconn_pool_send(lwcell_netconn_pool_p entry, const void* data, size_t btw);
+lwcellr_t lwcell_netconn_pool_receive(lwcell_netconn_pool_p entry, lwcell_pbuf_p* pbuf);
+lwcell_netconn_p lwcell_netconn_pool_get_netconn(lwcell_netconn_pool_p entry);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_NETCONN_POOL_HDR_H */
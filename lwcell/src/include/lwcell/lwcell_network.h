@@ -50,7 +50,21 @@ extern "C" {
 /* Basic commands, always available */
 lwcellr_t lwcell_network_rssi(int16_t* rssi, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
                             const uint32_t blocking);
+int16_t lwcell_network_rssi_cached(void);
 lwcell_network_reg_status_t lwcell_network_get_reg_status(void);
+#if LWCELL_CFG_NETWORK_PS_REG || __DOXYGEN__
+lwcell_network_reg_status_t lwcell_network_get_ps_reg_status(void);
+lwcellr_t lwcell_network_get_cell(uint32_t* area_code, uint32_t* cell_id);
+#endif /* LWCELL_CFG_NETWORK_PS_REG || __DOXYGEN__ */
+lwcellr_t lwcell_network_query_batch(uint32_t queries, int16_t* rssi, const lwcell_api_cmd_evt_fn evt_fn,
+                                     void* const evt_arg, const uint32_t blocking);
+#if LWCELL_CFG_NETWORK_BAND || __DOXYGEN__
+lwcellr_t lwcell_network_band_lock(lwcell_network_rat_t rat, const uint8_t* bands, size_t bands_len,
+                                   const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_network_band_get(lwcell_network_band_t* band, const lwcell_api_cmd_evt_fn evt_fn,
+                                  void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_network_band_set_manager(const lwcell_network_band_cfg_t* cfg);
+#endif /* LWCELL_CFG_NETWORK_BAND || __DOXYGEN__ */
 
 /* TCP/IP related commands */
 lwcellr_t lwcell_network_attach(const char* apn, const char* user, const char* pass, const lwcell_api_cmd_evt_fn evt_fn,
@@ -59,6 +73,16 @@ lwcellr_t lwcell_network_detach(const lwcell_api_cmd_evt_fn evt_fn, void* const
 uint8_t lwcell_network_is_attached(void);
 lwcellr_t lwcell_network_copy_ip(lwcell_ip_t* ip);
 lwcellr_t lwcell_network_check_status(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+#if LWCELL_CFG_NETWORK_PDP_RECOVERY || __DOXYGEN__
+lwcellr_t lwcell_network_set_pdp_recovery(const char* apn, const char* user, const char* pass);
+#endif /* LWCELL_CFG_NETWORK_PDP_RECOVERY || __DOXYGEN__ */
+
+#if LWCELL_CFG_NETWORK_CONTEXTS > 1 || __DOXYGEN__
+lwcellr_t lwcell_network_attach_ctx(uint8_t ctx, const char* apn, const char* user, const char* pass,
+                                    const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+uint8_t lwcell_network_is_attached_ctx(uint8_t ctx);
+lwcellr_t lwcell_network_copy_ip_ctx(uint8_t ctx, lwcell_ip_t* ip);
+#endif /* LWCELL_CFG_NETWORK_CONTEXTS > 1 || __DOXYGEN__ */
 
 /**
  * \}
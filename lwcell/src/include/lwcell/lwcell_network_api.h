@@ -49,6 +49,7 @@ extern "C" {
 
 lwcellr_t lwcell_network_set_credentials(const char* apn, const char* user, const char* pass);
 lwcellr_t lwcell_network_request_attach(void);
+lwcellr_t lwcell_network_request_preattach(void);
 lwcellr_t lwcell_network_request_detach(void);
 
 /**
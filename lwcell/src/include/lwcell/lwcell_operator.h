@@ -55,6 +55,11 @@ lwcellr_t lwcell_operator_set(lwcell_operator_mode_t mode, lwcell_operator_forma
 
 lwcellr_t lwcell_operator_scan(lwcell_operator_t* ops, size_t opsl, size_t* opf, const lwcell_api_cmd_evt_fn evt_fn,
                                void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_operator_scan_ex(lwcell_operator_t* ops, size_t opsl, size_t* opf, uint32_t stop_num,
+                                  const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+#if LWCELL_CFG_OPERATOR_CACHE || __DOXYGEN__
+lwcellr_t lwcell_operator_set_cache_fn(lwcell_operator_cache_fn fn, void* arg);
+#endif /* LWCELL_CFG_OPERATOR_CACHE || __DOXYGEN__ */
 
 /**
  * \}
@@ -53,7 +53,10 @@
 /**
  * \brief           Enables `1` or disables `0` operating system support for GSM library
  *
- * \note            Value must be set to 1 in the current revision
+ * When disabled, library runs in bare-metal single loop mode.
+ * Application must periodically call \ref lwcell_poll from its main loop
+ * and only non-blocking API calls (`blocking = 0`) may be used.
+ * Use `baremetal` system port in this case.
  *
  * \note            Check \ref LWCELL_OPT_OS group for more configuration related to operating system
  *
@@ -96,6 +99,134 @@
 #define LWCELL_CFG_MEM_ALIGNMENT 4
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` two-level segregated fit (TLSF) allocator
+ *
+ * When enabled, built-in memory manager keeps free blocks in size-class lists
+ * indexed by bitmaps, instead of single first-fit linked list.
+ * Allocation and free operations execute in constant time, independent of number of free blocks.
+ *
+ * \note            Used only when \ref LWCELL_CFG_MEM_CUSTOM is set to `0`
+ * \note            \ref LWCELL_CFG_MEM_ALIGNMENT must be at least `4` when enabled
+ */
+#ifndef LWCELL_CFG_MEM_TLSF
+#define LWCELL_CFG_MEM_TLSF 0
+#endif
+
+/**
+ * \brief           Base-2 logarithm of largest block size with its own size class
+ *
+ * Free blocks of `2^LWCELL_CFG_MEM_TLSF_MAX_LOG2` bytes or more are kept in last size-class list,
+ * which is searched linearly. Set it to cover largest expected allocation.
+ *
+ * \note            Used only when \ref LWCELL_CFG_MEM_TLSF is enabled
+ */
+#ifndef LWCELL_CFG_MEM_TLSF_MAX_LOG2
+#define LWCELL_CFG_MEM_TLSF_MAX_LOG2 16
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` static allocation mode
+ *
+ * When enabled, built-in memory manager does not use heap regions.
+ * Every allocation is served from fixed size block pools, placed in static memory and sized at compile time.
+ * Request is served by smallest pool with block big enough and with free entry.
+ * Allocation and free operations execute in constant time.
+ *
+ * Three size classes are available, configured with
+ * \ref LWCELL_CFG_STATIC_ALLOC_SMALL_SIZE, \ref LWCELL_CFG_STATIC_ALLOC_MEDIUM_SIZE
+ * and \ref LWCELL_CFG_STATIC_ALLOC_LARGE_SIZE.
+ * When allocation fails, \ref LWCELL_EVT_MEM_POOL_EMPTY event is sent from processing thread.
+ *
+ * \note            Used only when \ref LWCELL_CFG_MEM_CUSTOM is set to `0`.
+ *                  \ref lwcell_mem_assignmemory has no effect in this mode
+ * \note            Largest block must fit largest allocation, such as receive buffer
+ *                  of \ref LWCELL_CFG_RCV_BUFF_SIZE bytes or connection data packet
+ */
+#ifndef LWCELL_CFG_STATIC_ALLOC
+#define LWCELL_CFG_STATIC_ALLOC 0
+#endif
+
+/**
+ * \brief           Block size of small static allocation pool in units of bytes
+ */
+#ifndef LWCELL_CFG_STATIC_ALLOC_SMALL_SIZE
+#define LWCELL_CFG_STATIC_ALLOC_SMALL_SIZE 32
+#endif
+
+/**
+ * \brief           Number of blocks in small static allocation pool
+ */
+#ifndef LWCELL_CFG_STATIC_ALLOC_SMALL_CNT
+#define LWCELL_CFG_STATIC_ALLOC_SMALL_CNT 32
+#endif
+
+/**
+ * \brief           Block size of medium static allocation pool in units of bytes
+ */
+#ifndef LWCELL_CFG_STATIC_ALLOC_MEDIUM_SIZE
+#define LWCELL_CFG_STATIC_ALLOC_MEDIUM_SIZE 256
+#endif
+
+/**
+ * \brief           Number of blocks in medium static allocation pool
+ */
+#ifndef LWCELL_CFG_STATIC_ALLOC_MEDIUM_CNT
+#define LWCELL_CFG_STATIC_ALLOC_MEDIUM_CNT 16
+#endif
+
+/**
+ * \brief           Block size of large static allocation pool in units of bytes
+ */
+#ifndef LWCELL_CFG_STATIC_ALLOC_LARGE_SIZE
+#define LWCELL_CFG_STATIC_ALLOC_LARGE_SIZE (LWCELL_CFG_CONN_MAX_DATA_LEN + 64)
+#endif
+
+/**
+ * \brief           Number of blocks in large static allocation pool
+ */
+#ifndef LWCELL_CFG_STATIC_ALLOC_LARGE_CNT
+#define LWCELL_CFG_STATIC_ALLOC_LARGE_CNT 6
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` memory accounting per subsystem
+ *
+ * Every allocation is tagged with \ref lwcell_mem_tag_t of subsystem, which requested it.
+ * Built-in memory manager keeps current and peak number of bytes and allocation counts for each tag,
+ * available in \ref lwcell_mem_stats_t::tags with \ref lwcell_mem_get_stats function.
+ *
+ * \note            Every allocation uses additional \ref LWCELL_CFG_MEM_ALIGNMENT bytes to keep its tag
+ * \note            Used only when \ref LWCELL_CFG_MEM_CUSTOM is set to `0`
+ */
+#ifndef LWCELL_CFG_MEM_TAGS
+#define LWCELL_CFG_MEM_TAGS 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` memory region allocation classes
+ *
+ * Every region, assigned with \ref lwcell_mem_assignmemory, sets \ref lwcell_mem_region_t::classes mask
+ * of \ref lwcell_mem_class_t classes it serves. Every allocation requests class of its subsystem tag,
+ * messages use fast memory and packet buffers use DMA-capable memory.
+ * Use it on devices with tightly coupled memory, not reachable by DMA, such as STM32H7 DTCM.
+ *
+ * \note            Used only when \ref LWCELL_CFG_MEM_CUSTOM is set to `0`,
+ *                  static allocation mode with \ref LWCELL_CFG_STATIC_ALLOC has no regions
+ */
+#ifndef LWCELL_CFG_MEM_CLASSES
+#define LWCELL_CFG_MEM_CLASSES 0
+#endif
+
+/**
+ * \brief           Maximum number of regions with allocation classes
+ *
+ * \note            Used only when \ref LWCELL_CFG_MEM_CLASSES is enabled
+ */
+#ifndef LWCELL_CFG_MEM_CLASS_REGIONS
+#define LWCELL_CFG_MEM_CLASS_REGIONS 4
+#endif
+
 /**
  * \brief           Enables `1` or disables `0` callback function and custom parameter for API functions
  *
@@ -106,6 +237,53 @@
 #define LWCELL_CFG_USE_API_FUNC_EVT 1
 #endif
 
+/**
+ * \brief           Number of preallocated messages for API commands
+ *
+ * When set to value greater than `0`, API functions take command messages from static pool
+ * instead of allocating them from heap. Semaphore of blocking message is kept with message
+ * when returned to pool and is reused by next blocking command.
+ *
+ * When pool is empty, message is allocated from heap as if pool was not used.
+ * Pool messages are always full size, while heap messages are allocated
+ * with common header and payload of their command family only.
+ *
+ * \note            Set it to maximal number of concurrently pending API commands
+ */
+#ifndef LWCELL_CFG_MSG_POOL_SIZE
+#define LWCELL_CFG_MSG_POOL_SIZE 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` batch command submission with completion queue
+ *
+ * Non-blocking API calls between \ref lwcell_cq_begin and \ref lwcell_cq_submit are linked to one batch,
+ * put to producer queue at once and executed back to back.
+ * Results are collected from completion ring, without semaphore or callback per command.
+ *
+ * \note            This mode can only be used when \ref LWCELL_CFG_OS is enabled
+ * \sa              LWCELL_CQ
+ */
+#ifndef LWCELL_CFG_CQ
+#define LWCELL_CFG_CQ 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` fine-grained locking
+ *
+ * When enabled, connection write buffer and received counter are protected by per-connection mutex
+ * and global event callback list by separate mutex, instead of core lock.
+ * Application threads writing to connections or registering callbacks do not block input processing thread.
+ *
+ * \note            Core lock is still used for parser state and memory allocator.
+ *                  Fine-grained locks are never held while core lock is being acquired.
+ *
+ * \note            This mode can only be used when \ref LWCELL_CFG_OS is enabled
+ */
+#ifndef LWCELL_CFG_FINE_LOCK
+#define LWCELL_CFG_FINE_LOCK 0
+#endif
+
 /**
  * \defgroup        LWCELL_OPT_CONN Connection settings
  * \brief           Connection settings
@@ -142,6 +320,79 @@
 #define LWCELL_CFG_CONN_MIN_DATA_LEN 16
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` static packet buffer pools
+ *
+ * When enabled, \ref lwcell_pbuf_new takes packet buffer from smallest pool
+ * with payload size big enough for requested length.
+ * When all suitable pools are empty, packet buffer is allocated from heap.
+ *
+ * Three size classes are available, configured with
+ * \ref LWCELL_CFG_PBUF_POOL_SMALL_SIZE, \ref LWCELL_CFG_PBUF_POOL_MEDIUM_SIZE and \ref LWCELL_CFG_PBUF_POOL_LARGE_SIZE
+ */
+#ifndef LWCELL_CFG_PBUF_POOL
+#define LWCELL_CFG_PBUF_POOL 0
+#endif
+
+/**
+ * \brief           Payload size of small pool packet buffer in units of bytes
+ */
+#ifndef LWCELL_CFG_PBUF_POOL_SMALL_SIZE
+#define LWCELL_CFG_PBUF_POOL_SMALL_SIZE 64
+#endif
+
+/**
+ * \brief           Number of packet buffers in small pool
+ */
+#ifndef LWCELL_CFG_PBUF_POOL_SMALL_CNT
+#define LWCELL_CFG_PBUF_POOL_SMALL_CNT 8
+#endif
+
+/**
+ * \brief           Payload size of medium pool packet buffer in units of bytes
+ */
+#ifndef LWCELL_CFG_PBUF_POOL_MEDIUM_SIZE
+#define LWCELL_CFG_PBUF_POOL_MEDIUM_SIZE 256
+#endif
+
+/**
+ * \brief           Number of packet buffers in medium pool
+ */
+#ifndef LWCELL_CFG_PBUF_POOL_MEDIUM_CNT
+#define LWCELL_CFG_PBUF_POOL_MEDIUM_CNT 4
+#endif
+
+/**
+ * \brief           Payload size of large pool packet buffer in units of bytes
+ */
+#ifndef LWCELL_CFG_PBUF_POOL_LARGE_SIZE
+#define LWCELL_CFG_PBUF_POOL_LARGE_SIZE LWCELL_CFG_CONN_MAX_DATA_LEN
+#endif
+
+/**
+ * \brief           Number of packet buffers in large pool
+ */
+#ifndef LWCELL_CFG_PBUF_POOL_LARGE_CNT
+#define LWCELL_CFG_PBUF_POOL_LARGE_CNT 2
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` atomic packet buffer reference counter
+ *
+ * When enabled, \ref lwcell_pbuf_ref and \ref lwcell_pbuf_free modify reference counter
+ * without core lock, hence packet buffers may be shared and released from any thread
+ * without contention with processing thread.
+ *
+ * C11 `stdatomic.h` is used when compiler supports it,
+ * otherwise system port must implement \ref lwcell_sys_atomic_add function.
+ *
+ * \note            Memory allocator and packet buffer pools still use core lock,
+ *                  when last reference is released and memory is given back
+ */
+#ifndef LWCELL_CFG_PBUF_REF_ATOMIC
+#define LWCELL_CFG_PBUF_REF_ATOMIC 0
+#endif
+
 /**
  * \brief           Set number of retries for send data command.
  *
@@ -153,525 +404,2626 @@
 #endif
 
 /**
- * \}
+ * \brief           Enables `1` or disables `0` quick send mode for connection data
+ *
+ * When enabled, `AT+CIPQSEND=1` is set during network attach, unless device model does not support it.
+ * Device confirms every data chunk with `DATA ACCEPT` as soon as data are
+ * copied to its internal buffer, instead of waiting for `SEND OK` after remote side acknowledged them.
+ * Next chunk of the same send request is started immediately after confirmation.
+ *
+ * \note            Send event with \ref lwcellOK result only means data were accepted by device
  */
+#ifndef LWCELL_CFG_CONN_QUICK_SEND
+#define LWCELL_CFG_CONN_QUICK_SEND 0
+#endif
 
 /**
- * \brief           Default baudrate used for AT port
+ * \brief           Enables `1` or disables `0` source address of received connection data
  *
- * \note            Later, user may call API function to change to desired baudrate if necessary
+ * When enabled, `AT+CIPSRIP=1` is set during network attach and device reports
+ * `RECV FROM:<ip>:<port>` line before every received packet.
+ * Address is saved to packet buffer, to be read with \ref lwcell_netconn_receivefrom,
+ * allowing single UDP connection to serve many remote peers.
+ *
+ * When disabled, packet buffers carry remote address of connection instead
+ *
+ * \note            Applies to data pushed by device. In \ref LWCELL_CFG_CONN_MANUAL_RECV mode,
+ *                  device buffer is read as stream and connection remote address is used
  */
-#ifndef LWCELL_CFG_AT_PORT_BAUDRATE
-#define LWCELL_CFG_AT_PORT_BAUDRATE 115200
+#ifndef LWCELL_CFG_CONN_RECV_FROM
+#define LWCELL_CFG_CONN_RECV_FROM 0
 #endif
 
 /**
- * \brief           Buffer size for received data waiting to be processed
- * \note            When server mode is active and a lot of connections are in queue
- *                  this should be set high otherwise your buffer may overflow
+ * \brief           Number of `AT+CIPSEND` chunks sent in one turn, before send request yields to other connections
  *
- * \note            Buffer size also depends on TX user driver if it uses DMA or blocking mode
- *                  In case of DMA (CPU can work other tasks), buffer may be smaller as CPU
- *                  will have more time to process all the incoming bytes
+ * When send requests for other connections wait in producer queue,
+ * long send request is put back to the end of the queue after given number of chunks.
+ * Uploads on different connections are interleaved round-robin instead of one blocking the others.
+ * Weight of single connection is changed with \ref lwcell_conn_set_send_weight
  *
- * \note            This parameter has no meaning when \ref LWCELL_CFG_INPUT_USE_PROCESS is enabled
+ * \note            Set to `0` to send each request at once
  */
-#ifndef LWCELL_CFG_RCV_BUFF_SIZE
-#define LWCELL_CFG_RCV_BUFF_SIZE 0x400
+#ifndef LWCELL_CFG_CONN_SEND_FAIR
+#define LWCELL_CFG_CONN_SEND_FAIR 0
 #endif
 
 /**
- * \brief           Enables `1` or disables `0` reset sequence after \ref lwcell_init call
+ * \brief           Enables `1` or disables `0` deadlines and cancellation of queued send requests
  *
- * \note            When this functionality is disabled, user must manually call \ref lwcell_reset to send
- *                  reset sequence to GSM device.
+ * Send request started with \ref lwcell_conn_send_deadline is dropped when its deadline passes
+ * before it starts or between `AT+CIPSEND` chunks, or when it is cancelled with \ref lwcell_conn_send_cancel.
+ * Dropped request is reported with \ref lwcellERRSTALE result in \ref LWCELL_EVT_CONN_SEND event
  */
-#ifndef LWCELL_CFG_RESET_ON_INIT
-#define LWCELL_CFG_RESET_ON_INIT 1
+#ifndef LWCELL_CFG_CONN_SEND_DEADLINE
+#define LWCELL_CFG_CONN_SEND_DEADLINE 0
 #endif
 
 /**
- * \brief           Enables `1` or disables `0` reset sequence after \ref lwcell_device_set_present call
+ * \brief           Period of transmit windows for deferred connections, in units of milliseconds
  *
- * \note            When this functionality is disabled, user must manually call \ref lwcell_reset to send
- *                  reset sequence to GSM device.
+ * Send requests on connections marked with \ref lwcell_conn_set_tx_deferred are held back
+ * and released together, at most this time after first of them was queued.
+ * Sends on other connections, received data and \ref lwcell_conn_tx_window_open open the window earlier.
+ * Scattered sends are grouped, radio stays in connected state once per window instead of once per send.
+ *
+ * \note            Blocking send on deferred connection waits for the window too
+ * \note            Set to `0` to disable the feature
  */
-#ifndef LWCELL_CFG_RESET_ON_DEVICE_PRESENT
-#define LWCELL_CFG_RESET_ON_DEVICE_PRESENT 1
+#ifndef LWCELL_CFG_CONN_TX_WINDOW
+#define LWCELL_CFG_CONN_TX_WINDOW 0
 #endif
 
 /**
- * \brief           Default delay (milliseconds unit) before sending first AT command on reset sequence
+ * \brief           Time window stays open after radio activity, in units of milliseconds
+ *
+ * Deferred sends within this time after window opened, send on other connection or received data
+ * are not held back, as radio is still in connected state.
+ * Set close to radio inactivity timer of the network
+ *
+ * \note            Used only when \ref LWCELL_CFG_CONN_TX_WINDOW is greater than `0`
  */
-#ifndef LWCELL_CFG_RESET_DELAY_DEFAULT
-#define LWCELL_CFG_RESET_DELAY_DEFAULT 1000
+#ifndef LWCELL_CFG_CONN_TX_WINDOW_HOLD
+#define LWCELL_CFG_CONN_TX_WINDOW_HOLD 2000
 #endif
 
 /**
- * \brief           Default delay (milliseconds unit) after reset sequence
+ * \brief           Enables `1` or disables `0` pull based send of data from application source
+ *
+ * With \ref lwcell_conn_send_stream, data of every `AT+CIPSEND` chunk are read from application callback
+ * after device sent `> ` prompt, without staging complete payload in RAM
  */
-#ifndef LWCELL_CFG_RESET_DELAY_AFTER
-#define LWCELL_CFG_RESET_DELAY_AFTER 5000
+#ifndef LWCELL_CFG_CONN_SEND_STREAM
+#define LWCELL_CFG_CONN_SEND_STREAM 0
 #endif
 
 /**
- * \brief           Enables `1` or disables `0` periodic keep-alive events to registered callbacks
+ * \brief           Size of buffer on processing thread stack, used to read stream data from application
  *
+ * Data of each chunk are read in pieces of up to this size, before written to AT port
  */
-#ifndef LWCELL_CFG_KEEP_ALIVE
-#define LWCELL_CFG_KEEP_ALIVE 1
+#ifndef LWCELL_CFG_CONN_SEND_STREAM_BUFF_LEN
+#define LWCELL_CFG_CONN_SEND_STREAM_BUFF_LEN 64
 #endif
 
 /**
- * \brief           Timeout periodic time to trigger keep alive events to registered callbacks
+ * \brief           Enables `1` or disables `0` typed receive callback of connection
  *
- * Feature must be enabled with \ref LWCELL_CFG_KEEP_ALIVE
+ * Function set with \ref lwcell_conn_set_recv_fn is called with received packet buffer directly
+ * from input processing, instead of \ref LWCELL_EVT_CONN_RECV event through connection event function
+ *
+ * \note            \ref LWCELL_CFG_CONN must be enabled
  */
-#ifndef LWCELL_CFG_KEEP_ALIVE_TIMEOUT
-#define LWCELL_CFG_KEEP_ALIVE_TIMEOUT 1000
+#ifndef LWCELL_CFG_CONN_RECV_FN
+#define LWCELL_CFG_CONN_RECV_FN 0
 #endif
 
 /**
- * \defgroup        LWCELL_OPT_DBG Debugging
- * \brief           Debugging configurations
- * \{
+ * \brief           Maximal number of received packet buffers delivered with single batch receive callback
+ *
+ * Packets of connection with function set by \ref lwcell_conn_set_recv_batch_fn are collected
+ * while single input block is processed and delivered together at its end,
+ * or before any other event of the connection. Set to `0` to disable batch receive
+ *
+ * \note            \ref LWCELL_CFG_CONN_RECV_FN must be enabled when value is greater than `0`
  */
+#ifndef LWCELL_CFG_CONN_RECV_BATCH
+#define LWCELL_CFG_CONN_RECV_BATCH 0
+#endif
 
 /**
- * \brief           Set global debug support.
+ * \brief           Enables `1` or disables `0` link quality aware send chunk sizing and pacing
  *
- * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ * Connection tracks ratio of `SEND OK` and `SEND FAIL` responses and chunk round-trip time.
+ * Failed chunk halves chunk length and delays next chunk, \ref LWCELL_CFG_CONN_SEND_ADAPT_GROW
+ * consecutive confirmed chunks double chunk length back towards maximal length.
+ * Statistics are available with \ref lwcell_conn_get_send_stats
  *
- * \note            Set to \ref LWCELL_DBG_OFF to globally disable all debugs
+ * When disabled, failed chunk only reduces chunk length for the rest of connection lifetime
  */
-#ifndef LWCELL_CFG_DBG
-#define LWCELL_CFG_DBG LWCELL_DBG_OFF
+#ifndef LWCELL_CFG_CONN_SEND_ADAPT
+#define LWCELL_CFG_CONN_SEND_ADAPT 0
 #endif
 
 /**
- * \brief           Debugging output function
+ * \brief           Number of consecutive confirmed chunks before chunk length doubles
+ */
+#ifndef LWCELL_CFG_CONN_SEND_ADAPT_GROW
+#define LWCELL_CFG_CONN_SEND_ADAPT_GROW 4
+#endif
+
+/**
+ * \brief           Maximal delay between chunks in units of milliseconds
  *
- *                  Called with format and optional parameters for printf style debug
+ * Delay starts at half of smoothed chunk round-trip time after failed chunk,
+ * doubles with every next failure and halves with every confirmed chunk
  */
-#ifndef LWCELL_CFG_DBG_OUT
-#define LWCELL_CFG_DBG_OUT(fmt, ...)                                                                                   \
-    do {                                                                                                               \
-        extern int printf(const char* format, ...);                                                                    \
-        printf(fmt, ##__VA_ARGS__);                                                                                    \
-    } while (0)
+#ifndef LWCELL_CFG_CONN_SEND_ADAPT_PACE_MAX
+#define LWCELL_CFG_CONN_SEND_ADAPT_PACE_MAX 1000
 #endif
 
 /**
- * \brief           Minimal debug level
+ * \brief           Enables `1` or disables `0` persistent ring write buffer for \ref lwcell_conn_write
  *
- *                  Check \ref LWCELL_DBG_LVL for possible values
+ * Ring buffer is allocated when connection becomes active and freed when it closes.
+ * Linear blocks of ring memory are sent with `AT+CIPSEND` directly, application may
+ * continue writing while previously written data are being sent.
+ *
+ * When disabled, linear write buffer is allocated on demand and freed after it is sent
  */
-#ifndef LWCELL_CFG_DBG_LVL_MIN
-#define LWCELL_CFG_DBG_LVL_MIN LWCELL_DBG_LVL_ALL
+#ifndef LWCELL_CFG_CONN_WRITE_RING
+#define LWCELL_CFG_CONN_WRITE_RING 0
 #endif
 
 /**
- * \brief           Enabled debug types
+ * \brief           Size of connection ring write buffer in units of bytes
  *
- * When debug is globally enabled with \ref LWCELL_CFG_DBG parameter,
- * user must enable debug types such as TRACE or STATE messages.
+ * Data are sent when at least \ref LWCELL_CFG_CONN_MAX_DATA_LEN bytes are waiting or on flush request
+ */
+#ifndef LWCELL_CFG_CONN_WRITE_RING_LEN
+#define LWCELL_CFG_CONN_WRITE_RING_LEN (2 * LWCELL_CFG_CONN_MAX_DATA_LEN)
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` manual receive mode with backpressure
  *
- * Check \ref LWCELL_DBG_TYPE for possible options. Separate values with `bitwise OR` operator
+ * When enabled, `AT+CIPRXGET=1` is set during network attach.
+ * Device keeps received data in its internal buffer and notifies library with `+CIPRXGET: 1`.
+ * Library reads data with `AT+CIPRXGET=2` only while connection has receive credit available.
+ *
+ * Credit of \ref LWCELL_CFG_CONN_RECV_WINDOW bytes is consumed by data passed to application
+ * and returned with \ref lwcell_conn_recved function, once application processed the data.
+ * With \ref LWCELL_CFG_PBUF_POOL enabled, single read is limited to largest free packet buffer in pools
  */
-#ifndef LWCELL_CFG_DBG_TYPES_ON
-#define LWCELL_CFG_DBG_TYPES_ON 0
+#ifndef LWCELL_CFG_CONN_MANUAL_RECV
+#define LWCELL_CFG_CONN_MANUAL_RECV 0
 #endif
 
 /**
- * \brief           Set debug level for init function
+ * \brief           Receive window of single connection in manual receive mode, in units of bytes
  *
- * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ * Maximal number of received bytes passed to application and not yet confirmed with \ref lwcell_conn_recved.
+ * When using netconn, window shall not exceed what \ref LWCELL_CFG_NETCONN_RECEIVE_QUEUE_LEN packets can hold
+ *
+ * \note            Used only when \ref LWCELL_CFG_CONN_MANUAL_RECV is enabled
  */
-#ifndef LWCELL_CFG_DBG_INIT
-#define LWCELL_CFG_DBG_INIT LWCELL_DBG_OFF
+#ifndef LWCELL_CFG_CONN_RECV_WINDOW
+#define LWCELL_CFG_CONN_RECV_WINDOW (2 * LWCELL_CFG_CONN_MAX_DATA_LEN)
 #endif
 
 /**
- * \brief           Set debug level for memory manager
+ * \brief           Number of `AT+CIPRXGET=2` reads queued in advance in manual receive mode
  *
- * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ * When header of current read reports more data in device buffer,
+ * next read is queued immediately, while current data are still received and processed by application.
+ * Each read reserves its length from receive window, so window shall hold at least `1 + read-ahead` chunks.
+ * Value must be between `0` and `2`
+ *
+ * \note            Used only when \ref LWCELL_CFG_CONN_MANUAL_RECV is enabled
  */
-#ifndef LWCELL_CFG_DBG_MEM
-#define LWCELL_CFG_DBG_MEM LWCELL_DBG_OFF
+#ifndef LWCELL_CFG_CONN_RECV_READ_AHEAD
+#define LWCELL_CFG_CONN_RECV_READ_AHEAD 1
 #endif
 
 /**
- * \brief           Set debug level for input module
+ * \brief           Threshold of data waiting in device buffer of single connection, in units of bytes
+ *
+ * \ref LWCELL_EVT_CONN_RX_PENDING event is sent to connection when number of bytes
+ * reported by device for its buffer crosses the threshold, in either direction.
+ * Set to `0` to disable the event
+ *
+ * \note            Used only when \ref LWCELL_CFG_CONN_MANUAL_RECV is enabled
+ */
+#ifndef LWCELL_CFG_CONN_RX_PENDING_THRESHOLD
+#define LWCELL_CFG_CONN_RX_PENDING_THRESHOLD 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` `AT+CAOPEN` socket commands for connections
+ *
+ * On device models with native socket engine (SIM7070), connections are opened with `AT+CAOPEN`,
+ * data are sent with `AT+CASEND` and read with `AT+CARECV`, instead of `AT+CIPSTART` command family.
+ * Device keeps received data per socket and notifies library with `+CADATAIND`,
+ * reads follow receive credit of \ref LWCELL_CFG_CONN_MANUAL_RECV mode.
+ * Other device models keep using `AT+CIP*` commands.
+ *
+ * \note            PDP context `0` is activated with `AT+CNACT` on first connection start.
+ *                  SSL connections, additional PDP contexts and UDP send to address other than
+ *                  the one used on connection start are not supported with socket commands
+ */
+#ifndef LWCELL_CFG_CONN_CA_SOCKET
+#define LWCELL_CFG_CONN_CA_SOCKET 0
+#endif
+
+/**
+ * \}
+ */
+
+/**
+ * \brief           Default baudrate used for AT port
+ *
+ * \note            Later, user may call API function to change to desired baudrate if necessary
+ */
+#ifndef LWCELL_CFG_AT_PORT_BAUDRATE
+#define LWCELL_CFG_AT_PORT_BAUDRATE 115200
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` AT port baudrate upshift in reset sequence
+ *
+ * After device replies at \ref LWCELL_CFG_AT_PORT_BAUDRATE, stack requests first rate
+ * from \ref LWCELL_CFG_AT_PORT_BAUDRATE_LIST with `AT+IPR`, reconfigures low-level driver
+ * with \ref lwcell_ll_init and verifies the link with `AT` command.
+ * When verification fails, port returns to \ref LWCELL_CFG_AT_PORT_BAUDRATE and next candidate is tried.
+ *
+ * \note            Device must start at \ref LWCELL_CFG_AT_PORT_BAUDRATE after reset,
+ *                  either with auto-bauding or with fixed rate which is not stored to profile
+ */
+#ifndef LWCELL_CFG_AT_PORT_BAUDRATE_UPSHIFT
+#define LWCELL_CFG_AT_PORT_BAUDRATE_UPSHIFT 0
+#endif
+
+/**
+ * \brief           Size of AT port transmit staging buffer in units of bytes
+ *
+ * Command fragments (`AT`, parameters, quotes, commas, `CR/LF`) are collected to the buffer
+ * and passed to low-level send function with single call when command is flushed.
+ * Data larger than the buffer bypasses it and is passed to low-level driver directly.
+ *
+ * Set to `0` to disable staging and call low-level send function for every fragment
+ */
+#ifndef LWCELL_CFG_AT_PORT_TX_BUFF_SIZE
+#define LWCELL_CFG_AT_PORT_TX_BUFF_SIZE 64
+#endif
+
+/**
+ * \brief           Comma separated list of AT port baudrate candidates, from most to least preferred
+ *
+ * \note            Used only when \ref LWCELL_CFG_AT_PORT_BAUDRATE_UPSHIFT is enabled
+ */
+#ifndef LWCELL_CFG_AT_PORT_BAUDRATE_LIST
+#define LWCELL_CFG_AT_PORT_BAUDRATE_LIST 921600, 460800, 230400
+#endif
+
+/**
+ * \brief           Buffer size for received data waiting to be processed
+ * \note            When server mode is active and a lot of connections are in queue
+ *                  this should be set high otherwise your buffer may overflow
+ *
+ * \note            Buffer size also depends on TX user driver if it uses DMA or blocking mode
+ *                  In case of DMA (CPU can work other tasks), buffer may be smaller as CPU
+ *                  will have more time to process all the incoming bytes
+ *
+ * \note            This parameter has no meaning when \ref LWCELL_CFG_INPUT_USE_PROCESS is enabled
+ *
+ * \note            Default value may be overridden at runtime with \ref lwcell_input_set_buff_size.
+ *                  Usage high-water mark and overflows are reported by \ref lwcell_input_get_buff_stats
+ */
+#ifndef LWCELL_CFG_RCV_BUFF_SIZE
+#define LWCELL_CFG_RCV_BUFF_SIZE 0x400
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` automatic enlargement of input buffer on overflow
+ *
+ * When received data do not fit to input buffer, it is replaced with larger one,
+ * up to \ref LWCELL_CFG_RCV_BUFF_MAX_SIZE bytes. Data not processed yet are preserved.
+ *
+ * \note            \ref lwcell_input temporarily takes core lock on overflow,
+ *                  and must not be called from interrupt context when enabled
+ */
+#ifndef LWCELL_CFG_RCV_BUFF_AUTO_GROW
+#define LWCELL_CFG_RCV_BUFF_AUTO_GROW 0
+#endif
+
+/**
+ * \brief           Maximal input buffer size reached by \ref LWCELL_CFG_RCV_BUFF_AUTO_GROW
+ */
+#ifndef LWCELL_CFG_RCV_BUFF_MAX_SIZE
+#define LWCELL_CFG_RCV_BUFF_MAX_SIZE 0x2000
+#endif
+
+/**
+ * \brief           Size of buffer for single received response line, including termination character
+ *
+ * Characters of longer line are not saved, line is parsed with its beginning only.
+ * Truncated lines are counted with \ref LWCELL_CFG_STATS_COUNTERS
+ * and may be consumed in full with \ref LWCELL_CFG_RCV_LINE_STREAM
+ */
+#ifndef LWCELL_CFG_RCV_LINE_SIZE
+#define LWCELL_CFG_RCV_LINE_SIZE 128
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` streaming of lines longer than \ref LWCELL_CFG_RCV_LINE_SIZE
+ *
+ * Callback set with \ref lwcell_input_set_line_stream_fn receives complete long line in chunks,
+ * without larger line buffer allocation
+ */
+#ifndef LWCELL_CFG_RCV_LINE_STREAM
+#define LWCELL_CFG_RCV_LINE_STREAM 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` reset sequence after \ref lwcell_init call
+ *
+ * \note            When this functionality is disabled, user must manually call \ref lwcell_reset to send
+ *                  reset sequence to GSM device.
+ */
+#ifndef LWCELL_CFG_RESET_ON_INIT
+#define LWCELL_CFG_RESET_ON_INIT 1
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` reset sequence after \ref lwcell_device_set_present call
+ *
+ * \note            When this functionality is disabled, user must manually call \ref lwcell_reset to send
+ *                  reset sequence to GSM device.
+ */
+#ifndef LWCELL_CFG_RESET_ON_DEVICE_PRESENT
+#define LWCELL_CFG_RESET_ON_DEVICE_PRESENT 1
+#endif
+
+/**
+ * \brief           Default delay (milliseconds unit) before sending first AT command on reset sequence
+ */
+#ifndef LWCELL_CFG_RESET_DELAY_DEFAULT
+#define LWCELL_CFG_RESET_DELAY_DEFAULT 1000
+#endif
+
+/**
+ * \brief           Default delay (milliseconds unit) after reset sequence
+ */
+#ifndef LWCELL_CFG_RESET_DELAY_AFTER
+#define LWCELL_CFG_RESET_DELAY_AFTER 5000
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` fast-boot reset sequence
+ *
+ * Stack does not wait fixed \ref LWCELL_CFG_RESET_DELAY_AFTER time after reset.
+ * Instead, first command is repeated every \ref LWCELL_CFG_RESET_POLL_INTERVAL milliseconds
+ * until device replies, for maximum of \ref LWCELL_CFG_RESET_DELAY_AFTER time.
+ *
+ * When identity function is set with \ref lwcell_device_set_identity_fn,
+ * only serial number is queried from device. Manufacturer, model and revision queries
+ * are skipped when serial number matches persisted identity
+ */
+#ifndef LWCELL_CFG_RESET_FAST_BOOT
+#define LWCELL_CFG_RESET_FAST_BOOT 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` cached operator selection after reset
+ *
+ * When cache function is set with \ref lwcell_operator_set_cache_fn,
+ * operator of last successful registration (numeric PLMN) is passed to application to persist it.
+ * After reset sequence, operator is selected with `AT+COPS=4,2,<plmn>`, manual mode with automatic fallback,
+ * which avoids full automatic network search on roaming SIM cards.
+ * When no operator is cached, numeric operator format is selected to learn it on first registration
+ */
+#ifndef LWCELL_CFG_OPERATOR_CACHE
+#define LWCELL_CFG_OPERATOR_CACHE 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` warm-restart snapshot of stack state
+ *
+ * Application saves device identity, SIM, network, SMS and phonebook memory state
+ * and active connections with \ref lwcell_snapshot_save to memory retained during MCU deep sleep.
+ * After wake-up, \ref lwcell_snapshot_restore applies saved state and resynchronizes it
+ * with few status queries, while device stays registered and attached, without reset sequence.
+ *
+ * \note            \ref LWCELL_CFG_RESET_ON_INIT must be disabled.
+ *                  Application calls \ref lwcell_reset on cold start and \ref lwcell_snapshot_restore on wake-up
+ */
+#ifndef LWCELL_CFG_SNAPSHOT
+#define LWCELL_CFG_SNAPSHOT 0
+#endif
+
+/**
+ * \brief           Interval (milliseconds unit) between device polls in fast-boot reset sequence
+ *
+ * \note            Used only when \ref LWCELL_CFG_RESET_FAST_BOOT is enabled
+ */
+#ifndef LWCELL_CFG_RESET_POLL_INTERVAL
+#define LWCELL_CFG_RESET_POLL_INTERVAL 100
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` cached device information reads
+ *
+ * Device manufacturer, model, revision and serial number are read during reset sequence.
+ * When enabled, `lwcell_device_get_*` functions return these values immediately,
+ * without command to device. Device is queried only when value is not known yet
+ * or when \ref lwcell_device_info_refresh is called
+ */
+#ifndef LWCELL_CFG_DEVICE_INFO_CACHE
+#define LWCELL_CFG_DEVICE_INFO_CACHE 0
+#endif
+
+/**
+ * \brief           Device model application is built for
+ *
+ * Set to member of \ref lwcell_device_model_t enumeration, for example `LWCELL_DEVICE_MODEL_SIM800x`,
+ * to fix device model at compile time. Model capabilities from `lwcell_models.h` table
+ * then resolve to constants and code paths for other models are removed by compiler.
+ *
+ * Keep at `LWCELL_DEVICE_MODEL_UNKNOWN` to detect model from device at runtime
+ */
+#ifndef LWCELL_CFG_DEVICE_MODEL
+#define LWCELL_CFG_DEVICE_MODEL LWCELL_DEVICE_MODEL_UNKNOWN
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` periodic keep-alive events to registered callbacks
+ *
+ * Keep-alive timeout runs only while at least one registered callback function
+ * is subscribed to \ref LWCELL_EVT_KEEP_ALIVE event, see \ref lwcell_evt_register_ex.
+ */
+#ifndef LWCELL_CFG_KEEP_ALIVE
+#define LWCELL_CFG_KEEP_ALIVE 1
+#endif
+
+/**
+ * \brief           Timeout periodic time to trigger keep alive events to registered callbacks
+ *
+ * Feature must be enabled with \ref LWCELL_CFG_KEEP_ALIVE
+ */
+#ifndef LWCELL_CFG_KEEP_ALIVE_TIMEOUT
+#define LWCELL_CFG_KEEP_ALIVE_TIMEOUT 1000
+#endif
+
+/**
+ * \brief           Timeout slack in units of milliseconds
+ *
+ * Timeouts may expire up to this time later than requested.
+ * Processing thread waits until slack of the earliest timeout is over
+ * and then processes all expired ones together, which reduces number of wake-ups
+ * when timeouts are close to each other. Set to `0` to process each timeout on time.
+ *
+ * \note            See \ref lwcell_timeout_get_next_diff for tickless idle integration
+ */
+#ifndef LWCELL_CFG_TIMEOUT_SLACK
+#define LWCELL_CFG_TIMEOUT_SLACK 0
+#endif
+
+/**
+ * \defgroup        LWCELL_OPT_DBG Debugging
+ * \brief           Debugging configurations
+ * \{
+ */
+
+/**
+ * \brief           Set global debug support.
+ *
+ * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ *
+ * \note            Set to \ref LWCELL_DBG_OFF to globally disable all debugs
+ */
+#ifndef LWCELL_CFG_DBG
+#define LWCELL_CFG_DBG LWCELL_DBG_OFF
+#endif
+
+/**
+ * \brief           Debugging output function
+ *
+ *                  Called with format and optional parameters for printf style debug
+ */
+#ifndef LWCELL_CFG_DBG_OUT
+#define LWCELL_CFG_DBG_OUT(fmt, ...)                                                                                   \
+    do {                                                                                                               \
+        extern int printf(const char* format, ...);                                                                    \
+        printf(fmt, ##__VA_ARGS__);                                                                                    \
+    } while (0)
+#endif
+
+/**
+ * \brief           Minimal debug level
+ *
+ *                  Check \ref LWCELL_DBG_LVL for possible values
+ */
+#ifndef LWCELL_CFG_DBG_LVL_MIN
+#define LWCELL_CFG_DBG_LVL_MIN LWCELL_DBG_LVL_ALL
+#endif
+
+/**
+ * \brief           Enabled debug types
+ *
+ * When debug is globally enabled with \ref LWCELL_CFG_DBG parameter,
+ * user must enable debug types such as TRACE or STATE messages.
+ *
+ * Check \ref LWCELL_DBG_TYPE for possible options. Separate values with `bitwise OR` operator
+ */
+#ifndef LWCELL_CFG_DBG_TYPES_ON
+#define LWCELL_CFG_DBG_TYPES_ON 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` deferred binary debug logging
+ *
+ * When enabled, \ref LWCELL_DEBUGF does not format the message in the calling thread.
+ * Format string address and raw arguments are recorded into ring buffer instead,
+ * and formatted later by \ref lwcell_debug_deferred_flush (or debug thread),
+ * or exported with \ref lwcell_debug_deferred_read for decoding on the host.
+ *
+ * Debug types and levels are filtered at compile time exactly as for direct output.
+ *
+ * \note            String arguments are copied at record time,
+ *                  up to \ref LWCELL_CFG_DBG_DEFERRED_STR_MAX_LEN characters
+ */
+#ifndef LWCELL_CFG_DBG_DEFERRED
+#define LWCELL_CFG_DBG_DEFERRED 0
+#endif
+
+/**
+ * \brief           Size of deferred debug ring buffer in units of bytes
+ *
+ * Records that do not fit are dropped and counted.
+ *
+ * \note            Used only when \ref LWCELL_CFG_DBG_DEFERRED is enabled
+ */
+#ifndef LWCELL_CFG_DBG_DEFERRED_BUFF_SIZE
+#define LWCELL_CFG_DBG_DEFERRED_BUFF_SIZE 0x800
+#endif
+
+/**
+ * \brief           Maximal length of single record, or formatted output line, in units of bytes
+ *
+ * \note            Used only when \ref LWCELL_CFG_DBG_DEFERRED is enabled
+ */
+#ifndef LWCELL_CFG_DBG_DEFERRED_REC_MAX_LEN
+#define LWCELL_CFG_DBG_DEFERRED_REC_MAX_LEN 128
+#endif
+
+/**
+ * \brief           Maximal number of characters copied for every string argument
+ *
+ * \note            Used only when \ref LWCELL_CFG_DBG_DEFERRED is enabled
+ */
+#ifndef LWCELL_CFG_DBG_DEFERRED_STR_MAX_LEN
+#define LWCELL_CFG_DBG_DEFERRED_STR_MAX_LEN 32
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` debug thread which formats deferred records
+ *
+ * When disabled, application shall periodically call \ref lwcell_debug_deferred_flush
+ * or \ref lwcell_debug_deferred_read, for example from idle task.
+ *
+ * \note            Used only when \ref LWCELL_CFG_DBG_DEFERRED is enabled
+ */
+#ifndef LWCELL_CFG_DBG_DEFERRED_THREAD
+#define LWCELL_CFG_DBG_DEFERRED_THREAD 1
+#endif
+
+/**
+ * \brief           Priority of debug thread, should be lower than stack threads
+ *
+ * \note            Used only when \ref LWCELL_CFG_DBG_DEFERRED_THREAD is enabled
+ */
+#ifndef LWCELL_CFG_DBG_DEFERRED_THREAD_PRIO
+#define LWCELL_CFG_DBG_DEFERRED_THREAD_PRIO (LWCELL_SYS_THREAD_PRIO)
+#endif
+
+/**
+ * \brief           Period in units of milliseconds for debug thread to format pending records
+ *
+ * \note            Used only when \ref LWCELL_CFG_DBG_DEFERRED_THREAD is enabled
+ */
+#ifndef LWCELL_CFG_DBG_DEFERRED_THREAD_PERIOD
+#define LWCELL_CFG_DBG_DEFERRED_THREAD_PERIOD 20
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` runtime debug filter
+ *
+ * Messages that pass compile-time filter are additionally filtered with
+ * types and minimal level set by \ref lwcell_debug_set_mask.
+ * Check is single test of global mask with constant bit, before any argument is evaluated,
+ * which allows production build to keep debug messages compiled in and disabled.
+ *
+ * Combined with \ref LWCELL_CFG_DBG_DEFERRED, enabled messages are recorded in binary form,
+ * so cost of enabled tracing stays low too.
+ *
+ * \note            Set \ref LWCELL_CFG_DBG_TYPES_ON and \ref LWCELL_CFG_DBG_LVL_MIN
+ *                  to all messages that may be needed at runtime
+ */
+#ifndef LWCELL_CFG_DBG_RUNTIME
+#define LWCELL_CFG_DBG_RUNTIME 0
+#endif
+
+/**
+ * \brief           Debug types enabled at startup, when runtime debug filter is used
+ *
+ * Check \ref LWCELL_DBG_TYPE for possible options. Minimal level at startup is \ref LWCELL_CFG_DBG_LVL_MIN
+ *
+ * \note            Used only when \ref LWCELL_CFG_DBG_RUNTIME is enabled
+ */
+#ifndef LWCELL_CFG_DBG_RUNTIME_TYPES_ON
+#define LWCELL_CFG_DBG_RUNTIME_TYPES_ON 0
+#endif
+
+/**
+ * \brief           Set debug level for init function
+ *
+ * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ */
+#ifndef LWCELL_CFG_DBG_INIT
+#define LWCELL_CFG_DBG_INIT LWCELL_DBG_OFF
+#endif
+
+/**
+ * \brief           Set debug level for memory manager
+ *
+ * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ */
+#ifndef LWCELL_CFG_DBG_MEM
+#define LWCELL_CFG_DBG_MEM LWCELL_DBG_OFF
+#endif
+
+/**
+ * \brief           Set debug level for input module
+ *
+ * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ */
+#ifndef LWCELL_CFG_DBG_INPUT
+#define LWCELL_CFG_DBG_INPUT LWCELL_DBG_OFF
+#endif
+
+/**
+ * \brief           Set debug level for GSM threads
+ *
+ * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ */
+#ifndef LWCELL_CFG_DBG_THREAD
+#define LWCELL_CFG_DBG_THREAD LWCELL_DBG_OFF
+#endif
+
+/**
+ * \brief           Set debug level for asserting of input variables
+ *
+ * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ */
+#ifndef LWCELL_CFG_DBG_ASSERT
+#define LWCELL_CFG_DBG_ASSERT LWCELL_DBG_OFF
+#endif
+
+/**
+ * \brief           Set debug level for incoming data received from device
+ *
+ * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ */
+#ifndef LWCELL_CFG_DBG_IPD
+#define LWCELL_CFG_DBG_IPD LWCELL_DBG_OFF
+#endif
+
+/**
+ * \brief           Set debug level for packet buffer manager
+ *
+ * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ */
+#ifndef LWCELL_CFG_DBG_PBUF
+#define LWCELL_CFG_DBG_PBUF LWCELL_DBG_OFF
+#endif
+
+/**
+ * \brief           Set debug level for connections
+ *
+ * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ */
+#ifndef LWCELL_CFG_DBG_CONN
+#define LWCELL_CFG_DBG_CONN LWCELL_DBG_OFF
+#endif
+
+/**
+ * \brief           Set debug level for dynamic variable allocations
+ *
+ * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ */
+#ifndef LWCELL_CFG_DBG_VAR
+#define LWCELL_CFG_DBG_VAR LWCELL_DBG_OFF
+#endif
+
+/**
+ * \brief           Set debug level for netconn sequential API
+ *
+ * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ */
+#ifndef LWCELL_CFG_DBG_NETCONN
+#define LWCELL_CFG_DBG_NETCONN LWCELL_DBG_OFF
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` echo mode on AT commands
+ *                  sent to GSM device.
+ *
+ * \note            This mode is useful when debugging GSM communication
+ */
+#ifndef LWCELL_CFG_AT_ECHO
+#define LWCELL_CFG_AT_ECHO 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` skipping of command echo in received data
+ *
+ * When \ref LWCELL_CFG_AT_ECHO is enabled, device repeats every sent command.
+ * Echo is matched against recently sent command and dropped before line parsing.
+ * Skipped lines may be observed with callback set by \ref lwcell_input_set_echo_tap_fn
+ *
+ * \note            Requires \ref LWCELL_CFG_AT_ECHO to be enabled
+ */
+#ifndef LWCELL_CFG_AT_ECHO_SKIP
+#define LWCELL_CFG_AT_ECHO_SKIP 0
+#endif
+
+/**
+ * \brief           Number of characters of sent command remembered for echo matching
+ *
+ * Commands longer than this are matched by their beginning, rest of echoed line is skipped
+ *
+ * \note            Used only when \ref LWCELL_CFG_AT_ECHO_SKIP is enabled
+ */
+#ifndef LWCELL_CFG_AT_ECHO_SKIP_LEN
+#define LWCELL_CFG_AT_ECHO_SKIP_LEN 64
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` command latency statistics
+ *
+ * When enabled, time of each command phase (waiting in queue, device turnaround and response parsing)
+ * is measured and collected in histograms per command type, available with \ref lwcell_stats_get function.
+ *
+ * \note            Resolution of measurements is the one of \ref lwcell_sys_now function
+ */
+#ifndef LWCELL_CFG_STATS
+#define LWCELL_CFG_STATS 0
+#endif
+
+/**
+ * \brief           Maximal number of different command types tracked by statistics
+ *
+ * Entry is assigned to command type on its first execution.
+ * When all entries are used, other command types are not tracked
+ */
+#ifndef LWCELL_CFG_STATS_CMD_MAX
+#define LWCELL_CFG_STATS_CMD_MAX 16
+#endif
+
+/**
+ * \brief           Number of latency histogram buckets per phase
+ *
+ * Bucket `0` counts samples of `0` ms, bucket `i` counts samples from `2^(i-1)` to `2^i - 1` ms.
+ * Last bucket counts all longer samples
+ */
+#ifndef LWCELL_CFG_STATS_HIST_BUCKETS
+#define LWCELL_CFG_STATS_HIST_BUCKETS 16
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` byte and event throughput counters
+ *
+ * When enabled, library counts received and transmitted bytes, parsed lines, events by type
+ * and failures on fast paths, available with \ref lwcell_stats_get_counters function.
+ * Counters are plain `32-bit` integers and wrap around on overflow
+ */
+#ifndef LWCELL_CFG_STATS_COUNTERS
+#define LWCELL_CFG_STATS_COUNTERS 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` stack and run time reporting of library threads
+ *
+ * When enabled, \ref lwcell_stats_get_thread reports stack high-water mark and accumulated run time
+ * of producer, processing and event threads, as provided by \ref lwcell_sys_thread_get_info function.
+ *
+ * \note            System port must implement \ref lwcell_sys_thread_get_info function
+ */
+#ifndef LWCELL_CFG_STATS_THREADS
+#define LWCELL_CFG_STATS_THREADS 0
+#endif
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup        LWCELL_OPT_OS OS configuration
+ * \brief           Operating system dependant configuration
+ * \{
+ */
+
+/**
+ * \brief           Set number of message queue entries for procuder thread
+ *
+ * Message queue is used for storing memory address to command data
+ */
+#ifndef LWCELL_CFG_THREAD_PRODUCER_MBOX_SIZE
+#define LWCELL_CFG_THREAD_PRODUCER_MBOX_SIZE 16
+#endif
+
+/**
+ * \brief           Set number of message queue entries for priority lane of procuder thread
+ *
+ * When set to value greater than `0`, messages marked as priority (data-path, such as connection send)
+ * are put to separate queue, which producer thread always serves before regular (management) queue.
+ * Command, already being executed, is not interrupted.
+ *
+ * Set to `0` to disable priority lane and use single queue for all messages
+ */
+#ifndef LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE
+#define LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` admission control of producer queue
+ *
+ * Number of commands waiting in producer queue is counted per priority, with limit for each.
+ * Command above the limit is rejected with \ref lwcellERRMEM immediately, also in blocking mode,
+ * instead of waiting for free space in queue. Applications check depth with \ref lwcell_producer_check
+ * before submission, to shed or merge load themselves.
+ *
+ * Regular and priority commands are counted separately, also when priority lane
+ * is disabled with \ref LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE
+ */
+#ifndef LWCELL_CFG_PRODUCER_ADMISSION
+#define LWCELL_CFG_PRODUCER_ADMISSION 0
+#endif
+
+/**
+ * \brief           Default limit of regular commands waiting in producer queue
+ *
+ * \note            Used only when \ref LWCELL_CFG_PRODUCER_ADMISSION is enabled.
+ *                  Limit may be changed with \ref lwcell_producer_set_limit
+ */
+#ifndef LWCELL_CFG_PRODUCER_LIMIT
+#define LWCELL_CFG_PRODUCER_LIMIT LWCELL_CFG_THREAD_PRODUCER_MBOX_SIZE
+#endif
+
+/**
+ * \brief           Default limit of priority commands waiting in producer queue
+ *
+ * \note            Used only when \ref LWCELL_CFG_PRODUCER_ADMISSION is enabled.
+ *                  Limit may be changed with \ref lwcell_producer_set_limit
+ */
+#ifndef LWCELL_CFG_PRODUCER_PRIO_LIMIT
+#if LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0
+#define LWCELL_CFG_PRODUCER_PRIO_LIMIT LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE
+#else /* LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0 */
+#define LWCELL_CFG_PRODUCER_PRIO_LIMIT LWCELL_CFG_THREAD_PRODUCER_MBOX_SIZE
+#endif /* !(LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0) */
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` adaptive command timeouts and stall detection
+ *
+ * Producer thread keeps smoothed turnaround time and its deviation for every command type,
+ * learned from successfully finished commands.
+ * When enough samples are collected, command waits in windows of
+ * \ref LWCELL_CFG_CMD_TIMEOUT_ADAPT_MUL times learned high-percentile turnaround.
+ * If no byte is received from device during whole window, device is considered stalled
+ * and command is aborted early with \ref lwcellTIMEOUT, instead of waiting its full blocking time.
+ * Command that receives data keeps waiting up to its original blocking time.
+ *
+ * After every timed-out command, device is probed with `AT` command.
+ * If \ref LWCELL_CFG_CMD_STALL_PROBES consecutive probes time out, device reset is queued.
+ *
+ * \note            This mode can only be used when \ref LWCELL_CFG_OS is enabled
+ */
+#ifndef LWCELL_CFG_CMD_TIMEOUT_ADAPT
+#define LWCELL_CFG_CMD_TIMEOUT_ADAPT 0
+#endif
+
+/**
+ * \brief           Maximal number of different command types with adaptive timeout profile
+ *
+ * Profile is assigned to command type on its first successful execution.
+ * When all profiles are used, other command types always wait their full blocking time
+ */
+#ifndef LWCELL_CFG_CMD_TIMEOUT_ADAPT_CMD_MAX
+#define LWCELL_CFG_CMD_TIMEOUT_ADAPT_CMD_MAX 16
+#endif
+
+/**
+ * \brief           Number of successful executions before timeout of command type is adapted
+ */
+#ifndef LWCELL_CFG_CMD_TIMEOUT_ADAPT_SAMPLES
+#define LWCELL_CFG_CMD_TIMEOUT_ADAPT_SAMPLES 8
+#endif
+
+/**
+ * \brief           Multiplier of learned turnaround time for stall detection window
+ */
+#ifndef LWCELL_CFG_CMD_TIMEOUT_ADAPT_MUL
+#define LWCELL_CFG_CMD_TIMEOUT_ADAPT_MUL 4
+#endif
+
+/**
+ * \brief           Minimal stall detection window in units of milliseconds
+ */
+#ifndef LWCELL_CFG_CMD_TIMEOUT_ADAPT_MIN
+#define LWCELL_CFG_CMD_TIMEOUT_ADAPT_MIN 2000
+#endif
+
+/**
+ * \brief           Number of consecutive `AT` probes without response before device is reset
+ *
+ * Set to `0` to disable probing and reset after command timeout
+ */
+#ifndef LWCELL_CFG_CMD_STALL_PROBES
+#define LWCELL_CFG_CMD_STALL_PROBES 3
+#endif
+
+/**
+ * \brief           Timeout of single `AT` probe in units of milliseconds
+ */
+#ifndef LWCELL_CFG_CMD_STALL_PROBE_TIMEOUT
+#define LWCELL_CFG_CMD_STALL_PROBE_TIMEOUT 1000
+#endif
+
+/**
+ * \brief           Set number of message queue entries for processing thread
+ *
+ * Message queue is used to notify processing thread about new received data on AT port
+ */
+#ifndef LWCELL_CFG_THREAD_PROCESS_MBOX_SIZE
+#define LWCELL_CFG_THREAD_PROCESS_MBOX_SIZE 16
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` notification based wake-up of processing thread
+ *
+ * When enabled, processing thread waits on system notification object
+ * instead of message queue. Multiple wake-ups from \ref lwcell_input and timeouts
+ * are coalesced to single one, and thread processes full input buffer after it wakes up.
+ *
+ * \note            System port must implement notification functions, see \ref LWCELL_SYS_NOTIFY.
+ *                  \ref LWCELL_CFG_THREAD_PROCESS_MBOX_SIZE has no meaning when this mode is enabled
+ */
+#ifndef LWCELL_CFG_THREAD_PROCESS_NOTIFY
+#define LWCELL_CFG_THREAD_PROCESS_NOTIFY 0
+#endif
+
+/**
+ * \brief           Priority of producer thread
+ *
+ * \note            Not to be confused with producer priority lane, see \ref LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE
+ */
+#ifndef LWCELL_CFG_THREAD_PRODUCER_PRIO
+#define LWCELL_CFG_THREAD_PRODUCER_PRIO (LWCELL_SYS_THREAD_PRIO)
+#endif
+
+/**
+ * \brief           Stack size of producer thread in units of bytes
+ */
+#ifndef LWCELL_CFG_THREAD_PRODUCER_STACK_SIZE
+#define LWCELL_CFG_THREAD_PRODUCER_STACK_SIZE (LWCELL_SYS_THREAD_SS)
+#endif
+
+/**
+ * \brief           Priority of processing thread
+ */
+#ifndef LWCELL_CFG_THREAD_PROCESS_PRIO
+#define LWCELL_CFG_THREAD_PROCESS_PRIO (LWCELL_SYS_THREAD_PRIO)
+#endif
+
+/**
+ * \brief           Stack size of processing thread in units of bytes
+ */
+#ifndef LWCELL_CFG_THREAD_PROCESS_STACK_SIZE
+#define LWCELL_CFG_THREAD_PROCESS_STACK_SIZE (LWCELL_SYS_THREAD_SS)
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` core affinity of library threads
+ *
+ * When enabled, threads with core number `>= 0`, see \ref LWCELL_CFG_THREAD_PRODUCER_CORE,
+ * \ref LWCELL_CFG_THREAD_PROCESS_CORE and \ref LWCELL_CFG_EVT_DEFERRED_THREAD_CORE,
+ * are created with \ref lwcell_sys_thread_create_pinned function.
+ *
+ * \note            System port must implement \ref lwcell_sys_thread_create_pinned function
+ */
+#ifndef LWCELL_CFG_THREAD_AFFINITY
+#define LWCELL_CFG_THREAD_AFFINITY 0
+#endif
+
+/**
+ * \brief           Core number of producer thread, `-1` to let scheduler select the core
+ *
+ * \note            Used only when \ref LWCELL_CFG_THREAD_AFFINITY is enabled
+ */
+#ifndef LWCELL_CFG_THREAD_PRODUCER_CORE
+#define LWCELL_CFG_THREAD_PRODUCER_CORE -1
+#endif
+
+/**
+ * \brief           Core number of processing thread, `-1` to let scheduler select the core
+ *
+ * \note            Used only when \ref LWCELL_CFG_THREAD_AFFINITY is enabled
+ */
+#ifndef LWCELL_CFG_THREAD_PROCESS_CORE
+#define LWCELL_CFG_THREAD_PROCESS_CORE -1
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` priority boost of processing thread while connection data are read
+ *
+ * Processing thread runs with \ref LWCELL_CFG_THREAD_PROCESS_IPD_PRIO from `+RECEIVE` header
+ * until all announced data bytes are processed, to empty receive queue before it overflows.
+ *
+ * \note            System port must implement \ref lwcell_sys_thread_set_prio function.
+ *                  Not available with \ref LWCELL_CFG_INPUT_USE_PROCESS, as data are processed in caller thread,
+ *                  use \ref LWCELL_THREAD_PROCESS_IPD_HOOK instead
+ */
+#ifndef LWCELL_CFG_THREAD_PROCESS_IPD_BOOST
+#define LWCELL_CFG_THREAD_PROCESS_IPD_BOOST 0
+#endif
+
+/**
+ * \brief           Priority of processing thread while connection data are read
+ *
+ * \note            Used only when \ref LWCELL_CFG_THREAD_PROCESS_IPD_BOOST is enabled
+ */
+#ifndef LWCELL_CFG_THREAD_PROCESS_IPD_PRIO
+#define LWCELL_CFG_THREAD_PROCESS_IPD_PRIO (LWCELL_CFG_THREAD_PROCESS_PRIO)
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` deferred event delivery in separate dispatch thread
+ *
+ * Callback functions marked with \ref lwcell_evt_set_deferred receive copy of event
+ * in event dispatch thread, without core lock held. Processing thread only queues the event,
+ * parsing of received data therefore does not wait for application code.
+ *
+ * \note            Packet buffer of \ref LWCELL_EVT_CONN_RECV event is referenced until callback returns.
+ *                  When queue is full, event is delivered directly in processing thread
+ */
+#ifndef LWCELL_CFG_EVT_DEFERRED
+#define LWCELL_CFG_EVT_DEFERRED 0
+#endif
+
+/**
+ * \brief           Deferred event queue size, maximal number of pending events
+ *
+ * \note            Used only when \ref LWCELL_CFG_EVT_DEFERRED is enabled
+ */
+#ifndef LWCELL_CFG_EVT_DEFERRED_QUEUE_SIZE
+#define LWCELL_CFG_EVT_DEFERRED_QUEUE_SIZE 16
+#endif
+
+/**
+ * \brief           Maximal number of callback functions marked for deferred delivery
+ *
+ * \note            Used only when \ref LWCELL_CFG_EVT_DEFERRED is enabled
+ */
+#ifndef LWCELL_CFG_EVT_DEFERRED_FN_MAX
+#define LWCELL_CFG_EVT_DEFERRED_FN_MAX 4
+#endif
+
+/**
+ * \brief           Priority of event dispatch thread
+ *
+ * \note            Used only when \ref LWCELL_CFG_EVT_DEFERRED is enabled
+ */
+#ifndef LWCELL_CFG_EVT_DEFERRED_THREAD_PRIO
+#define LWCELL_CFG_EVT_DEFERRED_THREAD_PRIO (LWCELL_SYS_THREAD_PRIO)
+#endif
+
+/**
+ * \brief           Stack size of event dispatch thread in units of bytes
+ *
+ * \note            Used only when \ref LWCELL_CFG_EVT_DEFERRED is enabled
+ */
+#ifndef LWCELL_CFG_EVT_DEFERRED_THREAD_STACK_SIZE
+#define LWCELL_CFG_EVT_DEFERRED_THREAD_STACK_SIZE (LWCELL_SYS_THREAD_SS)
+#endif
+
+/**
+ * \brief           Core number of event dispatch thread, `-1` to let scheduler select the core
+ *
+ * \note            Used only when \ref LWCELL_CFG_EVT_DEFERRED and \ref LWCELL_CFG_THREAD_AFFINITY are enabled
+ */
+#ifndef LWCELL_CFG_EVT_DEFERRED_THREAD_CORE
+#define LWCELL_CFG_EVT_DEFERRED_THREAD_CORE -1
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` direct support for processing input data
+ *
+ * When this mode is enabled, no overhead is included for copying data
+ * to receive buffer because bytes are processed directly.
+ *
+ * \note            This mode can only be used when \ref LWCELL_CFG_OS is enabled
+ *
+ * \note            When using this mode, separate thread must be dedicated only
+ *                  for reading data on AT port
+ *
+ * \note            Best case for using this mode is if DMA receive is supported by host device
+ */
+#ifndef LWCELL_CFG_INPUT_USE_PROCESS
+#define LWCELL_CFG_INPUT_USE_PROCESS 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` lock-free input buffer
+ *
+ * When enabled, read and write indexes of input buffer are C11 atomic variables,
+ * accessed with acquire/release ordering. Buffer is then safe for single producer
+ * and single consumer without external locking, so \ref lwcell_input
+ * may be called directly from UART interrupt.
+ *
+ * Processing thread is notified only when it has not been notified yet
+ * since it last started processing the buffer, instead of on every \ref lwcell_input call.
+ *
+ * \note            Compiler must support C11 `stdatomic.h`
+ * \note            \ref lwcell_sys_mbox_putnow must be safe to call from interrupt context
+ * \note            This parameter has no meaning when \ref LWCELL_CFG_INPUT_USE_PROCESS is enabled
+ */
+#ifndef LWCELL_CFG_INPUT_BUFF_ATOMIC
+#define LWCELL_CFG_INPUT_BUFF_ATOMIC 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` power-of-two ring buffers
+ *
+ * Size of every \ref LWCELL_BUFF buffer is rounded up to power of two.
+ * Read and write indexes are free-running and wrapped with mask,
+ * so free and full space are computed with single subtraction
+ * and whole buffer size is available for data.
+ *
+ * \note            Buffers use up to `2x` more memory, when configured sizes are not power of two
+ */
+#ifndef LWCELL_CFG_BUFF_POW2
+#define LWCELL_CFG_BUFF_POW2 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` \ref lwcell_input_from_isr function
+ *
+ * Low-level driver writes received data to lock-free input buffer directly
+ * from UART or DMA interrupt and processing thread is woken-up with interrupt variant
+ * of system function, \ref lwcell_sys_mbox_putnow_from_isr or \ref lwcell_sys_notify_post_from_isr.
+ * No separate driver thread is needed to forward received data to the library.
+ *
+ * \note            \ref LWCELL_CFG_INPUT_BUFF_ATOMIC must be enabled
+ *                  and \ref LWCELL_CFG_INPUT_USE_PROCESS disabled to use this mode
+ */
+#ifndef LWCELL_CFG_INPUT_FROM_ISR
+#define LWCELL_CFG_INPUT_FROM_ISR 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` zero-copy receive of connection data
+ *
+ * When enabled, low-level driver may lend its receive memory with \ref lwcell_input_process_ref.
+ * Connection data fully available in lent memory are passed to application as reference packet buffers,
+ * created with \ref lwcell_pbuf_new_ref, without copying them to newly allocated memory.
+ * Driver is notified with release callback when application frees packet buffer.
+ *
+ * \note            Driver must not overwrite lent memory until it is released.
+ *                  Drivers with circular RX DMA, which cannot be held back, must keep using \ref lwcell_input_process
+ *
+ * \note            This mode can only be used when \ref LWCELL_CFG_INPUT_USE_PROCESS is enabled
+ */
+#ifndef LWCELL_CFG_INPUT_ZERO_COPY
+#define LWCELL_CFG_INPUT_ZERO_COPY 0
+#endif
+
+/**
+ * \brief           Producer thread hook, called each time thread wakes-up and does the processing.
+ *
+ * It can be used to check if thread is alive.
+ */
+#ifndef LWCELL_THREAD_PRODUCER_HOOK
+#define LWCELL_THREAD_PRODUCER_HOOK()
+#endif
+
+/**
+ * \brief           Process thread hook, called each time thread wakes-up and does the processing.
+ *
+ * It can be used to check if thread is alive.
+ */
+#ifndef LWCELL_THREAD_PROCESS_HOOK
+#define LWCELL_THREAD_PROCESS_HOOK()
+#endif
+
+/**
+ * \brief           Connection data read hook, called when reading of `+RECEIVE` data starts and ends.
+ *
+ * It is called from the thread processing input data, with core locked.
+ * It can be used to raise priority of the thread while data are read.
+ *
+ * \param[in]       active: `1` when read starts, `0` when it ends
+ */
+#ifndef LWCELL_THREAD_PROCESS_IPD_HOOK
+#define LWCELL_THREAD_PROCESS_IPD_HOOK(active)
+#endif
+
+/**
+ * \brief           Timeline trace hook, called at begin and end of traced stack operations.
+ *
+ * It is called from the thread executing the operation, mostly with core locked,
+ * and must not call any library function.
+ * It can be used to record timestamped spans, for example to export them in Chrome trace format,
+ * or to measure CPU cycles of pipeline stages on target, see `system/lwcell_prof_dwt.h`.
+ * Hook compiles to nothing when it is not defined.
+ *
+ * \param[in]       point: Traced operation, member of \ref lwcell_trace_point_t enumeration
+ * \param[in]       phase: Trace phase, member of \ref lwcell_trace_phase_t enumeration
+ * \param[in]       val: Operation specific value, see \ref lwcell_trace_point_t
+ */
+#ifndef LWCELL_TRACE_HOOK
+#define LWCELL_TRACE_HOOK(point, phase, val)
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` custom memory byte pool extension for ThreadX port
+ *
+ * When enabled, user must manually set byte pool at run-time, before \ref lwcell_init is called
+ */
+#ifndef LWCELL_CFG_THREADX_CUSTOM_MEM_BYTE_POOL
+#define LWCELL_CFG_THREADX_CUSTOM_MEM_BYTE_POOL 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` block pools for fixed-size objects in ThreadX memory port
+ *
+ * Small objects, such as packet buffer headers, command messages and full-size
+ * packet buffers with \ref LWCELL_CFG_CONN_MAX_DATA_LEN payload are allocated from `TX_BLOCK_POOL`
+ * with smallest fitting block size, in constant time.
+ * Other allocations, or allocations when block pool is exhausted, use byte pool
+ */
+#ifndef LWCELL_CFG_THREADX_MEM_BLOCK_POOLS
+#define LWCELL_CFG_THREADX_MEM_BLOCK_POOLS 0
+#endif
+
+/**
+ * \brief           Block size in units of bytes of small objects block pool
+ *
+ * \note            Used only when \ref LWCELL_CFG_THREADX_MEM_BLOCK_POOLS is enabled
+ */
+#ifndef LWCELL_CFG_THREADX_MEM_BLOCK_SMALL_SIZE
+#define LWCELL_CFG_THREADX_MEM_BLOCK_SMALL_SIZE 64
+#endif
+
+/**
+ * \brief           Number of blocks in small objects block pool
+ *
+ * \note            Used only when \ref LWCELL_CFG_THREADX_MEM_BLOCK_POOLS is enabled
+ */
+#ifndef LWCELL_CFG_THREADX_MEM_BLOCK_SMALL_COUNT
+#define LWCELL_CFG_THREADX_MEM_BLOCK_SMALL_COUNT 16
+#endif
+
+/**
+ * \brief           Number of blocks in command message block pool
+ *
+ * \note            Used only when \ref LWCELL_CFG_THREADX_MEM_BLOCK_POOLS is enabled
+ */
+#ifndef LWCELL_CFG_THREADX_MEM_BLOCK_MSG_COUNT
+#define LWCELL_CFG_THREADX_MEM_BLOCK_MSG_COUNT 8
+#endif
+
+/**
+ * \brief           Number of blocks in full-size packet buffer block pool
+ *
+ * \note            Used only when \ref LWCELL_CFG_THREADX_MEM_BLOCK_POOLS is enabled
+ */
+#ifndef LWCELL_CFG_THREADX_MEM_BLOCK_DATA_COUNT
+#define LWCELL_CFG_THREADX_MEM_BLOCK_DATA_COUNT 4
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` idle thread extensions feature of ThreadX
+ *
+ * When enabled, user must manually configure idle thread and setup additional thread handle extension fields.
+ * By default ThreadX doesn't support self-thread cleanup when thread memory is dynamically allocated & thread terminated,
+ * hence another thread is mandatory to do the cleanup process instead.
+ *
+ * This configuration does not create idle-thread, rather only sets additional TX_THREAD fields,
+ * indicating thread handle and thread stack are dynamically allocated.
+ *
+ * Have a look at System-ThreadX port for implementation
+ */
+#ifndef LWCELL_CFG_THREADX_IDLE_THREAD_EXTENSION
+#define LWCELL_CFG_THREADX_IDLE_THREAD_EXTENSION 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` static allocation of system objects in FreeRTOS and ThreadX ports
+ *
+ * When enabled, FreeRTOS port creates mutexes, semaphores, message queues and threads
+ * with `xSemaphoreCreate*Static`, `xQueueCreateStatic` and `xTaskCreateStatic` from preallocated slots,
+ * while ThreadX port takes message queue storage and thread stacks from preallocated slots
+ * instead of byte pool.
+ *
+ * When slots are exhausted or requested size does not fit the slot,
+ * object is allocated dynamically as if this option was disabled.
+ *
+ * \note            To remove kernel heap allocation from command path completely,
+ *                  enable \ref LWCELL_CFG_MSG_POOL_SIZE too, so that semaphores of blocking commands
+ *                  are created once and reused
+ * \note            FreeRTOS port requires `configSUPPORT_STATIC_ALLOCATION` to be enabled
+ */
+#ifndef LWCELL_CFG_SYS_STATIC_ALLOC
+#define LWCELL_CFG_SYS_STATIC_ALLOC 0
+#endif
+
+/**
+ * \brief           Number of preallocated mutex and semaphore slots
+ *
+ * \note            Used only by FreeRTOS port when \ref LWCELL_CFG_SYS_STATIC_ALLOC is enabled.
+ *                  ThreadX keeps control blocks inside the handles already
+ */
+#ifndef LWCELL_CFG_SYS_STATIC_SEM_CNT
+#define LWCELL_CFG_SYS_STATIC_SEM_CNT (LWCELL_CFG_MSG_POOL_SIZE + 8)
+#endif
+
+/**
+ * \brief           Number of preallocated message queue slots
+ *
+ * \note            Used only when \ref LWCELL_CFG_SYS_STATIC_ALLOC is enabled
+ */
+#ifndef LWCELL_CFG_SYS_STATIC_MBOX_CNT
+#define LWCELL_CFG_SYS_STATIC_MBOX_CNT 4
+#endif
+
+/**
+ * \brief           Maximal number of entries of message queue created from preallocated slot
+ *
+ * \note            Used only when \ref LWCELL_CFG_SYS_STATIC_ALLOC is enabled
+ */
+#ifndef LWCELL_CFG_SYS_STATIC_MBOX_SIZE
+#define LWCELL_CFG_SYS_STATIC_MBOX_SIZE 16
+#endif
+
+/**
+ * \brief           Number of preallocated thread slots, each with control block and stack
+ *
+ * \note            Used only when \ref LWCELL_CFG_SYS_STATIC_ALLOC is enabled
+ */
+#ifndef LWCELL_CFG_SYS_STATIC_THREAD_CNT
+#define LWCELL_CFG_SYS_STATIC_THREAD_CNT 3
+#endif
+
+/**
+ * \brief           Stack size in units of bytes of preallocated thread slot
+ *
+ * Thread, requesting larger stack, is created dynamically.
+ *
+ * \note            Used only when \ref LWCELL_CFG_SYS_STATIC_ALLOC is enabled
+ */
+#ifndef LWCELL_CFG_SYS_STATIC_THREAD_SS
+#define LWCELL_CFG_SYS_STATIC_THREAD_SS (LWCELL_SYS_THREAD_SS)
+#endif
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup        LWCELL_OPT_MODULES Modules
+ * \brief           Configuration of specific modules
+ * \{
+ */
+
+/**
+ * \defgroup        LWCELL_OPT_MODULES_NETCONN Netconn module
+ * \brief           Configuration of netconn API module
+ * \{
+ */
+
+/**
+ * \brief           Enables `1` or disables `0` NETCONN sequential API support for OS systems
+ *
+ * \note            To use this feature, OS support is mandatory.
+ * \sa              LWCELL_CFG_OS
+ */
+#ifndef LWCELL_CFG_NETCONN
+#define LWCELL_CFG_NETCONN 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` receive timeout feature
+ *
+ * When this option is enabled, user will get an option
+ * to set timeout value for receive data on netconn,
+ * before function returns timeout error.
+ *
+ * \note            Even if this option is enabled, user must still manually set timeout,
+ *                  by default time will be set to 0 which means no timeout.
+ */
+#ifndef LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT
+#define LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT 1
+#endif
+
+/**
+ * \brief           Accept queue length for new client when netconn server is used
+ *
+ * Defines number of maximal clients waiting in accept queue of server connection
+ */
+#ifndef LWCELL_CFG_NETCONN_ACCEPT_QUEUE_LEN
+#define LWCELL_CFG_NETCONN_ACCEPT_QUEUE_LEN 5
+#endif
+
+/**
+ * \brief           Receive queue length for pbuf entries
+ *
+ * Defines maximal number of pbuf data packet references for receive
+ */
+#ifndef LWCELL_CFG_NETCONN_RECEIVE_QUEUE_LEN
+#define LWCELL_CFG_NETCONN_RECEIVE_QUEUE_LEN 8
+#endif
+
+/**
+ * \brief           Maximal length of coalesced receive packet in units of bytes
+ *
+ * When set to value greater than `0`, newly received data are chained
+ * to last pbuf in receive queue, as long as application did not read it yet
+ * and total length does not exceed this value.
+ * This reduces number of queue entries and receive calls for small segments.
+ *
+ * Set to `0` to put every received packet to queue as separate entry
+ */
+#ifndef LWCELL_CFG_NETCONN_RECEIVE_COALESCE_LEN
+#define LWCELL_CFG_NETCONN_RECEIVE_COALESCE_LEN 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` netconn poll API
+ *
+ * When enabled, \ref lwcell_netconn_poll waits for receive readiness
+ * of multiple netconns at once, so single thread may serve all connections.
+ */
+#ifndef LWCELL_CFG_NETCONN_POLL
+#define LWCELL_CFG_NETCONN_POLL 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` persistent netconn write buffer
+ *
+ * Writes of at least \ref LWCELL_CFG_CONN_MAX_DATA_LEN bytes are always sent directly from application memory,
+ * only remaining tail is copied to netconn write buffer.
+ *
+ * When enabled, write buffer is allocated on first buffered write and kept until \ref lwcell_netconn_delete.
+ * Sending full buffer or \ref lwcell_netconn_flush only resets it,
+ * so streaming writes do not allocate and free memory for every tail fragment.
+ *
+ * When disabled, write buffer is freed after each send.
+ */
+#ifndef LWCELL_CFG_NETCONN_WRITE_BUFF_KEEP
+#define LWCELL_CFG_NETCONN_WRITE_BUFF_KEEP 0
+#endif
+
+/**
+ * \brief           Time in units of milliseconds, after which partially filled netconn write buffer is sent
+ *
+ * Small writes are collected in write buffer and sent as single packet, when buffer is full
+ * or when no flush happened within this time after the write.
+ * Single write may hold data with \ref LWCELL_NETCONN_FLAG_MORE or send it with \ref LWCELL_NETCONN_FLAG_FLUSH.
+ *
+ * Set to `0` to send buffered data only when buffer is full or on \ref lwcell_netconn_flush call
+ */
+#ifndef LWCELL_CFG_NETCONN_WRITE_FLUSH_DELAY
+#define LWCELL_CFG_NETCONN_WRITE_FLUSH_DELAY 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` netconn pool API
+ *
+ * Pool keeps connections to named endpoints open between exchanges
+ * and reconnects them on next use after remote side closes them.
+ *
+ * \sa              LWCELL_CFG_NETCONN_POOL_SIZE
+ */
+#ifndef LWCELL_CFG_NETCONN_POOL
+#define LWCELL_CFG_NETCONN_POOL 0
+#endif
+
+/**
+ * \brief           Maximal number of endpoints in netconn pool
+ *
+ * Each connected endpoint occupies one of \ref LWCELL_CFG_MAX_CONNS connections
+ */
+#ifndef LWCELL_CFG_NETCONN_POOL_SIZE
+#define LWCELL_CFG_NETCONN_POOL_SIZE 4
+#endif
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup        LWCELL_OPT_MODULES_MQTT MQTT client module
+ * \brief           Configuration of MQTT and MQTT API client modules, that are build on top of the TCP API
+ * \{
+ */
+
+/**
+ * \brief           Maximal number of open MQTT requests at a time
+ *
+ * Default in-flight window size of \ref lwcell_mqtt_client_new.
+ * Also sets number of referenced payloads waiting to be sent.
+ * Use \ref lwcell_mqtt_client_new_ex to set window size at runtime.
+ */
+#ifndef LWCELL_CFG_MQTT_MAX_REQUESTS
+#define LWCELL_CFG_MQTT_MAX_REQUESTS 8
+#endif
+
+/**
+ * \brief           Size of MQTT API message queue for received messages
+ *
+ */
+#ifndef LWCELL_CFG_MQTT_API_MBOX_SIZE
+#define LWCELL_CFG_MQTT_API_MBOX_SIZE 8
+#endif
+
+/**
+ * \brief           Number of receive buffers in MQTT API buffer pool
+ *
+ * Received publish packets are stored to fixed buffers, allocated when API client is created.
+ * Each buffer has RX buffer length. Heap is used when all buffers are in use.
+ *
+ * Set to `0` to allocate every received packet from heap
+ */
+#ifndef LWCELL_CFG_MQTT_API_BUF_POOL_SIZE
+#define LWCELL_CFG_MQTT_API_BUF_POOL_SIZE 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` receive without copy in MQTT API
+ *
+ * RX buffer of MQTT client holding received packet is handed to application
+ * and client continues with free buffer from pool.
+ * Topic and payload point to received packet and are not `NULL` terminated.
+ *
+ * \note            \ref LWCELL_CFG_MQTT_API_BUF_POOL_SIZE must be greater than `0`
+ */
+#ifndef LWCELL_CFG_MQTT_API_RX_REF
+#define LWCELL_CFG_MQTT_API_RX_REF 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` streaming of received publish packets larger than RX buffer
+ *
+ * When enabled, topic and packet ID are stored to RX buffer and payload is delivered
+ * to \ref LWCELL_MQTT_EVT_PUBLISH_RECV event in multiple parts, as data are received from connection.
+ * Use \ref lwcell_mqtt_client_evt_publish_recv_get_payload_offset and
+ * \ref lwcell_mqtt_client_evt_publish_recv_get_total_len to reassemble the payload.
+ *
+ * When disabled, packets larger than RX buffer are discarded
+ *
+ * \note            MQTT client API reassembles parts to single buffer, allocated from heap with full payload length
+ */
+#ifndef LWCELL_CFG_MQTT_RECV_STREAM
+#define LWCELL_CFG_MQTT_RECV_STREAM 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` MQTT offline publish queue
+ *
+ * When enabled, \ref lwcell_mqtt_client_set_offline_queue sets up queue
+ * for messages published while client is not connected.
+ * Queue is published after reconnect, with optional storage tier for messages not fitting to RAM
+ */
+#ifndef LWCELL_CFG_MQTT_OFFLINE_QUEUE
+#define LWCELL_CFG_MQTT_OFFLINE_QUEUE 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` MQTT topic router
+ *
+ * When enabled, \ref lwcell_mqtt_client_topic_add registers callbacks per topic filter.
+ * Incoming publish packets are matched against filter trie, with `+` and `#` wildcard support
+ */
+#ifndef LWCELL_CFG_MQTT_TOPIC_ROUTER
+#define LWCELL_CFG_MQTT_TOPIC_ROUTER 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` persistent MQTT session
+ *
+ * When enabled, \ref lwcell_mqtt_client_set_session sets storage for in-flight QoS `1` and `2` packets.
+ * Client connects without clean session flag and resends unacknowledged packets
+ * after reconnect or device restart
+ */
+#ifndef LWCELL_CFG_MQTT_SESSION
+#define LWCELL_CFG_MQTT_SESSION 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` MQTT version 5 protocol in MQTT client
+ *
+ * When enabled, client connects with MQTT 5 when \ref lwcell_mqtt_client_info_t::version is set to `5`.
+ * Repeated publish topics are replaced with topic aliases and number of unacknowledged
+ * QoS `1` and `2` publish packets is limited by receive maximum of the server
+ */
+#ifndef LWCELL_CFG_MQTT_V5
+#define LWCELL_CFG_MQTT_V5 0
+#endif
+
+/**
+ * \brief           Number of outgoing topic aliases cached per MQTT 5 client
+ *
+ * Each used entry keeps a copy of its topic in allocated memory.
+ * Least recently used entry is replaced when cache is full.
+ * Number of used aliases is further limited by topic alias maximum of the server
+ *
+ * \note            Set to `0` to disable topic aliases
+ */
+#ifndef LWCELL_CFG_MQTT_V5_TOPIC_ALIAS
+#define LWCELL_CFG_MQTT_V5_TOPIC_ALIAS 8
+#endif
+
+/**
+ * \brief           Set debug level for MQTT client module
+ *
+ * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ */
+#ifndef LWCELL_CFG_DBG_MQTT
+#define LWCELL_CFG_DBG_MQTT LWCELL_DBG_OFF
+#endif
+
+/**
+ * \brief           Set debug level for MQTT API client module
+ *
+ * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ */
+#ifndef LWCELL_CFG_DBG_MQTT_API
+#define LWCELL_CFG_DBG_MQTT_API LWCELL_DBG_OFF
+#endif
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup        LWCELL_OPT_MODULES_OTA OTA download module
+ * \brief           Configuration of resumable firmware download application
+ * \{
+ */
+
+/**
+ * \brief           Enables `1` or disables `0` resumable OTA download application
+ *
+ * Image is downloaded with HTTP `Range` requests over netconn,
+ * so it continues from last written offset after connection loss.
+ *
+ * \note            \ref LWCELL_CFG_NETCONN must be enabled
+ */
+#ifndef LWCELL_CFG_OTA
+#define LWCELL_CFG_OTA 0
+#endif
+
+/**
+ * \brief           Maximal length of single HTTP response header line in OTA download, including termination
+ *
+ * Longer header lines are truncated, which is harmless for lines not used by application
+ */
+#ifndef LWCELL_CFG_OTA_HEADER_LINE_LEN
+#define LWCELL_CFG_OTA_HEADER_LINE_LEN 96
+#endif
+
+/**
+ * \brief           Set debug level for OTA download application
+ *
+ * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ */
+#ifndef LWCELL_CFG_DBG_OTA
+#define LWCELL_CFG_DBG_OTA LWCELL_DBG_OFF
+#endif
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup        LWCELL_OPT_MODULES_WS WebSocket client module
+ * \brief           Configuration of WebSocket client application
+ * \{
+ */
+
+/**
+ * \brief           Enables `1` or disables `0` WebSocket client application
+ *
+ * \note            \ref LWCELL_CFG_NETCONN must be enabled
+ */
+#ifndef LWCELL_CFG_WS
+#define LWCELL_CFG_WS 0
+#endif
+
+/**
+ * \brief           Maximal payload length of received WebSocket frame, in units of bytes
+ *
+ * Complete frame is kept in received packet buffers until application processed it.
+ * Longer frames close connection with status `1009`
+ */
+#ifndef LWCELL_CFG_WS_MAX_PAYLOAD_LEN
+#define LWCELL_CFG_WS_MAX_PAYLOAD_LEN 4096
+#endif
+
+/**
+ * \brief           Get 32-bit random value for WebSocket masking key and handshake key
+ *
+ * Default implementation is pseudo random generator seeded from system time.
+ * It shall be overridden with hardware random generator when available
+ */
+#ifndef LWCELL_CFG_WS_RANDOM
+#define LWCELL_CFG_WS_RANDOM() lwcell_ws_client_random()
+#endif
+
+/**
+ * \brief           Set debug level for WebSocket client application
+ *
+ * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ */
+#ifndef LWCELL_CFG_DBG_WS
+#define LWCELL_CFG_DBG_WS LWCELL_DBG_OFF
+#endif
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup        LWCELL_OPT_MODULES_HTTP_CLIENT HTTP/1.1 client module
+ * \brief           Configuration of software HTTP/1.1 client application
+ * \{
+ */
+
+/**
+ * \brief           Enables `1` or disables `0` software HTTP/1.1 client application on top of netconn
+ *
+ * It is independent from modem HTTP engine enabled with \ref LWCELL_CFG_HTTP
+ *
+ * \note            \ref LWCELL_CFG_NETCONN must be enabled
+ */
+#ifndef LWCELL_CFG_HTTP_CLIENT
+#define LWCELL_CFG_HTTP_CLIENT 0
+#endif
+
+/**
+ * \brief           Maximal number of requests sent before their responses are read
+ *
+ * Value of `1` disables pipelining, requests still reuse the same connection.
+ * Maximal value is `32`
+ */
+#ifndef LWCELL_CFG_HTTP_CLIENT_PIPELINE_LEN
+#define LWCELL_CFG_HTTP_CLIENT_PIPELINE_LEN 4
+#endif
+
+/**
+ * \brief           Maximal length of response header, in units of bytes
+ *
+ * Header is kept in received packet buffers until complete, longer headers close connection
+ */
+#ifndef LWCELL_CFG_HTTP_CLIENT_MAX_HEADER_LEN
+#define LWCELL_CFG_HTTP_CLIENT_MAX_HEADER_LEN 1024
+#endif
+
+/**
+ * \brief           Set debug level for HTTP/1.1 client application
+ *
+ * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ */
+#ifndef LWCELL_CFG_DBG_HTTP_CLIENT
+#define LWCELL_CFG_DBG_HTTP_CLIENT LWCELL_DBG_OFF
+#endif
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup        LWCELL_OPT_MODULES_COAP CoAP client module
+ * \brief           Configuration of CoAP client application
+ * \{
+ */
+
+/**
+ * \brief           Enables `1` or disables `0` CoAP client application over UDP connection
+ *
+ * \note            \ref LWCELL_CFG_CONN must be enabled
+ */
+#ifndef LWCELL_CFG_COAP
+#define LWCELL_CFG_COAP 0
+#endif
+
+/**
+ * \brief           Maximal number of CoAP requests in progress at a time, per client
+ *
+ * Every entry holds message buffer of \ref LWCELL_CFG_COAP_MSG_LEN bytes,
+ * used for retransmission of confirmable messages. Observed resources keep their entry until cancelled
+ */
+#ifndef LWCELL_CFG_COAP_MAX_REQUESTS
+#define LWCELL_CFG_COAP_MAX_REQUESTS 4
+#endif
+
+/**
+ * \brief           Block size exponent for block-wise transfers
+ *
+ * Block size equals `16 << LWCELL_CFG_COAP_BLOCK_SZX` bytes, value must be between `0` (16 bytes) and `6` (1024 bytes).
+ * Request payload longer than block size is sent with `Block1` option
+ */
+#ifndef LWCELL_CFG_COAP_BLOCK_SZX
+#define LWCELL_CFG_COAP_BLOCK_SZX 4
+#endif
+
+/**
+ * \brief           Length of message buffer of single CoAP request, in units of bytes
+ *
+ * Buffer holds header, token, options (including `Uri-Path`) and one payload block
+ */
+#ifndef LWCELL_CFG_COAP_MSG_LEN
+#define LWCELL_CFG_COAP_MSG_LEN ((16 << LWCELL_CFG_COAP_BLOCK_SZX) + 96)
+#endif
+
+/**
+ * \brief           Initial acknowledge timeout of confirmable message, in units of milliseconds
+ *
+ * Timeout is doubled with each retransmission
+ */
+#ifndef LWCELL_CFG_COAP_ACK_TIMEOUT
+#define LWCELL_CFG_COAP_ACK_TIMEOUT 2000
+#endif
+
+/**
+ * \brief           Maximal number of retransmissions of confirmable message
+ */
+#ifndef LWCELL_CFG_COAP_MAX_RETRANSMIT
+#define LWCELL_CFG_COAP_MAX_RETRANSMIT 4
+#endif
+
+/**
+ * \brief           Time to wait for response after empty acknowledge or non-confirmable request,
+ *                  in units of milliseconds
+ */
+#ifndef LWCELL_CFG_COAP_RESPONSE_TIMEOUT
+#define LWCELL_CFG_COAP_RESPONSE_TIMEOUT 30000
+#endif
+
+/**
+ * \brief           Set debug level for CoAP client application
+ *
+ * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ */
+#ifndef LWCELL_CFG_DBG_COAP
+#define LWCELL_CFG_DBG_COAP LWCELL_DBG_OFF
+#endif
+
+/**
+ * \}
+ */
+
+/**
+ * \brief           Enables `1` or disables `0` network functionality
+ *                      used for TCP/IP communication
+ *
+ * Network must be enabled to use all GPRS/LTE functions such
+ * as connection API, FTP, HTTP, etc.
+ */
+#ifndef LWCELL_CFG_NETWORK
+#define LWCELL_CFG_NETWORK 0
+#endif
+
+/**
+ * \brief           Ignores `1` or not `0` result from `AT+CGACT` command.
+ *
+ * \note            This may be used for data-only SIM cards where command might fail
+ *                  when trying to attach to network for data transfer
+ */
+#ifndef LWCELL_CFG_NETWORK_IGNORE_CGACT_RESULT
+#define LWCELL_CFG_NETWORK_IGNORE_CGACT_RESULT 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` incremental network attach
+ *
+ * Network attach first queries current state with `AT+CIPSTATUS` and `AT+CGATT?`
+ * and skips steps which are already satisfied, instead of tearing down
+ * and rebuilding the PDP context on every attach.
+ *
+ * \note            APN settings are not applied when PDP context is already active.
+ *                  Detach from network first to change them
+ * \note            \ref LWCELL_CFG_CONN must be enabled
+ */
+#ifndef LWCELL_CFG_NETWORK_ATTACH_INCREMENTAL
+#define LWCELL_CFG_NETWORK_ATTACH_INCREMENTAL 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` connection recovery after PDP context deactivation
+ *
+ * On `+PDP: DEACT`, context is activated again once with credentials
+ * set by \ref lwcell_network_set_pdp_recovery. Client connections, active at that time,
+ * are not reported as closed. They are started again to the same remote address,
+ * connections with pending send requests first, and held send requests continue after.
+ * Connection is closed with \ref LWCELL_EVT_CONN_CLOSE event when context or connection cannot be restored.
+ *
+ * \note            \ref LWCELL_CFG_CONN and \ref LWCELL_CFG_USE_API_FUNC_EVT must be enabled
+ */
+#ifndef LWCELL_CFG_NETWORK_PDP_RECOVERY
+#define LWCELL_CFG_NETWORK_PDP_RECOVERY 0
+#endif
+
+/**
+ * \brief           Number of GPRS PDP contexts used in parallel for data connections
+ *
+ * Device keeps up to `2` contexts active at the same time, selected with `AT+CIPSGTXT`.
+ * Context `0` is activated with \ref lwcell_network_attach,
+ * context `1` with \ref lwcell_network_attach_ctx once context `0` is active.
+ * Connections are bound to context with \ref lwcell_conn_start_ctx
+ *
+ * \note            Value must be `1` or `2`. \ref LWCELL_CFG_CONN must be enabled for value `2`
+ */
+#ifndef LWCELL_CFG_NETWORK_CONTEXTS
+#define LWCELL_CFG_NETWORK_CONTEXTS 1
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` packet service registration tracking
+ *
+ * GPRS (`+CGREG`) and EPS (`+CEREG`) registration reports with location info
+ * are enabled with `AT+CGREG=2` and `AT+CEREG=2` during reset sequence.
+ * \ref LWCELL_EVT_NETWORK_PS_REG_CHANGED is sent on every report, application may
+ * attach to network as soon as packet service registration completes.
+ *
+ * \note            Devices without LTE reject `AT+CEREG` command, reset sequence continues
+ */
+#ifndef LWCELL_CFG_NETWORK_PS_REG
+#define LWCELL_CFG_NETWORK_PS_REG 0
+#endif
+
+/**
+ * \brief           Idle time in units of milliseconds before network API detaches from network
+ *
+ * When last user releases network with \ref lwcell_network_request_detach,
+ * or network attached with \ref lwcell_network_request_preattach is not requested,
+ * PDP context stays active for this time and is reused if network is requested again.
+ * Set to `0` to detach immediately
+ */
+#ifndef LWCELL_CFG_NETWORK_IDLE_DETACH_TIMEOUT
+#define LWCELL_CFG_NETWORK_IDLE_DETACH_TIMEOUT 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` RAT and band lock API
+ *
+ * Radio access technology and LTE bands are locked with `AT+CNMP`, `AT+CMNB` and `AT+CBANDCFG` commands.
+ * With manager set by \ref lwcell_network_band_set_manager, band of last successful registration
+ * is locked first after reset, and search widens to all configured bands when registration times out.
+ *
+ * \note            Commands are specific to SIM7000 and SIM7070 devices
+ */
+#ifndef LWCELL_CFG_NETWORK_BAND
+#define LWCELL_CFG_NETWORK_BAND 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` connection API.
+ *
+ * \note            \ref LWCELL_CFG_NETWORK must be enabled to use connection feature
+ */
+#ifndef LWCELL_CFG_CONN
+#define LWCELL_CFG_CONN 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` TCP server support with `AT+CIPSERVER`
+ *
+ * When enabled, device may listen on local port and accept incoming connections,
+ * reported to server callback with \ref LWCELL_EVT_CONN_ACTIVE event.
+ * Netconn API adds \ref lwcell_netconn_bind, \ref lwcell_netconn_listen and \ref lwcell_netconn_accept functions
+ *
+ * \note            \ref LWCELL_CFG_CONN must be enabled
+ */
+#ifndef LWCELL_CFG_CONN_SERVER
+#define LWCELL_CFG_CONN_SERVER 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` SMS API.
+ *
+ */
+#ifndef LWCELL_CFG_SMS
+#define LWCELL_CFG_SMS 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` PDU mode SMS encoder and decoder.
+ *
+ * It adds \ref lwcell_sms_send_pdu for GSM 7-bit, 8-bit binary and UCS2 messages,
+ * split to concatenated parts when they do not fit to single SMS.
+ *
+ * \note            \ref LWCELL_CFG_SMS must be enabled to use this feature
+ */
+#ifndef LWCELL_CFG_SMS_PDU
+#define LWCELL_CFG_SMS_PDU 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` direct delivery of received SMS.
+ *
+ * \ref lwcell_sms_enable configures device with `AT+CNMI=2,2` to forward new messages
+ * with `+CMT` instead of saving them to storage. Header and text are parsed from input stream
+ * and \ref LWCELL_EVT_SMS_RECV event carries complete message, see \ref lwcell_evt_sms_recv_get_entry.
+ * No read or delete command is necessary.
+ *
+ * Direct delivery headers follow current message format, hence device is returned to text mode
+ * after each message sent with \ref lwcell_sms_send_pdu.
+ *
+ * \note            \ref LWCELL_CFG_SMS must be enabled to use this feature
+ */
+#ifndef LWCELL_CFG_SMS_DIRECT
+#define LWCELL_CFG_SMS_DIRECT 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` SMS inbox service.
+ *
+ * When enabled with \ref lwcell_sms_inbox_enable, `+CMTI` notifications are collected
+ * for \ref LWCELL_CFG_SMS_INBOX_DELAY milliseconds, then all unread messages are read with single `AT+CMGL`
+ * and removed with single `AT+CMGDA="DEL READ"`, instead of read and delete command per message.
+ *
+ * \note            \ref LWCELL_CFG_SMS must be enabled to use this feature
+ */
+#ifndef LWCELL_CFG_SMS_INBOX
+#define LWCELL_CFG_SMS_INBOX 0
+#endif
+
+/**
+ * \brief           Time in milliseconds to collect `+CMTI` notifications before inbox is read
+ *
+ * Messages of multi-part SMS or burst of messages arrive within short time
+ * and are processed with single list and delete command pair.
+ *
+ * \note            Used only when \ref LWCELL_CFG_SMS_INBOX is enabled
+ */
+#ifndef LWCELL_CFG_SMS_INBOX_DELAY
+#define LWCELL_CFG_SMS_INBOX_DELAY 500
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` call API.
+ *
+ */
+#ifndef LWCELL_CFG_CALL
+#define LWCELL_CFG_CALL 0
+#endif
+
+/**
+ * \brief           Number of `RING` reports after which incoming call is answered automatically
+ *
+ * Answer command is queued directly from processing thread,
+ * to producer priority lane when enabled with \ref LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE.
+ *
+ * Set to `0` to disable automatic answer
+ *
+ * \note            Used only when \ref LWCELL_CFG_CALL is enabled
+ */
+#ifndef LWCELL_CFG_CALL_AUTO_ANSWER
+#define LWCELL_CFG_CALL_AUTO_ANSWER 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` phonebook API.
+ *
+ */
+#ifndef LWCELL_CFG_PHONEBOOK
+#define LWCELL_CFG_PHONEBOOK 0
+#endif
+
+/**
+ * \brief           Number of phonebook positions read with single `AT+CPBR` command
+ *
+ * Used by \ref lwcell_pb_list_iter and to load phonebook mirror. Bigger value means less commands,
+ * but longer response from device for each of them
+ */
+#ifndef LWCELL_CFG_PHONEBOOK_READ_CHUNK
+#define LWCELL_CFG_PHONEBOOK_READ_CHUNK 10
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` RAM mirror of phonebook entries.
+ *
+ * Mirror is loaded once with \ref lwcell_pb_mirror_load and kept in sync by phonebook add, edit and delete API.
+ * Number lookup with \ref lwcell_pb_mirror_find then runs from RAM, without any AT command traffic.
+ *
+ * \note            \ref LWCELL_CFG_PHONEBOOK must be enabled to use this feature
+ */
+#ifndef LWCELL_CFG_PHONEBOOK_MIRROR
+#define LWCELL_CFG_PHONEBOOK_MIRROR 0
+#endif
+
+/**
+ * \brief           Maximal number of entries kept in phonebook mirror
+ *
+ * Loading mirror fails if phonebook memory holds more entries than this value
+ */
+#ifndef LWCELL_CFG_PHONEBOOK_MIRROR_SIZE
+#define LWCELL_CFG_PHONEBOOK_MIRROR_SIZE 32
+#endif
+
+/**
+ * \brief           Number of trailing digits used to match phone numbers in mirror
+ *
+ * Only digits are considered, so `+386 40 123 456` and `040123456` match with default value.
+ */
+#ifndef LWCELL_CFG_PHONEBOOK_MIRROR_DIGITS
+#define LWCELL_CFG_PHONEBOOK_MIRROR_DIGITS 8
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` HTTP API.
+ *
+ * \note            \ref LWCELL_CFG_NETWORK must be enabled to use connection feature
+ */
+#ifndef LWCELL_CFG_HTTP
+#define LWCELL_CFG_HTTP 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` FTP API.
+ *
+ * \note            \ref LWCELL_CFG_NETWORK must be enabled to use connection feature
+ */
+#ifndef LWCELL_CFG_FTP
+#define LWCELL_CFG_FTP 0
+#endif
+
+/**
+ * \brief           Maximal length of single FTP data chunk in units of bytes
+ *
+ * Used for `AT+FTPGET=2` reads and `AT+FTPPUT=2` writes.
+ * Read is further limited by length of application packet buffer,
+ * write by maximal length reported by device when session is opened
+ *
+ * \note            SIM800 series accepts up to `1460` bytes per chunk
+ */
+#ifndef LWCELL_CFG_FTP_CHUNK_LEN
+#define LWCELL_CFG_FTP_CHUNK_LEN 1024
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` PING API.
  *
- * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ * \note            \ref LWCELL_CFG_NETWORK must be enabled to use connection feature
  */
-#ifndef LWCELL_CFG_DBG_INPUT
-#define LWCELL_CFG_DBG_INPUT LWCELL_DBG_OFF
+#ifndef LWCELL_CFG_PING
+#define LWCELL_CFG_PING 0
 #endif
 
 /**
- * \brief           Set debug level for GSM threads
+ * \brief           Enables `1` or disables `0` DNS API with resolved address cache.
  *
- * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ * When enabled, cached address is used by `AT+CIPSTART` instead of host name
+ *
+ * \note            \ref LWCELL_CFG_CONN must be enabled to use DNS feature
  */
-#ifndef LWCELL_CFG_DBG_THREAD
-#define LWCELL_CFG_DBG_THREAD LWCELL_DBG_OFF
+#ifndef LWCELL_CFG_DNS
+#define LWCELL_CFG_DNS 0
 #endif
 
 /**
- * \brief           Set debug level for asserting of input variables
- *
- * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ * \brief           Number of hosts kept in DNS cache
  */
-#ifndef LWCELL_CFG_DBG_ASSERT
-#define LWCELL_CFG_DBG_ASSERT LWCELL_DBG_OFF
+#ifndef LWCELL_CFG_DNS_CACHE_SIZE
+#define LWCELL_CFG_DNS_CACHE_SIZE 4
 #endif
 
 /**
- * \brief           Set debug level for incoming data received from device
+ * \brief           Maximal number of addresses saved per host
  *
- * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ * Additional addresses are used when connection to previous one fails
  */
-#ifndef LWCELL_CFG_DBG_IPD
-#define LWCELL_CFG_DBG_IPD LWCELL_DBG_OFF
+#ifndef LWCELL_CFG_DNS_MAX_ADDR
+#define LWCELL_CFG_DNS_MAX_ADDR 2
 #endif
 
 /**
- * \brief           Set debug level for packet buffer manager
+ * \brief           Maximal host name length in DNS cache, including `NULL` termination
  *
- * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ * Longer host names are resolved, but not cached
  */
-#ifndef LWCELL_CFG_DBG_PBUF
-#define LWCELL_CFG_DBG_PBUF LWCELL_DBG_OFF
+#ifndef LWCELL_CFG_DNS_HOST_LEN
+#define LWCELL_CFG_DNS_HOST_LEN 64
 #endif
 
 /**
- * \brief           Set debug level for connections
- *
- * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ * \brief           Lifetime of DNS cache entry in units of milliseconds
  */
-#ifndef LWCELL_CFG_DBG_CONN
-#define LWCELL_CFG_DBG_CONN LWCELL_DBG_OFF
+#ifndef LWCELL_CFG_DNS_CACHE_TTL
+#define LWCELL_CFG_DNS_CACHE_TTL 300000
 #endif
 
 /**
- * \brief           Set debug level for dynamic variable allocations
+ * \brief           Enables `1` or disables `0` GSM 07.10 multiplexer.
  *
- * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ * When enabled, \ref lwcell_cmux_start switches device to multiplexer mode,
+ * stack traffic is framed on its own channel and application gets additional channels
  */
-#ifndef LWCELL_CFG_DBG_VAR
-#define LWCELL_CFG_DBG_VAR LWCELL_DBG_OFF
+#ifndef LWCELL_CFG_CMUX
+#define LWCELL_CFG_CMUX 0
 #endif
 
 /**
- * \brief           Set debug level for netconn sequential API
+ * \brief           Maximal information field length of multiplexer frame, `N1` parameter of `AT+CMUX` command
  *
- * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ * Value must be between `1` and `127`
  */
-#ifndef LWCELL_CFG_DBG_NETCONN
-#define LWCELL_CFG_DBG_NETCONN LWCELL_DBG_OFF
+#ifndef LWCELL_CFG_CMUX_FRAME_LEN
+#define LWCELL_CFG_CMUX_FRAME_LEN 127
 #endif
 
 /**
- * \brief           Enables `1` or disables `0` echo mode on AT commands
- *                  sent to GSM device.
+ * \brief           Enables `1` or disables `0` PPP data mode API
  *
- * \note            This mode is useful when debugging GSM communication
+ * When enabled, \ref lwcell_ppp_start dials packet service and
+ * passes raw PPP bytes between device and external TCP/IP stack
  */
-#ifndef LWCELL_CFG_AT_ECHO
-#define LWCELL_CFG_AT_ECHO 0
+#ifndef LWCELL_CFG_PPP
+#define LWCELL_CFG_PPP 0
 #endif
 
 /**
- * \}
+ * \brief           Guard time in units of milliseconds before and after `+++` escape sequence
+ *
+ * Device only accepts escape sequence when there is no data for this time
  */
+#ifndef LWCELL_CFG_PPP_ESCAPE_GUARD_TIME
+#define LWCELL_CFG_PPP_ESCAPE_GUARD_TIME 1000
+#endif
 
 /**
- * \defgroup        LWCELL_OPT_OS OS configuration
- * \brief           Operating system dependant configuration
- * \{
+ * \brief           Enables `1` or disables `0` power manager for PSM, eDRX and modem sleep
+ *
+ * When enabled, modem put to sleep with \ref lwcell_pwr_sleep_set is woken up
+ * before producer thread sends next command
  */
+#ifndef LWCELL_CFG_PWR
+#define LWCELL_CFG_PWR 0
+#endif
 
 /**
- * \brief           Set number of message queue entries for procuder thread
+ * \brief           Command inactivity time in units of milliseconds before modem is put to sleep
  *
- * Message queue is used for storing memory address to command data
+ * Commands queued within this window are executed without additional wake-up.
+ * In automatic sleep mode, value shall be lower than UART idle time after which modem enters sleep
  */
-#ifndef LWCELL_CFG_THREAD_PRODUCER_MBOX_SIZE
-#define LWCELL_CFG_THREAD_PRODUCER_MBOX_SIZE 16
+#ifndef LWCELL_CFG_PWR_IDLE_TIME
+#define LWCELL_CFG_PWR_IDLE_TIME 2000
 #endif
 
 /**
- * \brief           Set number of message queue entries for processing thread
- *
- * Message queue is used to notify processing thread about new received data on AT port
+ * \brief           Time in units of milliseconds modem needs after wake-up before it accepts commands
  */
-#ifndef LWCELL_CFG_THREAD_PROCESS_MBOX_SIZE
-#define LWCELL_CFG_THREAD_PROCESS_MBOX_SIZE 16
+#ifndef LWCELL_CFG_PWR_WAKE_TIME
+#define LWCELL_CFG_PWR_WAKE_TIME 100
 #endif
 
 /**
- * \brief           Enables `1` or disables `0` direct support for processing input data
+ * \brief           Enables `1` or disables `0` automatic early radio release after last expected response
  *
- * When this mode is enabled, no overhead is included for copying data
- * to receive buffer because bytes are processed directly.
+ * Radio release is requested with \ref lwcell_pwr_radio_release, when:
  *
- * \note            This mode can only be used when \ref LWCELL_CFG_OS is enabled
+ *  - All send requests of deferred connections, released in transmit window of \ref LWCELL_CFG_CONN_TX_WINDOW,
+ *      are confirmed by device
+ *  - MQTT client with \ref lwcell_mqtt_client_info_t::radio_release set has no request waiting for acknowledge
  *
- * \note            When using this mode, separate thread must be dedicated only
- *                  for reading data on AT port
+ * Radio does not wait for network inactivity timer in connected state, which saves energy of every report.
  *
- * \note            Best case for using this mode is if DMA receive is supported by host device
+ * \note            Requires \ref LWCELL_CFG_PWR
  */
-#ifndef LWCELL_CFG_INPUT_USE_PROCESS
-#define LWCELL_CFG_INPUT_USE_PROCESS 0
+#ifndef LWCELL_CFG_PWR_RADIO_RELEASE
+#define LWCELL_CFG_PWR_RADIO_RELEASE 0
 #endif
 
 /**
- * \brief           Producer thread hook, called each time thread wakes-up and does the processing.
+ * \brief           Enables `1` or disables `0` USSD API.
  *
- * It can be used to check if thread is alive.
  */
-#ifndef LWCELL_THREAD_PRODUCER_HOOK
-#define LWCELL_THREAD_PRODUCER_HOOK()
+#ifndef LWCELL_CFG_USSD
+#define LWCELL_CFG_USSD 0
 #endif
 
 /**
- * \brief           Process thread hook, called each time thread wakes-up and does the processing.
- *
- * It can be used to check if thread is alive.
+ * \brief           Enables `1` or disables `0` MQTT API.
+ * \note            When enabled, it enables the MQTT native API with AT commands from the module
+ *                  and does not use MQTT library implementation on top of TCP/IP API
  */
-#ifndef LWCELL_THREAD_PROCESS_HOOK
-#define LWCELL_THREAD_PROCESS_HOOK()
+#ifndef LWCELL_CFG_MQTT
+#define LWCELL_CFG_MQTT 0
 #endif
 
 /**
- * \brief           Enables `1` or disables `0` custom memory byte pool extension for ThreadX port
+ * \brief           Enables `1` or disables `0` SSL configuration API
  *
- * When enabled, user must manually set byte pool at run-time, before \ref lwcell_init is called
+ * Certificates are uploaded to device file system and SSL contexts are configured
+ * with `AT+CFS*` and `AT+CSSLCFG` commands on SIM7070 series.
+ * Configured context is used by native MQTT connection.
  */
-#ifndef LWCELL_CFG_THREADX_CUSTOM_MEM_BYTE_POOL
-#define LWCELL_CFG_THREADX_CUSTOM_MEM_BYTE_POOL 0
+#ifndef LWCELL_CFG_SSL
+#define LWCELL_CFG_SSL 0
 #endif
 
 /**
- * \brief           Enables `1` or disables `0` idle thread extensions feature of ThreadX
- *
- * When enabled, user must manually configure idle thread and setup additional thread handle extension fields.
- * By default ThreadX doesn't support self-thread cleanup when thread memory is dynamically allocated & thread terminated,
- * hence another thread is mandatory to do the cleanup process instead.
+ * \brief           Maximal length of single file write in units of bytes, used for certificate upload
  *
- * This configuration does not create idle-thread, rather only sets additional TX_THREAD fields,
- * indicating thread handle and thread stack are dynamically allocated.
+ * Every chunk is written with one `AT+CFSWFILE` command and is read from application
+ * with read callback in small pieces, hence file is never kept in memory as a whole
  *
- * Have a look at System-ThreadX port for implementation
+ * \note            SIM7070 series accepts up to `10240` bytes per write
  */
-#ifndef LWCELL_CFG_THREADX_IDLE_THREAD_EXTENSION
-#define LWCELL_CFG_THREADX_IDLE_THREAD_EXTENSION 0
+#ifndef LWCELL_CFG_SSL_FILE_CHUNK_LEN
+#define LWCELL_CFG_SSL_FILE_CHUNK_LEN 2048
 #endif
 
 /**
- * \}
- */
-
-/**
- * \defgroup        LWCELL_OPT_MODULES Modules
- * \brief           Configuration of specific modules
- * \{
+ * \brief           Enables `1` or disables `0` device file system API
+ *
+ * Files in `customer` directory are written, read and deleted with `AT+CFS*` commands on SIM7070 series.
+ * Large payloads are staged to device file system at full UART speed
+ * and uploaded later by FTP client of the device with \ref lwcell_ftp_put_file,
+ * which releases application memory as soon as data are written to the file.
  */
+#ifndef LWCELL_CFG_FS
+#define LWCELL_CFG_FS 0
+#endif
 
 /**
- * \defgroup        LWCELL_OPT_MODULES_NETCONN Netconn module
- * \brief           Configuration of netconn API module
- * \{
+ * \brief           Maximal length of single file system write or read in units of bytes
+ *
+ * Every chunk is written with one `AT+CFSWFILE` command directly from application memory.
+ * Read is further limited by length of application packet buffer
+ *
+ * \note            SIM7070 series accepts up to `10240` bytes per write
  */
+#ifndef LWCELL_CFG_FS_CHUNK_LEN
+#define LWCELL_CFG_FS_CHUNK_LEN 10240
+#endif
 
 /**
- * \brief           Enables `1` or disables `0` NETCONN sequential API support for OS systems
+ * \brief           Enables `1` or disables `0` GNSS API
  *
- * \note            To use this feature, OS support is mandatory.
- * \sa              LWCELL_CFG_OS
+ * Navigation info is reported by device with `+UGNSINF` unsolicited code,
+ * parsed directly from receive buffer to position structure without memory allocation.
+ *
+ * \note            Supported on SIM7070 series
  */
-#ifndef LWCELL_CFG_NETCONN
-#define LWCELL_CFG_NETCONN 0
+#ifndef LWCELL_CFG_GNSS
+#define LWCELL_CFG_GNSS 0
 #endif
 
 /**
- * \brief           Enables `1` or disables `0` receive timeout feature
+ * \brief           Enables `1` or disables `0` cell info API with engineering mode reports
  *
- * When this option is enabled, user will get an option
- * to set timeout value for receive data on netconn,
- * before function returns timeout error.
+ * Serving and neighbour cell measurements are reported by device with `+CENG` unsolicited code,
+ * parsed line by line to fixed cell table without memory allocation.
+ * Application reads last measurements without command to device.
  *
- * \note            Even if this option is enabled, user must still manually set timeout,
- *                  by default time will be set to 0 which means no timeout.
+ * \note            Supported on SIM800 series
  */
-#ifndef LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT
-#define LWCELL_CFG_NETCONN_RECEIVE_TIMEOUT 1
+#ifndef LWCELL_CFG_CELL_INFO
+#define LWCELL_CFG_CELL_INFO 0
 #endif
 
 /**
- * \brief           Accept queue length for new client when netconn server is used
+ * \brief           Maximal number of neighbour cells kept from engineering mode report
  *
- * Defines number of maximal clients waiting in accept queue of server connection
+ * Device reports up to `6` neighbour cells, others are ignored
  */
-#ifndef LWCELL_CFG_NETCONN_ACCEPT_QUEUE_LEN
-#define LWCELL_CFG_NETCONN_ACCEPT_QUEUE_LEN 5
+#ifndef LWCELL_CFG_CELL_INFO_NEIGHBOURS
+#define LWCELL_CFG_CELL_INFO_NEIGHBOURS 6
 #endif
 
 /**
- * \brief           Receive queue length for pbuf entries
+ * \brief           Enables `1` or disables `0` network time and cell location cache
  *
- * Defines maximal number of pbuf data packet references for receive
+ * Network time is captured from `*PSUTTZ`, `+CTZV` and `+CCLK` lines, reported by device,
+ * and kept together with system time of capture.
+ * Current time is then calculated on request, without command to device.
+ *
+ * Local time stamp reports are enabled with `AT+CLTS=1` during reset sequence
  */
-#ifndef LWCELL_CFG_NETCONN_RECEIVE_QUEUE_LEN
-#define LWCELL_CFG_NETCONN_RECEIVE_QUEUE_LEN 8
+#ifndef LWCELL_CFG_TIME
+#define LWCELL_CFG_TIME 0
 #endif
 
 /**
- * \}
+ * \brief           Enables `1` or disables `0` unsolicited signal quality reports
+ *
+ * Reports are enabled with `AT+EXUNSOL="SQ",1` during reset sequence.
+ * Device sends `+CSQN` line when signal quality changes and RSSI is updated
+ * without `AT+CSQ` command. Use \ref lwcell_network_rssi_cached to read it.
+ *
+ * \note            Devices without extended unsolicited reports reject the command,
+ *                  reset sequence continues and RSSI is updated by `AT+CSQ` only
  */
+#ifndef LWCELL_CFG_RSSI_URC
+#define LWCELL_CFG_RSSI_URC 0
+#endif
 
 /**
- * \defgroup        LWCELL_OPT_MODULES_MQTT MQTT client module
- * \brief           Configuration of MQTT and MQTT API client modules, that are build on top of the TCP API
- * \{
+ * \brief           Minimal RSSI change in units of `dBm` to report \ref LWCELL_EVT_SIGNAL_STRENGTH event
+ *
+ * Applies to unsolicited signal quality reports. Response to \ref lwcell_network_rssi
+ * and change between valid and invalid RSSI are always reported.
+ *
+ * Set to `0` to report every update
  */
+#ifndef LWCELL_CFG_RSSI_HYSTERESIS
+#define LWCELL_CFG_RSSI_HYSTERESIS 0
+#endif
 
 /**
- * \brief           Maximal number of open MQTT requests at a time
+ * \brief           Enables `1` or disables `0` modem health supervisor
+ *
+ * Supervisor detects unresponsive device and lost network registration
+ * and recovers them with escalating actions. Check \ref LWCELL_SUPERVISOR for details.
  *
+ * \note            \ref LWCELL_CFG_USE_API_FUNC_EVT must be enabled
  */
-#ifndef LWCELL_CFG_MQTT_MAX_REQUESTS
-#define LWCELL_CFG_MQTT_MAX_REQUESTS 8
+#ifndef LWCELL_CFG_SUPERVISOR
+#define LWCELL_CFG_SUPERVISOR 0
 #endif
 
 /**
- * \brief           Size of MQTT API message queue for received messages
- *
+ * \brief           Supervisor health check interval in units of milliseconds
  */
-#ifndef LWCELL_CFG_MQTT_API_MBOX_SIZE
-#define LWCELL_CFG_MQTT_API_MBOX_SIZE 8
+#ifndef LWCELL_CFG_SUPERVISOR_INTERVAL
+#define LWCELL_CFG_SUPERVISOR_INTERVAL 5000
 #endif
 
 /**
- * \brief           Set debug level for MQTT client module
- *
- * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ * \brief           Number of consecutive command timeouts to consider device unresponsive
  */
-#ifndef LWCELL_CFG_DBG_MQTT
-#define LWCELL_CFG_DBG_MQTT LWCELL_DBG_OFF
+#ifndef LWCELL_CFG_SUPERVISOR_TIMEOUTS
+#define LWCELL_CFG_SUPERVISOR_TIMEOUTS 3
 #endif
 
 /**
- * \brief           Set debug level for MQTT API client module
+ * \brief           Time without any received data before device is probed, in units of milliseconds
  *
- * Possible values are \ref LWCELL_DBG_ON or \ref LWCELL_DBG_OFF
+ * Probe is sent only when no command is in progress. Set to `0` to disable probing on silence
  */
-#ifndef LWCELL_CFG_DBG_MQTT_API
-#define LWCELL_CFG_DBG_MQTT_API LWCELL_DBG_OFF
+#ifndef LWCELL_CFG_SUPERVISOR_RX_SILENCE
+#define LWCELL_CFG_SUPERVISOR_RX_SILENCE 60000
 #endif
 
 /**
- * \}
+ * \brief           Time network registration may be lost before recovery starts, in units of milliseconds
+ *
+ * Same time is given to device to register again after radio cycle or reset,
+ * and is doubled for every next reset of the same fault, up to `8` times
  */
+#ifndef LWCELL_CFG_SUPERVISOR_REG_LOSS
+#define LWCELL_CFG_SUPERVISOR_REG_LOSS 120000
+#endif
 
 /**
- * \brief           Enables `1` or disables `0` network functionality
- *                      used for TCP/IP communication
- *
- * Network must be enabled to use all GPRS/LTE functions such
- * as connection API, FTP, HTTP, etc.
+ * \brief           Maximal time for device to respond to `AT` probe in units of milliseconds
  */
-#ifndef LWCELL_CFG_NETWORK
-#define LWCELL_CFG_NETWORK 0
+#ifndef LWCELL_CFG_SUPERVISOR_PROBE_TIMEOUT
+#define LWCELL_CFG_SUPERVISOR_PROBE_TIMEOUT 1000
 #endif
 
 /**
- * \brief           Ignores `1` or not `0` result from `AT+CGACT` command.
+ * \brief           Enables `1` or disables `0` payload compression module
  *
- * \note            This may be used for data-only SIM cards where command might fail
- *                  when trying to attach to network for data transfer
+ * Module compresses payload with \ref lwcell_netconn_write_compressed
+ * and \ref lwcell_mqtt_client_publish_compressed and decompresses received data.
+ * Check \ref LWCELL_COMPRESS for stream format
  */
-#ifndef LWCELL_CFG_NETWORK_IGNORE_CGACT_RESULT
-#define LWCELL_CFG_NETWORK_IGNORE_CGACT_RESULT 0
+#ifndef LWCELL_CFG_COMPRESS
+#define LWCELL_CFG_COMPRESS 0
 #endif
 
 /**
- * \brief           Enables `1` or disables `0` connection API.
+ * \brief           Maximal block length for compression in units of bytes
  *
- * \note            \ref LWCELL_CFG_NETWORK must be enabled to use connection feature
+ * Block is compressed independently. Longer blocks compress better,
+ * compressor and decompressor state hold one frame of this length.
+ * Receiver must use the same or longer block length as sender
  */
-#ifndef LWCELL_CFG_CONN
-#define LWCELL_CFG_CONN 0
+#ifndef LWCELL_CFG_COMPRESS_BLOCK_LEN
+#define LWCELL_CFG_COMPRESS_BLOCK_LEN 512
 #endif
 
 /**
- * \brief           Enables `1` or disables `0` SMS API.
+ * \brief           Number of bits for compressor hash table index
  *
+ * Hash table has `2^bits` entries of `2` bytes each. Bigger table finds more matches
  */
-#ifndef LWCELL_CFG_SMS
-#define LWCELL_CFG_SMS 0
+#ifndef LWCELL_CFG_COMPRESS_HASH_BITS
+#define LWCELL_CFG_COMPRESS_HASH_BITS 9
 #endif
 
 /**
- * \brief           Enables `1` or disables `0` call API.
+ * \brief           Enables `1` or disables `0` data usage accounting
  *
+ * Payload bytes and estimated protocol overhead are counted in both directions
+ * per connection, per PDP context and in total. Check \ref LWCELL_USAGE for quota handling
+ *
+ * \note            \ref LWCELL_CFG_CONN must be enabled
  */
-#ifndef LWCELL_CFG_CALL
-#define LWCELL_CFG_CALL 0
+#ifndef LWCELL_CFG_USAGE
+#define LWCELL_CFG_USAGE 0
 #endif
 
 /**
- * \brief           Enables `1` or disables `0` phonebook API.
+ * \brief           Estimated protocol overhead per TCP segment in units of bytes
  *
+ * Default value covers IPv4 and TCP headers of data segment and of acknowledge sent by peer
  */
-#ifndef LWCELL_CFG_PHONEBOOK
-#define LWCELL_CFG_PHONEBOOK 0
+#ifndef LWCELL_CFG_USAGE_TCP_OVERHEAD
+#define LWCELL_CFG_USAGE_TCP_OVERHEAD 80
 #endif
 
 /**
- * \brief           Enables `1` or disables `0` HTTP API.
+ * \brief           Estimated protocol overhead per UDP datagram in units of bytes
  *
- * \note            \ref LWCELL_CFG_NETWORK must be enabled to use connection feature
+ * Default value covers IPv4 and UDP headers
  */
-#ifndef LWCELL_CFG_HTTP
-#define LWCELL_CFG_HTTP 0
+#ifndef LWCELL_CFG_USAGE_UDP_OVERHEAD
+#define LWCELL_CFG_USAGE_UDP_OVERHEAD 28
 #endif
 
 /**
- * \brief           Enables `1` or disables `0` FTP API.
- *
- * \note            \ref LWCELL_CFG_NETWORK must be enabled to use connection feature
+ * \brief           Maximal TCP segment length used to estimate number of segments, in units of bytes
  */
-#ifndef LWCELL_CFG_FTP
-#define LWCELL_CFG_FTP 0
+#ifndef LWCELL_CFG_USAGE_TCP_SEGMENT_LEN
+#define LWCELL_CFG_USAGE_TCP_SEGMENT_LEN 1360
 #endif
 
 /**
- * \brief           Enables `1` or disables `0` PING API.
+ * \brief           Enables `1` or disables `0` metric time series
  *
- * \note            \ref LWCELL_CFG_NETWORK must be enabled to use connection feature
+ * Library periodically samples RSSI, registration status, throughput and error counters
+ * to fixed-memory buffer, ready for compact upload. Check \ref LWCELL_METRICS for details
+ *
+ * \note            \ref LWCELL_CFG_STATS_COUNTERS must be enabled.
+ *                  \ref LWCELL_CFG_STATS adds command error and latency metrics
  */
-#ifndef LWCELL_CFG_PING
-#define LWCELL_CFG_PING 0
+#ifndef LWCELL_CFG_METRICS
+#define LWCELL_CFG_METRICS 0
 #endif
 
 /**
- * \brief           Enables `1` or disables `0` USSD API.
+ * \brief           Default sampling interval of metrics in units of milliseconds
  *
+ * Set to `0` to start without sampling, until interval is set with \ref lwcell_metrics_set_interval
  */
-#ifndef LWCELL_CFG_USSD
-#define LWCELL_CFG_USSD 0
+#ifndef LWCELL_CFG_METRICS_INTERVAL
+#define LWCELL_CFG_METRICS_INTERVAL 60000
 #endif
 
 /**
- * \brief           Enables `1` or disables `0` MQTT API.
- * \note            When enabled, it enables the MQTT native API with AT commands from the module
- *                  and does not use MQTT library implementation on top of TCP/IP API
+ * \brief           Size of buffer for encoded metric samples in units of bytes
+ *
+ * Sample with small changes takes about one byte per metric, oldest samples are dropped when buffer is full
  */
-#ifndef LWCELL_CFG_MQTT
-#define LWCELL_CFG_MQTT 0
+#ifndef LWCELL_CFG_METRICS_BUFF_SIZE
+#define LWCELL_CFG_METRICS_BUFF_SIZE 256
 #endif
 
 /**
@@ -679,11 +3031,13 @@
  */
 
 /**
- * \brief           Poll interval for connections in units of milliseconds
+ * \brief           Default poll interval for connections in units of milliseconds
  *
  * Value indicates interval time to call poll event on active connections.
+ * Each connection starts with this interval, application may change it
+ * with \ref lwcell_conn_set_poll_interval. Set to `0` to disable poll events by default.
  *
- * \note            Single poll interval applies for all connections
+ * \note            Poll events of all connections are driven by single timeout
  */
 #ifndef LWCELL_CFG_CONN_POLL_INTERVAL
 #define LWCELL_CFG_CONN_POLL_INTERVAL 500
@@ -747,12 +3101,326 @@ void *  my_memset(void* dst, int b, size_t len);
 
 #if !__DOXYGEN__
 
+#if LWCELL_CFG_INPUT_FROM_ISR && (LWCELL_CFG_INPUT_USE_PROCESS || !LWCELL_CFG_INPUT_BUFF_ATOMIC)
+#error "LWCELL_CFG_INPUT_FROM_ISR requires LWCELL_CFG_INPUT_BUFF_ATOMIC enabled and LWCELL_CFG_INPUT_USE_PROCESS disabled!"
+#endif /* LWCELL_CFG_INPUT_FROM_ISR && (LWCELL_CFG_INPUT_USE_PROCESS || !LWCELL_CFG_INPUT_BUFF_ATOMIC) */
+
+#if LWCELL_CFG_RCV_BUFF_AUTO_GROW && (LWCELL_CFG_INPUT_USE_PROCESS || LWCELL_CFG_INPUT_BUFF_ATOMIC)
+#error "LWCELL_CFG_RCV_BUFF_AUTO_GROW requires LWCELL_CFG_INPUT_USE_PROCESS and LWCELL_CFG_INPUT_BUFF_ATOMIC disabled!"
+#endif /* LWCELL_CFG_RCV_BUFF_AUTO_GROW && (LWCELL_CFG_INPUT_USE_PROCESS || LWCELL_CFG_INPUT_BUFF_ATOMIC) */
+
 #if !LWCELL_CFG_OS
 #if LWCELL_CFG_INPUT_USE_PROCESS
 #error "LWCELL_CFG_INPUT_USE_PROCESS may only be enabled when OS is used!"
 #endif /* LWCELL_CFG_INPUT_USE_PROCESS */
+#if LWCELL_CFG_FINE_LOCK
+#error "LWCELL_CFG_FINE_LOCK may only be enabled when OS is used!"
+#endif /* LWCELL_CFG_FINE_LOCK */
+#if LWCELL_CFG_THREAD_PROCESS_NOTIFY
+#error "LWCELL_CFG_THREAD_PROCESS_NOTIFY may only be enabled when OS is used!"
+#endif /* LWCELL_CFG_THREAD_PROCESS_NOTIFY */
+#if LWCELL_CFG_CMD_TIMEOUT_ADAPT
+#error "LWCELL_CFG_CMD_TIMEOUT_ADAPT may only be enabled when OS is used!"
+#endif /* LWCELL_CFG_CMD_TIMEOUT_ADAPT */
+#if LWCELL_CFG_CQ
+#error "LWCELL_CFG_CQ may only be enabled when OS is used!"
+#endif /* LWCELL_CFG_CQ */
+#if LWCELL_CFG_NETCONN
+#error "LWCELL_CFG_NETCONN may only be enabled when OS is used!"
+#endif /* LWCELL_CFG_NETCONN */
+#if LWCELL_CFG_EVT_DEFERRED
+#error "LWCELL_CFG_EVT_DEFERRED may only be enabled when OS is used!"
+#endif /* LWCELL_CFG_EVT_DEFERRED */
+#if LWCELL_CFG_DBG_DEFERRED
+#error "LWCELL_CFG_DBG_DEFERRED may only be enabled when OS is used!"
+#endif /* LWCELL_CFG_DBG_DEFERRED */
+#if LWCELL_CFG_STATS_THREADS
+#error "LWCELL_CFG_STATS_THREADS may only be enabled when OS is used!"
+#endif /* LWCELL_CFG_STATS_THREADS */
+#if LWCELL_CFG_THREAD_AFFINITY
+#error "LWCELL_CFG_THREAD_AFFINITY may only be enabled when OS is used!"
+#endif /* LWCELL_CFG_THREAD_AFFINITY */
+#if LWCELL_CFG_THREAD_PROCESS_IPD_BOOST
+#error "LWCELL_CFG_THREAD_PROCESS_IPD_BOOST may only be enabled when OS is used!"
+#endif /* LWCELL_CFG_THREAD_PROCESS_IPD_BOOST */
 #endif /* !LWCELL_CFG_OS */
 
+#if LWCELL_CFG_THREAD_PROCESS_IPD_BOOST && LWCELL_CFG_INPUT_USE_PROCESS
+#error "LWCELL_CFG_THREAD_PROCESS_IPD_BOOST cannot be used with LWCELL_CFG_INPUT_USE_PROCESS!"
+#endif /* LWCELL_CFG_THREAD_PROCESS_IPD_BOOST && LWCELL_CFG_INPUT_USE_PROCESS */
+
+#if LWCELL_CFG_INPUT_ZERO_COPY && !LWCELL_CFG_INPUT_USE_PROCESS
+#error "LWCELL_CFG_INPUT_ZERO_COPY may only be enabled when LWCELL_CFG_INPUT_USE_PROCESS is enabled!"
+#endif /* LWCELL_CFG_INPUT_ZERO_COPY && !LWCELL_CFG_INPUT_USE_PROCESS */
+
+#if LWCELL_CFG_PBUF_POOL
+#if LWCELL_CFG_PBUF_POOL_SMALL_SIZE >= LWCELL_CFG_PBUF_POOL_MEDIUM_SIZE                                              \
+    || LWCELL_CFG_PBUF_POOL_MEDIUM_SIZE >= LWCELL_CFG_PBUF_POOL_LARGE_SIZE
+#error "LWCELL_CFG_PBUF_POOL_*_SIZE values must be in ascending order!"
+#endif
+#endif /* LWCELL_CFG_PBUF_POOL */
+
+/* Packet buffer reference counter uses C11 atomics when compiler provides them, system port otherwise */
+#if LWCELL_CFG_PBUF_REF_ATOMIC && defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L                          \
+    && !defined(__STDC_NO_ATOMICS__)
+#define LWCELL_PBUF_REF_STDATOMIC 1
+#else
+#define LWCELL_PBUF_REF_STDATOMIC 0
+#endif
+
+#if LWCELL_CFG_STATS && (LWCELL_CFG_STATS_HIST_BUCKETS < 2 || LWCELL_CFG_STATS_HIST_BUCKETS > 32)
+#error "LWCELL_CFG_STATS_HIST_BUCKETS must be between 2 and 32!"
+#endif /* LWCELL_CFG_STATS && (LWCELL_CFG_STATS_HIST_BUCKETS < 2 || LWCELL_CFG_STATS_HIST_BUCKETS > 32) */
+
+#if LWCELL_CFG_CONN_MANUAL_RECV && !LWCELL_CFG_CONN
+#error "LWCELL_CFG_CONN must be enabled when LWCELL_CFG_CONN_MANUAL_RECV is enabled!"
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV && !LWCELL_CFG_CONN */
+
+#if LWCELL_CFG_CONN_RECV_FROM && !LWCELL_CFG_CONN
+#error "LWCELL_CFG_CONN must be enabled when LWCELL_CFG_CONN_RECV_FROM is enabled!"
+#endif /* LWCELL_CFG_CONN_RECV_FROM && !LWCELL_CFG_CONN */
+
+#if LWCELL_CFG_NETWORK_ATTACH_INCREMENTAL && !LWCELL_CFG_CONN
+#error "LWCELL_CFG_CONN must be enabled when LWCELL_CFG_NETWORK_ATTACH_INCREMENTAL is enabled!"
+#endif /* LWCELL_CFG_NETWORK_ATTACH_INCREMENTAL && !LWCELL_CFG_CONN */
+
+#if LWCELL_CFG_NETWORK_PDP_RECOVERY && (!LWCELL_CFG_NETWORK || !LWCELL_CFG_CONN)
+#error "LWCELL_CFG_NETWORK and LWCELL_CFG_CONN must be enabled when LWCELL_CFG_NETWORK_PDP_RECOVERY is enabled!"
+#endif /* LWCELL_CFG_NETWORK_PDP_RECOVERY && (!LWCELL_CFG_NETWORK || !LWCELL_CFG_CONN) */
+
+#if LWCELL_CFG_NETWORK_PDP_RECOVERY && !LWCELL_CFG_USE_API_FUNC_EVT
+#error "LWCELL_CFG_USE_API_FUNC_EVT must be enabled when LWCELL_CFG_NETWORK_PDP_RECOVERY is enabled!"
+#endif /* LWCELL_CFG_NETWORK_PDP_RECOVERY && !LWCELL_CFG_USE_API_FUNC_EVT */
+
+#if LWCELL_CFG_CONN_SERVER && !LWCELL_CFG_CONN
+#error "LWCELL_CFG_CONN must be enabled when LWCELL_CFG_CONN_SERVER is enabled!"
+#endif /* LWCELL_CFG_CONN_SERVER && !LWCELL_CFG_CONN */
+
+#if LWCELL_CFG_DNS && (!LWCELL_CFG_CONN || LWCELL_CFG_DNS_CACHE_SIZE < 1 || LWCELL_CFG_DNS_MAX_ADDR < 1)
+#error "LWCELL_CFG_CONN must be enabled and DNS cache sizes must be at least 1 when LWCELL_CFG_DNS is enabled!"
+#endif /* LWCELL_CFG_DNS && (!LWCELL_CFG_CONN || LWCELL_CFG_DNS_CACHE_SIZE < 1 || LWCELL_CFG_DNS_MAX_ADDR < 1) */
+
+#if LWCELL_CFG_CONN_MANUAL_RECV && LWCELL_CFG_CONN_RECV_READ_AHEAD > 2
+#error "LWCELL_CFG_CONN_RECV_READ_AHEAD must be between 0 and 2!"
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV && LWCELL_CFG_CONN_RECV_READ_AHEAD > 2 */
+
+#if LWCELL_CFG_CONN_CA_SOCKET && !LWCELL_CFG_CONN_MANUAL_RECV
+#error "LWCELL_CFG_CONN_MANUAL_RECV must be enabled when LWCELL_CFG_CONN_CA_SOCKET is enabled!"
+#endif /* LWCELL_CFG_CONN_CA_SOCKET && !LWCELL_CFG_CONN_MANUAL_RECV */
+
+#if LWCELL_CFG_RCV_LINE_SIZE < 64
+#error "LWCELL_CFG_RCV_LINE_SIZE must be at least 64!"
+#endif /* LWCELL_CFG_RCV_LINE_SIZE < 64 */
+
+#if LWCELL_CFG_MEM_CLASSES && LWCELL_CFG_MEM_CUSTOM
+#error "LWCELL_CFG_MEM_CLASSES cannot be used with LWCELL_CFG_MEM_CUSTOM!"
+#endif /* LWCELL_CFG_MEM_CLASSES && LWCELL_CFG_MEM_CUSTOM */
+
+#if LWCELL_CFG_MEM_TLSF && LWCELL_CFG_MEM_ALIGNMENT < 4
+#error "LWCELL_CFG_MEM_ALIGNMENT must be at least 4 when LWCELL_CFG_MEM_TLSF is enabled!"
+#endif /* LWCELL_CFG_MEM_TLSF && LWCELL_CFG_MEM_ALIGNMENT < 4 */
+
+#if LWCELL_CFG_STATIC_ALLOC
+#if LWCELL_CFG_MEM_CUSTOM || LWCELL_CFG_MEM_TLSF
+#error "LWCELL_CFG_STATIC_ALLOC cannot be used with LWCELL_CFG_MEM_CUSTOM or LWCELL_CFG_MEM_TLSF!"
+#endif
+#if LWCELL_CFG_MEM_CLASSES
+#error "LWCELL_CFG_MEM_CLASSES cannot be used with LWCELL_CFG_STATIC_ALLOC!"
+#endif
+#if LWCELL_CFG_STATIC_ALLOC_SMALL_SIZE >= LWCELL_CFG_STATIC_ALLOC_MEDIUM_SIZE                                          \
+    || LWCELL_CFG_STATIC_ALLOC_MEDIUM_SIZE >= LWCELL_CFG_STATIC_ALLOC_LARGE_SIZE
+#error "LWCELL_CFG_STATIC_ALLOC_*_SIZE values must be in ascending order!"
+#endif
+#endif /* LWCELL_CFG_STATIC_ALLOC */
+
+#if LWCELL_CFG_MEM_TAGS && LWCELL_CFG_MEM_CUSTOM
+#error "LWCELL_CFG_MEM_TAGS cannot be used with LWCELL_CFG_MEM_CUSTOM!"
+#endif /* LWCELL_CFG_MEM_TAGS && LWCELL_CFG_MEM_CUSTOM */
+
+#if LWCELL_CFG_FTP && (LWCELL_CFG_FTP_CHUNK_LEN < 1 || LWCELL_CFG_FTP_CHUNK_LEN > 1460)
+#error "LWCELL_CFG_FTP_CHUNK_LEN must be between 1 and 1460!"
+#endif /* LWCELL_CFG_FTP && (LWCELL_CFG_FTP_CHUNK_LEN < 1 || LWCELL_CFG_FTP_CHUNK_LEN > 1460) */
+
+#if LWCELL_CFG_SSL && (LWCELL_CFG_SSL_FILE_CHUNK_LEN < 1 || LWCELL_CFG_SSL_FILE_CHUNK_LEN > 10240)
+#error "LWCELL_CFG_SSL_FILE_CHUNK_LEN must be between 1 and 10240!"
+#endif /* LWCELL_CFG_SSL && (LWCELL_CFG_SSL_FILE_CHUNK_LEN < 1 || LWCELL_CFG_SSL_FILE_CHUNK_LEN > 10240) */
+
+#if LWCELL_CFG_FS && (LWCELL_CFG_FS_CHUNK_LEN < 1 || LWCELL_CFG_FS_CHUNK_LEN > 10240)
+#error "LWCELL_CFG_FS_CHUNK_LEN must be between 1 and 10240!"
+#endif /* LWCELL_CFG_FS && (LWCELL_CFG_FS_CHUNK_LEN < 1 || LWCELL_CFG_FS_CHUNK_LEN > 10240) */
+
+#if LWCELL_CFG_CMUX && (LWCELL_CFG_CMUX_FRAME_LEN < 1 || LWCELL_CFG_CMUX_FRAME_LEN > 127)
+#error "LWCELL_CFG_CMUX_FRAME_LEN must be between 1 and 127!"
+#endif /* LWCELL_CFG_CMUX && (LWCELL_CFG_CMUX_FRAME_LEN < 1 || LWCELL_CFG_CMUX_FRAME_LEN > 127) */
+
+#if LWCELL_CFG_CMUX && LWCELL_CFG_INPUT_ZERO_COPY
+#error "LWCELL_CFG_INPUT_ZERO_COPY cannot be used when LWCELL_CFG_CMUX is enabled!"
+#endif /* LWCELL_CFG_CMUX && LWCELL_CFG_INPUT_ZERO_COPY */
+
+#if LWCELL_CFG_SMS_PDU && !LWCELL_CFG_SMS
+#error "LWCELL_CFG_SMS must be enabled when LWCELL_CFG_SMS_PDU is enabled!"
+#endif /* LWCELL_CFG_SMS_PDU && !LWCELL_CFG_SMS */
+
+#if LWCELL_CFG_SMS_DIRECT && !LWCELL_CFG_SMS
+#error "LWCELL_CFG_SMS must be enabled when LWCELL_CFG_SMS_DIRECT is enabled!"
+#endif /* LWCELL_CFG_SMS_DIRECT && !LWCELL_CFG_SMS */
+
+#if LWCELL_CFG_SMS_INBOX && !LWCELL_CFG_SMS
+#error "LWCELL_CFG_SMS must be enabled when LWCELL_CFG_SMS_INBOX is enabled!"
+#endif /* LWCELL_CFG_SMS_INBOX && !LWCELL_CFG_SMS */
+
+#if LWCELL_CFG_PHONEBOOK_MIRROR && !LWCELL_CFG_PHONEBOOK
+#error "LWCELL_CFG_PHONEBOOK must be enabled when LWCELL_CFG_PHONEBOOK_MIRROR is enabled!"
+#endif /* LWCELL_CFG_PHONEBOOK_MIRROR && !LWCELL_CFG_PHONEBOOK */
+
+#if LWCELL_CFG_PHONEBOOK_MIRROR && (LWCELL_CFG_PHONEBOOK_MIRROR_SIZE < 1 || LWCELL_CFG_PHONEBOOK_MIRROR_SIZE > 65535)
+#error "LWCELL_CFG_PHONEBOOK_MIRROR_SIZE must be between 1 and 65535!"
+#endif /* LWCELL_CFG_PHONEBOOK_MIRROR && (LWCELL_CFG_PHONEBOOK_MIRROR_SIZE < 1 || ...) */
+
+#if LWCELL_CFG_PHONEBOOK && LWCELL_CFG_PHONEBOOK_READ_CHUNK < 1
+#error "LWCELL_CFG_PHONEBOOK_READ_CHUNK must be greater than 0!"
+#endif /* LWCELL_CFG_PHONEBOOK && LWCELL_CFG_PHONEBOOK_READ_CHUNK < 1 */
+
+#if LWCELL_CFG_PHONEBOOK_MIRROR && (LWCELL_CFG_PHONEBOOK_MIRROR_DIGITS < 1 || LWCELL_CFG_PHONEBOOK_MIRROR_DIGITS > 25)
+#error "LWCELL_CFG_PHONEBOOK_MIRROR_DIGITS must be between 1 and 25!"
+#endif /* LWCELL_CFG_PHONEBOOK_MIRROR && (LWCELL_CFG_PHONEBOOK_MIRROR_DIGITS < 1 || ...) */
+
+#if LWCELL_CFG_RESET_FAST_BOOT && LWCELL_CFG_RESET_POLL_INTERVAL == 0
+#error "LWCELL_CFG_RESET_POLL_INTERVAL must be greater than 0 when LWCELL_CFG_RESET_FAST_BOOT is enabled!"
+#endif /* LWCELL_CFG_RESET_FAST_BOOT && LWCELL_CFG_RESET_POLL_INTERVAL == 0 */
+
+#if LWCELL_CFG_OTA && !LWCELL_CFG_NETCONN
+#error "LWCELL_CFG_NETCONN must be enabled when LWCELL_CFG_OTA is enabled!"
+#endif /* LWCELL_CFG_OTA && !LWCELL_CFG_NETCONN */
+#if LWCELL_CFG_WS && !LWCELL_CFG_NETCONN
+#error "LWCELL_CFG_NETCONN must be enabled when LWCELL_CFG_WS is enabled!"
+#endif /* LWCELL_CFG_WS && !LWCELL_CFG_NETCONN */
+
+#if LWCELL_CFG_WS && (LWCELL_CFG_WS_MAX_PAYLOAD_LEN < 125)
+#error "LWCELL_CFG_WS_MAX_PAYLOAD_LEN must not be below 125!"
+#endif /* LWCELL_CFG_WS && (LWCELL_CFG_WS_MAX_PAYLOAD_LEN < 125) */
+
+#if LWCELL_CFG_CELL_INFO && LWCELL_CFG_CELL_INFO_NEIGHBOURS < 1
+#error "LWCELL_CFG_CELL_INFO_NEIGHBOURS must be at least 1 when LWCELL_CFG_CELL_INFO is enabled!"
+#endif /* LWCELL_CFG_CELL_INFO && LWCELL_CFG_CELL_INFO_NEIGHBOURS < 1 */
+
+#if LWCELL_CFG_HTTP_CLIENT && !LWCELL_CFG_NETCONN
+#error "LWCELL_CFG_NETCONN must be enabled when LWCELL_CFG_HTTP_CLIENT is enabled!"
+#endif /* LWCELL_CFG_HTTP_CLIENT && !LWCELL_CFG_NETCONN */
+
+#if LWCELL_CFG_HTTP_CLIENT && (LWCELL_CFG_HTTP_CLIENT_PIPELINE_LEN < 1 || LWCELL_CFG_HTTP_CLIENT_PIPELINE_LEN > 32)
+#error "LWCELL_CFG_HTTP_CLIENT_PIPELINE_LEN must be between 1 and 32!"
+#endif /* LWCELL_CFG_HTTP_CLIENT && (LWCELL_CFG_HTTP_CLIENT_PIPELINE_LEN < 1 || ...) */
+
+#if LWCELL_CFG_COAP && !LWCELL_CFG_CONN
+#error "LWCELL_CFG_CONN must be enabled when LWCELL_CFG_COAP is enabled!"
+#endif /* LWCELL_CFG_COAP && !LWCELL_CFG_CONN */
+
+#if LWCELL_CFG_COAP                                                                                                   \
+    && (LWCELL_CFG_COAP_BLOCK_SZX > 6 || LWCELL_CFG_COAP_MSG_LEN < (16 << LWCELL_CFG_COAP_BLOCK_SZX) + 32)
+#error "LWCELL_CFG_COAP_BLOCK_SZX must not exceed 6 and LWCELL_CFG_COAP_MSG_LEN must hold block with headers!"
+#endif /* LWCELL_CFG_COAP && (LWCELL_CFG_COAP_BLOCK_SZX > 6 || ...) */
+
+#if LWCELL_CFG_USAGE && (!LWCELL_CFG_CONN || LWCELL_CFG_USAGE_TCP_SEGMENT_LEN == 0)
+#error "LWCELL_CFG_CONN must be enabled and LWCELL_CFG_USAGE_TCP_SEGMENT_LEN must be greater than 0!"
+#endif /* LWCELL_CFG_USAGE && (!LWCELL_CFG_CONN || LWCELL_CFG_USAGE_TCP_SEGMENT_LEN == 0) */
+
+#if LWCELL_CFG_METRICS && !LWCELL_CFG_STATS_COUNTERS
+#error "LWCELL_CFG_STATS_COUNTERS must be enabled when LWCELL_CFG_METRICS is enabled!"
+#endif /* LWCELL_CFG_METRICS && !LWCELL_CFG_STATS_COUNTERS */
+
+#if LWCELL_CFG_METRICS && LWCELL_CFG_METRICS_BUFF_SIZE < 64
+#error "LWCELL_CFG_METRICS_BUFF_SIZE must be at least 64 bytes to hold one encoded sample!"
+#endif /* LWCELL_CFG_METRICS && LWCELL_CFG_METRICS_BUFF_SIZE < 64 */
+
+#if LWCELL_CFG_MQTT_API_RX_REF && LWCELL_CFG_MQTT_API_BUF_POOL_SIZE == 0
+#error "LWCELL_CFG_MQTT_API_BUF_POOL_SIZE must be greater than 0 when LWCELL_CFG_MQTT_API_RX_REF is enabled!"
+#endif /* LWCELL_CFG_MQTT_API_RX_REF && LWCELL_CFG_MQTT_API_BUF_POOL_SIZE == 0 */
+
+#if LWCELL_CFG_DBG_DEFERRED && LWCELL_CFG_DBG_DEFERRED_REC_MAX_LEN < (LWCELL_CFG_DBG_DEFERRED_STR_MAX_LEN + 16)
+#error "LWCELL_CFG_DBG_DEFERRED_REC_MAX_LEN must be at least 16 bytes longer than LWCELL_CFG_DBG_DEFERRED_STR_MAX_LEN!"
+#endif /* LWCELL_CFG_DBG_DEFERRED && LWCELL_CFG_DBG_DEFERRED_REC_MAX_LEN < (LWCELL_CFG_DBG_DEFERRED_STR_MAX_LEN + 16) */
+
+#if LWCELL_CFG_CONN_SEND_FAIR && !LWCELL_CFG_CONN
+#error "LWCELL_CFG_CONN must be enabled when LWCELL_CFG_CONN_SEND_FAIR is enabled!"
+#endif /* LWCELL_CFG_CONN_SEND_FAIR && !LWCELL_CFG_CONN */
+
+#if LWCELL_CFG_PWR_RADIO_RELEASE && !LWCELL_CFG_PWR
+#error "LWCELL_CFG_PWR must be enabled when LWCELL_CFG_PWR_RADIO_RELEASE is enabled!"
+#endif /* LWCELL_CFG_PWR_RADIO_RELEASE && !LWCELL_CFG_PWR */
+
+#if LWCELL_CFG_SNAPSHOT && LWCELL_CFG_RESET_ON_INIT
+#error "LWCELL_CFG_RESET_ON_INIT must be disabled when LWCELL_CFG_SNAPSHOT is enabled!"
+#endif /* LWCELL_CFG_SNAPSHOT && LWCELL_CFG_RESET_ON_INIT */
+
+#if LWCELL_CFG_AT_ECHO_SKIP && !LWCELL_CFG_AT_ECHO
+#error "LWCELL_CFG_AT_ECHO must be enabled when LWCELL_CFG_AT_ECHO_SKIP is enabled!"
+#endif /* LWCELL_CFG_AT_ECHO_SKIP && !LWCELL_CFG_AT_ECHO */
+
+#if LWCELL_CFG_PRODUCER_ADMISSION && (LWCELL_CFG_PRODUCER_LIMIT < 1 || LWCELL_CFG_PRODUCER_PRIO_LIMIT < 1)
+#error "LWCELL_CFG_PRODUCER_LIMIT and LWCELL_CFG_PRODUCER_PRIO_LIMIT must be greater than 0!"
+#endif /* LWCELL_CFG_PRODUCER_ADMISSION && (LWCELL_CFG_PRODUCER_LIMIT < 1 || LWCELL_CFG_PRODUCER_PRIO_LIMIT < 1) */
+
+#if LWCELL_CFG_CONN_TX_WINDOW > 0 && !LWCELL_CFG_CONN
+#error "LWCELL_CFG_CONN must be enabled when LWCELL_CFG_CONN_TX_WINDOW is greater than 0!"
+#endif /* LWCELL_CFG_CONN_TX_WINDOW > 0 && !LWCELL_CFG_CONN */
+
+#if LWCELL_CFG_CONN_SEND_DEADLINE && !LWCELL_CFG_CONN
+#error "LWCELL_CFG_CONN must be enabled when LWCELL_CFG_CONN_SEND_DEADLINE is enabled!"
+#endif /* LWCELL_CFG_CONN_SEND_DEADLINE && !LWCELL_CFG_CONN */
+
+#if LWCELL_CFG_CONN_SEND_STREAM && !LWCELL_CFG_CONN
+#error "LWCELL_CFG_CONN must be enabled when LWCELL_CFG_CONN_SEND_STREAM is enabled!"
+#endif /* LWCELL_CFG_CONN_SEND_STREAM && !LWCELL_CFG_CONN */
+
+#if LWCELL_CFG_CONN_SEND_STREAM && LWCELL_CFG_CONN_SEND_STREAM_BUFF_LEN == 0
+#error "LWCELL_CFG_CONN_SEND_STREAM_BUFF_LEN must be greater than 0!"
+#endif /* LWCELL_CFG_CONN_SEND_STREAM && LWCELL_CFG_CONN_SEND_STREAM_BUFF_LEN == 0 */
+
+#if LWCELL_CFG_CONN_RECV_FN && !LWCELL_CFG_CONN
+#error "LWCELL_CFG_CONN must be enabled when LWCELL_CFG_CONN_RECV_FN is enabled!"
+#endif /* LWCELL_CFG_CONN_RECV_FN && !LWCELL_CFG_CONN */
+
+#if LWCELL_CFG_CONN_RECV_BATCH > 0 && !LWCELL_CFG_CONN_RECV_FN
+#error "LWCELL_CFG_CONN_RECV_FN must be enabled when LWCELL_CFG_CONN_RECV_BATCH is greater than 0!"
+#endif /* LWCELL_CFG_CONN_RECV_BATCH > 0 && !LWCELL_CFG_CONN_RECV_FN */
+
+#if LWCELL_CFG_CONN_SEND_ADAPT && (!LWCELL_CFG_CONN || LWCELL_CFG_CONN_SEND_ADAPT_GROW < 1)
+#error "LWCELL_CFG_CONN must be enabled and LWCELL_CFG_CONN_SEND_ADAPT_GROW must be at least 1!"
+#endif /* LWCELL_CFG_CONN_SEND_ADAPT && (!LWCELL_CFG_CONN || LWCELL_CFG_CONN_SEND_ADAPT_GROW < 1) */
+
+#if LWCELL_CFG_CONN_WRITE_RING && (!LWCELL_CFG_CONN || LWCELL_CFG_CONN_WRITE_RING_LEN < LWCELL_CFG_CONN_MAX_DATA_LEN)
+#error "LWCELL_CFG_CONN must be enabled and LWCELL_CFG_CONN_WRITE_RING_LEN must not be below maximal data length!"
+#endif /* LWCELL_CFG_CONN_WRITE_RING && (!LWCELL_CFG_CONN || LWCELL_CFG_CONN_WRITE_RING_LEN < ...) */
+
+#if LWCELL_CFG_NETWORK_CONTEXTS < 1 || LWCELL_CFG_NETWORK_CONTEXTS > 2
+#error "LWCELL_CFG_NETWORK_CONTEXTS must be 1 or 2!"
+#endif /* LWCELL_CFG_NETWORK_CONTEXTS < 1 || LWCELL_CFG_NETWORK_CONTEXTS > 2 */
+
+#if LWCELL_CFG_NETWORK_CONTEXTS > 1 && !LWCELL_CFG_CONN
+#error "LWCELL_CFG_CONN must be enabled when LWCELL_CFG_NETWORK_CONTEXTS is greater than 1!"
+#endif /* LWCELL_CFG_NETWORK_CONTEXTS > 1 && !LWCELL_CFG_CONN */
+
+#if LWCELL_CFG_COMPRESS && (LWCELL_CFG_COMPRESS_BLOCK_LEN < 16 || LWCELL_CFG_COMPRESS_BLOCK_LEN > 16384)
+#error "LWCELL_CFG_COMPRESS_BLOCK_LEN must be between 16 and 16384!"
+#endif /* LWCELL_CFG_COMPRESS && (LWCELL_CFG_COMPRESS_BLOCK_LEN < 16 || LWCELL_CFG_COMPRESS_BLOCK_LEN > 16384) */
+
+#if LWCELL_CFG_COMPRESS && (LWCELL_CFG_COMPRESS_HASH_BITS < 8 || LWCELL_CFG_COMPRESS_HASH_BITS > 14)
+#error "LWCELL_CFG_COMPRESS_HASH_BITS must be between 8 and 14!"
+#endif /* LWCELL_CFG_COMPRESS && (LWCELL_CFG_COMPRESS_HASH_BITS < 8 || LWCELL_CFG_COMPRESS_HASH_BITS > 14) */
+
+#if LWCELL_CFG_SUPERVISOR && !LWCELL_CFG_USE_API_FUNC_EVT
+#error "LWCELL_CFG_USE_API_FUNC_EVT must be enabled when LWCELL_CFG_SUPERVISOR is enabled!"
+#endif /* LWCELL_CFG_SUPERVISOR && !LWCELL_CFG_USE_API_FUNC_EVT */
+
+#if LWCELL_CFG_SUPERVISOR && LWCELL_CFG_CMD_TIMEOUT_ADAPT && LWCELL_CFG_CMD_STALL_PROBES > 0
+#error "LWCELL_CFG_CMD_STALL_PROBES must be 0 when LWCELL_CFG_SUPERVISOR is enabled!"
+#endif /* LWCELL_CFG_SUPERVISOR && LWCELL_CFG_CMD_TIMEOUT_ADAPT && LWCELL_CFG_CMD_STALL_PROBES > 0 */
+
+#if LWCELL_CFG_SYS_STATIC_ALLOC && LWCELL_CFG_SYS_STATIC_MBOX_SIZE < 1
+#error "LWCELL_CFG_SYS_STATIC_MBOX_SIZE must be greater than 0!"
+#endif /* LWCELL_CFG_SYS_STATIC_ALLOC && LWCELL_CFG_SYS_STATIC_MBOX_SIZE < 1 */
+
 #endif /* !__DOXYGEN__ */
 
 #include "lwcell/lwcell_debug.h"
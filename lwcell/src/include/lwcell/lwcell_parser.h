@@ -40,6 +40,34 @@ extern "C" {
 
 #include "lwcell/lwcell_types.h"
 
+/**
+ * \brief           Maximal number of fields split from single response line
+ */
+#define LWCELLI_FIELDS_MAX 8
+
+/**
+ * \brief           Single field of comma separated response, not `NULL` terminated
+ */
+typedef struct {
+    const char* p; /*!< Field start, without quotes */
+    size_t len;    /*!< Field length in units of characters */
+} lwcelli_field_t;
+
+/**
+ * \brief           Comma separated response line split to fields
+ */
+typedef struct {
+    lwcelli_field_t fld[LWCELLI_FIELDS_MAX]; /*!< Fields of response line */
+    size_t cnt;                              /*!< Number of valid fields */
+} lwcelli_fields_t;
+
+size_t lwcelli_fields_split(lwcelli_fields_t* f, const char* str);
+int32_t lwcelli_fields_get_int(const lwcelli_fields_t* f, size_t idx);
+uint32_t lwcelli_fields_get_hex(const lwcelli_fields_t* f, size_t idx);
+uint8_t lwcelli_fields_get_ip(const lwcelli_fields_t* f, size_t idx, lwcell_ip_t* ip);
+size_t lwcelli_fields_get_str(const lwcelli_fields_t* f, size_t idx, char* dst, size_t dst_len);
+uint8_t lwcelli_fields_is(const lwcelli_fields_t* f, size_t idx, const char* str);
+
 int32_t lwcelli_parse_number(const char** str);
 uint8_t lwcelli_parse_string(const char** src, char* dst, size_t dst_len, uint8_t trim);
 uint8_t lwcelli_parse_ip(const char** src, lwcell_ip_t* ip);
@@ -47,10 +75,19 @@ uint8_t lwcelli_parse_mac(const char** src, lwcell_mac_t* mac);
 
 uint8_t lwcelli_parse_cpin(const char* str, uint8_t send_evt);
 uint8_t lwcelli_parse_creg(const char* str, uint8_t skip_first);
+#if LWCELL_CFG_NETWORK_PS_REG
+uint8_t lwcelli_parse_ps_reg(const char* str, uint8_t skip_first);
+#endif /* LWCELL_CFG_NETWORK_PS_REG */
+#if LWCELL_CFG_NETWORK_BAND
+uint8_t lwcelli_parse_cpsi(const char* str);
+#endif /* LWCELL_CFG_NETWORK_BAND */
 uint8_t lwcelli_parse_csq(const char* str);
 
 uint8_t lwcelli_parse_cmgs(const char* str, size_t* num);
 uint8_t lwcelli_parse_cmti(const char* str, uint8_t send_evt);
+#if LWCELL_CFG_SMS_DIRECT
+uint8_t lwcelli_parse_cmt(const char* str);
+#endif /* LWCELL_CFG_SMS_DIRECT */
 uint8_t lwcelli_parse_cmgr(const char* str);
 uint8_t lwcelli_parse_cmgl(const char* str);
 
@@ -59,6 +96,7 @@ uint8_t lwcelli_parse_at_sdk_version(const char* str, uint32_t* version_out);
 uint8_t lwcelli_parse_cops_scan(uint8_t ch, uint8_t reset);
 uint8_t lwcelli_parse_cops(const char* str);
 uint8_t lwcelli_parse_clcc(const char* str, uint8_t send_evt);
+uint8_t lwcelli_parse_clip(const char* str);
 
 uint8_t lwcelli_parse_cpbs(const char* str, uint8_t opt);
 uint8_t lwcelli_parse_cpms(const char* str, uint8_t opt);
@@ -68,6 +106,49 @@ uint8_t lwcelli_parse_cpbf(const char* str);
 uint8_t lwcelli_parse_cipstatus_conn(const char* str, uint8_t is_conn_line, uint8_t* continueScan);
 
 uint8_t lwcelli_parse_ipd(const char* str);
+size_t lwcelli_parse_ipd_header(const uint8_t* d, size_t d_len);
+#if LWCELL_CFG_CONN_RECV_FROM
+uint8_t lwcelli_parse_recv_from(const char* str);
+#endif /* LWCELL_CFG_CONN_RECV_FROM */
+#if LWCELL_CFG_CONN_MANUAL_RECV
+uint8_t lwcelli_parse_ciprxget(const char* str);
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV */
+#if LWCELL_CFG_CONN_CA_SOCKET
+uint8_t lwcelli_parse_carecv(const char* str);
+#endif /* LWCELL_CFG_CONN_CA_SOCKET */
+
+#if LWCELL_CFG_MQTT
+uint8_t lwcelli_parse_smsub(const char* str);
+uint8_t lwcelli_parse_smstate(const char* str);
+#endif /* LWCELL_CFG_MQTT */
+
+#if LWCELL_CFG_HTTP
+uint8_t lwcelli_parse_http_result(const char* str);
+uint8_t lwcelli_parse_http_read(const char* str);
+#endif /* LWCELL_CFG_HTTP */
+
+#if LWCELL_CFG_FTP
+uint8_t lwcelli_parse_ftpget(const char* str);
+uint8_t lwcelli_parse_ftpput(const char* str);
+#endif /* LWCELL_CFG_FTP */
+#if LWCELL_CFG_PING
+uint8_t lwcelli_parse_cipping(const char* str);
+#endif /* LWCELL_CFG_PING */
+#if LWCELL_CFG_DNS
+uint8_t lwcelli_parse_cdnsgip(const char* str);
+#endif /* LWCELL_CFG_DNS */
+#if LWCELL_CFG_GNSS
+uint8_t lwcelli_parse_gnsinf(const char* str, lwcell_gnss_fix_t* fix);
+#endif /* LWCELL_CFG_GNSS */
+#if LWCELL_CFG_CELL_INFO
+uint8_t lwcelli_parse_ceng(const char* str, lwcell_cell_info_t* info);
+#endif /* LWCELL_CFG_CELL_INFO */
+#if LWCELL_CFG_TIME
+uint8_t lwcelli_parse_psuttz(const char* str);
+uint8_t lwcelli_parse_ctzv(const char* str);
+uint8_t lwcelli_parse_cclk(const char* str);
+uint8_t lwcelli_parse_cipgsmloc(const char* str);
+#endif /* LWCELL_CFG_TIME */
 
 #if defined(__cplusplus)
 }
@@ -48,6 +48,10 @@ extern "C" {
  */
 
 lwcell_pbuf_p lwcell_pbuf_new(size_t len);
+#if LWCELL_CFG_INPUT_ZERO_COPY || __DOXYGEN__
+lwcell_pbuf_p lwcell_pbuf_new_ref(const void* mem, size_t len, lwcell_pbuf_release_fn release_fn, void* arg);
+uint8_t lwcell_pbuf_is_ref(const lwcell_pbuf_p pbuf);
+#endif /* LWCELL_CFG_INPUT_ZERO_COPY || __DOXYGEN__ */
 size_t lwcell_pbuf_free(lwcell_pbuf_p pbuf);
 size_t lwcell_pbuf_free_s(lwcell_pbuf_p* pbuf);
 void* lwcell_pbuf_data(const lwcell_pbuf_p pbuf);
@@ -58,6 +62,7 @@ size_t lwcell_pbuf_copy(lwcell_pbuf_p pbuf, void* data, size_t len, size_t offse
 lwcellr_t lwcell_pbuf_cat(lwcell_pbuf_p head, const lwcell_pbuf_p tail);
 lwcellr_t lwcell_pbuf_cat_s(lwcell_pbuf_p head, lwcell_pbuf_p* tail);
 lwcellr_t lwcell_pbuf_chain(lwcell_pbuf_p head, lwcell_pbuf_p tail);
+lwcell_pbuf_p lwcell_pbuf_unchain(lwcell_pbuf_p head);
 lwcellr_t lwcell_pbuf_ref(lwcell_pbuf_p pbuf);
 
 uint8_t lwcell_pbuf_get_at(const lwcell_pbuf_p pbuf, size_t pos, uint8_t* el);
@@ -70,9 +75,28 @@ uint8_t lwcell_pbuf_advance(lwcell_pbuf_p pbuf, int len);
 lwcell_pbuf_p lwcell_pbuf_skip(lwcell_pbuf_p pbuf, size_t offset, size_t* new_offset);
 
 void* lwcell_pbuf_get_linear_addr(const lwcell_pbuf_p pbuf, size_t offset, size_t* new_len);
+void* lwcell_pbuf_peek_linear(const lwcell_pbuf_p pbuf, size_t offset, size_t len, void* buff);
+lwcell_pbuf_p lwcell_pbuf_linearize(lwcell_pbuf_p pbuf);
 
 void lwcell_pbuf_set_ip(lwcell_pbuf_p pbuf, const lwcell_ip_t* ip, lwcell_port_t port);
 
+#if LWCELL_CFG_PBUF_POOL || __DOXYGEN__
+
+/**
+ * \brief           Packet buffer pool statistics
+ */
+typedef struct {
+    size_t size;   /*!< Payload size of packet buffer in pool */
+    size_t cnt;    /*!< Number of packet buffers in pool */
+    size_t free;   /*!< Number of currently free packet buffers */
+    uint32_t hit;  /*!< Number of allocations served by this pool */
+    uint32_t miss; /*!< Number of allocations for this size class, served by bigger pool or heap */
+} lwcell_pbuf_pool_stats_t;
+
+uint8_t lwcell_pbuf_pool_get_stats(size_t idx, lwcell_pbuf_pool_stats_t* stats);
+
+#endif /* LWCELL_CFG_PBUF_POOL || __DOXYGEN__ */
+
 /**
  * \}
  */
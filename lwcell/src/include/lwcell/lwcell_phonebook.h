@@ -60,9 +60,21 @@ lwcellr_t lwcell_pb_read(lwcell_mem_t mem, size_t pos, lwcell_pb_entry_t* entry,
                        void* const evt_arg, const uint32_t blocking);
 lwcellr_t lwcell_pb_list(lwcell_mem_t mem, size_t start_index, lwcell_pb_entry_t* entries, size_t etr, size_t* er,
                        const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_pb_list_iter(lwcell_mem_t mem, size_t start_index, lwcell_pb_entry_t* entry,
+                              lwcell_pb_list_fn entry_fn, void* entry_arg, size_t* er,
+                              const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_pb_import(lwcell_mem_t mem, lwcell_pb_entry_t* entry, size_t etw, lwcell_pb_import_fn fn, void* arg,
+                           size_t* ew, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                           const uint32_t blocking);
 lwcellr_t lwcell_pb_search(lwcell_mem_t mem, const char* search, lwcell_pb_entry_t* entries, size_t etr, size_t* er,
                          const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
 
+#if LWCELL_CFG_PHONEBOOK_MIRROR || __DOXYGEN__
+lwcellr_t lwcell_pb_mirror_load(lwcell_mem_t mem, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                                const uint32_t blocking);
+lwcellr_t lwcell_pb_mirror_find(const char* num, lwcell_pb_entry_t* entry);
+#endif /* LWCELL_CFG_PHONEBOOK_MIRROR || __DOXYGEN__ */
+
 /**
  * \}
  */
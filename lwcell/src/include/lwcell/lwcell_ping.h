@@ -45,8 +45,24 @@ extern "C" {
  * \defgroup        LWCELL_PING PING API
  * \brief           PING manager
  * \{
+ *
+ * Probes are sent by device with `AT+CIPPING` command,
+ * without opening connection to remote host.
+ * Result of every run is reported with \ref LWCELL_EVT_PING event,
+ * including minimal, average and maximal round-trip time and jitter.
+ *
+ * Periodic probe, started with \ref lwcell_ping_start, is scheduled with timeout manager.
+ * It measures link latency and keeps operator NAT bindings alive at low cost.
+ *
+ * \note            Device reports round-trip time with `100ms` resolution.
+ *                  Network must be attached with \ref lwcell_network_attach before ping is started
  */
 
+lwcellr_t lwcell_ping(const char* host, uint16_t count, lwcell_ping_stats_t* stats, const lwcell_api_cmd_evt_fn evt_fn,
+                      void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_ping_start(const char* host, uint16_t count, uint32_t interval);
+lwcellr_t lwcell_ping_stop(void);
+
 /**
  * \}
  */
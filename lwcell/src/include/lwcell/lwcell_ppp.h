@@ -0,0 +1,86 @@
+/**
+ * \file            lwcell_ppp.h
+ * \brief           PPP data mode
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_PPP_HDR_H
+#define LWCELL_PPP_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_PPP PPP data mode
+ * \brief           Raw PPP byte pipe for external TCP/IP stack
+ * \{
+ *
+ * Device dials packet service with `ATD*99#` and after `CONNECT` all received bytes
+ * are passed to input callback, which feeds them to PPP implementation of external stack, such as lwIP.
+ * Output of external stack is written with \ref lwcell_ppp_output.
+ *
+ * PPP runs either on AT channel or on application channel of \ref LWCELL_CMUX.
+ * On AT channel, stack commands are rejected while in data mode.
+ * Use \ref lwcell_ppp_suspend to escape to command mode with `+++` and \ref lwcell_ppp_resume to continue.
+ * On multiplexer channel, stack keeps working on its own channel during data transfer.
+ *
+ * \ref LWCELL_EVT_PPP_CONNECTED and \ref LWCELL_EVT_PPP_DISCONNECTED events report data mode state
+ */
+
+/**
+ * \brief           PPP data received callback
+ * \note            Function is called from processing thread with core locked
+ * \param[in]       data: Received data
+ * \param[in]       len: Length of received data
+ * \param[in]       arg: User argument passed to \ref lwcell_ppp_start
+ */
+typedef void (*lwcell_ppp_input_fn)(const void* data, size_t len, void* arg);
+
+lwcellr_t lwcell_ppp_start(uint8_t dlci, lwcell_ppp_input_fn input_fn, void* arg, const lwcell_api_cmd_evt_fn evt_fn,
+                           void* const evt_arg, const uint32_t blocking);
+size_t lwcell_ppp_output(const void* data, size_t len);
+lwcellr_t lwcell_ppp_suspend(void);
+lwcellr_t lwcell_ppp_resume(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_ppp_stop(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+uint8_t lwcell_ppp_is_data_mode(void);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_PPP_HDR_H */
@@ -45,6 +45,10 @@
 #include "lwcell/lwcell_types.h"
 #include "lwcell/lwcell_unicode.h"
 
+#if LWCELL_CFG_INPUT_BUFF_ATOMIC || LWCELL_PBUF_REF_STDATOMIC
+#include <stdatomic.h>
+#endif /* LWCELL_CFG_INPUT_BUFF_ATOMIC || LWCELL_PBUF_REF_STDATOMIC */
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -63,22 +67,33 @@ typedef enum {
     /* Basic AT commands */
     LWCELL_CMD_RESET,                  /*!< Reset device */
     LWCELL_CMD_RESET_DEVICE_FIRST_CMD, /*!< Reset device first driver specific command */
+#if LWCELL_CFG_CMD_TIMEOUT_ADAPT || LWCELL_CFG_SUPERVISOR
+    LWCELL_CMD_PROBE, /*!< Check if device responds to `AT` command after command timeout */
+#endif                /* LWCELL_CFG_CMD_TIMEOUT_ADAPT || LWCELL_CFG_SUPERVISOR */
     LWCELL_CMD_ATE0,                   /*!< Disable ECHO mode on AT commands */
     LWCELL_CMD_ATE1,                   /*!< Enable ECHO mode on AT commands */
     LWCELL_CMD_GSLP,                   /*!< Set GSM to sleep mode */
     LWCELL_CMD_RESTORE,                /*!< Restore GSM internal settings to default values */
-    LWCELL_CMD_UART,
+    LWCELL_CMD_UART,                   /*!< Set fixed local rate */
+    LWCELL_CMD_UART_CHECK,             /*!< Verify communication after local rate change */
+#if LWCELL_CFG_SNAPSHOT
+    LWCELL_CMD_SNAPSHOT_RESTORE, /*!< Resynchronize state restored from snapshot with device */
+#endif                           /* LWCELL_CFG_SNAPSHOT */
 
     LWCELL_CMD_CGACT_SET_0,
     LWCELL_CMD_CGACT_SET_1,
     LWCELL_CMD_CGATT_SET_0,
     LWCELL_CMD_CGATT_SET_1,
+    LWCELL_CMD_CGATT_GET,      /*!< Get network attach state */
     LWCELL_CMD_NETWORK_ATTACH, /*!< Attach to a network */
     LWCELL_CMD_NETWORK_DETACH, /*!< Detach from network */
 
     LWCELL_CMD_CIPMUX_SET,
     LWCELL_CMD_CIPRXGET_SET,
+    LWCELL_CMD_CIPQSEND_SET,
     LWCELL_CMD_CSTT_SET,
+    LWCELL_CMD_CIPSEND_GET, /*!< Query maximal data length for single send command */
+    LWCELL_CMD_CNACT_SET,   /*!< Activate PDP context for `AT+CAOPEN` socket commands */
 
     /* AT commands according to the V.25TER */
     LWCELL_CMD_CALL_ENABLE,
@@ -95,6 +110,7 @@ typedef enum {
     LWCELL_CMD_ATM,     /*!< Set Monitor Speaker Mode */
     LWCELL_CMD_PPP,     /*!< Switch from Data Mode or PPP Online Mode to Command Mode, "+++" originally */
     LWCELL_CMD_ATO,     /*!< Switch from Command Mode to Data Mode */
+    LWCELL_CMD_PPP_DIAL, /*!< Dial packet service for PPP data mode */
     LWCELL_CMD_ATP,     /*!< Select Pulse Dialing */
     LWCELL_CMD_ATQ,     /*!< Set Result Code Presentation Mode */
     LWCELL_CMD_ATS0,    /*!< Set Number of Rings before Automatically Answering the Call */
@@ -155,13 +171,15 @@ typedef enum {
     LWCELL_CMD_COLP,     /*!< Connected Line Identification Presentation */
 
     LWCELL_CMD_PHONEBOOK_ENABLE,
-    LWCELL_CMD_CPBF,         /*!< Find Phonebook Entries */
-    LWCELL_CMD_CPBR,         /*!< Read Current Phonebook Entries  */
-    LWCELL_CMD_CPBS_SET,     /*!< Select Phonebook Memory Storage */
-    LWCELL_CMD_CPBS_GET,     /*!< Get current Phonebook Memory Storage */
-    LWCELL_CMD_CPBS_GET_OPT, /*!< Get available Phonebook Memory Storages */
-    LWCELL_CMD_CPBW_SET,     /*!< Write Phonebook Entry */
-    LWCELL_CMD_CPBW_GET_OPT, /*!< Get options for write Phonebook Entry */
+    LWCELL_CMD_PHONEBOOK_MIRROR_LOAD, /*!< Load phonebook mirror with chunked entries read */
+    LWCELL_CMD_PHONEBOOK_IMPORT,      /*!< Write multiple phonebook entries after single memory select */
+    LWCELL_CMD_CPBF,                  /*!< Find Phonebook Entries */
+    LWCELL_CMD_CPBR,                  /*!< Read Current Phonebook Entries  */
+    LWCELL_CMD_CPBS_SET,              /*!< Select Phonebook Memory Storage */
+    LWCELL_CMD_CPBS_GET,              /*!< Get current Phonebook Memory Storage */
+    LWCELL_CMD_CPBS_GET_OPT,          /*!< Get available Phonebook Memory Storages */
+    LWCELL_CMD_CPBW_SET,              /*!< Write Phonebook Entry */
+    LWCELL_CMD_CPBW_GET_OPT,          /*!< Get options for write Phonebook Entry */
 
     LWCELL_CMD_SIM_PROCESS_BASIC_CMDS, /*!< Command setup, executed when SIM is in READY state */
     LWCELL_CMD_CPIN_SET,               /*!< Enter PIN */
@@ -172,13 +190,29 @@ typedef enum {
     LWCELL_CMD_CPUK_SET,               /*!< Enter PUK and set new PIN */
 
     LWCELL_CMD_CSQ_GET,  /*!< Signal Quality Report */
+#if LWCELL_CFG_RSSI_URC || __DOXYGEN__
+    LWCELL_CMD_EXUNSOL_SQ_SET, /*!< Enable unsolicited signal quality reports */
+#endif                         /* LWCELL_CFG_RSSI_URC || __DOXYGEN__ */
     LWCELL_CMD_CFUN_SET, /*!< Set Phone Functionality */
     LWCELL_CMD_CFUN_GET, /*!< Get Phone Functionality */
     LWCELL_CMD_CREG_SET, /*!< Network Registration set output */
     LWCELL_CMD_CREG_GET, /*!< Get current network registration status */
+#if LWCELL_CFG_NETWORK_PS_REG || __DOXYGEN__
+    LWCELL_CMD_CGREG_SET, /*!< Enable GPRS registration reports and read current status */
+    LWCELL_CMD_CEREG_SET, /*!< Enable EPS registration reports and read current status */
+#endif                    /* LWCELL_CFG_NETWORK_PS_REG || __DOXYGEN__ */
+#if LWCELL_CFG_NETWORK_BAND || __DOXYGEN__
+    LWCELL_CMD_NETWORK_BAND_SET, /*!< Lock radio access technology and bands */
+    LWCELL_CMD_CNMP_SET,         /*!< Set preferred mode selection */
+    LWCELL_CMD_CMNB_SET,         /*!< Set preferred LTE mode, CAT-M or NB-IoT */
+    LWCELL_CMD_CBANDCFG_SET,     /*!< Set LTE bands of single LTE mode */
+    LWCELL_CMD_CPSI_GET,         /*!< Get serving cell system information */
+#endif                           /* LWCELL_CFG_NETWORK_BAND || __DOXYGEN__ */
     LWCELL_CMD_CBC,      /*!< Battery Charge */
     LWCELL_CMD_CNUM,     /*!< Subscriber Number */
 
+    LWCELL_CMD_QUERY_BATCH, /*!< Multiple query commands concatenated in single command line */
+
     LWCELL_CMD_CPWD,     /*!< Change Password */
     LWCELL_CMD_CR,       /*!< Service Reporting Control */
     LWCELL_CMD_CRC,      /*!< Set Cellular Result Codes for Incoming Call Indication */
@@ -187,6 +221,10 @@ typedef enum {
     LWCELL_CMD_VTD,      /*!< Tone Duration */
     LWCELL_CMD_VTS,      /*!< DTMF and Tone Generation */
     LWCELL_CMD_CMUX,     /*!< Multiplexer Control */
+    LWCELL_CMD_CPSMS_SET,  /*!< Power Saving Mode Setting */
+    LWCELL_CMD_CEDRXS_SET, /*!< eDRX Setting */
+    LWCELL_CMD_CSCLK_SET,  /*!< Configure Slow Clock */
+    LWCELL_CMD_CNMPSD,     /*!< No More PS Data, request early radio release */
     LWCELL_CMD_CPOL,     /*!< Preferred Operator List */
     LWCELL_CMD_COPN,     /*!< Read Operator Names */
     LWCELL_CMD_CCLK,     /*!< Clock */
@@ -203,37 +241,39 @@ typedef enum {
     LWCELL_CMD_CUSD,     /*!< Unstructured Supplementary Service Data, Execute command */
     LWCELL_CMD_CSSN,     /*!< Supplementary Services Notification */
 
-    LWCELL_CMD_CIPMUX,     /*!< Start Up Multi-IP Connection */
-    LWCELL_CMD_CIPSTART,   /*!< Start Up TCP or UDP Connection */
-    LWCELL_CMD_CIPSEND,    /*!< Send Data Through TCP or UDP Connection */
-    LWCELL_CMD_CIPQSEND,   /*!< Select Data Transmitting Mode */
-    LWCELL_CMD_CIPACK,     /*!< Query Previous Connection Data Transmitting State */
-    LWCELL_CMD_CIPCLOSE,   /*!< Close TCP or UDP Connection */
-    LWCELL_CMD_CIPSHUT,    /*!< Deactivate GPRS PDP Context */
-    LWCELL_CMD_CLPORT,     /*!< Set Local Port */
-    LWCELL_CMD_CSTT,       /*!< Start Task and Set APN, username, password */
-    LWCELL_CMD_CIICR,      /*!< Bring Up Wireless Connection with GPRS or CSD */
-    LWCELL_CMD_CIFSR,      /*!< Get Local IP Address */
-    LWCELL_CMD_CIPSTATUS,  /*!< Query Current Connection Status */
-    LWCELL_CMD_CDNSCFG,    /*!< Configure Domain Name Server */
-    LWCELL_CMD_CDNSGIP,    /*!< Query the IP Address of Given Domain Name */
-    LWCELL_CMD_CIPHEAD,    /*!< Add an IP Head at the Beginning of a Package Received */
-    LWCELL_CMD_CIPATS,     /*!< Set Auto Sending Timer */
-    LWCELL_CMD_CIPSPRT,    /*!< Set Prompt of greater than sign When Module Sends Data */
-    LWCELL_CMD_CIPSERVER,  /*!< Configure Module as Server */
-    LWCELL_CMD_CIPCSGP,    /*!< Set CSD or GPRS for Connection Mode */
-    LWCELL_CMD_CIPSRIP,    /*!< Show Remote IP Address and Port When Received Data */
-    LWCELL_CMD_CIPDPDP,    /*!< Set Whether to Check State of GPRS Network Timing */
-    LWCELL_CMD_CIPMODE,    /*!< Select TCPIP Application Mode */
-    LWCELL_CMD_CIPCCFG,    /*!< Configure Transparent Transfer Mode */
-    LWCELL_CMD_CIPSHOWTP,  /*!< Display Transfer Protocol in IP Head When Received Data */
-    LWCELL_CMD_CIPUDPMODE, /*!< UDP Extended Mode */
-    LWCELL_CMD_CIPRXGET,   /*!< Get Data from Network Manually */
-    LWCELL_CMD_CIPSCONT,   /*!< Save TCPIP Application Context */
-    LWCELL_CMD_CIPRDTIMER, /*!< Set Remote Delay Timer */
-    LWCELL_CMD_CIPSGTXT,   /*!< Select GPRS PDP context */
-    LWCELL_CMD_CIPTKA,     /*!< Set TCP Keepalive Parameters */
-    LWCELL_CMD_CIPSSL,     /*!< Connection SSL function */
+    LWCELL_CMD_CIPMUX,         /*!< Start Up Multi-IP Connection */
+    LWCELL_CMD_CIPSTART,       /*!< Start Up TCP or UDP Connection */
+    LWCELL_CMD_CIPSEND,        /*!< Send Data Through TCP or UDP Connection */
+    LWCELL_CMD_CIPQSEND,       /*!< Select Data Transmitting Mode */
+    LWCELL_CMD_CIPACK,         /*!< Query Previous Connection Data Transmitting State */
+    LWCELL_CMD_CIPCLOSE,       /*!< Close TCP or UDP Connection */
+    LWCELL_CMD_CIPSHUT,        /*!< Deactivate GPRS PDP Context */
+    LWCELL_CMD_CLPORT,         /*!< Set Local Port */
+    LWCELL_CMD_CSTT,           /*!< Start Task and Set APN, username, password */
+    LWCELL_CMD_CIICR,          /*!< Bring Up Wireless Connection with GPRS or CSD */
+    LWCELL_CMD_CIFSR,          /*!< Get Local IP Address */
+    LWCELL_CMD_CIPSTATUS,      /*!< Query Current Connection Status */
+    LWCELL_CMD_CDNSCFG,        /*!< Configure Domain Name Server */
+    LWCELL_CMD_CDNSGIP,        /*!< Query the IP Address of Given Domain Name */
+    LWCELL_CMD_CIPHEAD,        /*!< Add an IP Head at the Beginning of a Package Received */
+    LWCELL_CMD_CIPATS,         /*!< Set Auto Sending Timer */
+    LWCELL_CMD_CIPSPRT,        /*!< Set Prompt of greater than sign When Module Sends Data */
+    LWCELL_CMD_CIPSERVER,      /*!< Configure Module as Server */
+    LWCELL_CMD_CIPCSGP,        /*!< Set CSD or GPRS for Connection Mode */
+    LWCELL_CMD_CIPSRIP,        /*!< Show Remote IP Address and Port When Received Data */
+    LWCELL_CMD_CIPDPDP,        /*!< Set Whether to Check State of GPRS Network Timing */
+    LWCELL_CMD_CIPMODE,        /*!< Select TCPIP Application Mode */
+    LWCELL_CMD_CIPCCFG,        /*!< Configure Transparent Transfer Mode */
+    LWCELL_CMD_CIPSHOWTP,      /*!< Display Transfer Protocol in IP Head When Received Data */
+    LWCELL_CMD_CIPUDPMODE,     /*!< UDP Extended Mode */
+    LWCELL_CMD_CIPRXGET,       /*!< Get Data from Network Manually */
+    LWCELL_CMD_CIPRXGET_QUERY, /*!< Query number of bytes waiting in device buffer */
+    LWCELL_CMD_CIPSCONT,       /*!< Save TCPIP Application Context */
+    LWCELL_CMD_CIPRDTIMER,     /*!< Set Remote Delay Timer */
+    LWCELL_CMD_CIPSGTXT,       /*!< Select GPRS PDP context */
+    LWCELL_CMD_CIPTKA,         /*!< Set TCP Keepalive Parameters */
+    LWCELL_CMD_CIPSSL,         /*!< Connection SSL function */
+    LWCELL_CMD_CIPPING,        /*!< Ping remote host */
 
     LWCELL_CMD_SMS_ENABLE,
     LWCELL_CMD_CMGD,         /*!< Delete SMS Message */
@@ -256,6 +296,75 @@ typedef enum {
     LWCELL_CMD_CSMP,         /*!< Set SMS Text Mode Parameters */
     LWCELL_CMD_CSMS,         /*!< Select Message Service */
 
+    LWCELL_CMD_SMCONF_URL,      /*!< Set MQTT server address and port */
+    LWCELL_CMD_SMCONF_CLIENTID, /*!< Set MQTT client ID */
+    LWCELL_CMD_SMCONF_KEEPTIME, /*!< Set MQTT keep-alive time */
+    LWCELL_CMD_SMCONF_USERNAME, /*!< Set MQTT username */
+    LWCELL_CMD_SMCONF_PASSWORD, /*!< Set MQTT password */
+    LWCELL_CMD_SMCONN,          /*!< Connect to MQTT server */
+    LWCELL_CMD_SMDISC,          /*!< Disconnect from MQTT server */
+    LWCELL_CMD_SMSUB,           /*!< Subscribe to MQTT topic */
+    LWCELL_CMD_SMUNSUB,         /*!< Unsubscribe from MQTT topic */
+    LWCELL_CMD_SMPUB,           /*!< Publish MQTT message */
+    LWCELL_CMD_SMSSL,           /*!< Select SSL context for MQTT connection */
+
+    LWCELL_CMD_CFSINIT,              /*!< Get buffer for file system operation */
+    LWCELL_CMD_CFSWFILE,             /*!< Write file chunk to device file system */
+    LWCELL_CMD_CFSTERM,              /*!< Free buffer of file system operation */
+    LWCELL_CMD_CFSRFILE,             /*!< Read file chunk from device file system */
+    LWCELL_CMD_CFSGFIS,              /*!< Get file size in device file system */
+    LWCELL_CMD_CFSDFILE,             /*!< Delete file from device file system */
+    LWCELL_CMD_FS_WRITE,             /*!< Write application data to device file system */
+    LWCELL_CMD_CSSLCFG_SSLVERSION,   /*!< Set SSL context protocol version */
+    LWCELL_CMD_CSSLCFG_SNI,          /*!< Set SSL context server name indication */
+    LWCELL_CMD_CSSLCFG_CONVERT_CA,   /*!< Convert root CA file for SSL context */
+    LWCELL_CMD_CSSLCFG_CONVERT_CERT, /*!< Convert client certificate and key files for SSL context */
+
+    LWCELL_CMD_CGNSPWR, /*!< Power GNSS engine on or off */
+    LWCELL_CMD_CGNSURC, /*!< Set navigation info unsolicited report interval */
+    LWCELL_CMD_CGNSINF, /*!< Read current navigation info */
+
+    LWCELL_CMD_CENG, /*!< Set engineering mode and cell info reports */
+
+    LWCELL_CMD_CLTS_SET,  /*!< Enable local time stamp reports */
+    LWCELL_CMD_CIPGSMLOC, /*!< Get cell location and time */
+
+    LWCELL_CMD_SAPBR_CONTYPE,    /*!< Set bearer profile connection type for HTTP */
+    LWCELL_CMD_SAPBR_OPEN,       /*!< Open bearer profile for HTTP */
+    LWCELL_CMD_HTTPINIT,         /*!< Initialize HTTP service */
+    LWCELL_CMD_HTTPPARA_CID,     /*!< Set HTTP bearer profile identifier */
+    LWCELL_CMD_HTTPPARA_URL,     /*!< Set HTTP request URL */
+    LWCELL_CMD_HTTPSSL,          /*!< Enable HTTPS for HTTP session */
+    LWCELL_CMD_HTTPACTION,       /*!< Start HTTP request */
+    LWCELL_CMD_HTTPREAD,         /*!< Read HTTP response body */
+    LWCELL_CMD_HTTPTERM,         /*!< Terminate HTTP service */
+    LWCELL_CMD_SHCONF_URL,       /*!< Set HTTP server address */
+    LWCELL_CMD_SHCONF_BODYLEN,   /*!< Set maximal HTTP request body length */
+    LWCELL_CMD_SHCONF_HEADERLEN, /*!< Set maximal HTTP request header length */
+    LWCELL_CMD_SHCONN,           /*!< Connect to HTTP server */
+    LWCELL_CMD_SHREQ,            /*!< Start HTTP request */
+    LWCELL_CMD_SHREAD,           /*!< Read HTTP response body */
+    LWCELL_CMD_SHDISC,           /*!< Disconnect from HTTP server */
+
+    LWCELL_CMD_FTPCID,       /*!< Set FTP bearer profile identifier */
+    LWCELL_CMD_FTPSERV,      /*!< Set FTP server address */
+    LWCELL_CMD_FTPPORT,      /*!< Set FTP server port */
+    LWCELL_CMD_FTPUN,        /*!< Set FTP username */
+    LWCELL_CMD_FTPPW,        /*!< Set FTP password */
+    LWCELL_CMD_FTPGETNAME,   /*!< Set name of file to download */
+    LWCELL_CMD_FTPGETPATH,   /*!< Set path of file to download */
+    LWCELL_CMD_FTPREST,      /*!< Set download restart offset */
+    LWCELL_CMD_FTPGET_OPEN,  /*!< Open FTP download session */
+    LWCELL_CMD_FTPGET_READ,  /*!< Read downloaded data from device */
+    LWCELL_CMD_FTPPUTNAME,   /*!< Set name of file to upload */
+    LWCELL_CMD_FTPPUTPATH,   /*!< Set path of file to upload */
+    LWCELL_CMD_FTPPUTOPT,    /*!< Set upload store or append type */
+    LWCELL_CMD_FTPPUT_OPEN,  /*!< Open FTP upload session */
+    LWCELL_CMD_FTPPUT_WRITE, /*!< Write upload data to device */
+    LWCELL_CMD_FTPPUT_END,   /*!< Finish upload */
+    LWCELL_CMD_FTPPUTFRMFS,  /*!< Upload file from device file system */
+    LWCELL_CMD_FTPQUIT,      /*!< Quit FTP session */
+
     LWCELL_CMD_END, /*!< Last CMD entry */
 } lwcell_cmd_t;
 
@@ -268,16 +377,54 @@ typedef struct lwcell_conn {
     lwcell_ip_t remote_ip;     /*!< Remote IP address */
     lwcell_port_t remote_port; /*!< Remote port number */
     lwcell_port_t local_port;  /*!< Local IP address */
+    lwcell_conn_state_t state; /*!< Last connection state reported by `AT+CIPSTATUS` */
     lwcell_evt_fn evt_func;    /*!< Callback function for connection */
     void* arg;                 /*!< User custom argument */
+#if LWCELL_CFG_CONN_RECV_FN || __DOXYGEN__
+    lwcell_conn_recv_fn recv_fn; /*!< Typed receive function, `NULL` when receive event is used */
+#endif                           /* LWCELL_CFG_CONN_RECV_FN || __DOXYGEN__ */
+#if LWCELL_CFG_CONN_RECV_BATCH > 0 || __DOXYGEN__
+    lwcell_conn_recv_batch_fn recv_batch_fn; /*!< Batch receive function, used before typed receive function */
+#endif                                       /* LWCELL_CFG_CONN_RECV_BATCH > 0 || __DOXYGEN__ */
 
     uint8_t val_id; /*!< Validation ID number. It is increased each time a new connection is established.
                                                      It protects sending data to wrong connection in case we have data in send queue,
                                                      and connection was closed and active again in between. */
 
+#if LWCELL_CFG_CONN_WRITE_RING || __DOXYGEN__
+    lwcell_buff_t tx_ring; /*!< Ring write buffer, allocated when connection becomes active */
+    size_t tx_ring_queued; /*!< Number of bytes from ring read pointer, already queued for send */
+#else                      /* LWCELL_CFG_CONN_WRITE_RING || __DOXYGEN__ */
     lwcell_linbuff_t buff; /*!< Linear buffer structure */
-
-    size_t total_recved; /*!< Total number of bytes received */
+#endif                     /* !(LWCELL_CFG_CONN_WRITE_RING || __DOXYGEN__) */
+
+    size_t total_recved;    /*!< Total number of bytes received */
+    uint32_t poll_interval; /*!< Poll event interval in units of milliseconds, `0` when poll is disabled */
+    uint32_t poll_time;     /*!< Time of last poll event or poll interval change */
+    size_t max_send_len; /*!< Maximal data length for single `AT+CIPSEND` command, reported by device.
+                                Reduced on send failure. `0` when default length is used */
+#if LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__
+    size_t rx_credit;  /*!< Number of bytes connection may still pass to application in manual receive mode */
+    size_t rx_dev_len; /*!< Number of bytes waiting in device buffer, as last reported by device */
+#endif                 /* LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__ */
+#if LWCELL_CFG_CONN_SEND_FAIR || __DOXYGEN__
+    uint8_t send_weight; /*!< Number of send chunks per turn, `0` when \ref LWCELL_CFG_CONN_SEND_FAIR is used */
+#endif                   /* LWCELL_CFG_CONN_SEND_FAIR || __DOXYGEN__ */
+#if LWCELL_CFG_CONN_SEND_ADAPT || __DOXYGEN__
+    size_t send_chunk;   /*!< Chunk length adapted to link quality, `0` when maximal length is used */
+    uint32_t send_srtt;  /*!< Smoothed chunk round-trip time in units of milliseconds */
+    uint32_t send_pace;  /*!< Delay before next chunk in units of milliseconds */
+    uint32_t send_ok;    /*!< Number of confirmed chunks */
+    uint32_t send_fail;  /*!< Number of failed chunks */
+    uint8_t send_loss;   /*!< Smoothed chunk loss ratio, `255` when all chunks fail */
+    uint8_t send_clean;  /*!< Number of confirmed chunks since last failure or chunk growth */
+#endif                   /* LWCELL_CFG_CONN_SEND_ADAPT || __DOXYGEN__ */
+#if LWCELL_CFG_USAGE || __DOXYGEN__
+    lwcell_usage_t usage; /*!< Data usage since connection became active */
+#endif                    /* LWCELL_CFG_USAGE || __DOXYGEN__ */
+#if LWCELL_CFG_NETWORK_PDP_RECOVERY || __DOXYGEN__
+    lwcell_conn_type_t start_type; /*!< Connection type used on start, used again after PDP context recovery */
+#endif                             /* LWCELL_CFG_NETWORK_PDP_RECOVERY || __DOXYGEN__ */
 
     union {
         struct {
@@ -287,10 +434,29 @@ typedef struct lwcell_conn {
             uint8_t in_closing    : 1; /*!< Status if connection is in closing mode.
                                                     When in closing mode, ignore any possible received data from function */
             uint8_t bearer        : 1; /*!< Bearer used. Can be `1` or `0` */
+#if LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__
+            uint8_t rx_pending : 1; /*!< Status if device has received data waiting to be read */
+            uint8_t rx_reads   : 2; /*!< Number of read commands for device data in queue or in progress */
+#endif                              /* LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__ */
+#if LWCELL_CFG_USAGE || __DOXYGEN__
+            uint8_t low_prio : 1; /*!< Connection is throttled when data quota limit is reached */
+#endif                            /* LWCELL_CFG_USAGE || __DOXYGEN__ */
+#if LWCELL_CFG_CONN_TX_WINDOW > 0 || __DOXYGEN__
+            uint8_t tx_deferred : 1; /*!< Send requests wait for transmit window */
+#endif                               /* LWCELL_CFG_CONN_TX_WINDOW > 0 || __DOXYGEN__ */
+#if LWCELL_CFG_NETWORK_PDP_RECOVERY || __DOXYGEN__
+            uint8_t pdp_hold : 1; /*!< Connection waits to be restored after PDP context deactivation */
+#endif                            /* LWCELL_CFG_NETWORK_PDP_RECOVERY || __DOXYGEN__ */
         } f;                           /*!< Connection flags */
     } status;                          /*!< Connection status union with flag bits */
 } lwcell_conn_t;
 
+#if LWCELL_PBUF_REF_STDATOMIC
+typedef atomic_size_t lwcell_pbuf_ref_t; /*!< Packet buffer reference counter type, atomic for lock-free access */
+#else
+typedef size_t lwcell_pbuf_ref_t; /*!< Packet buffer reference counter type */
+#endif /* LWCELL_PBUF_REF_STDATOMIC */
+
 /**
  * \ingroup         LWCELL_PBUF
  * \brief           Packet buffer structure
@@ -299,10 +465,16 @@ typedef struct lwcell_pbuf {
     struct lwcell_pbuf* next; /*!< Next pbuf in chain list */
     size_t tot_len;           /*!< Total length of pbuf chain */
     size_t len;               /*!< Length of payload */
-    size_t ref;               /*!< Number of references to this structure */
+    lwcell_pbuf_ref_t ref;    /*!< Number of references to this structure */
     uint8_t* payload;         /*!< Pointer to payload memory */
     lwcell_ip_t ip;           /*!< Remote address for received IPD data */
     lwcell_port_t port;       /*!< Remote port for received IPD data */
+#if LWCELL_CFG_INPUT_ZERO_COPY || __DOXYGEN__
+    const void* ref_mem;               /*!< Referenced external memory, `NULL` when payload follows structure */
+    size_t ref_len;                    /*!< Length of referenced external memory */
+    lwcell_pbuf_release_fn release_fn; /*!< Function called when referenced memory is not used anymore */
+    void* release_arg;                 /*!< Custom argument for release function */
+#endif                                 /* LWCELL_CFG_INPUT_ZERO_COPY || __DOXYGEN__ */
 } lwcell_pbuf_t;
 
 /**
@@ -317,6 +489,15 @@ typedef struct {
     size_t buff_ptr;    /*!< Buffer pointer to save data to.
                                                      When set to `NULL` while `read = 1`, reading should ignore incoming data */
     lwcell_pbuf_p buff; /*!< Pointer to data buffer used for receiving data */
+#if LWCELL_CFG_CONN_RECV_FROM || __DOXYGEN__
+    uint8_t src_valid;      /*!< Set to `1` when source address was reported for current packet */
+    lwcell_ip_t src_ip;     /*!< Source IP address of current packet */
+    lwcell_port_t src_port; /*!< Source port of current packet */
+#endif                      /* LWCELL_CFG_CONN_RECV_FROM || __DOXYGEN__ */
+#if LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__
+    uint8_t is_rxget; /*!< Set to `1` when data follow `+CIPRXGET: 2` header instead of `+RECEIVE`.
+                            Receive credit for such data was already reserved when read was requested */
+#endif                /* LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__ */
 } lwcell_ipd_t;
 
 /**
@@ -331,26 +512,57 @@ typedef enum {
 
 /**
  * \brief           Message queue structure to share between threads
+ *
+ * Common header is followed by command family payload in `msg` union.
+ * Messages are allocated only up to the payload used by command, see \ref LWCELL_MSG_SIZE,
+ * hence `msg` members of other command families must not be accessed
  */
 typedef struct lwcell_msg {
-    lwcell_cmd_t cmd_def; /*!< Default message type received from queue */
-    lwcell_cmd_t cmd;     /*!< Since some commands can have different subcommands, sub command is used here */
-    uint8_t i;            /*!< Variable to indicate order number of subcommands */
-    lwcell_sys_sem_t sem; /*!< Semaphore for the message */
-    uint8_t is_blocking;  /*!< Status if command is blocking */
-    uint32_t block_time;  /*!< Maximal blocking time in units of milliseconds. Use 0 to for non-blocking call */
-    lwcellr_t res;        /*!< Result of message operation */
+    lwcell_sys_sem_t sem;                /*!< Semaphore for the message */
     lwcellr_t (*fn)(struct lwcell_msg*); /*!< Processing callback function to process packet */
-
 #if LWCELL_CFG_USE_API_FUNC_EVT
     lwcell_api_cmd_evt_fn evt_fn; /*!< Command callback API function */
     void* evt_arg;                /*!< Command callback API callback parameter */
 #endif                            /* LWCELL_CFG_USE_API_FUNC_EVT */
+    lwcell_cmd_t cmd_def; /*!< Default message type received from queue */
+    lwcell_cmd_t cmd;     /*!< Since some commands can have different subcommands, sub command is used here */
+    uint32_t block_time;  /*!< Maximal blocking time in units of milliseconds. Use 0 to for non-blocking call */
+#if LWCELL_CFG_STATS || __DOXYGEN__
+    uint32_t stats_time_queued; /*!< Time when message was put to producer queue */
+#endif                          /* LWCELL_CFG_STATS || __DOXYGEN__ */
+    lwcellr_t res;              /*!< Result of message operation */
+    uint8_t i;                  /*!< Variable to indicate order number of subcommands */
+    lwcell_timeout_t park_to;   /*!< Continuation of parked command, stopped when message is released */
+    uint8_t is_blocking : 1;    /*!< Status if command is blocking */
+    uint8_t is_prio     : 1;    /*!< Status if command goes to producer priority lane */
+    uint8_t is_parked   : 1;    /*!< Status if command waits for scheduled continuation */
+#if LWCELL_CFG_PRODUCER_ADMISSION || __DOXYGEN__
+    uint8_t is_admitted : 1; /*!< Status if command is counted as waiting in producer queue */
+#endif                       /* LWCELL_CFG_PRODUCER_ADMISSION || __DOXYGEN__ */
+#if LWCELL_CFG_CONN_SEND_FAIR || __DOXYGEN__
+    uint8_t is_yielded     : 1; /*!< Status if send command gave up its turn and continues from producer queue */
+    uint8_t is_send_queued : 1; /*!< Status if send command is counted as waiting in producer queue */
+#endif                          /* LWCELL_CFG_CONN_SEND_FAIR || __DOXYGEN__ */
+#if LWCELL_CFG_CQ || __DOXYGEN__
+    struct lwcell_cq* cq;       /*!< Completion queue of batch command, `NULL` for regular command */
+    void* cq_data;              /*!< User data, written to completion entry */
+    struct lwcell_msg* cq_next; /*!< Next message of the same batch */
+#endif                          /* LWCELL_CFG_CQ || __DOXYGEN__ */
 
     union {
         struct {
-            uint32_t delay; /*!< Delay to use before sending first reset AT command */
-        } reset;            /*!< Reset device */
+            uint32_t delay;   /*!< Delay to use before sending first reset AT command */
+            uint8_t hw_reset; /*!< Set to `1` when hardware reset was already done */
+#if LWCELL_CFG_RESET_FAST_BOOT || __DOXYGEN__
+            uint32_t polls;       /*!< Number of device polls after reset */
+            uint8_t serial_first; /*!< Serial number is queried first to check persisted identity */
+#endif                            /* LWCELL_CFG_RESET_FAST_BOOT || __DOXYGEN__ */
+#if LWCELL_CFG_AT_PORT_BAUDRATE_UPSHIFT || __DOXYGEN__
+            uint8_t baud_idx;      /*!< Index of current baudrate candidate */
+            uint8_t baud_polls;    /*!< Number of link verification polls at current rate */
+            uint8_t baud_fallback; /*!< Set to `1` when verifying link after fallback to default rate */
+#endif                             /* LWCELL_CFG_AT_PORT_BAUDRATE_UPSHIFT || __DOXYGEN__ */
+        } reset;                  /*!< Reset device */
 
         struct {
             uint32_t baudrate; /*!< Baudrate for AT port */
@@ -362,6 +574,7 @@ typedef struct lwcell_msg {
 
         struct {
             const char* pin; /*!< Pin code to write */
+            uint8_t polls;   /*!< Number of SIM state polls after PIN was written */
         } cpin_enter;        /*!< Enter pin code */
 
         struct {
@@ -382,10 +595,6 @@ typedef struct lwcell_msg {
             const char* pin; /*!< New PIN code */
         } cpuk_enter;        /*!< Enter PUK and new PIN */
 
-        struct {
-            size_t cnum_tries; /*!< Number of tries */
-        } sim_info;            /*!< Get information for SIM card */
-
         struct {
             char* str;  /*!< Pointer to output string array */
             size_t len; /*!< Length of output string array including trailing zero memory */
@@ -395,18 +604,37 @@ typedef struct lwcell_msg {
             int16_t* rssi; /*!< Pointer to RSSI variable */
         } csq;             /*!< Signal strength */
 
+        struct {
+            uint32_t queries; /*!< Bit mask of \ref lwcell_query_t queries */
+            int16_t* rssi;    /*!< Pointer to RSSI variable */
+        } query_batch;        /*!< Batch of status queries */
+
         struct {
             uint8_t read;           /*!< Flag indicating we can read the COPS actual data */
             lwcell_operator_t* ops; /*!< Pointer to operators array */
             size_t opsl;            /*!< Length of operators array */
             size_t opsi;            /*!< Current operator index array */
             size_t* opf;            /*!< Pointer to number of operators found */
+            uint32_t stop_num;      /*!< Operator numeric value to stop scan on, `0` if not used */
         } cops_scan;                /*!< Scan operators */
 
         struct {
             lwcell_operator_curr_t* curr; /*!< Pointer to output current operator */
         } cops_get;                       /*!< Get current operator info */
 
+#if LWCELL_CFG_NETWORK_BAND || __DOXYGEN__
+        struct {
+            lwcell_network_rat_t rat;     /*!< Radio access technologies to lock */
+            const uint8_t* bands;         /*!< LTE bands to lock, `NULL` to keep modem band list */
+            size_t bands_len;             /*!< Number of bands */
+            lwcell_network_rat_t cfg_rat; /*!< LTE mode of active `AT+CBANDCFG` command */
+        } network_band;                   /*!< Radio access technology and band lock */
+
+        struct {
+            lwcell_network_band_t* band; /*!< Pointer to output serving band */
+        } cpsi_get;                      /*!< Get serving cell system information */
+#endif                                   /* LWCELL_CFG_NETWORK_BAND || __DOXYGEN__ */
+
         struct {
             lwcell_operator_mode_t mode;     /*!< COPS mode */
             lwcell_operator_format_t format; /*!< Operator format to print */
@@ -425,6 +653,12 @@ typedef struct lwcell_msg {
             lwcell_evt_fn evt_func;             /*!< Callback function to use on connection */
             uint8_t num;                        /*!< Connection number used for start */
             lwcell_conn_connect_res_t conn_res; /*!< Connection result status */
+#if LWCELL_CFG_NETWORK_CONTEXTS > 1 || __DOXYGEN__
+            uint8_t ctx; /*!< PDP context used by connection */
+#endif                   /* LWCELL_CFG_NETWORK_CONTEXTS > 1 || __DOXYGEN__ */
+#if LWCELL_CFG_NETWORK_PDP_RECOVERY || __DOXYGEN__
+            lwcell_conn_t* restart; /*!< Connection restored after PDP context recovery, `NULL` for new one */
+#endif                              /* LWCELL_CFG_NETWORK_PDP_RECOVERY || __DOXYGEN__ */
         } conn_start;                           /*!< Structure for starting new connection */
 
         struct {
@@ -433,20 +667,71 @@ typedef struct lwcell_msg {
         } conn_close;            /*!< Close connection */
 
         struct {
-            lwcell_conn_t* conn;          /*!< Pointer to connection to send data */
-            size_t btw;                   /*!< Number of remaining bytes to write */
-            size_t ptr;                   /*!< Current write pointer for data */
-            const uint8_t* data;          /*!< Data to send */
-            size_t sent;                  /*!< Number of bytes sent in last packet */
-            size_t sent_all;              /*!< Number of bytes sent all together */
-            uint8_t tries;                /*!< Number of tries used for last packet */
-            uint8_t wait_send_ok_err;     /*!< Set to 1 when we wait for SEND OK or SEND ERROR */
-            const lwcell_ip_t* remote_ip; /*!< Remote IP address for UDP connection */
-            lwcell_port_t remote_port;    /*!< Remote port address for UDP connection */
-            uint8_t fau;                  /*!< Free after use flag to free memory after data are sent (or not) */
-            size_t* bw;                   /*!< Number of bytes written so far */
-            uint8_t val_id;               /*!< Connection current validation ID when command was sent to queue */
-        } conn_send;                      /*!< Structure to send data on connection */
+            lwcell_conn_t* conn;            /*!< Pointer to connection to send data */
+            size_t btw;                     /*!< Number of remaining bytes to write */
+            size_t ptr;                     /*!< Current write pointer for data */
+            const uint8_t* data;            /*!< Data to send */
+            const lwcell_conn_iovec_t* iov; /*!< Data fragments to send, used instead of `data` when not `NULL` */
+            size_t iovcnt;                  /*!< Number of entries in `iov` array */
+            uint8_t dgram;                  /*!< Each `iov` entry is sent as separate datagram */
+            lwcell_pbuf_p pbuf;             /*!< Packet buffer chain to send, used instead of `data` when not `NULL`.
+                                                 Reference is held until command finishes */
+            size_t sent;                    /*!< Number of bytes sent in last packet */
+            size_t sent_all;                /*!< Number of bytes sent all together */
+            uint8_t tries;                  /*!< Number of tries used for last packet */
+            uint8_t wait_send_ok_err;       /*!< Set to 1 when we wait for SEND OK or SEND ERROR */
+            const lwcell_ip_t* remote_ip;   /*!< Remote IP address for UDP connection */
+            lwcell_port_t remote_port;      /*!< Remote port address for UDP connection */
+            uint8_t fau;                    /*!< Free after use flag to free memory after data are sent (or not) */
+            size_t* bw;                     /*!< Number of bytes written so far */
+            uint8_t val_id;                 /*!< Connection current validation ID when command was sent to queue */
+#if LWCELL_CFG_CONN_SEND_FAIR || __DOXYGEN__
+            uint8_t turn; /*!< Number of chunks sent in current turn */
+#endif                    /* LWCELL_CFG_CONN_SEND_FAIR || __DOXYGEN__ */
+#if LWCELL_CFG_CONN_SEND_ADAPT || __DOXYGEN__
+            uint32_t chunk_start; /*!< Time when last chunk command was sent, in units of milliseconds */
+#endif                            /* LWCELL_CFG_CONN_SEND_ADAPT || __DOXYGEN__ */
+#if LWCELL_CFG_CONN_WRITE_RING || __DOXYGEN__
+            size_t ring_len; /*!< Number of bytes to release from connection ring write buffer when finished */
+#endif                       /* LWCELL_CFG_CONN_WRITE_RING || __DOXYGEN__ */
+#if LWCELL_CFG_CONN_SEND_DEADLINE || __DOXYGEN__
+            lwcell_conn_send_id_t id;          /*!< Handle for cancellation, `0` when request is not tracked */
+            struct lwcell_msg* pending_next;   /*!< Next tracked send request */
+            uint32_t deadline;                 /*!< Time when data become stale, in units of milliseconds */
+            uint8_t has_deadline;              /*!< Set to `1` when `deadline` is used */
+            uint8_t cancelled;                 /*!< Set to `1` when request was cancelled by application */
+            uint8_t stale;                     /*!< Set to `1` when request was dropped between chunks */
+#endif                                         /* LWCELL_CFG_CONN_SEND_DEADLINE || __DOXYGEN__ */
+#if LWCELL_CFG_CONN_TX_WINDOW > 0 || __DOXYGEN__
+            struct lwcell_msg* tx_window_next; /*!< Next send request waiting for transmit window */
+            uint8_t tx_window_batch;           /*!< Set to `1` when request of deferred connection is counted */
+#endif                                         /* LWCELL_CFG_CONN_TX_WINDOW > 0 || __DOXYGEN__ */
+#if LWCELL_CFG_NETWORK_PDP_RECOVERY || __DOXYGEN__
+            struct lwcell_msg* pdp_hold_next; /*!< Next send request held until connection is restored */
+#endif                                        /* LWCELL_CFG_NETWORK_PDP_RECOVERY || __DOXYGEN__ */
+#if LWCELL_CFG_CONN_SEND_STREAM || __DOXYGEN__
+            lwcell_conn_read_fn read_fn; /*!< Function to read data from, used instead of `data` when not `NULL` */
+            void* read_arg;              /*!< User argument for read function */
+            uint8_t read_failed;         /*!< Set to `1` when read function did not provide all data of chunk */
+#endif                                   /* LWCELL_CFG_CONN_SEND_STREAM || __DOXYGEN__ */
+        } conn_send;                        /*!< Structure to send data on connection */
+#if LWCELL_CFG_CONN_SERVER || __DOXYGEN__
+        struct {
+            uint8_t en;             /*!< Status to enable or disable server */
+            lwcell_port_t port;     /*!< Local port to listen on */
+            lwcell_evt_fn evt_func; /*!< Callback function for every accepted connection */
+        } conn_server;              /*!< Enable or disable TCP server */
+#endif                              /* LWCELL_CFG_CONN_SERVER || __DOXYGEN__ */
+
+#if LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__
+        struct {
+            lwcell_conn_t* conn; /*!< Pointer to connection to read data from */
+            uint8_t val_id;      /*!< Connection current validation ID when command was sent to queue */
+            size_t len;          /*!< Number of bytes to read, reserved from receive credit */
+            size_t rem;          /*!< Number of bytes remaining in device buffer after read */
+            uint8_t hdr;         /*!< Set to `1` when `+CIPRXGET: 2` header was received */
+        } ciprxget;              /*!< Read received data from device buffer */
+#endif                           /* LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__ */
 #endif                                    /* LWCELL_CFG_CONN || __DOXYGEN__ */
 #if LWCELL_CFG_SMS || __DOXYGEN__
         struct {
@@ -454,7 +739,25 @@ typedef struct lwcell_msg {
             const char* text; /*!< SMS content to send */
             uint8_t format;   /*!< SMS format, `0 = PDU`, `1 = text` */
             size_t pos;       /*!< Set on +CMGS response if command is OK */
-        } sms_send;           /*!< Send SMS */
+#if LWCELL_CFG_SMS_PDU || __DOXYGEN__
+            const void* data;     /*!< User data to send in PDU mode */
+            size_t len;           /*!< Length of user data */
+            size_t off;           /*!< Offset of current part in user data */
+            size_t part_len;      /*!< Length of current part in user data */
+            lwcell_sms_dcs_t dcs; /*!< Data coding scheme */
+            uint8_t ref;          /*!< Concatenated message reference number */
+            uint8_t parts;        /*!< Number of parts, `1` for message which is not concatenated */
+            uint8_t part;         /*!< Current part, starting with `1` */
+
+            lwcell_sms_batch_entry_t* batch; /*!< Batch entries, `NULL` for single message */
+            size_t batch_len;                /*!< Number of batch entries */
+            size_t batch_idx;                /*!< Current batch entry index */
+            uint8_t batch_err;               /*!< Set to `1` when at least one entry failed */
+#if LWCELL_CFG_SMS_DIRECT || __DOXYGEN__
+            uint8_t text_restore; /*!< Text mode restore after send, `1` when send failed, `2` when succeeded */
+#endif                            /* LWCELL_CFG_SMS_DIRECT || __DOXYGEN__ */
+#endif                                       /* LWCELL_CFG_SMS_PDU || __DOXYGEN__ */
+        } sms_send;                          /*!< Send SMS */
 
         struct {
             lwcell_mem_t mem;          /*!< Memory to read from */
@@ -481,6 +784,8 @@ typedef struct lwcell_msg {
             size_t etr;                  /*!< Entries to read (array length) */
             size_t ei;                   /*!< Current entry index in array */
             size_t* er;                  /*!< Final entries read pointer for user */
+            lwcell_sms_list_fn entry_fn; /*!< Entry callback, `entries` is single scratch entry when set */
+            void* entry_arg;             /*!< Custom argument for entry callback */
             uint8_t update;              /*!< Update SMS status after read operation */
             uint8_t format;              /*!< SMS format, `0 = PDU`, `1 = text` */
             uint8_t read;                /*!< Read the data flag */
@@ -512,6 +817,9 @@ typedef struct lwcell_msg {
             size_t etr;                 /*!< NUmber of entries to read */
             size_t ei;                  /*!< Current entry index */
             size_t* er;                 /*!< Final entries read pointer for user */
+            lwcell_pb_list_fn entry_fn; /*!< Entry callback, `entries` is single scratch entry when set */
+            void* entry_arg;            /*!< Custom argument for entry callback */
+            uint8_t stop;               /*!< Flag indicating entry callback requested to stop */
         } pb_list;                      /*!< List phonebook entries */
 
         struct {
@@ -522,23 +830,199 @@ typedef struct lwcell_msg {
             size_t* er;                 /*!< Final entries read pointer for user */
             const char* search;         /*!< Search string */
         } pb_search;                    /*!< Search phonebook entries */
+
+        struct {
+            lwcell_mem_t mem;         /*!< Memory to write entries to */
+            lwcell_pb_entry_t* entry; /*!< Scratch entry filled by import callback */
+            lwcell_pb_import_fn fn;   /*!< Import callback */
+            void* arg;                /*!< Custom argument for import callback */
+            size_t etw;               /*!< Maximal number of entries to write */
+            size_t ei;                /*!< Current entry index */
+            size_t* ew;               /*!< Number of written entries pointer for user */
+            uint8_t failed;           /*!< Flag indicating at least one entry failed */
+        } pb_import;                  /*!< Import phonebook entries */
+#if LWCELL_CFG_PHONEBOOK_MIRROR || __DOXYGEN__
+        struct {
+            lwcell_mem_t mem; /*!< Memory to load */
+            size_t index;     /*!< Start index of next chunk to read */
+            uint8_t overflow; /*!< Flag indicating mirror has no space for read entry */
+        } pb_mirror;          /*!< Load phonebook mirror */
+#endif                        /* LWCELL_CFG_PHONEBOOK_MIRROR || __DOXYGEN__ */
 #endif                                  /* LWCELL_CFG_PHONEBOOK || __DOXYGEN__ */
         struct {
             const char* code;      /*!< Code to send */
             char* resp;            /*!< Response array */
             size_t resp_len;       /*!< Length of response array */
-            uint8_t read;          /*!< Flag indicating we can read the COPS actual data */
+            uint8_t read;          /*!< Flag indicating we can read the +CUSD response data */
             size_t resp_write_ptr; /*!< Write pointer for response */
             uint8_t quote_det;     /*!< Information if quote has been detected */
+            uint8_t field;         /*!< Index of current +CUSD response field */
+            uint8_t dcs;           /*!< Data coding scheme of response string */
         } ussd;                    /*!< Execute USSD command */
 #if LWCELL_CFG_NETWORK || __DOXYGEN__
         struct {
             const char* apn;  /*!< APN address */
             const char* user; /*!< APN username */
             const char* pass; /*!< APN password */
+            uint8_t step;     /*!< Current step of attach sequence */
+            uint8_t attached; /*!< Device is attached to packet domain service, result of `AT+CGATT?` */
+#if LWCELL_CFG_NETWORK_CONTEXTS > 1 || __DOXYGEN__
+            uint8_t ctx;     /*!< PDP context to activate */
+            uint8_t ctx_err; /*!< Context activation failed, result is reported after default context is restored */
+#endif                       /* LWCELL_CFG_NETWORK_CONTEXTS > 1 || __DOXYGEN__ */
         } network_attach;     /*!< Settings for network attach */
 #endif                        /* LWCELL_CFG_NETWORK || __DOXYGEN__ */
-    } msg;                    /*!< Group of different possible message contents */
+#if LWCELL_CFG_MQTT || __DOXYGEN__
+        struct {
+            const lwcell_mqtt_conn_desc_t* desc; /*!< Connection descriptor */
+        } mqtt_connect;                          /*!< Connect to MQTT server */
+
+        struct {
+            const char* topic; /*!< Topic to (un)subscribe */
+            uint8_t qos;       /*!< Quality of service for subscribe */
+        } mqtt_sub;            /*!< Subscribe or unsubscribe MQTT topic */
+
+        struct {
+            const char* topic; /*!< Topic to publish message to */
+            const void* data;  /*!< Message data */
+            size_t data_len;   /*!< Length of message data */
+        } mqtt_pub;            /*!< Publish MQTT message */
+#endif                         /* LWCELL_CFG_MQTT || __DOXYGEN__ */
+#if LWCELL_CFG_SSL || __DOXYGEN__
+        struct {
+            const char* name;           /*!< File name in device file system */
+            size_t len;                 /*!< Total file length */
+            lwcell_ssl_read_fn read_fn; /*!< Callback to read file data */
+            void* read_arg;             /*!< Custom argument for read callback */
+            size_t offset;              /*!< Offset of current chunk */
+            size_t chunk_len;           /*!< Length of current chunk */
+            uint8_t failed;             /*!< Set to `1` when chunk could not be written */
+            uint8_t sync;               /*!< Set to `1` to skip upload when installed file has the same digest */
+            uint8_t mark;               /*!< Set to `1` when digest marker file is checked or written */
+            uint32_t digest;            /*!< Digest of file content, part of marker file name */
+            size_t size;                /*!< Size of installed file, reported by device */
+            uint8_t* uploaded;          /*!< Pointer to output variable, set to `1` when file was uploaded */
+        } ssl_upload;                   /*!< Upload file to device file system */
+
+        struct {
+            const lwcell_ssl_cfg_t* cfg; /*!< SSL context configuration */
+        } ssl_cfg;                       /*!< Configure SSL context */
+#endif                                   /* LWCELL_CFG_SSL || __DOXYGEN__ */
+#if LWCELL_CFG_FS || __DOXYGEN__
+        struct {
+            const char* name; /*!< File name in device file system */
+            const void* data; /*!< Data to write */
+            size_t len;       /*!< Total data length */
+            size_t offset;    /*!< Offset of current chunk */
+            size_t chunk_len; /*!< Length of current chunk */
+            size_t* bw;       /*!< Pointer to output variable for number of bytes written */
+            uint8_t append;   /*!< Set to `1` to append first chunk to existing file */
+            uint8_t failed;   /*!< Set to `1` when chunk could not be written */
+        } fs_write;           /*!< Write data to device file system */
+
+        struct {
+            const char* name; /*!< File name in device file system */
+            size_t* size;     /*!< Pointer to output variable for file size */
+            uint8_t failed;   /*!< Set to `1` when operation failed */
+        } fs_file;            /*!< Get file size or delete file */
+#endif                        /* LWCELL_CFG_FS || __DOXYGEN__ */
+#if LWCELL_CFG_GNSS || __DOXYGEN__
+        struct {
+            uint8_t on;             /*!< Set to `1` to power on engine, `0` to power it off */
+            uint8_t interval;       /*!< Report navigation info every `interval` fixes, `0` to disable reports */
+            lwcell_gnss_fix_t* fix; /*!< Pointer to output variable for navigation info */
+        } gnss;                     /*!< GNSS engine control and navigation info read */
+#endif                              /* LWCELL_CFG_GNSS || __DOXYGEN__ */
+#if LWCELL_CFG_CELL_INFO || __DOXYGEN__
+        struct {
+            uint8_t enable; /*!< Set to `1` to enable reports, `0` to disable them */
+        } cell_info;        /*!< Engineering mode control */
+#endif                      /* LWCELL_CFG_CELL_INFO || __DOXYGEN__ */
+#if LWCELL_CFG_TIME || __DOXYGEN__
+        struct {
+            uint8_t found; /*!< Set to `1` when device reported valid location */
+        } time_loc;        /*!< Get cell location and time */
+#endif                     /* LWCELL_CFG_TIME || __DOXYGEN__ */
+#if LWCELL_CFG_PING || __DOXYGEN__
+        struct {
+            const char* host;               /*!< Host name or IP address to ping */
+            uint16_t count;                 /*!< Number of probes in run */
+            lwcell_ping_stats_t stats;      /*!< Statistics of current run */
+            lwcell_ping_stats_t* stats_out; /*!< Pointer to output variable for statistics */
+            uint32_t rtt_sum;               /*!< Sum of round-trip times of received replies */
+            uint32_t jitter_sum;            /*!< Sum of differences between consecutive round-trip times */
+            uint32_t rtt_last;              /*!< Round-trip time of previous reply */
+            uint8_t periodic_id;            /*!< Periodic probe ID run belongs to, `0` for single run */
+        } ping;                             /*!< Ping remote host */
+#endif                                      /* LWCELL_CFG_PING || __DOXYGEN__ */
+#if LWCELL_CFG_DNS || __DOXYGEN__
+        struct {
+            const char* host;                          /*!< Host name to resolve */
+            lwcell_ip_t* ip;                           /*!< Pointer to output variable for first address */
+            lwcell_ip_t addr[LWCELL_CFG_DNS_MAX_ADDR]; /*!< Resolved addresses */
+            uint8_t addr_cnt;                          /*!< Number of resolved addresses */
+            uint8_t resp_received;                     /*!< Flag indicating resolve result has been received */
+        } dns;                                         /*!< Resolve host name */
+
+        struct {
+            lwcell_ip_t primary;   /*!< Primary DNS server */
+            lwcell_ip_t secondary; /*!< Secondary DNS server */
+            uint8_t has_secondary; /*!< Set to `1` when secondary server is set */
+        } dns_cfg;                 /*!< Set DNS servers */
+#endif                                                 /* LWCELL_CFG_DNS || __DOXYGEN__ */
+#if LWCELL_CFG_PWR || __DOXYGEN__
+        struct {
+            uint8_t mode;     /*!< Mode parameter of command */
+            uint8_t act_type; /*!< Access technology for eDRX setting */
+            const char* t1;   /*!< Periodic TAU or eDRX cycle value string */
+            const char* t2;   /*!< Active time value string */
+        } pwr;                /*!< Power manager configuration */
+#endif                        /* LWCELL_CFG_PWR || __DOXYGEN__ */
+#if LWCELL_CFG_HTTP || __DOXYGEN__
+        struct {
+            const char* url;       /*!< Request URL */
+            uint16_t* status;      /*!< Pointer to output variable for HTTP status code */
+            size_t* content_len;   /*!< Pointer to output variable for response body length */
+            uint8_t resp_received; /*!< Flag indicating request result has been received */
+        } http_get;                /*!< Execute HTTP GET request */
+#endif                             /* LWCELL_CFG_HTTP || __DOXYGEN__ */
+#if LWCELL_CFG_HTTP || LWCELL_CFG_FTP || LWCELL_CFG_FS || __DOXYGEN__
+        struct {
+            size_t offset;      /*!< Offset of chunk to read */
+            size_t len;         /*!< Number of bytes requested from device */
+            lwcell_pbuf_p buff; /*!< First packet buffer of application chain */
+            lwcell_pbuf_p p;    /*!< Packet buffer currently written to */
+            size_t p_ptr;       /*!< Write pointer in current packet buffer */
+            size_t rem_len;     /*!< Remaining bytes of raw data device is sending */
+            size_t recv_len;    /*!< Number of bytes written to packet buffers */
+            size_t* br;         /*!< Pointer to output variable for number of bytes read */
+            uint8_t read;       /*!< Flag indicating raw data are being received */
+#if LWCELL_CFG_FS || __DOXYGEN__
+            const char* name; /*!< File name, used with device file system read */
+            uint8_t failed;   /*!< Set to `1` when device file system read failed */
+#endif                        /* LWCELL_CFG_FS || __DOXYGEN__ */
+        } data_read;          /*!< Read HTTP body, FTP or device file chunk to packet buffers */
+#endif                        /* LWCELL_CFG_HTTP || LWCELL_CFG_FTP || LWCELL_CFG_FS || __DOXYGEN__ */
+#if LWCELL_CFG_FTP || __DOXYGEN__
+        struct {
+            const lwcell_ftp_desc_t* desc; /*!< Server and file descriptor */
+            size_t offset;                 /*!< Download restart offset or upload append flag when not `0` */
+            uint8_t resp_received;         /*!< Flag indicating session open result has been received */
+            uint8_t resp_code;             /*!< Session open result code from device */
+#if LWCELL_CFG_FS || __DOXYGEN__
+            const char* fs_name; /*!< File in device file system to upload, `NULL` for upload from application */
+#endif                           /* LWCELL_CFG_FS || __DOXYGEN__ */
+        } ftp_start;             /*!< Open FTP download or upload session */
+
+        struct {
+            const void* data;      /*!< Data to upload */
+            size_t len;            /*!< Number of bytes to write in this chunk */
+            size_t* bw;            /*!< Pointer to output variable for number of bytes written */
+            uint8_t resp_received; /*!< Flag indicating device finished processing of the chunk */
+            uint8_t resp_code;     /*!< Result code from device */
+        } ftp_put;                 /*!< Write FTP upload chunk or finish upload */
+#endif                             /* LWCELL_CFG_FTP || __DOXYGEN__ */
+    } msg;                         /*!< Group of different possible message contents */
 } lwcell_msg_t;
 
 /**
@@ -564,12 +1048,25 @@ typedef struct {
     lwcell_port_t local_port;  /*!< Local port number */
 } lwcell_link_conn_t;
 
+#if LWCELL_CFG_EVT_DEFERRED || __DOXYGEN__
+
+/**
+ * \brief           Deferred event record, queued to event dispatch thread
+ */
+typedef struct {
+    lwcell_evt_fn fn; /*!< Callback function to call */
+    lwcell_evt_t evt; /*!< Copy of event data */
+} lwcell_evt_rec_t;
+
+#endif /* LWCELL_CFG_EVT_DEFERRED || __DOXYGEN__ */
+
 /**
  * \brief           Callback function linked list prototype
  */
 typedef struct lwcell_evt_func {
     struct lwcell_evt_func* next; /*!< Next function in the list */
     lwcell_evt_fn fn;             /*!< Function pointer itself */
+    lwcell_evt_mask_t mask;       /*!< Subscribed event types */
 } lwcell_evt_func_t;
 
 /**
@@ -592,6 +1089,24 @@ typedef struct {
     uint8_t enabled; /*!< Flag indicating feature enabled */
 
     lwcell_sms_mem_t mem[3]; /*!< 3 memory info for operation,receive,sent storage */
+#if LWCELL_CFG_SMS_PDU || __DOXYGEN__
+    uint8_t pdu_ref; /*!< Last used concatenated message reference number */
+#endif               /* LWCELL_CFG_SMS_PDU || __DOXYGEN__ */
+#if LWCELL_CFG_SMS_DIRECT || __DOXYGEN__
+    lwcell_sms_entry_t direct; /*!< Message delivered with `+CMT` */
+    uint8_t direct_read;       /*!< Set to `1` when text line of `+CMT` is expected */
+#endif                         /* LWCELL_CFG_SMS_DIRECT || __DOXYGEN__ */
+#if LWCELL_CFG_SMS_INBOX || __DOXYGEN__
+    lwcell_sms_list_fn inbox_fn;    /*!< Inbox entry callback, `NULL` when service is disabled */
+    void* inbox_arg;                /*!< Custom argument for inbox entry callback */
+    lwcell_sms_entry_t inbox_entry; /*!< Scratch entry for inbox list operation */
+    size_t inbox_cnt;               /*!< Number of messages listed in current drain */
+    lwcell_mem_t inbox_mem;         /*!< Memory of current drain */
+    lwcell_mem_t inbox_next_mem;    /*!< Memory of notification received during drain */
+    uint8_t inbox_scheduled;        /*!< Set to `1` when drain is waiting for notifications window */
+    uint8_t inbox_busy;             /*!< Set to `1` when list or delete command is in progress */
+    uint8_t inbox_pending;          /*!< Set to `1` when notification is received during drain */
+#endif                              /* LWCELL_CFG_SMS_INBOX || __DOXYGEN__ */
 } lwcell_sms_t;
 
 /**
@@ -605,6 +1120,32 @@ typedef struct {
     size_t used;            /*!< Number of used entries */
 } lwcell_pb_mem_t;
 
+#if LWCELL_CFG_PHONEBOOK_MIRROR || __DOXYGEN__
+
+/**
+ * \ingroup         LWCELL_PB
+ * \brief           Phonebook mirror entry
+ */
+typedef struct {
+    lwcell_pb_entry_t entry; /*!< Entry data. Slot is free when `entry.pos == 0` */
+    uint32_t hash;           /*!< Hash of normalized entry number */
+    uint16_t next;           /*!< Next slot in the same bucket, `1` based. `0` marks end of chain */
+} lwcell_pb_mirror_entry_t;
+
+/**
+ * \ingroup         LWCELL_PB
+ * \brief           Phonebook RAM mirror
+ */
+typedef struct {
+    uint8_t valid;                                                     /*!< Flag indicating mirror is loaded */
+    lwcell_mem_t mem;                                                  /*!< Memory mirror was loaded from */
+    size_t total;                                                      /*!< Size of mirrored memory in entries */
+    lwcell_pb_mirror_entry_t slots[LWCELL_CFG_PHONEBOOK_MIRROR_SIZE]; /*!< Entry slots */
+    uint16_t buckets[LWCELL_CFG_PHONEBOOK_MIRROR_SIZE];               /*!< Hash buckets, `1` based slot index */
+} lwcell_pb_mirror_t;
+
+#endif /* LWCELL_CFG_PHONEBOOK_MIRROR || __DOXYGEN__ */
+
 /**
  * \ingroup         LWCELL_PB
  * \brief           Phonebook structure
@@ -614,6 +1155,9 @@ typedef struct {
     uint8_t enabled; /*!< Flag indicating feature enabled */
 
     lwcell_pb_mem_t mem; /*!< Memory information */
+#if LWCELL_CFG_PHONEBOOK_MIRROR || __DOXYGEN__
+    lwcell_pb_mirror_t mirror; /*!< RAM mirror of phonebook entries */
+#endif                         /* LWCELL_CFG_PHONEBOOK_MIRROR || __DOXYGEN__ */
 } lwcell_pb_t;
 
 /**
@@ -621,8 +1165,22 @@ typedef struct {
  */
 typedef struct {
     lwcell_sim_state_t state; /*!< Current SIM status */
+    uint8_t info_tries;       /*!< Number of failed SIM info reads since SIM became ready */
 } lwcell_sim_t;
 
+/**
+ * \brief           IP connection state, as reported by `AT+CIPSTATUS`
+ */
+typedef enum {
+    LWCELL_IP_STATE_UNKNOWN = 0x00, /*!< State not known yet */
+    LWCELL_IP_STATE_INITIAL,        /*!< `IP INITIAL`, nothing configured */
+    LWCELL_IP_STATE_START,          /*!< `IP START`, APN is set */
+    LWCELL_IP_STATE_CONFIG,         /*!< `IP CONFIG`, context activation in progress */
+    LWCELL_IP_STATE_GPRSACT,        /*!< `IP GPRSACT`, context is active, IP address not read yet */
+    LWCELL_IP_STATE_ACTIVE,         /*!< `IP STATUS` or any connection state, context is active with IP address */
+    LWCELL_IP_STATE_DEACT,          /*!< `PDP DEACT`, context was deactivated by network */
+} lwcell_ip_state_t;
+
 /**
  * \brief           Network info
  */
@@ -630,10 +1188,46 @@ typedef struct {
     lwcell_network_reg_status_t status;   /*!< Network registration status */
     lwcell_operator_curr_t curr_operator; /*!< Current operator information */
 
-    uint8_t is_attached; /*!< Flag indicating device is attached and PDP context is active */
-    lwcell_ip_t ip_addr; /*!< Device IP address when network PDP context is enabled */
+    uint8_t is_attached;        /*!< Flag indicating device is attached and PDP context is active */
+    lwcell_ip_t ip_addr;        /*!< Device IP address when network PDP context is enabled */
+    lwcell_ip_state_t ip_state; /*!< Last IP connection state reported by device */
+#if LWCELL_CFG_NETWORK_PS_REG || __DOXYGEN__
+    lwcell_network_reg_status_t gprs_status; /*!< GPRS registration status, reported with `+CGREG` */
+    lwcell_network_reg_status_t eps_status;  /*!< EPS registration status, reported with `+CEREG` */
+    uint32_t area_code;                      /*!< Location or tracking area code of serving cell */
+    uint32_t cell_id;                        /*!< Serving cell ID, `0` when not known */
+#endif                                       /* LWCELL_CFG_NETWORK_PS_REG || __DOXYGEN__ */
+#if LWCELL_CFG_NETWORK_BAND || __DOXYGEN__
+    lwcell_network_band_t band; /*!< Serving radio access technology and band, reported with `+CPSI` */
+#endif                          /* LWCELL_CFG_NETWORK_BAND || __DOXYGEN__ */
+#if LWCELL_CFG_NETWORK_CONTEXTS > 1 || __DOXYGEN__
+    struct {
+        uint8_t is_attached; /*!< Flag indicating PDP context is active */
+        lwcell_ip_t ip_addr; /*!< Device IP address in this PDP context */
+    } ctx[LWCELL_CFG_NETWORK_CONTEXTS - 1]; /*!< Additional PDP contexts, entry `0` is context `1` */
+#endif                                      /* LWCELL_CFG_NETWORK_CONTEXTS > 1 || __DOXYGEN__ */
 } lwcell_network_t;
 
+/**
+ * \brief           HTTP session information
+ */
+typedef struct {
+    uint8_t active;     /*!< Flag indicating session with valid response is active on device */
+    uint8_t is_sh;      /*!< Session uses `AT+SH` command set instead of `AT+HTTP` */
+    uint16_t status;    /*!< HTTP status code of last request */
+    size_t content_len; /*!< Length of response body */
+} lwcell_http_t;
+
+/**
+ * \brief           FTP session information
+ */
+typedef struct {
+    uint8_t active;     /*!< Flag indicating download or upload session is open on device */
+    uint8_t is_put;     /*!< Session is upload session */
+    size_t offset;      /*!< Current offset in remote file */
+    size_t put_max_len; /*!< Maximal upload chunk length accepted by device */
+} lwcell_ftp_t;
+
 /**
  * \brief           GSM modules structure
  */
@@ -649,6 +1243,9 @@ typedef struct {
     lwcell_sim_t sim;         /*!< SIM data */
     lwcell_network_t network; /*!< Network status */
     int16_t rssi;             /*!< RSSI signal strength. `0` = invalid, `-53 % -113` = valid */
+#if LWCELL_CFG_RSSI_HYSTERESIS > 0 || __DOXYGEN__
+    int16_t rssi_evt; /*!< RSSI reported with last \ref LWCELL_EVT_SIGNAL_STRENGTH event */
+#endif                /* LWCELL_CFG_RSSI_HYSTERESIS > 0 || __DOXYGEN__ */
 
     /* Device specific */
 #if LWCELL_CFG_CONN || __DOXYGEN__
@@ -657,6 +1254,26 @@ typedef struct {
     lwcell_conn_t conns[LWCELL_CFG_MAX_CONNS]; /*!< Array of all connection structures */
     lwcell_ipd_t ipd;                          /*!< Connection incoming data structure */
     uint8_t conn_val_id;                       /*!< Validation ID increased each time device connects to network */
+#if LWCELL_CFG_CONN_SEND_FAIR || __DOXYGEN__
+    uint8_t conn_send_queued[LWCELL_CFG_MAX_CONNS]; /*!< Number of send requests waiting in queue per connection */
+    uint16_t conn_send_queued_all;                  /*!< Number of send requests waiting in queue for all connections */
+#endif                                              /* LWCELL_CFG_CONN_SEND_FAIR || __DOXYGEN__ */
+#if LWCELL_CFG_CONN_SEND_DEADLINE || __DOXYGEN__
+    struct lwcell_msg* conn_send_pending; /*!< List of tracked send requests, queued or in progress */
+    lwcell_conn_send_id_t conn_send_id;   /*!< Last send request handle */
+#endif                                    /* LWCELL_CFG_CONN_SEND_DEADLINE || __DOXYGEN__ */
+#if LWCELL_CFG_CONN_SERVER || __DOXYGEN__
+    lwcell_evt_fn evt_server;  /*!< Callback function for accepted connections, `NULL` when server is not active */
+    lwcell_port_t server_port; /*!< Local port server is listening on */
+#endif                         /* LWCELL_CFG_CONN_SERVER || __DOXYGEN__ */
+#if LWCELL_CFG_CONN_CA_SOCKET || __DOXYGEN__
+    uint8_t ca_pdp_active; /*!< Status if PDP context for `AT+CAOPEN` socket commands is active */
+#endif                     /* LWCELL_CFG_CONN_CA_SOCKET || __DOXYGEN__ */
+#if LWCELL_CFG_CONN_RECV_BATCH > 0 || __DOXYGEN__
+    lwcell_pbuf_p recv_batch[LWCELL_CFG_CONN_RECV_BATCH]; /*!< Received packets waiting for batch receive function */
+    size_t recv_batch_cnt;                                /*!< Number of packets in batch */
+    lwcell_conn_t* recv_batch_conn;                       /*!< Connection of packets in batch */
+#endif                                                    /* LWCELL_CFG_CONN_RECV_BATCH > 0 || __DOXYGEN__ */
 #endif                                         /* LWCELL_CFG_CONNS || __DOXYGEN__ */
 #if LWCELL_CFG_SMS || __DOXYGEN__
     lwcell_sms_t sms; /*!< SMS information */
@@ -666,9 +1283,409 @@ typedef struct {
 #endif              /* LWCELL_CFG_PHONEBOOK || __DOXYGEN__ */
 #if LWCELL_CFG_CALL || __DOXYGEN__
     lwcell_call_t call; /*!< Call information */
+    uint8_t call_rings; /*!< Number of `RING` reports for current incoming call */
 #endif                  /* LWCELL_CFG_CALL || __DOXYGEN__ */
+#if LWCELL_CFG_MQTT || __DOXYGEN__
+    lwcell_mqtt_t mqtt; /*!< Native MQTT instance, device supports single connection */
+#endif                  /* LWCELL_CFG_MQTT || __DOXYGEN__ */
+#if LWCELL_CFG_HTTP || __DOXYGEN__
+    lwcell_http_t http; /*!< HTTP session, device supports single session */
+#endif                  /* LWCELL_CFG_HTTP || __DOXYGEN__ */
+#if LWCELL_CFG_FTP || __DOXYGEN__
+    lwcell_ftp_t ftp; /*!< FTP session, device supports single session */
+#endif                /* LWCELL_CFG_FTP || __DOXYGEN__ */
+#if LWCELL_CFG_GNSS || __DOXYGEN__
+    lwcell_gnss_fix_t gnss; /*!< Last navigation info reported by device */
+#endif                      /* LWCELL_CFG_GNSS || __DOXYGEN__ */
+#if LWCELL_CFG_CELL_INFO || __DOXYGEN__
+    lwcell_cell_info_t cell_info; /*!< Last cell measurements reported by device */
+#endif                            /* LWCELL_CFG_CELL_INFO || __DOXYGEN__ */
 } lwcell_modules_t;
 
+/**
+ * \brief           Receive character structure to handle full line terminated with `\n` character
+ */
+typedef struct {
+    char data[LWCELL_CFG_RCV_LINE_SIZE]; /*!< Received characters, terminated only when passed to parser */
+    size_t len;                          /*!< Length of valid characters */
+    size_t overflow;                     /*!< Number of characters of current line, which did not fit to buffer */
+} lwcell_recv_t;
+
+/**
+ * \brief           Operator scan response parsing state
+ */
+typedef struct {
+    union {
+        struct {
+            uint8_t bo  : 1; /*!< Bracket open flag (Bracket Open) */
+            uint8_t ccd : 1; /*!< 2 consecutive commas detected in a row (Comma Comma Detected) */
+            uint8_t tn  : 2; /*!< Term number in response, 2 bits for 4 diff values */
+            uint8_t tp;      /*!< Current term character position */
+            uint8_t ch_prev; /*!< Previous character */
+        } f;                 /*!< Flags structure */
+    } u;                     /*!< Term parsing state */
+    lwcell_operator_t op;    /*!< Operator entry currently being parsed */
+    size_t op_idx;           /*!< Index of operator entry in response */
+} lwcell_cops_scan_t;
+
+/**
+ * \brief           Input parser state, kept across \ref lwcelli_process calls
+ */
+typedef struct {
+    lwcell_recv_t recv;       /*!< Currently received line */
+    uint8_t ch_prev1;         /*!< Previously received character */
+    uint8_t ch_prev2;         /*!< Character received before previous one */
+    lwcell_unicode_t unicode; /*!< Unicode decoder state */
+#if LWCELL_CFG_RCV_LINE_STREAM || __DOXYGEN__
+    lwcell_line_stream_fn line_stream_fn; /*!< Long line stream callback function */
+    void* line_stream_arg;                /*!< Custom argument for long line stream callback */
+#endif                                    /* LWCELL_CFG_RCV_LINE_STREAM || __DOXYGEN__ */
+#if LWCELL_CFG_AT_ECHO_SKIP || __DOXYGEN__
+    struct {
+        char cmd[LWCELL_CFG_AT_ECHO_SKIP_LEN]; /*!< Beginning of last sent command, expected as echo */
+        size_t len;                            /*!< Number of valid characters in `cmd` */
+        size_t match;                          /*!< Number of echo characters already matched */
+        uint8_t truncated;                     /*!< Set to `1` when command did not fit to `cmd` */
+        uint8_t record;                        /*!< Set to `1` while command is being sent */
+        uint8_t tail;                          /*!< Set to `1` when command matched, rest of line is skipped */
+        lwcell_echo_tap_fn tap_fn;             /*!< Skipped echo callback function */
+        void* tap_arg;                         /*!< Custom argument for echo callback */
+    } echo;                                    /*!< Command echo matching state */
+#endif                                         /* LWCELL_CFG_AT_ECHO_SKIP || __DOXYGEN__ */
+#if LWCELL_CFG_INPUT_ZERO_COPY || __DOXYGEN__
+    struct {
+        uint8_t active;                    /*!< Set to `1` when input data are lent by driver */
+        lwcell_pbuf_release_fn release_fn; /*!< Release function for lent memory */
+        void* arg;                         /*!< Custom argument for release function */
+    } ipd_lend;                            /*!< Memory lent by low-level driver for currently processed input data */
+#endif                                     /* LWCELL_CFG_INPUT_ZERO_COPY || __DOXYGEN__ */
+    lwcell_cops_scan_t cops;               /*!< Operator scan response parsing state */
+} lwcell_parser_t;
+
+#if LWCELL_CFG_MSG_POOL_SIZE > 0 || __DOXYGEN__
+
+/**
+ * \brief           Preallocated message pool
+ */
+typedef struct {
+    lwcell_msg_t msgs[LWCELL_CFG_MSG_POOL_SIZE];  /*!< Preallocated messages */
+    lwcell_msg_t* free[LWCELL_CFG_MSG_POOL_SIZE]; /*!< Stack of free messages in pool */
+    size_t free_cnt;                              /*!< Number of entries in free stack */
+    uint8_t initialized;                          /*!< Set to `1` after free stack is filled */
+} lwcell_msg_pool_t;
+
+#endif /* LWCELL_CFG_MSG_POOL_SIZE > 0 || __DOXYGEN__ */
+
+#if LWCELL_CFG_CMD_TIMEOUT_ADAPT || __DOXYGEN__
+
+/**
+ * \brief           Turnaround time profile of single command type
+ */
+typedef struct {
+    lwcell_cmd_t cmd; /*!< Command type, as set in \ref lwcell_msg_t::cmd_def */
+    int32_t srtt;     /*!< Smoothed turnaround time in units of milliseconds */
+    int32_t rttvar;   /*!< Smoothed mean deviation of turnaround time in units of milliseconds */
+    uint32_t samples; /*!< Number of collected samples */
+} lwcell_cmd_profile_t;
+
+/**
+ * \brief           Adaptive command timeout state
+ */
+typedef struct {
+    lwcell_cmd_profile_t profiles[LWCELL_CFG_CMD_TIMEOUT_ADAPT_CMD_MAX]; /*!< Profiles, assigned on first use */
+    size_t profiles_used;                                                /*!< Number of used profiles */
+    uint8_t probes;                                                      /*!< Stall probes sent in a row */
+    uint32_t start;                                                      /*!< Start time of active command */
+    uint32_t window;                                                     /*!< Stall window of active command */
+} lwcell_cmd_adapt_t;
+
+#endif /* LWCELL_CFG_CMD_TIMEOUT_ADAPT || __DOXYGEN__ */
+
+#if LWCELL_CFG_STATS || __DOXYGEN__
+
+/**
+ * \brief           Command statistics
+ */
+typedef struct {
+    lwcell_stats_t entries[LWCELL_CFG_STATS_CMD_MAX]; /*!< Statistics entries, assigned on first use */
+    size_t used;                                      /*!< Number of used entries */
+    struct {
+        uint32_t dequeued; /*!< Time when command was taken from queue */
+        uint32_t started;  /*!< Time when command transmission started */
+        uint32_t parse;    /*!< Accumulated parsing time */
+    } cur;                 /*!< Time points of currently executed command */
+} lwcell_cmd_stats_t;
+
+#endif /* LWCELL_CFG_STATS || __DOXYGEN__ */
+
+#if (LWCELL_CFG_CONN && LWCELL_CFG_CONN_TX_WINDOW > 0) || __DOXYGEN__
+
+/**
+ * \brief           Transmit window state, shared by all connections
+ */
+typedef struct {
+    lwcell_timeout_t timeout; /*!< Release timeout */
+    lwcell_msg_t* first;      /*!< First send request waiting for transmit window */
+    lwcell_msg_t* last;       /*!< Last send request waiting for transmit window */
+    uint32_t time;            /*!< Time when window was last opened */
+    uint8_t was_open;         /*!< Set to `1` once window was opened */
+#if LWCELL_CFG_PWR_RADIO_RELEASE || __DOXYGEN__
+    size_t batch_cnt; /*!< Number of unfinished send requests of deferred connections */
+#endif                /* LWCELL_CFG_PWR_RADIO_RELEASE || __DOXYGEN__ */
+} lwcell_tx_window_t;
+
+#endif /* (LWCELL_CFG_CONN && LWCELL_CFG_CONN_TX_WINDOW > 0) || __DOXYGEN__ */
+
+#if (LWCELL_CFG_NETWORK && LWCELL_CFG_NETWORK_PDP_RECOVERY) || __DOXYGEN__
+
+/**
+ * \brief           PDP context recovery state
+ */
+typedef struct {
+    const char* apn;          /*!< APN for context reactivation, `NULL` when recovery is disabled */
+    const char* user;         /*!< APN username for context reactivation */
+    const char* pass;         /*!< APN password for context reactivation */
+    uint8_t busy;             /*!< Set to `1` while context or connections are being restored */
+    lwcell_msg_t* hold_first; /*!< Send requests held until their connection is restored */
+    lwcell_timeout_t timeout; /*!< Held sends release retry timeout */
+} lwcell_pdp_recovery_t;
+
+#endif /* (LWCELL_CFG_NETWORK && LWCELL_CFG_NETWORK_PDP_RECOVERY) || __DOXYGEN__ */
+
+#if LWCELL_CFG_NETWORK_BAND || __DOXYGEN__
+
+/**
+ * \brief           Band lock manager state
+ */
+typedef struct {
+    const lwcell_network_band_cfg_t* cfg; /*!< Band lock manager configuration */
+    lwcell_network_band_t learned;        /*!< Band of last successful registration */
+    lwcell_network_band_t serving;        /*!< Serving band, read on registration */
+    lwcell_timeout_t timeout;             /*!< Timeout to widen search from learned band */
+    uint8_t narrow;                       /*!< Set to `1` while search is locked to learned band */
+    uint8_t registered;                   /*!< Registration status of last event */
+} lwcell_band_mgr_t;
+
+#endif /* LWCELL_CFG_NETWORK_BAND || __DOXYGEN__ */
+
+#if LWCELL_CFG_DNS || __DOXYGEN__
+
+/**
+ * \brief           DNS cache entry
+ */
+typedef struct {
+    char host[LWCELL_CFG_DNS_HOST_LEN];        /*!< Host name, empty when entry is not used */
+    lwcell_ip_t addr[LWCELL_CFG_DNS_MAX_ADDR]; /*!< Resolved addresses */
+    uint8_t addr_cnt;                          /*!< Number of valid addresses */
+    uint8_t addr_idx;                          /*!< Index of address used for next connection */
+    uint32_t time;                             /*!< Time when host was resolved */
+    uint32_t used;                             /*!< Time of last use */
+} lwcell_dns_entry_t;
+
+#endif /* LWCELL_CFG_DNS || __DOXYGEN__ */
+
+#if LWCELL_CFG_PING || __DOXYGEN__
+
+/**
+ * \brief           Periodic ping probe state
+ */
+typedef struct {
+    lwcell_timeout_t timeout; /*!< Periodic probe timeout entry */
+    const char* host;         /*!< Periodic probe host */
+    uint16_t count;           /*!< Number of probes in periodic run */
+    uint32_t interval;        /*!< Time between periodic runs, `0` when periodic probe is stopped */
+    uint8_t id;               /*!< Current periodic probe ID */
+} lwcell_ping_periodic_t;
+
+#endif /* LWCELL_CFG_PING || __DOXYGEN__ */
+
+#if LWCELL_CFG_CMUX || __DOXYGEN__
+
+/**
+ * \brief           Multiplexer frame receive state
+ */
+typedef enum {
+    LWCELL_CMUX_RX_FLAG, /*!< Waiting for opening flag */
+    LWCELL_CMUX_RX_ADDR, /*!< Waiting for address field */
+    LWCELL_CMUX_RX_CTRL, /*!< Waiting for control field */
+    LWCELL_CMUX_RX_LEN,  /*!< Waiting for first length byte */
+    LWCELL_CMUX_RX_LEN2, /*!< Waiting for second length byte */
+    LWCELL_CMUX_RX_DATA, /*!< Receiving information field */
+    LWCELL_CMUX_RX_FCS,  /*!< Waiting for frame check sequence */
+} lwcell_cmux_rx_state_t;
+
+/**
+ * \brief           Multiplexer state
+ */
+typedef struct {
+    uint8_t active;               /*!< Set to `1` when device is in multiplexer mode */
+    uint8_t in_frame;             /*!< Set to `1` while stack channel payload is processed */
+    uint8_t channels;             /*!< Number of application channels */
+    lwcell_cmux_rx_fn rx_fn;      /*!< Application channel receive callback */
+    void* rx_arg;                 /*!< Application channel receive callback argument */
+    lwcell_ll_send_fn ll_send_fn; /*!< Low-level send function, receives complete frames */
+
+    uint8_t tx_buff[LWCELL_CFG_CMUX_FRAME_LEN]; /*!< Stack channel data waiting for frame */
+    size_t tx_len;                              /*!< Number of bytes in TX buffer */
+
+    lwcell_cmux_rx_state_t rx_state;            /*!< Frame receive state */
+    uint8_t rx_hdr[4];                          /*!< Address, control and length fields of received frame */
+    size_t rx_hdr_len;                          /*!< Length of received header */
+    size_t rx_len;                              /*!< Length of received information field */
+    size_t rx_pos;                              /*!< Number of information bytes received so far */
+    uint8_t rx_buff[LWCELL_CFG_CMUX_FRAME_LEN]; /*!< Received information field */
+} lwcell_cmux_t;
+
+#endif /* LWCELL_CFG_CMUX || __DOXYGEN__ */
+
+#if LWCELL_CFG_PPP || __DOXYGEN__
+
+/**
+ * \brief           PPP session state
+ */
+typedef enum {
+    LWCELL_PPP_STATE_IDLE,    /*!< No packet service call */
+    LWCELL_PPP_STATE_DIALING, /*!< Waiting for `CONNECT` */
+    LWCELL_PPP_STATE_DATA,    /*!< Device is in data mode */
+    LWCELL_PPP_STATE_COMMAND, /*!< Call is active, device is in command mode */
+} lwcell_ppp_state_t;
+
+/**
+ * \brief           PPP session
+ */
+typedef struct {
+    lwcell_ppp_state_t state;     /*!< Session state */
+    uint8_t dlci;                 /*!< Multiplexer channel DLCI, `0` when AT channel is used */
+    lwcell_ppp_input_fn input_fn; /*!< Data received callback */
+    void* arg;                    /*!< Data received callback argument */
+#if LWCELL_CFG_CMUX || __DOXYGEN__
+    char line[16];   /*!< Response line received on multiplexer channel */
+    size_t line_len; /*!< Length of response line */
+#endif               /* LWCELL_CFG_CMUX || __DOXYGEN__ */
+} lwcell_ppp_t;
+
+#endif /* LWCELL_CFG_PPP || __DOXYGEN__ */
+
+#if LWCELL_CFG_PWR || __DOXYGEN__
+
+/**
+ * \brief           Power management state
+ */
+typedef struct {
+    lwcell_timeout_t idle_timeout; /*!< Command inactivity timeout entry */
+    lwcell_pwr_sleep_t mode;       /*!< Active sleep mode, set once device accepted it */
+    uint8_t asleep;                /*!< Set to `1` when modem is considered asleep */
+} lwcell_pwr_t;
+
+#endif /* LWCELL_CFG_PWR || __DOXYGEN__ */
+
+#if LWCELL_CFG_SUPERVISOR || __DOXYGEN__
+
+/**
+ * \brief           Type of fault detected by supervisor
+ */
+typedef enum {
+    LWCELL_SV_FAULT_NONE = 0x00, /*!< Device is healthy */
+    LWCELL_SV_FAULT_LINK,        /*!< Device does not respond to commands */
+    LWCELL_SV_FAULT_REG,         /*!< Network registration or data link is lost */
+} lwcell_sv_fault_t;
+
+/**
+ * \brief           Supervisor state
+ */
+typedef struct {
+    lwcell_timeout_t timeout;        /*!< Health check timeout entry */
+    lwcell_supervisor_stats_t stats; /*!< Recovery statistics */
+    uint32_t ttr_total;              /*!< Sum of all recovery times, used for mean value */
+    lwcell_supervisor_tier_t tier;   /*!< Active recovery tier */
+    lwcell_supervisor_tier_t heavy;  /*!< Last radio cycle or reset tier of active fault */
+    lwcell_sv_fault_t fault;         /*!< Active fault */
+    uint32_t fault_time;             /*!< Time when fault has been detected */
+    uint32_t action_time;            /*!< Time when active tier action started */
+    uint8_t action_busy;             /*!< Set to `1` while tier action command is in progress */
+    uint8_t resets;                  /*!< Number of resets for active fault */
+    uint8_t timeouts;                /*!< Number of consecutive command timeouts */
+    uint8_t probe_busy;              /*!< Set to `1` while probe on RX silence is in progress */
+    uint32_t rx_len;                 /*!< Received data counter at last check */
+    uint32_t rx_time;                /*!< Time when data were last received */
+    uint8_t was_registered;          /*!< Device has been registered to network since start */
+    uint8_t reg_lost;                /*!< Set to `1` when registration is lost */
+    uint32_t reg_lost_time;          /*!< Time when registration has been lost */
+#if LWCELL_CFG_NETWORK || __DOXYGEN__
+    const char* apn;      /*!< APN for reattach */
+    const char* user;     /*!< APN username for reattach */
+    const char* pass;     /*!< APN password for reattach */
+    uint8_t data_watch;   /*!< Set to `1` when data link is supervised */
+    uint8_t was_attached; /*!< Application attached to network and did not detach */
+    uint8_t reattached;   /*!< Reattach has been tried since last radio cycle or reset */
+#endif                    /* LWCELL_CFG_NETWORK || __DOXYGEN__ */
+} lwcell_sv_t;
+
+#endif /* LWCELL_CFG_SUPERVISOR || __DOXYGEN__ */
+
+#if LWCELL_CFG_TIME || __DOXYGEN__
+
+/**
+ * \brief           Network time and location state
+ */
+typedef struct {
+    uint8_t valid;         /*!< Set to `1` when time was captured */
+    uint32_t epoch;        /*!< UTC time in seconds since `1970-01-01`, valid at `tick` */
+    uint32_t tick;         /*!< System time in milliseconds, when `epoch` was captured */
+    int8_t tz;             /*!< Time zone in units of quarter hours */
+    uint8_t loc_valid;     /*!< Set to `1` when location was captured */
+    lwcell_location_t loc; /*!< Last reported location */
+} lwcell_time_state_t;
+
+#endif /* LWCELL_CFG_TIME || __DOXYGEN__ */
+
+#if LWCELL_CFG_USAGE || __DOXYGEN__
+
+/**
+ * \brief           Data usage accounting state
+ */
+typedef struct {
+    lwcell_usage_t ctx[LWCELL_CFG_NETWORK_CONTEXTS]; /*!< Usage per PDP context */
+    lwcell_usage_t total;                            /*!< Total usage */
+    uint64_t warn;                                   /*!< Warning threshold, `0` when not used */
+    uint64_t limit;                                  /*!< Limit threshold, `0` when not used */
+    uint8_t throttle;                                /*!< Set to `1` to throttle low-priority connections */
+    uint8_t warn_sent;                               /*!< Warning event has been sent */
+    uint8_t limit_sent;                              /*!< Limit event has been sent */
+} lwcell_usage_state_t;
+
+#endif /* LWCELL_CFG_USAGE || __DOXYGEN__ */
+
+#if LWCELL_CFG_METRICS || __DOXYGEN__
+
+/**
+ * \brief           Metrics sampling state
+ */
+typedef struct {
+    uint8_t buff[LWCELL_CFG_METRICS_BUFF_SIZE]; /*!< Encoded differences of samples after oldest one */
+    size_t r;                                   /*!< Read position of oldest encoded sample */
+    size_t w;                                   /*!< Write position for next encoded sample */
+    size_t used;                                /*!< Number of used bytes in buffer */
+    size_t count;                               /*!< Number of samples, including oldest one */
+    int32_t first[LWCELL_METRICS_END];          /*!< Values of oldest sample */
+    int32_t last[LWCELL_METRICS_END];           /*!< Values of newest sample */
+    uint32_t last_time;                         /*!< Time of newest sample */
+    uint32_t interval;                          /*!< Sampling interval, `0` when stopped */
+    lwcell_timeout_t timeout;                   /*!< Sampling timeout entry */
+    struct {
+        uint32_t rx_bytes;  /*!< Received bytes */
+        uint32_t tx_bytes;  /*!< Sent bytes */
+        uint32_t attaches;  /*!< Network attached events */
+        uint32_t conn_open; /*!< Connection active events */
+        uint32_t conn_err;  /*!< Connection error events */
+        uint32_t cmd_count; /*!< Finished commands */
+        uint32_t cmd_err;   /*!< Commands finished with error or timeout */
+        uint32_t cmd_turn;  /*!< Sum of turnaround times */
+    } prev;                 /*!< Counter values at previous sample, to calculate increase during interval */
+} lwcell_metrics_state_t;
+
+#endif /* LWCELL_CFG_METRICS || __DOXYGEN__ */
+
 /**
  * \brief           GSM global structure
  */
@@ -677,20 +1694,129 @@ typedef struct {
 
     lwcell_sys_sem_t sem_sync;          /*!< Synchronization semaphore between threads */
     lwcell_sys_mbox_t mbox_producer;    /*!< Producer message queue handle */
+#if LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0 || __DOXYGEN__
+    lwcell_sys_mbox_t mbox_producer_prio; /*!< Producer priority message queue handle */
+    uint8_t producer_prio_wakeup;         /*!< Wake-up entry for priority lane is in producer queue */
+#endif                                    /* LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0 || __DOXYGEN__ */
+#if LWCELL_CFG_THREAD_PROCESS_NOTIFY || __DOXYGEN__
+    lwcell_sys_notify_t notify_process; /*!< Processing thread wake-up notification */
+#else                                   /* LWCELL_CFG_THREAD_PROCESS_NOTIFY || __DOXYGEN__ */
     lwcell_sys_mbox_t mbox_process;     /*!< Consumer message queue handle */
+#endif                                  /* !(LWCELL_CFG_THREAD_PROCESS_NOTIFY || __DOXYGEN__) */
     lwcell_sys_thread_t thread_produce; /*!< Producer thread handle */
     lwcell_sys_thread_t thread_process; /*!< Processing thread handle */
 #if !LWCELL_CFG_INPUT_USE_PROCESS || __DOXYGEN__
-    lwcell_buff_t buff; /*!< Input processing buffer */
-#endif                  /* !LWCELL_CFG_INPUT_USE_PROCESS || __DOXYGEN__ */
-    lwcell_ll_t ll;     /*!< Low level functions */
+    lwcell_buff_t buff;                   /*!< Input processing buffer */
+    size_t buff_size;                     /*!< Input buffer size set by application, `0` for default */
+    lwcell_input_buff_stats_t buff_stats; /*!< Input buffer usage statistics */
+#if LWCELL_CFG_INPUT_BUFF_ATOMIC || __DOXYGEN__
+    atomic_uchar buff_notified; /*!< Processing thread is notified about new data in input buffer */
+#endif                          /* LWCELL_CFG_INPUT_BUFF_ATOMIC || __DOXYGEN__ */
+#endif                          /* !LWCELL_CFG_INPUT_USE_PROCESS || __DOXYGEN__ */
+    lwcell_ll_t ll;             /*!< Low level functions */
+#if LWCELL_CFG_RESET_FAST_BOOT || __DOXYGEN__
+    lwcell_device_identity_fn identity_fn; /*!< Persisted device identity callback function */
+    void* identity_arg;                    /*!< Custom argument for identity callback function */
+#endif                                     /* LWCELL_CFG_RESET_FAST_BOOT || __DOXYGEN__ */
+#if LWCELL_CFG_OPERATOR_CACHE || __DOXYGEN__
+    lwcell_operator_cache_fn operator_cache_fn; /*!< Cached operator callback function */
+    void* operator_cache_arg;                   /*!< Custom argument for cached operator callback function */
+    uint32_t operator_cache_num;                /*!< Last operator loaded or stored, `0` if unknown */
+#endif                                          /* LWCELL_CFG_OPERATOR_CACHE || __DOXYGEN__ */
 
     lwcell_msg_t* msg; /*!< Pointer to current user message being executed */
+#if !LWCELL_CFG_OS || __DOXYGEN__
+    lwcell_msg_t* poll_next; /*!< Next message taken from queue by \ref lwcell_poll, not started yet */
+    uint32_t poll_cmd_time;  /*!< Time when current message was started by \ref lwcell_poll */
+#endif                       /* !LWCELL_CFG_OS || __DOXYGEN__ */
+#if LWCELL_CFG_MSG_POOL_SIZE > 0 || __DOXYGEN__
+    lwcell_msg_pool_t msg_pool; /*!< Preallocated message pool */
+#endif                          /* LWCELL_CFG_MSG_POOL_SIZE > 0 || __DOXYGEN__ */
+#if LWCELL_CFG_CQ || __DOXYGEN__
+    struct lwcell_cq* cq_capture; /*!< Completion queue of batch being built, core is locked meanwhile */
+#endif                            /* LWCELL_CFG_CQ || __DOXYGEN__ */
+#if LWCELL_CFG_PRODUCER_ADMISSION || __DOXYGEN__
+    lwcell_producer_status_t admission; /*!< Producer queue admission state */
+#endif                                  /* LWCELL_CFG_PRODUCER_ADMISSION || __DOXYGEN__ */
 
     lwcell_evt_t evt;            /*!< Callback processing structure */
     lwcell_evt_func_t* evt_func; /*!< Callback function linked list */
-
-    lwcell_modules_t m; /*!< All modules. When resetting, reset structure */
+    lwcell_evt_mask_t evt_mask;  /*!< Union of subscription masks of all callback functions */
+#if LWCELL_CFG_EVT_DEFERRED || __DOXYGEN__
+    lwcell_sys_mbox_t mbox_evt;                                   /*!< Deferred event queue handle */
+    lwcell_sys_thread_t thread_evt;                               /*!< Event dispatch thread handle */
+    lwcell_evt_fn evt_deferred_fn[LWCELL_CFG_EVT_DEFERRED_FN_MAX]; /*!< Functions with deferred delivery */
+#endif /* LWCELL_CFG_EVT_DEFERRED || __DOXYGEN__ */
+#if LWCELL_CFG_FINE_LOCK || __DOXYGEN__
+    lwcell_sys_mutex_t evt_mutex; /*!< Mutex protecting callback function linked list */
+#if LWCELL_CFG_CONN || __DOXYGEN__
+    lwcell_sys_mutex_t conn_mutex[LWCELL_CFG_MAX_CONNS]; /*!< Mutexes protecting connection write buffer */
+#endif                                                  /* LWCELL_CFG_CONN || __DOXYGEN__ */
+#endif                                                  /* LWCELL_CFG_FINE_LOCK || __DOXYGEN__ */
+
+    lwcell_modules_t m;     /*!< All modules. When resetting, reset structure */
+    lwcell_parser_t parser; /*!< Input parser state */
+
+    /* Module states, kept over device reset */
+#if LWCELL_CFG_KEEP_ALIVE || __DOXYGEN__
+    lwcell_timeout_t keep_alive_timeout; /*!< Keep-alive timeout entry */
+#endif                                   /* LWCELL_CFG_KEEP_ALIVE || __DOXYGEN__ */
+#if LWCELL_CFG_CMD_TIMEOUT_ADAPT || __DOXYGEN__
+    lwcell_cmd_adapt_t cmd_adapt; /*!< Adaptive command timeout state */
+#endif                            /* LWCELL_CFG_CMD_TIMEOUT_ADAPT || __DOXYGEN__ */
+#if LWCELL_CFG_STATS || __DOXYGEN__
+    lwcell_cmd_stats_t cmd_stats; /*!< Command statistics */
+#endif                            /* LWCELL_CFG_STATS || __DOXYGEN__ */
+#if LWCELL_CFG_CONN || __DOXYGEN__
+    const struct lwcelli_conn_drv* conn_drv; /*!< Connection driver of identified device, `NULL` for `AT+CIP` */
+    lwcell_timeout_t conn_poll_timeout;      /*!< Connection poll timeout, shared by all connections */
+#if LWCELL_CFG_CONN_TX_WINDOW > 0 || __DOXYGEN__
+    lwcell_tx_window_t tx_window; /*!< Transmit window state */
+#endif                            /* LWCELL_CFG_CONN_TX_WINDOW > 0 || __DOXYGEN__ */
+#endif                            /* LWCELL_CFG_CONN || __DOXYGEN__ */
+#if (LWCELL_CFG_NETWORK && LWCELL_CFG_NETWORK_PDP_RECOVERY) || __DOXYGEN__
+    lwcell_pdp_recovery_t pdp; /*!< PDP context recovery state */
+#endif                         /* (LWCELL_CFG_NETWORK && LWCELL_CFG_NETWORK_PDP_RECOVERY) || __DOXYGEN__ */
+#if LWCELL_CFG_NETWORK_BAND || __DOXYGEN__
+    lwcell_band_mgr_t band; /*!< Band lock manager state */
+#endif                      /* LWCELL_CFG_NETWORK_BAND || __DOXYGEN__ */
+#if LWCELL_CFG_DNS || __DOXYGEN__
+    lwcell_dns_entry_t dns_cache[LWCELL_CFG_DNS_CACHE_SIZE]; /*!< Resolved hosts */
+#endif                                                       /* LWCELL_CFG_DNS || __DOXYGEN__ */
+#if LWCELL_CFG_PING || __DOXYGEN__
+    lwcell_ping_periodic_t ping; /*!< Periodic ping probe state */
+#endif                           /* LWCELL_CFG_PING || __DOXYGEN__ */
+#if LWCELL_CFG_CMUX || __DOXYGEN__
+    lwcell_cmux_t cmux; /*!< Multiplexer state */
+#endif                  /* LWCELL_CFG_CMUX || __DOXYGEN__ */
+#if LWCELL_CFG_PPP || __DOXYGEN__
+    lwcell_ppp_t ppp; /*!< PPP session */
+#endif                /* LWCELL_CFG_PPP || __DOXYGEN__ */
+#if LWCELL_CFG_PWR || __DOXYGEN__
+    lwcell_pwr_t pwr; /*!< Power management state */
+#endif                /* LWCELL_CFG_PWR || __DOXYGEN__ */
+#if LWCELL_CFG_SUPERVISOR || __DOXYGEN__
+    lwcell_sv_t sv; /*!< Supervisor state */
+#endif              /* LWCELL_CFG_SUPERVISOR || __DOXYGEN__ */
+#if (LWCELL_CFG_SNAPSHOT && LWCELL_CFG_CONN) || __DOXYGEN__
+    uint32_t snapshot_conns; /*!< Bit mask of connections restored from snapshot and not resumed yet */
+#endif                       /* (LWCELL_CFG_SNAPSHOT && LWCELL_CFG_CONN) || __DOXYGEN__ */
+#if LWCELL_CFG_TIME || __DOXYGEN__
+    lwcell_time_state_t time; /*!< Network time and location state */
+#endif                        /* LWCELL_CFG_TIME || __DOXYGEN__ */
+#if LWCELL_CFG_USAGE || __DOXYGEN__
+    lwcell_usage_state_t usage; /*!< Data usage accounting state */
+#endif                          /* LWCELL_CFG_USAGE || __DOXYGEN__ */
+#if LWCELL_CFG_METRICS || __DOXYGEN__
+    lwcell_metrics_state_t metrics; /*!< Metrics sampling state */
+#endif                              /* LWCELL_CFG_METRICS || __DOXYGEN__ */
+#if LWCELL_CFG_STATS_COUNTERS || __DOXYGEN__
+    lwcell_stats_counters_t stats; /*!< Throughput counters */
+#endif                             /* LWCELL_CFG_STATS_COUNTERS || __DOXYGEN__ */
+#if LWCELL_CFG_AT_PORT_TX_BUFF_SIZE > 0 || __DOXYGEN__
+    uint8_t at_tx_buff[LWCELL_CFG_AT_PORT_TX_BUFF_SIZE]; /*!< AT port transmit staging buffer */
+    size_t at_tx_len;                                    /*!< Number of bytes staged in \ref at_tx_buff */
+#endif                                                   /* LWCELL_CFG_AT_PORT_TX_BUFF_SIZE > 0 || __DOXYGEN__ */
 
     union {
         struct {
@@ -717,6 +1843,11 @@ typedef struct {
     uint8_t is_2g;               /*!< Status if modem is 2G */
     uint8_t is_lte;              /*!< Status if modem is LTE */
     uint8_t has_mqtt_native;     /*!< Status if modem supports native MQTT commands */
+    uint8_t has_http_sh;         /*!< Status if modem uses `AT+SH*` instead of `AT+HTTP*` commands for HTTP */
+    uint8_t has_quick_send;      /*!< Status if modem supports `AT+CIPQSEND` quick send mode */
+    uint8_t has_rxget;           /*!< Status if modem supports `AT+CIPRXGET` manual receive mode */
+    uint8_t has_ca_socket;       /*!< Status if modem supports `AT+CAOPEN` socket commands */
+    uint16_t max_send_len;       /*!< Maximal number of bytes in single `AT+CIPSEND` command */
 } lwcell_dev_model_map_t;
 
 /**
@@ -739,6 +1870,43 @@ extern const size_t lwcell_dev_mem_map_size;
 
 extern const lwcell_dev_model_map_t lwcell_dev_model_map[];
 extern const size_t lwcell_dev_model_map_size;
+extern const lwcell_dev_model_map_t lwcell_dev_model_unknown;
+
+/**
+ * \brief           Device models indexed by model, visible to every module
+ *                  to resolve capabilities at compile time when \ref LWCELL_CFG_DEVICE_MODEL is set
+ */
+static const lwcell_dev_model_map_t lwcelli_dev_model_fixed_map[] = {
+#define LWCELL_DEVICE_MODEL_ENTRY(name, str_id, is_2g, is_lte, has_mqtt_native, has_http_sh, has_quick_send,           \
+                                  has_rxget, has_ca_socket, max_send_len)                                              \
+    [LWCELL_DEVICE_MODEL_##name] = {LWCELL_DEVICE_MODEL_##name, str_id, is_2g, is_lte, has_mqtt_native, has_http_sh,   \
+                                    has_quick_send, has_rxget, has_ca_socket, max_send_len},
+#include "lwcell/lwcell_models.h"
+};
+
+/**
+ * \brief           Status if device model is fixed at compile time
+ */
+#define LWCELL_DEV_MODEL_IS_FIXED (LWCELL_CFG_DEVICE_MODEL != LWCELL_DEVICE_MODEL_UNKNOWN)
+
+/**
+ * \brief           Get capability of current device model
+ *
+ * With fixed device model, capability is a constant expression and
+ * unused paths for other models are removed by compiler.
+ * Unknown model at runtime uses \ref lwcell_dev_model_unknown entry
+ *
+ * \param[in]       cap: Member name of \ref lwcell_dev_model_map_t structure
+ */
+#define LWCELL_DEV_MODEL_CAP(cap)                                                                                      \
+    (LWCELL_DEV_MODEL_IS_FIXED                                                                                         \
+         ? lwcelli_dev_model_fixed_map[LWCELL_DEV_MODEL_IS_FIXED ? LWCELL_CFG_DEVICE_MODEL : 0].cap                    \
+         : lwcelli_dev_model_get()->cap)
+
+/**
+ * \brief           Status if connections use `AT+CAOPEN` socket commands instead of `AT+CIP*` commands
+ */
+#define LWCELL_CONN_IS_CA()         (LWCELL_CFG_CONN_CA_SOCKET && LWCELL_DEV_MODEL_CAP(has_ca_socket))
 
 #define CMD_IS_CUR(c)               (lwcell.msg != NULL && lwcell.msg->cmd == (c))
 #define CMD_IS_DEF(c)               (lwcell.msg != NULL && lwcell.msg->cmd_def == (c))
@@ -748,30 +1916,97 @@ extern const size_t lwcell_dev_model_map_size;
 #define CRLF                        "\r\n"
 #define CRLF_LEN                    2
 
+/* Locks for connection write buffer and global event list */
+#if LWCELL_CFG_FINE_LOCK
+#define LWCELL_CONN_LOCK(c)         lwcell_sys_mutex_lock(&lwcell.conn_mutex[(c) - lwcell.m.conns])
+#define LWCELL_CONN_UNLOCK(c)       lwcell_sys_mutex_unlock(&lwcell.conn_mutex[(c) - lwcell.m.conns])
+#define LWCELL_EVT_LOCK()           lwcell_sys_mutex_lock(&lwcell.evt_mutex)
+#define LWCELL_EVT_UNLOCK()         lwcell_sys_mutex_unlock(&lwcell.evt_mutex)
+#else /* LWCELL_CFG_FINE_LOCK */
+#define LWCELL_CONN_LOCK(c)         lwcell_core_lock()
+#define LWCELL_CONN_UNLOCK(c)       lwcell_core_unlock()
+#define LWCELL_EVT_LOCK()           lwcell_core_lock()
+#define LWCELL_EVT_UNLOCK()         lwcell_core_unlock()
+#endif /* !LWCELL_CFG_FINE_LOCK */
+
+#if LWCELL_CFG_EVT_DEFERRED
+#define LWCELL_EVT_DEFER(fn) lwcelli_evt_defer(fn)
+#else /* LWCELL_CFG_EVT_DEFERRED */
+#define LWCELL_EVT_DEFER(fn) 0
+#endif /* !LWCELL_CFG_EVT_DEFERRED */
+
+/* Wake-up processing thread, value is not important */
+#if !LWCELL_CFG_OS
+#define LWCELL_PROCESS_WAKEUP()     ((void)0) /* Application calls lwcell_poll from main loop */
+#elif LWCELL_CFG_THREAD_PROCESS_NOTIFY
+#define LWCELL_PROCESS_WAKEUP()     lwcell_sys_notify_post(&lwcell.notify_process)
+#else /* LWCELL_CFG_THREAD_PROCESS_NOTIFY */
+#define LWCELL_PROCESS_WAKEUP()     lwcell_sys_mbox_putnow(&lwcell.mbox_process, NULL)
+#endif /* !LWCELL_CFG_THREAD_PROCESS_NOTIFY */
+
+/* Wake-up processing thread from interrupt context */
+#if LWCELL_CFG_INPUT_FROM_ISR
+#if !LWCELL_CFG_OS
+#define LWCELL_PROCESS_WAKEUP_FROM_ISR() ((void)0)
+#elif LWCELL_CFG_THREAD_PROCESS_NOTIFY
+#define LWCELL_PROCESS_WAKEUP_FROM_ISR() lwcell_sys_notify_post_from_isr(&lwcell.notify_process)
+#else /* LWCELL_CFG_THREAD_PROCESS_NOTIFY */
+#define LWCELL_PROCESS_WAKEUP_FROM_ISR() lwcell_sys_mbox_putnow_from_isr(&lwcell.mbox_process, NULL)
+#endif /* !LWCELL_CFG_THREAD_PROCESS_NOTIFY */
+#endif /* LWCELL_CFG_INPUT_FROM_ISR */
+
+/* Throughput counters */
+#if LWCELL_CFG_STATS_COUNTERS
+#define LWCELL_STATS_ADD(f, v)      (lwcell.stats.f += (uint32_t)(v))
+#else /* LWCELL_CFG_STATS_COUNTERS */
+#define LWCELL_STATS_ADD(f, v)      ((void)(v)) /* Value may carry side effect, such as send call */
+#endif /* !LWCELL_CFG_STATS_COUNTERS */
+
+/* Message size with common header and single command family payload */
+#define LWCELL_MSG_SIZE_HDR         offsetof(lwcell_msg_t, msg)
+#define LWCELL_MSG_SIZE(member)     (LWCELL_MSG_SIZE_HDR + sizeof(((lwcell_msg_t*)0)->msg.member))
+
 #define LWCELL_MSG_VAR_DEFINE(name) lwcell_msg_t* name
-#define LWCELL_MSG_VAR_ALLOC(name, blocking)                                                                           \
+#define LWCELL_MSG_VAR_ALLOC(name, blocking) LWCELL_MSG_VAR_ALLOC_SZ(name, blocking, sizeof(lwcell_msg_t))
+#if LWCELL_CFG_MSG_POOL_SIZE > 0
+#define LWCELL_MSG_VAR_ALLOC_SZ(name, blocking, size)                                                                  \
+    do {                                                                                                               \
+        if (((name) = lwcelli_msg_alloc((blocking), (size))) == NULL) {                                                \
+            return lwcellERRMEM;                                                                                       \
+        }                                                                                                              \
+    } while (0)
+#define LWCELL_MSG_VAR_REF(name) (*(name))
+#define LWCELL_MSG_VAR_FREE(name)                                                                                      \
+    do {                                                                                                               \
+        lwcelli_msg_free(name);                                                                                        \
+        (name) = NULL;                                                                                                 \
+    } while (0)
+#else /* LWCELL_CFG_MSG_POOL_SIZE > 0 */
+#define LWCELL_MSG_VAR_ALLOC_SZ(name, blocking, size)                                                                  \
     do {                                                                                                               \
-        (name) = lwcell_mem_malloc(sizeof(*(name)));                                                                   \
+        (name) = lwcell_mem_malloc_tag(size, LWCELL_MEM_TAG_MSG);                                                      \
         LWCELL_DEBUGW(LWCELL_CFG_DBG_VAR | LWCELL_DBG_TYPE_TRACE, (name) != NULL,                                      \
-                      "[MSG VAR] Allocated %d bytes at %p\r\n", (int)sizeof(*(name)), (void*)(name));                  \
+                      "[MSG VAR] Allocated %d bytes at %p\r\n", (int)(size), (void*)(name));                           \
         LWCELL_DEBUGW(LWCELL_CFG_DBG_VAR | LWCELL_DBG_TYPE_TRACE, (name) == NULL,                                      \
-                      "[MSG VAR] Error allocating %d bytes\r\n", (int)sizeof(*(name)));                                \
+                      "[MSG VAR] Error allocating %d bytes\r\n", (int)(size));                                         \
         if ((name) == NULL) {                                                                                          \
             return lwcellERRMEM;                                                                                       \
         }                                                                                                              \
-        LWCELL_MEMSET((name), 0x00, sizeof(*(name)));                                                                  \
+        LWCELL_MEMSET((name), 0x00, (size));                                                                           \
         (name)->is_blocking = LWCELL_U8((blocking) > 0);                                                               \
     } while (0)
 #define LWCELL_MSG_VAR_REF(name) (*(name))
 #define LWCELL_MSG_VAR_FREE(name)                                                                                      \
     do {                                                                                                               \
         LWCELL_DEBUGF(LWCELL_CFG_DBG_VAR | LWCELL_DBG_TYPE_TRACE, "[MSG VAR] Free memory: %p\r\n", (void*)(name));     \
+        lwcell_timeout_stop(&((name)->park_to));                                                                       \
         if (lwcell_sys_sem_isvalid(&((name)->sem))) {                                                                  \
             lwcell_sys_sem_delete(&((name)->sem));                                                                     \
             lwcell_sys_sem_invalid(&((name)->sem));                                                                    \
         }                                                                                                              \
         lwcell_mem_free_s((void**)&(name));                                                                            \
     } while (0)
+#endif /* LWCELL_CFG_MSG_POOL_SIZE == 0 */
 #if LWCELL_CFG_USE_API_FUNC_EVT
 #define LWCELL_MSG_VAR_SET_EVT(name, e_fn, e_arg)                                                                      \
     do {                                                                                                               \
@@ -799,21 +2034,172 @@ extern const size_t lwcell_dev_model_map_size;
 
 const char* lwcelli_dbg_msg_to_string(lwcell_cmd_t cmd);
 lwcellr_t lwcelli_process(const void* data, size_t len);
+#if LWCELL_CFG_CMD_TIMEOUT_ADAPT || LWCELL_CFG_SUPERVISOR
+uint32_t lwcelli_input_get_total_len(void);
+#endif /* LWCELL_CFG_CMD_TIMEOUT_ADAPT || LWCELL_CFG_SUPERVISOR */
+#if !LWCELL_CFG_INPUT_USE_PROCESS
+size_t lwcelli_input_get_buff_size(void);
+#endif /* !LWCELL_CFG_INPUT_USE_PROCESS */
+#if LWCELL_CFG_INPUT_ZERO_COPY
+lwcellr_t lwcelli_process_ref(const void* data, size_t len, lwcell_pbuf_release_fn release_fn, void* arg);
+#endif /* LWCELL_CFG_INPUT_ZERO_COPY */
 lwcellr_t lwcelli_process_buffer(void);
 lwcellr_t lwcelli_initiate_cmd(lwcell_msg_t* msg);
+uint8_t lwcelli_urc_table_is_sorted(void);
 uint8_t lwcelli_is_valid_conn_ptr(lwcell_conn_p conn);
+#if LWCELL_CFG_CONN
+size_t lwcelli_conn_send_chunk_len(lwcell_conn_t* c);
+#endif /* LWCELL_CFG_CONN */
 lwcellr_t lwcelli_send_cb(lwcell_evt_type_t type);
 lwcellr_t lwcelli_send_conn_cb(lwcell_conn_t* conn, lwcell_evt_fn cb);
+#if LWCELL_CFG_EVT_DEFERRED
+uint8_t lwcelli_evt_defer(lwcell_evt_fn fn);
+#endif /* LWCELL_CFG_EVT_DEFERRED */
+#if LWCELL_CFG_MQTT
+lwcellr_t lwcelli_send_mqtt_cb(lwcell_evt_type_t type);
+#endif /* LWCELL_CFG_MQTT */
 void lwcelli_conn_init(void);
+#if LWCELL_CFG_MSG_POOL_SIZE > 0
+lwcell_msg_t* lwcelli_msg_alloc(uint32_t blocking, size_t size);
+void lwcelli_msg_free(lwcell_msg_t* msg);
+#endif /* LWCELL_CFG_MSG_POOL_SIZE > 0 */
+#if LWCELL_CFG_STATS
+void lwcelli_stats_cmd_dequeued(void);
+void lwcelli_stats_cmd_started(void);
+void lwcelli_stats_parse_time(uint32_t time);
+void lwcelli_stats_cmd_finished(const lwcell_msg_t* msg, lwcellr_t res);
+void lwcelli_stats_get_totals(uint32_t* count, uint32_t* errors, uint32_t* turnaround);
+#endif /* LWCELL_CFG_STATS */
 lwcellr_t lwcelli_send_msg_to_producer_mbox(lwcell_msg_t* msg, lwcellr_t (*process_fn)(lwcell_msg_t*),
                                             uint32_t max_block_time);
+#if LWCELL_CFG_PRODUCER_ADMISSION
+void lwcelli_producer_release(lwcell_msg_t* msg);
+#endif /* LWCELL_CFG_PRODUCER_ADMISSION */
+#if LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0
+void lwcelli_producer_prio_wakeup(void);
+#endif /* LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0 */
 uint32_t lwcelli_get_from_mbox_with_timeout_checks(lwcell_sys_mbox_t* b, void** m, uint32_t timeout);
+#if LWCELL_CFG_KEEP_ALIVE
+void lwcelli_keep_alive_update(void);
+#endif /* LWCELL_CFG_KEEP_ALIVE */
+#if LWCELL_CFG_THREAD_PROCESS_NOTIFY
+uint32_t lwcelli_wait_notify_with_timeout_checks(lwcell_sys_notify_t* n, uint32_t timeout);
+#endif /* LWCELL_CFG_THREAD_PROCESS_NOTIFY */
+#if !LWCELL_CFG_OS
+uint32_t lwcelli_timeout_poll(void);
+#endif /* !LWCELL_CFG_OS */
+const lwcell_dev_model_map_t* lwcelli_dev_model_get(void);
 uint8_t lwcelli_conn_closed_process(uint8_t conn_num, uint8_t forced);
+#if LWCELL_CFG_CONN_SERVER || __DOXYGEN__
+uint8_t lwcelli_conn_server_accept(const char* str);
+#endif /* LWCELL_CFG_CONN_SERVER || __DOXYGEN__ */
 void lwcelli_conn_start_timeout(lwcell_conn_p conn);
+#if LWCELL_CFG_CONN_SEND_FAIR
+void lwcelli_conn_send_queued(lwcell_msg_t* msg, uint8_t queued);
+uint8_t lwcelli_conn_send_requeue(lwcell_msg_t* msg);
+#endif /* LWCELL_CFG_CONN_SEND_FAIR */
+#if LWCELL_CFG_CONN_SEND_DEADLINE
+void lwcelli_conn_send_track(lwcell_msg_t* msg, uint8_t track);
+uint8_t lwcelli_conn_send_is_stale(const lwcell_msg_t* msg);
+#endif /* LWCELL_CFG_CONN_SEND_DEADLINE */
+#if LWCELL_CFG_CONN_TX_WINDOW > 0
+uint8_t lwcelli_conn_tx_window_defer(lwcell_msg_t* msg);
+void lwcelli_conn_tx_window_activity(void);
+void lwcelli_conn_tx_window_done(lwcell_msg_t* msg);
+#endif /* LWCELL_CFG_CONN_TX_WINDOW > 0 */
+#if LWCELL_CFG_CONN_WRITE_RING
+void lwcelli_conn_write_ring_sent(lwcell_msg_t* msg);
+#endif /* LWCELL_CFG_CONN_WRITE_RING */
+#if LWCELL_CFG_CONN_MANUAL_RECV
+lwcellr_t lwcelli_conn_manual_recv_read(lwcell_conn_p conn);
+void lwcelli_conn_rx_dev_len_set(lwcell_conn_p conn, size_t len);
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV */
+#if LWCELL_CFG_PBUF_POOL
+size_t lwcelli_pbuf_pool_free_len(void);
+#endif /* LWCELL_CFG_PBUF_POOL */
+#if LWCELL_CFG_STATIC_ALLOC
+void lwcelli_mem_pool_report(void);
+#endif /* LWCELL_CFG_STATIC_ALLOC */
+#if LWCELL_CFG_CQ
+lwcellr_t lwcelli_cq_add(struct lwcell_cq* cq, lwcell_msg_t* msg);
+void lwcelli_cq_complete(lwcell_msg_t* msg);
+#endif /* LWCELL_CFG_CQ */
+#if LWCELL_CFG_PING
+void lwcelli_ping_run_finished(lwcell_msg_t* msg, lwcellr_t res);
+#endif /* LWCELL_CFG_PING */
+#if LWCELL_CFG_DNS
+const lwcell_ip_t* lwcelli_dns_cache_get(const char* host);
+void lwcelli_dns_cache_failed(const char* host);
+uint8_t lwcelli_dns_resolve_cached(lwcell_msg_t* msg);
+void lwcelli_dns_resolve_finished(lwcell_msg_t* msg, uint8_t is_ok);
+#endif /* LWCELL_CFG_DNS */
+#if LWCELL_CFG_SMS_INBOX
+void lwcelli_sms_inbox_notify(lwcell_mem_t mem);
+#endif /* LWCELL_CFG_SMS_INBOX */
+#if LWCELL_CFG_PHONEBOOK_MIRROR
+void lwcelli_pb_mirror_reset(lwcell_mem_t mem, size_t total);
+uint8_t lwcelli_pb_mirror_put(const lwcell_pb_entry_t* entry);
+void lwcelli_pb_mirror_entry_written(lwcell_mem_t mem, const lwcell_pb_entry_t* entry);
+size_t lwcelli_pb_mirror_free_pos(lwcell_mem_t mem);
+const lwcell_pb_entry_t* lwcelli_pb_mirror_lookup(const char* num);
+void lwcelli_pb_mirror_write_finished(lwcell_msg_t* msg, uint8_t is_ok);
+#endif /* LWCELL_CFG_PHONEBOOK_MIRROR */
+#if LWCELL_CFG_TIME
+void lwcelli_time_set(const struct tm* dt, int8_t tz, uint8_t is_local);
+void lwcelli_time_tz_set(int8_t tz);
+void lwcelli_time_location_set(int32_t lat, int32_t lon);
+#endif /* LWCELL_CFG_TIME */
+#if LWCELL_CFG_CMUX
+uint8_t lwcelli_cmux_input(const void* data, size_t len);
+void lwcelli_cmux_enter(void);
+void lwcelli_cmux_reset(void);
+#endif /* LWCELL_CFG_CMUX */
+#if LWCELL_CFG_PPP
+uint8_t lwcelli_ppp_input(const void* data, size_t len);
+uint8_t lwcelli_ppp_blocks_commands(void);
+void lwcelli_ppp_connected(void);
+void lwcelli_ppp_dial_finished(uint8_t is_ok);
+void lwcelli_ppp_reset(void);
+#if LWCELL_CFG_CMUX
+uint8_t lwcelli_ppp_channel_input(uint8_t dlci, const void* data, size_t len);
+#endif /* LWCELL_CFG_CMUX */
+#endif /* LWCELL_CFG_PPP */
+#if LWCELL_CFG_PWR
+void lwcelli_pwr_wake(void);
+void lwcelli_pwr_cmd_done(void);
+void lwcelli_pwr_sleep_configured(lwcell_msg_t* msg, uint8_t is_ok);
+void lwcelli_pwr_reset(void);
+#endif /* LWCELL_CFG_PWR */
+#if LWCELL_CFG_SNAPSHOT && LWCELL_CFG_CONN
+void lwcelli_snapshot_conns_resume(void);
+#endif /* LWCELL_CFG_SNAPSHOT && LWCELL_CFG_CONN */
+#if LWCELL_CFG_USAGE
+void lwcelli_usage_add(lwcell_conn_p conn, size_t len, uint8_t is_tx);
+uint8_t lwcelli_usage_is_throttled(lwcell_conn_p conn);
+#endif /* LWCELL_CFG_USAGE */
+#if LWCELL_CFG_SUPERVISOR
+void lwcelli_supervisor_start(void);
+void lwcelli_supervisor_cmd_finished(const lwcell_msg_t* msg);
+#endif /* LWCELL_CFG_SUPERVISOR */
+#if LWCELL_CFG_METRICS
+void lwcelli_metrics_start(void);
+#endif /* LWCELL_CFG_METRICS */
+#if LWCELL_CFG_NETWORK_PDP_RECOVERY
+void lwcelli_network_pdp_deact(void);
+uint8_t lwcelli_network_pdp_hold(lwcell_msg_t* msg);
+void lwcelli_network_pdp_reset(void);
+#endif /* LWCELL_CFG_NETWORK_PDP_RECOVERY */
+
+#if LWCELL_CFG_CALL && LWCELL_CFG_CALL_AUTO_ANSWER > 0
+lwcellr_t lwcelli_call_auto_answer(void);
+#endif /* LWCELL_CFG_CALL && LWCELL_CFG_CALL_AUTO_ANSWER > 0 */
 
 lwcellr_t lwcelli_get_sim_info(const uint32_t blocking);
 
 void lwcelli_reset_everything(uint8_t forced);
+uint8_t lwcelli_cmd_park(lwcell_msg_t* msg, uint32_t time);
+void lwcelli_cmd_unpark(lwcell_msg_t* msg);
+void lwcelli_cmd_park_cancel(lwcell_msg_t* msg);
 void lwcelli_process_events_for_timeout_or_error(lwcell_msg_t* msg, lwcellr_t err);
 
 /**
@@ -0,0 +1,85 @@
+/**
+ * \file            lwcell_pwr.h
+ * \brief           Power saving modes manager
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_PWR_HDR_H
+#define LWCELL_PWR_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_PWR Power manager
+ * \brief           PSM, eDRX and modem sleep control
+ * \{
+ *
+ * Power manager configures network power saving modes and tracks modem sleep state.
+ * When sleep is enabled with \ref lwcell_pwr_sleep_set, modem is woken up before producer thread
+ * sends next command and is put back to sleep after \ref LWCELL_CFG_PWR_IDLE_TIME of command inactivity.
+ * Commands queued meanwhile are executed in the same wake window.
+ *
+ * In \ref LWCELL_PWR_SLEEP_DTR mode, \ref lwcell_ll_t::sleep_fn callback drives modem DTR pin.
+ * In \ref LWCELL_PWR_SLEEP_AUTO mode, modem enters sleep itself when UART is idle
+ * and is woken up with dummy `AT` command.
+ */
+
+/**
+ * \brief           Modem sleep mode, `AT+CSCLK` parameter
+ */
+typedef enum {
+    LWCELL_PWR_SLEEP_DISABLE = 0x00, /*!< Sleep mode is disabled */
+    LWCELL_PWR_SLEEP_DTR = 0x01,     /*!< Modem sleeps when DTR is high, requires \ref lwcell_ll_t::sleep_fn */
+    LWCELL_PWR_SLEEP_AUTO = 0x02,    /*!< Modem sleeps automatically when UART is idle */
+} lwcell_pwr_sleep_t;
+
+lwcellr_t lwcell_pwr_psm_set(uint8_t enable, const char* tau, const char* active_time,
+                             const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_pwr_edrx_set(uint8_t enable, uint8_t act_type, const char* cycle, const lwcell_api_cmd_evt_fn evt_fn,
+                              void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_pwr_sleep_set(lwcell_pwr_sleep_t mode, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                               const uint32_t blocking);
+lwcellr_t lwcell_pwr_radio_release(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+uint8_t lwcell_pwr_is_asleep(void);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_PWR_HDR_H */
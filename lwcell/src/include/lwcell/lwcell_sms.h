@@ -52,6 +52,10 @@ lwcellr_t lwcell_sms_disable(const lwcell_api_cmd_evt_fn evt_fn, void* const evt
 
 lwcellr_t lwcell_sms_send(const char* num, const char* text, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
                           const uint32_t blocking);
+lwcellr_t lwcell_sms_send_pdu(const char* num, const void* data, size_t len, lwcell_sms_dcs_t dcs,
+                              const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_sms_send_batch(lwcell_sms_batch_entry_t* entries, size_t entries_len,
+                                const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
 lwcellr_t lwcell_sms_read(lwcell_mem_t mem, size_t pos, lwcell_sms_entry_t* entry, uint8_t update,
                           const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
 lwcellr_t lwcell_sms_delete(lwcell_mem_t mem, size_t pos, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
@@ -61,9 +65,16 @@ lwcellr_t lwcell_sms_delete_all(lwcell_sms_status_t status, const lwcell_api_cmd
 lwcellr_t lwcell_sms_list(lwcell_mem_t mem, lwcell_sms_status_t stat, lwcell_sms_entry_t* entries, size_t etr,
                           size_t* er, uint8_t update, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
                           const uint32_t blocking);
+lwcellr_t lwcell_sms_list_iter(lwcell_mem_t mem, lwcell_sms_status_t stat, lwcell_sms_entry_t* entry,
+                               lwcell_sms_list_fn entry_fn, void* entry_arg, size_t* er, uint8_t update,
+                               const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
 lwcellr_t lwcell_sms_set_preferred_storage(lwcell_mem_t mem1, lwcell_mem_t mem2, lwcell_mem_t mem3,
                                            const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
                                            const uint32_t blocking);
+#if LWCELL_CFG_SMS_INBOX || __DOXYGEN__
+lwcellr_t lwcell_sms_inbox_enable(lwcell_sms_list_fn entry_fn, void* entry_arg);
+lwcellr_t lwcell_sms_inbox_disable(void);
+#endif /* LWCELL_CFG_SMS_INBOX || __DOXYGEN__ */
 
 /**
  * \}
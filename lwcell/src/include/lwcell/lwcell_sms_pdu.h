@@ -0,0 +1,78 @@
+/**
+ * \file            lwcell_sms_pdu.h
+ * \brief           SMS PDU encoder and decoder
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_SMS_PDU_HDR_H
+#define LWCELL_SMS_PDU_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL_SMS
+ * \defgroup        LWCELL_SMS_PDU SMS PDU mode
+ * \brief           SMS PDU encoder and decoder
+ * \{
+ *
+ * PDU mode gives access to all data coding schemes of SMS:
+ *
+ *  - GSM 7-bit default alphabet with extension table, `160` characters in single message
+ *  - 8-bit binary data, `140` bytes in single message
+ *  - UCS2 for text outside GSM alphabet, `70` characters in single message
+ *
+ * Longer messages are sent as concatenated SMS, each part carries `6` bytes long user data header.
+ * Text is exchanged with application in UTF-8 format for GSM 7-bit and UCS2 schemes.
+ */
+
+/**
+ * \brief           Maximal length of SMS PDU in units of bytes, including service center address
+ */
+#define LWCELL_SMS_PDU_MAX_LEN 176
+
+size_t lwcell_sms_pdu_part_len(lwcell_sms_dcs_t dcs, const void* data, size_t len, uint8_t concat);
+size_t lwcell_sms_pdu_parts(lwcell_sms_dcs_t dcs, const void* data, size_t len);
+size_t lwcell_sms_pdu_encode(uint8_t* pdu, size_t pdu_size, const char* num, lwcell_sms_dcs_t dcs, const void* data,
+                             size_t len, const lwcell_sms_concat_t* concat);
+lwcellr_t lwcell_sms_pdu_decode(const char* hex, size_t hex_len, lwcell_sms_pdu_t* sms);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_SMS_PDU_HDR_H */
@@ -0,0 +1,76 @@
+/**
+ * \file            lwcell_snapshot.h
+ * \brief           Warm-restart snapshot API
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_SNAPSHOT_HDR_H
+#define LWCELL_SNAPSHOT_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_SNAPSHOT Warm-restart snapshot API
+ * \brief           Save and restore stack state across MCU deep sleep
+ * \{
+ *
+ * Device stays powered, registered and attached while MCU is in deep sleep and loses its RAM.
+ * Before sleep, application saves stack state with \ref lwcell_snapshot_save to retained memory.
+ * After wake-up, \ref lwcell_init is followed by \ref lwcell_snapshot_restore instead of \ref lwcell_reset.
+ *
+ * Restore applies saved identity, SIM, network, SMS and phonebook state and active connections,
+ * then resynchronizes it with device using `AT+CPIN?`, `AT+CREG?` and `AT+CIPSTATUS` queries.
+ * Changes since snapshot are reported with regular events.
+ * When device does not respond or snapshot is not valid, application shall call \ref lwcell_reset.
+ *
+ * Restored connections report \ref LWCELL_EVT_CONN_ACTIVE to connection callback
+ * once resynchronization finishes. Connections closed in the meantime report \ref LWCELL_EVT_CONN_CLOSE.
+ *
+ * \note            Netconn and application layer objects are not part of snapshot
+ */
+
+lwcellr_t lwcell_snapshot_save(lwcell_snapshot_t* snap);
+lwcellr_t lwcell_snapshot_restore(const lwcell_snapshot_t* snap, lwcell_evt_fn conn_evt_fn,
+                                  const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_SNAPSHOT_HDR_H */
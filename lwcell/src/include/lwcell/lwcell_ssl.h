@@ -0,0 +1,79 @@
+/**
+ * \file            lwcell_ssl.h
+ * \brief           SSL configuration API
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_SSL_HDR_H
+#define LWCELL_SSL_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_SSL SSL configuration
+ * \brief           SSL certificates and context configuration
+ * \{
+ *
+ * Certificates are stored to device file system with `AT+CFSWFILE` command
+ * and converted to SSL context with `AT+CSSLCFG` command.
+ * Both are kept in non-volatile memory of device, hence upload and conversion are one-time operations,
+ * needed only when certificates change. \ref lwcell_ssl_file_sync compares digest of certificate
+ * with the one of installed file and skips upload when they are equal.
+ *
+ * File is streamed in chunks of \ref LWCELL_CFG_SSL_FILE_CHUNK_LEN bytes,
+ * read from application with \ref lwcell_ssl_read_fn callback,
+ * so that certificate does not need to be present in RAM as a whole.
+ *
+ * \note            Supported on `SIM7070` family. Configured context is used by MQTT
+ *                  when \ref lwcell_mqtt_conn_desc_t.ssl is set
+ */
+
+lwcellr_t lwcell_ssl_file_upload(const char* name, size_t len, lwcell_ssl_read_fn read_fn, void* read_arg,
+                                 const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_ssl_file_sync(const char* name, size_t len, lwcell_ssl_read_fn read_fn, void* read_arg,
+                               uint8_t* uploaded, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                               const uint32_t blocking);
+lwcellr_t lwcell_ssl_config(const lwcell_ssl_cfg_t* cfg, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                            const uint32_t blocking);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_SSL_HDR_H */
@@ -0,0 +1,129 @@
+/**
+ * \file            lwcell_stats.h
+ * \brief           Command latency statistics and throughput counters
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_STATS_HDR_H
+#define LWCELL_STATS_HDR_H
+
+#include "lwcell/lwcell_types.h"
+#include "system/lwcell_sys.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_STATS Statistics
+ * \brief           Command latency statistics and throughput counters
+ * \{
+ */
+
+/**
+ * \brief           Measured phases of command execution
+ */
+typedef enum {
+    LWCELL_STATS_PHASE_QUEUE,      /*!< Time from API call until producer thread takes command from queue */
+    LWCELL_STATS_PHASE_TURNAROUND, /*!< Time from start of transmission to device until command finishes */
+    LWCELL_STATS_PHASE_PARSE,      /*!< Time spent in parsing received data while command is active */
+    LWCELL_STATS_PHASE_END,        /*!< Number of phases, used internally */
+} lwcell_stats_phase_t;
+
+/**
+ * \brief           Latency data for single phase
+ */
+typedef struct {
+    uint32_t min; /*!< Minimal time in units of milliseconds */
+    uint32_t max; /*!< Maximal time in units of milliseconds */
+    uint32_t sum; /*!< Sum of all times in units of milliseconds */
+    uint32_t hist[LWCELL_CFG_STATS_HIST_BUCKETS]; /*!< Histogram, see \ref LWCELL_CFG_STATS_HIST_BUCKETS */
+} lwcell_stats_phase_data_t;
+
+/**
+ * \brief           Statistics for single command type
+ */
+typedef struct {
+    uint32_t cmd;      /*!< Internal command identifier, as printed by debug output */
+    uint32_t count;    /*!< Number of finished commands */
+    uint32_t errors;   /*!< Number of commands finished with error, excluding timeouts */
+    uint32_t timeouts; /*!< Number of commands finished with timeout */
+    lwcell_stats_phase_data_t phase[LWCELL_STATS_PHASE_END]; /*!< Latency data per phase */
+} lwcell_stats_t;
+
+/**
+ * \brief           Byte and event throughput counters
+ */
+typedef struct {
+    uint32_t rx_bytes;            /*!< Number of bytes received from device */
+    uint32_t rx_calls;            /*!< Number of calls to input functions */
+    uint32_t tx_bytes;            /*!< Number of bytes sent to device */
+    uint32_t lines;               /*!< Number of parsed response lines, excluding empty ones */
+    uint32_t urc_lines;           /*!< Number of parsed lines handled as `+` unsolicited result code */
+    uint32_t pbuf_alloc_failed;   /*!< Number of failed packet buffer allocations for received connection data */
+    uint32_t ipd_dropped_bytes;   /*!< Number of received connection data bytes discarded by library */
+    uint32_t mbox_full;           /*!< Number of non-blocking commands rejected because of full producer queue */
+    uint32_t line_overflows;      /*!< Number of received lines longer than \ref LWCELL_CFG_RCV_LINE_SIZE */
+    uint32_t line_overflow_bytes; /*!< Number of received line characters, which did not fit to line buffer */
+    uint32_t echo_lines;          /*!< Number of command echo lines skipped without parsing */
+    uint32_t evt[LWCELL_EVT_END]; /*!< Number of events sent to application, indexed by \ref lwcell_evt_type_t */
+#if LWCELL_CFG_CONN || __DOXYGEN__
+    uint32_t conn_rx_bytes[LWCELL_CFG_MAX_CONNS]; /*!< Number of data bytes received, indexed by connection number */
+    uint32_t conn_tx_bytes[LWCELL_CFG_MAX_CONNS]; /*!< Number of data bytes sent, indexed by connection number */
+#endif /* LWCELL_CFG_CONN || __DOXYGEN__ */
+} lwcell_stats_counters_t;
+
+/**
+ * \brief           Library threads reported by \ref lwcell_stats_get_thread
+ */
+typedef enum {
+    LWCELL_STATS_THREAD_PRODUCE, /*!< Producer thread, sending commands to device */
+    LWCELL_STATS_THREAD_PROCESS, /*!< Processing thread, parsing received data */
+    LWCELL_STATS_THREAD_EVT,     /*!< Event dispatch thread, available with \ref LWCELL_CFG_EVT_DEFERRED */
+} lwcell_stats_thread_t;
+
+uint8_t lwcell_stats_get(size_t index, lwcell_stats_t* stats);
+void lwcell_stats_reset(void);
+lwcellr_t lwcell_stats_get_counters(lwcell_stats_counters_t* counters);
+void lwcell_stats_reset_counters(void);
+#if LWCELL_CFG_STATS_THREADS || __DOXYGEN__
+lwcellr_t lwcell_stats_get_thread(lwcell_stats_thread_t thread, lwcell_sys_thread_info_t* info);
+#endif /* LWCELL_CFG_STATS_THREADS || __DOXYGEN__ */
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_STATS_HDR_H */
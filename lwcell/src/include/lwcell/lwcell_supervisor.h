@@ -0,0 +1,86 @@
+/**
+ * \file            lwcell_supervisor.h
+ * \brief           Modem health supervisor
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_SUPERVISOR_HDR_H
+#define LWCELL_SUPERVISOR_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_SUPERVISOR Modem health supervisor
+ * \brief           Fault detection and tiered recovery of modem link
+ * \{
+ *
+ * Supervisor checks modem health every \ref LWCELL_CFG_SUPERVISOR_INTERVAL milliseconds.
+ * Following faults are detected:
+ *
+ *  - Device does not respond: \ref LWCELL_CFG_SUPERVISOR_TIMEOUTS consecutive command timeouts.
+ *      When nothing is received for \ref LWCELL_CFG_SUPERVISOR_RX_SILENCE milliseconds,
+ *      device is probed with `AT` command and probe timeout counts as command timeout
+ *  - Network registration is lost for \ref LWCELL_CFG_SUPERVISOR_REG_LOSS milliseconds
+ *  - PDP context is lost while registered, when credentials are set with \ref lwcell_supervisor_set_credentials
+ *
+ * Recovery starts with the cheapest action that may help and escalates when fault remains:
+ *
+ *  - Device does not respond: `AT` probe, then device reset
+ *  - Data link lost: network reattach, with `AT+CIPSHUT` as part of attach sequence
+ *  - Registration lost: `AT+CFUN=0` and `AT+CFUN=1` cycle, then device reset.
+ *      Reset uses \ref lwcell_ll_t::reset_fn hardware reset when low-level driver provides it
+ *
+ * \ref LWCELL_EVT_SUPERVISOR event is sent when recovery action starts and when device recovered.
+ * Recovery times are available with \ref lwcell_supervisor_get_stats.
+ *
+ * \note            Supervisor replaces probing of \ref LWCELL_CFG_CMD_STALL_PROBES,
+ *                  which must be set to `0` when \ref LWCELL_CFG_CMD_TIMEOUT_ADAPT is used
+ */
+
+#if LWCELL_CFG_NETWORK || __DOXYGEN__
+lwcellr_t lwcell_supervisor_set_credentials(const char* apn, const char* user, const char* pass);
+#endif /* LWCELL_CFG_NETWORK || __DOXYGEN__ */
+lwcell_supervisor_tier_t lwcell_supervisor_get_tier(void);
+lwcellr_t lwcell_supervisor_get_stats(lwcell_supervisor_stats_t* stats);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_SUPERVISOR_HDR_H */
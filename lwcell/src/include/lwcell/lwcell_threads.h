@@ -40,8 +40,11 @@
 extern "C" {
 #endif /* __cplusplus */
 
+#if LWCELL_CFG_OS
 void lwcell_thread_produce(void* const arg);
 void lwcell_thread_process(void* const arg);
+void lwcell_thread_evt(void* const arg);
+#endif /* LWCELL_CFG_OS */
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,75 @@
+/**
+ * \file            lwcell_time.h
+ * \brief           Network time and cell location API
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_TIME_HDR_H
+#define LWCELL_TIME_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_TIME Network time and cell location
+ * \brief           Network time and cell location cache
+ * \{
+ *
+ * Network time is captured passively, from `*PSUTTZ` and `+CTZV` reports
+ * sent by device when network provides time (NITZ), and from any `+CCLK` reply.
+ * Time is stored together with system time of capture, hence \ref lwcell_time_get
+ * returns current time from cache, without command to device.
+ *
+ * When network does not provide time, \ref lwcell_time_sync reads device clock
+ * and \ref lwcell_time_location_update reads time and approximate location from cell location service.
+ *
+ * \note            Cache is kept across device resets. System time must not wrap more than once
+ *                  between two calls to \ref lwcell_time_get, which is approximately `49` days
+ */
+
+lwcellr_t lwcell_time_get(struct tm* dt, int8_t* tz);
+lwcellr_t lwcell_time_location_get(lwcell_location_t* loc);
+lwcellr_t lwcell_time_sync(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking);
+lwcellr_t lwcell_time_location_update(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                                      const uint32_t blocking);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_TIME_HDR_H */
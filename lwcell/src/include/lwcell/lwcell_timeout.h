@@ -49,6 +49,10 @@ extern "C" {
 
 lwcellr_t lwcell_timeout_add(uint32_t time, lwcell_timeout_fn fn, void* arg);
 lwcellr_t lwcell_timeout_remove(lwcell_timeout_fn fn);
+lwcellr_t lwcell_timeout_start(lwcell_timeout_t* to, uint32_t time, lwcell_timeout_fn fn, void* arg);
+lwcellr_t lwcell_timeout_stop(lwcell_timeout_t* to);
+uint8_t lwcell_timeout_is_active(const lwcell_timeout_t* to);
+uint32_t lwcell_timeout_get_next_diff(void);
 
 /**
  * \}
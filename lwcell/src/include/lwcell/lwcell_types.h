@@ -83,6 +83,8 @@ typedef enum {
     lwcellERRWIFINOTCONNECTED, /*!< Wifi not connected to access point */
     lwcellERRNODEVICE,         /*!< Device is not present */
     lwcellERRBLOCKING,         /*!< Blocking mode command is not allowed */
+    lwcellERRQUOTA,            /*!< Data quota reached, connection is throttled */
+    lwcellERRSTALE,            /*!< Queued data dropped after deadline passed or send was cancelled */
 } lwcellr_t;
 
 /**
@@ -91,7 +93,9 @@ typedef enum {
  */
 typedef enum {
 
-#define LWCELL_DEVICE_MODEL_ENTRY(name, str_id, is_2g, is_lte, has_mqtt_native) LWCELL_DEVICE_MODEL_##name,
+#define LWCELL_DEVICE_MODEL_ENTRY(name, str_id, is_2g, is_lte, has_mqtt_native, has_http_sh, has_quick_send,           \
+                                  has_rxget, has_ca_socket, max_send_len)                                              \
+    LWCELL_DEVICE_MODEL_##name,
 #include "lwcell/lwcell_models.h"
     LWCELL_DEVICE_MODEL_END,     /*!< End of device model */
     LWCELL_DEVICE_MODEL_UNKNOWN, /*!< Unknown device model */
@@ -144,6 +148,38 @@ typedef enum {
     LWCELL_CONN_TYPE_SSL, /*!< Connection type is TCP over SSL */
 } lwcell_conn_type_t;
 
+/**
+ * \ingroup         LWCELL_TYPES
+ * \brief           Connection state, as reported by `AT+CIPSTATUS` connection line
+ */
+typedef enum {
+    LWCELL_CONN_STATE_UNKNOWN = 0x00, /*!< State not reported yet */
+    LWCELL_CONN_STATE_INITIAL,        /*!< `INITIAL`, connection is not used */
+    LWCELL_CONN_STATE_CONNECTING,     /*!< `CONNECTING`, connection start in progress */
+    LWCELL_CONN_STATE_CONNECTED,      /*!< `CONNECTED`, connection is active */
+    LWCELL_CONN_STATE_REMOTE_CLOSING, /*!< `REMOTE CLOSING`, remote side started closing */
+    LWCELL_CONN_STATE_CLOSING,        /*!< `CLOSING`, local side started closing */
+    LWCELL_CONN_STATE_CLOSED,         /*!< `CLOSED`, connection is closed */
+} lwcell_conn_state_t;
+
+/**
+ * \ingroup         LWCELL_TYPES
+ * \anchor          LWCELL_CONN_CHANGED
+ * \name            Connection status change flags
+ * \brief           Flags used with \ref LWCELL_EVT_CONN_STATUS_CHANGED event
+ * \{
+ */
+
+#define LWCELL_CONN_CHANGED_STATE       0x01 /*!< Connection state changed */
+#define LWCELL_CONN_CHANGED_TYPE        0x02 /*!< Connection type changed */
+#define LWCELL_CONN_CHANGED_REMOTE_IP   0x04 /*!< Remote IP address changed */
+#define LWCELL_CONN_CHANGED_REMOTE_PORT 0x08 /*!< Remote port changed */
+#define LWCELL_CONN_CHANGED_BEARER      0x10 /*!< Bearer changed */
+
+/**
+ * \}
+ */
+
 /**
  * \ingroup         LWCELL_TYPES
  * \brief           Available device memories
@@ -196,6 +232,84 @@ typedef struct {
     size_t length;              /*!< Length of SMS data */
 } lwcell_sms_entry_t;
 
+/**
+ * \ingroup         LWCELL_SMS_PDU
+ * \brief           SMS data coding scheme for PDU mode
+ */
+typedef enum {
+    LWCELL_SMS_DCS_GSM7 = 0x00, /*!< GSM 7-bit default alphabet, application data are UTF-8 text */
+    LWCELL_SMS_DCS_8BIT = 0x04, /*!< 8-bit binary data */
+    LWCELL_SMS_DCS_UCS2 = 0x08, /*!< UCS2 alphabet, application data are UTF-8 text */
+} lwcell_sms_dcs_t;
+
+/**
+ * \ingroup         LWCELL_SMS_PDU
+ * \brief           Concatenated SMS part information
+ */
+typedef struct {
+    uint16_t ref;  /*!< Reference number, same for all parts of single message */
+    uint8_t total; /*!< Total number of parts, `0` for message which is not concatenated */
+    uint8_t seq;   /*!< Sequence number of this part, starting with `1` */
+} lwcell_sms_concat_t;
+
+/**
+ * \ingroup         LWCELL_SMS_PDU
+ * \brief           Decoded SMS-DELIVER PDU
+ */
+typedef struct {
+    char number[26];            /*!< Originating address */
+    struct tm dt;               /*!< Service center time stamp */
+    lwcell_sms_dcs_t dcs;       /*!< Data coding scheme of message */
+    lwcell_sms_concat_t concat; /*!< Concatenated part information */
+    uint8_t data[321];          /*!< Decoded data, UTF-8 text for GSM 7-bit and UCS2 messages.
+                                    Text is `NULL` terminated */
+    size_t length;              /*!< Length of decoded data in units of bytes */
+} lwcell_sms_pdu_t;
+
+/**
+ * \ingroup         LWCELL_SMS
+ * \brief           SMS batch send entry
+ * \sa              lwcell_sms_send_batch
+ */
+typedef struct {
+    const char* num;  /*!< Phone number */
+    const char* text; /*!< UTF-8 text. GSM 7-bit alphabet is used when possible, UCS2 otherwise */
+    lwcellr_t res;    /*!< Send result of this entry, set by stack */
+    size_t pos;       /*!< Message reference of last sent part, set by stack */
+} lwcell_sms_batch_entry_t;
+
+/**
+ * \ingroup         LWCELL_DEVICE_INFO
+ * \brief           Persisted device identity for fast-boot reset sequence
+ */
+typedef struct {
+    char manufacturer[20]; /*!< Device manufacturer */
+    char model[20];        /*!< Device model number */
+    char serial[20];       /*!< Device serial number */
+    char revision[20];     /*!< Device revision */
+} lwcell_device_identity_t;
+
+/**
+ * \ingroup         LWCELL_DEVICE_INFO
+ * \brief           Device identity load and store callback function
+ * \param[in,out]   id: Identity to fill on load or to persist on store
+ * \param[in]       store: Set to `1` when identity was queried from device and shall be persisted,
+ *                      `0` when application shall fill persisted identity
+ * \param[in]       arg: Custom user argument
+ * \return          On load, `1` if valid identity was filled, `0` otherwise. Ignored on store
+ * \sa              lwcell_device_set_identity_fn
+ */
+typedef uint8_t (*lwcell_device_identity_fn)(lwcell_device_identity_t* id, uint8_t store, void* arg);
+
+/**
+ * \ingroup         LWCELL_SMS
+ * \brief           SMS list entry callback function
+ * \param[in]       entry: Listed SMS entry. It is valid only until function returns
+ * \param[in]       arg: Custom user argument
+ * \sa              lwcell_sms_list_iter
+ */
+typedef void (*lwcell_sms_list_fn)(const lwcell_sms_entry_t* entry, void* arg);
+
 /**
  * \ingroup         LWCELL_PB
  * \brief           Phonebook entry structure
@@ -208,6 +322,27 @@ typedef struct {
     lwcell_number_type_t type; /*!< Phone number type */
 } lwcell_pb_entry_t;
 
+/**
+ * \ingroup         LWCELL_PB
+ * \brief           Phonebook list entry callback function
+ * \param[in]       entry: Listed entry. It is valid only until function returns
+ * \param[in]       arg: Custom user argument
+ * \return          `1` to continue listing, `0` to stop. Use `entry->pos + 1` as start index to resume later
+ * \sa              lwcell_pb_list_iter
+ */
+typedef uint8_t (*lwcell_pb_list_fn)(const lwcell_pb_entry_t* entry, void* arg);
+
+/**
+ * \ingroup         LWCELL_PB
+ * \brief           Phonebook import entry callback function
+ * \param[in]       index: Index of requested entry, starting with `0`
+ * \param[out]      entry: Entry to fill. Set `pos` to `0` to write it to first free position
+ * \param[in]       arg: Custom user argument
+ * \return          `1` when entry was filled, `0` when there are no more entries to import
+ * \sa              lwcell_pb_import
+ */
+typedef uint8_t (*lwcell_pb_import_fn)(size_t index, lwcell_pb_entry_t* entry, void* arg);
+
 /**
  * \ingroup         LWCELL_OPERATOR
  * \brief           Operator status value
@@ -227,6 +362,7 @@ typedef enum {
     LWCELL_OPERATOR_MODE_AUTO = 0x00,        /*!< Operator automatic mode */
     LWCELL_OPERATOR_MODE_MANUAL = 0x01,      /*!< Operator manual mode */
     LWCELL_OPERATOR_MODE_DEREGISTER = 0x02,  /*!< Operator deregistered from network */
+    LWCELL_OPERATOR_MODE_FORMAT = 0x03,      /*!< Set data format of current operator only, selection is not changed */
     LWCELL_OPERATOR_MODE_MANUAL_AUTO = 0x04, /*!< Operator manual mode first. If fails, auto mode enabled */
 } lwcell_operator_mode_t;
 
@@ -267,6 +403,18 @@ typedef struct {
     } data;                  /*!< Operator data union */
 } lwcell_operator_curr_t;
 
+/**
+ * \ingroup         LWCELL_OPERATOR
+ * \brief           Cached operator load and store callback function
+ * \param[in,out]   num: Numeric operator (PLMN) to fill on load or to persist on store
+ * \param[in]       store: Set to `1` when device registered to operator and it shall be persisted,
+ *                      `0` when application shall fill persisted operator
+ * \param[in]       arg: Custom user argument
+ * \return          On load, `1` if valid operator was filled, `0` otherwise. Ignored on store
+ * \sa              lwcell_operator_set_cache_fn
+ */
+typedef uint8_t (*lwcell_operator_cache_fn)(uint32_t* num, uint8_t store, void* arg);
+
 /**
  * \ingroup         LWCELL_NETWORK
  * \brief           Network Registration status
@@ -281,6 +429,63 @@ typedef enum {
     LWCELL_NETWORK_REG_STATUS_CONNECTED_ROAMING_SMS_ONLY = 0x07 /*!< Device is roaming in SMS-only mode */
 } lwcell_network_reg_status_t;
 
+/**
+ * \ingroup         LWCELL_NETWORK
+ * \brief           Radio access technology, values can be combined with binary OR
+ */
+typedef enum {
+    LWCELL_NETWORK_RAT_CATM = 0x01,       /*!< LTE CAT-M */
+    LWCELL_NETWORK_RAT_NBIOT = 0x02,      /*!< LTE NB-IoT */
+    LWCELL_NETWORK_RAT_CATM_NBIOT = 0x03, /*!< LTE CAT-M and NB-IoT */
+    LWCELL_NETWORK_RAT_GSM = 0x04,        /*!< GSM */
+} lwcell_network_rat_t;
+
+/**
+ * \ingroup         LWCELL_NETWORK
+ * \brief           Serving radio access technology and band
+ */
+typedef struct {
+    lwcell_network_rat_t rat; /*!< Single radio access technology, `0` if unknown */
+    uint8_t band;             /*!< E-UTRAN band number, `0` if unknown or not LTE */
+} lwcell_network_band_t;
+
+/**
+ * \ingroup         LWCELL_NETWORK
+ * \brief           Learned band load and store callback function
+ * \param[in,out]   band: Band to fill on load or to persist on store
+ * \param[in]       store: Set to `1` when device registered on band and it shall be persisted,
+ *                      `0` when application shall fill persisted band
+ * \param[in]       arg: Custom user argument
+ * \return          On load, `1` if valid band was filled, `0` otherwise. Ignored on store
+ * \sa              lwcell_network_band_set_manager
+ */
+typedef uint8_t (*lwcell_network_band_fn)(lwcell_network_band_t* band, uint8_t store, void* arg);
+
+/**
+ * \ingroup         LWCELL_NETWORK
+ * \brief           Band lock manager configuration
+ * \sa              lwcell_network_band_set_manager
+ */
+typedef struct {
+    lwcell_network_rat_t rat;  /*!< Allowed radio access technologies for wide search */
+    const uint8_t* bands;      /*!< Allowed LTE bands for wide search. Set to `NULL` to keep modem band list */
+    size_t bands_len;          /*!< Number of entries in `bands` array */
+    uint32_t timeout;          /*!< Time in milliseconds to register on learned band, before search widens */
+    lwcell_network_band_fn fn; /*!< Learned band load and store callback */
+    void* arg;                 /*!< Custom argument for callback function */
+} lwcell_network_band_cfg_t;
+
+/**
+ * \ingroup         LWCELL_NETWORK
+ * \brief           Status queries, that can be combined in \ref lwcell_network_query_batch
+ */
+typedef enum {
+    LWCELL_QUERY_RSSI = 0x01,       /*!< Signal quality, `+CSQ` command */
+    LWCELL_QUERY_REG_STATUS = 0x02, /*!< Network registration status, `+CREG?` command */
+    LWCELL_QUERY_OPERATOR = 0x04,   /*!< Current operator, `+COPS?` command */
+    LWCELL_QUERY_SIM_STATE = 0x08,  /*!< SIM card state, `+CPIN?` command */
+} lwcell_query_t;
+
 /**
  * \ingroup         LWCELL_CALL
  * \brief           List of call directions
@@ -344,12 +549,293 @@ struct lwcell_pbuf;
  */
 typedef struct lwcell_conn* lwcell_conn_p;
 
+/**
+ * \ingroup         LWCELL_CONN
+ * \brief           Single data fragment for vectored send
+ * \sa              lwcell_conn_sendv
+ */
+typedef struct {
+    const void* data; /*!< Pointer to fragment data */
+    size_t len;       /*!< Fragment length in units of bytes */
+} lwcell_conn_iovec_t;
+
+/**
+ * \ingroup         LWCELL_CONN
+ * \brief           Send request handle for cancellation, `0` is never used as valid handle
+ * \sa              lwcell_conn_send_deadline
+ */
+typedef uint32_t lwcell_conn_send_id_t;
+
+/**
+ * \ingroup         LWCELL_CONN
+ * \brief           Function to read data of send stream
+ * \note            Function is called from processing thread, while device waits for data of current chunk.
+ *                  It must not block and must not call other API functions
+ * \param[in]       arg: User argument, passed to \ref lwcell_conn_send_stream
+ * \param[in]       offset: Offset of data from beginning of stream.
+ *                      Same data may be requested again, when chunk is retransmitted
+ * \param[out]      buff: Buffer to write data to
+ * \param[in]       len: Number of bytes to read
+ * \return          Number of bytes read, less than `len` on read error
+ * \sa              lwcell_conn_send_stream
+ */
+typedef size_t (*lwcell_conn_read_fn)(void* arg, size_t offset, void* buff, size_t len);
+
+/**
+ * \ingroup         LWCELL_CONN
+ * \brief           Link quality statistics of connection send path
+ * \sa              lwcell_conn_get_send_stats
+ */
+typedef struct {
+    size_t chunk_len; /*!< Current chunk length in units of bytes */
+    uint32_t pace;    /*!< Current delay between chunks in units of milliseconds */
+    uint32_t srtt;    /*!< Smoothed chunk round-trip time in units of milliseconds */
+    uint8_t loss;     /*!< Smoothed chunk loss ratio in units of percent */
+    uint32_t ok;      /*!< Number of confirmed chunks */
+    uint32_t fail;    /*!< Number of failed chunks */
+} lwcell_conn_send_stats_t;
+
 /**
  * \ingroup         LWCELL_PBUF
  * \brief           Pointer to \ref lwcell_pbuf_t structure
  */
 typedef struct lwcell_pbuf* lwcell_pbuf_p;
 
+/**
+ * \ingroup         LWCELL_CONN
+ * \brief           Typed receive function of connection
+ * \note            Function is called from processing thread with core locked.
+ *                  Packet buffer is freed after function returns, use \ref lwcell_pbuf_ref to keep it
+ * \param[in]       conn: Connection handle
+ * \param[in]       pbuf: Received packet buffer
+ * \param[in]       arg: Connection user argument, see \ref lwcell_conn_set_arg
+ * \return          \ref lwcellOK on success, \ref lwcellOKIGNOREMORE to drop rest of received segment
+ * \sa              lwcell_conn_set_recv_fn
+ */
+typedef lwcellr_t (*lwcell_conn_recv_fn)(lwcell_conn_p conn, lwcell_pbuf_p pbuf, void* arg);
+
+/**
+ * \ingroup         LWCELL_CONN
+ * \brief           Batch receive function of connection
+ * \note            Function is called from processing thread with core locked.
+ *                  Packet buffers are freed after function returns, use \ref lwcell_pbuf_ref to keep them
+ * \param[in]       conn: Connection handle
+ * \param[in]       pbufs: Received packet buffers in receive order
+ * \param[in]       cnt: Number of packet buffers
+ * \param[in]       arg: Connection user argument, see \ref lwcell_conn_set_arg
+ * \sa              lwcell_conn_set_recv_batch_fn
+ */
+typedef void (*lwcell_conn_recv_batch_fn)(lwcell_conn_p conn, lwcell_pbuf_p* pbufs, size_t cnt, void* arg);
+
+/**
+ * \ingroup         LWCELL_PBUF
+ * \brief           Release function for memory referenced by packet buffer
+ * \param[in]       mem: Start of memory, as passed on packet buffer creation
+ * \param[in]       len: Length of memory in units of bytes
+ * \param[in]       arg: Custom user argument
+ * \sa              lwcell_pbuf_new_ref
+ */
+typedef void (*lwcell_pbuf_release_fn)(const void* mem, size_t len, void* arg);
+
+/**
+ * \ingroup         LWCELL_INPUT
+ * \brief           Long received line stream callback function
+ *
+ * Line longer than \ref LWCELL_CFG_RCV_LINE_SIZE is passed in chunks, starting with buffered beginning of line.
+ * Last call has `data` set to `NULL` and `is_last` set to `1`
+ *
+ * \param[in]       data: Chunk of line characters, valid only until function returns
+ * \param[in]       len: Length of chunk in units of bytes
+ * \param[in]       is_last: Set to `1` when line has ended
+ * \param[in]       arg: Custom user argument
+ * \sa              lwcell_input_set_line_stream_fn
+ */
+typedef void (*lwcell_line_stream_fn)(const char* data, size_t len, uint8_t is_last, void* arg);
+
+/**
+ * \ingroup         LWCELL
+ * \brief           Producer queue admission status, indexed by priority (`0` regular, `1` priority)
+ * \sa              lwcell_producer_get_status
+ */
+typedef struct {
+    size_t depth[2];      /*!< Number of commands waiting in producer queue */
+    size_t peak[2];       /*!< Highest number of waiting commands since last status reset */
+    size_t limit[2];      /*!< Maximal number of waiting commands, admitted to producer queue */
+    uint32_t rejected[2]; /*!< Number of commands rejected because of limit since last status reset */
+} lwcell_producer_status_t;
+
+/**
+ * \ingroup         LWCELL_INPUT
+ * \brief           Skipped command echo callback function
+ *
+ * \param[in]       data: Sent command, as remembered for echo matching, without line termination
+ * \param[in]       len: Length of command in units of bytes
+ * \param[in]       arg: Custom user argument
+ * \sa              lwcell_input_set_echo_tap_fn
+ */
+typedef void (*lwcell_echo_tap_fn)(const char* data, size_t len, void* arg);
+
+/**
+ * \ingroup         LWCELL_PING
+ * \brief           Ping run statistics
+ */
+typedef struct {
+    uint16_t sent;     /*!< Number of probes sent */
+    uint16_t received; /*!< Number of probes with reply */
+    uint32_t min;      /*!< Minimal round-trip time in units of milliseconds */
+    uint32_t avg;      /*!< Average round-trip time in units of milliseconds */
+    uint32_t max;      /*!< Maximal round-trip time in units of milliseconds */
+    uint32_t jitter;   /*!< Average difference between consecutive round-trip times in units of milliseconds */
+} lwcell_ping_stats_t;
+
+/**
+ * \ingroup         LWCELL_USAGE
+ * \brief           Data usage counters in units of bytes
+ * \sa              lwcell_usage_get
+ */
+typedef struct {
+    uint64_t tx;          /*!< Payload bytes sent */
+    uint64_t rx;          /*!< Payload bytes received */
+    uint64_t tx_overhead; /*!< Estimated protocol overhead of sent data */
+    uint64_t rx_overhead; /*!< Estimated protocol overhead of received data */
+} lwcell_usage_t;
+
+/**
+ * \ingroup         LWCELL_SUPERVISOR
+ * \brief           Recovery tier of modem health supervisor
+ */
+typedef enum {
+    LWCELL_SUPERVISOR_TIER_NONE = 0x00, /*!< No recovery in progress */
+    LWCELL_SUPERVISOR_TIER_PROBE,       /*!< Device is probed with `AT` command */
+    LWCELL_SUPERVISOR_TIER_REATTACH,    /*!< Network is attached again */
+    LWCELL_SUPERVISOR_TIER_CFUN,        /*!< Radio is turned off and on with `AT+CFUN` */
+    LWCELL_SUPERVISOR_TIER_RESET,       /*!< Device is reset */
+    LWCELL_SUPERVISOR_TIER_END,         /*!< Number of tiers, used internally */
+} lwcell_supervisor_tier_t;
+
+/**
+ * \ingroup         LWCELL_SUPERVISOR
+ * \brief           Modem health supervisor statistics
+ */
+typedef struct {
+    uint32_t faults;                              /*!< Number of detected faults */
+    uint32_t recoveries;                          /*!< Number of recovered faults */
+    uint32_t actions[LWCELL_SUPERVISOR_TIER_END]; /*!< Number of started recovery actions per tier */
+    uint32_t ttr_last;                            /*!< Time to recover from last fault in units of milliseconds */
+    uint32_t ttr_max;                             /*!< Maximal time to recover in units of milliseconds */
+    uint32_t ttr_mean;                            /*!< Mean time to recover in units of milliseconds */
+} lwcell_supervisor_stats_t;
+
+/**
+ * \ingroup         LWCELL_GNSS
+ * \brief           GNSS navigation info
+ *
+ * Values are kept in fixed point format, as reported by device, to avoid floating point parsing
+ */
+typedef struct {
+    uint8_t run;         /*!< Status whether GNSS engine is running */
+    uint8_t fix;         /*!< Status whether position is fixed and values below are valid */
+    struct tm dt;        /*!< UTC date and time of fix */
+    int32_t lat;         /*!< Latitude in units of `0.000001` degree, positive on northern hemisphere */
+    int32_t lon;         /*!< Longitude in units of `0.000001` degree, positive on eastern hemisphere */
+    int32_t alt;         /*!< Altitude above mean sea level in units of centimeters */
+    uint32_t speed;      /*!< Speed over ground in units of `0.01 km/h` */
+    uint32_t course;     /*!< Course over ground in units of `0.01` degree */
+    uint8_t mode;        /*!< Fix mode, as reported by device */
+    uint16_t hdop;       /*!< Horizontal dilution of precision in units of `0.1` */
+    uint8_t sats_view;   /*!< Number of satellites in view */
+} lwcell_gnss_fix_t;
+
+/**
+ * \ingroup         LWCELL_CELL_INFO
+ * \brief           Cell measurement from engineering mode report
+ */
+typedef struct {
+    uint16_t arfcn;   /*!< Absolute radio frequency channel number */
+    uint8_t rxlev;    /*!< Received signal level, `0..63` */
+    uint8_t bsic;     /*!< Base station identity code */
+    uint16_t mcc;     /*!< Mobile country code */
+    uint16_t mnc;     /*!< Mobile network code */
+    uint16_t lac;     /*!< Location area code */
+    uint32_t cell_id; /*!< Cell ID */
+} lwcell_cell_t;
+
+/**
+ * \ingroup         LWCELL_CELL_INFO
+ * \brief           Serving and neighbour cell measurements
+ */
+typedef struct {
+    uint8_t valid;                                            /*!< Set to `1` when serving cell was reported */
+    lwcell_cell_t serving;                                    /*!< Serving cell */
+    uint8_t rxqual;                                           /*!< Serving cell receive quality, `0..7` */
+    uint8_t ta;                                               /*!< Timing advance */
+    lwcell_cell_t neighbours[LWCELL_CFG_CELL_INFO_NEIGHBOURS]; /*!< Neighbour cells */
+    uint8_t neighbours_cnt;                                   /*!< Number of valid entries in `neighbours` */
+    uint32_t time;                                            /*!< System time of last report line */
+} lwcell_cell_info_t;
+
+/**
+ * \ingroup         LWCELL_TIME
+ * \brief           Approximate location based on serving cell
+ */
+typedef struct {
+    int32_t lat; /*!< Latitude in units of `0.000001` degree, positive on northern hemisphere */
+    int32_t lon; /*!< Longitude in units of `0.000001` degree, positive on eastern hemisphere */
+} lwcell_location_t;
+
+/**
+ * \ingroup         LWCELL_SNAPSHOT
+ * \brief           Stack state snapshot for warm restart
+ *
+ * Structure is filled by \ref lwcell_snapshot_save and shall not be modified by application.
+ * It is valid only for the same library build and configuration
+ */
+typedef struct {
+    uint32_t magic; /*!< Magic number with structure size, set when snapshot is valid */
+    uint32_t check; /*!< Check value of all following fields */
+
+    char model_manufacturer[20];  /*!< Device manufacturer */
+    char model_number[20];        /*!< Device model number */
+    char model_serial_number[20]; /*!< Device serial number */
+    char model_revision[20];      /*!< Device revision */
+    lwcell_device_model_t model;  /*!< Device model */
+
+    lwcell_sim_state_t sim_state;               /*!< SIM state */
+    lwcell_network_reg_status_t network_status; /*!< Network registration status */
+    uint8_t is_attached;                        /*!< Flag indicating PDP context is active */
+    lwcell_ip_t ip_addr;                        /*!< Device IP address in PDP context */
+#if LWCELL_CFG_SMS || __DOXYGEN__
+    uint8_t sms_ready;   /*!< SMS feature ready by device */
+    uint8_t sms_enabled; /*!< SMS feature enabled */
+    struct {
+        uint32_t mem_available; /*!< Bit field of available memories */
+        lwcell_mem_t current;   /*!< Current memory choice */
+        uint16_t total;         /*!< Size of memory in units of entries */
+        uint16_t used;          /*!< Number of used entries */
+    } sms_mem[3];               /*!< Operation, receive and sent storage */
+#endif                          /* LWCELL_CFG_SMS || __DOXYGEN__ */
+#if LWCELL_CFG_PHONEBOOK || __DOXYGEN__
+    uint8_t pb_ready;   /*!< Phonebook feature ready by device */
+    uint8_t pb_enabled; /*!< Phonebook feature enabled */
+    struct {
+        uint32_t mem_available; /*!< Bit field of available memories */
+        lwcell_mem_t current;   /*!< Current memory choice */
+        uint16_t total;         /*!< Size of memory in units of entries */
+        uint16_t used;          /*!< Number of used entries */
+    } pb_mem;                   /*!< Phonebook memory */
+#endif                          /* LWCELL_CFG_PHONEBOOK || __DOXYGEN__ */
+#if LWCELL_CFG_CONN || __DOXYGEN__
+    struct {
+        uint8_t active;            /*!< Connection is active on device */
+        uint8_t client;            /*!< Connection is in client mode */
+        lwcell_conn_type_t type;   /*!< Connection type */
+        lwcell_ip_t remote_ip;     /*!< Remote IP address */
+        lwcell_port_t remote_port; /*!< Remote port */
+        lwcell_port_t local_port;  /*!< Local port */
+    } conns[LWCELL_CFG_MAX_CONNS]; /*!< Connections by device connection number */
+#endif                             /* LWCELL_CFG_CONN || __DOXYGEN__ */
+} lwcell_snapshot_t;
+
 /**
  * \ingroup         LWCELL_EVT
  * \brief           Event function prototype
@@ -372,6 +858,10 @@ typedef enum lwcell_cb_type_t {
                                                         When application receives this event,
                                                         it may reset system as there was (maybe) a problem in device */
 
+#if LWCELL_CFG_STATIC_ALLOC || __DOXYGEN__
+    LWCELL_EVT_MEM_POOL_EMPTY, /*!< Allocation failed as no static pool had free block big enough */
+#endif                         /* LWCELL_CFG_STATIC_ALLOC || __DOXYGEN__ */
+
     LWCELL_EVT_DEVICE_PRESENT,    /*!< Notification when device present status changes */
     LWCELL_EVT_DEVICE_IDENTIFIED, /*!< Device identified event */
 
@@ -382,24 +872,32 @@ typedef enum lwcell_cb_type_t {
 
     LWCELL_EVT_SIM_STATE_CHANGED, /*!< SIM card state changed */
 
-    LWCELL_EVT_OPERATOR_SCAN, /*!< Operator scan finished event */
+    LWCELL_EVT_OPERATOR_SCAN,       /*!< Operator scan finished event */
+    LWCELL_EVT_OPERATOR_SCAN_ENTRY, /*!< Single operator entry parsed during operator scan */
 
     LWCELL_EVT_NETWORK_OPERATOR_CURRENT, /*!< Current operator event */
     LWCELL_EVT_NETWORK_REG_CHANGED,      /*!< Network registration changed.
                                                          Available even when \ref LWCELL_CFG_NETWORK is disabled */
+#if LWCELL_CFG_NETWORK_PS_REG || __DOXYGEN__
+    LWCELL_EVT_NETWORK_PS_REG_CHANGED, /*!< Packet service registration changed, `+CGREG` or `+CEREG` received */
+#endif                                 /* LWCELL_CFG_NETWORK_PS_REG || __DOXYGEN__ */
 #if LWCELL_CFG_NETWORK || __DOXYGEN__
     LWCELL_EVT_NETWORK_ATTACHED, /*!< Attached to network, PDP context active and ready for TCP/IP application */
     LWCELL_EVT_NETWORK_DETACHED, /*!< Detached from network, PDP context not active anymore */
 #endif                           /* LWCELL_CFG_NETWORK || __DOXYGEN__ */
 
 #if LWCELL_CFG_CONN || __DOXYGEN__
-    LWCELL_EVT_CONN_RECV,   /*!< Connection data received */
-    LWCELL_EVT_CONN_SEND,   /*!< Connection data send */
-    LWCELL_EVT_CONN_ACTIVE, /*!< Connection just became active */
-    LWCELL_EVT_CONN_ERROR,  /*!< Client connection start was not successful */
-    LWCELL_EVT_CONN_CLOSE,  /*!< Connection close event. Check status if successful */
-    LWCELL_EVT_CONN_POLL,   /*!< Poll for connection if there are any changes */
-#endif                      /* LWCELL_CFG_CONN || __DOXYGEN__ */
+    LWCELL_EVT_CONN_RECV,           /*!< Connection data received */
+    LWCELL_EVT_CONN_SEND,           /*!< Connection data send */
+    LWCELL_EVT_CONN_ACTIVE,         /*!< Connection just became active */
+    LWCELL_EVT_CONN_ERROR,          /*!< Client connection start was not successful */
+    LWCELL_EVT_CONN_CLOSE,          /*!< Connection close event. Check status if successful */
+    LWCELL_EVT_CONN_POLL,           /*!< Poll for connection if there are any changes */
+    LWCELL_EVT_CONN_STATUS_CHANGED, /*!< Connection line of `AT+CIPSTATUS` differs from cached connection status */
+#if LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__
+    LWCELL_EVT_CONN_RX_PENDING, /*!< Data waiting in device buffer crossed \ref LWCELL_CFG_CONN_RX_PENDING_THRESHOLD */
+#endif                          /* LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__ */
+#endif                          /* LWCELL_CFG_CONN || __DOXYGEN__ */
 
 #if LWCELL_CFG_SMS || __DOXYGEN__
     LWCELL_EVT_SMS_ENABLE, /*!< SMS enable event */
@@ -422,9 +920,59 @@ typedef enum lwcell_cb_type_t {
     LWCELL_EVT_PB_ENABLE, /*!< Phonebook enable event */
     LWCELL_EVT_PB_LIST,   /*!< Phonebook list event */
     LWCELL_EVT_PB_SEARCH, /*!< Phonebook search event */
+    LWCELL_EVT_PB_IMPORT, /*!< Phonebook import entry written or failed */
 #endif                    /* LWCELL_CFG_PHONEBOOK || __DOXYGEN__ */
+#if LWCELL_CFG_MQTT || __DOXYGEN__
+    LWCELL_EVT_MQTT_CONNECT,    /*!< Native MQTT connect finished, check result */
+    LWCELL_EVT_MQTT_DISCONNECT, /*!< Native MQTT disconnected from server */
+    LWCELL_EVT_MQTT_RECV,       /*!< Native MQTT message received on subscribed topic */
+#endif                          /* LWCELL_CFG_MQTT || __DOXYGEN__ */
+#if LWCELL_CFG_HTTP || __DOXYGEN__
+    LWCELL_EVT_HTTP_READ, /*!< HTTP response body chunk read to application packet buffer */
+#endif                    /* LWCELL_CFG_HTTP || __DOXYGEN__ */
+#if LWCELL_CFG_FTP || __DOXYGEN__
+    LWCELL_EVT_FTP_READY, /*!< FTP device has new download data or is ready for next upload chunk */
+    LWCELL_EVT_FTP_READ,  /*!< FTP file chunk read to application packet buffer */
+    LWCELL_EVT_FTP_DONE,  /*!< FTP transfer finished or aborted by device, check result */
+#endif                    /* LWCELL_CFG_FTP || __DOXYGEN__ */
+#if LWCELL_CFG_PING || __DOXYGEN__
+    LWCELL_EVT_PING, /*!< Ping run finished, statistics are available */
+#endif               /* LWCELL_CFG_PING || __DOXYGEN__ */
+#if LWCELL_CFG_GNSS || __DOXYGEN__
+    LWCELL_EVT_GNSS_FIX, /*!< New GNSS navigation info reported by device */
+#endif                   /* LWCELL_CFG_GNSS || __DOXYGEN__ */
+#if LWCELL_CFG_PPP || __DOXYGEN__
+    LWCELL_EVT_PPP_CONNECTED,    /*!< Device entered PPP data mode */
+    LWCELL_EVT_PPP_DISCONNECTED, /*!< PPP call has been terminated */
+#endif                           /* LWCELL_CFG_PPP || __DOXYGEN__ */
+#if LWCELL_CFG_SUPERVISOR || __DOXYGEN__
+    LWCELL_EVT_SUPERVISOR, /*!< Supervisor started recovery action or device recovered */
+#endif                     /* LWCELL_CFG_SUPERVISOR || __DOXYGEN__ */
+#if LWCELL_CFG_USAGE || __DOXYGEN__
+    LWCELL_EVT_USAGE_QUOTA, /*!< Total data usage reached warning or limit threshold */
+#endif                      /* LWCELL_CFG_USAGE || __DOXYGEN__ */
+    LWCELL_EVT_END,       /*!< Number of event types, used internally */
 } lwcell_evt_type_t;
 
+/**
+ * \ingroup         LWCELL_EVT
+ * \brief           Event subscription mask, one bit per \ref lwcell_evt_type_t member
+ */
+typedef uint64_t lwcell_evt_mask_t;
+
+/**
+ * \ingroup         LWCELL_EVT
+ * \brief           Get subscription mask bit for single event type
+ * \param[in]       type: Event type, member of \ref lwcell_evt_type_t enumeration
+ */
+#define LWCELL_EVT_MASK(type) ((lwcell_evt_mask_t)1 << (type))
+
+/**
+ * \ingroup         LWCELL_EVT
+ * \brief           Subscription mask for all event types
+ */
+#define LWCELL_EVT_MASK_ALL (~(lwcell_evt_mask_t)0)
+
 /**
  * \ingroup         LWCELL_EVT
  * \brief           Global callback structure to pass as parameter to callback function
@@ -455,10 +1003,21 @@ typedef struct lwcell_evt {
             lwcellr_t res;          /*!< Scan operation result */
         } operator_scan;            /*!< Operator scan event. Use with \ref LWCELL_EVT_OPERATOR_SCAN event */
 
+        struct {
+            const lwcell_operator_t* op; /*!< Parsed operator entry */
+            size_t index;                /*!< Index of entry in scan response */
+        } operator_scan_entry; /*!< Operator scan entry. Use with \ref LWCELL_EVT_OPERATOR_SCAN_ENTRY event */
+
         struct {
             int16_t rssi; /*!< Strength in units of dBm */
         } rssi;           /*!< Signal strength event. Use with \ref LWCELL_EVT_SIGNAL_STRENGTH event */
 
+#if LWCELL_CFG_STATIC_ALLOC || __DOXYGEN__
+        struct {
+            size_t size; /*!< Largest requested size that failed since previous event */
+        } mem_pool_empty; /*!< Static pool exhausted. Use with \ref LWCELL_EVT_MEM_POOL_EMPTY event */
+#endif                    /* LWCELL_CFG_STATIC_ALLOC || __DOXYGEN__ */
+
 #if LWCELL_CFG_CONN || __DOXYGEN__
         struct {
             lwcell_conn_p conn; /*!< Connection where data were received */
@@ -489,7 +1048,20 @@ typedef struct lwcell_evt {
         struct {
             lwcell_conn_p conn; /*!< Set connection pointer */
         } conn_poll; /*!< Polling active connection to check for timeouts. Use with \ref LWCELL_EVT_CONN_POLL event */
-#endif               /* LWCELL_CFG_CONN || __DOXYGEN__ */
+
+        struct {
+            lwcell_conn_p conn;             /*!< Connection with changed status */
+            uint8_t changed;                /*!< Changed fields, combination of \ref LWCELL_CONN_CHANGED flags */
+            lwcell_conn_state_t state;      /*!< New connection state */
+            lwcell_conn_state_t prev_state; /*!< Previous connection state */
+        } conn_status_changed; /*!< Connection status changed. Use with \ref LWCELL_EVT_CONN_STATUS_CHANGED event */
+#if LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__
+        struct {
+            lwcell_conn_p conn; /*!< Connection handle */
+            size_t len;         /*!< Number of bytes waiting in device buffer */
+        } conn_rx_pending; /*!< Data waiting in device buffer. Use with \ref LWCELL_EVT_CONN_RX_PENDING event */
+#endif                     /* LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__ */
+#endif                     /* LWCELL_CFG_CONN || __DOXYGEN__ */
 
 #if LWCELL_CFG_SMS || __DOXYGEN__
         struct {
@@ -504,7 +1076,10 @@ typedef struct lwcell_evt {
         struct {
             lwcell_mem_t mem; /*!< Memory of received message */
             size_t pos;       /*!< Received position in memory for sent SMS */
-        } sms_recv;           /*!< SMS received info. Use with \ref LWCELL_EVT_SMS_RECV event */
+#if LWCELL_CFG_SMS_DIRECT || __DOXYGEN__
+            lwcell_sms_entry_t* entry; /*!< Directly delivered message, `NULL` when message is in storage */
+#endif                                 /* LWCELL_CFG_SMS_DIRECT || __DOXYGEN__ */
+        } sms_recv;                    /*!< SMS received info. Use with \ref LWCELL_EVT_SMS_RECV event */
 
         struct {
             lwcell_sms_entry_t* entry; /*!< SMS entry */
@@ -519,7 +1094,7 @@ typedef struct lwcell_evt {
 
         struct {
             lwcell_mem_t mem;            /*!< Memory used for scan */
-            lwcell_sms_entry_t* entries; /*!< Pointer to entries */
+            lwcell_sms_entry_t* entries; /*!< Pointer to entries, `NULL` when entries were listed to callback */
             size_t size;                 /*!< Number of valid entries */
             lwcellr_t res;               /*!< Result on command */
         } sms_list;                      /*!< SMS list. Use with \ref LWCELL_EVT_SMS_LIST event */
@@ -552,8 +1127,78 @@ typedef struct lwcell_evt {
             size_t size;                /*!< Number of valid entries */
             lwcellr_t res;              /*!< Operation success */
         } pb_search;                    /*!< Phonebok search list. Use with \ref LWCELL_EVT_PB_SEARCH event */
+
+        struct {
+            lwcell_mem_t mem;               /*!< Memory entry was written to */
+            size_t index;                   /*!< Entry index in import, starting with `0` */
+            const lwcell_pb_entry_t* entry; /*!< Imported entry, `pos` is set to used position */
+            lwcellr_t res;                  /*!< Entry write result */
+        } pb_import;                        /*!< Phonebook import entry. Use with \ref LWCELL_EVT_PB_IMPORT event */
 #endif                                  /* LWCELL_CFG_PHONEBOOK || __DOXYGEN__ */
-    } evt;                              /*!< Callback event union */
+#if LWCELL_CFG_MQTT || __DOXYGEN__
+        struct {
+            struct lwcell_mqtt* mqtt; /*!< MQTT instance */
+            lwcellr_t res;            /*!< Connect result */
+        } mqtt_connect;               /*!< MQTT connect. Use with \ref LWCELL_EVT_MQTT_CONNECT event */
+
+        struct {
+            struct lwcell_mqtt* mqtt; /*!< MQTT instance */
+            uint8_t forced;           /*!< Set to `1` when disconnect was requested by application */
+        } mqtt_disconnect;            /*!< MQTT disconnect. Use with \ref LWCELL_EVT_MQTT_DISCONNECT event */
+
+        struct {
+            struct lwcell_mqtt* mqtt; /*!< MQTT instance */
+            const char* topic;        /*!< Topic name, not `NULL` terminated */
+            size_t topic_len;         /*!< Length of topic name */
+            const void* payload;      /*!< Message payload */
+            size_t payload_len;       /*!< Length of message payload */
+        } mqtt_recv;                  /*!< MQTT message received. Use with \ref LWCELL_EVT_MQTT_RECV event */
+#endif                                /* LWCELL_CFG_MQTT || __DOXYGEN__ */
+#if LWCELL_CFG_HTTP || __DOXYGEN__
+        struct {
+            lwcell_pbuf_p buff; /*!< Packet buffer with body data */
+            size_t offset;      /*!< Offset of chunk in response body */
+            size_t len;         /*!< Number of bytes read to packet buffer */
+            size_t total_len;   /*!< Total length of response body */
+        } http_read;            /*!< HTTP body chunk read. Use with \ref LWCELL_EVT_HTTP_READ event */
+#endif                          /* LWCELL_CFG_HTTP || __DOXYGEN__ */
+#if LWCELL_CFG_FTP || __DOXYGEN__
+        struct {
+            lwcell_pbuf_p buff; /*!< Packet buffer with file data */
+            size_t offset;      /*!< Offset of chunk in remote file */
+            size_t len;         /*!< Number of bytes read to packet buffer */
+        } ftp_read;             /*!< FTP file chunk read. Use with \ref LWCELL_EVT_FTP_READ event */
+
+        struct {
+            lwcellr_t res; /*!< \ref lwcellOK when whole file was transferred, member of \ref lwcellr_t otherwise */
+            size_t offset; /*!< Offset in remote file reached by transfer, use it to resume */
+        } ftp_done;        /*!< FTP transfer finished. Use with \ref LWCELL_EVT_FTP_DONE event */
+#endif                     /* LWCELL_CFG_FTP || __DOXYGEN__ */
+#if LWCELL_CFG_PING || __DOXYGEN__
+        struct {
+            const char* host;                 /*!< Pinged host name or IP address */
+            const lwcell_ping_stats_t* stats; /*!< Run statistics */
+            lwcellr_t res;                    /*!< Run result */
+        } ping;                               /*!< Ping run finished. Use with \ref LWCELL_EVT_PING event */
+#endif                                        /* LWCELL_CFG_PING || __DOXYGEN__ */
+#if LWCELL_CFG_GNSS || __DOXYGEN__
+        struct {
+            const lwcell_gnss_fix_t* fix; /*!< Navigation info, valid only during event callback */
+        } gnss_fix;                       /*!< GNSS navigation info. Use with \ref LWCELL_EVT_GNSS_FIX event */
+#endif                                    /* LWCELL_CFG_GNSS || __DOXYGEN__ */
+#if LWCELL_CFG_SUPERVISOR || __DOXYGEN__
+        struct {
+            lwcell_supervisor_tier_t tier; /*!< Recovery tier */
+            uint8_t recovered;             /*!< Set to `1` when device recovered, `0` when tier action starts */
+        } supervisor;                      /*!< Supervisor recovery. Use with \ref LWCELL_EVT_SUPERVISOR event */
+#endif                                     /* LWCELL_CFG_SUPERVISOR || __DOXYGEN__ */
+#if LWCELL_CFG_USAGE || __DOXYGEN__
+        struct {
+            uint64_t used;    /*!< Total data usage with overhead in units of bytes */
+            uint8_t is_limit; /*!< Set to `1` when limit is reached, `0` for warning threshold */
+        } usage_quota;        /*!< Data quota threshold. Use with \ref LWCELL_EVT_USAGE_QUOTA event */
+#endif                        /* LWCELL_CFG_USAGE || __DOXYGEN__ */
+    } evt;                                    /*!< Callback event union */
 } lwcell_evt_t;
 
 #define LWCELL_SIZET_MAX ((size_t)(-1)) /*!< Maximal value of size_t variable type */
@@ -580,6 +1225,15 @@ typedef size_t (*lwcell_ll_send_fn)(const void* data, size_t len);
  */
 typedef uint8_t (*lwcell_ll_reset_fn)(uint8_t state);
 
+/**
+ * \ingroup         LWCELL_LL
+ * \brief           Function prototype for modem sleep control, usually DTR pin
+ * \param[in]       sleep: Set to `1` to allow modem to enter sleep (DTR high),
+ *                      or `0` to wake modem up (DTR low)
+ * \return          `1` on successful action, `0` otherwise
+ */
+typedef uint8_t (*lwcell_ll_sleep_fn)(uint8_t sleep);
+
 /**
  * \ingroup         LWCELL_LL
  * \brief           Low level user specific functions
@@ -587,6 +1241,7 @@ typedef uint8_t (*lwcell_ll_reset_fn)(uint8_t state);
 typedef struct {
     lwcell_ll_send_fn send_fn;   /*!< Callback function to transmit data */
     lwcell_ll_reset_fn reset_fn; /*!< Reset callback function */
+    lwcell_ll_sleep_fn sleep_fn; /*!< Sleep control callback function. Set to `NULL` if not used */
 
     struct {
         uint32_t baudrate; /*!< UART baudrate value */
@@ -605,12 +1260,44 @@ typedef void (*lwcell_timeout_fn)(void* arg);
  * \brief           Timeout structure
  */
 typedef struct lwcell_timeout {
-    struct lwcell_timeout* next; /*!< Pointer to next timeout entry */
-    uint32_t time;               /*!< Time difference from previous entry */
-    void* arg;                   /*!< Argument to pass to callback function */
-    lwcell_timeout_fn fn;        /*!< Callback function for timeout */
+    uint32_t time;        /*!< Absolute time of expiration in units of milliseconds */
+    void* arg;            /*!< Argument to pass to callback function */
+    lwcell_timeout_fn fn; /*!< Callback function for timeout */
+    size_t idx;           /*!< Position in timeout heap plus `1`, `0` when timeout is not scheduled */
+    uint8_t dyn;          /*!< Set to `1` when entry is allocated by \ref lwcell_timeout_add */
 } lwcell_timeout_t;
 
+/**
+ * \ingroup         LWCELL_TYPEDEFS
+ * \brief           Operations reported to \ref LWCELL_TRACE_HOOK
+ */
+typedef enum {
+    LWCELL_TRACE_MSG_ENQUEUE, /*!< Message put to producer queue by application thread. Value is command */
+    LWCELL_TRACE_MSG,         /*!< Message taken from producer queue until it is finished. Value is command */
+    LWCELL_TRACE_MSG_FN,      /*!< Message processing function starts command execution. Value is command */
+    LWCELL_TRACE_CMD_TX,      /*!< AT command line was sent to device. Value is current command */
+    LWCELL_TRACE_INPUT,       /*!< Received data are processed. Value is number of bytes */
+    LWCELL_TRACE_URC,         /*!< Unsolicited result code is parsed */
+    LWCELL_TRACE_DATA_TX,     /*!< Connection data are sent after prompt. Value is number of bytes */
+    LWCELL_TRACE_EVT,         /*!< Event callback function is called. Value is event type */
+    LWCELL_TRACE_SYNC,        /*!< Command finished and synchronization semaphore was released. Value is result */
+    LWCELL_TRACE_PARSE,       /*!< Received line is parsed. Value is line length */
+    LWCELL_TRACE_SEND_FN,     /*!< Low-level driver send function is called. Value is number of bytes */
+    LWCELL_TRACE_MEM_ALLOC,   /*!< Memory is allocated or reallocated. Value is requested size */
+    LWCELL_TRACE_MEM_FREE,    /*!< Memory is freed */
+    LWCELL_TRACE_POINT_END,   /*!< Number of trace points, used internally */
+} lwcell_trace_point_t;
+
+/**
+ * \ingroup         LWCELL_TYPEDEFS
+ * \brief           Phase of operation reported to \ref LWCELL_TRACE_HOOK
+ */
+typedef enum {
+    LWCELL_TRACE_BEGIN,   /*!< Operation begins */
+    LWCELL_TRACE_END,     /*!< Operation ends, value is `0` */
+    LWCELL_TRACE_INSTANT, /*!< Operation without duration */
+} lwcell_trace_phase_t;
+
 /**
  * \ingroup         LWCELL_BUFF
  * \brief           Buffer structure
@@ -619,13 +1306,26 @@ typedef struct {
     uint8_t* buff; /*!< Pointer to buffer data.
                                                         Buffer is considered initialized when `buff != NULL` */
     size_t size;   /*!< Size of buffer data.
-                                                        Size of actual buffer is `1` byte less than this value */
+                                                        Size of actual buffer is `1` byte less than this value,
+                                                        unless \ref LWCELL_CFG_BUFF_POW2 is enabled */
     size_t r;      /*!< Next read pointer.
-                                                        Buffer is considered empty when `r == w` and full when `w == r - 1` */
+                                                        Buffer is considered empty when `r == w` and full when `w == r - 1`.
+                                                        Accessed atomically when \ref LWCELL_CFG_INPUT_BUFF_ATOMIC is enabled */
     size_t w;      /*!< Next write pointer.
-                                                        Buffer is considered empty when `r == w` and full when `w == r - 1` */
+                                                        Buffer is considered empty when `r == w` and full when `w == r - 1`.
+                                                        Accessed atomically when \ref LWCELL_CFG_INPUT_BUFF_ATOMIC is enabled */
 } lwcell_buff_t;
 
+/**
+ * \ingroup         LWCELL_BUFF
+ * \brief           Linear segment of buffer memory
+ * \sa              lwcell_buff_get_read_vec, lwcell_buff_get_write_vec
+ */
+typedef struct {
+    uint8_t* data; /*!< Pointer to segment start */
+    size_t len;    /*!< Segment length in units of bytes */
+} lwcell_buff_vec_t;
+
 /**
  * \ingroup         LWCELL_TYPES
  * \brief           Linear buffer structure
@@ -655,21 +1355,81 @@ typedef struct {
     lwcellr_t res; /*!< Current result of processing */
 } lwcell_unicode_t;
 
+/**
+ * \ingroup         LWCELL_SSL
+ * \brief           Callback function to read file data during upload
+ * \param[in]       arg: Custom argument, passed to upload function
+ * \param[in]       offset: Offset of requested data in file, in units of bytes
+ * \param[out]      buff: Buffer to copy data to
+ * \param[in]       btr: Number of bytes to read
+ * \return          Number of bytes copied to `buff`. Upload fails if less than `btr`
+ */
+typedef size_t (*lwcell_ssl_read_fn)(void* arg, size_t offset, void* buff, size_t btr);
+
+/**
+ * \ingroup         LWCELL_SSL
+ * \brief           SSL protocol version
+ */
+typedef enum {
+    LWCELL_SSL_VERSION_TLS1_0 = 0x01, /*!< TLS version 1.0 */
+    LWCELL_SSL_VERSION_TLS1_1 = 0x02, /*!< TLS version 1.1 */
+    LWCELL_SSL_VERSION_TLS1_2 = 0x03, /*!< TLS version 1.2 */
+} lwcell_ssl_version_t;
+
+/**
+ * \ingroup         LWCELL_SSL
+ * \brief           SSL context configuration
+ *
+ * File names refer to files in device file system, uploaded with \ref lwcell_ssl_file_upload
+ */
+typedef struct {
+    uint8_t ctx;                  /*!< SSL context index on device, between `0` and `5` */
+    lwcell_ssl_version_t version; /*!< Protocol version */
+    const char* sni;              /*!< Server name for SNI extension. Set to `NULL` to disable */
+    const char* ca;               /*!< Root CA file name. Set to `NULL` if server is not verified */
+    const char* cert;             /*!< Client certificate file name. Set to `NULL` if not used */
+    const char* key;              /*!< Client private key file name, used together with `cert` */
+} lwcell_ssl_cfg_t;
+
 /**
  * \ingroup         LWCELL_MQTT
  * \brief           MQTT connection descriptor structure
  */
 typedef struct {
     const char* device_id; /*!< Device ID */
-    const char* username;  /*!< Username */
-    const char* password;  /*!< Password */
+    const char* username;  /*!< Username. Set to `NULL` if not used */
+    const char* password;  /*!< Password. Set to `NULL` if not used */
+    const char* host;      /*!< Server host name or IP address */
+    lwcell_port_t port;    /*!< Server port */
+    uint16_t keep_alive;   /*!< Keep-alive time in units of seconds, handled by device */
+#if LWCELL_CFG_SSL || __DOXYGEN__
+    const lwcell_ssl_cfg_t* ssl; /*!< SSL context, configured with \ref lwcell_ssl_config.
+                                        Set to `NULL` for plain connection */
+#endif                           /* LWCELL_CFG_SSL || __DOXYGEN__ */
 } lwcell_mqtt_conn_desc_t;
 
 /**
- * \brief           MQTT instance
+ * \ingroup         LWCELL_FTP
+ * \brief           FTP server and file descriptor structure
  */
 typedef struct {
-    void* arg;
+    const char* host;   /*!< Server host name or IP address */
+    lwcell_port_t port; /*!< Server port, set to `0` for default port `21` */
+    const char* user;   /*!< Username. Set to `NULL` for anonymous login */
+    const char* pass;   /*!< Password. Set to `NULL` if not used */
+    const char* path;   /*!< Path of remote directory, such as `/logs/` */
+    const char* name;   /*!< Name of remote file */
+} lwcell_ftp_desc_t;
+
+/**
+ * \ingroup         LWCELL_MQTT
+ * \brief           MQTT instance
+ */
+typedef struct lwcell_mqtt {
+    lwcell_evt_fn evt_fn; /*!< Event callback function for MQTT events */
+    void* arg;            /*!< User custom argument */
+    uint8_t in_use;       /*!< Set to `1` when instance is taken by \ref lwcell_mqtt_connect */
+    uint8_t is_connected; /*!< Set to `1` when device is connected to server */
 } lwcell_mqtt_t;
 
 #ifdef __cplusplus
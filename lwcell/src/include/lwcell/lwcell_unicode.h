@@ -48,6 +48,8 @@ extern "C" {
  */
 
 lwcellr_t lwcelli_unicode_decode(lwcell_unicode_t* uni, uint8_t ch);
+uint8_t lwcelli_unicode_ucs2_hex_decode(char* str);
+size_t lwcelli_unicode_ascii_run(const uint8_t* data, size_t len);
 
 /**
  * \}
@@ -0,0 +1,81 @@
+/**
+ * \file            lwcell_usage.h
+ * \brief           Data usage accounting
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_USAGE_HDR_H
+#define LWCELL_USAGE_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWCELL
+ * \defgroup        LWCELL_USAGE Data usage accounting
+ * \brief           Data usage per connection, per PDP context and in total, with quota
+ * \{
+ *
+ * Payload bytes are counted exactly when device confirms sent data and when received data are reported.
+ * Protocol overhead is estimated per TCP segment and per UDP datagram,
+ * with \ref LWCELL_CFG_USAGE_TCP_OVERHEAD and \ref LWCELL_CFG_USAGE_UDP_OVERHEAD.
+ * Connection setup, DNS and TLS record overhead are not included.
+ *
+ * Quota applies to total usage, payload and overhead in both directions.
+ * \ref LWCELL_EVT_USAGE_QUOTA event is sent once when warning threshold is reached and once when limit is reached.
+ * When throttling is enabled, send functions of low-priority connections fail with \ref lwcellERRQUOTA
+ * once limit is reached, until counters are reset or quota is changed.
+ *
+ * Connection counters start from zero each time connection becomes active.
+ */
+
+/**
+ * \brief           Context number to get total usage with \ref lwcell_usage_get
+ */
+#define LWCELL_USAGE_TOTAL 0xFF
+
+lwcellr_t lwcell_usage_get(uint8_t ctx, lwcell_usage_t* usage);
+lwcellr_t lwcell_usage_get_conn(lwcell_conn_p conn, lwcell_usage_t* usage);
+lwcellr_t lwcell_usage_reset(void);
+lwcellr_t lwcell_usage_set_quota(uint64_t warn, uint64_t limit, uint8_t throttle);
+lwcellr_t lwcell_usage_set_conn_low_prio(lwcell_conn_p conn, uint8_t low_prio);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_USAGE_HDR_H */
@@ -0,0 +1,87 @@
+/**
+ * \file            lwcell_prof_dwt.h
+ * \brief           Cycle profiling of stack pipeline with Cortex-M DWT cycle counter
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef LWCELL_PROF_DWT_HDR_H
+#define LWCELL_PROF_DWT_HDR_H
+
+#include "lwcell/lwcell_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \defgroup        LWCELL_PROF_DWT Cycle profiling
+ * \brief           Reference \ref LWCELL_TRACE_HOOK implementation with Cortex-M DWT cycle counter
+ *
+ * Cycles spent in every traced operation are accumulated on target,
+ * without debugger attached. Hook is enabled in `lwcell_opts.h` file:
+ *
+ * \code{.c}
+ * #include <stdint.h>
+ * void lwcell_prof_dwt_hook(unsigned point, unsigned phase, uint32_t val);
+ * #define LWCELL_TRACE_HOOK(point, phase, val) lwcell_prof_dwt_hook((point), (phase), (uint32_t)(val))
+ * \endcode
+ *
+ * and `system/lwcell_prof_dwt.c` is added to the build.
+ * Cycle counter is available on Cortex-M3, M4, M7, M33 and M55 cores.
+ *
+ * \note            Nested spans of the same operation are measured once, by the outermost span.
+ *                  Spans of the same operation from different threads must not overlap,
+ *                  which is the case for operations executed with core locked
+ * \{
+ */
+
+/**
+ * \brief           Accumulated statistics of single trace point
+ */
+typedef struct {
+    uint32_t count;  /*!< Number of finished spans or instant events */
+    uint64_t cycles; /*!< Total number of cycles of all spans */
+    uint32_t max;    /*!< Number of cycles of the longest span */
+} lwcell_prof_dwt_stats_t;
+
+void lwcell_prof_dwt_init(void);
+void lwcell_prof_dwt_hook(unsigned point, unsigned phase, uint32_t val);
+uint8_t lwcell_prof_dwt_get(lwcell_trace_point_t point, lwcell_prof_dwt_stats_t* stats);
+void lwcell_prof_dwt_reset(void);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWCELL_PROF_DWT_HDR_H */
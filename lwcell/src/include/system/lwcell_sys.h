@@ -74,6 +74,13 @@ typedef void* lwcell_sys_sem_t;
  */
 typedef void* lwcell_sys_mbox_t;
 
+/**
+ * \brief           System notification type
+ *
+ * It is used by middleware to wake-up processing thread.
+ */
+typedef void* lwcell_sys_notify_t;
+
 /**
  * \brief           System thread ID type
  */
@@ -108,6 +115,13 @@ typedef int lwcell_sys_thread_prio_t;
  */
 #define LWCELL_SYS_MBOX_NULL   ((lwcell_sys_mbox_t)0)
 
+/**
+ * \brief           Notification invalid value
+ *
+ * Value assigned to \ref lwcell_sys_notify_t type when it is not valid.
+ */
+#define LWCELL_SYS_NOTIFY_NULL ((lwcell_sys_notify_t)0)
+
 /**
  * \brief           OS timeout value
  *
@@ -135,6 +149,18 @@ typedef int lwcell_sys_thread_prio_t;
 #include "lwcell_sys_port.h"
 #endif /* __DOXYGEN__ */
 
+/**
+ * \brief           Thread stack usage and run time information
+ */
+typedef struct {
+    size_t stack_size;       /*!< Size of thread stack in units of bytes */
+    size_t stack_unused;     /*!< Stack high-water mark, minimal number of bytes never used since thread start */
+    uint64_t run_time;       /*!< Accumulated run time of thread, in port specific units */
+    uint64_t run_time_total; /*!< Total run time of all threads since system start, in units of `run_time` */
+    uint8_t stack_valid;     /*!< Set to `1` when stack information is provided by system port */
+    uint8_t run_time_valid;  /*!< Set to `1` when run time information is provided by system port */
+} lwcell_sys_thread_info_t;
+
 /**
  * \anchor          LWCELL_SYS_CORE
  * \name            Main
@@ -360,10 +386,121 @@ uint8_t lwcell_sys_mbox_isvalid(lwcell_sys_mbox_t* b);
  */
 uint8_t lwcell_sys_mbox_invalid(lwcell_sys_mbox_t* b);
 
+#if LWCELL_CFG_INPUT_FROM_ISR || __DOXYGEN__
+
+/**
+ * \brief           Put a new entry to message queue from interrupt context
+ *
+ * Function must not block and must request context switch on interrupt exit,
+ * when thread waiting for message has higher priority than interrupted one.
+ *
+ * \note            This function is required only when \ref LWCELL_CFG_INPUT_FROM_ISR is enabled
+ * \param[in]       b: Pointer to message queue structure
+ * \param[in]       m: Pointer to message to save to queue
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t lwcell_sys_mbox_putnow_from_isr(lwcell_sys_mbox_t* b, void* m);
+
+#endif /* LWCELL_CFG_INPUT_FROM_ISR || __DOXYGEN__ */
+
 /**
  * \}
  */
 
+#if (LWCELL_CFG_PBUF_REF_ATOMIC && !LWCELL_PBUF_REF_STDATOMIC) || __DOXYGEN__
+
+/**
+ * \brief           Atomically add value to variable
+ *
+ * Function must be safe to call from multiple threads at the same time.
+ * Critical section, shorter than core protection, is sufficient.
+ *
+ * \note            This function is required only when \ref LWCELL_CFG_PBUF_REF_ATOMIC is enabled
+ *                  and compiler does not support C11 atomics
+ * \param[in,out]   var: Pointer to variable to modify
+ * \param[in]       delta: Value to add, negative to subtract
+ * \return          New value of variable
+ */
+size_t lwcell_sys_atomic_add(size_t* var, int delta);
+
+#endif /* (LWCELL_CFG_PBUF_REF_ATOMIC && !LWCELL_PBUF_REF_STDATOMIC) || __DOXYGEN__ */
+
+#if LWCELL_CFG_THREAD_PROCESS_NOTIFY || __DOXYGEN__
+
+/**
+ * \anchor          LWCELL_SYS_NOTIFY
+ * \name            Notifications
+ */
+
+/**
+ * \brief           Create a new notification object
+ *
+ * Notification is a wake-up signal without payload for single waiting thread.
+ * Multiple posts before thread waits are coalesced to single wake-up.
+ *
+ * \note            Only one thread may wait for notification
+ * \param[out]      n: Pointer to notification structure
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t lwcell_sys_notify_create(lwcell_sys_notify_t* n);
+
+/**
+ * \brief           Delete notification object
+ * \param[in]       n: Pointer to notification structure
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t lwcell_sys_notify_delete(lwcell_sys_notify_t* n);
+
+/**
+ * \brief           Post notification to waiting thread without blocking
+ * \note            Function must be safe to call from interrupt context
+ * \param[in]       n: Pointer to notification structure
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t lwcell_sys_notify_post(lwcell_sys_notify_t* n);
+
+/**
+ * \brief           Wait for notification with timeout
+ * \param[in]       n: Pointer to notification structure
+ * \param[in]       timeout: Maximal timeout to wait for notification. When `0` is applied, wait for unlimited time
+ * \return          Number of milliseconds waited for notification or
+ *                      \ref LWCELL_SYS_TIMEOUT if not posted within given time
+ */
+uint32_t lwcell_sys_notify_wait(lwcell_sys_notify_t* n, uint32_t timeout);
+
+/**
+ * \brief           Check if notification object is valid
+ * \param[in]       n: Pointer to notification structure
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t lwcell_sys_notify_isvalid(lwcell_sys_notify_t* n);
+
+/**
+ * \brief           Invalid notification object
+ * \param[in]       n: Pointer to notification structure
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t lwcell_sys_notify_invalid(lwcell_sys_notify_t* n);
+
+#if LWCELL_CFG_INPUT_FROM_ISR || __DOXYGEN__
+
+/**
+ * \brief           Post notification from interrupt context
+ * \note            This function is required only when \ref LWCELL_CFG_INPUT_FROM_ISR is enabled
+ * \param[in]       n: Pointer to notification structure
+ * \return          `1` on success, `0` otherwise
+ * \sa              lwcell_sys_mbox_putnow_from_isr
+ */
+uint8_t lwcell_sys_notify_post_from_isr(lwcell_sys_notify_t* n);
+
+#endif /* LWCELL_CFG_INPUT_FROM_ISR || __DOXYGEN__ */
+
+/**
+ * \}
+ */
+
+#endif /* LWCELL_CFG_THREAD_PROCESS_NOTIFY || __DOXYGEN__ */
+
 /**
  * \anchor          LWCELL_SYS_THREAD
  * \name            Threads
@@ -397,6 +534,59 @@ uint8_t lwcell_sys_thread_terminate(lwcell_sys_thread_t* t);
  */
 uint8_t lwcell_sys_thread_yield(void);
 
+#if LWCELL_CFG_THREAD_AFFINITY || __DOXYGEN__
+
+/**
+ * \brief           Create a new thread, pinned to single core
+ *
+ * Port without core affinity support may create the thread without it.
+ *
+ * \note            This function is required only when \ref LWCELL_CFG_THREAD_AFFINITY is enabled
+ * \param[out]      t: Pointer to thread identifier if create was successful.
+ *                     It may be set to `NULL`
+ * \param[in]       name: Name of a new thread
+ * \param[in]       thread_func: Thread function to use as thread body
+ * \param[in]       arg: Thread function argument
+ * \param[in]       stack_size: Size of thread stack in uints of bytes. If set to 0, reserve default stack size
+ * \param[in]       prio: Thread priority
+ * \param[in]       core: Core number, starting with `0`
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t lwcell_sys_thread_create_pinned(lwcell_sys_thread_t* t, const char* name, lwcell_sys_thread_fn thread_func,
+                                        void* const arg, size_t stack_size, lwcell_sys_thread_prio_t prio, int core);
+
+#endif /* LWCELL_CFG_THREAD_AFFINITY || __DOXYGEN__ */
+
+#if LWCELL_CFG_THREAD_PROCESS_IPD_BOOST || __DOXYGEN__
+
+/**
+ * \brief           Change priority of running thread
+ * \note            This function is required only when \ref LWCELL_CFG_THREAD_PROCESS_IPD_BOOST is enabled
+ * \param[in]       t: Pointer to thread handle
+ * \param[in]       prio: New thread priority
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t lwcell_sys_thread_set_prio(lwcell_sys_thread_t* t, lwcell_sys_thread_prio_t prio);
+
+#endif /* LWCELL_CFG_THREAD_PROCESS_IPD_BOOST || __DOXYGEN__ */
+
+#if LWCELL_CFG_STATS_THREADS || __DOXYGEN__
+
+/**
+ * \brief           Get thread stack usage and accumulated run time
+ *
+ * Port sets `stack_valid` and `run_time_valid` flags for information it provides.
+ * Structure is reset and `stack_size` is set to requested stack size before function is called.
+ *
+ * \note            This function is required only when \ref LWCELL_CFG_STATS_THREADS is enabled
+ * \param[in]       t: Pointer to thread handle
+ * \param[in,out]   info: Information to fill
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t lwcell_sys_thread_get_info(lwcell_sys_thread_t* t, lwcell_sys_thread_info_t* info);
+
+#endif /* LWCELL_CFG_STATS_THREADS || __DOXYGEN__ */
+
 /**
  * \}
  */
@@ -48,12 +48,14 @@ extern "C" {
 typedef osMutexId_t lwcell_sys_mutex_t;
 typedef osSemaphoreId_t lwcell_sys_sem_t;
 typedef osMessageQueueId_t lwcell_sys_mbox_t;
+typedef osEventFlagsId_t lwcell_sys_notify_t;
 typedef osThreadId_t lwcell_sys_thread_t;
 typedef osPriority_t lwcell_sys_thread_prio_t;
 
 #define LWCELL_SYS_MUTEX_NULL  ((lwcell_sys_mutex_t)0)
 #define LWCELL_SYS_SEM_NULL    ((lwcell_sys_sem_t)0)
 #define LWCELL_SYS_MBOX_NULL   ((lwcell_sys_mbox_t)0)
+#define LWCELL_SYS_NOTIFY_NULL ((lwcell_sys_notify_t)0)
 #define LWCELL_SYS_TIMEOUT     ((uint32_t)osWaitForever)
 #define LWCELL_SYS_THREAD_PRIO (osPriorityNormal)
 #define LWCELL_SYS_THREAD_SS   (512)
@@ -77,6 +77,17 @@ typedef SemaphoreHandle_t lwcell_sys_sem_t;
  */
 typedef QueueHandle_t lwcell_sys_mbox_t;
 
+/**
+ * \brief           System notification type
+ *
+ * Implemented with direct task notifications,
+ * task is bound on first wait.
+ */
+typedef struct {
+    TaskHandle_t task; /*!< Task waiting for notification */
+    uint8_t created;   /*!< Set to `1` when object is created */
+} lwcell_sys_notify_t;
+
 /**
  * \brief           System thread ID type
  */
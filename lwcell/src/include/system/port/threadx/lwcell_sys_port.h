@@ -48,6 +48,7 @@ extern "C" {
 typedef TX_MUTEX lwcell_sys_mutex_t;
 typedef TX_SEMAPHORE lwcell_sys_sem_t;
 typedef TX_QUEUE lwcell_sys_mbox_t;
+typedef TX_EVENT_FLAGS_GROUP lwcell_sys_notify_t;
 typedef TX_THREAD lwcell_sys_thread_t;
 typedef UINT lwcell_sys_thread_prio_t;
 
@@ -48,12 +48,14 @@ extern "C" {
 typedef HANDLE lwcell_sys_mutex_t;
 typedef HANDLE lwcell_sys_sem_t;
 typedef HANDLE lwcell_sys_mbox_t;
+typedef HANDLE lwcell_sys_notify_t;
 typedef HANDLE lwcell_sys_thread_t;
 typedef int lwcell_sys_thread_prio_t;
 
 #define LWCELL_SYS_MUTEX_NULL  ((HANDLE)0)
 #define LWCELL_SYS_SEM_NULL    ((HANDLE)0)
 #define LWCELL_SYS_MBOX_NULL   ((HANDLE)0)
+#define LWCELL_SYS_NOTIFY_NULL ((HANDLE)0)
 #define LWCELL_SYS_TIMEOUT     (INFINITE)
 #define LWCELL_SYS_THREAD_PRIO (0)
 #define LWCELL_SYS_THREAD_SS   (4096)
@@ -37,10 +37,6 @@
 #include "lwcell/lwcell_timeout.h"
 #include "system/lwcell_ll.h"
 
-#if LWCELL_CFG_OS != 1
-#error LWCELL_CFG_OS must be set to 1!
-#endif
-
 static lwcellr_t prv_def_callback(lwcell_evt_t* cb);
 static lwcell_evt_func_t def_evt_link;
 
@@ -57,6 +53,34 @@ prv_def_callback(lwcell_evt_t* evt) {
     return lwcellOK;
 }
 
+#if LWCELL_CFG_OS
+
+/**
+ * \brief           Create library thread, pinned to configured core when enabled
+ * \param[out]      t: Pointer to thread handle
+ * \param[in]       name: Name of a new thread
+ * \param[in]       thread_func: Thread function to use as thread body
+ * \param[in]       arg: Thread function argument
+ * \param[in]       stack_size: Size of thread stack in uints of bytes
+ * \param[in]       prio: Thread priority
+ * \param[in]       core: Core number, `-1` for no affinity
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_thread_create(lwcell_sys_thread_t* t, const char* name, lwcell_sys_thread_fn thread_func, void* const arg,
+                  size_t stack_size, lwcell_sys_thread_prio_t prio, int core) {
+#if LWCELL_CFG_THREAD_AFFINITY
+    if (core >= 0) {
+        return lwcell_sys_thread_create_pinned(t, name, thread_func, arg, stack_size, prio, core);
+    }
+#else  /* LWCELL_CFG_THREAD_AFFINITY */
+    LWCELL_UNUSED(core);
+#endif /* !LWCELL_CFG_THREAD_AFFINITY */
+    return lwcell_sys_thread_create(t, name, thread_func, arg, stack_size, prio);
+}
+
+#endif /* LWCELL_CFG_OS */
+
 #if LWCELL_CFG_KEEP_ALIVE
 
 /**
@@ -69,7 +93,29 @@ prv_keep_alive_timeout_fn(void* arg) {
     lwcelli_send_cb(LWCELL_EVT_KEEP_ALIVE);
 
     /* Start new timeout */
-    lwcell_timeout_add(LWCELL_CFG_KEEP_ALIVE_TIMEOUT, prv_keep_alive_timeout_fn, arg);
+    lwcell_timeout_start(&lwcell.keep_alive_timeout, LWCELL_CFG_KEEP_ALIVE_TIMEOUT, prv_keep_alive_timeout_fn, arg);
+}
+
+/**
+ * \brief           Start or stop keep-alive timeout, depending on event subscriptions
+ *
+ * Timeout runs only while any registered callback function is subscribed to \ref LWCELL_EVT_KEEP_ALIVE,
+ * so the system is not woken-up periodically when nobody listens.
+ */
+void
+lwcelli_keep_alive_update(void) {
+    lwcell_core_lock();
+    if (lwcell.status.f.initialized) {
+        if (lwcell.evt_mask & LWCELL_EVT_MASK(LWCELL_EVT_KEEP_ALIVE)) {
+            if (!lwcell_timeout_is_active(&lwcell.keep_alive_timeout)) {
+                lwcell_timeout_start(&lwcell.keep_alive_timeout, LWCELL_CFG_KEEP_ALIVE_TIMEOUT,
+                                     prv_keep_alive_timeout_fn, NULL);
+            }
+        } else {
+            lwcell_timeout_stop(&lwcell.keep_alive_timeout);
+        }
+    }
+    lwcell_core_unlock();
 }
 
 #endif /* LWCELL_CFG_KEEP_ALIVE */
@@ -78,6 +124,8 @@ prv_keep_alive_timeout_fn(void* arg) {
  * \brief           Init and prepare GSM stack for device operation
  * \note            Function must be called from operating system thread context.
  *                  It creates necessary threads and waits them to start, thus running operating system is important.
+ *                  - When \ref LWCELL_CFG_OS is disabled, no threads are created
+ *                      and application must call \ref lwcell_poll from its main loop
  *                  - When \ref LWCELL_CFG_RESET_ON_INIT is enabled, reset sequence will be sent to device
  *                      otherwise manual call to \ref lwcell_reset is required to setup device
  *
@@ -90,14 +138,22 @@ lwcellr_t
 lwcell_init(lwcell_evt_fn evt_func, const uint32_t blocking) {
     lwcellr_t res = lwcellOK;
 
+    /* Handlers of `+` lines are found with binary search */
+    LWCELL_ASSERT(lwcelli_urc_table_is_sorted());
+
     lwcell.status.f.initialized = 0; /* Clear possible init flag */
 
     def_evt_link.fn = evt_func != NULL ? evt_func : prv_def_callback;
+    def_evt_link.mask = LWCELL_EVT_MASK_ALL;
     lwcell.evt_func = &def_evt_link; /* Set callback function */
+    lwcell.evt_mask = LWCELL_EVT_MASK_ALL;
 
     if (!lwcell_sys_init()) { /* Init low-level system */
         goto cleanup;
     }
+#if LWCELL_CFG_DBG && LWCELL_CFG_DBG_DEFERRED
+    lwcelli_debug_deferred_init(); /* Start recording debug messages */
+#endif /* LWCELL_CFG_DBG && LWCELL_CFG_DBG_DEFERRED */
 
     if (!lwcell_sys_sem_create(&lwcell.sem_sync, 1)) { /* Create sync semaphore between threads */
         LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_LVL_SEVERE | LWCELL_DBG_TYPE_TRACE,
@@ -105,30 +161,72 @@ lwcell_init(lwcell_evt_fn evt_func, const uint32_t blocking) {
         goto cleanup;
     }
 
-    /* Create message queues */
-    if (!lwcell_sys_mbox_create(&lwcell.mbox_producer, LWCELL_CFG_THREAD_PRODUCER_MBOX_SIZE)) {
+#if LWCELL_CFG_FINE_LOCK
+    /* Create fine-grained locks */
+    if (!lwcell_sys_mutex_create(&lwcell.evt_mutex)) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_LVL_SEVERE | LWCELL_DBG_TYPE_TRACE,
+                     "[LWCELL CORE] Cannot allocate event list mutex!\r\n");
+        goto cleanup;
+    }
+#if LWCELL_CFG_CONN
+    for (size_t i = 0; i < LWCELL_CFG_MAX_CONNS; ++i) {
+        if (!lwcell_sys_mutex_create(&lwcell.conn_mutex[i])) {
+            LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_LVL_SEVERE | LWCELL_DBG_TYPE_TRACE,
+                         "[LWCELL CORE] Cannot allocate connection mutex!\r\n");
+            goto cleanup;
+        }
+    }
+#endif /* LWCELL_CFG_CONN */
+#endif /* LWCELL_CFG_FINE_LOCK */
+
+#if LWCELL_CFG_PRODUCER_ADMISSION
+    lwcell.admission.limit[0] = LWCELL_CFG_PRODUCER_LIMIT;
+    lwcell.admission.limit[1] = LWCELL_CFG_PRODUCER_PRIO_LIMIT;
+#endif /* LWCELL_CFG_PRODUCER_ADMISSION */
+
+    /* Create message queues, regular producer queue has extra entry for priority lane wake-up */
+    if (!lwcell_sys_mbox_create(&lwcell.mbox_producer,
+                                LWCELL_CFG_THREAD_PRODUCER_MBOX_SIZE + (LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0))) {
         LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_LVL_SEVERE | LWCELL_DBG_TYPE_TRACE,
                      "[LWCELL CORE] Cannot allocate producer mbox queue!\r\n");
         goto cleanup;
     }
+#if LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0
+    if (!lwcell_sys_mbox_create(&lwcell.mbox_producer_prio, LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE)) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_LVL_SEVERE | LWCELL_DBG_TYPE_TRACE,
+                     "[LWCELL CORE] Cannot allocate producer priority mbox queue!\r\n");
+        goto cleanup;
+    }
+#endif /* LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0 */
+#if LWCELL_CFG_THREAD_PROCESS_NOTIFY
+    if (!lwcell_sys_notify_create(&lwcell.notify_process)) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_LVL_SEVERE | LWCELL_DBG_TYPE_TRACE,
+                     "[LWCELL CORE] Cannot allocate process notification!\r\n");
+        goto cleanup;
+    }
+#elif LWCELL_CFG_OS
     if (!lwcell_sys_mbox_create(&lwcell.mbox_process, LWCELL_CFG_THREAD_PROCESS_MBOX_SIZE)) {
         LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_LVL_SEVERE | LWCELL_DBG_TYPE_TRACE,
                      "[LWCELL CORE] Cannot allocate process mbox queue!\r\n");
         goto cleanup;
     }
+#endif /* LWCELL_CFG_OS && !LWCELL_CFG_THREAD_PROCESS_NOTIFY */
 
+#if LWCELL_CFG_OS
     /* Create threads */
     lwcell_sys_sem_wait(&lwcell.sem_sync, 0);
-    if (!lwcell_sys_thread_create(&lwcell.thread_produce, "lwcell_produce", lwcell_thread_produce, &lwcell.sem_sync,
-                                 LWCELL_SYS_THREAD_SS, LWCELL_SYS_THREAD_PRIO)) {
+    if (!prv_thread_create(&lwcell.thread_produce, "lwcell_produce", lwcell_thread_produce, &lwcell.sem_sync,
+                           LWCELL_CFG_THREAD_PRODUCER_STACK_SIZE, LWCELL_CFG_THREAD_PRODUCER_PRIO,
+                           LWCELL_CFG_THREAD_PRODUCER_CORE)) {
         LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_LVL_SEVERE | LWCELL_DBG_TYPE_TRACE,
                      "[LWCELL CORE] Cannot create producing thread!\r\n");
         lwcell_sys_sem_release(&lwcell.sem_sync); /* Release semaphore and return */
         goto cleanup;
     }
     lwcell_sys_sem_wait(&lwcell.sem_sync, 0); /* Wait semaphore, should be unlocked in produce thread */
-    if (!lwcell_sys_thread_create(&lwcell.thread_process, "lwcell_process", lwcell_thread_process, &lwcell.sem_sync,
-                                 LWCELL_SYS_THREAD_SS, LWCELL_SYS_THREAD_PRIO)) {
+    if (!prv_thread_create(&lwcell.thread_process, "lwcell_process", lwcell_thread_process, &lwcell.sem_sync,
+                           LWCELL_CFG_THREAD_PROCESS_STACK_SIZE, LWCELL_CFG_THREAD_PROCESS_PRIO,
+                           LWCELL_CFG_THREAD_PROCESS_CORE)) {
         LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_LVL_SEVERE | LWCELL_DBG_TYPE_TRACE,
                      "[LWCELL CORE] Cannot create processing thread!\r\n");
         lwcell_sys_thread_terminate(&lwcell.thread_produce); /* Delete produce thread */
@@ -137,14 +235,27 @@ lwcell_init(lwcell_evt_fn evt_func, const uint32_t blocking) {
     }
     lwcell_sys_sem_wait(&lwcell.sem_sync, 0); /* Wait semaphore, should be unlocked in produce thread */
     lwcell_sys_sem_release(&lwcell.sem_sync); /* Release semaphore manually */
+#if LWCELL_CFG_EVT_DEFERRED
+    if (!lwcell_sys_mbox_create(&lwcell.mbox_evt, LWCELL_CFG_EVT_DEFERRED_QUEUE_SIZE)
+        || !prv_thread_create(&lwcell.thread_evt, "lwcell_evt", lwcell_thread_evt, NULL,
+                              LWCELL_CFG_EVT_DEFERRED_THREAD_STACK_SIZE, LWCELL_CFG_EVT_DEFERRED_THREAD_PRIO,
+                              LWCELL_CFG_EVT_DEFERRED_THREAD_CORE)) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_LVL_SEVERE | LWCELL_DBG_TYPE_TRACE,
+                      "[LWCELL CORE] Cannot create event dispatch thread!\r\n");
+        lwcell_sys_thread_terminate(&lwcell.thread_produce); /* Delete produce thread */
+        lwcell_sys_thread_terminate(&lwcell.thread_process); /* Delete process thread */
+        goto cleanup;
+    }
+#endif /* LWCELL_CFG_EVT_DEFERRED */
+#endif /* LWCELL_CFG_OS */
 
     lwcell_core_lock();
     lwcell.ll.uart.baudrate = LWCELL_CFG_AT_PORT_BAUDRATE;
     lwcell_ll_init(&lwcell.ll); /* Init low-level communication */
 
 #if !LWCELL_CFG_INPUT_USE_PROCESS
-    lwcell_buff_init(&lwcell.buff, LWCELL_CFG_RCV_BUFF_SIZE); /* Init buffer for input data */
-#endif                                                     /* !LWCELL_CFG_INPUT_USE_PROCESS */
+    lwcell_buff_init(&lwcell.buff, lwcelli_input_get_buff_size()); /* Init buffer for input data */
+#endif /* !LWCELL_CFG_INPUT_USE_PROCESS */
 
     lwcell.status.f.initialized = 1; /* We are initialized now */
     lwcell.status.f.dev_present = 1; /* We assume device is present at this point */
@@ -152,9 +263,14 @@ lwcell_init(lwcell_evt_fn evt_func, const uint32_t blocking) {
     lwcelli_send_cb(LWCELL_EVT_INIT_FINISH); /* Call user callback function */
 
 #if LWCELL_CFG_KEEP_ALIVE
-    /* Register keep-alive events */
-    lwcell_timeout_add(LWCELL_CFG_KEEP_ALIVE_TIMEOUT, prv_keep_alive_timeout_fn, NULL);
+    lwcelli_keep_alive_update(); /* Start keep-alive events if anyone is subscribed */
 #endif /* LWCELL_CFG_KEEP_ALIVE */
+#if LWCELL_CFG_SUPERVISOR
+    lwcelli_supervisor_start(); /* Start periodic health checks */
+#endif                          /* LWCELL_CFG_SUPERVISOR */
+#if LWCELL_CFG_METRICS
+    lwcelli_metrics_start(); /* Start periodic sampling */
+#endif                       /* LWCELL_CFG_METRICS */
 
     /*
      * Call reset command and call default
@@ -179,14 +295,47 @@ cleanup:
         lwcell_sys_mbox_delete(&lwcell.mbox_producer);
         lwcell_sys_mbox_invalid(&lwcell.mbox_producer);
     }
+#if LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0
+    if (lwcell_sys_mbox_isvalid(&lwcell.mbox_producer_prio)) {
+        lwcell_sys_mbox_delete(&lwcell.mbox_producer_prio);
+        lwcell_sys_mbox_invalid(&lwcell.mbox_producer_prio);
+    }
+#endif /* LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0 */
+#if LWCELL_CFG_THREAD_PROCESS_NOTIFY
+    if (lwcell_sys_notify_isvalid(&lwcell.notify_process)) {
+        lwcell_sys_notify_delete(&lwcell.notify_process);
+        lwcell_sys_notify_invalid(&lwcell.notify_process);
+    }
+#else  /* LWCELL_CFG_THREAD_PROCESS_NOTIFY */
     if (lwcell_sys_mbox_isvalid(&lwcell.mbox_process)) {
         lwcell_sys_mbox_delete(&lwcell.mbox_process);
         lwcell_sys_mbox_invalid(&lwcell.mbox_process);
     }
+#endif /* !LWCELL_CFG_THREAD_PROCESS_NOTIFY */
+#if LWCELL_CFG_EVT_DEFERRED
+    if (lwcell_sys_mbox_isvalid(&lwcell.mbox_evt)) {
+        lwcell_sys_mbox_delete(&lwcell.mbox_evt);
+        lwcell_sys_mbox_invalid(&lwcell.mbox_evt);
+    }
+#endif /* LWCELL_CFG_EVT_DEFERRED */
     if (lwcell_sys_sem_isvalid(&lwcell.sem_sync)) {
         lwcell_sys_sem_delete(&lwcell.sem_sync);
         lwcell_sys_sem_invalid(&lwcell.sem_sync);
     }
+#if LWCELL_CFG_FINE_LOCK
+    if (lwcell_sys_mutex_isvalid(&lwcell.evt_mutex)) {
+        lwcell_sys_mutex_delete(&lwcell.evt_mutex);
+        lwcell_sys_mutex_invalid(&lwcell.evt_mutex);
+    }
+#if LWCELL_CFG_CONN
+    for (size_t i = 0; i < LWCELL_CFG_MAX_CONNS; ++i) {
+        if (lwcell_sys_mutex_isvalid(&lwcell.conn_mutex[i])) {
+            lwcell_sys_mutex_delete(&lwcell.conn_mutex[i]);
+            lwcell_sys_mutex_invalid(&lwcell.conn_mutex[i]);
+        }
+    }
+#endif /* LWCELL_CFG_CONN */
+#endif /* LWCELL_CFG_FINE_LOCK */
     return lwcellERRMEM;
 }
 
@@ -215,7 +364,7 @@ lwcell_reset_with_delay(uint32_t delay, const lwcell_api_cmd_evt_fn evt_fn, void
                        const uint32_t blocking) {
     LWCELL_MSG_VAR_DEFINE(msg);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(reset));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_RESET;
     LWCELL_MSG_VAR_REF(msg).msg.reset.delay = delay;
@@ -264,15 +413,26 @@ lwcell_core_unlock(void) {
  * It locks semaphore and waits for timeout in `ms` time.
  * Based on operating system, thread may be put to \e blocked list during delay and may improve execution speed
  *
+ * When \ref LWCELL_CFG_OS is disabled, function busy-waits on \ref lwcell_sys_now
+ *
  * \param[in]       ms: Milliseconds to delay
  * \return          `1` on success, `0` otherwise
  */
 uint8_t
 lwcell_delay(uint32_t ms) {
+#if LWCELL_CFG_OS
     lwcell_sys_sem_t sem;
+#else  /* LWCELL_CFG_OS */
+    uint32_t start;
+#endif /* !LWCELL_CFG_OS */
     if (ms == 0) {
         return 1;
     }
+#if !LWCELL_CFG_OS
+    start = lwcell_sys_now();
+    while ((lwcell_sys_now() - start) < ms) {}
+    return 1;
+#else  /* !LWCELL_CFG_OS */
     if (lwcell_sys_sem_create(&sem, 0)) {
         lwcell_sys_sem_wait(&sem, ms);
         lwcell_sys_sem_release(&sem);
@@ -280,6 +440,7 @@ lwcell_delay(uint32_t ms) {
         return 1;
     }
     return 0;
+#endif /* LWCELL_CFG_OS */
 }
 
 /**
@@ -295,7 +456,7 @@ lwcellr_t
 lwcell_set_func_mode(uint8_t mode, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
     LWCELL_MSG_VAR_DEFINE(msg);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(cfun));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CFUN_SET;
     LWCELL_MSG_VAR_REF(msg).msg.cfun.mode = mode;
@@ -358,3 +519,73 @@ lwcell_device_is_present(void) {
     lwcell_core_unlock();
     return res;
 }
+
+#if LWCELL_CFG_PRODUCER_ADMISSION || __DOXYGEN__
+
+/**
+ * \brief           Check if command of given priority would be admitted to producer queue
+ *
+ * Function does not block. Applications use it before submitting command,
+ * to drop or merge data when device does not keep up
+ *
+ * \param[in]       prio: Set to `1` for priority (data path) commands, `0` for regular commands
+ * \param[out]      depth: Pointer to output variable to save number of waiting commands of
+ *                      the same priority to. Set to `NULL` if not used
+ * \return          \ref lwcellOK if command would be admitted, \ref lwcellERRMEM if limit is reached
+ */
+lwcellr_t
+lwcell_producer_check(uint8_t prio, size_t* depth) {
+    lwcellr_t res;
+
+    prio = prio ? 1 : 0;
+    lwcell_core_lock();
+    res = lwcell.admission.depth[prio] < lwcell.admission.limit[prio] ? lwcellOK : lwcellERRMEM;
+    if (depth != NULL) {
+        *depth = lwcell.admission.depth[prio];
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Set limit of waiting commands for given priority
+ *
+ * Limit above producer queue size has no effect, as queue is full before
+ *
+ * \param[in]       prio: Set to `1` for priority (data path) commands, `0` for regular commands
+ * \param[in]       limit: Maximal number of waiting commands, must be greater than `0`
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_producer_set_limit(uint8_t prio, size_t limit) {
+    LWCELL_ASSERT(limit > 0);
+
+    lwcell_core_lock();
+    lwcell.admission.limit[prio ? 1 : 0] = limit;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+/**
+ * \brief           Get producer queue depth, limits and overflow metrics
+ * \param[out]      status: Pointer to output variable to save status to
+ * \param[in]       reset: Set to `1` to reset peak depth and rejected counters after read
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_producer_get_status(lwcell_producer_status_t* status, uint8_t reset) {
+    LWCELL_ASSERT(status != NULL);
+
+    lwcell_core_lock();
+    *status = lwcell.admission;
+    if (reset) {
+        for (size_t i = 0; i < LWCELL_ARRAYSIZE(lwcell.admission.peak); ++i) {
+            lwcell.admission.peak[i] = lwcell.admission.depth[i];
+            lwcell.admission.rejected[i] = 0;
+        }
+    }
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_PRODUCER_ADMISSION || __DOXYGEN__ */
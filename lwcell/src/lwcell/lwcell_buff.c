@@ -46,8 +46,44 @@
 #define BUF_MIN(x, y)   ((x) < (y) ? (x) : (y))
 #define BUF_MAX(x, y)   ((x) > (y) ? (x) : (y))
 
+/*
+ * Index access macros.
+ *
+ * Writer owns `w` and reader owns `r`. Each side reads other index with acquire
+ * and publishes own index with release, after data have been copied
+ */
+#if LWCELL_CFG_INPUT_BUFF_ATOMIC
+/* Indexes are plain `size_t` in public structure, to keep header usable from C++ */
+_Static_assert(sizeof(atomic_size_t) == sizeof(size_t) && _Alignof(atomic_size_t) == _Alignof(size_t),
+               "atomic_size_t must have the same layout as size_t");
+#define BUF_LOAD(var, type)       atomic_load_explicit((volatile atomic_size_t*)&(var), (type))
+#define BUF_STORE(var, val, type) atomic_store_explicit((volatile atomic_size_t*)&(var), (val), (type))
+#else /* LWCELL_CFG_INPUT_BUFF_ATOMIC */
+#define BUF_LOAD(var, type)       (var)
+#define BUF_STORE(var, val, type) ((var) = (val))
+#endif /* !LWCELL_CFG_INPUT_BUFF_ATOMIC */
+
+/*
+ * Index arithmetic macros.
+ *
+ * Power-of-two buffer keeps free-running indexes, masked only on memory access,
+ * other buffers keep indexes in range and wrap them on every advance
+ */
+#if LWCELL_CFG_BUFF_POW2
+#define BUF_POS(b, i)     ((i) & ((b)->size - 1))
+#define BUF_ADD(b, i, n)  ((i) + (n))
+#define BUF_FULL(b, w, r) ((w) - (r))
+#define BUF_CAP(b)        ((b)->size)
+#else /* LWCELL_CFG_BUFF_POW2 */
+#define BUF_POS(b, i)     (i)
+#define BUF_ADD(b, i, n)  ((i) + (n) >= (b)->size ? (i) + (n) - (b)->size : (i) + (n))
+#define BUF_FULL(b, w, r) ((w) >= (r) ? (w) - (r) : (b)->size - ((r) - (w)))
+#define BUF_CAP(b)        ((b)->size - 1)
+#endif /* !LWCELL_CFG_BUFF_POW2 */
+
 /**
  * \brief           Initialize buffer
+ * \note            Size is rounded up to power of two when \ref LWCELL_CFG_BUFF_POW2 is enabled
  * \param[in]       buff: Pointer to buffer structure
  * \param[in]       size: Size of buffer in units of bytes
  * \return          `1` on success, `0` otherwise
@@ -59,10 +95,20 @@ BUF_PREF(buff_init)(BUF_PREF(buff_t) * buff, size_t size) {
     }
     BUF_MEMSET(buff, 0, sizeof(*buff));
 
-    buff->size = size;                                          /* Set default values */
-    buff->buff = lwcell_mem_malloc(sizeof(*buff->buff) * size); /* Allocate memory for buffer */
+#if LWCELL_CFG_BUFF_POW2
+    {
+        size_t pow2 = 1;
 
-    if (buff->buff == NULL) {                                   /* Check allocation */
+        while (pow2 < size) {
+            pow2 <<= 1;
+        }
+        size = pow2;
+    }
+#endif /* LWCELL_CFG_BUFF_POW2 */
+    buff->size = size; /* Set default values */
+    buff->buff = lwcell_mem_malloc_tag(sizeof(*buff->buff) * size, LWCELL_MEM_TAG_BUFF); /* Allocate memory */
+
+    if (buff->buff == NULL) { /* Check allocation */
         return 0;
     }
     return 1; /* Initialized OK */
@@ -91,7 +137,7 @@ BUF_PREF(buff_free)(BUF_PREF(buff_t) * buff) {
  */
 size_t
 BUF_PREF(buff_write)(BUF_PREF(buff_t) * buff, const void* data, size_t btw) {
-    size_t tocopy, free;
+    size_t tocopy, free, w, pos;
     const uint8_t* d = data;
 
     if (!BUF_IS_VALID(buff) || btw == 0) {
@@ -106,21 +152,17 @@ BUF_PREF(buff_write)(BUF_PREF(buff_t) * buff, const void* data, size_t btw) {
     }
 
     /* Step 1: Write data to linear part of buffer */
-    tocopy = BUF_MIN(buff->size - buff->w, btw);
-    BUF_MEMCPY(&buff->buff[buff->w], d, tocopy);
-    buff->w += tocopy;
-    btw -= tocopy;
+    w = BUF_LOAD(buff->w, memory_order_relaxed);
+    pos = BUF_POS(buff, w);
+    tocopy = BUF_MIN(buff->size - pos, btw);
+    BUF_MEMCPY(&buff->buff[pos], d, tocopy);
 
     /* Step 2: Write data to beginning of buffer (overflow part) */
-    if (btw > 0) {
-        BUF_MEMCPY(buff->buff, (void*)&d[tocopy], btw);
-        buff->w = btw;
-    }
-
-    if (buff->w >= buff->size) {
-        buff->w = 0;
+    if (btw > tocopy) {
+        BUF_MEMCPY(buff->buff, (void*)&d[tocopy], btw - tocopy);
     }
-    return tocopy + btw;
+    BUF_STORE(buff->w, BUF_ADD(buff, w, btw), memory_order_release); /* Publish data to reader */
+    return btw;
 }
 
 /**
@@ -133,7 +175,7 @@ BUF_PREF(buff_write)(BUF_PREF(buff_t) * buff, const void* data, size_t btw) {
  */
 size_t
 BUF_PREF(buff_read)(BUF_PREF(buff_t) * buff, void* data, size_t btr) {
-    size_t tocopy, full;
+    size_t tocopy, full, r, pos;
     uint8_t* d = data;
 
     if (!BUF_IS_VALID(buff) || btr == 0) {
@@ -148,22 +190,17 @@ BUF_PREF(buff_read)(BUF_PREF(buff_t) * buff, void* data, size_t btr) {
     }
 
     /* Step 1: Read data from linear part of buffer */
-    tocopy = BUF_MIN(buff->size - buff->r, btr);
-    BUF_MEMCPY(d, &buff->buff[buff->r], tocopy);
-    buff->r += tocopy;
-    btr -= tocopy;
+    r = BUF_LOAD(buff->r, memory_order_relaxed);
+    pos = BUF_POS(buff, r);
+    tocopy = BUF_MIN(buff->size - pos, btr);
+    BUF_MEMCPY(d, &buff->buff[pos], tocopy);
 
     /* Step 2: Read data from beginning of buffer (overflow part) */
-    if (btr > 0) {
-        BUF_MEMCPY(&d[tocopy], buff->buff, btr);
-        buff->r = btr;
-    }
-
-    /* Step 3: Check end of buffer */
-    if (buff->r >= buff->size) {
-        buff->r = 0;
+    if (btr > tocopy) {
+        BUF_MEMCPY(&d[tocopy], buff->buff, btr - tocopy);
     }
-    return tocopy + btr;
+    BUF_STORE(buff->r, BUF_ADD(buff, r, btr), memory_order_release); /* Release memory to writer */
+    return btr;
 }
 
 /**
@@ -176,15 +213,13 @@ BUF_PREF(buff_read)(BUF_PREF(buff_t) * buff, void* data, size_t btr) {
  */
 size_t
 BUF_PREF(buff_peek)(BUF_PREF(buff_t) * buff, size_t skip_count, void* data, size_t btp) {
-    size_t full, tocopy, r;
+    size_t full, tocopy, pos;
     uint8_t* d = data;
 
     if (!BUF_IS_VALID(buff) || btp == 0) {
         return 0;
     }
 
-    r = buff->r;
-
     /* Calculate maximum number of bytes available to read */
     full = BUF_PREF(buff_get_full)(buff);
 
@@ -192,28 +227,21 @@ BUF_PREF(buff_peek)(BUF_PREF(buff_t) * buff, size_t skip_count, void* data, size
     if (skip_count >= full) {
         return 0;
     }
-    r += skip_count;
+    pos = BUF_POS(buff, BUF_ADD(buff, BUF_LOAD(buff->r, memory_order_relaxed), skip_count));
     full -= skip_count;
-    if (r >= buff->size) {
-        r -= buff->size;
-    }
 
     /* Check maximum number of bytes available to read after skip */
     btp = BUF_MIN(full, btp);
-    if (btp == 0) {
-        return 0;
-    }
 
     /* Step 1: Read data from linear part of buffer */
-    tocopy = BUF_MIN(buff->size - r, btp);
-    BUF_MEMCPY(d, &buff->buff[r], tocopy);
-    btp -= tocopy;
+    tocopy = BUF_MIN(buff->size - pos, btp);
+    BUF_MEMCPY(d, &buff->buff[pos], tocopy);
 
     /* Step 2: Read data from beginning of buffer (overflow part) */
-    if (btp > 0) {
-        BUF_MEMCPY(&d[tocopy], buff->buff, btp);
+    if (btp > tocopy) {
+        BUF_MEMCPY(&d[tocopy], buff->buff, btp - tocopy);
     }
-    return tocopy + btp;
+    return btp;
 }
 
 /**
@@ -223,25 +251,18 @@ BUF_PREF(buff_peek)(BUF_PREF(buff_t) * buff, size_t skip_count, void* data, size
  */
 size_t
 BUF_PREF(buff_get_free)(BUF_PREF(buff_t) * buff) {
-    size_t size, w, r;
+    size_t w, r;
 
     if (!BUF_IS_VALID(buff)) {
         return 0;
     }
 
     /* Use temporary values in case they are changed during operations */
-    w = buff->w;
-    r = buff->r;
-    if (w == r) {
-        size = buff->size;
-    } else if (r > w) {
-        size = r - w;
-    } else {
-        size = buff->size - (w - r);
-    }
+    w = BUF_LOAD(buff->w, memory_order_relaxed);
+    r = BUF_LOAD(buff->r, memory_order_acquire);
 
-    /* Buffer free size is always 1 less than actual size */
-    return size - 1;
+    /* Without power-of-two indexes, buffer free size is always 1 less than actual size */
+    return BUF_CAP(buff) - BUF_FULL(buff, w, r);
 }
 
 /**
@@ -251,23 +272,16 @@ BUF_PREF(buff_get_free)(BUF_PREF(buff_t) * buff) {
  */
 size_t
 BUF_PREF(buff_get_full)(BUF_PREF(buff_t) * buff) {
-    size_t w, r, size;
+    size_t w, r;
 
     if (!BUF_IS_VALID(buff)) {
         return 0;
     }
 
     /* Use temporary values in case they are changed during operations */
-    w = buff->w;
-    r = buff->r;
-    if (w == r) {
-        size = 0;
-    } else if (w > r) {
-        size = w - r;
-    } else {
-        size = buff->size - (r - w);
-    }
-    return size;
+    w = BUF_LOAD(buff->w, memory_order_acquire);
+    r = BUF_LOAD(buff->r, memory_order_relaxed);
+    return BUF_FULL(buff, w, r);
 }
 
 /**
@@ -277,8 +291,8 @@ BUF_PREF(buff_get_full)(BUF_PREF(buff_t) * buff) {
 void
 BUF_PREF(buff_reset)(BUF_PREF(buff_t) * buff) {
     if (BUF_IS_VALID(buff)) {
-        buff->w = 0;
-        buff->r = 0;
+        BUF_STORE(buff->w, 0, memory_order_release);
+        BUF_STORE(buff->r, 0, memory_order_release);
     }
 }
 
@@ -292,7 +306,7 @@ BUF_PREF(buff_get_linear_block_read_address)(BUF_PREF(buff_t) * buff) {
     if (!BUF_IS_VALID(buff)) {
         return NULL;
     }
-    return &buff->buff[buff->r];
+    return &buff->buff[BUF_POS(buff, BUF_LOAD(buff->r, memory_order_relaxed))];
 }
 
 /**
@@ -302,23 +316,15 @@ BUF_PREF(buff_get_linear_block_read_address)(BUF_PREF(buff_t) * buff) {
  */
 size_t
 BUF_PREF(buff_get_linear_block_read_length)(BUF_PREF(buff_t) * buff) {
-    size_t w, r, len;
+    size_t full;
 
     if (!BUF_IS_VALID(buff)) {
         return 0;
     }
 
-    /* Use temporary values in case they are changed during operations */
-    w = buff->w;
-    r = buff->r;
-    if (w > r) {
-        len = w - r;
-    } else if (r > w) {
-        len = buff->size - r;
-    } else {
-        len = 0;
-    }
-    return len;
+    /* Data wrap at the end of memory */
+    full = BUF_PREF(buff_get_full)(buff);
+    return BUF_MIN(full, buff->size - BUF_POS(buff, BUF_LOAD(buff->r, memory_order_relaxed)));
 }
 
 /**
@@ -331,17 +337,16 @@ BUF_PREF(buff_get_linear_block_read_length)(BUF_PREF(buff_t) * buff) {
  */
 size_t
 BUF_PREF(buff_skip)(BUF_PREF(buff_t) * buff, size_t len) {
-    size_t full;
+    size_t full, r;
 
     if (!BUF_IS_VALID(buff) || len == 0) {
         return 0;
     }
 
     full = BUF_PREF(buff_get_full)(buff); /* Get buffer used length */
-    buff->r += BUF_MIN(len, full);        /* Advance read pointer */
-    if (buff->r >= buff->size) {          /* Subtract possible overflow */
-        buff->r -= buff->size;
-    }
+    r = BUF_LOAD(buff->r, memory_order_relaxed);
+    r = BUF_ADD(buff, r, BUF_MIN(len, full));    /* Advance read pointer */
+    BUF_STORE(buff->r, r, memory_order_release); /* Release memory to writer */
     return len;
 }
 
@@ -355,7 +360,7 @@ BUF_PREF(buff_get_linear_block_write_address)(BUF_PREF(buff_t) * buff) {
     if (!BUF_IS_VALID(buff)) {
         return NULL;
     }
-    return &buff->buff[buff->w];
+    return &buff->buff[BUF_POS(buff, BUF_LOAD(buff->w, memory_order_relaxed))];
 }
 
 /**
@@ -365,34 +370,19 @@ BUF_PREF(buff_get_linear_block_write_address)(BUF_PREF(buff_t) * buff) {
  */
 size_t
 BUF_PREF(buff_get_linear_block_write_length)(BUF_PREF(buff_t) * buff) {
-    size_t w, r, len;
+    size_t free;
 
     if (!BUF_IS_VALID(buff)) {
         return 0;
     }
 
-    /* Use temporary values in case they are changed during operations */
-    w = buff->w;
-    r = buff->r;
-    if (w >= r) {
-        len = buff->size - w;
-        /*
-         * When read pointer is 0,
-         * maximal length is one less as if too many bytes
-         * are written, buffer would be considered empty again (r == w)
-         */
-        if (r == 0) {
-            /*
-             * Cannot overflow:
-             * - If r is not 0, statement does not get called
-             * - buff->size cannot be 0 and if r is 0, len is greater 0
-             */
-            --len;
-        }
-    } else {
-        len = r - w - 1;
-    }
-    return len;
+    /*
+     * Free memory wraps at the end of memory.
+     * When read pointer is 0, free size is already one less,
+     * as if too many bytes are written, buffer would be considered empty again (r == w)
+     */
+    free = BUF_PREF(buff_get_free)(buff);
+    return BUF_MIN(free, buff->size - BUF_POS(buff, BUF_LOAD(buff->w, memory_order_relaxed)));
 }
 
 /**
@@ -406,16 +396,71 @@ BUF_PREF(buff_get_linear_block_write_length)(BUF_PREF(buff_t) * buff) {
  */
 size_t
 BUF_PREF(buff_advance)(BUF_PREF(buff_t) * buff, size_t len) {
-    size_t free;
+    size_t free, w;
 
     if (!BUF_IS_VALID(buff) || len == 0) {
         return 0;
     }
 
     free = BUF_PREF(buff_get_free)(buff); /* Get buffer free length */
-    buff->w += BUF_MIN(len, free);        /* Advance write pointer */
-    if (buff->w >= buff->size) {          /* Subtract possible overflow */
-        buff->w -= buff->size;
-    }
+    w = BUF_LOAD(buff->w, memory_order_relaxed);
+    w = BUF_ADD(buff, w, BUF_MIN(len, free));    /* Advance write pointer */
+    BUF_STORE(buff->w, w, memory_order_release); /* Publish data to reader */
     return len;
 }
+
+/**
+ * \brief           Get both linear blocks of data available to read with single call
+ *
+ * First block starts at read pointer, second one at the beginning of buffer memory
+ * and has zero length when data do not wrap. Use \ref lwcell_buff_skip to release data after processing.
+ *
+ * \param[in]       buff: Buffer handle
+ * \param[out]      vec: Array of `2` entries to save blocks to
+ * \return          Number of bytes available to read, sum of both block lengths
+ */
+size_t
+BUF_PREF(buff_get_read_vec)(BUF_PREF(buff_t) * buff, BUF_PREF(buff_vec_t) vec[2]) {
+    size_t full, pos;
+
+    if (!BUF_IS_VALID(buff)) {
+        BUF_MEMSET(vec, 0x00, 2 * sizeof(*vec));
+        return 0;
+    }
+
+    full = BUF_PREF(buff_get_full)(buff);
+    pos = BUF_POS(buff, BUF_LOAD(buff->r, memory_order_relaxed));
+    vec[0].data = &buff->buff[pos];
+    vec[0].len = BUF_MIN(full, buff->size - pos);
+    vec[1].data = buff->buff;
+    vec[1].len = full - vec[0].len;
+    return full;
+}
+
+/**
+ * \brief           Get both linear blocks of memory available to write with single call
+ *
+ * First block starts at write pointer, second one at the beginning of buffer memory
+ * and has zero length when free memory does not wrap. Use \ref lwcell_buff_advance to publish written data.
+ *
+ * \param[in]       buff: Buffer handle
+ * \param[out]      vec: Array of `2` entries to save blocks to
+ * \return          Number of bytes available to write, sum of both block lengths
+ */
+size_t
+BUF_PREF(buff_get_write_vec)(BUF_PREF(buff_t) * buff, BUF_PREF(buff_vec_t) vec[2]) {
+    size_t free, pos;
+
+    if (!BUF_IS_VALID(buff)) {
+        BUF_MEMSET(vec, 0x00, 2 * sizeof(*vec));
+        return 0;
+    }
+
+    free = BUF_PREF(buff_get_free)(buff);
+    pos = BUF_POS(buff, BUF_LOAD(buff->w, memory_order_relaxed));
+    vec[0].data = &buff->buff[pos];
+    vec[0].len = BUF_MIN(free, buff->size - pos);
+    vec[1].data = buff->buff;
+    vec[1].len = free - vec[0].len;
+    return free;
+}
@@ -80,7 +80,7 @@ lwcellr_t
 lwcell_call_enable(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
     LWCELL_MSG_VAR_DEFINE(msg);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE_HDR);
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CALL_ENABLE;
     LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CLCC_SET;
@@ -124,7 +124,7 @@ lwcell_call_start(const char* number, const lwcell_api_cmd_evt_fn evt_fn, void*
     CHECK_ENABLED(); /* Check if enabled */
     LWCELL_ASSERT(check_ready() == lwcellOK);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(call_start));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_ATD;
     LWCELL_MSG_VAR_REF(msg).msg.call_start.number = number;
@@ -145,13 +145,38 @@ lwcell_call_answer(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, cons
 
     CHECK_ENABLED();
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE_HDR);
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_ATA;
 
     return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 10000);
 }
 
+#if LWCELL_CFG_CALL_AUTO_ANSWER > 0 || __DOXYGEN__
+
+/**
+ * \brief           Answer incoming call from processing thread
+ * \note            Function must be called with core locked.
+ *                  Answer goes to producer priority lane, ahead of commands waiting in regular queue
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcelli_call_auto_answer(void) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    if (!lwcell.m.call.enabled) {
+        return lwcellERRNOTENABLED;
+    }
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, 0, LWCELL_MSG_SIZE_HDR);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_ATA;
+    LWCELL_MSG_VAR_REF(msg).is_prio = 1; /* Answer before commands waiting in regular queue */
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 10000);
+}
+
+#endif /* LWCELL_CFG_CALL_AUTO_ANSWER > 0 || __DOXYGEN__ */
+
 /**
  * \brief           Hang-up incoming or active call
  * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
@@ -165,7 +190,7 @@ lwcell_call_hangup(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, cons
 
     CHECK_ENABLED();
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE_HDR);
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_ATH;
 
@@ -0,0 +1,81 @@
+/**
+ * \file            lwcell_cell_info.c
+ * \brief           Cell info API
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_cell_info.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_CELL_INFO || __DOXYGEN__
+
+/**
+ * \brief           Enable or disable engineering mode with periodic cell info reports
+ * \param[in]       enable: Set to `1` to enable reports, `0` to disable them
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_cell_info_enable(uint8_t enable, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                        const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(cell_info));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CENG;
+    LWCELL_MSG_VAR_REF(msg).msg.cell_info.enable = enable > 0;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 10000);
+}
+
+/**
+ * \brief           Get snapshot of last reported serving and neighbour cells
+ * \note            No command is sent to device
+ * \param[out]      info: Pointer to output variable to save cell info to
+ * \return          \ref lwcellOK on success, \ref lwcellERR when no report was received since reports were enabled
+ */
+lwcellr_t
+lwcell_cell_info_get(lwcell_cell_info_t* info) {
+    lwcellr_t res = lwcellERR;
+
+    LWCELL_ASSERT(info != NULL);
+
+    lwcell_core_lock();
+    if (lwcell.m.cell_info.valid) {
+        *info = lwcell.m.cell_info;
+        res = lwcellOK;
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+#endif /* LWCELL_CFG_CELL_INFO || __DOXYGEN__ */
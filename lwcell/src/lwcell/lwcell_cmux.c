@@ -0,0 +1,396 @@
+/**
+ * \file            lwcell_cmux.c
+ * \brief           GSM 07.10 multiplexer
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_cmux.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_CMUX || __DOXYGEN__
+
+/* Frame flag and control field values, without poll/final bit */
+#define CMUX_FLAG      0xF9
+#define CMUX_CTRL_PF   0x10
+#define CMUX_CTRL_SABM 0x2F
+#define CMUX_CTRL_UA   0x63
+#define CMUX_CTRL_UIH  0xEF
+#define CMUX_CTRL_UI   0x03
+
+/* Control channel message type command/response bit and close down command */
+#define CMUX_MSG_CR    0x02
+#define CMUX_MSG_CLD   0xC1
+
+/**
+ * \brief           Calculate frame check sequence
+ * \param[in]       data: Address, control and length fields
+ * \param[in]       len: Length of fields
+ * \return          Frame check sequence
+ */
+static uint8_t
+prv_cmux_fcs(const uint8_t* data, size_t len) {
+    uint8_t fcs = 0xFF;
+
+    while (len-- > 0) {
+        fcs ^= *data++;
+        for (uint8_t i = 0; i < 8; ++i) {
+            fcs = (fcs & 0x01) ? ((fcs >> 1) ^ 0xE0) : (fcs >> 1);
+        }
+    }
+    return LWCELL_U8(0xFF - fcs);
+}
+
+/**
+ * \brief           Send single frame to low-level driver
+ * \param[in]       dlci: Channel DLCI
+ * \param[in]       ctrl: Control field
+ * \param[in]       data: Information field. Set to `NULL` if not used
+ * \param[in]       len: Length of information field, up to \ref LWCELL_CFG_CMUX_FRAME_LEN bytes
+ */
+static void
+prv_cmux_send_frame(uint8_t dlci, uint8_t ctrl, const void* data, size_t len) {
+    uint8_t hdr[4], tail[2];
+
+    hdr[0] = CMUX_FLAG;
+    hdr[1] = LWCELL_U8((dlci << 2) | 0x03); /* Commands from initiator, single byte address */
+    hdr[2] = ctrl;
+    hdr[3] = LWCELL_U8((len << 1) | 0x01);  /* Single byte length */
+    tail[0] = prv_cmux_fcs(&hdr[1], 3);
+    tail[1] = CMUX_FLAG;
+
+    lwcell.cmux.ll_send_fn(hdr, sizeof(hdr));
+    if (len > 0) {
+        lwcell.cmux.ll_send_fn(data, len);
+    }
+    lwcell.cmux.ll_send_fn(tail, sizeof(tail));
+}
+
+/**
+ * \brief           Send stack channel data collected so far in single frame
+ */
+static void
+prv_cmux_at_flush(void) {
+    if (lwcell.cmux.tx_len > 0) {
+        prv_cmux_send_frame(LWCELL_CMUX_AT_DLCI, CMUX_CTRL_UIH, lwcell.cmux.tx_buff, lwcell.cmux.tx_len);
+        lwcell.cmux.tx_len = 0;
+    }
+}
+
+/**
+ * \brief           Send function for stack channel, installed as low-level send function
+ *
+ * Data is collected to frame until flush request or until frame is full
+ *
+ * \param[in]       data: Data to send. Set to `NULL` to flush
+ * \param[in]       len: Length of data to send
+ * \return          Number of bytes accepted
+ */
+static size_t
+prv_cmux_at_send(const void* data, size_t len) {
+    const uint8_t* d = data;
+
+    if (d == NULL || len == 0) {
+        prv_cmux_at_flush();
+        lwcell.cmux.ll_send_fn(NULL, 0);
+        return 0;
+    }
+    for (size_t i = 0; i < len;) {
+        size_t cnt = LWCELL_MIN(len - i, sizeof(lwcell.cmux.tx_buff) - lwcell.cmux.tx_len);
+
+        LWCELL_MEMCPY(&lwcell.cmux.tx_buff[lwcell.cmux.tx_len], &d[i], cnt);
+        lwcell.cmux.tx_len += cnt;
+        i += cnt;
+        if (lwcell.cmux.tx_len == sizeof(lwcell.cmux.tx_buff)) {
+            prv_cmux_at_flush();
+        }
+    }
+    return len;
+}
+
+/**
+ * \brief           Leave multiplexer mode and restore low-level send function
+ */
+static void
+prv_cmux_exit(void) {
+    if (!lwcell.cmux.active) {
+        return;
+    }
+    if (lwcell.ll.send_fn == prv_cmux_at_send) { /* Driver may have been initialized again meanwhile */
+        lwcell.ll.send_fn = lwcell.cmux.ll_send_fn;
+    }
+    lwcell.cmux.active = 0;
+    lwcell.cmux.tx_len = 0;
+    lwcell.cmux.rx_state = LWCELL_CMUX_RX_FLAG;
+}
+
+/**
+ * \brief           Process complete received frame
+ */
+static void
+prv_cmux_frame_received(void) {
+    uint8_t dlci = LWCELL_U8(lwcell.cmux.rx_hdr[0] >> 2);
+    uint8_t ctrl = LWCELL_U8(lwcell.cmux.rx_hdr[1] & ~CMUX_CTRL_PF);
+
+    if (ctrl != CMUX_CTRL_UIH && ctrl != CMUX_CTRL_UI) {
+        return; /* Channel establishment replies need no action */
+    }
+    if (dlci == 0) {
+        if (lwcell.cmux.rx_len == 0) {
+            return;
+        }
+        if (lwcell.cmux.rx_buff[0] & CMUX_MSG_CR) { /* Device command, reply with the same content */
+            lwcell.cmux.rx_buff[0] &= LWCELL_U8(~CMUX_MSG_CR);
+            prv_cmux_send_frame(0, CMUX_CTRL_UIH, lwcell.cmux.rx_buff, lwcell.cmux.rx_len);
+            lwcell.cmux.ll_send_fn(NULL, 0);
+        } else if (lwcell.cmux.rx_buff[0] == CMUX_MSG_CLD) { /* Close down confirmed */
+            prv_cmux_exit();
+        }
+    } else if (dlci == LWCELL_CMUX_AT_DLCI) {
+        lwcell.cmux.in_frame = 1;
+        lwcelli_process(lwcell.cmux.rx_buff, lwcell.cmux.rx_len);
+        lwcell.cmux.in_frame = 0;
+#if LWCELL_CFG_PPP
+    } else if (lwcelli_ppp_channel_input(dlci, lwcell.cmux.rx_buff, lwcell.cmux.rx_len)) {
+        /* Channel carries PPP session */
+#endif /* LWCELL_CFG_PPP */
+    } else if (lwcell.cmux.rx_fn != NULL && dlci <= lwcell.cmux.channels + LWCELL_CMUX_AT_DLCI) {
+        lwcell.cmux.rx_fn(dlci, lwcell.cmux.rx_buff, lwcell.cmux.rx_len, lwcell.cmux.rx_arg);
+    }
+}
+
+/**
+ * \brief           Decode received data when multiplexer is active
+ * \note            Function must be called with core locked
+ * \param[in]       data: Received data
+ * \param[in]       len: Length of received data
+ * \return          `1` if data was consumed by multiplexer, `0` if it shall be processed as AT data
+ */
+uint8_t
+lwcelli_cmux_input(const void* data, size_t len) {
+    const uint8_t* d = data;
+
+    if (!lwcell.cmux.active || lwcell.cmux.in_frame) {
+        return 0;
+    }
+    for (size_t i = 0; i < len && lwcell.cmux.active; ++i) {
+        uint8_t ch = d[i];
+
+        switch (lwcell.cmux.rx_state) {
+            case LWCELL_CMUX_RX_FLAG: {
+                if (ch == CMUX_FLAG) {
+                    lwcell.cmux.rx_state = LWCELL_CMUX_RX_ADDR;
+                }
+                break;
+            }
+            case LWCELL_CMUX_RX_ADDR: {
+                if (ch != CMUX_FLAG) { /* Repeated flag is closing flag of previous frame */
+                    lwcell.cmux.rx_hdr[0] = ch;
+                    lwcell.cmux.rx_hdr_len = 1;
+                    lwcell.cmux.rx_state = LWCELL_CMUX_RX_CTRL;
+                }
+                break;
+            }
+            case LWCELL_CMUX_RX_CTRL: {
+                lwcell.cmux.rx_hdr[lwcell.cmux.rx_hdr_len++] = ch;
+                lwcell.cmux.rx_state = LWCELL_CMUX_RX_LEN;
+                break;
+            }
+            case LWCELL_CMUX_RX_LEN:
+            case LWCELL_CMUX_RX_LEN2: {
+                lwcell.cmux.rx_hdr[lwcell.cmux.rx_hdr_len++] = ch;
+                if (lwcell.cmux.rx_state == LWCELL_CMUX_RX_LEN) {
+                    lwcell.cmux.rx_len = ch >> 1;
+                } else {
+                    lwcell.cmux.rx_len |= (size_t)ch << 7;
+                }
+                if (lwcell.cmux.rx_state == LWCELL_CMUX_RX_LEN && !(ch & 0x01)) {
+                    lwcell.cmux.rx_state = LWCELL_CMUX_RX_LEN2;
+                } else if (lwcell.cmux.rx_len > sizeof(lwcell.cmux.rx_buff)) {
+                    lwcell.cmux.rx_state = LWCELL_CMUX_RX_FLAG; /* Frame too long, drop it */
+                } else {
+                    lwcell.cmux.rx_pos = 0;
+                    lwcell.cmux.rx_state = lwcell.cmux.rx_len > 0 ? LWCELL_CMUX_RX_DATA : LWCELL_CMUX_RX_FCS;
+                }
+                break;
+            }
+            case LWCELL_CMUX_RX_DATA: {
+                lwcell.cmux.rx_buff[lwcell.cmux.rx_pos++] = ch;
+                if (lwcell.cmux.rx_pos == lwcell.cmux.rx_len) {
+                    lwcell.cmux.rx_state = LWCELL_CMUX_RX_FCS;
+                }
+                break;
+            }
+            case LWCELL_CMUX_RX_FCS: {
+                lwcell.cmux.rx_state = LWCELL_CMUX_RX_FLAG;
+                if (ch == prv_cmux_fcs(lwcell.cmux.rx_hdr, lwcell.cmux.rx_hdr_len)) {
+                    prv_cmux_frame_received();
+                }
+                break;
+            }
+            default: break;
+        }
+    }
+    return 1;
+}
+
+/**
+ * \brief           Enter multiplexer mode after device accepted `AT+CMUX` command
+ * \note            Function must be called with core locked
+ */
+void
+lwcelli_cmux_enter(void) {
+    if (lwcell.cmux.active) {
+        return;
+    }
+    lwcell.cmux.ll_send_fn = lwcell.ll.send_fn;
+    lwcell.cmux.tx_len = 0;
+    lwcell.cmux.rx_state = LWCELL_CMUX_RX_FLAG;
+
+    /* Open control, stack and application channels */
+    for (uint8_t dlci = 0; dlci <= lwcell.cmux.channels + LWCELL_CMUX_AT_DLCI; ++dlci) {
+        prv_cmux_send_frame(dlci, CMUX_CTRL_SABM | CMUX_CTRL_PF, NULL, 0);
+    }
+    lwcell.cmux.ll_send_fn(NULL, 0);
+
+    lwcell.ll.send_fn = prv_cmux_at_send;
+    lwcell.cmux.active = 1;
+}
+
+/**
+ * \brief           Reset multiplexer state, device has left multiplexer mode
+ * \note            Function must be called with core locked
+ */
+void
+lwcelli_cmux_reset(void) {
+    prv_cmux_exit();
+}
+
+/**
+ * \brief           Start multiplexer mode
+ *
+ * Stack channel \ref LWCELL_CMUX_AT_DLCI and `channels` application channels,
+ * DLCI `2` and up, are opened once device accepts the command
+ *
+ * \param[in]       channels: Number of application channels
+ * \param[in]       rx_fn: Application channel data callback. Set to `NULL` if not used
+ * \param[in]       rx_arg: Custom argument for data callback
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_cmux_start(uint8_t channels, lwcell_cmux_rx_fn rx_fn, void* rx_arg, const lwcell_api_cmd_evt_fn evt_fn,
+                  void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(channels <= 61);
+
+    lwcell_core_lock();
+    if (lwcell.cmux.active) {
+        lwcell_core_unlock();
+        return lwcellERR;
+    }
+    lwcell.cmux.channels = channels;
+    lwcell.cmux.rx_fn = rx_fn;
+    lwcell.cmux.rx_arg = rx_arg;
+    lwcell_core_unlock();
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE_HDR);
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CMUX;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 10000);
+}
+
+/**
+ * \brief           Close multiplexer and return device to single AT channel mode
+ * \note            Function shall be called when no command is in progress
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_cmux_stop(void) {
+    static const uint8_t cld[] = {CMUX_MSG_CLD | CMUX_MSG_CR, 0x01};
+    lwcellr_t res = lwcellERR;
+
+    lwcell_core_lock();
+    if (lwcell.cmux.active) {
+        prv_cmux_at_flush();
+        prv_cmux_send_frame(0, CMUX_CTRL_UIH, cld, sizeof(cld));
+        lwcell.cmux.ll_send_fn(NULL, 0);
+        prv_cmux_exit();
+        res = lwcellOK;
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Send data on application channel
+ * \param[in]       dlci: Channel DLCI, starting with `2`
+ * \param[in]       data: Data to send
+ * \param[in]       len: Length of data to send
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_cmux_channel_send(uint8_t dlci, const void* data, size_t len) {
+    const uint8_t* d = data;
+    lwcellr_t res = lwcellERR;
+
+    LWCELL_ASSERT(dlci > LWCELL_CMUX_AT_DLCI);
+    LWCELL_ASSERT(data != NULL && len > 0);
+
+    lwcell_core_lock();
+    if (lwcell.cmux.active && dlci <= lwcell.cmux.channels + LWCELL_CMUX_AT_DLCI) {
+        for (size_t i = 0; i < len; i += LWCELL_CFG_CMUX_FRAME_LEN) {
+            prv_cmux_send_frame(dlci, CMUX_CTRL_UIH, &d[i], LWCELL_MIN(len - i, LWCELL_CFG_CMUX_FRAME_LEN));
+        }
+        lwcell.cmux.ll_send_fn(NULL, 0);
+        res = lwcellOK;
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Check if multiplexer mode is active
+ * \return          `1` if active, `0` otherwise
+ */
+uint8_t
+lwcell_cmux_is_active(void) {
+    uint8_t res;
+
+    lwcell_core_lock();
+    res = lwcell.cmux.active;
+    lwcell_core_unlock();
+    return res;
+}
+
+#endif /* LWCELL_CFG_CMUX || __DOXYGEN__ */
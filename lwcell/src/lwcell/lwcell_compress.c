@@ -0,0 +1,427 @@
+/**
+ * \file            lwcell_compress.c
+ * \brief           Payload compression
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_compress.h"
+#include "lwcell/lwcell_pbuf.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_COMPRESS || __DOXYGEN__
+
+#define COMPRESS_MIN_MATCH  4       /*!< Minimal match length, shorter repetitions are stored as literals */
+#define COMPRESS_FRAME_FLAG 0x8000U /*!< Frame header flag for compressed payload */
+#define COMPRESS_FRAME_MASK 0x7FFFU /*!< Frame header mask for payload length */
+
+/**
+ * \brief           Read `4` bytes as little-endian number
+ * \param[in]       p: Pointer to data
+ * \return          Read value
+ */
+static uint32_t
+prv_read32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * \brief           Get hash table index of `4` bytes sequence
+ * \param[in]       v: Sequence value
+ * \return          Hash table index
+ */
+static uint32_t
+prv_hash(uint32_t v) {
+    return (v * 2654435761U) >> (32 - LWCELL_CFG_COMPRESS_HASH_BITS);
+}
+
+/**
+ * \brief           Write length continuation bytes
+ * \param[out]      out: Output buffer
+ * \param[in,out]   op: Output position
+ * \param[in]       out_size: Size of output buffer
+ * \param[in]       len: Length to write, already reduced by token nibble
+ * \return          `1` on success, `0` if output buffer is full
+ */
+static uint8_t
+prv_put_len(uint8_t* out, size_t* op, size_t out_size, size_t len) {
+    for (; len >= 255; len -= 255) {
+        if (*op >= out_size) {
+            return 0;
+        }
+        out[(*op)++] = 255;
+    }
+    if (*op >= out_size) {
+        return 0;
+    }
+    out[(*op)++] = (uint8_t)len;
+    return 1;
+}
+
+/**
+ * \brief           Write single token with literals and optional match
+ * \param[out]      out: Output buffer
+ * \param[in,out]   op: Output position
+ * \param[in]       out_size: Size of output buffer
+ * \param[in]       lit: Literals
+ * \param[in]       lit_len: Number of literals
+ * \param[in]       off: Match offset
+ * \param[in]       mlen: Match length. Set to `0` for last token with literals only
+ * \return          `1` on success, `0` if output buffer is full
+ */
+static uint8_t
+prv_put_seq(uint8_t* out, size_t* op, size_t out_size, const uint8_t* lit, size_t lit_len, size_t off, size_t mlen) {
+    size_t ml = mlen > 0 ? mlen - COMPRESS_MIN_MATCH : 0;
+
+    if (*op >= out_size) {
+        return 0;
+    }
+    out[(*op)++] = (uint8_t)((LWCELL_MIN(lit_len, 15U) << 4) | LWCELL_MIN(ml, 15U));
+    if ((lit_len >= 15 && !prv_put_len(out, op, out_size, lit_len - 15)) || out_size - *op < lit_len) {
+        return 0;
+    }
+    LWCELL_MEMCPY(&out[*op], lit, lit_len);
+    *op += lit_len;
+    if (mlen > 0) {
+        if (out_size - *op < 2) {
+            return 0;
+        }
+        out[(*op)++] = (uint8_t)off;
+        out[(*op)++] = (uint8_t)(off >> 8);
+        if (ml >= 15 && !prv_put_len(out, op, out_size, ml - 15)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * \brief           Read length continuation bytes
+ * \param[in]       in: Input data
+ * \param[in,out]   ip: Input position
+ * \param[in]       len: Length of input data
+ * \param[in,out]   val: Length to increase
+ * \return          `1` on success, `0` if input is truncated
+ */
+static uint8_t
+prv_get_len(const uint8_t* in, size_t* ip, size_t len, size_t* val) {
+    uint8_t b;
+
+    do {
+        if (*ip >= len) {
+            return 0;
+        }
+        b = in[(*ip)++];
+        *val += b;
+    } while (b == 255);
+    return 1;
+}
+
+/**
+ * \brief           Compress single block
+ * \param[in]       comp: Compressor state
+ * \param[in]       data: Data to compress
+ * \param[in]       len: Length of data in units of bytes. Must not be greater than `65534`
+ * \param[out]      out: Output buffer
+ * \param[in]       out_size: Size of output buffer
+ * \return          Compressed length, `0` when output does not fit to buffer
+ */
+size_t
+lwcell_compress_block(lwcell_compress_t* comp, const void* data, size_t len, void* out, size_t out_size) {
+    const uint8_t* in = data;
+    size_t ip = 0, anchor = 0, op = 0, ref, mlen;
+
+    LWCELL_ASSERT0(comp != NULL);
+    LWCELL_ASSERT0(data != NULL || len == 0);
+    LWCELL_ASSERT0(out != NULL);
+    LWCELL_ASSERT0(len < 0xFFFF);
+
+    LWCELL_MEMSET(comp->hash, 0x00, sizeof(comp->hash));
+    while (ip + COMPRESS_MIN_MATCH <= len) {
+        uint32_t h = prv_hash(prv_read32(&in[ip]));
+
+        ref = comp->hash[h];
+        comp->hash[h] = (uint16_t)(ip + 1);
+        if (ref == 0 || prv_read32(&in[ref - 1]) != prv_read32(&in[ip])) {
+            ++ip;
+            continue;
+        }
+        --ref;
+        mlen = COMPRESS_MIN_MATCH;
+        while (ip + mlen < len && in[ref + mlen] == in[ip + mlen]) {
+            ++mlen;
+        }
+        if (!prv_put_seq(out, &op, out_size, &in[anchor], ip - anchor, ip - ref, mlen)) {
+            return 0;
+        }
+        ip += mlen;
+        anchor = ip;
+    }
+    if (!prv_put_seq(out, &op, out_size, &in[anchor], len - anchor, 0, 0)) {
+        return 0;
+    }
+    return op;
+}
+
+/**
+ * \brief           Decompress single block
+ * \param[in]       data: Compressed data
+ * \param[in]       len: Length of compressed data in units of bytes
+ * \param[out]      out: Output buffer
+ * \param[in]       out_size: Size of output buffer
+ * \return          Decompressed length, `0` on malformed data or when output does not fit to buffer
+ */
+size_t
+lwcell_decompress_block(const void* data, size_t len, void* out, size_t out_size) {
+    const uint8_t* in = data;
+    uint8_t* o = out;
+    size_t ip = 0, op = 0, lit, ml, off;
+
+    LWCELL_ASSERT0(data != NULL || len == 0);
+    LWCELL_ASSERT0(out != NULL);
+
+    while (ip < len) {
+        uint8_t token = in[ip++];
+
+        lit = token >> 4;
+        if ((lit == 15 && !prv_get_len(in, &ip, len, &lit)) || len - ip < lit || out_size - op < lit) {
+            return 0;
+        }
+        LWCELL_MEMCPY(&o[op], &in[ip], lit);
+        ip += lit;
+        op += lit;
+        if (ip == len) {
+            break; /* Last token has literals only */
+        }
+        if (len - ip < 2) {
+            return 0;
+        }
+        off = (size_t)in[ip] | ((size_t)in[ip + 1] << 8);
+        ip += 2;
+        ml = token & 0x0F;
+        if (ml == 15 && !prv_get_len(in, &ip, len, &ml)) {
+            return 0;
+        }
+        ml += COMPRESS_MIN_MATCH;
+        if (off == 0 || off > op || out_size - op < ml) {
+            return 0;
+        }
+        for (; ml > 0; --ml, ++op) { /* Match may overlap its own output */
+            o[op] = o[op - off];
+        }
+    }
+    return op;
+}
+
+/**
+ * \brief           Compress block to frame in compressor state
+ *
+ * Block is stored raw when compressed payload would not be shorter.
+ * Frame is available in \ref lwcell_compress_t::frame until next call
+ *
+ * \param[in]       comp: Compressor state
+ * \param[in]       data: Data to compress
+ * \param[in]       len: Length of data in units of bytes.
+ *                      Must not be greater than \ref LWCELL_CFG_COMPRESS_BLOCK_LEN
+ * \return          Frame length in units of bytes, `0` on invalid parameters
+ */
+size_t
+lwcell_compress_frame(lwcell_compress_t* comp, const void* data, size_t len) {
+    size_t n = 0;
+    uint16_t hdr;
+
+    LWCELL_ASSERT0(comp != NULL);
+    LWCELL_ASSERT0(data != NULL || len == 0);
+    LWCELL_ASSERT0(len <= LWCELL_CFG_COMPRESS_BLOCK_LEN);
+
+    /* Compressed payload must be shorter than raw one */
+    if (len > 1) {
+        n = lwcell_compress_block(comp, data, len, &comp->frame[LWCELL_COMPRESS_FRAME_HDR_LEN], len - 1);
+    }
+    if (n > 0) {
+        hdr = (uint16_t)(COMPRESS_FRAME_FLAG | n);
+    } else {
+        LWCELL_MEMCPY(&comp->frame[LWCELL_COMPRESS_FRAME_HDR_LEN], data, len);
+        n = len;
+        hdr = (uint16_t)len;
+    }
+    comp->frame[0] = (uint8_t)(hdr >> 8);
+    comp->frame[1] = (uint8_t)hdr;
+    return LWCELL_COMPRESS_FRAME_HDR_LEN + n;
+}
+
+/**
+ * \brief           Decode complete frame
+ * \param[in]       frame: Frame with header
+ * \param[in]       frame_len: Length of frame in units of bytes
+ * \param[out]      out: Output buffer
+ * \param[in]       out_size: Size of output buffer
+ * \param[out]      out_len: Decompressed length
+ * \return          `1` on success, `0` on malformed frame or when output does not fit to buffer
+ */
+static uint8_t
+prv_frame_decode(const uint8_t* frame, size_t frame_len, void* out, size_t out_size, size_t* out_len) {
+    uint16_t hdr;
+    size_t len;
+
+    if (frame_len < LWCELL_COMPRESS_FRAME_HDR_LEN) {
+        return 0;
+    }
+    hdr = (uint16_t)(((uint16_t)frame[0] << 8) | frame[1]);
+    len = hdr & COMPRESS_FRAME_MASK;
+    if (frame_len != LWCELL_COMPRESS_FRAME_HDR_LEN + len) {
+        return 0;
+    }
+    frame += LWCELL_COMPRESS_FRAME_HDR_LEN;
+    if (hdr & COMPRESS_FRAME_FLAG) {
+        *out_len = lwcell_decompress_block(frame, len, out, out_size);
+        return *out_len > 0;
+    }
+    if (len > out_size) {
+        return 0;
+    }
+    LWCELL_MEMCPY(out, frame, len);
+    *out_len = len;
+    return 1;
+}
+
+/**
+ * \brief           Decompress complete frame, for example MQTT message payload
+ * \param[in]       frame: Frame with header
+ * \param[in]       frame_len: Length of frame in units of bytes
+ * \param[out]      out: Output buffer
+ * \param[in]       out_size: Size of output buffer
+ * \return          Decompressed length, `0` on malformed frame, empty frame
+ *                  or when output does not fit to buffer
+ */
+size_t
+lwcell_decompress_frame(const void* frame, size_t frame_len, void* out, size_t out_size) {
+    size_t len = 0;
+
+    LWCELL_ASSERT0(frame != NULL);
+    LWCELL_ASSERT0(out != NULL);
+
+    return prv_frame_decode(frame, frame_len, out, out_size, &len) ? len : 0;
+}
+
+/**
+ * \brief           Get length of frame currently received by stream decompressor
+ * \param[in]       dec: Decompressor state
+ * \return          Frame length, or header length while header is not complete
+ */
+static size_t
+prv_frame_len(const lwcell_decompress_t* dec) {
+    if (dec->frame_len < LWCELL_COMPRESS_FRAME_HDR_LEN) {
+        return LWCELL_COMPRESS_FRAME_HDR_LEN;
+    }
+    return LWCELL_COMPRESS_FRAME_HDR_LEN + ((((size_t)dec->frame[0] << 8) | dec->frame[1]) & COMPRESS_FRAME_MASK);
+}
+
+/**
+ * \brief           Reset stream decompressor state
+ * \param[in]       dec: Decompressor state
+ */
+void
+lwcell_decompress_init(lwcell_decompress_t* dec) {
+    dec->frame_len = 0;
+}
+
+/**
+ * \brief           Feed received stream data to decompressor
+ *
+ * Data may be split to any number of calls, callback is called for every decompressed block
+ *
+ * \param[in]       dec: Decompressor state
+ * \param[in]       data: Received data
+ * \param[in]       len: Length of data in units of bytes
+ * \param[in]       fn: Callback function for decompressed blocks
+ * \param[in]       arg: Custom user argument for callback
+ * \return          \ref lwcellOK on success, \ref lwcellERR on malformed stream,
+ *                  callback result when callback stopped decompression
+ */
+lwcellr_t
+lwcell_decompress_feed(lwcell_decompress_t* dec, const void* data, size_t len, lwcell_decompress_fn fn, void* arg) {
+    const uint8_t* d = data;
+    size_t n, flen;
+    lwcellr_t res;
+
+    LWCELL_ASSERT(dec != NULL);
+    LWCELL_ASSERT(data != NULL || len == 0);
+    LWCELL_ASSERT(fn != NULL);
+
+    while (len > 0) {
+        n = LWCELL_MIN(prv_frame_len(dec) - dec->frame_len, len);
+        LWCELL_MEMCPY(&dec->frame[dec->frame_len], d, n);
+        dec->frame_len += n;
+        d += n;
+        len -= n;
+
+        if ((flen = prv_frame_len(dec)) > sizeof(dec->frame)) {
+            dec->frame_len = 0;
+            return lwcellERR; /* Sender uses longer blocks */
+        }
+        if (dec->frame_len < LWCELL_COMPRESS_FRAME_HDR_LEN || dec->frame_len < flen) {
+            continue;
+        }
+        dec->frame_len = 0;
+        if (!prv_frame_decode(dec->frame, flen, dec->block, sizeof(dec->block), &n)) {
+            return lwcellERR;
+        }
+        if (n > 0 && (res = fn(dec->block, n, arg)) != lwcellOK) {
+            return res;
+        }
+    }
+    return lwcellOK;
+}
+
+/**
+ * \brief           Feed received packet buffer chain to decompressor
+ * \note            Packet buffer is not freed by this function
+ * \param[in]       dec: Decompressor state
+ * \param[in]       pbuf: Packet buffer chain with received data
+ * \param[in]       fn: Callback function for decompressed blocks
+ * \param[in]       arg: Custom user argument for callback
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_decompress_feed_pbuf(lwcell_decompress_t* dec, lwcell_pbuf_p pbuf, lwcell_decompress_fn fn, void* arg) {
+    const void* d;
+    size_t off = 0, len;
+    lwcellr_t res = lwcellOK;
+
+    LWCELL_ASSERT(pbuf != NULL);
+
+    while (res == lwcellOK && (d = lwcell_pbuf_get_linear_addr(pbuf, off, &len)) != NULL && len > 0) {
+        res = lwcell_decompress_feed(dec, d, len, fn, arg);
+        off += len;
+    }
+    return res;
+}
+
+#endif /* LWCELL_CFG_COMPRESS || __DOXYGEN__ */
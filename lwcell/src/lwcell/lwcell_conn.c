@@ -53,33 +53,306 @@
         }                                                                                                              \
     } while (0)
 
+#if LWCELL_CFG_USAGE
 /**
- * \brief           Timeout callback for connection
- * \param[in]       arg: Timeout callback custom argument
+ * \brief           Check if sending on connection is blocked by data quota
+ * \param[in]       conn: Connection handle
+ */
+#define CONN_CHECK_QUOTA(conn)                                                                                         \
+    do {                                                                                                               \
+        if (lwcelli_usage_is_throttled(conn)) {                                                                        \
+            return lwcellERRQUOTA;                                                                                     \
+        }                                                                                                              \
+    } while (0)
+#else /* LWCELL_CFG_USAGE */
+#define CONN_CHECK_QUOTA(conn)
+#endif /* !LWCELL_CFG_USAGE */
+
+static void prv_conn_poll_cb(void* arg);
+
+/**
+ * \brief           Schedule shared poll timeout to the earliest poll of active connections
+ *
+ * Timeout is stopped when no active connection has poll enabled
+ *
+ * \note            Function must be called with core locked
+ */
+static void
+prv_conn_poll_schedule(void) {
+    uint32_t now = lwcell_sys_now(), elapsed, diff, min_diff = 0;
+    uint8_t found = 0;
+
+    for (size_t i = 0; i < LWCELL_CFG_MAX_CONNS; ++i) {
+        lwcell_conn_p conn = &lwcell.m.conns[i];
+
+        if (!conn->status.f.active || conn->poll_interval == 0) {
+            continue;
+        }
+        elapsed = now - conn->poll_time;
+        diff = elapsed >= conn->poll_interval ? 0 : conn->poll_interval - elapsed;
+        if (!found || diff < min_diff) {
+            min_diff = diff;
+            found = 1;
+        }
+    }
+    if (found) {
+        lwcell_timeout_start(&lwcell.conn_poll_timeout, min_diff, prv_conn_poll_cb, NULL);
+    } else if (lwcell_timeout_is_active(&lwcell.conn_poll_timeout)) {
+        lwcell_timeout_stop(&lwcell.conn_poll_timeout);
+    }
+}
+
+/**
+ * \brief           Poll timeout callback, sends poll event to every connection with expired interval
+ * \param[in]       arg: Timeout callback custom argument, not used
  */
 static void
-conn_timeout_cb(void* arg) {
-    lwcell_conn_p conn = arg;                   /* Argument is actual connection */
+prv_conn_poll_cb(void* arg) {
+    uint32_t now = lwcell_sys_now();
 
-    if (conn->status.f.active) {                /* Handle only active connections */
-        lwcell.evt.type = LWCELL_EVT_CONN_POLL; /* Poll connection event */
-        lwcell.evt.evt.conn_poll.conn = conn;   /* Set connection pointer */
-        lwcelli_send_conn_cb(conn, NULL);       /* Send connection callback */
+    LWCELL_UNUSED(arg);
+    for (size_t i = 0; i < LWCELL_CFG_MAX_CONNS; ++i) {
+        lwcell_conn_p conn = &lwcell.m.conns[i];
 
-        lwcelli_conn_start_timeout(conn);       /* Schedule new timeout */
-        LWCELL_DEBUGF(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE, "[LWCELL CONN] Poll event: %p\r\n", (void*)conn);
+        if (conn->status.f.active && conn->poll_interval > 0 && (now - conn->poll_time) >= conn->poll_interval) {
+            conn->poll_time = now;
+            lwcell.evt.type = LWCELL_EVT_CONN_POLL; /* Poll connection event */
+            lwcell.evt.evt.conn_poll.conn = conn;   /* Set connection pointer */
+            lwcelli_send_conn_cb(conn, NULL);       /* Send connection callback */
+            LWCELL_DEBUGF(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE, "[LWCELL CONN] Poll event: %p\r\n", (void*)conn);
+        }
     }
+    prv_conn_poll_schedule(); /* Schedule next poll, if any */
 }
 
 /**
- * \brief           Start timeout function for connection
- * \param[in]       conn: Connection handle as user argument
+ * \brief           Start poll events for newly active connection with default interval
+ *
+ * Function is called before connection active event is sent,
+ * so that application may change the interval from the event callback
+ *
+ * \param[in]       conn: Connection handle
  */
 void
 lwcelli_conn_start_timeout(lwcell_conn_p conn) {
-    lwcell_timeout_add(LWCELL_CFG_CONN_POLL_INTERVAL, conn_timeout_cb, conn); /* Add connection timeout */
+    conn->poll_interval = LWCELL_CFG_CONN_POLL_INTERVAL;
+    conn->poll_time = lwcell_sys_now();
+    prv_conn_poll_schedule();
+}
+
+#if LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__
+
+/**
+ * \brief           Start reading data from device buffer, if connection has receive credit available
+ *
+ * Length of read is reserved from receive credit and limited to what packet buffer pools can serve.
+ * Up to \ref LWCELL_CFG_CONN_RECV_READ_AHEAD reads are queued while previous one is still in progress
+ *
+ * \note            Function must be called with core locked
+ * \param[in]       conn: Connection handle
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcelli_conn_manual_recv_read(lwcell_conn_p conn) {
+    lwcellr_t res;
+    size_t len;
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    /* Read only if device has data and there is no read in progress, or read-ahead is allowed */
+    if (!conn->status.f.active || conn->status.f.in_closing || !conn->status.f.rx_pending
+        || conn->status.f.rx_reads > LWCELL_CFG_CONN_RECV_READ_AHEAD) {
+        return lwcellOK;
+    }
+    len = LWCELL_MIN(conn->rx_credit, LWCELL_CFG_CONN_MAX_DATA_LEN);
+    if (conn->rx_dev_len > 0) { /* Read only what device reported, when known */
+        len = LWCELL_MIN(len, conn->rx_dev_len);
+    }
+#if LWCELL_CFG_PBUF_POOL
+    if (lwcelli_pbuf_pool_free_len() > 0) { /* Exhausted pools fall back to heap */
+        len = LWCELL_MIN(len, lwcelli_pbuf_pool_free_len());
+    }
+#endif /* LWCELL_CFG_PBUF_POOL */
+    if (len == 0) { /* Application shall confirm data first */
+        return lwcellOK;
+    }
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, 0, LWCELL_MSG_SIZE(ciprxget));
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CIPRXGET;
+    LWCELL_MSG_VAR_REF(msg).is_prio = 1; /* Data path command */
+    LWCELL_MSG_VAR_REF(msg).msg.ciprxget.conn = conn;
+    LWCELL_MSG_VAR_REF(msg).msg.ciprxget.val_id = conn->val_id;
+    LWCELL_MSG_VAR_REF(msg).msg.ciprxget.len = len;
+
+    if ((res = lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 10000)) == lwcellOK) {
+        conn->rx_credit -= len;        /* Reserve window for data of this read */
+        conn->status.f.rx_pending = 0; /* Set again by read header when more data are waiting */
+        ++conn->status.f.rx_reads;
+    }
+    return res;
+}
+
+/**
+ * \brief           Set number of bytes waiting in device buffer, as reported by device
+ *
+ * \ref LWCELL_EVT_CONN_RX_PENDING event is sent when value crosses \ref LWCELL_CFG_CONN_RX_PENDING_THRESHOLD
+ *
+ * \note            Function must be called with core locked
+ * \param[in]       conn: Connection handle
+ * \param[in]       len: Number of bytes in device buffer
+ */
+void
+lwcelli_conn_rx_dev_len_set(lwcell_conn_p conn, size_t len) {
+    size_t prev = conn->rx_dev_len;
+
+    conn->rx_dev_len = len;
+#if LWCELL_CFG_CONN_RX_PENDING_THRESHOLD > 0
+    if (conn->status.f.active
+        && (prev >= LWCELL_CFG_CONN_RX_PENDING_THRESHOLD) != (len >= LWCELL_CFG_CONN_RX_PENDING_THRESHOLD)) {
+        lwcell.evt.type = LWCELL_EVT_CONN_RX_PENDING;
+        lwcell.evt.evt.conn_rx_pending.conn = conn;
+        lwcell.evt.evt.conn_rx_pending.len = len;
+        lwcelli_send_conn_cb(conn, NULL);
+    }
+#else  /* LWCELL_CFG_CONN_RX_PENDING_THRESHOLD > 0 */
+    LWCELL_UNUSED(prev);
+#endif /* !(LWCELL_CFG_CONN_RX_PENDING_THRESHOLD > 0) */
+}
+
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__ */
+
+#if LWCELL_CFG_CONN_TX_WINDOW > 0 || __DOXYGEN__
+
+/* Time to retry release of deferred sends when producer queue is full */
+#define TX_WINDOW_RETRY_TIME 10
+
+/**
+ * \brief           Put deferred send request to producer queue
+ * \param[in]       msg: Send request
+ * \return          `1` on success, `0` if queue is full
+ */
+static uint8_t
+prv_conn_tx_window_put(lwcell_msg_t* msg) {
+    lwcell_sys_mbox_t* mbox = &lwcell.mbox_producer;
+
+#if LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0
+    if (msg->is_prio) {
+        mbox = &lwcell.mbox_producer_prio;
+    }
+#endif /* LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0 */
+    if (!lwcell_sys_mbox_putnow(mbox, msg)) {
+        return 0;
+    }
+#if LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0
+    if (mbox != &lwcell.mbox_producer) {
+        lwcelli_producer_prio_wakeup(); /* Wake up producer waiting on regular queue */
+    }
+#endif /* LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0 */
+    return 1;
+}
+
+/**
+ * \brief           Open transmit window and release all deferred send requests to producer queue
+ * \param[in]       arg: Timeout callback custom argument, not used
+ */
+static void
+prv_conn_tx_window_cb(void* arg) {
+    lwcell_msg_t* next;
+
+    LWCELL_UNUSED(arg);
+    lwcell.tx_window.time = lwcell_sys_now();
+    lwcell.tx_window.was_open = 1;
+    while (lwcell.tx_window.first != NULL) {
+        next = lwcell.tx_window.first->msg.conn_send.tx_window_next;
+        if (!prv_conn_tx_window_put(lwcell.tx_window.first)) {
+            lwcell_timeout_start(&lwcell.tx_window.timeout, TX_WINDOW_RETRY_TIME, prv_conn_tx_window_cb, NULL);
+            return;
+        }
+        lwcell.tx_window.first = next;
+    }
+    lwcell.tx_window.last = NULL;
+    LWCELL_DEBUGF(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE, "[LWCELL CONN] Transmit window opened\r\n");
+}
+
+/**
+ * \brief           Hold send request back until next transmit window, if its connection is deferred
+ *
+ * Send on connection, which is not deferred, opens the window for requests waiting already
+ *
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Message about to enter producer queue
+ * \return          `1` when message waits for transmit window, `0` when it shall be put to producer queue
+ */
+uint8_t
+lwcelli_conn_tx_window_defer(lwcell_msg_t* msg) {
+    if (msg->cmd_def != LWCELL_CMD_CIPSEND) {
+        return 0;
+    }
+    if (!msg->msg.conn_send.conn->status.f.tx_deferred) {
+        lwcelli_conn_tx_window_activity(); /* Radio is woken up anyway */
+        return 0;
+    }
+#if LWCELL_CFG_PWR_RADIO_RELEASE
+    msg->msg.conn_send.tx_window_batch = 1;
+    ++lwcell.tx_window.batch_cnt;
+#endif /* LWCELL_CFG_PWR_RADIO_RELEASE */
+    if (lwcell.tx_window.was_open && (lwcell_sys_now() - lwcell.tx_window.time) < LWCELL_CFG_CONN_TX_WINDOW_HOLD) {
+        return 0; /* Radio is still in connected state */
+    }
+
+    msg->msg.conn_send.tx_window_next = NULL;
+    if (lwcell.tx_window.last != NULL) {
+        lwcell.tx_window.last->msg.conn_send.tx_window_next = msg;
+    } else {
+        lwcell.tx_window.first = msg;
+        lwcell_timeout_start(&lwcell.tx_window.timeout, LWCELL_CFG_CONN_TX_WINDOW, prv_conn_tx_window_cb, NULL);
+    }
+    lwcell.tx_window.last = msg;
+    return 1;
+}
+
+/**
+ * \brief           Notify about radio activity, transmit window is opened
+ *
+ * Deferred send requests are released from processing thread, after request which caused activity
+ *
+ * \note            Function must be called with core locked
+ */
+void
+lwcelli_conn_tx_window_activity(void) {
+    lwcell.tx_window.time = lwcell_sys_now();
+    lwcell.tx_window.was_open = 1;
+    if (lwcell.tx_window.first != NULL) {
+        lwcell_timeout_start(&lwcell.tx_window.timeout, 0, prv_conn_tx_window_cb, NULL);
+    }
 }
 
+/**
+ * \brief           Send request has finished or was not queued
+ *
+ * When last send request of deferred connections finishes and nothing waits for next window,
+ * early radio release is requested with \ref LWCELL_CFG_PWR_RADIO_RELEASE enabled
+ *
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Finished message
+ */
+void
+lwcelli_conn_tx_window_done(lwcell_msg_t* msg) {
+#if LWCELL_CFG_PWR_RADIO_RELEASE
+    if (msg->cmd_def != LWCELL_CMD_CIPSEND || !msg->msg.conn_send.tx_window_batch) {
+        return;
+    }
+    msg->msg.conn_send.tx_window_batch = 0;
+    if (--lwcell.tx_window.batch_cnt == 0 && lwcell.tx_window.first == NULL) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE, "[LWCELL CONN] Transmit window done\r\n");
+        lwcell_pwr_radio_release(NULL, NULL, 0);
+    }
+#else  /* LWCELL_CFG_PWR_RADIO_RELEASE */
+    LWCELL_UNUSED(msg);
+#endif /* !LWCELL_CFG_PWR_RADIO_RELEASE */
+}
+
+#endif /* LWCELL_CFG_CONN_TX_WINDOW > 0 || __DOXYGEN__ */
+
 /**
  * \brief           Get connection validation ID
  * \param[in]       conn: Connection handle
@@ -105,12 +378,16 @@ lwcelli_conn_get_val_id(lwcell_conn_p conn) {
  * \param[in]       btw: Number of bytes to send
  * \param[out]      bw: Pointer to output variable to save number of sent data when successfully sent
  * \param[in]       fau: "Free After Use" flag. Set to `1` if stack should free the memory after data sent
+ * \param[in]       deadline_ms: Time in units of milliseconds after which queued data are dropped.
+ *                      Set to `0` to keep data until sent
+ * \param[out]      id: Pointer to output variable to save send handle for cancellation. Set to `NULL` if not used
  * \param[in]       blocking: Status whether command should be blocking or not
  * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
  */
 static lwcellr_t
 conn_send(lwcell_conn_p conn, const lwcell_ip_t* const ip, lwcell_port_t port, const void* data, size_t btw,
-          size_t* const bw, uint8_t fau, const uint32_t blocking) {
+          size_t* const bw, uint8_t fau, uint32_t deadline_ms, lwcell_conn_send_id_t* const id,
+          const uint32_t blocking) {
     LWCELL_MSG_VAR_DEFINE(msg);
 
     LWCELL_ASSERT(conn != NULL);
@@ -122,9 +399,11 @@ conn_send(lwcell_conn_p conn, const lwcell_ip_t* const ip, lwcell_port_t port, c
     }
 
     CONN_CHECK_CLOSED_IN_CLOSING(conn); /* Check if we can continue */
+    CONN_CHECK_QUOTA(conn);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(conn_send));
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CIPSEND;
+    LWCELL_MSG_VAR_REF(msg).is_prio = 1; /* Data path command */
 
     LWCELL_MSG_VAR_REF(msg).msg.conn_send.conn = conn;
     LWCELL_MSG_VAR_REF(msg).msg.conn_send.data = data;
@@ -134,10 +413,211 @@ conn_send(lwcell_conn_p conn, const lwcell_ip_t* const ip, lwcell_port_t port, c
     LWCELL_MSG_VAR_REF(msg).msg.conn_send.remote_port = port;
     LWCELL_MSG_VAR_REF(msg).msg.conn_send.fau = fau;
     LWCELL_MSG_VAR_REF(msg).msg.conn_send.val_id = lwcelli_conn_get_val_id(conn);
+#if LWCELL_CFG_CONN_SEND_DEADLINE
+    if (deadline_ms > 0) {
+        LWCELL_MSG_VAR_REF(msg).msg.conn_send.deadline = lwcell_sys_now() + deadline_ms;
+        LWCELL_MSG_VAR_REF(msg).msg.conn_send.has_deadline = 1;
+    }
+    if (id != NULL) {
+        lwcell_core_lock();
+        if (++lwcell.m.conn_send_id == 0) { /* Handle 0 is reserved for invalid handle */
+            ++lwcell.m.conn_send_id;
+        }
+        LWCELL_MSG_VAR_REF(msg).msg.conn_send.id = lwcell.m.conn_send_id;
+        *id = lwcell.m.conn_send_id;
+        lwcell_core_unlock();
+    }
+#else  /* LWCELL_CFG_CONN_SEND_DEADLINE */
+    LWCELL_UNUSED(deadline_ms);
+    LWCELL_UNUSED(id);
+#endif /* !LWCELL_CFG_CONN_SEND_DEADLINE */
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
+}
+
+/**
+ * \brief           Send data fragments or packet buffer chain on active connection
+ *
+ * CIPSEND chunks are written to AT port directly from fragments, without intermediate copy
+ *
+ * \param[in]       conn: Pointer to connection to send data
+ * \param[in]       ip: Remote IP address for UDP connection. Set to `NULL` when not used
+ * \param[in]       port: Remote port for UDP connection
+ * \param[in]       iov: Array of data fragments. Set to `NULL` when sending packet buffer
+ * \param[in]       iovcnt: Number of entries in `iov` array
+ * \param[in]       pbuf: Packet buffer chain to send. Set to `NULL` when sending fragments
+ * \param[in]       btw: Number of bytes to send
+ * \param[out]      bw: Pointer to output variable to save number of sent data when successfully sent
+ * \param[in]       dgram: Set to `1` to send each fragment as separate datagram
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+conn_sendv(lwcell_conn_p conn, const lwcell_ip_t* const ip, lwcell_port_t port, const lwcell_conn_iovec_t* iov,
+           size_t iovcnt, lwcell_pbuf_p pbuf, size_t btw, size_t* const bw, uint8_t dgram, const uint32_t blocking) {
+    lwcellr_t res;
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    if (bw != NULL) {
+        *bw = 0;
+    }
+
+    CONN_CHECK_CLOSED_IN_CLOSING(conn); /* Check if we can continue */
+    CONN_CHECK_QUOTA(conn);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(conn_send));
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CIPSEND;
+    LWCELL_MSG_VAR_REF(msg).is_prio = 1; /* Data path command */
+
+    LWCELL_MSG_VAR_REF(msg).msg.conn_send.conn = conn;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_send.iov = iov;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_send.iovcnt = iovcnt;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_send.dgram = dgram;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_send.btw = btw;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_send.bw = bw;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_send.remote_ip = ip;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_send.remote_port = port;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_send.val_id = lwcelli_conn_get_val_id(conn);
+    if (pbuf != NULL) {
+        lwcell_pbuf_ref(pbuf); /* Keep packet buffer until command finishes */
+        LWCELL_MSG_VAR_REF(msg).msg.conn_send.pbuf = pbuf;
+    }
+
+    /* Message is released on failure, reference must be released here */
+    res = lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
+    if (res != lwcellOK && pbuf != NULL) {
+        lwcell_pbuf_free(pbuf);
+    }
+    return res;
+}
+
+#if LWCELL_CFG_CONN_WRITE_RING || __DOXYGEN__
+
+/**
+ * \brief           Put linear block of connection ring write buffer to send queue
+ * \note            Block memory is released from ring when send command finishes
+ * \param[in]       conn: Connection to send data on
+ * \param[in]       data: Pointer to block in ring memory
+ * \param[in]       btw: Number of bytes to send
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+conn_write_ring_send_block(lwcell_conn_p conn, const uint8_t* data, size_t btw) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    CONN_CHECK_CLOSED_IN_CLOSING(conn); /* Check if we can continue */
+    CONN_CHECK_QUOTA(conn);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, 0, LWCELL_MSG_SIZE(conn_send));
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CIPSEND;
+    LWCELL_MSG_VAR_REF(msg).is_prio = 1; /* Data path command */
+
+    LWCELL_MSG_VAR_REF(msg).msg.conn_send.conn = conn;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_send.data = data;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_send.btw = btw;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_send.ring_len = btw;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_send.val_id = lwcelli_conn_get_val_id(conn);
 
     return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
 }
 
+/**
+ * \brief           Queue data of connection ring write buffer, not yet queued for send
+ *
+ * Data are queued when at least \ref LWCELL_CFG_CONN_MAX_DATA_LEN bytes are waiting or when flush is requested.
+ * Up to `2` linear blocks are queued, when data wrap around the end of ring memory
+ *
+ * \param[in]       conn: Connection to send data on
+ * \param[in]       flush: Set to `1` to queue all waiting data
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+conn_write_ring_send(lwcell_conn_p conn, uint8_t flush) {
+    lwcellr_t res = lwcellOK;
+    lwcell_buff_vec_t vec[2];
+    const uint8_t* addr;
+    size_t full, len = 0;
+
+    while (res == lwcellOK) {
+        addr = NULL;
+        LWCELL_CONN_LOCK(conn);
+        full = lwcell_buff_get_read_vec(&conn->tx_ring, vec);
+        if (full > conn->tx_ring_queued
+            && (flush || (full - conn->tx_ring_queued) >= LWCELL_CFG_CONN_MAX_DATA_LEN)) {
+            /* Queued data always start at read pointer, find first byte after them */
+            if (conn->tx_ring_queued < vec[0].len) {
+                addr = vec[0].data + conn->tx_ring_queued;
+                len = vec[0].len - conn->tx_ring_queued;
+            } else {
+                addr = vec[1].data + (conn->tx_ring_queued - vec[0].len);
+                len = full - conn->tx_ring_queued;
+            }
+            conn->tx_ring_queued += len;
+        }
+        LWCELL_CONN_UNLOCK(conn);
+        if (addr == NULL) {
+            break;
+        }
+
+        /* Data stay in ring on failure and are queued with next write or flush */
+        res = conn_write_ring_send_block(conn, addr, len);
+        if (res != lwcellOK) {
+            LWCELL_CONN_LOCK(conn);
+            conn->tx_ring_queued -= len;
+            LWCELL_CONN_UNLOCK(conn);
+        }
+    }
+    return res;
+}
+
+/**
+ * \brief           Release connection ring write buffer memory of finished send command
+ * \note            Function must be called from producer thread with core locked.
+ *                  Send commands of single connection finish in the order they were queued
+ * \param[in]       msg: Finished send message
+ */
+void
+lwcelli_conn_write_ring_sent(lwcell_msg_t* msg) {
+    lwcell_conn_p conn = msg->msg.conn_send.conn;
+    size_t len = msg->msg.conn_send.ring_len;
+    uint8_t active;
+
+    msg->msg.conn_send.ring_len = 0;
+    if (msg->msg.conn_send.val_id != conn->val_id) {
+        return; /* Ring memory was released when connection closed */
+    }
+
+    LWCELL_CONN_LOCK(conn);
+    len = LWCELL_MIN(len, conn->tx_ring_queued);
+    lwcell_buff_skip(&conn->tx_ring, len);
+    conn->tx_ring_queued -= len;
+    active = conn->status.f.active;
+    if (!active && conn->tx_ring_queued == 0) {
+        lwcell_buff_free(&conn->tx_ring); /* Release was postponed when connection closed */
+    }
+    LWCELL_CONN_UNLOCK(conn);
+
+    /* Queue data, which could not be queued before */
+    if (active) {
+        conn_write_ring_send(conn, 0);
+    }
+}
+
+/**
+ * \brief           Flush buffer on connection
+ * \param[in]       conn: Connection to flush buffer on
+ * \return          \ref lwcellOK if data flushed and put to queue, member of \ref lwcellr_t otherwise
+ */
+static lwcellr_t
+flush_buff(lwcell_conn_p conn) {
+    if (conn == NULL) {
+        return lwcellOK;
+    }
+    return conn_write_ring_send(conn, 1);
+}
+
+#else /* LWCELL_CFG_CONN_WRITE_RING || __DOXYGEN__ */
+
 /**
  * \brief           Flush buffer on connection
  * \param[in]       conn: Connection to flush buffer on
@@ -146,196 +626,839 @@ conn_send(lwcell_conn_p conn, const lwcell_ip_t* const ip, lwcell_port_t port, c
 static lwcellr_t
 flush_buff(lwcell_conn_p conn) {
     lwcellr_t res = lwcellOK;
-    lwcell_core_lock();
-    if (conn != NULL && conn->buff.buff != NULL) { /* Do we have something ready? */
+    uint8_t* buff = NULL;
+    size_t len = 0;
+
+    if (conn == NULL) {
+        return res;
+    }
+
+    /* Detach buffer from connection, send it outside lock */
+    LWCELL_CONN_LOCK(conn);
+    if (conn->buff.buff != NULL) { /* Do we have something ready? */
+        buff = conn->buff.buff;
+        len = conn->buff.ptr;
+        conn->buff.buff = NULL;
+    }
+    LWCELL_CONN_UNLOCK(conn);
+
+    if (buff != NULL) {
         /*
          * If there is nothing to write or if write was not successful,
          * simply free the memory and stop execution
          */
-        if (conn->buff.ptr > 0) { /* Anything to send at the moment? */
-            res = conn_send(conn, NULL, 0, conn->buff.buff, conn->buff.ptr, NULL, 1, 0);
+        if (len > 0) { /* Anything to send at the moment? */
+            res = conn_send(conn, NULL, 0, buff, len, NULL, 1, 0, NULL, 0);
         } else {
             res = lwcellERR;
         }
         if (res != lwcellOK) {
             LWCELL_DEBUGF(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE, "[LWCELL CONN] Free write buffer: %p\r\n",
-                          (void*)conn->buff.buff);
-            lwcell_mem_free_s((void**)&conn->buff.buff);
+                          (void*)buff);
+            lwcell_mem_free_s((void**)&buff);
         }
-        conn->buff.buff = NULL;
+    }
+    return res;
+}
+
+#endif /* !(LWCELL_CFG_CONN_WRITE_RING || __DOXYGEN__) */
+
+/**
+ * \brief           Initialize connection module
+ */
+void
+lwcelli_conn_init(void) {}
+
+/**
+ * \brief           Send connection start message
+ * \param[out]      conn: Pointer to connection handle to set new connection reference
+ * \param[in]       ctx: PDP context used by connection
+ * \param[in]       type: Connection type
+ * \param[in]       host: Connection host
+ * \param[in]       port: Connection port
+ * \param[in]       arg: Pointer to user argument passed to connection if successfully connected
+ * \param[in]       conn_evt_fn: Callback function for this connection
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+prv_conn_start(lwcell_conn_p* conn, uint8_t ctx, lwcell_conn_type_t type, const char* const host, lwcell_port_t port,
+               void* const arg, lwcell_evt_fn conn_evt_fn, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+    lwcell_cmd_t cmd = LWCELL_CMD_CIPSTATUS;
+
+    LWCELL_ASSERT(host != NULL);
+    LWCELL_ASSERT(port > 0);
+    LWCELL_ASSERT(conn_evt_fn != NULL);
+
+#if LWCELL_CFG_CONN_CA_SOCKET
+    lwcell_core_lock();
+    if (LWCELL_CONN_IS_CA()) {
+        /* Socket commands open connection directly, PDP context is activated first time only */
+        cmd = lwcell.m.ca_pdp_active ? LWCELL_CMD_CIPSTART : LWCELL_CMD_CNACT_SET;
+        if (type == LWCELL_CONN_TYPE_SSL || ctx > 0) {
+            cmd = LWCELL_CMD_IDLE;
+        }
+    }
+    lwcell_core_unlock();
+    if (cmd == LWCELL_CMD_IDLE) {
+        return lwcellERRNOTENABLED;
+    }
+#endif /* LWCELL_CFG_CONN_CA_SOCKET */
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(conn_start));
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CIPSTART;
+    LWCELL_MSG_VAR_REF(msg).cmd = cmd;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_start.num = LWCELL_CFG_MAX_CONNS; /* Set maximal value as invalid number */
+    LWCELL_MSG_VAR_REF(msg).msg.conn_start.conn = conn;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_start.type = type;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_start.host = host;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_start.port = port;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_start.evt_func = conn_evt_fn;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_start.arg = arg;
+#if LWCELL_CFG_NETWORK_CONTEXTS > 1
+    LWCELL_MSG_VAR_REF(msg).msg.conn_start.ctx = ctx;
+#else  /* LWCELL_CFG_NETWORK_CONTEXTS > 1 */
+    LWCELL_UNUSED(ctx);
+#endif /* !(LWCELL_CFG_NETWORK_CONTEXTS > 1) */
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
+}
+
+/**
+ * \brief           Start a new connection of specific type
+ * \param[out]      conn: Pointer to connection handle to set new connection reference in case of successful connection
+ * \param[in]       type: Connection type. This parameter can be a value of \ref lwcell_conn_type_t enumeration
+ * \param[in]       host: Connection host. In case of IP, write it as string, ex. "192.168.1.1"
+ * \param[in]       port: Connection port
+ * \param[in]       arg: Pointer to user argument passed to connection if successfully connected
+ * \param[in]       conn_evt_fn: Callback function for this connection
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_conn_start(lwcell_conn_p* conn, lwcell_conn_type_t type, const char* const host, lwcell_port_t port,
+                  void* const arg, lwcell_evt_fn conn_evt_fn, const uint32_t blocking) {
+    return prv_conn_start(conn, 0, type, host, port, arg, conn_evt_fn, blocking);
+}
+
+#if LWCELL_CFG_NETWORK_CONTEXTS > 1 || __DOXYGEN__
+
+/**
+ * \brief           Start a new connection of specific type in selected PDP context
+ * \note            Context must be active, see \ref lwcell_network_attach_ctx
+ * \param[out]      conn: Pointer to connection handle to set new connection reference in case of successful connection
+ * \param[in]       ctx: PDP context number to bind connection to
+ * \param[in]       type: Connection type. This parameter can be a value of \ref lwcell_conn_type_t enumeration
+ * \param[in]       host: Connection host. In case of IP, write it as string, ex. "192.168.1.1"
+ * \param[in]       port: Connection port
+ * \param[in]       arg: Pointer to user argument passed to connection if successfully connected
+ * \param[in]       conn_evt_fn: Callback function for this connection
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_conn_start_ctx(lwcell_conn_p* conn, uint8_t ctx, lwcell_conn_type_t type, const char* const host,
+                      lwcell_port_t port, void* const arg, lwcell_evt_fn conn_evt_fn, const uint32_t blocking) {
+    if (!lwcell_network_is_attached_ctx(ctx)) {
+        return lwcellERR;
+    }
+    return prv_conn_start(conn, ctx, type, host, port, arg, conn_evt_fn, blocking);
+}
+
+/**
+ * \brief           Get PDP context used by connection
+ * \param[in]       conn: Connection handle
+ * \return          PDP context number as reported by device
+ */
+uint8_t
+lwcell_conn_get_ctx(lwcell_conn_p conn) {
+    uint8_t res = 0;
+    if (conn != NULL && lwcelli_is_valid_conn_ptr(conn)) {
+        lwcell_core_lock();
+        res = LWCELL_U8(conn->status.f.bearer);
+        lwcell_core_unlock();
+    }
+    return res;
+}
+
+#endif /* LWCELL_CFG_NETWORK_CONTEXTS > 1 || __DOXYGEN__ */
+
+/**
+ * \brief           Close specific or all connections
+ * \param[in]       conn: Connection handle to close. Set to NULL if you want to close all connections.
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_conn_close(lwcell_conn_p conn, const uint32_t blocking) {
+    lwcellr_t res = lwcellOK;
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(conn != NULL);
+
+    CONN_CHECK_CLOSED_IN_CLOSING(conn); /* Check if we can continue */
+
+    /* Proceed with close event at this point! */
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(conn_close));
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CIPCLOSE;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_close.conn = conn;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_close.val_id = lwcelli_conn_get_val_id(conn);
+
+    flush_buff(conn);                   /* First flush buffer */
+    res = lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 1000);
+    if (res == lwcellOK && !blocking) { /* Function succedded in non-blocking mode */
+        lwcell_core_lock();
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE,
+                      "[LWCELL CONN] Connection %d set to closing state\r\n", (int)conn->num);
+        conn->status.f.in_closing = 1; /* Connection is in closing mode but not yet closed */
+        lwcell_core_unlock();
+    }
+    return res;
+}
+
+#if LWCELL_CFG_CONN_SERVER || __DOXYGEN__
+
+/**
+ * \brief           Enable or disable TCP server on device
+ *
+ * Every incoming connection is reported to `server_evt_fn` with \ref LWCELL_EVT_CONN_ACTIVE event,
+ * where \ref lwcell_conn_is_client returns `0` for the connection.
+ * Callback is then used for all further events of that connection
+ *
+ * \note            Device supports single server at a time and network must be attached
+ * \param[in]       en: Set to `1` to start server, `0` to stop it
+ * \param[in]       port: Local port to listen on. Not used when server is disabled
+ * \param[in]       server_evt_fn: Callback function for accepted connections. Not used when server is disabled
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_conn_set_server(uint8_t en, lwcell_port_t port, lwcell_evt_fn server_evt_fn, const lwcell_api_cmd_evt_fn evt_fn,
+                       void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(!en || port > 0);
+    LWCELL_ASSERT(!en || server_evt_fn != NULL);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(conn_server));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CIPSERVER;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_server.en = en;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_server.port = port;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_server.evt_func = server_evt_fn;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 10000);
+}
+
+#endif /* LWCELL_CFG_CONN_SERVER || __DOXYGEN__ */
+
+/**
+ * \brief           Send data on active connection of type UDP to specific remote IP and port
+ * \note            In case IP and port values are not set, it will behave as normal send function (suitable for TCP too)
+ * \param[in]       conn: Connection handle to send data
+ * \param[in]       ip: Remote IP address for UDP connection
+ * \param[in]       port: Remote port connection
+ * \param[in]       data: Pointer to data to send
+ * \param[in]       btw: Number of bytes to send
+ * \param[out]      bw: Pointer to output variable to save number of sent data when successfully sent
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_conn_sendto(lwcell_conn_p conn, const lwcell_ip_t* const ip, lwcell_port_t port, const void* data, size_t btw,
+                   size_t* bw, const uint32_t blocking) {
+    LWCELL_ASSERT(conn != NULL);
+
+    flush_buff(conn); /* Flush currently written memory if exists */
+    return conn_send(conn, ip, port, data, btw, bw, 0, 0, NULL, blocking);
+}
+
+/**
+ * \brief           Send data on already active connection either as client or server
+ * \param[in]       conn: Connection handle to send data
+ * \param[in]       data: Data to send
+ * \param[in]       btw: Number of bytes to send
+ * \param[out]      bw: Pointer to output variable to save number of sent data when successfully sent.
+ *                      Parameter value might not be accurate if you combine \ref lwcell_conn_write and \ref lwcell_conn_send functions
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_conn_send(lwcell_conn_p conn, const void* data, size_t btw, size_t* const bw, const uint32_t blocking) {
+    lwcellr_t res;
+    const uint8_t* d = data;
+
+    LWCELL_ASSERT(conn != NULL);
+    LWCELL_ASSERT(data != NULL);
+    LWCELL_ASSERT(btw > 0);
+
+#if !LWCELL_CFG_CONN_WRITE_RING
+    LWCELL_CONN_LOCK(conn);
+    if (conn->buff.buff != NULL) { /* Check if memory available */
+        size_t to_copy;
+        to_copy = LWCELL_MIN(btw, conn->buff.len - conn->buff.ptr);
+        if (to_copy > 0) {
+            LWCELL_MEMCPY(&conn->buff.buff[conn->buff.ptr], d, to_copy);
+            conn->buff.ptr += to_copy;
+            d += to_copy;
+            btw -= to_copy;
+        }
+    }
+    LWCELL_CONN_UNLOCK(conn);
+#endif /* !LWCELL_CFG_CONN_WRITE_RING */
+    res = flush_buff(conn); /* Flush currently written memory if exists */
+    if (btw > 0) {          /* Check for remaining data */
+        res = conn_send(conn, NULL, 0, d, btw, bw, 0, 0, NULL, blocking);
+    }
+    return res;
+}
+
+/**
+ * \brief           Send data on already active connection and pass ownership of data buffer to stack
+ *
+ * Buffer is freed by stack with \ref lwcell_mem_free once data are sent or send fails,
+ * also when function returns an error. Application must not access buffer after function call,
+ * there is no need to keep it alive until \ref LWCELL_EVT_CONN_SEND event.
+ *
+ * \note            Packet buffer ownership is passed by calling \ref lwcell_pbuf_free
+ *                  right after \ref lwcell_conn_send_pbuf, stack keeps its own reference
+ *
+ * \param[in]       conn: Connection handle to send data
+ * \param[in]       data: Data buffer, allocated with \ref lwcell_mem_malloc
+ * \param[in]       btw: Number of bytes to send
+ * \param[out]      bw: Pointer to output variable to save number of sent data when successfully sent
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_conn_send_owned(lwcell_conn_p conn, void* data, size_t btw, size_t* const bw, const uint32_t blocking) {
+    lwcellr_t res = lwcellERRPAR;
+
+    if (conn != NULL && data != NULL && btw > 0) {
+        flush_buff(conn); /* Flush currently written memory if exists */
+
+        /* Blocking caller waits until data are sent, buffer is freed here in any case */
+        res = conn_send(conn, NULL, 0, data, btw, bw, !blocking, 0, NULL, blocking);
+    }
+    if (data != NULL && (blocking || res != lwcellOK)) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE, "[LWCELL CONN] Free owned buffer: %p\r\n", data);
+        lwcell_mem_free_s(&data);
+    }
+    return res;
+}
+
+/**
+ * \brief           Send data fragments on already active connection, without copying them to single buffer
+ *
+ * Fragments are sent as one continuous stream, for example protocol header followed by payload.
+ *
+ * \note            In non-blocking mode, `iov` array and fragment data must stay valid
+ *                  until \ref LWCELL_EVT_CONN_SEND event is received
+ *
+ * \param[in]       conn: Connection handle to send data
+ * \param[in]       iov: Array of data fragments
+ * \param[in]       iovcnt: Number of entries in `iov` array
+ * \param[out]      bw: Pointer to output variable to save number of sent data when successfully sent
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_conn_sendv(lwcell_conn_p conn, const lwcell_conn_iovec_t* iov, size_t iovcnt, size_t* const bw,
+                  const uint32_t blocking) {
+    size_t btw = 0;
+
+    LWCELL_ASSERT(conn != NULL);
+    LWCELL_ASSERT(iov != NULL);
+    LWCELL_ASSERT(iovcnt > 0);
+
+    for (size_t i = 0; i < iovcnt; ++i) {
+        LWCELL_ASSERT(iov[i].data != NULL || iov[i].len == 0);
+        btw += iov[i].len;
+    }
+    LWCELL_ASSERT(btw > 0);
+
+    flush_buff(conn); /* Flush currently written memory if exists */
+    return conn_sendv(conn, NULL, 0, iov, iovcnt, NULL, btw, bw, 0, blocking);
+}
+
+/**
+ * \brief           Send batch of datagrams on active connection of type UDP with single command
+ *
+ * Each entry of `dgrams` array is sent as its own datagram, with `AT+CIPSEND` commands executed back to back.
+ * Queue, synchronization and send event overhead is paid once for whole batch instead of once per datagram.
+ *
+ * \note            Datagram is never split, its length must not exceed \ref LWCELL_CFG_CONN_MAX_DATA_LEN
+ *                  or maximal send length reported by device
+ * \note            In non-blocking mode, `dgrams` array and datagram data must stay valid
+ *                  until \ref LWCELL_EVT_CONN_SEND event is received
+ *
+ * \param[in]       conn: Connection handle to send data
+ * \param[in]       ip: Remote IP address. Set to `NULL` to use address connection was started with
+ * \param[in]       port: Remote port, used together with `ip`
+ * \param[in]       dgrams: Array of datagrams
+ * \param[in]       cnt: Number of entries in `dgrams` array
+ * \param[out]      bw: Pointer to output variable to save number of sent data when successfully sent
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_conn_sendto_batch(lwcell_conn_p conn, const lwcell_ip_t* const ip, lwcell_port_t port,
+                         const lwcell_conn_iovec_t* dgrams, size_t cnt, size_t* const bw, const uint32_t blocking) {
+    size_t btw = 0;
+
+    LWCELL_ASSERT(conn != NULL);
+    LWCELL_ASSERT(dgrams != NULL);
+    LWCELL_ASSERT(cnt > 0);
+
+    for (size_t i = 0; i < cnt; ++i) {
+        if (dgrams[i].data == NULL || dgrams[i].len == 0 || dgrams[i].len > LWCELL_CFG_CONN_MAX_DATA_LEN) {
+            return lwcellERRPAR;
+        }
+        btw += dgrams[i].len;
+    }
+    if (conn->type != LWCELL_CONN_TYPE_UDP) {
+        return lwcellERR;
+    }
+
+    flush_buff(conn); /* Flush currently written memory if exists */
+    return conn_sendv(conn, ip, port, dgrams, cnt, NULL, btw, bw, 1, blocking);
+}
+
+/**
+ * \brief           Send packet buffer chain on already active connection, without copying it to single buffer
+ *
+ * Stack holds its own reference to packet buffer until data are sent,
+ * application may free packet buffer immediately after function returns
+ *
+ * \param[in]       conn: Connection handle to send data
+ * \param[in]       pbuf: Packet buffer chain to send
+ * \param[out]      bw: Pointer to output variable to save number of sent data when successfully sent
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_conn_send_pbuf(lwcell_conn_p conn, lwcell_pbuf_p pbuf, size_t* const bw, const uint32_t blocking) {
+    LWCELL_ASSERT(conn != NULL);
+    LWCELL_ASSERT(pbuf != NULL);
+    LWCELL_ASSERT(lwcell_pbuf_length(pbuf, 1) > 0);
+
+    flush_buff(conn); /* Flush currently written memory if exists */
+    return conn_sendv(conn, NULL, 0, NULL, 0, pbuf, lwcell_pbuf_length(pbuf, 1), bw, 0, blocking);
+}
+
+/**
+ * \brief           Notify connection about received data which means connection is ready to accept more data
+ *
+ * Once data reception is confirmed, stack will try to send more data to user.
+ *
+ * \note            Function has effect only when \ref LWCELL_CFG_CONN_MANUAL_RECV is enabled.
+ *                  Length of packet buffer is returned to connection receive window
+ *                  and next read from device buffer is started if data are waiting there
+ *
+ * \note            Function may be called from connection event function or from any user thread
+ *
+ * \param[in]       conn: Connection handle
+ * \param[in]       pbuf: Packet buffer received on connection
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_conn_recved(lwcell_conn_p conn, lwcell_pbuf_p pbuf) {
+#if LWCELL_CFG_CONN_MANUAL_RECV
+    lwcellr_t res = lwcellOK;
+
+    LWCELL_ASSERT(conn != NULL);
+    LWCELL_ASSERT(pbuf != NULL);
+
+    lwcell_core_lock();
+    if (conn->status.f.active) {
+        conn->rx_credit = LWCELL_MIN(conn->rx_credit + lwcell_pbuf_length(pbuf, 1), LWCELL_CFG_CONN_RECV_WINDOW);
+        res = lwcelli_conn_manual_recv_read(conn);
+    }
+    lwcell_core_unlock();
+    return res;
+#else  /* LWCELL_CFG_CONN_MANUAL_RECV */
+    LWCELL_UNUSED(conn);
+    LWCELL_UNUSED(pbuf);
+    return lwcellOK;
+#endif /* !LWCELL_CFG_CONN_MANUAL_RECV */
+}
+
+/**
+ * \brief           Set argument variable for connection
+ * \param[in]       conn: Connection handle to set argument
+ * \param[in]       arg: Pointer to argument
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ * \sa              lwcell_conn_get_arg
+ */
+lwcellr_t
+lwcell_conn_set_arg(lwcell_conn_p conn, void* const arg) {
+    lwcell_core_lock();
+    conn->arg = arg; /* Set argument for connection */
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+/**
+ * \brief           Set interval of \ref LWCELL_EVT_CONN_POLL events for connection
+ *
+ * Connection starts with \ref LWCELL_CFG_CONN_POLL_INTERVAL when it becomes active.
+ * Interval is best set from \ref LWCELL_EVT_CONN_ACTIVE event and is valid until connection is closed.
+ * Poll events of all connections are driven by single timeout, which is not running
+ * when no active connection has poll enabled
+ *
+ * \param[in]       conn: Connection handle
+ * \param[in]       interval: Poll interval in units of milliseconds. Set to `0` to disable poll events
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_conn_set_poll_interval(lwcell_conn_p conn, uint32_t interval) {
+    lwcellr_t res = lwcellERR;
+    lwcell_core_lock();
+    if (conn != NULL && lwcelli_is_valid_conn_ptr(conn) && conn->status.f.active) {
+        conn->poll_interval = interval;
+        conn->poll_time = lwcell_sys_now(); /* Next poll is one full interval from now */
+        prv_conn_poll_schedule();
+        res = lwcellOK;
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+#if LWCELL_CFG_CONN_RECV_FN || __DOXYGEN__
+
+/**
+ * \brief           Set function to receive data of connection directly
+ *
+ * Received packet buffers are passed to function from processing thread,
+ * instead of \ref LWCELL_EVT_CONN_RECV event to connection callback.
+ * Packet buffer is freed after function returns, use \ref lwcell_pbuf_ref to keep it.
+ * Function is best set from \ref LWCELL_EVT_CONN_ACTIVE event and is valid until connection is closed
+ *
+ * \param[in]       conn: Connection handle
+ * \param[in]       recv_fn: Receive function, called with connection argument. Set to `NULL` to use events
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_conn_set_recv_fn(lwcell_conn_p conn, lwcell_conn_recv_fn recv_fn) {
+    lwcellr_t res = lwcellERR;
+    lwcell_core_lock();
+    if (conn != NULL && lwcelli_is_valid_conn_ptr(conn) && conn->status.f.active) {
+        conn->recv_fn = recv_fn;
+        res = lwcellOK;
     }
     lwcell_core_unlock();
     return res;
 }
 
-/**
- * \brief           Initialize connection module
- */
-void
-lwcelli_conn_init(void) {}
+#if LWCELL_CFG_CONN_RECV_BATCH > 0 || __DOXYGEN__
 
 /**
- * \brief           Start a new connection of specific type
- * \param[out]      conn: Pointer to connection handle to set new connection reference in case of successful connection
- * \param[in]       type: Connection type. This parameter can be a value of \ref lwcell_conn_type_t enumeration
- * \param[in]       host: Connection host. In case of IP, write it as string, ex. "192.168.1.1"
- * \param[in]       port: Connection port
- * \param[in]       arg: Pointer to user argument passed to connection if successfully connected
- * \param[in]       conn_evt_fn: Callback function for this connection
- * \param[in]       blocking: Status whether command should be blocking or not
+ * \brief           Set function to receive data of connection in batches
+ *
+ * Packets completed in single block of received data are collected, up to \ref LWCELL_CFG_CONN_RECV_BATCH,
+ * and passed to function with one call. Packet buffers are freed after function returns.
+ * Batch function takes precedence over function set with \ref lwcell_conn_set_recv_fn
+ *
+ * \param[in]       conn: Connection handle
+ * \param[in]       recv_batch_fn: Batch receive function, called with connection argument.
+ *                      Set to `NULL` to disable batching
  * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
  */
 lwcellr_t
-lwcell_conn_start(lwcell_conn_p* conn, lwcell_conn_type_t type, const char* const host, lwcell_port_t port,
-                  void* const arg, lwcell_evt_fn conn_evt_fn, const uint32_t blocking) {
-    LWCELL_MSG_VAR_DEFINE(msg);
+lwcell_conn_set_recv_batch_fn(lwcell_conn_p conn, lwcell_conn_recv_batch_fn recv_batch_fn) {
+    lwcellr_t res = lwcellERR;
+    lwcell_core_lock();
+    if (conn != NULL && lwcelli_is_valid_conn_ptr(conn) && conn->status.f.active) {
+        conn->recv_batch_fn = recv_batch_fn;
+        res = lwcellOK;
+    }
+    lwcell_core_unlock();
+    return res;
+}
 
-    LWCELL_ASSERT(host != NULL);
-    LWCELL_ASSERT(port > 0);
-    LWCELL_ASSERT(conn_evt_fn != NULL);
+#endif /* LWCELL_CFG_CONN_RECV_BATCH > 0 || __DOXYGEN__ */
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
-    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CIPSTART;
-    LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CIPSTATUS;
-    LWCELL_MSG_VAR_REF(msg).msg.conn_start.num = LWCELL_CFG_MAX_CONNS; /* Set maximal value as invalid number */
-    LWCELL_MSG_VAR_REF(msg).msg.conn_start.conn = conn;
-    LWCELL_MSG_VAR_REF(msg).msg.conn_start.type = type;
-    LWCELL_MSG_VAR_REF(msg).msg.conn_start.host = host;
-    LWCELL_MSG_VAR_REF(msg).msg.conn_start.port = port;
-    LWCELL_MSG_VAR_REF(msg).msg.conn_start.evt_func = conn_evt_fn;
-    LWCELL_MSG_VAR_REF(msg).msg.conn_start.arg = arg;
+#endif /* LWCELL_CFG_CONN_RECV_FN || __DOXYGEN__ */
 
-    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
+#if LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__
+
+/**
+ * \brief           Get number of bytes waiting in device buffer for connection
+ *
+ * Value is updated from `+CIPRXGET` read headers and notifications with length
+ * and on demand with \ref lwcell_conn_query_rx_pending function.
+ * It is as recent as last report of the device
+ *
+ * \param[in]       conn: Connection handle
+ * \return          Number of bytes waiting in device buffer, `0` when device did not report any
+ */
+size_t
+lwcell_conn_get_rx_pending(lwcell_conn_p conn) {
+    size_t len = 0;
+    lwcell_core_lock();
+    if (conn != NULL && lwcelli_is_valid_conn_ptr(conn)) {
+        len = conn->rx_dev_len;
+    }
+    lwcell_core_unlock();
+    return len;
 }
 
 /**
- * \brief           Close specific or all connections
- * \param[in]       conn: Connection handle to close. Set to NULL if you want to close all connections.
+ * \brief           Query device for number of bytes waiting in its buffer for connection
+ *
+ * Command `AT+CIPRXGET=4` is sent and result is available with \ref lwcell_conn_get_rx_pending
+ *
+ * \note            Not available with `AT+CA*` socket commands
+ * \param[in]       conn: Connection handle
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
  * \param[in]       blocking: Status whether command should be blocking or not
  * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
  */
 lwcellr_t
-lwcell_conn_close(lwcell_conn_p conn, const uint32_t blocking) {
-    lwcellr_t res = lwcellOK;
+lwcell_conn_query_rx_pending(lwcell_conn_p conn, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                             const uint32_t blocking) {
     LWCELL_MSG_VAR_DEFINE(msg);
 
     LWCELL_ASSERT(conn != NULL);
 
+    if (LWCELL_CONN_IS_CA()) {
+        return lwcellERRNOTENABLED;
+    }
     CONN_CHECK_CLOSED_IN_CLOSING(conn); /* Check if we can continue */
 
-    /* Proceed with close event at this point! */
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
-    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CIPCLOSE;
-    LWCELL_MSG_VAR_REF(msg).msg.conn_close.conn = conn;
-    LWCELL_MSG_VAR_REF(msg).msg.conn_close.val_id = lwcelli_conn_get_val_id(conn);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(ciprxget));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CIPRXGET_QUERY;
+    LWCELL_MSG_VAR_REF(msg).msg.ciprxget.conn = conn;
+    LWCELL_MSG_VAR_REF(msg).msg.ciprxget.val_id = lwcelli_conn_get_val_id(conn);
 
-    flush_buff(conn);                   /* First flush buffer */
-    res = lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 1000);
-    if (res == lwcellOK && !blocking) { /* Function succedded in non-blocking mode */
-        lwcell_core_lock();
-        LWCELL_DEBUGF(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE,
-                      "[LWCELL CONN] Connection %d set to closing state\r\n", (int)conn->num);
-        conn->status.f.in_closing = 1; /* Connection is in closing mode but not yet closed */
-        lwcell_core_unlock();
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 1000);
+}
+
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__ */
+
+#if LWCELL_CFG_CONN_SEND_FAIR || __DOXYGEN__
+
+/**
+ * \brief           Set send weight of connection
+ *
+ * Weight is number of `AT+CIPSEND` chunks connection sends in one turn,
+ * before its send request yields to requests for other connections.
+ * It is valid until connection is closed
+ *
+ * \param[in]       conn: Connection handle
+ * \param[in]       weight: Number of chunks per turn. Set to `0` to use \ref LWCELL_CFG_CONN_SEND_FAIR
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_conn_set_send_weight(lwcell_conn_p conn, uint8_t weight) {
+    lwcellr_t res = lwcellERR;
+    lwcell_core_lock();
+    if (conn != NULL && lwcelli_is_valid_conn_ptr(conn)) {
+        conn->send_weight = weight;
+        res = lwcellOK;
     }
+    lwcell_core_unlock();
     return res;
 }
 
+#endif /* LWCELL_CFG_CONN_SEND_FAIR || __DOXYGEN__ */
+
+#if LWCELL_CFG_CONN_SEND_DEADLINE || __DOXYGEN__
+
 /**
- * \brief           Send data on active connection of type UDP to specific remote IP and port
- * \note            In case IP and port values are not set, it will behave as normal send function (suitable for TCP too)
+ * \brief           Send data on active connection, with deadline for data to leave the queue
+ *
+ * Data not sent to device before deadline passes are dropped, before send starts or between `AT+CIPSEND` chunks.
+ * Dropped request is reported with \ref lwcellERRSTALE result, \ref lwcell_conn_send_cancel drops it earlier.
+ * Chunk already written to device is always sent completely
+ *
  * \param[in]       conn: Connection handle to send data
- * \param[in]       ip: Remote IP address for UDP connection
- * \param[in]       port: Remote port connection
- * \param[in]       data: Pointer to data to send
+ * \param[in]       data: Data to send
  * \param[in]       btw: Number of bytes to send
  * \param[out]      bw: Pointer to output variable to save number of sent data when successfully sent
+ * \param[in]       deadline_ms: Time in units of milliseconds, from now, for data to be sent.
+ *                      Set to `0` to only allow cancellation
+ * \param[out]      id: Pointer to output variable to save send handle. Set to `NULL` if not used
  * \param[in]       blocking: Status whether command should be blocking or not
  * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
  */
 lwcellr_t
-lwcell_conn_sendto(lwcell_conn_p conn, const lwcell_ip_t* const ip, lwcell_port_t port, const void* data, size_t btw,
-                   size_t* bw, const uint32_t blocking) {
+lwcell_conn_send_deadline(lwcell_conn_p conn, const void* data, size_t btw, size_t* const bw, uint32_t deadline_ms,
+                          lwcell_conn_send_id_t* const id, const uint32_t blocking) {
     LWCELL_ASSERT(conn != NULL);
 
-    flush_buff(conn); /* Flush currently written memory if exists */
-    return conn_send(conn, ip, port, data, btw, bw, 0, blocking);
+    if (id != NULL) {
+        *id = 0;
+    }
+    flush_buff(conn); /* Flush currently written memory if exists, to keep data in order */
+    return conn_send(conn, NULL, 0, data, btw, bw, 0, deadline_ms, id, blocking);
 }
 
 /**
- * \brief           Send data on already active connection either as client or server
- * \param[in]       conn: Connection handle to send data
- * \param[in]       data: Data to send
- * \param[in]       btw: Number of bytes to send
- * \param[out]      bw: Pointer to output variable to save number of sent data when successfully sent.
- *                      Parameter value might not be accurate if you combine \ref lwcell_conn_write and \ref lwcell_conn_send functions
- * \param[in]       blocking: Status whether command should be blocking or not
- * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ * \brief           Cancel send request, started with \ref lwcell_conn_send_deadline
+ *
+ * Request waiting in queue is dropped before it starts, request in progress is dropped before its next chunk.
+ * \ref LWCELL_EVT_CONN_SEND event reports \ref lwcellERRSTALE result for dropped request
+ *
+ * \param[in]       id: Send handle
+ * \return          \ref lwcellOK on success, \ref lwcellERR when request already finished
  */
 lwcellr_t
-lwcell_conn_send(lwcell_conn_p conn, const void* data, size_t btw, size_t* const bw, const uint32_t blocking) {
-    lwcellr_t res;
-    const uint8_t* d = data;
+lwcell_conn_send_cancel(lwcell_conn_send_id_t id) {
+    lwcellr_t res = lwcellERR;
 
-    LWCELL_ASSERT(conn != NULL);
-    LWCELL_ASSERT(data != NULL);
-    LWCELL_ASSERT(btw > 0);
+    LWCELL_ASSERT(id != 0);
 
     lwcell_core_lock();
-    if (conn->buff.buff != NULL) { /* Check if memory available */
-        size_t to_copy;
-        to_copy = LWCELL_MIN(btw, conn->buff.len - conn->buff.ptr);
-        if (to_copy > 0) {
-            LWCELL_MEMCPY(&conn->buff.buff[conn->buff.ptr], d, to_copy);
-            conn->buff.ptr += to_copy;
-            d += to_copy;
-            btw -= to_copy;
+    for (lwcell_msg_t* m = lwcell.m.conn_send_pending; m != NULL; m = m->msg.conn_send.pending_next) {
+        if (m->msg.conn_send.id == id) {
+            m->msg.conn_send.cancelled = 1;
+            res = lwcellOK;
+            break;
         }
     }
     lwcell_core_unlock();
-    res = flush_buff(conn); /* Flush currently written memory if exists */
-    if (btw > 0) {          /* Check for remaining data */
-        res = conn_send(conn, NULL, 0, d, btw, bw, 0, blocking);
-    }
     return res;
 }
 
+#endif /* LWCELL_CFG_CONN_SEND_DEADLINE || __DOXYGEN__ */
+
+#if LWCELL_CFG_CONN_TX_WINDOW > 0 || __DOXYGEN__
+
 /**
- * \brief           Notify connection about received data which means connection is ready to accept more data
+ * \brief           Set whether send requests on connection wait for transmit window
  *
- * Once data reception is confirmed, stack will try to send more data to user.
+ * Send requests on deferred connection are grouped and released in transmit windows,
+ * every \ref LWCELL_CFG_CONN_TX_WINDOW milliseconds, to save energy of the radio.
+ * Use it for low priority traffic, such as telemetry or MQTT publish of MQTT client connection.
+ * It is valid until connection is closed
  *
- * \note            Since this feature is not supported yet by AT commands, function is only prototype
- *                  and should be used in connection callback when data are received
+ * \param[in]       conn: Connection handle
+ * \param[in]       deferred: Set to `1` to defer send requests, `0` to send them immediately
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ * \sa              lwcell_conn_tx_window_open
+ */
+lwcellr_t
+lwcell_conn_set_tx_deferred(lwcell_conn_p conn, uint8_t deferred) {
+    lwcellr_t res = lwcellERR;
+    lwcell_core_lock();
+    if (conn != NULL && lwcelli_is_valid_conn_ptr(conn) && conn->status.f.active) {
+        conn->status.f.tx_deferred = deferred > 0;
+        res = lwcellOK;
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Open transmit window immediately
  *
- * \note            Function is not thread safe and may only be called from connection event function
+ * Deferred send requests are released now, as well as requests
+ * queued within \ref LWCELL_CFG_CONN_TX_WINDOW_HOLD milliseconds.
+ * Call it after urgent send on deferred connection, to not wait for next window
  *
- * \param[in]       conn: Connection handle
- * \param[in]       pbuf: Packet buffer received on connection
  * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
  */
 lwcellr_t
-lwcell_conn_recved(lwcell_conn_p conn, lwcell_pbuf_p pbuf) {
-    LWCELL_UNUSED(conn);
-    LWCELL_UNUSED(pbuf);
+lwcell_conn_tx_window_open(void) {
+    lwcell_core_lock();
+    lwcelli_conn_tx_window_activity();
+    lwcell_core_unlock();
     return lwcellOK;
 }
 
+#endif /* LWCELL_CFG_CONN_TX_WINDOW > 0 || __DOXYGEN__ */
+
+#if LWCELL_CFG_CONN_SEND_STREAM || __DOXYGEN__
+
 /**
- * \brief           Set argument variable for connection
- * \param[in]       conn: Connection handle to set argument
- * \param[in]       arg: Pointer to argument
+ * \brief           Send data on active connection, read from application source chunk by chunk
+ *
+ * Read function is called after device sent `> ` prompt for every `AT+CIPSEND` chunk,
+ * data are written to AT port through buffer of \ref LWCELL_CFG_CONN_SEND_STREAM_BUFF_LEN bytes.
+ * Source may be external flash or file, payload is never staged in RAM as a whole
+ *
+ * \note            In non-blocking mode, source must stay readable until \ref LWCELL_EVT_CONN_SEND event is received
+ *
+ * \param[in]       conn: Connection handle to send data
+ * \param[in]       read_fn: Function to read data from source
+ * \param[in]       arg: User argument for read function
+ * \param[in]       total_len: Number of bytes to send
+ * \param[out]      bw: Pointer to output variable to save number of sent data when successfully sent
+ * \param[in]       blocking: Status whether command should be blocking or not
  * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
- * \sa              lwcell_conn_get_arg
  */
 lwcellr_t
-lwcell_conn_set_arg(lwcell_conn_p conn, void* const arg) {
+lwcell_conn_send_stream(lwcell_conn_p conn, lwcell_conn_read_fn read_fn, void* arg, size_t total_len,
+                        size_t* const bw, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(conn != NULL);
+    LWCELL_ASSERT(read_fn != NULL);
+    LWCELL_ASSERT(total_len > 0);
+
+    if (bw != NULL) {
+        *bw = 0;
+    }
+
+    flush_buff(conn); /* Flush currently written memory if exists */
+    CONN_CHECK_CLOSED_IN_CLOSING(conn);
+    CONN_CHECK_QUOTA(conn);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(conn_send));
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CIPSEND;
+    LWCELL_MSG_VAR_REF(msg).is_prio = 1; /* Data path command */
+
+    LWCELL_MSG_VAR_REF(msg).msg.conn_send.conn = conn;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_send.read_fn = read_fn;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_send.read_arg = arg;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_send.btw = total_len;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_send.bw = bw;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_send.val_id = lwcelli_conn_get_val_id(conn);
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
+}
+
+#endif /* LWCELL_CFG_CONN_SEND_STREAM || __DOXYGEN__ */
+
+#if LWCELL_CFG_CONN_SEND_ADAPT || __DOXYGEN__
+
+/**
+ * \brief           Get link quality statistics of connection send path
+ *
+ * Statistics are reset when connection is opened
+ *
+ * \param[in]       conn: Connection handle
+ * \param[out]      stats: Pointer to output statistics structure
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_conn_get_send_stats(lwcell_conn_p conn, lwcell_conn_send_stats_t* stats) {
+    lwcellr_t res = lwcellERR;
+
+    LWCELL_ASSERT(stats != NULL);
+
     lwcell_core_lock();
-    conn->arg = arg; /* Set argument for connection */
+    if (conn != NULL && lwcelli_is_valid_conn_ptr(conn)) {
+        stats->chunk_len = lwcelli_conn_send_chunk_len(conn);
+        stats->pace = conn->send_pace;
+        stats->srtt = conn->send_srtt;
+        stats->loss = (uint8_t)((conn->send_loss * 100U + 127U) / 255U);
+        stats->ok = conn->send_ok;
+        stats->fail = conn->send_fail;
+        res = lwcellOK;
+    }
     lwcell_core_unlock();
-    return lwcellOK;
+    return res;
 }
 
+#endif /* LWCELL_CFG_CONN_SEND_ADAPT || __DOXYGEN__ */
+
 /**
  * \brief           Get user defined connection argument
  * \param[in]       conn: Connection handle to get argument
@@ -360,7 +1483,7 @@ lwcellr_t
 lwcell_get_conns_status(const uint32_t blocking) {
     LWCELL_MSG_VAR_DEFINE(msg);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE_HDR);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CIPSTATUS;
 
     return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 1000);
@@ -442,10 +1565,63 @@ lwcell_conn_get_from_evt(lwcell_evt_t* evt) {
         case LWCELL_EVT_CONN_RECV: return lwcell_evt_conn_recv_get_conn(evt);
         case LWCELL_EVT_CONN_SEND: return lwcell_evt_conn_send_get_conn(evt);
         case LWCELL_EVT_CONN_POLL: return lwcell_evt_conn_poll_get_conn(evt);
+        case LWCELL_EVT_CONN_STATUS_CHANGED: return lwcell_evt_conn_status_changed_get_conn(evt);
+#if LWCELL_CFG_CONN_MANUAL_RECV
+        case LWCELL_EVT_CONN_RX_PENDING: return lwcell_evt_conn_rx_pending_get_conn(evt);
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV */
         default: return NULL;
     }
 }
 
+#if LWCELL_CFG_CONN_WRITE_RING || __DOXYGEN__
+
+/**
+ * \brief           Write data to connection ring write buffer and send it non-blocking way
+ *
+ * Data are sent directly from ring memory when at least \ref LWCELL_CFG_CONN_MAX_DATA_LEN bytes are waiting.
+ * Writing may continue while previously written data are being sent
+ *
+ * \param[in]       conn: Connection to write
+ * \param[in]       data: Data to copy to write buffer
+ * \param[in]       btw: Number of bytes to write
+ * \param[in]       flush: Flush flag. Set to `1` if you want to send data immediately after copying
+ * \param[out]      mem_available: Available memory size in ring write buffer after write operation
+ * \return          \ref lwcellOK on success, \ref lwcellERRMEM when data do not fit to free ring memory
+ *                  (nothing is written in this case), member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_conn_write(lwcell_conn_p conn, const void* data, size_t btw, uint8_t flush, size_t* const mem_available) {
+    lwcellr_t res = lwcellOK;
+
+    LWCELL_ASSERT(conn != NULL);
+
+    LWCELL_CONN_LOCK(conn);
+    if (conn->tx_ring.buff == NULL) {
+        res = lwcellERRMEM; /* Ring was not allocated when connection became active */
+    } else if (btw > 0) {
+        if (lwcell_buff_get_free(&conn->tx_ring) >= btw) {
+            lwcell_buff_write(&conn->tx_ring, data, btw);
+        } else {
+            res = lwcellERRMEM;
+        }
+    }
+    LWCELL_CONN_UNLOCK(conn);
+
+    if (res == lwcellOK) {
+        conn_write_ring_send(conn, flush);
+    }
+
+    /* Calculate number of available memory after write operation */
+    if (mem_available != NULL) {
+        LWCELL_CONN_LOCK(conn);
+        *mem_available = lwcell_buff_get_free(&conn->tx_ring);
+        LWCELL_CONN_UNLOCK(conn);
+    }
+    return res;
+}
+
+#else /* LWCELL_CFG_CONN_WRITE_RING || __DOXYGEN__ */
+
 /**
  * \brief           Write data to connection buffer and if it is full, send it non-blocking way
  * \note            This function may only be called from core (connection callbacks)
@@ -461,7 +1637,9 @@ lwcell_conn_get_from_evt(lwcell_evt_t* evt) {
  */
 lwcellr_t
 lwcell_conn_write(lwcell_conn_p conn, const void* data, size_t btw, uint8_t flush, size_t* const mem_available) {
-    size_t len;
+    lwcellr_t res = lwcellOK;
+    size_t len, buff_len = 0;
+    uint8_t *buff = NULL, has_buff;
     const uint8_t* d = data;
 
     LWCELL_ASSERT(conn != NULL);
@@ -480,6 +1658,7 @@ lwcell_conn_write(lwcell_conn_p conn, const void* data, size_t btw, uint8_t flus
      */
 
     /* Step 1 */
+    LWCELL_CONN_LOCK(conn);
     if (conn->buff.buff != NULL) {
         len = LWCELL_MIN(conn->buff.len - conn->buff.ptr, btw);
         LWCELL_MEMCPY(&conn->buff.buff[conn->buff.ptr], d, len);
@@ -490,28 +1669,34 @@ lwcell_conn_write(lwcell_conn_p conn, const void* data, size_t btw, uint8_t flus
 
         /* Step 1.1 */
         if (conn->buff.ptr == conn->buff.len || flush) {
-            /* Try to send to processing queue in non-blocking way */
-            if (conn_send(conn, NULL, 0, conn->buff.buff, conn->buff.ptr, NULL, 1, 0) != lwcellOK) {
-                LWCELL_DEBUGF(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE, "[LWCELL CONN] Free write buffer: %p\r\n",
-                              conn->buff.buff);
-                lwcell_mem_free_s((void**)&conn->buff.buff);
-            }
+            buff = conn->buff.buff; /* Detach buffer, sent outside lock */
+            buff_len = conn->buff.ptr;
             conn->buff.buff = NULL;
         }
     }
+    LWCELL_CONN_UNLOCK(conn);
+    if (buff != NULL) {
+        /* Try to send to processing queue in non-blocking way */
+        if (conn_send(conn, NULL, 0, buff, buff_len, NULL, 1, 0, NULL, 0) != lwcellOK) {
+            LWCELL_DEBUGF(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE, "[LWCELL CONN] Free write buffer: %p\r\n",
+                          (void*)buff);
+            lwcell_mem_free_s((void**)&buff);
+        }
+        buff = NULL;
+    }
 
     /* Step 2 */
     while (btw >= LWCELL_CFG_CONN_MAX_DATA_LEN) {
-        uint8_t* buff;
-        buff = lwcell_mem_malloc(sizeof(*buff) * LWCELL_CFG_CONN_MAX_DATA_LEN);
+        buff = lwcell_mem_malloc_tag(sizeof(*buff) * LWCELL_CFG_CONN_MAX_DATA_LEN, LWCELL_MEM_TAG_CONN);
         if (buff != NULL) {
             LWCELL_MEMCPY(buff, d, LWCELL_CFG_CONN_MAX_DATA_LEN); /* Copy data to buffer */
-            if (conn_send(conn, NULL, 0, buff, LWCELL_CFG_CONN_MAX_DATA_LEN, NULL, 1, 0) != lwcellOK) {
+            if (conn_send(conn, NULL, 0, buff, LWCELL_CFG_CONN_MAX_DATA_LEN, NULL, 1, 0, NULL, 0) != lwcellOK) {
                 LWCELL_DEBUGF(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE, "[LWCELL CONN] Free write buffer: %p\r\n",
                               (void*)buff);
                 lwcell_mem_free_s((void**)&buff);
                 return lwcellERRMEM;
             }
+            buff = NULL;
         } else {
             return lwcellERRMEM;
         }
@@ -520,42 +1705,62 @@ lwcell_conn_write(lwcell_conn_p conn, const void* data, size_t btw, uint8_t flus
         d += LWCELL_CFG_CONN_MAX_DATA_LEN;   /* Advance data pointer */
     }
 
-    /* Step 3 */
-    if (conn->buff.buff == NULL) {
-        conn->buff.buff = lwcell_mem_malloc(sizeof(*conn->buff.buff) * LWCELL_CFG_CONN_MAX_DATA_LEN);
-        conn->buff.len = LWCELL_CFG_CONN_MAX_DATA_LEN;
-        conn->buff.ptr = 0;
+    /* Step 3, allocate outside lock as allocator uses core lock */
+    LWCELL_CONN_LOCK(conn);
+    has_buff = conn->buff.buff != NULL;
+    LWCELL_CONN_UNLOCK(conn);
+    if (!has_buff) {
+        buff = lwcell_mem_malloc_tag(sizeof(*buff) * LWCELL_CFG_CONN_MAX_DATA_LEN, LWCELL_MEM_TAG_CONN);
 
-        LWCELL_DEBUGW(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE, conn->buff.buff != NULL,
-                      "[LWCELL CONN] New write buffer allocated, addr = %p\r\n", conn->buff.buff);
-        LWCELL_DEBUGW(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE, conn->buff.buff == NULL,
+        LWCELL_DEBUGW(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE, buff != NULL,
+                      "[LWCELL CONN] New write buffer allocated, addr = %p\r\n", (void*)buff);
+        LWCELL_DEBUGW(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE, buff == NULL,
                       "[LWCELL CONN] Cannot allocate new write buffer\r\n");
     }
+    LWCELL_CONN_LOCK(conn);
+    if (conn->buff.buff == NULL && buff != NULL) {
+        conn->buff.buff = buff;
+        conn->buff.len = LWCELL_CFG_CONN_MAX_DATA_LEN;
+        conn->buff.ptr = 0;
+        buff = NULL;
+    }
     if (btw > 0) {
         if (conn->buff.buff != NULL) {
             LWCELL_MEMCPY(conn->buff.buff, d, btw); /* Copy data to memory */
             conn->buff.ptr = btw;
         } else {
-            return lwcellERRMEM;
+            res = lwcellERRMEM;
         }
     }
+    has_buff = conn->buff.buff != NULL;
+    LWCELL_CONN_UNLOCK(conn);
+    if (buff != NULL) { /* Buffer was set by other thread in the meantime */
+        lwcell_mem_free_s((void**)&buff);
+    }
+    if (res != lwcellOK) {
+        return res;
+    }
 
     /* Step 4 */
-    if (flush && conn->buff.buff != NULL) {
+    if (flush && has_buff) {
         flush_buff(conn);
     }
 
     /* Calculate number of available memory after write operation */
     if (mem_available != NULL) {
+        LWCELL_CONN_LOCK(conn);
         if (conn->buff.buff != NULL) {
             *mem_available = conn->buff.len - conn->buff.ptr;
         } else {
             *mem_available = 0;
         }
+        LWCELL_CONN_UNLOCK(conn);
     }
     return lwcellOK;
 }
 
+#endif /* !(LWCELL_CFG_CONN_WRITE_RING || __DOXYGEN__) */
+
 /**
  * \brief           Get total number of bytes ever received on connection and sent to user
  * \param[in]       conn: Connection handle
@@ -567,9 +1772,9 @@ lwcell_conn_get_total_recved_count(lwcell_conn_p conn) {
 
     LWCELL_ASSERT(conn != NULL);
 
-    lwcell_core_lock();
+    LWCELL_CONN_LOCK(conn);
     tot = conn->total_recved; /* Get total received bytes */
-    lwcell_core_unlock();
+    LWCELL_CONN_UNLOCK(conn);
 
     return tot;
 }
@@ -623,4 +1828,21 @@ lwcell_conn_get_local_port(lwcell_conn_p conn) {
     return port;
 }
 
+/**
+ * \brief           Get last connection state reported by device
+ * \note            State is refreshed by \ref lwcell_get_conns_status and by connection URCs
+ * \param[in]       conn: Connection handle
+ * \return          Member of \ref lwcell_conn_state_t enumeration
+ */
+lwcell_conn_state_t
+lwcell_conn_get_state(lwcell_conn_p conn) {
+    lwcell_conn_state_t state = LWCELL_CONN_STATE_UNKNOWN;
+    if (conn != NULL) {
+        lwcell_core_lock();
+        state = conn->state;
+        lwcell_core_unlock();
+    }
+    return state;
+}
+
 #endif /* LWCELL_CFG_CONN || __DOXYGEN__ */
@@ -0,0 +1,236 @@
+/**
+ * \file            lwcell_cq.c
+ * \brief           Batch command submission with completion queue
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_cq.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_CQ || __DOXYGEN__
+
+/**
+ * \brief           Initialize completion queue
+ * \param[in]       cq: Completion queue to initialize
+ * \param[in]       ring: Completion ring, valid for completion queue lifetime
+ * \param[in]       size: Number of entries in `ring`. Limits number of commands in flight
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_cq_init(lwcell_cq_t* cq, lwcell_cqe_t* ring, size_t size) {
+    LWCELL_ASSERT(cq != NULL);
+    LWCELL_ASSERT(ring != NULL);
+    LWCELL_ASSERT(size > 0);
+
+    LWCELL_MEMSET(cq, 0x00, sizeof(*cq));
+    if (!lwcell_sys_sem_create(&cq->sem, 0)) {
+        return lwcellERRMEM;
+    }
+    cq->ring = ring;
+    cq->size = size;
+    return lwcellOK;
+}
+
+/**
+ * \brief           Deinitialize completion queue
+ * \param[in]       cq: Completion queue
+ * \return          \ref lwcellOK on success, \ref lwcellERR when commands are still in flight
+ */
+lwcellr_t
+lwcell_cq_deinit(lwcell_cq_t* cq) {
+    lwcellr_t res = lwcellOK;
+
+    LWCELL_ASSERT(cq != NULL);
+
+    lwcell_core_lock();
+    if (cq->inflight > 0) {
+        res = lwcellERR;
+    }
+    lwcell_core_unlock();
+    if (res == lwcellOK && lwcell_sys_sem_isvalid(&cq->sem)) {
+        lwcell_sys_sem_delete(&cq->sem);
+        lwcell_sys_sem_invalid(&cq->sem);
+    }
+    return res;
+}
+
+/**
+ * \brief           Start building batch of commands
+ *
+ * Function locks the core until \ref lwcell_cq_submit is called.
+ * Non-blocking API calls in between are added to the batch, instead of being put to producer queue.
+ * Blocking calls fail with \ref lwcellERRBLOCKING.
+ *
+ * \param[in]       cq: Completion queue for batch results
+ * \return          \ref lwcellOK on success, \ref lwcellERR if batch is already being built
+ */
+lwcellr_t
+lwcell_cq_begin(lwcell_cq_t* cq) {
+    LWCELL_ASSERT(cq != NULL);
+
+    lwcell_core_lock();
+    if (lwcell.cq_capture != NULL) {
+        lwcell_core_unlock();
+        return lwcellERR;
+    }
+    lwcell.cq_capture = cq;
+    cq->first = cq->last = NULL;
+    cq->cnt = 0;
+    cq->data = NULL;
+    return lwcellOK;
+}
+
+/**
+ * \brief           Set user data, reported in completion entry of next added command
+ * \param[in]       cq: Completion queue
+ * \param[in]       data: User data
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_cq_set_data(lwcell_cq_t* cq, void* data) {
+    LWCELL_ASSERT(cq != NULL);
+    cq->data = data;
+    return lwcellOK;
+}
+
+/**
+ * \brief           Put built batch to producer queue and unlock the core
+ * \param[in]       cq: Completion queue, used with \ref lwcell_cq_begin
+ * \param[out]      cnt: Output variable to save number of submitted commands. Set to `NULL` when not used
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_cq_submit(lwcell_cq_t* cq, size_t* cnt) {
+    lwcell_msg_t* first;
+
+    LWCELL_ASSERT(cq != NULL);
+    LWCELL_ASSERT(lwcell.cq_capture == cq);
+
+    lwcell.cq_capture = NULL;
+    first = cq->first;
+    if (cnt != NULL) {
+        *cnt = cq->cnt;
+    }
+    cq->first = cq->last = NULL;
+    cq->cnt = 0;
+    lwcell_core_unlock();
+
+    if (first != NULL) {
+        /* Queue may be full, producer needs core to empty it, hence put is done without lock */
+        lwcell_sys_mbox_put(&lwcell.mbox_producer, first);
+    }
+    return lwcellOK;
+}
+
+/**
+ * \brief           Take completion entry, if available
+ * \param[in]       cq: Completion queue
+ * \param[out]      cqe: Output variable to save entry to
+ * \return          `1` if entry was taken, `0` otherwise
+ */
+uint8_t
+lwcell_cq_get(lwcell_cq_t* cq, lwcell_cqe_t* cqe) {
+    uint8_t res = 0;
+
+    LWCELL_ASSERT(cq != NULL);
+    LWCELL_ASSERT(cqe != NULL);
+
+    lwcell_core_lock();
+    if (cq->ready > 0) {
+        *cqe = cq->ring[cq->r];
+        cq->r = (cq->r + 1) % cq->size;
+        --cq->ready;
+        --cq->inflight;
+        res = 1;
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Wait for completion entry
+ * \param[in]       cq: Completion queue
+ * \param[out]      cqe: Output variable to save entry to
+ * \param[in]       timeout: Maximal time to wait in units of milliseconds, `0` to wait forever
+ * \return          \ref lwcellOK when entry was taken, \ref lwcellTIMEOUT otherwise
+ */
+lwcellr_t
+lwcell_cq_wait(lwcell_cq_t* cq, lwcell_cqe_t* cqe, uint32_t timeout) {
+    while (!lwcell_cq_get(cq, cqe)) {
+        if (lwcell_sys_sem_wait(&cq->sem, timeout) == LWCELL_SYS_TIMEOUT) {
+            return lwcell_cq_get(cq, cqe) ? lwcellOK : lwcellTIMEOUT;
+        }
+    }
+    return lwcellOK;
+}
+
+/**
+ * \brief           Add message to batch being built, instead of putting it to producer queue
+ * \note            Function must be called with core locked
+ * \param[in]       cq: Completion queue, set by \ref lwcell_cq_begin
+ * \param[in]       msg: Non-blocking message, ready for execution
+ * \return          \ref lwcellOK on success, \ref lwcellERRMEM when completion ring is full
+ */
+lwcellr_t
+lwcelli_cq_add(lwcell_cq_t* cq, lwcell_msg_t* msg) {
+    if (cq->inflight >= cq->size) {
+        return lwcellERRMEM; /* Completion could not be stored */
+    }
+    msg->cq = cq;
+    msg->cq_data = cq->data;
+    msg->cq_next = NULL;
+    if (cq->last != NULL) {
+        cq->last->cq_next = msg;
+    } else {
+        cq->first = msg;
+    }
+    cq->last = msg;
+    ++cq->cnt;
+    ++cq->inflight;
+    return lwcellOK;
+}
+
+/**
+ * \brief           Write result of finished batch message to its completion ring
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Finished message
+ */
+void
+lwcelli_cq_complete(lwcell_msg_t* msg) {
+    lwcell_cq_t* cq = msg->cq;
+
+    cq->ring[cq->w].data = msg->cq_data;
+    cq->ring[cq->w].res = msg->res;
+    cq->w = (cq->w + 1) % cq->size;
+    ++cq->ready;
+    lwcell_sys_sem_release(&cq->sem);
+}
+
+#endif /* LWCELL_CFG_CQ || __DOXYGEN__ */
@@ -31,8 +31,10 @@
  * Author:          Tilen MAJERLE <tilen@majerle.eu>
  * Version:         v0.1.1
  */
+#include <stdarg.h>
 #include "lwcell/lwcell_debug.h"
 #include "lwcell/lwcell_private.h"
+#include "lwcell/lwcell_utils.h"
 
 #if LWCELL_CFG_DBG || __DOXYGEN__
 
@@ -46,4 +48,471 @@ lwcelli_dbg_msg_to_string(lwcell_cmd_t cmd) {
     return "";
 }
 
+#if LWCELL_CFG_DBG_RUNTIME || __DOXYGEN__
+
+/* Runtime filter, read by every debug message that passes compile-time filter */
+uint16_t lwcelli_debug_mask = LWCELL_DEBUG_RT_MASK(LWCELL_CFG_DBG_RUNTIME_TYPES_ON, LWCELL_CFG_DBG_LVL_MIN);
+static uint8_t debug_types = LWCELL_CFG_DBG_RUNTIME_TYPES_ON;
+static uint8_t debug_lvl_min = LWCELL_CFG_DBG_LVL_MIN;
+
+/**
+ * \brief           Set debug types and minimal level at runtime
+ *
+ * Only messages enabled at compile time with \ref LWCELL_CFG_DBG_TYPES_ON, \ref LWCELL_CFG_DBG_LVL_MIN
+ * and module debug option can be enabled. Set `types` to `0` to disable all messages.
+ *
+ * \note            Function can be called from any thread and before \ref lwcell_init,
+ *                  new mask is used by following messages
+ * \param[in]       types: Enabled debug types, check \ref LWCELL_DBG_TYPE
+ * \param[in]       lvl_min: Minimal debug level, check \ref LWCELL_DBG_LVL
+ */
+void
+lwcell_debug_set_mask(uint8_t types, uint8_t lvl_min) {
+    debug_types = types & LWCELL_DBG_TYPE_ALL;
+    debug_lvl_min = lvl_min & LWCELL_DBG_LVL_MASK;
+    lwcelli_debug_mask = LWCELL_DEBUG_RT_MASK(debug_types, debug_lvl_min);
+}
+
+/**
+ * \brief           Get debug types and minimal level, set with \ref lwcell_debug_set_mask
+ * \param[out]      types: Pointer to output variable to save enabled debug types. Can be set to `NULL`
+ * \param[out]      lvl_min: Pointer to output variable to save minimal debug level. Can be set to `NULL`
+ */
+void
+lwcell_debug_get_mask(uint8_t* types, uint8_t* lvl_min) {
+    if (types != NULL) {
+        *types = debug_types;
+    }
+    if (lvl_min != NULL) {
+        *lvl_min = debug_lvl_min;
+    }
+}
+
+#endif /* LWCELL_CFG_DBG_RUNTIME || __DOXYGEN__ */
+
+#if LWCELL_CFG_DBG_DEFERRED || __DOXYGEN__
+
+/**
+ * \brief           Argument type of single conversion specifier
+ */
+typedef enum {
+    DBG_ARG_NONE = 0x00, /*!< No argument, such as `%%` */
+    DBG_ARG_INT,         /*!< `int` or promoted smaller type */
+    DBG_ARG_LONG,        /*!< `long` */
+    DBG_ARG_LLONG,       /*!< `long long` */
+    DBG_ARG_SIZE,        /*!< `size_t` */
+    DBG_ARG_PTR,         /*!< `void*` */
+    DBG_ARG_STR,         /*!< `const char*`, copied at record time */
+    DBG_ARG_DOUBLE,      /*!< `double` */
+} dbg_arg_type_t;
+
+/**
+ * \brief           Parsed conversion specifier
+ */
+typedef struct {
+    dbg_arg_type_t type; /*!< Argument type */
+    uint8_t stars;       /*!< Number of `*` width/precision arguments before value */
+    size_t len;          /*!< Length of specifier, including leading `%` */
+} dbg_spec_t;
+
+/* Record header: length and format string address */
+#define DBG_REC_HDR_LEN (sizeof(uint16_t) + sizeof(const char*))
+
+static uint8_t dbg_buff_data[LWCELL_CFG_DBG_DEFERRED_BUFF_SIZE];
+static lwcell_buff_t dbg_buff = {.buff = dbg_buff_data, .size = sizeof(dbg_buff_data)};
+static uint32_t dbg_dropped;
+static uint8_t dbg_ready;
+#if LWCELL_CFG_DBG_DEFERRED_THREAD
+static lwcell_sys_thread_t dbg_thread;
+#endif /* LWCELL_CFG_DBG_DEFERRED_THREAD */
+
+/**
+ * \brief           Parse conversion specifier, only type information is extracted
+ * \param[in]       fmt: Pointer to `%` character in format string
+ * \param[out]      spec: Parsed specifier output
+ */
+static void
+prv_parse_spec(const char* fmt, dbg_spec_t* spec) {
+    const char* f = fmt + 1;
+    uint8_t lng = 0, sz = 0;
+
+    spec->stars = 0;
+    while (*f != '\0' && strchr("-+ #0", *f) != NULL) { /* Flags */
+        ++f;
+    }
+    for (uint8_t i = 0; i < 2; ++i) { /* Width, then precision */
+        if (i > 0) {
+            if (*f != '.') {
+                break;
+            }
+            ++f;
+        }
+        if (*f == '*') {
+            ++spec->stars;
+            ++f;
+        } else {
+            while (LWCELL_CHARISNUM(*f)) {
+                ++f;
+            }
+        }
+    }
+    while (*f != '\0' && strchr("hlzjtL", *f) != NULL) { /* Length modifiers */
+        lng += *f == 'l';
+        sz |= *f == 'z' || *f == 'j' || *f == 't';
+        ++f;
+    }
+    switch (*f) {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+        case 'c':
+            spec->type = sz ? DBG_ARG_SIZE : lng > 1 ? DBG_ARG_LLONG : lng ? DBG_ARG_LONG : DBG_ARG_INT;
+            break;
+        case 'p': spec->type = DBG_ARG_PTR; break;
+        case 's': spec->type = DBG_ARG_STR; break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G': spec->type = DBG_ARG_DOUBLE; break;
+        default: spec->type = DBG_ARG_NONE; break;
+    }
+    if (*f != '\0') {
+        ++f;
+    }
+    spec->len = f - fmt;
+}
+
+/**
+ * \brief           Record debug message to deferred ring buffer
+ *
+ * No formatting is done, only arguments are copied according to format specifiers
+ *
+ * \param[in]       fmt: Format string, must stay valid (typically string literal)
+ * \param[in]       ...: Arguments for format string
+ */
+void
+lwcelli_debug_deferred_record(const char* fmt, ...) {
+    uint8_t rec[LWCELL_CFG_DBG_DEFERRED_REC_MAX_LEN];
+    size_t pos = DBG_REC_HDR_LEN;
+    int stars[2] = {-1, -1};
+    uint16_t rec_len;
+    dbg_spec_t spec;
+    va_list ap;
+
+    if (!dbg_ready) {
+        ++dbg_dropped;
+        return;
+    }
+
+/* Copy variable to record if it fits */
+#define DBG_REC_PUT(val)                                                                                               \
+    do {                                                                                                               \
+        if (pos + sizeof(val) <= sizeof(rec)) {                                                                        \
+            LWCELL_MEMCPY(&rec[pos], &(val), sizeof(val));                                                             \
+        }                                                                                                              \
+        pos += sizeof(val);                                                                                            \
+    } while (0)
+
+    va_start(ap, fmt);
+    for (const char* f = fmt; *f != '\0' && pos <= sizeof(rec); ++f) {
+        if (*f != '%') {
+            continue;
+        }
+        prv_parse_spec(f, &spec);
+        for (uint8_t i = 0; i < spec.stars; ++i) {
+            stars[i] = va_arg(ap, int);
+            DBG_REC_PUT(stars[i]);
+        }
+        switch (spec.type) {
+            case DBG_ARG_INT: {
+                int v = va_arg(ap, int);
+                DBG_REC_PUT(v);
+                break;
+            }
+            case DBG_ARG_LONG: {
+                long v = va_arg(ap, long);
+                DBG_REC_PUT(v);
+                break;
+            }
+            case DBG_ARG_LLONG: {
+                long long v = va_arg(ap, long long);
+                DBG_REC_PUT(v);
+                break;
+            }
+            case DBG_ARG_SIZE: {
+                size_t v = va_arg(ap, size_t);
+                DBG_REC_PUT(v);
+                break;
+            }
+            case DBG_ARG_PTR: {
+                void* v = va_arg(ap, void*);
+                DBG_REC_PUT(v);
+                break;
+            }
+            case DBG_ARG_DOUBLE: {
+                double v = va_arg(ap, double);
+                DBG_REC_PUT(v);
+                break;
+            }
+            case DBG_ARG_STR: {
+                const char* v = va_arg(ap, const char*);
+                size_t max = LWCELL_CFG_DBG_DEFERRED_STR_MAX_LEN;
+                uint8_t l = 0;
+
+                if (spec.stars > 0 && stars[spec.stars - 1] >= 0 && (size_t)stars[spec.stars - 1] < max) {
+                    max = stars[spec.stars - 1]; /* Precision limits characters to copy */
+                }
+                if (v == NULL) {
+                    v = "(null)";
+                }
+                while (l < max && v[l] != '\0') {
+                    ++l;
+                }
+                DBG_REC_PUT(l);
+                if (pos + l <= sizeof(rec)) {
+                    LWCELL_MEMCPY(&rec[pos], v, l);
+                }
+                pos += l;
+                break;
+            }
+            default: break;
+        }
+        f += spec.len - 1;
+    }
+    va_end(ap);
+#undef DBG_REC_PUT
+
+    /* Truncated record keeps arguments that fit, formatter stops at first missing one */
+    if (pos > sizeof(rec)) {
+        pos = sizeof(rec);
+    }
+    rec_len = (uint16_t)pos;
+    LWCELL_MEMCPY(&rec[0], &rec_len, sizeof(rec_len));
+    LWCELL_MEMCPY(&rec[sizeof(rec_len)], &fmt, sizeof(fmt));
+
+    /* Multiple producers are serialized, reader is lock-free */
+    lwcell_sys_protect();
+    if (lwcell_buff_get_free(&dbg_buff) >= rec_len) {
+        lwcell_buff_write(&dbg_buff, rec, rec_len);
+    } else {
+        ++dbg_dropped;
+    }
+    lwcell_sys_unprotect();
+}
+
+/**
+ * \brief           Format single record and send it to \ref LWCELL_CFG_DBG_OUT
+ * \param[in]       rec: Record data
+ * \param[in]       rec_len: Record length in units of bytes
+ */
+static void
+prv_format_record(const uint8_t* rec, size_t rec_len) {
+    char line[LWCELL_CFG_DBG_DEFERRED_REC_MAX_LEN];
+    char fmt_spec[16], str[LWCELL_CFG_DBG_DEFERRED_STR_MAX_LEN + 1];
+    size_t pos = DBG_REC_HDR_LEN, out = 0;
+    const char* fmt;
+    dbg_spec_t spec;
+    int stars[2] = {0, 0}, n;
+
+    LWCELL_MEMCPY(&fmt, &rec[sizeof(uint16_t)], sizeof(fmt));
+
+/* Get variable from record, stop formatting when record has been truncated */
+#define DBG_REC_GET(val)                                                                                               \
+    if (pos + sizeof(val) > rec_len) {                                                                                 \
+        goto trunc;                                                                                                    \
+    }                                                                                                                  \
+    LWCELL_MEMCPY(&(val), &rec[pos], sizeof(val));                                                                     \
+    pos += sizeof(val)
+
+/* Format value with optional star arguments */
+#define DBG_REC_FMT(val)                                                                                               \
+    n = spec.stars == 0   ? snprintf(&line[out], sizeof(line) - out, fmt_spec, val)                                    \
+        : spec.stars == 1 ? snprintf(&line[out], sizeof(line) - out, fmt_spec, stars[0], val)                          \
+                          : snprintf(&line[out], sizeof(line) - out, fmt_spec, stars[0], stars[1], val)
+
+    for (const char* f = fmt; *f != '\0' && out < sizeof(line) - 1;) {
+        if (*f != '%') {
+            line[out++] = *f++;
+            continue;
+        }
+        prv_parse_spec(f, &spec);
+        if (spec.len >= sizeof(fmt_spec)) {
+            break;
+        }
+        LWCELL_MEMCPY(fmt_spec, f, spec.len);
+        fmt_spec[spec.len] = '\0';
+        f += spec.len;
+        for (uint8_t i = 0; i < spec.stars; ++i) {
+            DBG_REC_GET(stars[i]);
+        }
+        n = 0;
+        switch (spec.type) {
+            case DBG_ARG_INT: {
+                int v;
+                DBG_REC_GET(v);
+                DBG_REC_FMT(v);
+                break;
+            }
+            case DBG_ARG_LONG: {
+                long v;
+                DBG_REC_GET(v);
+                DBG_REC_FMT(v);
+                break;
+            }
+            case DBG_ARG_LLONG: {
+                long long v;
+                DBG_REC_GET(v);
+                DBG_REC_FMT(v);
+                break;
+            }
+            case DBG_ARG_SIZE: {
+                size_t v;
+                DBG_REC_GET(v);
+                DBG_REC_FMT(v);
+                break;
+            }
+            case DBG_ARG_PTR: {
+                void* v;
+                DBG_REC_GET(v);
+                DBG_REC_FMT(v);
+                break;
+            }
+            case DBG_ARG_DOUBLE: {
+                double v;
+                DBG_REC_GET(v);
+                DBG_REC_FMT(v);
+                break;
+            }
+            case DBG_ARG_STR: {
+                uint8_t l;
+                DBG_REC_GET(l);
+                if (pos + l > rec_len) {
+                    goto trunc;
+                }
+                LWCELL_MEMCPY(str, &rec[pos], l);
+                str[l] = '\0';
+                pos += l;
+                DBG_REC_FMT(str);
+                break;
+            }
+            default: {
+                if (fmt_spec[spec.len - 1] == '%') {
+                    line[out] = '%';
+                    n = 1;
+                }
+                break;
+            }
+        }
+        if (n > 0) {
+            out += LWCELL_MIN((size_t)n, sizeof(line) - 1 - out);
+        }
+    }
+    line[out] = '\0';
+    LWCELL_CFG_DBG_OUT("%s", line);
+    return;
+trunc:
+    line[out] = '\0';
+    LWCELL_CFG_DBG_OUT("%s...\r\n", line);
+#undef DBG_REC_GET
+#undef DBG_REC_FMT
+}
+
+/**
+ * \brief           Format pending deferred debug records with \ref LWCELL_CFG_DBG_OUT
+ *
+ * Function may be called from low-priority thread or idle task.
+ * It must not be called concurrently with \ref lwcell_debug_deferred_read
+ *
+ * \param[in]       max_records: Maximal number of records to format. Set to `0` to format all pending records
+ * \return          Number of formatted records
+ */
+size_t
+lwcell_debug_deferred_flush(size_t max_records) {
+    uint8_t rec[LWCELL_CFG_DBG_DEFERRED_REC_MAX_LEN];
+    uint16_t rec_len;
+    size_t cnt = 0;
+
+    while ((max_records == 0 || cnt < max_records)
+           && lwcell_buff_peek(&dbg_buff, 0, &rec_len, sizeof(rec_len)) == sizeof(rec_len)) {
+        if (lwcell_buff_read(&dbg_buff, rec, rec_len) != rec_len) {
+            break;
+        }
+        prv_format_record(rec, rec_len);
+        ++cnt;
+    }
+    return cnt;
+}
+
+/**
+ * \brief           Read raw deferred records for decoding on the host
+ *
+ * Only complete records are read, record layout is described in \ref LWCELL_DEBUG module.
+ * It must not be called concurrently with \ref lwcell_debug_deferred_flush
+ *
+ * \param[out]      data: Output buffer to copy records to
+ * \param[in]       len: Length of output buffer in units of bytes
+ * \return          Number of bytes copied to output buffer
+ */
+size_t
+lwcell_debug_deferred_read(void* data, size_t len) {
+    uint8_t* d = data;
+    uint16_t rec_len;
+    size_t out = 0;
+
+    while (lwcell_buff_peek(&dbg_buff, 0, &rec_len, sizeof(rec_len)) == sizeof(rec_len) && out + rec_len <= len) {
+        out += lwcell_buff_read(&dbg_buff, &d[out], rec_len);
+    }
+    return out;
+}
+
+/**
+ * \brief           Get number of records dropped due to full ring buffer
+ * \return          Number of dropped records since start
+ */
+uint32_t
+lwcell_debug_deferred_get_dropped(void) {
+    return dbg_dropped;
+}
+
+#if LWCELL_CFG_DBG_DEFERRED_THREAD
+/**
+ * \brief           Debug thread, formats deferred records periodically
+ * \param[in]       arg: Thread argument, not used
+ */
+static void
+prv_debug_thread(void* const arg) {
+    LWCELL_UNUSED(arg);
+    while (1) {
+        lwcell_debug_deferred_flush(0);
+        lwcell_delay(LWCELL_CFG_DBG_DEFERRED_THREAD_PERIOD);
+    }
+}
+#endif /* LWCELL_CFG_DBG_DEFERRED_THREAD */
+
+/**
+ * \brief           Enable deferred recording, called after system initialization
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_debug_deferred_init(void) {
+    if (dbg_ready) {
+        return 1;
+    }
+#if LWCELL_CFG_DBG_DEFERRED_THREAD
+    if (!lwcell_sys_thread_create(&dbg_thread, "lwcell_dbg", prv_debug_thread, NULL, LWCELL_SYS_THREAD_SS,
+                                  LWCELL_CFG_DBG_DEFERRED_THREAD_PRIO)) {
+        return 0;
+    }
+#endif /* LWCELL_CFG_DBG_DEFERRED_THREAD */
+    dbg_ready = 1;
+    return 1;
+}
+
+#endif /* LWCELL_CFG_DBG_DEFERRED || __DOXYGEN__ */
+
 #endif /* LWCELL_CFG_DBG || __DOXYGEN__ */
@@ -34,8 +34,50 @@
 #include "lwcell/lwcell_device_info.h"
 #include "lwcell/lwcell_private.h"
 
+#if LWCELL_CFG_DEVICE_INFO_CACHE || __DOXYGEN__
+
+/**
+ * \brief           Copy device information captured during reset sequence
+ * \param[out]      str: Pointer to output string array
+ * \param[in]       len: Length of string array including `NULL` termination
+ * \param[in]       cached: Value stored in device structure
+ * \param[in]       evt_fn: Callback function called when value is copied. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \return          `1` if value was known and copied, `0` otherwise
+ */
+static uint8_t
+prv_device_info_from_cache(char* str, size_t len, const char* cached, const lwcell_api_cmd_evt_fn evt_fn,
+                           void* const evt_arg) {
+    uint8_t found;
+
+    lwcell_core_lock();
+    found = cached[0] != '\0';
+    if (found) {
+        size_t tocopy = LWCELL_MIN(strlen(cached) + 1, len);
+
+        LWCELL_MEMCPY(str, cached, tocopy);
+        str[tocopy - 1] = '\0';
+    }
+    lwcell_core_unlock();
+    if (found && evt_fn != NULL) {
+        evt_fn(lwcellOK, evt_arg); /* Command is finished before function returns */
+    }
+    return found;
+}
+
+#define DEVICE_INFO_FROM_CACHE(str, len, cached, evt_fn, evt_arg)                                                      \
+    do {                                                                                                               \
+        if (prv_device_info_from_cache((str), (len), (cached), (evt_fn), (evt_arg))) {                                 \
+            return lwcellOK;                                                                                           \
+        }                                                                                                              \
+    } while (0)
+#else /* LWCELL_CFG_DEVICE_INFO_CACHE || __DOXYGEN__ */
+#define DEVICE_INFO_FROM_CACHE(str, len, cached, evt_fn, evt_arg)
+#endif /* !(LWCELL_CFG_DEVICE_INFO_CACHE || __DOXYGEN__) */
+
 /**
  * \brief           Get device manufacturer
+ * \note            With \ref LWCELL_CFG_DEVICE_INFO_CACHE enabled, value read during reset sequence is returned
  * \param[in]       manuf: Pointer to output string array to save manufacturer info
  * \param[in]       len: Length of string array including `NULL` termination
  * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
@@ -51,7 +93,9 @@ lwcell_device_get_manufacturer(char* manuf, size_t len, const lwcell_api_cmd_evt
     LWCELL_ASSERT(manuf != NULL);
     LWCELL_ASSERT(len > 0);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    DEVICE_INFO_FROM_CACHE(manuf, len, lwcell.m.model_manufacturer, evt_fn, evt_arg);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(device_info));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CGMI_GET;
     LWCELL_MSG_VAR_REF(msg).msg.device_info.str = manuf;
@@ -62,6 +106,7 @@ lwcell_device_get_manufacturer(char* manuf, size_t len, const lwcell_api_cmd_evt
 
 /**
  * \brief           Get device model name
+ * \note            With \ref LWCELL_CFG_DEVICE_INFO_CACHE enabled, value read during reset sequence is returned
  * \param[in]       model: Pointer to output string array to save model info
  * \param[in]       len: Length of string array including `NULL` termination
  * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
@@ -77,7 +122,9 @@ lwcell_device_get_model(char* model, size_t len, const lwcell_api_cmd_evt_fn evt
     LWCELL_ASSERT(model != NULL);
     LWCELL_ASSERT(len > 0);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    DEVICE_INFO_FROM_CACHE(model, len, lwcell.m.model_number, evt_fn, evt_arg);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(device_info));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CGMM_GET;
     LWCELL_MSG_VAR_REF(msg).msg.device_info.str = model;
@@ -88,6 +135,7 @@ lwcell_device_get_model(char* model, size_t len, const lwcell_api_cmd_evt_fn evt
 
 /**
  * \brief           Get device revision
+ * \note            With \ref LWCELL_CFG_DEVICE_INFO_CACHE enabled, value read during reset sequence is returned
  * \param[in]       rev: Pointer to output string array to save revision info
  * \param[in]       len: Length of string array including `NULL` termination
  * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
@@ -103,7 +151,9 @@ lwcell_device_get_revision(char* rev, size_t len, const lwcell_api_cmd_evt_fn ev
     LWCELL_ASSERT(rev != NULL);
     LWCELL_ASSERT(len > 0);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    DEVICE_INFO_FROM_CACHE(rev, len, lwcell.m.model_revision, evt_fn, evt_arg);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(device_info));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CGMR_GET;
     LWCELL_MSG_VAR_REF(msg).msg.device_info.str = rev;
@@ -114,6 +164,7 @@ lwcell_device_get_revision(char* rev, size_t len, const lwcell_api_cmd_evt_fn ev
 
 /**
  * \brief           Get device serial number
+ * \note            With \ref LWCELL_CFG_DEVICE_INFO_CACHE enabled, value read during reset sequence is returned
  * \param[in]       serial: Pointer to output string array to save serial number info
  * \param[in]       len: Length of string array including `NULL` termination
  * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
@@ -129,7 +180,9 @@ lwcell_device_get_serial_number(char* serial, size_t len, const lwcell_api_cmd_e
     LWCELL_ASSERT(serial != NULL);
     LWCELL_ASSERT(len > 0);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    DEVICE_INFO_FROM_CACHE(serial, len, lwcell.m.model_serial_number, evt_fn, evt_arg);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(device_info));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CGSN_GET;
     LWCELL_MSG_VAR_REF(msg).msg.device_info.str = serial;
@@ -137,3 +190,51 @@ lwcell_device_get_serial_number(char* serial, size_t len, const lwcell_api_cmd_e
 
     return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 10000);
 }
+
+#if LWCELL_CFG_DEVICE_INFO_CACHE || __DOXYGEN__
+
+/**
+ * \brief           Read manufacturer, model, serial number and revision from device again
+ *
+ * Values are stored to device structure and returned by next `lwcell_device_get_*` calls
+ *
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_device_info_refresh(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(device_info));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CGMI_GET; /* Output string is `NULL` for full refresh */
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 40000);
+}
+
+#endif /* LWCELL_CFG_DEVICE_INFO_CACHE || __DOXYGEN__ */
+
+#if LWCELL_CFG_RESET_FAST_BOOT || __DOXYGEN__
+
+/**
+ * \brief           Set callback function to load and store persisted device identity
+ *
+ * Used by fast-boot reset sequence to skip device identification queries.
+ * Function is called from processing thread during reset sequence
+ *
+ * \param[in]       fn: Callback function. Set to `NULL` to always query full identity
+ * \param[in]       arg: Custom argument for callback function
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_device_set_identity_fn(lwcell_device_identity_fn fn, void* arg) {
+    lwcell_core_lock();
+    lwcell.identity_fn = fn;
+    lwcell.identity_arg = arg;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_RESET_FAST_BOOT || __DOXYGEN__ */
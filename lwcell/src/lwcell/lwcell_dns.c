@@ -0,0 +1,247 @@
+/**
+ * \file            lwcell_dns.c
+ * \brief           DNS API
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_dns.h"
+#include "lwcell/lwcell_private.h"
+#include "system/lwcell_sys.h"
+
+#if LWCELL_CFG_DNS || __DOXYGEN__
+
+/**
+ * \brief           Find valid cache entry for host
+ * \note            Expired entry is removed
+ * \param[in]       host: Host name
+ * \return          Pointer to entry or `NULL` if not in cache
+ */
+static lwcell_dns_entry_t*
+prv_dns_find(const char* host) {
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(lwcell.dns_cache); ++i) {
+        lwcell_dns_entry_t* e = &lwcell.dns_cache[i];
+
+        if (e->host[0] != '\0' && !strcmp(e->host, host)) {
+            if ((uint32_t)(lwcell_sys_now() - e->time) >= LWCELL_CFG_DNS_CACHE_TTL) {
+                e->host[0] = '\0'; /* Entry has expired */
+                return NULL;
+            }
+            return e;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Get cached address of host for new connection
+ * \note            Function must be called with core locked
+ * \param[in]       host: Host name
+ * \return          Pointer to address or `NULL` if host is not in cache
+ */
+const lwcell_ip_t*
+lwcelli_dns_cache_get(const char* host) {
+    lwcell_dns_entry_t* e;
+
+    if (host == NULL || (e = prv_dns_find(host)) == NULL) {
+        return NULL;
+    }
+    e->used = lwcell_sys_now();
+    return &e->addr[e->addr_idx];
+}
+
+/**
+ * \brief           Report failed connection to cached address and switch to next one
+ * \note            Function must be called with core locked
+ * \param[in]       host: Host name
+ */
+void
+lwcelli_dns_cache_failed(const char* host) {
+    lwcell_dns_entry_t* e;
+
+    if (host != NULL && (e = prv_dns_find(host)) != NULL) {
+        if (++e->addr_idx >= e->addr_cnt) {
+            e->host[0] = '\0'; /* All addresses failed, let device resolve name again */
+        }
+    }
+}
+
+/**
+ * \brief           Complete resolve command from cache, before it is sent to device
+ *
+ * Multiple lookups of the same host may be queued before first one finishes.
+ * Only first one is sent to device, others take its result from cache
+ *
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Resolve command message
+ * \return          `1` when host is in cache and command is completed, `0` otherwise
+ */
+uint8_t
+lwcelli_dns_resolve_cached(lwcell_msg_t* msg) {
+    const lwcell_ip_t* cached;
+
+    if ((cached = lwcelli_dns_cache_get(msg->msg.dns.host)) == NULL) {
+        return 0;
+    }
+    if (msg->msg.dns.ip != NULL) {
+        *msg->msg.dns.ip = *cached;
+    }
+    return 1;
+}
+
+/**
+ * \brief           Finish resolve command, save result to cache and output variable
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Resolve command message
+ * \param[in]       is_ok: Set to `1` when host was resolved
+ */
+void
+lwcelli_dns_resolve_finished(lwcell_msg_t* msg, uint8_t is_ok) {
+    lwcell_dns_entry_t* e;
+    size_t len;
+
+    if (!is_ok || msg->msg.dns.addr_cnt == 0) {
+        return;
+    }
+    if (msg->msg.dns.ip != NULL) {
+        *msg->msg.dns.ip = msg->msg.dns.addr[0];
+    }
+
+    /* Long names are not cached */
+    if ((len = strlen(msg->msg.dns.host)) >= LWCELL_CFG_DNS_HOST_LEN) {
+        return;
+    }
+
+    /* Replace existing, empty or least recently used entry */
+    if ((e = prv_dns_find(msg->msg.dns.host)) == NULL) {
+        e = &lwcell.dns_cache[0];
+        for (size_t i = 0; i < LWCELL_ARRAYSIZE(lwcell.dns_cache); ++i) {
+            if (lwcell.dns_cache[i].host[0] == '\0') {
+                e = &lwcell.dns_cache[i];
+                break;
+            }
+            if ((uint32_t)(lwcell_sys_now() - lwcell.dns_cache[i].used) > (uint32_t)(lwcell_sys_now() - e->used)) {
+                e = &lwcell.dns_cache[i];
+            }
+        }
+    }
+    LWCELL_MEMCPY(e->host, msg->msg.dns.host, len + 1);
+    LWCELL_MEMCPY(e->addr, msg->msg.dns.addr, sizeof(e->addr));
+    e->addr_cnt = msg->msg.dns.addr_cnt;
+    e->addr_idx = 0;
+    e->time = e->used = lwcell_sys_now();
+}
+
+/**
+ * \brief           Resolve host name to IP address
+ *
+ * When host is in cache, address is written immediately and command is not sent to device.
+ * In this case, function returns \ref lwcellOK and `evt_fn` is not called.
+ *
+ * Lookups are queued and may be started for many hosts at once, in non-blocking mode,
+ * to fill cache before connections are started. When the same host is queued more than once,
+ * only first lookup is sent to device
+ *
+ * \param[in]       host: Host name to resolve. It must stay valid until command finishes
+ * \param[out]      ip: Pointer to output variable to save first address to. Set to `NULL` if not used
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_dns_gethostbyname(const char* host, lwcell_ip_t* ip, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                         const uint32_t blocking) {
+    const lwcell_ip_t* cached;
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(host != NULL && strlen(host) > 0);
+
+    lwcell_core_lock();
+    if ((cached = lwcelli_dns_cache_get(host)) != NULL) {
+        if (ip != NULL) {
+            *ip = *cached;
+        }
+        lwcell_core_unlock();
+        return lwcellOK;
+    }
+    lwcell_core_unlock();
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(dns));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CDNSGIP;
+    LWCELL_MSG_VAR_REF(msg).msg.dns.host = host;
+    LWCELL_MSG_VAR_REF(msg).msg.dns.ip = ip;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
+}
+
+/**
+ * \brief           Set DNS servers used by device to resolve host names
+ * \param[in]       primary: Primary DNS server address
+ * \param[in]       secondary: Secondary DNS server address. Set to `NULL` if not used
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_dns_set_servers(const lwcell_ip_t* primary, const lwcell_ip_t* secondary, const lwcell_api_cmd_evt_fn evt_fn,
+                       void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(primary != NULL);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(dns_cfg));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CDNSCFG;
+    LWCELL_MSG_VAR_REF(msg).msg.dns_cfg.primary = *primary;
+    if (secondary != NULL) {
+        LWCELL_MSG_VAR_REF(msg).msg.dns_cfg.secondary = *secondary;
+        LWCELL_MSG_VAR_REF(msg).msg.dns_cfg.has_secondary = 1;
+    }
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 10000);
+}
+
+/**
+ * \brief           Remove all entries from DNS cache
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_dns_cache_flush(void) {
+    lwcell_core_lock();
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(lwcell.dns_cache); ++i) {
+        lwcell.dns_cache[i].host[0] = '\0';
+    }
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_DNS || __DOXYGEN__ */
@@ -34,19 +34,61 @@
 #include "lwcell/lwcell_evt.h"
 #include "lwcell/lwcell_private.h"
 
+/* Every event type must have its own bit in subscription mask */
+typedef char prv_evt_mask_check_t[LWCELL_EVT_END <= (sizeof(lwcell_evt_mask_t) * 8) ? 1 : -1];
+
+/**
+ * \brief           Update union of subscription masks after list change
+ * \note            Event lock must be held when calling this function
+ */
+static void
+prv_update_mask(void) {
+    lwcell.evt_mask = 0;
+    for (lwcell_evt_func_t* func = lwcell.evt_func; func != NULL; func = func->next) {
+        lwcell.evt_mask |= func->mask;
+    }
+}
+
 /**
  * \brief           Register callback function for global (non-connection based) events
+ * \note            Function is subscribed to all event types.
+ *                  Use \ref lwcell_evt_register_ex to receive only selected event types
  * \param[in]       fn: Callback function to call on specific event
  * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
  */
 lwcellr_t
 lwcell_evt_register(lwcell_evt_fn fn) {
+    return lwcell_evt_register_ex(fn, LWCELL_EVT_MASK_ALL);
+}
+
+/**
+ * \brief           Register callback function for selected global (non-connection based) events
+ *
+ * Function is called only for event types set in subscription mask,
+ * high-rate events such as \ref LWCELL_EVT_KEEP_ALIVE do not reach functions not interested in them.
+ *
+ * \param[in]       fn: Callback function to call on specific event
+ * \param[in]       mask: Subscribed event types, combine \ref LWCELL_EVT_MASK values
+ *                      with `bitwise OR` or use \ref LWCELL_EVT_MASK_ALL
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_evt_register_ex(lwcell_evt_fn fn, lwcell_evt_mask_t mask) {
     lwcellr_t res = lwcellOK;
     lwcell_evt_func_t *func, *new_func;
 
     LWCELL_ASSERT(fn != NULL);
 
-    lwcell_core_lock();
+    /* Allocate outside event lock, allocator uses core lock */
+    new_func = lwcell_mem_malloc_tag(sizeof(*new_func), LWCELL_MEM_TAG_EVT);
+    if (new_func == NULL) {
+        return lwcellERRMEM;
+    }
+    LWCELL_MEMSET(new_func, 0x00, sizeof(*new_func));
+    new_func->fn = fn; /* Set function pointer */
+    new_func->mask = mask;
+
+    LWCELL_EVT_LOCK();
 
     /* Check if function already exists on list */
     for (func = lwcell.evt_func; func != NULL; func = func->next) {
@@ -57,23 +99,22 @@ lwcell_evt_register(lwcell_evt_fn fn) {
     }
 
     if (res == lwcellOK) {
-        new_func = lwcell_mem_malloc(sizeof(*new_func));
-        if (new_func != NULL) {
-            LWCELL_MEMSET(new_func, 0x00, sizeof(*new_func));
-            new_func->fn = fn; /* Set function pointer */
-            for (func = lwcell.evt_func; func != NULL && func->next != NULL; func = func->next) {}
-            if (func != NULL) {
-                func->next = new_func; /* Set new function as next */
-                res = lwcellOK;
-            } else {
-                lwcell_mem_free_s((void**)&new_func);
-                res = lwcellERRMEM;
-            }
+        for (func = lwcell.evt_func; func != NULL && func->next != NULL; func = func->next) {}
+        if (func != NULL) {
+            func->next = new_func; /* Set new function as next */
+            new_func = NULL;
+            prv_update_mask();
         } else {
             res = lwcellERRMEM;
         }
     }
-    lwcell_core_unlock();
+    LWCELL_EVT_UNLOCK();
+    if (new_func != NULL) {
+        lwcell_mem_free_s((void**)&new_func);
+    }
+#if LWCELL_CFG_KEEP_ALIVE
+    lwcelli_keep_alive_update(); /* Outside event lock, core lock is taken */
+#endif /* LWCELL_CFG_KEEP_ALIVE */
     return res;
 }
 
@@ -88,18 +129,100 @@ lwcell_evt_unregister(lwcell_evt_fn fn) {
     lwcell_evt_func_t *func, *prev;
     LWCELL_ASSERT(fn != NULL);
 
-    lwcell_core_lock();
+    LWCELL_EVT_LOCK();
     for (prev = lwcell.evt_func, func = lwcell.evt_func->next; func != NULL; prev = func, func = func->next) {
         if (func->fn == fn) {
             prev->next = func->next;
-            lwcell_mem_free_s((void**)&func);
+            prv_update_mask();
             break;
         }
     }
-    lwcell_core_unlock();
+    LWCELL_EVT_UNLOCK();
+    if (func != NULL) {
+        lwcell_mem_free_s((void**)&func);
+    }
+#if LWCELL_CFG_KEEP_ALIVE
+    lwcelli_keep_alive_update(); /* Outside event lock, core lock is taken */
+#endif /* LWCELL_CFG_KEEP_ALIVE */
     return lwcellOK;
 }
 
+/**
+ * \brief           Change subscription mask of registered callback function
+ * \note            Can also be used for callback function, passed to \ref lwcell_init
+ * \param[in]       fn: Registered callback function
+ * \param[in]       mask: New subscribed event types, combine \ref LWCELL_EVT_MASK values with `bitwise OR`
+ * \return          \ref lwcellOK on success, \ref lwcellERR if function is not registered
+ */
+lwcellr_t
+lwcell_evt_set_mask(lwcell_evt_fn fn, lwcell_evt_mask_t mask) {
+    lwcellr_t res = lwcellERR;
+    LWCELL_ASSERT(fn != NULL);
+
+    LWCELL_EVT_LOCK();
+    for (lwcell_evt_func_t* func = lwcell.evt_func; func != NULL; func = func->next) {
+        if (func->fn == fn) {
+            func->mask = mask;
+            prv_update_mask();
+            res = lwcellOK;
+            break;
+        }
+    }
+    LWCELL_EVT_UNLOCK();
+#if LWCELL_CFG_KEEP_ALIVE
+    lwcelli_keep_alive_update(); /* Outside event lock, core lock is taken */
+#endif /* LWCELL_CFG_KEEP_ALIVE */
+    return res;
+}
+
+#if LWCELL_CFG_EVT_DEFERRED || __DOXYGEN__
+
+/**
+ * \brief           Enable or disable deferred delivery of events to callback function
+ *
+ * When enabled, function receives copy of event in event dispatch thread, without core lock held.
+ * It applies to global callback functions and connection callback functions.
+ *
+ * \note            Deferred callback function cannot return \ref lwcellOKIGNOREMORE for received data.
+ *                  Event pointers to stack internal data or temporary user memory (such as connection
+ *                  start `host`) may not be valid anymore, and connection may already be reused
+ *                  when its close event is delivered
+ * \param[in]       fn: Callback function
+ * \param[in]       deferred: Set to `1` to deliver events in dispatch thread, `0` to call it directly
+ * \return          \ref lwcellOK on success, \ref lwcellERRMEM if there is no free slot
+ */
+lwcellr_t
+lwcell_evt_set_deferred(lwcell_evt_fn fn, uint8_t deferred) {
+    lwcellr_t res = deferred ? lwcellERRMEM : lwcellOK;
+    size_t i;
+
+    LWCELL_ASSERT(fn != NULL);
+
+    lwcell_core_lock();
+    for (i = 0; i < LWCELL_ARRAYSIZE(lwcell.evt_deferred_fn); ++i) {
+        if (lwcell.evt_deferred_fn[i] == fn) {
+            if (!deferred) {
+                lwcell.evt_deferred_fn[i] = NULL;
+            }
+            res = lwcellOK;
+            break;
+        }
+    }
+    if (i == LWCELL_ARRAYSIZE(lwcell.evt_deferred_fn) && deferred) {
+        for (i = 0; i < LWCELL_ARRAYSIZE(lwcell.evt_deferred_fn); ++i) {
+            if (lwcell.evt_deferred_fn[i] == NULL) {
+                lwcell.evt_deferred_fn[i] = fn;
+                res = lwcellOK;
+                break;
+            }
+        }
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+#endif /* LWCELL_CFG_EVT_DEFERRED || __DOXYGEN__ */
+
 /**
  * \brief           Get event type
  * \param[in]       cc: Event handle
@@ -170,6 +293,27 @@ lwcell_evt_operator_scan_get_length(lwcell_evt_t* cc) {
     return cc->evt.operator_scan.opf;
 }
 
+/**
+ * \brief           Get operator entry parsed during scan
+ * \note            Entry is valid only during callback, copy it if needed later
+ * \param[in]       cc: Event data
+ * \return          Pointer to operator entry
+ */
+const lwcell_operator_t*
+lwcell_evt_operator_scan_entry_get_operator(lwcell_evt_t* cc) {
+    return cc->evt.operator_scan_entry.op;
+}
+
+/**
+ * \brief           Get index of operator entry in scan response
+ * \param[in]       cc: Event data
+ * \return          Entry index, starting with `0`
+ */
+size_t
+lwcell_evt_operator_scan_entry_get_index(lwcell_evt_t* cc) {
+    return cc->evt.operator_scan_entry.index;
+}
+
 /**
  * \brief           Get RSSi from CSQ command
  * \param[in]       cc: Event data
@@ -180,6 +324,20 @@ lwcell_evt_signal_strength_get_rssi(lwcell_evt_t* cc) {
     return cc->evt.rssi.rssi;
 }
 
+#if LWCELL_CFG_STATIC_ALLOC || __DOXYGEN__
+
+/**
+ * \brief           Get largest allocation size that failed since previous event
+ * \param[in]       cc: Event data
+ * \return          Requested size in units of bytes
+ */
+size_t
+lwcell_evt_mem_pool_empty_get_size(lwcell_evt_t* cc) {
+    return cc->evt.mem_pool_empty.size;
+}
+
+#endif /* LWCELL_CFG_STATIC_ALLOC || __DOXYGEN__ */
+
 #if LWCELL_CFG_CONN || __DOXYGEN__
 
 /**
@@ -302,6 +460,70 @@ lwcell_evt_conn_poll_get_conn(lwcell_evt_t* cc) {
     return cc->evt.conn_poll.conn;
 }
 
+/**
+ * \brief           Get connection handle
+ * \param[in]       cc: Event handle
+ * \return          Connection handle
+ */
+lwcell_conn_p
+lwcell_evt_conn_status_changed_get_conn(lwcell_evt_t* cc) {
+    return cc->evt.conn_status_changed.conn;
+}
+
+/**
+ * \brief           Get changed connection fields
+ * \param[in]       cc: Event handle
+ * \return          Combination of \ref LWCELL_CONN_CHANGED flags
+ */
+uint8_t
+lwcell_evt_conn_status_changed_get_flags(lwcell_evt_t* cc) {
+    return cc->evt.conn_status_changed.changed;
+}
+
+/**
+ * \brief           Get new connection state
+ * \param[in]       cc: Event handle
+ * \return          Member of \ref lwcell_conn_state_t enumeration
+ */
+lwcell_conn_state_t
+lwcell_evt_conn_status_changed_get_state(lwcell_evt_t* cc) {
+    return cc->evt.conn_status_changed.state;
+}
+
+/**
+ * \brief           Get connection state before the change
+ * \param[in]       cc: Event handle
+ * \return          Member of \ref lwcell_conn_state_t enumeration
+ */
+lwcell_conn_state_t
+lwcell_evt_conn_status_changed_get_prev_state(lwcell_evt_t* cc) {
+    return cc->evt.conn_status_changed.prev_state;
+}
+
+#if LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__
+
+/**
+ * \brief           Get connection handle
+ * \param[in]       cc: Event handle
+ * \return          Connection handle
+ */
+lwcell_conn_p
+lwcell_evt_conn_rx_pending_get_conn(lwcell_evt_t* cc) {
+    return cc->evt.conn_rx_pending.conn;
+}
+
+/**
+ * \brief           Get number of bytes waiting in device buffer
+ * \param[in]       cc: Event handle
+ * \return          Number of bytes reported by device
+ */
+size_t
+lwcell_evt_conn_rx_pending_get_length(lwcell_evt_t* cc) {
+    return cc->evt.conn_rx_pending.len;
+}
+
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__ */
+
 /**
  * \brief           Get connection error type
  * \param[in]       cc: Event handle
@@ -376,6 +598,23 @@ lwcell_evt_sms_recv_get_mem(lwcell_evt_t* cc) {
     return cc->evt.sms_recv.mem;
 }
 
+#if LWCELL_CFG_SMS_DIRECT || __DOXYGEN__
+
+/**
+ * \brief           Get directly delivered SMS entry
+ *
+ * Entry is valid only during event callback
+ *
+ * \param[in]       cc: Event handle
+ * \return          SMS entry with number, date and text, `NULL` when message was saved to storage
+ */
+lwcell_sms_entry_t*
+lwcell_evt_sms_recv_get_entry(lwcell_evt_t* cc) {
+    return cc->evt.sms_recv.entry;
+}
+
+#endif /* LWCELL_CFG_SMS_DIRECT || __DOXYGEN__ */
+
 /**
  * \brief           Get SMS entry after successful read
  * \param[in]       cc: Event handle
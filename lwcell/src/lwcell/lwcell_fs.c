@@ -0,0 +1,171 @@
+/**
+ * \file            lwcell_fs.c
+ * \brief           Device file system API
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_fs.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_FS || __DOXYGEN__
+
+/* Time given to each file chunk, in units of milliseconds */
+#define FS_CHUNK_TIMEOUT 10000
+
+/**
+ * \brief           Write data to file in device file system
+ *
+ * Data are written in chunks of up to \ref LWCELL_CFG_FS_CHUNK_LEN bytes, directly from application memory.
+ * First chunk creates or overwrites the file, unless `append` is set; next chunks are appended
+ *
+ * \param[in]       name: File name in `customer` directory, such as `log.bin`.
+ *                      It must stay valid until command finishes
+ * \param[in]       data: Data to write. It must stay valid until command finishes
+ * \param[in]       len: Length of data in units of bytes
+ * \param[in]       append: Set to `1` to append data to existing file, `0` to overwrite it
+ * \param[out]      bw: Pointer to output variable to save number of bytes written. Set to `NULL` if not used
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_fs_write(const char* name, const void* data, size_t len, uint8_t append, size_t* bw,
+                const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(name != NULL && strlen(name) > 0);
+    LWCELL_ASSERT(data != NULL);
+    LWCELL_ASSERT(len > 0);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(fs_write));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_FS_WRITE;
+    LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CFSINIT;
+    LWCELL_MSG_VAR_REF(msg).msg.fs_write.name = name;
+    LWCELL_MSG_VAR_REF(msg).msg.fs_write.data = data;
+    LWCELL_MSG_VAR_REF(msg).msg.fs_write.len = len;
+    LWCELL_MSG_VAR_REF(msg).msg.fs_write.append = append;
+    LWCELL_MSG_VAR_REF(msg).msg.fs_write.bw = bw;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd,
+                                             LWCELL_U32(len / LWCELL_CFG_FS_CHUNK_LEN + 2) * FS_CHUNK_TIMEOUT);
+}
+
+/**
+ * \brief           Read chunk of file from device file system to packet buffer
+ *
+ * Number of bytes requested from device equals to total length of packet buffer chain,
+ * limited by \ref LWCELL_CFG_FS_CHUNK_LEN. Device returns less data at the end of file
+ *
+ * \param[in]       name: File name in `customer` directory. It must stay valid until command finishes
+ * \param[in]       offset: Offset in file to read from
+ * \param[in]       pbuf: Packet buffer or chain to write file data to.
+ *                      It must stay valid until command finishes
+ * \param[out]      br: Pointer to output variable to save number of bytes read. Set to `NULL` if not used
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_fs_read(const char* name, size_t offset, lwcell_pbuf_p pbuf, size_t* br, const lwcell_api_cmd_evt_fn evt_fn,
+               void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(name != NULL && strlen(name) > 0);
+    LWCELL_ASSERT(pbuf != NULL);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(data_read));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CFSRFILE;
+    LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CFSINIT;
+    LWCELL_MSG_VAR_REF(msg).msg.data_read.name = name;
+    LWCELL_MSG_VAR_REF(msg).msg.data_read.offset = offset;
+    LWCELL_MSG_VAR_REF(msg).msg.data_read.len = LWCELL_MIN(lwcell_pbuf_length(pbuf, 1), LWCELL_CFG_FS_CHUNK_LEN);
+    LWCELL_MSG_VAR_REF(msg).msg.data_read.buff = pbuf;
+    LWCELL_MSG_VAR_REF(msg).msg.data_read.p = pbuf;
+    LWCELL_MSG_VAR_REF(msg).msg.data_read.br = br;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 3 * FS_CHUNK_TIMEOUT);
+}
+
+/**
+ * \brief           Get size of file in device file system
+ * \param[in]       name: File name in `customer` directory. It must stay valid until command finishes
+ * \param[out]      size: Pointer to output variable to save file size to
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise.
+ *                  Command fails when file does not exist
+ */
+lwcellr_t
+lwcell_fs_get_size(const char* name, size_t* size, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                   const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(name != NULL && strlen(name) > 0);
+    LWCELL_ASSERT(size != NULL);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(fs_file));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CFSGFIS;
+    LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CFSINIT;
+    LWCELL_MSG_VAR_REF(msg).msg.fs_file.name = name;
+    LWCELL_MSG_VAR_REF(msg).msg.fs_file.size = size;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, FS_CHUNK_TIMEOUT);
+}
+
+/**
+ * \brief           Delete file from device file system
+ * \param[in]       name: File name in `customer` directory. It must stay valid until command finishes
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_fs_delete(const char* name, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(name != NULL && strlen(name) > 0);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(fs_file));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CFSDFILE;
+    LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CFSINIT;
+    LWCELL_MSG_VAR_REF(msg).msg.fs_file.name = name;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, FS_CHUNK_TIMEOUT);
+}
+
+#endif /* LWCELL_CFG_FS || __DOXYGEN__ */
@@ -36,4 +36,233 @@
 
 #if LWCELL_CFG_FTP || __DOXYGEN__
 
+/**
+ * \brief           Open FTP session and start transfer
+ * \param[in]       desc: Server and file descriptor
+ * \param[in]       offset: Download restart offset or upload resume offset
+ * \param[in]       is_put: Set to `1` to start upload or `0` to start download
+ * \param[in]       fs_name: File in device file system to upload at once, `NULL` to upload from application
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+prv_ftp_start(const lwcell_ftp_desc_t* desc, size_t offset, uint8_t is_put, const char* fs_name,
+              const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(desc != NULL);
+    LWCELL_ASSERT(desc->host != NULL && strlen(desc->host) > 0);
+    LWCELL_ASSERT(desc->name != NULL && strlen(desc->name) > 0);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(ftp_start));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+
+    lwcell_core_lock();
+    lwcell.m.ftp.active = 0;
+    lwcell.m.ftp.put_max_len = 0;
+    lwcell_core_unlock();
+
+    LWCELL_MSG_VAR_REF(msg).cmd_def = is_put ? LWCELL_CMD_FTPPUT_OPEN : LWCELL_CMD_FTPGET_OPEN;
+    LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_SAPBR_CONTYPE;
+    LWCELL_MSG_VAR_REF(msg).msg.ftp_start.desc = desc;
+    LWCELL_MSG_VAR_REF(msg).msg.ftp_start.offset = offset;
+#if LWCELL_CFG_FS
+    LWCELL_MSG_VAR_REF(msg).msg.ftp_start.fs_name = fs_name;
+#else  /* LWCELL_CFG_FS */
+    LWCELL_UNUSED(fs_name);
+#endif /* !LWCELL_CFG_FS */
+
+    /* Upload from file system finishes when the whole file is transferred */
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd,
+                                             fs_name != NULL ? 600000 : 120000);
+}
+
+/**
+ * \brief           Start FTP file download
+ *
+ * Function finishes when device has opened data connection to server,
+ * file is later read with \ref lwcell_ftp_get_read
+ *
+ * \note            Bearer profile `1` is opened with default APN, if not already active
+ * \param[in]       desc: Server and file descriptor. It must stay valid until command finishes
+ * \param[in]       offset: Offset in remote file to start download at. Use `0` to download complete file
+ *                      or offset reported in \ref LWCELL_EVT_FTP_DONE event to resume interrupted transfer
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ftp_get_start(const lwcell_ftp_desc_t* desc, size_t offset, const lwcell_api_cmd_evt_fn evt_fn,
+                     void* const evt_arg, const uint32_t blocking) {
+    return prv_ftp_start(desc, offset, 0, NULL, evt_fn, evt_arg, blocking);
+}
+
+/**
+ * \brief           Read next chunk of downloaded file to packet buffer
+ *
+ * Number of bytes requested from device equals to total length of packet buffer chain,
+ * limited by \ref LWCELL_CFG_FTP_CHUNK_LEN.
+ * Device may return less data than requested. When `0` bytes are read, no data are currently available;
+ * end of file is reported with \ref LWCELL_EVT_FTP_DONE event.
+ * \ref LWCELL_EVT_FTP_READ event is sent to global event callback after every non-empty chunk
+ *
+ * \param[in]       pbuf: Packet buffer or chain to write file data to.
+ *                      It must stay valid until command finishes
+ * \param[out]      br: Pointer to output variable to save number of bytes read. Set to `NULL` if not used
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ftp_get_read(lwcell_pbuf_p pbuf, size_t* br, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                    const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+    uint8_t active;
+
+    LWCELL_ASSERT(pbuf != NULL);
+
+    lwcell_core_lock();
+    active = lwcell.m.ftp.active && !lwcell.m.ftp.is_put;
+    lwcell_core_unlock();
+    if (!active) {
+        return lwcellERR;
+    }
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(data_read));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_FTPGET_READ;
+    LWCELL_MSG_VAR_REF(msg).msg.data_read.len = LWCELL_MIN(lwcell_pbuf_length(pbuf, 1), LWCELL_CFG_FTP_CHUNK_LEN);
+    LWCELL_MSG_VAR_REF(msg).msg.data_read.buff = pbuf;
+    LWCELL_MSG_VAR_REF(msg).msg.data_read.p = pbuf;
+    LWCELL_MSG_VAR_REF(msg).msg.data_read.br = br;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
+}
+
+/**
+ * \brief           Start FTP file upload
+ *
+ * Function finishes when device has opened data connection to server,
+ * data are later written with \ref lwcell_ftp_put_write
+ *
+ * \note            Bearer profile `1` is opened with default APN, if not already active
+ * \param[in]       desc: Server and file descriptor. It must stay valid until command finishes
+ * \param[in]       offset: Set to `0` to create or overwrite remote file.
+ *                      When not `0`, data are appended to remote file to resume interrupted transfer
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ftp_put_start(const lwcell_ftp_desc_t* desc, size_t offset, const lwcell_api_cmd_evt_fn evt_fn,
+                     void* const evt_arg, const uint32_t blocking) {
+    return prv_ftp_start(desc, offset, 1, NULL, evt_fn, evt_arg, blocking);
+}
+
+#if LWCELL_CFG_FS || __DOXYGEN__
+
+/**
+ * \brief           Upload file from device file system with `AT+FTPPUTFRMFS`
+ *
+ * File is staged before with \ref lwcell_fs_write.
+ * Device transfers the whole file on its own and function finishes when upload is complete,
+ * no session is left open. Application memory is not used during transfer,
+ * while command channel stays busy until device reports the result.
+ *
+ * \note            Bearer profile `1` is opened with default APN, if not already active
+ * \param[in]       desc: Server and remote file descriptor. It must stay valid until command finishes
+ * \param[in]       fs_name: File name in `customer` directory of device file system.
+ *                      It must stay valid until command finishes
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ftp_put_file(const lwcell_ftp_desc_t* desc, const char* fs_name, const lwcell_api_cmd_evt_fn evt_fn,
+                    void* const evt_arg, const uint32_t blocking) {
+    LWCELL_ASSERT(fs_name != NULL && strlen(fs_name) > 0);
+
+    return prv_ftp_start(desc, 0, 1, fs_name, evt_fn, evt_arg, blocking);
+}
+
+#endif /* LWCELL_CFG_FS || __DOXYGEN__ */
+
+/**
+ * \brief           Write chunk of data to uploaded file
+ *
+ * Number of bytes written is limited by \ref LWCELL_CFG_FTP_CHUNK_LEN
+ * and by maximal chunk length device reported when session was opened.
+ * Application writes rest of the data with next call
+ *
+ * \param[in]       data: Data to upload. It must stay valid until command finishes
+ * \param[in]       len: Length of data in units of bytes
+ * \param[out]      bw: Pointer to output variable to save number of bytes written. Set to `NULL` if not used
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ftp_put_write(const void* data, size_t len, size_t* bw, const lwcell_api_cmd_evt_fn evt_fn,
+                     void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+    uint8_t active;
+
+    LWCELL_ASSERT(data != NULL);
+    LWCELL_ASSERT(len > 0);
+
+    lwcell_core_lock();
+    active = lwcell.m.ftp.active && lwcell.m.ftp.is_put;
+    len = LWCELL_MIN(len, LWCELL_CFG_FTP_CHUNK_LEN);
+    if (lwcell.m.ftp.put_max_len > 0) {
+        len = LWCELL_MIN(len, lwcell.m.ftp.put_max_len);
+    }
+    lwcell_core_unlock();
+    if (!active) {
+        return lwcellERR;
+    }
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(ftp_put));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_FTPPUT_WRITE;
+    LWCELL_MSG_VAR_REF(msg).msg.ftp_put.data = data;
+    LWCELL_MSG_VAR_REF(msg).msg.ftp_put.len = len;
+    LWCELL_MSG_VAR_REF(msg).msg.ftp_put.bw = bw;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
+}
+
+/**
+ * \brief           Close FTP session
+ *
+ * Upload session is finished and remote file is closed.
+ * Download session is aborted
+ *
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ftp_close(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+    uint8_t is_put;
+
+    lwcell_core_lock();
+    is_put = lwcell.m.ftp.active && lwcell.m.ftp.is_put;
+    lwcell_core_unlock();
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(ftp_put));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = is_put ? LWCELL_CMD_FTPPUT_END : LWCELL_CMD_FTPQUIT;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
+}
+
 #endif /* LWCELL_CFG_FTP || __DOXYGEN__ */
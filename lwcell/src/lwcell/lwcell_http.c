@@ -36,4 +36,125 @@
 
 #if LWCELL_CFG_HTTP || __DOXYGEN__
 
+/**
+ * \brief           Execute HTTP GET request
+ *
+ * Previous session is closed and new one is started.
+ * Function finishes when device receives response headers,
+ * body is later read with \ref lwcell_http_read
+ *
+ * \note            On SIM800/SIM900 bearer profile `1` is opened with default APN, if not already active.
+ *                  HTTPS is supported on SIM800/SIM900 only
+ * \param[in]       url: Request URL, such as `http://example.com/file.bin`.
+ *                      It must stay valid until command finishes
+ * \param[out]      status: Pointer to output variable to save HTTP status code to. Set to `NULL` if not used
+ * \param[out]      content_len: Pointer to output variable to save body length to. Set to `NULL` if not used
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_http_get(const char* url, uint16_t* status, size_t* content_len, const lwcell_api_cmd_evt_fn evt_fn,
+                void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+    uint8_t is_sh;
+
+    LWCELL_ASSERT(url != NULL && strlen(url) > 0);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(http_get));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+
+    lwcell_core_lock();
+    is_sh = LWCELL_DEV_MODEL_CAP(has_http_sh);
+    lwcell.m.http.is_sh = is_sh;
+    lwcell.m.http.active = 0;
+    lwcell_core_unlock();
+
+    LWCELL_MSG_VAR_REF(msg).cmd_def = is_sh ? LWCELL_CMD_SHREQ : LWCELL_CMD_HTTPACTION;
+    LWCELL_MSG_VAR_REF(msg).cmd = is_sh ? LWCELL_CMD_SHDISC : LWCELL_CMD_HTTPTERM;
+    LWCELL_MSG_VAR_REF(msg).msg.http_get.url = url;
+    LWCELL_MSG_VAR_REF(msg).msg.http_get.status = status;
+    LWCELL_MSG_VAR_REF(msg).msg.http_get.content_len = content_len;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 120000);
+}
+
+/**
+ * \brief           Read chunk of HTTP response body to packet buffer
+ *
+ * Number of bytes requested from device equals to total length of packet buffer chain,
+ * limited by remaining body length. Application requests next chunk when it has processed previous one,
+ * device keeps rest of the body until then.
+ * \ref LWCELL_EVT_HTTP_READ event is sent to global event callback after every chunk
+ *
+ * \param[in]       offset: Offset of chunk in response body
+ * \param[in]       pbuf: Packet buffer or chain to write body data to.
+ *                      It must stay valid until command finishes
+ * \param[out]      br: Pointer to output variable to save number of bytes read. Set to `NULL` if not used
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise.
+ *                  \ref lwcellERRPAR is returned when `offset` is at or past end of body
+ */
+lwcellr_t
+lwcell_http_read(size_t offset, lwcell_pbuf_p pbuf, size_t* br, const lwcell_api_cmd_evt_fn evt_fn,
+                 void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+    lwcellr_t res = lwcellOK;
+    size_t len = 0;
+    uint8_t is_sh = 0;
+
+    LWCELL_ASSERT(pbuf != NULL);
+
+    lwcell_core_lock();
+    if (!lwcell.m.http.active) {
+        res = lwcellERR;
+    } else if (offset >= lwcell.m.http.content_len) {
+        res = lwcellERRPAR;
+    } else {
+        len = LWCELL_MIN(lwcell_pbuf_length(pbuf, 1), lwcell.m.http.content_len - offset);
+        is_sh = lwcell.m.http.is_sh;
+    }
+    lwcell_core_unlock();
+    if (res != lwcellOK) {
+        return res;
+    }
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(data_read));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = is_sh ? LWCELL_CMD_SHREAD : LWCELL_CMD_HTTPREAD;
+    LWCELL_MSG_VAR_REF(msg).msg.data_read.offset = offset;
+    LWCELL_MSG_VAR_REF(msg).msg.data_read.len = len;
+    LWCELL_MSG_VAR_REF(msg).msg.data_read.buff = pbuf;
+    LWCELL_MSG_VAR_REF(msg).msg.data_read.p = pbuf;
+    LWCELL_MSG_VAR_REF(msg).msg.data_read.br = br;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
+}
+
+/**
+ * \brief           Close HTTP session and release device resources
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_http_close(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+    uint8_t is_sh;
+
+    lwcell_core_lock();
+    is_sh = lwcell.m.http.is_sh;
+    lwcell_core_unlock();
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE_HDR);
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = is_sh ? LWCELL_CMD_SHDISC : LWCELL_CMD_HTTPTERM;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 10000);
+}
+
 #endif /* LWCELL_CFG_HTTP || __DOXYGEN__ */
@@ -38,11 +38,109 @@
 static uint32_t lwcell_recv_total_len;
 static uint32_t lwcell_recv_calls;
 
+#if LWCELL_CFG_CMD_TIMEOUT_ADAPT || LWCELL_CFG_SUPERVISOR || __DOXYGEN__
+
+/**
+ * \brief           Get total number of bytes received from device
+ * \note            Value wraps around on overflow, use it only to detect new received data
+ * \return          Number of received bytes
+ */
+uint32_t
+lwcelli_input_get_total_len(void) {
+    return lwcell_recv_total_len;
+}
+
+#endif /* LWCELL_CFG_CMD_TIMEOUT_ADAPT || LWCELL_CFG_SUPERVISOR || __DOXYGEN__ */
+
 #if !LWCELL_CFG_INPUT_USE_PROCESS || __DOXYGEN__
 
+/**
+ * \brief           Get size of input buffer to allocate in \ref lwcell_init
+ * \return          Buffer size in units of bytes
+ */
+size_t
+lwcelli_input_get_buff_size(void) {
+    return lwcell.buff_size > 0 ? lwcell.buff_size : LWCELL_CFG_RCV_BUFF_SIZE;
+}
+
+#if LWCELL_CFG_RCV_BUFF_AUTO_GROW || __DOXYGEN__
+
+/**
+ * \brief           Replace input buffer with larger one, keeping data not processed yet
+ *
+ * Core lock guarantees processing thread does not access buffer meanwhile
+ *
+ * \param[in]       needed: Number of bytes, which did not fit to current buffer
+ * \return          `1` if buffer has been enlarged, `0` otherwise
+ */
+static uint8_t
+prv_buff_grow(size_t needed) {
+    lwcell_buff_t nb;
+    size_t size, len;
+    uint8_t ret = 0;
+
+    lwcell_core_lock();
+    if (lwcell.buff.size < LWCELL_CFG_RCV_BUFF_MAX_SIZE) {
+        len = lwcell_buff_get_full(&lwcell.buff);
+        size = LWCELL_MAX(2 * lwcell.buff.size, len + needed + 1);
+        size = LWCELL_MIN(size, LWCELL_CFG_RCV_BUFF_MAX_SIZE);
+        if (lwcell_buff_init(&nb, size)) {
+            lwcell_buff_vec_t vec[2];
+
+            /* Move unprocessed data to the beginning of new buffer */
+            lwcell_buff_get_read_vec(&lwcell.buff, vec);
+            lwcell_buff_write(&nb, vec[0].data, vec[0].len);
+            lwcell_buff_write(&nb, vec[1].data, vec[1].len);
+            lwcell_buff_free(&lwcell.buff);
+            lwcell.buff = nb;
+            ++lwcell.buff_stats.grows;
+            ret = 1;
+            LWCELL_DEBUGF(LWCELL_CFG_DBG_INPUT | LWCELL_DBG_TYPE_TRACE,
+                          "[LWCELL INPUT] Input buffer enlarged to %d bytes\r\n", (int)size);
+        }
+    }
+    lwcell_core_unlock();
+    return ret;
+}
+
+#endif /* LWCELL_CFG_RCV_BUFF_AUTO_GROW || __DOXYGEN__ */
+
+/**
+ * \brief           Write received data to input buffer and update buffer statistics
+ * \param[in]       data: Pointer to data to write
+ * \param[in]       len: Number of data elements in units of bytes
+ * \return          Number of bytes, which did not fit to buffer and are lost
+ */
+static size_t
+prv_buff_write(const void* data, size_t len) {
+    size_t written, used;
+
+    written = lwcell_buff_write(&lwcell.buff, data, len);
+#if LWCELL_CFG_RCV_BUFF_AUTO_GROW
+    if (written < len && prv_buff_grow(len - written)) {
+        written += lwcell_buff_write(&lwcell.buff, (const uint8_t*)data + written, len - written);
+    }
+#endif /* LWCELL_CFG_RCV_BUFF_AUTO_GROW */
+    used = lwcell_buff_get_full(&lwcell.buff);
+    if (used > lwcell.buff_stats.max_used) {
+        lwcell.buff_stats.max_used = used;
+    }
+    if (written < len) {
+        ++lwcell.buff_stats.overflows;
+        lwcell.buff_stats.overflow_bytes += len - written;
+        used += len - written + 1; /* Buffer size that would fit all data */
+        if (used > lwcell.buff_stats.size_recommended) {
+            lwcell.buff_stats.size_recommended = used;
+        }
+    }
+    return len - written;
+}
+
 /**
  * \brief           Write data to input buffer
  * \note            \ref LWCELL_CFG_INPUT_USE_PROCESS must be disabled to use this function
+ * \note            When \ref LWCELL_CFG_INPUT_BUFF_ATOMIC is enabled, function may be called
+ *                  from interrupt context, but only from single writer
  * \param[in]       data: Pointer to data to write
  * \param[in]       len: Number of data elements in units of bytes
  * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
@@ -52,13 +150,117 @@ lwcell_input(const void* data, size_t len) {
     if (!lwcell.status.f.initialized || lwcell.buff.buff == NULL) {
         return lwcellERR;
     }
-    lwcell_buff_write(&lwcell.buff, data, len);         /* Write data to buffer */
-    lwcell_sys_mbox_putnow(&lwcell.mbox_process, NULL); /* Write empty box, don't care if write fails */
+    if (prv_buff_write(data, len) > 0) { /* Write data to buffer */
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_INPUT | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING,
+                      "[LWCELL INPUT] Input buffer overflow, recommended size is at least %d bytes\r\n",
+                      (int)lwcell.buff_stats.size_recommended);
+    }
+#if LWCELL_CFG_INPUT_BUFF_ATOMIC
+    /* Notify processing thread only if not notified yet since it started processing */
+    if (!atomic_exchange(&lwcell.buff_notified, 1)) {
+        LWCELL_PROCESS_WAKEUP(); /* Wake-up processing thread, don't care if write fails */
+    }
+#else                            /* LWCELL_CFG_INPUT_BUFF_ATOMIC */
+    LWCELL_PROCESS_WAKEUP(); /* Wake-up processing thread, don't care if write fails */
+#endif                           /* !LWCELL_CFG_INPUT_BUFF_ATOMIC */
     lwcell_recv_total_len += len;                       /* Update total number of received bytes */
     ++lwcell_recv_calls;                                /* Update number of calls */
+    LWCELL_STATS_ADD(rx_bytes, len);
+    LWCELL_STATS_ADD(rx_calls, 1);
+    return lwcellOK;
+}
+
+#if LWCELL_CFG_INPUT_FROM_ISR || __DOXYGEN__
+
+/**
+ * \brief           Write data to input buffer from interrupt context
+ *
+ * Low-level driver calls it directly from UART or DMA interrupt handler,
+ * processing thread is woken-up with interrupt variant of system function.
+ * There is no need for driver thread to forward received data to the library.
+ *
+ * \note            \ref LWCELL_CFG_INPUT_FROM_ISR must be enabled to use this function
+ * \note            Buffer has single writer, function must not be mixed with \ref lwcell_input
+ *                  and may only be called from one interrupt at a time
+ * \param[in]       data: Pointer to data to write
+ * \param[in]       len: Number of data elements in units of bytes
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_input_from_isr(const void* data, size_t len) {
+    if (!lwcell.status.f.initialized || lwcell.buff.buff == NULL) {
+        return lwcellERR;
+    }
+    prv_buff_write(data, len); /* Write data to buffer, overflow is only counted in interrupt context */
+
+    /* Notify processing thread only if not notified yet since it started processing */
+    if (!atomic_exchange(&lwcell.buff_notified, 1)) {
+        LWCELL_PROCESS_WAKEUP_FROM_ISR();
+    }
+    lwcell_recv_total_len += len; /* Update total number of received bytes */
+    ++lwcell_recv_calls;          /* Update number of calls */
+    LWCELL_STATS_ADD(rx_bytes, len);
+    LWCELL_STATS_ADD(rx_calls, 1);
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_INPUT_FROM_ISR || __DOXYGEN__ */
+
+/**
+ * \brief           Set size of input buffer for received data
+ *
+ * Overrides \ref LWCELL_CFG_RCV_BUFF_SIZE, to size buffer at runtime
+ * for actual baudrate and application load.
+ *
+ * \note            Function must be called before \ref lwcell_init, where buffer is allocated
+ * \param[in]       size: Buffer size in units of bytes. Usable size is `1` byte less than this value
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_input_set_buff_size(size_t size) {
+    if (size < 2) {
+        return lwcellERRPAR;
+    }
+    if (lwcell.status.f.initialized) {
+        return lwcellERR;
+    }
+    lwcell.buff_size = size;
+    return lwcellOK;
+}
+
+/**
+ * \brief           Get input buffer usage statistics
+ *
+ * Use \ref lwcell_input_buff_stats_t::max_used to tune buffer size with \ref lwcell_input_set_buff_size
+ *
+ * \param[out]      stats: Pointer to output structure to fill
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_input_get_buff_stats(lwcell_input_buff_stats_t* stats) {
+    LWCELL_ASSERT(stats != NULL);
+
+    if (!lwcell.status.f.initialized) {
+        return lwcellERR;
+    }
+    lwcell_core_lock();
+    *stats = lwcell.buff_stats;
+    stats->size = lwcell.buff.size;
+    stats->used = lwcell_buff_get_full(&lwcell.buff);
+    lwcell_core_unlock();
     return lwcellOK;
 }
 
+/**
+ * \brief           Reset input buffer usage statistics, including high-water mark
+ */
+void
+lwcell_input_reset_buff_stats(void) {
+    lwcell_core_lock();
+    LWCELL_MEMSET(&lwcell.buff_stats, 0x00, sizeof(lwcell.buff_stats));
+    lwcell_core_unlock();
+}
+
 #endif /* !LWCELL_CFG_INPUT_USE_PROCESS || __DOXYGEN__ */
 
 #if LWCELL_CFG_INPUT_USE_PROCESS || __DOXYGEN__
@@ -86,9 +288,99 @@ lwcell_input_process(const void* data, size_t len) {
     ++lwcell_recv_calls;          /* Update number of calls */
 
     lwcell_core_lock();
+    LWCELL_STATS_ADD(rx_bytes, len);
+    LWCELL_STATS_ADD(rx_calls, 1);
+    LWCELL_TRACE_HOOK(LWCELL_TRACE_INPUT, LWCELL_TRACE_BEGIN, len);
     res = lwcelli_process(data, len); /* Process input data */
+    LWCELL_TRACE_HOOK(LWCELL_TRACE_INPUT, LWCELL_TRACE_END, 0);
+    lwcell_core_unlock();
+    return res;
+}
+
+#if LWCELL_CFG_INPUT_ZERO_COPY || __DOXYGEN__
+
+/**
+ * \brief           Process input data directly from memory lent by low-level driver
+ *
+ * Connection data may be passed to application without copying, referencing this memory directly.
+ * Driver must not overwrite any part of the memory until `release_fn` is called for it.
+ * Memory which is not referenced once function returns may be reused immediately.
+ *
+ * \note            `release_fn` may be called from any thread, which frees received packet buffer
+ *
+ * \note            \ref LWCELL_CFG_INPUT_USE_PROCESS and \ref LWCELL_CFG_INPUT_ZERO_COPY must be enabled to use this function
+ *
+ * \param[in]       data: Pointer to received data to be processed
+ * \param[in]       len: Length of data to process in units of bytes
+ * \param[in]       release_fn: Function called with every referenced region, once it is not used anymore
+ * \param[in]       arg: Custom argument passed to release function
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_input_process_ref(const void* data, size_t len, lwcell_pbuf_release_fn release_fn, void* arg) {
+    lwcellr_t res;
+
+    if (!lwcell.status.f.initialized) {
+        return lwcellERR;
+    }
+
+    lwcell_recv_total_len += len; /* Update total number of received bytes */
+    ++lwcell_recv_calls;          /* Update number of calls */
+
+    lwcell_core_lock();
+    LWCELL_STATS_ADD(rx_bytes, len);
+    LWCELL_STATS_ADD(rx_calls, 1);
+    res = lwcelli_process_ref(data, len, release_fn, arg); /* Process input data */
     lwcell_core_unlock();
     return res;
 }
 
+#endif /* LWCELL_CFG_INPUT_ZERO_COPY || __DOXYGEN__ */
+
 #endif /* LWCELL_CFG_INPUT_USE_PROCESS || __DOXYGEN__ */
+
+#if LWCELL_CFG_RCV_LINE_STREAM || __DOXYGEN__
+
+/**
+ * \brief           Set callback function for received lines longer than \ref LWCELL_CFG_RCV_LINE_SIZE
+ *
+ * Beginning of line is still parsed by library, callback receives complete line in chunks
+ *
+ * \note            Callback is called from processing thread
+ * \param[in]       fn: Callback function. Set to `NULL` to disable streaming
+ * \param[in]       arg: Custom argument for callback function
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_input_set_line_stream_fn(lwcell_line_stream_fn fn, void* arg) {
+    lwcell_core_lock();
+    lwcell.parser.line_stream_fn = fn;
+    lwcell.parser.line_stream_arg = arg;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_RCV_LINE_STREAM || __DOXYGEN__ */
+
+#if LWCELL_CFG_AT_ECHO_SKIP || __DOXYGEN__
+
+/**
+ * \brief           Set callback function for command echo, skipped by parser
+ *
+ * Callback is called once for every echoed line, matched against sent command
+ *
+ * \note            Callback is called from processing thread
+ * \param[in]       fn: Callback function. Set to `NULL` to disable
+ * \param[in]       arg: Custom argument for callback function
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_input_set_echo_tap_fn(lwcell_echo_tap_fn fn, void* arg) {
+    lwcell_core_lock();
+    lwcell.parser.echo.tap_fn = fn;
+    lwcell.parser.echo.tap_arg = arg;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_AT_ECHO_SKIP || __DOXYGEN__ */
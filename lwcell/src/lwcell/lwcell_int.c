@@ -36,14 +36,6 @@
 #include "system/lwcell_ll.h"
 
 #if !__DOXYGEN__
-/**
- * \brief           Receive character structure to handle full line terminated with `\n` character
- */
-typedef struct {
-    char data[128]; /*!< Received characters */
-    size_t len;     /*!< Length of valid characters */
-} lwcell_recv_t;
-
 /**
  * \brief           Processing function status data
  */
@@ -55,25 +47,195 @@ typedef struct {
 /* Receive character macros */
 #define RECV_ADD(ch)                                                                                                   \
     do {                                                                                                               \
-        if (recv_buff.len < (sizeof(recv_buff.data)) - 1) {                                                            \
-            recv_buff.data[recv_buff.len++] = ch;                                                                      \
-            recv_buff.data[recv_buff.len] = 0;                                                                         \
+        char c_ = (char)(ch);                                                                                          \
+        if (lwcell.parser.recv.len < (sizeof(lwcell.parser.recv.data)) - 1) {                                          \
+            lwcell.parser.recv.data[lwcell.parser.recv.len++] = c_;                                                    \
+        } else {                                                                                                       \
+            prv_recv_overflow(&c_, 1);                                                                                 \
         }                                                                                                              \
     } while (0)
 #define RECV_RESET()                                                                                                   \
     do {                                                                                                               \
-        recv_buff.len = 0;                                                                                             \
-        recv_buff.data[0] = 0;                                                                                         \
+        if (lwcell.parser.recv.overflow > 0) {                                                                         \
+            prv_recv_overflow_end();                                                                                   \
+        }                                                                                                              \
+        lwcell.parser.recv.len = 0;                                                                                    \
+    } while (0)
+#define RECV_TERM()                 (lwcell.parser.recv.data[lwcell.parser.recv.len] = 0)
+#define RECV_LEN()                  ((size_t)lwcell.parser.recv.len)
+#define RECV_IDX(index)             lwcell.parser.recv.data[index]
+
+/**
+ * \brief           Account characters, which do not fit to line buffer, and stream them when enabled
+ * \param[in]       data: Characters to account
+ * \param[in]       len: Number of characters
+ */
+static void
+prv_recv_overflow(const char* data, size_t len) {
+#if LWCELL_CFG_RCV_LINE_STREAM
+    if (lwcell.parser.line_stream_fn != NULL) {
+        if (lwcell.parser.recv.overflow == 0) { /* Beginning of line is in buffer */
+            lwcell.parser.line_stream_fn(lwcell.parser.recv.data, lwcell.parser.recv.len, 0,
+                                         lwcell.parser.line_stream_arg);
+        }
+        lwcell.parser.line_stream_fn(data, len, 0, lwcell.parser.line_stream_arg);
+    }
+#else  /* LWCELL_CFG_RCV_LINE_STREAM */
+    LWCELL_UNUSED(data);
+#endif /* !LWCELL_CFG_RCV_LINE_STREAM */
+    lwcell.parser.recv.overflow += len;
+}
+
+/**
+ * \brief           Finish line, which did not fit to line buffer
+ */
+static void
+prv_recv_overflow_end(void) {
+    LWCELL_DEBUGF(LWCELL_CFG_DBG_INPUT | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING,
+                  "[LWCELL] Received line truncated, %d characters dropped\r\n", (int)lwcell.parser.recv.overflow);
+    LWCELL_STATS_ADD(line_overflows, 1);
+    LWCELL_STATS_ADD(line_overflow_bytes, lwcell.parser.recv.overflow);
+#if LWCELL_CFG_RCV_LINE_STREAM
+    if (lwcell.parser.line_stream_fn != NULL) {
+        lwcell.parser.line_stream_fn(NULL, 0, 1, lwcell.parser.line_stream_arg);
+    }
+#endif /* LWCELL_CFG_RCV_LINE_STREAM */
+    lwcell.parser.recv.overflow = 0;
+}
+
+#if LWCELL_CFG_AT_ECHO_SKIP
+
+/* Record sent command for echo matching */
+#define ECHO_RECORD_BEGIN()                                                                                            \
+    do {                                                                                                               \
+        lwcell.parser.echo.len = 0;                                                                                    \
+        lwcell.parser.echo.truncated = 0;                                                                              \
+        lwcell.parser.echo.record = 1;                                                                                 \
     } while (0)
-#define RECV_LEN()                  ((size_t)recv_buff.len)
-#define RECV_IDX(index)             recv_buff.data[index]
+#define ECHO_RECORD_END() (lwcell.parser.echo.record = 0)
+
+/**
+ * \brief           Remember characters of command being sent, to be matched as echo later
+ * \param[in]       data: Sent characters, `NULL` for flush
+ * \param[in]       len: Number of characters
+ */
+static void
+prv_echo_record(const void* data, size_t len) {
+    size_t cpy;
+
+    if (!lwcell.parser.echo.record || data == NULL) {
+        return;
+    }
+    cpy = LWCELL_MIN(len, sizeof(lwcell.parser.echo.cmd) - lwcell.parser.echo.len);
+    LWCELL_MEMCPY(&lwcell.parser.echo.cmd[lwcell.parser.echo.len], data, cpy);
+    lwcell.parser.echo.len += cpy;
+    if (cpy < len) {
+        lwcell.parser.echo.truncated = 1;
+    }
+}
+
+/**
+ * \brief           Stop echo matching for last sent command
+ * \param[in]       restore: Set to `1` to move matched characters to receive buffer
+ */
+static void
+prv_echo_stop(uint8_t restore) {
+    if (restore) {
+        for (size_t i = 0; i < lwcell.parser.echo.match; ++i) {
+            RECV_ADD(lwcell.parser.echo.cmd[i]);
+        }
+    }
+    lwcell.parser.echo.len = 0;
+    lwcell.parser.echo.match = 0;
+    lwcell.parser.echo.tail = 0;
+}
+
+/**
+ * \brief           Consume echo of last sent command from received data
+ *
+ * Beginning of line is compared with remembered command. On mismatch, matched characters
+ * are moved to receive buffer and line continues with normal processing
+ *
+ * \param[in]       data: Received data, starting with current character
+ * \param[in]       len: Number of bytes in data
+ * \return          Number of consumed bytes, `0` if current character must be processed as part of the line
+ */
+static size_t
+prv_echo_skip(const uint8_t* data, size_t len) {
+    size_t i = 0;
+
+    /* Compare command characters */
+    for (; i < len && !lwcell.parser.echo.tail; ++i) {
+        if ((char)data[i] != lwcell.parser.echo.cmd[lwcell.parser.echo.match]) {
+            prv_echo_stop(1); /* Not an echo, give back matched part of the line */
+            return i;
+        }
+        if (++lwcell.parser.echo.match >= lwcell.parser.echo.len) {
+            lwcell.parser.echo.tail = 1;
+        }
+    }
+
+    /* Skip line termination, or rest of command which did not fit to memory */
+    for (; i < len; ++i) {
+        if (data[i] == '\n') {
+            LWCELL_STATS_ADD(echo_lines, 1);
+            if (lwcell.parser.echo.tap_fn != NULL) {
+                lwcell.parser.echo.tap_fn(lwcell.parser.echo.cmd, lwcell.parser.echo.len, lwcell.parser.echo.tap_arg);
+            }
+            prv_echo_stop(0);
+            return i + 1;
+        }
+        if (data[i] != '\r' && !lwcell.parser.echo.truncated) {
+            prv_echo_stop(1); /* Line continues after command, it is not an echo */
+            return i;
+        }
+    }
+    return i;
+}
+
+#else /* LWCELL_CFG_AT_ECHO_SKIP */
+#define ECHO_RECORD_BEGIN()
+#define ECHO_RECORD_END()
+#endif /* !LWCELL_CFG_AT_ECHO_SKIP */
+
+/**
+ * \brief           Pass data to low-level driver send function
+ * \param[in]       data: Data to send, `NULL` together with `len = 0` to flush
+ * \param[in]       len: Number of bytes to send
+ * \return          Number of bytes sent
+ */
+static size_t
+prv_ll_send(const void* data, size_t len) {
+    size_t res;
+
+    LWCELL_TRACE_HOOK(LWCELL_TRACE_SEND_FN, LWCELL_TRACE_BEGIN, len);
+    res = lwcell.ll.send_fn(data, len);
+    LWCELL_TRACE_HOOK(LWCELL_TRACE_SEND_FN, LWCELL_TRACE_END, 0);
+    return res;
+}
 
 /* Send data over AT port */
-#define AT_PORT_SEND_STR(str)       lwcell.ll.send_fn((const void*)(str), (size_t)strlen(str))
-#define AT_PORT_SEND_CONST_STR(str) lwcell.ll.send_fn((const void*)(str), (size_t)(sizeof(str) - 1))
-#define AT_PORT_SEND_CHR(ch)        lwcell.ll.send_fn((const void*)(ch), (size_t)1)
-#define AT_PORT_SEND_FLUSH()        lwcell.ll.send_fn(NULL, 0)
-#define AT_PORT_SEND(d, l)          lwcell.ll.send_fn((const void*)(d), (size_t)(l))
+#if LWCELL_CFG_AT_PORT_TX_BUFF_SIZE > 0
+#define AT_PORT_SEND_LL_FN(d, l)    lwcelli_at_port_send((d), (l))
+#elif LWCELL_CFG_STATS_COUNTERS
+#define AT_PORT_SEND_LL_FN(d, l)    LWCELL_STATS_ADD(tx_bytes, prv_ll_send((d), (l)))
+#else /* LWCELL_CFG_STATS_COUNTERS */
+#define AT_PORT_SEND_LL_FN(d, l)    prv_ll_send((d), (l))
+#endif /* !LWCELL_CFG_STATS_COUNTERS */
+#if LWCELL_CFG_AT_ECHO_SKIP
+#define AT_PORT_SEND_FN(d, l)                                                                                          \
+    do {                                                                                                               \
+        prv_echo_record((d), (l));                                                                                     \
+        AT_PORT_SEND_LL_FN((d), (l));                                                                                  \
+    } while (0)
+#else /* LWCELL_CFG_AT_ECHO_SKIP */
+#define AT_PORT_SEND_FN(d, l)       AT_PORT_SEND_LL_FN((d), (l))
+#endif /* !LWCELL_CFG_AT_ECHO_SKIP */
+#define AT_PORT_SEND_STR(str)       AT_PORT_SEND_FN((const void*)(str), (size_t)strlen(str))
+#define AT_PORT_SEND_CONST_STR(str) AT_PORT_SEND_FN((const void*)(str), (size_t)(sizeof(str) - 1))
+#define AT_PORT_SEND_CHR(ch)        AT_PORT_SEND_FN((const void*)(ch), (size_t)1)
+#define AT_PORT_SEND_FLUSH()        AT_PORT_SEND_FN(NULL, 0)
+#define AT_PORT_SEND(d, l)          AT_PORT_SEND_FN((const void*)(d), (size_t)(l))
 #define AT_PORT_SEND_WITH_FLUSH(d, l)                                                                                  \
     do {                                                                                                               \
         AT_PORT_SEND((d), (l));                                                                                        \
@@ -83,12 +245,15 @@ typedef struct {
 /* Beginning and end of every AT command */
 #define AT_PORT_SEND_BEGIN_AT()                                                                                        \
     do {                                                                                                               \
+        ECHO_RECORD_BEGIN();                                                                                           \
         AT_PORT_SEND_CONST_STR("AT");                                                                                  \
     } while (0)
 #define AT_PORT_SEND_END_AT()                                                                                          \
     do {                                                                                                               \
+        ECHO_RECORD_END();                                                                                             \
         AT_PORT_SEND(CRLF, CRLF_LEN);                                                                                  \
         AT_PORT_SEND(NULL, 0);                                                                                         \
+        LWCELL_TRACE_HOOK(LWCELL_TRACE_CMD_TX, LWCELL_TRACE_INSTANT, lwcell.msg != NULL ? lwcell.msg->cmd : 0);        \
     } while (0)
 
 /* Send special characters over AT port with condition */
@@ -116,9 +281,87 @@ typedef struct {
 #define AT_PORT_SEND_ESC()    AT_PORT_SEND_STR("\x1B")
 #endif /* !__DOXYGEN__ */
 
-static lwcell_recv_t recv_buff;
 static lwcellr_t lwcelli_process_sub_cmd(lwcell_msg_t* msg, lwcell_status_flags_t* stat);
 
+#if LWCELL_CFG_CONN
+
+/**
+ * \brief           Connection command set driver
+ *
+ * Encoders and decoders of connection commands which differ between command sets of device models.
+ * Driver is bound when device is identified, connection hot paths then run without model checks
+ */
+typedef struct lwcelli_conn_drv {
+    void (*send_open)(lwcell_conn_p c);             /*!< Send open command with connection number */
+    void (*send_close)(uint32_t num);               /*!< Send close command with connection number */
+    void (*send_data)(lwcell_conn_p c, size_t len); /*!< Send data write command with connection and length */
+#if LWCELL_CFG_CONN_MANUAL_RECV
+    void (*send_read)(lwcell_conn_p c, size_t len); /*!< Send data read command with connection and length */
+#endif                                              /* LWCELL_CFG_CONN_MANUAL_RECV */
+    void (*process_send_confirm)(lwcell_recv_t* rcv,
+                                 lwcell_status_flags_t* stat); /*!< Process confirmation of written data */
+    uint8_t read_inline; /*!< Set to `1` when read data follow response header on the same line */
+} lwcelli_conn_drv_t;
+
+static const lwcelli_conn_drv_t conn_drv_cip;
+#if LWCELL_CFG_CONN_CA_SOCKET
+static const lwcelli_conn_drv_t conn_drv_ca;
+#endif /* LWCELL_CFG_CONN_CA_SOCKET */
+
+/* Connection driver of identified device, `AT+CIP` driver until device is identified */
+#define CONN_DRV() (lwcell.conn_drv != NULL ? lwcell.conn_drv : &conn_drv_cip)
+
+static void lwcelli_conn_drv_bind(void);
+
+#endif /* LWCELL_CFG_CONN */
+
+#if LWCELL_CFG_AT_PORT_TX_BUFF_SIZE > 0
+
+/**
+ * \brief           Write staged AT port data to low-level driver
+ */
+static void
+lwcelli_at_port_tx_drain(void) {
+    if (lwcell.at_tx_len > 0) {
+        LWCELL_STATS_ADD(tx_bytes, prv_ll_send(lwcell.at_tx_buff, lwcell.at_tx_len));
+        lwcell.at_tx_len = 0;
+    }
+}
+
+/**
+ * \brief           Send data over AT port through transmit staging buffer
+ *
+ * Small fragments are collected and written to low-level driver with single call.
+ * Data that does not fit to the buffer is passed directly after staged data is written.
+ *
+ * \param[in]       data: Data to send. Set to `NULL` together with `len = 0` to flush
+ * \param[in]       len: Number of bytes to send
+ * \return          Number of bytes accepted
+ */
+static size_t
+lwcelli_at_port_send(const void* data, size_t len) {
+    if (data == NULL || len == 0) {
+        lwcelli_at_port_tx_drain();
+        return prv_ll_send(NULL, 0);
+    }
+    if (len >= sizeof(lwcell.at_tx_buff)) {
+        lwcelli_at_port_tx_drain();
+        LWCELL_STATS_ADD(tx_bytes, prv_ll_send(data, len));
+        return len;
+    }
+    if (lwcell.at_tx_len + len > sizeof(lwcell.at_tx_buff)) {
+        lwcelli_at_port_tx_drain();
+    }
+    LWCELL_MEMCPY(&lwcell.at_tx_buff[lwcell.at_tx_len], data, len);
+    lwcell.at_tx_len += len;
+    return len;
+}
+
+#endif /* LWCELL_CFG_AT_PORT_TX_BUFF_SIZE > 0 */
+#if LWCELL_CFG_MQTT
+static void lwcelli_mqtt_disconnected(uint8_t forced);
+#endif /* LWCELL_CFG_MQTT */
+
 /**
  * \brief           Memory mapping
  */
@@ -136,8 +379,10 @@ const size_t lwcell_dev_mem_map_size = LWCELL_ARRAYSIZE(lwcell_dev_mem_map);
  * \brief           List of supported devices
  */
 const lwcell_dev_model_map_t lwcell_dev_model_map[] = {
-#define LWCELL_DEVICE_MODEL_ENTRY(name, str_id, is_2g, is_lte, has_mqtt_native)                                        \
-    {LWCELL_DEVICE_MODEL_##name, str_id, is_2g, is_lte, has_mqtt_native},
+#define LWCELL_DEVICE_MODEL_ENTRY(name, str_id, is_2g, is_lte, has_mqtt_native, has_http_sh, has_quick_send,           \
+                                  has_rxget, has_ca_socket, max_send_len)                                              \
+    [LWCELL_DEVICE_MODEL_##name] = {LWCELL_DEVICE_MODEL_##name, str_id, is_2g, is_lte, has_mqtt_native, has_http_sh,   \
+                                    has_quick_send, has_rxget, has_ca_socket, max_send_len},
 #include "lwcell/lwcell_models.h"
 };
 
@@ -146,6 +391,42 @@ const lwcell_dev_model_map_t lwcell_dev_model_map[] = {
  */
 const size_t lwcell_dev_model_map_size = LWCELL_ARRAYSIZE(lwcell_dev_model_map);
 
+/**
+ * \brief           Capabilities used when device model is not known.
+ *                  Classic `AT+CIP*` command set is assumed
+ */
+const lwcell_dev_model_map_t lwcell_dev_model_unknown = {
+    LWCELL_DEVICE_MODEL_UNKNOWN, "", 0, 0, 0, 0, 1, 1, 0, LWCELL_CFG_CONN_MAX_DATA_LEN,
+};
+
+/**
+ * \brief           Get device model map entry for currently detected model
+ * \note            Use \ref LWCELL_DEV_MODEL_CAP macro to read capabilities
+ * \return          Pointer to model entry. \ref lwcell_dev_model_unknown when model is not known
+ */
+const lwcell_dev_model_map_t*
+lwcelli_dev_model_get(void) {
+    if (lwcell.m.model < LWCELL_DEVICE_MODEL_END) {
+        return &lwcell_dev_model_map[lwcell.m.model];
+    }
+    return &lwcell_dev_model_unknown;
+}
+
+/**
+ * \brief           Release ring write buffer memory of connection send data
+ * \param[in]       m: Send data message type
+ */
+#if LWCELL_CFG_CONN_WRITE_RING
+#define CONN_SEND_DATA_RING_RELEASE(m)                                                                                 \
+    do {                                                                                                               \
+        if ((m) != NULL && (m)->msg.conn_send.ring_len > 0) {                                                          \
+            lwcelli_conn_write_ring_sent(m);                                                                           \
+        }                                                                                                              \
+    } while (0)
+#else /* LWCELL_CFG_CONN_WRITE_RING */
+#define CONN_SEND_DATA_RING_RELEASE(m)
+#endif /* !LWCELL_CFG_CONN_WRITE_RING */
+
 /**
  * \brief           Free connection send data memory
  * \param[in]       m: Send data message type
@@ -160,8 +441,42 @@ const size_t lwcell_dev_model_map_size = LWCELL_ARRAYSIZE(lwcell_dev_model_map);
                 lwcell_mem_free_s((void**)&((m)->msg.conn_send.data));                                                 \
             }                                                                                                          \
         }                                                                                                              \
+        if ((m) != NULL && (m)->msg.conn_send.pbuf != NULL) {                                                          \
+            lwcell_pbuf_free_s(&(m)->msg.conn_send.pbuf);                                                              \
+        }                                                                                                              \
+        CONN_SEND_DATA_RING_RELEASE(m);                                                                                \
     } while (0)
 
+/**
+ * \brief           Check if send message gave up its turn, with rest of data still to send
+ * \param[in]       m: Send data message type
+ */
+#if LWCELL_CFG_CONN_SEND_FAIR
+#define CONN_SEND_YIELDED(m) ((m)->is_yielded)
+#else  /* LWCELL_CFG_CONN_SEND_FAIR */
+#define CONN_SEND_YIELDED(m) 0
+#endif /* !LWCELL_CFG_CONN_SEND_FAIR */
+
+/**
+ * \brief           Check if rest of send message data was dropped after deadline or cancellation
+ * \param[in]       m: Send data message type
+ */
+#if LWCELL_CFG_CONN_SEND_DEADLINE
+#define CONN_SEND_STALE(m) ((m)->msg.conn_send.stale)
+#else  /* LWCELL_CFG_CONN_SEND_DEADLINE */
+#define CONN_SEND_STALE(m) 0
+#endif /* !LWCELL_CFG_CONN_SEND_DEADLINE */
+
+/**
+ * \brief           Check if application did not provide all data of send stream chunk
+ * \param[in]       m: Send data message type
+ */
+#if LWCELL_CFG_CONN_SEND_STREAM
+#define CONN_SEND_READ_FAILED(m) ((m)->msg.conn_send.read_failed)
+#else  /* LWCELL_CFG_CONN_SEND_STREAM */
+#define CONN_SEND_READ_FAILED(m) 0
+#endif /* !LWCELL_CFG_CONN_SEND_STREAM */
+
 /**
  * \brief           Send connection callback for "data send"
  * \param[in]       m: Command message
@@ -208,7 +523,7 @@ const size_t lwcell_dev_model_map_size = LWCELL_ARRAYSIZE(lwcell_dev_model_map);
     do {                                                                                                               \
         lwcell.evt.evt.operator_scan.res = err;                                                                        \
         lwcell.evt.evt.operator_scan.ops = (m)->msg.cops_scan.ops;                                                     \
-        lwcell.evt.evt.operator_scan.opf = *(m)->msg.cops_scan.opf;                                                    \
+        lwcell.evt.evt.operator_scan.opf = (m)->msg.cops_scan.opsi;                                                    \
         lwcelli_send_cb(LWCELL_EVT_OPERATOR_SCAN);                                                                     \
     } while (0)
 
@@ -245,7 +560,7 @@ const size_t lwcell_dev_model_map_size = LWCELL_ARRAYSIZE(lwcell_dev_model_map);
 #define SMS_SEND_LIST_EVT(mm, err)                                                                                     \
     do {                                                                                                               \
         lwcell.evt.evt.sms_list.mem = lwcell.m.sms.mem[0].current;                                                     \
-        lwcell.evt.evt.sms_list.entries = (mm)->msg.sms_list.entries;                                                  \
+        lwcell.evt.evt.sms_list.entries = (mm)->msg.sms_list.entry_fn != NULL ? NULL : (mm)->msg.sms_list.entries;     \
         lwcell.evt.evt.sms_list.size = (mm)->msg.sms_list.ei;                                                          \
         lwcell.evt.evt.sms_list.res = err;                                                                             \
         lwcelli_send_cb(LWCELL_EVT_SMS_LIST);                                                                          \
@@ -263,6 +578,119 @@ const size_t lwcell_dev_model_map_size = LWCELL_ARRAYSIZE(lwcell_dev_model_map);
         lwcelli_send_cb(LWCELL_EVT_SMS_SEND);                                                                          \
     } while (0)
 
+/* Maximal number of SIM info reads when SIM is not ready just after PIN entry */
+#define SIM_INFO_TRIES_MAX      5
+
+/* Time between SIM info reads, in units of milliseconds */
+#define SIM_INFO_RETRY_INTERVAL 1000
+
+/* Maximal number of SIM state polls after PIN entry */
+#define SIM_POLL_MAX            5
+
+/* Base time between SIM state polls after PIN entry, multiplied by poll number, in units of milliseconds */
+#define SIM_POLL_INTERVAL       500
+
+/* Time device needs after hardware reset before it accepts commands, in units of milliseconds */
+#define HW_RESET_RECOVERY_TIME  500
+
+/**
+ * \brief           Repeat SIM info read, when SIM did not reply on previous try
+ * \param[in]       arg: Unused
+ */
+static void
+lwcelli_sim_info_timeout_fn(void* arg) {
+    LWCELL_UNUSED(arg);
+    if (lwcell.m.sim.state == LWCELL_SIM_STATE_READY) {
+        lwcelli_get_sim_info(0);
+    }
+}
+
+#if LWCELL_CFG_CALL || LWCELL_CFG_SMS
+
+/**
+ * \brief           Read SIM info immediately when retry was scheduled
+ * \note            Called on modem URCs, which indicate SIM became fully operational
+ */
+static void
+lwcelli_sim_info_retry_now(void) {
+    if (lwcell_timeout_remove(lwcelli_sim_info_timeout_fn) == lwcellOK) {
+        lwcelli_get_sim_info(0);
+    }
+}
+
+#endif /* LWCELL_CFG_CALL || LWCELL_CFG_SMS */
+
+/**
+ * \brief           Continue parked command
+ * \note            Timeout entry is part of message and is stopped before message is released,
+ *                  hence `arg` always points to the message which parked itself
+ * \param[in]       arg: Parked message
+ */
+static void
+lwcelli_cmd_park_timeout_fn(void* arg) {
+    lwcell_msg_t* msg = arg;
+
+    if (lwcell.msg != msg || !msg->is_parked) {
+        return; /* Command is not active anymore */
+    }
+    lwcelli_cmd_unpark(msg);
+}
+
+/**
+ * \brief           Park active command and continue it with its initiate function after specified time
+ *
+ * Command stays active, but neither processing nor producer thread waits for it.
+ * It is used instead of \ref lwcell_delay inside command state machine.
+ *
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Active message
+ * \param[in]       time: Time to wait before command continues, in units of milliseconds
+ * \return          `1` when command is parked, `0` when time was waited in place and caller shall continue
+ */
+uint8_t
+lwcelli_cmd_park(lwcell_msg_t* msg, uint32_t time) {
+    if (lwcell_timeout_start(&msg->park_to, time, lwcelli_cmd_park_timeout_fn, msg) == lwcellOK) {
+        msg->is_parked = 1;
+        return 1;
+    }
+    lwcell_delay(time); /* No memory for timeout, fall back to blocking wait */
+    return 0;
+}
+
+/**
+ * \brief           Continue parked command immediately
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Parked message
+ */
+void
+lwcelli_cmd_unpark(lwcell_msg_t* msg) {
+    lwcellr_t res;
+
+    if (!msg->is_parked) {
+        return;
+    }
+    lwcell_timeout_stop(&msg->park_to);
+    msg->is_parked = 0;
+    if ((res = msg->fn(msg)) != lwcellOK) {
+        msg->res = res;
+        LWCELL_TRACE_HOOK(LWCELL_TRACE_SYNC, LWCELL_TRACE_INSTANT, res);
+        lwcell_sys_sem_release(&lwcell.sem_sync); /* Command cannot continue, finish it */
+    }
+}
+
+/**
+ * \brief           Cancel continuation of parked command
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Finished message
+ */
+void
+lwcelli_cmd_park_cancel(lwcell_msg_t* msg) {
+    if (msg->is_parked) {
+        lwcell_timeout_stop(&msg->park_to);
+        msg->is_parked = 0;
+    }
+}
+
 /**
  * \brief           Get SIM info when SIM is ready
  * \param[in]       blocking: Blocking command
@@ -272,7 +700,9 @@ lwcellr_t
 lwcelli_get_sim_info(const uint32_t blocking) {
     LWCELL_MSG_VAR_DEFINE(msg);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    lwcell_timeout_remove(lwcelli_sim_info_timeout_fn); /* New read replaces pending retry */
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE_HDR);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_SIM_PROCESS_BASIC_CMDS;
     LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CNUM;
 
@@ -431,8 +861,85 @@ lwcelli_send_sms_stat(lwcell_sms_status_t status, uint8_t q, uint8_t c) {
     lwcelli_send_string(t, 0, q, c);
 }
 
+#if LWCELL_CFG_SMS_PDU || __DOXYGEN__
+
+/**
+ * \brief           Encode current part of PDU mode SMS
+ * \param[in]       msg: Send SMS message
+ * \param[out]      pdu: Output buffer of \ref LWCELL_SMS_PDU_MAX_LEN bytes
+ * \return          Length of PDU in units of bytes, `0` on error
+ */
+static size_t
+lwcelli_sms_pdu_encode_part(lwcell_msg_t* msg, uint8_t* pdu) {
+    lwcell_sms_concat_t concat;
+    const uint8_t* d = (const uint8_t*)msg->msg.sms_send.data + msg->msg.sms_send.off;
+    size_t rem = msg->msg.sms_send.len - msg->msg.sms_send.off;
+
+    concat.ref = msg->msg.sms_send.ref;
+    concat.total = msg->msg.sms_send.parts;
+    concat.seq = msg->msg.sms_send.part;
+    msg->msg.sms_send.part_len = lwcell_sms_pdu_part_len(msg->msg.sms_send.dcs, d, rem, concat.total > 1);
+    return lwcell_sms_pdu_encode(pdu, LWCELL_SMS_PDU_MAX_LEN, msg->msg.sms_send.num, msg->msg.sms_send.dcs, d,
+                                 msg->msg.sms_send.part_len, concat.total > 1 ? &concat : NULL);
+}
+
+/**
+ * \brief           Load current batch entry to send SMS message
+ *
+ * Entries which cannot be encoded are marked with \ref lwcellERRPAR and skipped
+ *
+ * \param[in]       msg: Send SMS message
+ * \return          `1` if entry is ready to send, `0` when there are no more entries
+ */
+static uint8_t
+lwcelli_sms_batch_load(lwcell_msg_t* msg) {
+    for (; msg->msg.sms_send.batch_idx < msg->msg.sms_send.batch_len; ++msg->msg.sms_send.batch_idx) {
+        lwcell_sms_batch_entry_t* e = &msg->msg.sms_send.batch[msg->msg.sms_send.batch_idx];
+        size_t len = strlen(e->text), parts;
+
+        msg->msg.sms_send.dcs = LWCELL_SMS_DCS_GSM7;
+        if ((parts = lwcell_sms_pdu_parts(LWCELL_SMS_DCS_GSM7, e->text, len)) == 0) {
+            msg->msg.sms_send.dcs = LWCELL_SMS_DCS_UCS2;
+            parts = lwcell_sms_pdu_parts(LWCELL_SMS_DCS_UCS2, e->text, len);
+        }
+        if (parts == 0) {
+            e->res = lwcellERRPAR;
+            msg->msg.sms_send.batch_err = 1;
+            continue;
+        }
+        msg->msg.sms_send.num = e->num;
+        msg->msg.sms_send.data = e->text;
+        msg->msg.sms_send.len = len;
+        msg->msg.sms_send.off = 0;
+        msg->msg.sms_send.parts = (uint8_t)parts;
+        msg->msg.sms_send.part = 1;
+        msg->msg.sms_send.pos = 0;
+        msg->msg.sms_send.ref = ++lwcell.m.sms.pdu_ref;
+        return 1;
+    }
+    return 0;
+}
+
+#endif /* LWCELL_CFG_SMS_PDU || __DOXYGEN__ */
+
 #endif /* LWCELL_CFG_SMS */
 
+/**
+ * \brief           Set device model from model number string
+ */
+static void
+lwcelli_device_model_from_number(void) {
+    if (LWCELL_DEV_MODEL_IS_FIXED) {
+        return; /* Model is set at compile time */
+    }
+    for (size_t i = 0; i < lwcell_dev_model_map_size; ++i) {
+        if (strstr(lwcell.m.model_number, lwcell_dev_model_map[i].id_str) != NULL) {
+            lwcell.m.model = lwcell_dev_model_map[i].model;
+            break;
+        }
+    }
+}
+
 #if LWCELL_CFG_CONN || __DOXYGEN__
 
 /**
@@ -457,6 +964,20 @@ reset_connections(uint8_t forced) {
     }
 }
 
+/**
+ * \brief           Connection data read started or ended in input processing
+ * \param[in]       active: `1` when read starts, `0` when it ends
+ */
+static void
+lwcelli_ipd_read_active(uint8_t active) {
+#if LWCELL_CFG_THREAD_PROCESS_IPD_BOOST
+    lwcell_sys_thread_set_prio(&lwcell.thread_process,
+                               active ? LWCELL_CFG_THREAD_PROCESS_IPD_PRIO : LWCELL_CFG_THREAD_PROCESS_PRIO);
+#endif /* LWCELL_CFG_THREAD_PROCESS_IPD_BOOST */
+    LWCELL_THREAD_PROCESS_IPD_HOOK(active);
+    LWCELL_UNUSED(active);
+}
+
 #endif /* LWCELL_CFG_CONN || __DOXYGEN__ */
 
 /**
@@ -474,7 +995,24 @@ lwcelli_reset_everything(uint8_t forced) {
      *          - Reset GSM structure
      */
 
+#if LWCELL_CFG_CMUX
+    /* Device leaves multiplexer mode with reset */
+    lwcelli_cmux_reset();
+#endif /* LWCELL_CFG_CMUX */
+#if LWCELL_CFG_PPP
+    lwcelli_ppp_reset();
+#endif /* LWCELL_CFG_PPP */
+#if LWCELL_CFG_PWR
+    lwcelli_pwr_reset();
+#endif /* LWCELL_CFG_PWR */
+#if LWCELL_CFG_SMS_DIRECT
+    lwcell.m.sms.direct_read = 0; /* Partial message text is lost */
+#endif                            /* LWCELL_CFG_SMS_DIRECT */
+
 #if LWCELL_CFG_CONN
+#if LWCELL_CFG_NETWORK_PDP_RECOVERY
+    lwcelli_network_pdp_reset(); /* Connections waiting for recovery are closed too */
+#endif                           /* LWCELL_CFG_NETWORK_PDP_RECOVERY */
     /* Manually close all connections in memory */
     reset_connections(forced);
 
@@ -482,6 +1020,9 @@ lwcelli_reset_everything(uint8_t forced) {
     if (lwcell.m.ipd.buff != NULL) {
         lwcell_pbuf_free_s(&lwcell.m.ipd.buff);
     }
+    if (lwcell.m.ipd.read) {
+        lwcelli_ipd_read_active(0);
+    }
 #endif /* LWCELL_CFG_CONN */
 
 #if LWCELL_CFG_NETWORK
@@ -490,14 +1031,25 @@ lwcelli_reset_everything(uint8_t forced) {
         lwcell.m.network.is_attached = 0;
         lwcelli_send_cb(LWCELL_EVT_NETWORK_DETACHED);
     }
+#if LWCELL_CFG_NETWORK_CONTEXTS > 1
+    LWCELL_MEMSET(lwcell.m.network.ctx, 0x00, sizeof(lwcell.m.network.ctx));
+#endif /* LWCELL_CFG_NETWORK_CONTEXTS > 1 */
 #endif /* LWCELL_CFG_NETWORK */
 
+#if LWCELL_CFG_MQTT
+    /* Device lost MQTT connection with reset */
+    lwcelli_mqtt_disconnected(forced);
+#endif /* LWCELL_CFG_MQTT */
+
     /* Invalid GSM modules */
     LWCELL_MEMSET(&lwcell.m, 0x00, sizeof(lwcell.m));
 
     /* Manually set states */
     lwcell.m.sim.state = (lwcell_sim_state_t)-1;
-    lwcell.m.model = LWCELL_DEVICE_MODEL_UNKNOWN;
+    lwcell.m.model = LWCELL_CFG_DEVICE_MODEL;
+#if LWCELL_CFG_CONN
+    lwcelli_conn_drv_bind();
+#endif /* LWCELL_CFG_CONN */
 }
 
 /**
@@ -508,16 +1060,106 @@ lwcelli_reset_everything(uint8_t forced) {
 lwcellr_t
 lwcelli_send_cb(lwcell_evt_type_t type) {
     lwcell.evt.type = type; /* Set callback type to process */
+    LWCELL_STATS_ADD(evt[type], 1);
+
+    /* Skip list when no function is subscribed to this event type */
+    if (!(lwcell.evt_mask & LWCELL_EVT_MASK(type))) {
+        return lwcellOK;
+    }
 
-    /* Call callback function for all registered functions */
+    /* Call callback function for all subscribed registered functions */
+    LWCELL_EVT_LOCK();
     for (lwcell_evt_func_t* link = lwcell.evt_func; link != NULL; link = link->next) {
-        link->fn(&lwcell.evt);
+        if ((link->mask & LWCELL_EVT_MASK(type)) && !LWCELL_EVT_DEFER(link->fn)) {
+            LWCELL_TRACE_HOOK(LWCELL_TRACE_EVT, LWCELL_TRACE_BEGIN, type);
+            link->fn(&lwcell.evt);
+            LWCELL_TRACE_HOOK(LWCELL_TRACE_EVT, LWCELL_TRACE_END, 0);
+        }
     }
+    LWCELL_EVT_UNLOCK();
     return lwcellOK;
 }
 
 #if LWCELL_CFG_CONN || __DOXYGEN__
 
+/**
+ * \brief           Call connection event function with prepared callback structure
+ * \param[in]       evt: Event callback function
+ * \return          Member of \ref lwcellr_t enumeration
+ */
+static lwcellr_t
+prv_conn_evt_call(lwcell_evt_fn evt) {
+    lwcellr_t res;
+
+    if (LWCELL_EVT_DEFER(evt)) {
+        return lwcellOK;
+    }
+    LWCELL_TRACE_HOOK(LWCELL_TRACE_EVT, LWCELL_TRACE_BEGIN, lwcell.evt.type);
+    res = evt(&lwcell.evt);
+    LWCELL_TRACE_HOOK(LWCELL_TRACE_EVT, LWCELL_TRACE_END, 0);
+    return res;
+}
+
+#if LWCELL_CFG_CONN_RECV_BATCH > 0 || __DOXYGEN__
+
+/**
+ * \brief           Deliver collected received packets to batch receive function and free them
+ */
+static void
+prv_conn_recv_batch_flush(void) {
+    lwcell_conn_t* conn = lwcell.m.recv_batch_conn;
+    size_t cnt = lwcell.m.recv_batch_cnt;
+
+    if (cnt == 0) {
+        return;
+    }
+    lwcell.m.recv_batch_cnt = 0; /* Function may cause events of connection */
+    LWCELL_STATS_ADD(evt[LWCELL_EVT_CONN_RECV], cnt);
+    if (conn->recv_batch_fn != NULL) {
+        conn->recv_batch_fn(conn, lwcell.m.recv_batch, cnt, conn->arg);
+    }
+    for (size_t i = 0; i < cnt; ++i) {
+        lwcell_pbuf_free_s(&lwcell.m.recv_batch[i]);
+    }
+}
+
+#endif /* LWCELL_CFG_CONN_RECV_BATCH > 0 || __DOXYGEN__ */
+
+/**
+ * \brief           Pass received packet buffer to connection
+ *
+ * Typed receive functions are called directly, \ref LWCELL_EVT_CONN_RECV event is sent otherwise
+ *
+ * \param[in]       conn: Connection handle
+ * \param[in]       pbuf: Received packet buffer, freed by caller after function returns
+ * \return          Member of \ref lwcellr_t enumeration
+ */
+static lwcellr_t
+prv_conn_recv_cb(lwcell_conn_t* conn, lwcell_pbuf_p pbuf) {
+#if LWCELL_CFG_CONN_RECV_BATCH > 0
+    if (conn->recv_batch_fn != NULL) {
+        if (lwcell.m.recv_batch_cnt > 0
+            && (lwcell.m.recv_batch_conn != conn || lwcell.m.recv_batch_cnt == LWCELL_CFG_CONN_RECV_BATCH)) {
+            prv_conn_recv_batch_flush();
+        }
+        lwcell_pbuf_ref(pbuf); /* Packet stays valid until batch is delivered */
+        lwcell.m.recv_batch[lwcell.m.recv_batch_cnt++] = pbuf;
+        lwcell.m.recv_batch_conn = conn;
+        return lwcellOK;
+    }
+#endif /* LWCELL_CFG_CONN_RECV_BATCH > 0 */
+#if LWCELL_CFG_CONN_RECV_FN
+    if (conn->recv_fn != NULL) {
+        LWCELL_STATS_ADD(evt[LWCELL_EVT_CONN_RECV], 1);
+        return conn->recv_fn(conn, pbuf, conn->arg);
+    }
+#endif /* LWCELL_CFG_CONN_RECV_FN */
+    lwcell.evt.type = LWCELL_EVT_CONN_RECV;
+    lwcell.evt.evt.conn_data_recv.buff = pbuf;
+    lwcell.evt.evt.conn_data_recv.conn = conn;
+    return lwcelli_send_conn_cb(conn, NULL);
+}
+
 /**
  * \brief           Process connection callback
  * \note            Before calling function, callback structure must be prepared
@@ -531,11 +1173,16 @@ lwcelli_send_conn_cb(lwcell_conn_t* conn, lwcell_evt_fn evt) {
         && lwcell.evt.type != LWCELL_EVT_CONN_CLOSE) { /* Do not continue if in closing mode */
         /* return lwcellOK; */
     }
+#if LWCELL_CFG_CONN_RECV_BATCH > 0
+    /* Received data are delivered before other events, evt structure is not used by batch */
+    prv_conn_recv_batch_flush();
+#endif /* LWCELL_CFG_CONN_RECV_BATCH > 0 */
+    LWCELL_STATS_ADD(evt[lwcell.evt.type], 1);
 
     if (evt != NULL) {                                   /* Try with user connection */
-        return evt(&lwcell.evt);                         /* Call temporary function */
+        return prv_conn_evt_call(evt);                   /* Call temporary function */
     } else if (conn != NULL && conn->evt_func != NULL) { /* Connection custom callback? */
-        return conn->evt_func(&lwcell.evt);              /* Process callback function */
+        return prv_conn_evt_call(conn->evt_func);        /* Process callback function */
     } else if (conn == NULL) {
         return lwcellOK;
     }
@@ -556,38 +1203,290 @@ lwcelli_send_conn_cb(lwcell_conn_t* conn, lwcell_evt_fn evt) {
     return lwcell_conn_close(conn, 0);
 }
 
+#if LWCELL_CFG_EVT_DEFERRED || __DOXYGEN__
+
 /**
- * \brief           Process and send data from device buffer
- * \return          Member of \ref lwcellr_t enumeration
+ * \brief           Queue copy of current event to event dispatch thread
+ *
+ * Function is called for every callback function before it is called directly.
+ * Received packet buffer is referenced, it is freed by dispatch thread after callback returns.
+ *
+ * \param[in]       fn: Callback function to deliver event to
+ * \return          `1` if event has been queued, `0` if function must be called directly
  */
-static lwcellr_t
-lwcelli_tcpip_process_send_data(void) {
-    lwcell_conn_t* c = lwcell.msg->msg.conn_send.conn;
-    if (!lwcell_conn_is_active(c) ||                  /* Is the connection already closed? */
-        lwcell.msg->msg.conn_send.val_id != c->val_id /* Did validation ID change after we set parameter? */
-    ) {
-        /* Send event to user about failed send event */
-        CONN_SEND_DATA_SEND_EVT(lwcell.msg, lwcellCLOSED);
-        return lwcellERR;
-    }
-    lwcell.msg->msg.conn_send.sent = LWCELL_MIN(lwcell.msg->msg.conn_send.btw, LWCELL_CFG_CONN_MAX_DATA_LEN);
+uint8_t
+lwcelli_evt_defer(lwcell_evt_fn fn) {
+    lwcell_evt_rec_t* rec;
+    size_t i;
 
-    AT_PORT_SEND_BEGIN_AT();
-    AT_PORT_SEND_CONST_STR("+CIPSEND=");
-    lwcelli_send_number(LWCELL_U32(c->num), 0, 0);                         /* Send connection number */
-    lwcelli_send_number(LWCELL_U32(lwcell.msg->msg.conn_send.sent), 0, 1); /* Send length number */
+    for (i = 0; i < LWCELL_ARRAYSIZE(lwcell.evt_deferred_fn) && lwcell.evt_deferred_fn[i] != fn; ++i) {}
+    if (i == LWCELL_ARRAYSIZE(lwcell.evt_deferred_fn) || !lwcell_sys_mbox_isvalid(&lwcell.mbox_evt)) {
+        return 0;
+    }
+    if ((rec = lwcell_mem_malloc_tag(sizeof(*rec), LWCELL_MEM_TAG_EVT)) == NULL) {
+        return 0;
+    }
+    rec->fn = fn;
+    LWCELL_MEMCPY(&rec->evt, &lwcell.evt, sizeof(rec->evt));
+#if LWCELL_CFG_CONN
+    if (rec->evt.type == LWCELL_EVT_CONN_RECV) {
+        lwcell_pbuf_ref(rec->evt.evt.conn_data_recv.buff);
+    }
+#endif /* LWCELL_CFG_CONN */
 
-    /* On UDP connections, IP address and port may be selected */
-    if (c->type == LWCELL_CONN_TYPE_UDP) {
-        if (lwcell.msg->msg.conn_send.remote_ip != NULL && lwcell.msg->msg.conn_send.remote_port) {
-            lwcelli_send_ip_mac(lwcell.msg->msg.conn_send.remote_ip, 1, 1, 1); /* Send IP address including quotes */
-            lwcelli_send_port(lwcell.msg->msg.conn_send.remote_port, 0, 1);    /* Send length number */
+    /* Queue is full, deliver event directly not to lose it */
+    if (!lwcell_sys_mbox_putnow(&lwcell.mbox_evt, rec)) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_THREAD | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING,
+                      "[LWCELL EVT] Deferred event queue full, calling callback directly\r\n");
+#if LWCELL_CFG_CONN
+        if (rec->evt.type == LWCELL_EVT_CONN_RECV) {
+            lwcell_pbuf_free(rec->evt.evt.conn_data_recv.buff);
+        }
+#endif /* LWCELL_CFG_CONN */
+        lwcell_mem_free_s((void**)&rec);
+        return 0;
+    }
+    return 1;
+}
+
+#endif /* LWCELL_CFG_EVT_DEFERRED || __DOXYGEN__ */
+
+/**
+ * \brief           Minimal send chunk length when reducing it after failed send
+ */
+#define CONN_SEND_CHUNK_LEN_MIN 128
+
+/**
+ * \brief           Get maximal data length for single send command on connection
+ *
+ * Length reported by device with `AT+CIPSEND?` is used when available,
+ * otherwise length is limited by configuration and device model
+ *
+ * \param[in]       c: Connection handle
+ * \return          Maximal chunk length in units of bytes
+ */
+static size_t
+lwcelli_conn_send_max_len(lwcell_conn_t* c) {
+    if (c->max_send_len > 0) {
+        return c->max_send_len;
+    }
+    return LWCELL_MIN(LWCELL_CFG_CONN_MAX_DATA_LEN, (size_t)LWCELL_DEV_MODEL_CAP(max_send_len));
+}
+
+/**
+ * \brief           Get data length for single send command on connection
+ * \note            With \ref LWCELL_CFG_CONN_SEND_ADAPT, length is reduced on lossy link
+ * \param[in]       c: Connection handle
+ * \return          Chunk length in units of bytes
+ */
+size_t
+lwcelli_conn_send_chunk_len(lwcell_conn_t* c) {
+    size_t len = lwcelli_conn_send_max_len(c);
+
+#if LWCELL_CFG_CONN_SEND_ADAPT
+    if (c->send_chunk > 0) {
+        len = LWCELL_MIN(len, c->send_chunk);
+    }
+#endif /* LWCELL_CFG_CONN_SEND_ADAPT */
+    return len;
+}
+
+#if LWCELL_CFG_CONN_SEND_ADAPT || __DOXYGEN__
+
+/**
+ * \brief           Update link quality of connection after chunk was confirmed or failed
+ *
+ * Failed chunk halves chunk length and delays next chunk, consecutive confirmed chunks
+ * double chunk length and every confirmed chunk halves the delay
+ *
+ * \param[in]       c: Connection handle
+ * \param[in]       sent: Set to `1` when chunk was confirmed, `0` when it failed
+ */
+static void
+lwcelli_conn_send_adapt(lwcell_conn_t* c, uint8_t sent) {
+    uint32_t rtt = lwcell_sys_now() - lwcell.msg->msg.conn_send.chunk_start;
+    size_t len = lwcell.msg->msg.conn_send.sent, max_len = lwcelli_conn_send_max_len(c);
+
+    /* Smoothed round-trip time with 1/8 gain */
+    c->send_srtt = c->send_srtt == 0 ? rtt : (7 * c->send_srtt + rtt) / 8;
+    if (sent) {
+        ++c->send_ok;
+        c->send_loss -= c->send_loss / 8;
+        c->send_pace /= 2;
+        if (c->send_chunk > 0 && ++c->send_clean >= LWCELL_CFG_CONN_SEND_ADAPT_GROW) {
+            c->send_clean = 0;
+            c->send_chunk *= 2;
+            if (c->send_chunk >= max_len) {
+                c->send_chunk = 0; /* Link is clean again, use maximal length */
+            }
+        }
+    } else {
+        ++c->send_fail;
+        c->send_loss += (255 - c->send_loss + 7) / 8;
+        c->send_clean = 0;
+        c->send_pace = LWCELL_MIN(LWCELL_MAX(2 * c->send_pace, c->send_srtt / 2),
+                                  (uint32_t)LWCELL_CFG_CONN_SEND_ADAPT_PACE_MAX);
+        if (!lwcell.msg->msg.conn_send.dgram && len > CONN_SEND_CHUNK_LEN_MIN) {
+            c->send_chunk = LWCELL_MAX(len / 2, CONN_SEND_CHUNK_LEN_MIN);
+        }
+    }
+    LWCELL_DEBUGF(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE,
+                  "[LWCELL CONN] Connection %d send %s, rtt %u ms, chunk %u bytes, pace %u ms\r\n", (int)c->num,
+                  sent ? "ok" : "fail", (unsigned)rtt, (unsigned)lwcelli_conn_send_chunk_len(c),
+                  (unsigned)c->send_pace);
+}
+
+#endif /* LWCELL_CFG_CONN_SEND_ADAPT || __DOXYGEN__ */
+
+/**
+ * \brief           Get length of datagram at current write pointer, when each `iov` entry is separate datagram
+ * \return          Datagram length in units of bytes
+ */
+static size_t
+lwcelli_tcpip_dgram_len(void) {
+    size_t off = lwcell.msg->msg.conn_send.ptr;
+
+    for (size_t i = 0; i < lwcell.msg->msg.conn_send.iovcnt; ++i) {
+        if (off < lwcell.msg->msg.conn_send.iov[i].len) {
+            return lwcell.msg->msg.conn_send.iov[i].len - off;
         }
+        off -= lwcell.msg->msg.conn_send.iov[i].len;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Process and send data from device buffer
+ * \return          Member of \ref lwcellr_t enumeration
+ */
+static lwcellr_t
+lwcelli_tcpip_process_send_data(void) {
+    lwcell_conn_t* c = lwcell.msg->msg.conn_send.conn;
+    if (!lwcell_conn_is_active(c) ||                  /* Is the connection already closed? */
+        lwcell.msg->msg.conn_send.val_id != c->val_id /* Did validation ID change after we set parameter? */
+    ) {
+        /* Send event to user about failed send event */
+        CONN_SEND_DATA_SEND_EVT(lwcell.msg, lwcellCLOSED);
+        return lwcellERR;
+    }
+#if LWCELL_CFG_CONN_SEND_DEADLINE
+    if (lwcelli_conn_send_is_stale(lwcell.msg)) {
+        /* Drop rest of data, application does not need them anymore */
+        lwcell.msg->msg.conn_send.stale = 1;
+        CONN_SEND_DATA_SEND_EVT(lwcell.msg, lwcellERRSTALE);
+        return lwcellERRSTALE;
+    }
+#endif /* LWCELL_CFG_CONN_SEND_DEADLINE */
+    if (lwcell.msg->msg.conn_send.dgram) {
+        lwcell.msg->msg.conn_send.sent = lwcelli_tcpip_dgram_len(); /* Datagram is never split */
+    } else {
+        lwcell.msg->msg.conn_send.sent = LWCELL_MIN(lwcell.msg->msg.conn_send.btw, lwcelli_conn_send_chunk_len(c));
     }
+#if LWCELL_CFG_CONN_SEND_ADAPT
+    lwcell.msg->msg.conn_send.chunk_start = lwcell_sys_now();
+#endif /* LWCELL_CFG_CONN_SEND_ADAPT */
+
+    AT_PORT_SEND_BEGIN_AT();
+    CONN_DRV()->send_data(c, lwcell.msg->msg.conn_send.sent);
     AT_PORT_SEND_END_AT();
     return lwcellOK;
 }
 
+/**
+ * \brief           Write data of current CIPSEND chunk to AT port, after device sent `> ` prompt
+ *
+ * Chunk is written directly from its source: single buffer, data fragments, packet buffer chain
+ * or application read function. When read function provides less data, chunk is padded with zeros,
+ * as device expects announced number of bytes, and send fails after chunk is confirmed
+ */
+static void
+lwcelli_tcpip_write_data(void) {
+    size_t off = lwcell.msg->msg.conn_send.ptr, rem = lwcell.msg->msg.conn_send.sent, len;
+
+    if (lwcell.msg->msg.conn_send.pbuf != NULL) {
+        while (rem > 0) {
+            const uint8_t* d = lwcell_pbuf_get_linear_addr(lwcell.msg->msg.conn_send.pbuf, off, &len);
+
+            if (d == NULL || len == 0) {
+                break;
+            }
+            len = LWCELL_MIN(len, rem);
+            AT_PORT_SEND(d, len);
+            off += len;
+            rem -= len;
+        }
+#if LWCELL_CFG_CONN_SEND_STREAM
+    } else if (lwcell.msg->msg.conn_send.read_fn != NULL) {
+        uint8_t buff[LWCELL_CFG_CONN_SEND_STREAM_BUFF_LEN];
+
+        while (rem > 0) {
+            size_t r = 0;
+
+            len = LWCELL_MIN(rem, sizeof(buff));
+            if (!lwcell.msg->msg.conn_send.read_failed) {
+                r = lwcell.msg->msg.conn_send.read_fn(lwcell.msg->msg.conn_send.read_arg, off, buff, len);
+            }
+            if (r < len) {
+                lwcell.msg->msg.conn_send.read_failed = 1;
+                LWCELL_MEMSET(&buff[r], 0x00, len - r);
+            }
+            AT_PORT_SEND(buff, len);
+            off += len;
+            rem -= len;
+        }
+#endif /* LWCELL_CFG_CONN_SEND_STREAM */
+    } else if (lwcell.msg->msg.conn_send.iov != NULL) {
+        for (size_t i = 0; i < lwcell.msg->msg.conn_send.iovcnt && rem > 0; ++i) {
+            const lwcell_conn_iovec_t* v = &lwcell.msg->msg.conn_send.iov[i];
+
+            if (off >= v->len) { /* Skip fragments sent with previous chunks */
+                off -= v->len;
+                continue;
+            }
+            len = LWCELL_MIN(v->len - off, rem);
+            AT_PORT_SEND((const uint8_t*)v->data + off, len);
+            rem -= len;
+            off = 0;
+        }
+    } else {
+        AT_PORT_SEND(&lwcell.msg->msg.conn_send.data[off], rem);
+    }
+    AT_PORT_SEND_FLUSH();
+}
+
+#if LWCELL_CFG_CONN_SEND_FAIR || __DOXYGEN__
+
+/**
+ * \brief           Check if current send request shall give its turn to other connections
+ *
+ * Request yields after connection weight of chunks, when send requests for other connections are waiting.
+ * It never yields when request for the same connection is waiting, to keep data in order
+ *
+ * \return          `1` if request yields, `0` otherwise
+ */
+static uint8_t
+lwcelli_conn_send_yield(void) {
+    lwcell_conn_t* c = lwcell.msg->msg.conn_send.conn;
+    uint8_t weight = c->send_weight > 0 ? c->send_weight : LWCELL_CFG_CONN_SEND_FAIR;
+
+    if (++lwcell.msg->msg.conn_send.turn < weight) {
+        return 0;
+    }
+    lwcell.msg->msg.conn_send.turn = 0;
+#if LWCELL_CFG_CQ
+    if (lwcell.msg->cq != NULL) {
+        return 0; /* Batch is executed back to back */
+    }
+#endif /* LWCELL_CFG_CQ */
+    if (lwcell.m.conn_send_queued_all == 0 || lwcell.m.conn_send_queued[c - lwcell.m.conns] > 0) {
+        return 0;
+    }
+    lwcell.msg->is_yielded = 1;
+    return 1;
+}
+
+#endif /* LWCELL_CFG_CONN_SEND_FAIR || __DOXYGEN__ */
+
 /**
  * \brief           Process data sent and send remaining
  * \param[in]       sent: Status whether data were sent or not,
@@ -596,22 +1495,55 @@ lwcelli_tcpip_process_send_data(void) {
  */
 static uint8_t
 lwcelli_tcpip_process_data_sent(uint8_t sent) {
+#if LWCELL_CFG_CONN_SEND_ADAPT
+    lwcelli_conn_send_adapt(lwcell.msg->msg.conn_send.conn, sent);
+#endif /* LWCELL_CFG_CONN_SEND_ADAPT */
     if (sent) { /* Data were successfully sent */
         lwcell.msg->msg.conn_send.sent_all += lwcell.msg->msg.conn_send.sent;
+        LWCELL_STATS_ADD(conn_tx_bytes[lwcell.msg->msg.conn_send.conn->num], lwcell.msg->msg.conn_send.sent);
+#if LWCELL_CFG_USAGE
+        lwcelli_usage_add(lwcell.msg->msg.conn_send.conn, lwcell.msg->msg.conn_send.sent, 1);
+#endif /* LWCELL_CFG_USAGE */
         lwcell.msg->msg.conn_send.btw -= lwcell.msg->msg.conn_send.sent;
         lwcell.msg->msg.conn_send.ptr += lwcell.msg->msg.conn_send.sent;
         if (lwcell.msg->msg.conn_send.bw != NULL) {
             *lwcell.msg->msg.conn_send.bw += lwcell.msg->msg.conn_send.sent;
         }
         lwcell.msg->msg.conn_send.tries = 0;
+        if (CONN_SEND_READ_FAILED(lwcell.msg)) {
+            return 1; /* Stream cannot continue after padded chunk */
+        }
+#if LWCELL_CFG_CONN_SEND_FAIR
+        if (lwcell.msg->msg.conn_send.btw > 0 && lwcelli_conn_send_yield()) {
+            return 1; /* Rest of data is sent in next turn */
+        }
+#endif                                     /* LWCELL_CFG_CONN_SEND_FAIR */
     } else {                               /* We were not successful */
         ++lwcell.msg->msg.conn_send.tries; /* Increase number of tries */
+#if LWCELL_CFG_CONN_SEND_STREAM
+        lwcell.msg->msg.conn_send.read_failed = 0; /* Padded chunk was not accepted, read it again */
+#endif                                             /* LWCELL_CFG_CONN_SEND_STREAM */
         if (lwcell.msg->msg.conn_send.tries
             == LWCELL_CFG_MAX_SEND_RETRIES) { /* In case we reached max number of retransmissions */
             return 1;                         /* Return 1 and indicate error */
         }
+
+#if !LWCELL_CFG_CONN_SEND_ADAPT
+        /* Back off with smaller chunks for the rest of connection lifetime */
+        if (!lwcell.msg->msg.conn_send.dgram && lwcell.msg->msg.conn_send.sent > CONN_SEND_CHUNK_LEN_MIN) {
+            lwcell.msg->msg.conn_send.conn->max_send_len =
+                LWCELL_MAX(lwcell.msg->msg.conn_send.sent / 2, CONN_SEND_CHUNK_LEN_MIN);
+        }
+#endif /* !LWCELL_CFG_CONN_SEND_ADAPT */
     }
     if (lwcell.msg->msg.conn_send.btw > 0) {                 /* Do we still have data to send? */
+#if LWCELL_CFG_CONN_SEND_ADAPT
+        /* Next chunk waits with command parked, processing continues meanwhile */
+        if (lwcell.msg->msg.conn_send.conn->send_pace > 0
+            && lwcelli_cmd_park(lwcell.msg, lwcell.msg->msg.conn_send.conn->send_pace)) {
+            return 0;
+        }
+#endif /* LWCELL_CFG_CONN_SEND_ADAPT */
         if (lwcelli_tcpip_process_send_data() != lwcellOK) { /* Check if we can continue */
             return 1;                                        /* Finish at this point */
         }
@@ -620,6 +1552,223 @@ lwcelli_tcpip_process_data_sent(uint8_t sent) {
     return 1; /* Everything was sent, we can stop execution */
 }
 
+/**
+ * \brief           Process confirmation of data written after send prompt
+ * \param[in]       sent: Set to `1` when device confirmed data, `0` when send failed
+ * \param[in,out]   stat: Status flags
+ */
+static void
+lwcelli_tcpip_process_send_result(uint8_t sent, lwcell_status_flags_t* stat) {
+    lwcell.msg->msg.conn_send.wait_send_ok_err = 0;
+    if (sent) {
+        stat->is_ok = lwcelli_tcpip_process_data_sent(1); /* Process as data were sent */
+        if (CONN_SEND_STALE(lwcell.msg)) {
+            stat->is_ok = 0; /* Event was already sent, command finishes with error */
+            stat->is_error = 1;
+        } else if (CONN_SEND_READ_FAILED(lwcell.msg)) {
+            stat->is_ok = 0; /* Device received padded data, stream is broken */
+            stat->is_error = 1;
+            if (lwcell.msg->msg.conn_send.conn->status.f.active) {
+                CONN_SEND_DATA_SEND_EVT(lwcell.msg, lwcellERR);
+            }
+        } else if (stat->is_ok && !CONN_SEND_YIELDED(lwcell.msg) && lwcell.msg->msg.conn_send.conn->status.f.active) {
+            CONN_SEND_DATA_SEND_EVT(lwcell.msg, lwcellOK);
+        }
+    } else {
+        /* Data were not sent due to SEND FAIL or command didn't even start */
+        stat->is_error = lwcelli_tcpip_process_data_sent(0);
+        if (stat->is_error && !CONN_SEND_STALE(lwcell.msg) && lwcell.msg->msg.conn_send.conn->status.f.active) {
+            CONN_SEND_DATA_SEND_EVT(lwcell.msg, lwcellERR);
+        }
+    }
+}
+
+/**
+ * \brief           Send `AT+CIPSTART` command with connection number
+ * \param[in]       c: Connection handle
+ */
+static void
+lwcelli_conn_cip_send_open(lwcell_conn_p c) {
+    AT_PORT_SEND_CONST_STR("+CIPSTART=");
+    lwcelli_send_number(LWCELL_U32(c->num), 0, 0);
+}
+
+/**
+ * \brief           Send `AT+CIPCLOSE` command with connection number
+ * \param[in]       num: Connection number
+ */
+static void
+lwcelli_conn_cip_send_close(uint32_t num) {
+    AT_PORT_SEND_CONST_STR("+CIPCLOSE=");
+    lwcelli_send_number(num, 0, 0);
+}
+
+/**
+ * \brief           Send `AT+CIPSEND` command with connection number and length
+ * \param[in]       c: Connection handle
+ * \param[in]       len: Number of bytes to write
+ */
+static void
+lwcelli_conn_cip_send_data(lwcell_conn_p c, size_t len) {
+    AT_PORT_SEND_CONST_STR("+CIPSEND=");
+    lwcelli_send_number(LWCELL_U32(c->num), 0, 0); /* Send connection number */
+    lwcelli_send_number(LWCELL_U32(len), 0, 1);    /* Send length number */
+
+    /* On UDP connections, IP address and port may be selected */
+    if (c->type == LWCELL_CONN_TYPE_UDP) {
+        if (lwcell.msg->msg.conn_send.remote_ip != NULL && lwcell.msg->msg.conn_send.remote_port) {
+            lwcelli_send_ip_mac(lwcell.msg->msg.conn_send.remote_ip, 1, 1, 1); /* Send IP address including quotes */
+            lwcelli_send_port(lwcell.msg->msg.conn_send.remote_port, 0, 1);    /* Send length number */
+        }
+    }
+}
+
+#if LWCELL_CFG_CONN_MANUAL_RECV
+/**
+ * \brief           Send `AT+CIPRXGET` read command with connection number and length
+ * \param[in]       c: Connection handle
+ * \param[in]       len: Maximal number of bytes to read
+ */
+static void
+lwcelli_conn_cip_send_read(lwcell_conn_p c, size_t len) {
+    AT_PORT_SEND_CONST_STR("+CIPRXGET=2");
+    lwcelli_send_number(LWCELL_U32(c->num), 0, 1);
+    lwcelli_send_number(LWCELL_U32(len), 0, 1);
+}
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV */
+
+/**
+ * \brief           Process `SEND OK`, `SEND FAIL` and `DATA ACCEPT` confirmations of written data
+ * \param[in]       rcv: Received data
+ * \param[in,out]   stat: Status flags
+ */
+static void
+lwcelli_conn_cip_process_send_confirm(lwcell_recv_t* rcv, lwcell_status_flags_t* stat) {
+    if (LWCELL_CHARISNUM(rcv->data[0]) && rcv->data[1] == ',') {
+        if (!strncmp(&rcv->data[3], "SEND OK" CRLF, 7 + CRLF_LEN)) {
+            lwcelli_tcpip_process_send_result(1, stat);
+        } else if (!strncmp(&rcv->data[3], "SEND FAIL" CRLF, 9 + CRLF_LEN)) {
+            lwcelli_tcpip_process_send_result(0, stat);
+        }
+#if LWCELL_CFG_CONN_QUICK_SEND
+    } else if (!strncmp(rcv->data, "DATA ACCEPT:", 12)) {
+        const char* tmp = &rcv->data[12];
+        uint8_t num = LWCELL_U8(lwcelli_parse_number(&tmp));
+        size_t len = LWCELL_SZ(lwcelli_parse_number(&tmp));
+
+        /* Quick send mode confirms data as soon as they are in device buffer */
+        if (num == lwcell.msg->msg.conn_send.conn->num) {
+            /* Device may accept only part of the chunk, remaining data are sent with next command */
+            if (len < lwcell.msg->msg.conn_send.sent) {
+                lwcell.msg->msg.conn_send.sent = len;
+            }
+            lwcelli_tcpip_process_send_result(1, stat);
+        }
+#endif /* LWCELL_CFG_CONN_QUICK_SEND */
+    }
+}
+
+/**
+ * \brief           Connection driver with `AT+CIP*` command set
+ */
+static const lwcelli_conn_drv_t conn_drv_cip = {
+    .send_open = lwcelli_conn_cip_send_open,
+    .send_close = lwcelli_conn_cip_send_close,
+    .send_data = lwcelli_conn_cip_send_data,
+#if LWCELL_CFG_CONN_MANUAL_RECV
+    .send_read = lwcelli_conn_cip_send_read,
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV */
+    .process_send_confirm = lwcelli_conn_cip_process_send_confirm,
+    .read_inline = 0,
+};
+
+#if LWCELL_CFG_CONN_CA_SOCKET
+/**
+ * \brief           Send `AT+CAOPEN` command with connection number and PDP context
+ * \param[in]       c: Connection handle
+ */
+static void
+lwcelli_conn_ca_send_open(lwcell_conn_p c) {
+    AT_PORT_SEND_CONST_STR("+CAOPEN=");
+    lwcelli_send_number(LWCELL_U32(c->num), 0, 0);
+    lwcelli_send_number(0, 0, 1); /* PDP context activated with AT+CNACT */
+}
+
+/**
+ * \brief           Send `AT+CACLOSE` command with connection number
+ * \param[in]       num: Connection number
+ */
+static void
+lwcelli_conn_ca_send_close(uint32_t num) {
+    AT_PORT_SEND_CONST_STR("+CACLOSE=");
+    lwcelli_send_number(num, 0, 0);
+}
+
+/**
+ * \brief           Send `AT+CASEND` command with connection number and length
+ * \param[in]       c: Connection handle
+ * \param[in]       len: Number of bytes to write
+ */
+static void
+lwcelli_conn_ca_send_data(lwcell_conn_p c, size_t len) {
+    AT_PORT_SEND_CONST_STR("+CASEND=");
+    lwcelli_send_number(LWCELL_U32(c->num), 0, 0);
+    lwcelli_send_number(LWCELL_U32(len), 0, 1);
+}
+
+/**
+ * \brief           Send `AT+CARECV` read command with connection number and length
+ * \param[in]       c: Connection handle
+ * \param[in]       len: Maximal number of bytes to read
+ */
+static void
+lwcelli_conn_ca_send_read(lwcell_conn_p c, size_t len) {
+    AT_PORT_SEND_CONST_STR("+CARECV=");
+    lwcelli_send_number(LWCELL_U32(c->num), 0, 0);
+    lwcelli_send_number(LWCELL_U32(len), 0, 1);
+}
+
+/**
+ * \brief           Process plain `OK` or `ERROR` confirmation of written data
+ * \param[in]       rcv: Received data
+ * \param[in,out]   stat: Status flags
+ */
+static void
+lwcelli_conn_ca_process_send_confirm(lwcell_recv_t* rcv, lwcell_status_flags_t* stat) {
+    if (!strcmp(rcv->data, "OK" CRLF)) {
+        lwcelli_tcpip_process_send_result(1, stat);
+    } else if (stat->is_error) {
+        lwcelli_tcpip_process_send_result(0, stat);
+    }
+}
+
+/**
+ * \brief           Connection driver with `AT+CA*` socket command set
+ */
+static const lwcelli_conn_drv_t conn_drv_ca = {
+    .send_open = lwcelli_conn_ca_send_open,
+    .send_close = lwcelli_conn_ca_send_close,
+    .send_data = lwcelli_conn_ca_send_data,
+    .send_read = lwcelli_conn_ca_send_read,
+    .process_send_confirm = lwcelli_conn_ca_process_send_confirm,
+    .read_inline = 1,
+};
+#endif /* LWCELL_CFG_CONN_CA_SOCKET */
+
+/**
+ * \brief           Bind connection driver to identified device model
+ */
+static void
+lwcelli_conn_drv_bind(void) {
+#if LWCELL_CFG_CONN_CA_SOCKET
+    if (LWCELL_DEV_MODEL_CAP(has_ca_socket)) {
+        lwcell.conn_drv = &conn_drv_ca;
+        return;
+    }
+#endif /* LWCELL_CFG_CONN_CA_SOCKET */
+    lwcell.conn_drv = &conn_drv_cip;
+}
+
 /**
  * \brief           Process CIPSEND response
  * \param[in]       rcv: Received data
@@ -628,26 +1777,14 @@ lwcelli_tcpip_process_data_sent(uint8_t sent) {
 void
 lwcelli_process_cipsend_response(lwcell_recv_t* rcv, lwcell_status_flags_t* stat) {
     if (lwcell.msg->msg.conn_send.wait_send_ok_err) {
-        if (LWCELL_CHARISNUM(rcv->data[0]) && rcv->data[1] == ',') {
-            uint8_t num = LWCELL_CHARTONUM(rcv->data[0]);
-            if (!strncmp(&rcv->data[3], "SEND OK" CRLF, 7 + CRLF_LEN)) {
-                lwcell.msg->msg.conn_send.wait_send_ok_err = 0;
-                stat->is_ok = lwcelli_tcpip_process_data_sent(1); /* Process as data were sent */
-                if (stat->is_ok && lwcell.msg->msg.conn_send.conn->status.f.active) {
-                    CONN_SEND_DATA_SEND_EVT(lwcell.msg, lwcellOK);
-                }
-            } else if (!strncmp(&rcv->data[3], "SEND FAIL" CRLF, 9 + CRLF_LEN)) {
-                lwcell.msg->msg.conn_send.wait_send_ok_err = 0;
-                /* Data were not sent due to SEND FAIL or command didn't even start */
-                stat->is_error = lwcelli_tcpip_process_data_sent(0);
-                if (stat->is_error && lwcell.msg->msg.conn_send.conn->status.f.active) {
-                    CONN_SEND_DATA_SEND_EVT(lwcell.msg, lwcellERR);
-                }
-            }
-            LWCELL_UNUSED(num);
-        }
+        CONN_DRV()->process_send_confirm(rcv, stat);
         /* Check for an error or if connection closed in the meantime */
     } else if (stat->is_error) {
+        /* Device may reject send command due to chunk length, retry with smaller chunk */
+        if (!strcmp(rcv->data, "ERROR" CRLF) && !lwcelli_tcpip_process_data_sent(0)) {
+            stat->is_error = 0;
+            return;
+        }
         CONN_SEND_DATA_SEND_EVT(lwcell.msg, lwcellERR);
     }
 }
@@ -659,6 +1796,11 @@ lwcelli_process_cipsend_response(lwcell_recv_t* rcv, lwcell_status_flags_t* stat
  */
 static void
 lwcelli_send_conn_error_cb(lwcell_msg_t* msg, lwcellr_t error) {
+#if LWCELL_CFG_NETWORK_PDP_RECOVERY
+    if (lwcell.msg->msg.conn_start.restart != NULL) {
+        return; /* Failed restore is reported as connection close */
+    }
+#endif /* LWCELL_CFG_NETWORK_PDP_RECOVERY */
     lwcell.evt.type = LWCELL_EVT_CONN_ERROR; /* Connection error */
     lwcell.evt.evt.conn_error.host = lwcell.msg->msg.conn_start.host;
     lwcell.evt.evt.conn_error.port = lwcell.msg->msg.conn_start.port;
@@ -667,7 +1809,9 @@ lwcelli_send_conn_error_cb(lwcell_msg_t* msg, lwcellr_t error) {
     lwcell.evt.evt.conn_error.err = error;
 
     /* Call callback specified by user on connection startup */
-    lwcell.msg->msg.conn_start.evt_func(&lwcell.evt);
+    if (!LWCELL_EVT_DEFER(lwcell.msg->msg.conn_start.evt_func)) {
+        lwcell.msg->msg.conn_start.evt_func(&lwcell.evt);
+    }
     LWCELL_UNUSED(msg);
 }
 
@@ -696,15 +1840,38 @@ lwcelli_is_valid_conn_ptr(lwcell_conn_p conn) {
 uint8_t
 lwcelli_conn_closed_process(uint8_t conn_num, uint8_t forced) {
     lwcell_conn_t* conn = &lwcell.m.conns[conn_num];
-
+#if !LWCELL_CFG_CONN_WRITE_RING
+    uint8_t* buff;
+#endif /* !LWCELL_CFG_CONN_WRITE_RING */
+
+#if LWCELL_CFG_NETWORK_PDP_RECOVERY
+    if (conn->status.f.pdp_hold) {
+        conn->state = LWCELL_CONN_STATE_CLOSED;
+        return 1; /* Connection is started again once PDP context is active */
+    }
+#endif /* LWCELL_CFG_NETWORK_PDP_RECOVERY */
     conn->status.f.active = 0;
+    conn->state = LWCELL_CONN_STATE_CLOSED; /* URC already reported it, no change event on next status */
 
+#if LWCELL_CFG_CONN_WRITE_RING
+    /* Queued send commands may still use ring memory, last finished one releases it */
+    LWCELL_CONN_LOCK(conn);
+    if (conn->tx_ring_queued == 0) {
+        lwcell_buff_free(&conn->tx_ring);
+    }
+    LWCELL_CONN_UNLOCK(conn);
+#else  /* LWCELL_CFG_CONN_WRITE_RING */
     /* Check if write buffer is set */
-    if (conn->buff.buff != NULL) {
+    LWCELL_CONN_LOCK(conn);
+    buff = conn->buff.buff;
+    conn->buff.buff = NULL;
+    LWCELL_CONN_UNLOCK(conn);
+    if (buff != NULL) {
         LWCELL_DEBUGF(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE, "[LWCELL CONN] Free write buffer: %p\r\n",
-                      conn->buff.buff);
-        lwcell_mem_free_s((void**)&conn->buff.buff);
+                      (void*)buff);
+        lwcell_mem_free_s((void**)&buff);
     }
+#endif /* !LWCELL_CFG_CONN_WRITE_RING */
 
     /* Send event */
     lwcell.evt.type = LWCELL_EVT_CONN_CLOSE;
@@ -717,105 +1884,985 @@ lwcelli_conn_closed_process(uint8_t conn_num, uint8_t forced) {
     return 1;
 }
 
-#endif /* LWCELL_CFG_CONN || __DOXYGEN__ */
-
 /**
- * \brief           Process received string from GSM
- * \param[in]       rcv: Pointer to \ref lwcell_recv_t structure with input string
+ * \brief           Client connection of current start command is open, reset and set its handle
+ * \param[in]       conn_num: Connection number
  */
 static void
-lwcelli_parse_received(lwcell_recv_t* rcv) {
-    lwcell_status_flags_t stat = {0};
+lwcelli_conn_client_opened(uint8_t conn_num) {
+    lwcell_conn_t* conn = &lwcell.m.conns[conn_num];
+    uint8_t id;
 
-    /* Try to remove non-parsable strings */
-    if (rcv->len == 2 && rcv->data[0] == '\r' && rcv->data[1] == '\n') {
+#if LWCELL_CFG_NETWORK_PDP_RECOVERY
+    if (lwcell.msg->msg.conn_start.restart == conn) {
+        /* Restored connection keeps handle, validation ID and data waiting for send */
+        lwcell.msg->msg.conn_start.conn_res = LWCELL_CONN_CONNECT_OK;
         return;
     }
+#endif /* LWCELL_CFG_NETWORK_PDP_RECOVERY */
+    id = conn->val_id;
+#if LWCELL_CFG_CONN_WRITE_RING
+    lwcell_buff_free(&conn->tx_ring); /* Release ring of previous connection, if still allocated */
+#endif                                /* LWCELL_CFG_CONN_WRITE_RING */
+    LWCELL_MEMSET(conn, 0x00, sizeof(*conn)); /* Reset connection parameters */
+    conn->num = conn_num;
+    conn->status.f.active = 1;
+    conn->val_id = ++id; /* Set new validation ID */
+#if LWCELL_CFG_CONN_WRITE_RING
+    /* Ring keeps one byte unused, write returns error when allocation fails */
+    lwcell_buff_init(&conn->tx_ring, LWCELL_CFG_CONN_WRITE_RING_LEN + 1);
+#endif /* LWCELL_CFG_CONN_WRITE_RING */
+#if LWCELL_CFG_CONN_MANUAL_RECV
+    conn->rx_credit = LWCELL_CFG_CONN_RECV_WINDOW; /* Full receive window is available */
+#endif                                             /* LWCELL_CFG_CONN_MANUAL_RECV */
+
+    /* Set connection parameters */
+    conn->status.f.client = 1;
+    conn->evt_func = lwcell.msg->msg.conn_start.evt_func;
+    conn->arg = lwcell.msg->msg.conn_start.arg;
+#if LWCELL_CFG_NETWORK_PDP_RECOVERY
+    conn->start_type = lwcell.msg->msg.conn_start.type;
+#endif /* LWCELL_CFG_NETWORK_PDP_RECOVERY */
+
+    /* Set status */
+    lwcell.msg->msg.conn_start.conn_res = LWCELL_CONN_CONNECT_OK;
+}
 
-    /* Check OK response */
-    stat.is_ok = rcv->len == (2 + CRLF_LEN) && !strcmp(rcv->data, "OK" CRLF); /* Check if received string is OK */
-    if (!stat.is_ok) {                                                        /* Check for SHUT OK string */
-        stat.is_ok = rcv->len == (7 + CRLF_LEN) && !strcmp(rcv->data, "SEND OK" CRLF);
+/**
+ * \brief           Send connection active event for connection started by application
+ * \param[in]       conn: Connection handle
+ */
+static void
+lwcelli_send_conn_active_cb(lwcell_conn_t* conn) {
+#if LWCELL_CFG_NETWORK_PDP_RECOVERY
+    if (lwcell.msg->msg.conn_start.restart != NULL) {
+        return; /* Connection has never been reported closed to application */
     }
+#endif /* LWCELL_CFG_NETWORK_PDP_RECOVERY */
+    lwcell.evt.type = LWCELL_EVT_CONN_ACTIVE; /* Connection just active */
+    lwcell.evt.evt.conn_active_close.client = 1;
+    lwcell.evt.evt.conn_active_close.conn = conn;
+    lwcell.evt.evt.conn_active_close.forced = 1;
+    lwcelli_conn_start_timeout(conn); /* Start poll events, callback may change interval */
+    lwcelli_send_conn_cb(conn, NULL);
+}
 
-    /* Check error response */
-    if (!stat.is_ok) { /* If still not ok, check if error? */
-        stat.is_error =
-            rcv->data[0] == '+' && !strncmp(rcv->data, "+CME ERROR", 10); /* First check +CME coded errors */
-        if (!stat.is_error) {                                             /* Check basic error aswell */
-            stat.is_error =
-                rcv->data[0] == '+' && !strncmp(rcv->data, "+CMS ERROR", 10); /* First check +CME coded errors */
-            if (!stat.is_error) {
-                stat.is_error = !strcmp(rcv->data, "ERROR" CRLF) || !strcmp(rcv->data, "FAIL" CRLF);
-            }
-        }
-    }
+#if LWCELL_CFG_CONN_SERVER || __DOXYGEN__
+
+/**
+ * \brief           Incoming server connection detected, process with callback to user
+ * \param[in]       str: Received string in `<n>, REMOTE IP: <ip>` format
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_conn_server_accept(const char* str) {
+    lwcell_conn_t* conn;
+    uint8_t num, id;
+
+    num = LWCELL_CHARTONUM(str[0]);
+    if (num >= LWCELL_CFG_MAX_CONNS || lwcell.m.evt_server == NULL) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING,
+                      "[LWCELL CONN] Ignoring incoming connection %d, server is not active\r\n", (int)num);
+        return 0;
+    }
+    conn = &lwcell.m.conns[num];
+
+    id = conn->val_id;
+#if LWCELL_CFG_CONN_WRITE_RING
+    lwcell_buff_free(&conn->tx_ring); /* Release ring of previous connection, if still allocated */
+#endif                                /* LWCELL_CFG_CONN_WRITE_RING */
+    LWCELL_MEMSET(conn, 0x00, sizeof(*conn)); /* Reset connection parameters */
+    conn->num = num;
+    conn->status.f.active = 1;
+    conn->val_id = ++id; /* Set new validation ID */
+#if LWCELL_CFG_CONN_WRITE_RING
+    /* Ring keeps one byte unused, write returns error when allocation fails */
+    lwcell_buff_init(&conn->tx_ring, LWCELL_CFG_CONN_WRITE_RING_LEN + 1);
+#endif /* LWCELL_CFG_CONN_WRITE_RING */
+#if LWCELL_CFG_CONN_MANUAL_RECV
+    conn->rx_credit = LWCELL_CFG_CONN_RECV_WINDOW; /* Full receive window is available */
+#endif                                             /* LWCELL_CFG_CONN_MANUAL_RECV */
+
+    /* Set connection parameters */
+    conn->type = LWCELL_CONN_TYPE_TCP;
+    conn->local_port = lwcell.m.server_port;
+    conn->evt_func = lwcell.m.evt_server;
+    str += 14; /* Skip "<n>, REMOTE IP: " part */
+    lwcelli_parse_ip(&str, &conn->remote_ip);
+
+    /* Send event */
+    lwcell.evt.type = LWCELL_EVT_CONN_ACTIVE;
+    lwcell.evt.evt.conn_active_close.conn = conn;
+    lwcell.evt.evt.conn_active_close.client = 0;
+    lwcell.evt.evt.conn_active_close.forced = 0;
+    lwcell.evt.evt.conn_active_close.res = lwcellOK;
+    lwcelli_conn_start_timeout(conn); /* Start poll events, callback may change interval */
+    lwcelli_send_conn_cb(conn, NULL);
+
+    return 1;
+}
+
+#endif /* LWCELL_CFG_CONN_SERVER || __DOXYGEN__ */
+
+#endif /* LWCELL_CFG_CONN || __DOXYGEN__ */
+
+#if LWCELL_CFG_MQTT || __DOXYGEN__
+
+/**
+ * \brief           Process native MQTT callback
+ * \note            Before calling function, callback structure must be prepared
+ * \param[in]       type: Callback event type
+ * \return          Member of \ref lwcellr_t enumeration
+ */
+lwcellr_t
+lwcelli_send_mqtt_cb(lwcell_evt_type_t type) {
+    if (lwcell.m.mqtt.evt_fn == NULL) {
+        return lwcelli_send_cb(type); /* No instance callback, use global event functions */
+    }
+    lwcell.evt.type = type;
+    LWCELL_STATS_ADD(evt[type], 1);
+    return lwcell.m.mqtt.evt_fn(&lwcell.evt);
+}
+
+/**
+ * \brief           Finish native MQTT connect procedure and notify application
+ * \param[in]       res: Connect result
+ */
+static void
+lwcelli_mqtt_connect_done(lwcellr_t res) {
+    lwcell.m.mqtt.is_connected = res == lwcellOK;
+    lwcell.m.mqtt.in_use = res == lwcellOK; /* Instance is free again on failure */
+
+    lwcell.evt.evt.mqtt_connect.mqtt = &lwcell.m.mqtt;
+    lwcell.evt.evt.mqtt_connect.res = res;
+    lwcelli_send_mqtt_cb(LWCELL_EVT_MQTT_CONNECT);
+}
+
+/**
+ * \brief           Mark native MQTT instance as disconnected and notify application
+ * \param[in]       forced: Set to `1` if disconnect was requested by application
+ */
+static void
+lwcelli_mqtt_disconnected(uint8_t forced) {
+    uint8_t was_connected = lwcell.m.mqtt.is_connected;
+
+    lwcell.m.mqtt.is_connected = 0;
+    lwcell.m.mqtt.in_use = 0;
+    if (was_connected) {
+        lwcell.evt.evt.mqtt_disconnect.mqtt = &lwcell.m.mqtt;
+        lwcell.evt.evt.mqtt_disconnect.forced = forced;
+        lwcelli_send_mqtt_cb(LWCELL_EVT_MQTT_DISCONNECT);
+    }
+}
+
+#endif /* LWCELL_CFG_MQTT || __DOXYGEN__ */
+
+/**
+ * \brief           Build lookup key from first `4` characters after `+` sign
+ *
+ * Characters are packed in big-endian order, so that numerical order of keys
+ * matches alphabetical order of the prefixes
+ */
+#define URC_KEY(a, b, c, d)                                                                                            \
+    ((uint32_t)(((uint32_t)(uint8_t)(a) << 24) | ((uint32_t)(uint8_t)(b) << 16) | ((uint32_t)(uint8_t)(c) << 8)          \
+                | ((uint32_t)(uint8_t)(d))))
+
+/**
+ * \brief           Handler for received line starting with `+` sign
+ * \param[in]       str: Received line, starting with `+` sign
+ */
+typedef void (*lwcell_urc_fn)(const char* str);
+
+/**
+ * \brief           Single entry in the table of `+` prefixed responses
+ */
+typedef struct {
+    uint32_t key;     /*!< Key of the prefix, built with \ref URC_KEY */
+    lwcell_urc_fn fn; /*!< Function to handle the line */
+} lwcell_urc_entry_t;
+
+static void
+urc_csq(const char* str) {
+    lwcelli_parse_csq(str); /* Parse +CSQ response */
+}
 
-    /* Scan received strings which start with '+' */
-    if (rcv->data[0] == '+') {
-        if (!strncmp(rcv->data, "+CSQ", 4)) {
-            lwcelli_parse_csq(rcv->data); /* Parse +CSQ response */
 #if LWCELL_CFG_NETWORK
-        } else if (!strncmp(rcv->data, "+PDP: DEACT", 11)) {
-            /* PDP has been deactivated */
-            lwcell_network_check_status(NULL, NULL, 0); /* Update status */
-#endif                                                  /* LWCELL_CFG_NETWORK */
+static void
+urc_pdp(const char* str) {
+    if (!strncmp(str, "+PDP: DEACT", 11)) {
+        /* PDP has been deactivated */
+#if LWCELL_CFG_NETWORK_PDP_RECOVERY
+        lwcelli_network_pdp_deact(); /* Activate context again and restore connections */
+#else                                /* LWCELL_CFG_NETWORK_PDP_RECOVERY */
+        lwcell_network_check_status(NULL, NULL, 0); /* Update status */
+#endif                               /* !LWCELL_CFG_NETWORK_PDP_RECOVERY */
+    }
+}
+#endif /* LWCELL_CFG_NETWORK */
+
 #if LWCELL_CFG_CONN
-        } else if (!strncmp(rcv->data, "+RECEIVE", 8)) {
-            lwcelli_parse_ipd(rcv->data);                                              /* Parse IPD */
-#endif                                                                                 /* LWCELL_CFG_CONN */
-        } else if (!strncmp(rcv->data, "+CREG", 5)) {                                  /* Check for +CREG indication */
-            lwcelli_parse_creg(rcv->data, LWCELL_U8(CMD_IS_CUR(LWCELL_CMD_CREG_GET))); /* Parse +CREG response */
-        } else if (!strncmp(rcv->data, "+CPIN", 5)) { /* Check for +CPIN indication for SIM */
-            lwcelli_parse_cpin(rcv->data, 1 /* !CMD_IS_DEF(LWCELL_CMD_CPIN_SET) */); /* Parse +CPIN response */
-        } else if (CMD_IS_CUR(LWCELL_CMD_COPS_GET) && !strncmp(rcv->data, "+COPS", 5)) {
-            lwcelli_parse_cops(rcv->data); /* Parse current +COPS */
-#if LWCELL_CFG_SMS
-        } else if (CMD_IS_CUR(LWCELL_CMD_CMGS) && !strncmp(rcv->data, "+CMGS", 5)) {
-            lwcelli_parse_cmgs(rcv->data, &lwcell.msg->msg.sms_send.pos); /* Parse +CMGS response */
-        } else if (CMD_IS_CUR(LWCELL_CMD_CMGR) && !strncmp(rcv->data, "+CMGR", 5)) {
-            if (lwcelli_parse_cmgr(rcv->data)) {   /* Parse +CMGR response */
-                lwcell.msg->msg.sms_read.read = 2; /* Set read flag and process the data */
+static void
+urc_receive(const char* str) {
+    if (!strncmp(str, "+RECEIVE", 8)) {
+        lwcelli_parse_ipd(str); /* Parse IPD */
+    }
+}
+
+#if LWCELL_CFG_CONN_MANUAL_RECV
+static void
+urc_ciprxget(const char* str) {
+    lwcelli_parse_ciprxget(str); /* Parse data notification or read header */
+}
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV */
+
+static void
+urc_cipsend(const char* str) {
+    if (CMD_IS_CUR(LWCELL_CMD_CIPSEND_GET) && !strncmp(str, "+CIPSEND: ", 10)) {
+        const char* tmp = &str[10];
+        uint8_t num = LWCELL_U8(lwcelli_parse_number(&tmp));
+        size_t len = LWCELL_SZ(lwcelli_parse_number(&tmp));
+
+        /* Update only connection being started, others may have reduced length already */
+        if (num == lwcell.msg->msg.conn_start.num && len > 0) {
+            lwcell.m.conns[num].max_send_len = len;
+        }
+    }
+}
+
+#if LWCELL_CFG_CONN_CA_SOCKET
+static void
+urc_app_pdp(const char* str) {
+    if (!strncmp(str, "+APP PDP: 0,DEACTIVE", 20)) {
+        lwcell.m.ca_pdp_active = 0; /* Context is activated again on next connection start */
+    }
+}
+
+static void
+urc_ca(const char* str) {
+    const char* tmp;
+    uint8_t num;
+
+    if (!strncmp(str, "+CAOPEN: ", 9)) {
+        tmp = &str[9];
+        num = LWCELL_U8(lwcelli_parse_number(&tmp));
+        if (CMD_IS_CUR(LWCELL_CMD_CIPSTART) && num == lwcell.msg->msg.conn_start.num) {
+            if (lwcelli_parse_number(&tmp) == 0) { /* Result code `0` means socket is open */
+                lwcelli_conn_client_opened(num);
+                lwcell.m.conns[num].type = lwcell.msg->msg.conn_start.type;
+                lwcell.m.conns[num].remote_port = lwcell.msg->msg.conn_start.port;
+                lwcell.m.ca_pdp_active = 1;
             } else {
-                lwcell.msg->msg.sms_read.read = 1; /* Read but ignore data */
+                lwcell.msg->msg.conn_start.conn_res = LWCELL_CONN_CONNECT_ERROR;
             }
-        } else if (CMD_IS_CUR(LWCELL_CMD_CMGL) && !strncmp(rcv->data, "+CMGL", 5)) {
-            if (lwcelli_parse_cmgl(rcv->data)) {   /* Parse +CMGL response */
-                lwcell.msg->msg.sms_list.read = 2; /* Set read flag and process the data */
-            } else {
-                lwcell.msg->msg.sms_list.read = 1; /* Read but ignore data */
-            }
-        } else if (!strncmp(rcv->data, "+CMTI", 5)) {
-            lwcelli_parse_cmti(rcv->data, 1); /* Parse +CMTI response with received SMS */
-        } else if (CMD_IS_CUR(LWCELL_CMD_CPMS_GET_OPT) && !strncmp(rcv->data, "+CPMS", 5)) {
-            lwcelli_parse_cpms(rcv->data, 0); /* Parse +CPMS with SMS memories info */
-        } else if (CMD_IS_CUR(LWCELL_CMD_CPMS_GET) && !strncmp(rcv->data, "+CPMS", 5)) {
-            lwcelli_parse_cpms(rcv->data, 1); /* Parse +CPMS with SMS memories info */
-        } else if (CMD_IS_CUR(LWCELL_CMD_CPMS_SET) && !strncmp(rcv->data, "+CPMS", 5)) {
-            lwcelli_parse_cpms(rcv->data, 2); /* Parse +CPMS with SMS memories info */
-#endif                                        /* LWCELL_CFG_SMS */
+        }
+    } else if (!strncmp(str, "+CADATAIND: ", 12)) {
+        tmp = &str[12];
+        num = LWCELL_U8(lwcelli_parse_number(&tmp));
+        if (num < LWCELL_CFG_MAX_CONNS) {
+            lwcell.m.conns[num].status.f.rx_pending = 1;
+            lwcelli_conn_manual_recv_read(&lwcell.m.conns[num]); /* Start reading if application can accept data */
+        }
+    } else if (!strncmp(str, "+CARECV: ", 9)) {
+        lwcelli_parse_carecv(str); /* Header without data, socket buffer is empty */
+    } else if (!strncmp(str, "+CASTATE: ", 10)) {
+        tmp = &str[10];
+        num = LWCELL_U8(lwcelli_parse_number(&tmp));
+        if (num < LWCELL_CFG_MAX_CONNS && lwcelli_parse_number(&tmp) == 0 && lwcell.m.conns[num].status.f.active) {
+            lwcelli_conn_closed_process(num, CMD_IS_CUR(LWCELL_CMD_CIPCLOSE)
+                                                 && lwcell.msg->msg.conn_close.conn == &lwcell.m.conns[num]);
+        }
+    }
+}
+#endif /* LWCELL_CFG_CONN_CA_SOCKET */
+#endif /* LWCELL_CFG_CONN */
+
+#if LWCELL_CFG_PING
+static void
+urc_cipping(const char* str) {
+    lwcelli_parse_cipping(str); /* Parse single probe result */
+}
+#endif /* LWCELL_CFG_PING */
+
+#if LWCELL_CFG_DNS
+static void
+urc_cdnsgip(const char* str) {
+    lwcelli_parse_cdnsgip(str); /* Parse resolve result */
+}
+#endif /* LWCELL_CFG_DNS */
+
+#if LWCELL_CFG_GNSS
+static void
+urc_cgnsinf(const char* str) {
+    if (CMD_IS_CUR(LWCELL_CMD_CGNSINF) && !strncmp(str, "+CGNSINF:", 9)) {
+        lwcelli_parse_gnsinf(str, &lwcell.m.gnss); /* Parse navigation info read on request */
+        if (lwcell.msg->msg.gnss.fix != NULL) {
+            *lwcell.msg->msg.gnss.fix = lwcell.m.gnss;
+        }
+    }
+}
+
+static void
+urc_ugnsinf(const char* str) {
+    if (!strncmp(str, "+UGNSINF:", 9)) {
+        lwcelli_parse_gnsinf(str, &lwcell.m.gnss); /* Parse periodic navigation info report */
+        lwcell.evt.evt.gnss_fix.fix = &lwcell.m.gnss;
+        lwcelli_send_cb(LWCELL_EVT_GNSS_FIX);
+    }
+}
+#endif /* LWCELL_CFG_GNSS */
+
+#if LWCELL_CFG_CELL_INFO
+static void
+urc_ceng(const char* str) {
+    lwcelli_parse_ceng(str, &lwcell.m.cell_info); /* Parse report line to cell table */
+}
+#endif /* LWCELL_CFG_CELL_INFO */
+
+#if LWCELL_CFG_TIME
+static void
+urc_cclk(const char* str) {
+    lwcelli_parse_cclk(str); /* Parse device clock, local time */
+}
+
+static void
+urc_ctzv(const char* str) {
+    lwcelli_parse_ctzv(str); /* Parse network time zone report */
+}
+
+static void
+urc_cipgsmloc(const char* str) {
+    if (lwcelli_parse_cipgsmloc(str) && CMD_IS_CUR(LWCELL_CMD_CIPGSMLOC)) {
+        lwcell.msg->msg.time_loc.found = 1;
+    }
+}
+#endif /* LWCELL_CFG_TIME */
+
+static void
+urc_creg(const char* str) {
+    /* Query response has additional mode parameter, unlike unsolicited report */
+    lwcelli_parse_creg(str, LWCELL_U8(CMD_IS_CUR(LWCELL_CMD_CREG_GET) || CMD_IS_CUR(LWCELL_CMD_QUERY_BATCH)));
+}
+
+#if LWCELL_CFG_NETWORK_PS_REG
+static void
+urc_ps_reg(const char* str) {
+    /* Status is read together with enabling reports, query response has additional mode parameter */
+    lwcelli_parse_ps_reg(str, LWCELL_U8(CMD_IS_CUR(LWCELL_CMD_CGREG_SET) || CMD_IS_CUR(LWCELL_CMD_CEREG_SET)));
+}
+#endif /* LWCELL_CFG_NETWORK_PS_REG */
+
+static void
+urc_cpin(const char* str) {
+    lwcelli_parse_cpin(str, 1 /* !CMD_IS_DEF(LWCELL_CMD_CPIN_SET) */); /* Parse +CPIN response */
+    if (lwcell.m.sim.state == LWCELL_SIM_STATE_READY && CMD_IS_DEF(LWCELL_CMD_CPIN_SET)
+        && CMD_IS_CUR(LWCELL_CMD_CPIN_GET)) {
+        lwcelli_cmd_unpark(lwcell.msg); /* SIM reported ready, confirm now instead of waiting for next poll */
+    }
+}
+
+static void
+urc_cops(const char* str) {
+    if (CMD_IS_CUR(LWCELL_CMD_COPS_GET) || CMD_IS_CUR(LWCELL_CMD_QUERY_BATCH)) {
+        lwcelli_parse_cops(str); /* Parse current +COPS */
+    }
+}
+
+#if LWCELL_CFG_NETWORK_BAND
+static void
+urc_cpsi(const char* str) {
+    if (CMD_IS_CUR(LWCELL_CMD_CPSI_GET)) {
+        lwcelli_parse_cpsi(str); /* Parse serving cell system information */
+    }
+}
+#endif /* LWCELL_CFG_NETWORK_BAND */
+
+#if LWCELL_CFG_SMS
+static void
+urc_cmgs(const char* str) {
+    if (CMD_IS_CUR(LWCELL_CMD_CMGS)) {
+        lwcelli_parse_cmgs(str, &lwcell.msg->msg.sms_send.pos); /* Parse +CMGS response */
+    }
+}
+
+static void
+urc_cmgr(const char* str) {
+    if (CMD_IS_CUR(LWCELL_CMD_CMGR)) {
+        if (lwcelli_parse_cmgr(str)) {         /* Parse +CMGR response */
+            lwcell.msg->msg.sms_read.read = 2; /* Set read flag and process the data */
+        } else {
+            lwcell.msg->msg.sms_read.read = 1; /* Read but ignore data */
+        }
+    }
+}
+
+static void
+urc_cmgl(const char* str) {
+    if (CMD_IS_CUR(LWCELL_CMD_CMGL)) {
+        if (lwcelli_parse_cmgl(str)) {         /* Parse +CMGL response */
+            lwcell.msg->msg.sms_list.read = 2; /* Set read flag and process the data */
+        } else {
+            lwcell.msg->msg.sms_list.read = 1; /* Read but ignore data */
+        }
+    }
+}
+
+static void
+urc_cmti(const char* str) {
+    lwcelli_parse_cmti(str, 1); /* Parse +CMTI response with received SMS */
+#if LWCELL_CFG_SMS_INBOX
+    lwcelli_sms_inbox_notify(lwcell.evt.evt.sms_recv.mem); /* Schedule inbox drain */
+#endif                                                     /* LWCELL_CFG_SMS_INBOX */
+}
+
+#if LWCELL_CFG_SMS_DIRECT
+static void
+urc_cmt(const char* str) {
+    if (lwcelli_parse_cmt(str)) {     /* Parse +CMT header of directly delivered SMS */
+        lwcell.m.sms.direct_read = 1; /* Text follows in next line */
+    }
+}
+#endif /* LWCELL_CFG_SMS_DIRECT */
+
+static void
+urc_cpms(const char* str) {
+    if (CMD_IS_CUR(LWCELL_CMD_CPMS_GET_OPT)) {
+        lwcelli_parse_cpms(str, 0); /* Parse +CPMS with SMS memories info */
+    } else if (CMD_IS_CUR(LWCELL_CMD_CPMS_GET)) {
+        lwcelli_parse_cpms(str, 1);
+    } else if (CMD_IS_CUR(LWCELL_CMD_CPMS_SET)) {
+        lwcelli_parse_cpms(str, 2);
+    }
+}
+#endif /* LWCELL_CFG_SMS */
+
 #if LWCELL_CFG_CALL
-        } else if (!strncmp(rcv->data, "+CLCC", 5)) {
-            lwcelli_parse_clcc(rcv->data, 1); /* Parse +CLCC response with call info change */
-#endif                                        /* LWCELL_CFG_CALL */
+static void
+urc_clcc(const char* str) {
+    lwcelli_parse_clcc(str, 1); /* Parse +CLCC response with call info change */
+}
+#endif /* LWCELL_CFG_CALL */
+
 #if LWCELL_CFG_PHONEBOOK
-        } else if (CMD_IS_CUR(LWCELL_CMD_CPBS_GET_OPT) && !strncmp(rcv->data, "+CPBS", 5)) {
-            lwcelli_parse_cpbs(rcv->data, 0); /* Parse +CPBS response */
-        } else if (CMD_IS_CUR(LWCELL_CMD_CPBS_GET) && !strncmp(rcv->data, "+CPBS", 5)) {
-            lwcelli_parse_cpbs(rcv->data, 1); /* Parse +CPBS response */
-        } else if (CMD_IS_CUR(LWCELL_CMD_CPBS_SET) && !strncmp(rcv->data, "+CPBS", 5)) {
-            lwcelli_parse_cpbs(rcv->data, 2); /* Parse +CPBS response */
-        } else if (CMD_IS_CUR(LWCELL_CMD_CPBR) && !strncmp(rcv->data, "+CPBR", 5)) {
-            lwcelli_parse_cpbr(rcv->data); /* Parse +CPBR statement */
-        } else if (CMD_IS_CUR(LWCELL_CMD_CPBF) && !strncmp(rcv->data, "+CPBF", 5)) {
-            lwcelli_parse_cpbf(rcv->data); /* Parse +CPBR statement */
-#endif                                     /* LWCELL_CFG_PHONEBOOK */
+static void
+urc_cpbs(const char* str) {
+    if (CMD_IS_CUR(LWCELL_CMD_CPBS_GET_OPT)) {
+        lwcelli_parse_cpbs(str, 0); /* Parse +CPBS response */
+    } else if (CMD_IS_CUR(LWCELL_CMD_CPBS_GET)) {
+        lwcelli_parse_cpbs(str, 1);
+    } else if (CMD_IS_CUR(LWCELL_CMD_CPBS_SET)) {
+        lwcelli_parse_cpbs(str, 2);
+    }
+}
+
+static void
+urc_cpbr(const char* str) {
+    if (CMD_IS_CUR(LWCELL_CMD_CPBR)) {
+        lwcelli_parse_cpbr(str); /* Parse +CPBR statement */
+    }
+}
+
+static void
+urc_cpbf(const char* str) {
+    if (CMD_IS_CUR(LWCELL_CMD_CPBF)) {
+        lwcelli_parse_cpbf(str); /* Parse +CPBF statement */
+    }
+}
+#endif /* LWCELL_CFG_PHONEBOOK */
+
+#if LWCELL_CFG_MQTT
+static void
+urc_smstate(const char* str) {
+    lwcelli_parse_smstate(str); /* Parse MQTT connection state */
+}
+
+static void
+urc_smsub(const char* str) {
+    if (!strncmp(str, "+SMSUB:", 7)) {
+        lwcelli_parse_smsub(str); /* Parse message received on subscribed topic */
+    }
+}
+#endif /* LWCELL_CFG_MQTT */
+
+#if LWCELL_CFG_HTTP
+static void
+urc_http(const char* str) {
+    if (CMD_IS_CUR(LWCELL_CMD_HTTPACTION) && !strncmp(str, "+HTTPACTION:", 12)) {
+        lwcelli_parse_http_result(str); /* Parse request result */
+    } else if (CMD_IS_CUR(LWCELL_CMD_HTTPREAD) && !strncmp(str, "+HTTPREAD:", 10)) {
+        lwcelli_parse_http_read(str); /* Parse length of body data that follow */
+    }
+}
+
+static void
+urc_shre(const char* str) {
+    if (CMD_IS_CUR(LWCELL_CMD_SHREQ) && !strncmp(str, "+SHREQ:", 7)) {
+        lwcelli_parse_http_result(str); /* Parse request result */
+    } else if (CMD_IS_CUR(LWCELL_CMD_SHREAD) && !strncmp(str, "+SHREAD:", 8)) {
+        lwcelli_parse_http_read(str); /* Parse length of body data that follow */
+    }
+}
+#endif /* LWCELL_CFG_HTTP */
+
+#if LWCELL_CFG_NETWORK_ATTACH_INCREMENTAL
+static void
+urc_cgatt(const char* str) {
+    if (CMD_IS_CUR(LWCELL_CMD_CGATT_GET) && !strncmp(str, "+CGATT: ", 8)) {
+        const char* tmp = &str[8];
+        lwcell.msg->msg.network_attach.attached = lwcelli_parse_number(&tmp) > 0; /* Parse attach state */
+    }
+}
+#endif /* LWCELL_CFG_NETWORK_ATTACH_INCREMENTAL */
+
+#if LWCELL_CFG_FTP
+static void
+urc_ftp(const char* str) {
+    if (!strncmp(str, "+FTPGET:", 8)) {
+        lwcelli_parse_ftpget(str); /* Parse download data length or session status */
+    } else if (!strncmp(str, "+FTPPUT: 2,", 11)) {
+        /* Device is ready to receive upload data */
+        if (CMD_IS_CUR(LWCELL_CMD_FTPPUT_WRITE)) {
+            const char* tmp = &str[11];
+            size_t len = LWCELL_MIN((size_t)lwcelli_parse_number(&tmp), lwcell.msg->msg.ftp_put.len);
+
+            lwcell.msg->msg.ftp_put.len = len;
+            AT_PORT_SEND(lwcell.msg->msg.ftp_put.data, len);
+            AT_PORT_SEND_FLUSH();
+        }
+    } else if (!strncmp(str, "+FTPPUT:", 8)) {
+        lwcelli_parse_ftpput(str); /* Parse upload session status */
+    }
+}
+#endif /* LWCELL_CFG_FTP */
+
+#if LWCELL_CFG_SSL || LWCELL_CFG_FS
+static void
+urc_cfs(const char* str) {
+    if (0) {
+#if LWCELL_CFG_FS
+    } else if (CMD_IS_CUR(LWCELL_CMD_CFSRFILE) && !strncmp(str, "+CFSRFILE:", 10)) {
+        const char* tmp = &str[11];
+        size_t len = (size_t)lwcelli_parse_number(&tmp);
+
+        if (len > 0) {
+            lwcell.msg->msg.data_read.rem_len = LWCELL_MIN(len, lwcell.msg->msg.data_read.len);
+            lwcell.msg->msg.data_read.read = 1; /* Raw data follow after this line */
+        }
+#endif /* LWCELL_CFG_FS */
+    } else if (CMD_IS_CUR(LWCELL_CMD_CFSGFIS) && !strncmp(str, "+CFSGFIS:", 9)) {
+        const char* tmp = &str[10];
+#if LWCELL_CFG_SSL
+        if (CMD_IS_DEF(LWCELL_CMD_CFSWFILE)) { /* Installed certificate check */
+            lwcell.msg->msg.ssl_upload.size = (size_t)lwcelli_parse_number(&tmp);
+            return;
+        }
+#endif /* LWCELL_CFG_SSL */
+#if LWCELL_CFG_FS
+        if (lwcell.msg->msg.fs_file.size != NULL) {
+            *lwcell.msg->msg.fs_file.size = (size_t)lwcelli_parse_number(&tmp);
+        }
+#endif /* LWCELL_CFG_FS */
+    }
+}
+#endif /* LWCELL_CFG_SSL || LWCELL_CFG_FS */
+
+/**
+ * \brief           Table of handlers for lines starting with `+` sign
+ * \note            Entries must be kept sorted by key (alphabetical order of prefix),
+ *                  as table is searched with binary search. Order is checked by \ref lwcell_init
+ */
+static const lwcell_urc_entry_t urc_table[] = {
+#if LWCELL_CFG_CONN_CA_SOCKET
+    {URC_KEY('A', 'P', 'P', ' '), urc_app_pdp},
+    {URC_KEY('C', 'A', 'D', 'A'), urc_ca},
+    {URC_KEY('C', 'A', 'O', 'P'), urc_ca},
+    {URC_KEY('C', 'A', 'R', 'E'), urc_ca},
+    {URC_KEY('C', 'A', 'S', 'T'), urc_ca},
+#endif /* LWCELL_CFG_CONN_CA_SOCKET */
+#if LWCELL_CFG_TIME
+    {URC_KEY('C', 'C', 'L', 'K'), urc_cclk},
+#endif /* LWCELL_CFG_TIME */
+#if LWCELL_CFG_DNS
+    {URC_KEY('C', 'D', 'N', 'S'), urc_cdnsgip},
+#endif /* LWCELL_CFG_DNS */
+#if LWCELL_CFG_CELL_INFO
+    {URC_KEY('C', 'E', 'N', 'G'), urc_ceng},
+#endif /* LWCELL_CFG_CELL_INFO */
+#if LWCELL_CFG_NETWORK_PS_REG
+    {URC_KEY('C', 'E', 'R', 'E'), urc_ps_reg},
+#endif /* LWCELL_CFG_NETWORK_PS_REG */
+#if LWCELL_CFG_SSL || LWCELL_CFG_FS
+    {URC_KEY('C', 'F', 'S', 'G'), urc_cfs},
+#endif /* LWCELL_CFG_SSL || LWCELL_CFG_FS */
+#if LWCELL_CFG_FS
+    {URC_KEY('C', 'F', 'S', 'R'), urc_cfs},
+#endif /* LWCELL_CFG_FS */
+#if LWCELL_CFG_NETWORK_ATTACH_INCREMENTAL
+    {URC_KEY('C', 'G', 'A', 'T'), urc_cgatt},
+#endif /* LWCELL_CFG_NETWORK_ATTACH_INCREMENTAL */
+#if LWCELL_CFG_GNSS
+    {URC_KEY('C', 'G', 'N', 'S'), urc_cgnsinf},
+#endif /* LWCELL_CFG_GNSS */
+#if LWCELL_CFG_NETWORK_PS_REG
+    {URC_KEY('C', 'G', 'R', 'E'), urc_ps_reg},
+#endif /* LWCELL_CFG_NETWORK_PS_REG */
+#if LWCELL_CFG_TIME
+    {URC_KEY('C', 'I', 'P', 'G'), urc_cipgsmloc},
+#endif /* LWCELL_CFG_TIME */
+#if LWCELL_CFG_PING
+    {URC_KEY('C', 'I', 'P', 'P'), urc_cipping},
+#endif /* LWCELL_CFG_PING */
+#if LWCELL_CFG_CONN && LWCELL_CFG_CONN_MANUAL_RECV
+    {URC_KEY('C', 'I', 'P', 'R'), urc_ciprxget},
+#endif /* LWCELL_CFG_CONN && LWCELL_CFG_CONN_MANUAL_RECV */
+#if LWCELL_CFG_CONN
+    {URC_KEY('C', 'I', 'P', 'S'), urc_cipsend},
+#endif /* LWCELL_CFG_CONN */
+#if LWCELL_CFG_CALL
+    {URC_KEY('C', 'L', 'C', 'C'), urc_clcc},
+#endif /* LWCELL_CFG_CALL */
+#if LWCELL_CFG_SMS
+    {URC_KEY('C', 'M', 'G', 'L'), urc_cmgl},
+    {URC_KEY('C', 'M', 'G', 'R'), urc_cmgr},
+    {URC_KEY('C', 'M', 'G', 'S'), urc_cmgs},
+#if LWCELL_CFG_SMS_DIRECT
+    {URC_KEY('C', 'M', 'T', ':'), urc_cmt},
+#endif /* LWCELL_CFG_SMS_DIRECT */
+    {URC_KEY('C', 'M', 'T', 'I'), urc_cmti},
+#endif /* LWCELL_CFG_SMS */
+    {URC_KEY('C', 'O', 'P', 'S'), urc_cops},
+#if LWCELL_CFG_PHONEBOOK
+    {URC_KEY('C', 'P', 'B', 'F'), urc_cpbf},
+    {URC_KEY('C', 'P', 'B', 'R'), urc_cpbr},
+    {URC_KEY('C', 'P', 'B', 'S'), urc_cpbs},
+#endif /* LWCELL_CFG_PHONEBOOK */
+    {URC_KEY('C', 'P', 'I', 'N'), urc_cpin},
+#if LWCELL_CFG_SMS
+    {URC_KEY('C', 'P', 'M', 'S'), urc_cpms},
+#endif /* LWCELL_CFG_SMS */
+#if LWCELL_CFG_NETWORK_BAND
+    {URC_KEY('C', 'P', 'S', 'I'), urc_cpsi},
+#endif /* LWCELL_CFG_NETWORK_BAND */
+    {URC_KEY('C', 'R', 'E', 'G'), urc_creg},
+    {URC_KEY('C', 'S', 'Q', ':'), urc_csq},
+#if LWCELL_CFG_RSSI_URC
+    {URC_KEY('C', 'S', 'Q', 'N'), urc_csq},
+#endif /* LWCELL_CFG_RSSI_URC */
+#if LWCELL_CFG_TIME
+    {URC_KEY('C', 'T', 'Z', 'V'), urc_ctzv},
+#endif /* LWCELL_CFG_TIME */
+#if LWCELL_CFG_FTP
+    {URC_KEY('F', 'T', 'P', 'G'), urc_ftp},
+    {URC_KEY('F', 'T', 'P', 'P'), urc_ftp},
+#endif /* LWCELL_CFG_FTP */
+#if LWCELL_CFG_HTTP
+    {URC_KEY('H', 'T', 'T', 'P'), urc_http},
+#endif /* LWCELL_CFG_HTTP */
+#if LWCELL_CFG_NETWORK
+    {URC_KEY('P', 'D', 'P', ':'), urc_pdp},
+#endif /* LWCELL_CFG_NETWORK */
+#if LWCELL_CFG_CONN
+    {URC_KEY('R', 'E', 'C', 'E'), urc_receive},
+#endif /* LWCELL_CFG_CONN */
+#if LWCELL_CFG_HTTP
+    {URC_KEY('S', 'H', 'R', 'E'), urc_shre},
+#endif /* LWCELL_CFG_HTTP */
+#if LWCELL_CFG_MQTT
+    {URC_KEY('S', 'M', 'S', 'T'), urc_smstate},
+    {URC_KEY('S', 'M', 'S', 'U'), urc_smsub},
+#endif /* LWCELL_CFG_MQTT */
+#if LWCELL_CFG_GNSS
+    {URC_KEY('U', 'G', 'N', 'S'), urc_ugnsinf},
+#endif /* LWCELL_CFG_GNSS */
+};
+
+/**
+ * \brief           Check that table of `+` prefixed handlers is sorted for binary search
+ *
+ * Entries are enabled with configuration options, order is checked for actual configuration
+ *
+ * \return          `1` if keys are in strictly ascending order, `0` otherwise
+ */
+uint8_t
+lwcelli_urc_table_is_sorted(void) {
+    for (size_t i = 1; i < LWCELL_ARRAYSIZE(urc_table); ++i) {
+        if (urc_table[i - 1].key >= urc_table[i].key) {
+            LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_LVL_SEVERE | LWCELL_DBG_TYPE_TRACE,
+                          "[LWCELL CORE] URC table entry %u is out of order\r\n", (unsigned)i);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * \brief           Find handler for line starting with `+` sign
+ * \param[in]       rcv: Received line
+ * \return          Handler function on success, `NULL` otherwise
+ */
+static lwcell_urc_fn
+lwcelli_urc_find(const lwcell_recv_t* rcv) {
+    uint32_t key;
+    size_t low = 0, high = LWCELL_ARRAYSIZE(urc_table);
+
+    if (rcv->len < 5) {
+        return NULL;
+    }
+    key = URC_KEY(rcv->data[1], rcv->data[2], rcv->data[3], rcv->data[4]);
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (urc_table[mid].key == key) {
+            return urc_table[mid].fn;
+        } else if (urc_table[mid].key < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return NULL;
+}
+
+#if LWCELL_CFG_SSL || __DOXYGEN__
+/**
+ * \brief           Send current file chunk after `DOWNLOAD` prompt
+ *
+ * Data are read from application in small pieces, to keep stack usage low.
+ * Device expects exact chunk length, hence missing data are replaced with zeros
+ * and upload is marked as failed.
+ *
+ * \param[in]       msg: File upload message
+ */
+static void
+lwcelli_ssl_file_send_chunk(lwcell_msg_t* msg) {
+    uint8_t buff[64];
+    size_t off = msg->msg.ssl_upload.offset, rem = msg->msg.ssl_upload.chunk_len;
+
+    if (msg->msg.ssl_upload.mark) { /* Marker file holds digest only */
+        char hex[9];
+
+        lwcell_u32_to_hex_str(msg->msg.ssl_upload.digest, hex, 8);
+        AT_PORT_SEND_WITH_FLUSH(hex, 8);
+        return;
+    }
+    while (rem > 0) {
+        size_t btr = LWCELL_MIN(rem, sizeof(buff)), br;
+
+        br = msg->msg.ssl_upload.read_fn(msg->msg.ssl_upload.read_arg, off, buff, btr);
+        if (br < btr) {
+            LWCELL_MEMSET(&buff[br], 0x00, btr - br);
+            msg->msg.ssl_upload.failed = 1;
+        }
+        AT_PORT_SEND(buff, btr);
+        off += btr;
+        rem -= btr;
+    }
+    AT_PORT_SEND_FLUSH();
+}
+
+/**
+ * \brief           Calculate FNV-1a digest of file to upload
+ *
+ * File is read with application callback in small pieces, the same way as for upload.
+ * Digest stays `0` when file cannot be read in full, which never matches installed file
+ *
+ * \param[in]       msg: File upload message
+ */
+static void
+lwcelli_ssl_file_digest(lwcell_msg_t* msg) {
+    uint8_t buff[64];
+    uint32_t hash = 0x811C9DC5UL;
+
+    for (size_t off = 0, btr, br; off < msg->msg.ssl_upload.len; off += btr) {
+        btr = LWCELL_MIN(msg->msg.ssl_upload.len - off, sizeof(buff));
+        br = msg->msg.ssl_upload.read_fn(msg->msg.ssl_upload.read_arg, off, buff, btr);
+        if (br < btr) {
+            msg->msg.ssl_upload.digest = 0;
+            return;
+        }
+        for (size_t i = 0; i < br; ++i) {
+            hash = (hash ^ buff[i]) * 0x01000193UL;
+        }
+    }
+    msg->msg.ssl_upload.digest = hash != 0 ? hash : 1;
+}
+
+/**
+ * \brief           Send name of uploaded file or its digest marker file, with comma and quotes
+ *
+ * Marker file is named after the file, with digest appended as `.xxxxxxxx` hex suffix
+ *
+ * \param[in]       msg: File upload message
+ */
+static void
+lwcelli_ssl_file_send_name(lwcell_msg_t* msg) {
+    if (msg->msg.ssl_upload.mark) {
+        char hex[10] = ".";
+
+        lwcell_u32_to_hex_str(msg->msg.ssl_upload.digest, &hex[1], 8);
+        AT_PORT_SEND_CONST_STR(",\"");
+        lwcelli_send_string(msg->msg.ssl_upload.name, 0, 0, 0);
+        AT_PORT_SEND_STR(hex);
+        AT_PORT_SEND_CONST_STR("\"");
+    } else {
+        lwcelli_send_string(msg->msg.ssl_upload.name, 0, 1, 1);
+    }
+}
+#endif /* LWCELL_CFG_SSL || __DOXYGEN__ */
+
+/**
+ * \brief           Process active command with known execution status
+ * \param[in]       stat: Pointer to status variables
+ */
+static void
+lwcelli_process_cmd_status(lwcell_status_flags_t* stat) {
+    /*
+     * In case of any of these events, simply release semaphore
+     * and proceed with next command
+     */
+    if (stat->is_ok || stat->is_error) {
+        lwcellr_t res = lwcellOK;
+        if (lwcell.msg != NULL && !lwcell.msg->is_parked) { /* Do we have active message, waiting for response? */
+            res = lwcelli_process_sub_cmd(lwcell.msg, stat);
+            if (res != lwcellCONT) { /* Shall we continue with next subcommand under this one? */
+                if (stat->is_ok) {   /* Check OK status */
+                    res = lwcell.msg->res = lwcellOK;
+                } else {                         /* Or error status */
+                    res = lwcell.msg->res = res; /* Set the error status */
+                }
+            } else {
+                ++lwcell.msg->i; /* Number of continue calls */
+            }
+
+            /*
+             * When the command is finished,
+             * release synchronization semaphore
+             * from user thread and start with next command
+             */
+            if (res != lwcellCONT) { /* Do we have to continue to wait for command? */
+                LWCELL_TRACE_HOOK(LWCELL_TRACE_SYNC, LWCELL_TRACE_INSTANT, res);
+                lwcell_sys_sem_release(&lwcell.sem_sync); /* Release semaphore */
+            }
+        }
+    }
+}
+
+#if LWCELL_CFG_CALL || __DOXYGEN__
+
+/**
+ * \brief           Process call report ahead of generic response processing
+ *
+ * Time from `RING` to answer is latency critical.
+ * Reports are classified by first character and length, before line is checked for command responses
+ *
+ * \param[in]       rcv: Pointer to \ref lwcell_recv_t structure with input string
+ * \return          `1` when line is call report and was fully processed, `0` otherwise
+ */
+static uint8_t
+lwcelli_process_call_report(const lwcell_recv_t* rcv) {
+    switch (rcv->data[0]) {
+        case 'R': {
+            if (rcv->len == 4 + CRLF_LEN && !strcmp(rcv->data, "RING" CRLF)) {
+                if (lwcell.m.call_rings < 0xFF) {
+                    ++lwcell.m.call_rings;
+                }
+#if LWCELL_CFG_CALL_AUTO_ANSWER > 0
+                if (lwcell.m.call_rings == LWCELL_CFG_CALL_AUTO_ANSWER) {
+                    lwcelli_call_auto_answer(); /* Queue answer before application processes the event */
+                }
+#endif /* LWCELL_CFG_CALL_AUTO_ANSWER > 0 */
+                lwcelli_send_cb(LWCELL_EVT_CALL_RING); /* Send call ring */
+                return 1;
+            }
+            break;
+        }
+        case 'N': {
+            if (rcv->len == 10 + CRLF_LEN && !strcmp(rcv->data, "NO CARRIER" CRLF)
+#if LWCELL_CFG_PPP
+                && !CMD_IS_CUR(LWCELL_CMD_PPP_DIAL) && !CMD_IS_CUR(LWCELL_CMD_ATO)
+#endif /* LWCELL_CFG_PPP */
+            ) {
+                lwcell.m.call_rings = 0;
+                lwcelli_send_cb(LWCELL_EVT_CALL_NO_CARRIER); /* Send call no carrier event */
+                return 1;
+            }
+            break;
+        }
+        case 'B': {
+            if (rcv->len == 4 + CRLF_LEN && !strcmp(rcv->data, "BUSY" CRLF)) {
+                lwcell.m.call_rings = 0;
+                lwcelli_send_cb(LWCELL_EVT_CALL_BUSY); /* Send call busy message */
+                return 1;
+            }
+            break;
+        }
+        case '+': {
+            if (rcv->len > 7 && !strncmp(rcv->data, "+CLIP: ", 7)) {
+                lwcelli_parse_clip(rcv->data); /* Incoming call number */
+                return 1;
+            }
+            break;
+        }
+        default: break;
+    }
+    return 0;
+}
+
+#endif /* LWCELL_CFG_CALL || __DOXYGEN__ */
+
+/**
+ * \brief           Process received string from GSM
+ * \param[in]       rcv: Pointer to \ref lwcell_recv_t structure with input string
+ */
+static void
+lwcelli_parse_received(lwcell_recv_t* rcv) {
+    lwcell_status_flags_t stat = {0};
+
+    /* Try to remove non-parsable strings */
+    if (rcv->len == 2 && rcv->data[0] == '\r' && rcv->data[1] == '\n') {
+        return;
+    }
+    LWCELL_STATS_ADD(lines, 1);
+#if LWCELL_CFG_CALL
+    if (lwcelli_process_call_report(rcv)) {
+        return;
+    }
+#endif /* LWCELL_CFG_CALL */
+
+    /* Check OK response */
+    stat.is_ok = rcv->len == (2 + CRLF_LEN) && !strcmp(rcv->data, "OK" CRLF); /* Check if received string is OK */
+    if (!stat.is_ok) {                                                        /* Check for SHUT OK string */
+        stat.is_ok = rcv->len == (7 + CRLF_LEN) && !strcmp(rcv->data, "SEND OK" CRLF);
+    }
+
+    /* Check error response */
+    if (!stat.is_ok) { /* If still not ok, check if error? */
+        stat.is_error =
+            rcv->data[0] == '+' && !strncmp(rcv->data, "+CME ERROR", 10); /* First check +CME coded errors */
+        if (!stat.is_error) {                                             /* Check basic error aswell */
+            stat.is_error =
+                rcv->data[0] == '+' && !strncmp(rcv->data, "+CMS ERROR", 10); /* First check +CME coded errors */
+            if (!stat.is_error) {
+                stat.is_error = !strcmp(rcv->data, "ERROR" CRLF) || !strcmp(rcv->data, "FAIL" CRLF);
+            }
+        }
+    }
+
+    /* Scan received strings which start with '+' */
+    if (rcv->data[0] == '+') {
+        lwcell_urc_fn fn = lwcelli_urc_find(rcv);
+        if (fn != NULL) {
+            LWCELL_STATS_ADD(urc_lines, 1);
+            LWCELL_TRACE_HOOK(LWCELL_TRACE_URC, LWCELL_TRACE_BEGIN, 0);
+            fn(rcv->data);
+            LWCELL_TRACE_HOOK(LWCELL_TRACE_URC, LWCELL_TRACE_END, 0);
         }
 
         /* Messages not starting with '+' sign */
     } else {
         if (rcv->data[0] == 'S' && !strncmp(rcv->data, "SHUT OK" CRLF, 7 + CRLF_LEN)) {
             stat.is_ok = 1;
+#if LWCELL_CFG_CONN_SERVER
+            lwcell.m.evt_server = NULL; /* Server is stopped together with all connections */
+#endif                                  /* LWCELL_CFG_CONN_SERVER */
 #if LWCELL_CFG_CONN
         } else if (LWCELL_CHARISNUM(rcv->data[0]) && rcv->data[1] == ',' && rcv->data[2] == ' '
                    && (!strncmp(&rcv->data[3], "CLOSE OK" CRLF, 8 + CRLF_LEN)
@@ -838,22 +2885,59 @@ lwcelli_parse_received(lwcell_recv_t* rcv) {
                 lwcelli_process_cipsend_response(rcv, &stat);
             }
             lwcelli_conn_closed_process(num, forced); /* Connection closed, process */
-#endif                                                /* LWCELL_CFG_CONN */
+#if LWCELL_CFG_CONN_RECV_FROM
+        } else if (rcv->data[0] == 'R' && !strncmp(rcv->data, "RECV FROM:", 10)) {
+            lwcelli_parse_recv_from(rcv->data); /* Source address of packet which follows */
+#endif                                          /* LWCELL_CFG_CONN_RECV_FROM */
+#if LWCELL_CFG_CONN_SERVER
+        } else if (LWCELL_CHARISNUM(rcv->data[0]) && rcv->data[1] == ',' && rcv->data[2] == ' '
+                   && !strncmp(&rcv->data[3], "REMOTE IP: ", 11)) {
+            lwcelli_conn_server_accept(rcv->data);
+        } else if (rcv->data[0] == 'S' && !strncmp(rcv->data, "SERVER CLOSE" CRLF, 12 + CRLF_LEN)) {
+            lwcell.m.evt_server = NULL; /* Server stopped, device does not accept new connections */
+#endif /* LWCELL_CFG_CONN_SERVER */
+#endif /* LWCELL_CFG_CONN */
+#if LWCELL_CFG_PPP
+        } else if ((CMD_IS_CUR(LWCELL_CMD_PPP_DIAL) || CMD_IS_CUR(LWCELL_CMD_ATO))
+                   && rcv->data[0] == 'C' && !strncmp(rcv->data, "CONNECT", 7)) {
+            stat.is_ok = 1; /* There is no OK in data mode */
+            lwcelli_ppp_connected();
+        } else if ((CMD_IS_CUR(LWCELL_CMD_PPP_DIAL) || CMD_IS_CUR(LWCELL_CMD_ATO))
+                   && rcv->data[0] == 'N' && !strncmp(rcv->data, "NO CARRIER" CRLF, 10 + CRLF_LEN)) {
+            stat.is_error = 1; /* Packet service call failed */
+#endif /* LWCELL_CFG_PPP */
+#if LWCELL_CFG_SSL || LWCELL_CFG_FS
+        } else if (CMD_IS_CUR(LWCELL_CMD_CFSWFILE) && rcv->data[0] == 'D'
+                   && !strncmp(rcv->data, "DOWNLOAD" CRLF, 8 + CRLF_LEN)) {
+            /* Device waits for chunk data */
+#if LWCELL_CFG_FS
+            if (CMD_IS_DEF(LWCELL_CMD_FS_WRITE)) {
+                AT_PORT_SEND((const uint8_t*)lwcell.msg->msg.fs_write.data + lwcell.msg->msg.fs_write.offset,
+                             lwcell.msg->msg.fs_write.chunk_len);
+                AT_PORT_SEND_FLUSH();
+            }
+#endif /* LWCELL_CFG_FS */
+#if LWCELL_CFG_SSL
+            if (CMD_IS_DEF(LWCELL_CMD_CFSWFILE)) {
+                lwcelli_ssl_file_send_chunk(lwcell.msg);
+            }
+#endif /* LWCELL_CFG_SSL */
+#endif /* LWCELL_CFG_SSL || LWCELL_CFG_FS */
+#if LWCELL_CFG_TIME
+        } else if (rcv->data[0] == '*' && !strncmp(rcv->data, "*PSUTTZ:", 8)) {
+            lwcelli_parse_psuttz(rcv->data); /* Network time and time zone */
+#endif                                       /* LWCELL_CFG_TIME */
 #if LWCELL_CFG_CALL
         } else if (rcv->data[0] == 'C' && !strncmp(rcv->data, "Call Ready" CRLF, 10 + CRLF_LEN)) {
             lwcell.m.call.ready = 1;
             lwcelli_send_cb(LWCELL_EVT_CALL_READY); /* Send CALL ready event */
-        } else if (rcv->data[0] == 'R' && !strncmp(rcv->data, "RING" CRLF, 4 + CRLF_LEN)) {
-            lwcelli_send_cb(LWCELL_EVT_CALL_RING); /* Send call ring */
-        } else if (rcv->data[0] == 'N' && !strncmp(rcv->data, "NO CARRIER" CRLF, 10 + CRLF_LEN)) {
-            lwcelli_send_cb(LWCELL_EVT_CALL_NO_CARRIER); /* Send call no carrier event */
-        } else if (rcv->data[0] == 'B' && !strncmp(rcv->data, "BUSY" CRLF, 4 + CRLF_LEN)) {
-            lwcelli_send_cb(LWCELL_EVT_CALL_BUSY); /* Send call busy message */
-#endif                                             /* LWCELL_CFG_CALL */
+            lwcelli_sim_info_retry_now();
+#endif /* LWCELL_CFG_CALL */
 #if LWCELL_CFG_SMS
         } else if (rcv->data[0] == 'S' && !strncmp(rcv->data, "SMS Ready" CRLF, 9 + CRLF_LEN)) {
             lwcell.m.sms.ready = 1;                /* SMS ready flag */
             lwcelli_send_cb(LWCELL_EVT_SMS_READY); /* Send SMS ready event */
+            lwcelli_sim_info_retry_now();
 #endif                                             /* LWCELL_CFG_SMS */
         } else if ((CMD_IS_CUR(LWCELL_CMD_CGMI_GET) || CMD_IS_CUR(LWCELL_CMD_CGMM_GET)
                     || CMD_IS_CUR(LWCELL_CMD_CGSN_GET) || CMD_IS_CUR(LWCELL_CMD_CGMR_GET))
@@ -862,7 +2946,7 @@ lwcelli_parse_received(lwcell_recv_t* rcv) {
             size_t tocopy;
             if (CMD_IS_CUR(LWCELL_CMD_CGMI_GET)) { /* Check device manufacturer */
                 lwcelli_parse_string(&tmp, lwcell.m.model_manufacturer, sizeof(lwcell.m.model_manufacturer), 1);
-                if (CMD_IS_DEF(LWCELL_CMD_CGMI_GET)) {
+                if (CMD_IS_DEF(LWCELL_CMD_CGMI_GET) && lwcell.msg->msg.device_info.str != NULL) {
                     tocopy = LWCELL_MIN(sizeof(lwcell.m.model_manufacturer), lwcell.msg->msg.device_info.len);
                     LWCELL_MEMCPY(lwcell.msg->msg.device_info.str, lwcell.m.model_manufacturer, tocopy);
                     lwcell.msg->msg.device_info.str[tocopy - 1] = 0;
@@ -874,12 +2958,7 @@ lwcelli_parse_received(lwcell_recv_t* rcv) {
                     LWCELL_MEMCPY(lwcell.msg->msg.device_info.str, lwcell.m.model_number, tocopy);
                     lwcell.msg->msg.device_info.str[tocopy - 1] = 0;
                 }
-                for (size_t i = 0; i < lwcell_dev_model_map_size; ++i) {
-                    if (strstr(lwcell.m.model_number, lwcell_dev_model_map[i].id_str) != NULL) {
-                        lwcell.m.model = lwcell_dev_model_map[i].model;
-                        break;
-                    }
-                }
+                lwcelli_device_model_from_number();
             } else if (CMD_IS_CUR(LWCELL_CMD_CGSN_GET)) { /* Check device serial number */
                 lwcelli_parse_string(&tmp, lwcell.m.model_serial_number, sizeof(lwcell.m.model_serial_number), 1);
                 if (CMD_IS_DEF(LWCELL_CMD_CGSN_GET)) {
@@ -900,7 +2979,14 @@ lwcelli_parse_received(lwcell_recv_t* rcv) {
             }
         } else if (CMD_IS_CUR(LWCELL_CMD_CIFSR) && LWCELL_CHARISNUM(rcv->data[0])) {
             const char* tmp = rcv->data;
-            lwcelli_parse_ip(&tmp, &lwcell.m.network.ip_addr); /* Parse IP address */
+            lwcell_ip_t* ip = &lwcell.m.network.ip_addr;
+
+#if LWCELL_CFG_NETWORK_CONTEXTS > 1
+            if (lwcell.msg->msg.network_attach.ctx > 0) { /* Address of additional context */
+                ip = &lwcell.m.network.ctx[lwcell.msg->msg.network_attach.ctx - 1].ip_addr;
+            }
+#endif /* LWCELL_CFG_NETWORK_CONTEXTS > 1 */
+            lwcelli_parse_ip(&tmp, ip); /* Parse IP address */
 
             stat.is_ok = 1; /* Manually set OK flag as we don't expect OK in CIFSR command */
         }
@@ -908,7 +2994,8 @@ lwcelli_parse_received(lwcell_recv_t* rcv) {
 
     /* Check general responses for active commands */
     if (lwcell.msg != NULL) {
-        if (CMD_IS_CUR(LWCELL_CMD_CPIN_GET)) {
+        if (CMD_IS_CUR(LWCELL_CMD_CPIN_GET)
+            || (CMD_IS_CUR(LWCELL_CMD_QUERY_BATCH) && (lwcell.msg->msg.query_batch.queries & LWCELL_QUERY_SIM_STATE))) {
             /*
              * CME ERROR 10 indicates no SIM pin inserted.
              *
@@ -950,8 +3037,8 @@ lwcelli_parse_received(lwcell_recv_t* rcv) {
                 }
             }
         } else if (CMD_IS_CUR(LWCELL_CMD_CIPSTART)) {
-            /* For CIPSTART, OK is returned before important data */
-            if (stat.is_ok) {
+            /* For CIPSTART, OK is returned before important data, socket engine reports result before OK */
+            if (stat.is_ok && !LWCELL_CONN_IS_CA()) {
                 stat.is_ok = 0;
             }
 
@@ -959,23 +3046,8 @@ lwcelli_parse_received(lwcell_recv_t* rcv) {
             if (LWCELL_CHARISNUM(rcv->data[0]) && rcv->data[1] == ',' && rcv->data[2] == ' ') {
                 uint8_t num = LWCELL_CHARTONUM(rcv->data[0]);
                 if (num < LWCELL_CFG_MAX_CONNS) {
-                    uint8_t id;
-                    lwcell_conn_t* conn = &lwcell.m.conns[num]; /* Get connection handle */
-
                     if (!strncmp(&rcv->data[3], "CONNECT OK" CRLF, 10 + CRLF_LEN)) {
-                        id = conn->val_id;
-                        LWCELL_MEMSET(conn, 0x00, sizeof(*conn)); /* Reset connection parameters */
-                        conn->num = num;
-                        conn->status.f.active = 1;
-                        conn->val_id = ++id; /* Set new validation ID */
-
-                        /* Set connection parameters */
-                        conn->status.f.client = 1;
-                        conn->evt_func = lwcell.msg->msg.conn_start.evt_func;
-                        conn->arg = lwcell.msg->msg.conn_start.arg;
-
-                        /* Set status */
-                        lwcell.msg->msg.conn_start.conn_res = LWCELL_CONN_CONNECT_OK;
+                        lwcelli_conn_client_opened(num);
                         stat.is_ok = 1;
                     } else if (!strncmp(&rcv->data[3], "CONNECT FAIL" CRLF, 12 + CRLF_LEN)) {
                         lwcell.msg->msg.conn_start.conn_res = LWCELL_CONN_CONNECT_ERROR;
@@ -991,6 +3063,20 @@ lwcelli_parse_received(lwcell_recv_t* rcv) {
                 stat.is_ok = 0;
             }
             lwcelli_process_cipsend_response(rcv, &stat);
+#if LWCELL_CFG_CONN_SERVER
+        } else if (CMD_IS_CUR(LWCELL_CMD_CIPSERVER)) {
+            /* OK is returned before server status */
+            if (stat.is_ok) {
+                stat.is_ok = 0;
+            }
+            if (!strncmp(rcv->data, "SERVER OK" CRLF, 9 + CRLF_LEN)) {
+                lwcell.m.evt_server = lwcell.msg->msg.conn_server.evt_func;
+                lwcell.m.server_port = lwcell.msg->msg.conn_server.port;
+                stat.is_ok = 1;
+            } else if (!strncmp(rcv->data, "SERVER CLOSE" CRLF, 12 + CRLF_LEN)) {
+                stat.is_ok = 1;
+            }
+#endif /* LWCELL_CFG_CONN_SERVER */
 #endif /* LWCELL_CFG_CONN */
 #if LWCELL_CFG_USSD
         } else if (CMD_IS_CUR(LWCELL_CMD_CUSD)) {
@@ -999,81 +3085,335 @@ lwcelli_parse_received(lwcell_recv_t* rcv) {
             if (stat.is_ok) {
                 stat.is_ok = 0;
             }
+#endif /* LWCELL_CFG_USSD */
+#if LWCELL_CFG_HTTP
+        } else if (CMD_IS_CUR(LWCELL_CMD_HTTPACTION) || CMD_IS_CUR(LWCELL_CMD_SHREQ)) {
+            /* OK is returned before request result */
+            if (stat.is_ok) {
+                stat.is_ok = 0;
+            }
+            if (lwcell.msg->msg.http_get.resp_received) {
+                stat.is_ok = lwcell.m.http.status < 600; /* Codes from 600 up are device network errors */
+                stat.is_error = !stat.is_ok;
+                lwcell.m.http.active = stat.is_ok;
+            }
+        } else if (CMD_IS_CUR(LWCELL_CMD_SHREAD)) {
+            /* OK is returned before +SHREAD and body data */
+            if (stat.is_ok) {
+                stat.is_ok = 0;
+            }
 
-            /* Check for manual CUSTOM OK message */
+            /* Check for manual CUSTOM OK message after raw data */
             if (!strcmp(rcv->data, "CUSTOM_OK\r\n")) {
                 stat.is_ok = 1;
             }
-#endif /* LWCELL_CFG_USSD */
+#endif /* LWCELL_CFG_HTTP */
+#if LWCELL_CFG_FTP
+        } else if (CMD_IS_CUR(LWCELL_CMD_FTPGET_OPEN) || CMD_IS_CUR(LWCELL_CMD_FTPPUT_OPEN)) {
+            /* OK is returned before session open result */
+            if (stat.is_ok) {
+                stat.is_ok = 0;
+            }
+            if (lwcell.msg->msg.ftp_start.resp_received) {
+                stat.is_ok = lwcell.msg->msg.ftp_start.resp_code == 1;
+                stat.is_error = !stat.is_ok;
+            }
+#if LWCELL_CFG_FS
+        } else if (CMD_IS_CUR(LWCELL_CMD_FTPPUTFRMFS)) {
+            /* OK is returned before device uploaded the file */
+            if (stat.is_ok) {
+                stat.is_ok = 0;
+            }
+            if (lwcell.msg->msg.ftp_start.resp_received) {
+                stat.is_ok = lwcell.msg->msg.ftp_start.resp_code == 0;
+                stat.is_error = !stat.is_ok;
+            }
+#endif /* LWCELL_CFG_FS */
+        } else if (CMD_IS_CUR(LWCELL_CMD_FTPPUT_WRITE) || CMD_IS_CUR(LWCELL_CMD_FTPPUT_END)) {
+            /* OK is returned before device processed upload data */
+            if (stat.is_ok) {
+                stat.is_ok = 0;
+            }
+            if (lwcell.msg->msg.ftp_put.resp_received) {
+                stat.is_ok = lwcell.msg->msg.ftp_put.resp_code == (CMD_IS_CUR(LWCELL_CMD_FTPPUT_WRITE) ? 1 : 0);
+                stat.is_error = !stat.is_ok;
+            }
+#endif /* LWCELL_CFG_FTP */
+#if LWCELL_CFG_DNS
+        } else if (CMD_IS_CUR(LWCELL_CMD_CDNSGIP)) {
+            /* OK is returned before resolve result */
+            if (stat.is_ok) {
+                stat.is_ok = 0;
+            }
+            if (lwcell.msg->msg.dns.resp_received) {
+                stat.is_ok = lwcell.msg->msg.dns.addr_cnt > 0;
+                stat.is_error = !stat.is_ok;
+            }
+#endif /* LWCELL_CFG_DNS */
         }
     }
 
+    lwcelli_process_cmd_status(&stat);
+}
+
+#if !LWCELL_CFG_INPUT_USE_PROCESS || __DOXYGEN__
+/**
+ * \brief           Process data from input buffer
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcelli_process_buffer(void) {
+    lwcell_buff_vec_t vec[2];
+    size_t len;
+
+#if LWCELL_CFG_INPUT_BUFF_ATOMIC
     /*
-     * In case of any of these events, simply release semaphore
-     * and proceed with next command
+     * Clear notification before reading buffer.
+     * Data written after this point either get processed below
+     * or writer sends new notification to processing thread
      */
-    if (stat.is_ok || stat.is_error) {
-        lwcellr_t res = lwcellOK;
-        if (lwcell.msg != NULL) { /* Do we have active message? */
-            res = lwcelli_process_sub_cmd(lwcell.msg, &stat);
-            if (res != lwcellCONT) { /* Shall we continue with next subcommand under this one? */
-                if (stat.is_ok) {    /* Check OK status */
-                    res = lwcell.msg->res = lwcellOK;
-                } else {                         /* Or error status */
-                    res = lwcell.msg->res = res; /* Set the error status */
-                }
-            } else {
-                ++lwcell.msg->i; /* Number of continue calls */
+    atomic_exchange(&lwcell.buff_notified, 0);
+#endif /* LWCELL_CFG_INPUT_BUFF_ATOMIC */
+    do {
+        /*
+         * Get both linear blocks of memory in buffer,
+         * wrapped data are processed in the same pass
+         */
+        len = lwcell_buff_get_read_vec(&lwcell.buff, vec);
+        if (len > 0) {
+            /* Process actual received data */
+            LWCELL_TRACE_HOOK(LWCELL_TRACE_INPUT, LWCELL_TRACE_BEGIN, len);
+            lwcelli_process(vec[0].data, vec[0].len);
+            if (vec[1].len > 0) {
+                lwcelli_process(vec[1].data, vec[1].len);
             }
+            LWCELL_TRACE_HOOK(LWCELL_TRACE_INPUT, LWCELL_TRACE_END, 0);
 
             /*
-             * When the command is finished,
-             * release synchronization semaphore
-             * from user thread and start with next command
+             * Once data is processed, simply skip
+             * the buffer memory and start over
              */
-            if (res != lwcellCONT) {                      /* Do we have to continue to wait for command? */
-                lwcell_sys_sem_release(&lwcell.sem_sync); /* Release semaphore */
-            }
+            lwcell_buff_skip(&lwcell.buff, len);
+        }
+    } while (len > 0);
+    return lwcellOK;
+}
+#endif /* !LWCELL_CFG_INPUT_USE_PROCESS || __DOXYGEN__ */
+
+#if LWCELL_CFG_CONN || __DOXYGEN__
+
+#if LWCELL_CFG_INPUT_ZERO_COPY || __DOXYGEN__
+
+/* Check if data must be copied to packet buffer or is already referenced by it */
+#define IPD_BUFF_NEEDS_COPY(b) ((b) != NULL && (b)->ref_mem == NULL)
+#else /* LWCELL_CFG_INPUT_ZERO_COPY || __DOXYGEN__ */
+#define IPD_BUFF_NEEDS_COPY(b) ((b) != NULL)
+#endif /* !(LWCELL_CFG_INPUT_ZERO_COPY || __DOXYGEN__) */
+
+/**
+ * \brief           Allocate new packet buffer for received connection data
+ *
+ * When input memory is lent by driver and all data for packet buffer are already available,
+ * packet buffer references input memory directly. Otherwise new memory is allocated,
+ * with size decreased down to \ref LWCELL_CFG_CONN_MIN_DATA_LEN until allocation is successful
+ *
+ * \param[in]       len: Preferred length of packet buffer
+ * \param[in]       d: Pointer to remaining input data
+ * \param[in]       d_len: Length of remaining input data
+ * \return          New packet buffer on success, `NULL` otherwise
+ */
+static lwcell_pbuf_p
+lwcelli_ipd_pbuf_new(size_t len, const uint8_t* d, size_t d_len) {
+    lwcell_pbuf_p p = NULL;
+
+#if LWCELL_CFG_INPUT_ZERO_COPY
+    if (lwcell.parser.ipd_lend.active && d_len >= len) {
+        p = lwcell_pbuf_new_ref(d, len, lwcell.parser.ipd_lend.release_fn, lwcell.parser.ipd_lend.arg);
+    }
+#else  /* LWCELL_CFG_INPUT_ZERO_COPY */
+    LWCELL_UNUSED(d);
+    LWCELL_UNUSED(d_len);
+#endif /* !LWCELL_CFG_INPUT_ZERO_COPY */
+    if (p == NULL) {
+        do {
+            p = lwcell_pbuf_new(len); /* Allocate new packet buffer */
+        } while (p == NULL && (len = (len >> 1)) >= LWCELL_CFG_CONN_MIN_DATA_LEN);
+    }
+#if LWCELL_CFG_CONN_RECV_FROM
+    if (lwcell.m.ipd.src_valid) {
+        lwcell_pbuf_set_ip(p, &lwcell.m.ipd.src_ip, lwcell.m.ipd.src_port);
+        return p;
+    }
+#endif /* LWCELL_CFG_CONN_RECV_FROM */
+    lwcell_pbuf_set_ip(p, &lwcell.m.ipd.conn->remote_ip, lwcell.m.ipd.conn->remote_port);
+    return p;
+}
+
+/**
+ * \brief           Start reading connection data after header was parsed
+ *
+ * Packet buffer is allocated for active connection, data on closed connection are skipped
+ *
+ * \param[in]       d: Pointer to remaining input data, first byte of connection data
+ * \param[in]       d_len: Length of remaining input data
+ */
+static void
+prv_ipd_start_read(const uint8_t* d, size_t d_len) {
+    size_t len;
+
+    LWCELL_DEBUGF(LWCELL_CFG_DBG_IPD | LWCELL_DBG_TYPE_TRACE,
+                  "[LWCELL IPD] Data on connection %d with total size %d byte(s)\r\n", (int)lwcell.m.ipd.conn->num,
+                  (int)lwcell.m.ipd.tot_len);
+
+    lwcelli_ipd_read_active(1);
+#if LWCELL_CFG_CONN_TX_WINDOW > 0
+    lwcelli_conn_tx_window_activity(); /* Radio is in connected state */
+#endif                                 /* LWCELL_CFG_CONN_TX_WINDOW > 0 */
+    len = LWCELL_MIN(lwcell.m.ipd.rem_len, LWCELL_CFG_CONN_MAX_DATA_LEN);
+
+    /*
+     * Read received data in case of:
+     *
+     *  - Connection is active and
+     *  - Connection is not in closing mode
+     */
+    if (lwcell.m.ipd.conn->status.f.active && !lwcell.m.ipd.conn->status.f.in_closing) {
+        lwcell.m.ipd.buff = lwcelli_ipd_pbuf_new(len, d, d_len); /* Allocate new packet buffer */
+        if (lwcell.m.ipd.buff == NULL) {
+            LWCELL_STATS_ADD(pbuf_alloc_failed, 1);
+        }
+        LWCELL_DEBUGW(LWCELL_CFG_DBG_IPD | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING, lwcell.m.ipd.buff == NULL,
+                      "[LWCELL IPD] Buffer allocation failed for %d byte(s)\r\n", (int)len);
+#if LWCELL_CFG_CONN_MANUAL_RECV
+        if (lwcell.m.ipd.buff == NULL && lwcell.m.ipd.is_rxget) {
+            lwcell.m.ipd.conn->rx_credit += lwcell.m.ipd.tot_len; /* Data never reach application */
         }
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV */
+    } else {
+        lwcell.m.ipd.buff = NULL; /* Ignore reading on closed connection */
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_IPD | LWCELL_DBG_TYPE_TRACE,
+                      "[LWCELL IPD] Connection %d closed or in closing, skipping %d byte(s)\r\n",
+                      (int)lwcell.m.ipd.conn->num, (int)len);
     }
+    lwcell.m.ipd.conn->status.f.data_received = 1; /* We have first received data */
+    lwcell.m.ipd.buff_ptr = 0;                     /* Reset buffer write pointer */
 }
 
-#if !LWCELL_CFG_INPUT_USE_PROCESS || __DOXYGEN__
+#endif /* LWCELL_CFG_CONN || __DOXYGEN__ */
+
+#if LWCELL_CFG_HTTP || __DOXYGEN__
+
 /**
- * \brief           Process data from input buffer
- * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ * \brief           Get path part of HTTP request URL
+ * \param[in]       url: Full URL, such as `http://example.com/file.bin`
+ * \return          Pointer to path in URL or to end of string when URL has no path
  */
-lwcellr_t
-lwcelli_process_buffer(void) {
-    void* data;
-    size_t len;
+static const char*
+lwcelli_http_url_path(const char* url) {
+    const char* p = strstr(url, "://");
 
-    do {
-        /*
-         * Get length of linear memory in buffer
-         * we can process directly as memory
-         */
-        len = lwcell_buff_get_linear_block_read_length(&lwcell.buff);
-        if (len > 0) {
-            /*
-             * Get memory address of first element
-             * in linear block of data to process
-             */
-            data = lwcell_buff_get_linear_block_read_address(&lwcell.buff);
+    p = p != NULL ? (p + 3) : url;
+    for (; *p != '\0' && *p != '/'; ++p) {}
+    return p;
+}
 
-            /* Process actual received data */
-            lwcelli_process(data, len);
+#endif /* LWCELL_CFG_HTTP || __DOXYGEN__ */
 
-            /*
-             * Once data is processed, simply skip
-             * the buffer memory and start over
-             */
-            lwcell_buff_skip(&lwcell.buff, len);
+#if LWCELL_CFG_HTTP || LWCELL_CFG_FTP || LWCELL_CFG_FS || __DOXYGEN__
+
+/* Commands which receive raw data to application packet buffers */
+#define CMD_IS_DATA_READ()                                                                                             \
+    (CMD_IS_CUR(LWCELL_CMD_HTTPREAD) || CMD_IS_CUR(LWCELL_CMD_SHREAD) || CMD_IS_CUR(LWCELL_CMD_FTPGET_READ)            \
+     || CMD_IS_CUR(LWCELL_CMD_CFSRFILE))
+
+/**
+ * \brief           Copy raw HTTP body, FTP or device file data to application packet buffer chain
+ *
+ * Data which do not fit to remaining packet buffer memory are dropped
+ *
+ * \param[in]       data: Pointer to received raw data
+ * \param[in]       len: Length of data in units of bytes
+ */
+static void
+lwcelli_data_read_copy(const uint8_t* data, size_t len) {
+    size_t copy_len;
+
+    while (len > 0 && lwcell.msg->msg.data_read.p != NULL) {
+        lwcell_pbuf_p p = lwcell.msg->msg.data_read.p;
+
+        copy_len = LWCELL_MIN(len, p->len - lwcell.msg->msg.data_read.p_ptr);
+        LWCELL_MEMCPY(&p->payload[lwcell.msg->msg.data_read.p_ptr], data, copy_len);
+        lwcell.msg->msg.data_read.p_ptr += copy_len;
+        lwcell.msg->msg.data_read.recv_len += copy_len;
+        data += copy_len;
+        len -= copy_len;
+        if (lwcell.msg->msg.data_read.p_ptr == p->len) { /* Continue with next buffer in chain */
+            lwcell.msg->msg.data_read.p = p->next;
+            lwcell.msg->msg.data_read.p_ptr = 0;
         }
-    } while (len > 0);
-    return lwcellOK;
+    }
+}
+
+#endif /* LWCELL_CFG_HTTP || LWCELL_CFG_FTP || LWCELL_CFG_FS || __DOXYGEN__ */
+
+#if LWCELL_CFG_USSD || __DOXYGEN__
+
+/**
+ * \brief           Process +CUSD response data
+ *
+ * Quoted response string is copied to user array in bulk, up to the closing quote.
+ * Data coding scheme after the string selects UCS2 hex decoding, done in place when line ends
+ *
+ * \param[in]       data: Received data, starting with current character
+ * \param[in]       len: Length of received data
+ * \return          Number of processed bytes, at least `1`
+ */
+static size_t
+lwcelli_ussd_read(const uint8_t* data, size_t len) {
+    lwcell_msg_t* msg = lwcell.msg;
+
+    if (msg->msg.ussd.quote_det) {
+        const uint8_t* end = memchr(data, '"', len);
+        size_t n, copy;
+
+        n = end != NULL ? (size_t)(end - data) : len;
+        copy = LWCELL_MIN(n, msg->msg.ussd.resp_len - 1 - msg->msg.ussd.resp_write_ptr);
+        LWCELL_MEMCPY(&msg->msg.ussd.resp[msg->msg.ussd.resp_write_ptr], data, copy);
+        msg->msg.ussd.resp_write_ptr += copy;
+        if (end != NULL) {
+            msg->msg.ussd.quote_det = 0;
+            ++n; /* Closing quote */
+        }
+        return n;
+    }
+    switch (data[0]) {
+        case '"': msg->msg.ussd.quote_det = 1; break;
+        case ',': ++msg->msg.ussd.field; break;
+        case '\n': {
+            lwcell_status_flags_t stat = {0};
+
+            msg->msg.ussd.resp[msg->msg.ussd.resp_write_ptr] = '\0';
+            if ((msg->msg.ussd.dcs & 0xCC) == 0x48) { /* UCS2 alphabet, such as `72` */
+                lwcelli_unicode_ucs2_hex_decode(msg->msg.ussd.resp);
+            }
+            msg->msg.ussd.read = 0;
+
+            /* OK was received before +CUSD, command is finished now */
+            stat.is_ok = 1;
+            lwcelli_process_cmd_status(&stat);
+            break;
+        }
+        default: {
+            if (msg->msg.ussd.field == 2 && LWCELL_CHARISNUM(data[0])) {
+                msg->msg.ussd.dcs = (uint8_t)(msg->msg.ussd.dcs * 10 + LWCELL_CHARTONUM(data[0]));
+            }
+            break;
+        }
+    }
+    return 1;
 }
-#endif /* !LWCELL_CFG_INPUT_USE_PROCESS || __DOXYGEN__ */
+
+#endif /* LWCELL_CFG_USSD || __DOXYGEN__ */
 
 /**
  * \brief           Process input data received from GSM device
@@ -1086,13 +3426,24 @@ lwcelli_process(const void* data, size_t data_len) {
     uint8_t ch;
     const uint8_t* d = data;
     size_t d_len = data_len;
-    static uint8_t ch_prev1, ch_prev2;
-    static lwcell_unicode_t unicode;
+#if LWCELL_CFG_STATS
+    uint32_t time_start = lwcell_sys_now();
+#endif /* LWCELL_CFG_STATS */
 
     /* Check status if device is available */
     if (!lwcell.status.f.dev_present) {
         return lwcellERRNODEVICE;
     }
+#if LWCELL_CFG_CMUX
+    if (lwcelli_cmux_input(data, data_len)) { /* Frames are decoded, stack channel data comes back here */
+        return lwcellOK;
+    }
+#endif /* LWCELL_CFG_CMUX */
+#if LWCELL_CFG_PPP
+    if (lwcelli_ppp_input(data, data_len)) { /* Data mode, bytes belong to PPP */
+        return lwcellOK;
+    }
+#endif /* LWCELL_CFG_PPP */
 
     while (d_len > 0) { /* Read entire set of characters from buffer */
         ch = *d;        /* Get next character */
@@ -1104,8 +3455,10 @@ lwcelli_process(const void* data, size_t data_len) {
         } else if (lwcell.m.ipd.read) { /* Read connection data */
             size_t len;
 
-            if (lwcell.m.ipd.buff != NULL) {                            /* Do we have active buffer? */
+            if (IPD_BUFF_NEEDS_COPY(lwcell.m.ipd.buff)) {               /* Do we have active buffer? */
                 lwcell.m.ipd.buff->payload[lwcell.m.ipd.buff_ptr] = ch; /* Save data character */
+            } else if (lwcell.m.ipd.buff == NULL) {
+                LWCELL_STATS_ADD(ipd_dropped_bytes, 1);
             }
             ++lwcell.m.ipd.buff_ptr;
             --lwcell.m.ipd.rem_len;
@@ -1118,13 +3471,17 @@ lwcelli_process(const void* data, size_t data_len) {
             LWCELL_DEBUGF(LWCELL_CFG_DBG_IPD | LWCELL_DBG_TYPE_TRACE, "[LWCELL IPD] New length to read: %d bytes\r\n",
                           (int)len);
             if (len > 0) {
-                if (lwcell.m.ipd.buff != NULL) { /* Is buffer valid? */
+                if (IPD_BUFF_NEEDS_COPY(lwcell.m.ipd.buff)) { /* Is buffer valid? */
                     LWCELL_MEMCPY(&lwcell.m.ipd.buff->payload[lwcell.m.ipd.buff_ptr], d, len);
                     LWCELL_DEBUGF(LWCELL_CFG_DBG_IPD | LWCELL_DBG_TYPE_TRACE, "[LWCELL IPD] Bytes read: %d\r\n",
                                   (int)len);
+                } else if (lwcell.m.ipd.buff != NULL) { /* Data are already in referenced memory */
+                    LWCELL_DEBUGF(LWCELL_CFG_DBG_IPD | LWCELL_DBG_TYPE_TRACE, "[LWCELL IPD] Bytes referenced: %d\r\n",
+                                  (int)len);
                 } else { /* Simply skip the data in buffer */
                     LWCELL_DEBUGF(LWCELL_CFG_DBG_IPD | LWCELL_DBG_TYPE_TRACE, "[LWCELL IPD] Bytes skipped: %d\r\n",
                                   (int)len);
+                    LWCELL_STATS_ADD(ipd_dropped_bytes, len);
                 }
                 d_len -= len;                 /* Decrease effective length */
                 d += len;                     /* Skip remaining length */
@@ -1139,8 +3496,18 @@ lwcelli_process(const void* data, size_t data_len) {
 
                 /* Call user callback function with received data */
                 if (lwcell.m.ipd.buff != NULL) { /* Do we have valid buffer? */
+                    LWCELL_CONN_LOCK(lwcell.m.ipd.conn);
                     lwcell.m.ipd.conn->total_recved +=
                         lwcell.m.ipd.buff->tot_len; /* Increase number of bytes received */
+#if LWCELL_CFG_CONN_MANUAL_RECV
+                    /* Consume receive window, returned by application with lwcell_conn_recved */
+                    if (!lwcell.m.ipd.is_rxget) {
+                        lwcell.m.ipd.conn->rx_credit -=
+                            LWCELL_MIN(lwcell.m.ipd.conn->rx_credit, lwcell.m.ipd.buff->tot_len);
+                    }
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV */
+                    LWCELL_CONN_UNLOCK(lwcell.m.ipd.conn);
+                    LWCELL_STATS_ADD(conn_rx_bytes[lwcell.m.ipd.conn->num], lwcell.m.ipd.buff->tot_len);
 
                     /*
                      * Send data buffer to upper layer
@@ -1148,10 +3515,7 @@ lwcelli_process(const void* data, size_t data_len) {
                      * From this moment, user is responsible for packet
                      * buffer and must free it manually
                      */
-                    lwcell.evt.type = LWCELL_EVT_CONN_RECV;
-                    lwcell.evt.evt.conn_data_recv.buff = lwcell.m.ipd.buff;
-                    lwcell.evt.evt.conn_data_recv.conn = lwcell.m.ipd.conn;
-                    res = lwcelli_send_conn_cb(lwcell.m.ipd.conn, NULL);
+                    res = prv_conn_recv_cb(lwcell.m.ipd.conn, lwcell.m.ipd.buff);
 
                     lwcell_pbuf_free(lwcell.m.ipd.buff); /* Free packet buffer at this point */
                     LWCELL_DEBUGF(LWCELL_CFG_DBG_IPD | LWCELL_DBG_TYPE_TRACE, "[LWCELL IPD] Free packet buffer\r\n");
@@ -1174,10 +3538,10 @@ lwcelli_process(const void* data, size_t data_len) {
 
                         LWCELL_DEBUGF(LWCELL_CFG_DBG_IPD | LWCELL_DBG_TYPE_TRACE,
                                       "[LWCELL IPD] Allocating new packet buffer of size: %d bytes\r\n", (int)new_len);
-                        do {
-                            lwcell.m.ipd.buff = lwcell_pbuf_new(new_len); /* Allocate new packet buffer */
-                        } while (lwcell.m.ipd.buff == NULL
-                                 && (new_len = (new_len >> 1)) >= LWCELL_CFG_CONN_MIN_DATA_LEN);
+                        lwcell.m.ipd.buff = lwcelli_ipd_pbuf_new(new_len, d, d_len); /* Allocate new packet buffer */
+                        if (lwcell.m.ipd.buff == NULL) {
+                            LWCELL_STATS_ADD(pbuf_alloc_failed, 1);
+                        }
 
                         LWCELL_DEBUGW(LWCELL_CFG_DBG_IPD | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING,
                                       lwcell.m.ipd.buff == NULL,
@@ -1189,10 +3553,38 @@ lwcelli_process(const void* data, size_t data_len) {
                 if (lwcell.m.ipd.rem_len == 0) { /* Check if we read everything */
                     lwcell.m.ipd.buff = NULL;    /* Reset buffer pointer */
                     lwcell.m.ipd.read = 0;       /* Stop reading data */
+#if LWCELL_CFG_CONN_RECV_FROM
+                    lwcell.m.ipd.src_valid = 0; /* Address applies to single packet only */
+#endif                                          /* LWCELL_CFG_CONN_RECV_FROM */
+                    lwcelli_ipd_read_active(0);
                 }
                 lwcell.m.ipd.buff_ptr = 0; /* Reset input buffer pointer */
             }
 #endif /* LWCELL_CFG_CONN */
+#if LWCELL_CFG_HTTP || LWCELL_CFG_FTP || LWCELL_CFG_FS
+        } else if (CMD_IS_DATA_READ() && lwcell.msg->msg.data_read.read) {
+            /* Current character and rest of input, as long as it belongs to requested data */
+            size_t len = LWCELL_MIN(lwcell.msg->msg.data_read.rem_len, d_len + 1);
+
+            lwcelli_data_read_copy(d - 1, len);
+            d += len - 1;
+            d_len -= len - 1;
+            ch = *(d - 1); /* Last processed character */
+            lwcell.msg->msg.data_read.rem_len -= len;
+            if (lwcell.msg->msg.data_read.rem_len == 0) {
+                lwcell.msg->msg.data_read.read = 0;
+
+                /* For SHREAD, OK was received before data, finish command manually */
+                if (CMD_IS_CUR(LWCELL_CMD_SHREAD)) {
+                    strcpy(lwcell.parser.recv.data, "CUSTOM_OK\r\n");
+                    lwcell.parser.recv.len = strlen(lwcell.parser.recv.data);
+                    LWCELL_TRACE_HOOK(LWCELL_TRACE_PARSE, LWCELL_TRACE_BEGIN, lwcell.parser.recv.len);
+                    lwcelli_parse_received(&lwcell.parser.recv);
+                    LWCELL_TRACE_HOOK(LWCELL_TRACE_PARSE, LWCELL_TRACE_END, 0);
+                    RECV_RESET();
+                }
+            }
+#endif /* LWCELL_CFG_HTTP || LWCELL_CFG_FTP || LWCELL_CFG_FS */
             /*
              * Check if operators scan command is active
              * and if we are ready to read the incoming data
@@ -1204,6 +3596,25 @@ lwcelli_process(const void* data, size_t data_len) {
                 lwcelli_parse_cops_scan(ch, 0); /* Parse character by character */
             }
 #if LWCELL_CFG_SMS
+#if LWCELL_CFG_SMS_DIRECT
+        } else if (lwcell.m.sms.direct_read) {
+            lwcell_sms_entry_t* e = &lwcell.m.sms.direct;
+
+            if (ch == '\n' && lwcell.parser.ch_prev1 == '\r') {
+                if (e->length > 0 && e->data[e->length - 1] == '\r') {
+                    --e->length; /* Strip carriage return */
+                }
+                e->data[e->length] = 0;
+                lwcell.m.sms.direct_read = 0;
+
+                lwcell.evt.evt.sms_recv.mem = LWCELL_MEM_UNKNOWN;
+                lwcell.evt.evt.sms_recv.pos = 0;
+                lwcell.evt.evt.sms_recv.entry = e;
+                lwcelli_send_cb(LWCELL_EVT_SMS_RECV);
+            } else if (e->length < (sizeof(e->data) - 1)) {
+                e->data[e->length++] = ch;
+            }
+#endif /* LWCELL_CFG_SMS_DIRECT */
         } else if (CMD_IS_CUR(LWCELL_CMD_CMGR) && lwcell.msg->msg.sms_read.read) {
             lwcell_sms_entry_t* e = lwcell.msg->msg.sms_read.entry;
             if (lwcell.msg->msg.sms_read.read == 2) { /* Read only if set to 2 */
@@ -1215,19 +3626,27 @@ lwcelli_process(const void* data, size_t data_len) {
                     lwcell.msg->msg.sms_read.read = 1; /* Read but ignore data */
                 }
             }
-            if (ch == '\n' && ch_prev1 == '\r') {
+            if (ch == '\n' && lwcell.parser.ch_prev1 == '\r') {
                 if (lwcell.msg->msg.sms_read.read == 2) {}
                 lwcell.msg->msg.sms_read.read = 0;
             }
         } else if (CMD_IS_CUR(LWCELL_CMD_CMGL) && lwcell.msg->msg.sms_list.read) {
+            lwcell_sms_entry_t* e = NULL;
+
             if (lwcell.msg->msg.sms_list.read == 2) {
-                lwcell_sms_entry_t* e = &lwcell.msg->msg.sms_list.entries[lwcell.msg->msg.sms_list.ei];
+                e = lwcell.msg->msg.sms_list.entries;
+                if (lwcell.msg->msg.sms_list.entry_fn == NULL) { /* Every message has its own array entry */
+                    e += lwcell.msg->msg.sms_list.ei;
+                }
                 if (e->length < (sizeof(e->data) - 1)) {
                     e->data[e->length++] = ch;
                 }
             }
-            if (ch == '\n' && ch_prev1 == '\r') {
-                if (lwcell.msg->msg.sms_list.read == 2) {
+            if (ch == '\n' && lwcell.parser.ch_prev1 == '\r') {
+                if (e != NULL) {
+                    if (lwcell.msg->msg.sms_list.entry_fn != NULL) { /* Entry is complete, emit it */
+                        lwcell.msg->msg.sms_list.entry_fn(e, lwcell.msg->msg.sms_list.entry_arg);
+                    }
                     ++lwcell.msg->msg.sms_list.ei;             /* Go to next entry */
                     if (lwcell.msg->msg.sms_list.er != NULL) { /* Check and update user variable */
                         *lwcell.msg->msg.sms_list.er = lwcell.msg->msg.sms_list.ei;
@@ -1238,99 +3657,188 @@ lwcelli_process(const void* data, size_t data_len) {
 #endif /* LWCELL_CFG_SMS */
 #if LWCELL_CFG_USSD
         } else if (CMD_IS_CUR(LWCELL_CMD_CUSD) && lwcell.msg->msg.ussd.read) {
-            if (ch == '"') {
-                lwcell.msg->msg.ussd.resp[lwcell.msg->msg.ussd.resp_write_ptr] = 0;
-                lwcell.msg->msg.ussd.quote_det = !lwcell.msg->msg.ussd.quote_det;
-            } else if (lwcell.msg->msg.ussd.quote_det) {
-                if (lwcell.msg->msg.ussd.resp_write_ptr < lwcell.msg->msg.ussd.resp_len) {
-                    lwcell.msg->msg.ussd.resp[lwcell.msg->msg.ussd.resp_write_ptr++] = ch;
-                    lwcell.msg->msg.ussd.resp[lwcell.msg->msg.ussd.resp_write_ptr] = 0;
-                }
-            } else if (ch == '\n' && ch_prev1 == '\r') {
-                /* End of reading, command finished! */
-                /* Return OK at this point! */
-                strcpy(recv_buff.data, "CUSTOM_OK\r\n");
-                recv_buff.len = strlen(recv_buff.data);
-                lwcelli_parse_received(&recv_buff);
-            }
+            /* Current character and rest of input, up to the end of response string or field */
+            size_t len = lwcelli_ussd_read(d - 1, d_len + 1);
+
+            d += len - 1;
+            d_len -= len - 1;
+            ch = *(d - 1); /* Last processed character */
 #endif /* LWCELL_CFG_USSD */
+#if LWCELL_CFG_AT_ECHO_SKIP
+        } else if (lwcell.parser.echo.match > 0
+                   || (lwcell.parser.recv.len == 0 && lwcell.parser.echo.len > 0 && !lwcell.parser.echo.record
+                       && (char)ch == lwcell.parser.echo.cmd[0])) {
+            /* Echo of sent command is dropped before it reaches line parser */
+            size_t len = prv_echo_skip(d - 1, d_len + 1);
+
+            if (len == 0) { /* Current character belongs to the line, process it again */
+                --d;
+                ++d_len;
+                continue;
+            }
+            d += len - 1;
+            d_len -= len - 1;
+            if (len > 1) {
+                lwcell.parser.ch_prev1 = *(d - 2);
+            }
+            ch = *(d - 1); /* Last processed character */
+#endif /* LWCELL_CFG_AT_ECHO_SKIP */
             /*
              * We are in command mode where we have to process byte by byte
              * Simply check for ASCII and unicode format and process data accordingly
              */
         } else {
             lwcellr_t res = lwcellERR;
+
+#if LWCELL_CFG_CONN
+            /* Connection data header at the beginning of line goes directly to connection data read */
+            if (ch == '+' && lwcell.parser.recv.len == 0) {
+                size_t len = lwcelli_parse_ipd_header(d - 1, d_len + 1);
+
+                if (len > 0) {
+                    LWCELL_STATS_ADD(lines, 1);
+                    LWCELL_STATS_ADD(urc_lines, 1);
+                    d += len - 1; /* Current character was already consumed */
+                    d_len -= len - 1;
+                    lwcell.parser.ch_prev2 = '\r';
+                    lwcell.parser.ch_prev1 = '\n';
+                    prv_ipd_start_read(d, d_len);
+                    continue;
+                }
+            }
+#endif /* LWCELL_CFG_CONN */
+
+            /*
+             * Fast path for plain ASCII characters in the middle of the line
+             *
+             * Only new line and prompt characters have meaning for the state machine,
+             * everything before them can be copied to receive buffer at once.
+             * Commands which inspect receive buffer after every character are excluded
+             */
+            if (ch != '\n' && ch != '>' && lwcell.parser.ch_prev1 != '>' && LWCELL_ISVALIDASCII(ch)
+                && !CMD_IS_CUR(LWCELL_CMD_COPS_GET_OPT)
+#if LWCELL_CFG_USSD
+                && !CMD_IS_CUR(LWCELL_CMD_CUSD)
+#endif /* LWCELL_CFG_USSD */
+#if LWCELL_CFG_CONN_CA_SOCKET
+                && !(CONN_DRV()->read_inline && CMD_IS_CUR(LWCELL_CMD_CIPRXGET)) /* Data start after header comma */
+#endif /* LWCELL_CFG_CONN_CA_SOCKET */
+            ) {
+                const uint8_t* s = d - 1; /* Start of the run, including current character */
+                size_t run_len, copy_len;
+
+                run_len = 1 + lwcelli_unicode_ascii_run(d, d_len); /* Check rest of input a word at a time */
+
+                /* Copy as much as fits, rest of the line is accounted the same way as with RECV_ADD */
+                copy_len = LWCELL_MIN(run_len, sizeof(lwcell.parser.recv.data) - 1 - lwcell.parser.recv.len);
+                if (copy_len > 0) {
+                    LWCELL_MEMCPY(&lwcell.parser.recv.data[lwcell.parser.recv.len], s, copy_len);
+                    lwcell.parser.recv.len += copy_len;
+                }
+                if (copy_len < run_len) {
+                    prv_recv_overflow((const char*)&s[copy_len], run_len - copy_len);
+                }
+                lwcell.parser.unicode.t = 1; /* Plain ASCII resets unicode decoder */
+                lwcell.parser.unicode.r = 0;
+
+                lwcell.parser.ch_prev2 = run_len > 1 ? s[run_len - 2] : lwcell.parser.ch_prev1;
+                lwcell.parser.ch_prev1 = s[run_len - 1];
+                d += run_len - 1; /* Current character was already consumed */
+                d_len -= run_len - 1;
+                continue;
+            }
             if (LWCELL_ISVALIDASCII(ch)) { /* Manually check if valid ASCII character */
                 res = lwcellOK;
-                unicode.t = 1;                              /* Manually set total to 1 */
-                unicode.r = 0;                              /* Reset remaining bytes */
-            } else if (ch >= 0x80) {                        /* Process only if more than ASCII can hold */
-                res = lwcelli_unicode_decode(&unicode, ch); /* Try to decode unicode format */
+                lwcell.parser.unicode.t = 1;                              /* Manually set total to 1 */
+                lwcell.parser.unicode.r = 0;                              /* Reset remaining bytes */
+            } else if (ch >= 0x80) {                                      /* Process only if more than ASCII can hold */
+                res = lwcelli_unicode_decode(&lwcell.parser.unicode, ch); /* Try to decode unicode format */
             }
 
             if (res == lwcellERR) { /* In case of an ERROR */
-                unicode.r = 0;
+                lwcell.parser.unicode.r = 0;
             }
-            if (res == lwcellOK) {    /* Can we process the character(s) */
-                if (unicode.t == 1) { /* Totally 1 character? */
-                    RECV_ADD(ch);     /* Any ASCII valid character */
+            if (res == lwcellOK) {                  /* Can we process the character(s) */
+                if (lwcell.parser.unicode.t == 1) { /* Totally 1 character? */
+                    RECV_ADD(ch);                   /* Any ASCII valid character */
                     if (ch == '\n') {
-                        lwcelli_parse_received(&recv_buff); /* Parse received string */
-                        RECV_RESET();                       /* Reset received string */
+                        RECV_TERM();
+                        LWCELL_TRACE_HOOK(LWCELL_TRACE_PARSE, LWCELL_TRACE_BEGIN, lwcell.parser.recv.len);
+                        lwcelli_parse_received(&lwcell.parser.recv); /* Parse received string */
+                        LWCELL_TRACE_HOOK(LWCELL_TRACE_PARSE, LWCELL_TRACE_END, 0);
+                        RECV_RESET(); /* Reset received string */
+#if LWCELL_CFG_PPP
+                        if (lwcelli_ppp_input(d, d_len)) { /* "CONNECT" received, rest is PPP data */
+                            d_len = 0;
+                            continue;
+                        }
+#endif /* LWCELL_CFG_PPP */
+                    }
+
+#if LWCELL_CFG_CONN_CA_SOCKET
+                    /* Socket read data follow header on the same line, right after comma */
+                    if (ch == ',' && CMD_IS_CUR(LWCELL_CMD_CIPRXGET) && RECV_LEN() > 9
+                        && !strncmp(lwcell.parser.recv.data, "+CARECV: ", 9)) {
+                        RECV_TERM();
+                        lwcelli_parse_carecv(lwcell.parser.recv.data);
+                        RECV_RESET();
                     }
+#endif /* LWCELL_CFG_CONN_CA_SOCKET */
 
 #if LWCELL_CFG_CONN
                     /* Check if we have to read data */
-                    if (ch == '\n' && lwcell.m.ipd.read) {
-                        size_t len;
-                        LWCELL_DEBUGF(LWCELL_CFG_DBG_IPD | LWCELL_DBG_TYPE_TRACE,
-                                      "[LWCELL IPD] Data on connection %d with total size %d byte(s)\r\n",
-                                      (int)lwcell.m.ipd.conn->num, (int)lwcell.m.ipd.tot_len);
-
-                        len = LWCELL_MIN(lwcell.m.ipd.rem_len, LWCELL_CFG_CONN_MAX_DATA_LEN);
-
-                        /*
-                         * Read received data in case of:
-                         *
-                         *  - Connection is active and
-                         *  - Connection is not in closing mode
-                         */
-                        if (lwcell.m.ipd.conn->status.f.active && !lwcell.m.ipd.conn->status.f.in_closing) {
-                            do {
-                                lwcell.m.ipd.buff = lwcell_pbuf_new(len); /* Allocate new packet buffer */
-                            } while (lwcell.m.ipd.buff == NULL && (len = (len >> 1)) >= LWCELL_CFG_CONN_MIN_DATA_LEN);
-                            LWCELL_DEBUGW(LWCELL_CFG_DBG_IPD | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING,
-                                          lwcell.m.ipd.buff == NULL,
-                                          "[LWCELL IPD] Buffer allocation failed for %d byte(s)\r\n", (int)len);
-                        } else {
-                            lwcell.m.ipd.buff = NULL; /* Ignore reading on closed connection */
-                            LWCELL_DEBUGF(LWCELL_CFG_DBG_IPD | LWCELL_DBG_TYPE_TRACE,
-                                          "[LWCELL IPD] Connection %d closed or in closing, skipping %d byte(s)\r\n",
-                                          (int)lwcell.m.ipd.conn->num, (int)len);
-                        }
-                        lwcell.m.ipd.conn->status.f.data_received = 1; /* We have first received data */
-                        lwcell.m.ipd.buff_ptr = 0;                     /* Reset buffer write pointer */
+                    if ((ch == '\n' || ch == ',') && lwcell.m.ipd.read) {
+                        prv_ipd_start_read(d, d_len);
                     }
 #endif /* LWCELL_CFG_CONN */
 
+#if LWCELL_CFG_MQTT
+                    /* Publish prompt is a single ">" character at the beginning of line */
+                    if (ch == '>' && lwcell.parser.ch_prev1 == '\n' && CMD_IS_CUR(LWCELL_CMD_SMPUB)) {
+                        RECV_RESET(); /* Reset received object */
+                        AT_PORT_SEND(lwcell.msg->msg.mqtt_pub.data, lwcell.msg->msg.mqtt_pub.data_len);
+                        AT_PORT_SEND_FLUSH();
+                    }
+#endif /* LWCELL_CFG_MQTT */
+
                     /*
                      * Do we have a special sequence "> "?
                      *
                      * Check if any command active which may expect that kind of response
                      */
-                    if (ch_prev2 == '\n' && ch_prev1 == '>' && ch == ' ') {
+                    if (lwcell.parser.ch_prev2 == '\n' && lwcell.parser.ch_prev1 == '>' && ch == ' ') {
                         if (0) {
 #if LWCELL_CFG_CONN
                         } else if (CMD_IS_CUR(LWCELL_CMD_CIPSEND)) {
                             RECV_RESET(); /* Reset received object */
 
                             /* Now actually send the data prepared before */
-                            AT_PORT_SEND_WITH_FLUSH(&lwcell.msg->msg.conn_send.data[lwcell.msg->msg.conn_send.ptr],
-                                                    lwcell.msg->msg.conn_send.sent);
+                            LWCELL_TRACE_HOOK(LWCELL_TRACE_DATA_TX, LWCELL_TRACE_BEGIN,
+                                              lwcell.msg->msg.conn_send.sent);
+                            lwcelli_tcpip_write_data();
+                            LWCELL_TRACE_HOOK(LWCELL_TRACE_DATA_TX, LWCELL_TRACE_END, 0);
                             lwcell.msg->msg.conn_send.wait_send_ok_err =
                                 1; /* Now we are waiting for "SEND OK" or "SEND ERROR" */
 #endif                             /* LWCELL_CFG_CONN */
 #if LWCELL_CFG_SMS
+#if LWCELL_CFG_SMS_PDU
+                        } else if (CMD_IS_CUR(LWCELL_CMD_CMGS) && !lwcell.msg->msg.sms_send.format) {
+                            uint8_t pdu[LWCELL_SMS_PDU_MAX_LEN];
+                            char hex[33];
+                            size_t pdu_len = lwcelli_sms_pdu_encode_part(lwcell.msg, pdu);
+
+                            /* Send PDU in hex format, small chunks to keep stack usage low */
+                            for (size_t i = 0, h = 0; i < pdu_len; ++i) {
+                                lwcell_u8_to_hex_str(pdu[i], &hex[h], 2);
+                                h += 2;
+                                if (h == sizeof(hex) - 1 || i + 1 == pdu_len) {
+                                    AT_PORT_SEND(hex, h);
+                                    h = 0;
+                                }
+                            }
+                            AT_PORT_SEND_CTRL_Z();
+                            AT_PORT_SEND_FLUSH();
+#endif /* LWCELL_CFG_SMS_PDU */
                         } else if (CMD_IS_CUR(LWCELL_CMD_CMGS)) { /* Send SMS? */
                             AT_PORT_SEND(lwcell.msg->msg.sms_send.text, strlen(lwcell.msg->msg.sms_send.text));
                             AT_PORT_SEND_CTRL_Z();
@@ -1338,14 +3846,14 @@ lwcelli_process(const void* data, size_t data_len) {
 #endif /* LWCELL_CFG_SMS */
                         }
                     } else if (CMD_IS_CUR(LWCELL_CMD_COPS_GET_OPT)) {
-                        if (RECV_LEN() > 5 && !strncmp(recv_buff.data, "+COPS:", 6)) {
+                        if (RECV_LEN() > 5 && !strncmp(lwcell.parser.recv.data, "+COPS:", 6)) {
                             RECV_RESET();                       /* Reset incoming buffer */
                             lwcelli_parse_cops_scan(0, 1);      /* Reset parser state */
                             lwcell.msg->msg.cops_scan.read = 1; /* Start reading incoming bytes */
                         }
 #if LWCELL_CFG_USSD
                     } else if (CMD_IS_CUR(LWCELL_CMD_CUSD)) {
-                        if (RECV_LEN() > 5 && !strncmp(recv_buff.data, "+CUSD:", 6)) {
+                        if (RECV_LEN() > 5 && !strncmp(lwcell.parser.recv.data, "+CUSD:", 6)) {
                             RECV_RESET();                  /* Reset incoming buffer */
                             lwcell.msg->msg.ussd.read = 1; /* Start reading incoming bytes */
                         }
@@ -1357,8 +3865,8 @@ lwcelli_process(const void* data, size_t data_len) {
                      * so it is safe to just add them to receive array without checking
                      * what are the actual values
                      */
-                    for (uint8_t i = 0; i < unicode.t; ++i) {
-                        RECV_ADD(unicode.ch[i]); /* Add character to receive array */
+                    for (uint8_t i = 0; i < lwcell.parser.unicode.t; ++i) {
+                        RECV_ADD(lwcell.parser.unicode.ch[i]); /* Add character to receive array */
                     }
                 }
             } else if (res != lwcellINPROG) { /* Not in progress? */
@@ -1366,26 +3874,424 @@ lwcelli_process(const void* data, size_t data_len) {
             }
         }
 
-        ch_prev2 = ch_prev1; /* Save previous character as previous previous */
-        ch_prev1 = ch;       /* Set current as previous */
+        lwcell.parser.ch_prev2 = lwcell.parser.ch_prev1; /* Save previous character as previous previous */
+        lwcell.parser.ch_prev1 = ch;                     /* Set current as previous */
+    }
+#if LWCELL_CFG_CONN_RECV_BATCH > 0
+    prv_conn_recv_batch_flush(); /* Deliver packets completed in this block */
+#endif                           /* LWCELL_CFG_CONN_RECV_BATCH > 0 */
+#if LWCELL_CFG_STATS
+    lwcelli_stats_parse_time(lwcell_sys_now() - time_start);
+#endif /* LWCELL_CFG_STATS */
+    return lwcellOK;
+}
+
+#if LWCELL_CFG_INPUT_ZERO_COPY || __DOXYGEN__
+
+/**
+ * \brief           Process input data received from GSM device, stored in memory lent by driver
+ *
+ * Connection data fully available in input memory are referenced by packet buffers instead of copied.
+ * `release_fn` is called for every referenced region once packet buffer is freed.
+ *
+ * \param[in]       data: Pointer to data to process
+ * \param[in]       data_len: Length of data to process in units of bytes
+ * \param[in]       release_fn: Function called when referenced memory is not used anymore
+ * \param[in]       arg: Custom argument for release function
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcelli_process_ref(const void* data, size_t data_len, lwcell_pbuf_release_fn release_fn, void* arg) {
+    lwcellr_t res;
+
+#if LWCELL_CFG_CONN
+    lwcell.parser.ipd_lend.release_fn = release_fn;
+    lwcell.parser.ipd_lend.arg = arg;
+    lwcell.parser.ipd_lend.active = 1;
+#else  /* LWCELL_CFG_CONN */
+    LWCELL_UNUSED(release_fn);
+    LWCELL_UNUSED(arg);
+#endif /* !LWCELL_CFG_CONN */
+    LWCELL_TRACE_HOOK(LWCELL_TRACE_INPUT, LWCELL_TRACE_BEGIN, data_len);
+    res = lwcelli_process(data, data_len);
+    LWCELL_TRACE_HOOK(LWCELL_TRACE_INPUT, LWCELL_TRACE_END, 0);
+#if LWCELL_CFG_CONN
+    lwcell.parser.ipd_lend.active = 0;
+#endif /* LWCELL_CFG_CONN */
+    return res;
+}
+
+#endif /* LWCELL_CFG_INPUT_ZERO_COPY || __DOXYGEN__ */
+
+/* Temporary macros, only available for inside lwcelli_process_sub_cmd function */
+/* Set new command, but first check for error on previous */
+#define SET_NEW_CMD_CHECK_ERROR(new_cmd)                                                                               \
+    do {                                                                                                               \
+        if (!stat->is_error) {                                                                                         \
+            n_cmd = (new_cmd);                                                                                         \
+        }                                                                                                              \
+    } while (0)
+
+/* Set new command, ignore result of previous */
+#define SET_NEW_CMD(new_cmd)                                                                                           \
+    do {                                                                                                               \
+        n_cmd = (new_cmd);                                                                                             \
+    } while (0)
+
+/* Sub-command step flags */
+#define SUB_STEP_CHECK_ERROR 0x01 /*!< Start step only when previous command did not report error */
+#define SUB_STEP_CHECK_OK    0x02 /*!< Start step only when previous command reported success */
+
+/**
+ * \brief           Single step of multi-step command sequence
+ */
+typedef struct {
+    lwcell_cmd_t cmd; /*!< Command to start in this step */
+    uint8_t flags;    /*!< Condition for previous command result, `SUB_STEP_*` flags */
+} lwcelli_sub_step_t;
+
+#if LWCELL_CFG_NETWORK || LWCELL_CFG_DEVICE_INFO_CACHE || LWCELL_CFG_SMS || LWCELL_CFG_PHONEBOOK
+
+/**
+ * \brief           Get command of sequence step, if its condition on previous result is satisfied
+ * \param[in]       steps: Sequence table
+ * \param[in]       len: Number of steps in table
+ * \param[in]       idx: Step index to start
+ * \param[in]       stat: Status of previous command
+ * \return          Command to start or \ref LWCELL_CMD_IDLE when sequence is finished
+ */
+static lwcell_cmd_t
+prv_sub_step_get(const lwcelli_sub_step_t* steps, size_t len, size_t idx, const lwcell_status_flags_t* stat) {
+    if (idx >= len || ((steps[idx].flags & SUB_STEP_CHECK_ERROR) && stat->is_error)
+        || ((steps[idx].flags & SUB_STEP_CHECK_OK) && !stat->is_ok)) {
+        return LWCELL_CMD_IDLE;
+    }
+    return steps[idx].cmd;
+}
+
+#endif /* LWCELL_CFG_NETWORK || LWCELL_CFG_DEVICE_INFO_CACHE || LWCELL_CFG_SMS || LWCELL_CFG_PHONEBOOK */
+
+#if LWCELL_CFG_DEVICE_INFO_CACHE || LWCELL_CFG_SMS || LWCELL_CFG_PHONEBOOK
+
+/**
+ * \brief           Get command following current command in sequence table
+ * \note            Each command may appear only once in the table
+ * \param[in]       steps: Sequence table
+ * \param[in]       len: Number of steps in table
+ * \param[in]       stat: Status of current command
+ * \return          Command to start or \ref LWCELL_CMD_IDLE when sequence is finished
+ */
+static lwcell_cmd_t
+prv_sub_step_next(const lwcelli_sub_step_t* steps, size_t len, const lwcell_status_flags_t* stat) {
+    for (size_t i = 0; i < len; ++i) {
+        if (CMD_IS_CUR(steps[i].cmd)) {
+            return prv_sub_step_get(steps, len, i + 1, stat);
+        }
+    }
+    return LWCELL_CMD_IDLE;
+}
+
+#endif /* LWCELL_CFG_DEVICE_INFO_CACHE || LWCELL_CFG_SMS || LWCELL_CFG_PHONEBOOK */
+
+#if LWCELL_CFG_DEVICE_INFO_CACHE
+/* Refresh of all device info strings */
+static const lwcelli_sub_step_t sub_seq_device_info[] = {
+    {LWCELL_CMD_CGMI_GET, 0},
+    {LWCELL_CMD_CGMM_GET, SUB_STEP_CHECK_ERROR},
+    {LWCELL_CMD_CGSN_GET, SUB_STEP_CHECK_ERROR},
+    {LWCELL_CMD_CGMR_GET, SUB_STEP_CHECK_ERROR},
+};
+#endif /* LWCELL_CFG_DEVICE_INFO_CACHE */
+
+#if LWCELL_CFG_SMS
+/* Read SMS message */
+static const lwcelli_sub_step_t sub_seq_sms_read[] = {
+    {LWCELL_CMD_CPMS_GET, 0},
+    {LWCELL_CMD_CPMS_SET, SUB_STEP_CHECK_OK},
+    {LWCELL_CMD_CMGF, SUB_STEP_CHECK_OK},
+    {LWCELL_CMD_CMGR, SUB_STEP_CHECK_OK},
+};
+
+/* Delete SMS message */
+static const lwcelli_sub_step_t sub_seq_sms_delete[] = {
+    {LWCELL_CMD_CPMS_GET, 0},
+    {LWCELL_CMD_CPMS_SET, SUB_STEP_CHECK_OK},
+    {LWCELL_CMD_CMGD, SUB_STEP_CHECK_OK},
+};
+
+/* Delete all SMS messages */
+static const lwcelli_sub_step_t sub_seq_sms_delete_all[] = {
+    {LWCELL_CMD_CMGF, 0},
+    {LWCELL_CMD_CMGDA, SUB_STEP_CHECK_OK},
+};
+
+/* List SMS messages */
+static const lwcelli_sub_step_t sub_seq_sms_list[] = {
+    {LWCELL_CMD_CPMS_GET, 0},
+    {LWCELL_CMD_CPMS_SET, SUB_STEP_CHECK_OK},
+    {LWCELL_CMD_CMGF, SUB_STEP_CHECK_OK},
+    {LWCELL_CMD_CMGL, SUB_STEP_CHECK_OK},
+};
+
+/* Set preferred SMS memory */
+static const lwcelli_sub_step_t sub_seq_sms_mem[] = {
+    {LWCELL_CMD_CPMS_GET, 0},
+    {LWCELL_CMD_CPMS_SET, SUB_STEP_CHECK_OK},
+};
+#endif /* LWCELL_CFG_SMS */
+
+#if LWCELL_CFG_PHONEBOOK
+/* Select phonebook memory and search entries */
+static const lwcelli_sub_step_t sub_seq_pb_search[] = {
+    {LWCELL_CMD_CPBS_GET, 0},
+    {LWCELL_CMD_CPBS_SET, SUB_STEP_CHECK_OK},
+    {LWCELL_CMD_CPBF, SUB_STEP_CHECK_OK},
+};
+#endif /* LWCELL_CFG_PHONEBOOK */
+
+#if LWCELL_CFG_NETWORK
+/* Network attach, indexed by subcommand order number or by attach step */
+static const lwcelli_sub_step_t sub_seq_network_attach[] = {
+    {LWCELL_CMD_CGACT_SET_0, SUB_STEP_CHECK_ERROR},
+    {LWCELL_CMD_CGACT_SET_1, 0},
+#if LWCELL_CFG_NETWORK_IGNORE_CGACT_RESULT
+    {LWCELL_CMD_CGATT_SET_0, 0},
+#else  /* LWCELL_CFG_NETWORK_IGNORE_CGACT_RESULT */
+    {LWCELL_CMD_CGATT_SET_0, SUB_STEP_CHECK_ERROR},
+#endif /* !LWCELL_CFG_NETWORK_IGNORE_CGACT_RESULT */
+    {LWCELL_CMD_CGATT_SET_1, 0},
+    {LWCELL_CMD_CIPSHUT, SUB_STEP_CHECK_ERROR},
+    {LWCELL_CMD_CIPMUX_SET, SUB_STEP_CHECK_ERROR},
+    {LWCELL_CMD_CIPRXGET_SET, SUB_STEP_CHECK_ERROR},
+#if LWCELL_CFG_CONN_QUICK_SEND
+    {LWCELL_CMD_CIPQSEND_SET, SUB_STEP_CHECK_ERROR},
+#endif /* LWCELL_CFG_CONN_QUICK_SEND */
+#if LWCELL_CFG_CONN_RECV_FROM
+    {LWCELL_CMD_CIPSRIP, SUB_STEP_CHECK_ERROR},
+#endif /* LWCELL_CFG_CONN_RECV_FROM */
+    {LWCELL_CMD_CSTT_SET, SUB_STEP_CHECK_ERROR},
+    {LWCELL_CMD_CIICR, SUB_STEP_CHECK_ERROR},
+    {LWCELL_CMD_CIFSR, SUB_STEP_CHECK_ERROR},
+    {LWCELL_CMD_CIPSTATUS, 0},
+};
+
+/* Network detach, indexed by subcommand order number */
+static const lwcelli_sub_step_t sub_seq_network_detach[] = {
+    {LWCELL_CMD_CGATT_SET_0, 0},
+    {LWCELL_CMD_CGACT_SET_0, 0},
+#if LWCELL_CFG_CONN
+    {LWCELL_CMD_CIPSTATUS, 0},
+#endif /* LWCELL_CFG_CONN */
+};
+#endif /* LWCELL_CFG_NETWORK */
+
+#if LWCELL_CFG_RESET_FAST_BOOT || __DOXYGEN__
+
+/* Maximal number of device polls in fast-boot reset sequence */
+#define RESET_POLL_MAX (LWCELL_CFG_RESET_DELAY_AFTER / LWCELL_CFG_RESET_POLL_INTERVAL)
+
+/**
+ * \brief           Repeat first command of reset sequence when device did not reply in time
+ * \param[in]       arg: Reset message which started the poll
+ */
+static void
+lwcelli_reset_poll_timeout_fn(void* arg) {
+    lwcell_msg_t* msg = arg;
+
+    if (lwcell.msg != msg || !CMD_IS_DEF(LWCELL_CMD_RESET)
+        || !(CMD_IS_CUR(LWCELL_CMD_ATE0) || CMD_IS_CUR(LWCELL_CMD_ATE1))) {
+        return; /* Device replied or command is gone */
+    }
+    if (++msg->msg.reset.polls < RESET_POLL_MAX) {
+        RECV_RESET(); /* Drop partial boot output */
+        if (msg->fn(msg) == lwcellOK) {
+            lwcell_timeout_add(LWCELL_CFG_RESET_POLL_INTERVAL, lwcelli_reset_poll_timeout_fn, msg);
+        }
+    }
+}
+
+/**
+ * \brief           Check persisted identity against serial number read from device
+ * \return          `1` if identity matches and was applied, `0` otherwise
+ */
+static uint8_t
+lwcelli_reset_identity_apply(void) {
+    lwcell_device_identity_t id;
+
+    LWCELL_MEMSET(&id, 0x00, sizeof(id));
+    if (lwcell.identity_fn == NULL || !lwcell.identity_fn(&id, 0, lwcell.identity_arg)
+        || strncmp(id.serial, lwcell.m.model_serial_number, sizeof(id.serial)) != 0) {
+        return 0;
+    }
+    LWCELL_MEMCPY(lwcell.m.model_manufacturer, id.manufacturer, sizeof(lwcell.m.model_manufacturer));
+    LWCELL_MEMCPY(lwcell.m.model_number, id.model, sizeof(lwcell.m.model_number));
+    LWCELL_MEMCPY(lwcell.m.model_revision, id.revision, sizeof(lwcell.m.model_revision));
+    lwcell.m.model_manufacturer[sizeof(lwcell.m.model_manufacturer) - 1] = 0;
+    lwcell.m.model_number[sizeof(lwcell.m.model_number) - 1] = 0;
+    lwcell.m.model_revision[sizeof(lwcell.m.model_revision) - 1] = 0;
+    lwcelli_device_model_from_number();
+    return 1;
+}
+
+/**
+ * \brief           Pass identity queried from device to application to persist it
+ */
+static void
+lwcelli_reset_identity_store(void) {
+    lwcell_device_identity_t id;
+
+    if (lwcell.identity_fn == NULL) {
+        return;
+    }
+    LWCELL_MEMCPY(id.manufacturer, lwcell.m.model_manufacturer, sizeof(id.manufacturer));
+    LWCELL_MEMCPY(id.model, lwcell.m.model_number, sizeof(id.model));
+    LWCELL_MEMCPY(id.serial, lwcell.m.model_serial_number, sizeof(id.serial));
+    LWCELL_MEMCPY(id.revision, lwcell.m.model_revision, sizeof(id.revision));
+    lwcell.identity_fn(&id, 1, lwcell.identity_arg);
+}
+
+#endif /* LWCELL_CFG_RESET_FAST_BOOT || __DOXYGEN__ */
+
+#if LWCELL_CFG_OPERATOR_CACHE || __DOXYGEN__
+
+/**
+ * \brief           Select cached operator after reset, or numeric operator format to learn it
+ *
+ * Command is queued after reset command and is executed once reset finishes
+ */
+static void
+lwcelli_reset_operator_select(void) {
+    uint32_t num = 0;
+
+    if (lwcell.operator_cache_fn == NULL) {
+        return;
+    }
+    if (lwcell.operator_cache_fn(&num, 0, lwcell.operator_cache_arg) && num != 0) {
+        lwcell.operator_cache_num = num;
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_TYPE_TRACE, "[LWCELL] Selecting cached operator %u\r\n",
+                      (unsigned)num);
+        lwcell_operator_set(LWCELL_OPERATOR_MODE_MANUAL_AUTO, LWCELL_OPERATOR_FORMAT_NUMBER, NULL, num, NULL, NULL, 0);
+    } else {
+        lwcell_operator_set(LWCELL_OPERATOR_MODE_FORMAT, LWCELL_OPERATOR_FORMAT_NUMBER, NULL, 0, NULL, NULL, 0);
+    }
+}
+
+#endif /* LWCELL_CFG_OPERATOR_CACHE || __DOXYGEN__ */
+
+#if LWCELL_CFG_AT_PORT_BAUDRATE_UPSHIFT || __DOXYGEN__
+
+/* Link verification poll interval and maximal number of polls after rate change and after fallback */
+#define BAUD_CHECK_INTERVAL       200
+#define BAUD_CHECK_POLLS          3
+#define BAUD_CHECK_FALLBACK_POLLS (LWCELL_CFG_RESET_DELAY_AFTER / BAUD_CHECK_INTERVAL + 1)
+
+/* Baudrate candidates for upshift */
+static const uint32_t baud_candidates[] = {LWCELL_CFG_AT_PORT_BAUDRATE_LIST};
+
+/**
+ * \brief           Reconfigure low-level AT port rate
+ * \param[in]       baudrate: New baudrate
+ */
+static void
+lwcelli_reset_baud_apply(uint32_t baudrate) {
+    if (lwcell.ll.uart.baudrate != baudrate) {
+        lwcell.ll.uart.baudrate = baudrate;
+        lwcell_ll_init(&lwcell.ll);
+        RECV_RESET(); /* Drop characters received during reconfiguration */
+    }
+}
+
+/**
+ * \brief           Get next command to try baudrate upshift with
+ * \param[in]       msg: Reset message
+ * \return          Command to execute next
+ */
+static lwcell_cmd_t
+lwcelli_reset_baud_next(lwcell_msg_t* msg) {
+    while (msg->msg.reset.baud_idx < LWCELL_ARRAYSIZE(baud_candidates)
+           && baud_candidates[msg->msg.reset.baud_idx] <= LWCELL_CFG_AT_PORT_BAUDRATE) {
+        ++msg->msg.reset.baud_idx; /* Skip candidates which are no upshift */
+    }
+    if (msg->msg.reset.baud_idx < LWCELL_ARRAYSIZE(baud_candidates)) {
+        return LWCELL_CMD_UART;
+    }
+    return LWCELL_CMD_CFUN_SET; /* Continue reset sequence at current rate */
+}
+
+/**
+ * \brief           Repeat link verification or fall back to default rate when device did not reply
+ * \param[in]       arg: Reset message which started the verification
+ */
+static void
+lwcelli_reset_baud_timeout_fn(void* arg) {
+    lwcell_msg_t* msg = arg;
+
+    if (lwcell.msg != msg || !CMD_IS_DEF(LWCELL_CMD_RESET) || !CMD_IS_CUR(LWCELL_CMD_UART_CHECK)) {
+        return; /* Device replied or command is gone */
+    }
+    if (msg->msg.reset.baud_fallback) {
+        if (++msg->msg.reset.baud_polls >= BAUD_CHECK_FALLBACK_POLLS) {
+            return; /* Device is lost at both rates, let command time out */
+        }
+    } else if (++msg->msg.reset.baud_polls >= BAUD_CHECK_POLLS) {
+        /*
+         * Link does not work at new rate, bring device back to default rate.
+         * Hardware reset is reliable, rate change command sent at broken rate is best effort only
+         */
+        if (lwcell.ll.reset_fn != NULL && lwcell.ll.reset_fn(1)) {
+            lwcell_delay(2);
+            lwcell.ll.reset_fn(0);
+        } else {
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+IPR=");
+            lwcelli_send_number(LWCELL_CFG_AT_PORT_BAUDRATE, 0, 0);
+            AT_PORT_SEND_END_AT();
+            AT_PORT_SEND_FLUSH();
+            lwcell_delay(BAUD_CHECK_INTERVAL);
+        }
+        lwcelli_reset_baud_apply(LWCELL_CFG_AT_PORT_BAUDRATE);
+        msg->msg.reset.baud_fallback = 1;
+        msg->msg.reset.baud_polls = 0;
+    }
+    RECV_RESET();
+    if (msg->fn(msg) == lwcellOK) {
+        lwcell_timeout_add(BAUD_CHECK_INTERVAL, lwcelli_reset_baud_timeout_fn, msg);
+    }
+}
+
+#endif /* LWCELL_CFG_AT_PORT_BAUDRATE_UPSHIFT || __DOXYGEN__ */
+
+#if LWCELL_CFG_NETWORK_ATTACH_INCREMENTAL || __DOXYGEN__
+
+/**
+ * \brief           Get first step of network attach sequence not yet satisfied by device
+ * \param[in]       msg: Network attach message
+ * \return          Step index for network attach sequence
+ */
+static uint8_t
+lwcelli_network_attach_resume_step(lwcell_msg_t* msg) {
+    lwcell_cmd_t cmd;
+
+    if (!msg->msg.network_attach.attached) {
+        return 0; /* Full sequence */
     }
-    return lwcellOK;
+    switch (lwcell.m.network.ip_state) {
+        case LWCELL_IP_STATE_ACTIVE:
+        case LWCELL_IP_STATE_GPRSACT: cmd = LWCELL_CMD_CIFSR; break;      /* Context is active, only read IP address */
+        case LWCELL_IP_STATE_START: cmd = LWCELL_CMD_CIICR; break;        /* APN is set, activate context */
+        case LWCELL_IP_STATE_INITIAL: cmd = LWCELL_CMD_CIPMUX_SET; break; /* Configure connections and APN */
+        case LWCELL_IP_STATE_DEACT: cmd = LWCELL_CMD_CIPSHUT; break;      /* Shut context deactivated by network first */
+        default: return 0;
+    }
+    for (uint8_t i = 0; i < LWCELL_ARRAYSIZE(sub_seq_network_attach); ++i) {
+        if (sub_seq_network_attach[i].cmd == cmd) {
+            return i;
+        }
+    }
+    return 0;
 }
 
-/* Temporary macros, only available for inside lwcelli_process_sub_cmd function */
-/* Set new command, but first check for error on previous */
-#define SET_NEW_CMD_CHECK_ERROR(new_cmd)                                                                               \
-    do {                                                                                                               \
-        if (!stat->is_error) {                                                                                         \
-            n_cmd = (new_cmd);                                                                                         \
-        }                                                                                                              \
-    } while (0)
-
-/* Set new command, ignore result of previous */
-#define SET_NEW_CMD(new_cmd)                                                                                           \
-    do {                                                                                                               \
-        n_cmd = (new_cmd);                                                                                             \
-    } while (0)
+#endif /* LWCELL_CFG_NETWORK_ATTACH_INCREMENTAL || __DOXYGEN__ */
 
 /**
  * \brief           Process current command with known execution status and start another if necessary
@@ -1401,39 +4307,211 @@ lwcelli_process_sub_cmd(lwcell_msg_t* msg, lwcell_status_flags_t* stat) {
     if (CMD_IS_DEF(LWCELL_CMD_RESET)) {
         switch (CMD_GET_CUR()) { /* Check current command */
             case LWCELL_CMD_RESET: {
-                lwcelli_reset_everything(1);                                         /* Reset everything */
+                lwcelli_reset_everything(1); /* Reset everything */
+#if LWCELL_CFG_AT_PORT_BAUDRATE_UPSHIFT
+                lwcelli_reset_baud_apply(LWCELL_CFG_AT_PORT_BAUDRATE); /* Device restarts at default rate */
+                msg->msg.reset.baud_idx = 0;
+#endif /* LWCELL_CFG_AT_PORT_BAUDRATE_UPSHIFT */
                 SET_NEW_CMD(LWCELL_CFG_AT_ECHO ? LWCELL_CMD_ATE1 : LWCELL_CMD_ATE0); /* Set ECHO mode */
-                lwcell_delay(LWCELL_CFG_RESET_DELAY_AFTER); /* Delay for some time before we can continue after reset */
+#if LWCELL_CFG_RESET_FAST_BOOT
+                /* Poll device with first command instead of waiting fixed time */
+                msg->msg.reset.polls = 0;
+                lwcell_timeout_add(LWCELL_CFG_RESET_POLL_INTERVAL, lwcelli_reset_poll_timeout_fn, msg);
+#else  /* LWCELL_CFG_RESET_FAST_BOOT */
+                /* Give device some time before we can continue after reset */
+                msg->cmd = n_cmd;
+                if (lwcelli_cmd_park(msg, LWCELL_CFG_RESET_DELAY_AFTER)) {
+                    return lwcellCONT;
+                }
+#endif /* !LWCELL_CFG_RESET_FAST_BOOT */
                 break;
             }
             case LWCELL_CMD_ATE0:
-            case LWCELL_CMD_ATE1: SET_NEW_CMD(LWCELL_CMD_CFUN_SET); break;     /* Set full functionality */
+            case LWCELL_CMD_ATE1: {
+#if LWCELL_CFG_RESET_FAST_BOOT
+                /*
+                 * Device is not ready yet, wait for poll timeout to repeat the command.
+                 * Command is never repeated from here, to keep single command in flight
+                 */
+                if (!stat->is_ok && msg->msg.reset.polls + 1 < RESET_POLL_MAX) {
+                    return lwcellCONT;
+                }
+                lwcell_timeout_remove(lwcelli_reset_poll_timeout_fn);
+#endif /* LWCELL_CFG_RESET_FAST_BOOT */
+#if LWCELL_CFG_AT_PORT_BAUDRATE_UPSHIFT
+                if (stat->is_ok) {
+                    SET_NEW_CMD(lwcelli_reset_baud_next(msg)); /* Try to speed up AT port first */
+                    break;
+                }
+#endif                                            /* LWCELL_CFG_AT_PORT_BAUDRATE_UPSHIFT */
+                SET_NEW_CMD(LWCELL_CMD_CFUN_SET); /* Set full functionality */
+                break;
+            }
+#if LWCELL_CFG_AT_PORT_BAUDRATE_UPSHIFT
+            case LWCELL_CMD_UART: {
+                if (stat->is_ok) {
+                    /* Device replied at old rate and switched, follow it and verify the link */
+                    lwcelli_reset_baud_apply(baud_candidates[msg->msg.reset.baud_idx]);
+                    msg->msg.reset.baud_polls = 0;
+                    msg->msg.reset.baud_fallback = 0;
+                    lwcell_timeout_add(BAUD_CHECK_INTERVAL, lwcelli_reset_baud_timeout_fn, msg);
+                    SET_NEW_CMD(LWCELL_CMD_UART_CHECK);
+                } else {
+                    ++msg->msg.reset.baud_idx; /* Rate not supported by device */
+                    SET_NEW_CMD(lwcelli_reset_baud_next(msg));
+                }
+                break;
+            }
+            case LWCELL_CMD_UART_CHECK: {
+                if (!stat->is_ok) {
+                    return lwcellCONT; /* Garbage at wrong rate, wait for poll timeout */
+                }
+                lwcell_timeout_remove(lwcelli_reset_baud_timeout_fn);
+                if (msg->msg.reset.baud_fallback) {
+                    /* Back at default rate, device may have been reset, repeat setup and try next candidate */
+                    ++msg->msg.reset.baud_idx;
+                    SET_NEW_CMD(LWCELL_CFG_AT_ECHO ? LWCELL_CMD_ATE1 : LWCELL_CMD_ATE0);
+                } else {
+                    LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_TYPE_TRACE, "[LWCELL] AT port at %u bauds\r\n",
+                                  (unsigned)lwcell.ll.uart.baudrate);
+                    SET_NEW_CMD(LWCELL_CMD_CFUN_SET); /* Set full functionality */
+                }
+                break;
+            }
+#endif /* LWCELL_CFG_AT_PORT_BAUDRATE_UPSHIFT */
             case LWCELL_CMD_CFUN_SET: SET_NEW_CMD(LWCELL_CMD_CMEE_SET); break; /* Set detailed error reporting */
-            case LWCELL_CMD_CMEE_SET: SET_NEW_CMD(LWCELL_CMD_CGMI_GET); break; /* Get manufacturer */
+            case LWCELL_CMD_CMEE_SET: {
+#if LWCELL_CFG_RESET_FAST_BOOT
+                if (lwcell.identity_fn != NULL) {
+                    msg->msg.reset.serial_first = 1;
+                    SET_NEW_CMD(LWCELL_CMD_CGSN_GET); /* Get serial number to check persisted identity */
+                    break;
+                }
+#endif                                            /* LWCELL_CFG_RESET_FAST_BOOT */
+                SET_NEW_CMD(LWCELL_CMD_CGMI_GET); /* Get manufacturer */
+                break;
+            }
             case LWCELL_CMD_CGMI_GET: SET_NEW_CMD(LWCELL_CMD_CGMM_GET); break; /* Get model */
-            case LWCELL_CMD_CGMM_GET: SET_NEW_CMD(LWCELL_CMD_CGSN_GET); break; /* Get product serial number */
-            case LWCELL_CMD_CGSN_GET: SET_NEW_CMD(LWCELL_CMD_CGMR_GET); break; /* Get product revision */
+            case LWCELL_CMD_CGMM_GET: {
+#if LWCELL_CFG_RESET_FAST_BOOT
+                if (msg->msg.reset.serial_first) {
+                    SET_NEW_CMD(LWCELL_CMD_CGMR_GET); /* Serial number is already known */
+                    break;
+                }
+#endif                                            /* LWCELL_CFG_RESET_FAST_BOOT */
+                SET_NEW_CMD(LWCELL_CMD_CGSN_GET); /* Get product serial number */
+                break;
+            }
+            case LWCELL_CMD_CGSN_GET: {
+#if LWCELL_CFG_RESET_FAST_BOOT
+                if (msg->msg.reset.serial_first) {
+                    if (lwcelli_reset_identity_apply()) {
+#if LWCELL_CFG_CONN
+                        lwcelli_conn_drv_bind();
+#endif /* LWCELL_CFG_CONN */
+                        lwcelli_send_cb(LWCELL_EVT_DEVICE_IDENTIFIED);
+                        SET_NEW_CMD(LWCELL_CMD_CREG_SET); /* Enable unsolicited code for CREG */
+                    } else {
+                        SET_NEW_CMD(LWCELL_CMD_CGMI_GET); /* Different device, query full identity */
+                    }
+                    break;
+                }
+#endif                                            /* LWCELL_CFG_RESET_FAST_BOOT */
+                SET_NEW_CMD(LWCELL_CMD_CGMR_GET); /* Get product revision */
+                break;
+            }
             case LWCELL_CMD_CGMR_GET: {
                 /*
                  * At this point we have modem info.
                  * It is now time to send info to user
                  * to select between device drivers
                  */
+#if LWCELL_CFG_CONN
+                lwcelli_conn_drv_bind(); /* Connection commands of detected model */
+#endif                                   /* LWCELL_CFG_CONN */
                 lwcelli_send_cb(LWCELL_EVT_DEVICE_IDENTIFIED);
+#if LWCELL_CFG_RESET_FAST_BOOT
+                lwcelli_reset_identity_store();
+#endif /* LWCELL_CFG_RESET_FAST_BOOT */
 
                 SET_NEW_CMD(LWCELL_CMD_CREG_SET); /* Enable unsolicited code for CREG */
                 break;
             }
-            case LWCELL_CMD_CREG_SET: SET_NEW_CMD(LWCELL_CMD_CLCC_SET); break; /* Set call state */
-            case LWCELL_CMD_CLCC_SET: SET_NEW_CMD(LWCELL_CMD_CPIN_GET); break; /* Get SIM state */
+            case LWCELL_CMD_CREG_SET: {
+#if LWCELL_CFG_NETWORK_PS_REG
+                SET_NEW_CMD(LWCELL_CMD_CGREG_SET); /* Enable GPRS registration reports */
+                break;
+            }
+            case LWCELL_CMD_CGREG_SET: SET_NEW_CMD(LWCELL_CMD_CEREG_SET); break; /* Enable EPS registration reports */
+            case LWCELL_CMD_CEREG_SET: {
+#endif /* LWCELL_CFG_NETWORK_PS_REG */
+#if LWCELL_CFG_RSSI_URC
+                SET_NEW_CMD(LWCELL_CMD_EXUNSOL_SQ_SET); /* Enable signal quality reports */
+                break;
+#endif                                            /* LWCELL_CFG_RSSI_URC */
+                SET_NEW_CMD(LWCELL_CMD_CLCC_SET); /* Set call state */
+                break;
+            }
+#if LWCELL_CFG_RSSI_URC
+            case LWCELL_CMD_EXUNSOL_SQ_SET: SET_NEW_CMD(LWCELL_CMD_CLCC_SET); break; /* Set call state */
+#endif /* LWCELL_CFG_RSSI_URC */
+            case LWCELL_CMD_CLCC_SET: {
+#if LWCELL_CFG_TIME
+                SET_NEW_CMD(LWCELL_CMD_CLTS_SET); /* Enable network time reports */
+                break;
+#endif                                            /* LWCELL_CFG_TIME */
+                SET_NEW_CMD(LWCELL_CMD_CPIN_GET); /* Get SIM state */
+                break;
+            }
+#if LWCELL_CFG_TIME
+            case LWCELL_CMD_CLTS_SET: SET_NEW_CMD(LWCELL_CMD_CPIN_GET); break; /* Get SIM state */
+#endif /* LWCELL_CFG_TIME */
             case LWCELL_CMD_CPIN_GET: break;
             default: break;
         }
 
         /* Send event */
         if (n_cmd == LWCELL_CMD_IDLE) {
+#if LWCELL_CFG_OPERATOR_CACHE
+            lwcelli_reset_operator_select();
+#endif /* LWCELL_CFG_OPERATOR_CACHE */
             RESET_SEND_EVT(msg, lwcellOK);
         }
+#if LWCELL_CFG_SNAPSHOT
+    } else if (CMD_IS_DEF(LWCELL_CMD_SNAPSHOT_RESTORE)) {
+        switch (CMD_GET_CUR()) {
+            case LWCELL_CMD_ATE0:
+            case LWCELL_CMD_ATE1: {
+                if (stat->is_ok) { /* Device is still powered, identity is restored */
+#if LWCELL_CFG_CONN
+                    lwcelli_conn_drv_bind();
+#endif /* LWCELL_CFG_CONN */
+                    lwcelli_send_cb(LWCELL_EVT_DEVICE_IDENTIFIED);
+                }
+                SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_CPIN_GET); /* Resync SIM state */
+                break;
+            }
+            case LWCELL_CMD_CPIN_GET: SET_NEW_CMD(LWCELL_CMD_CREG_GET); break; /* Resync registration */
+#if LWCELL_CFG_CONN
+            case LWCELL_CMD_CREG_GET: {
+                if (!LWCELL_CONN_IS_CA()) {
+                    SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_CIPSTATUS); /* Resync PDP context and connections */
+                }
+                break;
+            }
+#endif /* LWCELL_CFG_CONN */
+            default: break;
+        }
+#if LWCELL_CFG_CONN
+        if (n_cmd == LWCELL_CMD_IDLE && stat->is_ok) {
+            lwcelli_snapshot_conns_resume();
+        }
+#endif /* LWCELL_CFG_CONN */
+#endif /* LWCELL_CFG_SNAPSHOT */
+#if LWCELL_CFG_DEVICE_INFO_CACHE
+    } else if (CMD_IS_DEF(LWCELL_CMD_CGMI_GET) && msg->msg.device_info.str == NULL) { /* Refresh all info */
+        n_cmd = prv_sub_step_next(sub_seq_device_info, LWCELL_ARRAYSIZE(sub_seq_device_info), stat);
+#endif /* LWCELL_CFG_DEVICE_INFO_CACHE */
     } else if (CMD_IS_DEF(LWCELL_CMD_COPS_GET)) {
         if (CMD_IS_CUR(LWCELL_CMD_COPS_GET)) {
             lwcell.evt.evt.operator_current.operator_current = &lwcell.m.network.curr_operator;
@@ -1443,16 +4521,46 @@ lwcelli_process_sub_cmd(lwcell_msg_t* msg, lwcell_status_flags_t* stat) {
         if (CMD_IS_CUR(LWCELL_CMD_COPS_GET_OPT)) {
             OPERATOR_SCAN_SEND_EVT(lwcell.msg, stat->is_ok ? lwcellOK : lwcellERR);
         }
+#if LWCELL_CFG_NETWORK_BAND
+    } else if (CMD_IS_DEF(LWCELL_CMD_NETWORK_BAND_SET)) {
+        lwcell_network_rat_t rat = msg->msg.network_band.rat;
+
+        switch (CMD_GET_CUR()) {
+            case LWCELL_CMD_CNMP_SET: {
+                if (rat & LWCELL_NETWORK_RAT_CATM_NBIOT) {
+                    SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_CMNB_SET);
+                }
+                break;
+            }
+            case LWCELL_CMD_CMNB_SET: {
+                if (msg->msg.network_band.bands != NULL && msg->msg.network_band.bands_len > 0) {
+                    /* CAT-M bands are set first, followed by NB-IoT bands */
+                    msg->msg.network_band.cfg_rat =
+                        (rat & LWCELL_NETWORK_RAT_CATM) ? LWCELL_NETWORK_RAT_CATM : LWCELL_NETWORK_RAT_NBIOT;
+                    SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_CBANDCFG_SET);
+                }
+                break;
+            }
+            case LWCELL_CMD_CBANDCFG_SET: {
+                if (msg->msg.network_band.cfg_rat == LWCELL_NETWORK_RAT_CATM && (rat & LWCELL_NETWORK_RAT_NBIOT)) {
+                    msg->msg.network_band.cfg_rat = LWCELL_NETWORK_RAT_NBIOT;
+                    SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_CBANDCFG_SET);
+                }
+                break;
+            }
+            default: break;
+        }
+#endif /* LWCELL_CFG_NETWORK_BAND */
     } else if (CMD_IS_DEF(LWCELL_CMD_SIM_PROCESS_BASIC_CMDS)) {
         if (CMD_IS_CUR(LWCELL_CMD_CNUM)) {
-            /* Get own phone number */
-            if (!stat->is_ok) {
-                /* Sometimes SIM is not ready just after PIN entered */
-                if (msg->msg.sim_info.cnum_tries < 5) {
-                    ++msg->msg.sim_info.cnum_tries;
-                    SET_NEW_CMD(LWCELL_CMD_CNUM);
-                    lwcell_delay(1000);
-                }
+            /*
+             * Sometimes SIM is not ready just after PIN entered.
+             * Finish command and read again later, or earlier on ready URC,
+             * to not hold other commands in the queue meanwhile
+             */
+            if (!stat->is_ok && lwcell.m.sim.info_tries < SIM_INFO_TRIES_MAX) {
+                ++lwcell.m.sim.info_tries;
+                lwcell_timeout_add(SIM_INFO_RETRY_INTERVAL, lwcelli_sim_info_timeout_fn, NULL);
             }
         }
     } else if (CMD_IS_DEF(LWCELL_CMD_CPIN_SET)) { /* Set PIN code */
@@ -1470,12 +4578,12 @@ lwcelli_process_sub_cmd(lwcell_msg_t* msg, lwcell_status_flags_t* stat) {
                      * This else will only get executed when CPIN_GET is requested after CPIN has been set.
                      * This is indicated by msg command counter (msg->i > 0).
                      * 
-                     * We try several times to acquire status, each time with different delays in-between.
+                     * We try several times to acquire status, each time with longer delay in-between.
                      * This allows to immediately stop execution on fast modems, 
                      * while it allows slow modems to take more time to handle the situation
                      */
-                    if ((stat->is_error || lwcell.m.sim.state != LWCELL_SIM_STATE_READY) && msg->i < 5) {
-                        lwcell_delay(500 * msg->i);
+                    if ((stat->is_error || lwcell.m.sim.state != LWCELL_SIM_STATE_READY)
+                        && msg->msg.cpin_enter.polls < SIM_POLL_MAX) {
                         SET_NEW_CMD(LWCELL_CMD_CPIN_GET);
                     }
                 }
@@ -1483,18 +4591,34 @@ lwcelli_process_sub_cmd(lwcell_msg_t* msg, lwcell_status_flags_t* stat) {
             }
             case LWCELL_CMD_CPIN_SET: { /* Set CPIN */
                 if (stat->is_ok) {
-                    lwcell_delay(500);
                     SET_NEW_CMD(LWCELL_CMD_CPIN_GET);
                 }
                 break;
             }
             default: break;
         }
+
+        /*
+         * Poll SIM state with command parked instead of sleeping in processing thread.
+         * +CPIN: READY URC sends the poll immediately
+         */
+        if (n_cmd == LWCELL_CMD_CPIN_GET && msg->i > 0 && lwcell.m.sim.state != LWCELL_SIM_STATE_READY) {
+            ++msg->msg.cpin_enter.polls;
+            msg->cmd = LWCELL_CMD_CPIN_GET;
+            if (lwcelli_cmd_park(msg, SIM_POLL_INTERVAL * msg->msg.cpin_enter.polls)) {
+                return lwcellCONT;
+            }
+        }
 #if LWCELL_CFG_SMS
     } else if (CMD_IS_DEF(LWCELL_CMD_SMS_ENABLE)) {
         switch (CMD_GET_CUR()) {
             case LWCELL_CMD_CPMS_GET_OPT: SET_NEW_CMD(LWCELL_CMD_CPMS_GET); break;
+#if LWCELL_CFG_SMS_DIRECT
+            case LWCELL_CMD_CPMS_GET: SET_NEW_CMD(LWCELL_CMD_CMGF); break; /* Text mode for direct delivery */
+            case LWCELL_CMD_CMGF: SET_NEW_CMD(LWCELL_CMD_CNMI); break;
+#else  /* LWCELL_CFG_SMS_DIRECT */
             case LWCELL_CMD_CPMS_GET: break;
+#endif /* !LWCELL_CFG_SMS_DIRECT */
             default: break;
         }
         if (!stat->is_ok || n_cmd == LWCELL_CMD_IDLE) { /* Stop execution on any command */
@@ -1503,23 +4627,68 @@ lwcelli_process_sub_cmd(lwcell_msg_t* msg, lwcell_status_flags_t* stat) {
             lwcell.evt.evt.sms_enable.status = lwcell.m.sms.enabled ? lwcellOK : lwcellERR;
             lwcelli_send_cb(LWCELL_EVT_SMS_ENABLE); /* Send to user */
         }
+#if LWCELL_CFG_SMS_DIRECT && LWCELL_CFG_SMS_PDU
+    } else if (CMD_IS_DEF(LWCELL_CMD_CMGS) && msg->msg.sms_send.text_restore) {
+        /* Device is back in text mode, report result of sending */
+        stat->is_ok = msg->msg.sms_send.text_restore == 2;
+        stat->is_error = !stat->is_ok;
+        SMS_SEND_SEND_EVT(lwcell.msg, stat->is_ok ? lwcellOK : lwcellERR);
+#endif                                                    /* LWCELL_CFG_SMS_DIRECT && LWCELL_CFG_SMS_PDU */
     } else if (CMD_IS_DEF(LWCELL_CMD_CMGS)) {             /* Send SMS default command */
         if (CMD_IS_CUR(LWCELL_CMD_CMGF) && stat->is_ok) { /* Set message format current command */
             SET_NEW_CMD(LWCELL_CMD_CMGS);                 /* Now send actual message */
+#if LWCELL_CFG_SMS_PDU
+            if (msg->msg.sms_send.batch != NULL) {
+                if (!lwcelli_sms_batch_load(msg)) { /* No entry can be sent */
+                    SET_NEW_CMD(LWCELL_CMD_IDLE);
+                    stat->is_ok = 0;
+                    stat->is_error = 1;
+                }
+            } else if (!msg->msg.sms_send.format) {
+                msg->msg.sms_send.ref = ++lwcell.m.sms.pdu_ref;
+            }
+#endif /* LWCELL_CFG_SMS_PDU */
+#if LWCELL_CFG_SMS_PDU
+        } else if (CMD_IS_CUR(LWCELL_CMD_CMGS) && !msg->msg.sms_send.format) {
+            if (stat->is_ok && msg->msg.sms_send.off + msg->msg.sms_send.part_len < msg->msg.sms_send.len) {
+                msg->msg.sms_send.off += msg->msg.sms_send.part_len; /* Continue with next concatenated part */
+                ++msg->msg.sms_send.part;
+                SET_NEW_CMD(LWCELL_CMD_CMGS);
+            } else if (msg->msg.sms_send.batch != NULL) {
+                lwcell_sms_batch_entry_t* e = &msg->msg.sms_send.batch[msg->msg.sms_send.batch_idx];
+
+                /* Entry is done, continue with next one in the same command context */
+                e->res = stat->is_ok ? lwcellOK : lwcellERR;
+                e->pos = stat->is_ok ? msg->msg.sms_send.pos : 0;
+                if (!stat->is_ok) {
+                    msg->msg.sms_send.batch_err = 1;
+                }
+                ++msg->msg.sms_send.batch_idx;
+                if (lwcelli_sms_batch_load(msg)) {
+                    SET_NEW_CMD(LWCELL_CMD_CMGS);
+                } else if (msg->msg.sms_send.batch_err) { /* Report error when at least one entry failed */
+                    stat->is_ok = 0;
+                    stat->is_error = 1;
+                }
+            }
+#endif /* LWCELL_CFG_SMS_PDU */
         }
+#if LWCELL_CFG_SMS_DIRECT && LWCELL_CFG_SMS_PDU
+        /* Direct delivery headers follow message format, return device to text mode */
+        if (n_cmd == LWCELL_CMD_IDLE && CMD_IS_CUR(LWCELL_CMD_CMGS) && !msg->msg.sms_send.format) {
+            msg->msg.sms_send.text_restore = stat->is_ok ? 2 : 1;
+            msg->msg.sms_send.format = 1;
+            SET_NEW_CMD(LWCELL_CMD_CMGF);
+        }
+#endif /* LWCELL_CFG_SMS_DIRECT && LWCELL_CFG_SMS_PDU */
 
         /* Send event on finish */
         if (n_cmd == LWCELL_CMD_IDLE) {
             SMS_SEND_SEND_EVT(lwcell.msg, stat->is_ok ? lwcellOK : lwcellERR);
         }
     } else if (CMD_IS_DEF(LWCELL_CMD_CMGR)) { /* Read SMS message */
-        if (CMD_IS_CUR(LWCELL_CMD_CPMS_GET) && stat->is_ok) {
-            SET_NEW_CMD(LWCELL_CMD_CPMS_SET); /* Set memory */
-        } else if (CMD_IS_CUR(LWCELL_CMD_CPMS_SET) && stat->is_ok) {
-            SET_NEW_CMD(LWCELL_CMD_CMGF);                        /* Set text mode */
-        } else if (CMD_IS_CUR(LWCELL_CMD_CMGF) && stat->is_ok) { /* Set message format current command*/
-            SET_NEW_CMD(LWCELL_CMD_CMGR);                        /* Start message read */
-        } else if (CMD_IS_CUR(LWCELL_CMD_CMGR) && stat->is_ok) {
+        n_cmd = prv_sub_step_next(sub_seq_sms_read, LWCELL_ARRAYSIZE(sub_seq_sms_read), stat);
+        if (CMD_IS_CUR(LWCELL_CMD_CMGR) && stat->is_ok) {
             msg->msg.sms_read.mem = lwcell.m.sms.mem[0].current; /* Set current memory */
         }
 
@@ -1528,37 +4697,23 @@ lwcelli_process_sub_cmd(lwcell_msg_t* msg, lwcell_status_flags_t* stat) {
             SMS_SEND_READ_EVT(lwcell.msg, stat->is_ok ? lwcellOK : lwcellERR);
         }
     } else if (CMD_IS_DEF(LWCELL_CMD_CMGD)) { /* Delete SMS message*/
-        if (CMD_IS_CUR(LWCELL_CMD_CPMS_GET) && stat->is_ok) {
-            SET_NEW_CMD(LWCELL_CMD_CPMS_SET); /* Set memory */
-        } else if (CMD_IS_CUR(LWCELL_CMD_CPMS_SET) && stat->is_ok) {
-            SET_NEW_CMD(LWCELL_CMD_CMGD); /* Delete message */
-        }
+        n_cmd = prv_sub_step_next(sub_seq_sms_delete, LWCELL_ARRAYSIZE(sub_seq_sms_delete), stat);
 
         /* Send event on finish */
         if (n_cmd == LWCELL_CMD_IDLE) {
             SMS_SEND_DELETE_EVT(msg, stat->is_ok ? lwcellOK : lwcellERR);
         }
     } else if (CMD_IS_DEF(LWCELL_CMD_CMGDA)) {
-        if (CMD_IS_CUR(LWCELL_CMD_CMGF) && stat->is_ok) {
-            SET_NEW_CMD(LWCELL_CMD_CMGDA); /* Mass storage */
-        }
+        n_cmd = prv_sub_step_next(sub_seq_sms_delete_all, LWCELL_ARRAYSIZE(sub_seq_sms_delete_all), stat);
     } else if (CMD_IS_DEF(LWCELL_CMD_CMGL)) { /* List SMS messages */
-        if (CMD_IS_CUR(LWCELL_CMD_CPMS_GET) && stat->is_ok) {
-            SET_NEW_CMD(LWCELL_CMD_CPMS_SET); /* Set memory */
-        } else if (CMD_IS_CUR(LWCELL_CMD_CPMS_SET) && stat->is_ok) {
-            SET_NEW_CMD(LWCELL_CMD_CMGF); /* Set text format */
-        } else if (CMD_IS_CUR(LWCELL_CMD_CMGF) && stat->is_ok) {
-            SET_NEW_CMD(LWCELL_CMD_CMGL); /* List messages */
-        }
+        n_cmd = prv_sub_step_next(sub_seq_sms_list, LWCELL_ARRAYSIZE(sub_seq_sms_list), stat);
 
         /* Send event on finish */
         if (n_cmd == LWCELL_CMD_IDLE) {
             SMS_SEND_LIST_EVT(msg, stat->is_ok ? lwcellOK : lwcellERR);
         }
     } else if (CMD_IS_DEF(LWCELL_CMD_CPMS_SET)) { /* Set preferred memory */
-        if (CMD_IS_CUR(LWCELL_CMD_CPMS_GET) && stat->is_ok) {
-            SET_NEW_CMD(LWCELL_CMD_CPMS_SET); /* Now set the command */
-        }
+        n_cmd = prv_sub_step_next(sub_seq_sms_mem, LWCELL_ARRAYSIZE(sub_seq_sms_mem), stat);
 #endif /* LWCELL_CFG_SMS */
 #if LWCELL_CFG_CALL
     } else if (CMD_IS_DEF(LWCELL_CMD_CALL_ENABLE)) {
@@ -1576,12 +4731,80 @@ lwcelli_process_sub_cmd(lwcell_msg_t* msg, lwcell_status_flags_t* stat) {
             SET_NEW_CMD(LWCELL_CMD_CPBS_SET);                 /* Set current memory */
         } else if (CMD_IS_CUR(LWCELL_CMD_CPBS_SET) && stat->is_ok) {
             SET_NEW_CMD(LWCELL_CMD_CPBW_SET); /* Write entry to phonebook */
+#if LWCELL_CFG_PHONEBOOK_MIRROR
+        } else if (CMD_IS_CUR(LWCELL_CMD_CPBW_SET)) {
+            lwcelli_pb_mirror_write_finished(lwcell.msg, stat->is_ok);
+#endif /* LWCELL_CFG_PHONEBOOK_MIRROR */
+        }
+    } else if (CMD_IS_DEF(LWCELL_CMD_PHONEBOOK_IMPORT)) {
+        if (CMD_IS_CUR(LWCELL_CMD_CPBW_SET)) { /* Report written entry */
+            lwcell.evt.evt.pb_import.mem = lwcell.msg->msg.pb_import.mem == LWCELL_MEM_CURRENT
+                                               ? lwcell.m.pb.mem.current
+                                               : lwcell.msg->msg.pb_import.mem;
+            lwcell.evt.evt.pb_import.index = lwcell.msg->msg.pb_import.ei;
+            lwcell.evt.evt.pb_import.entry = lwcell.msg->msg.pb_import.entry;
+            lwcell.evt.evt.pb_import.res = stat->is_ok ? lwcellOK : lwcellERR;
+            lwcelli_send_cb(LWCELL_EVT_PB_IMPORT);
+            if (stat->is_ok) {
+#if LWCELL_CFG_PHONEBOOK_MIRROR
+                lwcelli_pb_mirror_entry_written(lwcell.evt.evt.pb_import.mem, lwcell.msg->msg.pb_import.entry);
+#endif /* LWCELL_CFG_PHONEBOOK_MIRROR */
+            } else {
+                lwcell.msg->msg.pb_import.failed = 1;
+            }
+            ++lwcell.msg->msg.pb_import.ei;
+            if (lwcell.msg->msg.pb_import.ew != NULL) {
+                *lwcell.msg->msg.pb_import.ew = lwcell.msg->msg.pb_import.ei;
+            }
+        }
+        if (CMD_IS_CUR(LWCELL_CMD_CPBW_SET) || stat->is_ok) { /* Memory selected or entry processed */
+            LWCELL_MEMSET(lwcell.msg->msg.pb_import.entry, 0x00, sizeof(*lwcell.msg->msg.pb_import.entry));
+            if (lwcell.msg->msg.pb_import.ei < lwcell.msg->msg.pb_import.etw
+                && lwcell.msg->msg.pb_import.fn(lwcell.msg->msg.pb_import.ei, lwcell.msg->msg.pb_import.entry,
+                                                lwcell.msg->msg.pb_import.arg)) {
+                SET_NEW_CMD(LWCELL_CMD_CPBW_SET); /* Write next entry */
+            } else if (lwcell.msg->msg.pb_import.failed) {
+                stat->is_ok = 0; /* Report overall failure when any entry failed */
+                stat->is_error = 1;
+            }
+        }
+#if LWCELL_CFG_PHONEBOOK_MIRROR
+    } else if (CMD_IS_DEF(LWCELL_CMD_PHONEBOOK_MIRROR_LOAD)) {
+        if (CMD_IS_CUR(LWCELL_CMD_CPBS_SET) && stat->is_ok) {
+            SET_NEW_CMD(LWCELL_CMD_CPBS_GET); /* Get memory size */
+        } else if (CMD_IS_CUR(LWCELL_CMD_CPBS_GET) && stat->is_ok) {
+            lwcelli_pb_mirror_reset(lwcell.m.pb.mem.current, lwcell.m.pb.mem.total);
+            lwcell.msg->msg.pb_mirror.index = 1;
+            if (lwcell.m.pb.mem.total > 0) {
+                SET_NEW_CMD(LWCELL_CMD_CPBR); /* Read first chunk */
+            } else {
+                lwcell.m.pb.mirror.valid = 1;
+            }
+        } else if (CMD_IS_CUR(LWCELL_CMD_CPBR) && stat->is_ok) {
+            if (lwcell.msg->msg.pb_mirror.overflow) {
+                stat->is_ok = 0; /* More entries than mirror can hold */
+                stat->is_error = 1;
+            } else {
+                lwcell.msg->msg.pb_mirror.index += LWCELL_CFG_PHONEBOOK_READ_CHUNK;
+                if (lwcell.msg->msg.pb_mirror.index <= lwcell.m.pb.mirror.total) {
+                    SET_NEW_CMD(LWCELL_CMD_CPBR); /* Read next chunk */
+                } else {
+                    lwcell.m.pb.mirror.valid = 1;
+                }
+            }
         }
+#endif /* LWCELL_CFG_PHONEBOOK_MIRROR */
     } else if (CMD_IS_DEF(LWCELL_CMD_CPBR)) {
+        uint8_t is_iter = lwcell.msg->msg.pb_list.entry_fn != NULL;
+
         if (CMD_IS_CUR(LWCELL_CMD_CPBS_GET) && stat->is_ok) { /* Get current memory */
-            SET_NEW_CMD(LWCELL_CMD_CPBS_SET);                 /* Set current memory */
+            SET_NEW_CMD(is_iter ? LWCELL_CMD_CPBR : LWCELL_CMD_CPBS_SET);
         } else if (CMD_IS_CUR(LWCELL_CMD_CPBS_SET) && stat->is_ok) {
-            SET_NEW_CMD(LWCELL_CMD_CPBR); /* Read entries */
+            SET_NEW_CMD(is_iter ? LWCELL_CMD_CPBS_GET : LWCELL_CMD_CPBR); /* Iterator needs memory size */
+        } else if (CMD_IS_CUR(LWCELL_CMD_CPBR) && is_iter && stat->is_ok && !lwcell.msg->msg.pb_list.stop
+                   && lwcell.msg->msg.pb_list.start_index + LWCELL_CFG_PHONEBOOK_READ_CHUNK <= lwcell.m.pb.mem.total) {
+            lwcell.msg->msg.pb_list.start_index += LWCELL_CFG_PHONEBOOK_READ_CHUNK;
+            SET_NEW_CMD(LWCELL_CMD_CPBR); /* Read next chunk */
         } else if (CMD_IS_CUR(LWCELL_CMD_CPBR)) {
             lwcell.evt.evt.pb_list.mem = lwcell.m.pb.mem.current;
             lwcell.evt.evt.pb_list.entries = lwcell.msg->msg.pb_list.entries;
@@ -1590,11 +4813,8 @@ lwcelli_process_sub_cmd(lwcell_msg_t* msg, lwcell_status_flags_t* stat) {
             lwcelli_send_cb(LWCELL_EVT_PB_LIST);
         }
     } else if (CMD_IS_DEF(LWCELL_CMD_CPBF)) {
-        if (CMD_IS_CUR(LWCELL_CMD_CPBS_GET) && stat->is_ok) { /* Get current memory */
-            SET_NEW_CMD(LWCELL_CMD_CPBS_SET);                 /* Set current memory */
-        } else if (CMD_IS_CUR(LWCELL_CMD_CPBS_SET) && stat->is_ok) {
-            SET_NEW_CMD(LWCELL_CMD_CPBF); /* Read entries */
-        } else if (CMD_IS_CUR(LWCELL_CMD_CPBF)) {
+        n_cmd = prv_sub_step_next(sub_seq_pb_search, LWCELL_ARRAYSIZE(sub_seq_pb_search), stat);
+        if (CMD_IS_CUR(LWCELL_CMD_CPBF)) {
             lwcell.evt.evt.pb_search.mem = lwcell.m.pb.mem.current;
             lwcell.evt.evt.pb_search.search = lwcell.msg->msg.pb_search.search;
             lwcell.evt.evt.pb_search.entries = lwcell.msg->msg.pb_search.entries;
@@ -1605,65 +4825,119 @@ lwcelli_process_sub_cmd(lwcell_msg_t* msg, lwcell_status_flags_t* stat) {
 #endif /* LWCELL_CFG_PHONEBOOK */
 #if LWCELL_CFG_NETWORK
     } else if (CMD_IS_DEF(LWCELL_CMD_NETWORK_ATTACH)) {
-        switch (msg->i) {
-            case 0: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_CGACT_SET_0); break;
-            case 1: SET_NEW_CMD(LWCELL_CMD_CGACT_SET_1); break;
-#if LWCELL_CFG_NETWORK_IGNORE_CGACT_RESULT
-            case 2: SET_NEW_CMD(LWCELL_CMD_CGATT_SET_0); break;
-#else  /* LWCELL_CFG_NETWORK_IGNORE_CGACT_RESULT */
-            case 2: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_CGATT_SET_0); break;
-#endif /* !LWCELL_CFG_NETWORK_IGNORE_CGACT_RESULT */
-            case 3: SET_NEW_CMD(LWCELL_CMD_CGATT_SET_1); break;
-            case 4: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_CIPSHUT); break;
-            case 5: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_CIPMUX_SET); break;
-            case 6: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_CIPRXGET_SET); break;
-            case 7: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_CSTT_SET); break;
-            case 8: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_CIICR); break;
-            case 9: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_CIFSR); break;
-            case 10: SET_NEW_CMD(LWCELL_CMD_CIPSTATUS); break;
-            default: break;
+#if LWCELL_CFG_NETWORK_CONTEXTS > 1
+        if (msg->msg.network_attach.ctx > 0) {
+            /* Activate additional context, then select default context again, also on failure */
+            if (CMD_IS_CUR(LWCELL_CMD_CIPSGTXT)) {
+                if (!msg->i) {
+                    SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_CSTT_SET);
+                } else if (msg->msg.network_attach.ctx_err) {
+                    stat->is_ok = 0;
+                    stat->is_error = 1;
+                }
+            } else if (stat->is_error) {
+                msg->msg.network_attach.ctx_err = 1;
+                SET_NEW_CMD(LWCELL_CMD_CIPSGTXT);
+            } else if (CMD_IS_CUR(LWCELL_CMD_CSTT_SET)) {
+                SET_NEW_CMD(LWCELL_CMD_CIICR);
+            } else if (CMD_IS_CUR(LWCELL_CMD_CIICR)) {
+                SET_NEW_CMD(LWCELL_CMD_CIFSR);
+            } else if (CMD_IS_CUR(LWCELL_CMD_CIFSR)) {
+                lwcell.m.network.ctx[msg->msg.network_attach.ctx - 1].is_attached = 1;
+                SET_NEW_CMD(LWCELL_CMD_CIPSGTXT);
+            }
+        } else
+#endif /* LWCELL_CFG_NETWORK_CONTEXTS > 1 */
+#if LWCELL_CFG_NETWORK_ATTACH_INCREMENTAL
+        if (msg->i == 0) {
+            SET_NEW_CMD(LWCELL_CMD_CGATT_GET); /* Query attach state after initial status */
+        } else {
+            if (CMD_IS_CUR(LWCELL_CMD_CGATT_GET)) {
+                stat->is_error = 0; /* Failed query is not fatal, full sequence is used instead */
+                msg->msg.network_attach.step = lwcelli_network_attach_resume_step(msg);
+            }
+            n_cmd = prv_sub_step_get(sub_seq_network_attach, LWCELL_ARRAYSIZE(sub_seq_network_attach),
+                                     msg->msg.network_attach.step++, stat);
         }
-    } else if (CMD_IS_DEF(LWCELL_CMD_NETWORK_DETACH)) {
-        switch (msg->i) {
-            case 0: SET_NEW_CMD(LWCELL_CMD_CGATT_SET_0); break;
-            case 1: SET_NEW_CMD(LWCELL_CMD_CGACT_SET_0); break;
-#if LWCELL_CFG_CONN
-            case 2: SET_NEW_CMD(LWCELL_CMD_CIPSTATUS); break;
-#endif /* LWCELL_CFG_CONN */
-            default: break;
+#else  /* LWCELL_CFG_NETWORK_ATTACH_INCREMENTAL */
+        n_cmd = prv_sub_step_get(sub_seq_network_attach, LWCELL_ARRAYSIZE(sub_seq_network_attach), msg->i, stat);
+#endif /* !LWCELL_CFG_NETWORK_ATTACH_INCREMENTAL */
+#if LWCELL_CFG_CONN_QUICK_SEND
+        if (n_cmd == LWCELL_CMD_CIPQSEND_SET && !LWCELL_DEV_MODEL_CAP(has_quick_send)) {
+            /* Device model has no quick send mode, continue with following step */
+#if LWCELL_CFG_NETWORK_ATTACH_INCREMENTAL
+            n_cmd = prv_sub_step_get(sub_seq_network_attach, LWCELL_ARRAYSIZE(sub_seq_network_attach),
+                                     msg->msg.network_attach.step++, stat);
+#else  /* LWCELL_CFG_NETWORK_ATTACH_INCREMENTAL */
+            n_cmd = prv_sub_step_get(sub_seq_network_attach, LWCELL_ARRAYSIZE(sub_seq_network_attach), ++msg->i, stat);
+#endif /* !LWCELL_CFG_NETWORK_ATTACH_INCREMENTAL */
         }
+#endif /* LWCELL_CFG_CONN_QUICK_SEND */
+    } else if (CMD_IS_DEF(LWCELL_CMD_NETWORK_DETACH)) {
+        n_cmd = prv_sub_step_get(sub_seq_network_detach, LWCELL_ARRAYSIZE(sub_seq_network_detach), msg->i, stat);
         if (!n_cmd) {
             stat->is_ok = 1;
         }
 #endif /* LWCELL_CFG_NETWORK */
 #if LWCELL_CFG_CONN
+#if LWCELL_CFG_CONN_CA_SOCKET
+    } else if (CMD_IS_DEF(LWCELL_CMD_CIPSTART) && LWCELL_CONN_IS_CA()) {
+        if (CMD_IS_CUR(LWCELL_CMD_CNACT_SET)) {
+            SET_NEW_CMD(LWCELL_CMD_CIPSTART); /* Error is returned also when context is already active */
+        } else if (CMD_IS_CUR(LWCELL_CMD_CIPSTART)) {
+            if (stat->is_ok && msg->msg.conn_start.conn_res == LWCELL_CONN_CONNECT_OK) {
+                lwcelli_send_conn_active_cb(&lwcell.m.conns[msg->msg.conn_start.num]);
+            } else {
+#if LWCELL_CFG_DNS
+                lwcelli_dns_cache_failed(msg->msg.conn_start.host); /* Try next address on next start */
+#endif                                                              /* LWCELL_CFG_DNS */
+                lwcelli_send_conn_error_cb(msg, lwcellERRCONNFAIL);
+                stat->is_error = 1;
+                stat->is_ok = 0;
+            }
+        }
+#endif /* LWCELL_CFG_CONN_CA_SOCKET */
     } else if (CMD_IS_DEF(LWCELL_CMD_CIPSTART)) {
         if (!msg->i && CMD_IS_CUR(LWCELL_CMD_CIPSTATUS)) { /* Was the current command status info? */
             if (stat->is_ok) {
                 SET_NEW_CMD(LWCELL_CMD_CIPSSL); /* Set SSL */
+#if LWCELL_CFG_NETWORK_CONTEXTS > 1
+                if (msg->msg.conn_start.ctx > 0) {
+                    SET_NEW_CMD(LWCELL_CMD_CIPSGTXT); /* Select connection context first */
+                }
+#endif /* LWCELL_CFG_NETWORK_CONTEXTS > 1 */
+            }
+#if LWCELL_CFG_NETWORK_CONTEXTS > 1
+        } else if (CMD_IS_CUR(LWCELL_CMD_CIPSGTXT)) {
+            if (msg->i == 1) {
+                SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_CIPSSL); /* Context selected, set SSL */
+            } else {
+                SET_NEW_CMD(LWCELL_CMD_CIPSTATUS); /* Default context is selected again */
             }
-        } else if (msg->i == 1 && CMD_IS_CUR(LWCELL_CMD_CIPSSL)) {
+#endif /* LWCELL_CFG_NETWORK_CONTEXTS > 1 */
+        } else if (CMD_IS_CUR(LWCELL_CMD_CIPSSL)) {
             SET_NEW_CMD(LWCELL_CMD_CIPSTART); /* Now actually start connection */
-        } else if (msg->i == 2 && CMD_IS_CUR(LWCELL_CMD_CIPSTART)) {
+        } else if (CMD_IS_CUR(LWCELL_CMD_CIPSTART)) {
             SET_NEW_CMD(LWCELL_CMD_CIPSTATUS); /* Go to status mode */
+#if LWCELL_CFG_NETWORK_CONTEXTS > 1
+            if (msg->msg.conn_start.ctx > 0) {
+                SET_NEW_CMD(LWCELL_CMD_CIPSGTXT); /* Select default context before status */
+            }
+#endif /* LWCELL_CFG_NETWORK_CONTEXTS > 1 */
             if (stat->is_error) {
                 msg->msg.conn_start.conn_res = LWCELL_CONN_CONNECT_ERROR;
             }
-        } else if (msg->i == 3 && CMD_IS_CUR(LWCELL_CMD_CIPSTATUS)) {
+        } else if (msg->i > 0 && CMD_IS_CUR(LWCELL_CMD_CIPSTATUS)) {
             /* After second CIP status, define what to do next */
             switch (msg->msg.conn_start.conn_res) {
-                case LWCELL_CONN_CONNECT_OK: {                                      /* Successfully connected */
-                    lwcell_conn_t* conn = &lwcell.m.conns[msg->msg.conn_start.num]; /* Get connection number */
-
-                    lwcell.evt.type = LWCELL_EVT_CONN_ACTIVE; /* Connection just active */
-                    lwcell.evt.evt.conn_active_close.client = 1;
-                    lwcell.evt.evt.conn_active_close.conn = conn;
-                    lwcell.evt.evt.conn_active_close.forced = 1;
-                    lwcelli_send_conn_cb(conn, NULL);
-                    lwcelli_conn_start_timeout(conn); /* Start connection timeout timer */
+                case LWCELL_CONN_CONNECT_OK: {             /* Successfully connected */
+                    SET_NEW_CMD(LWCELL_CMD_CIPSEND_GET); /* Query maximal send length for connection */
                     break;
                 }
                 case LWCELL_CONN_CONNECT_ERROR: { /* Connection error */
+#if LWCELL_CFG_DNS
+                    lwcelli_dns_cache_failed(msg->msg.conn_start.host); /* Try next address on next start */
+#endif                                                                  /* LWCELL_CFG_DNS */
                     lwcelli_send_conn_error_cb(msg, lwcellERRCONNFAIL);
                     stat->is_error = 1; /* Manually set error */
                     stat->is_ok = 0;    /* Reset success */
@@ -1674,36 +4948,390 @@ lwcelli_process_sub_cmd(lwcell_msg_t* msg, lwcell_status_flags_t* stat) {
                     break;
                 }
             }
+        } else if (CMD_IS_CUR(LWCELL_CMD_CIPSEND_GET)) {
+            /* Failed query is not fatal, default send length is used */
+            stat->is_error = 0;
+            stat->is_ok = 1;
+
+            lwcelli_send_conn_active_cb(&lwcell.m.conns[msg->msg.conn_start.num]);
+        }
+    } else if (CMD_IS_DEF(LWCELL_CMD_CIPCLOSE)) {
+        /*
+         * It is unclear in which state connection is when ERROR is received on close command.
+         * Stack checks if connection is closed before it allows and sends close command,
+         * however it was detected that no automatic close event has been received from device
+         * and AT+CIPCLOSE returned ERROR.
+         *
+         * Is it device firmware bug?
+         */
+        if (CMD_IS_CUR(LWCELL_CMD_CIPCLOSE) && stat->is_error) {
+            /* Notify upper layer about failed close event */
+            lwcell.evt.type = LWCELL_EVT_CONN_CLOSE;
+            lwcell.evt.evt.conn_active_close.conn = msg->msg.conn_close.conn;
+            lwcell.evt.evt.conn_active_close.forced = 1;
+            lwcell.evt.evt.conn_active_close.res = lwcellERR;
+            lwcell.evt.evt.conn_active_close.client =
+                msg->msg.conn_close.conn->status.f.active && msg->msg.conn_close.conn->status.f.client;
+            lwcelli_send_conn_cb(msg->msg.conn_close.conn, NULL);
+        }
+#if LWCELL_CFG_CONN_CA_SOCKET
+        /* Socket engine confirms close with "OK" only */
+        if (LWCELL_CONN_IS_CA() && stat->is_ok && msg->msg.conn_close.conn->status.f.active) {
+            lwcelli_conn_closed_process(msg->msg.conn_close.conn->num, 1);
+        }
+#endif /* LWCELL_CFG_CONN_CA_SOCKET */
+#if LWCELL_CFG_CONN_MANUAL_RECV
+    } else if (CMD_IS_DEF(LWCELL_CMD_CIPRXGET)) {
+        lwcell_conn_p c = msg->msg.ciprxget.conn;
+
+        /* Read finished, continue if device reported more data and connection was not reopened meanwhile */
+        if (c->val_id == msg->msg.ciprxget.val_id) {
+            --c->status.f.rx_reads;
+            if (!msg->msg.ciprxget.hdr) {
+                /* Read failed, return reserved window and retry on next notification or confirmation */
+                c->rx_credit += msg->msg.ciprxget.len;
+                c->status.f.rx_pending = 1;
+            } else {
+                lwcelli_conn_manual_recv_read(c);
+            }
+        }
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV */
+#endif /* LWCELL_CFG_CONN */
+#if LWCELL_CFG_USSD
+    } else if (CMD_IS_DEF(LWCELL_CMD_CUSD)) {
+        if (CMD_IS_CUR(LWCELL_CMD_CUSD_GET)) {
+            if (stat->is_ok) {
+                SET_NEW_CMD(LWCELL_CMD_CUSD); /* Run next command */
+            }
+        }
+        /* The rest is handled in one layer above */
+#endif /* LWCELL_CFG_USSD */
+#if LWCELL_CFG_MQTT
+    } else if (CMD_IS_DEF(LWCELL_CMD_SMCONN)) {
+        const lwcell_mqtt_conn_desc_t* desc = msg->msg.mqtt_connect.desc;
+        lwcell_cmd_t conf_last = LWCELL_CMD_SMCONN; /* Command after last configuration step */
+
+#if LWCELL_CFG_SSL
+        if (desc->ssl != NULL) {
+            conf_last = LWCELL_CMD_SMSSL;
+        }
+#endif /* LWCELL_CFG_SSL */
+        if (stat->is_ok) {
+            switch (CMD_GET_CUR()) {
+                case LWCELL_CMD_SMCONF_URL: SET_NEW_CMD(LWCELL_CMD_SMCONF_CLIENTID); break;
+                case LWCELL_CMD_SMCONF_CLIENTID: SET_NEW_CMD(LWCELL_CMD_SMCONF_KEEPTIME); break;
+                case LWCELL_CMD_SMCONF_KEEPTIME: {
+                    SET_NEW_CMD(desc->username != NULL   ? LWCELL_CMD_SMCONF_USERNAME
+                                : desc->password != NULL ? LWCELL_CMD_SMCONF_PASSWORD
+                                                         : conf_last);
+                    break;
+                }
+                case LWCELL_CMD_SMCONF_USERNAME: {
+                    SET_NEW_CMD(desc->password != NULL ? LWCELL_CMD_SMCONF_PASSWORD : conf_last);
+                    break;
+                }
+                case LWCELL_CMD_SMCONF_PASSWORD: SET_NEW_CMD(conf_last); break;
+#if LWCELL_CFG_SSL
+                case LWCELL_CMD_SMSSL: SET_NEW_CMD(LWCELL_CMD_SMCONN); break;
+#endif /* LWCELL_CFG_SSL */
+                default: break;
+            }
+        }
+        if (n_cmd == LWCELL_CMD_IDLE) { /* Procedure finished, successful only after SMCONN */
+            lwcelli_mqtt_connect_done(stat->is_ok && CMD_IS_CUR(LWCELL_CMD_SMCONN) ? lwcellOK : lwcellERRCONNFAIL);
+        }
+    } else if (CMD_IS_DEF(LWCELL_CMD_SMDISC)) {
+        lwcelli_mqtt_disconnected(1); /* Connection is gone also on error */
+#endif /* LWCELL_CFG_MQTT */
+#if LWCELL_CFG_SSL
+    } else if (CMD_IS_DEF(LWCELL_CMD_CFSWFILE)) {
+        switch (CMD_GET_CUR()) {
+            case LWCELL_CMD_CFSINIT: { /* May be already initialized */
+                if (msg->msg.ssl_upload.sync) {
+                    lwcelli_ssl_file_digest(msg);
+                    SET_NEW_CMD(LWCELL_CMD_CFSGFIS); /* Check installed file first */
+                } else {
+                    SET_NEW_CMD(LWCELL_CMD_CFSWFILE);
+                }
+                break;
+            }
+            case LWCELL_CMD_CFSGFIS: {
+                /* File must have expected size and marker with the same digest must exist */
+                if (!msg->msg.ssl_upload.mark && stat->is_ok && msg->msg.ssl_upload.size == msg->msg.ssl_upload.len
+                    && msg->msg.ssl_upload.digest != 0) {
+                    msg->msg.ssl_upload.mark = 1;
+                    SET_NEW_CMD(LWCELL_CMD_CFSGFIS);
+                } else if (msg->msg.ssl_upload.mark && stat->is_ok) {
+                    SET_NEW_CMD(LWCELL_CMD_CFSTERM); /* Installed file is up to date */
+                } else {
+                    msg->msg.ssl_upload.mark = 0;
+                    SET_NEW_CMD(LWCELL_CMD_CFSWFILE);
+                }
+                break;
+            }
+            case LWCELL_CMD_CFSWFILE: {
+                if (stat->is_ok && !msg->msg.ssl_upload.failed) {
+                    if (msg->msg.ssl_upload.mark) {
+                        SET_NEW_CMD(LWCELL_CMD_CFSTERM); /* Marker is written after complete file */
+                        break;
+                    }
+                    msg->msg.ssl_upload.offset += msg->msg.ssl_upload.chunk_len;
+                    if (msg->msg.ssl_upload.offset < msg->msg.ssl_upload.len) {
+                        SET_NEW_CMD(LWCELL_CMD_CFSWFILE);
+                    } else if (msg->msg.ssl_upload.sync && msg->msg.ssl_upload.digest != 0) {
+                        msg->msg.ssl_upload.mark = 1;
+                        SET_NEW_CMD(LWCELL_CMD_CFSWFILE);
+                    } else {
+                        SET_NEW_CMD(LWCELL_CMD_CFSTERM);
+                    }
+                } else {
+                    msg->msg.ssl_upload.failed = 1;
+                    SET_NEW_CMD(LWCELL_CMD_CFSTERM); /* File system buffer is always released */
+                }
+                break;
+            }
+            case LWCELL_CMD_CFSTERM: {
+                if (msg->msg.ssl_upload.failed) {
+                    stat->is_ok = 0;
+                    stat->is_error = 1;
+                } else if (msg->msg.ssl_upload.uploaded != NULL) {
+                    *msg->msg.ssl_upload.uploaded = msg->msg.ssl_upload.offset > 0;
+                }
+                break;
+            }
+            default: break;
+        }
+#endif /* LWCELL_CFG_SSL */
+#if LWCELL_CFG_FS
+    } else if (CMD_IS_DEF(LWCELL_CMD_FS_WRITE)) {
+        switch (CMD_GET_CUR()) {
+            case LWCELL_CMD_CFSINIT: SET_NEW_CMD(LWCELL_CMD_CFSWFILE); break; /* May be already initialized */
+            case LWCELL_CMD_CFSWFILE: {
+                if (stat->is_ok) {
+                    msg->msg.fs_write.offset += msg->msg.fs_write.chunk_len;
+                    SET_NEW_CMD(msg->msg.fs_write.offset < msg->msg.fs_write.len ? LWCELL_CMD_CFSWFILE
+                                                                                 : LWCELL_CMD_CFSTERM);
+                } else {
+                    msg->msg.fs_write.failed = 1;
+                    SET_NEW_CMD(LWCELL_CMD_CFSTERM); /* File system buffer is always released */
+                }
+                break;
+            }
+            case LWCELL_CMD_CFSTERM: {
+                if (msg->msg.fs_write.bw != NULL) {
+                    *msg->msg.fs_write.bw = msg->msg.fs_write.offset;
+                }
+                if (msg->msg.fs_write.failed) {
+                    stat->is_ok = 0;
+                    stat->is_error = 1;
+                }
+                break;
+            }
+            default: break;
+        }
+    } else if (CMD_IS_DEF(LWCELL_CMD_CFSRFILE)) {
+        switch (CMD_GET_CUR()) {
+            case LWCELL_CMD_CFSINIT: SET_NEW_CMD(LWCELL_CMD_CFSRFILE); break; /* May be already initialized */
+            case LWCELL_CMD_CFSRFILE: {
+                if (msg->msg.data_read.br != NULL) {
+                    *msg->msg.data_read.br = msg->msg.data_read.recv_len;
+                }
+                msg->msg.data_read.failed = !stat->is_ok;
+                SET_NEW_CMD(LWCELL_CMD_CFSTERM); /* File system buffer is always released */
+                break;
+            }
+            case LWCELL_CMD_CFSTERM: {
+                if (msg->msg.data_read.failed) {
+                    stat->is_ok = 0;
+                    stat->is_error = 1;
+                }
+                break;
+            }
+            default: break;
+        }
+    } else if (CMD_IS_DEF(LWCELL_CMD_CFSGFIS) || CMD_IS_DEF(LWCELL_CMD_CFSDFILE)) {
+        if (CMD_IS_CUR(LWCELL_CMD_CFSINIT)) {
+            SET_NEW_CMD(msg->cmd_def); /* May be already initialized */
+        } else if (CMD_IS_CUR(LWCELL_CMD_CFSTERM)) {
+            if (msg->msg.fs_file.failed) {
+                stat->is_ok = 0;
+                stat->is_error = 1;
+            }
+        } else {
+            msg->msg.fs_file.failed = !stat->is_ok;
+            SET_NEW_CMD(LWCELL_CMD_CFSTERM); /* File system buffer is always released */
+        }
+#endif /* LWCELL_CFG_FS */
+#if LWCELL_CFG_SSL
+    } else if (CMD_IS_DEF(LWCELL_CMD_CSSLCFG_SSLVERSION)) {
+        const lwcell_ssl_cfg_t* cfg = msg->msg.ssl_cfg.cfg;
+        lwcell_cmd_t next = LWCELL_CMD_IDLE;
+
+        /* Steps are executed in fixed order, unused ones are skipped */
+        switch (CMD_GET_CUR()) {
+            case LWCELL_CMD_CSSLCFG_SSLVERSION:
+                if (cfg->sni != NULL) {
+                    next = LWCELL_CMD_CSSLCFG_SNI;
+                    break;
+                }
+                /* Fallthrough */
+            case LWCELL_CMD_CSSLCFG_SNI:
+                if (cfg->ca != NULL) {
+                    next = LWCELL_CMD_CSSLCFG_CONVERT_CA;
+                    break;
+                }
+                /* Fallthrough */
+            case LWCELL_CMD_CSSLCFG_CONVERT_CA:
+                if (cfg->cert != NULL && cfg->key != NULL) {
+                    next = LWCELL_CMD_CSSLCFG_CONVERT_CERT;
+                }
+                break;
+            default: break;
+        }
+        if (next != LWCELL_CMD_IDLE) {
+            SET_NEW_CMD_CHECK_ERROR(next);
+        }
+#endif /* LWCELL_CFG_SSL */
+#if LWCELL_CFG_GNSS
+    } else if (CMD_IS_DEF(LWCELL_CMD_CGNSPWR)) {
+        if (msg->msg.gnss.on) {
+            if (CMD_IS_CUR(LWCELL_CMD_CGNSPWR)) {
+                SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_CGNSURC);
+            }
+        } else if (CMD_IS_CUR(LWCELL_CMD_CGNSURC)) {
+            SET_NEW_CMD(LWCELL_CMD_CGNSPWR); /* Power off engine even if reports could not be disabled */
         }
-    } else if (CMD_IS_DEF(LWCELL_CMD_CIPCLOSE)) {
-        /*
-         * It is unclear in which state connection is when ERROR is received on close command.
-         * Stack checks if connection is closed before it allows and sends close command,
-         * however it was detected that no automatic close event has been received from device
-         * and AT+CIPCLOSE returned ERROR.
-         *
-         * Is it device firmware bug?
-         */
-        if (CMD_IS_CUR(LWCELL_CMD_CIPCLOSE) && stat->is_error) {
-            /* Notify upper layer about failed close event */
-            lwcell.evt.type = LWCELL_EVT_CONN_CLOSE;
-            lwcell.evt.evt.conn_active_close.conn = msg->msg.conn_close.conn;
-            lwcell.evt.evt.conn_active_close.forced = 1;
-            lwcell.evt.evt.conn_active_close.res = lwcellERR;
-            lwcell.evt.evt.conn_active_close.client =
-                msg->msg.conn_close.conn->status.f.active && msg->msg.conn_close.conn->status.f.client;
-            lwcelli_send_conn_cb(msg->msg.conn_close.conn, NULL);
+#endif /* LWCELL_CFG_GNSS */
+#if LWCELL_CFG_CELL_INFO
+    } else if (CMD_IS_DEF(LWCELL_CMD_CENG)) {
+        if (stat->is_ok && !msg->msg.cell_info.enable) {
+            lwcell.m.cell_info.valid = 0; /* Measurements are not updated anymore */
         }
-#endif /* LWCELL_CFG_CONN */
-#if LWCELL_CFG_USSD
-    } else if (CMD_IS_DEF(LWCELL_CMD_CUSD)) {
-        if (CMD_IS_CUR(LWCELL_CMD_CUSD_GET)) {
-            if (stat->is_ok) {
-                SET_NEW_CMD(LWCELL_CMD_CUSD); /* Run next command */
+#endif /* LWCELL_CFG_CELL_INFO */
+#if LWCELL_CFG_TIME
+    } else if (CMD_IS_DEF(LWCELL_CMD_CIPGSMLOC)) {
+        if (stat->is_ok && !msg->msg.time_loc.found) { /* Device replied, but location is not available */
+            stat->is_ok = 0;
+            stat->is_error = 1;
+        }
+#endif /* LWCELL_CFG_TIME */
+#if LWCELL_CFG_HTTP
+    } else if (CMD_IS_DEF(LWCELL_CMD_HTTPACTION)) {
+        switch (CMD_GET_CUR()) {
+            case LWCELL_CMD_HTTPTERM: SET_NEW_CMD(LWCELL_CMD_SAPBR_CONTYPE); break; /* Session may not be active */
+            case LWCELL_CMD_SAPBR_CONTYPE: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_SAPBR_OPEN); break;
+            case LWCELL_CMD_SAPBR_OPEN: SET_NEW_CMD(LWCELL_CMD_HTTPINIT); break; /* Bearer may already be open */
+            case LWCELL_CMD_HTTPINIT: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_HTTPPARA_CID); break;
+            case LWCELL_CMD_HTTPPARA_CID: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_HTTPPARA_URL); break;
+            case LWCELL_CMD_HTTPPARA_URL: {
+                SET_NEW_CMD_CHECK_ERROR(!strncmp(msg->msg.http_get.url, "https://", 8) ? LWCELL_CMD_HTTPSSL
+                                                                                       : LWCELL_CMD_HTTPACTION);
+                break;
             }
+            case LWCELL_CMD_HTTPSSL: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_HTTPACTION); break;
+            default: break;
         }
-        /* The rest is handled in one layer above */
-#endif /* LWCELL_CFG_USSD */
+    } else if (CMD_IS_DEF(LWCELL_CMD_SHREQ)) {
+        switch (CMD_GET_CUR()) {
+            case LWCELL_CMD_SHDISC: SET_NEW_CMD(LWCELL_CMD_SHCONF_URL); break; /* Session may not be active */
+            case LWCELL_CMD_SHCONF_URL: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_SHCONF_BODYLEN); break;
+            case LWCELL_CMD_SHCONF_BODYLEN: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_SHCONF_HEADERLEN); break;
+            case LWCELL_CMD_SHCONF_HEADERLEN: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_SHCONN); break;
+            case LWCELL_CMD_SHCONN: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_SHREQ); break;
+            default: break;
+        }
+    } else if (CMD_IS_DEF(LWCELL_CMD_HTTPREAD) || CMD_IS_DEF(LWCELL_CMD_SHREAD)) {
+        if (msg->msg.data_read.br != NULL) {
+            *msg->msg.data_read.br = msg->msg.data_read.recv_len;
+        }
+        if (stat->is_ok) { /* Report progress to application */
+            lwcell.evt.evt.http_read.buff = msg->msg.data_read.buff;
+            lwcell.evt.evt.http_read.offset = msg->msg.data_read.offset;
+            lwcell.evt.evt.http_read.len = msg->msg.data_read.recv_len;
+            lwcell.evt.evt.http_read.total_len = lwcell.m.http.content_len;
+            lwcelli_send_cb(LWCELL_EVT_HTTP_READ);
+        }
+    } else if (CMD_IS_DEF(LWCELL_CMD_HTTPTERM) || CMD_IS_DEF(LWCELL_CMD_SHDISC)) {
+        lwcell.m.http.active = 0; /* Session is gone also on error */
+#endif /* LWCELL_CFG_HTTP */
+#if LWCELL_CFG_FTP
+    } else if (CMD_IS_DEF(LWCELL_CMD_FTPGET_OPEN) || CMD_IS_DEF(LWCELL_CMD_FTPPUT_OPEN)) {
+        uint8_t is_put = CMD_IS_DEF(LWCELL_CMD_FTPPUT_OPEN), is_file = 0;
+
+#if LWCELL_CFG_FS
+        is_file = msg->msg.ftp_start.fs_name != NULL; /* File is uploaded from device file system at once */
+#endif /* LWCELL_CFG_FS */
+
+        switch (CMD_GET_CUR()) {
+            case LWCELL_CMD_SAPBR_CONTYPE: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_SAPBR_OPEN); break;
+            case LWCELL_CMD_SAPBR_OPEN: SET_NEW_CMD(LWCELL_CMD_FTPCID); break; /* Bearer may already be open */
+            case LWCELL_CMD_FTPCID: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_FTPSERV); break;
+            case LWCELL_CMD_FTPSERV: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_FTPPORT); break;
+            case LWCELL_CMD_FTPPORT: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_FTPUN); break;
+            case LWCELL_CMD_FTPUN: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_FTPPW); break;
+            case LWCELL_CMD_FTPPW:
+                SET_NEW_CMD_CHECK_ERROR(is_put ? LWCELL_CMD_FTPPUTNAME : LWCELL_CMD_FTPGETNAME);
+                break;
+            case LWCELL_CMD_FTPGETNAME: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_FTPGETPATH); break;
+            case LWCELL_CMD_FTPGETPATH: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_FTPREST); break;
+            case LWCELL_CMD_FTPREST: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_FTPGET_OPEN); break;
+            case LWCELL_CMD_FTPPUTNAME: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_FTPPUTPATH); break;
+            case LWCELL_CMD_FTPPUTPATH: SET_NEW_CMD_CHECK_ERROR(LWCELL_CMD_FTPPUTOPT); break;
+            case LWCELL_CMD_FTPPUTOPT:
+                SET_NEW_CMD_CHECK_ERROR(is_file ? LWCELL_CMD_FTPPUTFRMFS : LWCELL_CMD_FTPPUT_OPEN);
+                break;
+            default: break;
+        }
+        if (n_cmd == LWCELL_CMD_IDLE && stat->is_ok && !is_file) { /* Session is open */
+            lwcell.m.ftp.active = 1;
+            lwcell.m.ftp.is_put = is_put;
+            lwcell.m.ftp.offset = msg->msg.ftp_start.offset;
+        }
+    } else if (CMD_IS_DEF(LWCELL_CMD_FTPGET_READ)) {
+        if (msg->msg.data_read.br != NULL) {
+            *msg->msg.data_read.br = msg->msg.data_read.recv_len;
+        }
+        if (stat->is_ok && msg->msg.data_read.recv_len > 0) { /* Report progress to application */
+            lwcell.evt.evt.ftp_read.buff = msg->msg.data_read.buff;
+            lwcell.evt.evt.ftp_read.offset = lwcell.m.ftp.offset;
+            lwcell.evt.evt.ftp_read.len = msg->msg.data_read.recv_len;
+            lwcell.m.ftp.offset += msg->msg.data_read.recv_len;
+            lwcelli_send_cb(LWCELL_EVT_FTP_READ);
+        }
+    } else if (CMD_IS_DEF(LWCELL_CMD_FTPPUT_WRITE)) {
+        if (stat->is_ok) {
+            lwcell.m.ftp.offset += msg->msg.ftp_put.len;
+        } else if (msg->msg.ftp_put.resp_received) {
+            lwcell.m.ftp.active = 0; /* Device reported upload error, session is closed */
+        }
+        if (msg->msg.ftp_put.bw != NULL) {
+            *msg->msg.ftp_put.bw = stat->is_ok ? msg->msg.ftp_put.len : 0;
+        }
+    } else if (CMD_IS_DEF(LWCELL_CMD_FTPPUT_END) || CMD_IS_DEF(LWCELL_CMD_FTPQUIT)) {
+        lwcell.m.ftp.active = 0; /* Session is gone also on error */
+#endif /* LWCELL_CFG_FTP */
+#if LWCELL_CFG_PING
+    } else if (CMD_IS_DEF(LWCELL_CMD_CIPPING)) {
+        lwcelli_ping_run_finished(msg, stat->is_ok ? lwcellOK : lwcellERR);
+#endif /* LWCELL_CFG_PING */
+#if LWCELL_CFG_DNS
+    } else if (CMD_IS_DEF(LWCELL_CMD_CDNSGIP)) {
+        lwcelli_dns_resolve_finished(msg, stat->is_ok);
+#endif /* LWCELL_CFG_DNS */
+#if LWCELL_CFG_CMUX
+    } else if (CMD_IS_DEF(LWCELL_CMD_CMUX)) {
+        if (stat->is_ok) {
+            lwcelli_cmux_enter(); /* Device expects frames from now on */
+        }
+#endif /* LWCELL_CFG_CMUX */
+#if LWCELL_CFG_PPP
+    } else if (CMD_IS_DEF(LWCELL_CMD_PPP_DIAL) || CMD_IS_DEF(LWCELL_CMD_ATO)) {
+        lwcelli_ppp_dial_finished(stat->is_ok);
+#endif /* LWCELL_CFG_PPP */
+#if LWCELL_CFG_PWR
+    } else if (CMD_IS_DEF(LWCELL_CMD_CSCLK_SET)) {
+        lwcelli_pwr_sleep_configured(msg, stat->is_ok);
+#endif /* LWCELL_CFG_PWR */
     }
 
     /* Check if new command was set for execution */
@@ -1720,9 +5348,126 @@ lwcelli_process_sub_cmd(lwcell_msg_t* msg, lwcell_status_flags_t* stat) {
     } else {
         msg->cmd = LWCELL_CMD_IDLE;
     }
+#if LWCELL_CFG_CONN_SEND_DEADLINE
+    if (CMD_IS_DEF(LWCELL_CMD_CIPSEND) && msg->msg.conn_send.stale) {
+        return lwcellERRSTALE;
+    }
+#endif /* LWCELL_CFG_CONN_SEND_DEADLINE */
     return stat->is_ok ? lwcellOK : lwcellERR;
 }
 
+/**
+ * \brief           Requests of commands, sent as constant string after `AT` prefix
+ *
+ * Commands listed here are encoded by \ref lwcelli_initiate_cmd without dedicated `case` statement.
+ * Commands with arguments or with additional logic are handled in its `switch` statement.
+ */
+static const char* const cmd_const_req[LWCELL_CMD_END] = {
+    [LWCELL_CMD_CMEE_SET] = "+CMEE=1", /* Enable detailed error messages */
+    [LWCELL_CMD_CLCC_SET] = "+CLCC=1", /* Enable detailed call info */
+    [LWCELL_CMD_CGMI_GET] = "+CGMI",   /* Get manufacturer */
+    [LWCELL_CMD_CGMM_GET] = "+CGMM",   /* Get model */
+    [LWCELL_CMD_CGSN_GET] = "+CGSN",   /* Get serial number */
+    [LWCELL_CMD_CGMR_GET] = "+CGMR",   /* Get revision */
+    [LWCELL_CMD_CREG_SET] = "+CREG=1", /* Enable +CREG message */
+#if LWCELL_CFG_NETWORK_PS_REG
+    [LWCELL_CMD_CGREG_SET] = "+CGREG=2;+CGREG?", /* Enable +CGREG message with location */
+    [LWCELL_CMD_CEREG_SET] = "+CEREG=2;+CEREG?", /* Enable +CEREG message with location */
+#endif /* LWCELL_CFG_NETWORK_PS_REG */
+    [LWCELL_CMD_CREG_GET] = "+CREG?",      /* Get network registration status */
+    [LWCELL_CMD_CPIN_GET] = "+CPIN?",      /* Read current SIM status */
+    [LWCELL_CMD_COPS_GET] = "+COPS?",      /* Get current operator */
+    [LWCELL_CMD_COPS_GET_OPT] = "+COPS=?", /* Get list of available operators */
+    [LWCELL_CMD_CSQ_GET] = "+CSQ",         /* Get signal strength */
+#if LWCELL_CFG_RSSI_URC
+    [LWCELL_CMD_EXUNSOL_SQ_SET] = "+EXUNSOL=\"SQ\",1", /* Enable signal quality reports */
+#endif /* LWCELL_CFG_RSSI_URC */
+#if LWCELL_CFG_NETWORK_BAND
+    [LWCELL_CMD_CPSI_GET] = "+CPSI?", /* Get serving cell system information */
+#endif /* LWCELL_CFG_NETWORK_BAND */
+    [LWCELL_CMD_CNUM] = "+CNUM",       /* Get SIM number */
+    [LWCELL_CMD_CIPSHUT] = "+CIPSHUT", /* Shut down network connection and put to reset state */
+#if LWCELL_CFG_CONN
+    [LWCELL_CMD_CIPMUX] = "+CIPMUX=1",      /* Enable multiple connections */
+    [LWCELL_CMD_CIPHEAD] = "+CIPHEAD=1",    /* Enable information on receive data about connection and length */
+    [LWCELL_CMD_CIPSRIP] = "+CIPSRIP=1",
+    [LWCELL_CMD_CIPSEND_GET] = "+CIPSEND?", /* Get maximal send length of all connections */
+    [LWCELL_CMD_CNACT_SET] = "+CNACT=0,1",  /* Activate PDP context for socket commands */
+    [LWCELL_CMD_CIPSTATUS] = "+CIPSTATUS",  /* Get status of device and all connections */
+#endif /* LWCELL_CFG_CONN */
+#if LWCELL_CFG_SMS
+#if LWCELL_CFG_SMS_DIRECT
+    [LWCELL_CMD_CNMI] = "+CNMI=2,2,0,0,0", /* Forward new messages directly with +CMT */
+#endif /* LWCELL_CFG_SMS_DIRECT */
+    [LWCELL_CMD_CPMS_GET_OPT] = "+CPMS=?", /* Get available SMS storages */
+    [LWCELL_CMD_CPMS_GET] = "+CPMS?",      /* Get current SMS storage info */
+#endif /* LWCELL_CFG_SMS */
+#if LWCELL_CFG_CALL
+    [LWCELL_CMD_ATA] = "A", /* Answer phone call */
+#endif /* LWCELL_CFG_CALL */
+#if LWCELL_CFG_CALL || LWCELL_CFG_PPP
+    [LWCELL_CMD_ATH] = "H", /* Disconnect existing connection (hang-up phone call) */
+#endif /* LWCELL_CFG_CALL || LWCELL_CFG_PPP */
+#if LWCELL_CFG_PPP
+    [LWCELL_CMD_PPP_DIAL] = "D*99#", /* Dial packet service */
+    [LWCELL_CMD_ATO] = "O",          /* Return to data mode */
+#endif /* LWCELL_CFG_PPP */
+#if LWCELL_CFG_PHONEBOOK
+    [LWCELL_CMD_CPBS_GET_OPT] = "+CPBS=?", /* Get available phonebook storages */
+    [LWCELL_CMD_CPBS_GET] = "+CPBS?",      /* Get current memory info */
+#endif /* LWCELL_CFG_PHONEBOOK */
+#if LWCELL_CFG_NETWORK
+    [LWCELL_CMD_CGACT_SET_1] = "+CGACT=1",
+    [LWCELL_CMD_CGATT_SET_1] = "+CGATT=1",
+#if LWCELL_CFG_NETWORK_ATTACH_INCREMENTAL
+    [LWCELL_CMD_CGATT_GET] = "+CGATT?",
+#endif /* LWCELL_CFG_NETWORK_ATTACH_INCREMENTAL */
+    [LWCELL_CMD_CIPMUX_SET] = "+CIPMUX=1",
+    [LWCELL_CMD_CIICR] = "+CIICR",
+    [LWCELL_CMD_CIFSR] = "+CIFSR",
+#endif /* LWCELL_CFG_NETWORK */
+#if LWCELL_CFG_USSD
+    [LWCELL_CMD_CUSD_GET] = "+CUSD?",
+#endif /* LWCELL_CFG_USSD */
+#if LWCELL_CFG_MQTT
+    [LWCELL_CMD_SMCONN] = "+SMCONN",
+    [LWCELL_CMD_SMDISC] = "+SMDISC",
+#endif /* LWCELL_CFG_MQTT */
+#if LWCELL_CFG_SSL || LWCELL_CFG_FS
+    [LWCELL_CMD_CFSINIT] = "+CFSINIT",
+    [LWCELL_CMD_CFSTERM] = "+CFSTERM",
+#endif /* LWCELL_CFG_SSL || LWCELL_CFG_FS */
+#if LWCELL_CFG_GNSS
+    [LWCELL_CMD_CGNSINF] = "+CGNSINF",
+#endif /* LWCELL_CFG_GNSS */
+#if LWCELL_CFG_TIME
+    [LWCELL_CMD_CLTS_SET] = "+CLTS=1",
+    [LWCELL_CMD_CCLK] = "+CCLK?",
+    [LWCELL_CMD_CIPGSMLOC] = "+CIPGSMLOC=1,1", /* Location and time with bearer profile 1 */
+#endif /* LWCELL_CFG_TIME */
+#if LWCELL_CFG_HTTP || LWCELL_CFG_FTP
+    [LWCELL_CMD_SAPBR_CONTYPE] = "+SAPBR=3,1,\"Contype\",\"GPRS\"",
+    [LWCELL_CMD_SAPBR_OPEN] = "+SAPBR=1,1",
+#endif /* LWCELL_CFG_HTTP || LWCELL_CFG_FTP */
+#if LWCELL_CFG_HTTP
+    [LWCELL_CMD_HTTPINIT] = "+HTTPINIT",
+    [LWCELL_CMD_HTTPPARA_CID] = "+HTTPPARA=\"CID\",1",
+    [LWCELL_CMD_HTTPSSL] = "+HTTPSSL=1",
+    [LWCELL_CMD_HTTPACTION] = "+HTTPACTION=0",
+    [LWCELL_CMD_HTTPTERM] = "+HTTPTERM",
+    [LWCELL_CMD_SHCONF_BODYLEN] = "+SHCONF=\"BODYLEN\",1024",
+    [LWCELL_CMD_SHCONF_HEADERLEN] = "+SHCONF=\"HEADERLEN\",350",
+    [LWCELL_CMD_SHCONN] = "+SHCONN",
+    [LWCELL_CMD_SHDISC] = "+SHDISC",
+#endif /* LWCELL_CFG_HTTP */
+#if LWCELL_CFG_FTP
+    [LWCELL_CMD_FTPCID] = "+FTPCID=1",
+    [LWCELL_CMD_FTPGET_OPEN] = "+FTPGET=1",
+    [LWCELL_CMD_FTPPUT_OPEN] = "+FTPPUT=1",
+    [LWCELL_CMD_FTPQUIT] = "+FTPQUIT",
+#endif /* LWCELL_CFG_FTP */
+};
+
 /**
  * \brief           Function to initialize every AT command
  * \note            Never call this function directly. Set as initialization function for command and use `msg->fn(msg)`
@@ -1731,537 +5476,1273 @@ lwcelli_process_sub_cmd(lwcell_msg_t* msg, lwcell_status_flags_t* stat) {
  */
 lwcellr_t
 lwcelli_initiate_cmd(lwcell_msg_t* msg) {
+    const char* req;
+
+    /* Generic encoder for commands without arguments */
+    if (CMD_GET_CUR() < LWCELL_CMD_END && (req = cmd_const_req[CMD_GET_CUR()]) != NULL) {
+        AT_PORT_SEND_BEGIN_AT();
+        AT_PORT_SEND_STR(req);
+        AT_PORT_SEND_END_AT();
+        return lwcellOK;
+    }
     switch (CMD_GET_CUR()) {     /* Check current message we want to send over AT */
         case LWCELL_CMD_RESET: { /* Reset modem with AT commands */
+            /* Wait requested time first, with command parked */
+            if (msg->msg.reset.delay > 0) {
+                uint32_t delay = msg->msg.reset.delay;
+
+                msg->msg.reset.delay = 0;
+                if (lwcelli_cmd_park(msg, delay)) {
+                    break;
+                }
+            }
+
             /* Try with hardware reset */
-            if (lwcell.ll.reset_fn != NULL && lwcell.ll.reset_fn(1)) {
+            if (!msg->msg.reset.hw_reset && lwcell.ll.reset_fn != NULL && lwcell.ll.reset_fn(1)) {
                 lwcell_delay(2);
                 lwcell.ll.reset_fn(0);
-                lwcell_delay(500);
+#if LWCELL_CFG_AT_PORT_BAUDRATE_UPSHIFT
+                lwcelli_reset_baud_apply(LWCELL_CFG_AT_PORT_BAUDRATE); /* Device is back at default rate */
+#endif /* LWCELL_CFG_AT_PORT_BAUDRATE_UPSHIFT */
+                msg->msg.reset.hw_reset = 1;
+                if (lwcelli_cmd_park(msg, HW_RESET_RECOVERY_TIME)) {
+                    break; /* Device needs some time before it accepts commands */
+                }
+            }
+
+            /* Send manual AT command */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+CFUN=1,1");
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+#if LWCELL_CFG_CMD_TIMEOUT_ADAPT || LWCELL_CFG_SUPERVISOR
+        case LWCELL_CMD_PROBE:
+#endif                                            /* LWCELL_CFG_CMD_TIMEOUT_ADAPT || LWCELL_CFG_SUPERVISOR */
+        case LWCELL_CMD_RESET_DEVICE_FIRST_CMD: { /* First command for device driver specific reset */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+#if LWCELL_CFG_AT_PORT_BAUDRATE_UPSHIFT
+        case LWCELL_CMD_UART: { /* Set fixed local rate */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+IPR=");
+            lwcelli_send_number(baud_candidates[msg->msg.reset.baud_idx], 0, 0);
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+        case LWCELL_CMD_UART_CHECK: { /* Verify link at new rate */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+#endif /* LWCELL_CFG_AT_PORT_BAUDRATE_UPSHIFT */
+        case LWCELL_CMD_ATE0:
+        case LWCELL_CMD_ATE1: {
+            AT_PORT_SEND_BEGIN_AT();
+            if (CMD_IS_CUR(LWCELL_CMD_ATE0)) {
+                AT_PORT_SEND_CONST_STR("E0");
+            } else {
+                AT_PORT_SEND_CONST_STR("E1");
+            }
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+        case LWCELL_CMD_CFUN_SET: {
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+CFUN=");
+            /**
+             * \todo: If CFUN command forced, check value
+             */
+            if (CMD_IS_DEF(LWCELL_CMD_RESET) || (CMD_IS_DEF(LWCELL_CMD_CFUN_SET) && msg->msg.cfun.mode)) {
+                AT_PORT_SEND_CONST_STR("1");
+            } else {
+                AT_PORT_SEND_CONST_STR("0");
+            }
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+        case LWCELL_CMD_CPIN_SET: { /* Set SIM pin code */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+CPIN=");
+            lwcelli_send_string(msg->msg.cpin_enter.pin, 0, 1, 0);
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+        case LWCELL_CMD_CPIN_ADD: { /* Add new pin code */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+CLCK=\"SC\",1,");
+            lwcelli_send_string(msg->msg.cpin_add.pin, 0, 1, 0);
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+        case LWCELL_CMD_CPIN_CHANGE: { /* Change already active SIM */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+CPWD=\"SC\"");
+            lwcelli_send_string(msg->msg.cpin_change.current_pin, 0, 1, 1);
+            lwcelli_send_string(msg->msg.cpin_change.new_pin, 0, 1, 1);
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+        case LWCELL_CMD_CPIN_REMOVE: { /* Remove current PIN */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+CLCK=\"SC\",0,");
+            lwcelli_send_string(msg->msg.cpin_remove.pin, 0, 1, 0);
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+        case LWCELL_CMD_CPUK_SET: { /* Enter PUK and set new PIN */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+CPIN=");
+            lwcelli_send_string(msg->msg.cpuk_enter.puk, 0, 1, 0);
+            lwcelli_send_string(msg->msg.cpuk_enter.pin, 0, 1, 1);
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+        case LWCELL_CMD_COPS_SET: { /* Set current operator */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+COPS=");
+            lwcelli_send_number(LWCELL_U32(msg->msg.cops_set.mode), 0, 0);
+            if (msg->msg.cops_set.mode == LWCELL_OPERATOR_MODE_FORMAT) {
+                lwcelli_send_number(LWCELL_U32(msg->msg.cops_set.format), 0, 1);
+            } else if (msg->msg.cops_set.mode != LWCELL_OPERATOR_MODE_AUTO) {
+                lwcelli_send_number(LWCELL_U32(msg->msg.cops_set.format), 0, 1);
+                switch (msg->msg.cops_set.format) {
+                    case LWCELL_OPERATOR_FORMAT_LONG_NAME:
+                    case LWCELL_OPERATOR_FORMAT_SHORT_NAME: lwcelli_send_string(msg->msg.cops_set.name, 1, 1, 1); break;
+                    default: lwcelli_send_number(LWCELL_U32(msg->msg.cops_set.num), 0, 1);
+                }
+            }
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+#if LWCELL_CFG_NETWORK_BAND
+        case LWCELL_CMD_CNMP_SET: { /* Set preferred mode, 2 = automatic, 13 = GSM only, 38 = LTE only */
+            uint32_t mode = 2;
+
+            if (!(msg->msg.network_band.rat & LWCELL_NETWORK_RAT_CATM_NBIOT)) {
+                mode = 13;
+            } else if (!(msg->msg.network_band.rat & LWCELL_NETWORK_RAT_GSM)) {
+                mode = 38;
+            }
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+CNMP=");
+            lwcelli_send_number(mode, 0, 0);
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+        case LWCELL_CMD_CMNB_SET: { /* Set preferred LTE mode, 1 = CAT-M, 2 = NB-IoT, 3 = both */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+CMNB=");
+            lwcelli_send_number(LWCELL_U32(msg->msg.network_band.rat & LWCELL_NETWORK_RAT_CATM_NBIOT), 0, 0);
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+        case LWCELL_CMD_CBANDCFG_SET: { /* Set bands of single LTE mode */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+CBANDCFG=");
+            lwcelli_send_string(msg->msg.network_band.cfg_rat == LWCELL_NETWORK_RAT_CATM ? "CAT-M" : "NB-IOT", 0, 1,
+                                0);
+            for (size_t i = 0; i < msg->msg.network_band.bands_len; ++i) {
+                lwcelli_send_number(LWCELL_U32(msg->msg.network_band.bands[i]), 0, 1);
+            }
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+#endif /* LWCELL_CFG_NETWORK_BAND */
+        case LWCELL_CMD_QUERY_BATCH: { /* Send all queries in single command line */
+            static const struct {
+                uint32_t query;
+                const char* cmd;
+            } queries[] = {
+                {LWCELL_QUERY_RSSI, "+CSQ"},
+                {LWCELL_QUERY_REG_STATUS, "+CREG?"},
+                {LWCELL_QUERY_OPERATOR, "+COPS?"},
+                {LWCELL_QUERY_SIM_STATE, "+CPIN?"},
+            };
+            uint8_t sep = 0;
+
+            AT_PORT_SEND_BEGIN_AT();
+            for (size_t i = 0; i < LWCELL_ARRAYSIZE(queries); ++i) {
+                if (msg->msg.query_batch.queries & queries[i].query) {
+                    if (sep) {
+                        AT_PORT_SEND_CONST_STR(";");
+                    }
+                    AT_PORT_SEND_STR(queries[i].cmd);
+                    sep = 1;
+                }
+            }
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+#if LWCELL_CFG_CONN
+#if LWCELL_CFG_CONN_SERVER
+        case LWCELL_CMD_CIPSERVER: { /* Enable or disable server mode */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+CIPSERVER=");
+            if (msg->msg.conn_server.en) {
+                lwcelli_send_number(1, 0, 0);
+                lwcelli_send_port(msg->msg.conn_server.port, 0, 1);
+            } else {
+                lwcelli_send_number(0, 0, 0);
+            }
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+#endif /* LWCELL_CFG_CONN_SERVER */
+        case LWCELL_CMD_CIPSSL: { /* Set SSL configuration */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+CIPSSL=");
+            lwcelli_send_number((msg->msg.conn_start.type == LWCELL_CONN_TYPE_SSL) ? 1 : 0, 0, 0);
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+        case LWCELL_CMD_CIPSTART: { /* Start a new connection */
+            lwcell_conn_t* c = NULL;
+            const lwcell_ip_t* ip = NULL;
+
+            /* Do we have network connection? */
+            /* Check if we are connected to network */
+
+            msg->msg.conn_start.num = 0;                              /* Start with max value = invalidated */
+            for (int16_t i = LWCELL_CFG_MAX_CONNS - 1; i >= 0; --i) { /* Find available connection */
+                if (!lwcell.m.conns[i].status.f.active) {
+                    c = &lwcell.m.conns[i];
+                    c->num = LWCELL_U8(i);
+                    msg->msg.conn_start.num = LWCELL_U8(i); /* Set connection number for message structure */
+                    break;
+                }
+            }
+#if LWCELL_CFG_NETWORK_PDP_RECOVERY
+            if (msg->msg.conn_start.restart != NULL) {
+                c = msg->msg.conn_start.restart; /* Restored connection keeps its number */
+                msg->msg.conn_start.num = c->num;
+            }
+#endif /* LWCELL_CFG_NETWORK_PDP_RECOVERY */
+            if (c == NULL) {
+                lwcelli_send_conn_error_cb(msg, lwcellERRNOFREECONN);
+                return lwcellERRNOFREECONN; /* We don't have available connection */
+            }
+
+            if (msg->msg.conn_start.conn != NULL) { /* Is user interested about connection info? */
+                *msg->msg.conn_start.conn = c;      /* Save connection for user */
+            }
+
+            AT_PORT_SEND_BEGIN_AT();
+            CONN_DRV()->send_open(c);
+            if (msg->msg.conn_start.type == LWCELL_CONN_TYPE_UDP) {
+                lwcelli_send_string("UDP", 0, 1, 1);
+            } else {
+                lwcelli_send_string("TCP", 0, 1, 1);
+            }
+#if LWCELL_CFG_DNS
+            ip = lwcelli_dns_cache_get(msg->msg.conn_start.host);
+#endif /* LWCELL_CFG_DNS */
+#if LWCELL_CFG_NETWORK_PDP_RECOVERY
+            if (msg->msg.conn_start.restart != NULL) {
+                ip = &c->remote_ip; /* Address reported by device before context was lost */
+            }
+#endif /* LWCELL_CFG_NETWORK_PDP_RECOVERY */
+            if (ip != NULL) {
+                lwcelli_send_ip_mac(ip, 1, 1, 1); /* Cached address, device does not resolve name again */
+            } else {
+                lwcelli_send_string(msg->msg.conn_start.host, 0, 1, 1);
+            }
+            lwcelli_send_port(msg->msg.conn_start.port, 0, 1);
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+        case LWCELL_CMD_CIPCLOSE: { /* Close the connection */
+            lwcell_conn_p c = msg->msg.conn_close.conn;
+            if (c != NULL &&
+                /* Is connection already closed or command for this connection is not valid anymore? */
+                (!lwcell_conn_is_active(c) || c->val_id != msg->msg.conn_close.val_id)) {
+                return lwcellERR;
             }
-
-            /* Send manual AT command */
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CFUN=1,1");
+            CONN_DRV()->send_close(
+                LWCELL_U32(msg->msg.conn_close.conn ? msg->msg.conn_close.conn->num : LWCELL_CFG_MAX_CONNS));
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_RESET_DEVICE_FIRST_CMD: { /* First command for device driver specific reset */
+        case LWCELL_CMD_CIPSEND: {                    /* Send data to connection */
+            return lwcelli_tcpip_process_send_data(); /* Process send data */
+        }
+#if LWCELL_CFG_CONN_MANUAL_RECV
+        case LWCELL_CMD_CIPRXGET: { /* Read data from device buffer */
+            lwcell_conn_p c = msg->msg.ciprxget.conn;
+            if (!lwcell_conn_is_active(c) || c->val_id != msg->msg.ciprxget.val_id) {
+                return lwcellERR;
+            }
             AT_PORT_SEND_BEGIN_AT();
+            CONN_DRV()->send_read(c, msg->msg.ciprxget.len);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_ATE0:
-        case LWCELL_CMD_ATE1: {
+        case LWCELL_CMD_CIPRXGET_QUERY: { /* Query number of bytes in device buffer */
+            lwcell_conn_p c = msg->msg.ciprxget.conn;
+            if (!lwcell_conn_is_active(c) || c->val_id != msg->msg.ciprxget.val_id) {
+                return lwcellERR;
+            }
             AT_PORT_SEND_BEGIN_AT();
-            if (CMD_IS_CUR(LWCELL_CMD_ATE0)) {
-                AT_PORT_SEND_CONST_STR("E0");
+            AT_PORT_SEND_CONST_STR("+CIPRXGET=4");
+            lwcelli_send_number(LWCELL_U32(c->num), 0, 1);
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV */
+#endif /* LWCELL_CFG_CONN */
+#if LWCELL_CFG_SMS
+        case LWCELL_CMD_CMGF: { /* Select SMS message format */
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+CMGF=");
+            if (CMD_IS_DEF(LWCELL_CMD_CMGS)) {
+                lwcelli_send_number(LWCELL_U32(!!msg->msg.sms_send.format), 0, 0);
+            } else if (CMD_IS_DEF(LWCELL_CMD_CMGR)) {
+                lwcelli_send_number(LWCELL_U32(!!msg->msg.sms_read.format), 0, 0);
+            } else if (CMD_IS_DEF(LWCELL_CMD_CMGL)) {
+                lwcelli_send_number(LWCELL_U32(!!msg->msg.sms_list.format), 0, 0);
             } else {
-                AT_PORT_SEND_CONST_STR("E1");
+                /* Used for all other operations like delete all messages, etc */
+                AT_PORT_SEND_CONST_STR("1");
             }
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CMEE_SET: { /* Enable detailed error messages */
+        case LWCELL_CMD_CMGS: { /* Send SMS */
+#if LWCELL_CFG_SMS_PDU
+            if (!msg->msg.sms_send.format) {
+                uint8_t pdu[LWCELL_SMS_PDU_MAX_LEN];
+                size_t pdu_len = lwcelli_sms_pdu_encode_part(msg, pdu);
+
+                if (pdu_len == 0) {
+                    return lwcellERRPAR;
+                }
+                AT_PORT_SEND_BEGIN_AT();
+                AT_PORT_SEND_CONST_STR("+CMGS=");
+                lwcelli_send_number(LWCELL_U32(pdu_len - 1), 0, 0); /* TPDU length, without SCA octet */
+                AT_PORT_SEND_END_AT();
+                break;
+            }
+#endif /* LWCELL_CFG_SMS_PDU */
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CMEE=1");
+            AT_PORT_SEND_CONST_STR("+CMGS=");
+            lwcelli_send_string(msg->msg.sms_send.num, 0, 1, 0);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CLCC_SET: { /* Enable detailed call info */
+        case LWCELL_CMD_CMGR: { /* Read message */
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CLCC=1");
+            AT_PORT_SEND_CONST_STR("+CMGR=");
+            lwcelli_send_number(LWCELL_U32(msg->msg.sms_read.pos), 0, 0);
+            lwcelli_send_number(LWCELL_U32(!msg->msg.sms_read.update), 0, 1);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CGMI_GET: { /* Get manufacturer */
+        case LWCELL_CMD_CMGD: { /* Delete SMS message */
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CGMI");
+            AT_PORT_SEND_CONST_STR("+CMGD=");
+            lwcelli_send_number(LWCELL_U32(msg->msg.sms_delete.pos), 0, 0);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CGMM_GET: { /* Get model */
+        case LWCELL_CMD_CMGDA: { /* Mass delete SMS messages */
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CGMM");
+            AT_PORT_SEND_CONST_STR("+CMGDA=");
+            switch (msg->msg.sms_delete_all.status) {
+                case LWCELL_SMS_STATUS_READ: lwcelli_send_string("DEL READ", 0, 1, 0); break;
+                case LWCELL_SMS_STATUS_UNREAD: lwcelli_send_string("DEL UNREAD", 0, 1, 0); break;
+                case LWCELL_SMS_STATUS_SENT: lwcelli_send_string("DEL SENT", 0, 1, 0); break;
+                case LWCELL_SMS_STATUS_UNSENT: lwcelli_send_string("DEL UNSENT", 0, 1, 0); break;
+                case LWCELL_SMS_STATUS_INBOX: lwcelli_send_string("DEL INBOX", 0, 1, 0); break;
+                case LWCELL_SMS_STATUS_ALL: lwcelli_send_string("DEL ALL", 0, 1, 0); break;
+                default: break;
+            }
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CGSN_GET: { /* Get serial number */
+
+        case LWCELL_CMD_CMGL: { /* Delete SMS message */
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CGSN");
+            AT_PORT_SEND_CONST_STR("+CMGL=");
+            lwcelli_send_sms_stat(msg->msg.sms_list.status, 1, 0);
+            lwcelli_send_number(LWCELL_U32(!msg->msg.sms_list.update), 0, 1);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CGMR_GET: { /* Get revision */
+        case LWCELL_CMD_CPMS_SET: { /* Set active SMS storage(s) */
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CGMR");
+            AT_PORT_SEND_CONST_STR("+CPMS=");
+            if (CMD_IS_DEF(LWCELL_CMD_CMGR)) { /* Read SMS original command? */
+                lwcelli_send_dev_memory(msg->msg.sms_read.mem == LWCELL_MEM_CURRENT ? lwcell.m.sms.mem[0].current
+                                                                                    : msg->msg.sms_read.mem,
+                                        1, 0);
+            } else if (CMD_IS_DEF(LWCELL_CMD_CMGD)) { /* Delete SMS original command? */
+                lwcelli_send_dev_memory(msg->msg.sms_delete.mem == LWCELL_MEM_CURRENT ? lwcell.m.sms.mem[0].current
+                                                                                      : msg->msg.sms_delete.mem,
+                                        1, 0);
+            } else if (CMD_IS_DEF(LWCELL_CMD_CMGL)) { /* List SMS original command? */
+                lwcelli_send_dev_memory(msg->msg.sms_list.mem == LWCELL_MEM_CURRENT ? lwcell.m.sms.mem[0].current
+                                                                                    : msg->msg.sms_list.mem,
+                                        1, 0);
+            } else if (CMD_IS_DEF(
+                           LWCELL_CMD_CPMS_SET)) { /* Do we want to set memory for read/delete,sent/write,receive? */
+                for (size_t i = 0; i < 3; ++i) {   /* Write 3 memories */
+                    lwcelli_send_dev_memory(msg->msg.sms_memory.mem[i] == LWCELL_MEM_CURRENT
+                                                ? lwcell.m.sms.mem[i].current
+                                                : msg->msg.sms_memory.mem[i],
+                                            1, !!i);
+                }
+            }
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CREG_SET: { /* Enable +CREG message */
+#endif /* LWCELL_CFG_SMS */
+#if LWCELL_CFG_CALL
+        case LWCELL_CMD_ATD: { /* Start new call */
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CREG=1");
+            AT_PORT_SEND_CONST_STR("D");
+            lwcelli_send_string(msg->msg.call_start.number, 0, 0, 0);
+            AT_PORT_SEND_CONST_STR(";");
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CREG_GET: { /* Get network registration status */
+#endif /* LWCELL_CFG_CALL */
+#if LWCELL_CFG_PHONEBOOK
+        case LWCELL_CMD_CPBS_SET: { /* Get current memory info */
+            lwcell_mem_t mem;
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CREG?");
+            AT_PORT_SEND_CONST_STR("+CPBS=");
+            switch (CMD_GET_DEF()) {
+                case LWCELL_CMD_CPBW_SET: mem = msg->msg.pb_write.mem; break;
+                case LWCELL_CMD_CPBR: mem = msg->msg.pb_list.mem; break;
+                case LWCELL_CMD_CPBF: mem = msg->msg.pb_search.mem; break;
+                case LWCELL_CMD_PHONEBOOK_IMPORT: mem = msg->msg.pb_import.mem; break;
+#if LWCELL_CFG_PHONEBOOK_MIRROR
+                case LWCELL_CMD_PHONEBOOK_MIRROR_LOAD: mem = msg->msg.pb_mirror.mem; break;
+#endif /* LWCELL_CFG_PHONEBOOK_MIRROR */
+                default: break;
+            }
+            lwcelli_send_dev_memory(mem == LWCELL_MEM_CURRENT ? lwcell.m.pb.mem.current : mem, 1, 0);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CFUN_SET: {
+        case LWCELL_CMD_CPBW_SET: { /* Write/Delete new/old entry */
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CFUN=");
-            /**
-             * \todo: If CFUN command forced, check value
-             */
-            if (CMD_IS_DEF(LWCELL_CMD_RESET) || (CMD_IS_DEF(LWCELL_CMD_CFUN_SET) && msg->msg.cfun.mode)) {
-                AT_PORT_SEND_CONST_STR("1");
-            } else {
-                AT_PORT_SEND_CONST_STR("0");
+            AT_PORT_SEND_CONST_STR("+CPBW=");
+            if (CMD_IS_DEF(LWCELL_CMD_PHONEBOOK_IMPORT)) {
+                lwcell_pb_entry_t* e = msg->msg.pb_import.entry;
+
+#if LWCELL_CFG_PHONEBOOK_MIRROR
+                if (e->pos == 0) { /* Choose position so mirror knows where new entry is */
+                    e->pos = lwcelli_pb_mirror_free_pos(msg->msg.pb_import.mem);
+                }
+#endif /* LWCELL_CFG_PHONEBOOK_MIRROR */
+                if (e->pos > 0) {
+                    lwcelli_send_number(LWCELL_U32(e->pos), 0, 0);
+                }
+                lwcelli_send_string(e->number, 0, 1, 1);
+                lwcelli_send_number(LWCELL_U32(e->type), 0, 1);
+                lwcelli_send_string(e->name, 0, 1, 1);
+                AT_PORT_SEND_END_AT();
+                break;
+            }
+#if LWCELL_CFG_PHONEBOOK_MIRROR
+            if (msg->msg.pb_write.pos == 0) { /* Choose position so mirror knows where new entry is */
+                msg->msg.pb_write.pos = lwcelli_pb_mirror_free_pos(msg->msg.pb_write.mem);
+            }
+#endif /* LWCELL_CFG_PHONEBOOK_MIRROR */
+            if (msg->msg.pb_write.pos > 0) { /* Write number if more than 0 */
+                lwcelli_send_number(LWCELL_U32(msg->msg.pb_write.pos), 0, 0);
+            }
+            if (!msg->msg.pb_write.del) {
+                lwcelli_send_string(msg->msg.pb_write.num, 0, 1, 1);
+                lwcelli_send_number(LWCELL_U32(msg->msg.pb_write.type), 0, 1);
+                lwcelli_send_string(msg->msg.pb_write.name, 0, 1, 1);
             }
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CPIN_GET: { /* Read current SIM status */
+        case LWCELL_CMD_CPBR: { /* Read entires */
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CPIN?");
+            AT_PORT_SEND_CONST_STR("+CPBR=");
+#if LWCELL_CFG_PHONEBOOK_MIRROR
+            if (CMD_IS_DEF(LWCELL_CMD_PHONEBOOK_MIRROR_LOAD)) {
+                size_t end = msg->msg.pb_mirror.index + LWCELL_CFG_PHONEBOOK_READ_CHUNK - 1;
+
+                lwcelli_send_number(LWCELL_U32(msg->msg.pb_mirror.index), 0, 0);
+                lwcelli_send_number(LWCELL_U32(LWCELL_MIN(end, lwcell.m.pb.mirror.total)), 0, 1);
+                AT_PORT_SEND_END_AT();
+                break;
+            }
+#endif /* LWCELL_CFG_PHONEBOOK_MIRROR */
+            lwcelli_send_number(LWCELL_U32(msg->msg.pb_list.start_index), 0, 0);
+            if (msg->msg.pb_list.entry_fn != NULL) { /* Iterator reads memory in chunks */
+                size_t end = msg->msg.pb_list.start_index + LWCELL_CFG_PHONEBOOK_READ_CHUNK - 1;
+
+                lwcelli_send_number(LWCELL_U32(LWCELL_MIN(end, lwcell.m.pb.mem.total)), 0, 1);
+            } else {
+                lwcelli_send_number(LWCELL_U32(msg->msg.pb_list.start_index + msg->msg.pb_list.etr - 1), 0, 1);
+            }
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CPIN_SET: { /* Set SIM pin code */
+        case LWCELL_CMD_CPBF: { /* Find entires */
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CPIN=");
-            lwcelli_send_string(msg->msg.cpin_enter.pin, 0, 1, 0);
+            AT_PORT_SEND_CONST_STR("+CPBF=");
+            lwcelli_send_string(msg->msg.pb_search.search, 1, 1, 0);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CPIN_ADD: { /* Add new pin code */
+#endif /* LWCELL_CFG_PHONEBOOK */
+#if LWCELL_CFG_NETWORK
+        case LWCELL_CMD_NETWORK_ATTACH:
+        case LWCELL_CMD_CGACT_SET_0: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CLCK=\"SC\",1,");
-            lwcelli_send_string(msg->msg.cpin_add.pin, 0, 1, 0);
+            AT_PORT_SEND_CONST_STR("+CGACT=0");
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CPIN_CHANGE: { /* Change already active SIM */
+        case LWCELL_CMD_NETWORK_DETACH:
+        case LWCELL_CMD_CGATT_SET_0: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CPWD=\"SC\"");
-            lwcelli_send_string(msg->msg.cpin_change.current_pin, 0, 1, 1);
-            lwcelli_send_string(msg->msg.cpin_change.new_pin, 0, 1, 1);
+            AT_PORT_SEND_CONST_STR("+CGATT=0");
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CPIN_REMOVE: { /* Remove current PIN */
+        case LWCELL_CMD_CIPRXGET_SET: {
+            if (LWCELL_CFG_CONN_MANUAL_RECV && !LWCELL_DEV_MODEL_CAP(has_rxget)) {
+                return lwcellERRNOTENABLED; /* Manual receive is not supported by device model */
+            }
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CLCK=\"SC\",0,");
-            lwcelli_send_string(msg->msg.cpin_remove.pin, 0, 1, 0);
+            AT_PORT_SEND_CONST_STR("+CIPRXGET=");
+            lwcelli_send_number(LWCELL_U32(!!LWCELL_CFG_CONN_MANUAL_RECV), 0, 0);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CPUK_SET: { /* Enter PUK and set new PIN */
+#if LWCELL_CFG_CONN_QUICK_SEND
+        case LWCELL_CMD_CIPQSEND_SET: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CPIN=");
-            lwcelli_send_string(msg->msg.cpuk_enter.puk, 0, 1, 0);
-            lwcelli_send_string(msg->msg.cpuk_enter.pin, 0, 1, 1);
+            AT_PORT_SEND_CONST_STR("+CIPQSEND=1");
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_COPS_SET: { /* Set current operator */
+#endif /* LWCELL_CFG_CONN_QUICK_SEND */
+        case LWCELL_CMD_CSTT_SET: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+COPS=");
-            lwcelli_send_number(LWCELL_U32(msg->msg.cops_set.mode), 0, 0);
-            if (msg->msg.cops_set.mode != LWCELL_OPERATOR_MODE_AUTO) {
-                lwcelli_send_number(LWCELL_U32(msg->msg.cops_set.format), 0, 1);
-                switch (msg->msg.cops_set.format) {
-                    case LWCELL_OPERATOR_FORMAT_LONG_NAME:
-                    case LWCELL_OPERATOR_FORMAT_SHORT_NAME: lwcelli_send_string(msg->msg.cops_set.name, 1, 1, 1); break;
-                    default: lwcelli_send_number(LWCELL_U32(msg->msg.cops_set.num), 0, 1);
-                }
-            }
+            AT_PORT_SEND_CONST_STR("+CSTT=");
+            lwcelli_send_string(msg->msg.network_attach.apn, 1, 1, 0);
+            lwcelli_send_string(msg->msg.network_attach.user, 1, 1, 1);
+            lwcelli_send_string(msg->msg.network_attach.pass, 1, 1, 1);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_COPS_GET: { /* Get current operator */
+#if LWCELL_CFG_NETWORK_CONTEXTS > 1
+        case LWCELL_CMD_CIPSGTXT: {
+            uint8_t ctx = 0;
+
+            /* First command in sequence selects requested context, later one restores default context */
+            if (!msg->i) {
+                ctx = CMD_IS_DEF(LWCELL_CMD_CIPSTART) ? msg->msg.conn_start.ctx : msg->msg.network_attach.ctx;
+            }
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+COPS?");
+            AT_PORT_SEND_CONST_STR("+CIPSGTXT=");
+            lwcelli_send_number(LWCELL_U32(ctx), 0, 0);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_COPS_GET_OPT: { /* Get list of available operators */
+#endif /* LWCELL_CFG_NETWORK_CONTEXTS > 1 */
+#endif /* LWCELL_CFG_NETWORK */
+#if LWCELL_CFG_USSD
+        case LWCELL_CMD_CUSD: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+COPS=?");
+            AT_PORT_SEND_CONST_STR("+CUSD=1,");
+            lwcelli_send_string(msg->msg.ussd.code, 1, 1, 0);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CSQ_GET: { /* Get signal strength */
+#endif /* LWCELL_CFG_USSD */
+#if LWCELL_CFG_MQTT
+        case LWCELL_CMD_SMCONF_URL: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CSQ");
+            AT_PORT_SEND_CONST_STR("+SMCONF=\"URL\"");
+            lwcelli_send_string(msg->msg.mqtt_connect.desc->host, 1, 1, 1);
+            lwcelli_send_port(msg->msg.mqtt_connect.desc->port, 0, 1);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CNUM: { /* Get SIM number */
+        case LWCELL_CMD_SMCONF_CLIENTID: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CNUM");
+            AT_PORT_SEND_CONST_STR("+SMCONF=\"CLIENTID\"");
+            lwcelli_send_string(msg->msg.mqtt_connect.desc->device_id, 1, 1, 1);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CIPSHUT: { /* Shut down network connection and put to reset state */
+        case LWCELL_CMD_SMCONF_KEEPTIME: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CIPSHUT");
+            AT_PORT_SEND_CONST_STR("+SMCONF=\"KEEPTIME\"");
+            lwcelli_send_number(msg->msg.mqtt_connect.desc->keep_alive > 0 ? msg->msg.mqtt_connect.desc->keep_alive
+                                                                           : 60,
+                                0, 1);
             AT_PORT_SEND_END_AT();
             break;
         }
-#if LWCELL_CFG_CONN
-        case LWCELL_CMD_CIPMUX: { /* Enable multiple connections */
+        case LWCELL_CMD_SMCONF_USERNAME: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CIPMUX=1");
+            AT_PORT_SEND_CONST_STR("+SMCONF=\"USERNAME\"");
+            lwcelli_send_string(msg->msg.mqtt_connect.desc->username, 1, 1, 1);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CIPHEAD: { /* Enable information on receive data about connection and length */
+        case LWCELL_CMD_SMCONF_PASSWORD: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CIPHEAD=1");
+            AT_PORT_SEND_CONST_STR("+SMCONF=\"PASSWORD\"");
+            lwcelli_send_string(msg->msg.mqtt_connect.desc->password, 1, 1, 1);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CIPSRIP: {
+        case LWCELL_CMD_SMSUB: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CIPSRIP=1");
+            AT_PORT_SEND_CONST_STR("+SMSUB=");
+            lwcelli_send_string(msg->msg.mqtt_sub.topic, 1, 1, 0);
+            lwcelli_send_number(msg->msg.mqtt_sub.qos, 0, 1);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CIPSSL: { /* Set SSL configuration */
+        case LWCELL_CMD_SMUNSUB: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CIPSSL=");
-            lwcelli_send_number((msg->msg.conn_start.type == LWCELL_CONN_TYPE_SSL) ? 1 : 0, 0, 0);
+            AT_PORT_SEND_CONST_STR("+SMUNSUB=");
+            lwcelli_send_string(msg->msg.mqtt_sub.topic, 1, 1, 0);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CIPSTART: { /* Start a new connection */
-            lwcell_conn_t* c = NULL;
-
-            /* Do we have network connection? */
-            /* Check if we are connected to network */
-
-            msg->msg.conn_start.num = 0;                              /* Start with max value = invalidated */
-            for (int16_t i = LWCELL_CFG_MAX_CONNS - 1; i >= 0; --i) { /* Find available connection */
-                if (!lwcell.m.conns[i].status.f.active) {
-                    c = &lwcell.m.conns[i];
-                    c->num = LWCELL_U8(i);
-                    msg->msg.conn_start.num = LWCELL_U8(i); /* Set connection number for message structure */
-                    break;
-                }
-            }
-            if (c == NULL) {
-                lwcelli_send_conn_error_cb(msg, lwcellERRNOFREECONN);
-                return lwcellERRNOFREECONN; /* We don't have available connection */
-            }
-
-            if (msg->msg.conn_start.conn != NULL) { /* Is user interested about connection info? */
-                *msg->msg.conn_start.conn = c;      /* Save connection for user */
-            }
-
+        case LWCELL_CMD_SMPUB: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CIPSTART=");
-            lwcelli_send_number(LWCELL_U32(c->num), 0, 0);
-            if (msg->msg.conn_start.type == LWCELL_CONN_TYPE_UDP) {
-                lwcelli_send_string("UDP", 0, 1, 1);
-            } else {
-                lwcelli_send_string("TCP", 0, 1, 1);
-            }
-            lwcelli_send_string(msg->msg.conn_start.host, 0, 1, 1);
-            lwcelli_send_port(msg->msg.conn_start.port, 0, 1);
+            AT_PORT_SEND_CONST_STR("+SMPUB=");
+            lwcelli_send_string(msg->msg.mqtt_pub.topic, 1, 1, 0);
+            lwcelli_send_number(LWCELL_U32(msg->msg.mqtt_pub.data_len), 0, 1);
+            AT_PORT_SEND_CONST_STR(",0,0"); /* QoS 0, no retain */
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CIPCLOSE: { /* Close the connection */
-            lwcell_conn_p c = msg->msg.conn_close.conn;
-            if (c != NULL &&
-                /* Is connection already closed or command for this connection is not valid anymore? */
-                (!lwcell_conn_is_active(c) || c->val_id != msg->msg.conn_close.val_id)) {
-                return lwcellERR;
-            }
+#if LWCELL_CFG_SSL
+        case LWCELL_CMD_SMSSL: { /* Context index 0 disables SSL, hence device index is increased by 1 */
+            const lwcell_ssl_cfg_t* cfg = msg->msg.mqtt_connect.desc->ssl;
+
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CIPCLOSE=");
-            lwcelli_send_number(
-                LWCELL_U32(msg->msg.conn_close.conn ? msg->msg.conn_close.conn->num : LWCELL_CFG_MAX_CONNS), 0, 0);
+            AT_PORT_SEND_CONST_STR("+SMSSL=");
+            lwcelli_send_number(LWCELL_U32(cfg->ctx) + 1, 0, 0);
+            lwcelli_send_string(cfg->ca != NULL ? cfg->ca : "", 0, 1, 1);
+            lwcelli_send_string(cfg->cert != NULL ? cfg->cert : "", 0, 1, 1);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CIPSEND: {                    /* Send data to connection */
-            return lwcelli_tcpip_process_send_data(); /* Process send data */
-        }
-        case LWCELL_CMD_CIPSTATUS: { /* Get status of device and all connections */
+#endif /* LWCELL_CFG_SSL */
+#endif /* LWCELL_CFG_MQTT */
+#if LWCELL_CFG_SSL || LWCELL_CFG_FS
+        case LWCELL_CMD_CFSWFILE: {
+#if LWCELL_CFG_FS
+            if (CMD_IS_DEF(LWCELL_CMD_FS_WRITE)) { /* Later chunks are always appended */
+                msg->msg.fs_write.chunk_len =
+                    LWCELL_MIN(msg->msg.fs_write.len - msg->msg.fs_write.offset, LWCELL_CFG_FS_CHUNK_LEN);
+
+                AT_PORT_SEND_BEGIN_AT();
+                AT_PORT_SEND_CONST_STR("+CFSWFILE=3");
+                lwcelli_send_string(msg->msg.fs_write.name, 0, 1, 1);
+                lwcelli_send_number(msg->msg.fs_write.append || msg->msg.fs_write.offset > 0 ? 1 : 0, 0, 1);
+                lwcelli_send_number(LWCELL_U32(msg->msg.fs_write.chunk_len), 0, 1);
+                AT_PORT_SEND_CONST_STR(",10000"); /* Time for device to receive chunk */
+                AT_PORT_SEND_END_AT();
+                break;
+            }
+#endif /* LWCELL_CFG_FS */
+#if LWCELL_CFG_SSL
+            /* First chunk overwrites file, others are appended */
+            if (msg->msg.ssl_upload.mark) {
+                msg->msg.ssl_upload.chunk_len = 8; /* Digest in hex format */
+            } else {
+                msg->msg.ssl_upload.chunk_len =
+                    LWCELL_MIN(msg->msg.ssl_upload.len - msg->msg.ssl_upload.offset, LWCELL_CFG_SSL_FILE_CHUNK_LEN);
+            }
+
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CIPSTATUS");
+            AT_PORT_SEND_CONST_STR("+CFSWFILE=3");
+            lwcelli_ssl_file_send_name(msg);
+            lwcelli_send_number(msg->msg.ssl_upload.offset > 0 && !msg->msg.ssl_upload.mark ? 1 : 0, 0, 1);
+            lwcelli_send_number(LWCELL_U32(msg->msg.ssl_upload.chunk_len), 0, 1);
+            AT_PORT_SEND_CONST_STR(",10000"); /* Time for device to receive chunk */
             AT_PORT_SEND_END_AT();
+#endif /* LWCELL_CFG_SSL */
             break;
         }
-#endif /* LWCELL_CFG_CONN */
-#if LWCELL_CFG_SMS
-        case LWCELL_CMD_CMGF: { /* Select SMS message format */
+        case LWCELL_CMD_CFSGFIS:
+        case LWCELL_CMD_CFSDFILE: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CMGF=");
-            if (CMD_IS_DEF(LWCELL_CMD_CMGS)) {
-                lwcelli_send_number(LWCELL_U32(!!msg->msg.sms_send.format), 0, 0);
-            } else if (CMD_IS_DEF(LWCELL_CMD_CMGR)) {
-                lwcelli_send_number(LWCELL_U32(!!msg->msg.sms_read.format), 0, 0);
-            } else if (CMD_IS_DEF(LWCELL_CMD_CMGL)) {
-                lwcelli_send_number(LWCELL_U32(!!msg->msg.sms_list.format), 0, 0);
+            if (CMD_IS_CUR(LWCELL_CMD_CFSGFIS)) {
+                AT_PORT_SEND_CONST_STR("+CFSGFIS=3");
             } else {
-                /* Used for all other operations like delete all messages, etc */
-                AT_PORT_SEND_CONST_STR("1");
+                AT_PORT_SEND_CONST_STR("+CFSDFILE=3");
+            }
+#if LWCELL_CFG_SSL
+            if (CMD_IS_DEF(LWCELL_CMD_CFSWFILE)) { /* Installed certificate check */
+                lwcelli_ssl_file_send_name(msg);
             }
+#endif /* LWCELL_CFG_SSL */
+#if LWCELL_CFG_FS
+            if (!CMD_IS_DEF(LWCELL_CMD_CFSWFILE)) {
+                lwcelli_send_string(msg->msg.fs_file.name, 0, 1, 1);
+            }
+#endif /* LWCELL_CFG_FS */
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CMGS: { /* Send SMS */
+#endif /* LWCELL_CFG_SSL || LWCELL_CFG_FS */
+#if LWCELL_CFG_FS
+        case LWCELL_CMD_CFSRFILE: { /* Read from position, mode 1 */
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CMGS=");
-            lwcelli_send_string(msg->msg.sms_send.num, 0, 1, 0);
+            AT_PORT_SEND_CONST_STR("+CFSRFILE=3");
+            lwcelli_send_string(msg->msg.data_read.name, 0, 1, 1);
+            AT_PORT_SEND_CONST_STR(",1");
+            lwcelli_send_number(LWCELL_U32(msg->msg.data_read.len), 0, 1);
+            lwcelli_send_number(LWCELL_U32(msg->msg.data_read.offset), 0, 1);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CMGR: { /* Read message */
+#endif /* LWCELL_CFG_FS */
+#if LWCELL_CFG_SSL
+        case LWCELL_CMD_CSSLCFG_SSLVERSION: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CMGR=");
-            lwcelli_send_number(LWCELL_U32(msg->msg.sms_read.pos), 0, 0);
-            lwcelli_send_number(LWCELL_U32(!msg->msg.sms_read.update), 0, 1);
+            AT_PORT_SEND_CONST_STR("+CSSLCFG=\"SSLVERSION\"");
+            lwcelli_send_number(LWCELL_U32(msg->msg.ssl_cfg.cfg->ctx), 0, 1);
+            lwcelli_send_number(LWCELL_U32(msg->msg.ssl_cfg.cfg->version), 0, 1);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CMGD: { /* Delete SMS message */
+        case LWCELL_CMD_CSSLCFG_SNI: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CMGD=");
-            lwcelli_send_number(LWCELL_U32(msg->msg.sms_delete.pos), 0, 0);
+            AT_PORT_SEND_CONST_STR("+CSSLCFG=\"SNI\"");
+            lwcelli_send_number(LWCELL_U32(msg->msg.ssl_cfg.cfg->ctx), 0, 1);
+            lwcelli_send_string(msg->msg.ssl_cfg.cfg->sni, 0, 1, 1);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CMGDA: { /* Mass delete SMS messages */
+        case LWCELL_CMD_CSSLCFG_CONVERT_CA: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CMGDA=");
-            switch (msg->msg.sms_delete_all.status) {
-                case LWCELL_SMS_STATUS_READ: lwcelli_send_string("DEL READ", 0, 1, 0); break;
-                case LWCELL_SMS_STATUS_UNREAD: lwcelli_send_string("DEL UNREAD", 0, 1, 0); break;
-                case LWCELL_SMS_STATUS_SENT: lwcelli_send_string("DEL SENT", 0, 1, 0); break;
-                case LWCELL_SMS_STATUS_UNSENT: lwcelli_send_string("DEL UNSENT", 0, 1, 0); break;
-                case LWCELL_SMS_STATUS_INBOX: lwcelli_send_string("DEL INBOX", 0, 1, 0); break;
-                case LWCELL_SMS_STATUS_ALL: lwcelli_send_string("DEL ALL", 0, 1, 0); break;
-                default: break;
-            }
+            AT_PORT_SEND_CONST_STR("+CSSLCFG=\"CONVERT\",2"); /* Type 2 is CA list */
+            lwcelli_send_string(msg->msg.ssl_cfg.cfg->ca, 0, 1, 1);
             AT_PORT_SEND_END_AT();
             break;
         }
-
-        case LWCELL_CMD_CMGL: { /* Delete SMS message */
+        case LWCELL_CMD_CSSLCFG_CONVERT_CERT: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CMGL=");
-            lwcelli_send_sms_stat(msg->msg.sms_list.status, 1, 0);
-            lwcelli_send_number(LWCELL_U32(!msg->msg.sms_list.update), 0, 1);
+            AT_PORT_SEND_CONST_STR("+CSSLCFG=\"CONVERT\",1"); /* Type 1 is client certificate */
+            lwcelli_send_string(msg->msg.ssl_cfg.cfg->cert, 0, 1, 1);
+            lwcelli_send_string(msg->msg.ssl_cfg.cfg->key, 0, 1, 1);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CPMS_GET_OPT: { /* Get available SMS storages */
+#endif /* LWCELL_CFG_SSL */
+#if LWCELL_CFG_GNSS
+        case LWCELL_CMD_CGNSPWR: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CPMS=?");
+            AT_PORT_SEND_CONST_STR("+CGNSPWR=");
+            lwcelli_send_number(LWCELL_U32(msg->msg.gnss.on), 0, 0);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CPMS_GET: { /* Get current SMS storage info */
+        case LWCELL_CMD_CGNSURC: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CPMS?");
+            AT_PORT_SEND_CONST_STR("+CGNSURC=");
+            lwcelli_send_number(LWCELL_U32(msg->msg.gnss.on ? msg->msg.gnss.interval : 0), 0, 0);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CPMS_SET: { /* Set active SMS storage(s) */
+#endif /* LWCELL_CFG_GNSS */
+#if LWCELL_CFG_CELL_INFO
+        case LWCELL_CMD_CENG: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CPMS=");
-            if (CMD_IS_DEF(LWCELL_CMD_CMGR)) { /* Read SMS original command? */
-                lwcelli_send_dev_memory(msg->msg.sms_read.mem == LWCELL_MEM_CURRENT ? lwcell.m.sms.mem[0].current
-                                                                                    : msg->msg.sms_read.mem,
-                                        1, 0);
-            } else if (CMD_IS_DEF(LWCELL_CMD_CMGD)) { /* Delete SMS original command? */
-                lwcelli_send_dev_memory(msg->msg.sms_delete.mem == LWCELL_MEM_CURRENT ? lwcell.m.sms.mem[0].current
-                                                                                      : msg->msg.sms_delete.mem,
-                                        1, 0);
-            } else if (CMD_IS_DEF(LWCELL_CMD_CMGL)) { /* List SMS original command? */
-                lwcelli_send_dev_memory(msg->msg.sms_list.mem == LWCELL_MEM_CURRENT ? lwcell.m.sms.mem[0].current
-                                                                                    : msg->msg.sms_list.mem,
-                                        1, 0);
-            } else if (CMD_IS_DEF(
-                           LWCELL_CMD_CPMS_SET)) { /* Do we want to set memory for read/delete,sent/write,receive? */
-                for (size_t i = 0; i < 3; ++i) {   /* Write 3 memories */
-                    lwcelli_send_dev_memory(msg->msg.sms_memory.mem[i] == LWCELL_MEM_CURRENT
-                                                ? lwcell.m.sms.mem[i].current
-                                                : msg->msg.sms_memory.mem[i],
-                                            1, !!i);
-                }
+            if (msg->msg.cell_info.enable) {
+                AT_PORT_SEND_CONST_STR("+CENG=2,1"); /* Automatic reports, including neighbour cell IDs */
+            } else {
+                AT_PORT_SEND_CONST_STR("+CENG=0");
             }
             AT_PORT_SEND_END_AT();
             break;
         }
-#endif /* LWCELL_CFG_SMS */
-#if LWCELL_CFG_CALL
-        case LWCELL_CMD_ATD: { /* Start new call */
+#endif /* LWCELL_CFG_CELL_INFO */
+#if LWCELL_CFG_PING
+        case LWCELL_CMD_CIPPING: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("D");
-            lwcelli_send_string(msg->msg.call_start.number, 0, 0, 0);
-            AT_PORT_SEND_CONST_STR(";");
+            AT_PORT_SEND_CONST_STR("+CIPPING=");
+            lwcelli_send_string(msg->msg.ping.host, 0, 1, 0);
+            lwcelli_send_number(LWCELL_U32(msg->msg.ping.count), 0, 1);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_ATA: { /* Answer phone call */
+#endif /* LWCELL_CFG_PING */
+#if LWCELL_CFG_DNS
+        case LWCELL_CMD_CDNSGIP: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("A");
+            AT_PORT_SEND_CONST_STR("+CDNSGIP=");
+            lwcelli_send_string(msg->msg.dns.host, 0, 1, 0);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_ATH: { /* Disconnect existing connection (hang-up phone call) */
+        case LWCELL_CMD_CDNSCFG: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("H");
+            AT_PORT_SEND_CONST_STR("+CDNSCFG=");
+            lwcelli_send_ip_mac(&msg->msg.dns_cfg.primary, 1, 1, 0);
+            if (msg->msg.dns_cfg.has_secondary) {
+                lwcelli_send_ip_mac(&msg->msg.dns_cfg.secondary, 1, 1, 1);
+            }
             AT_PORT_SEND_END_AT();
             break;
         }
-#endif /* LWCELL_CFG_CALL */
-#if LWCELL_CFG_PHONEBOOK
-        case LWCELL_CMD_CPBS_GET_OPT: { /* Get available phonebook storages */
+#endif /* LWCELL_CFG_DNS */
+#if LWCELL_CFG_CMUX
+        case LWCELL_CMD_CMUX: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CPBS=?");
+            AT_PORT_SEND_CONST_STR("+CMUX=0,0,5,"); /* Basic option, UIH frames, 115200 bauds */
+            lwcelli_send_number(LWCELL_CFG_CMUX_FRAME_LEN, 0, 0);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CPBS_GET: { /* Get current memory info */
+#endif /* LWCELL_CFG_CMUX */
+#if LWCELL_CFG_PWR
+        case LWCELL_CMD_CPSMS_SET: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CPBS?");
+            AT_PORT_SEND_CONST_STR("+CPSMS=");
+            lwcelli_send_number(msg->msg.pwr.mode, 0, 0);
+            if (msg->msg.pwr.mode && (msg->msg.pwr.t1 != NULL || msg->msg.pwr.t2 != NULL)) {
+                AT_PORT_SEND_CONST_STR(",,"); /* Skip legacy GPRS timers */
+                if (msg->msg.pwr.t1 != NULL) {
+                    lwcelli_send_string(msg->msg.pwr.t1, 0, 1, 1);
+                } else {
+                    AT_PORT_SEND_CONST_STR(",");
+                }
+                if (msg->msg.pwr.t2 != NULL) {
+                    lwcelli_send_string(msg->msg.pwr.t2, 0, 1, 1);
+                }
+            }
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CPBS_SET: { /* Get current memory info */
-            lwcell_mem_t mem;
+        case LWCELL_CMD_CEDRXS_SET: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CPBS=");
-            switch (CMD_GET_DEF()) {
-                case LWCELL_CMD_CPBW_SET: mem = msg->msg.pb_write.mem; break;
-                case LWCELL_CMD_CPBR: mem = msg->msg.pb_list.mem; break;
-                case LWCELL_CMD_CPBF: mem = msg->msg.pb_search.mem; break;
-                default: break;
+            AT_PORT_SEND_CONST_STR("+CEDRXS=");
+            lwcelli_send_number(msg->msg.pwr.mode, 0, 0);
+            if (msg->msg.pwr.mode) {
+                lwcelli_send_number(msg->msg.pwr.act_type, 0, 1);
+                if (msg->msg.pwr.t1 != NULL) {
+                    lwcelli_send_string(msg->msg.pwr.t1, 0, 1, 1);
+                }
             }
-            lwcelli_send_dev_memory(mem == LWCELL_MEM_CURRENT ? lwcell.m.pb.mem.current : mem, 1, 0);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CPBW_SET: { /* Write/Delete new/old entry */
+        case LWCELL_CMD_CSCLK_SET: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CPBW=");
-            if (msg->msg.pb_write.pos > 0) { /* Write number if more than 0 */
-                lwcelli_send_number(LWCELL_U32(msg->msg.pb_write.pos), 0, 0);
+            AT_PORT_SEND_CONST_STR("+CSCLK=");
+            lwcelli_send_number(msg->msg.pwr.mode, 0, 0);
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+        case LWCELL_CMD_CNMPSD: {
+            if (!LWCELL_DEV_MODEL_CAP(is_lte)) {
+                return lwcellERRNOTENABLED; /* Release assistance is not available on 2G devices */
             }
-            if (!msg->msg.pb_write.del) {
-                lwcelli_send_string(msg->msg.pb_write.num, 0, 1, 1);
-                lwcelli_send_number(LWCELL_U32(msg->msg.pb_write.type), 0, 1);
-                lwcelli_send_string(msg->msg.pb_write.name, 0, 1, 1);
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+CNMPSD");
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+#endif /* LWCELL_CFG_PWR */
+#if LWCELL_CFG_HTTP
+        case LWCELL_CMD_HTTPPARA_URL: {
+            AT_PORT_SEND_BEGIN_AT();
+            AT_PORT_SEND_CONST_STR("+HTTPPARA=\"URL\"");
+            lwcelli_send_string(msg->msg.http_get.url, 0, 1, 1);
+            AT_PORT_SEND_END_AT();
+            break;
+        }
+        case LWCELL_CMD_HTTPREAD:
+        case LWCELL_CMD_SHREAD: {
+            AT_PORT_SEND_BEGIN_AT();
+            if (CMD_IS_CUR(LWCELL_CMD_HTTPREAD)) {
+                AT_PORT_SEND_CONST_STR("+HTTPREAD=");
+            } else {
+                AT_PORT_SEND_CONST_STR("+SHREAD=");
             }
+            lwcelli_send_number(LWCELL_U32(msg->msg.data_read.offset), 0, 0);
+            lwcelli_send_number(LWCELL_U32(msg->msg.data_read.len), 0, 1);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CPBR: { /* Read entires */
+        case LWCELL_CMD_SHCONF_URL: { /* Server part of URL only, path is used with request */
+            const char* url = msg->msg.http_get.url;
+
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CPBR=");
-            lwcelli_send_number(LWCELL_U32(msg->msg.pb_list.start_index), 0, 0);
-            lwcelli_send_number(LWCELL_U32(msg->msg.pb_list.etr), 0, 1);
+            AT_PORT_SEND_CONST_STR("+SHCONF=\"URL\",\"");
+            AT_PORT_SEND(url, LWCELL_SZ(lwcelli_http_url_path(url) - url));
+            AT_PORT_SEND_CONST_STR("\"");
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CPBF: { /* Find entires */
+        case LWCELL_CMD_SHREQ: {
+            const char* path = lwcelli_http_url_path(msg->msg.http_get.url);
+
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CPBF=");
-            lwcelli_send_string(msg->msg.pb_search.search, 1, 1, 0);
+            AT_PORT_SEND_CONST_STR("+SHREQ=");
+            lwcelli_send_string(*path != '\0' ? path : "/", 0, 1, 0);
+            AT_PORT_SEND_CONST_STR(",1"); /* GET method */
             AT_PORT_SEND_END_AT();
             break;
         }
-#endif /* LWCELL_CFG_PHONEBOOK */
-#if LWCELL_CFG_NETWORK
-        case LWCELL_CMD_NETWORK_ATTACH:
-        case LWCELL_CMD_CGACT_SET_0: {
+#endif /* LWCELL_CFG_HTTP */
+#if LWCELL_CFG_FTP
+        case LWCELL_CMD_FTPSERV: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CGACT=0");
+            AT_PORT_SEND_CONST_STR("+FTPSERV=");
+            lwcelli_send_string(msg->msg.ftp_start.desc->host, 0, 1, 0);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CGACT_SET_1: {
+        case LWCELL_CMD_FTPPORT: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CGACT=1");
+            AT_PORT_SEND_CONST_STR("+FTPPORT=");
+            lwcelli_send_port(msg->msg.ftp_start.desc->port > 0 ? msg->msg.ftp_start.desc->port : 21, 0, 0);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_NETWORK_DETACH:
-        case LWCELL_CMD_CGATT_SET_0: {
+        case LWCELL_CMD_FTPUN: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CGATT=0");
+            AT_PORT_SEND_CONST_STR("+FTPUN=");
+            lwcelli_send_string(msg->msg.ftp_start.desc->user != NULL ? msg->msg.ftp_start.desc->user : "anonymous", 0,
+                                1, 0);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CGATT_SET_1: {
+        case LWCELL_CMD_FTPPW: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CGATT=1");
+            AT_PORT_SEND_CONST_STR("+FTPPW=");
+            lwcelli_send_string(msg->msg.ftp_start.desc->pass, 0, 1, 0);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CIPMUX_SET: {
+        case LWCELL_CMD_FTPGETNAME:
+        case LWCELL_CMD_FTPPUTNAME: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CIPMUX=1");
+            if (CMD_IS_CUR(LWCELL_CMD_FTPGETNAME)) {
+                AT_PORT_SEND_CONST_STR("+FTPGETNAME=");
+            } else {
+                AT_PORT_SEND_CONST_STR("+FTPPUTNAME=");
+            }
+            lwcelli_send_string(msg->msg.ftp_start.desc->name, 0, 1, 0);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CIPRXGET_SET: {
+        case LWCELL_CMD_FTPGETPATH:
+        case LWCELL_CMD_FTPPUTPATH: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CIPRXGET=0");
+            if (CMD_IS_CUR(LWCELL_CMD_FTPGETPATH)) {
+                AT_PORT_SEND_CONST_STR("+FTPGETPATH=");
+            } else {
+                AT_PORT_SEND_CONST_STR("+FTPPUTPATH=");
+            }
+            lwcelli_send_string(msg->msg.ftp_start.desc->path != NULL ? msg->msg.ftp_start.desc->path : "/", 0, 1, 0);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CSTT_SET: {
+        case LWCELL_CMD_FTPREST: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CSTT=");
-            lwcelli_send_string(msg->msg.network_attach.apn, 1, 1, 0);
-            lwcelli_send_string(msg->msg.network_attach.user, 1, 1, 1);
-            lwcelli_send_string(msg->msg.network_attach.pass, 1, 1, 1);
+            AT_PORT_SEND_CONST_STR("+FTPREST=");
+            lwcelli_send_number(LWCELL_U32(msg->msg.ftp_start.offset), 0, 0);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CIICR: {
+        case LWCELL_CMD_FTPPUTOPT: { /* Append to remote file when upload is resumed */
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CIICR");
+            AT_PORT_SEND_CONST_STR("+FTPPUTOPT=");
+            lwcelli_send_string(msg->msg.ftp_start.offset > 0 ? "APPE" : "STOR", 0, 1, 0);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CIFSR: {
+        case LWCELL_CMD_FTPGET_READ: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CIFSR");
+            AT_PORT_SEND_CONST_STR("+FTPGET=2");
+            lwcelli_send_number(LWCELL_U32(msg->msg.data_read.len), 0, 1);
             AT_PORT_SEND_END_AT();
             break;
         }
-#endif /* LWCELL_CFG_NETWORK */
-#if LWCELL_CFG_USSD
-        case LWCELL_CMD_CUSD_GET: {
+#if LWCELL_CFG_FS
+        case LWCELL_CMD_FTPPUTFRMFS: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CUSD?");
+            AT_PORT_SEND_CONST_STR("+FTPPUTFRMFS=3");
+            lwcelli_send_string(msg->msg.ftp_start.fs_name, 0, 1, 1);
             AT_PORT_SEND_END_AT();
             break;
         }
-        case LWCELL_CMD_CUSD: {
+#endif /* LWCELL_CFG_FS */
+        case LWCELL_CMD_FTPPUT_WRITE:
+        case LWCELL_CMD_FTPPUT_END: {
             AT_PORT_SEND_BEGIN_AT();
-            AT_PORT_SEND_CONST_STR("+CUSD=1,");
-            lwcelli_send_string(msg->msg.ussd.code, 1, 1, 0);
+            AT_PORT_SEND_CONST_STR("+FTPPUT=2");
+            lwcelli_send_number(CMD_IS_CUR(LWCELL_CMD_FTPPUT_WRITE) ? LWCELL_U32(msg->msg.ftp_put.len) : 0, 0, 1);
             AT_PORT_SEND_END_AT();
             break;
         }
-#endif                             /* LWCELL_CFG_USSD */
+#endif                             /* LWCELL_CFG_FTP */
         default: return lwcellERR; /* Invalid command */
     }
     return lwcellOK; /* Valid command */
 }
 
+#if LWCELL_CFG_MSG_POOL_SIZE > 0
+
+/**
+ * \brief           Get new message for API command
+ *
+ * Message is taken from pool when available, otherwise it is allocated from heap.
+ * Semaphore of pool message is kept and reused
+ *
+ * \param[in]       blocking: Status whether command is blocking
+ * \param[in]       size: Message size with payload, see \ref LWCELL_MSG_SIZE.
+ *                      Used for heap allocation, pool messages are always full size
+ * \return          Message with cleared content on success, `NULL` otherwise
+ */
+lwcell_msg_t*
+lwcelli_msg_alloc(uint32_t blocking, size_t size) {
+    lwcell_msg_t* msg = NULL;
+    lwcell_sys_sem_t sem;
+
+    lwcell_core_lock();
+    if (!lwcell.msg_pool.initialized) {
+        for (size_t i = 0; i < LWCELL_ARRAYSIZE(lwcell.msg_pool.msgs); ++i) {
+            lwcell.msg_pool.free[i] = &lwcell.msg_pool.msgs[i];
+        }
+        lwcell.msg_pool.free_cnt = LWCELL_ARRAYSIZE(lwcell.msg_pool.msgs);
+        lwcell.msg_pool.initialized = 1;
+    }
+    if (lwcell.msg_pool.free_cnt > 0) {
+        msg = lwcell.msg_pool.free[--lwcell.msg_pool.free_cnt];
+    }
+    lwcell_core_unlock();
+
+    if (msg != NULL) {
+        sem = msg->sem;
+        LWCELL_MEMSET(msg, 0x00, sizeof(*msg));
+        msg->sem = sem;
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_VAR | LWCELL_DBG_TYPE_TRACE, "[MSG VAR] Pool message %p\r\n", (void*)msg);
+    } else {
+        msg = lwcell_mem_malloc_tag(size, LWCELL_MEM_TAG_MSG);
+        LWCELL_DEBUGW(LWCELL_CFG_DBG_VAR | LWCELL_DBG_TYPE_TRACE, msg != NULL,
+                      "[MSG VAR] Pool empty, allocated %d bytes at %p\r\n", (int)size, (void*)msg);
+        LWCELL_DEBUGW(LWCELL_CFG_DBG_VAR | LWCELL_DBG_TYPE_TRACE, msg == NULL,
+                      "[MSG VAR] Pool empty, error allocating %d bytes\r\n", (int)size);
+        if (msg == NULL) {
+            return NULL;
+        }
+        LWCELL_MEMSET(msg, 0x00, size);
+    }
+    msg->is_blocking = LWCELL_U8(blocking > 0);
+    return msg;
+}
+
+/**
+ * \brief           Release message, previously returned by \ref lwcelli_msg_alloc
+ * \param[in]       msg: Message to release
+ */
+void
+lwcelli_msg_free(lwcell_msg_t* msg) {
+    if (msg == NULL) {
+        return;
+    }
+    LWCELL_DEBUGF(LWCELL_CFG_DBG_VAR | LWCELL_DBG_TYPE_TRACE, "[MSG VAR] Free message: %p\r\n", (void*)msg);
+    lwcell_timeout_stop(&msg->park_to); /* Memory may be reused by next message */
+    if (msg >= &lwcell.msg_pool.msgs[0] && msg < &lwcell.msg_pool.msgs[LWCELL_ARRAYSIZE(lwcell.msg_pool.msgs)]) {
+        lwcell_core_lock();
+        lwcell.msg_pool.free[lwcell.msg_pool.free_cnt++] = msg;
+        lwcell_core_unlock();
+    } else {
+        if (lwcell_sys_sem_isvalid(&msg->sem)) {
+            lwcell_sys_sem_delete(&msg->sem);
+            lwcell_sys_sem_invalid(&msg->sem);
+        }
+        lwcell_mem_free(msg);
+    }
+}
+
+#endif /* LWCELL_CFG_MSG_POOL_SIZE > 0 */
+
+#if LWCELL_CFG_CONN_SEND_FAIR || __DOXYGEN__
+
+/**
+ * \brief           Count send message entering or leaving producer queue
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Message to count, other than send messages are ignored
+ * \param[in]       queued: Set to `1` when message is put to queue, `0` when it is taken from it
+ */
+void
+lwcelli_conn_send_queued(lwcell_msg_t* msg, uint8_t queued) {
+    size_t idx;
+
+    if (msg->cmd_def != LWCELL_CMD_CIPSEND || msg->is_send_queued == !!queued) {
+        return;
+    }
+    idx = (size_t)(msg->msg.conn_send.conn - lwcell.m.conns);
+    msg->is_send_queued = !!queued;
+    if (queued) {
+        ++lwcell.m.conn_send_queued[idx];
+        ++lwcell.m.conn_send_queued_all;
+    } else {
+        --lwcell.m.conn_send_queued[idx];
+        --lwcell.m.conn_send_queued_all;
+    }
+}
+
+/**
+ * \brief           Put send message, which gave up its turn, back to the end of producer queue
+ * \note            Function must be called from producer thread with core locked
+ * \param[in]       msg: Yielded send message
+ * \return          `1` on success, `0` if queue is full and message shall continue immediately
+ */
+uint8_t
+lwcelli_conn_send_requeue(lwcell_msg_t* msg) {
+    lwcell_sys_mbox_t* mbox = &lwcell.mbox_producer;
+
+    msg->cmd = msg->cmd_def; /* Turn finished the command, start it again with next chunk */
+#if LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0
+    if (msg->is_prio) {
+        mbox = &lwcell.mbox_producer_prio;
+    }
+#endif /* LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0 */
+    lwcelli_conn_send_queued(msg, 1);
+    if (!lwcell_sys_mbox_putnow(mbox, msg)) {
+        lwcelli_conn_send_queued(msg, 0);
+        return 0;
+    }
+#if LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0
+    if (mbox != &lwcell.mbox_producer) {
+        lwcelli_producer_prio_wakeup(); /* Wake up producer waiting on regular queue */
+    }
+#endif /* LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0 */
+    return 1;
+}
+
+#endif /* LWCELL_CFG_CONN_SEND_FAIR || __DOXYGEN__ */
+
+#if LWCELL_CFG_CONN_SEND_DEADLINE || __DOXYGEN__
+
+/**
+ * \brief           Add send message to list of requests, which can be cancelled, or remove it from the list
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Message to track, send messages without send handle are ignored
+ * \param[in]       track: Set to `1` when message enters producer queue, `0` when it is finished
+ */
+void
+lwcelli_conn_send_track(lwcell_msg_t* msg, uint8_t track) {
+    if (msg->cmd_def != LWCELL_CMD_CIPSEND || msg->msg.conn_send.id == 0) {
+        return;
+    }
+    if (track) {
+        msg->msg.conn_send.pending_next = lwcell.m.conn_send_pending;
+        lwcell.m.conn_send_pending = msg;
+    } else {
+        for (lwcell_msg_t** m = &lwcell.m.conn_send_pending; *m != NULL; m = &(*m)->msg.conn_send.pending_next) {
+            if (*m == msg) {
+                *m = msg->msg.conn_send.pending_next;
+                break;
+            }
+        }
+        msg->msg.conn_send.id = 0; /* Handle is not valid anymore */
+    }
+}
+
+/**
+ * \brief           Check if send message data shall be dropped
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Send message
+ * \return          `1` if message was cancelled or its deadline passed, `0` otherwise
+ */
+uint8_t
+lwcelli_conn_send_is_stale(const lwcell_msg_t* msg) {
+    if (msg->cmd_def != LWCELL_CMD_CIPSEND) {
+        return 0;
+    }
+    return msg->msg.conn_send.cancelled
+           || (msg->msg.conn_send.has_deadline
+               && (int32_t)(lwcell_sys_now() - msg->msg.conn_send.deadline) >= 0);
+}
+
+#endif /* LWCELL_CFG_CONN_SEND_DEADLINE || __DOXYGEN__ */
+
+#if LWCELL_CFG_PRODUCER_ADMISSION || __DOXYGEN__
+
+/**
+ * \brief           Count new command as waiting in producer queue, if its priority is below the limit
+ * \note            Function must be called with core locked
+ * \param[in]       msg: New message
+ * \return          \ref lwcellOK if command is admitted, \ref lwcellERRMEM otherwise
+ */
+static lwcellr_t
+prv_producer_admit(lwcell_msg_t* msg) {
+    lwcell_producer_status_t* a = &lwcell.admission;
+    uint8_t prio = msg->is_prio;
+
+    if (a->depth[prio] >= a->limit[prio]) {
+        ++a->rejected[prio];
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_THREAD | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING,
+                      "[LWCELL THREAD] Command %d rejected, %d commands waiting\r\n", (int)msg->cmd_def,
+                      (int)a->depth[prio]);
+        return lwcellERRMEM;
+    }
+    if (++a->depth[prio] > a->peak[prio]) {
+        a->peak[prio] = a->depth[prio];
+    }
+    msg->is_admitted = 1;
+    return lwcellOK;
+}
+
+/**
+ * \brief           Command does not wait in producer queue anymore
+ *
+ * Called when producer thread takes command, or when command could not be put to queue
+ *
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Message taken from queue
+ */
+void
+lwcelli_producer_release(lwcell_msg_t* msg) {
+    if (msg->is_admitted) {
+        msg->is_admitted = 0;
+        --lwcell.admission.depth[msg->is_prio];
+    }
+}
+
+#endif /* LWCELL_CFG_PRODUCER_ADMISSION || __DOXYGEN__ */
+
+#if LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0 || __DOXYGEN__
+
+/**
+ * \brief           Wake up producer thread after message was put to priority lane
+ *
+ * Producer thread blocks on regular queue only, where `NULL` entry is put as wake-up.
+ * At most one entry is queued at a time and regular queue has one extra slot for it,
+ * so wake-up never takes place of real messages.
+ * If regular queue is full, producer is busy and checks priority lane before next message anyway
+ */
+void
+lwcelli_producer_prio_wakeup(void) {
+    lwcell_core_lock();
+    if (!lwcell.producer_prio_wakeup && lwcell_sys_mbox_putnow(&lwcell.mbox_producer, NULL)) {
+        lwcell.producer_prio_wakeup = 1;
+    }
+    lwcell_core_unlock();
+}
+
+#endif /* LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0 || __DOXYGEN__ */
+
 /**
  * \brief           Send message from API function to producer queue for further processing
  * \param[in]       msg: New message to process
@@ -2272,6 +6753,11 @@ lwcelli_initiate_cmd(lwcell_msg_t* msg) {
 lwcellr_t
 lwcelli_send_msg_to_producer_mbox(lwcell_msg_t* msg, lwcellr_t (*process_fn)(lwcell_msg_t*), uint32_t max_block_time) {
     lwcellr_t res = msg->res = lwcellOK;
+    lwcell_sys_mbox_t* mbox = &lwcell.mbox_producer;
+    uint8_t deferred = 0;
+#if LWCELL_CFG_CQ
+    lwcell_cq_t* cq;
+#endif /* LWCELL_CFG_CQ */
 
     /* Check here if stack is even enabled or shall we disable new command entry? */
     lwcell_core_lock();
@@ -2279,19 +6765,50 @@ lwcelli_send_msg_to_producer_mbox(lwcell_msg_t* msg, lwcellr_t (*process_fn)(lwc
     if (lwcell.locked_cnt > 1 && msg->is_blocking) {
         res = lwcellERRBLOCKING; /* Blocking mode not allowed */
     }
+#if !LWCELL_CFG_OS
+    /* Command is executed by lwcell_poll, nobody would run it while caller waits */
+    if (msg->is_blocking) {
+        res = lwcellERRBLOCKING;
+    }
+#endif /* !LWCELL_CFG_OS */
     /* Check if device present */
     if (res == lwcellOK && !lwcell.status.f.dev_present) {
         res = lwcellERRNODEVICE; /* No device connected */
     }
+#if LWCELL_CFG_PPP
+    /* AT channel carries PPP data, device does not listen for commands */
+    if (res == lwcellOK && lwcelli_ppp_blocks_commands()) {
+        res = lwcellERR;
+    }
+#endif /* LWCELL_CFG_PPP */
+#if LWCELL_CFG_CQ
+    /* Batch is being built by this thread, as core stays locked from its begin until submit */
+    cq = lwcell.cq_capture;
+#endif /* LWCELL_CFG_CQ */
+#if LWCELL_CFG_PRODUCER_ADMISSION
+    /* Reject command right away instead of waiting for free space in queue */
+    if (res == lwcellOK
+#if LWCELL_CFG_CQ
+        && cq == NULL
+#endif /* LWCELL_CFG_CQ */
+    ) {
+        res = prv_producer_admit(msg);
+    }
+#endif /* LWCELL_CFG_PRODUCER_ADMISSION */
     lwcell_core_unlock();
     if (res != lwcellOK) {
         LWCELL_MSG_VAR_FREE(msg); /* Free memory and return */
         return res;
     }
 
-    if (msg->is_blocking) {                         /* In case message is blocking */
-        if (!lwcell_sys_sem_create(&msg->sem, 0)) { /* Create semaphore and lock it immediately */
-            LWCELL_MSG_VAR_FREE(msg);               /* Release memory and return */
+    if (msg->is_blocking && !lwcell_sys_sem_isvalid(&msg->sem)) { /* In case message is blocking */
+        if (!lwcell_sys_sem_create(&msg->sem, 0)) {                /* Create semaphore and lock it immediately */
+#if LWCELL_CFG_PRODUCER_ADMISSION
+            lwcell_core_lock();
+            lwcelli_producer_release(msg);
+            lwcell_core_unlock();
+#endif                                /* LWCELL_CFG_PRODUCER_ADMISSION */
+            LWCELL_MSG_VAR_FREE(msg); /* Release memory and return */
             return lwcellERRMEM;
         }
     }
@@ -2300,14 +6817,78 @@ lwcelli_send_msg_to_producer_mbox(lwcell_msg_t* msg, lwcellr_t (*process_fn)(lwc
     }
     msg->block_time = max_block_time; /* Set blocking status if necessary */
     msg->fn = process_fn;             /* Save processing function to be called as callback */
-    if (msg->is_blocking) {
-        lwcell_sys_mbox_put(&lwcell.mbox_producer, msg); /* Write message to producer queue and wait forever */
+#if LWCELL_CFG_STATS
+    msg->stats_time_queued = lwcell_sys_now();
+#endif /* LWCELL_CFG_STATS */
+#if LWCELL_CFG_CQ
+    if (cq != NULL) {
+        if ((res = lwcelli_cq_add(cq, msg)) != lwcellOK) {
+            LWCELL_MSG_VAR_FREE(msg);
+        }
+        return res; /* Message is put to producer queue by lwcell_cq_submit */
+    }
+#endif /* LWCELL_CFG_CQ */
+#if LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0
+    if (msg->is_prio) {
+        mbox = &lwcell.mbox_producer_prio; /* Data path messages use priority lane */
+    }
+#endif /* LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0 */
+#if LWCELL_CFG_CONN_SEND_FAIR
+    lwcell_core_lock();
+    lwcelli_conn_send_queued(msg, 1); /* Count before put, producer may take message immediately */
+    lwcell_core_unlock();
+#endif /* LWCELL_CFG_CONN_SEND_FAIR */
+#if LWCELL_CFG_CONN_SEND_DEADLINE
+    lwcell_core_lock();
+    lwcelli_conn_send_track(msg, 1);
+    lwcell_core_unlock();
+#endif /* LWCELL_CFG_CONN_SEND_DEADLINE */
+#if LWCELL_CFG_CONN_TX_WINDOW > 0
+    lwcell_core_lock();
+    deferred = lwcelli_conn_tx_window_defer(msg);
+    lwcell_core_unlock();
+#endif /* LWCELL_CFG_CONN_TX_WINDOW > 0 */
+    LWCELL_TRACE_HOOK(LWCELL_TRACE_MSG_ENQUEUE, LWCELL_TRACE_INSTANT, msg->cmd_def);
+    if (deferred) {
+        /* Message is put to producer queue when transmit window opens */
+    } else if (msg->is_blocking) {
+        lwcell_sys_mbox_put(mbox, msg); /* Write message to producer queue and wait forever */
     } else {
-        if (!lwcell_sys_mbox_putnow(&lwcell.mbox_producer, msg)) { /* Write message to producer queue immediately */
-            LWCELL_MSG_VAR_FREE(msg);                              /* Release message */
+        if (!lwcell_sys_mbox_putnow(mbox, msg)) { /* Write message to producer queue immediately */
+#if LWCELL_CFG_CONN_SEND_FAIR
+            lwcell_core_lock();
+            lwcelli_conn_send_queued(msg, 0);
+            lwcell_core_unlock();
+#endif /* LWCELL_CFG_CONN_SEND_FAIR */
+#if LWCELL_CFG_CONN_SEND_DEADLINE
+            lwcell_core_lock();
+            lwcelli_conn_send_track(msg, 0);
+            lwcell_core_unlock();
+#endif /* LWCELL_CFG_CONN_SEND_DEADLINE */
+#if LWCELL_CFG_CONN_TX_WINDOW > 0
+            lwcell_core_lock();
+            lwcelli_conn_tx_window_done(msg);
+            lwcell_core_unlock();
+#endif /* LWCELL_CFG_CONN_TX_WINDOW > 0 */
+#if LWCELL_CFG_STATS_COUNTERS
+            lwcell_core_lock();
+            LWCELL_STATS_ADD(mbox_full, 1);
+            lwcell_core_unlock();
+#endif /* LWCELL_CFG_STATS_COUNTERS */
+#if LWCELL_CFG_PRODUCER_ADMISSION
+            lwcell_core_lock();
+            lwcelli_producer_release(msg);
+            lwcell_core_unlock();
+#endif                                            /* LWCELL_CFG_PRODUCER_ADMISSION */
+            LWCELL_MSG_VAR_FREE(msg);             /* Release message */
             return lwcellERRMEM;
         }
     }
+#if LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0
+    if (!deferred && mbox != &lwcell.mbox_producer) {
+        lwcelli_producer_prio_wakeup(); /* Wake up producer thread, waiting on regular queue */
+    }
+#endif /* LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0 */
     if (res == lwcellOK && msg->is_blocking) { /* In case we have blocking request */
         uint32_t time;
         time = lwcell_sys_sem_wait(&msg->sem, 0); /* Wait forever for semaphore */
@@ -2353,20 +6934,58 @@ lwcelli_process_events_for_timeout_or_error(lwcell_msg_t* msg, lwcellr_t err) {
             break;
         }
 
+#if LWCELL_CFG_PPP
+        case LWCELL_CMD_PPP_DIAL:
+        case LWCELL_CMD_ATO: {
+            /* Dial has timed-out, device did not enter data mode */
+            lwcelli_ppp_dial_finished(0);
+            break;
+        }
+#endif /* LWCELL_CFG_PPP */
+
 #if LWCELL_CFG_CONN
         case LWCELL_CMD_CIPSTART: {
             /* Start connection error */
+#if LWCELL_CFG_DNS
+            lwcelli_dns_cache_failed(msg->msg.conn_start.host);
+#endif /* LWCELL_CFG_DNS */
             lwcelli_send_conn_error_cb(msg, err);
             break;
         }
 
         case LWCELL_CMD_CIPSEND: {
-            /* Send data error event */
-            CONN_SEND_DATA_SEND_EVT(msg, err);
+            /* Send data error event, dropped data were already reported */
+            if (!CONN_SEND_STALE(msg)) {
+                CONN_SEND_DATA_SEND_EVT(msg, err);
+            }
+            break;
+        }
+
+#if LWCELL_CFG_CONN_MANUAL_RECV
+        case LWCELL_CMD_CIPRXGET: {
+            /* Read was not executed, return reserved window and allow next one */
+            if (msg->msg.ciprxget.conn->val_id == msg->msg.ciprxget.val_id) {
+                lwcell_conn_p c = msg->msg.ciprxget.conn;
+
+                --c->status.f.rx_reads;
+                if (!msg->msg.ciprxget.hdr) {
+                    c->rx_credit += msg->msg.ciprxget.len;
+                }
+                c->status.f.rx_pending = 1;
+            }
             break;
         }
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV */
 #endif /* LWCELL_CFG_CONN */
 
+#if LWCELL_CFG_PING
+        case LWCELL_CMD_CIPPING: {
+            /* Report failed run and keep periodic probe running */
+            lwcelli_ping_run_finished(msg, err);
+            break;
+        }
+#endif /* LWCELL_CFG_PING */
+
 #if LWCELL_CFG_SMS
         case LWCELL_CMD_CMGS: {
             /* Send error event */
@@ -2393,6 +7012,14 @@ lwcelli_process_events_for_timeout_or_error(lwcell_msg_t* msg, lwcellr_t err) {
         }
 #endif /* LWCELL_CFG_SMS */
 
+#if LWCELL_CFG_MQTT
+        case LWCELL_CMD_SMCONN: {
+            /* Connect procedure not finished, release instance */
+            lwcelli_mqtt_connect_done(err);
+            break;
+        }
+#endif /* LWCELL_CFG_MQTT */
+
         default: break;
     }
 }
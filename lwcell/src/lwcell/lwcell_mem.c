@@ -32,18 +32,12 @@
  * Version:         v0.1.1
  */
 #include <limits.h>
+#include <stddef.h>
 #include "lwcell/lwcell_mem.h"
 #include "lwcell/lwcell_private.h"
 
 #if !LWCELL_CFG_MEM_CUSTOM || __DOXYGEN__
 
-#if !__DOXYGEN__
-typedef struct mem_block {
-    struct mem_block* next; /*!< Pointer to next free block */
-    size_t size;            /*!< Size of block */
-} mem_block_t;
-#endif                      /* !__DOXYGEN__ */
-
 /**
  * \brief           Memory alignment bits and absolute number
  */
@@ -51,6 +45,679 @@ typedef struct mem_block {
 #define MEM_ALIGN_NUM            LWCELL_SZ(LWCELL_CFG_MEM_ALIGNMENT)
 #define MEM_ALIGN(x)             LWCELL_MEM_ALIGN(x)
 
+static size_t mem_available_bytes;     /*!< Number of available bytes for allocations */
+static size_t mem_total_bytes;         /*!< Number of bytes assigned to allocator */
+static size_t mem_min_available_bytes; /*!< Minimum number of available bytes ever */
+static uint32_t mem_alloc_count;       /*!< Number of successful allocations */
+static uint32_t mem_free_count;        /*!< Number of successful frees */
+static uint32_t mem_alloc_failed;      /*!< Number of failed allocations */
+
+#if LWCELL_CFG_MEM_CLASSES
+
+/**
+ * \brief           Region address range with its classes
+ */
+typedef struct {
+    const uint8_t* start; /*!< Start address of region */
+    const uint8_t* end;   /*!< End address of region, not included */
+    uint8_t classes;      /*!< Mask of \ref LWCELL_MEM_CLASS_BIT values region serves */
+} mem_class_region_t;
+
+static mem_class_region_t mem_class_regions[LWCELL_CFG_MEM_CLASS_REGIONS]; /*!< Regions, limited to some classes */
+static size_t mem_class_regions_cnt;                                       /*!< Number of used entries */
+
+/* Class mask to search first, `0` when any region is fine */
+#define MEM_CLASS_MASK(cls)                                                                                            \
+    ((mem_class_regions_cnt > 0 && (cls) != LWCELL_MEM_CLASS_ANY) ? LWCELL_MEM_CLASS_BIT(cls) : 0)
+/* Check if allocation may fall back to any region, DMA memory must stay in its regions */
+#define MEM_CLASS_ANY_REGION(cls)    (mem_class_regions_cnt == 0 || (cls) != LWCELL_MEM_CLASS_DMA)
+#define MEM_CLASS_ACCEPTS(ptr, mask) ((mask) == 0 || mem_class_accepts((ptr), (mask)))
+
+/**
+ * \brief           Check if memory address belongs to region, allowed for class mask
+ * \param[in]       ptr: Memory address
+ * \param[in]       mask: Class mask of \ref LWCELL_MEM_CLASS_BIT values
+ * \return          `1` if allowed, `0` otherwise
+ */
+static uint8_t
+mem_class_accepts(const void* ptr, uint8_t mask) {
+    for (size_t i = 0; i < mem_class_regions_cnt; ++i) {
+        if ((const uint8_t*)ptr >= mem_class_regions[i].start && (const uint8_t*)ptr < mem_class_regions[i].end) {
+            return (mem_class_regions[i].classes & mask) != 0;
+        }
+    }
+    return 1; /* Regions without classes serve everything */
+}
+
+#else /* LWCELL_CFG_MEM_CLASSES */
+#define MEM_CLASS_MASK(cls)          0
+#define MEM_CLASS_ANY_REGION(cls)    1
+#define MEM_CLASS_ACCEPTS(ptr, mask) 1
+#endif /* !LWCELL_CFG_MEM_CLASSES */
+
+#if LWCELL_CFG_STATIC_ALLOC
+
+/*
+ * Static block pools
+ *
+ * Memory is split to fixed size blocks at compile time, one array per size class.
+ * Free blocks of each class are linked in single list, keeping pointer to next free block in user area.
+ * Block class is found from its address on free.
+ */
+
+#define MEM_POOL_STRIDE(size)    MEM_ALIGN(LWCELL_MAX((size_t)(size), sizeof(void*)))
+#define MEM_POOL_MEM(size, cnt)  (((MEM_POOL_STRIDE(size) * (cnt)) + MEM_ALIGN_NUM + sizeof(void*) - 1) / sizeof(void*))
+
+#define MEM_BLOCK_USER_SIZE(ptr) mem_pool_block_size(ptr)
+
+/**
+ * \brief           Single size class pool
+ */
+typedef struct {
+    size_t size;     /*!< Size of each block */
+    size_t cnt;      /*!< Number of blocks */
+    uint8_t* mem;    /*!< Start of pool memory, aligned to \ref LWCELL_CFG_MEM_ALIGNMENT */
+    void* free;      /*!< List of free blocks, linked with first pointer in block */
+    size_t free_cnt; /*!< Number of free blocks */
+} mem_pool_t;
+
+/* Pointer arrays keep memory aligned for pointer, extra space leaves room for configured alignment */
+static void* mem_pool_mem_small[MEM_POOL_MEM(LWCELL_CFG_STATIC_ALLOC_SMALL_SIZE, LWCELL_CFG_STATIC_ALLOC_SMALL_CNT)];
+static void* mem_pool_mem_medium[MEM_POOL_MEM(LWCELL_CFG_STATIC_ALLOC_MEDIUM_SIZE, LWCELL_CFG_STATIC_ALLOC_MEDIUM_CNT)];
+static void* mem_pool_mem_large[MEM_POOL_MEM(LWCELL_CFG_STATIC_ALLOC_LARGE_SIZE, LWCELL_CFG_STATIC_ALLOC_LARGE_CNT)];
+
+static mem_pool_t mem_pools[] = {
+    {
+        .size = MEM_POOL_STRIDE(LWCELL_CFG_STATIC_ALLOC_SMALL_SIZE),
+        .cnt = LWCELL_CFG_STATIC_ALLOC_SMALL_CNT,
+    },
+    {
+        .size = MEM_POOL_STRIDE(LWCELL_CFG_STATIC_ALLOC_MEDIUM_SIZE),
+        .cnt = LWCELL_CFG_STATIC_ALLOC_MEDIUM_CNT,
+    },
+    {
+        .size = MEM_POOL_STRIDE(LWCELL_CFG_STATIC_ALLOC_LARGE_SIZE),
+        .cnt = LWCELL_CFG_STATIC_ALLOC_LARGE_CNT,
+    },
+};
+static uint8_t mem_pools_initialized;
+static size_t mem_pool_failed_size; /*!< Largest failed request since last report, `0` when nothing to report */
+
+/**
+ * \brief           Split pool memory to free blocks
+ */
+static void
+mem_pools_init(void) {
+    uint8_t* mem[] = {(uint8_t*)mem_pool_mem_small, (uint8_t*)mem_pool_mem_medium, (uint8_t*)mem_pool_mem_large};
+    mem_pool_t* pool;
+
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(mem_pools); ++i) {
+        pool = &mem_pools[i];
+        pool->mem = mem[i];
+        if (LWCELL_SZ(pool->mem) & MEM_ALIGN_BITS) {
+            pool->mem += MEM_ALIGN_NUM - (LWCELL_SZ(pool->mem) & MEM_ALIGN_BITS);
+        }
+        pool->free = NULL;
+        for (size_t j = pool->cnt; j > 0; --j) {
+            void** b = (void**)(pool->mem + (j - 1) * pool->size);
+            *b = pool->free;
+            pool->free = b;
+        }
+        pool->free_cnt = pool->cnt;
+        mem_total_bytes += pool->cnt * pool->size;
+    }
+    mem_available_bytes = mem_total_bytes;
+    mem_min_available_bytes = mem_total_bytes;
+    mem_pools_initialized = 1;
+}
+
+/**
+ * \brief           Get pool block belongs to
+ * \param[in]       ptr: Pointer to block
+ * \return          Pool handle on success, `NULL` if pointer is not part of any pool
+ */
+static mem_pool_t*
+mem_pool_of(const void* ptr) {
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(mem_pools); ++i) {
+        mem_pool_t* pool = &mem_pools[i];
+        if ((const uint8_t*)ptr >= pool->mem && (const uint8_t*)ptr < pool->mem + pool->cnt * pool->size) {
+            return pool;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Get usable size of block
+ * \param[in]       ptr: Pointer to block
+ * \return          Block size in units of bytes, `0` if pointer is not part of any pool
+ */
+static size_t
+mem_pool_block_size(const void* ptr) {
+    mem_pool_t* pool = mem_pool_of(ptr);
+    return pool != NULL ? pool->size : 0;
+}
+
+/**
+ * \brief           Regions are not used with static pools
+ * \param[in]       regions: Unused
+ * \param[in]       len: Unused
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+mem_assignmem(const lwcell_mem_region_t* regions, size_t len) {
+    LWCELL_UNUSED(regions);
+    LWCELL_UNUSED(len);
+    if (!mem_pools_initialized) {
+        mem_pools_init();
+    }
+    return 1;
+}
+
+/**
+ * \brief           Allocate memory of specific size
+ * \param[in]       size: Number of bytes to allocate
+ * \param[in]       cls: Unused, pools have no regions
+ * \return          Memory address on success, `NULL` otherwise
+ */
+static void*
+mem_alloc(size_t size, lwcell_mem_class_t cls) {
+    mem_pool_t* pool;
+    void** b;
+
+    LWCELL_UNUSED(cls);
+    if (!mem_pools_initialized) {
+        mem_pools_init();
+    }
+    if (size > 0) {
+        for (size_t i = 0; i < LWCELL_ARRAYSIZE(mem_pools); ++i) {
+            pool = &mem_pools[i];
+            if (pool->size >= size && pool->free != NULL) {
+                b = pool->free;
+                pool->free = *b;
+                --pool->free_cnt;
+                mem_available_bytes -= pool->size;
+                if (mem_available_bytes < mem_min_available_bytes) {
+                    mem_min_available_bytes = mem_available_bytes;
+                }
+                ++mem_alloc_count;
+                return b;
+            }
+        }
+    }
+    ++mem_alloc_failed;
+
+    /* Report is sent from processing thread, as allocator can be called from any context */
+    if (mem_pool_failed_size == 0 && lwcell.status.f.initialized) {
+        LWCELL_PROCESS_WAKEUP();
+    }
+    if (size > mem_pool_failed_size) {
+        mem_pool_failed_size = size;
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Free memory
+ * \param[in]       ptr: Pointer to memory previously returned using \ref lwcell_mem_malloc,
+ *                      \ref lwcell_mem_calloc or \ref lwcell_mem_realloc functions
+ */
+static void
+mem_free(void* ptr) {
+    mem_pool_t* pool;
+
+    if (ptr == NULL || (pool = mem_pool_of(ptr)) == NULL) { /* Invalid pointer */
+        return;
+    }
+    *(void**)ptr = pool->free;
+    pool->free = ptr;
+    ++pool->free_cnt;
+    mem_available_bytes += pool->size;
+    ++mem_free_count;
+}
+
+/**
+ * \brief           Get largest free block and number of free blocks
+ * \param[out]      largest: Size of largest free block
+ * \param[out]      count: Number of free blocks
+ */
+static void
+mem_free_blocks_info(size_t* largest, size_t* count) {
+    *largest = 0;
+    *count = 0;
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(mem_pools); ++i) {
+        if (mem_pools[i].free_cnt > 0) {
+            *largest = mem_pools[i].size;
+        }
+        *count += mem_pools[i].free_cnt;
+    }
+}
+
+/**
+ * \brief           Send \ref LWCELL_EVT_MEM_POOL_EMPTY event if any allocation failed since last call
+ * \note            Function is called from processing thread with core locked
+ */
+void
+lwcelli_mem_pool_report(void) {
+    if (mem_pool_failed_size == 0) {
+        return;
+    }
+    lwcell.evt.evt.mem_pool_empty.size = mem_pool_failed_size;
+    lwcelli_send_cb(LWCELL_EVT_MEM_POOL_EMPTY);
+
+    /* Failures during callback are part of this report */
+    mem_pool_failed_size = 0;
+}
+
+#elif LWCELL_CFG_MEM_TLSF
+
+/*
+ * Two-level segregated fit allocator
+ *
+ * Every block starts with header, holding pointer to physically previous block
+ * and size of user area. Free blocks additionally keep free list pointers in user area.
+ *
+ * Free blocks are kept in lists, indexed by first level (power of 2 range)
+ * and second level (linear subdivision of first level range).
+ * Bitmaps of non-empty lists allow finding suitable list with bit-scan operations.
+ */
+
+#if !__DOXYGEN__
+typedef struct mem_block {
+    struct mem_block* prev_phys; /*!< Physically previous block, `NULL` for first block in region */
+    size_t size;                 /*!< Size of user area with \ref MEM_FREE_BIT flag */
+    struct mem_block* next_free; /*!< Next free block in the same list. Valid only for free blocks */
+    struct mem_block* prev_free; /*!< Previous free block in the same list. Valid only for free blocks */
+} mem_block_t;
+#endif /* !__DOXYGEN__ */
+
+#if LWCELL_CFG_MEM_ALIGNMENT == 4
+#define MEM_ALIGN_LOG2 2
+#elif LWCELL_CFG_MEM_ALIGNMENT == 8
+#define MEM_ALIGN_LOG2 3
+#elif LWCELL_CFG_MEM_ALIGNMENT == 16
+#define MEM_ALIGN_LOG2 4
+#elif LWCELL_CFG_MEM_ALIGNMENT == 32
+#define MEM_ALIGN_LOG2 5
+#else
+#error "LWCELL_CFG_MEM_ALIGNMENT must be 4, 8, 16 or 32 when LWCELL_CFG_MEM_TLSF is enabled!"
+#endif
+
+#define MEM_SL_LOG2              3
+#define MEM_SL_COUNT             (1U << MEM_SL_LOG2)
+#define MEM_SMALL_LOG2           (MEM_SL_LOG2 + MEM_ALIGN_LOG2)
+#define MEM_SMALL_SIZE           ((size_t)1 << MEM_SMALL_LOG2)
+#define MEM_FL_COUNT             (LWCELL_CFG_MEM_TLSF_MAX_LOG2 - MEM_SMALL_LOG2 + 1)
+
+#if LWCELL_CFG_MEM_TLSF_MAX_LOG2 <= MEM_SMALL_LOG2 || MEM_FL_COUNT > 32
+#error "LWCELL_CFG_MEM_TLSF_MAX_LOG2 is out of range!"
+#endif
+
+#define MEM_FREE_BIT             ((size_t)0x01)
+#define MEM_SIZE_MASK            (~(size_t)0x03)
+#define MEMBLOCK_METASIZE        MEM_ALIGN(offsetof(mem_block_t, next_free))
+#define MEMBLOCK_MIN_SIZE        MEM_ALIGN(sizeof(mem_block_t) - offsetof(mem_block_t, next_free))
+#define MEM_MAX_SIZE             (MEM_SIZE_MASK - MEMBLOCK_METASIZE)
+
+#define MEM_BLOCK_SIZE(b)        ((b)->size & MEM_SIZE_MASK)
+#define MEM_BLOCK_IS_FREE(b)     (((b)->size & MEM_FREE_BIT) != 0)
+#define MEM_BLOCK_NEXT(b)        ((mem_block_t*)((uint8_t*)(b) + MEMBLOCK_METASIZE + MEM_BLOCK_SIZE(b)))
+#define MEM_BLOCK_FROM_PTR(ptr)  ((mem_block_t*)(((uint8_t*)(ptr)) - MEMBLOCK_METASIZE))
+#define MEM_BLOCK_TO_PTR(b)      ((void*)((uint8_t*)(b) + MEMBLOCK_METASIZE))
+#define MEM_BLOCK_USER_SIZE(ptr) MEM_BLOCK_SIZE(MEM_BLOCK_FROM_PTR(ptr))
+
+static mem_block_t* mem_lists[MEM_FL_COUNT][MEM_SL_COUNT]; /*!< Heads of free lists */
+static uint32_t mem_fl_bitmap;                             /*!< Bitmap of non-empty first level ranges */
+static uint32_t mem_sl_bitmap[MEM_FL_COUNT];               /*!< Bitmaps of non-empty second level lists */
+static uint8_t mem_assigned;                               /*!< Set to `1` when regions are assigned */
+
+/**
+ * \brief           Get index of most significant set bit
+ * \param[in]       x: Value to scan, must not be `0`
+ * \return          Bit index
+ */
+static uint32_t
+mem_fls(size_t x) {
+#if defined(__GNUC__)
+    return (uint32_t)(sizeof(unsigned long) * CHAR_BIT - 1 - __builtin_clzl((unsigned long)x));
+#else
+    uint32_t bit = 0;
+    for (; x > 1; x >>= 1, ++bit) {}
+    return bit;
+#endif /* defined(__GNUC__) */
+}
+
+/**
+ * \brief           Get index of least significant set bit
+ * \param[in]       x: Value to scan, must not be `0`
+ * \return          Bit index
+ */
+static uint32_t
+mem_ffs(uint32_t x) {
+    return mem_fls((size_t)(x & (~x + 1)));
+}
+
+/**
+ * \brief           Get list indexes for block size
+ * \param[in]       size: Block user size
+ * \param[out]      fl: First level index
+ * \param[out]      sl: Second level index
+ */
+static void
+mem_mapping(size_t size, uint32_t* fl, uint32_t* sl) {
+    uint32_t bit;
+
+    if (size < MEM_SMALL_SIZE) {
+        *fl = 0;
+        *sl = (uint32_t)(size >> MEM_ALIGN_LOG2);
+        return;
+    }
+    bit = mem_fls(size);
+    if (bit >= LWCELL_CFG_MEM_TLSF_MAX_LOG2) { /* Oversized blocks go to last list */
+        *fl = MEM_FL_COUNT - 1;
+        *sl = MEM_SL_COUNT - 1;
+        return;
+    }
+    *fl = bit - MEM_SMALL_LOG2 + 1;
+    *sl = (uint32_t)(size >> (bit - MEM_SL_LOG2)) ^ MEM_SL_COUNT;
+}
+
+/**
+ * \brief           Insert free block to its list
+ * \param[in]       b: Block to insert
+ */
+static void
+mem_list_insert(mem_block_t* b) {
+    uint32_t fl, sl;
+
+    mem_mapping(MEM_BLOCK_SIZE(b), &fl, &sl);
+    b->size |= MEM_FREE_BIT;
+    b->prev_free = NULL;
+    b->next_free = mem_lists[fl][sl];
+    if (b->next_free != NULL) {
+        b->next_free->prev_free = b;
+    }
+    mem_lists[fl][sl] = b;
+    mem_fl_bitmap |= 1UL << fl;
+    mem_sl_bitmap[fl] |= 1UL << sl;
+}
+
+/**
+ * \brief           Remove free block from its list
+ * \param[in]       b: Block to remove
+ */
+static void
+mem_list_remove(mem_block_t* b) {
+    uint32_t fl, sl;
+
+    mem_mapping(MEM_BLOCK_SIZE(b), &fl, &sl);
+    if (b->prev_free != NULL) {
+        b->prev_free->next_free = b->next_free;
+    } else {
+        mem_lists[fl][sl] = b->next_free;
+        if (mem_lists[fl][sl] == NULL) {
+            mem_sl_bitmap[fl] &= ~(1UL << sl);
+            if (mem_sl_bitmap[fl] == 0) {
+                mem_fl_bitmap &= ~(1UL << fl);
+            }
+        }
+    }
+    if (b->next_free != NULL) {
+        b->next_free->prev_free = b->prev_free;
+    }
+    b->size &= ~MEM_FREE_BIT;
+}
+
+/**
+ * \brief           Find free block, big enough for requested size
+ * \param[in]       size: Aligned user size
+ * \return          Free block on success, `NULL` otherwise
+ */
+static mem_block_t*
+mem_find_block(size_t size) {
+    mem_block_t* b;
+    uint32_t fl, sl, sl_map, fl_map;
+    size_t rsize = size;
+
+    /* Round up to next list, so that any block in found list fits */
+    if (rsize >= MEM_SMALL_SIZE) {
+        rsize += ((size_t)1 << (mem_fls(rsize) - MEM_SL_LOG2)) - 1;
+    }
+    mem_mapping(rsize, &fl, &sl);
+
+    sl_map = mem_sl_bitmap[fl] & (uint32_t)(~0UL << sl);
+    if (sl_map == 0) {
+        fl_map = (fl + 1) < MEM_FL_COUNT ? (mem_fl_bitmap & (uint32_t)(~0UL << (fl + 1))) : 0;
+        if (fl_map == 0) {
+            return NULL;
+        }
+        fl = mem_ffs(fl_map);
+        sl_map = mem_sl_bitmap[fl];
+    }
+    sl = mem_ffs(sl_map);
+    b = mem_lists[fl][sl];
+
+    /* Last list keeps blocks of different sizes */
+    if (fl == MEM_FL_COUNT - 1 && sl == MEM_SL_COUNT - 1) {
+        for (; b != NULL && MEM_BLOCK_SIZE(b) < size; b = b->next_free) {}
+    }
+    return b;
+}
+
+#if LWCELL_CFG_MEM_CLASSES
+
+/**
+ * \brief           Find free block, big enough for requested size, in regions of class mask
+ * \note            Lists are walked block by block, as any of them may be in wrong region
+ * \param[in]       size: Aligned user size
+ * \param[in]       mask: Class mask of \ref LWCELL_MEM_CLASS_BIT values
+ * \return          Free block on success, `NULL` otherwise
+ */
+static mem_block_t*
+mem_find_block_class(size_t size, uint8_t mask) {
+    uint32_t fl, sl, sl_map;
+
+    mem_mapping(size, &fl, &sl);
+    for (; fl < MEM_FL_COUNT; ++fl, sl = 0) {
+        sl_map = mem_sl_bitmap[fl] & (uint32_t)(~0UL << sl);
+        for (; sl_map != 0; sl_map &= sl_map - 1) {
+            for (mem_block_t* b = mem_lists[fl][mem_ffs(sl_map)]; b != NULL; b = b->next_free) {
+                if (MEM_BLOCK_SIZE(b) >= size && mem_class_accepts(b, mask)) {
+                    return b;
+                }
+            }
+        }
+    }
+    return NULL;
+}
+
+#endif /* LWCELL_CFG_MEM_CLASSES */
+
+/**
+ * \brief           Assign memory for HEAP allocations
+ * \param[in]       regions: Pointer to list of regions.
+ *                  Set regions in ascending order by address
+ * \param[in]       len: Number of regions to assign
+ */
+static uint8_t
+mem_assignmem(const lwcell_mem_region_t* regions, size_t len) {
+    uint8_t* mem_start_addr;
+    size_t mem_size;
+    mem_block_t *first_block, *last_block;
+
+    if (mem_assigned) { /* Regions already defined */
+        return 0;
+    }
+
+    /* Check if region address are linear and rising */
+    mem_start_addr = (uint8_t*)0;
+    for (size_t i = 0; i < len; ++i) {
+        if (mem_start_addr >= (uint8_t*)regions[i].start_addr) {
+            return 0;
+        }
+        mem_start_addr = (uint8_t*)regions[i].start_addr;
+    }
+
+    for (; len > 0; --len, ++regions) {
+        mem_start_addr = (uint8_t*)regions->start_addr;
+        mem_size = regions->size;
+        if (LWCELL_SZ(mem_start_addr) & MEM_ALIGN_BITS) {
+            size_t diff = MEM_ALIGN_NUM - (LWCELL_SZ(mem_start_addr) & MEM_ALIGN_BITS);
+            if (diff >= mem_size) {
+                continue;
+            }
+            mem_start_addr += diff;
+            mem_size -= diff;
+        }
+        mem_size &= ~MEM_ALIGN_BITS;
+
+        /* Region needs first block and end sentinel block */
+        if (mem_size < (2 * MEMBLOCK_METASIZE + MEMBLOCK_MIN_SIZE)) {
+            continue;
+        }
+        if (mem_size - 2 * MEMBLOCK_METASIZE > MEM_MAX_SIZE) {
+            mem_size = MEM_MAX_SIZE + 2 * MEMBLOCK_METASIZE;
+        }
+
+        first_block = (mem_block_t*)mem_start_addr;
+        first_block->prev_phys = NULL;
+        first_block->size = mem_size - 2 * MEMBLOCK_METASIZE;
+
+        /* Sentinel is never free, it stops merging at the end of region */
+        last_block = MEM_BLOCK_NEXT(first_block);
+        last_block->prev_phys = first_block;
+        last_block->size = 0;
+
+        mem_list_insert(first_block);
+        mem_available_bytes += MEM_BLOCK_SIZE(first_block) + MEMBLOCK_METASIZE;
+        mem_assigned = 1;
+    }
+    mem_total_bytes = mem_available_bytes;
+    mem_min_available_bytes = mem_available_bytes;
+    return mem_assigned;
+}
+
+/**
+ * \brief           Allocate memory of specific size
+ * \param[in]       size: Number of bytes to allocate
+ * \param[in]       cls: Allocation class
+ * \return          Memory address on success, `NULL` otherwise
+ */
+static void*
+mem_alloc(size_t size, lwcell_mem_class_t cls) {
+    mem_block_t *b = NULL, *next;
+
+    if (size == 0 || size > MEM_MAX_SIZE) {
+        ++mem_alloc_failed;
+        return NULL;
+    }
+    size = MEM_ALIGN(size);
+    if (size < MEMBLOCK_MIN_SIZE) {
+        size = MEMBLOCK_MIN_SIZE;
+    }
+
+#if LWCELL_CFG_MEM_CLASSES
+    if (MEM_CLASS_MASK(cls) != 0) {
+        b = mem_find_block_class(size, MEM_CLASS_MASK(cls));
+    }
+#else
+    LWCELL_UNUSED(cls);
+#endif /* LWCELL_CFG_MEM_CLASSES */
+    if (b == NULL && MEM_CLASS_ANY_REGION(cls)) {
+        b = mem_find_block(size);
+    }
+    if (b == NULL) {
+        ++mem_alloc_failed;
+        return NULL;
+    }
+    mem_list_remove(b);
+
+    /* Split block when remaining part can hold another block */
+    if (MEM_BLOCK_SIZE(b) - size >= MEMBLOCK_METASIZE + MEMBLOCK_MIN_SIZE) {
+        next = (mem_block_t*)((uint8_t*)b + MEMBLOCK_METASIZE + size);
+        next->prev_phys = b;
+        next->size = MEM_BLOCK_SIZE(b) - size - MEMBLOCK_METASIZE;
+        b->size = size;
+        MEM_BLOCK_NEXT(next)->prev_phys = next;
+        mem_list_insert(next);
+    }
+
+    mem_available_bytes -= MEM_BLOCK_SIZE(b) + MEMBLOCK_METASIZE;
+    if (mem_available_bytes < mem_min_available_bytes) {
+        mem_min_available_bytes = mem_available_bytes;
+    }
+    ++mem_alloc_count;
+    return MEM_BLOCK_TO_PTR(b);
+}
+
+/**
+ * \brief           Free memory
+ * \param[in]       ptr: Pointer to memory previously returned using \ref lwcell_mem_malloc,
+ *                      \ref lwcell_mem_calloc or \ref lwcell_mem_realloc functions
+ */
+static void
+mem_free(void* ptr) {
+    mem_block_t *b, *next;
+
+    if (ptr == NULL) {
+        return;
+    }
+
+    b = MEM_BLOCK_FROM_PTR(ptr);
+    if (MEM_BLOCK_IS_FREE(b) || MEM_BLOCK_SIZE(b) == 0) { /* Double free or invalid pointer */
+        return;
+    }
+    mem_available_bytes += MEM_BLOCK_SIZE(b) + MEMBLOCK_METASIZE;
+    ++mem_free_count;
+
+    /* Merge with physically previous free block */
+    if (b->prev_phys != NULL && MEM_BLOCK_IS_FREE(b->prev_phys)) {
+        mem_list_remove(b->prev_phys);
+        b->prev_phys->size += MEMBLOCK_METASIZE + MEM_BLOCK_SIZE(b);
+        b = b->prev_phys;
+    }
+
+    /* Merge with physically next free block */
+    next = MEM_BLOCK_NEXT(b);
+    if (MEM_BLOCK_IS_FREE(next)) {
+        mem_list_remove(next);
+        b->size += MEMBLOCK_METASIZE + MEM_BLOCK_SIZE(next);
+        next = MEM_BLOCK_NEXT(b);
+    }
+    next->prev_phys = b;
+    mem_list_insert(b);
+}
+
+/**
+ * \brief           Get largest free block and number of free blocks
+ * \param[out]      largest: Size of largest free block, including metadata
+ * \param[out]      count: Number of free blocks
+ */
+static void
+mem_free_blocks_info(size_t* largest, size_t* count) {
+    *largest = 0;
+    *count = 0;
+    for (uint32_t fl = 0; fl < MEM_FL_COUNT; ++fl) {
+        for (uint32_t sl = 0; sl < MEM_SL_COUNT; ++sl) {
+            for (mem_block_t* b = mem_lists[fl][sl]; b != NULL; b = b->next_free) {
+                if (MEM_BLOCK_SIZE(b) + MEMBLOCK_METASIZE > *largest) {
+                    *largest = MEM_BLOCK_SIZE(b) + MEMBLOCK_METASIZE;
+                }
+                ++*count;
+            }
+        }
+    }
+}
+
+#else /* LWCELL_CFG_STATIC_ALLOC || LWCELL_CFG_MEM_TLSF */
+
+#if !__DOXYGEN__
+typedef struct mem_block {
+    struct mem_block* next; /*!< Pointer to next free block */
+    size_t size;            /*!< Size of block */
+} mem_block_t;
+#endif                      /* !__DOXYGEN__ */
+
 #define MEMBLOCK_METASIZE        MEM_ALIGN(sizeof(mem_block_t))
 
 #define MEM_ALLOC_BIT            ((size_t)((size_t)1 << (sizeof(size_t) * CHAR_BIT - 1)))
@@ -59,7 +726,6 @@ typedef struct mem_block {
 
 static mem_block_t start_block;    /*!< First block data for allocations */
 static mem_block_t* end_block;     /*!< Pointer to last block in linked list */
-static size_t mem_available_bytes; /*!< Number of available bytes for allocations */
 
 /**
  * \brief           Insert a new block to linked list of free blocks
@@ -203,6 +869,8 @@ mem_assignmem(const lwcell_mem_region_t* regions, size_t len) {
         /* Set number of free bytes available to allocate in region */
         mem_available_bytes += first_block->size;
     }
+    mem_total_bytes = mem_available_bytes;
+    mem_min_available_bytes = mem_available_bytes;
 
     return 1; /* Regions set as expected */
 }
@@ -210,23 +878,30 @@ mem_assignmem(const lwcell_mem_region_t* regions, size_t len) {
 /**
  * \brief           Allocate memory of specific size
  * \param[in]       size: Number of bytes to allocate
+ * \param[in]       cls: Allocation class
  * \return          Memory address on success, `NULL` otherwise
  */
 static void*
-mem_alloc(size_t size) {
+mem_alloc(size_t size, lwcell_mem_class_t cls) {
     mem_block_t *prev, *curr, *next;
     void* retval = NULL;
+    uint8_t mask = MEM_CLASS_MASK(cls);
 
+#if !LWCELL_CFG_MEM_CLASSES
+    LWCELL_UNUSED(cls);
+#endif /* !LWCELL_CFG_MEM_CLASSES */
     if (end_block == NULL) { /* If end block is not yet defined */
         return NULL;         /* Invalid, not initialized */
     }
 
     if (size == 0 || size >= MEM_ALLOC_BIT) {
+        ++mem_alloc_failed;
         return NULL;
     }
 
     size = MEM_ALIGN(size) + MEMBLOCK_METASIZE; /* Increase size for metadata */
     if (size > mem_available_bytes) {           /* Check if we have enough memory available */
+        ++mem_alloc_failed;
         return 0;
     }
 
@@ -235,11 +910,17 @@ mem_alloc(size_t size) {
      * Go through free blocks until enough memory is found
      * or end block is reached (no next free block)
      */
-    prev = &start_block; /* Set first first block as previous */
-    curr = prev->next;   /* Set next block as current */
-    while ((curr->size < size) && (curr->next != NULL)) {
-        prev = curr;
-        curr = curr->next;
+    for (;;) {
+        prev = &start_block; /* Set first first block as previous */
+        curr = prev->next;   /* Set next block as current */
+        while ((curr->size < size || !MEM_CLASS_ACCEPTS(curr, mask)) && (curr->next != NULL)) {
+            prev = curr;
+            curr = curr->next;
+        }
+        if (curr != end_block || mask == 0 || !MEM_CLASS_ANY_REGION(cls)) {
+            break;
+        }
+        mask = 0; /* Class regions are full, retry in any region */
     }
 
     /*
@@ -270,12 +951,16 @@ mem_alloc(size_t size) {
              */
             mem_insertfreeblock(next); /* Insert free memory block to list of free memory blocks (linked list chain) */
         }
-        curr->size |= MEM_ALLOC_BIT;   /* Set allocated bit = memory is allocated */
-        curr->next = NULL;             /* Clear next free block pointer as there is no one */
+        mem_available_bytes -= curr->size; /* Decrease available memory, block may be bigger than requested */
+        curr->size |= MEM_ALLOC_BIT;       /* Set allocated bit = memory is allocated */
+        curr->next = NULL;                 /* Clear next free block pointer as there is no one */
 
-        mem_available_bytes -= size;   /* Decrease available memory */
+        if (mem_available_bytes < mem_min_available_bytes) {
+            mem_min_available_bytes = mem_available_bytes;
+        }
+        ++mem_alloc_count;
     } else {
-        /* Allocation failed, no free blocks of required size */
+        ++mem_alloc_failed; /* Allocation failed, no free blocks of required size */
     }
     return retval;
 }
@@ -307,22 +992,133 @@ mem_free(void* ptr) {
         block->size &= ~MEM_ALLOC_BIT;      /* Clear allocated bit */
         mem_available_bytes += block->size; /* Increase available bytes back */
         mem_insertfreeblock(block);         /* Insert block to list of free blocks */
+        ++mem_free_count;
     }
 }
 
+/**
+ * \brief           Get largest free block and number of free blocks
+ * \param[out]      largest: Size of largest free block, including metadata
+ * \param[out]      count: Number of free blocks
+ */
+static void
+mem_free_blocks_info(size_t* largest, size_t* count) {
+    *largest = 0;
+    *count = 0;
+    if (end_block == NULL) {
+        return;
+    }
+    for (mem_block_t* b = start_block.next; b != NULL; b = b->next) {
+        if (b->size > *largest) {
+            *largest = b->size;
+        }
+        if (b->size > 0) { /* Skip region end blocks */
+            ++*count;
+        }
+    }
+}
+
+#endif /* !LWCELL_CFG_STATIC_ALLOC && !LWCELL_CFG_MEM_TLSF */
+
+#if LWCELL_CFG_MEM_TAGS || __DOXYGEN__
+
+/**
+ * \brief           Size of tag header in front of user memory, keeps user memory aligned
+ */
+#define MEM_TAG_SIZE            MEM_ALIGN_NUM
+#define MEM_TAG_RAW(ptr)        ((uint8_t*)(ptr) - MEM_TAG_SIZE)
+#define MEM_TAG_USER_SIZE(ptr)  (MEM_BLOCK_USER_SIZE(MEM_TAG_RAW(ptr)) - MEM_TAG_SIZE)
+
+static lwcell_mem_tag_stats_t mem_tags[LWCELL_MEM_TAG_END]; /*!< Memory usage per subsystem tag */
+
+#else /* LWCELL_CFG_MEM_TAGS || __DOXYGEN__ */
+#define MEM_TAG_USER_SIZE(ptr) MEM_BLOCK_USER_SIZE(ptr)
+#endif /* !(LWCELL_CFG_MEM_TAGS || __DOXYGEN__) */
+
+/**
+ * \brief           Allocation class of each subsystem tag, indexed by \ref lwcell_mem_tag_t
+ */
+static const uint8_t mem_tag_classes[LWCELL_MEM_TAG_END] = {
+    [LWCELL_MEM_TAG_OTHER] = LWCELL_MEM_CLASS_ANY,
+    [LWCELL_MEM_TAG_MSG] = LWCELL_MEM_CLASS_FAST,
+    [LWCELL_MEM_TAG_PBUF] = LWCELL_MEM_CLASS_DMA,
+    [LWCELL_MEM_TAG_BUFF] = LWCELL_MEM_CLASS_FAST,
+    [LWCELL_MEM_TAG_CONN] = LWCELL_MEM_CLASS_DMA,
+    [LWCELL_MEM_TAG_NETCONN] = LWCELL_MEM_CLASS_BULK,
+    [LWCELL_MEM_TAG_MQTT] = LWCELL_MEM_CLASS_BULK,
+    [LWCELL_MEM_TAG_EVT] = LWCELL_MEM_CLASS_FAST,
+    [LWCELL_MEM_TAG_TIMEOUT] = LWCELL_MEM_CLASS_FAST,
+};
+
+/**
+ * \brief           Allocate memory and account it to subsystem tag
+ * \param[in]       size: Number of bytes to allocate
+ * \param[in]       tag: Subsystem tag of allocation
+ * \return          Memory address on success, `NULL` otherwise
+ */
+static void*
+mem_alloc_tag(size_t size, lwcell_mem_tag_t tag) {
+#if LWCELL_CFG_MEM_TAGS
+    lwcell_mem_tag_stats_t* st;
+    uint8_t* raw;
+
+    if ((size_t)tag >= LWCELL_MEM_TAG_END) {
+        tag = LWCELL_MEM_TAG_OTHER;
+    }
+    if (size == 0 || (size + MEM_TAG_SIZE) < size
+        || (raw = mem_alloc(size + MEM_TAG_SIZE, lwcell_mem_tag_class(tag))) == NULL) {
+        return NULL;
+    }
+    raw[0] = (uint8_t)tag;
+    st = &mem_tags[tag];
+    st->current_bytes += MEM_BLOCK_USER_SIZE(raw);
+    if (st->current_bytes > st->peak_bytes) {
+        st->peak_bytes = st->current_bytes;
+    }
+    ++st->alloc_count;
+    return raw + MEM_TAG_SIZE;
+#else  /* LWCELL_CFG_MEM_TAGS */
+    return mem_alloc(size, lwcell_mem_tag_class(tag));
+#endif /* !LWCELL_CFG_MEM_TAGS */
+}
+
+/**
+ * \brief           Free memory and remove it from its subsystem tag
+ * \param[in]       ptr: Pointer to memory previously returned using \ref mem_alloc_tag
+ */
+static void
+mem_free_tag(void* ptr) {
+#if LWCELL_CFG_MEM_TAGS
+    lwcell_mem_tag_stats_t* st;
+    uint8_t* raw;
+
+    if (ptr == NULL) {
+        return;
+    }
+    raw = MEM_TAG_RAW(ptr);
+    st = &mem_tags[raw[0] < LWCELL_MEM_TAG_END ? raw[0] : LWCELL_MEM_TAG_OTHER];
+    st->current_bytes -= LWCELL_MIN(st->current_bytes, MEM_BLOCK_USER_SIZE(raw));
+    ++st->free_count;
+    mem_free(raw);
+#else  /* LWCELL_CFG_MEM_TAGS */
+    mem_free(ptr);
+#endif /* !LWCELL_CFG_MEM_TAGS */
+}
+
 /**
  * \brief           Allocate memory of specific size
  * \param[in]       num: Number of elements to allocate
  * \param[in]       size: Size of element in units of bytes
+ * \param[in]       tag: Subsystem tag of allocation
  * \return          Memory address on success, `NULL` otherwise
  */
 static void*
-mem_calloc(size_t num, size_t size) {
+mem_calloc(size_t num, size_t size, lwcell_mem_tag_t tag) {
     void* ptr;
     size_t tot_len = num * size;
 
-    if ((ptr = mem_alloc(tot_len)) != NULL) { /* Try to allocate memory */
-        LWCELL_MEMSET(ptr, 0x00, tot_len);    /* Reset entire memory */
+    if ((ptr = mem_alloc_tag(tot_len, tag)) != NULL) { /* Try to allocate memory */
+        LWCELL_MEMSET(ptr, 0x00, tot_len);             /* Reset entire memory */
     }
     return ptr;
 }
@@ -333,22 +1129,23 @@ mem_calloc(size_t num, size_t size) {
  * \param[in]       ptr: Pointer to current allocated memory to resize, returned using
  *                      \ref lwcell_mem_malloc, \ref lwcell_mem_calloc or \ref lwcell_mem_realloc functions
  * \param[in]       size: Number of bytes to allocate on new memory
+ * \param[in]       tag: Subsystem tag of new allocation
  * \return          Memory address on success, `NULL` otherwise
  */
 static void*
-mem_realloc(void* ptr, size_t size) {
+mem_realloc(void* ptr, size_t size, lwcell_mem_tag_t tag) {
     void* new_ptr;
     size_t old_size;
 
-    if (ptr == NULL) {          /* If pointer is not valid */
-        return mem_alloc(size); /* Only allocate memory */
+    if (ptr == NULL) {                   /* If pointer is not valid */
+        return mem_alloc_tag(size, tag); /* Only allocate memory */
     }
 
-    old_size = MEM_BLOCK_USER_SIZE(ptr);                         /* Get size of old pointer */
-    new_ptr = mem_alloc(size);                                   /* Try to allocate new memory block */
+    old_size = MEM_TAG_USER_SIZE(ptr);                           /* Get size of old pointer */
+    new_ptr = mem_alloc_tag(size, tag);                          /* Try to allocate new memory block */
     if (new_ptr != NULL) {
         LWCELL_MEMCPY(new_ptr, ptr, LWCELL_MIN(size, old_size)); /* Copy old data to new array */
-        mem_free(ptr);                                           /* Free old pointer */
+        mem_free_tag(ptr);                                       /* Free old pointer */
     }
     return new_ptr;
 }
@@ -361,9 +1158,49 @@ mem_realloc(void* ptr, size_t size) {
  */
 void*
 lwcell_mem_malloc(size_t size) {
+    return lwcell_mem_malloc_tag(size, LWCELL_MEM_TAG_OTHER);
+}
+
+/**
+ * \brief           Reallocate memory to specific size
+ * \note            After new memory is allocated, content of old one is copied to new memory
+ * \param[in]       ptr: Pointer to current allocated memory to resize, returned using \ref lwcell_mem_malloc,
+ *                      \ref lwcell_mem_calloc or \ref lwcell_mem_realloc functions
+ * \param[in]       size: Number of bytes to allocate on new memory
+ * \return          Memory address on success, `NULL` otherwise
+ * \note            Function is not available when \ref LWCELL_CFG_MEM_CUSTOM is `1` and must be implemented by user
+ */
+void*
+lwcell_mem_realloc(void* ptr, size_t size) {
+    return lwcell_mem_realloc_tag(ptr, size, LWCELL_MEM_TAG_OTHER);
+}
+
+/**
+ * \brief           Allocate memory of specific size and set memory to zero
+ * \param[in]       num: Number of elements to allocate
+ * \param[in]       size: Size of each element
+ * \return          Memory address on success, `NULL` otherwise
+ * \note            Function is not available when \ref LWCELL_CFG_MEM_CUSTOM is `1` and must be implemented by user
+ */
+void*
+lwcell_mem_calloc(size_t num, size_t size) {
+    return lwcell_mem_calloc_tag(num, size, LWCELL_MEM_TAG_OTHER);
+}
+
+/**
+ * \brief           Allocate memory of specific size for subsystem
+ * \note            With \ref LWCELL_CFG_MEM_TAGS enabled, allocation is accounted to `tag`
+ * \param[in]       size: Number of bytes to allocate
+ * \param[in]       tag: Subsystem tag of allocation
+ * \return          Memory address on success, `NULL` otherwise
+ */
+void*
+lwcell_mem_malloc_tag(size_t size, lwcell_mem_tag_t tag) {
     void* ptr;
     lwcell_core_lock();
-    ptr = mem_calloc(1, size); /* Allocate memory and return pointer */
+    LWCELL_TRACE_HOOK(LWCELL_TRACE_MEM_ALLOC, LWCELL_TRACE_BEGIN, size);
+    ptr = mem_calloc(1, size, tag); /* Allocate memory and return pointer */
+    LWCELL_TRACE_HOOK(LWCELL_TRACE_MEM_ALLOC, LWCELL_TRACE_END, 0);
     lwcell_core_unlock();
     LWCELL_DEBUGW(LWCELL_CFG_DBG_MEM | LWCELL_DBG_TYPE_TRACE, ptr == NULL,
                   "[LWCELL MEM] Allocation failed: %d bytes\r\n", (int)size);
@@ -373,18 +1210,20 @@ lwcell_mem_malloc(size_t size) {
 }
 
 /**
- * \brief           Reallocate memory to specific size
+ * \brief           Reallocate memory to specific size for subsystem
  * \note            After new memory is allocated, content of old one is copied to new memory
  * \param[in]       ptr: Pointer to current allocated memory to resize, returned using \ref lwcell_mem_malloc,
  *                      \ref lwcell_mem_calloc or \ref lwcell_mem_realloc functions
  * \param[in]       size: Number of bytes to allocate on new memory
+ * \param[in]       tag: Subsystem tag of new allocation
  * \return          Memory address on success, `NULL` otherwise
- * \note            Function is not available when \ref LWCELL_CFG_MEM_CUSTOM is `1` and must be implemented by user
  */
 void*
-lwcell_mem_realloc(void* ptr, size_t size) {
+lwcell_mem_realloc_tag(void* ptr, size_t size, lwcell_mem_tag_t tag) {
     lwcell_core_lock();
-    ptr = mem_realloc(ptr, size); /* Reallocate and return pointer */
+    LWCELL_TRACE_HOOK(LWCELL_TRACE_MEM_ALLOC, LWCELL_TRACE_BEGIN, size);
+    ptr = mem_realloc(ptr, size, tag); /* Reallocate and return pointer */
+    LWCELL_TRACE_HOOK(LWCELL_TRACE_MEM_ALLOC, LWCELL_TRACE_END, 0);
     lwcell_core_unlock();
     LWCELL_DEBUGW(LWCELL_CFG_DBG_MEM | LWCELL_DBG_TYPE_TRACE, ptr == NULL,
                   "[LWCELL MEM] Reallocation failed: %d bytes\r\n", (int)size);
@@ -394,17 +1233,19 @@ lwcell_mem_realloc(void* ptr, size_t size) {
 }
 
 /**
- * \brief           Allocate memory of specific size and set memory to zero
+ * \brief           Allocate memory of specific size for subsystem and set memory to zero
  * \param[in]       num: Number of elements to allocate
  * \param[in]       size: Size of each element
+ * \param[in]       tag: Subsystem tag of allocation
  * \return          Memory address on success, `NULL` otherwise
- * \note            Function is not available when \ref LWCELL_CFG_MEM_CUSTOM is `1` and must be implemented by user
  */
 void*
-lwcell_mem_calloc(size_t num, size_t size) {
+lwcell_mem_calloc_tag(size_t num, size_t size, lwcell_mem_tag_t tag) {
     void* ptr;
     lwcell_core_lock();
-    ptr = mem_calloc(num, size); /* Allocate memory and clear it to 0. Then return pointer */
+    LWCELL_TRACE_HOOK(LWCELL_TRACE_MEM_ALLOC, LWCELL_TRACE_BEGIN, num * size);
+    ptr = mem_calloc(num, size, tag); /* Allocate memory and clear it to 0. Then return pointer */
+    LWCELL_TRACE_HOOK(LWCELL_TRACE_MEM_ALLOC, LWCELL_TRACE_END, 0);
     lwcell_core_unlock();
     LWCELL_DEBUGW(LWCELL_CFG_DBG_MEM | LWCELL_DBG_TYPE_TRACE, ptr == NULL,
                   "[LWCELL MEM] Callocation failed: %d bytes\r\n", (int)size * (int)num);
@@ -425,9 +1266,11 @@ lwcell_mem_free(void* ptr) {
         return;
     }
     LWCELL_DEBUGF(LWCELL_CFG_DBG_MEM | LWCELL_DBG_TYPE_TRACE, "[LWCELL MEM] Free size: %d, address: %p\r\n",
-                  (int)MEM_BLOCK_USER_SIZE(ptr), ptr);
+                  (int)MEM_TAG_USER_SIZE(ptr), ptr);
     lwcell_core_lock();
-    mem_free(ptr);
+    LWCELL_TRACE_HOOK(LWCELL_TRACE_MEM_FREE, LWCELL_TRACE_BEGIN, 0);
+    mem_free_tag(ptr);
+    LWCELL_TRACE_HOOK(LWCELL_TRACE_MEM_FREE, LWCELL_TRACE_END, 0);
     lwcell_core_unlock();
 }
 
@@ -442,10 +1285,70 @@ lwcell_mem_free(void* ptr) {
 uint8_t
 lwcell_mem_assignmemory(const lwcell_mem_region_t* regions, size_t len) {
     uint8_t ret;
+#if LWCELL_CFG_MEM_CLASSES
+    size_t cnt = 0;
+
+    for (size_t i = 0; i < len; ++i) {
+        cnt += regions[i].classes != 0;
+    }
+    if (cnt > LWCELL_ARRAYSIZE(mem_class_regions)) {
+        return 0;
+    }
+#endif                                 /* LWCELL_CFG_MEM_CLASSES */
     ret = mem_assignmem(regions, len); /* Assign memory */
+#if LWCELL_CFG_MEM_CLASSES
+    if (ret) {
+        /* Only regions limited to some classes are kept, others serve everything */
+        for (size_t i = 0; i < len; ++i) {
+            if (regions[i].classes != 0) {
+                mem_class_regions[mem_class_regions_cnt].start = regions[i].start_addr;
+                mem_class_regions[mem_class_regions_cnt].end = (const uint8_t*)regions[i].start_addr + regions[i].size;
+                mem_class_regions[mem_class_regions_cnt].classes = regions[i].classes;
+                ++mem_class_regions_cnt;
+            }
+        }
+    }
+#endif /* LWCELL_CFG_MEM_CLASSES */
     return ret;
 }
 
+/**
+ * \brief           Get allocation class of subsystem tag
+ * \param[in]       tag: Subsystem tag of allocation
+ * \return          Member of \ref lwcell_mem_class_t enumeration
+ */
+lwcell_mem_class_t
+lwcell_mem_tag_class(lwcell_mem_tag_t tag) {
+    return (size_t)tag < LWCELL_MEM_TAG_END ? (lwcell_mem_class_t)mem_tag_classes[tag] : LWCELL_MEM_CLASS_ANY;
+}
+
+/**
+ * \brief           Get memory manager statistics
+ * \note            Function walks free blocks to find largest one. Do not call it from time critical code
+ * \param[out]      stats: Pointer to structure to fill with statistics
+ * \return          `1` on success, `0` otherwise
+ * \note            Function is not available when \ref LWCELL_CFG_MEM_CUSTOM is `1`
+ */
+uint8_t
+lwcell_mem_get_stats(lwcell_mem_stats_t* stats) {
+    if (stats == NULL) {
+        return 0;
+    }
+    lwcell_core_lock();
+    stats->total_bytes = mem_total_bytes;
+    stats->available_bytes = mem_available_bytes;
+    stats->min_ever_available_bytes = mem_min_available_bytes;
+    stats->alloc_count = mem_alloc_count;
+    stats->free_count = mem_free_count;
+    stats->alloc_failed_count = mem_alloc_failed;
+    mem_free_blocks_info(&stats->largest_free_block, &stats->free_blocks);
+#if LWCELL_CFG_MEM_TAGS
+    LWCELL_MEMCPY(stats->tags, mem_tags, sizeof(stats->tags));
+#endif /* LWCELL_CFG_MEM_TAGS */
+    lwcell_core_unlock();
+    return 1;
+}
+
 #endif /* !LWCELL_CFG_MEM_CUSTOM || __DOXYGEN__ */
 
 /**
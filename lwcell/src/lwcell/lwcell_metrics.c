@@ -0,0 +1,337 @@
+/**
+ * \file            lwcell_metrics.c
+ * \brief           Metric time series
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_metrics.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_METRICS || __DOXYGEN__
+
+/* Longest encoded 32-bit varint */
+#define METRICS_VARINT_MAX 5
+
+/**
+ * \brief           Get increase of counter since previous sample
+ * \param[in]       curr: Current counter value
+ * \param[in,out]   prev_val: Counter value at previous sample, updated to current one
+ * \return          Increase, counter value when it has been reset in the meantime
+ */
+static uint32_t
+prv_metrics_delta(uint32_t curr, uint32_t* prev_val) {
+    uint32_t d = curr >= *prev_val ? curr - *prev_val : curr;
+
+    *prev_val = curr;
+    return d;
+}
+
+/**
+ * \brief           Write unsigned varint
+ * \param[out]      d: Output buffer with at least \ref METRICS_VARINT_MAX bytes
+ * \param[in]       v: Value to write
+ * \return          Number of written bytes
+ */
+static size_t
+prv_metrics_varint(uint8_t* d, uint32_t v) {
+    size_t len = 0;
+
+    for (; v >= 0x80; v >>= 7) {
+        d[len++] = (uint8_t)(v | 0x80);
+    }
+    d[len++] = (uint8_t)v;
+    return len;
+}
+
+/**
+ * \brief           Write signed value as zigzag varint
+ * \param[out]      d: Output buffer with at least \ref METRICS_VARINT_MAX bytes
+ * \param[in]       v: Value to write
+ * \return          Number of written bytes
+ */
+static size_t
+prv_metrics_zigzag(uint8_t* d, int32_t v) {
+    return prv_metrics_varint(d, ((uint32_t)v << 1) ^ (uint32_t)(v < 0 ? -1 : 0));
+}
+
+/**
+ * \brief           Decode one encoded sample from buffer and add differences to values
+ * \param[in,out]   pos: Position in buffer, set to position after sample
+ * \param[in,out]   values: Values of previous sample, updated to decoded sample
+ * \return          Number of bytes of encoded sample
+ */
+static size_t
+prv_metrics_apply(size_t* pos, int32_t* values) {
+    size_t len = 0;
+
+    for (size_t i = 0; i < LWCELL_METRICS_END; ++i) {
+        uint32_t v = 0;
+        uint8_t b, shift = 0;
+
+        do {
+            b = lwcell.metrics.buff[*pos];
+            if (++*pos == LWCELL_CFG_METRICS_BUFF_SIZE) {
+                *pos = 0;
+            }
+            ++len;
+            v |= (uint32_t)(b & 0x7F) << shift;
+            shift += 7;
+        } while ((b & 0x80) && shift < 7 * METRICS_VARINT_MAX);
+        values[i] = (int32_t)((uint32_t)values[i] + ((v >> 1) ^ (0U - (v & 1))));
+    }
+    return len;
+}
+
+/**
+ * \brief           Add new sample and drop oldest ones when buffer is full
+ * \param[in]       values: Sample values
+ */
+static void
+prv_metrics_add(const int32_t* values) {
+    uint8_t rec[LWCELL_METRICS_END * METRICS_VARINT_MAX];
+    size_t len = 0;
+
+    lwcell.metrics.last_time = lwcell_sys_now();
+    if (lwcell.metrics.count == 0) {
+        LWCELL_MEMCPY(lwcell.metrics.first, values, sizeof(lwcell.metrics.first));
+        LWCELL_MEMCPY(lwcell.metrics.last, values, sizeof(lwcell.metrics.last));
+        lwcell.metrics.count = 1;
+        return;
+    }
+    for (size_t i = 0; i < LWCELL_METRICS_END; ++i) {
+        len += prv_metrics_zigzag(&rec[len], (int32_t)((uint32_t)values[i] - (uint32_t)lwcell.metrics.last[i]));
+    }
+    while (LWCELL_CFG_METRICS_BUFF_SIZE - lwcell.metrics.used < len) {
+        /* Second sample becomes oldest one */
+        lwcell.metrics.used -= prv_metrics_apply(&lwcell.metrics.r, lwcell.metrics.first);
+        --lwcell.metrics.count;
+    }
+    for (size_t i = 0; i < len; ++i) {
+        lwcell.metrics.buff[lwcell.metrics.w] = rec[i];
+        if (++lwcell.metrics.w == LWCELL_CFG_METRICS_BUFF_SIZE) {
+            lwcell.metrics.w = 0;
+        }
+    }
+    lwcell.metrics.used += len;
+    ++lwcell.metrics.count;
+    LWCELL_MEMCPY(lwcell.metrics.last, values, sizeof(lwcell.metrics.last));
+}
+
+/**
+ * \brief           Take sample of library state
+ * \note            Function must be called with core locked
+ */
+static void
+prv_metrics_sample(void) {
+    int32_t values[LWCELL_METRICS_END] = {0};
+
+    values[LWCELL_METRICS_RSSI] = lwcell.m.rssi;
+    values[LWCELL_METRICS_NETWORK_REG] = (int32_t)lwcell.m.network.status;
+    values[LWCELL_METRICS_RX_BYTES] = (int32_t)prv_metrics_delta(lwcell.stats.rx_bytes, &lwcell.metrics.prev.rx_bytes);
+    values[LWCELL_METRICS_TX_BYTES] = (int32_t)prv_metrics_delta(lwcell.stats.tx_bytes, &lwcell.metrics.prev.tx_bytes);
+#if LWCELL_CFG_NETWORK
+    values[LWCELL_METRICS_ATTACHES] =
+        (int32_t)prv_metrics_delta(lwcell.stats.evt[LWCELL_EVT_NETWORK_ATTACHED], &lwcell.metrics.prev.attaches);
+#endif /* LWCELL_CFG_NETWORK */
+#if LWCELL_CFG_CONN
+    values[LWCELL_METRICS_CONN_OPENED] =
+        (int32_t)prv_metrics_delta(lwcell.stats.evt[LWCELL_EVT_CONN_ACTIVE], &lwcell.metrics.prev.conn_open);
+    values[LWCELL_METRICS_CONN_ERRORS] =
+        (int32_t)prv_metrics_delta(lwcell.stats.evt[LWCELL_EVT_CONN_ERROR], &lwcell.metrics.prev.conn_err);
+#endif /* LWCELL_CFG_CONN */
+#if LWCELL_CFG_STATS
+    {
+        uint32_t count, errors, turnaround;
+
+        lwcelli_stats_get_totals(&count, &errors, &turnaround);
+        count = prv_metrics_delta(count, &lwcell.metrics.prev.cmd_count);
+        turnaround = prv_metrics_delta(turnaround, &lwcell.metrics.prev.cmd_turn);
+        values[LWCELL_METRICS_CMD_ERRORS] = (int32_t)prv_metrics_delta(errors, &lwcell.metrics.prev.cmd_err);
+        values[LWCELL_METRICS_CMD_LATENCY] = count > 0 ? (int32_t)(turnaround / count) : 0;
+    }
+#endif /* LWCELL_CFG_STATS */
+    prv_metrics_add(values);
+}
+
+/**
+ * \brief           Sampling timeout callback
+ * \param[in]       arg: Custom user argument
+ */
+static void
+prv_metrics_timeout_fn(void* arg) {
+    uint32_t interval;
+
+    lwcell_core_lock();
+    prv_metrics_sample();
+    interval = lwcell.metrics.interval;
+    lwcell_core_unlock();
+
+    if (interval > 0) {
+        lwcell_timeout_start(&lwcell.metrics.timeout, interval, prv_metrics_timeout_fn, arg);
+    }
+}
+
+/**
+ * \brief           Start periodic sampling with \ref LWCELL_CFG_METRICS_INTERVAL
+ * \note            Function must be called with core locked
+ */
+void
+lwcelli_metrics_start(void) {
+    lwcell.metrics.interval = LWCELL_CFG_METRICS_INTERVAL;
+    if (lwcell.metrics.interval > 0) {
+        lwcell_timeout_start(&lwcell.metrics.timeout, lwcell.metrics.interval, prv_metrics_timeout_fn, NULL);
+    }
+}
+
+/**
+ * \brief           Set sampling interval
+ *
+ * Next sample is taken one full interval after function call
+ *
+ * \param[in]       interval: Interval in units of milliseconds. Set to `0` to stop sampling
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_metrics_set_interval(uint32_t interval) {
+    lwcell_core_lock();
+    lwcell.metrics.interval = interval;
+    if (interval > 0) {
+        lwcell_timeout_start(&lwcell.metrics.timeout, interval, prv_metrics_timeout_fn, NULL);
+    } else {
+        lwcell_timeout_stop(&lwcell.metrics.timeout);
+    }
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+/**
+ * \brief           Get number of stored samples
+ * \return          Number of samples
+ */
+size_t
+lwcell_metrics_get_count(void) {
+    size_t cnt;
+
+    lwcell_core_lock();
+    cnt = lwcell.metrics.count;
+    lwcell_core_unlock();
+    return cnt;
+}
+
+/**
+ * \brief           Get values of stored sample
+ * \param[in]       index: Sample index, `0` is the oldest one
+ * \param[out]      values: Array of \ref LWCELL_METRICS_END values, indexed by \ref lwcell_metrics_id_t
+ * \return          \ref lwcellOK on success, \ref lwcellERRPAR if sample does not exist
+ */
+lwcellr_t
+lwcell_metrics_get(size_t index, int32_t* values) {
+    lwcellr_t res = lwcellERRPAR;
+
+    LWCELL_ASSERT(values != NULL);
+
+    lwcell_core_lock();
+    if (index < lwcell.metrics.count) {
+        size_t pos = lwcell.metrics.r;
+
+        LWCELL_MEMCPY(values, lwcell.metrics.first, sizeof(lwcell.metrics.first));
+        for (size_t i = 0; i < index; ++i) {
+            prv_metrics_apply(&pos, values);
+        }
+        res = lwcellOK;
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Write all stored samples in compact format for upload
+ *
+ * Format is described in \ref LWCELL_METRICS. Samples stay stored, use \ref lwcell_metrics_clear
+ * after they have been uploaded successfully
+ *
+ * \param[out]      data: Output buffer
+ * \param[in]       btw: Size of output buffer in units of bytes
+ * \param[out]      bw: Number of written bytes. When output buffer is too small,
+ *                      it is set to required size and nothing is written
+ * \return          \ref lwcellOK on success, \ref lwcellERRMEM when output buffer is too small
+ */
+lwcellr_t
+lwcell_metrics_serialize(void* data, size_t btw, size_t* bw) {
+    uint8_t hdr[2 + 3 * METRICS_VARINT_MAX + LWCELL_METRICS_END * METRICS_VARINT_MAX];
+    uint8_t* d = data;
+    size_t len = 0, first_len;
+    lwcellr_t res = lwcellOK;
+
+    LWCELL_ASSERT(data != NULL);
+    LWCELL_ASSERT(bw != NULL);
+
+    lwcell_core_lock();
+    hdr[len++] = 1;
+    hdr[len++] = LWCELL_METRICS_END;
+    len += prv_metrics_varint(&hdr[len], lwcell.metrics.interval);
+    len += prv_metrics_varint(&hdr[len], (uint32_t)lwcell.metrics.count);
+    len += prv_metrics_varint(&hdr[len], lwcell.metrics.count > 0 ? lwcell_sys_now() - lwcell.metrics.last_time : 0);
+    for (size_t i = 0; lwcell.metrics.count > 0 && i < LWCELL_METRICS_END; ++i) {
+        len += prv_metrics_zigzag(&hdr[len], lwcell.metrics.first[i]);
+    }
+
+    *bw = len + lwcell.metrics.used;
+    if (*bw > btw) {
+        res = lwcellERRMEM;
+    } else {
+        LWCELL_MEMCPY(d, hdr, len);
+        first_len = LWCELL_MIN(lwcell.metrics.used, LWCELL_CFG_METRICS_BUFF_SIZE - lwcell.metrics.r);
+        LWCELL_MEMCPY(&d[len], &lwcell.metrics.buff[lwcell.metrics.r], first_len);
+        LWCELL_MEMCPY(&d[len + first_len], lwcell.metrics.buff, lwcell.metrics.used - first_len);
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Remove all stored samples
+ *
+ * Counter metrics of next sample still hold increase since last sample
+ *
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_metrics_clear(void) {
+    lwcell_core_lock();
+    lwcell.metrics.r = 0;
+    lwcell.metrics.w = 0;
+    lwcell.metrics.used = 0;
+    lwcell.metrics.count = 0;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_METRICS || __DOXYGEN__ */
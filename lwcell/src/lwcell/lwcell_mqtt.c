@@ -36,31 +36,179 @@
 
 #if LWCELL_CFG_MQTT || __DOXYGEN__
 
+/**
+ * \brief           Check if instance is valid and connected to server
+ * \param[in]       mi: MQTT instance
+ */
+#define MQTT_CHECK_CONNECTED(mi)                                                                                       \
+    do {                                                                                                               \
+        if ((mi) != &lwcell.m.mqtt || !(mi)->is_connected) {                                                           \
+            return lwcellCLOSED;                                                                                       \
+        }                                                                                                              \
+    } while (0)
+
+/**
+ * \brief           Check if identified device supports native MQTT commands
+ * \return          `1` if supported, `0` otherwise
+ */
+static uint8_t
+prv_device_has_mqtt(void) {
+    return LWCELL_DEV_MODEL_CAP(has_mqtt_native);
+}
+
+/**
+ * \brief           Connect to MQTT server with device native MQTT engine
+ *
+ * MQTT framing, keep-alive and retransmissions are handled by the device.
+ * \ref LWCELL_EVT_MQTT_CONNECT event is called when procedure finishes.
+ *
+ * \note            Device supports single connection, only one instance is available at a time
+ * \param[out]      instance: Pointer to output variable to save instance handle to
+ * \param[in]       desc: Connection descriptor. It must stay valid until command finishes
+ * \param[in]       evt_fn: Callback function for MQTT events.
+ *                      Set to `NULL` to use global event callback functions instead
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise.
+ *                  \ref lwcellERRNOTENABLED is returned when device has no native MQTT support
+ */
 lwcellr_t
 lwcell_mqtt_connect(lwcell_mqtt_t** instance, const lwcell_mqtt_conn_desc_t* desc, lwcell_evt_fn evt_fn,
                     const uint32_t blocking) {
-    return lwcellERRNOTENABLED;
+    lwcellr_t res = lwcellOK;
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(instance != NULL);
+    LWCELL_ASSERT(desc != NULL);
+    LWCELL_ASSERT(desc->host != NULL);
+    LWCELL_ASSERT(desc->device_id != NULL);
+    LWCELL_ASSERT(desc->port > 0);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(mqtt_connect));
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_SMCONN;
+    LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_SMCONF_URL;
+    LWCELL_MSG_VAR_REF(msg).msg.mqtt_connect.desc = desc;
+
+    /* Take single device instance */
+    lwcell_core_lock();
+    if (!prv_device_has_mqtt()) {
+        res = lwcellERRNOTENABLED;
+    } else if (lwcell.m.mqtt.in_use) {
+        res = lwcellERR;
+    } else {
+        lwcell.m.mqtt.in_use = 1;
+        lwcell.m.mqtt.evt_fn = evt_fn;
+        *instance = &lwcell.m.mqtt;
+    }
+    lwcell_core_unlock();
+    if (res != lwcellOK) {
+        LWCELL_MSG_VAR_FREE(msg);
+        return res;
+    }
+
+    if ((res = lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000)) != lwcellOK) {
+        /* Command not queued or connect failed, instance is free again */
+        lwcell_core_lock();
+        if (!lwcell.m.mqtt.is_connected) {
+            lwcell.m.mqtt.in_use = 0;
+        }
+        lwcell_core_unlock();
+    }
+    return res;
 }
 
+/**
+ * \brief           Disconnect from MQTT server
+ * \note            \ref LWCELL_EVT_MQTT_DISCONNECT event is called and instance is released
+ * \param[in]       instance: MQTT instance
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
 lwcellr_t
 lwcell_mqtt_disconnect(lwcell_mqtt_t* instance, const uint32_t blocking) {
-    return lwcellERRNOTENABLED;
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    MQTT_CHECK_CONNECTED(instance);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE_HDR);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_SMDISC;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 10000);
 }
 
+/**
+ * \brief           Subscribe to MQTT topic
+ * \note            Received messages are reported with \ref LWCELL_EVT_MQTT_RECV event.
+ *                  Message must fit single line of AT parser receive buffer, longer messages are truncated
+ * \param[in]       instance: MQTT instance
+ * \param[in]       topic: Topic to subscribe to
+ * \param[in]       qos: Quality of service, value between `0` and `2`
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
 lwcellr_t
 lwcell_mqtt_subscribe(lwcell_mqtt_t* instance, const char* topic, uint8_t qos, const uint32_t blocking) {
-    return lwcellERRNOTENABLED;
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(topic != NULL && strlen(topic) > 0);
+    MQTT_CHECK_CONNECTED(instance);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(mqtt_sub));
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_SMSUB;
+    LWCELL_MSG_VAR_REF(msg).msg.mqtt_sub.topic = topic;
+    LWCELL_MSG_VAR_REF(msg).msg.mqtt_sub.qos = LWCELL_MIN(qos, 2);
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 10000);
 }
 
+/**
+ * \brief           Unsubscribe from MQTT topic
+ * \param[in]       instance: MQTT instance
+ * \param[in]       topic: Topic to unsubscribe from
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
 lwcellr_t
 lwcell_mqtt_unsubscribe(lwcell_mqtt_t* instance, const char* topic, const uint32_t blocking) {
-    return lwcellERRNOTENABLED;
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(topic != NULL && strlen(topic) > 0);
+    MQTT_CHECK_CONNECTED(instance);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(mqtt_sub));
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_SMUNSUB;
+    LWCELL_MSG_VAR_REF(msg).msg.mqtt_sub.topic = topic;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 10000);
 }
 
+/**
+ * \brief           Publish message to MQTT topic
+ * \note            Message is published with quality of service `0` and without retain flag,
+ *                  delivery is handled by the device
+ * \param[in]       instance: MQTT instance
+ * \param[in]       topic: Topic to publish message to
+ * \param[in]       data: Message data. It must stay valid until command finishes
+ * \param[in]       data_len: Length of message data
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
 lwcellr_t
 lwcell_mqtt_publish(lwcell_mqtt_t* instance, const char* topic, const void* data, size_t data_len,
                     const uint32_t blocking) {
-    return lwcellERRNOTENABLED;
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(topic != NULL && strlen(topic) > 0);
+    LWCELL_ASSERT(data != NULL);
+    LWCELL_ASSERT(data_len > 0);
+    MQTT_CHECK_CONNECTED(instance);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(mqtt_pub));
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_SMPUB;
+    LWCELL_MSG_VAR_REF(msg).msg.mqtt_pub.topic = topic;
+    LWCELL_MSG_VAR_REF(msg).msg.mqtt_pub.data = data;
+    LWCELL_MSG_VAR_REF(msg).msg.mqtt_pub.data_len = data_len;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 10000);
 }
 
 #endif /* LWCELL_CFG_MQTT || __DOXYGEN__ */
@@ -51,7 +51,7 @@ lwcell_network_attach(const char* apn, const char* user, const char* pass, const
                       void* const evt_arg, const uint32_t blocking) {
     LWCELL_MSG_VAR_DEFINE(msg);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(network_attach));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_NETWORK_ATTACH;
 #if LWCELL_CFG_CONN
@@ -64,6 +64,91 @@ lwcell_network_attach(const char* apn, const char* user, const char* pass, const
     return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 200000);
 }
 
+#if LWCELL_CFG_NETWORK_CONTEXTS > 1 || __DOXYGEN__
+
+/**
+ * \brief           Activate additional PDP context for parallel data path
+ *
+ * Context is selected with `AT+CIPSGTXT`, activated with APN settings
+ * and default context `0` is selected again when command finishes.
+ * Connections use it when started with \ref lwcell_conn_start_ctx
+ *
+ * \note            Default context must be active with \ref lwcell_network_attach first
+ * \param[in]       ctx: PDP context number, `0` attaches default context with \ref lwcell_network_attach
+ * \param[in]       apn: APN name
+ * \param[in]       user: User name to attach. Set to `NULL` if not used
+ * \param[in]       pass: User password to attach. Set to `NULL` if not used
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_network_attach_ctx(uint8_t ctx, const char* apn, const char* user, const char* pass,
+                          const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    if (ctx == 0) {
+        return lwcell_network_attach(apn, user, pass, evt_fn, evt_arg, blocking);
+    } else if (ctx >= LWCELL_CFG_NETWORK_CONTEXTS) {
+        return lwcellERRPAR;
+    } else if (!lwcell_network_is_attached()) {
+        return lwcellERR;
+    }
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(network_attach));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_NETWORK_ATTACH;
+    LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CIPSGTXT;
+    LWCELL_MSG_VAR_REF(msg).msg.network_attach.apn = apn;
+    LWCELL_MSG_VAR_REF(msg).msg.network_attach.user = user;
+    LWCELL_MSG_VAR_REF(msg).msg.network_attach.pass = pass;
+    LWCELL_MSG_VAR_REF(msg).msg.network_attach.ctx = ctx;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 200000);
+}
+
+/**
+ * \brief           Check if PDP context is active
+ * \param[in]       ctx: PDP context number
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcell_network_is_attached_ctx(uint8_t ctx) {
+    uint8_t res = 0;
+
+    if (ctx == 0) {
+        return lwcell_network_is_attached();
+    }
+    lwcell_core_lock();
+    if (ctx < LWCELL_CFG_NETWORK_CONTEXTS) {
+        res = LWCELL_U8(lwcell.m.network.ctx[ctx - 1].is_attached);
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Copy IP address of PDP context from internal value to user variable
+ * \param[in]       ctx: PDP context number
+ * \param[out]      ip: Pointer to output IP variable
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_network_copy_ip_ctx(uint8_t ctx, lwcell_ip_t* ip) {
+    if (ctx == 0) {
+        return lwcell_network_copy_ip(ip);
+    } else if (lwcell_network_is_attached_ctx(ctx)) {
+        lwcell_core_lock();
+        LWCELL_MEMCPY(ip, &lwcell.m.network.ctx[ctx - 1].ip_addr, sizeof(*ip));
+        lwcell_core_unlock();
+        return lwcellOK;
+    }
+    return lwcellERR;
+}
+
+#endif /* LWCELL_CFG_NETWORK_CONTEXTS > 1 || __DOXYGEN__ */
+
 /**
  * \brief           Detach from network
  * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
@@ -75,7 +160,7 @@ lwcellr_t
 lwcell_network_detach(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
     LWCELL_MSG_VAR_DEFINE(msg);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE_HDR);
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_NETWORK_DETACH;
 #if LWCELL_CFG_CONN
@@ -96,7 +181,7 @@ lwcellr_t
 lwcell_network_check_status(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
     LWCELL_MSG_VAR_DEFINE(msg);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE_HDR);
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CIPSTATUS;
 
@@ -132,6 +217,267 @@ lwcell_network_is_attached(void) {
     return res;
 }
 
+#if LWCELL_CFG_NETWORK_PDP_RECOVERY || __DOXYGEN__
+
+/* Time to retry release of held sends when producer queue is full */
+#define PDP_RELEASE_RETRY_TIME 10
+
+static void prv_pdp_restart_next(void);
+
+/**
+ * \brief           Put held send requests of connections, not waiting anymore, back to producer queue
+ * \param[in]       arg: Timeout callback custom argument, not used
+ */
+static void
+prv_pdp_release(void* arg) {
+    lwcell_msg_t **m = &lwcell.pdp.hold_first, *msg;
+    lwcell_sys_mbox_t* mbox;
+
+    LWCELL_UNUSED(arg);
+    while ((msg = *m) != NULL) {
+        if (msg->msg.conn_send.conn->status.f.pdp_hold) {
+            m = &msg->msg.conn_send.pdp_hold_next; /* Connection is not restored yet */
+            continue;
+        }
+        mbox = &lwcell.mbox_producer;
+#if LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0
+        if (msg->is_prio) {
+            mbox = &lwcell.mbox_producer_prio;
+        }
+#endif /* LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0 */
+        if (!lwcell_sys_mbox_putnow(mbox, msg)) {
+            lwcell_timeout_start(&lwcell.pdp.timeout, PDP_RELEASE_RETRY_TIME, prv_pdp_release, NULL);
+            return;
+        }
+#if LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0
+        if (mbox != &lwcell.mbox_producer) {
+            lwcelli_producer_prio_wakeup(); /* Wake up producer waiting on regular queue */
+        }
+#endif /* LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0 */
+        *m = msg->msg.conn_send.pdp_hold_next;
+    }
+}
+
+/**
+ * \brief           Check if connection has held send requests
+ * \param[in]       conn: Connection handle
+ * \return          `1` if at least one send request waits, `0` otherwise
+ */
+static uint8_t
+prv_pdp_has_held(lwcell_conn_t* conn) {
+    for (lwcell_msg_t* msg = lwcell.pdp.hold_first; msg != NULL; msg = msg->msg.conn_send.pdp_hold_next) {
+        if (msg->msg.conn_send.conn == conn) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Finish recovery of single connection
+ *
+ * Held send requests continue on restored connection and fail on closed one
+ *
+ * \param[in]       conn: Connection handle
+ * \param[in]       is_ok: Set to `1` when connection is active again, `0` when it cannot be restored
+ */
+static void
+prv_pdp_conn_done(lwcell_conn_t* conn, uint8_t is_ok) {
+    if (!conn->status.f.pdp_hold) {
+        return; /* Stack has been reset meanwhile */
+    }
+    conn->status.f.pdp_hold = 0;
+    if (!is_ok) {
+        lwcelli_conn_closed_process(conn->num, 0);
+    }
+    LWCELL_DEBUGF(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE, "[LWCELL NETWORK] Connection %d %s\r\n",
+                  (int)conn->num, is_ok ? "restored" : "not restored");
+    prv_pdp_release(NULL);
+}
+
+/**
+ * \brief           Connection restart finished callback
+ * \param[in]       res: Result of command
+ * \param[in]       arg: Connection handle
+ */
+static void
+prv_pdp_restart_fn(lwcellr_t res, void* arg) {
+    prv_pdp_conn_done(arg, res == lwcellOK);
+    prv_pdp_restart_next();
+}
+
+/**
+ * \brief           Start connection again to remote address used before PDP context deactivation
+ * \param[in]       conn: Connection handle
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+prv_pdp_restart(lwcell_conn_t* conn) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, 0, LWCELL_MSG_SIZE(conn_start));
+    LWCELL_MSG_VAR_SET_EVT(msg, prv_pdp_restart_fn, conn);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CIPSTART;
+    LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CIPSTATUS;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_start.num = conn->num;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_start.type = conn->start_type;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_start.port = conn->remote_port;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_start.evt_func = conn->evt_func;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_start.arg = conn->arg;
+    LWCELL_MSG_VAR_REF(msg).msg.conn_start.restart = conn;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
+}
+
+/**
+ * \brief           Start next connection waiting for recovery
+ *
+ * Connections with held send requests go first, others follow in connection number order.
+ * Only one connection is started at a time, so held data of restored connection
+ * are sent before next connection is started
+ */
+static void
+prv_pdp_restart_next(void) {
+    lwcell_conn_t* conn;
+
+    do {
+        conn = NULL;
+        for (size_t i = 0; i < LWCELL_CFG_MAX_CONNS; ++i) {
+            if (lwcell.m.conns[i].status.f.pdp_hold) {
+                if (conn == NULL) {
+                    conn = &lwcell.m.conns[i];
+                }
+                if (prv_pdp_has_held(&lwcell.m.conns[i])) {
+                    conn = &lwcell.m.conns[i];
+                    break;
+                }
+            }
+        }
+        if (conn == NULL) {
+            lwcell.pdp.busy = 0; /* All connections are restored or closed */
+            return;
+        }
+        if (prv_pdp_restart(conn) == lwcellOK) {
+            return;
+        }
+        prv_pdp_conn_done(conn, 0);
+    } while (1);
+}
+
+/**
+ * \brief           Context reactivation finished callback
+ * \param[in]       res: Result of command
+ * \param[in]       arg: Custom user argument, not used
+ */
+static void
+prv_pdp_attach_fn(lwcellr_t res, void* arg) {
+    LWCELL_UNUSED(arg);
+    LWCELL_DEBUGF(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE, "[LWCELL NETWORK] PDP context reactivation: %d\r\n",
+                  (int)res);
+    if (res != lwcellOK) {
+        for (size_t i = 0; i < LWCELL_CFG_MAX_CONNS; ++i) {
+            prv_pdp_conn_done(&lwcell.m.conns[i], 0);
+        }
+    }
+    prv_pdp_restart_next();
+}
+
+/**
+ * \brief           PDP context has been deactivated by network
+ *
+ * Active client connections of default context are held and context is activated again.
+ * Without credentials or connections to restore, only status is updated
+ *
+ * \note            Function must be called with core locked
+ */
+void
+lwcelli_network_pdp_deact(void) {
+    lwcell_conn_t* conn;
+    uint8_t cnt = 0;
+
+    if (lwcell.pdp.busy) {
+        return; /* Reactivation is already in progress */
+    }
+    for (size_t i = 0; lwcell.pdp.apn != NULL && i < LWCELL_CFG_MAX_CONNS; ++i) {
+        conn = &lwcell.m.conns[i];
+        if (conn->status.f.active && conn->status.f.client && !conn->status.f.in_closing && !conn->status.f.bearer
+            && conn->remote_port > 0) {
+            conn->status.f.pdp_hold = 1;
+            ++cnt;
+        }
+    }
+    if (cnt > 0
+        && lwcell_network_attach(lwcell.pdp.apn, lwcell.pdp.user, lwcell.pdp.pass, prv_pdp_attach_fn, NULL, 0)
+               == lwcellOK) {
+        lwcell.pdp.busy = 1;
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE,
+                      "[LWCELL NETWORK] PDP context deactivated, restoring %d connections\r\n", (int)cnt);
+        return;
+    }
+    for (size_t i = 0; i < LWCELL_CFG_MAX_CONNS; ++i) {
+        lwcell.m.conns[i].status.f.pdp_hold = 0;
+    }
+    lwcell_network_check_status(NULL, NULL, 0); /* Update status, connections are reported closed */
+}
+
+/**
+ * \brief           Hold send request of connection waiting for recovery
+ * \note            Function must be called from producer thread with core locked
+ * \param[in]       msg: Message taken from producer queue
+ * \return          `1` when message waits for connection, `0` when it shall be started
+ */
+uint8_t
+lwcelli_network_pdp_hold(lwcell_msg_t* msg) {
+    lwcell_msg_t** m = &lwcell.pdp.hold_first;
+
+    if (msg->cmd_def != LWCELL_CMD_CIPSEND || !msg->msg.conn_send.conn->status.f.pdp_hold) {
+        return 0;
+    }
+    while (*m != NULL) {
+        m = &(*m)->msg.conn_send.pdp_hold_next;
+    }
+    msg->msg.conn_send.pdp_hold_next = NULL;
+    *m = msg;
+    return 1;
+}
+
+/**
+ * \brief           Stop recovery on stack reset, held send requests fail on closed connections
+ * \note            Function must be called with core locked
+ */
+void
+lwcelli_network_pdp_reset(void) {
+    for (size_t i = 0; i < LWCELL_CFG_MAX_CONNS; ++i) {
+        lwcell.m.conns[i].status.f.pdp_hold = 0;
+    }
+    lwcell.pdp.busy = 0;
+    prv_pdp_release(NULL);
+}
+
+/**
+ * \brief           Set credentials for PDP context reactivation and enable connection recovery
+ *
+ * When network deactivates PDP context, context is activated again with these credentials
+ * and client connections, active at that time, are started again
+ *
+ * \note            Strings are not copied and must stay valid while recovery uses them
+ * \param[in]       apn: APN domain. Set to `NULL` to disable connection recovery
+ * \param[in]       user: APN username. Set to `NULL` if not used
+ * \param[in]       pass: APN password. Set to `NULL` if not used
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_network_set_pdp_recovery(const char* apn, const char* user, const char* pass) {
+    lwcell_core_lock();
+    lwcell.pdp.apn = apn;
+    lwcell.pdp.user = user;
+    lwcell.pdp.pass = pass;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_NETWORK_PDP_RECOVERY || __DOXYGEN__ */
+
 #endif /* LWCELL_CFG_NETWORK || __DOXYGEN__ */
 
 /**
@@ -146,7 +492,7 @@ lwcellr_t
 lwcell_network_rssi(int16_t* rssi, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
     LWCELL_MSG_VAR_DEFINE(msg);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(csq));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CSQ_GET;
     LWCELL_MSG_VAR_REF(msg).msg.csq.rssi = rssi;
@@ -154,6 +500,55 @@ lwcell_network_rssi(int16_t* rssi, const lwcell_api_cmd_evt_fn evt_fn, void* con
     return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 120000);
 }
 
+/**
+ * \brief           Execute multiple status queries with single command line
+ *
+ * Queries are concatenated with `;` separator and sent as one AT command,
+ * which saves round trips to device compared to separate API calls.
+ * Each response is parsed and reported with its usual event,
+ * command fails when device rejects any of the queries.
+ *
+ * \param[in]       queries: Bit mask of \ref lwcell_query_t queries to execute
+ * \param[out]      rssi: RSSI output variable when \ref LWCELL_QUERY_RSSI is used. Set to `NULL` when not used
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_network_query_batch(uint32_t queries, int16_t* rssi, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                           const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    queries &= LWCELL_QUERY_RSSI | LWCELL_QUERY_REG_STATUS | LWCELL_QUERY_OPERATOR | LWCELL_QUERY_SIM_STATE;
+    LWCELL_ASSERT(queries != 0);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(query_batch));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_QUERY_BATCH;
+    LWCELL_MSG_VAR_REF(msg).msg.query_batch.queries = queries;
+    LWCELL_MSG_VAR_REF(msg).msg.query_batch.rssi = rssi;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 120000);
+}
+
+/**
+ * \brief           Get last known RSSI signal, without command to device
+ *
+ * Value is updated by \ref lwcell_network_rssi and by unsolicited reports,
+ * when \ref LWCELL_CFG_RSSI_URC is enabled
+ *
+ * \return          RSSI in units of `dBm`. `0` when RSSI is not known or not valid
+ */
+int16_t
+lwcell_network_rssi_cached(void) {
+    int16_t ret;
+    lwcell_core_lock();
+    ret = lwcell.m.rssi;
+    lwcell_core_unlock();
+    return ret;
+}
+
 /**
  * \brief           Get network registration status
  * \return          Member of \ref lwcell_network_reg_status_t enumeration
@@ -166,3 +561,245 @@ lwcell_network_get_reg_status(void) {
     lwcell_core_unlock();
     return ret;
 }
+
+#if LWCELL_CFG_NETWORK_PS_REG || __DOXYGEN__
+
+/**
+ * \brief           Get packet service registration status
+ *
+ * EPS (LTE) status is returned when device is registered to EPS, GPRS status otherwise
+ *
+ * \return          Member of \ref lwcell_network_reg_status_t enumeration
+ */
+lwcell_network_reg_status_t
+lwcell_network_get_ps_reg_status(void) {
+    lwcell_network_reg_status_t ret;
+    lwcell_core_lock();
+    ret = lwcell.m.network.eps_status;
+    if (ret != LWCELL_NETWORK_REG_STATUS_CONNECTED && ret != LWCELL_NETWORK_REG_STATUS_CONNECTED_ROAMING) {
+        ret = lwcell.m.network.gprs_status;
+    }
+    lwcell_core_unlock();
+    return ret;
+}
+
+/**
+ * \brief           Get serving cell location, reported with packet service registration
+ * \param[out]      area_code: Output variable for location or tracking area code. Set to `NULL` when not used
+ * \param[out]      cell_id: Output variable for cell ID. Set to `NULL` when not used
+ * \return          \ref lwcellOK on success, \ref lwcellERR when location is not known yet
+ */
+lwcellr_t
+lwcell_network_get_cell(uint32_t* area_code, uint32_t* cell_id) {
+    lwcellr_t res = lwcellERR;
+    lwcell_core_lock();
+    if (lwcell.m.network.cell_id != 0) {
+        if (area_code != NULL) {
+            *area_code = lwcell.m.network.area_code;
+        }
+        if (cell_id != NULL) {
+            *cell_id = lwcell.m.network.cell_id;
+        }
+        res = lwcellOK;
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+#endif /* LWCELL_CFG_NETWORK_PS_REG || __DOXYGEN__ */
+
+#if LWCELL_CFG_NETWORK_BAND || __DOXYGEN__
+
+/**
+ * \brief           Lock radio access technology and LTE bands
+ *
+ * Preferred mode is set with `AT+CNMP`, LTE mode with `AT+CMNB`
+ * and bands of each selected LTE mode with `AT+CBANDCFG`.
+ * Device searches network only within locked bands, which shortens network search after power-up
+ *
+ * \param[in]       rat: Radio access technologies to allow, combine \ref lwcell_network_rat_t values
+ * \param[in]       bands: LTE bands to lock. Set to `NULL` to keep current band list of device.
+ *                      Array must stay valid until command finishes
+ * \param[in]       bands_len: Number of entries in `bands` array
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_network_band_lock(lwcell_network_rat_t rat, const uint8_t* bands, size_t bands_len,
+                         const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(rat != 0);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(network_band));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_NETWORK_BAND_SET;
+    LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CNMP_SET;
+    LWCELL_MSG_VAR_REF(msg).msg.network_band.rat = rat;
+    LWCELL_MSG_VAR_REF(msg).msg.network_band.bands = bands;
+    LWCELL_MSG_VAR_REF(msg).msg.network_band.bands_len = bands_len;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 10000);
+}
+
+/**
+ * \brief           Read serving radio access technology and band with `AT+CPSI?`
+ * \param[out]      band: Output variable for serving band. Set to `NULL` when not used
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_network_band_get(lwcell_network_band_t* band, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                        const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(cpsi_get));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CPSI_GET;
+    LWCELL_MSG_VAR_REF(msg).msg.cpsi_get.band = band;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 10000);
+}
+
+/**
+ * \brief           Check if device is registered to network
+ * \return          `1` if registered, `0` otherwise
+ */
+static uint8_t
+prv_band_is_registered(void) {
+    lwcell_network_reg_status_t s = lwcell.m.network.status;
+
+#if LWCELL_CFG_NETWORK_PS_REG
+    if (s != LWCELL_NETWORK_REG_STATUS_CONNECTED && s != LWCELL_NETWORK_REG_STATUS_CONNECTED_ROAMING) {
+        s = lwcell.m.network.eps_status;
+    }
+#endif /* LWCELL_CFG_NETWORK_PS_REG */
+    return s == LWCELL_NETWORK_REG_STATUS_CONNECTED || s == LWCELL_NETWORK_REG_STATUS_CONNECTED_ROAMING;
+}
+
+/**
+ * \brief           Lock all configured technologies and bands
+ */
+static void
+prv_band_lock_wide(void) {
+    lwcell.band.narrow = 0;
+    lwcell_network_band_lock(lwcell.band.cfg->rat, lwcell.band.cfg->bands, lwcell.band.cfg->bands_len, NULL, NULL, 0);
+}
+
+/**
+ * \brief           Registration on learned band timed out, widen the search
+ * \param[in]       arg: Custom argument
+ */
+static void
+prv_band_timeout_fn(void* arg) {
+    LWCELL_UNUSED(arg);
+    if (lwcell.band.cfg != NULL && lwcell.band.narrow && !prv_band_is_registered()) {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_TYPE_TRACE,
+                      "[LWCELL BAND] Not registered on learned band, widening search\r\n");
+        prv_band_lock_wide();
+    }
+}
+
+/**
+ * \brief           Serving band read finished, persist it when changed
+ * \param[in]       res: Command result
+ * \param[in]       arg: Custom argument
+ */
+static void
+prv_band_get_evt_fn(lwcellr_t res, void* arg) {
+    LWCELL_UNUSED(arg);
+    if (res != lwcellOK || lwcell.band.cfg == NULL || lwcell.band.cfg->fn == NULL || lwcell.band.serving.band == 0
+        || !(lwcell.band.serving.rat & LWCELL_NETWORK_RAT_CATM_NBIOT)) {
+        return;
+    }
+    if (lwcell.band.serving.rat != lwcell.band.learned.rat || lwcell.band.serving.band != lwcell.band.learned.band) {
+        lwcell.band.learned = lwcell.band.serving;
+        lwcell.band.cfg->fn(&lwcell.band.learned, 1, lwcell.band.cfg->arg);
+    }
+}
+
+/**
+ * \brief           Lock learned band after reset and follow registration status
+ * \param[in]       evt: Event information
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+prv_band_evt_fn(lwcell_evt_t* evt) {
+    uint8_t registered;
+
+    if (lwcell.band.cfg == NULL) {
+        return lwcellOK;
+    }
+    if (evt->type == LWCELL_EVT_RESET) {
+        if (lwcell_evt_reset_get_result(evt) != lwcellOK) {
+            return lwcellOK;
+        }
+        lwcell.band.registered = 0;
+        LWCELL_MEMSET(&lwcell.band.learned, 0x00, sizeof(lwcell.band.learned));
+        if (lwcell.band.cfg->fn != NULL && lwcell.band.cfg->fn(&lwcell.band.learned, 0, lwcell.band.cfg->arg)
+            && lwcell.band.learned.band != 0
+            && (lwcell.band.learned.rat == LWCELL_NETWORK_RAT_CATM
+                || lwcell.band.learned.rat == LWCELL_NETWORK_RAT_NBIOT)) {
+            LWCELL_DEBUGF(LWCELL_CFG_DBG_INIT | LWCELL_DBG_TYPE_TRACE, "[LWCELL BAND] Locking learned band %u\r\n",
+                          (unsigned)lwcell.band.learned.band);
+            lwcell.band.narrow = 1;
+            lwcell_network_band_lock(lwcell.band.learned.rat, &lwcell.band.learned.band, 1, NULL, NULL, 0);
+            lwcell_timeout_start(&lwcell.band.timeout, lwcell.band.cfg->timeout, prv_band_timeout_fn, NULL);
+        } else {
+            prv_band_lock_wide();
+        }
+        return lwcellOK;
+    }
+
+    /* Registration status changed, react on change only */
+    registered = prv_band_is_registered();
+    if (registered == lwcell.band.registered) {
+        return lwcellOK;
+    }
+    lwcell.band.registered = registered;
+    if (registered) {
+        lwcell_timeout_stop(&lwcell.band.timeout);
+        lwcell_network_band_get(&lwcell.band.serving, prv_band_get_evt_fn, NULL, 0);
+    } else if (lwcell.band.narrow) {
+        lwcell_timeout_start(&lwcell.band.timeout, lwcell.band.cfg->timeout, prv_band_timeout_fn, NULL);
+    }
+    return lwcellOK;
+}
+
+/**
+ * \brief           Set band lock manager
+ *
+ * At the end of every reset sequence, band of last successful registration is loaded with callback
+ * and device is locked to it. When device does not register within configured timeout,
+ * search widens to all configured technologies and bands.
+ * Serving band is read on every registration and stored with callback when it changes.
+ * Without learned band, all configured technologies and bands are locked immediately
+ *
+ * \param[in]       cfg: Manager configuration, must stay valid while manager is set.
+ *                      Set to `NULL` to disable the manager
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_network_band_set_manager(const lwcell_network_band_cfg_t* cfg) {
+    lwcell_core_lock();
+    lwcell.band.cfg = cfg;
+    lwcell.band.narrow = 0;
+    lwcell_core_unlock();
+    lwcell_timeout_stop(&lwcell.band.timeout);
+    if (cfg != NULL) {
+        /* Function may already be registered from previous call */
+        lwcell_evt_register_ex(prv_band_evt_fn, LWCELL_EVT_MASK(LWCELL_EVT_RESET)
+                                                    | LWCELL_EVT_MASK(LWCELL_EVT_NETWORK_REG_CHANGED)
+#if LWCELL_CFG_NETWORK_PS_REG
+                                                    | LWCELL_EVT_MASK(LWCELL_EVT_NETWORK_PS_REG_CHANGED)
+#endif /* LWCELL_CFG_NETWORK_PS_REG */
+        );
+    }
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_NETWORK_BAND || __DOXYGEN__ */
@@ -47,7 +47,7 @@ lwcell_operator_get(lwcell_operator_curr_t* curr, const lwcell_api_cmd_evt_fn ev
                     const uint32_t blocking) {
     LWCELL_MSG_VAR_DEFINE(msg);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(cops_get));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_COPS_GET;
     LWCELL_MSG_VAR_REF(msg).msg.cops_get.curr = curr;
@@ -78,7 +78,7 @@ lwcell_operator_set(lwcell_operator_mode_t mode, lwcell_operator_format_t format
         }
     }
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(cops_set));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_COPS_SET;
 
@@ -87,7 +87,8 @@ lwcell_operator_set(lwcell_operator_mode_t mode, lwcell_operator_format_t format
     LWCELL_MSG_VAR_REF(msg).msg.cops_set.name = name;
     LWCELL_MSG_VAR_REF(msg).msg.cops_set.num = num;
 
-    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 2000);
+    /* Manual selection replies once registration attempt finishes */
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 120000);
 }
 
 /**
@@ -103,18 +104,66 @@ lwcell_operator_set(lwcell_operator_mode_t mode, lwcell_operator_format_t format
 lwcellr_t
 lwcell_operator_scan(lwcell_operator_t* ops, size_t opsl, size_t* opf, const lwcell_api_cmd_evt_fn evt_fn,
                      void* const evt_arg, const uint32_t blocking) {
+    return lwcell_operator_scan_ex(ops, opsl, opf, 0, evt_fn, evt_arg, blocking);
+}
+
+/**
+ * \brief           Scan for available operators, with streaming and early stop support
+ *
+ * Every operator is reported with \ref LWCELL_EVT_OPERATOR_SCAN_ENTRY event as soon as it is parsed.
+ * Operators array is optional when application uses entry events only.
+ *
+ * \param[in]       ops: Pointer to array to write found operators. Set to `NULL` when not used
+ * \param[in]       opsl: Length of input array in units of elements
+ * \param[out]      opf: Pointer to ouput variable to save number of operators written to array
+ * \param[in]       stop_num: Numeric value of preferred operator (PLMN).
+ *                      Remaining response is ignored once this operator is parsed. Set to `0` to parse all entries
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_operator_scan_ex(lwcell_operator_t* ops, size_t opsl, size_t* opf, uint32_t stop_num,
+                        const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
     LWCELL_MSG_VAR_DEFINE(msg);
 
     if (opf != NULL) {
         *opf = 0;
     }
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(cops_scan));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_COPS_GET_OPT;
     LWCELL_MSG_VAR_REF(msg).msg.cops_scan.ops = ops;
     LWCELL_MSG_VAR_REF(msg).msg.cops_scan.opsl = opsl;
     LWCELL_MSG_VAR_REF(msg).msg.cops_scan.opf = opf;
+    LWCELL_MSG_VAR_REF(msg).msg.cops_scan.stop_num = stop_num;
 
     return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 120000);
 }
+
+#if LWCELL_CFG_OPERATOR_CACHE || __DOXYGEN__
+
+/**
+ * \brief           Set callback function to load and store cached operator
+ *
+ * Operator is loaded at the end of reset sequence and selected with manual mode and automatic fallback.
+ * Operator is stored when device registers to network with different operator.
+ * Function is called from processing thread
+ *
+ * \param[in]       fn: Callback function. Set to `NULL` to use automatic network selection
+ * \param[in]       arg: Custom argument for callback function
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_operator_set_cache_fn(lwcell_operator_cache_fn fn, void* arg) {
+    lwcell_core_lock();
+    lwcell.operator_cache_fn = fn;
+    lwcell.operator_cache_arg = arg;
+    lwcell.operator_cache_num = 0;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_OPERATOR_CACHE || __DOXYGEN__ */
@@ -34,6 +34,194 @@
 #include "lwcell/lwcell_parser.h"
 #include "lwcell/lwcell_private.h"
 
+/* Character classes for field tokenizer */
+#define CCLS_DIGIT 0x01 /*!< Decimal digit */
+#define CCLS_HEX   0x02 /*!< Hexadecimal digit */
+#define CCLS_SEP   0x04 /*!< Field separator */
+#define CCLS_QUOTE 0x08 /*!< Quote character */
+#define CCLS_EOL   0x10 /*!< End of line or string */
+#define CCLS_SPACE 0x20 /*!< Space character */
+#define CCLS_NUM   (CCLS_DIGIT | CCLS_HEX)
+#define CCLS(ch)   (char_cls[(uint8_t)(ch)])
+
+/* Character classification table, one lookup per character */
+static const uint8_t char_cls[256] = {
+    ['\0'] = CCLS_EOL, ['\r'] = CCLS_EOL, ['\n'] = CCLS_EOL, [' '] = CCLS_SPACE, [','] = CCLS_SEP, ['"'] = CCLS_QUOTE,
+    ['0'] = CCLS_NUM,  ['1'] = CCLS_NUM,  ['2'] = CCLS_NUM,  ['3'] = CCLS_NUM,   ['4'] = CCLS_NUM, ['5'] = CCLS_NUM,
+    ['6'] = CCLS_NUM,  ['7'] = CCLS_NUM,  ['8'] = CCLS_NUM,  ['9'] = CCLS_NUM,   ['a'] = CCLS_HEX, ['b'] = CCLS_HEX,
+    ['c'] = CCLS_HEX,  ['d'] = CCLS_HEX,  ['e'] = CCLS_HEX,  ['f'] = CCLS_HEX,   ['A'] = CCLS_HEX, ['B'] = CCLS_HEX,
+    ['C'] = CCLS_HEX,  ['D'] = CCLS_HEX,  ['E'] = CCLS_HEX,  ['F'] = CCLS_HEX,
+};
+
+/**
+ * \brief           Split comma separated response line to fields in single pass
+ *
+ * Quotes are removed from quoted fields, separators inside quotes do not split the field.
+ * Splitting stops at end of line, or when \ref LWCELLI_FIELDS_MAX fields are found
+ *
+ * \param[out]      f: Fields output
+ * \param[in]       str: Input string, starting with first field (command prefix already skipped)
+ * \return          Number of fields
+ */
+size_t
+lwcelli_fields_split(lwcelli_fields_t* f, const char* str) {
+    const char* p = str;
+
+    f->cnt = 0;
+    while (f->cnt < LWCELLI_FIELDS_MAX) {
+        lwcelli_field_t* fld = &f->fld[f->cnt++];
+
+        while (CCLS(*p) & CCLS_SPACE) { /* Skip leading spaces */
+            ++p;
+        }
+        if (CCLS(*p) & CCLS_QUOTE) { /* Quoted field ends with closing quote */
+            fld->p = ++p;
+            while (!(CCLS(*p) & (CCLS_QUOTE | CCLS_EOL))) {
+                ++p;
+            }
+            fld->len = p - fld->p;
+            while (!(CCLS(*p) & (CCLS_SEP | CCLS_EOL))) { /* Skip closing quote */
+                ++p;
+            }
+        } else { /* Unquoted field ends with separator */
+            fld->p = p;
+            while (!(CCLS(*p) & (CCLS_SEP | CCLS_EOL))) {
+                ++p;
+            }
+            fld->len = p - fld->p;
+        }
+        if (!(CCLS(*p) & CCLS_SEP)) {
+            break;
+        }
+        ++p; /* Skip separator */
+    }
+    return f->cnt;
+}
+
+/**
+ * \brief           Get field as signed decimal number
+ * \param[in]       f: Fields
+ * \param[in]       idx: Field index
+ * \return          Parsed number, `0` if field does not exist
+ */
+int32_t
+lwcelli_fields_get_int(const lwcelli_fields_t* f, size_t idx) {
+    const char *p, *end;
+    int32_t val = 0;
+    uint8_t minus = 0;
+
+    if (idx >= f->cnt) {
+        return 0;
+    }
+    p = f->fld[idx].p;
+    end = p + f->fld[idx].len;
+    if (p < end && (*p == '+' || *p == '-')) {
+        minus = *p == '-';
+        ++p;
+    }
+    for (; p < end && (CCLS(*p) & CCLS_DIGIT); ++p) {
+        val = val * 10 + LWCELL_CHARTONUM(*p);
+    }
+    return minus ? -val : val;
+}
+
+/**
+ * \brief           Get field as hexadecimal number
+ * \param[in]       f: Fields
+ * \param[in]       idx: Field index
+ * \return          Parsed number, `0` if field does not exist
+ */
+uint32_t
+lwcelli_fields_get_hex(const lwcelli_fields_t* f, size_t idx) {
+    const char *p, *end;
+    uint32_t val = 0;
+
+    if (idx >= f->cnt) {
+        return 0;
+    }
+    p = f->fld[idx].p;
+    end = p + f->fld[idx].len;
+    for (; p < end && (CCLS(*p) & CCLS_HEX); ++p) {
+        val = val * 16 + LWCELL_CHARHEXTONUM(*p);
+    }
+    return val;
+}
+
+/**
+ * \brief           Get field as IPv4 address in `a.b.c.d` format
+ * \param[in]       f: Fields
+ * \param[in]       idx: Field index
+ * \param[out]      ip: IP address output, changed only on success
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_fields_get_ip(const lwcelli_fields_t* f, size_t idx, lwcell_ip_t* ip) {
+    const char *p, *end;
+    uint16_t oct[4] = {0};
+    size_t i = 0;
+
+    if (idx >= f->cnt) {
+        return 0;
+    }
+    p = f->fld[idx].p;
+    end = p + f->fld[idx].len;
+    if (p == end || !(CCLS(*p) & CCLS_DIGIT)) {
+        return 0;
+    }
+    for (; p < end && i < LWCELL_ARRAYSIZE(oct); ++p) {
+        if (CCLS(*p) & CCLS_DIGIT) {
+            oct[i] = oct[i] * 10 + LWCELL_CHARTONUM(*p);
+        } else if (*p == '.') {
+            ++i;
+        } else {
+            break;
+        }
+    }
+    if (i != LWCELL_ARRAYSIZE(oct) - 1) {
+        return 0;
+    }
+    for (i = 0; i < LWCELL_ARRAYSIZE(oct); ++i) {
+        ip->ip[i] = LWCELL_U8(oct[i]);
+    }
+    return 1;
+}
+
+/**
+ * \brief           Copy field as `NULL` terminated string
+ * \param[in]       f: Fields
+ * \param[in]       idx: Field index
+ * \param[out]      dst: Destination memory
+ * \param[in]       dst_len: Length of destination memory, including memory for `NULL` termination
+ * \return          Number of copied characters, excluding `NULL` termination
+ */
+size_t
+lwcelli_fields_get_str(const lwcelli_fields_t* f, size_t idx, char* dst, size_t dst_len) {
+    size_t len = 0;
+
+    if (dst_len == 0) {
+        return 0;
+    }
+    if (idx < f->cnt) {
+        len = LWCELL_MIN(f->fld[idx].len, dst_len - 1);
+        LWCELL_MEMCPY(dst, f->fld[idx].p, len);
+    }
+    dst[len] = '\0';
+    return len;
+}
+
+/**
+ * \brief           Compare field with string, without copying it
+ * \param[in]       f: Fields
+ * \param[in]       idx: Field index
+ * \param[in]       str: String to compare field with
+ * \return          `1` if field equals string, `0` otherwise
+ */
+uint8_t
+lwcelli_fields_is(const lwcelli_fields_t* f, size_t idx, const char* str) {
+    size_t len = strlen(str);
+    return idx < f->cnt && f->fld[idx].len == len && !strncmp(f->fld[idx].p, str, len);
+}
+
 /**
  * \brief           Parse number from string
  * \note            Input string pointer is changed and number is skipped
@@ -313,14 +501,14 @@ lwcelli_parse_memories_string(const char** src, uint32_t* mem_dst) {
  */
 uint8_t
 lwcelli_parse_creg(const char* str, uint8_t skip_first) {
+    lwcelli_fields_t fields;
+
     if (*str == '+') {
         str += 7;
     }
 
-    if (skip_first) {
-        lwcelli_parse_number(&str);
-    }
-    lwcell.m.network.status = (lwcell_network_reg_status_t)lwcelli_parse_number(&str);
+    lwcelli_fields_split(&fields, str);
+    lwcell.m.network.status = (lwcell_network_reg_status_t)lwcelli_fields_get_int(&fields, skip_first ? 1 : 0);
 
     /*
      * In case we are connected to network,
@@ -343,28 +531,102 @@ lwcelli_parse_creg(const char* str, uint8_t skip_first) {
     return 1;
 }
 
+#if LWCELL_CFG_NETWORK_PS_REG || __DOXYGEN__
+
+/**
+ * \brief           Status if registration status means device is registered
+ * \param[in]       s: Registration status
+ */
+#define PS_REG_IS_CONNECTED(s)                                                                                         \
+    ((s) == LWCELL_NETWORK_REG_STATUS_CONNECTED || (s) == LWCELL_NETWORK_REG_STATUS_CONNECTED_ROAMING)
+
+/**
+ * \brief           Parse received +CGREG or +CEREG packet service registration message
+ * \param[in]       str: Input string to parse from
+ * \param[in]       skip_first: Set to `1` to skip first number
+ * \return          1 on success, 0 otherwise
+ */
+uint8_t
+lwcelli_parse_ps_reg(const char* str, uint8_t skip_first) {
+    lwcelli_fields_t fields;
+    lwcell_network_reg_status_t status;
+    uint8_t is_eps = 0, was_connected;
+
+    if (*str == '+') {
+        is_eps = str[2] == 'E';
+        str += 8;
+    }
+
+    lwcelli_fields_split(&fields, str);
+    status = (lwcell_network_reg_status_t)lwcelli_fields_get_int(&fields, skip_first ? 1 : 0);
+    was_connected = PS_REG_IS_CONNECTED(lwcell.m.network.gprs_status)
+                    || PS_REG_IS_CONNECTED(lwcell.m.network.eps_status);
+    if (is_eps) {
+        lwcell.m.network.eps_status = status;
+    } else {
+        lwcell.m.network.gprs_status = status;
+    }
+
+    /* Location is reported with registered status only, area code and cell ID as hexadecimal strings */
+    if (fields.cnt > (skip_first ? 3U : 2U)) {
+        lwcell.m.network.area_code = lwcelli_fields_get_hex(&fields, skip_first ? 2 : 1);
+        lwcell.m.network.cell_id = lwcelli_fields_get_hex(&fields, skip_first ? 3 : 2);
+    }
+
+#if LWCELL_CFG_NETWORK
+    /* Packet service lost while PDP context is active */
+    if (was_connected && !PS_REG_IS_CONNECTED(lwcell.m.network.gprs_status)
+        && !PS_REG_IS_CONNECTED(lwcell.m.network.eps_status) && lwcell_network_is_attached()) {
+        lwcell_network_check_status(NULL, NULL, 0); /* Do the update */
+    }
+#endif /* LWCELL_CFG_NETWORK */
+    LWCELL_UNUSED(was_connected);
+
+    /* Send callback event */
+    lwcelli_send_cb(LWCELL_EVT_NETWORK_PS_REG_CHANGED);
+
+    return 1;
+}
+
+#endif /* LWCELL_CFG_NETWORK_PS_REG || __DOXYGEN__ */
+
 /**
- * \brief           Parse received +CSQ signal value
+ * \brief           Parse received +CSQ signal value or +CSQN unsolicited report
  * \param[in]       str: Input string
  * \return          1 on success, 0 otherwise
  */
 uint8_t
 lwcelli_parse_csq(const char* str) {
+    lwcelli_fields_t fields;
     int16_t rssi;
     if (*str == '+') {
-        str += 6;
+        str += str[4] == 'N' ? 7 : 6;
     }
 
-    rssi = lwcelli_parse_number(&str);
+    lwcelli_fields_split(&fields, str);
+    rssi = lwcelli_fields_get_int(&fields, 0);
     if (rssi < 32) {
         rssi = -(113 - (rssi * 2));
     } else {
         rssi = 0;
     }
     lwcell.m.rssi = rssi;                 /* Save RSSI to global variable */
-    if (lwcell.msg->cmd_def == LWCELL_CMD_CSQ_GET && lwcell.msg->msg.csq.rssi != NULL) {
+    if (CMD_IS_DEF(LWCELL_CMD_CSQ_GET) && lwcell.msg->msg.csq.rssi != NULL) {
         *lwcell.msg->msg.csq.rssi = rssi; /* Save to user variable */
+    } else if (CMD_IS_DEF(LWCELL_CMD_QUERY_BATCH) && lwcell.msg->msg.query_batch.rssi != NULL) {
+        *lwcell.msg->msg.query_batch.rssi = rssi;
+    }
+
+#if LWCELL_CFG_RSSI_HYSTERESIS > 0
+    /* Unsolicited update is reported when validity changed or change is above threshold */
+    if (!CMD_IS_DEF(LWCELL_CMD_CSQ_GET) && !CMD_IS_DEF(LWCELL_CMD_QUERY_BATCH)
+        && (rssi == 0) == (lwcell.m.rssi_evt == 0)
+        && (rssi > lwcell.m.rssi_evt ? rssi - lwcell.m.rssi_evt : lwcell.m.rssi_evt - rssi)
+               < LWCELL_CFG_RSSI_HYSTERESIS) {
+        return 1;
     }
+    lwcell.m.rssi_evt = rssi;
+#endif /* LWCELL_CFG_RSSI_HYSTERESIS > 0 */
 
     /* Report CSQ status */
     lwcell.evt.evt.rssi.rssi = rssi;
@@ -407,6 +669,7 @@ lwcelli_parse_cpin(const char* str, uint8_t send_evt) {
          * start with basic info about SIM
          */
         if (lwcell.m.sim.state == LWCELL_SIM_STATE_READY) {
+            lwcell.m.sim.info_tries = 0;
             lwcelli_get_sim_info(0);
         }
 
@@ -452,6 +715,18 @@ lwcelli_parse_cops(const char* str) {
         lwcell.m.network.curr_operator.format = LWCELL_OPERATOR_FORMAT_INVALID;
     }
 
+#if LWCELL_CFG_OPERATOR_CACHE
+    /* Persist operator of successful registration, for fast selection after reset */
+    if (lwcell.operator_cache_fn != NULL && lwcell.m.network.curr_operator.format == LWCELL_OPERATOR_FORMAT_NUMBER
+        && lwcell.m.network.curr_operator.data.num != 0
+        && lwcell.m.network.curr_operator.data.num != lwcell.operator_cache_num
+        && (lwcell.m.network.status == LWCELL_NETWORK_REG_STATUS_CONNECTED
+            || lwcell.m.network.status == LWCELL_NETWORK_REG_STATUS_CONNECTED_ROAMING)) {
+        lwcell.operator_cache_num = lwcell.m.network.curr_operator.data.num;
+        lwcell.operator_cache_fn(&lwcell.operator_cache_num, 1, lwcell.operator_cache_arg);
+    }
+#endif /* LWCELL_CFG_OPERATOR_CACHE */
+
     if (CMD_IS_DEF(LWCELL_CMD_COPS_GET)
         && lwcell.msg->msg.cops_get.curr != NULL) { /* Check and copy to user variable */
         LWCELL_MEMCPY(lwcell.msg->msg.cops_get.curr, &lwcell.m.network.curr_operator,
@@ -460,8 +735,51 @@ lwcelli_parse_cops(const char* str) {
     return 1;
 }
 
+#if LWCELL_CFG_NETWORK_BAND || __DOXYGEN__
+
+/**
+ * \brief           Parse +CPSI serving cell system information
+ *
+ * Only system mode and E-UTRAN band are parsed, `EUTRAN-BAND` field position differs between modes
+ *
+ * \param[in]       str: Input string
+ * \return          1 on success, 0 otherwise
+ */
+uint8_t
+lwcelli_parse_cpsi(const char* str) {
+    lwcell_network_band_t band = {0};
+    const char* p;
+
+    if (*str == '+') {
+        str += 7;
+    }
+    if (!strncmp(str, "LTE CAT-M", 9)) {
+        band.rat = LWCELL_NETWORK_RAT_CATM;
+    } else if (!strncmp(str, "LTE NB-IOT", 10)) {
+        band.rat = LWCELL_NETWORK_RAT_NBIOT;
+    } else if (!strncmp(str, "GSM", 3)) {
+        band.rat = LWCELL_NETWORK_RAT_GSM;
+    }
+    if ((band.rat & LWCELL_NETWORK_RAT_CATM_NBIOT) && (p = strstr(str, "EUTRAN-BAND")) != NULL) {
+        p += 11;
+        band.band = LWCELL_U8(lwcelli_parse_number(&p));
+    }
+    lwcell.m.network.band = band;
+
+    if (CMD_IS_DEF(LWCELL_CMD_CPSI_GET) && lwcell.msg->msg.cpsi_get.band != NULL) {
+        *lwcell.msg->msg.cpsi_get.band = band;
+    }
+    return 1;
+}
+
+#endif /* LWCELL_CFG_NETWORK_BAND || __DOXYGEN__ */
+
 /**
  * \brief           Parse +COPS received statement byte by byte
+ *
+ * Every operator is reported with \ref LWCELL_EVT_OPERATOR_SCAN_ENTRY event as soon as its entry is parsed,
+ * and copied to user array if there is space available
+ *
  * \note            Command must be active and message set to use this function
  * \param[in]       ch: New character to parse
  * \param[in]       reset: Flag to reset state machine
@@ -469,71 +787,82 @@ lwcelli_parse_cops(const char* str) {
  */
 uint8_t
 lwcelli_parse_cops_scan(uint8_t ch, uint8_t reset) {
-    static union {
-        struct {
-            uint8_t bo  : 1; /*!< Bracket open flag (Bracket Open) */
-            uint8_t ccd : 1; /*!< 2 consecutive commas detected in a row (Comma Comma Detected) */
-            uint8_t tn  : 2; /*!< Term number in response, 2 bits for 4 diff values */
-            uint8_t tp;      /*!< Current term character position */
-            uint8_t ch_prev; /*!< Previous character */
-        } f;
-    } u;
-
-    if (reset) {                            /* Check for reset status */
-        LWCELL_MEMSET(&u, 0x00, sizeof(u)); /* Reset everything */
-        u.f.ch_prev = 0;
+    lwcell_cops_scan_t* c = &lwcell.parser.cops;
+
+    if (reset) {                                  /* Check for reset status */
+        LWCELL_MEMSET(&c->u, 0x00, sizeof(c->u)); /* Reset everything */
+        LWCELL_MEMSET(&c->op, 0x00, sizeof(c->op));
+        c->u.f.ch_prev = 0;
+        c->op_idx = 0;
         return 1;
     }
 
-    if (u.f.ch_prev == 0) {     /* Check if this is first character */
-        if (ch == ' ') {        /* Skip leading spaces */
+    if (c->u.f.ch_prev == 0) { /* Check if this is first character */
+        if (ch == ' ') {       /* Skip leading spaces */
             return 1;
         } else if (ch == ',') { /* If first character is comma, no operators available */
-            u.f.ccd = 1;        /* Fake double commas in a row */
+            c->u.f.ccd = 1;     /* Fake double commas in a row */
         }
     }
 
-    if (u.f.ccd ||                                                          /* Ignore data after 2 commas in a row */
-        lwcell.msg->msg.cops_scan.opsi >= lwcell.msg->msg.cops_scan.opsl) { /* or if array is full */
+    if (c->u.f.ccd) { /* Ignore data after 2 commas in a row or after scan has been stopped */
         return 1;
     }
 
-    if (u.f.bo) {                             /* Bracket already open */
-        if (ch == ')') {                      /* Close bracket check */
-            u.f.bo = 0;                       /* Clear bracket open flag */
-            u.f.tn = 0;                       /* Go to next term */
-            u.f.tp = 0;                       /* Go to beginning of next term */
-            ++lwcell.msg->msg.cops_scan.opsi; /* Increase index */
-            if (lwcell.msg->msg.cops_scan.opf != NULL) {
-                *lwcell.msg->msg.cops_scan.opf = lwcell.msg->msg.cops_scan.opsi;
+    if (c->u.f.bo) {     /* Bracket already open */
+        if (ch == ')') { /* Close bracket check */
+            size_t i = lwcell.msg->msg.cops_scan.opsi;
+
+            c->u.f.bo = 0; /* Clear bracket open flag */
+            c->u.f.tn = 0; /* Go to next term */
+            c->u.f.tp = 0; /* Go to beginning of next term */
+
+            /* Copy to user array when there is space available */
+            if (lwcell.msg->msg.cops_scan.ops != NULL && i < lwcell.msg->msg.cops_scan.opsl) {
+                LWCELL_MEMCPY(&lwcell.msg->msg.cops_scan.ops[i], &c->op, sizeof(c->op));
+                ++lwcell.msg->msg.cops_scan.opsi; /* Increase index */
+                if (lwcell.msg->msg.cops_scan.opf != NULL) {
+                    *lwcell.msg->msg.cops_scan.opf = lwcell.msg->msg.cops_scan.opsi;
+                }
+            }
+
+            /* Stream entry to application */
+            lwcell.evt.evt.operator_scan_entry.op = &c->op;
+            lwcell.evt.evt.operator_scan_entry.index = c->op_idx++;
+            lwcelli_send_cb(LWCELL_EVT_OPERATOR_SCAN_ENTRY);
+
+            /* Stop on preferred operator, or if array is full and there is nobody to stream to */
+            if ((lwcell.msg->msg.cops_scan.stop_num > 0 && c->op.num == lwcell.msg->msg.cops_scan.stop_num)
+                || (lwcell.msg->msg.cops_scan.opsi >= lwcell.msg->msg.cops_scan.opsl
+                    && !(lwcell.evt_mask & LWCELL_EVT_MASK(LWCELL_EVT_OPERATOR_SCAN_ENTRY)))) {
+                c->u.f.ccd = 1;
             }
+            LWCELL_MEMSET(&c->op, 0x00, sizeof(c->op));
         } else if (ch == ',') {
-            ++u.f.tn;           /* Go to next term */
-            u.f.tp = 0;         /* Go to beginning of next term */
+            ++c->u.f.tn;        /* Go to next term */
+            c->u.f.tp = 0;      /* Go to beginning of next term */
         } else if (ch != '"') { /* We have valid data */
-            size_t i = lwcell.msg->msg.cops_scan.opsi;
-            switch (u.f.tn) {
+            switch (c->u.f.tn) {
                 case 0: { /* Parse status info */
-                    lwcell.msg->msg.cops_scan.ops[i].stat =
-                        (lwcell_operator_status_t)(10 * (size_t)lwcell.msg->msg.cops_scan.ops[i].stat + (ch - '0'));
+                    c->op.stat = (lwcell_operator_status_t)(10 * (size_t)c->op.stat + (ch - '0'));
                     break;
                 }
                 case 1: { /*!< Parse long name */
-                    if (u.f.tp < sizeof(lwcell.msg->msg.cops_scan.ops[i].long_name) - 1) {
-                        lwcell.msg->msg.cops_scan.ops[i].long_name[u.f.tp] = ch;
-                        lwcell.msg->msg.cops_scan.ops[i].long_name[++u.f.tp] = 0;
+                    if (c->u.f.tp < sizeof(c->op.long_name) - 1) {
+                        c->op.long_name[c->u.f.tp] = ch;
+                        c->op.long_name[++c->u.f.tp] = 0;
                     }
                     break;
                 }
                 case 2: { /*!< Parse short name */
-                    if (u.f.tp < sizeof(lwcell.msg->msg.cops_scan.ops[i].short_name) - 1) {
-                        lwcell.msg->msg.cops_scan.ops[i].short_name[u.f.tp] = ch;
-                        lwcell.msg->msg.cops_scan.ops[i].short_name[++u.f.tp] = 0;
+                    if (c->u.f.tp < sizeof(c->op.short_name) - 1) {
+                        c->op.short_name[c->u.f.tp] = ch;
+                        c->op.short_name[++c->u.f.tp] = 0;
                     }
                     break;
                 }
                 case 3: { /*!< Parse number */
-                    lwcell.msg->msg.cops_scan.ops[i].num = (10 * lwcell.msg->msg.cops_scan.ops[i].num) + (ch - '0');
+                    c->op.num = (10 * c->op.num) + (ch - '0');
                     break;
                 }
                 default: break;
@@ -541,12 +870,12 @@ lwcelli_parse_cops_scan(uint8_t ch, uint8_t reset) {
         }
     } else {
         if (ch == '(') { /* Check for opening bracket */
-            u.f.bo = 1;
-        } else if (ch == ',' && u.f.ch_prev == ',') {
-            u.f.ccd = 1; /* 2 commas in a row */
+            c->u.f.bo = 1;
+        } else if (ch == ',' && c->u.f.ch_prev == ',') {
+            c->u.f.ccd = 1; /* 2 commas in a row */
         }
     }
-    u.f.ch_prev = ch;
+    c->u.f.ch_prev = ch;
     return 1;
 }
 
@@ -571,17 +900,45 @@ lwcelli_parse_datetime(const char** src, struct tm* dt) {
 
 #if LWCELL_CFG_CALL || __DOXYGEN__
 
+/**
+ * \brief           Resolve caller name from phonebook mirror when device did not report it
+ */
+static void
+prv_call_name_resolve(void) {
+#if LWCELL_CFG_PHONEBOOK_MIRROR
+    if (lwcell.m.call.name[0] == '\0') {
+        const lwcell_pb_entry_t* e = lwcelli_pb_mirror_lookup(lwcell.m.call.number);
+
+        if (e != NULL) {
+            LWCELL_MEMCPY(lwcell.m.call.name, e->name, LWCELL_MIN(sizeof(lwcell.m.call.name), sizeof(e->name)));
+            lwcell.m.call.name[sizeof(lwcell.m.call.name) - 1] = '\0';
+        }
+    }
+#endif /* LWCELL_CFG_PHONEBOOK_MIRROR */
+}
+
 /**
  * \brief           Parse received +CLCC with call status info
+ *
+ * Event is sent only when call state changes,
+ * repeated reports for the same call state are collapsed
+ *
  * \param[in]       str: Input string
- * \param[in]       send_evt: Send event about new CPIN status
+ * \param[in]       send_evt: Send event about new call status
  * \return          1 on success, 0 otherwise
  */
 uint8_t
 lwcelli_parse_clcc(const char* str, uint8_t send_evt) {
+    uint8_t id = lwcell.m.call.id;
+    lwcell_call_dir_t dir = lwcell.m.call.dir;
+    lwcell_call_state_t state = lwcell.m.call.state;
+    char number[sizeof(lwcell.m.call.number)], name[sizeof(lwcell.m.call.name)];
+
     if (*str == '+') {
         str += 7;
     }
+    LWCELL_MEMCPY(number, lwcell.m.call.number, sizeof(number));
+    LWCELL_MEMCPY(name, lwcell.m.call.name, sizeof(name));
 
     lwcell.m.call.id = lwcelli_parse_number(&str);
     lwcell.m.call.dir = (lwcell_call_dir_t)lwcelli_parse_number(&str);
@@ -591,14 +948,43 @@ lwcelli_parse_clcc(const char* str, uint8_t send_evt) {
     lwcelli_parse_string(&str, lwcell.m.call.number, sizeof(lwcell.m.call.number), 1);
     lwcell.m.call.addr_type = lwcelli_parse_number(&str);
     lwcelli_parse_string(&str, lwcell.m.call.name, sizeof(lwcell.m.call.name), 1);
+    if (lwcell.m.call.name[0] == '\0' && !strncmp(number, lwcell.m.call.number, sizeof(number))) {
+        LWCELL_MEMCPY(lwcell.m.call.name, name, sizeof(name)); /* Keep name reported by +CLIP for the same call */
+    }
+    prv_call_name_resolve();
+    if (lwcell.m.call.state != LWCELL_CALL_STATE_INCOMING && lwcell.m.call.state != LWCELL_CALL_STATE_WAITING) {
+        lwcell.m.call_rings = 0; /* Call is not ringing anymore */
+    }
 
-    if (send_evt) {
+    if (send_evt
+        && (id != lwcell.m.call.id || dir != lwcell.m.call.dir || state != lwcell.m.call.state
+            || strncmp(number, lwcell.m.call.number, sizeof(number)))) {
         lwcell.evt.evt.call_changed.call = &lwcell.m.call;
         lwcelli_send_cb(LWCELL_EVT_CALL_CHANGED);
     }
     return 1;
 }
 
+/**
+ * \brief           Parse received +CLIP with incoming call number
+ * \param[in]       str: Input string
+ * \return          1 on success, 0 otherwise
+ */
+uint8_t
+lwcelli_parse_clip(const char* str) {
+    if (*str == '+') {
+        str += 7;
+    }
+    lwcelli_parse_string(&str, lwcell.m.call.number, sizeof(lwcell.m.call.number), 1);
+    lwcell.m.call.addr_type = lwcelli_parse_number(&str);
+    lwcelli_parse_string(&str, NULL, 0, 1); /* Skip subaddress */
+    lwcelli_parse_number(&str);             /* Skip subaddress type */
+    lwcelli_parse_string(&str, lwcell.m.call.name, sizeof(lwcell.m.call.name), 1);
+    lwcell.m.call.dir = LWCELL_CALL_DIR_MT;
+    prv_call_name_resolve();
+    return 1;
+}
+
 #endif /* LWCELL_CFG_CALL || __DOXYGEN__ */
 
 #if LWCELL_CFG_SMS || __DOXYGEN__
@@ -684,7 +1070,16 @@ uint8_t
 lwcelli_parse_cmgl(const char* str) {
     lwcell_sms_entry_t* e;
 
-    if (!CMD_IS_DEF(LWCELL_CMD_CMGL) || lwcell.msg->msg.sms_list.ei >= lwcell.msg->msg.sms_list.etr) {
+    if (!CMD_IS_DEF(LWCELL_CMD_CMGL)) {
+        return 0;
+    }
+    if (lwcell.msg->msg.sms_list.entry_fn != NULL) { /* Scratch entry is reused for every message */
+        e = lwcell.msg->msg.sms_list.entries;
+        LWCELL_MEMSET(e, 0x00, sizeof(*e));
+    } else if (lwcell.msg->msg.sms_list.ei < lwcell.msg->msg.sms_list.etr) {
+        e = &lwcell.msg->msg.sms_list.entries[lwcell.msg->msg.sms_list.ei];
+        e->length = 0;
+    } else {
         return 0;
     }
 
@@ -692,8 +1087,6 @@ lwcelli_parse_cmgl(const char* str) {
         str += 7;
     }
 
-    e = &lwcell.msg->msg.sms_list.entries[lwcell.msg->msg.sms_list.ei];
-    e->length = 0;
     e->mem = lwcell.msg->msg.sms_list.mem;          /* Manually set memory */
     e->pos = LWCELL_SZ(lwcelli_parse_number(&str)); /* Scan position */
     lwcelli_parse_sms_status(&str, &e->status);
@@ -719,12 +1112,49 @@ lwcelli_parse_cmti(const char* str, uint8_t send_evt) {
     lwcell.evt.evt.sms_recv.mem = lwcelli_parse_memory(&str); /* Parse memory string */
     lwcell.evt.evt.sms_recv.pos = lwcelli_parse_number(&str); /* Parse number */
 
+#if LWCELL_CFG_SMS_DIRECT
+    lwcell.evt.evt.sms_recv.entry = NULL; /* Message is in storage */
+#endif                                    /* LWCELL_CFG_SMS_DIRECT */
+
     if (send_evt) {
         lwcelli_send_cb(LWCELL_EVT_SMS_RECV);
     }
     return 1;
 }
 
+#if LWCELL_CFG_SMS_DIRECT || __DOXYGEN__
+
+/**
+ * \brief           Parse received +CMT header of directly delivered SMS
+ *
+ * Message text follows in next line and is read from input stream
+ *
+ * \param[in]       str: Input string
+ * \return          `1` on success, `0` when header is not in text mode format
+ */
+uint8_t
+lwcelli_parse_cmt(const char* str) {
+    lwcell_sms_entry_t* e = &lwcell.m.sms.direct;
+
+    if (*str == '+') {
+        str += 6;
+    }
+    if (*str != '"') { /* PDU mode header starts with optional alpha and length */
+        return 0;
+    }
+
+    LWCELL_MEMSET(e, 0x00, sizeof(*e));
+    e->mem = LWCELL_MEM_UNKNOWN; /* Message is not saved */
+    e->status = LWCELL_SMS_STATUS_UNREAD;
+    lwcelli_parse_string(&str, e->number, sizeof(e->number), 1);
+    lwcelli_parse_string(&str, e->name, sizeof(e->name), 1);
+    lwcelli_parse_datetime(&str, &e->dt);
+
+    return 1;
+}
+
+#endif /* LWCELL_CFG_SMS_DIRECT || __DOXYGEN__ */
+
 /**
  * \brief           Parse +CPMS statement
  * \param[in]       str: Input string
@@ -801,6 +1231,19 @@ lwcelli_parse_cpbs(const char* str, uint8_t opt) {
     return 1;
 }
 
+/**
+ * \brief           Parse single entry from +CPBR statement
+ * \param[in]       str: Input string, after `+CPBR: ` prefix
+ * \param[out]      e: Entry to fill
+ */
+static void
+prv_parse_cpbr_entry(const char* str, lwcell_pb_entry_t* e) {
+    e->pos = LWCELL_SZ(lwcelli_parse_number(&str));
+    lwcelli_parse_string(&str, e->number, sizeof(e->number), 1);
+    e->type = (lwcell_number_type_t)lwcelli_parse_number(&str);
+    lwcelli_parse_string(&str, e->name, sizeof(e->name), 1);
+}
+
 /**
  * \brief           Parse +CPBR statement
  * \param[in]       str: Input string
@@ -810,24 +1253,45 @@ uint8_t
 lwcelli_parse_cpbr(const char* str) {
     lwcell_pb_entry_t* e;
 
-    if (!CMD_IS_DEF(LWCELL_CMD_CPBR) || lwcell.msg->msg.pb_list.ei >= lwcell.msg->msg.pb_list.etr) {
-        return 0;
-    }
-
     if (*str == '+') {
         str += 7;
     }
 
-    e = &lwcell.msg->msg.pb_list.entries[lwcell.msg->msg.pb_list.ei];
-    e->pos = LWCELL_SZ(lwcelli_parse_number(&str));
-    lwcelli_parse_string(&str, e->number, sizeof(e->number), 1);
-    e->type = (lwcell_number_type_t)lwcelli_parse_number(&str);
-    lwcelli_parse_string(&str, e->name, sizeof(e->name), 1);
+#if LWCELL_CFG_PHONEBOOK_MIRROR
+    if (CMD_IS_DEF(LWCELL_CMD_PHONEBOOK_MIRROR_LOAD)) {
+        lwcell_pb_entry_t entry;
+
+        prv_parse_cpbr_entry(str, &entry);
+        if (entry.pos > 0 && !lwcelli_pb_mirror_put(&entry)) {
+            lwcell.msg->msg.pb_mirror.overflow = 1;
+        }
+        return 1;
+    }
+#endif /* LWCELL_CFG_PHONEBOOK_MIRROR */
+
+    if (!CMD_IS_DEF(LWCELL_CMD_CPBR)) {
+        return 0;
+    }
+    if (lwcell.msg->msg.pb_list.entry_fn != NULL) { /* Single scratch entry passed to callback */
+        if (lwcell.msg->msg.pb_list.stop) {
+            return 0;
+        }
+        e = lwcell.msg->msg.pb_list.entries;
+    } else if (lwcell.msg->msg.pb_list.ei < lwcell.msg->msg.pb_list.etr) {
+        e = &lwcell.msg->msg.pb_list.entries[lwcell.msg->msg.pb_list.ei];
+    } else {
+        return 0;
+    }
+    prv_parse_cpbr_entry(str, e);
 
     ++lwcell.msg->msg.pb_list.ei;
     if (lwcell.msg->msg.pb_list.er != NULL) {
         *lwcell.msg->msg.pb_list.er = lwcell.msg->msg.pb_list.ei;
     }
+    if (lwcell.msg->msg.pb_list.entry_fn != NULL
+        && !lwcell.msg->msg.pb_list.entry_fn(e, lwcell.msg->msg.pb_list.entry_arg)) {
+        lwcell.msg->msg.pb_list.stop = 1;
+    }
     return 1;
 }
 
@@ -865,6 +1329,18 @@ lwcelli_parse_cpbf(const char* str) {
 
 #if LWCELL_CFG_CONN
 
+/**
+ * \brief           Connection state strings from `AT+CIPSTATUS`, indexed by \ref lwcell_conn_state_t
+ */
+static const char* const conn_state_str[] = {
+    [LWCELL_CONN_STATE_INITIAL] = "INITIAL",
+    [LWCELL_CONN_STATE_CONNECTING] = "CONNECTING",
+    [LWCELL_CONN_STATE_CONNECTED] = "CONNECTED",
+    [LWCELL_CONN_STATE_REMOTE_CLOSING] = "REMOTE CLOSING",
+    [LWCELL_CONN_STATE_CLOSING] = "CLOSING",
+    [LWCELL_CONN_STATE_CLOSED] = "CLOSED",
+};
+
 /**
  * \brief           Parse connection info line from CIPSTATUS command
  * \param[in]       str: Input string
@@ -874,10 +1350,14 @@ lwcelli_parse_cpbf(const char* str) {
  */
 uint8_t
 lwcelli_parse_cipstatus_conn(const char* str, uint8_t is_conn_line, uint8_t* continueScan) {
-    uint8_t num;
+    uint8_t num, changed;
     lwcell_conn_t* conn;
-    char s_tmp[16];
-    uint8_t tmp_pdp_state;
+    lwcelli_fields_t fields;
+    lwcell_conn_type_t type;
+    lwcell_ip_t ip;
+    lwcell_port_t port;
+    lwcell_conn_state_t state, prev_state;
+    uint8_t tmp_pdp_state, bearer;
 
     *continueScan = 1;
     if (is_conn_line && (*str == 'C' || *str == 'S')) {
@@ -885,17 +1365,31 @@ lwcelli_parse_cipstatus_conn(const char* str, uint8_t is_conn_line, uint8_t* con
     } else {
         /* Check if PDP context is deactivated or not */
         tmp_pdp_state = 1;
+        lwcell.m.network.ip_state = LWCELL_IP_STATE_ACTIVE;
         if (!strncmp(&str[7], "IP INITIAL", 10)) {
             *continueScan = 0; /* Stop command execution at this point (no OK,ERROR received after this line) */
             tmp_pdp_state = 0;
+            lwcell.m.network.ip_state = LWCELL_IP_STATE_INITIAL;
         } else if (!strncmp(&str[7], "PDP DEACT", 9)) {
             /* Deactivated */
             tmp_pdp_state = 0;
+            lwcell.m.network.ip_state = LWCELL_IP_STATE_DEACT;
+        } else if (!strncmp(&str[7], "IP START", 8)) {
+            lwcell.m.network.ip_state = LWCELL_IP_STATE_START;
+        } else if (!strncmp(&str[7], "IP CONFIG", 9)) {
+            lwcell.m.network.ip_state = LWCELL_IP_STATE_CONFIG;
+        } else if (!strncmp(&str[7], "IP GPRSACT", 10)) {
+            lwcell.m.network.ip_state = LWCELL_IP_STATE_GPRSACT;
         }
 
         /* Check if we have to update status for application */
         if (lwcell.m.network.is_attached != tmp_pdp_state) {
             lwcell.m.network.is_attached = tmp_pdp_state;
+#if LWCELL_CFG_NETWORK_CONTEXTS > 1
+            if (!tmp_pdp_state) { /* Additional contexts are deactivated together with default one */
+                LWCELL_MEMSET(lwcell.m.network.ctx, 0x00, sizeof(lwcell.m.network.ctx));
+            }
+#endif /* LWCELL_CFG_NETWORK_CONTEXTS > 1 */
 
             /* Notify upper layer */
             lwcelli_send_cb(lwcell.m.network.is_attached ? LWCELL_EVT_NETWORK_ATTACHED : LWCELL_EVT_NETWORK_DETACHED);
@@ -904,40 +1398,74 @@ lwcelli_parse_cipstatus_conn(const char* str, uint8_t is_conn_line, uint8_t* con
         return 1;
     }
 
-    /* Parse connection line */
-    num = LWCELL_U8(lwcelli_parse_number(&str));
+    /* Parse connection line: <num>,<bearer>,<type>,<ip>,<port>,<state> */
+    lwcelli_fields_split(&fields, str);
+    num = LWCELL_U8(lwcelli_fields_get_int(&fields, 0));
+    if (num >= LWCELL_CFG_MAX_CONNS) {
+        return 0;
+    }
     conn = &lwcell.m.conns[num];
 
-    conn->status.f.bearer = LWCELL_U8(lwcelli_parse_number(&str));
-    lwcelli_parse_string(&str, s_tmp, sizeof(s_tmp), 1); /* Parse TCP/UPD */
-    if (strlen(s_tmp)) {
-        if (!strcmp(s_tmp, "TCP")) {
-            conn->type = LWCELL_CONN_TYPE_TCP;
-        } else if (!strcmp(s_tmp, "UDP")) {
-            conn->type = LWCELL_CONN_TYPE_UDP;
+    /* Parse line to temporary values first, empty fields keep cached value */
+    bearer = LWCELL_U8(lwcelli_fields_get_int(&fields, 1) > 0);
+    type = conn->type;
+    if (lwcelli_fields_is(&fields, 2, "TCP")) {
+        type = LWCELL_CONN_TYPE_TCP;
+    } else if (lwcelli_fields_is(&fields, 2, "UDP")) {
+        type = LWCELL_CONN_TYPE_UDP;
+    }
+    ip = conn->remote_ip;
+    lwcelli_fields_get_ip(&fields, 3, &ip);
+    port = conn->remote_port;
+    if (fields.cnt > 4 && fields.fld[4].len > 0) {
+        port = (lwcell_port_t)lwcelli_fields_get_int(&fields, 4);
+    }
+    state = LWCELL_CONN_STATE_UNKNOWN;
+    for (size_t i = 1; i < LWCELL_ARRAYSIZE(conn_state_str); ++i) {
+        if (lwcelli_fields_is(&fields, 5, conn_state_str[i])) {
+            state = (lwcell_conn_state_t)i;
+            break;
         }
     }
-    lwcelli_parse_ip(&str, &conn->remote_ip);
-    conn->remote_port = lwcelli_parse_number(&str);
-
-    /* Get connection status */
-    lwcelli_parse_string(&str, s_tmp, sizeof(s_tmp), 1);
-
-    /* TODO: Implement all connection states */
-    if (!strcmp(s_tmp, "INITIAL")) {
-
-    } else if (!strcmp(s_tmp, "CONNECTING")) {
 
-    } else if (!strcmp(s_tmp, "CONNECTED")) {
-
-    } else if (!strcmp(s_tmp, "REMOTE CLOSING")) {
+    /* Diff against cached connection status */
+    changed = 0;
+    prev_state = conn->state;
+    if (state != prev_state) {
+        changed |= LWCELL_CONN_CHANGED_STATE;
+    }
+    if (type != conn->type) {
+        changed |= LWCELL_CONN_CHANGED_TYPE;
+    }
+    if (memcmp(&ip, &conn->remote_ip, sizeof(ip)) != 0) {
+        changed |= LWCELL_CONN_CHANGED_REMOTE_IP;
+    }
+    if (port != conn->remote_port) {
+        changed |= LWCELL_CONN_CHANGED_REMOTE_PORT;
+    }
+    if (bearer != conn->status.f.bearer) {
+        changed |= LWCELL_CONN_CHANGED_BEARER;
+    }
 
-    } else if (!strcmp(s_tmp, "CLOSING")) {
+    /* Update cache */
+    conn->status.f.bearer = bearer;
+    conn->type = type;
+    conn->remote_ip = ip;
+    conn->remote_port = port;
+    conn->state = state;
 
-    } else if (!strcmp(s_tmp, "CLOSED")) {             /* Connection closed */
+    if (state == LWCELL_CONN_STATE_CLOSED) {           /* Connection closed */
         if (conn->status.f.active) {                   /* Check if connection is not */
             lwcelli_conn_closed_process(conn->num, 0); /* Process closed event */
         }
+    } else if (changed && conn->status.f.active && prev_state != LWCELL_CONN_STATE_UNKNOWN) {
+        /* Report only changes on active connections, first line after connect only fills the cache */
+        lwcell.evt.type = LWCELL_EVT_CONN_STATUS_CHANGED;
+        lwcell.evt.evt.conn_status_changed.conn = conn;
+        lwcell.evt.evt.conn_status_changed.changed = changed;
+        lwcell.evt.evt.conn_status_changed.state = state;
+        lwcell.evt.evt.conn_status_changed.prev_state = prev_state;
+        lwcelli_send_conn_cb(conn, NULL);
     }
 
     /* Save last parsed connection */
@@ -947,39 +1475,845 @@ lwcelli_parse_cipstatus_conn(const char* str, uint8_t is_conn_line, uint8_t* con
 }
 
 /**
- * \brief           Parse IPD or RECEIVE statements
- * \param[in]       str: Input string
- * \return          `1` on success, `0` otherwise
+ * \brief           Start reading connection data of received packet
+ * \param[in]       conn: Connection number reported by device
+ * \param[in]       len: Number of bytes in packet
+ * \return          `1` on success, `0` for invalid connection number
  */
-uint8_t
-lwcelli_parse_ipd(const char* str) {
-    uint8_t conn;
-    size_t len;
+static uint8_t
+prv_ipd_begin(size_t conn, size_t len) {
     lwcell_conn_p c;
 
-    if (*str == '+') {
-        ++str;
-        if (*str == 'R') {
-            str += 8; /* Advance for RECEIVE */
-        } else {
-            str += 4; /* Advance for IPD */
-        }
-    }
-
-    conn = lwcelli_parse_number(&str);                              /* Parse number for connection number */
-    len = lwcelli_parse_number(&str);                               /* Parse number for number of bytes to read */
-
-    c = conn < LWCELL_CFG_MAX_CONNS ? &lwcell.m.conns[conn] : NULL; /* Get connection handle */
-    if (c == NULL) {                                                /* Invalid connection number */
-        return 0;
+    if (conn >= LWCELL_CFG_MAX_CONNS) { /* Invalid connection number */
+        return 0;
     }
+    c = &lwcell.m.conns[conn];
 
     lwcell.m.ipd.read = 1;      /* Start reading network data */
     lwcell.m.ipd.tot_len = len; /* Total number of bytes in this received packet */
     lwcell.m.ipd.rem_len = len; /* Number of remaining bytes to read */
     lwcell.m.ipd.conn = c;      /* Pointer to connection we have data for */
+#if LWCELL_CFG_USAGE
+    lwcelli_usage_add(c, len, 0);
+#endif /* LWCELL_CFG_USAGE */
+#if LWCELL_CFG_CONN_MANUAL_RECV
+    lwcell.m.ipd.is_rxget = 0; /* Data pushed by device consume credit on delivery */
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV */
 
     return 1;
 }
 
+/**
+ * \brief           Parse IPD or RECEIVE statements
+ * \param[in]       str: Input string
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_parse_ipd(const char* str) {
+    lwcelli_fields_t fields;
+
+    if (*str == '+') {
+        ++str;
+        if (*str == 'R') {
+            str += 8; /* Advance for RECEIVE */
+        } else {
+            str += 4; /* Advance for IPD */
+        }
+    }
+
+    lwcelli_fields_split(&fields, str);
+    return prv_ipd_begin(LWCELL_SZ(lwcelli_fields_get_int(&fields, 0)),  /* Connection number */
+                         LWCELL_SZ(lwcelli_fields_get_int(&fields, 1))); /* Number of bytes to read */
+}
+
+/**
+ * \brief           Decode `+RECEIVE,<conn>,<len>:` header line directly from input data
+ *
+ * Header is recognized at the beginning of line and decoded in single pass,
+ * without copying it to receive buffer and without going through received line parser.
+ * Only complete header line is decoded, partial or unexpected input is left to line parser
+ *
+ * \param[in]       d: Input data, starting at the beginning of line
+ * \param[in]       d_len: Length of input data
+ * \return          Length of header line including `CRLF` when connection data read has started, `0` otherwise
+ */
+size_t
+lwcelli_parse_ipd_header(const uint8_t* d, size_t d_len) {
+    static const char prefix[] = "+RECEIVE,";
+    size_t i = sizeof(prefix) - 1, start, conn = 0, len = 0;
+
+    if (d_len <= i || memcmp(d, prefix, i) != 0) {
+        return 0;
+    }
+    for (start = i; i < d_len && i - start < 3 && LWCELL_CHARISNUM(d[i]); ++i) {
+        conn = conn * 10 + LWCELL_CHARTONUM(d[i]);
+    }
+    if (i == start || i >= d_len || d[i] != ',') {
+        return 0;
+    }
+    for (start = ++i; i < d_len && i - start < 9 && LWCELL_CHARISNUM(d[i]); ++i) {
+        len = len * 10 + LWCELL_CHARTONUM(d[i]);
+    }
+    if (i == start || d_len - i < 3 || d[i] != ':' || d[i + 1] != '\r' || d[i + 2] != '\n') {
+        return 0;
+    }
+    return prv_ipd_begin(conn, len) ? (i + 3) : 0;
+}
+
+#if LWCELL_CFG_CONN_RECV_FROM || __DOXYGEN__
+
+/**
+ * \brief           Parse `RECV FROM:<ip>:<port>` line, reported before received packet
+ *
+ * Address is kept for packet which follows and assigned to its packet buffers
+ *
+ * \param[in]       str: Input string
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_parse_recv_from(const char* str) {
+    str += 10; /* Advance for RECV FROM: */
+    if (!LWCELL_CHARISNUM(*str)) {
+        return 0;
+    }
+    lwcelli_parse_ip(&str, &lwcell.m.ipd.src_ip);
+    if (*str != ':') {
+        return 0;
+    }
+    ++str;
+    lwcell.m.ipd.src_port = (lwcell_port_t)lwcelli_parse_number(&str);
+    lwcell.m.ipd.src_valid = 1;
+    return 1;
+}
+
+#endif /* LWCELL_CFG_CONN_RECV_FROM || __DOXYGEN__ */
+
+#if LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__
+
+/**
+ * \brief           Parse +CIPRXGET statement in manual receive mode
+ *
+ * Mode `1` is notification about new data in device buffer,
+ * mode `2` is header of data read with `AT+CIPRXGET=2` command
+ * and mode `4` is response to `AT+CIPRXGET=4` query of data length in device buffer
+ *
+ * \param[in]       str: Input string
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_parse_ciprxget(const char* str) {
+    uint8_t mode, num;
+    size_t len, rem;
+    lwcell_conn_p c;
+    lwcelli_fields_t fields;
+
+    if (*str == '+') {
+        str += 11; /* Advance for +CIPRXGET: */
+    }
+
+    lwcelli_fields_split(&fields, str);
+    mode = LWCELL_U8(lwcelli_fields_get_int(&fields, 0));
+    num = LWCELL_U8(lwcelli_fields_get_int(&fields, 1));
+    if (num >= LWCELL_CFG_MAX_CONNS) { /* Invalid connection number */
+        return 0;
+    }
+    c = &lwcell.m.conns[num];
+
+    if (mode == 1) { /* New data available in device buffer */
+        if (fields.cnt > 2) {
+            lwcelli_conn_rx_dev_len_set(c, LWCELL_SZ(lwcelli_fields_get_int(&fields, 2)));
+        }
+        c->status.f.rx_pending = 1;
+        lwcelli_conn_manual_recv_read(c); /* Start reading if application can accept data */
+    } else if (mode == 4 && CMD_IS_CUR(LWCELL_CMD_CIPRXGET_QUERY) && lwcell.msg->msg.ciprxget.conn == c) {
+        len = LWCELL_SZ(lwcelli_fields_get_int(&fields, 2)); /* Number of bytes in device buffer */
+        lwcelli_conn_rx_dev_len_set(c, len);
+        if (len > 0 && !c->status.f.rx_pending) {
+            c->status.f.rx_pending = 1;
+            lwcelli_conn_manual_recv_read(c); /* Data may have been missed, start reading */
+        }
+    } else if (mode == 2 && CMD_IS_CUR(LWCELL_CMD_CIPRXGET) && lwcell.msg->msg.ciprxget.conn == c) {
+        len = LWCELL_SZ(lwcelli_fields_get_int(&fields, 2)); /* Number of bytes that follow */
+        rem = LWCELL_SZ(lwcelli_fields_get_int(&fields, 3)); /* Number of bytes still in device buffer */
+        len = LWCELL_MIN(len, lwcell.msg->msg.ciprxget.len);
+
+        /* Return unused part of reserved window */
+        c->rx_credit += lwcell.msg->msg.ciprxget.len - len;
+        lwcell.msg->msg.ciprxget.len = len;
+        lwcell.msg->msg.ciprxget.rem = rem;
+        lwcell.msg->msg.ciprxget.hdr = 1;
+        if (c->val_id == lwcell.msg->msg.ciprxget.val_id) {
+            lwcelli_conn_rx_dev_len_set(c, rem);
+        }
+        if (len > 0) {
+            lwcell.m.ipd.read = 1;      /* Start reading network data */
+            lwcell.m.ipd.tot_len = len; /* Total number of bytes in this received packet */
+            lwcell.m.ipd.rem_len = len; /* Number of remaining bytes to read */
+            lwcell.m.ipd.conn = c;      /* Pointer to connection we have data for */
+#if LWCELL_CFG_USAGE
+            lwcelli_usage_add(c, len, 0);
+#endif /* LWCELL_CFG_USAGE */
+            lwcell.m.ipd.is_rxget = 1;  /* Credit is already reserved */
+        }
+
+        /* Queue next read while data of this one are being received */
+        if (rem > 0 && c->val_id == lwcell.msg->msg.ciprxget.val_id) {
+            c->status.f.rx_pending = 1;
+            lwcelli_conn_manual_recv_read(c);
+        }
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+#if LWCELL_CFG_CONN_CA_SOCKET || __DOXYGEN__
+
+/**
+ * \brief           Parse +CARECV statement, header of data read with `AT+CARECV` command
+ *
+ * Data follow header on the same line, after comma.
+ * Device does not report length left in socket buffer, full read means more data may be waiting
+ *
+ * \param[in]       str: Input string
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_parse_carecv(const char* str) {
+    size_t len;
+    uint8_t more;
+    lwcell_conn_p c;
+
+    if (!CMD_IS_CUR(LWCELL_CMD_CIPRXGET)) {
+        return 0;
+    }
+    if (*str == '+') {
+        str += 9; /* Advance for +CARECV: */
+    }
+    c = lwcell.msg->msg.ciprxget.conn;
+    len = LWCELL_SZ(lwcelli_parse_number(&str));
+    len = LWCELL_MIN(len, lwcell.msg->msg.ciprxget.len);
+    more = len > 0 && len == lwcell.msg->msg.ciprxget.len;
+
+    /* Return unused part of reserved window */
+    c->rx_credit += lwcell.msg->msg.ciprxget.len - len;
+    lwcell.msg->msg.ciprxget.len = len;
+    lwcell.msg->msg.ciprxget.hdr = 1;
+    if (len > 0) {
+        lwcell.m.ipd.read = 1;      /* Start reading network data */
+        lwcell.m.ipd.tot_len = len; /* Total number of bytes in this received packet */
+        lwcell.m.ipd.rem_len = len; /* Number of remaining bytes to read */
+        lwcell.m.ipd.conn = c;      /* Pointer to connection we have data for */
+#if LWCELL_CFG_USAGE
+        lwcelli_usage_add(c, len, 0);
+#endif /* LWCELL_CFG_USAGE */
+        lwcell.m.ipd.is_rxget = 1;  /* Credit is already reserved */
+    }
+
+    /* Queue next read while data of this one are being received */
+    if (more && c->val_id == lwcell.msg->msg.ciprxget.val_id) {
+        c->status.f.rx_pending = 1;
+        lwcelli_conn_manual_recv_read(c);
+    }
+    return 1;
+}
+
+#endif /* LWCELL_CFG_CONN_CA_SOCKET || __DOXYGEN__ */
+
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV || __DOXYGEN__ */
+
 #endif /* LWCELL_CFG_CONN */
+
+#if LWCELL_CFG_MQTT || __DOXYGEN__
+
+/**
+ * \brief           Parse received +SMSUB statement with message on subscribed topic
+ *
+ * Statement format is `+SMSUB: "topic","message"`,
+ * topic and payload are passed to application without copy
+ *
+ * \param[in]       str: Input string
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_parse_smsub(const char* str) {
+    const char *topic, *payload, *end;
+
+    if (*str == '+') {
+        str += 7; /* Advance for +SMSUB: */
+    }
+    for (; *str == ' ' || *str == '"'; ++str) {}
+    topic = str;
+    if ((payload = strstr(topic, "\",\"")) == NULL) {
+        return 0;
+    }
+    end = payload + 3 + strlen(payload + 3);
+    for (; end > payload + 3 && (end[-1] == '\r' || end[-1] == '\n'); --end) {}
+    if (end > payload + 3 && end[-1] == '"') {
+        --end;
+    }
+
+    lwcell.evt.evt.mqtt_recv.mqtt = &lwcell.m.mqtt;
+    lwcell.evt.evt.mqtt_recv.topic = topic;
+    lwcell.evt.evt.mqtt_recv.topic_len = LWCELL_SZ(payload - topic);
+    lwcell.evt.evt.mqtt_recv.payload = payload + 3;
+    lwcell.evt.evt.mqtt_recv.payload_len = LWCELL_SZ(end - (payload + 3));
+    lwcelli_send_mqtt_cb(LWCELL_EVT_MQTT_RECV);
+    return 1;
+}
+
+/**
+ * \brief           Parse +SMSTATE statement with MQTT connection state
+ * \param[in]       str: Input string
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_parse_smstate(const char* str) {
+    if (*str == '+') {
+        str += 10; /* Advance for +SMSTATE: */
+    }
+
+    /* Device reports disconnect from server, for example on keep-alive timeout */
+    if (lwcelli_parse_number(&str) == 0 && lwcell.m.mqtt.is_connected) {
+        lwcell.m.mqtt.is_connected = 0;
+        lwcell.m.mqtt.in_use = 0;
+        lwcell.evt.evt.mqtt_disconnect.mqtt = &lwcell.m.mqtt;
+        lwcell.evt.evt.mqtt_disconnect.forced = 0;
+        lwcelli_send_mqtt_cb(LWCELL_EVT_MQTT_DISCONNECT);
+    }
+    return 1;
+}
+
+#endif /* LWCELL_CFG_MQTT || __DOXYGEN__ */
+
+#if LWCELL_CFG_HTTP || __DOXYGEN__
+
+/**
+ * \brief           Parse +HTTPACTION or +SHREQ statement with HTTP request result
+ * \param[in]       str: Input string
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_parse_http_result(const char* str) {
+    uint16_t status;
+    size_t len;
+
+    if ((str = strchr(str, ':')) == NULL) {
+        return 0;
+    }
+    str += 2; /* Advance for ": " */
+
+    /* Method is number on HTTPACTION and string on SHREQ */
+    if (*str == '"') {
+        lwcelli_parse_string(&str, NULL, 0, 1);
+    } else {
+        lwcelli_parse_number(&str);
+    }
+    status = (uint16_t)lwcelli_parse_number(&str);
+    len = (size_t)lwcelli_parse_number(&str);
+
+    lwcell.m.http.status = status;
+    lwcell.m.http.content_len = len;
+    if (lwcell.msg->msg.http_get.status != NULL) {
+        *lwcell.msg->msg.http_get.status = status;
+    }
+    if (lwcell.msg->msg.http_get.content_len != NULL) {
+        *lwcell.msg->msg.http_get.content_len = len;
+    }
+    lwcell.msg->msg.http_get.resp_received = 1;
+    return 1;
+}
+
+/**
+ * \brief           Parse +HTTPREAD or +SHREAD statement and start reading raw body data
+ * \param[in]       str: Input string
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_parse_http_read(const char* str) {
+    size_t len;
+
+    if ((str = strchr(str, ':')) == NULL) {
+        return 0;
+    }
+    str += 2; /* Advance for ": " */
+
+    len = (size_t)lwcelli_parse_number(&str);
+    if (len > 0) {
+        lwcell.msg->msg.data_read.rem_len = len;
+        lwcell.msg->msg.data_read.read = 1; /* Raw data follow after this line */
+    }
+    return 1;
+}
+
+#endif /* LWCELL_CFG_HTTP || __DOXYGEN__ */
+
+#if LWCELL_CFG_FTP || __DOXYGEN__
+
+/**
+ * \brief           Process asynchronous FTP session status reported by device
+ * \param[in]       code: Status code, `1` when device is ready, `0` when transfer finished, error code otherwise
+ */
+static void
+lwcelli_ftp_session_status(int32_t code) {
+    if (code == 1) {
+        lwcelli_send_cb(LWCELL_EVT_FTP_READY);
+    } else {
+        lwcell.m.ftp.active = 0;
+        lwcell.evt.evt.ftp_done.res = code == 0 ? lwcellOK : lwcellERR;
+        lwcell.evt.evt.ftp_done.offset = lwcell.m.ftp.offset;
+        lwcelli_send_cb(LWCELL_EVT_FTP_DONE);
+    }
+}
+
+/**
+ * \brief           Parse +FTPGET statement
+ * \param[in]       str: Input string
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_parse_ftpget(const char* str) {
+    uint8_t mode;
+    int32_t val;
+
+    if (*str == '+') {
+        str += 9; /* Advance for +FTPGET: */
+    }
+    mode = (uint8_t)lwcelli_parse_number(&str);
+    val = lwcelli_parse_number(&str);
+
+    if (mode == 2) { /* Length of data that follow */
+        if (CMD_IS_CUR(LWCELL_CMD_FTPGET_READ) && val > 0) {
+            lwcell.msg->msg.data_read.rem_len = (size_t)val;
+            lwcell.msg->msg.data_read.read = 1; /* Raw data follow after this line */
+        }
+    } else if (mode == 1) { /* Session status */
+        if (CMD_IS_CUR(LWCELL_CMD_FTPGET_OPEN)) {
+            lwcell.msg->msg.ftp_start.resp_received = 1;
+            lwcell.msg->msg.ftp_start.resp_code = (uint8_t)val;
+        } else if (lwcell.m.ftp.active && !lwcell.m.ftp.is_put) {
+            lwcelli_ftp_session_status(val);
+        }
+    }
+    return 1;
+}
+
+/**
+ * \brief           Parse +FTPPUT statement with upload session status
+ * \note            Data length statement in response to write command is processed by caller
+ * \param[in]       str: Input string
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_parse_ftpput(const char* str) {
+    int32_t val;
+
+    if (*str == '+') {
+        str += 9; /* Advance for +FTPPUT: */
+    }
+    if (lwcelli_parse_number(&str) != 1) {
+        return 0;
+    }
+    val = lwcelli_parse_number(&str);
+    if (val == 1) {
+        lwcell.m.ftp.put_max_len = (size_t)lwcelli_parse_number(&str);
+    }
+
+    if (CMD_IS_CUR(LWCELL_CMD_FTPPUT_OPEN)) {
+        lwcell.msg->msg.ftp_start.resp_received = 1;
+        lwcell.msg->msg.ftp_start.resp_code = (uint8_t)val;
+#if LWCELL_CFG_FS
+    } else if (CMD_IS_CUR(LWCELL_CMD_FTPPUTFRMFS)) {
+        if (val != 1) { /* Upload from file system finished, `0` on success */
+            lwcell.msg->msg.ftp_start.resp_received = 1;
+            lwcell.msg->msg.ftp_start.resp_code = (uint8_t)val;
+        }
+#endif /* LWCELL_CFG_FS */
+    } else if (CMD_IS_CUR(LWCELL_CMD_FTPPUT_WRITE) || CMD_IS_CUR(LWCELL_CMD_FTPPUT_END)) {
+        lwcell.msg->msg.ftp_put.resp_received = 1;
+        lwcell.msg->msg.ftp_put.resp_code = (uint8_t)val;
+    } else if (lwcell.m.ftp.active && lwcell.m.ftp.is_put) {
+        lwcelli_ftp_session_status(val);
+    }
+    return 1;
+}
+
+#endif /* LWCELL_CFG_FTP || __DOXYGEN__ */
+
+#if LWCELL_CFG_PING || __DOXYGEN__
+
+/**
+ * \brief           Parse +CIPPING statement with single probe result
+ *
+ * Device reports round-trip time in units of `100ms`, value `600000` indicates probe timeout
+ *
+ * \param[in]       str: Input string
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_parse_cipping(const char* str) {
+    lwcell_ping_stats_t* st;
+    uint32_t rtt;
+
+    if (!CMD_IS_CUR(LWCELL_CMD_CIPPING)) {
+        return 0;
+    }
+    if (*str == '+') {
+        str += 10; /* Advance for +CIPPING: */
+    }
+    lwcelli_parse_number(&str);              /* Skip reply ID */
+    lwcelli_parse_string(&str, NULL, 0, 1); /* Skip IP address */
+    rtt = LWCELL_U32(lwcelli_parse_number(&str));
+
+    st = &lwcell.msg->msg.ping.stats;
+    ++st->sent;
+    if (rtt == 600000) { /* Probe has timed out */
+        return 1;
+    }
+    rtt *= 100; /* Convert to milliseconds */
+    if (st->received == 0 || rtt < st->min) {
+        st->min = rtt;
+    }
+    if (rtt > st->max) {
+        st->max = rtt;
+    }
+    if (st->received > 0) {
+        lwcell.msg->msg.ping.jitter_sum += rtt > lwcell.msg->msg.ping.rtt_last ? (rtt - lwcell.msg->msg.ping.rtt_last)
+                                                                               : (lwcell.msg->msg.ping.rtt_last - rtt);
+    }
+    lwcell.msg->msg.ping.rtt_last = rtt;
+    lwcell.msg->msg.ping.rtt_sum += rtt;
+    ++st->received;
+    return 1;
+}
+
+#endif /* LWCELL_CFG_PING || __DOXYGEN__ */
+
+#if LWCELL_CFG_DNS || __DOXYGEN__
+
+/**
+ * \brief           Parse +CDNSGIP statement with resolve result
+ * \param[in]       str: Input string
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_parse_cdnsgip(const char* str) {
+    if (!CMD_IS_CUR(LWCELL_CMD_CDNSGIP)) {
+        return 0;
+    }
+    if (*str == '+') {
+        str += 10; /* Advance for +CDNSGIP: */
+    }
+    lwcell.msg->msg.dns.resp_received = 1;
+    if (lwcelli_parse_number(&str) != 1) { /* Resolve failed, error code follows */
+        return 1;
+    }
+    lwcelli_parse_string(&str, NULL, 0, 1); /* Skip host name */
+    while (*str == ',' && lwcell.msg->msg.dns.addr_cnt < LWCELL_CFG_DNS_MAX_ADDR) {
+        lwcelli_parse_ip(&str, &lwcell.msg->msg.dns.addr[lwcell.msg->msg.dns.addr_cnt]);
+        ++lwcell.msg->msg.dns.addr_cnt;
+    }
+    return 1;
+}
+
+#endif /* LWCELL_CFG_DNS || __DOXYGEN__ */
+
+#if LWCELL_CFG_GNSS || LWCELL_CFG_TIME || __DOXYGEN__
+
+/**
+ * \brief           Parse decimal number with fraction to fixed point value
+ *
+ * Fraction digits above `dec` are truncated, missing ones are filled with zeros.
+ * Empty field gives `0`
+ *
+ * \note            Input string pointer is changed and number with trailing comma is skipped
+ * \param[in,out]   str: Pointer to pointer to string to parse
+ * \param[in]       dec: Number of fraction digits in output value
+ * \return          Parsed value, multiplied by `10^dec`
+ */
+static int32_t
+prv_parse_fixed(const char** str, uint8_t dec) {
+    const char* p = *str;
+    int32_t val = 0;
+    uint8_t minus = 0, frac = 0, in_frac = 0;
+
+    if (*p == '-') {
+        minus = 1;
+        ++p;
+    }
+    for (;; ++p) {
+        if (LWCELL_CHARISNUM(*p)) {
+            if (!in_frac || frac < dec) {
+                val = val * 10 + LWCELL_CHARTONUM(*p);
+                frac += in_frac;
+            }
+        } else if (*p == '.' && !in_frac) {
+            in_frac = 1;
+        } else {
+            break;
+        }
+    }
+    for (; frac < dec; ++frac) {
+        val *= 10;
+    }
+    if (*p == ',') {
+        ++p;
+    }
+    *str = p;
+    return minus ? -val : val;
+}
+
+#endif /* LWCELL_CFG_GNSS || LWCELL_CFG_TIME || __DOXYGEN__ */
+
+#if LWCELL_CFG_GNSS || __DOXYGEN__
+
+/**
+ * \brief           Parse fixed number of digits as decimal number
+ * \note            Input string pointer is changed and digits are skipped
+ * \param[in,out]   str: Pointer to pointer to string to parse
+ * \param[in]       cnt: Number of digits to parse
+ * \return          Parsed number
+ */
+static int
+prv_parse_digits(const char** str, size_t cnt) {
+    int val = 0;
+
+    for (; cnt > 0 && LWCELL_CHARISNUM(**str); --cnt, ++*str) {
+        val = val * 10 + LWCELL_CHARTONUM(**str);
+    }
+    return val;
+}
+
+/**
+ * \brief           Parse +UGNSINF or +CGNSINF statement with navigation info
+ *
+ * Line is parsed in place, fields are
+ * `<run>,<fix>,<yyyyMMddhhmmss.sss>,<lat>,<lon>,<alt>,<speed>,<course>,<mode>,,<HDOP>,<PDOP>,<VDOP>,,<sats>,...`
+ *
+ * \param[in]       str: Input string
+ * \param[out]      fix: Output navigation info
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_parse_gnsinf(const char* str, lwcell_gnss_fix_t* fix) {
+    if (*str == '+') {
+        str += 10; /* Advance for +UGNSINF: or +CGNSINF: */
+    }
+    LWCELL_MEMSET(fix, 0x00, sizeof(*fix));
+    fix->run = LWCELL_U8(lwcelli_parse_number(&str));
+    fix->fix = LWCELL_U8(lwcelli_parse_number(&str));
+    if (*str == ',') {
+        ++str;
+    }
+
+    /* Date and time is in yyyyMMddhhmmss.sss format */
+    fix->dt.tm_year = prv_parse_digits(&str, 4) - 1900;
+    fix->dt.tm_mon = prv_parse_digits(&str, 2) - 1;
+    fix->dt.tm_mday = prv_parse_digits(&str, 2);
+    fix->dt.tm_hour = prv_parse_digits(&str, 2);
+    fix->dt.tm_min = prv_parse_digits(&str, 2);
+    fix->dt.tm_sec = prv_parse_digits(&str, 2);
+    prv_parse_fixed(&str, 0); /* Skip milliseconds */
+
+    fix->lat = prv_parse_fixed(&str, 6);
+    fix->lon = prv_parse_fixed(&str, 6);
+    fix->alt = prv_parse_fixed(&str, 2);
+    fix->speed = LWCELL_U32(prv_parse_fixed(&str, 2));
+    fix->course = LWCELL_U32(prv_parse_fixed(&str, 2));
+    fix->mode = LWCELL_U8(prv_parse_fixed(&str, 0));
+    prv_parse_fixed(&str, 0); /* Skip reserved field */
+    fix->hdop = LWCELL_U16(prv_parse_fixed(&str, 1));
+    prv_parse_fixed(&str, 0); /* Skip PDOP */
+    prv_parse_fixed(&str, 0); /* Skip VDOP */
+    prv_parse_fixed(&str, 0); /* Skip reserved field */
+    fix->sats_view = LWCELL_U8(prv_parse_fixed(&str, 0));
+    return 1;
+}
+
+#endif /* LWCELL_CFG_GNSS || __DOXYGEN__ */
+
+#if LWCELL_CFG_CELL_INFO || __DOXYGEN__
+
+/**
+ * \brief           Parse single +CENG line of engineering mode report
+ *
+ * Serving cell line `<0>,"<arfcn>,<rxl>,<rxq>,<mcc>,<mnc>,<bsic>,<cellid>,<rla>,<txp>,<lac>,<TA>"`
+ * starts new report, neighbour cell lines `<n>,"<arfcn>,<rxl>,<bsic>,<cellid>,<mcc>,<mnc>,<lac>"`
+ * are added to table in the order they are received. Engineering mode status line is ignored.
+ *
+ * \param[in]       str: Input string
+ * \param[out]      info: Cell info to update
+ * \return          `1` if cell line was parsed, `0` otherwise
+ */
+uint8_t
+lwcelli_parse_ceng(const char* str, lwcell_cell_info_t* info) {
+    lwcell_cell_t* cell;
+    uint8_t idx;
+
+    if (*str == '+') {
+        str += 7; /* Advance for +CENG: */
+    }
+    idx = LWCELL_U8(lwcelli_parse_number(&str));
+    if (str[0] != ',' || str[1] != '"') {
+        return 0; /* Engineering mode status, not a cell line */
+    }
+
+    if (idx == 0) {
+        cell = &info->serving;
+        cell->arfcn = LWCELL_U16(lwcelli_parse_number(&str));
+        cell->rxlev = LWCELL_U8(lwcelli_parse_number(&str));
+        info->rxqual = LWCELL_U8(lwcelli_parse_number(&str));
+        cell->mcc = LWCELL_U16(lwcelli_parse_number(&str));
+        cell->mnc = LWCELL_U16(lwcelli_parse_number(&str));
+        cell->bsic = LWCELL_U8(lwcelli_parse_number(&str));
+        cell->cell_id = LWCELL_U32(lwcelli_parse_hexnumber(&str));
+        lwcelli_parse_number(&str); /* Skip RLA */
+        lwcelli_parse_number(&str); /* Skip TXP */
+        cell->lac = LWCELL_U16(lwcelli_parse_hexnumber(&str));
+        info->ta = LWCELL_U8(lwcelli_parse_number(&str));
+        info->neighbours_cnt = 0;
+        info->valid = 1;
+    } else if (info->neighbours_cnt < LWCELL_ARRAYSIZE(info->neighbours)) {
+        cell = &info->neighbours[info->neighbours_cnt];
+        cell->arfcn = LWCELL_U16(lwcelli_parse_number(&str));
+        cell->rxlev = LWCELL_U8(lwcelli_parse_number(&str));
+        cell->bsic = LWCELL_U8(lwcelli_parse_number(&str));
+        cell->cell_id = LWCELL_U32(lwcelli_parse_hexnumber(&str));
+        cell->mcc = LWCELL_U16(lwcelli_parse_number(&str));
+        cell->mnc = LWCELL_U16(lwcelli_parse_number(&str));
+        cell->lac = LWCELL_U16(lwcelli_parse_hexnumber(&str));
+        if (cell->arfcn != 0 || cell->cell_id != 0) { /* Empty slots are reported with zero values */
+            ++info->neighbours_cnt;
+        }
+    }
+    info->time = lwcell_sys_now();
+    return 1;
+}
+
+#endif /* LWCELL_CFG_CELL_INFO || __DOXYGEN__ */
+
+#if LWCELL_CFG_TIME || __DOXYGEN__
+
+/**
+ * \brief           Parse date and time in `yy/MM/dd,hh:mm:ss` format, used by clock and time zone reports
+ *
+ * Year may also be reported with 4 digits
+ *
+ * \param[in,out]   str: Pointer to pointer to string to parse
+ * \param[out]      dt: Date time structure
+ */
+static void
+prv_parse_date_time(const char** str, struct tm* dt) {
+    int32_t year;
+
+    LWCELL_MEMSET(dt, 0x00, sizeof(*dt));
+    year = lwcelli_parse_number(str);
+    dt->tm_year = (int)(year < 100 ? (year + 100) : (year - 1900));
+    dt->tm_mon = (int)lwcelli_parse_number(str) - 1;
+    dt->tm_mday = (int)lwcelli_parse_number(str);
+    dt->tm_hour = (int)lwcelli_parse_number(str);
+    dt->tm_min = (int)lwcelli_parse_number(str);
+    dt->tm_sec = (int)lwcelli_parse_number(str);
+}
+
+/**
+ * \brief           Parse *PSUTTZ statement with network time
+ *
+ * Format is `*PSUTTZ: <year>,<month>,<day>,<hour>,<min>,<sec>,"<tz>",<dst>`, time is in UTC
+ * and time zone is in units of quarter hours
+ *
+ * \param[in]       str: Input string
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_parse_psuttz(const char* str) {
+    struct tm dt;
+
+    if (*str == '*') {
+        str += 9; /* Advance for *PSUTTZ: */
+    }
+    prv_parse_date_time(&str, &dt);
+    lwcelli_time_set(&dt, LWCELL_I8(lwcelli_parse_number(&str)), 0);
+    return 1;
+}
+
+/**
+ * \brief           Parse +CTZV statement with time zone report
+ *
+ * Some devices report only time zone as `+CTZV: <tz>[,<dst>]`,
+ * others add local time as `+CTZV: <yy/MM/dd>,<hh:mm:ss>,<tz>`
+ *
+ * \param[in]       str: Input string
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_parse_ctzv(const char* str) {
+    if (*str == '+') {
+        str += 7; /* Advance for +CTZV: */
+    }
+    if (strchr(str, '/') != NULL) {
+        struct tm dt;
+
+        prv_parse_date_time(&str, &dt);
+        lwcelli_time_set(&dt, LWCELL_I8(lwcelli_parse_number(&str)), 1);
+    } else {
+        lwcelli_time_tz_set(LWCELL_I8(lwcelli_parse_number(&str)));
+    }
+    return 1;
+}
+
+/**
+ * \brief           Parse +CCLK statement with device clock
+ *
+ * Format is `+CCLK: "<yy/MM/dd>,<hh:mm:ss><tz>"`, time is local time
+ *
+ * \param[in]       str: Input string
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_parse_cclk(const char* str) {
+    struct tm dt;
+
+    if (*str == '+') {
+        str += 7; /* Advance for +CCLK: */
+    }
+    prv_parse_date_time(&str, &dt);
+    if (dt.tm_year < 100 + 10) { /* Clock was never set, device reports default value */
+        return 0;
+    }
+    lwcelli_time_set(&dt, LWCELL_I8(lwcelli_parse_number(&str)), 1);
+    return 1;
+}
+
+/**
+ * \brief           Parse +CIPGSMLOC statement with cell location
+ *
+ * Format is `+CIPGSMLOC: <code>,<lon>,<lat>,<yyyy/MM/dd>,<hh:mm:ss>`, time is in UTC
+ *
+ * \param[in]       str: Input string
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcelli_parse_cipgsmloc(const char* str) {
+    struct tm dt;
+    int32_t lat, lon;
+
+    if (*str == '+') {
+        str += 12; /* Advance for +CIPGSMLOC: */
+    }
+    if (lwcelli_parse_number(&str) != 0) { /* Location is not available */
+        return 0;
+    }
+    if (*str == ',') {
+        ++str;
+    }
+    lon = prv_parse_fixed(&str, 6);
+    lat = prv_parse_fixed(&str, 6);
+    lwcelli_time_location_set(lat, lon);
+
+    prv_parse_date_time(&str, &dt);
+    lwcelli_time_set(&dt, 0, 0);
+    return 1;
+}
+
+#endif /* LWCELL_CFG_TIME || __DOXYGEN__ */
@@ -43,6 +43,145 @@
         }                                                                                                              \
     } while (0)
 
+/* Reference counter access, returns new value */
+#if LWCELL_CFG_PBUF_REF_ATOMIC
+#if LWCELL_PBUF_REF_STDATOMIC
+#define PBUF_REF_INC(p) (atomic_fetch_add_explicit(&(p)->ref, 1, memory_order_relaxed) + 1)
+#define PBUF_REF_DEC(p) (atomic_fetch_sub_explicit(&(p)->ref, 1, memory_order_acq_rel) - 1)
+#else /* LWCELL_PBUF_REF_STDATOMIC */
+#define PBUF_REF_INC(p) lwcell_sys_atomic_add(&(p)->ref, 1)
+#define PBUF_REF_DEC(p) lwcell_sys_atomic_add(&(p)->ref, -1)
+#endif /* !LWCELL_PBUF_REF_STDATOMIC */
+#endif /* LWCELL_CFG_PBUF_REF_ATOMIC */
+
+#if LWCELL_CFG_PBUF_POOL
+
+#define PBUF_POOL_STRIDE(size) LWCELL_MEM_ALIGN(SIZEOF_PBUF_STRUCT + (size))
+#define PBUF_POOL_MEM(size, cnt)                                                                                       \
+    (((PBUF_POOL_STRIDE(size) * (cnt)) + sizeof(void*) - 1) / sizeof(void*) + 1)
+
+/**
+ * \brief           Single size class pool
+ */
+typedef struct {
+    size_t size;        /*!< Payload size of each packet buffer */
+    size_t cnt;         /*!< Number of packet buffers */
+    uint8_t* mem;       /*!< Start of pool memory */
+    lwcell_pbuf_p free; /*!< List of free entries, linked with `next` member */
+    size_t free_cnt;    /*!< Number of free entries */
+    uint32_t hit;       /*!< Allocations served by pool */
+    uint32_t miss;      /*!< Allocations of this class served elsewhere */
+} pbuf_pool_t;
+
+/* Pointer arrays keep memory aligned for packet buffer structure */
+static void* pbuf_pool_mem_small[PBUF_POOL_MEM(LWCELL_CFG_PBUF_POOL_SMALL_SIZE, LWCELL_CFG_PBUF_POOL_SMALL_CNT)];
+static void* pbuf_pool_mem_medium[PBUF_POOL_MEM(LWCELL_CFG_PBUF_POOL_MEDIUM_SIZE, LWCELL_CFG_PBUF_POOL_MEDIUM_CNT)];
+static void* pbuf_pool_mem_large[PBUF_POOL_MEM(LWCELL_CFG_PBUF_POOL_LARGE_SIZE, LWCELL_CFG_PBUF_POOL_LARGE_CNT)];
+
+static pbuf_pool_t pbuf_pools[] = {
+    {
+        .size = LWCELL_CFG_PBUF_POOL_SMALL_SIZE,
+        .cnt = LWCELL_CFG_PBUF_POOL_SMALL_CNT,
+        .mem = (uint8_t*)pbuf_pool_mem_small,
+    },
+    {
+        .size = LWCELL_CFG_PBUF_POOL_MEDIUM_SIZE,
+        .cnt = LWCELL_CFG_PBUF_POOL_MEDIUM_CNT,
+        .mem = (uint8_t*)pbuf_pool_mem_medium,
+    },
+    {
+        .size = LWCELL_CFG_PBUF_POOL_LARGE_SIZE,
+        .cnt = LWCELL_CFG_PBUF_POOL_LARGE_CNT,
+        .mem = (uint8_t*)pbuf_pool_mem_large,
+    },
+};
+static uint8_t pbuf_pools_initialized;
+
+/**
+ * \brief           Get memory for packet buffer from pools
+ * \note            Core must be locked when calling this function
+ * \param[in]       len: Payload length
+ * \return          Memory for packet buffer on success, `NULL` when no pool could serve the request
+ */
+static lwcell_pbuf_p
+pbuf_pool_alloc(size_t len) {
+    lwcell_pbuf_p p;
+    pbuf_pool_t* pool;
+    uint8_t first = 1;
+
+    if (!pbuf_pools_initialized) {
+        for (size_t i = 0; i < LWCELL_ARRAYSIZE(pbuf_pools); ++i) {
+            pool = &pbuf_pools[i];
+            pool->free = NULL;
+            for (size_t j = pool->cnt; j > 0; --j) {
+                p = (lwcell_pbuf_p)(pool->mem + (j - 1) * PBUF_POOL_STRIDE(pool->size));
+                p->next = pool->free;
+                pool->free = p;
+            }
+            pool->free_cnt = pool->cnt;
+        }
+        pbuf_pools_initialized = 1;
+    }
+
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(pbuf_pools); ++i) {
+        pool = &pbuf_pools[i];
+        if (pool->size < len) {
+            continue;
+        }
+        if (pool->free != NULL) {
+            p = pool->free;
+            pool->free = p->next;
+            --pool->free_cnt;
+            ++pool->hit;
+            return p;
+        }
+        if (first) { /* Count miss only for best matching class */
+            ++pool->miss;
+            first = 0;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Give packet buffer memory back to its pool
+ * \note            Core must be locked when calling this function
+ * \param[in]       p: Packet buffer to release
+ * \return          `1` if packet buffer belongs to pool, `0` otherwise
+ */
+static uint8_t
+pbuf_pool_free(lwcell_pbuf_p p) {
+    pbuf_pool_t* pool;
+
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(pbuf_pools); ++i) {
+        pool = &pbuf_pools[i];
+        if ((uint8_t*)p >= pool->mem && (uint8_t*)p < pool->mem + pool->cnt * PBUF_POOL_STRIDE(pool->size)) {
+            p->next = pool->free;
+            pool->free = p;
+            ++pool->free_cnt;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Get largest payload length currently available from pools
+ * \note            Core must be locked when calling this function
+ * \return          Payload size of largest pool with free entry, `0` when all pools are exhausted
+ */
+size_t
+lwcelli_pbuf_pool_free_len(void) {
+    for (size_t i = LWCELL_ARRAYSIZE(pbuf_pools); i > 0; --i) {
+        if (!pbuf_pools_initialized || pbuf_pools[i - 1].free_cnt > 0) {
+            return pbuf_pools[i - 1].size;
+        }
+    }
+    return 0;
+}
+
+#endif /* LWCELL_CFG_PBUF_POOL */
+
 /**
  * \brief           Skip pbufs for desired offset
  * \param[in]       p: Source pbuf to skip
@@ -66,6 +205,55 @@ pbuf_skip(lwcell_pbuf_p p, size_t off, size_t* new_off) {
     return p;
 }
 
+/* Minimal needle length to search with shift table instead of first byte scan */
+#define PBUF_FIND_SHIFT_MIN_LEN 8
+
+/**
+ * \brief           Forward-only position cursor over pbuf chain
+ */
+typedef struct {
+    lwcell_pbuf_p p; /*!< Current pbuf in chain */
+    size_t base;     /*!< Chain offset of first byte in current pbuf */
+} pbuf_cursor_t;
+
+/**
+ * \brief           Get byte at chain position, moving cursor forward as needed
+ * \param[in,out]   c: Cursor, position must not be before current pbuf
+ * \param[in]       pos: Chain position, must be smaller than total chain length
+ * \return          Byte value at position
+ */
+static uint8_t
+pbuf_cursor_at(pbuf_cursor_t* c, size_t pos) {
+    while (pos - c->base >= c->p->len) {
+        c->base += c->p->len;
+        c->p = c->p->next;
+    }
+    return c->p->payload[pos - c->base];
+}
+
+/**
+ * \brief           Compare data with pbuf chain memory, segment by segment
+ * \param[in]       p: Pbuf to start compare
+ * \param[in]       off: Offset in first pbuf, must be smaller than its length
+ * \param[in]       data: Data to compare
+ * \param[in]       len: Length of data, must fit to chain from offset
+ * \return          `1` if memory is equal, `0` otherwise
+ */
+static uint8_t
+pbuf_match(lwcell_pbuf_p p, size_t off, const uint8_t* data, size_t len) {
+    size_t tc;
+
+    for (; p != NULL && len > 0; p = p->next, off = 0) {
+        tc = LWCELL_MIN(p->len - off, len);
+        if (memcmp(p->payload + off, data, tc) != 0) {
+            return 0;
+        }
+        data += tc;
+        len -= tc;
+    }
+    return LWCELL_U8(len == 0);
+}
+
 /**
  * \brief           Allocate packet buffer for network data of specific size
  * \param[in]       len: Length of payload memory to allocate
@@ -73,9 +261,16 @@ pbuf_skip(lwcell_pbuf_p p, size_t off, size_t* new_off) {
  */
 lwcell_pbuf_p
 lwcell_pbuf_new(size_t len) {
-    lwcell_pbuf_p p;
-
-    p = lwcell_mem_malloc(SIZEOF_PBUF_STRUCT + sizeof(*p->payload) * len);
+    lwcell_pbuf_p p = NULL;
+
+#if LWCELL_CFG_PBUF_POOL
+    lwcell_core_lock();
+    p = pbuf_pool_alloc(len);
+    lwcell_core_unlock();
+#endif /* LWCELL_CFG_PBUF_POOL */
+    if (p == NULL) {
+        p = lwcell_mem_malloc_tag(SIZEOF_PBUF_STRUCT + sizeof(*p->payload) * len, LWCELL_MEM_TAG_PBUF);
+    }
     LWCELL_DEBUGW(LWCELL_CFG_DBG_PBUF | LWCELL_DBG_TYPE_TRACE, p == NULL,
                   "[LWCELL PBUF] Failed to allocate %u bytes\r\n", (unsigned)len);
     LWCELL_DEBUGW(LWCELL_CFG_DBG_PBUF | LWCELL_DBG_TYPE_TRACE, p != NULL, "[LWCELL PBUF] Allocated %u bytes on %p\r\n",
@@ -86,10 +281,68 @@ lwcell_pbuf_new(size_t len) {
         p->len = len;                                          /* Set payload length */
         p->payload = (void*)(((char*)p) + SIZEOF_PBUF_STRUCT); /* Set pointer to payload data */
         p->ref = 1;                                            /* Single reference is used on this pbuf */
+#if LWCELL_CFG_INPUT_ZERO_COPY
+        p->ref_mem = NULL; /* Payload follows the structure */
+        p->release_fn = NULL;
+#endif /* LWCELL_CFG_INPUT_ZERO_COPY */
+    }
+    return p;
+}
+
+#if LWCELL_CFG_INPUT_ZERO_COPY || __DOXYGEN__
+
+/**
+ * \brief           Allocate packet buffer which references external memory instead of copying it
+ *
+ * Only packet buffer structure is allocated, payload points directly to `mem`.
+ * Release function is called once last reference to packet buffer is freed,
+ * after which memory must not be referenced by the stack anymore.
+ *
+ * \note            Referenced memory must stay valid and unchanged until release function is called
+ * \param[in]       mem: Pointer to external memory with payload data
+ * \param[in]       len: Length of external memory in units of bytes
+ * \param[in]       release_fn: Function called when memory is not used anymore. Can be set to `NULL`
+ * \param[in]       arg: Custom user argument passed to release function
+ * \return          Pointer to allocated packet buffer, `NULL` otherwise
+ */
+lwcell_pbuf_p
+lwcell_pbuf_new_ref(const void* mem, size_t len, lwcell_pbuf_release_fn release_fn, void* arg) {
+    lwcell_pbuf_p p;
+
+    LWCELL_ASSERT0(mem != NULL);
+
+    p = lwcell_mem_malloc_tag(SIZEOF_PBUF_STRUCT, LWCELL_MEM_TAG_PBUF);
+    LWCELL_DEBUGW(LWCELL_CFG_DBG_PBUF | LWCELL_DBG_TYPE_TRACE, p == NULL,
+                  "[LWCELL PBUF] Failed to allocate reference for %u bytes\r\n", (unsigned)len);
+    LWCELL_DEBUGW(LWCELL_CFG_DBG_PBUF | LWCELL_DBG_TYPE_TRACE, p != NULL,
+                  "[LWCELL PBUF] Allocated reference to %u bytes on %p\r\n", (unsigned)len, (void*)p);
+    if (p != NULL) {
+        p->next = NULL;
+        p->tot_len = len;
+        p->len = len;
+        p->payload = (void*)mem; /* Payload is external memory */
+        p->ref = 1;
+        p->ref_mem = mem;
+        p->ref_len = len;
+        p->release_fn = release_fn;
+        p->release_arg = arg;
     }
     return p;
 }
 
+/**
+ * \brief           Check if packet buffer references external memory
+ * \param[in]       pbuf: Packet buffer to check
+ * \return          `1` if payload is external memory, `0` otherwise
+ * \sa              lwcell_pbuf_new_ref
+ */
+uint8_t
+lwcell_pbuf_is_ref(const lwcell_pbuf_p pbuf) {
+    return pbuf != NULL && pbuf->ref_mem != NULL;
+}
+
+#endif /* LWCELL_CFG_INPUT_ZERO_COPY || __DOXYGEN__ */
+
 /**
  * \brief           Free previously allocated packet buffer
  * \note            Application must not use reference to pbuf after the call to this function.
@@ -114,14 +367,30 @@ lwcell_pbuf_free(lwcell_pbuf_p pbuf) {
      */
     cnt = 0;
     for (p = pbuf; p != NULL;) {
+#if LWCELL_CFG_PBUF_REF_ATOMIC
+        ref = PBUF_REF_DEC(p); /* Decrease current value without core lock */
+#else                          /* LWCELL_CFG_PBUF_REF_ATOMIC */
         lwcell_core_lock();
         ref = --p->ref; /* Decrease current value and save it */
         lwcell_core_unlock();
+#endif /* LWCELL_CFG_PBUF_REF_ATOMIC */
         if (ref == 0) { /* Did we reach 0 and are ready to free it? */
             LWCELL_DEBUGF(LWCELL_CFG_DBG_PBUF | LWCELL_DBG_TYPE_TRACE,
                           "[LWCELL PBUF] Deallocating %p with len/tot_len: %u/%u\r\n", (void*)p, (unsigned)p->len,
                           (unsigned)p->tot_len);
-            pn = p->next;                  /* Save next entry */
+            pn = p->next; /* Save next entry */
+#if LWCELL_CFG_INPUT_ZERO_COPY
+            if (p->ref_mem != NULL && p->release_fn != NULL) {
+                p->release_fn(p->ref_mem, p->ref_len, p->release_arg); /* Give memory back to its owner */
+            }
+#endif                                     /* LWCELL_CFG_INPUT_ZERO_COPY */
+#if LWCELL_CFG_PBUF_POOL
+            lwcell_core_lock();
+            if (pbuf_pool_free(p)) {
+                p = NULL;
+            }
+            lwcell_core_unlock();
+#endif                                     /* LWCELL_CFG_PBUF_POOL */
             lwcell_mem_free_s((void**)&p); /* Free memory for pbuf */
             p = pn;                        /* Restore with next entry */
             ++cnt;                         /* Increase number of freed pbufs */
@@ -267,7 +536,11 @@ lwcellr_t
 lwcell_pbuf_ref(lwcell_pbuf_p pbuf) {
     LWCELL_ASSERT(pbuf != NULL);
 
+#if LWCELL_CFG_PBUF_REF_ATOMIC
+    (void)PBUF_REF_INC(pbuf);
+#else  /* LWCELL_CFG_PBUF_REF_ATOMIC */
     ++pbuf->ref; /* Increase reference count for pbuf */
+#endif /* !LWCELL_CFG_PBUF_REF_ATOMIC */
     return lwcellOK;
 }
 
@@ -396,14 +669,62 @@ lwcell_pbuf_get_at(const lwcell_pbuf_p pbuf, size_t pos, uint8_t* el) {
  */
 size_t
 lwcell_pbuf_memfind(const lwcell_pbuf_p pbuf, const void* needle, size_t len, size_t off) {
-    if (pbuf != NULL && needle != NULL && pbuf->tot_len >= (len + off)) { /* Check if valid entries */
-        /*
-         * Try entire buffer element by element
-         * and in case we have a match, report it
-         */
-        for (size_t i = off; i <= pbuf->tot_len - len; ++i) {
-            if (!lwcell_pbuf_memcmp(pbuf, needle, len, i)) { /* Check if identical */
-                return i;                                    /* We have a match! */
+    const uint8_t* d = needle;
+    pbuf_cursor_t c;
+    size_t i, last;
+
+    if (pbuf == NULL || needle == NULL || len == 0 || pbuf->tot_len < (len + off)) { /* Check if valid entries */
+        return LWCELL_SIZET_MAX;
+    }
+    last = pbuf->tot_len - len; /* Last position where needle still fits */
+
+    /* Find start pbuf once, search moves forward through chain only */
+    c.p = pbuf;
+    c.base = 0;
+    for (; c.p->len <= off - c.base; c.p = c.p->next) {
+        c.base += c.p->len;
+    }
+
+    if (len < PBUF_FIND_SHIFT_MIN_LEN) {
+        const uint8_t* f;
+        size_t loff, avail;
+
+        /* Scan each contiguous segment for first needle byte, compare rest across segments */
+        for (i = off; i <= last;) {
+            loff = i - c.base;
+            avail = LWCELL_MIN(c.p->len - loff, last - i + 1);
+            f = memchr(c.p->payload + loff, d[0], avail);
+            if (f == NULL) {
+                i += avail;
+            } else {
+                loff = (size_t)(f - c.p->payload);
+                if (pbuf_match(c.p, loff, d, len)) {
+                    return c.base + loff; /* We have a match! */
+                }
+                i = c.base + loff + 1;
+            }
+            if (i <= last && i - c.base >= c.p->len) { /* Move to next segment */
+                c.base += c.p->len;
+                c.p = c.p->next;
+            }
+        }
+    } else {
+        pbuf_cursor_t e = c;
+        uint8_t shift[256], ch = 0;
+        size_t max_shift = LWCELL_MIN(len, 0xFF);
+
+        /* Horspool search, shift is limited to byte size to keep table on stack small */
+        LWCELL_MEMSET(shift, (int)max_shift, sizeof(shift));
+        for (i = 0; i < len - 1; ++i) {
+            shift[d[i]] = LWCELL_U8(LWCELL_MIN(len - 1 - i, max_shift));
+        }
+        for (i = off; i <= last; i += shift[ch]) {
+            ch = pbuf_cursor_at(&e, i + len - 1);
+            if (ch == d[len - 1]) {
+                pbuf_cursor_at(&c, i);
+                if (pbuf_match(c.p, i - c.base, d, len)) {
+                    return i; /* We have a match! */
+                }
             }
         }
     }
@@ -436,8 +757,6 @@ lwcell_pbuf_strfind(const lwcell_pbuf_p pbuf, const char* str, size_t off) {
 size_t
 lwcell_pbuf_memcmp(const lwcell_pbuf_p pbuf, const void* data, size_t len, size_t offset) {
     lwcell_pbuf_p p;
-    uint8_t el;
-    const uint8_t* d = data;
 
     if (pbuf == NULL || data == NULL || len == 0 /* Input parameters check */
         || pbuf->tot_len < (offset + len)) {     /* Check of valid ranges */
@@ -454,14 +773,10 @@ lwcell_pbuf_memcmp(const lwcell_pbuf_p pbuf, const void* data, size_t len, size_
 
     /*
      * We have known starting pbuf.
-     * Now it is time to check byte by byte from pbuf and memory
-     *
-     * Use byte by byte read function to inspect bytes separatelly
+     * Now compare memory of each segment in the chain
      */
-    for (size_t i = 0; i < len; ++i) {
-        if (!lwcell_pbuf_get_at(p, offset + i, &el) || el != d[i]) { /* Get value from pbuf at specific offset */
-            return offset + 1;                                       /* Return value from offset where it failed */
-        }
+    if (!pbuf_match(p, offset, data, len)) {
+        return offset + 1; /* Return value from offset where it failed */
     }
     return 0; /* Memory matches at this point */
 }
@@ -509,6 +824,67 @@ lwcell_pbuf_get_linear_addr(const lwcell_pbuf_p pbuf, size_t offset, size_t* new
     return &p->payload[offset]; /* Return memory at desired offset */
 }
 
+/**
+ * \brief           Get contiguous memory of pbuf range, copy it only when range spans multiple pbufs
+ * \param[in]       pbuf: Pbuf to get data from
+ * \param[in]       offset: Start offset of range
+ * \param[in]       len: Length of range in units of bytes
+ * \param[out]      buff: Memory of at least `len` bytes, used when range is not in single pbuf.
+ *                      Set to `NULL` to only get memory when no copy is necessary
+ * \return          Pointer to pbuf memory or `buff` with range data, `NULL` when range is out of pbuf
+ *                      or copy is necessary and `buff` is `NULL`
+ */
+void*
+lwcell_pbuf_peek_linear(const lwcell_pbuf_p pbuf, size_t offset, size_t len, void* buff) {
+    size_t l;
+    uint8_t* d;
+
+    if (pbuf == NULL || len == 0 || offset + len > pbuf->tot_len) {
+        return NULL;
+    }
+    if ((d = lwcell_pbuf_get_linear_addr(pbuf, offset, &l)) != NULL && l >= len) {
+        return d; /* Range is in single pbuf */
+    }
+    if (buff == NULL || lwcell_pbuf_copy(pbuf, buff, len, offset) != len) {
+        return NULL;
+    }
+    return buff;
+}
+
+/**
+ * \brief           Get pbuf with entire chain data in single contiguous memory
+ *
+ * Pbuf is returned unchanged when it is not a chain. Otherwise new pbuf is allocated
+ * for total length and data of every pbuf in chain is copied to it.
+ * IP and port of first pbuf are kept.
+ *
+ * \note            Reference of input pbuf is released when new pbuf is returned.
+ *                  On allocation failure, input pbuf is not modified and it is still owned by caller
+ * \param[in]       pbuf: Pbuf chain to linearize
+ * \return          Pbuf with single contiguous memory on success, `NULL` otherwise
+ */
+lwcell_pbuf_p
+lwcell_pbuf_linearize(lwcell_pbuf_p pbuf) {
+    lwcell_pbuf_p p, q;
+    uint8_t* d;
+
+    if (pbuf == NULL || pbuf->next == NULL) {
+        return pbuf; /* Already linear */
+    }
+    if ((p = lwcell_pbuf_new(pbuf->tot_len)) == NULL) {
+        return NULL;
+    }
+    d = p->payload;
+    for (q = pbuf; q != NULL; q = q->next) {
+        LWCELL_MEMCPY(d, q->payload, q->len);
+        d += q->len;
+    }
+    LWCELL_MEMCPY(&p->ip, &pbuf->ip, sizeof(pbuf->ip));
+    p->port = pbuf->port;
+    lwcell_pbuf_free(pbuf);
+    return p;
+}
+
 /**
  * \brief           Get data pointer from packet buffer
  * \param[in]       pbuf: Packet buffer
@@ -571,6 +947,12 @@ lwcell_pbuf_advance(lwcell_pbuf_p pbuf, int len) {
         if (((uint8_t*)pbuf + SIZEOF_PBUF_STRUCT) < (pbuf->payload + len)) {
             process = 1;
         }
+#if LWCELL_CFG_INPUT_ZERO_COPY
+        /* Payload of reference pbuf cannot move before beginning of referenced memory */
+        if (pbuf->ref_mem != NULL) {
+            process = (const uint8_t*)pbuf->ref_mem <= (pbuf->payload + len);
+        }
+#endif /* LWCELL_CFG_INPUT_ZERO_COPY */
     }
     if (process) {
         pbuf->payload += len; /* Increase payload pointer */
@@ -613,3 +995,28 @@ lwcell_pbuf_dump(lwcell_pbuf_p p, uint8_t seq) {
         LWCELL_DEBUGF(LWCELL_CFG_DBG_PBUF | LWCELL_DBG_TYPE_TRACE, "[LWCELL PBUF] Dump end\r\n");
     }
 }
+
+#if LWCELL_CFG_PBUF_POOL || __DOXYGEN__
+
+/**
+ * \brief           Get statistics of packet buffer pool
+ * \param[in]       idx: Pool index, `0` for small, `1` for medium and `2` for large pool
+ * \param[out]      stats: Pointer to structure to fill with statistics
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcell_pbuf_pool_get_stats(size_t idx, lwcell_pbuf_pool_stats_t* stats) {
+    if (stats == NULL || idx >= LWCELL_ARRAYSIZE(pbuf_pools)) {
+        return 0;
+    }
+    lwcell_core_lock();
+    stats->size = pbuf_pools[idx].size;
+    stats->cnt = pbuf_pools[idx].cnt;
+    stats->free = pbuf_pools_initialized ? pbuf_pools[idx].free_cnt : pbuf_pools[idx].cnt;
+    stats->hit = pbuf_pools[idx].hit;
+    stats->miss = pbuf_pools[idx].miss;
+    lwcell_core_unlock();
+    return 1;
+}
+
+#endif /* LWCELL_CFG_PBUF_POOL || __DOXYGEN__ */
@@ -37,6 +37,9 @@
 #if LWCELL_CFG_PHONEBOOK || __DOXYGEN__
 
 #if !__DOXYGEN__
+/* Time given to each entry of bulk import, in units of milliseconds */
+#define PB_WRITE_TIMEOUT 5000
+
 #define CHECK_ENABLED()                                                                                                \
     if (!(check_enabled() == lwcellOK)) {                                                                              \
         return lwcellERRNOTENABLED;                                                                                    \
@@ -85,7 +88,7 @@ lwcellr_t
 lwcell_pb_enable(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
     LWCELL_MSG_VAR_DEFINE(msg);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE_HDR);
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_PHONEBOOK_ENABLE;
     LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CPBS_GET_OPT;
@@ -133,7 +136,7 @@ lwcell_pb_add(lwcell_mem_t mem, const char* name, const char* num, lwcell_number
     CHECK_ENABLED(); /* Check if enabled */
     LWCELL_ASSERT(check_mem(mem, 1) == lwcellOK);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(pb_write));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CPBW_SET;
     if (mem == LWCELL_MEM_CURRENT) {                       /* Should be always false */
@@ -189,7 +192,7 @@ lwcell_pb_edit(lwcell_mem_t mem, size_t pos, const char* name, const char* num,
     CHECK_ENABLED(); /* Check if enabled */
     LWCELL_ASSERT(check_mem(mem, 1) == lwcellOK);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(pb_write));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CPBW_SET;
     if (mem == LWCELL_MEM_CURRENT) {                       /* Should be always false */
@@ -225,7 +228,7 @@ lwcell_pb_delete(lwcell_mem_t mem, size_t pos, const lwcell_api_cmd_evt_fn evt_f
     CHECK_ENABLED(); /* Check if enabled */
     LWCELL_ASSERT(check_mem(mem, 1) == lwcellOK);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(pb_write));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CPBW_SET;
     if (mem == LWCELL_MEM_CURRENT) {                       /* Should be always false */
@@ -242,29 +245,30 @@ lwcell_pb_delete(lwcell_mem_t mem, size_t pos, const lwcell_api_cmd_evt_fn evt_f
 }
 
 /**
- * \brief           List entires from specific memory
+ * \brief           Start phonebook list operation
  * \param[in]       mem: Memory to use to save entry. Use \ref LWCELL_MEM_CURRENT to use current memory
  * \param[in]       start_index: Start position in memory to list
- * \param[out]      entries: Pointer to array to save entries
+ * \param[out]      entries: Pointer to array to save entries or scratch entry when `entry_fn` is set
  * \param[in]       etr: Number of entries to read
  * \param[out]      er: Pointer to output variable to save entries listed
+ * \param[in]       entry_fn: Entry callback function or `NULL` to fill array
+ * \param[in]       entry_arg: Custom argument for entry callback function
  * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
  * \param[in]       evt_arg: Custom argument for event callback function
  * \param[in]       blocking: Status whether command should be blocking or not
  * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
  */
-lwcellr_t
-lwcell_pb_list(lwcell_mem_t mem, size_t start_index, lwcell_pb_entry_t* entries, size_t etr, size_t* er,
-               const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+static lwcellr_t
+prv_pb_list(lwcell_mem_t mem, size_t start_index, lwcell_pb_entry_t* entries, size_t etr, size_t* er,
+            lwcell_pb_list_fn entry_fn, void* entry_arg, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+            const uint32_t blocking) {
     LWCELL_MSG_VAR_DEFINE(msg);
 
     LWCELL_ASSERT(start_index);
-    LWCELL_ASSERT(entries != NULL);
-    LWCELL_ASSERT(etr > 0);
     CHECK_ENABLED();
     LWCELL_ASSERT(check_mem(mem, 1) == lwcellOK);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(pb_list));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
 
     if (er != NULL) {
@@ -283,10 +287,118 @@ lwcell_pb_list(lwcell_mem_t mem, size_t start_index, lwcell_pb_entry_t* entries,
     LWCELL_MSG_VAR_REF(msg).msg.pb_list.entries = entries;
     LWCELL_MSG_VAR_REF(msg).msg.pb_list.etr = etr;
     LWCELL_MSG_VAR_REF(msg).msg.pb_list.er = er;
+    LWCELL_MSG_VAR_REF(msg).msg.pb_list.entry_fn = entry_fn;
+    LWCELL_MSG_VAR_REF(msg).msg.pb_list.entry_arg = entry_arg;
 
     return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
 }
 
+/**
+ * \brief           List entires from specific memory
+ * \param[in]       mem: Memory to use to save entry. Use \ref LWCELL_MEM_CURRENT to use current memory
+ * \param[in]       start_index: Start position in memory to list
+ * \param[out]      entries: Pointer to array to save entries
+ * \param[in]       etr: Number of entries to read
+ * \param[out]      er: Pointer to output variable to save entries listed
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_pb_list(lwcell_mem_t mem, size_t start_index, lwcell_pb_entry_t* entries, size_t etr, size_t* er,
+               const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    LWCELL_ASSERT(entries != NULL);
+    LWCELL_ASSERT(etr > 0);
+
+    return prv_pb_list(mem, start_index, entries, etr, er, NULL, NULL, evt_fn, evt_arg, blocking);
+}
+
+/**
+ * \brief           List entries from specific memory, one entry at a time
+ *
+ * Memory is selected once and read from `start_index` to its end with chunked `AT+CPBR` commands,
+ * \ref LWCELL_CFG_PHONEBOOK_READ_CHUNK positions each. Every entry is parsed to single scratch entry
+ * and passed to `entry_fn`, memory use does not depend on phonebook size.
+ * `entry_fn` is called from processing thread, it shall copy data it needs and return quickly
+ *
+ * \param[in]       mem: Memory to read entries from. Use \ref LWCELL_MEM_CURRENT to use current memory
+ * \param[in]       start_index: Start position in memory to list. Use position after last received entry to resume
+ * \param[in]       entry: Scratch entry reused for every entry. It must stay valid until command finishes
+ * \param[in]       entry_fn: Callback function called for every listed entry
+ * \param[in]       entry_arg: Custom argument for entry callback function
+ * \param[out]      er: Pointer to output variable to save number of listed entries. Set to `NULL` if not used
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_pb_list_iter(lwcell_mem_t mem, size_t start_index, lwcell_pb_entry_t* entry, lwcell_pb_list_fn entry_fn,
+                    void* entry_arg, size_t* er, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                    const uint32_t blocking) {
+    LWCELL_ASSERT(entry != NULL);
+    LWCELL_ASSERT(entry_fn != NULL);
+
+    return prv_pb_list(mem, start_index, entry, 1, er, entry_fn, entry_arg, evt_fn, evt_arg, blocking);
+}
+
+/**
+ * \brief           Write multiple entries to specific memory
+ *
+ * Memory is selected once, then entries are requested one by one from `fn`
+ * and written back to back with `AT+CPBW`, all within single command.
+ * Result of every entry is reported with \ref LWCELL_EVT_PB_IMPORT event,
+ * failed entry does not stop import of next ones.
+ * `fn` is called from processing thread, it shall fill entry and return quickly
+ *
+ * \param[in]       mem: Memory to write entries to. Use \ref LWCELL_MEM_CURRENT to use current memory
+ * \param[in]       entry: Scratch entry reused for every entry. It must stay valid until command finishes
+ * \param[in]       etw: Maximal number of entries to write
+ * \param[in]       fn: Callback function called to get every entry to write
+ * \param[in]       arg: Custom argument for import callback function
+ * \param[out]      ew: Pointer to output variable to save number of processed entries.
+ *                      Use it as first index to resume interrupted import. Set to `NULL` if not used
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK when all entries were written, member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_pb_import(lwcell_mem_t mem, lwcell_pb_entry_t* entry, size_t etw, lwcell_pb_import_fn fn, void* arg,
+                 size_t* ew, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(entry != NULL);
+    LWCELL_ASSERT(etw > 0);
+    LWCELL_ASSERT(fn != NULL);
+    CHECK_ENABLED(); /* Check if enabled */
+    LWCELL_ASSERT(check_mem(mem, 1) == lwcellOK);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(pb_import));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+
+    if (ew != NULL) {
+        *ew = 0;
+    }
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_PHONEBOOK_IMPORT;
+    if (mem == LWCELL_MEM_CURRENT) {                       /* Should be always false */
+        LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CPBS_GET; /* First get memory */
+    } else {
+        LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CPBS_SET; /* First set memory */
+    }
+
+    LWCELL_MSG_VAR_REF(msg).msg.pb_import.mem = mem;
+    LWCELL_MSG_VAR_REF(msg).msg.pb_import.entry = entry;
+    LWCELL_MSG_VAR_REF(msg).msg.pb_import.fn = fn;
+    LWCELL_MSG_VAR_REF(msg).msg.pb_import.arg = arg;
+    LWCELL_MSG_VAR_REF(msg).msg.pb_import.etw = etw;
+    LWCELL_MSG_VAR_REF(msg).msg.pb_import.ew = ew;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd,
+                                             LWCELL_U32(etw + 2) * PB_WRITE_TIMEOUT);
+}
+
 /**
  * \brief           Search for entires with specific name from specific memory
  * \note            Search works by entry name only. Phone number search is not available
@@ -311,7 +423,7 @@ lwcell_pb_search(lwcell_mem_t mem, const char* search, lwcell_pb_entry_t* entrie
     CHECK_ENABLED(); /* Check if enabled */
     LWCELL_ASSERT(check_mem(mem, 1) == lwcellOK);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(pb_search));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
 
     if (er != NULL) {
@@ -334,4 +446,301 @@ lwcell_pb_search(lwcell_mem_t mem, const char* search, lwcell_pb_entry_t* entrie
     return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
 }
 
+#if LWCELL_CFG_PHONEBOOK_MIRROR || __DOXYGEN__
+
+/**
+ * \brief           Normalize phone number to its last \ref LWCELL_CFG_PHONEBOOK_MIRROR_DIGITS digits
+ * \param[in]       num: Phone number to normalize
+ * \param[out]      out: Output buffer, at least `LWCELL_CFG_PHONEBOOK_MIRROR_DIGITS + 1` bytes long
+ * \return          Number of digits written to output buffer
+ */
+static size_t
+prv_mirror_normalize(const char* num, char* out) {
+    size_t digits = 0, skip, len = 0;
+
+    for (const char* c = num; *c != '\0'; ++c) {
+        if (LWCELL_CHARISNUM(*c)) {
+            ++digits;
+        }
+    }
+    skip = digits > LWCELL_CFG_PHONEBOOK_MIRROR_DIGITS ? digits - LWCELL_CFG_PHONEBOOK_MIRROR_DIGITS : 0;
+    for (const char* c = num; *c != '\0'; ++c) {
+        if (LWCELL_CHARISNUM(*c)) {
+            if (skip > 0) {
+                --skip;
+            } else {
+                out[len++] = *c;
+            }
+        }
+    }
+    out[len] = '\0';
+    return len;
+}
+
+/**
+ * \brief           Calculate FNV-1a hash of normalized phone number
+ * \param[in]       norm: Normalized phone number
+ * \return          Hash value
+ */
+static uint32_t
+prv_mirror_hash(const char* norm) {
+    uint32_t hash = 2166136261UL;
+
+    for (; *norm != '\0'; ++norm) {
+        hash = (hash ^ LWCELL_U8(*norm)) * 16777619UL;
+    }
+    return hash;
+}
+
+/**
+ * \brief           Remove entry at specific position from mirror
+ * \param[in]       pos: Entry position in phonebook memory
+ */
+static void
+prv_mirror_remove(size_t pos) {
+    lwcell_pb_mirror_t* m = &lwcell.m.pb.mirror;
+    uint16_t* link;
+
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(m->slots); ++i) {
+        if (m->slots[i].entry.pos != pos) {
+            continue;
+        }
+        /* Unlink slot from its bucket chain */
+        for (link = &m->buckets[m->slots[i].hash % LWCELL_ARRAYSIZE(m->buckets)]; *link != 0;
+             link = &m->slots[*link - 1].next) {
+            if (*link == i + 1) {
+                *link = m->slots[i].next;
+                break;
+            }
+        }
+        LWCELL_MEMSET(&m->slots[i], 0x00, sizeof(m->slots[i]));
+        break;
+    }
+}
+
+/**
+ * \brief           Copy string with truncation to fixed size buffer
+ * \param[out]      dst: Destination buffer
+ * \param[in]       src: Source string
+ * \param[in]       dst_size: Size of destination buffer including `NULL` termination
+ */
+static void
+prv_mirror_strcpy(char* dst, const char* src, size_t dst_size) {
+    size_t len = LWCELL_MIN(strlen(src), dst_size - 1);
+
+    LWCELL_MEMCPY(dst, src, len);
+    dst[len] = '\0';
+}
+
+/**
+ * \brief           Clear phonebook mirror before new load
+ * \note            Mirror stays invalid until load finishes successfully
+ * \param[in]       mem: Memory mirror is loaded from
+ * \param[in]       total: Size of memory in units of entries
+ */
+void
+lwcelli_pb_mirror_reset(lwcell_mem_t mem, size_t total) {
+    LWCELL_MEMSET(&lwcell.m.pb.mirror, 0x00, sizeof(lwcell.m.pb.mirror));
+    lwcell.m.pb.mirror.mem = mem;
+    lwcell.m.pb.mirror.total = total;
+}
+
+/**
+ * \brief           Insert entry to mirror or replace existing one at the same position
+ * \param[in]       entry: Entry to insert. Entry position must be greater than `0`
+ * \return          `1` on success, `0` if mirror has no free slot
+ */
+uint8_t
+lwcelli_pb_mirror_put(const lwcell_pb_entry_t* entry) {
+    lwcell_pb_mirror_t* m = &lwcell.m.pb.mirror;
+    char norm[LWCELL_CFG_PHONEBOOK_MIRROR_DIGITS + 1];
+    size_t b;
+
+    prv_mirror_remove(entry->pos);
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(m->slots); ++i) {
+        if (m->slots[i].entry.pos == 0) {
+            prv_mirror_normalize(entry->number, norm);
+            m->slots[i].entry = *entry;
+            m->slots[i].hash = prv_mirror_hash(norm);
+
+            /* Link slot to the head of its bucket */
+            b = m->slots[i].hash % LWCELL_ARRAYSIZE(m->buckets);
+            m->slots[i].next = m->buckets[b];
+            m->buckets[b] = LWCELL_U16(i + 1);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Get first free position in phonebook memory for new entry
+ * \param[in]       mem: Memory new entry is written to
+ * \return          Free position, or `0` if mirror is not valid for memory or memory is full
+ */
+size_t
+lwcelli_pb_mirror_free_pos(lwcell_mem_t mem) {
+    lwcell_pb_mirror_t* m = &lwcell.m.pb.mirror;
+    size_t i;
+
+    if (mem == LWCELL_MEM_CURRENT) {
+        mem = lwcell.m.pb.mem.current;
+    }
+    if (!m->valid || m->mem != mem) {
+        return 0;
+    }
+    for (size_t pos = 1; pos <= m->total; ++pos) {
+        for (i = 0; i < LWCELL_ARRAYSIZE(m->slots) && m->slots[i].entry.pos != pos; ++i) {}
+        if (i == LWCELL_ARRAYSIZE(m->slots)) {
+            return pos;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Find mirror entry matching phone number
+ * \param[in]       num: Phone number in any format
+ * \return          Pointer to entry on success, `NULL` if mirror is not valid or number is not found
+ */
+const lwcell_pb_entry_t*
+lwcelli_pb_mirror_lookup(const char* num) {
+    lwcell_pb_mirror_t* m = &lwcell.m.pb.mirror;
+    char norm[LWCELL_CFG_PHONEBOOK_MIRROR_DIGITS + 1], slot_norm[LWCELL_CFG_PHONEBOOK_MIRROR_DIGITS + 1];
+    uint32_t hash;
+
+    if (!m->valid || prv_mirror_normalize(num, norm) == 0) {
+        return NULL;
+    }
+    hash = prv_mirror_hash(norm);
+    for (uint16_t s = m->buckets[hash % LWCELL_ARRAYSIZE(m->buckets)]; s != 0; s = m->slots[s - 1].next) {
+        if (m->slots[s - 1].hash == hash) {
+            prv_mirror_normalize(m->slots[s - 1].entry.number, slot_norm);
+            if (!strcmp(norm, slot_norm)) {
+                return &m->slots[s - 1].entry;
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Update mirror after phonebook write command finished
+ * \param[in]       msg: Write message with `pb_write` data
+ * \param[in]       is_ok: Status whether write succeeded
+ */
+void
+lwcelli_pb_mirror_write_finished(lwcell_msg_t* msg, uint8_t is_ok) {
+    lwcell_pb_mirror_t* m = &lwcell.m.pb.mirror;
+    lwcell_pb_entry_t entry;
+    lwcell_mem_t mem;
+
+    mem = msg->msg.pb_write.mem == LWCELL_MEM_CURRENT ? lwcell.m.pb.mem.current : msg->msg.pb_write.mem;
+    if (!is_ok || !m->valid || m->mem != mem) {
+        return;
+    }
+    if (msg->msg.pb_write.del) {
+        prv_mirror_remove(msg->msg.pb_write.pos);
+    } else {
+        LWCELL_MEMSET(&entry, 0x00, sizeof(entry));
+        entry.pos = msg->msg.pb_write.pos;
+        entry.type = msg->msg.pb_write.type;
+        prv_mirror_strcpy(entry.name, msg->msg.pb_write.name, sizeof(entry.name));
+        prv_mirror_strcpy(entry.number, msg->msg.pb_write.num, sizeof(entry.number));
+        lwcelli_pb_mirror_entry_written(mem, &entry);
+    }
+}
+
+/**
+ * \brief           Update mirror after entry was successfully written to phonebook memory
+ * \param[in]       mem: Memory entry was written to. Use \ref LWCELL_MEM_CURRENT for current memory
+ * \param[in]       entry: Written entry. Position `0` means position was chosen by device
+ */
+void
+lwcelli_pb_mirror_entry_written(lwcell_mem_t mem, const lwcell_pb_entry_t* entry) {
+    lwcell_pb_mirror_t* m = &lwcell.m.pb.mirror;
+
+    if (mem == LWCELL_MEM_CURRENT) {
+        mem = lwcell.m.pb.mem.current;
+    }
+    if (!m->valid || m->mem != mem) {
+        return;
+    }
+    if (entry->pos == 0) {
+        m->valid = 0; /* Position chosen by device is unknown, mirror must be reloaded */
+    } else if (!lwcelli_pb_mirror_put(entry)) {
+        m->valid = 0; /* No space left, mirror no longer reflects phonebook */
+    }
+}
+
+/**
+ * \brief           Load phonebook mirror from specific memory
+ *
+ * Function reads entire memory with chunked `AT+CPBR` commands
+ * and keeps a RAM copy of all entries, indexed by normalized phone number.
+ * Later add, edit or delete operations on the same memory update mirror accordingly.
+ *
+ * \note            Load fails if memory holds more than \ref LWCELL_CFG_PHONEBOOK_MIRROR_SIZE entries
+ * \param[in]       mem: Memory to mirror. Use \ref LWCELL_MEM_CURRENT to use current memory
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_pb_mirror_load(lwcell_mem_t mem, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                      const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    CHECK_ENABLED(); /* Check if enabled */
+    LWCELL_ASSERT(check_mem(mem, 1) == lwcellOK);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(pb_mirror));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_PHONEBOOK_MIRROR_LOAD;
+    if (mem == LWCELL_MEM_CURRENT) {                       /* Should be always false */
+        LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CPBS_GET; /* First get memory */
+    } else {
+        LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CPBS_SET; /* First set memory */
+    }
+
+    LWCELL_MSG_VAR_REF(msg).msg.pb_mirror.mem = mem;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
+}
+
+/**
+ * \brief           Find phonebook entry by phone number in RAM mirror
+ *
+ * Only last \ref LWCELL_CFG_PHONEBOOK_MIRROR_DIGITS digits are compared,
+ * so numbers in international and national format match the same entry.
+ * Function does not communicate with device.
+ *
+ * \param[in]       num: Phone number to find, for example caller number from \ref LWCELL_EVT_CALL_CHANGED event
+ * \param[out]      entry: Pointer to output entry. Set to `NULL` to only check presence
+ * \return          \ref lwcellOK if found, \ref lwcellERRNOTENABLED if mirror is not loaded,
+ *                      \ref lwcellERR if number is not in phonebook
+ */
+lwcellr_t
+lwcell_pb_mirror_find(const char* num, lwcell_pb_entry_t* entry) {
+    const lwcell_pb_entry_t* e;
+    lwcellr_t res = lwcellERR;
+
+    LWCELL_ASSERT(num != NULL);
+
+    lwcell_core_lock();
+    if (!lwcell.m.pb.mirror.valid) {
+        res = lwcellERRNOTENABLED;
+    } else if ((e = lwcelli_pb_mirror_lookup(num)) != NULL) {
+        if (entry != NULL) {
+            *entry = *e;
+        }
+        res = lwcellOK;
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+#endif /* LWCELL_CFG_PHONEBOOK_MIRROR || __DOXYGEN__ */
+
 #endif /* LWCELL_CFG_PHONEBOOK || __DOXYGEN__ */
@@ -36,4 +36,146 @@
 
 #if LWCELL_CFG_PING || __DOXYGEN__
 
+/* Per-probe timeout used by device, in units of milliseconds */
+#define PING_PROBE_TIMEOUT 10000
+
+/**
+ * \brief           Send ping run to producer queue
+ * \param[in]       host: Host name or IP address
+ * \param[in]       count: Number of probes
+ * \param[out]      stats: Pointer to output statistics variable
+ * \param[in]       periodic_id: Periodic probe ID or `0` for single run
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+prv_ping_send(const char* host, uint16_t count, lwcell_ping_stats_t* stats, uint8_t periodic_id,
+              const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(ping));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CIPPING;
+    LWCELL_MSG_VAR_REF(msg).msg.ping.host = host;
+    LWCELL_MSG_VAR_REF(msg).msg.ping.count = count;
+    LWCELL_MSG_VAR_REF(msg).msg.ping.stats_out = stats;
+    LWCELL_MSG_VAR_REF(msg).msg.ping.periodic_id = periodic_id;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd,
+                                             (uint32_t)count * PING_PROBE_TIMEOUT + 10000);
+}
+
+/**
+ * \brief           Periodic probe timeout callback function
+ * \param[in]       arg: Custom user argument
+ */
+static void
+prv_ping_timeout_fn(void* arg) {
+    if (lwcell.ping.interval == 0) {
+        return;
+    }
+    if (prv_ping_send(lwcell.ping.host, lwcell.ping.count, NULL, lwcell.ping.id, NULL, NULL, 0) != lwcellOK) {
+        /* Queue is full, try again with next interval */
+        lwcell_timeout_start(&lwcell.ping.timeout, lwcell.ping.interval, prv_ping_timeout_fn, arg);
+    }
+}
+
+/**
+ * \brief           Finish ping run, report statistics and schedule next periodic run
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Ping command message
+ * \param[in]       res: Run result
+ */
+void
+lwcelli_ping_run_finished(lwcell_msg_t* msg, lwcellr_t res) {
+    lwcell_ping_stats_t* st = &msg->msg.ping.stats;
+
+    if (st->received > 0) {
+        st->avg = msg->msg.ping.rtt_sum / st->received;
+    }
+    if (st->received > 1) {
+        st->jitter = msg->msg.ping.jitter_sum / (st->received - 1U);
+    }
+    if (msg->msg.ping.stats_out != NULL) {
+        *msg->msg.ping.stats_out = *st;
+    }
+
+    lwcell.evt.evt.ping.host = msg->msg.ping.host;
+    lwcell.evt.evt.ping.stats = st;
+    lwcell.evt.evt.ping.res = res;
+    lwcelli_send_cb(LWCELL_EVT_PING);
+
+    /* Ignore runs of periodic probe which was stopped or restarted meanwhile */
+    if (msg->msg.ping.periodic_id != 0 && msg->msg.ping.periodic_id == lwcell.ping.id && lwcell.ping.interval > 0) {
+        lwcell_timeout_start(&lwcell.ping.timeout, lwcell.ping.interval, prv_ping_timeout_fn, NULL);
+    }
+}
+
+/**
+ * \brief           Execute single ping run
+ * \param[in]       host: Host name or IP address. It must stay valid until command finishes
+ * \param[in]       count: Number of probes in run, between `1` and `100`
+ * \param[out]      stats: Pointer to output variable to save run statistics to. Set to `NULL` if not used
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ping(const char* host, uint16_t count, lwcell_ping_stats_t* stats, const lwcell_api_cmd_evt_fn evt_fn,
+            void* const evt_arg, const uint32_t blocking) {
+    LWCELL_ASSERT(host != NULL && strlen(host) > 0);
+    LWCELL_ASSERT(count > 0 && count <= 100);
+
+    return prv_ping_send(host, count, stats, 0, evt_fn, evt_arg, blocking);
+}
+
+/**
+ * \brief           Start periodic ping probe
+ *
+ * First run is executed immediately, next one `interval` milliseconds after previous run has finished.
+ * Statistics of every run are reported with \ref LWCELL_EVT_PING event.
+ * Previously started periodic probe is replaced
+ *
+ * \param[in]       host: Host name or IP address. It must stay valid until probe is stopped
+ * \param[in]       count: Number of probes in every run, between `1` and `100`
+ * \param[in]       interval: Time between runs in units of milliseconds
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ping_start(const char* host, uint16_t count, uint32_t interval) {
+    lwcellr_t res;
+
+    LWCELL_ASSERT(host != NULL && strlen(host) > 0);
+    LWCELL_ASSERT(count > 0 && count <= 100);
+    LWCELL_ASSERT(interval > 0);
+
+    lwcell_core_lock();
+    lwcell.ping.host = host;
+    lwcell.ping.count = count;
+    lwcell.ping.interval = interval;
+    if (++lwcell.ping.id == 0) { /* ID `0` is reserved for single runs */
+        lwcell.ping.id = 1;
+    }
+    res = lwcell_timeout_start(&lwcell.ping.timeout, 0, prv_ping_timeout_fn, NULL);
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Stop periodic ping probe
+ * \note            Run in progress is finished and reported, but no new run is scheduled
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ping_stop(void) {
+    lwcell_core_lock();
+    lwcell.ping.interval = 0;
+    lwcell_timeout_stop(&lwcell.ping.timeout);
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
 #endif /* LWCELL_CFG_PING || __DOXYGEN__ */
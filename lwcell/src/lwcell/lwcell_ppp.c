@@ -0,0 +1,390 @@
+/**
+ * \file            lwcell_ppp.c
+ * \brief           PPP data mode
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_ppp.h"
+#include "lwcell/lwcell_private.h"
+#if LWCELL_CFG_CMUX
+#include "lwcell/lwcell_cmux.h"
+#endif /* LWCELL_CFG_CMUX */
+
+#if LWCELL_CFG_PPP || __DOXYGEN__
+
+/**
+ * \brief           Write raw data to channel used by PPP
+ * \note            Function must be called with core locked
+ * \param[in]       data: Data to write
+ * \param[in]       len: Length of data
+ */
+static void
+prv_ppp_send(const void* data, size_t len) {
+#if LWCELL_CFG_CMUX
+    if (lwcell.ppp.dlci > 0) {
+        lwcell_cmux_channel_send(lwcell.ppp.dlci, data, len);
+        return;
+    }
+#endif /* LWCELL_CFG_CMUX */
+    lwcell.ll.send_fn(data, len);
+    lwcell.ll.send_fn(NULL, 0);
+}
+
+/**
+ * \brief           Set new session state and report data mode change
+ * \note            Function must be called with core locked
+ * \param[in]       state: New state
+ */
+static void
+prv_ppp_set_state(lwcell_ppp_state_t state) {
+    lwcell_ppp_state_t old = lwcell.ppp.state;
+
+    lwcell.ppp.state = state;
+    if (state == LWCELL_PPP_STATE_DATA && old != LWCELL_PPP_STATE_DATA) {
+        lwcelli_send_cb(LWCELL_EVT_PPP_CONNECTED);
+    } else if (state == LWCELL_PPP_STATE_IDLE && old != LWCELL_PPP_STATE_IDLE) {
+        lwcelli_send_cb(LWCELL_EVT_PPP_DISCONNECTED);
+    }
+}
+
+/**
+ * \brief           Pass data to PPP in data mode on AT channel
+ * \note            Function must be called with core locked
+ * \param[in]       data: Received data
+ * \param[in]       len: Length of received data
+ * \return          `1` if data belongs to PPP, `0` if it shall be processed as AT data
+ */
+uint8_t
+lwcelli_ppp_input(const void* data, size_t len) {
+    if (lwcell.ppp.state != LWCELL_PPP_STATE_DATA || lwcell.ppp.dlci > 0) {
+        return 0;
+    }
+    if (len > 0) {
+        lwcell.ppp.input_fn(data, len, lwcell.ppp.arg);
+    }
+    return 1;
+}
+
+/**
+ * \brief           Check if AT channel is occupied by PPP data
+ * \note            Function must be called with core locked
+ * \return          `1` if commands cannot be sent, `0` otherwise
+ */
+uint8_t
+lwcelli_ppp_blocks_commands(void) {
+    return LWCELL_U8(lwcell.ppp.state == LWCELL_PPP_STATE_DATA && lwcell.ppp.dlci == 0);
+}
+
+/**
+ * \brief           Device reported `CONNECT` to dial or resume command on AT channel
+ * \note            Function must be called with core locked
+ */
+void
+lwcelli_ppp_connected(void) {
+    prv_ppp_set_state(LWCELL_PPP_STATE_DATA);
+}
+
+/**
+ * \brief           Dial or resume command on AT channel has finished
+ * \note            Function must be called with core locked
+ * \param[in]       is_ok: Set to `1` when device entered data mode
+ */
+void
+lwcelli_ppp_dial_finished(uint8_t is_ok) {
+    if (!is_ok) {
+        prv_ppp_set_state(lwcell.ppp.state == LWCELL_PPP_STATE_COMMAND ? LWCELL_PPP_STATE_COMMAND
+                                                                       : LWCELL_PPP_STATE_IDLE);
+    }
+}
+
+/**
+ * \brief           Reset session, device has dropped packet service call
+ * \note            Function must be called with core locked
+ */
+void
+lwcelli_ppp_reset(void) {
+    prv_ppp_set_state(LWCELL_PPP_STATE_IDLE);
+}
+
+#if LWCELL_CFG_CMUX || __DOXYGEN__
+
+/**
+ * \brief           Process data received on multiplexer application channel
+ * \note            Function must be called with core locked
+ * \param[in]       dlci: Channel DLCI
+ * \param[in]       data: Received data
+ * \param[in]       len: Length of received data
+ * \return          `1` if channel is used by PPP, `0` otherwise
+ */
+uint8_t
+lwcelli_ppp_channel_input(uint8_t dlci, const void* data, size_t len) {
+    const char* d = data;
+
+    if (lwcell.ppp.dlci == 0 || dlci != lwcell.ppp.dlci || lwcell.ppp.state == LWCELL_PPP_STATE_IDLE) {
+        return 0;
+    }
+    if (lwcell.ppp.state == LWCELL_PPP_STATE_DATA) {
+        lwcell.ppp.input_fn(data, len, lwcell.ppp.arg);
+        return 1;
+    }
+
+    /* Wait for dial or resume result, line by line */
+    for (size_t i = 0; i < len; ++i) {
+        if (lwcell.ppp.line_len < sizeof(lwcell.ppp.line) - 1) {
+            lwcell.ppp.line[lwcell.ppp.line_len++] = d[i];
+        }
+        if (d[i] != '\n') {
+            continue;
+        }
+        lwcell.ppp.line[lwcell.ppp.line_len] = '\0';
+        lwcell.ppp.line_len = 0;
+        if (lwcell.ppp.state != LWCELL_PPP_STATE_DIALING) {
+            continue;
+        }
+        if (!strncmp(lwcell.ppp.line, "CONNECT", 7)) {
+            prv_ppp_set_state(LWCELL_PPP_STATE_DATA);
+            if (i + 1 < len) {
+                lwcell.ppp.input_fn(&d[i + 1], len - i - 1, lwcell.ppp.arg); /* Rest of frame is PPP data already */
+            }
+            break;
+        } else if (!strncmp(lwcell.ppp.line, "NO CARRIER", 10) || !strncmp(lwcell.ppp.line, "ERROR", 5)) {
+            prv_ppp_set_state(LWCELL_PPP_STATE_IDLE);
+        }
+    }
+    return 1;
+}
+
+#endif /* LWCELL_CFG_CMUX || __DOXYGEN__ */
+
+/**
+ * \brief           Send dial, resume or hang-up command on AT channel
+ * \param[in]       cmd: Command to send
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+prv_ppp_cmd(lwcell_cmd_t cmd, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE_HDR);
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = cmd;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
+}
+
+/**
+ * \brief           Dial packet service and enter PPP data mode
+ *
+ * Network must be registered and PDP context must be configured, with APN, before dial.
+ * On AT channel, command finishes once device enters data mode.
+ * On multiplexer channel, function returns once dial is sent,
+ * data mode is reported with \ref LWCELL_EVT_PPP_CONNECTED event
+ *
+ * \param[in]       dlci: Multiplexer application channel DLCI or `0` to use AT channel
+ * \param[in]       input_fn: Callback function for received PPP data
+ * \param[in]       arg: Custom argument for data callback
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ppp_start(uint8_t dlci, lwcell_ppp_input_fn input_fn, void* arg, const lwcell_api_cmd_evt_fn evt_fn,
+                 void* const evt_arg, const uint32_t blocking) {
+    lwcellr_t res = lwcellOK;
+
+    LWCELL_ASSERT(input_fn != NULL);
+#if !LWCELL_CFG_CMUX
+    LWCELL_ASSERT(dlci == 0);
+#endif /* !LWCELL_CFG_CMUX */
+
+    lwcell_core_lock();
+    if (lwcell.ppp.state != LWCELL_PPP_STATE_IDLE) {
+        res = lwcellERR;
+    } else {
+        lwcell.ppp.dlci = dlci;
+        lwcell.ppp.input_fn = input_fn;
+        lwcell.ppp.arg = arg;
+        lwcell.ppp.state = LWCELL_PPP_STATE_DIALING;
+#if LWCELL_CFG_CMUX
+        if (dlci > 0) {
+            lwcell.ppp.line_len = 0;
+            res = lwcell_cmux_channel_send(dlci, "ATD*99#\r", 8);
+            if (res != lwcellOK) {
+                lwcell.ppp.state = LWCELL_PPP_STATE_IDLE;
+            }
+            lwcell_core_unlock();
+            return res;
+        }
+#endif /* LWCELL_CFG_CMUX */
+    }
+    lwcell_core_unlock();
+    if (res != lwcellOK) {
+        return res;
+    }
+    if ((res = prv_ppp_cmd(LWCELL_CMD_PPP_DIAL, evt_fn, evt_arg, blocking)) != lwcellOK) {
+        lwcell_core_lock();
+        lwcell.ppp.state = LWCELL_PPP_STATE_IDLE;
+        lwcell_core_unlock();
+    }
+    return res;
+}
+
+/**
+ * \brief           Write PPP data to device
+ *
+ * Function may be used directly as output callback of external PPP implementation
+ *
+ * \param[in]       data: Data to write
+ * \param[in]       len: Length of data
+ * \return          Number of bytes written, `0` when not in data mode
+ */
+size_t
+lwcell_ppp_output(const void* data, size_t len) {
+    size_t res = 0;
+
+    lwcell_core_lock();
+    if (lwcell.ppp.state == LWCELL_PPP_STATE_DATA && data != NULL && len > 0) {
+        prv_ppp_send(data, len);
+        res = len;
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Escape from data mode to command mode with `+++` sequence
+ *
+ * Call stays active and may be resumed with \ref lwcell_ppp_resume.
+ * Function blocks for twice \ref LWCELL_CFG_PPP_ESCAPE_GUARD_TIME, as required by device
+ *
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ppp_suspend(void) {
+    lwcellr_t res = lwcellERR;
+
+    lwcell_core_lock();
+    if (lwcell.ppp.state == LWCELL_PPP_STATE_DATA) {
+        lwcell.ppp.state = LWCELL_PPP_STATE_COMMAND; /* External stack output is stopped from now on */
+        res = lwcellOK;
+    }
+    lwcell_core_unlock();
+    if (res != lwcellOK) {
+        return res;
+    }
+
+    lwcell_delay(LWCELL_CFG_PPP_ESCAPE_GUARD_TIME);
+    lwcell_core_lock();
+    prv_ppp_send("+++", 3);
+    lwcell_core_unlock();
+    lwcell_delay(LWCELL_CFG_PPP_ESCAPE_GUARD_TIME);
+    return lwcellOK;
+}
+
+/**
+ * \brief           Return from command mode to data mode of active call
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ppp_resume(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    lwcellr_t res = lwcellERR;
+    uint8_t dlci = 0;
+
+    lwcell_core_lock();
+    if (lwcell.ppp.state == LWCELL_PPP_STATE_COMMAND) {
+        dlci = lwcell.ppp.dlci;
+        res = lwcellOK;
+#if LWCELL_CFG_CMUX
+        if (dlci > 0) {
+            lwcell.ppp.state = LWCELL_PPP_STATE_DIALING;
+            lwcell.ppp.line_len = 0;
+            res = lwcell_cmux_channel_send(dlci, "ATO\r", 4);
+        }
+#endif /* LWCELL_CFG_CMUX */
+    }
+    lwcell_core_unlock();
+    if (res != lwcellOK || dlci > 0) {
+        return res;
+    }
+    return prv_ppp_cmd(LWCELL_CMD_ATO, evt_fn, evt_arg, blocking);
+}
+
+/**
+ * \brief           Leave data mode if active and hang up packet service call
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ppp_stop(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    uint8_t dlci;
+
+    if (lwcell_ppp_is_data_mode()) {
+        lwcell_ppp_suspend();
+    }
+
+    lwcell_core_lock();
+    dlci = lwcell.ppp.dlci;
+#if LWCELL_CFG_CMUX
+    if (dlci > 0 && lwcell.ppp.state != LWCELL_PPP_STATE_IDLE) {
+        lwcell_cmux_channel_send(dlci, "ATH\r", 4);
+    }
+#endif /* LWCELL_CFG_CMUX */
+    prv_ppp_set_state(LWCELL_PPP_STATE_IDLE);
+    lwcell_core_unlock();
+    if (dlci > 0) {
+        return lwcellOK;
+    }
+    return prv_ppp_cmd(LWCELL_CMD_ATH, evt_fn, evt_arg, blocking);
+}
+
+/**
+ * \brief           Check if device is in PPP data mode
+ * \return          `1` if in data mode, `0` otherwise
+ */
+uint8_t
+lwcell_ppp_is_data_mode(void) {
+    uint8_t res;
+
+    lwcell_core_lock();
+    res = LWCELL_U8(lwcell.ppp.state == LWCELL_PPP_STATE_DATA);
+    lwcell_core_unlock();
+    return res;
+}
+
+#endif /* LWCELL_CFG_PPP || __DOXYGEN__ */
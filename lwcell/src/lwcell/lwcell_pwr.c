@@ -0,0 +1,243 @@
+/**
+ * \file            lwcell_pwr.c
+ * \brief           Power saving modes manager
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_pwr.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_PWR || __DOXYGEN__
+
+/**
+ * \brief           Command inactivity timeout callback, put modem to sleep
+ * \param[in]       arg: Custom user argument
+ */
+static void
+prv_pwr_idle_timeout_fn(void* arg) {
+    LWCELL_UNUSED(arg);
+
+    lwcell_core_lock();
+    /* Command in progress restarts timeout once it finishes */
+    if (lwcell.pwr.mode != LWCELL_PWR_SLEEP_DISABLE && !lwcell.pwr.asleep && lwcell.msg == NULL) {
+        if (lwcell.pwr.mode == LWCELL_PWR_SLEEP_DTR) {
+            lwcell.ll.sleep_fn(1);
+        }
+        lwcell.pwr.asleep = 1;
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_THREAD | LWCELL_DBG_TYPE_TRACE, "[LWCELL PWR] Modem is asleep\r\n");
+    }
+    lwcell_core_unlock();
+}
+
+/**
+ * \brief           Wake up modem before next command is sent
+ * \note            Function must be called from producer thread with core locked,
+ *                  before command message is set as current one
+ */
+void
+lwcelli_pwr_wake(void) {
+    lwcell_timeout_stop(&lwcell.pwr.idle_timeout);
+    if (!lwcell.pwr.asleep) {
+        return;
+    }
+    lwcell.pwr.asleep = 0;
+    if (lwcell.pwr.mode == LWCELL_PWR_SLEEP_DTR) {
+        lwcell.ll.sleep_fn(0);
+    } else {
+        /* First character only wakes UART up, response of dummy command is ignored with no current command */
+        lwcell.ll.send_fn("AT" CRLF, 2 + CRLF_LEN);
+        lwcell.ll.send_fn(NULL, 0);
+    }
+    lwcell_core_unlock();
+    lwcell_delay(LWCELL_CFG_PWR_WAKE_TIME);
+    lwcell_core_lock();
+    LWCELL_DEBUGF(LWCELL_CFG_DBG_THREAD | LWCELL_DBG_TYPE_TRACE, "[LWCELL PWR] Modem woken up\r\n");
+}
+
+/**
+ * \brief           Command has finished, restart inactivity window
+ * \note            Function must be called with core locked
+ */
+void
+lwcelli_pwr_cmd_done(void) {
+    if (lwcell.pwr.mode != LWCELL_PWR_SLEEP_DISABLE) {
+        lwcell_timeout_start(&lwcell.pwr.idle_timeout, LWCELL_CFG_PWR_IDLE_TIME, prv_pwr_idle_timeout_fn, NULL);
+    }
+}
+
+/**
+ * \brief           Sleep mode command has finished
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Sleep mode command message
+ * \param[in]       is_ok: Set to `1` when device accepted new mode
+ */
+void
+lwcelli_pwr_sleep_configured(lwcell_msg_t* msg, uint8_t is_ok) {
+    if (!is_ok) {
+        return;
+    }
+    lwcell.pwr.mode = (lwcell_pwr_sleep_t)msg->msg.pwr.mode;
+    if (lwcell.pwr.mode == LWCELL_PWR_SLEEP_DISABLE) {
+        lwcell_timeout_stop(&lwcell.pwr.idle_timeout);
+    }
+}
+
+/**
+ * \brief           Reset manager state, device is awake after reset
+ * \note            Function must be called with core locked
+ */
+void
+lwcelli_pwr_reset(void) {
+    if (lwcell.pwr.asleep && lwcell.pwr.mode == LWCELL_PWR_SLEEP_DTR) {
+        lwcell.ll.sleep_fn(0);
+    }
+    lwcell.pwr.mode = LWCELL_PWR_SLEEP_DISABLE;
+    lwcell.pwr.asleep = 0;
+    lwcell_timeout_stop(&lwcell.pwr.idle_timeout);
+}
+
+/**
+ * \brief           Send power manager configuration command
+ * \param[in]       cmd: Command to send
+ * \param[in]       mode: Mode parameter of command
+ * \param[in]       act_type: Access technology for eDRX command
+ * \param[in]       t1: First timer value string
+ * \param[in]       t2: Second timer value string
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+prv_pwr_send(lwcell_cmd_t cmd, uint8_t mode, uint8_t act_type, const char* t1, const char* t2,
+             const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(pwr));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = cmd;
+    LWCELL_MSG_VAR_REF(msg).msg.pwr.mode = mode;
+    LWCELL_MSG_VAR_REF(msg).msg.pwr.act_type = act_type;
+    LWCELL_MSG_VAR_REF(msg).msg.pwr.t1 = t1;
+    LWCELL_MSG_VAR_REF(msg).msg.pwr.t2 = t2;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 10000);
+}
+
+/**
+ * \brief           Configure power saving mode (PSM)
+ * \param[in]       enable: Set to `1` to request PSM, `0` to disable it
+ * \param[in]       tau: Requested periodic TAU (T3412), 8-bit binary string, such as `"00100001"`.
+ *                      Set to `NULL` to use device default
+ * \param[in]       active_time: Requested active time (T3324), 8-bit binary string.
+ *                      Set to `NULL` to use device default
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_pwr_psm_set(uint8_t enable, const char* tau, const char* active_time, const lwcell_api_cmd_evt_fn evt_fn,
+                   void* const evt_arg, const uint32_t blocking) {
+    return prv_pwr_send(LWCELL_CMD_CPSMS_SET, LWCELL_U8(enable > 0), 0, tau, active_time, evt_fn, evt_arg, blocking);
+}
+
+/**
+ * \brief           Configure extended discontinuous reception (eDRX)
+ * \param[in]       enable: Set to `1` to request eDRX, `0` to disable it
+ * \param[in]       act_type: Access technology, `4` for LTE-M, `5` for NB-IoT
+ * \param[in]       cycle: Requested eDRX cycle, 4-bit binary string, such as `"0101"`.
+ *                      Set to `NULL` to use device default
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_pwr_edrx_set(uint8_t enable, uint8_t act_type, const char* cycle, const lwcell_api_cmd_evt_fn evt_fn,
+                    void* const evt_arg, const uint32_t blocking) {
+    return prv_pwr_send(LWCELL_CMD_CEDRXS_SET, LWCELL_U8(enable > 0), act_type, cycle, NULL, evt_fn, evt_arg,
+                        blocking);
+}
+
+/**
+ * \brief           Set modem sleep mode
+ *
+ * Once device accepts the mode, modem is put to sleep after \ref LWCELL_CFG_PWR_IDLE_TIME
+ * of command inactivity and woken up automatically before next command
+ *
+ * \param[in]       mode: Sleep mode
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_pwr_sleep_set(lwcell_pwr_sleep_t mode, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                     const uint32_t blocking) {
+    LWCELL_ASSERT(mode <= LWCELL_PWR_SLEEP_AUTO);
+    LWCELL_ASSERT(mode != LWCELL_PWR_SLEEP_DTR || lwcell.ll.sleep_fn != NULL);
+
+    return prv_pwr_send(LWCELL_CMD_CSCLK_SET, (uint8_t)mode, 0, NULL, NULL, evt_fn, evt_arg, blocking);
+}
+
+/**
+ * \brief           Request early release of radio connection
+ *
+ * Device tells the network, with `AT+CNMPSD`, that no more data are expected.
+ * Network releases radio connection without waiting for inactivity timer.
+ * Use it once last expected response of the exchange has arrived
+ *
+ * \note            Available on LTE devices only
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_pwr_radio_release(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    return prv_pwr_send(LWCELL_CMD_CNMPSD, 0, 0, NULL, NULL, evt_fn, evt_arg, blocking);
+}
+
+/**
+ * \brief           Check if modem is asleep
+ * \return          `1` if asleep, `0` otherwise
+ */
+uint8_t
+lwcell_pwr_is_asleep(void) {
+    uint8_t res;
+
+    lwcell_core_lock();
+    res = lwcell.pwr.asleep;
+    lwcell_core_unlock();
+    return res;
+}
+
+#endif /* LWCELL_CFG_PWR || __DOXYGEN__ */
@@ -63,7 +63,7 @@ lwcell_sim_pin_enter(const char* pin, const lwcell_api_cmd_evt_fn evt_fn, void*
 
     LWCELL_ASSERT(pin != NULL);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(cpin_enter));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CPIN_SET;
     LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CPIN_GET;
@@ -88,7 +88,7 @@ lwcell_sim_pin_add(const char* pin, const lwcell_api_cmd_evt_fn evt_fn, void* co
 
     LWCELL_ASSERT(pin != NULL);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(cpin_add));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CPIN_ADD;
     LWCELL_MSG_VAR_REF(msg).msg.cpin_add.pin = pin;
@@ -113,7 +113,7 @@ lwcell_sim_pin_change(const char* pin, const char* new_pin, const lwcell_api_cmd
     LWCELL_ASSERT(pin != NULL);
     LWCELL_ASSERT(new_pin != NULL);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(cpin_change));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CPIN_CHANGE;
     LWCELL_MSG_VAR_REF(msg).msg.cpin_change.current_pin = pin;
@@ -137,7 +137,7 @@ lwcell_sim_pin_remove(const char* pin, const lwcell_api_cmd_evt_fn evt_fn, void*
 
     LWCELL_ASSERT(pin != NULL);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(cpin_remove));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CPIN_REMOVE;
     LWCELL_MSG_VAR_REF(msg).msg.cpin_remove.pin = pin;
@@ -162,7 +162,7 @@ lwcell_sim_puk_enter(const char* puk, const char* new_pin, const lwcell_api_cmd_
     LWCELL_ASSERT(puk != NULL);
     LWCELL_ASSERT(new_pin != NULL);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(cpuk_enter));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CPUK_SET;
     LWCELL_MSG_VAR_REF(msg).msg.cpuk_enter.puk = puk;
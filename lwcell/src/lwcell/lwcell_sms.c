@@ -106,7 +106,7 @@ lwcellr_t
 lwcell_sms_enable(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
     LWCELL_MSG_VAR_DEFINE(msg);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE_HDR);
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_SMS_ENABLE;
     LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CPMS_GET_OPT;
@@ -152,7 +152,7 @@ lwcell_sms_send(const char* num, const char* text, const lwcell_api_cmd_evt_fn e
     CHECK_ENABLED(); /* Check if enabled */
     CHECK_READY();   /* Check if ready */
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(sms_send));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CMGS;
     LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CMGF;
@@ -163,6 +163,113 @@ lwcell_sms_send(const char* num, const char* text, const lwcell_api_cmd_evt_fn e
     return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
 }
 
+#if LWCELL_CFG_SMS_PDU || __DOXYGEN__
+
+/**
+ * \brief           Send SMS in PDU mode to phone number
+ *
+ * Data longer than single SMS are split to concatenated parts, sent one after another.
+ * Event callback is called once, after all parts are sent or on first error
+ *
+ * \note            Data must stay valid until command finishes
+ * \param[in]       num: String number, international number starts with `+`
+ * \param[in]       data: Data to send, UTF-8 text for \ref LWCELL_SMS_DCS_GSM7 and \ref LWCELL_SMS_DCS_UCS2 schemes
+ * \param[in]       len: Length of data in units of bytes
+ * \param[in]       dcs: Data coding scheme
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_sms_send_pdu(const char* num, const void* data, size_t len, lwcell_sms_dcs_t dcs,
+                    const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    size_t parts;
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(num != NULL && num[0] > 0);
+    LWCELL_ASSERT(data != NULL && len > 0);
+    CHECK_ENABLED(); /* Check if enabled */
+    CHECK_READY();   /* Check if ready */
+
+    /* Count concatenated parts, characters are never split */
+    if ((parts = lwcell_sms_pdu_parts(dcs, data, len)) == 0) {
+        return lwcellERRPAR;
+    }
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(sms_send));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CMGS;
+    LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CMGF;
+    LWCELL_MSG_VAR_REF(msg).msg.sms_send.num = num;
+    LWCELL_MSG_VAR_REF(msg).msg.sms_send.format = 0; /* Send in PDU mode */
+    LWCELL_MSG_VAR_REF(msg).msg.sms_send.data = data;
+    LWCELL_MSG_VAR_REF(msg).msg.sms_send.len = len;
+    LWCELL_MSG_VAR_REF(msg).msg.sms_send.dcs = dcs;
+    LWCELL_MSG_VAR_REF(msg).msg.sms_send.parts = (uint8_t)parts;
+    LWCELL_MSG_VAR_REF(msg).msg.sms_send.part = 1;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000 * (uint32_t)parts);
+}
+
+/**
+ * \brief           Send batch of SMS text messages in PDU mode
+ *
+ * All entries are sent within single command, message format is configured only once.
+ * Each text is sent with GSM 7-bit alphabet when possible or UCS2 otherwise,
+ * and split to concatenated parts when it does not fit to single SMS.
+ *
+ * Entry which fails does not stop the batch, its `res` member is set to error.
+ * Event callback is called once, after all entries are processed,
+ * with \ref lwcellOK only when all entries were sent
+ *
+ * \note            Entries array and texts must stay valid until command finishes
+ * \param[in,out]   entries: Array of entries to send. Result of each entry is written back
+ * \param[in]       entries_len: Number of entries in array
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_sms_send_batch(lwcell_sms_batch_entry_t* entries, size_t entries_len, const lwcell_api_cmd_evt_fn evt_fn,
+                      void* const evt_arg, const uint32_t blocking) {
+    size_t parts = 0;
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(entries != NULL && entries_len > 0);
+    CHECK_ENABLED(); /* Check if enabled */
+    CHECK_READY();   /* Check if ready */
+
+    /* Validate entries and count all parts for command timeout */
+    for (size_t i = 0; i < entries_len; ++i) {
+        size_t len, n;
+
+        LWCELL_ASSERT(entries[i].num != NULL && entries[i].num[0] > 0);
+        LWCELL_ASSERT(entries[i].text != NULL && entries[i].text[0] != '\0');
+        len = strlen(entries[i].text);
+        if ((n = lwcell_sms_pdu_parts(LWCELL_SMS_DCS_GSM7, entries[i].text, len)) == 0
+            && (n = lwcell_sms_pdu_parts(LWCELL_SMS_DCS_UCS2, entries[i].text, len)) == 0) {
+            return lwcellERRPAR;
+        }
+        entries[i].res = lwcellINPROG;
+        entries[i].pos = 0;
+        parts += n;
+    }
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(sms_send));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CMGS;
+    LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CMGF;
+    LWCELL_MSG_VAR_REF(msg).msg.sms_send.format = 0; /* Send in PDU mode */
+    LWCELL_MSG_VAR_REF(msg).msg.sms_send.batch = entries;
+    LWCELL_MSG_VAR_REF(msg).msg.sms_send.batch_len = entries_len;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000 * (uint32_t)parts);
+}
+
+#endif /* LWCELL_CFG_SMS_PDU || __DOXYGEN__ */
+
 /**
  * \brief           Read SMS entry at specific memory and position
  * \param[in]       mem: Memory used to read message from
@@ -184,7 +291,7 @@ lwcell_sms_read(lwcell_mem_t mem, size_t pos, lwcell_sms_entry_t* entry, uint8_t
     CHECK_READY();   /* Check if ready */
     LWCELL_ASSERT(check_sms_mem(mem, 1) == lwcellOK);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(sms_read));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
 
     LWCELL_MEMSET(entry, 0x00, sizeof(*entry));            /* Reset data structure */
@@ -224,7 +331,7 @@ lwcell_sms_delete(lwcell_mem_t mem, size_t pos, const lwcell_api_cmd_evt_fn evt_
     CHECK_READY();   /* Check if ready */
     LWCELL_ASSERT(check_sms_mem(mem, 1) == lwcellOK);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(sms_delete));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CMGD;
     if (mem == LWCELL_MEM_CURRENT) {                       /* Should be always false */
@@ -254,7 +361,7 @@ lwcell_sms_delete_all(lwcell_sms_status_t status, const lwcell_api_cmd_evt_fn ev
     CHECK_ENABLED(); /* Check if enabled */
     CHECK_READY();   /* Check if ready */
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(sms_delete_all));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CMGDA;
     LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CMGF; /* By default format = 1 */
@@ -265,30 +372,31 @@ lwcell_sms_delete_all(lwcell_sms_status_t status, const lwcell_api_cmd_evt_fn ev
 }
 
 /**
- * \brief           List SMS from SMS memory
- * \param[in]       mem: Memory to read entries from. Use \ref LWCELL_MEM_CURRENT to read from current memory
- * \param[in]       stat: SMS status to read, either `read`, `unread`, `sent`, `unsent` or `all`
- * \param[out]      entries: Pointer to array to save SMS entries
+ * \brief           Start SMS list operation
+ * \param[in]       mem: Memory to read entries from
+ * \param[in]       stat: SMS status to read
+ * \param[out]      entries: Pointer to array to save SMS entries or scratch entry when `entry_fn` is set
  * \param[in]       etr: Number of entries to read
- * \param[out]      er: Pointer to output variable to save number of entries in array
- * \param[in]       update: Flag indicates update. Set to `1` to change `UNREAD` messages to `READ` or `0` to leave as is
+ * \param[out]      er: Pointer to output variable to save number of listed entries
+ * \param[in]       entry_fn: Entry callback function or `NULL` to fill array
+ * \param[in]       entry_arg: Custom argument for entry callback function
+ * \param[in]       update: Flag indicates update of `UNREAD` messages to `READ`
  * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
  * \param[in]       evt_arg: Custom argument for event callback function
  * \param[in]       blocking: Status whether command should be blocking or not
  * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
  */
-lwcellr_t
-lwcell_sms_list(lwcell_mem_t mem, lwcell_sms_status_t stat, lwcell_sms_entry_t* entries, size_t etr, size_t* er,
-                uint8_t update, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+static lwcellr_t
+prv_sms_list(lwcell_mem_t mem, lwcell_sms_status_t stat, lwcell_sms_entry_t* entries, size_t etr, size_t* er,
+             lwcell_sms_list_fn entry_fn, void* entry_arg, uint8_t update, const lwcell_api_cmd_evt_fn evt_fn,
+             void* const evt_arg, const uint32_t blocking) {
     LWCELL_MSG_VAR_DEFINE(msg);
 
-    LWCELL_ASSERT(entries != NULL);
-    LWCELL_ASSERT(etr > 0);
     CHECK_ENABLED(); /* Check if enabled */
     CHECK_READY();   /* Check if ready */
     LWCELL_ASSERT(check_sms_mem(mem, 1) == lwcellOK);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(sms_list));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
 
     if (er != NULL) {
@@ -306,12 +414,65 @@ lwcell_sms_list(lwcell_mem_t mem, lwcell_sms_status_t stat, lwcell_sms_entry_t*
     LWCELL_MSG_VAR_REF(msg).msg.sms_list.entries = entries;
     LWCELL_MSG_VAR_REF(msg).msg.sms_list.etr = etr;
     LWCELL_MSG_VAR_REF(msg).msg.sms_list.er = er;
+    LWCELL_MSG_VAR_REF(msg).msg.sms_list.entry_fn = entry_fn;
+    LWCELL_MSG_VAR_REF(msg).msg.sms_list.entry_arg = entry_arg;
     LWCELL_MSG_VAR_REF(msg).msg.sms_list.update = update;
     LWCELL_MSG_VAR_REF(msg).msg.sms_list.format = 1; /* Send as plain text */
 
     return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
 }
 
+/**
+ * \brief           List SMS from SMS memory
+ * \param[in]       mem: Memory to read entries from. Use \ref LWCELL_MEM_CURRENT to read from current memory
+ * \param[in]       stat: SMS status to read, either `read`, `unread`, `sent`, `unsent` or `all`
+ * \param[out]      entries: Pointer to array to save SMS entries
+ * \param[in]       etr: Number of entries to read
+ * \param[out]      er: Pointer to output variable to save number of entries in array
+ * \param[in]       update: Flag indicates update. Set to `1` to change `UNREAD` messages to `READ` or `0` to leave as is
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_sms_list(lwcell_mem_t mem, lwcell_sms_status_t stat, lwcell_sms_entry_t* entries, size_t etr, size_t* er,
+                uint8_t update, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    LWCELL_ASSERT(entries != NULL);
+    LWCELL_ASSERT(etr > 0);
+
+    return prv_sms_list(mem, stat, entries, etr, er, NULL, NULL, update, evt_fn, evt_arg, blocking);
+}
+
+/**
+ * \brief           List SMS from SMS memory, one entry at a time
+ *
+ * Every message is parsed to single scratch entry and passed to `entry_fn`
+ * as soon as its data line is received, memory use does not depend on number of stored messages.
+ * `entry_fn` is called from processing thread, it shall copy data it needs and return quickly
+ *
+ * \param[in]       mem: Memory to read entries from. Use \ref LWCELL_MEM_CURRENT to read from current memory
+ * \param[in]       stat: SMS status to read, either `read`, `unread`, `sent`, `unsent` or `all`
+ * \param[in]       entry: Scratch entry reused for every message. It must stay valid until command finishes
+ * \param[in]       entry_fn: Callback function called for every listed message
+ * \param[in]       entry_arg: Custom argument for entry callback function
+ * \param[out]      er: Pointer to output variable to save number of listed entries. Set to `NULL` if not used
+ * \param[in]       update: Flag indicates update. Set to `1` to change `UNREAD` messages to `READ` or `0` to leave as is
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_sms_list_iter(lwcell_mem_t mem, lwcell_sms_status_t stat, lwcell_sms_entry_t* entry, lwcell_sms_list_fn entry_fn,
+                     void* entry_arg, size_t* er, uint8_t update, const lwcell_api_cmd_evt_fn evt_fn,
+                     void* const evt_arg, const uint32_t blocking) {
+    LWCELL_ASSERT(entry != NULL);
+    LWCELL_ASSERT(entry_fn != NULL);
+
+    return prv_sms_list(mem, stat, entry, 1, er, entry_fn, entry_arg, update, evt_fn, evt_arg, blocking);
+}
+
 /**
  * \brief           Set preferred storage for SMS
  * \param[in]       mem1: Preferred memory for read/delete SMS operations. Use \ref LWCELL_MEM_CURRENT to keep it as is
@@ -333,7 +494,7 @@ lwcell_sms_set_preferred_storage(lwcell_mem_t mem1, lwcell_mem_t mem2, lwcell_me
     LWCELL_ASSERT(check_sms_mem(mem2, 1) == lwcellOK);
     LWCELL_ASSERT(check_sms_mem(mem3, 1) == lwcellOK);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(sms_memory));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CPMS_SET;
 
@@ -348,4 +509,153 @@ lwcell_sms_set_preferred_storage(lwcell_mem_t mem1, lwcell_mem_t mem2, lwcell_me
     return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
 }
 
+#if LWCELL_CFG_SMS_INBOX || __DOXYGEN__
+
+/**
+ * \brief           Finish inbox drain and start new one if notification was received in the meantime
+ */
+static void
+prv_inbox_finish(void) {
+    lwcell.m.sms.inbox_busy = 0;
+    if (lwcell.m.sms.inbox_pending) {
+        lwcell.m.sms.inbox_pending = 0;
+        lwcelli_sms_inbox_notify(lwcell.m.sms.inbox_next_mem);
+    }
+}
+
+/**
+ * \brief           Inbox entry callback, forwards listed message to application
+ * \param[in]       entry: Listed SMS entry
+ * \param[in]       arg: Custom argument, not used
+ */
+static void
+prv_inbox_entry_fn(const lwcell_sms_entry_t* entry, void* arg) {
+    LWCELL_UNUSED(arg);
+    if (lwcell.m.sms.inbox_fn != NULL) {
+        lwcell.m.sms.inbox_fn(entry, lwcell.m.sms.inbox_arg);
+    }
+}
+
+/**
+ * \brief           Inbox delete command finished callback
+ * \param[in]       res: Command result
+ * \param[in]       arg: Custom argument, not used
+ */
+static void
+prv_inbox_delete_done(lwcellr_t res, void* arg) {
+    LWCELL_UNUSED(res);
+    LWCELL_UNUSED(arg);
+    prv_inbox_finish();
+}
+
+/**
+ * \brief           Inbox list command finished callback
+ *
+ * Listed messages are marked as read by device and all read messages are deleted with single command.
+ * Messages received after list command are still unread and stay in memory for next drain
+ *
+ * \param[in]       res: Command result
+ * \param[in]       arg: Custom argument, not used
+ */
+static void
+prv_inbox_list_done(lwcellr_t res, void* arg) {
+    LWCELL_UNUSED(arg);
+    if (res != lwcellOK || lwcell.m.sms.inbox_cnt == 0
+        || lwcell_sms_delete_all(LWCELL_SMS_STATUS_READ, prv_inbox_delete_done, NULL, 0) != lwcellOK) {
+        prv_inbox_finish();
+    }
+}
+
+/**
+ * \brief           Notifications window expired, list unread messages
+ * \param[in]       arg: Custom argument, not used
+ */
+static void
+prv_inbox_timeout_fn(void* arg) {
+    lwcell_mem_t mem = lwcell.m.sms.inbox_mem;
+
+    LWCELL_UNUSED(arg);
+    lwcell.m.sms.inbox_scheduled = 0;
+    if (lwcell.m.sms.inbox_fn == NULL) {
+        return;
+    }
+    if (check_sms_mem(mem, 0) != lwcellOK) {
+        mem = LWCELL_MEM_CURRENT; /* Unknown memory in notification */
+    }
+    lwcell.m.sms.inbox_busy = 1;
+    lwcell.m.sms.inbox_cnt = 0;
+    if (lwcell_sms_list_iter(mem, LWCELL_SMS_STATUS_UNREAD, &lwcell.m.sms.inbox_entry, prv_inbox_entry_fn, NULL,
+                             &lwcell.m.sms.inbox_cnt, 1, prv_inbox_list_done, NULL, 0)
+        != lwcellOK) {
+        prv_inbox_finish();
+    }
+}
+
+/**
+ * \brief           Process new message notification for inbox service
+ *
+ * First notification opens collection window, others received in the window are served by the same drain
+ *
+ * \note            Function is called from processing thread with core locked
+ * \param[in]       mem: Memory where message has been stored
+ */
+void
+lwcelli_sms_inbox_notify(lwcell_mem_t mem) {
+    if (lwcell.m.sms.inbox_fn == NULL) {
+        return;
+    }
+    if (lwcell.m.sms.inbox_busy) { /* Drain in progress, repeat it once finished */
+        lwcell.m.sms.inbox_pending = 1;
+        lwcell.m.sms.inbox_next_mem = mem;
+    } else if (!lwcell.m.sms.inbox_scheduled) {
+        lwcell.m.sms.inbox_mem = mem;
+        if (lwcell_timeout_add(LWCELL_CFG_SMS_INBOX_DELAY, prv_inbox_timeout_fn, NULL) == lwcellOK) {
+            lwcell.m.sms.inbox_scheduled = 1;
+        }
+    }
+}
+
+/**
+ * \brief           Enable SMS inbox service
+ *
+ * New messages reported with `+CMTI` are read in batches with single `AT+CMGL` command
+ * and passed to `entry_fn` one by one. When list is complete, all `READ` messages are deleted
+ * from memory with single `AT+CMGDA` command.
+ *
+ * \note            Service deletes every message with `READ` status in memory, including messages
+ *                  read before by application. Copy data to keep from `entry_fn` callback
+ *
+ * \param[in]       entry_fn: Callback function called for every received message, from processing thread
+ * \param[in]       entry_arg: Custom argument for entry callback function
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_sms_inbox_enable(lwcell_sms_list_fn entry_fn, void* entry_arg) {
+    LWCELL_ASSERT(entry_fn != NULL);
+
+    lwcell_core_lock();
+    lwcell.m.sms.inbox_fn = entry_fn;
+    lwcell.m.sms.inbox_arg = entry_arg;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+/**
+ * \brief           Disable SMS inbox service
+ *
+ * Drain in progress finishes, but its messages are not passed to application anymore
+ *
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t otherwise
+ */
+lwcellr_t
+lwcell_sms_inbox_disable(void) {
+    lwcell_core_lock();
+    lwcell.m.sms.inbox_fn = NULL;
+    lwcell.m.sms.inbox_arg = NULL;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_SMS_INBOX || __DOXYGEN__ */
+
 #endif /* LWCELL_CFG_SMS || __DOXYGEN__ */
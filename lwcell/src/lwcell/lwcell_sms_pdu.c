@@ -0,0 +1,720 @@
+/**
+ * \file            lwcell_sms_pdu.c
+ * \brief           SMS PDU encoder and decoder
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_sms_pdu.h"
+#include "lwcell/lwcell_private.h"
+#include "lwcell/lwcell_unicode.h"
+
+#if LWCELL_CFG_SMS_PDU || __DOXYGEN__
+
+/* Flags and markers of GSM 7-bit tables */
+#define GSM7_ESC     0x1B /*!< Escape to extension table */
+#define GSM7_EXT     0x80 /*!< Flag in ASCII table, character is in extension table */
+#define GSM7_INVALID 0xFF /*!< Character has no GSM 7-bit representation */
+
+/* Length of concatenated SMS user data header, including header length byte */
+#define PDU_UDH_LEN 6
+
+/**
+ * \brief           GSM 7-bit default alphabet to unicode
+ */
+static const uint16_t gsm7_to_unicode[128] = {
+    0x0040, 0x00A3, 0x0024, 0x00A5, 0x00E8, 0x00E9, 0x00F9, 0x00EC, 0x00F2, 0x00C7, 0x000A, 0x00D8, 0x00F8,
+    0x000D, 0x00C5, 0x00E5, 0x0394, 0x005F, 0x03A6, 0x0393, 0x039B, 0x03A9, 0x03A0, 0x03A8, 0x03A3, 0x0398,
+    0x039E, 0x00A0, 0x00C6, 0x00E6, 0x00DF, 0x00C9, 0x0020, 0x0021, 0x0022, 0x0023, 0x00A4, 0x0025, 0x0026,
+    0x0027, 0x0028, 0x0029, 0x002A, 0x002B, 0x002C, 0x002D, 0x002E, 0x002F, 0x0030, 0x0031, 0x0032, 0x0033,
+    0x0034, 0x0035, 0x0036, 0x0037, 0x0038, 0x0039, 0x003A, 0x003B, 0x003C, 0x003D, 0x003E, 0x003F, 0x00A1,
+    0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047, 0x0048, 0x0049, 0x004A, 0x004B, 0x004C, 0x004D,
+    0x004E, 0x004F, 0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057, 0x0058, 0x0059, 0x005A,
+    0x00C4, 0x00D6, 0x00D1, 0x00DC, 0x00A7, 0x00BF, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+    0x0068, 0x0069, 0x006A, 0x006B, 0x006C, 0x006D, 0x006E, 0x006F, 0x0070, 0x0071, 0x0072, 0x0073, 0x0074,
+    0x0075, 0x0076, 0x0077, 0x0078, 0x0079, 0x007A, 0x00E4, 0x00F6, 0x00F1, 0x00FC, 0x00E0,
+};
+
+/**
+ * \brief           ASCII to GSM 7-bit default alphabet, fast path for most common characters
+ *
+ * Characters from extension table are marked with \ref GSM7_EXT flag,
+ * characters without representation with \ref GSM7_INVALID
+ */
+static const uint8_t ascii_to_gsm7[128] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0A, 0xFF, 0x8A, 0x0D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x20, 0x21, 0x22, 0x23, 0x02, 0x25,
+    0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
+    0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F, 0x00, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x4B,
+    0x4C, 0x4D, 0x4E, 0x4F, 0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0xBC, 0xAF, 0xBE, 0x94,
+    0x11, 0xFF, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F, 0x70, 0x71,
+    0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0xA8, 0xC0, 0xA9, 0xBD, 0xFF,
+};
+
+/**
+ * \brief           GSM 7-bit extension table entry
+ */
+typedef struct {
+    uint8_t code;     /*!< Code after escape character */
+    uint16_t unicode; /*!< Unicode code point */
+} gsm7_ext_t;
+
+/**
+ * \brief           GSM 7-bit extension table
+ */
+static const gsm7_ext_t gsm7_ext[] = {
+    {0x0A, 0x000C}, {0x14, 0x005E}, {0x28, 0x007B}, {0x29, 0x007D}, {0x2F, 0x005C},
+    {0x3C, 0x005B}, {0x3D, 0x007E}, {0x3E, 0x005D}, {0x40, 0x007C}, {0x65, 0x20AC},
+};
+
+/**
+ * \brief           Reader of PDU in hex string format
+ */
+typedef struct {
+    const char* hex; /*!< Hex string */
+    size_t len;      /*!< Length of hex string */
+    size_t pos;      /*!< Current read position in hex string */
+} pdu_reader_t;
+
+/**
+ * \brief           7-bit septet unpacker
+ */
+typedef struct {
+    pdu_reader_t* r; /*!< Octet reader */
+    uint32_t acc;    /*!< Bit accumulator */
+    uint8_t bits;    /*!< Number of valid bits in accumulator */
+} gsm7_unpacker_t;
+
+/**
+ * \brief           Get next UTF-8 character from input data
+ * \param[in]       d: Input data
+ * \param[in]       len: Length of input data
+ * \param[out]      cp: Output variable for unicode code point
+ * \return          Number of bytes used by character, `0` on invalid sequence
+ */
+static size_t
+prv_utf8_get(const uint8_t* d, size_t len, uint32_t* cp) {
+    lwcell_unicode_t uni = {0};
+
+    for (size_t i = 0; i < len && i < 4; ++i) {
+        lwcellr_t res = lwcelli_unicode_decode(&uni, d[i]);
+        if (res == lwcellOK) {
+            switch (uni.t) {
+                case 1: *cp = uni.ch[0]; break;
+                case 2: *cp = ((uint32_t)(uni.ch[0] & 0x1F) << 6) | (uni.ch[1] & 0x3F); break;
+                case 3:
+                    *cp = ((uint32_t)(uni.ch[0] & 0x0F) << 12) | ((uint32_t)(uni.ch[1] & 0x3F) << 6)
+                          | (uni.ch[2] & 0x3F);
+                    break;
+                default:
+                    *cp = ((uint32_t)(uni.ch[0] & 0x07) << 18) | ((uint32_t)(uni.ch[1] & 0x3F) << 12)
+                          | ((uint32_t)(uni.ch[2] & 0x3F) << 6) | (uni.ch[3] & 0x3F);
+                    break;
+            }
+            return i + 1;
+        } else if (res != lwcellINPROG) {
+            break;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Write unicode code point in UTF-8 format
+ * \note            Output is always kept `NULL` terminated, character which does not fit is dropped
+ * \param[in]       cp: Unicode code point
+ * \param[out]      out: Output buffer
+ * \param[in]       size: Size of output buffer
+ * \param[in,out]   pos: Current write position in buffer
+ */
+static void
+prv_utf8_put(uint32_t cp, uint8_t* out, size_t size, size_t* pos) {
+    uint8_t b[4];
+    size_t n;
+
+    if (cp < 0x80) {
+        b[0] = (uint8_t)cp;
+        n = 1;
+    } else if (cp < 0x800) {
+        b[0] = (uint8_t)(0xC0 | (cp >> 6));
+        b[1] = (uint8_t)(0x80 | (cp & 0x3F));
+        n = 2;
+    } else if (cp < 0x10000) {
+        b[0] = (uint8_t)(0xE0 | (cp >> 12));
+        b[1] = (uint8_t)(0x80 | ((cp >> 6) & 0x3F));
+        b[2] = (uint8_t)(0x80 | (cp & 0x3F));
+        n = 3;
+    } else {
+        b[0] = (uint8_t)(0xF0 | (cp >> 18));
+        b[1] = (uint8_t)(0x80 | ((cp >> 12) & 0x3F));
+        b[2] = (uint8_t)(0x80 | ((cp >> 6) & 0x3F));
+        b[3] = (uint8_t)(0x80 | (cp & 0x3F));
+        n = 4;
+    }
+    if (*pos + n < size) {
+        LWCELL_MEMCPY(&out[*pos], b, n);
+        *pos += n;
+        out[*pos] = 0;
+    }
+}
+
+/**
+ * \brief           Convert unicode code point to GSM 7-bit septets
+ * \param[in]       cp: Unicode code point
+ * \param[out]      s: Output array for up to `2` septets
+ * \return          Number of septets, `0` if character has no GSM 7-bit representation
+ */
+static uint8_t
+prv_gsm7_from_unicode(uint32_t cp, uint8_t* s) {
+    if (cp < 0x80) { /* Fast path for ASCII */
+        uint8_t c = ascii_to_gsm7[cp];
+        if (c == GSM7_INVALID) {
+            return 0;
+        } else if (c & GSM7_EXT) {
+            s[0] = GSM7_ESC;
+            s[1] = c & ~GSM7_EXT;
+            return 2;
+        }
+        s[0] = c;
+        return 1;
+    }
+    for (uint8_t i = 0; i < LWCELL_ARRAYSIZE(gsm7_to_unicode); ++i) {
+        if (gsm7_to_unicode[i] == cp && i != GSM7_ESC) {
+            s[0] = i;
+            return 1;
+        }
+    }
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(gsm7_ext); ++i) {
+        if (gsm7_ext[i].unicode == cp) {
+            s[0] = GSM7_ESC;
+            s[1] = gsm7_ext[i].code;
+            return 2;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Get length of next character in units of septets or octets, depending on coding scheme
+ * \param[in]       dcs: Data coding scheme
+ * \param[in]       d: Input data
+ * \param[in]       len: Length of input data
+ * \param[out]      units: Output variable for number of septets (GSM 7-bit) or octets (8-bit, UCS2)
+ * \param[out]      s: Output array for GSM 7-bit septets or UCS2 code units
+ * \return          Number of input bytes used by character, `0` on invalid input
+ */
+static size_t
+prv_next_char(lwcell_sms_dcs_t dcs, const uint8_t* d, size_t len, uint8_t* units, uint16_t* s) {
+    uint32_t cp;
+    size_t used;
+
+    if (dcs == LWCELL_SMS_DCS_8BIT) {
+        s[0] = d[0];
+        *units = 1;
+        return 1;
+    }
+    if ((used = prv_utf8_get(d, len, &cp)) == 0) {
+        return 0;
+    }
+    if (dcs == LWCELL_SMS_DCS_GSM7) {
+        uint8_t sept[2];
+        if ((*units = prv_gsm7_from_unicode(cp, sept)) == 0) {
+            return 0;
+        }
+        s[0] = sept[0];
+        s[1] = sept[1];
+    } else if (cp < 0x10000) {
+        s[0] = (uint16_t)cp;
+        *units = 2;
+    } else { /* Surrogate pair */
+        cp -= 0x10000;
+        s[0] = (uint16_t)(0xD800 | (cp >> 10));
+        s[1] = (uint16_t)(0xDC00 | (cp & 0x3FF));
+        *units = 4;
+    }
+    return used;
+}
+
+/**
+ * \brief           Get length of data that fit to single SMS
+ *
+ * Characters are never split between parts.
+ * Use it to split long message to concatenated parts
+ *
+ * \param[in]       dcs: Data coding scheme
+ * \param[in]       data: Data to send, UTF-8 text for GSM 7-bit and UCS2 schemes
+ * \param[in]       len: Length of data in units of bytes
+ * \param[in]       concat: Set to `1` if part is sent as concatenated SMS with user data header
+ * \return          Number of input bytes which fit to single SMS, `0` if data contain invalid character
+ */
+size_t
+lwcell_sms_pdu_part_len(lwcell_sms_dcs_t dcs, const void* data, size_t len, uint8_t concat) {
+    const uint8_t* d = data;
+    size_t cap, used = 0, off = 0;
+
+    if (dcs == LWCELL_SMS_DCS_GSM7) {
+        cap = concat ? 153 : 160;
+    } else {
+        cap = concat ? (140 - PDU_UDH_LEN) : 140;
+    }
+    if (dcs == LWCELL_SMS_DCS_8BIT) { /* Fast path, no character boundaries */
+        return LWCELL_MIN(len, cap);
+    }
+    while (off < len) {
+        uint16_t s[2];
+        uint8_t units;
+        size_t n = prv_next_char(dcs, &d[off], len - off, &units, s);
+
+        if (n == 0) {
+            return 0;
+        }
+        if (used + units > cap) {
+            break;
+        }
+        used += units;
+        off += n;
+    }
+    return off;
+}
+
+/**
+ * \brief           Get number of SMS parts needed to send data
+ * \param[in]       dcs: Data coding scheme
+ * \param[in]       data: Data to send, UTF-8 text for GSM 7-bit and UCS2 schemes
+ * \param[in]       len: Length of data in units of bytes
+ * \return          Number of parts, `1` for single SMS, `0` on invalid character or more than `255` parts
+ */
+size_t
+lwcell_sms_pdu_parts(lwcell_sms_dcs_t dcs, const void* data, size_t len) {
+    const uint8_t* d = data;
+    size_t parts = 0;
+
+    if (len == 0) {
+        return 0;
+    } else if (lwcell_sms_pdu_part_len(dcs, d, len, 0) == len) {
+        return 1;
+    }
+    for (size_t off = 0, n; off < len; off += n) {
+        if ((n = lwcell_sms_pdu_part_len(dcs, &d[off], len - off, 1)) == 0 || ++parts > 255) {
+            return 0;
+        }
+    }
+    return parts;
+}
+
+/**
+ * \brief           Encode SMS-SUBMIT PDU
+ *
+ * Service center address from SIM card is used, PDU starts with `00` octet.
+ * Length for `AT+CMGS` command is returned length minus `1`
+ *
+ * \param[out]      pdu: Output buffer, \ref LWCELL_SMS_PDU_MAX_LEN bytes is always enough
+ * \param[in]       pdu_size: Size of output buffer
+ * \param[in]       num: Destination phone number, international number starts with `+`
+ * \param[in]       dcs: Data coding scheme
+ * \param[in]       data: Data to send, UTF-8 text for GSM 7-bit and UCS2 schemes
+ * \param[in]       len: Length of data in units of bytes, see \ref lwcell_sms_pdu_part_len
+ * \param[in]       concat: Concatenated part information. Set to `NULL` for single SMS
+ * \return          Length of PDU in units of bytes, `0` on error
+ */
+size_t
+lwcell_sms_pdu_encode(uint8_t* pdu, size_t pdu_size, const char* num, lwcell_sms_dcs_t dcs, const void* data,
+                      size_t len, const lwcell_sms_concat_t* concat) {
+    const uint8_t* d = data;
+    size_t n = 0, digits, udl, udl_pos, off = 0;
+    uint8_t intl = 0;
+
+#define PDU_PUT(b)                                                                                                     \
+    do {                                                                                                               \
+        if (n >= pdu_size) {                                                                                           \
+            return 0;                                                                                                  \
+        }                                                                                                              \
+        pdu[n++] = (uint8_t)(b);                                                                                       \
+    } while (0)
+
+    LWCELL_ASSERT0(pdu != NULL);
+    LWCELL_ASSERT0(num != NULL);
+
+    if (*num == '+') {
+        intl = 1;
+        ++num;
+    }
+    digits = strlen(num);
+    if (digits == 0 || digits > 20) {
+        return 0;
+    }
+
+    PDU_PUT(0x00);                                /* Use service center address from SIM */
+    PDU_PUT(0x01 | (concat != NULL ? 0x40 : 0x00)); /* SMS-SUBMIT, user data header indicator */
+    PDU_PUT(0x00);                                /* Message reference is set by device */
+    PDU_PUT(digits);
+    PDU_PUT(intl ? 0x91 : 0x81);
+    for (size_t i = 0; i < digits; i += 2) { /* Swapped semi-octets */
+        uint8_t lo = (uint8_t)(num[i] - '0'), hi = i + 1 < digits ? (uint8_t)(num[i + 1] - '0') : 0x0F;
+        if (lo > 9 || (hi > 9 && hi != 0x0F)) {
+            return 0;
+        }
+        PDU_PUT(lo | (hi << 4));
+    }
+    PDU_PUT(0x00); /* Protocol identifier */
+    PDU_PUT(dcs);
+    udl_pos = n;
+    PDU_PUT(0x00); /* User data length, set at the end */
+    if (concat != NULL) {
+        PDU_PUT(PDU_UDH_LEN - 1);
+        PDU_PUT(0x00); /* Concatenated SMS, 8-bit reference number */
+        PDU_PUT(0x03);
+        PDU_PUT(concat->ref);
+        PDU_PUT(concat->total);
+        PDU_PUT(concat->seq);
+    }
+
+    if (dcs == LWCELL_SMS_DCS_GSM7) {
+        uint32_t acc = 0;
+        uint8_t bits = 0;
+
+        /* Septets are aligned to septet boundary after user data header */
+        udl = concat != NULL ? ((PDU_UDH_LEN * 8 + 6) / 7) : 0;
+        bits = (uint8_t)(udl * 7 - PDU_UDH_LEN * (concat != NULL ? 8 : 0));
+        while (off < len) {
+            uint16_t s[2];
+            uint8_t units;
+            size_t used = prv_next_char(dcs, &d[off], len - off, &units, s);
+
+            if (used == 0) {
+                return 0;
+            }
+            for (uint8_t i = 0; i < units; ++i) {
+                acc |= (uint32_t)s[i] << bits;
+                bits += 7;
+                while (bits >= 8) {
+                    PDU_PUT(acc);
+                    acc >>= 8;
+                    bits -= 8;
+                }
+            }
+            udl += units;
+            off += used;
+        }
+        if (bits > 0) {
+            PDU_PUT(acc);
+        }
+        if (udl > 160) {
+            return 0;
+        }
+    } else {
+        while (off < len) {
+            uint16_t s[2];
+            uint8_t units;
+            size_t used = prv_next_char(dcs, &d[off], len - off, &units, s);
+
+            if (used == 0) {
+                return 0;
+            }
+            if (dcs == LWCELL_SMS_DCS_8BIT) {
+                PDU_PUT(s[0]);
+            } else {
+                for (uint8_t i = 0; i < units / 2; ++i) { /* Big endian code units */
+                    PDU_PUT(s[i] >> 8);
+                    PDU_PUT(s[i]);
+                }
+            }
+            off += used;
+        }
+        udl = n - udl_pos - 1;
+        if (udl > 140) {
+            return 0;
+        }
+    }
+    pdu[udl_pos] = (uint8_t)udl;
+    return n;
+#undef PDU_PUT
+}
+
+/**
+ * \brief           Get next octet from hex string
+ * \param[in]       r: PDU reader
+ * \param[out]      b: Output variable for octet
+ * \return          `1` on success, `0` on end of input or invalid character
+ */
+static uint8_t
+prv_pdu_get(pdu_reader_t* r, uint8_t* b) {
+    char h, l;
+
+    if (r->pos + 2 > r->len) {
+        return 0;
+    }
+    h = r->hex[r->pos];
+    l = r->hex[r->pos + 1];
+    if (!LWCELL_CHARISHEXNUM(h) || !LWCELL_CHARISHEXNUM(l)) {
+        return 0;
+    }
+    *b = (uint8_t)((LWCELL_CHARHEXTONUM(h) << 4) | LWCELL_CHARHEXTONUM(l));
+    r->pos += 2;
+    return 1;
+}
+
+/**
+ * \brief           Get next septet from packed 7-bit data
+ * \param[in]       u: Septet unpacker
+ * \param[out]      s: Output variable for septet
+ * \return          `1` on success, `0` on end of input
+ */
+static uint8_t
+prv_gsm7_get(gsm7_unpacker_t* u, uint8_t* s) {
+    if (u->bits < 7) {
+        uint8_t b;
+        if (!prv_pdu_get(u->r, &b)) {
+            return 0;
+        }
+        u->acc |= (uint32_t)b << u->bits;
+        u->bits += 8;
+    }
+    *s = (uint8_t)(u->acc & 0x7F);
+    u->acc >>= 7;
+    u->bits -= 7;
+    return 1;
+}
+
+/**
+ * \brief           Decode packed GSM 7-bit text to UTF-8
+ * \param[in]       u: Septet unpacker
+ * \param[in]       septets: Number of septets to decode
+ * \param[out]      out: Output buffer
+ * \param[in]       size: Size of output buffer
+ * \return          Length of decoded text in units of bytes
+ */
+static size_t
+prv_gsm7_decode(gsm7_unpacker_t* u, size_t septets, uint8_t* out, size_t size) {
+    size_t pos = 0;
+    uint8_t s;
+
+    out[0] = 0;
+    for (size_t i = 0; i < septets && prv_gsm7_get(u, &s); ++i) {
+        uint32_t cp = gsm7_to_unicode[s];
+
+        if (s == GSM7_ESC && i + 1 < septets && prv_gsm7_get(u, &s)) {
+            ++i;
+            cp = gsm7_to_unicode[s]; /* Unknown extension is displayed as basic character */
+            for (size_t k = 0; k < LWCELL_ARRAYSIZE(gsm7_ext); ++k) {
+                if (gsm7_ext[k].code == s) {
+                    cp = gsm7_ext[k].unicode;
+                    break;
+                }
+            }
+        }
+        prv_utf8_put(cp, out, size, &pos);
+    }
+    return pos;
+}
+
+/**
+ * \brief           Decode semi-octet value
+ * \param[in]       b: Octet with swapped semi-octets
+ * \return          Decimal value
+ */
+static int
+prv_semi_octet(uint8_t b) {
+    return (b & 0x0F) * 10 + ((b >> 4) & 0x0F);
+}
+
+/**
+ * \brief           Decode SMS-DELIVER PDU, as received from device with `+CMGR` or `+CMT` in PDU mode
+ * \param[in]       hex: PDU in hex string format, starting with service center address
+ * \param[in]       hex_len: Length of hex string
+ * \param[out]      sms: Output structure for decoded message
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_sms_pdu_decode(const char* hex, size_t hex_len, lwcell_sms_pdu_t* sms) {
+    pdu_reader_t r = {.hex = hex, .len = hex_len};
+    uint8_t b, fo, oa_len, oa_type, dcs, udl, udhl = 0;
+    size_t udh_start;
+
+#define PDU_GET(v)                                                                                                     \
+    do {                                                                                                               \
+        if (!prv_pdu_get(&r, &(v))) {                                                                                  \
+            return lwcellERR;                                                                                          \
+        }                                                                                                              \
+    } while (0)
+
+    LWCELL_ASSERT(hex != NULL);
+    LWCELL_ASSERT(sms != NULL);
+    LWCELL_MEMSET(sms, 0x00, sizeof(*sms));
+
+    PDU_GET(b); /* Skip service center address */
+    r.pos += 2 * (size_t)b;
+    PDU_GET(fo);
+    if ((fo & 0x03) != 0x00) { /* Only SMS-DELIVER is supported */
+        return lwcellERRPAR;
+    }
+
+    /* Originating address */
+    PDU_GET(oa_len);
+    PDU_GET(oa_type);
+    if ((oa_type & 0x70) == 0x50) { /* Alphanumeric address, packed GSM 7-bit */
+        pdu_reader_t ar = {.hex = &hex[r.pos], .len = LWCELL_MIN(hex_len - r.pos, (size_t)oa_len)};
+        gsm7_unpacker_t u = {.r = &ar};
+
+        prv_gsm7_decode(&u, (size_t)oa_len * 4 / 7, (uint8_t*)sms->number, sizeof(sms->number));
+        r.pos += ((size_t)oa_len + 1) & ~(size_t)1;
+    } else {
+        size_t pos = 0;
+
+        if ((oa_type & 0x70) == 0x10) {
+            sms->number[pos++] = '+';
+        }
+        for (uint8_t i = 0; i < oa_len; i += 2) {
+            PDU_GET(b);
+            if (pos + 2 < sizeof(sms->number)) {
+                sms->number[pos++] = (char)('0' + (b & 0x0F));
+                if (i + 1 < oa_len) {
+                    sms->number[pos++] = (char)('0' + (b >> 4));
+                }
+            }
+        }
+        sms->number[pos] = 0;
+    }
+
+    PDU_GET(b); /* Protocol identifier */
+    PDU_GET(dcs);
+    if ((dcs & 0xC0) == 0x00 || (dcs & 0xC0) == 0x40) { /* General data coding */
+        sms->dcs = (lwcell_sms_dcs_t)(dcs & 0x0C);
+    } else if ((dcs & 0xF0) == 0xF0) { /* Data coding and message class */
+        sms->dcs = (dcs & 0x04) ? LWCELL_SMS_DCS_8BIT : LWCELL_SMS_DCS_GSM7;
+    } else if ((dcs & 0xF0) == 0xE0) {
+        sms->dcs = LWCELL_SMS_DCS_UCS2;
+    } else {
+        sms->dcs = LWCELL_SMS_DCS_GSM7;
+    }
+    if (sms->dcs == 0x0C) { /* Reserved alphabet, treat as binary */
+        sms->dcs = LWCELL_SMS_DCS_8BIT;
+    }
+
+    /* Service center time stamp */
+    PDU_GET(b);
+    sms->dt.tm_year = prv_semi_octet(b) + 100;
+    PDU_GET(b);
+    sms->dt.tm_mon = prv_semi_octet(b) - 1;
+    PDU_GET(b);
+    sms->dt.tm_mday = prv_semi_octet(b);
+    PDU_GET(b);
+    sms->dt.tm_hour = prv_semi_octet(b);
+    PDU_GET(b);
+    sms->dt.tm_min = prv_semi_octet(b);
+    PDU_GET(b);
+    sms->dt.tm_sec = prv_semi_octet(b);
+    PDU_GET(b); /* Time zone */
+
+    /* User data header */
+    PDU_GET(udl);
+    udh_start = r.pos;
+    if (fo & 0x40) {
+        PDU_GET(udhl);
+        while (r.pos < udh_start + 2 + 2 * (size_t)udhl) {
+            uint8_t iei, iel, v[4];
+
+            PDU_GET(iei);
+            PDU_GET(iel);
+            for (uint8_t i = 0; i < iel; ++i) {
+                PDU_GET(b);
+                if (i < sizeof(v)) {
+                    v[i] = b;
+                }
+            }
+            if (iei == 0x00 && iel == 3) {
+                sms->concat.ref = v[0];
+                sms->concat.total = v[1];
+                sms->concat.seq = v[2];
+            } else if (iei == 0x08 && iel == 4) {
+                sms->concat.ref = (uint16_t)((v[0] << 8) | v[1]);
+                sms->concat.total = v[2];
+                sms->concat.seq = v[3];
+            }
+        }
+        r.pos = udh_start + 2 + 2 * (size_t)udhl;
+    }
+
+    /* User data */
+    if (sms->dcs == LWCELL_SMS_DCS_GSM7) {
+        gsm7_unpacker_t u = {.r = &r};
+        size_t skip = 0;
+
+        if (fo & 0x40) { /* Drop fill bits after header */
+            size_t hdr_bits = ((size_t)udhl + 1) * 8;
+
+            skip = (hdr_bits + 6) / 7;
+            if (skip * 7 > hdr_bits) {
+                PDU_GET(b);
+                u.acc = (uint32_t)b >> (skip * 7 - hdr_bits);
+                u.bits = (uint8_t)(8 - (skip * 7 - hdr_bits));
+            }
+        }
+        if (udl < skip) {
+            return lwcellERR;
+        }
+        sms->length = prv_gsm7_decode(&u, udl - skip, sms->data, sizeof(sms->data));
+    } else {
+        size_t ud_len = udl - ((fo & 0x40) ? ((size_t)udhl + 1) : 0);
+        size_t pos = 0;
+
+        if (udl < ((fo & 0x40) ? ((size_t)udhl + 1) : 0)) {
+            return lwcellERR;
+        }
+        for (size_t i = 0; i < ud_len; ++i) {
+            PDU_GET(b);
+            if (sms->dcs == LWCELL_SMS_DCS_8BIT) {
+                if (pos < sizeof(sms->data)) {
+                    sms->data[pos++] = b;
+                }
+            } else if (i + 1 < ud_len) { /* UCS2 code unit, big endian */
+                uint32_t cp;
+                uint8_t b2;
+
+                PDU_GET(b2);
+                ++i;
+                cp = ((uint32_t)b << 8) | b2;
+                if (cp >= 0xD800 && cp < 0xDC00 && i + 2 < ud_len) { /* Surrogate pair */
+                    uint8_t b3, b4;
+
+                    PDU_GET(b3);
+                    PDU_GET(b4);
+                    i += 2;
+                    cp = 0x10000 + (((cp & 0x3FF) << 10) | ((((uint32_t)b3 << 8) | b4) & 0x3FF));
+                }
+                prv_utf8_put(cp, sms->data, sizeof(sms->data), &pos);
+            }
+        }
+        sms->length = pos;
+    }
+    return lwcellOK;
+#undef PDU_GET
+}
+
+#endif /* LWCELL_CFG_SMS_PDU || __DOXYGEN__ */
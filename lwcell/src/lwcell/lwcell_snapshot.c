@@ -0,0 +1,271 @@
+/**
+ * \file            lwcell_snapshot.c
+ * \brief           Warm-restart snapshot API
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_snapshot.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_SNAPSHOT || __DOXYGEN__
+
+/* Magic number, combined with structure size to reject snapshots of other builds */
+#define SNAPSHOT_MAGIC ((uint32_t)0x534E0000UL | (uint32_t)(sizeof(lwcell_snapshot_t) & 0xFFFFU))
+
+/**
+ * \brief           Calculate check value of snapshot fields after `check` field
+ * \param[in]       snap: Snapshot
+ * \return          FNV-1a hash of fields
+ */
+static uint32_t
+prv_snapshot_check(const lwcell_snapshot_t* snap) {
+    const uint8_t* d = (const uint8_t*)&snap->check + sizeof(snap->check);
+    const uint8_t* end = (const uint8_t*)snap + sizeof(*snap);
+    uint32_t hash = 2166136261UL;
+
+    for (; d < end; ++d) {
+        hash = (hash ^ *d) * 16777619UL;
+    }
+    return hash;
+}
+
+/**
+ * \brief           Save current stack state to snapshot
+ *
+ * Call it before MCU enters deep sleep, when no command is in progress,
+ * and keep the structure in memory retained during sleep
+ *
+ * \note            No command is sent to device
+ * \param[out]      snap: Pointer to snapshot to fill
+ * \return          \ref lwcellOK on success, \ref lwcellERR when device was not identified yet
+ */
+lwcellr_t
+lwcell_snapshot_save(lwcell_snapshot_t* snap) {
+    lwcellr_t res = lwcellERR;
+
+    LWCELL_ASSERT(snap != NULL);
+
+    LWCELL_MEMSET(snap, 0x00, sizeof(*snap)); /* Padding bytes are part of check value */
+    lwcell_core_lock();
+    if (lwcell.status.f.initialized && lwcell.m.model_serial_number[0] != '\0') {
+        LWCELL_MEMCPY(snap->model_manufacturer, lwcell.m.model_manufacturer, sizeof(snap->model_manufacturer));
+        LWCELL_MEMCPY(snap->model_number, lwcell.m.model_number, sizeof(snap->model_number));
+        LWCELL_MEMCPY(snap->model_serial_number, lwcell.m.model_serial_number, sizeof(snap->model_serial_number));
+        LWCELL_MEMCPY(snap->model_revision, lwcell.m.model_revision, sizeof(snap->model_revision));
+        snap->model = lwcell.m.model;
+        snap->sim_state = lwcell.m.sim.state;
+        snap->network_status = lwcell.m.network.status;
+        snap->is_attached = lwcell.m.network.is_attached;
+        snap->ip_addr = lwcell.m.network.ip_addr;
+#if LWCELL_CFG_SMS
+        snap->sms_ready = lwcell.m.sms.ready;
+        snap->sms_enabled = lwcell.m.sms.enabled;
+        for (size_t i = 0; i < LWCELL_ARRAYSIZE(snap->sms_mem); ++i) {
+            snap->sms_mem[i].mem_available = lwcell.m.sms.mem[i].mem_available;
+            snap->sms_mem[i].current = lwcell.m.sms.mem[i].current;
+            snap->sms_mem[i].total = (uint16_t)lwcell.m.sms.mem[i].total;
+            snap->sms_mem[i].used = (uint16_t)lwcell.m.sms.mem[i].used;
+        }
+#endif /* LWCELL_CFG_SMS */
+#if LWCELL_CFG_PHONEBOOK
+        snap->pb_ready = lwcell.m.pb.ready;
+        snap->pb_enabled = lwcell.m.pb.enabled;
+        snap->pb_mem.mem_available = lwcell.m.pb.mem.mem_available;
+        snap->pb_mem.current = lwcell.m.pb.mem.current;
+        snap->pb_mem.total = (uint16_t)lwcell.m.pb.mem.total;
+        snap->pb_mem.used = (uint16_t)lwcell.m.pb.mem.used;
+#endif /* LWCELL_CFG_PHONEBOOK */
+#if LWCELL_CFG_CONN
+        for (size_t i = 0; i < LWCELL_CFG_MAX_CONNS; ++i) {
+            const lwcell_conn_t* conn = &lwcell.m.conns[i];
+
+            if (conn->status.f.active && !conn->status.f.in_closing) {
+                snap->conns[i].active = 1;
+                snap->conns[i].client = conn->status.f.client;
+                snap->conns[i].type = conn->type;
+                snap->conns[i].remote_ip = conn->remote_ip;
+                snap->conns[i].remote_port = conn->remote_port;
+                snap->conns[i].local_port = conn->local_port;
+            }
+        }
+#endif /* LWCELL_CFG_CONN */
+        snap->magic = SNAPSHOT_MAGIC;
+        snap->check = prv_snapshot_check(snap);
+        res = lwcellOK;
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Restore stack state from snapshot and resynchronize it with device
+ *
+ * Call it after \ref lwcell_init on MCU wake-up, instead of \ref lwcell_reset.
+ * Saved state is applied immediately, status queries are then sent to device
+ *
+ * \param[in]       snap: Snapshot saved with \ref lwcell_snapshot_save
+ * \param[in]       conn_evt_fn: Callback function for restored connections.
+ *                      Set to `NULL` to not restore connections
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, \ref lwcellERRPAR when snapshot is not valid,
+ *                  member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_snapshot_restore(const lwcell_snapshot_t* snap, lwcell_evt_fn conn_evt_fn, const lwcell_api_cmd_evt_fn evt_fn,
+                        void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(snap != NULL);
+
+    if (snap->magic != SNAPSHOT_MAGIC || snap->check != prv_snapshot_check(snap)
+        || snap->model >= LWCELL_DEVICE_MODEL_END) {
+        return lwcellERRPAR;
+    }
+
+    lwcell_core_lock();
+    LWCELL_MEMCPY(lwcell.m.model_manufacturer, snap->model_manufacturer, sizeof(lwcell.m.model_manufacturer));
+    LWCELL_MEMCPY(lwcell.m.model_number, snap->model_number, sizeof(lwcell.m.model_number));
+    LWCELL_MEMCPY(lwcell.m.model_serial_number, snap->model_serial_number, sizeof(lwcell.m.model_serial_number));
+    LWCELL_MEMCPY(lwcell.m.model_revision, snap->model_revision, sizeof(lwcell.m.model_revision));
+    if (!LWCELL_DEV_MODEL_IS_FIXED) {
+        lwcell.m.model = snap->model;
+    }
+    lwcell.m.sim.state = snap->sim_state;
+    lwcell.m.network.status = snap->network_status;
+    lwcell.m.network.is_attached = snap->is_attached;
+    lwcell.m.network.ip_addr = snap->ip_addr;
+    lwcell.m.network.ip_state = snap->is_attached ? LWCELL_IP_STATE_ACTIVE : LWCELL_IP_STATE_UNKNOWN;
+#if LWCELL_CFG_SMS
+    lwcell.m.sms.ready = snap->sms_ready;
+    lwcell.m.sms.enabled = snap->sms_enabled;
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(snap->sms_mem); ++i) {
+        lwcell.m.sms.mem[i].mem_available = snap->sms_mem[i].mem_available;
+        lwcell.m.sms.mem[i].current = snap->sms_mem[i].current;
+        lwcell.m.sms.mem[i].total = snap->sms_mem[i].total;
+        lwcell.m.sms.mem[i].used = snap->sms_mem[i].used;
+    }
+#endif /* LWCELL_CFG_SMS */
+#if LWCELL_CFG_PHONEBOOK
+    lwcell.m.pb.ready = snap->pb_ready;
+    lwcell.m.pb.enabled = snap->pb_enabled;
+    lwcell.m.pb.mem.mem_available = snap->pb_mem.mem_available;
+    lwcell.m.pb.mem.current = snap->pb_mem.current;
+    lwcell.m.pb.mem.total = snap->pb_mem.total;
+    lwcell.m.pb.mem.used = snap->pb_mem.used;
+#endif /* LWCELL_CFG_PHONEBOOK */
+#if LWCELL_CFG_CONN
+    lwcell.snapshot_conns = 0;
+    for (size_t i = 0; conn_evt_fn != NULL && i < LWCELL_CFG_MAX_CONNS; ++i) {
+        lwcell_conn_t* conn = &lwcell.m.conns[i];
+        uint8_t id;
+
+        if (!snap->conns[i].active || conn->status.f.active) {
+            continue;
+        }
+        id = conn->val_id;
+        LWCELL_MEMSET(conn, 0x00, sizeof(*conn));
+        conn->num = LWCELL_U8(i);
+        conn->status.f.active = 1;
+        conn->val_id = ++id;
+#if LWCELL_CFG_CONN_WRITE_RING
+        /* Ring keeps one byte unused, write returns error when allocation fails */
+        lwcell_buff_init(&conn->tx_ring, LWCELL_CFG_CONN_WRITE_RING_LEN + 1);
+#endif /* LWCELL_CFG_CONN_WRITE_RING */
+#if LWCELL_CFG_CONN_MANUAL_RECV
+        conn->rx_credit = LWCELL_CFG_CONN_RECV_WINDOW; /* Full receive window is available */
+#endif                                             /* LWCELL_CFG_CONN_MANUAL_RECV */
+        conn->status.f.client = snap->conns[i].client;
+        conn->type = snap->conns[i].type;
+        conn->remote_ip = snap->conns[i].remote_ip;
+        conn->remote_port = snap->conns[i].remote_port;
+        conn->local_port = snap->conns[i].local_port;
+        conn->state = LWCELL_CONN_STATE_UNKNOWN; /* Set by status query, if connection is still open */
+        conn->evt_func = conn_evt_fn;
+        lwcell.snapshot_conns |= (uint32_t)1 << i;
+    }
+#else  /* LWCELL_CFG_CONN */
+    LWCELL_UNUSED(conn_evt_fn);
+#endif /* !LWCELL_CFG_CONN */
+    lwcell_core_unlock();
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE_HDR);
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_SNAPSHOT_RESTORE;
+    LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CFG_AT_ECHO ? LWCELL_CMD_ATE1 : LWCELL_CMD_ATE0; /* Check device replies */
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 10000);
+}
+
+#if LWCELL_CFG_CONN || __DOXYGEN__
+
+/**
+ * \brief           Resume connections restored from snapshot, after device status was queried
+ *
+ * Connections not reported by device were closed while MCU was in sleep
+ *
+ * \note            Function is called from processing thread with core locked
+ */
+void
+lwcelli_snapshot_conns_resume(void) {
+    for (size_t i = 0; i < LWCELL_CFG_MAX_CONNS; ++i) {
+        lwcell_conn_t* conn = &lwcell.m.conns[i];
+
+        if (!(lwcell.snapshot_conns & ((uint32_t)1 << i))) {
+            continue;
+        }
+        lwcell.snapshot_conns &= ~((uint32_t)1 << i);
+        if (!conn->status.f.active) {
+            continue; /* Closed during resynchronization */
+        }
+        if ((conn->state == LWCELL_CONN_STATE_UNKNOWN || conn->state == LWCELL_CONN_STATE_INITIAL)
+            && !LWCELL_CONN_IS_CA()) {
+            lwcelli_conn_closed_process(conn->num, 0);
+            continue;
+        }
+        lwcell.evt.type = LWCELL_EVT_CONN_ACTIVE;
+        lwcell.evt.evt.conn_active_close.client = conn->status.f.client;
+        lwcell.evt.evt.conn_active_close.conn = conn;
+        lwcell.evt.evt.conn_active_close.forced = 0;
+        lwcell.evt.evt.conn_active_close.res = lwcellOK;
+        lwcelli_conn_start_timeout(conn); /* Start poll events, callback may change interval */
+        lwcelli_send_conn_cb(conn, NULL);
+#if LWCELL_CFG_CONN_MANUAL_RECV
+        if (!LWCELL_CONN_IS_CA()) {
+            lwcell_conn_query_rx_pending(conn, NULL, NULL, 0); /* Data received during sleep were not reported */
+        }
+#endif /* LWCELL_CFG_CONN_MANUAL_RECV */
+    }
+}
+
+#endif /* LWCELL_CFG_CONN || __DOXYGEN__ */
+
+#endif /* LWCELL_CFG_SNAPSHOT || __DOXYGEN__ */
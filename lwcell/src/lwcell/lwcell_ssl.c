@@ -0,0 +1,163 @@
+/**
+ * \file            lwcell_ssl.c
+ * \brief           SSL configuration API
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_ssl.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_SSL || __DOXYGEN__
+
+/* Time given to each file chunk, in units of milliseconds */
+#define SSL_FILE_CHUNK_TIMEOUT 10000
+
+/**
+ * \brief           Upload file to device file system
+ *
+ * Existing file with the same name is overwritten.
+ * Data are read with `read_fn` callback from producing thread, chunk by chunk,
+ * while command is in progress.
+ *
+ * \param[in]       name: File name in `customer` directory, such as `ca.crt`.
+ *                      It must stay valid until command finishes
+ * \param[in]       len: Total file length in units of bytes
+ * \param[in]       read_fn: Callback function to read file data
+ * \param[in]       read_arg: Custom argument for read callback function
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ssl_file_upload(const char* name, size_t len, lwcell_ssl_read_fn read_fn, void* read_arg,
+                       const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(name != NULL && strlen(name) > 0);
+    LWCELL_ASSERT(len > 0);
+    LWCELL_ASSERT(read_fn != NULL);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(ssl_upload));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CFSWFILE;
+    LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CFSINIT;
+    LWCELL_MSG_VAR_REF(msg).msg.ssl_upload.name = name;
+    LWCELL_MSG_VAR_REF(msg).msg.ssl_upload.len = len;
+    LWCELL_MSG_VAR_REF(msg).msg.ssl_upload.read_fn = read_fn;
+    LWCELL_MSG_VAR_REF(msg).msg.ssl_upload.read_arg = read_arg;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd,
+                                             LWCELL_U32(len / LWCELL_CFG_SSL_FILE_CHUNK_LEN + 2)
+                                                 * SSL_FILE_CHUNK_TIMEOUT);
+}
+
+/**
+ * \brief           Upload file to device file system, only when its content differs from installed file
+ *
+ * Digest of file content is calculated from data returned by `read_fn`.
+ * Installed file is kept when it has the same length and marker file, named after the file
+ * with digest appended as `.xxxxxxxx` hex suffix, exists in device file system.
+ * Otherwise file is uploaded the same way as with \ref lwcell_ssl_file_upload and marker is written after it,
+ * so that interrupted upload is repeated on next call.
+ *
+ * Boot-time certificate setup hence needs a few short commands only, when certificates have not changed.
+ *
+ * \note            Marker files of previous file versions are not deleted, they are `8` bytes long each
+ *
+ * \param[in]       name: File name in `customer` directory, such as `ca.crt`.
+ *                      It must stay valid until command finishes
+ * \param[in]       len: Total file length in units of bytes
+ * \param[in]       read_fn: Callback function to read file data. It is called for whole file
+ *                      to calculate the digest, and again for upload when needed
+ * \param[in]       read_arg: Custom argument for read callback function
+ * \param[out]      uploaded: Pointer to output variable, set to `1` when file was uploaded
+ *                      or to `0` when installed file was kept. Set to `NULL` if not used
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ssl_file_sync(const char* name, size_t len, lwcell_ssl_read_fn read_fn, void* read_arg, uint8_t* uploaded,
+                     const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(name != NULL && strlen(name) > 0);
+    LWCELL_ASSERT(len > 0);
+    LWCELL_ASSERT(read_fn != NULL);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(ssl_upload));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CFSWFILE;
+    LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CFSINIT;
+    LWCELL_MSG_VAR_REF(msg).msg.ssl_upload.name = name;
+    LWCELL_MSG_VAR_REF(msg).msg.ssl_upload.len = len;
+    LWCELL_MSG_VAR_REF(msg).msg.ssl_upload.read_fn = read_fn;
+    LWCELL_MSG_VAR_REF(msg).msg.ssl_upload.read_arg = read_arg;
+    LWCELL_MSG_VAR_REF(msg).msg.ssl_upload.uploaded = uploaded;
+    LWCELL_MSG_VAR_REF(msg).msg.ssl_upload.sync = 1;
+
+    /* Two file checks and marker write are given time of one chunk each */
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd,
+                                             LWCELL_U32(len / LWCELL_CFG_SSL_FILE_CHUNK_LEN + 5)
+                                                 * SSL_FILE_CHUNK_TIMEOUT);
+}
+
+/**
+ * \brief           Configure SSL context
+ *
+ * Protocol version and optional server name indication are set first.
+ * Previously uploaded certificate files are then converted to context
+ * (CA when `ca` is set, client certificate when both `cert` and `key` are set).
+ *
+ * \param[in]       cfg: SSL configuration. It must stay valid until command finishes
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ssl_config(const lwcell_ssl_cfg_t* cfg, const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg,
+                  const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_ASSERT(cfg != NULL);
+    LWCELL_ASSERT(cfg->ctx <= 5);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(ssl_cfg));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CSSLCFG_SSLVERSION;
+    LWCELL_MSG_VAR_REF(msg).msg.ssl_cfg.cfg = cfg;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 10000);
+}
+
+#endif /* LWCELL_CFG_SSL || __DOXYGEN__ */
@@ -0,0 +1,266 @@
+/**
+ * \file            lwcell_stats.c
+ * \brief           Command latency statistics and throughput counters
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_stats.h"
+#include "lwcell/lwcell_private.h"
+#include "system/lwcell_sys.h"
+
+#if LWCELL_CFG_STATS || __DOXYGEN__
+
+/**
+ * \brief           Add new sample to phase data
+ * \param[in,out]   p: Phase data
+ * \param[in]       time: Sample in units of milliseconds
+ * \param[in]       first: Set to `1` for first sample of the entry
+ */
+static void
+prv_phase_add(lwcell_stats_phase_data_t* p, uint32_t time, uint8_t first) {
+    size_t bucket = 0;
+
+    for (uint32_t t = time; t > 0 && bucket < LWCELL_CFG_STATS_HIST_BUCKETS - 1; t >>= 1) {
+        ++bucket;
+    }
+    ++p->hist[bucket];
+    if (first || time < p->min) {
+        p->min = time;
+    }
+    if (time > p->max) {
+        p->max = time;
+    }
+    p->sum += time;
+}
+
+/**
+ * \brief           Command has been taken from producer queue
+ * \note            Function must be called with core locked
+ */
+void
+lwcelli_stats_cmd_dequeued(void) {
+    lwcell.cmd_stats.cur.dequeued = lwcell.cmd_stats.cur.started = lwcell_sys_now();
+    lwcell.cmd_stats.cur.parse = 0;
+}
+
+/**
+ * \brief           Command transmission to device is about to start
+ * \note            Function must be called with core locked
+ */
+void
+lwcelli_stats_cmd_started(void) {
+    lwcell.cmd_stats.cur.started = lwcell_sys_now();
+    lwcell.cmd_stats.cur.parse = 0;
+}
+
+/**
+ * \brief           Add time spent in input processing
+ * \note            Function must be called with core locked
+ * \param[in]       time: Processing time in units of milliseconds
+ */
+void
+lwcelli_stats_parse_time(uint32_t time) {
+    if (lwcell.msg != NULL) {
+        lwcell.cmd_stats.cur.parse += time;
+    }
+}
+
+/**
+ * \brief           Command has finished, store its times
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Finished message
+ * \param[in]       res: Command result
+ */
+void
+lwcelli_stats_cmd_finished(const lwcell_msg_t* msg, lwcellr_t res) {
+    lwcell_stats_t* s = NULL;
+    uint32_t now = lwcell_sys_now();
+    uint8_t first;
+
+    /* Find entry for command or assign new one */
+    for (size_t i = 0; i < lwcell.cmd_stats.used; ++i) {
+        if (lwcell.cmd_stats.entries[i].cmd == (uint32_t)msg->cmd_def) {
+            s = &lwcell.cmd_stats.entries[i];
+            break;
+        }
+    }
+    if (s == NULL) {
+        if (lwcell.cmd_stats.used >= LWCELL_ARRAYSIZE(lwcell.cmd_stats.entries)) {
+            return;
+        }
+        s = &lwcell.cmd_stats.entries[lwcell.cmd_stats.used++];
+        LWCELL_MEMSET(s, 0x00, sizeof(*s));
+        s->cmd = (uint32_t)msg->cmd_def;
+    }
+
+    first = s->count == 0;
+    ++s->count;
+    if (res == lwcellTIMEOUT) {
+        ++s->timeouts;
+    } else if (res != lwcellOK) {
+        ++s->errors;
+    }
+    prv_phase_add(&s->phase[LWCELL_STATS_PHASE_QUEUE], lwcell.cmd_stats.cur.dequeued - msg->stats_time_queued, first);
+    prv_phase_add(&s->phase[LWCELL_STATS_PHASE_TURNAROUND], now - lwcell.cmd_stats.cur.started, first);
+    prv_phase_add(&s->phase[LWCELL_STATS_PHASE_PARSE], lwcell.cmd_stats.cur.parse, first);
+}
+
+/**
+ * \brief           Get totals of all tracked command types
+ * \note            Function must be called with core locked
+ * \param[out]      count: Number of finished commands
+ * \param[out]      errors: Number of commands finished with error or timeout
+ * \param[out]      turnaround: Sum of turnaround times in units of milliseconds
+ */
+void
+lwcelli_stats_get_totals(uint32_t* count, uint32_t* errors, uint32_t* turnaround) {
+    *count = 0;
+    *errors = 0;
+    *turnaround = 0;
+    for (size_t i = 0; i < lwcell.cmd_stats.used; ++i) {
+        *count += lwcell.cmd_stats.entries[i].count;
+        *errors += lwcell.cmd_stats.entries[i].errors + lwcell.cmd_stats.entries[i].timeouts;
+        *turnaround += lwcell.cmd_stats.entries[i].phase[LWCELL_STATS_PHASE_TURNAROUND].sum;
+    }
+}
+
+/**
+ * \brief           Get statistics of command type
+ *
+ * Entries are assigned to command types in order of their first execution.
+ * Iterate `index` from `0` until function returns `0` to read all entries
+ *
+ * \param[in]       index: Entry index
+ * \param[out]      stats: Output statistics
+ * \return          `1` on success, `0` if entry is not used
+ */
+uint8_t
+lwcell_stats_get(size_t index, lwcell_stats_t* stats) {
+    uint8_t res = 0;
+
+    LWCELL_ASSERT0(stats != NULL);
+
+    lwcell_core_lock();
+    if (index < lwcell.cmd_stats.used) {
+        LWCELL_MEMCPY(stats, &lwcell.cmd_stats.entries[index], sizeof(*stats));
+        res = 1;
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Reset all statistics
+ */
+void
+lwcell_stats_reset(void) {
+    lwcell_core_lock();
+    LWCELL_MEMSET(lwcell.cmd_stats.entries, 0x00, sizeof(lwcell.cmd_stats.entries));
+    lwcell.cmd_stats.used = 0;
+    lwcell_core_unlock();
+}
+
+#endif /* LWCELL_CFG_STATS || __DOXYGEN__ */
+
+#if LWCELL_CFG_STATS_COUNTERS || __DOXYGEN__
+
+/**
+ * \brief           Get byte and event throughput counters
+ * \param[out]      counters: Output counters
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_stats_get_counters(lwcell_stats_counters_t* counters) {
+    LWCELL_ASSERT(counters != NULL);
+
+    lwcell_core_lock();
+    LWCELL_MEMCPY(counters, &lwcell.stats, sizeof(*counters));
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+/**
+ * \brief           Reset all throughput counters
+ */
+void
+lwcell_stats_reset_counters(void) {
+    lwcell_core_lock();
+    LWCELL_MEMSET(&lwcell.stats, 0x00, sizeof(lwcell.stats));
+    lwcell_core_unlock();
+}
+
+#endif /* LWCELL_CFG_STATS_COUNTERS || __DOXYGEN__ */
+
+#if LWCELL_CFG_STATS_THREADS || __DOXYGEN__
+
+/**
+ * \brief           Get stack high-water mark and accumulated run time of library thread
+ *
+ * Fields, not supported by system port, are left at `0` with `stack_valid` or `run_time_valid` cleared.
+ * Use ratio of `run_time` and `run_time_total` to get CPU load of the thread
+ *
+ * \param[in]       thread: Thread to query
+ * \param[out]      info: Output information
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_stats_get_thread(lwcell_stats_thread_t thread, lwcell_sys_thread_info_t* info) {
+    lwcell_sys_thread_t* t;
+    size_t stack_size;
+
+    LWCELL_ASSERT(info != NULL);
+
+    if (!lwcell.status.f.initialized) {
+        return lwcellERR;
+    }
+    switch (thread) {
+        case LWCELL_STATS_THREAD_PRODUCE:
+            t = &lwcell.thread_produce;
+            stack_size = LWCELL_CFG_THREAD_PRODUCER_STACK_SIZE;
+            break;
+        case LWCELL_STATS_THREAD_PROCESS:
+            t = &lwcell.thread_process;
+            stack_size = LWCELL_CFG_THREAD_PROCESS_STACK_SIZE;
+            break;
+#if LWCELL_CFG_EVT_DEFERRED
+        case LWCELL_STATS_THREAD_EVT:
+            t = &lwcell.thread_evt;
+            stack_size = LWCELL_CFG_EVT_DEFERRED_THREAD_STACK_SIZE;
+            break;
+#endif /* LWCELL_CFG_EVT_DEFERRED */
+        default: return lwcellERRPAR;
+    }
+
+    LWCELL_MEMSET(info, 0x00, sizeof(*info));
+    info->stack_size = stack_size;
+    return lwcell_sys_thread_get_info(t, info) ? lwcellOK : lwcellERR;
+}
+
+#endif /* LWCELL_CFG_STATS_THREADS || __DOXYGEN__ */
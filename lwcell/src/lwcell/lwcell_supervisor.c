@@ -0,0 +1,437 @@
+/**
+ * \file            lwcell_supervisor.c
+ * \brief           Modem health supervisor
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_supervisor.h"
+#include "lwcell/lwcell_private.h"
+#if LWCELL_CFG_NETWORK
+#include "lwcell/lwcell_network.h"
+#endif /* LWCELL_CFG_NETWORK */
+
+#if LWCELL_CFG_SUPERVISOR || __DOXYGEN__
+
+/**
+ * \brief           Check if device is registered to network
+ * \return          `1` if registered, `0` otherwise
+ */
+static uint8_t
+prv_sv_is_registered(void) {
+    return lwcell.m.network.status == LWCELL_NETWORK_REG_STATUS_CONNECTED
+           || lwcell.m.network.status == LWCELL_NETWORK_REG_STATUS_CONNECTED_ROAMING;
+}
+
+/**
+ * \brief           Check if data link is missing while it should be active
+ * \return          `1` if data link is lost, `0` otherwise
+ */
+static uint8_t
+prv_sv_is_data_lost(void) {
+#if LWCELL_CFG_NETWORK
+    return lwcell.sv.data_watch && lwcell.sv.was_attached && !lwcell.m.network.is_attached;
+#else  /* LWCELL_CFG_NETWORK */
+    return 0;
+#endif /* !LWCELL_CFG_NETWORK */
+}
+
+/**
+ * \brief           Send supervisor event to application
+ * \param[in]       recovered: Set to `1` when device recovered, `0` when tier action starts
+ */
+static void
+prv_sv_send_evt(uint8_t recovered) {
+    lwcell.evt.evt.supervisor.tier = lwcell.sv.tier;
+    lwcell.evt.evt.supervisor.recovered = recovered;
+    lwcelli_send_cb(LWCELL_EVT_SUPERVISOR);
+}
+
+/**
+ * \brief           Tier action finished callback
+ * \param[in]       res: Result of command
+ * \param[in]       arg: Custom user argument
+ */
+static void
+prv_sv_action_fn(lwcellr_t res, void* arg) {
+    LWCELL_UNUSED(res);
+    LWCELL_UNUSED(arg);
+
+    lwcell.sv.action_busy = 0;
+}
+
+/**
+ * \brief           Radio turned off callback, turn it on again
+ * \param[in]       res: Result of command
+ * \param[in]       arg: Custom user argument
+ */
+static void
+prv_sv_cfun_off_fn(lwcellr_t res, void* arg) {
+    LWCELL_UNUSED(res);
+
+    if (lwcell_set_func_mode(1, prv_sv_action_fn, arg, 0) != lwcellOK) {
+        lwcell.sv.action_busy = 0;
+    }
+}
+
+/**
+ * \brief           Probe on RX silence finished callback
+ * \param[in]       res: Result of command
+ * \param[in]       arg: Custom user argument
+ */
+static void
+prv_sv_probe_fn(lwcellr_t res, void* arg) {
+    LWCELL_UNUSED(res);
+    LWCELL_UNUSED(arg);
+
+    lwcell.sv.probe_busy = 0;
+}
+
+/**
+ * \brief           Queue `AT` probe as priority command
+ * \param[in]       evt_fn: Callback function called when probe finished
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+prv_sv_probe(lwcell_api_cmd_evt_fn evt_fn) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, 0, LWCELL_MSG_SIZE(reset));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, NULL);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_PROBE;
+    LWCELL_MSG_VAR_REF(msg).is_prio = 1; /* Serve it before commands waiting behind stalled one */
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd,
+                                             LWCELL_CFG_SUPERVISOR_PROBE_TIMEOUT);
+}
+
+/**
+ * \brief           Get next recovery tier for active fault
+ * \return          Next tier to start
+ */
+static lwcell_supervisor_tier_t
+prv_sv_next_tier(void) {
+    if (lwcell.sv.fault == LWCELL_SV_FAULT_LINK) {
+        return lwcell.sv.tier == LWCELL_SUPERVISOR_TIER_NONE ? LWCELL_SUPERVISOR_TIER_PROBE
+                                                             : LWCELL_SUPERVISOR_TIER_RESET;
+    }
+#if LWCELL_CFG_NETWORK
+    /* Registered device only lost its data link, attach again before radio is touched */
+    if (prv_sv_is_registered() && !lwcell.sv.reattached && lwcell.sv.apn != NULL) {
+        return LWCELL_SUPERVISOR_TIER_REATTACH;
+    }
+#endif /* LWCELL_CFG_NETWORK */
+    return lwcell.sv.heavy == LWCELL_SUPERVISOR_TIER_NONE ? LWCELL_SUPERVISOR_TIER_CFUN : LWCELL_SUPERVISOR_TIER_RESET;
+}
+
+/**
+ * \brief           Start next recovery tier action
+ * \param[in]       now: Current time in units of milliseconds
+ */
+static void
+prv_sv_escalate(uint32_t now) {
+    lwcellr_t res = lwcellERR;
+
+    lwcell.sv.tier = prv_sv_next_tier();
+    lwcell.sv.action_time = now;
+    lwcell.sv.action_busy = 1;
+    ++lwcell.sv.stats.actions[lwcell.sv.tier];
+    LWCELL_DEBUGF(LWCELL_CFG_DBG_THREAD | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING,
+                  "[LWCELL SUPERVISOR] Starting recovery tier %d\r\n", (int)lwcell.sv.tier);
+    prv_sv_send_evt(0);
+
+    switch (lwcell.sv.tier) {
+        case LWCELL_SUPERVISOR_TIER_PROBE: {
+            res = prv_sv_probe(prv_sv_action_fn);
+            break;
+        }
+#if LWCELL_CFG_NETWORK
+        case LWCELL_SUPERVISOR_TIER_REATTACH: {
+            lwcell.sv.reattached = 1;
+            res = lwcell_network_attach(lwcell.sv.apn, lwcell.sv.user, lwcell.sv.pass, prv_sv_action_fn, NULL, 0);
+            break;
+        }
+#endif /* LWCELL_CFG_NETWORK */
+        case LWCELL_SUPERVISOR_TIER_CFUN: {
+            lwcell.sv.heavy = lwcell.sv.tier;
+            res = lwcell_set_func_mode(0, prv_sv_cfun_off_fn, NULL, 0);
+            break;
+        }
+        case LWCELL_SUPERVISOR_TIER_RESET: {
+            lwcell.sv.heavy = lwcell.sv.tier;
+            if (lwcell.sv.resets < 4) {
+                ++lwcell.sv.resets;
+            }
+            res = lwcell_reset(prv_sv_action_fn, NULL, 0);
+            break;
+        }
+        default: break;
+    }
+#if LWCELL_CFG_NETWORK
+    if (lwcell.sv.tier == LWCELL_SUPERVISOR_TIER_CFUN || lwcell.sv.tier == LWCELL_SUPERVISOR_TIER_RESET) {
+        lwcell.sv.reattached = 0; /* Data link is attached again once device registers */
+    }
+#endif /* LWCELL_CFG_NETWORK */
+    if (res != lwcellOK) {
+        lwcell.sv.action_busy = 0; /* Action is retried with next tier on next check */
+    }
+}
+
+/**
+ * \brief           Check if active fault has been recovered
+ * \return          `1` if healthy, `0` otherwise
+ */
+static uint8_t
+prv_sv_is_healthy(void) {
+    if (lwcell.sv.fault == LWCELL_SV_FAULT_LINK) {
+        return lwcell.sv.timeouts == 0;
+    }
+    return prv_sv_is_registered() && !prv_sv_is_data_lost();
+}
+
+/**
+ * \brief           Check if next tier shall start for unrecovered fault
+ * \param[in]       now: Current time in units of milliseconds
+ * \return          `1` if next tier shall start, `0` to wait
+ */
+static uint8_t
+prv_sv_is_escalation_due(uint32_t now) {
+    if (lwcell.sv.tier == LWCELL_SUPERVISOR_TIER_PROBE || lwcell.sv.tier == LWCELL_SUPERVISOR_TIER_REATTACH) {
+        return 1;
+    }
+    /* Registered again after radio cycle or reset, only data link is missing */
+    if (lwcell.sv.fault == LWCELL_SV_FAULT_REG && prv_sv_is_registered()) {
+        return 1;
+    }
+    return now - lwcell.sv.action_time
+           >= ((uint32_t)LWCELL_CFG_SUPERVISOR_REG_LOSS << (lwcell.sv.resets > 0 ? lwcell.sv.resets - 1 : 0));
+}
+
+/**
+ * \brief           Finish recovery of active fault and update statistics
+ * \param[in]       now: Current time in units of milliseconds
+ */
+static void
+prv_sv_recovered(uint32_t now) {
+    uint32_t ttr = now - lwcell.sv.fault_time;
+
+    lwcell.sv.stats.ttr_last = ttr;
+    lwcell.sv.stats.ttr_max = LWCELL_MAX(lwcell.sv.stats.ttr_max, ttr);
+    lwcell.sv.ttr_total += ttr;
+    ++lwcell.sv.stats.recoveries;
+    LWCELL_DEBUGF(LWCELL_CFG_DBG_THREAD | LWCELL_DBG_TYPE_TRACE,
+                  "[LWCELL SUPERVISOR] Recovered with tier %d in %u ms\r\n", (int)lwcell.sv.tier, (unsigned)ttr);
+    prv_sv_send_evt(1);
+
+    lwcell.sv.tier = LWCELL_SUPERVISOR_TIER_NONE;
+    lwcell.sv.heavy = LWCELL_SUPERVISOR_TIER_NONE;
+    lwcell.sv.fault = LWCELL_SV_FAULT_NONE;
+    lwcell.sv.resets = 0;
+#if LWCELL_CFG_NETWORK
+    lwcell.sv.reattached = 0;
+#endif /* LWCELL_CFG_NETWORK */
+}
+
+/**
+ * \brief           Periodic health check
+ * \param[in]       now: Current time in units of milliseconds
+ */
+static void
+prv_sv_check(uint32_t now) {
+    uint32_t rx_len = lwcelli_input_get_total_len();
+
+    if (rx_len != lwcell.sv.rx_len) {
+        lwcell.sv.rx_len = rx_len;
+        lwcell.sv.rx_time = now;
+    }
+    if (prv_sv_is_registered()) {
+        lwcell.sv.was_registered = 1;
+        lwcell.sv.reg_lost = 0;
+    } else if (lwcell.sv.was_registered && !lwcell.sv.reg_lost) {
+        lwcell.sv.reg_lost = 1;
+        lwcell.sv.reg_lost_time = now;
+    }
+    if (lwcell.sv.action_busy) {
+        return; /* Result of action is checked once its command finished */
+    }
+
+    if (lwcell.sv.fault == LWCELL_SV_FAULT_NONE) {
+        if (lwcell.sv.timeouts >= LWCELL_CFG_SUPERVISOR_TIMEOUTS) {
+            lwcell.sv.fault = LWCELL_SV_FAULT_LINK;
+        } else if ((lwcell.sv.reg_lost && now - lwcell.sv.reg_lost_time >= LWCELL_CFG_SUPERVISOR_REG_LOSS)
+                   || (prv_sv_is_registered() && prv_sv_is_data_lost())) {
+            lwcell.sv.fault = LWCELL_SV_FAULT_REG;
+        } else {
+#if LWCELL_CFG_SUPERVISOR_RX_SILENCE > 0
+            /* Silent device is probed, timeout of probe counts as any other command timeout */
+            if (!lwcell.sv.probe_busy && lwcell.msg == NULL
+                && now - lwcell.sv.rx_time >= LWCELL_CFG_SUPERVISOR_RX_SILENCE
+                && prv_sv_probe(prv_sv_probe_fn) == lwcellOK) {
+                lwcell.sv.probe_busy = 1;
+                lwcell.sv.rx_time = now;
+            }
+#endif /* LWCELL_CFG_SUPERVISOR_RX_SILENCE > 0 */
+            return;
+        }
+        ++lwcell.sv.stats.faults;
+        lwcell.sv.fault_time = now;
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_THREAD | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING,
+                      "[LWCELL SUPERVISOR] Fault %d detected\r\n", (int)lwcell.sv.fault);
+        prv_sv_escalate(now);
+        return;
+    }
+
+    /* Device stopped responding during registration recovery */
+    if (lwcell.sv.fault == LWCELL_SV_FAULT_REG && lwcell.sv.timeouts >= LWCELL_CFG_SUPERVISOR_TIMEOUTS) {
+        lwcell.sv.fault = LWCELL_SV_FAULT_LINK;
+    }
+    if (prv_sv_is_healthy()) {
+        prv_sv_recovered(now);
+    } else if (prv_sv_is_escalation_due(now)) {
+        prv_sv_escalate(now);
+    }
+}
+
+/**
+ * \brief           Health check timeout callback
+ * \param[in]       arg: Custom user argument
+ */
+static void
+prv_sv_timeout_fn(void* arg) {
+    lwcell_core_lock();
+    prv_sv_check(lwcell_sys_now());
+    lwcell_core_unlock();
+
+    lwcell_timeout_start(&lwcell.sv.timeout, LWCELL_CFG_SUPERVISOR_INTERVAL, prv_sv_timeout_fn, arg);
+}
+
+/**
+ * \brief           Start periodic health checks
+ * \note            Function must be called with core locked
+ */
+void
+lwcelli_supervisor_start(void) {
+    lwcell.sv.rx_len = lwcelli_input_get_total_len();
+    lwcell.sv.rx_time = lwcell_sys_now();
+    lwcell_timeout_start(&lwcell.sv.timeout, LWCELL_CFG_SUPERVISOR_INTERVAL, prv_sv_timeout_fn, NULL);
+}
+
+/**
+ * \brief           Track command results for fault detection
+ * \note            Function must be called from producer thread with core locked,
+ *                  for every finished command
+ * \param[in]       msg: Finished message with its result
+ */
+void
+lwcelli_supervisor_cmd_finished(const lwcell_msg_t* msg) {
+    if (msg->res == lwcellTIMEOUT) {
+        if (lwcell.sv.timeouts < 0xFF) {
+            ++lwcell.sv.timeouts;
+        }
+    } else if (msg->res != lwcellERRSTALE) {
+        lwcell.sv.timeouts = 0; /* Device responds, dropped send request did not reach it */
+    }
+    if (msg->cmd_def == LWCELL_CMD_RESET || msg->cmd_def == LWCELL_CMD_CFUN_SET) {
+        lwcell.sv.reg_lost = 0; /* Give device full time to register again */
+    }
+#if LWCELL_CFG_NETWORK
+    if (msg->res == lwcellOK) {
+        if (msg->cmd_def == LWCELL_CMD_NETWORK_ATTACH
+#if LWCELL_CFG_NETWORK_CONTEXTS > 1
+            && msg->msg.network_attach.ctx == 0
+#endif /* LWCELL_CFG_NETWORK_CONTEXTS > 1 */
+        ) {
+            lwcell.sv.was_attached = 1;
+        } else if (msg->cmd_def == LWCELL_CMD_NETWORK_DETACH) {
+            lwcell.sv.was_attached = 0; /* Application does not want data link anymore */
+        }
+    }
+#endif /* LWCELL_CFG_NETWORK */
+}
+
+#if LWCELL_CFG_NETWORK || __DOXYGEN__
+
+/**
+ * \brief           Set credentials for network reattach and enable data link supervision
+ *
+ * Once application attached to network with \ref lwcell_network_attach,
+ * supervisor attaches again with these credentials when data link is lost.
+ * Data link is not supervised after \ref lwcell_network_detach.
+ *
+ * \note            Strings are not copied and must stay valid while supervisor uses them
+ * \param[in]       apn: APN domain. Set to `NULL` to disable data link supervision
+ * \param[in]       user: APN username. Set to `NULL` if not used
+ * \param[in]       pass: APN password. Set to `NULL` if not used
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_supervisor_set_credentials(const char* apn, const char* user, const char* pass) {
+    lwcell_core_lock();
+    lwcell.sv.apn = apn;
+    lwcell.sv.user = user;
+    lwcell.sv.pass = pass;
+    lwcell.sv.data_watch = apn != NULL;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_NETWORK || __DOXYGEN__ */
+
+/**
+ * \brief           Get active recovery tier
+ * \return          Member of \ref lwcell_supervisor_tier_t enumeration,
+ *                  \ref LWCELL_SUPERVISOR_TIER_NONE when no recovery is in progress
+ */
+lwcell_supervisor_tier_t
+lwcell_supervisor_get_tier(void) {
+    lwcell_supervisor_tier_t tier;
+
+    lwcell_core_lock();
+    tier = lwcell.sv.tier;
+    lwcell_core_unlock();
+    return tier;
+}
+
+/**
+ * \brief           Get supervisor fault and recovery statistics
+ * \param[out]      stats: Pointer to output statistics structure
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_supervisor_get_stats(lwcell_supervisor_stats_t* stats) {
+    LWCELL_ASSERT(stats != NULL);
+
+    lwcell_core_lock();
+    *stats = lwcell.sv.stats;
+    stats->ttr_mean = lwcell.sv.stats.recoveries > 0 ? lwcell.sv.ttr_total / lwcell.sv.stats.recoveries : 0;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_SUPERVISOR || __DOXYGEN__ */
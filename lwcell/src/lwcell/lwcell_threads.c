@@ -38,6 +38,361 @@
 #include "lwcell/lwcell_timeout.h"
 #include "system/lwcell_sys.h"
 
+#if LWCELL_CFG_CMD_TIMEOUT_ADAPT || __DOXYGEN__
+
+/**
+ * \brief           Get profile for command type
+ * \param[in]       cmd: Command type
+ * \param[in]       create: Set to `1` to assign new profile if command type has none
+ * \return          Profile on success, `NULL` otherwise
+ */
+static lwcell_cmd_profile_t*
+prv_cmd_profile_get(lwcell_cmd_t cmd, uint8_t create) {
+    lwcell_cmd_adapt_t* a = &lwcell.cmd_adapt;
+
+    for (size_t i = 0; i < a->profiles_used; ++i) {
+        if (a->profiles[i].cmd == cmd) {
+            return &a->profiles[i];
+        }
+    }
+    if (!create || a->profiles_used >= LWCELL_ARRAYSIZE(a->profiles)) {
+        return NULL;
+    }
+    LWCELL_MEMSET(&a->profiles[a->profiles_used], 0x00, sizeof(a->profiles[0]));
+    a->profiles[a->profiles_used].cmd = cmd;
+    return &a->profiles[a->profiles_used++];
+}
+
+/**
+ * \brief           Get stall detection window for message
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Message to execute
+ * \return          Window in units of milliseconds, `0` to wait full blocking time
+ */
+static uint32_t
+prv_cmd_window(const lwcell_msg_t* msg) {
+    lwcell_cmd_profile_t* p;
+    uint32_t window;
+
+    if ((p = prv_cmd_profile_get(msg->cmd_def, 0)) == NULL || p->samples < LWCELL_CFG_CMD_TIMEOUT_ADAPT_SAMPLES) {
+        return 0;
+    }
+
+    /* Smoothed time with 4 deviations covers most of the samples, as in TCP retransmission timeout */
+    window = (uint32_t)(p->srtt + 4 * p->rttvar) * LWCELL_CFG_CMD_TIMEOUT_ADAPT_MUL;
+    window = LWCELL_MAX(window, (uint32_t)LWCELL_CFG_CMD_TIMEOUT_ADAPT_MIN);
+    if (msg->block_time > 0 && window >= msg->block_time) {
+        return 0;
+    }
+    return window;
+}
+
+/**
+ * \brief           Wait for command to finish, abort early when device stalls
+ * \param[in]       msg: Message being executed
+ * \param[in]       window: Stall detection window in units of milliseconds, `0` to wait full blocking time
+ * \return          \ref LWCELL_SYS_TIMEOUT on timeout, any other value otherwise
+ */
+static uint32_t
+prv_cmd_wait(const lwcell_msg_t* msg, uint32_t window) {
+    uint32_t start, elapsed, rx;
+
+    if (window == 0) {
+        return lwcell_sys_sem_wait(&lwcell.sem_sync, msg->block_time);
+    }
+    start = lwcell_sys_now();
+    rx = lwcelli_input_get_total_len();
+    while (1) {
+        elapsed = lwcell_sys_now() - start;
+        if (msg->block_time > 0) {
+            if (elapsed >= msg->block_time) {
+                return LWCELL_SYS_TIMEOUT;
+            }
+            window = LWCELL_MIN(window, msg->block_time - elapsed);
+        }
+        if (lwcell_sys_sem_wait(&lwcell.sem_sync, window) != LWCELL_SYS_TIMEOUT) {
+            return lwcell_sys_now() - start;
+        }
+
+        /* Device sent nothing during whole window, while it was expected to reply */
+        if (rx == lwcelli_input_get_total_len() && !msg->is_parked
+            && (msg->block_time == 0 || lwcell_sys_now() - start < msg->block_time)) {
+            LWCELL_DEBUGF(LWCELL_CFG_DBG_THREAD | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING,
+                          "[LWCELL THREAD] No data from device for %d ms, aborting command %d\r\n", (int)window,
+                          (int)msg->cmd);
+            return LWCELL_SYS_TIMEOUT;
+        }
+        rx = lwcelli_input_get_total_len();
+    }
+}
+
+#if LWCELL_CFG_CMD_STALL_PROBES > 0
+
+/**
+ * \brief           Queue internal priority command
+ * \note            Function must be called with core locked
+ * \param[in]       cmd: Command to queue, \ref LWCELL_CMD_PROBE or \ref LWCELL_CMD_RESET
+ * \param[in]       block_time: Maximal time command can block in units of milliseconds
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+prv_cmd_queue(lwcell_cmd_t cmd, uint32_t block_time) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, 0, LWCELL_MSG_SIZE(reset));
+    LWCELL_MSG_VAR_REF(msg).cmd_def = cmd;
+    LWCELL_MSG_VAR_REF(msg).is_prio = 1; /* Serve it before commands waiting behind stalled one */
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, block_time);
+}
+
+#endif /* LWCELL_CFG_CMD_STALL_PROBES > 0 */
+
+/**
+ * \brief           Update command profile and device stall state after command finished
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Finished message
+ * \param[in]       res: Command result
+ * \param[in]       time: Command turnaround time in units of milliseconds
+ */
+static void
+prv_cmd_finished(const lwcell_msg_t* msg, lwcellr_t res, uint32_t time) {
+    lwcell_cmd_profile_t* p;
+
+    if (res != lwcellTIMEOUT) {
+        /* Device responds, only successful commands describe their normal turnaround */
+        if (res == lwcellOK && msg->cmd_def != LWCELL_CMD_PROBE
+            && (p = prv_cmd_profile_get(msg->cmd_def, 1)) != NULL) {
+            int32_t err = (int32_t)time - p->srtt;
+            if (p->samples == 0) {
+                p->srtt = (int32_t)time;
+                p->rttvar = (int32_t)time / 2;
+            } else {
+                p->srtt += err / 8;
+                p->rttvar += ((err < 0 ? -err : err) - p->rttvar) / 4;
+            }
+            if (p->samples < UINT32_MAX) {
+                ++p->samples;
+            }
+        }
+        lwcell.cmd_adapt.probes = 0;
+        return;
+    }
+#if LWCELL_CFG_CMD_STALL_PROBES > 0
+    if (msg->cmd_def == LWCELL_CMD_RESET) {
+        lwcell.cmd_adapt.probes = 0; /* Reset is not probed, application decides what to do next */
+    } else if (lwcell.cmd_adapt.probes < LWCELL_CFG_CMD_STALL_PROBES) {
+        if (prv_cmd_queue(LWCELL_CMD_PROBE, LWCELL_CFG_CMD_STALL_PROBE_TIMEOUT) == lwcellOK) {
+            ++lwcell.cmd_adapt.probes;
+        }
+    } else {
+        LWCELL_DEBUGF(LWCELL_CFG_DBG_THREAD | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_SEVERE,
+                      "[LWCELL THREAD] Device does not respond to probes, resetting\r\n");
+        if (prv_cmd_queue(LWCELL_CMD_RESET, 60000) == lwcellOK) {
+            lwcell.cmd_adapt.probes = 0;
+        }
+    }
+#endif /* LWCELL_CFG_CMD_STALL_PROBES > 0 */
+}
+
+#endif /* LWCELL_CFG_CMD_TIMEOUT_ADAPT || __DOXYGEN__ */
+
+/**
+ * \brief           Start execution of message taken from producer queue
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Message to start
+ * \param[out]      started: Set to `1` when synchronization semaphore was taken and message function called
+ * \return          \ref lwcellOK when command was sent to device or completed without it,
+ *                      member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+prv_cmd_start(lwcell_msg_t* msg, uint8_t* started) {
+    lwcell_t* e = &lwcell;
+    lwcellr_t res = lwcellOK;
+
+    *started = 0;
+    LWCELL_TRACE_HOOK(LWCELL_TRACE_MSG, LWCELL_TRACE_BEGIN, msg->cmd_def);
+#if LWCELL_CFG_STATS
+    lwcelli_stats_cmd_dequeued();
+#endif /* LWCELL_CFG_STATS */
+#if LWCELL_CFG_CONN_SEND_FAIR
+    lwcelli_conn_send_queued(msg, 0);
+#endif /* LWCELL_CFG_CONN_SEND_FAIR */
+#if LWCELL_CFG_PRODUCER_ADMISSION
+    lwcelli_producer_release(msg);
+#endif /* LWCELL_CFG_PRODUCER_ADMISSION */
+
+#if LWCELL_CFG_PWR
+    if (e->status.f.dev_present) {
+        lwcelli_pwr_wake(); /* Modem must listen before command is sent */
+    }
+#endif            /* LWCELL_CFG_PWR */
+    e->msg = msg; /* Set message handle */
+
+    /*
+     * This check is performed when adding command to queue
+     * Do it again here to prevent long timeouts,
+     * if device present flag changes
+     */
+    if (!e->status.f.dev_present) {
+        res = lwcellERRNODEVICE;
+    }
+#if LWCELL_CFG_CONN_SEND_DEADLINE
+    if (res == lwcellOK && lwcelli_conn_send_is_stale(msg)) {
+        res = lwcellERRSTALE; /* Data are not needed anymore, drop them without sending */
+    }
+#endif /* LWCELL_CFG_CONN_SEND_DEADLINE */
+#if LWCELL_CFG_DNS
+    if (res == lwcellOK && msg->cmd_def == LWCELL_CMD_CDNSGIP && lwcelli_dns_resolve_cached(msg)) {
+        return lwcellOK; /* Host was resolved by lookup queued earlier, nothing to send */
+    }
+#endif /* LWCELL_CFG_DNS */
+
+    /* For reset message, requested delay is waited with command parked */
+    if (res == lwcellOK && msg->cmd_def == LWCELL_CMD_RESET) {
+        lwcelli_reset_everything(1); /* Reset stack before trying to reset */
+    }
+
+    /*
+     * Try to call function to process this message
+     * Usually it should be function to transmit data to AT port
+     */
+    if (res == lwcellOK && msg->fn != NULL) { /* Check for callback processing function */
+        /*
+         * Obtain semaphore
+         * This code should not block at any point.
+         * If it blocks, severe problems occurred and program should
+         * immediate terminate
+         */
+        lwcell_core_unlock();
+        lwcell_sys_sem_wait(&e->sem_sync, 0); /* First call */
+        lwcell_core_lock();
+#if LWCELL_CFG_STATS
+        lwcelli_stats_cmd_started();
+#endif /* LWCELL_CFG_STATS */
+#if LWCELL_CFG_CMD_TIMEOUT_ADAPT
+        lwcell.cmd_adapt.start = lwcell_sys_now();
+        lwcell.cmd_adapt.window = prv_cmd_window(msg);
+#endif /* LWCELL_CFG_CMD_TIMEOUT_ADAPT */
+        *started = 1;
+        LWCELL_TRACE_HOOK(LWCELL_TRACE_MSG_FN, LWCELL_TRACE_BEGIN, msg->cmd_def);
+        res = msg->fn(msg); /* Process this message, check if command started at least */
+        LWCELL_TRACE_HOOK(LWCELL_TRACE_MSG_FN, LWCELL_TRACE_END, 0);
+    } else if (res == lwcellOK) {
+        res = lwcellERR; /* Simply set error message */
+    }
+    return res;
+}
+
+/**
+ * \brief           Finish execution of message and notify application
+ * \note            Function must be called with core locked
+ * \param[in]       msg: Message to finish
+ * \param[in]       res: Result of command execution
+ * \param[in]       started: Value of `started` parameter, returned by \ref prv_cmd_start
+ * \return          Message to execute next, without accessing producer queue, `NULL` otherwise
+ */
+static lwcell_msg_t*
+prv_cmd_finish(lwcell_msg_t* msg, lwcellr_t res, uint8_t started) {
+    lwcell_t* e = &lwcell;
+    lwcell_msg_t* next = NULL;
+
+    if (started) {
+        /* Notify application on command timeout */
+        if (res == lwcellTIMEOUT) {
+            lwcelli_send_cb(LWCELL_EVT_CMD_TIMEOUT);
+        }
+
+        LWCELL_DEBUGW(LWCELL_CFG_DBG_THREAD | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_SEVERE, res == lwcellTIMEOUT,
+                      "[LWCELL THREAD] Timeout in produce thread waiting for command to finish in process thread\r\n");
+        LWCELL_DEBUGW(LWCELL_CFG_DBG_THREAD | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_SEVERE,
+                      res != lwcellOK && res != lwcellTIMEOUT,
+                      "[LWCELL THREAD] Could not start execution for command %d\r\n", (int)msg->cmd);
+
+        /*
+         * Manually release semaphore in all cases:
+         *
+         * Case 1: msg->fn function fails, command did not start,
+         *           application needs to release previously acquired semaphore
+         * Case 2: If time == TIMEOUT, acquiring on second call was not successful,
+         *           application has to manually release semaphore, taken on first call
+         * Case 3: If time != TIMEOUT, acquiring on second call was successful,
+         *           which effectively means that another thread successfully released semaphore,
+         *           application has to release semaphore, now taken on second call
+         *
+         * If application would not manually release semaphore,
+         * and if command would return with timeout (or fail),
+         * it would not be possible to start a new command after,
+         * because semaphore would be still locked
+         */
+        lwcell_sys_sem_release(&e->sem_sync);
+    }
+#if LWCELL_CFG_CONN_SEND_FAIR
+    /* Send request gave up its turn, rest of data is sent after requests for other connections */
+    if (msg->is_yielded) {
+        msg->is_yielded = 0;
+        if (res == lwcellOK && msg->res == lwcellOK) {
+            e->msg = NULL;
+            if (!lwcelli_conn_send_requeue(msg)) {
+                next = msg; /* Yielded send could not be put back to full queue, it continues immediately */
+            }
+            LWCELL_TRACE_HOOK(LWCELL_TRACE_MSG, LWCELL_TRACE_END, 0);
+            return next;
+        }
+    }
+#endif /* LWCELL_CFG_CONN_SEND_FAIR */
+#if LWCELL_CFG_CONN_SEND_DEADLINE
+    lwcelli_conn_send_track(msg, 0);
+#endif /* LWCELL_CFG_CONN_SEND_DEADLINE */
+#if LWCELL_CFG_CONN_TX_WINDOW > 0
+    lwcelli_conn_tx_window_done(msg);
+#endif /* LWCELL_CFG_CONN_TX_WINDOW > 0 */
+    if (res != lwcellOK) {
+        /* Process global callbacks */
+        lwcelli_process_events_for_timeout_or_error(msg, res);
+
+        msg->res = res; /* Save response */
+    }
+#if LWCELL_CFG_STATS
+    lwcelli_stats_cmd_finished(msg, msg->res);
+#endif /* LWCELL_CFG_STATS */
+#if LWCELL_CFG_SUPERVISOR
+    lwcelli_supervisor_cmd_finished(msg);
+#endif /* LWCELL_CFG_SUPERVISOR */
+
+#if LWCELL_CFG_USE_API_FUNC_EVT
+    /* Send event function to user */
+    if (msg->evt_fn != NULL) {
+        msg->evt_fn(msg->res, msg->evt_arg); /* Send event with user argument */
+    }
+#endif                                       /* LWCELL_CFG_USE_API_FUNC_EVT */
+#if LWCELL_CFG_CQ
+    if (msg->cq != NULL) {
+        next = msg->cq_next; /* Rest of submitted batch is executed back to back */
+        lwcelli_cq_complete(msg);
+    }
+#endif /* LWCELL_CFG_CQ */
+
+    /*
+     * In case message is blocking,
+     * release semaphore and notify finished with processing
+     * otherwise directly free memory of message structure
+     */
+    if (msg->is_blocking) {
+        lwcell_sys_sem_release(&msg->sem);
+    } else {
+        LWCELL_MSG_VAR_FREE(msg);
+    }
+    e->msg = NULL;
+#if LWCELL_CFG_PWR
+    lwcelli_pwr_cmd_done(); /* Keep modem awake for commands queued meanwhile */
+#endif                      /* LWCELL_CFG_PWR */
+    LWCELL_TRACE_HOOK(LWCELL_TRACE_MSG, LWCELL_TRACE_END, 0);
+    return next;
+}
+
+#if LWCELL_CFG_OS || __DOXYGEN__
+
 /**
  * \brief           User thread to process input packets from API functions
  * \param[in]       arg: User argument. Semaphore to release when thread starts
@@ -46,9 +401,10 @@ void
 lwcell_thread_produce(void* const arg) {
     lwcell_sys_sem_t* sem = arg;
     lwcell_t* e = &lwcell;
-    lwcell_msg_t* msg;
+    lwcell_msg_t *msg, *next = NULL;
     lwcellr_t res;
     uint32_t time;
+    uint8_t started;
 
     /* Thread is running, unlock semaphore */
     if (lwcell_sys_sem_isvalid(sem)) {
@@ -59,117 +415,56 @@ lwcell_thread_produce(void* const arg) {
     while (1) {
         lwcell_core_unlock();
         do {
+            /* Yielded send or rest of submitted batch continues immediately, without queue access */
+            if ((msg = next) != NULL) {
+                next = NULL;
+                time = 0;
+                continue;
+            }
+#if LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0
+            /* Priority lane is always served first, regular queue carries wakeup entries */
+            if (lwcell_sys_mbox_getnow(&e->mbox_producer_prio, (void**)&msg)) {
+                time = 0;
+                continue;
+            }
+#endif /* LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0 */
             time = lwcell_sys_mbox_get(&e->mbox_producer, (void**)&msg, 0); /* Get message from queue */
+#if LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0
+            if (time != LWCELL_SYS_TIMEOUT && msg == NULL) {
+                lwcell_core_lock();
+                e->producer_prio_wakeup = 0; /* Next priority message posts new wake-up entry */
+                lwcell_core_unlock();
+            }
+#endif /* LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0 */
         } while (time == LWCELL_SYS_TIMEOUT || msg == NULL);
         LWCELL_THREAD_PRODUCER_HOOK();                                      /* Execute producer thread hook */
         lwcell_core_lock();
-
-        res = lwcellOK; /* Start with OK */
-        e->msg = msg;   /* Set message handle */
-
-        /*
-         * This check is performed when adding command to queue
-         * Do it again here to prevent long timeouts,
-         * if device present flag changes
-         */
-        if (!e->status.f.dev_present) {
-            res = lwcellERRNODEVICE;
+#if LWCELL_CFG_NETWORK_PDP_RECOVERY
+        if (lwcelli_network_pdp_hold(msg)) {
+            continue; /* Send waits until its connection is restored */
         }
+#endif /* LWCELL_CFG_NETWORK_PDP_RECOVERY */
 
-        /* For reset message, we can have delay! */
-        if (res == lwcellOK && msg->cmd_def == LWCELL_CMD_RESET) {
-            if (msg->msg.reset.delay > 0) {
-                lwcell_delay(msg->msg.reset.delay);
-            }
-            lwcelli_reset_everything(1); /* Reset stack before trying to reset */
-        }
-
-        /*
-         * Try to call function to process this message
-         * Usually it should be function to transmit data to AT port
-         */
-        if (res == lwcellOK && msg->fn != NULL) { /* Check for callback processing function */
-            /*
-             * Obtain semaphore
-             * This code should not block at any point.
-             * If it blocks, severe problems occurred and program should
-             * immediate terminate
-             */
+        res = prv_cmd_start(msg, &started);
+        if (started && res == lwcellOK) { /* We have valid data and data were sent */
             lwcell_core_unlock();
-            lwcell_sys_sem_wait(&e->sem_sync, 0); /* First call */
+#if LWCELL_CFG_CMD_TIMEOUT_ADAPT
+            time = prv_cmd_wait(msg, lwcell.cmd_adapt.window);
+#else  /* LWCELL_CFG_CMD_TIMEOUT_ADAPT */
+            time = lwcell_sys_sem_wait(
+                &e->sem_sync,
+                msg->block_time); /* Second call; Wait for synchronization semaphore from processing thread or timeout */
+#endif /* !LWCELL_CFG_CMD_TIMEOUT_ADAPT */
             lwcell_core_lock();
-            res = msg->fn(msg);                   /* Process this message, check if command started at least */
-            time = ~LWCELL_SYS_TIMEOUT;           /* Reset time */
-            if (res == lwcellOK) {                /* We have valid data and data were sent */
-                lwcell_core_unlock();
-                time = lwcell_sys_sem_wait(
-                    &e->sem_sync,
-                    msg->block_time); /* Second call; Wait for synchronization semaphore from processing thread or timeout */
-                lwcell_core_lock();
-                if (time == LWCELL_SYS_TIMEOUT) { /* Sync timeout occurred? */
-                    res = lwcellTIMEOUT;          /* Timeout on command */
-                }
+            lwcelli_cmd_park_cancel(msg);     /* Command may time out while parked */
+            if (time == LWCELL_SYS_TIMEOUT) { /* Sync timeout occurred? */
+                res = lwcellTIMEOUT;          /* Timeout on command */
             }
-
-            /* Notify application on command timeout */
-            if (res == lwcellTIMEOUT) {
-                lwcelli_send_cb(LWCELL_EVT_CMD_TIMEOUT);
-            }
-
-            LWCELL_DEBUGW(
-                LWCELL_CFG_DBG_THREAD | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_SEVERE, res == lwcellTIMEOUT,
-                "[LWCELL THREAD] Timeout in produce thread waiting for command to finish in process thread\r\n");
-            LWCELL_DEBUGW(LWCELL_CFG_DBG_THREAD | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_SEVERE,
-                          res != lwcellOK && res != lwcellTIMEOUT,
-                          "[LWCELL THREAD] Could not start execution for command %d\r\n", (int)msg->cmd);
-
-            /*
-             * Manually release semaphore in all cases:
-             *
-             * Case 1: msg->fn function fails, command did not start,
-             *           application needs to release previously acquired semaphore
-             * Case 2: If time == TIMEOUT, acquiring on second call was not successful,
-             *           application has to manually release semaphore, taken on first call
-             * Case 3: If time != TIMEOUT, acquiring on second call was successful,
-             *           which effectively means that another thread successfully released semaphore,
-             *           application has to release semaphore, now taken on second call
-             *
-             * If application would not manually release semaphore,
-             * and if command would return with timeout (or fail),
-             * it would not be possible to start a new command after,
-             * because semaphore would be still locked
-             */
-            lwcell_sys_sem_release(&e->sem_sync);
-        } else {
-            if (res == lwcellOK) {
-                res = lwcellERR; /* Simply set error message */
-            }
-        }
-        if (res != lwcellOK) {
-            /* Process global callbacks */
-            lwcelli_process_events_for_timeout_or_error(msg, res);
-
-            msg->res = res; /* Save response */
-        }
-
-#if LWCELL_CFG_USE_API_FUNC_EVT
-        /* Send event function to user */
-        if (msg->evt_fn != NULL) {
-            msg->evt_fn(msg->res, msg->evt_arg); /* Send event with user argument */
-        }
-#endif                                           /* LWCELL_CFG_USE_API_FUNC_EVT */
-
-        /*
-         * In case message is blocking,
-         * release semaphore and notify finished with processing
-         * otherwise directly free memory of message structure
-         */
-        if (msg->is_blocking) {
-            lwcell_sys_sem_release(&msg->sem);
-        } else {
-            LWCELL_MSG_VAR_FREE(msg);
+#if LWCELL_CFG_CMD_TIMEOUT_ADAPT
+            prv_cmd_finished(msg, res == lwcellOK ? msg->res : res, lwcell_sys_now() - lwcell.cmd_adapt.start);
+#endif /* LWCELL_CFG_CMD_TIMEOUT_ADAPT */
         }
-        e->msg = NULL;
+        next = prv_cmd_finish(msg, res, started);
     }
 }
 
@@ -198,14 +493,22 @@ lwcell_thread_process(void* const arg) {
     lwcell_core_lock();
     while (1) {
         lwcell_core_unlock();
+#if LWCELL_CFG_THREAD_PROCESS_NOTIFY
+        time = lwcelli_wait_notify_with_timeout_checks(&e->notify_process, 10);
+        msg = NULL; /* Notification carries no message */
+#else  /* LWCELL_CFG_THREAD_PROCESS_NOTIFY */
         time = lwcelli_get_from_mbox_with_timeout_checks(&e->mbox_process, (void**)&msg, 10);
+#endif /* !LWCELL_CFG_THREAD_PROCESS_NOTIFY */
         LWCELL_THREAD_PROCESS_HOOK(); /* Execute process thread hook */
         lwcell_core_lock();
 
         if (time == LWCELL_SYS_TIMEOUT || msg == NULL) {
             LWCELL_UNUSED(time);  /* Unused variable */
         }
-        lwcelli_process_buffer(); /* Process input data */
+        lwcelli_process_buffer(); /* Process input data until buffer is empty */
+#if LWCELL_CFG_STATIC_ALLOC
+        lwcelli_mem_pool_report();
+#endif /* LWCELL_CFG_STATIC_ALLOC */
 #else                             /* LWCELL_CFG_INPUT_USE_PROCESS */
     while (1) {
         /*
@@ -214,9 +517,136 @@ lwcell_thread_process(void* const arg) {
          * If there are no timeouts to process, we can wait unlimited time.
          * In case new timeout occurs, thread will wake up by writing new element to mbox process queue
          */
+#if LWCELL_CFG_THREAD_PROCESS_NOTIFY
+        time = lwcelli_wait_notify_with_timeout_checks(&e->notify_process, 0);
+        LWCELL_UNUSED(msg);
+#else  /* LWCELL_CFG_THREAD_PROCESS_NOTIFY */
         time = lwcelli_get_from_mbox_with_timeout_checks(&e->mbox_process, (void**)&msg, 0);
+#endif /* !LWCELL_CFG_THREAD_PROCESS_NOTIFY */
         LWCELL_THREAD_PROCESS_HOOK(); /* Execute process thread hook */
         LWCELL_UNUSED(time);
+#if LWCELL_CFG_STATIC_ALLOC
+        lwcell_core_lock();
+        lwcelli_mem_pool_report();
+        lwcell_core_unlock();
+#endif /* LWCELL_CFG_STATIC_ALLOC */
 #endif                            /* !LWCELL_CFG_INPUT_USE_PROCESS */
     }
 }
+
+#endif /* LWCELL_CFG_OS || __DOXYGEN__ */
+
+#if !LWCELL_CFG_OS || __DOXYGEN__
+
+/**
+ * \brief           Run library from application main loop, when operating system is not used
+ *
+ * Function processes received data and expired timeouts,
+ * checks if active command finished or timed out and starts next command from the queue.
+ * It never blocks and replaces producing and processing threads in bare-metal mode.
+ *
+ * \note            Function must be called periodically from main loop,
+ *                  and as soon as possible after new data were written with \ref lwcell_input.
+ *                  It must not be called from interrupt context or from library callback functions
+ * \return          Time in units of milliseconds application may sleep before next call,
+ *                  `0` when there is more work pending, `0xFFFFFFFF` when nothing is scheduled
+ * \sa              LWCELL_CFG_OS
+ */
+uint32_t
+lwcell_poll(void) {
+    lwcell_t* e = &lwcell;
+    lwcell_msg_t* msg;
+    lwcellr_t res;
+    uint32_t wait, elapsed;
+    uint8_t started;
+
+    lwcell_core_lock();
+    lwcelli_process_buffer(); /* Process input data until buffer is empty */
+    wait = lwcelli_timeout_poll();
+#if LWCELL_CFG_STATIC_ALLOC
+    lwcelli_mem_pool_report();
+#endif /* LWCELL_CFG_STATIC_ALLOC */
+
+    while (1) {
+        /* Check if active command finished, process thread released semaphore, or timed out */
+        if ((msg = e->msg) != NULL) {
+            elapsed = lwcell_sys_now() - e->poll_cmd_time;
+            if (lwcell_sys_sem_wait(&e->sem_sync, 1) != LWCELL_SYS_TIMEOUT) {
+                res = lwcellOK;
+            } else if (msg->block_time > 0 && elapsed >= msg->block_time) {
+                res = lwcellTIMEOUT;
+            } else {
+                if (msg->block_time > 0) {
+                    wait = LWCELL_MIN(wait, msg->block_time - elapsed);
+                }
+                break; /* Command is still in progress */
+            }
+            lwcelli_cmd_park_cancel(msg); /* Command may time out while parked */
+            e->poll_next = prv_cmd_finish(msg, res, 1);
+        }
+
+        /* Start next command, priority lane is always served first */
+        msg = e->poll_next;
+        e->poll_next = NULL;
+#if LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0
+        if (msg == NULL) {
+            lwcell_sys_mbox_getnow(&e->mbox_producer_prio, (void**)&msg);
+        }
+#endif /* LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0 */
+        if (msg == NULL && !lwcell_sys_mbox_getnow(&e->mbox_producer, (void**)&msg)) {
+            break;
+        }
+        if (msg == NULL) {
+#if LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0
+            e->producer_prio_wakeup = 0; /* Next priority message posts new wake-up entry */
+#endif                                   /* LWCELL_CFG_THREAD_PRODUCER_PRIO_MBOX_SIZE > 0 */
+            continue;                    /* Wakeup entry for priority lane */
+        }
+        LWCELL_THREAD_PRODUCER_HOOK(); /* Execute producer thread hook */
+#if LWCELL_CFG_NETWORK_PDP_RECOVERY
+        if (lwcelli_network_pdp_hold(msg)) {
+            continue; /* Send waits until its connection is restored */
+        }
+#endif /* LWCELL_CFG_NETWORK_PDP_RECOVERY */
+        e->poll_cmd_time = lwcell_sys_now();
+        if ((res = prv_cmd_start(msg, &started)) != lwcellOK || !started) {
+            e->poll_next = prv_cmd_finish(msg, res, started);
+        }
+    }
+    lwcell_core_unlock();
+    return wait;
+}
+
+#endif /* !LWCELL_CFG_OS || __DOXYGEN__ */
+
+#if LWCELL_CFG_EVT_DEFERRED || __DOXYGEN__
+
+/**
+ * \brief           Thread for delivering deferred events to callback functions
+ *
+ *                  Events are delivered in the order they were generated,
+ *                  callback functions are called without core lock held
+ *
+ * \param[in]       arg: User argument, not used
+ * \sa              LWCELL_CFG_EVT_DEFERRED
+ */
+void
+lwcell_thread_evt(void* const arg) {
+    lwcell_evt_rec_t* rec;
+
+    LWCELL_UNUSED(arg);
+    while (1) {
+        if (lwcell_sys_mbox_get(&lwcell.mbox_evt, (void**)&rec, 0) == LWCELL_SYS_TIMEOUT || rec == NULL) {
+            continue;
+        }
+        rec->fn(&rec->evt);
+#if LWCELL_CFG_CONN
+        if (rec->evt.type == LWCELL_EVT_CONN_RECV) {
+            lwcell_pbuf_free(rec->evt.evt.conn_data_recv.buff); /* Release reference taken when queued */
+        }
+#endif /* LWCELL_CFG_CONN */
+        lwcell_mem_free_s((void**)&rec);
+    }
+}
+
+#endif /* LWCELL_CFG_EVT_DEFERRED || __DOXYGEN__ */
@@ -0,0 +1,224 @@
+/**
+ * \file            lwcell_time.c
+ * \brief           Network time and cell location API
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_time.h"
+#include "lwcell/lwcell_private.h"
+#include "system/lwcell_sys.h"
+
+#if LWCELL_CFG_TIME || __DOXYGEN__
+
+/* Days between 0000-03-01 and 1970-01-01 in proleptic Gregorian calendar */
+#define TIME_DAYS_TO_EPOCH 719468
+
+/**
+ * \brief           Convert UTC date and time to seconds since `1970-01-01`
+ * \param[in]       dt: Date and time
+ * \return          Seconds since `1970-01-01`
+ */
+static uint32_t
+prv_tm_to_epoch(const struct tm* dt) {
+    uint32_t y = LWCELL_U32(dt->tm_year + 1900), m = LWCELL_U32(dt->tm_mon + 1), era, yoe, doy, doe;
+
+    y -= m <= 2; /* Year starts in March, leap day is last day of year */
+    era = y / 400;
+    yoe = y - era * 400;
+    doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + LWCELL_U32(dt->tm_mday) - 1;
+    doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return (era * 146097 + doe - TIME_DAYS_TO_EPOCH) * 86400UL + LWCELL_U32(dt->tm_hour) * 3600UL
+           + LWCELL_U32(dt->tm_min) * 60UL + LWCELL_U32(dt->tm_sec);
+}
+
+/**
+ * \brief           Convert seconds since `1970-01-01` to UTC date and time
+ * \param[in]       t: Seconds since `1970-01-01`
+ * \param[out]      dt: Date and time
+ */
+static void
+prv_epoch_to_tm(uint32_t t, struct tm* dt) {
+    uint32_t days = t / 86400UL, sec = t % 86400UL, z, era, doe, yoe, doy, mp, m;
+
+    z = days + TIME_DAYS_TO_EPOCH;
+    era = z / 146097;
+    doe = z - era * 146097;
+    yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    mp = (5 * doy + 2) / 153;
+    m = mp < 10 ? mp + 3 : mp - 9;
+
+    LWCELL_MEMSET(dt, 0x00, sizeof(*dt));
+    dt->tm_year = (int)(yoe + era * 400 + (m <= 2)) - 1900;
+    dt->tm_mon = (int)m - 1;
+    dt->tm_mday = (int)(doy - (153 * mp + 2) / 5 + 1);
+    dt->tm_hour = (int)(sec / 3600);
+    dt->tm_min = (int)(sec / 60 % 60);
+    dt->tm_sec = (int)(sec % 60);
+    dt->tm_wday = (int)((days + 4) % 7); /* `1970-01-01` was Thursday */
+}
+
+/**
+ * \brief           Set network time captured from device
+ * \note            Function must be called with core locked
+ * \param[in]       dt: Date and time
+ * \param[in]       tz: Time zone in units of quarter hours
+ * \param[in]       is_local: Set to `1` if `dt` is local time, `0` if it is UTC
+ */
+void
+lwcelli_time_set(const struct tm* dt, int8_t tz, uint8_t is_local) {
+    lwcell.time.epoch = prv_tm_to_epoch(dt);
+    if (is_local) {
+        lwcell.time.epoch -= (uint32_t)((int32_t)tz * 15 * 60);
+    }
+    lwcell.time.tick = lwcell_sys_now();
+    if (is_local || tz != 0) { /* UTC only reports do not carry time zone */
+        lwcell.time.tz = tz;
+    }
+    lwcell.time.valid = 1;
+}
+
+/**
+ * \brief           Set time zone reported by network
+ * \note            Function must be called with core locked
+ * \param[in]       tz: Time zone in units of quarter hours
+ */
+void
+lwcelli_time_tz_set(int8_t tz) {
+    lwcell.time.tz = tz;
+}
+
+/**
+ * \brief           Set cell location reported by device
+ * \note            Function must be called with core locked
+ * \param[in]       lat: Latitude in units of `0.000001` degree
+ * \param[in]       lon: Longitude in units of `0.000001` degree
+ */
+void
+lwcelli_time_location_set(int32_t lat, int32_t lon) {
+    lwcell.time.loc.lat = lat;
+    lwcell.time.loc.lon = lon;
+    lwcell.time.loc_valid = 1;
+}
+
+/**
+ * \brief           Get current time from cache
+ *
+ * Time is calculated from last captured network time and system time elapsed since,
+ * no command is sent to device
+ *
+ * \param[out]      dt: Pointer to output variable to save UTC date and time to
+ * \param[out]      tz: Pointer to output variable to save time zone to, in units of quarter hours.
+ *                      Set to `NULL` if not used
+ * \return          \ref lwcellOK on success, \ref lwcellERR if time was not captured yet
+ */
+lwcellr_t
+lwcell_time_get(struct tm* dt, int8_t* tz) {
+    lwcellr_t res = lwcellERR;
+    uint32_t elapsed;
+
+    LWCELL_ASSERT(dt != NULL);
+
+    lwcell_core_lock();
+    if (lwcell.time.valid) {
+        /* Move capture point forward, to tolerate system time wrap */
+        elapsed = (lwcell_sys_now() - lwcell.time.tick) / 1000;
+        lwcell.time.epoch += elapsed;
+        lwcell.time.tick += elapsed * 1000;
+
+        prv_epoch_to_tm(lwcell.time.epoch, dt);
+        if (tz != NULL) {
+            *tz = lwcell.time.tz;
+        }
+        res = lwcellOK;
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Get approximate location from cache
+ * \param[out]      loc: Pointer to output variable to save location to
+ * \return          \ref lwcellOK on success, \ref lwcellERR if location was not captured yet
+ */
+lwcellr_t
+lwcell_time_location_get(lwcell_location_t* loc) {
+    lwcellr_t res = lwcellERR;
+
+    LWCELL_ASSERT(loc != NULL);
+
+    lwcell_core_lock();
+    if (lwcell.time.loc_valid) {
+        *loc = lwcell.time.loc;
+        res = lwcellOK;
+    }
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Read device clock with `AT+CCLK?` and store it to cache
+ * \note            Use it only when network does not provide time, as device clock is not set otherwise
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_time_sync(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE_HDR);
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CCLK;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 10000);
+}
+
+/**
+ * \brief           Read approximate location and time from cell location service and store them to cache
+ * \note            Bearer profile `1` must be open, as used by HTTP on SIM800 series
+ * \param[in]       evt_fn: Callback function called when command has finished. Set to `NULL` when not used
+ * \param[in]       evt_arg: Custom argument for event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_time_location_update(const lwcell_api_cmd_evt_fn evt_fn, void* const evt_arg, const uint32_t blocking) {
+    LWCELL_MSG_VAR_DEFINE(msg);
+
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(time_loc));
+    LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
+    LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CIPGSMLOC;
+
+    return lwcelli_send_msg_to_producer_mbox(&LWCELL_MSG_VAR_REF(msg), lwcelli_initiate_cmd, 60000);
+}
+
+#endif /* LWCELL_CFG_TIME || __DOXYGEN__ */
@@ -34,8 +34,115 @@
 #include "lwcell/lwcell_timeout.h"
 #include "lwcell/lwcell_private.h"
 
-static lwcell_timeout_t* first_timeout;
-static uint32_t last_timeout_time;
+/*
+ * Timeouts are kept in binary min-heap, ordered by absolute expiration time.
+ * Every entry knows its heap position, so it can be removed without searching.
+ */
+static lwcell_timeout_t** timeouts; /*!< Heap of scheduled timeouts */
+static size_t timeouts_cnt;         /*!< Number of scheduled timeouts */
+static size_t timeouts_size;        /*!< Number of entries heap memory can hold */
+
+/* Time comparison, safe for 32-bit timer overflow */
+#define TIMEOUT_BEFORE(a, b) ((int32_t)((a)->time - (b)->time) < 0)
+
+/**
+ * \brief           Place timeout on heap position and update its index
+ * \param[in]       to: Timeout entry
+ * \param[in]       pos: Heap position
+ */
+static void
+heap_set(lwcell_timeout_t* to, size_t pos) {
+    timeouts[pos] = to;
+    to->idx = pos + 1;
+}
+
+/**
+ * \brief           Move entry towards heap root until order is valid
+ * \param[in]       pos: Heap position of entry to move
+ */
+static void
+heap_up(size_t pos) {
+    lwcell_timeout_t* to = timeouts[pos];
+
+    while (pos > 0) {
+        size_t parent = (pos - 1) / 2;
+        if (!TIMEOUT_BEFORE(to, timeouts[parent])) {
+            break;
+        }
+        heap_set(timeouts[parent], pos);
+        pos = parent;
+    }
+    heap_set(to, pos);
+}
+
+/**
+ * \brief           Move entry away from heap root until order is valid
+ * \param[in]       pos: Heap position of entry to move
+ */
+static void
+heap_down(size_t pos) {
+    lwcell_timeout_t* to = timeouts[pos];
+
+    while (1) {
+        size_t child = 2 * pos + 1;
+        if (child >= timeouts_cnt) {
+            break;
+        }
+        if (child + 1 < timeouts_cnt && TIMEOUT_BEFORE(timeouts[child + 1], timeouts[child])) {
+            ++child;
+        }
+        if (!TIMEOUT_BEFORE(timeouts[child], to)) {
+            break;
+        }
+        heap_set(timeouts[child], pos);
+        pos = child;
+    }
+    heap_set(to, pos);
+}
+
+/**
+ * \brief           Insert timeout entry to heap
+ * \note            Core must be locked when calling this function
+ * \param[in]       to: Timeout entry, not yet scheduled
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+static lwcellr_t
+heap_insert(lwcell_timeout_t* to) {
+    if (timeouts_cnt == timeouts_size) {
+        size_t new_size = timeouts_size > 0 ? (2 * timeouts_size) : 8;
+        lwcell_timeout_t** new_timeouts =
+            lwcell_mem_realloc_tag(timeouts, new_size * sizeof(*timeouts), LWCELL_MEM_TAG_TIMEOUT);
+        if (new_timeouts == NULL) {
+            return lwcellERRMEM;
+        }
+        timeouts = new_timeouts;
+        timeouts_size = new_size;
+    }
+    timeouts[timeouts_cnt] = to;
+    heap_up(timeouts_cnt++);
+    return lwcellOK;
+}
+
+/**
+ * \brief           Remove scheduled timeout entry from heap
+ * \note            Core must be locked when calling this function
+ * \param[in]       to: Timeout entry to remove
+ */
+static void
+heap_remove(lwcell_timeout_t* to) {
+    size_t pos = to->idx - 1;
+
+    to->idx = 0;
+    if (--timeouts_cnt == pos) { /* Last entry, nothing to reorder */
+        return;
+    }
+    heap_set(timeouts[timeouts_cnt], pos);
+    if (pos > 0 && TIMEOUT_BEFORE(timeouts[pos], timeouts[(pos - 1) / 2])) {
+        heap_up(pos);
+    } else {
+        heap_down(pos);
+    }
+}
 
 /**
  * \brief           Get time we have to wait before we can process next timeout
@@ -43,44 +150,59 @@ static uint32_t last_timeout_time;
  */
 static uint32_t
 get_next_timeout_diff(void) {
-    uint32_t diff;
-    if (first_timeout == NULL) {
+    int32_t diff;
+    if (timeouts_cnt == 0) {
         return 0xFFFFFFFF;
     }
-    diff = lwcell_sys_now() - last_timeout_time; /* Get difference between current time and last process time */
-    if (diff >= first_timeout->time) {           /* Are we over already? */
-        return 0;                                /* We have to immediately process this timeout */
+    diff = (int32_t)(timeouts[0]->time - lwcell_sys_now());
+    if (diff <= 0) { /* Are we over already? */
+        return 0;    /* We have to immediately process this timeout */
     }
-    return first_timeout->time - diff;           /* Return remaining time for sleep */
+    return (uint32_t)diff; /* Return remaining time for sleep */
 }
 
 /**
- * \brief           Process next timeout in a linked list
+ * \brief           Get time to wait before timeouts shall be processed, including slack
+ * \return          Time in units of milliseconds to wait
  */
-static void
-process_next_timeout(void) {
-    uint32_t time;
-
-    time = lwcell_sys_now();
+static uint32_t
+get_next_wait_time(void) {
+    uint32_t diff = get_next_timeout_diff();
 
-    /*
-     * Before calling timeout callback, update variable
-     * to make sure we have correct timing in case
-     * callback creates timeout value again
-     */
-    last_timeout_time = time; /* Reset variable when we were last processed */
+#if LWCELL_CFG_TIMEOUT_SLACK > 0
+    if (diff > 0 && diff < (0xFFFFFFFF - LWCELL_CFG_TIMEOUT_SLACK)) {
+        diff += LWCELL_CFG_TIMEOUT_SLACK; /* Wait for nearby timeouts to expire too */
+    }
+#endif /* LWCELL_CFG_TIMEOUT_SLACK > 0 */
+    return diff;
+}
 
-    if (first_timeout != NULL) {
-        lwcell_timeout_t* to = first_timeout;
+/**
+ * \brief           Process all expired timeouts in a heap
+ *
+ * Number of processed entries is limited to entries scheduled at the time of call,
+ * callback function restarting its timeout with `0` time cannot keep thread in the loop
+ */
+static void
+process_expired_timeouts(void) {
+    for (size_t cnt = timeouts_cnt; cnt > 0 && timeouts_cnt > 0 && get_next_timeout_diff() == 0; --cnt) {
+        lwcell_timeout_t* to = timeouts[0];
 
         /*
-         * Before calling callback remove current timeout from list
+         * Before calling callback remove current timeout from heap
          * to make sure we are safe in case callback function
-         * adds a new timeout entry to list
+         * adds a new timeout entry or restarts the same one
          */
-        first_timeout = first_timeout->next; /* Set next timeout on a list as first timeout */
-        to->fn(to->arg);                     /* Call user callback function */
-        lwcell_mem_free_s((void**)&to);
+        heap_remove(to);
+        if (to->dyn) {
+            lwcell_timeout_fn fn = to->fn;
+            void* arg = to->arg;
+
+            lwcell_mem_free_s((void**)&to);
+            fn(arg); /* Call user callback function */
+        } else {
+            to->fn(to->arg); /* Call user callback function */
+        }
     }
 }
 
@@ -95,13 +217,13 @@ uint32_t
 lwcelli_get_from_mbox_with_timeout_checks(lwcell_sys_mbox_t* b, void** m, uint32_t timeout) {
     uint32_t wait_time;
     do {
-        if (first_timeout == NULL) {                   /* We have no timeouts ready? */
+        if (timeouts_cnt == 0) {                       /* We have no timeouts ready? */
             return lwcell_sys_mbox_get(b, m, timeout); /* Get entry from message queue */
         }
-        wait_time = get_next_timeout_diff();           /* Get time to wait for next timeout execution */
+        wait_time = get_next_wait_time();              /* Get time to wait for next timeout execution */
         if (wait_time == 0 || lwcell_sys_mbox_get(b, m, wait_time) == LWCELL_SYS_TIMEOUT) {
             lwcell_core_lock();
-            process_next_timeout(); /* Process with next timeout */
+            process_expired_timeouts(); /* Process expired timeouts */
             lwcell_core_unlock();
         }
         break;
@@ -109,8 +231,145 @@ lwcelli_get_from_mbox_with_timeout_checks(lwcell_sys_mbox_t* b, void** m, uint32
     return wait_time;
 }
 
+#if LWCELL_CFG_THREAD_PROCESS_NOTIFY || __DOXYGEN__
+
+/**
+ * \brief           Wait for notification and process timeouts in the meantime
+ * \param[in]       n: Pointer to notification to wait for
+ * \param[in]       timeout: Maximal time to wait for notification (0 = wait until notification received)
+ * \return          Time in milliseconds required for next notification
+ */
+uint32_t
+lwcelli_wait_notify_with_timeout_checks(lwcell_sys_notify_t* n, uint32_t timeout) {
+    uint32_t wait_time;
+
+    if (timeouts_cnt == 0) {                       /* We have no timeouts ready? */
+        return lwcell_sys_notify_wait(n, timeout); /* Wait for notification */
+    }
+    wait_time = get_next_wait_time(); /* Get time to wait for next timeout execution */
+    if (timeout > 0 && timeout < wait_time) {
+        wait_time = timeout; /* Do not wait longer than requested */
+    }
+    if (wait_time == 0 || lwcell_sys_notify_wait(n, wait_time) == LWCELL_SYS_TIMEOUT) {
+        lwcell_core_lock();
+        process_expired_timeouts(); /* Process expired timeouts */
+        lwcell_core_unlock();
+    }
+    return wait_time;
+}
+
+#endif /* LWCELL_CFG_THREAD_PROCESS_NOTIFY || __DOXYGEN__ */
+
+#if !LWCELL_CFG_OS || __DOXYGEN__
+
+/**
+ * \brief           Process expired timeouts without waiting
+ * \note            Function must be called with core locked
+ * \return          Time in milliseconds until next timeout shall be processed
+ */
+uint32_t
+lwcelli_timeout_poll(void) {
+    process_expired_timeouts();
+    return get_next_wait_time();
+}
+
+#endif /* !LWCELL_CFG_OS || __DOXYGEN__ */
+
+/**
+ * \brief           Start timeout with application provided entry
+ *
+ * Entry memory is owned by application and must stay valid until timeout expires or is stopped.
+ * When entry is already scheduled, it is rescheduled with new parameters.
+ *
+ * \param[in]       to: Timeout entry. It shall be zero-initialized before first use
+ * \param[in]       time: Time in units of milliseconds for timeout execution
+ * \param[in]       fn: Callback function to call when timeout expires
+ * \param[in]       arg: Pointer to user specific argument to call when timeout callback function is executed
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ * \sa              lwcell_timeout_stop
+ */
+lwcellr_t
+lwcell_timeout_start(lwcell_timeout_t* to, uint32_t time, lwcell_timeout_fn fn, void* arg) {
+    lwcellr_t res = lwcellOK;
+
+    LWCELL_ASSERT(to != NULL);
+    LWCELL_ASSERT(fn != NULL);
+
+    lwcell_core_lock();
+    to->fn = fn;
+    to->arg = arg;
+    to->time = lwcell_sys_now() + time;
+    if (to->idx > 0) { /* Already scheduled, restore heap order */
+        size_t pos = to->idx - 1;
+        if (pos > 0 && TIMEOUT_BEFORE(to, timeouts[(pos - 1) / 2])) {
+            heap_up(pos);
+        } else {
+            heap_down(pos);
+        }
+    } else {
+        res = heap_insert(to);
+    }
+    lwcell_core_unlock();
+    if (res == lwcellOK) {
+        LWCELL_PROCESS_WAKEUP(); /* Wakeup process thread to re-evaluate next timeout */
+    }
+    return res;
+}
+
+/**
+ * \brief           Stop timeout, previously started with \ref lwcell_timeout_start
+ * \param[in]       to: Timeout entry
+ * \return          \ref lwcellOK on success, \ref lwcellERR if timeout was not scheduled
+ */
+lwcellr_t
+lwcell_timeout_stop(lwcell_timeout_t* to) {
+    uint8_t success = 0;
+
+    LWCELL_ASSERT(to != NULL);
+
+    lwcell_core_lock();
+    if (to->idx > 0) {
+        heap_remove(to);
+        success = 1;
+    }
+    lwcell_core_unlock();
+    return success ? lwcellOK : lwcellERR;
+}
+
+/**
+ * \brief           Check if timeout entry is scheduled
+ * \param[in]       to: Timeout entry
+ * \return          `1` if scheduled, `0` otherwise
+ */
+uint8_t
+lwcell_timeout_is_active(const lwcell_timeout_t* to) {
+    uint8_t active;
+
+    lwcell_core_lock();
+    active = to != NULL && to->idx > 0;
+    lwcell_core_unlock();
+    return active;
+}
+
+/**
+ * \brief           Get time until library has to process next timeout
+ *
+ * It is intended for tickless idle integration, such as RTOS pre-sleep hook,
+ * to select sleep time without periodic wake-ups. Time includes \ref LWCELL_CFG_TIMEOUT_SLACK.
+ *
+ * \note            Function does not lock the core and can be called from idle task.
+ *                  Value is a snapshot, new timeout started afterwards wakes up processing thread
+ * \return          Time in units of milliseconds, `0xFFFFFFFF` when no timeout is scheduled
+ */
+uint32_t
+lwcell_timeout_get_next_diff(void) {
+    return get_next_wait_time();
+}
+
 /**
  * \brief           Add new timeout to processing list
+ * \note            Entry is allocated by the library. Use \ref lwcell_timeout_start
+ *                  to avoid allocation and to cancel specific timeout
  * \param[in]       time: Time in units of milliseconds for timeout execution
  * \param[in]       fn: Callback function to call when timeout expires
  * \param[in]       arg: Pointer to user specific argument to call when timeout callback function is executed
@@ -119,111 +378,46 @@ lwcelli_get_from_mbox_with_timeout_checks(lwcell_sys_mbox_t* b, void** m, uint32
 lwcellr_t
 lwcell_timeout_add(uint32_t time, lwcell_timeout_fn fn, void* arg) {
     lwcell_timeout_t* to;
-    uint32_t now;
+    lwcellr_t res;
 
     LWCELL_ASSERT(fn != NULL);
 
     /* Allocate memory for timeout structure */
-    if ((to = lwcell_mem_calloc(1, sizeof(*to))) == NULL) {
+    if ((to = lwcell_mem_calloc_tag(1, sizeof(*to), LWCELL_MEM_TAG_TIMEOUT)) == NULL) {
         return lwcellERRMEM;
     }
-
-    lwcell_core_lock();
-    now = lwcell_sys_now(); /* Get current time */
-    if (first_timeout != NULL) {
-        /*
-         * Since we want timeout value to start from NOW,
-         * we have to add time when we last processed our timeouts
-         */
-        time += now - last_timeout_time; /* Add difference between now and last processed time */
-    }
-    to->time = time;
-    to->arg = arg;
-    to->fn = fn;
-
-    /*
-     * Add new timeout to proper place on linked list
-     * and align times to have correct values between timeouts
-     */
-    if (first_timeout == NULL) {
-        first_timeout = to;      /* Set as first element */
-        last_timeout_time = now; /* Reset last timeout time to current time */
-    } else {                     /* Find where to place a new timeout */
-        /*
-         * First check if we have to put new timeout
-         * to beginning of linked list.
-         * In this case just align new value for current first element
-         */
-        if (first_timeout->time > to->time) {
-            first_timeout->time -= time; /* Decrease first timeout value to match difference */
-            to->next = first_timeout;    /* Set first timeout as next of new one */
-            first_timeout = to;          /* Set new timeout as first */
-        } else {                         /* Go somewhere in between current list */
-            for (lwcell_timeout_t* t = first_timeout; t != NULL; t = t->next) {
-                to->time -= t->time;     /* Decrease new timeout time by time in a linked list */
-                /*
-                 * Enter between 2 entries on a list in case:
-                 *
-                 * - We reached end of linked list
-                 * - Our time is less than diff between 2 entries in list
-                 */
-                if (t->next == NULL || t->next->time > to->time) {
-                    if (t->next != NULL) {         /* Check if there is next element */
-                        t->next->time -= to->time; /* Decrease difference time to next one */
-                    } else if (to->time > time) {  /* Overflow of time check */
-                        to->time = time + first_timeout->time;
-                    }
-                    to->next = t->next; /* Change order of elements */
-                    t->next = to;       /* Add new element to linked list */
-                    break;
-                }
-            }
-        }
+    to->dyn = 1;
+    if ((res = lwcell_timeout_start(to, time, fn, arg)) != lwcellOK) {
+        lwcell_mem_free_s((void**)&to);
     }
-    lwcell_core_unlock();
-    lwcell_sys_mbox_putnow(&lwcell.mbox_process, NULL); /* Insert dummy value to wakeup process thread */
-    return lwcellOK;
+    return res;
 }
 
 /**
  * \brief           Remove callback from timeout list
+ * \note            First found timeout with matching callback is removed.
+ *                  Use \ref lwcell_timeout_stop to remove specific timeout
  * \param[in]       fn: Callback function to identify timeout to remove
  * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
  */
 lwcellr_t
 lwcell_timeout_remove(lwcell_timeout_fn fn) {
-    uint8_t success = 0;
+    lwcell_timeout_t* to = NULL;
 
     lwcell_core_lock();
-    for (lwcell_timeout_t *t = first_timeout, *t_prev = NULL; t != NULL;
-         t_prev = t, t = t->next) { /* Check all entries */
-        if (t->fn == fn) {          /* Do we have a match from callback point of view? */
-
-            /*
-             * We have to first increase
-             * difference time between current and next one
-             * to be aligned for correct wait time
-             */
-            if (t->next != NULL) {        /* Do we have next element? */
-                t->next->time += t->time; /* Increase timeout time for next element */
-            }
-
-            /*
-             * In case we have previous element on a list,
-             * set next element of previous to next of current one
-             * otherwise we were first element so simply set
-             * next of current as first one
-             */
-            if (t_prev != NULL) {
-                t_prev->next = t->next;
-            } else {
-                first_timeout = t->next;
-            }
-            lwcell_mem_free_s((void**)&t);
-            success = 1;
+    for (size_t i = 0; i < timeouts_cnt; ++i) {
+        if (timeouts[i]->fn == fn) {
+            to = timeouts[i];
+            heap_remove(to);
             break;
         }
     }
     lwcell_core_unlock();
-    return success ? lwcellOK : lwcellERR;
+    if (to == NULL) {
+        return lwcellERR;
+    }
+    if (to->dyn) {
+        lwcell_mem_free_s((void**)&to);
+    }
+    return lwcellOK;
 }
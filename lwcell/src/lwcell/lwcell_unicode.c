@@ -34,6 +34,48 @@
 #include "lwcell/lwcell_unicode.h"
 #include "lwcell/lwcell_private.h"
 
+/* Word-at-a-time byte checks, see "Bit Twiddling Hacks" */
+#define WORD_ONES           ((size_t)-1 / 0xFF)
+#define WORD_HIGHS          (WORD_ONES * 0x80)
+#define WORD_HAS_LESS(w, n) ((((w) - WORD_ONES * (n)) & ~(w) & WORD_HIGHS) != 0)
+#define WORD_HAS_BYTE(w, n) WORD_HAS_LESS((w) ^ (WORD_ONES * (n)), 1)
+
+/* Bit is set for characters, which continue plain ASCII run: printable except `>` and `\r` */
+static const uint32_t ascii_run_chars[4] = {
+    0x00002000, /* 0x00 - 0x1F: `\r` only */
+    0xBFFFFFFF, /* 0x20 - 0x3F: all except `>` */
+    0xFFFFFFFF, /* 0x40 - 0x5F */
+    0x7FFFFFFF, /* 0x60 - 0x7F: all except DEL */
+};
+
+/**
+ * \brief           Get length of plain ASCII run at the beginning of data
+ *
+ * Run contains printable characters and `\r` and ends on new line, prompt `>`,
+ * control or non-ASCII character, which have to be processed by state machine and unicode decoder.
+ * Data are checked one word at a time, bytes of the last word and of word with any special
+ * character are checked with lookup table
+ *
+ * \param[in]       data: Data to check
+ * \param[in]       len: Length of data in units of bytes
+ * \return          Number of bytes in the run
+ */
+size_t
+lwcelli_unicode_ascii_run(const uint8_t* data, size_t len) {
+    size_t i = 0;
+
+    for (; i + sizeof(size_t) <= len; i += sizeof(size_t)) {
+        size_t w;
+
+        LWCELL_MEMCPY(&w, &data[i], sizeof(w)); /* Input data may not be aligned */
+        if ((w & WORD_HIGHS) != 0 || WORD_HAS_LESS(w, 0x20) || WORD_HAS_BYTE(w, '>') || WORD_HAS_BYTE(w, 0x7F)) {
+            break;
+        }
+    }
+    for (; i < len && data[i] < 0x80 && (ascii_run_chars[data[i] >> 5] & (1UL << (data[i] & 0x1F))) != 0; ++i) {}
+    return i;
+}
+
 /**
  * \brief           Decode single character for unicode (UTF-8 only) format
  * \param[in,out]   s: Pointer to unicode decode control structure
@@ -73,3 +115,58 @@ lwcelli_unicode_decode(lwcell_unicode_t* s, uint8_t c) {
     }
     return lwcellERR;                /* An error, unknown UTF-8 character entered */
 }
+
+/**
+ * \brief           Decode UCS2 text in hex format to UTF-8 text, in place
+ *
+ * Every UCS2 code unit takes `4` hex characters and at most `3` bytes in UTF-8 format,
+ * surrogate pair takes `8` hex characters and `4` bytes. Output is never longer than input.
+ *
+ * \param[in,out]   str: `NULL` terminated hex string. Incomplete code unit at the end is dropped
+ * \return          `1` when string was decoded, `0` when it is not a hex string and was left unchanged
+ */
+uint8_t
+lwcelli_unicode_ucs2_hex_decode(char* str) {
+    const char* in = str;
+    char* out = str;
+    size_t units;
+    uint32_t cp, lo;
+
+    for (; *in != '\0'; ++in) {
+        if (!LWCELL_CHARISHEXNUM(*in)) {
+            return 0;
+        }
+    }
+    units = (size_t)(in - str) / 4;
+    in = str;
+    for (size_t i = 0; i < units; ++i, in += 4) {
+        cp = ((uint32_t)LWCELL_CHARHEXTONUM(in[0]) << 12) | ((uint32_t)LWCELL_CHARHEXTONUM(in[1]) << 8)
+             | ((uint32_t)LWCELL_CHARHEXTONUM(in[2]) << 4) | (uint32_t)LWCELL_CHARHEXTONUM(in[3]);
+        if (cp >= 0xD800 && cp < 0xDC00 && i + 1 < units) { /* High surrogate, combine with low one */
+            lo = ((uint32_t)LWCELL_CHARHEXTONUM(in[4]) << 12) | ((uint32_t)LWCELL_CHARHEXTONUM(in[5]) << 8)
+                 | ((uint32_t)LWCELL_CHARHEXTONUM(in[6]) << 4) | (uint32_t)LWCELL_CHARHEXTONUM(in[7]);
+            if (lo >= 0xDC00 && lo < 0xE000) {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                ++i;
+                in += 4;
+            }
+        }
+        if (cp < 0x80) {
+            *out++ = (char)cp;
+        } else if (cp < 0x800) {
+            *out++ = (char)(0xC0 | (cp >> 6));
+            *out++ = (char)(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            *out++ = (char)(0xE0 | (cp >> 12));
+            *out++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+            *out++ = (char)(0x80 | (cp & 0x3F));
+        } else {
+            *out++ = (char)(0xF0 | (cp >> 18));
+            *out++ = (char)(0x80 | ((cp >> 12) & 0x3F));
+            *out++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+            *out++ = (char)(0x80 | (cp & 0x3F));
+        }
+    }
+    *out = '\0';
+    return 1;
+}
@@ -0,0 +1,225 @@
+/**
+ * \file            lwcell_usage.c
+ * \brief           Data usage accounting
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_usage.h"
+#include "lwcell/lwcell_private.h"
+
+#if LWCELL_CFG_USAGE || __DOXYGEN__
+
+/**
+ * \brief           Get total usage with overhead
+ * \return          Number of bytes
+ */
+static uint64_t
+prv_usage_used(void) {
+    const lwcell_usage_t* u = &lwcell.usage.total;
+
+    return u->tx + u->rx + u->tx_overhead + u->rx_overhead;
+}
+
+/**
+ * \brief           Add bytes to usage counters
+ * \param[in]       u: Usage counters
+ * \param[in]       len: Payload length
+ * \param[in]       overhead: Estimated overhead
+ * \param[in]       is_tx: Set to `1` for sent data, `0` for received data
+ */
+static void
+prv_usage_add(lwcell_usage_t* u, size_t len, size_t overhead, uint8_t is_tx) {
+    if (is_tx) {
+        u->tx += len;
+        u->tx_overhead += overhead;
+    } else {
+        u->rx += len;
+        u->rx_overhead += overhead;
+    }
+}
+
+/**
+ * \brief           Send quota event to application
+ * \param[in]       is_limit: Set to `1` for limit, `0` for warning threshold
+ */
+static void
+prv_usage_send_evt(uint8_t is_limit) {
+    LWCELL_DEBUGF(LWCELL_CFG_DBG_CONN | LWCELL_DBG_TYPE_TRACE | LWCELL_DBG_LVL_WARNING,
+                  "[LWCELL USAGE] Quota %s reached\r\n", is_limit ? "limit" : "warning");
+    lwcell.evt.evt.usage_quota.used = prv_usage_used();
+    lwcell.evt.evt.usage_quota.is_limit = is_limit;
+    lwcelli_send_cb(LWCELL_EVT_USAGE_QUOTA);
+}
+
+/**
+ * \brief           Account data sent or received on connection
+ * \note            Function is called with core locked
+ * \param[in]       conn: Connection handle
+ * \param[in]       len: Payload length in units of bytes, single datagram for UDP connection
+ * \param[in]       is_tx: Set to `1` for sent data, `0` for received data
+ */
+void
+lwcelli_usage_add(lwcell_conn_p conn, size_t len, uint8_t is_tx) {
+    size_t overhead;
+    uint64_t used;
+
+    if (len == 0) {
+        return;
+    }
+    if (conn->type == LWCELL_CONN_TYPE_UDP) {
+        overhead = LWCELL_CFG_USAGE_UDP_OVERHEAD;
+    } else {
+        overhead = ((len + LWCELL_CFG_USAGE_TCP_SEGMENT_LEN - 1) / LWCELL_CFG_USAGE_TCP_SEGMENT_LEN)
+                   * LWCELL_CFG_USAGE_TCP_OVERHEAD;
+    }
+    prv_usage_add(&conn->usage, len, overhead, is_tx);
+    prv_usage_add(&lwcell.usage.ctx[LWCELL_MIN(conn->status.f.bearer, LWCELL_CFG_NETWORK_CONTEXTS - 1)], len, overhead,
+                  is_tx);
+    prv_usage_add(&lwcell.usage.total, len, overhead, is_tx);
+
+    used = prv_usage_used();
+    if (lwcell.usage.warn > 0 && !lwcell.usage.warn_sent && used >= lwcell.usage.warn) {
+        lwcell.usage.warn_sent = 1;
+        prv_usage_send_evt(0);
+    }
+    if (lwcell.usage.limit > 0 && !lwcell.usage.limit_sent && used >= lwcell.usage.limit) {
+        lwcell.usage.limit_sent = 1;
+        prv_usage_send_evt(1);
+    }
+}
+
+/**
+ * \brief           Check if sending on connection is blocked by quota
+ * \param[in]       conn: Connection handle
+ * \return          `1` if connection is throttled, `0` otherwise
+ */
+uint8_t
+lwcelli_usage_is_throttled(lwcell_conn_p conn) {
+    uint8_t res;
+
+    lwcell_core_lock();
+    res = lwcell.usage.throttle && lwcell.usage.limit_sent && conn->status.f.low_prio;
+    lwcell_core_unlock();
+    return res;
+}
+
+/**
+ * \brief           Get usage of PDP context or total usage
+ * \param[in]       ctx: PDP context number or \ref LWCELL_USAGE_TOTAL for total usage
+ * \param[out]      usage: Pointer to output variable
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_usage_get(uint8_t ctx, lwcell_usage_t* usage) {
+    LWCELL_ASSERT(usage != NULL);
+    LWCELL_ASSERT(ctx < LWCELL_CFG_NETWORK_CONTEXTS || ctx == LWCELL_USAGE_TOTAL);
+
+    lwcell_core_lock();
+    *usage = ctx == LWCELL_USAGE_TOTAL ? lwcell.usage.total : lwcell.usage.ctx[ctx];
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+/**
+ * \brief           Get usage of connection since it became active
+ * \param[in]       conn: Connection handle
+ * \param[out]      usage: Pointer to output variable
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_usage_get_conn(lwcell_conn_p conn, lwcell_usage_t* usage) {
+    LWCELL_ASSERT(conn != NULL && lwcelli_is_valid_conn_ptr(conn));
+    LWCELL_ASSERT(usage != NULL);
+
+    lwcell_core_lock();
+    *usage = conn->usage;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+/**
+ * \brief           Reset context and total counters, such as at start of billing period
+ *
+ * Quota events are armed again and throttled connections may send
+ *
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_usage_reset(void) {
+    lwcell_core_lock();
+    LWCELL_MEMSET(lwcell.usage.ctx, 0x00, sizeof(lwcell.usage.ctx));
+    LWCELL_MEMSET(&lwcell.usage.total, 0x00, sizeof(lwcell.usage.total));
+    lwcell.usage.warn_sent = 0;
+    lwcell.usage.limit_sent = 0;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+/**
+ * \brief           Set quota thresholds for total usage
+ *
+ * Thresholds already exceeded are reported with next accounted data
+ *
+ * \param[in]       warn: Warning threshold in units of bytes. Set to `0` to disable
+ * \param[in]       limit: Limit threshold in units of bytes. Set to `0` to disable
+ * \param[in]       throttle: Set to `1` to block sending on low-priority connections when limit is reached
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ * \sa              lwcell_usage_set_conn_low_prio
+ */
+lwcellr_t
+lwcell_usage_set_quota(uint64_t warn, uint64_t limit, uint8_t throttle) {
+    lwcell_core_lock();
+    lwcell.usage.warn = warn;
+    lwcell.usage.limit = limit;
+    lwcell.usage.throttle = throttle;
+    lwcell.usage.warn_sent = 0;
+    lwcell.usage.limit_sent = 0;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+/**
+ * \brief           Mark connection as low priority, to be throttled when quota limit is reached
+ * \note            Flag is cleared when connection becomes active, set it in \ref LWCELL_EVT_CONN_ACTIVE event
+ * \param[in]       conn: Connection handle
+ * \param[in]       low_prio: Set to `1` to mark connection as low priority, `0` otherwise
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_usage_set_conn_low_prio(lwcell_conn_p conn, uint8_t low_prio) {
+    LWCELL_ASSERT(conn != NULL && lwcelli_is_valid_conn_ptr(conn));
+
+    lwcell_core_lock();
+    conn->status.f.low_prio = low_prio > 0;
+    lwcell_core_unlock();
+    return lwcellOK;
+}
+
+#endif /* LWCELL_CFG_USAGE || __DOXYGEN__ */
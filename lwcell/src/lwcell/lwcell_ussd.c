@@ -38,6 +38,8 @@
 
 /**
  * \brief           Run USSD command, such as `*123#` to get balance on SIM card
+ * \note            Response in UCS2 alphabet is decoded to UTF-8 text.
+ *                  It is received as hex string first, array must be large enough for `4` characters per symbol
  * \param[in]       code: Code to run, such as `*123#`
  * \param[out]      resp: Pointer to array to save response
  * \param[in]       resp_len: Length of array, including string `NULL` termination
@@ -55,7 +57,7 @@ lwcell_ussd_run(const char* code, char* resp, size_t resp_len, const lwcell_api_
     LWCELL_ASSERT(resp != NULL);
     LWCELL_ASSERT(resp_len > 0);
 
-    LWCELL_MSG_VAR_ALLOC(msg, blocking);
+    LWCELL_MSG_VAR_ALLOC_SZ(msg, blocking, LWCELL_MSG_SIZE(ussd));
     LWCELL_MSG_VAR_SET_EVT(msg, evt_fn, evt_arg);
     LWCELL_MSG_VAR_REF(msg).cmd_def = LWCELL_CMD_CUSD;
     LWCELL_MSG_VAR_REF(msg).cmd = LWCELL_CMD_CUSD_GET;
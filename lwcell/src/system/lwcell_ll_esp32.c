@@ -37,6 +37,7 @@
 #include "lwcell/lwcell_input.h"
 #include "lwcell/lwcell_mem.h"
 #include "lwcell/lwcell_types.h"
+#include "lwcell/lwcell_utils.h"
 #include "system/lwcell_ll.h"
 
 #if !__DOXYGEN__
@@ -55,11 +56,22 @@
 #define LWCELL_MEM_SIZE 0x1000
 #endif /* !defined(LWCELL_MEM_SIZE) */
 
+/*
+ * Minimal number of buffered bytes to forward to stack on intermediate data event.
+ * Smaller chunks wait for end of line pattern or receive timeout, to process complete lines in single call
+ */
+#if !defined(LWCELL_USART_RX_BULK_LEN)
+#define LWCELL_USART_RX_BULK_LEN 512
+#endif /* !defined(LWCELL_USART_RX_BULK_LEN) */
+
+/* Size of end of line pattern position queue */
+#define GSM_UART_PATTERN_QUEUE_SIZE 20
+
 static QueueHandle_t gsm_uart_queue;
 
 static uint8_t initialized = 0;
 
-char* uart_buffer[LWCELL_USART_DMA_RX_BUFF_SIZE];
+static uint8_t uart_buffer[LWCELL_USART_DMA_RX_BUFF_SIZE];
 
 /**
  * \brief           Send data to GSM device, function called from GSM stack when we have data to send
@@ -78,6 +90,38 @@ send_data(const void* data, size_t len) {
     return len; /* Return number of bytes actually sent to AT port */
 }
 
+/**
+ * \brief           Read all buffered data and send it to stack
+ */
+static void
+uart_forward_buffered(void) {
+    size_t buffer_len = 0;
+
+    uart_get_buffered_data_len(GSM_UART_NUM, &buffer_len);
+    while (buffer_len > 0) {
+        int len = uart_read_bytes(GSM_UART_NUM, uart_buffer, LWCELL_MIN(buffer_len, sizeof(uart_buffer)), 0);
+        if (len <= 0) {
+            break;
+        }
+        ESP_LOG_BUFFER_HEXDUMP("<", uart_buffer, len, ESP_LOG_DEBUG);
+#if LWCELL_CFG_INPUT_USE_PROCESS
+        lwcell_input_process(uart_buffer, (size_t)len);
+#else
+        lwcell_input(uart_buffer, (size_t)len);
+#endif
+        buffer_len -= LWCELL_MIN(buffer_len, (size_t)len);
+    }
+}
+
+/**
+ * \brief           UART event task
+ *
+ * Data is forwarded to stack once end of line is detected, line goes idle
+ * or enough data is buffered, such as during data phase of received connection data.
+ * Complete lines and bulk data blocks are passed with single input call
+ *
+ * \param[in]       pvParameters: Task parameters
+ */
 static void
 uart_event_task(void* pvParameters) {
     uart_event_t event;
@@ -88,25 +132,27 @@ uart_event_task(void* pvParameters) {
         if (xQueueReceive(gsm_uart_queue, (void*)&event, (portTickType)portMAX_DELAY)) {
             switch (event.type) {
                 case UART_DATA:
+                    /* Intermediate FIFO chunk, wait for more unless line went idle */
                     uart_get_buffered_data_len(GSM_UART_NUM, &buffer_len);
-                    buffer_len = uart_read_bytes(GSM_UART_NUM, (void*)uart_buffer, buffer_len, portMAX_DELAY);
-                    ESP_LOG_BUFFER_HEXDUMP("<", uart_buffer, buffer_len, ESP_LOG_DEBUG);
-                    if (buffer_len) {
-#if LWCELL_CFG_INPUT_USE_PROCESS
-                        lwcell_input_process(uart_buffer, buffer_len);
-#else
-                        lwcell_input(uart_buffer, buffer_len);
-#endif
+                    if (event.timeout_flag || buffer_len >= LWCELL_USART_RX_BULK_LEN) {
+                        uart_forward_buffered();
                     }
                     break;
+                case UART_PATTERN_DET:
+                    /* Everything up to and including latest end of line is buffered, positions are not needed */
+                    while (uart_pattern_pop_pos(GSM_UART_NUM) >= 0) {}
+                    uart_forward_buffered();
+                    break;
                 case UART_FIFO_OVF:
                     ESP_LOGW(TAG, "UART_FIFO_OVF");
                     uart_flush_input(GSM_UART_NUM);
+                    uart_pattern_queue_reset(GSM_UART_NUM, GSM_UART_PATTERN_QUEUE_SIZE);
                     xQueueReset(gsm_uart_queue);
                     break;
                 case UART_BUFFER_FULL:
                     ESP_LOGW(TAG, "UART_BUFFER_FULL");
                     uart_flush_input(GSM_UART_NUM);
+                    uart_pattern_queue_reset(GSM_UART_NUM, GSM_UART_PATTERN_QUEUE_SIZE);
                     xQueueReset(gsm_uart_queue);
                     break;
                 default: break;
@@ -127,10 +173,20 @@ configure_uart(uint32_t baudrate) {
                                  .stop_bits = UART_STOP_BITS_1,
                                  .source_clk = UART_SCLK_REF_TICK,
                                  .flow_ctrl = UART_HW_FLOWCTRL_DISABLE};
+
+    /* Only rate changes when called again */
+    if (initialized) {
+        ESP_ERROR_CHECK(uart_set_baudrate(GSM_UART_NUM, baudrate));
+        return;
+    }
     ESP_ERROR_CHECK(uart_driver_install(GSM_UART_NUM, LWCELL_USART_DMA_RX_BUFF_SIZE * 2,
                                         LWCELL_USART_DMA_RX_BUFF_SIZE * 2, 20, &gsm_uart_queue, 0));
     ESP_ERROR_CHECK(uart_param_config(GSM_UART_NUM, &uart_config));
     ESP_ERROR_CHECK(uart_set_pin(GSM_UART_NUM, CONFIG_LWCELL_TX, CONFIG_LWCELL_RX, 0, 0));
+
+    /* Report end of line as event, to forward complete lines */
+    ESP_ERROR_CHECK(uart_enable_pattern_det_baud_intr(GSM_UART_NUM, '\n', 1, 9, 0, 0));
+    ESP_ERROR_CHECK(uart_pattern_queue_reset(GSM_UART_NUM, GSM_UART_PATTERN_QUEUE_SIZE));
 }
 
 /**
@@ -170,7 +226,9 @@ lwcell_ll_init(lwcell_ll_t* ll) {
 
     /* Step 3: Configure AT port to be able to send/receive data to/from GSM device */
     configure_uart(ll->uart.baudrate); /* Initialize UART for communication */
-    xTaskCreate(uart_event_task, "uart_lwcell_task0", 4096, NULL, 5, NULL);
+    if (!initialized) {
+        xTaskCreate(uart_event_task, "uart_lwcell_task0", 4096, NULL, 5, NULL);
+    }
     initialized = 1;
     return lwcellOK;
 }
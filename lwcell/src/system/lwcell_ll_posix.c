@@ -0,0 +1,277 @@
+/**
+ * \file            lwcell_ll_posix.c
+ * \brief           Low-level communication with GSM device for POSIX (termios)
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <termios.h>
+#include <unistd.h>
+#include "lwcell/lwcell_input.h"
+#include "lwcell/lwcell_mem.h"
+#include "lwcell/lwcell_types.h"
+#include "lwcell/lwcell_utils.h"
+#include "system/lwcell_ll.h"
+#include "system/lwcell_sys.h"
+
+#if !__DOXYGEN__
+
+/* Serial device connected to AT port of the modem */
+#ifndef LWCELL_LL_POSIX_DEVICE
+#define LWCELL_LL_POSIX_DEVICE "/dev/ttyUSB0"
+#endif
+
+/*
+ * Define to file path to record received data for replay.
+ * Every read is stored as 32-bit timestamp in milliseconds and 32-bit length,
+ * both in host byte order, followed by received bytes
+ */
+/* #define LWCELL_LL_POSIX_CAPTURE_FILE "lwcell_capture.bin" */
+
+static uint8_t initialized = 0;
+static lwcell_sys_thread_t thread_handle;
+static volatile int uart_fd = -1;   /*!< Serial port file descriptor */
+static uint8_t data_buffer[0x1000]; /*!< Received data array */
+
+static void uart_thread(void* param);
+
+/**
+ * \brief           Baudrate to termios speed mapping entry
+ */
+typedef struct {
+    uint32_t baudrate; /*!< Baudrate in units of bits per second */
+    speed_t speed;     /*!< Termios speed constant */
+} baudrate_map_t;
+
+static const baudrate_map_t baudrates[] = {
+    {9600, B9600},     {19200, B19200},   {38400, B38400},   {57600, B57600},
+    {115200, B115200}, {230400, B230400},
+#ifdef B460800
+    {460800, B460800},
+#endif
+#ifdef B921600
+    {921600, B921600},
+#endif
+};
+
+/**
+ * \brief           Send data to GSM device, function called from GSM stack when we have data to send
+ * \param[in]       data: Pointer to data to send
+ * \param[in]       len: Number of bytes to send
+ * \return          Number of bytes sent
+ */
+static size_t
+send_data(const void* data, size_t len) {
+    const uint8_t* d = data;
+    size_t written = 0;
+
+    if (uart_fd < 0) {
+        return 0;
+    }
+    while (written < len) {
+        ssize_t res = write(uart_fd, &d[written], len - written);
+        if (res < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        written += (size_t)res;
+    }
+    tcdrain(uart_fd);
+    return written;
+}
+
+/**
+ * \brief           Configure UART (USB to UART)
+ * \param[in]       baudrate: Baudrate to use on AT port
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+configure_uart(uint32_t baudrate) {
+    struct termios tty;
+    speed_t speed = B115200;
+
+    /* On first call, open serial device */
+    if (!initialized) {
+        uart_fd = open(LWCELL_LL_POSIX_DEVICE, O_RDWR | O_NOCTTY);
+        if (uart_fd < 0) {
+            printf("Cannot open serial port %s\r\n", LWCELL_LL_POSIX_DEVICE);
+            return 0;
+        }
+    }
+
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(baudrates); ++i) {
+        if (baudrates[i].baudrate == baudrate) {
+            speed = baudrates[i].speed;
+            break;
+        }
+    }
+
+    /* Configure port as raw 8N1 without flow control */
+    if (tcgetattr(uart_fd, &tty) != 0) {
+        printf("Cannot get serial port attributes\r\n");
+        return 0;
+    }
+    tty.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON | IXOFF | IXANY);
+    tty.c_oflag &= ~OPOST;
+    tty.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+    tty.c_cflag &= ~(CSIZE | PARENB | CSTOPB);
+#ifdef CRTSCTS
+    tty.c_cflag &= ~CRTSCTS;
+#endif
+    tty.c_cflag |= CS8 | CREAD | CLOCAL;
+
+    /* Block in read until at least one byte is available */
+    tty.c_cc[VMIN] = 1;
+    tty.c_cc[VTIME] = 0;
+    cfsetispeed(&tty, speed);
+    cfsetospeed(&tty, speed);
+    if (tcsetattr(uart_fd, TCSANOW, &tty) != 0) {
+        printf("Cannot set serial port attributes\r\n");
+        return 0;
+    }
+
+    /* On first function call, create a thread to read data from serial port */
+    if (!initialized) {
+        tcflush(uart_fd, TCIOFLUSH);
+        lwcell_sys_thread_create(&thread_handle, "lwcell_ll_thread", uart_thread, NULL, 0, 0);
+    }
+    return 1;
+}
+
+/**
+ * \brief            UART thread
+ */
+static void
+uart_thread(void* param) {
+    ssize_t bytes_read;
+#ifdef LWCELL_LL_POSIX_CAPTURE_FILE
+    FILE* capture = fopen(LWCELL_LL_POSIX_CAPTURE_FILE, "wb");
+#endif /* LWCELL_LL_POSIX_CAPTURE_FILE */
+
+    LWCELL_UNUSED(param);
+
+    while (1) {
+        /*
+         * Block until data are available on serial port
+         * and send them to upper layer for processing
+         */
+        bytes_read = read(uart_fd, data_buffer, sizeof(data_buffer));
+        if (bytes_read > 0) {
+#ifdef LWCELL_LL_POSIX_CAPTURE_FILE
+            if (capture != NULL) {
+                uint32_t hdr[2] = {lwcell_sys_now(), (uint32_t)bytes_read};
+
+                fwrite(hdr, sizeof(hdr), 1, capture);
+                fwrite(data_buffer, 1, (size_t)bytes_read, capture);
+                fflush(capture);
+            }
+#endif /* LWCELL_LL_POSIX_CAPTURE_FILE */
+#if LWCELL_CFG_INPUT_USE_PROCESS
+            lwcell_input_process(data_buffer, (size_t)bytes_read);
+#else  /* LWCELL_CFG_INPUT_USE_PROCESS */
+            lwcell_input(data_buffer, (size_t)bytes_read);
+#endif /* !LWCELL_CFG_INPUT_USE_PROCESS */
+        } else if (bytes_read < 0 && errno != EINTR && errno != EAGAIN) {
+            break;
+        }
+    }
+#ifdef LWCELL_LL_POSIX_CAPTURE_FILE
+    if (capture != NULL) {
+        fclose(capture);
+    }
+#endif /* LWCELL_LL_POSIX_CAPTURE_FILE */
+    lwcell_sys_thread_terminate(NULL);
+}
+
+/**
+ * \brief           Callback function called from initialization process
+ *
+ * \note            This function may be called multiple times if AT baudrate is changed from application.
+ *                  It is important that every configuration except AT baudrate is configured only once!
+ *
+ * \note            This function may be called from different threads in GSM stack when using OS.
+ *                  When \ref LWCELL_CFG_INPUT_USE_PROCESS is set to 1, this function may be called from user UART thread.
+ *
+ * \param[in,out]   ll: Pointer to \ref lwcell_ll_t structure to fill data for communication functions
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ll_init(lwcell_ll_t* ll) {
+#if !LWCELL_CFG_MEM_CUSTOM
+    /* Step 1: Configure memory for dynamic allocations */
+    static uint8_t memory[0x10000]; /* Create memory for dynamic allocations with specific size */
+
+    /*
+     * Create memory region(s) of memory.
+     * If device has internal/external memory available,
+     * multiple memories may be used
+     */
+    lwcell_mem_region_t mem_regions[] = {{memory, sizeof(memory)}};
+    if (!initialized) {
+        lwcell_mem_assignmemory(mem_regions,
+                                LWCELL_ARRAYSIZE(mem_regions)); /* Assign memory for allocations to GSM library */
+    }
+#endif /* !LWCELL_CFG_MEM_CUSTOM */
+
+    /* Step 2: Set AT port send function to use when we have data to transmit */
+    if (!initialized) {
+        ll->send_fn = send_data; /* Set callback function to send data */
+    }
+
+    /* Step 3: Configure AT port to be able to send/receive data to/from GSM device */
+    if (!configure_uart(ll->uart.baudrate)) { /* Initialize UART for communication */
+        return lwcellERR;
+    }
+    initialized = 1;
+    return lwcellOK;
+}
+
+/**
+ * \brief           Callback function to de-init low-level communication part
+ * \param[in,out]   ll: Pointer to \ref lwcell_ll_t structure to fill data for communication functions
+ * \return          \ref lwcellOK on success, member of \ref lwcellr_t enumeration otherwise
+ */
+lwcellr_t
+lwcell_ll_deinit(lwcell_ll_t* ll) {
+    LWCELL_UNUSED(ll);
+    if (initialized) {
+        lwcell_sys_thread_terminate(&thread_handle);
+        close(uart_fd);
+        uart_fd = -1;
+        initialized = 0;
+    }
+    return lwcellOK;
+}
+
+#endif /* !__DOXYGEN__ */
@@ -42,6 +42,24 @@
  * More about UART + RX DMA: https://github.com/MaJerle/stm32-usart-dma-rx-tx
  *
  * \ref LWCELL_CFG_INPUT_USE_PROCESS must be enabled in `lwcell_config.h` to use this driver.
+ *
+ * Alternatively, when \ref LWCELL_CFG_INPUT_FROM_ISR is enabled, received data are written
+ * to library input buffer directly from USART and DMA interrupt handlers with \ref lwcell_input_from_isr.
+ * Driver thread and its message queue are not created in this mode.
+ *
+ * Driver does not lend DMA memory to the stack, even when \ref LWCELL_CFG_INPUT_ZERO_COPY is enabled.
+ * RX DMA operates in circular mode and cannot be held back while application still references
+ * received data, hence data are always copied with \ref lwcell_input_process.
+ *
+ * When `LWCELL_USART_DMA_TX_STREAM` or `LWCELL_USART_DMA_TX_CH` is defined, transmit is done with DMA.
+ * Data are copied to one of `2` TX buffers, while DMA may still transmit the other one.
+ * Transfer is started on flush request (`send_fn(NULL, 0)`) or when buffer is full,
+ * and calling thread only waits when both buffers are in use.
+ *
+ * On Cortex-M7 devices with data cache, `LWCELL_USART_DCACHE` is enabled by default.
+ * DMA buffers are then aligned to cache lines and their sizes must be multiple of cache line.
+ * Cache is invalidated exactly for region, passed to the stack, and cleaned for TX data before DMA transfer.
+ * Data cache may stay enabled globally, buffers do not need non-cacheable memory region.
  */
 #include "lwcell/lwcell_input.h"
 #include "lwcell/lwcell_mem.h"
@@ -52,9 +70,9 @@
 
 #if !__DOXYGEN__
 
-#if !LWCELL_CFG_INPUT_USE_PROCESS
-#error "LWCELL_CFG_INPUT_USE_PROCESS must be enabled in `lwcell_config.h` to use this driver."
-#endif /* LWCELL_CFG_INPUT_USE_PROCESS */
+#if !LWCELL_CFG_INPUT_USE_PROCESS && !LWCELL_CFG_INPUT_FROM_ISR
+#error "LWCELL_CFG_INPUT_USE_PROCESS or LWCELL_CFG_INPUT_FROM_ISR must be enabled in `lwcell_config.h` to use this driver."
+#endif /* !LWCELL_CFG_INPUT_USE_PROCESS && !LWCELL_CFG_INPUT_FROM_ISR */
 
 #if !defined(LWCELL_USART_DMA_RX_BUFF_SIZE)
 #define LWCELL_USART_DMA_RX_BUFF_SIZE 0x1000
@@ -68,55 +86,166 @@
 #define LWCELL_USART_RDR_NAME RDR
 #endif /* !defined(LWCELL_USART_RDR_NAME) */
 
-/* USART memory */
-static uint8_t usart_mem[LWCELL_USART_DMA_RX_BUFF_SIZE];
+#if defined(LWCELL_USART_DMA_TX_STREAM) || defined(LWCELL_USART_DMA_TX_CH)
+#define LWCELL_USART_USE_DMA_TX 1
+#else
+#define LWCELL_USART_USE_DMA_TX 0
+#endif /* defined(LWCELL_USART_DMA_TX_STREAM) || defined(LWCELL_USART_DMA_TX_CH) */
+
+#if !defined(LWCELL_USART_DMA_TX_BUFF_SIZE)
+#define LWCELL_USART_DMA_TX_BUFF_SIZE 0x200
+#endif /* !defined(LWCELL_USART_DMA_TX_BUFF_SIZE) */
+
+#if !defined(LWCELL_USART_TDR_NAME)
+#define LWCELL_USART_TDR_NAME TDR
+#endif /* !defined(LWCELL_USART_TDR_NAME) */
+
+#if !defined(LWCELL_USART_DCACHE)
+#if defined(__DCACHE_PRESENT) && __DCACHE_PRESENT
+#define LWCELL_USART_DCACHE 1
+#else
+#define LWCELL_USART_DCACHE 0
+#endif /* defined(__DCACHE_PRESENT) && __DCACHE_PRESENT */
+#endif /* !defined(LWCELL_USART_DCACHE) */
+
+#if LWCELL_USART_DCACHE
+#if defined(__SCB_DCACHE_LINE_SIZE)
+#define USART_DCACHE_LINE __SCB_DCACHE_LINE_SIZE
+#else
+#define USART_DCACHE_LINE 32
+#endif /* defined(__SCB_DCACHE_LINE_SIZE) */
+#if (LWCELL_USART_DMA_RX_BUFF_SIZE % USART_DCACHE_LINE) || (LWCELL_USART_DMA_TX_BUFF_SIZE % USART_DCACHE_LINE)
+#error "LWCELL_USART_DMA_RX_BUFF_SIZE and LWCELL_USART_DMA_TX_BUFF_SIZE must be multiple of cache line size!"
+#endif
+#define USART_DMA_MEM __ALIGNED(USART_DCACHE_LINE)
+#else
+#define USART_DMA_MEM
+#endif /* LWCELL_USART_DCACHE */
+
+/* USART memory, DMA buffers do not share cache lines with other variables */
+static USART_DMA_MEM uint8_t usart_mem[LWCELL_USART_DMA_RX_BUFF_SIZE];
 static uint8_t is_running, initialized;
 static size_t old_pos;
 
+#if !LWCELL_CFG_INPUT_FROM_ISR
 /* USART thread */
 static void usart_ll_thread(void* arg);
 static osThreadId_t usart_ll_thread_id;
 
 /* Message queue */
 static osMessageQueueId_t usart_ll_mbox_id;
+#endif /* !LWCELL_CFG_INPUT_FROM_ISR */
+
+#if LWCELL_USART_USE_DMA_TX
+/* Double TX buffer, one is filled while other one can be transmitted by DMA */
+static USART_DMA_MEM uint8_t usart_tx_mem[2][LWCELL_USART_DMA_TX_BUFF_SIZE];
+static size_t usart_tx_len;             /* Number of bytes in currently filled buffer */
+static uint8_t usart_tx_idx;            /* Index of currently filled buffer */
+static osSemaphoreId_t usart_tx_sem_id; /* Semaphore, available when DMA is not transmitting */
+#endif                                  /* LWCELL_USART_USE_DMA_TX */
+
+#if LWCELL_USART_DCACHE
 
 /**
- * \brief           USART data processing
+ * \brief           Invalidate data cache lines, covering memory region
+ *
+ * Data written by DMA become visible to CPU. Only lines of region are touched,
+ * DMA buffers are aligned to cache lines and do not share them with other variables
+ * \param[in]       mem: Start of memory region
+ * \param[in]       len: Length of memory region in units of bytes
  */
 static void
-usart_ll_thread(void* arg) {
-    size_t pos;
+usart_dcache_invalidate(const void* mem, size_t len) {
+    uint32_t start = (uint32_t)mem & ~(uint32_t)(USART_DCACHE_LINE - 1);
+    uint32_t end = ((uint32_t)mem + len + USART_DCACHE_LINE - 1) & ~(uint32_t)(USART_DCACHE_LINE - 1);
 
-    LWCELL_UNUSED(arg);
+    if (SCB->CCR & SCB_CCR_DC_Msk) {
+        SCB_InvalidateDCache_by_Addr((void*)start, (int32_t)(end - start));
+    }
+}
 
-    while (1) {
-        void* d;
-        /* Wait for the event message from DMA or USART */
-        osMessageQueueGet(usart_ll_mbox_id, &d, NULL, osWaitForever);
+/**
+ * \brief           Clean data cache lines, covering memory region
+ *
+ * Data written by CPU become visible to DMA
+ * \param[in]       mem: Start of memory region
+ * \param[in]       len: Length of memory region in units of bytes
+ */
+static void
+usart_dcache_clean(const void* mem, size_t len) {
+    uint32_t start = (uint32_t)mem & ~(uint32_t)(USART_DCACHE_LINE - 1);
+    uint32_t end = ((uint32_t)mem + len + USART_DCACHE_LINE - 1) & ~(uint32_t)(USART_DCACHE_LINE - 1);
+
+    if (SCB->CCR & SCB_CCR_DC_Msk) {
+        SCB_CleanDCache_by_Addr((void*)start, (int32_t)(end - start));
+    }
+}
+
+#else /* LWCELL_USART_DCACHE */
+#define usart_dcache_invalidate(mem, len)
+#define usart_dcache_clean(mem, len)
+#endif /* !LWCELL_USART_DCACHE */
+
+#if LWCELL_CFG_INPUT_FROM_ISR
+#define USART_INPUT(d, l) lwcell_input_from_isr((d), (l))
+#else /* LWCELL_CFG_INPUT_FROM_ISR */
+#define USART_INPUT(d, l) lwcell_input_process((d), (l))
+#endif /* !LWCELL_CFG_INPUT_FROM_ISR */
+
+/* Make region visible to CPU and pass it to the stack */
+#define USART_INPUT_PROCESS(d, l)                                                                                      \
+    do {                                                                                                               \
+        usart_dcache_invalidate((d), (l));                                                                             \
+        USART_INPUT((d), (l));                                                                                         \
+    } while (0)
+
+/**
+ * \brief           Check DMA position and pass newly received data to the stack
+ */
+static void
+usart_rx_check(void) {
+    size_t pos;
 
-        /* Read data */
 #if defined(LWCELL_USART_DMA_RX_STREAM)
-        pos = sizeof(usart_mem) - LL_DMA_GetDataLength(LWCELL_USART_DMA, LWCELL_USART_DMA_RX_STREAM);
+    pos = sizeof(usart_mem) - LL_DMA_GetDataLength(LWCELL_USART_DMA, LWCELL_USART_DMA_RX_STREAM);
 #else
-        pos = sizeof(usart_mem) - LL_DMA_GetDataLength(LWCELL_USART_DMA, LWCELL_USART_DMA_RX_CH);
+    pos = sizeof(usart_mem) - LL_DMA_GetDataLength(LWCELL_USART_DMA, LWCELL_USART_DMA_RX_CH);
 #endif /* defined(LWCELL_USART_DMA_RX_STREAM) */
-        if (pos != old_pos && is_running) {
-            if (pos > old_pos) {
-                lwcell_input_process(&usart_mem[old_pos], pos - old_pos);
-            } else {
-                lwcell_input_process(&usart_mem[old_pos], sizeof(usart_mem) - old_pos);
-                if (pos > 0) {
-                    lwcell_input_process(&usart_mem[0], pos);
-                }
-            }
-            old_pos = pos;
-            if (old_pos == sizeof(usart_mem)) {
-                old_pos = 0;
+    if (pos != old_pos && is_running) {
+        if (pos > old_pos) {
+            USART_INPUT_PROCESS(&usart_mem[old_pos], pos - old_pos);
+        } else {
+            USART_INPUT_PROCESS(&usart_mem[old_pos], sizeof(usart_mem) - old_pos);
+            if (pos > 0) {
+                USART_INPUT_PROCESS(&usart_mem[0], pos);
             }
         }
+        old_pos = pos;
+        if (old_pos == sizeof(usart_mem)) {
+            old_pos = 0;
+        }
     }
 }
 
+#if !LWCELL_CFG_INPUT_FROM_ISR
+
+/**
+ * \brief           USART data processing
+ */
+static void
+usart_ll_thread(void* arg) {
+    LWCELL_UNUSED(arg);
+
+    while (1) {
+        void* d;
+        /* Wait for the event message from DMA or USART */
+        osMessageQueueGet(usart_ll_mbox_id, &d, NULL, osWaitForever);
+        usart_rx_check(); /* Read data */
+    }
+}
+
+#endif /* !LWCELL_CFG_INPUT_FROM_ISR */
+
 /**
  * \brief           Configure UART using DMA for receive in double buffer mode and IDLE line detection
  */
@@ -227,6 +356,38 @@ configure_uart(uint32_t baudrate) {
         NVIC_SetPriority(LWCELL_USART_DMA_RX_IRQ, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 0x07, 0x00));
         NVIC_EnableIRQ(LWCELL_USART_DMA_RX_IRQ);
 
+#if LWCELL_USART_USE_DMA_TX
+        /* Configure TX DMA, memory address and length are set for each transfer */
+#if defined(LWCELL_USART_DMA_TX_STREAM)
+        LL_DMA_DeInit(LWCELL_USART_DMA, LWCELL_USART_DMA_TX_STREAM);
+        dma_init.Channel = LWCELL_USART_DMA_TX_CH;
+#else
+        LL_DMA_DeInit(LWCELL_USART_DMA, LWCELL_USART_DMA_TX_CH);
+        dma_init.PeriphRequest = LWCELL_USART_DMA_TX_REQ_NUM;
+#endif /* defined(LWCELL_USART_DMA_TX_STREAM) */
+        dma_init.PeriphOrM2MSrcAddress = (uint32_t)&LWCELL_USART->LWCELL_USART_TDR_NAME;
+        dma_init.MemoryOrM2MDstAddress = (uint32_t)usart_tx_mem[0];
+        dma_init.Direction = LL_DMA_DIRECTION_MEMORY_TO_PERIPH;
+        dma_init.Mode = LL_DMA_MODE_NORMAL;
+        dma_init.NbData = 0;
+#if defined(LWCELL_USART_DMA_TX_STREAM)
+        LL_DMA_Init(LWCELL_USART_DMA, LWCELL_USART_DMA_TX_STREAM, &dma_init);
+        LL_DMA_EnableIT_TC(LWCELL_USART_DMA, LWCELL_USART_DMA_TX_STREAM);
+#else
+        LL_DMA_Init(LWCELL_USART_DMA, LWCELL_USART_DMA_TX_CH, &dma_init);
+        LL_DMA_EnableIT_TC(LWCELL_USART_DMA, LWCELL_USART_DMA_TX_CH);
+#endif /* defined(LWCELL_USART_DMA_TX_STREAM) */
+        NVIC_SetPriority(LWCELL_USART_DMA_TX_IRQ, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 0x07, 0x00));
+        NVIC_EnableIRQ(LWCELL_USART_DMA_TX_IRQ);
+        LL_USART_EnableDMAReq_TX(LWCELL_USART);
+
+        if (usart_tx_sem_id == NULL) {
+            usart_tx_sem_id = osSemaphoreNew(1, 1, NULL);
+        }
+        usart_tx_len = 0;
+        usart_tx_idx = 0;
+#endif /* LWCELL_USART_USE_DMA_TX */
+
         old_pos = 0;
         is_running = 1;
 
@@ -238,6 +399,11 @@ configure_uart(uint32_t baudrate) {
 #endif /* defined(LWCELL_USART_DMA_RX_STREAM) */
         LL_USART_Enable(LWCELL_USART);
     } else {
+#if LWCELL_USART_USE_DMA_TX
+        /* Wait for on-going transfer to finish before baudrate is changed */
+        osSemaphoreAcquire(usart_tx_sem_id, osWaitForever);
+        osSemaphoreRelease(usart_tx_sem_id);
+#endif /* LWCELL_USART_USE_DMA_TX */
         osDelay(10);
         LL_USART_Disable(LWCELL_USART);
         usart_init.BaudRate = baudrate;
@@ -245,6 +411,7 @@ configure_uart(uint32_t baudrate) {
         LL_USART_Enable(LWCELL_USART);
     }
 
+#if !LWCELL_CFG_INPUT_FROM_ISR
     /* Create mbox and start thread */
     if (usart_ll_mbox_id == NULL) {
         usart_ll_mbox_id = osMessageQueueNew(10, sizeof(void*), NULL);
@@ -253,6 +420,7 @@ configure_uart(uint32_t baudrate) {
         const osThreadAttr_t attr = {.stack_size = 1024};
         usart_ll_thread_id = osThreadNew(usart_ll_thread, usart_ll_mbox_id, &attr);
     }
+#endif /* !LWCELL_CFG_INPUT_FROM_ISR */
 }
 
 #if defined(LWCELL_RESET_PIN)
@@ -270,6 +438,41 @@ reset_device(uint8_t state) {
 }
 #endif /* defined(LWCELL_RESET_PIN) */
 
+#if LWCELL_USART_USE_DMA_TX
+
+/**
+ * \brief           Start DMA transfer of currently filled TX buffer and switch to other buffer
+ *
+ * Function waits only if DMA is still busy transmitting previous buffer
+ */
+static void
+usart_tx_start(void) {
+    if (usart_tx_len == 0) {
+        return;
+    }
+
+    /* Wait for previous transfer to complete, semaphore is released from DMA interrupt */
+    osSemaphoreAcquire(usart_tx_sem_id, osWaitForever);
+    usart_dcache_clean(usart_tx_mem[usart_tx_idx], usart_tx_len);
+    LWCELL_USART_DMA_TX_CLEAR_TC;
+#if defined(LWCELL_USART_DMA_TX_STREAM)
+    LL_DMA_SetMemoryAddress(LWCELL_USART_DMA, LWCELL_USART_DMA_TX_STREAM, (uint32_t)usart_tx_mem[usart_tx_idx]);
+    LL_DMA_SetDataLength(LWCELL_USART_DMA, LWCELL_USART_DMA_TX_STREAM, usart_tx_len);
+    LL_DMA_EnableStream(LWCELL_USART_DMA, LWCELL_USART_DMA_TX_STREAM);
+#else
+    LL_DMA_DisableChannel(LWCELL_USART_DMA, LWCELL_USART_DMA_TX_CH);
+    LL_DMA_SetMemoryAddress(LWCELL_USART_DMA, LWCELL_USART_DMA_TX_CH, (uint32_t)usart_tx_mem[usart_tx_idx]);
+    LL_DMA_SetDataLength(LWCELL_USART_DMA, LWCELL_USART_DMA_TX_CH, usart_tx_len);
+    LL_DMA_EnableChannel(LWCELL_USART_DMA, LWCELL_USART_DMA_TX_CH);
+#endif /* defined(LWCELL_USART_DMA_TX_STREAM) */
+
+    /* Continue filling other buffer */
+    usart_tx_idx ^= 1;
+    usart_tx_len = 0;
+}
+
+#endif /* LWCELL_USART_USE_DMA_TX */
+
 /**
  * \brief           Send data to GSM device
  * \param[in]       data: Pointer to data to send
@@ -280,10 +483,25 @@ static size_t
 send_data(const void* data, size_t len) {
     const uint8_t* d = data;
 
+#if LWCELL_USART_USE_DMA_TX
+    if (d == NULL) { /* Flush request, start transmission */
+        usart_tx_start();
+        return 0;
+    }
+    for (size_t rem = len, to_copy; rem > 0; rem -= to_copy, d += to_copy) {
+        to_copy = LWCELL_MIN(rem, sizeof(usart_tx_mem[0]) - usart_tx_len);
+        LWCELL_MEMCPY(&usart_tx_mem[usart_tx_idx][usart_tx_len], d, to_copy);
+        usart_tx_len += to_copy;
+        if (usart_tx_len == sizeof(usart_tx_mem[0])) {
+            usart_tx_start(); /* Buffer is full, send it */
+        }
+    }
+#else  /* LWCELL_USART_USE_DMA_TX */
     for (size_t i = 0; i < len; ++i, ++d) {
         LL_USART_TransmitData8(LWCELL_USART, *d);
         while (!LL_USART_IsActiveFlag_TXE(LWCELL_USART)) {}
     }
+#endif /* !LWCELL_USART_USE_DMA_TX */
     return len;
 }
 
@@ -324,6 +542,9 @@ lwcell_ll_init(lwcell_ll_t* ll) {
  */
 lwcellr_t
 lwcell_ll_deinit(lwcell_ll_t* ll) {
+#if LWCELL_CFG_INPUT_FROM_ISR
+    is_running = 0; /* Interrupt handlers stop passing data to the stack */
+#else  /* LWCELL_CFG_INPUT_FROM_ISR */
     if (usart_ll_mbox_id != NULL) {
         osMessageQueueId_t tmp = usart_ll_mbox_id;
         usart_ll_mbox_id = NULL;
@@ -334,6 +555,15 @@ lwcell_ll_deinit(lwcell_ll_t* ll) {
         usart_ll_thread_id = NULL;
         osThreadTerminate(tmp);
     }
+#endif /* !LWCELL_CFG_INPUT_FROM_ISR */
+#if LWCELL_USART_USE_DMA_TX
+    if (usart_tx_sem_id != NULL) {
+        osSemaphoreId_t tmp = usart_tx_sem_id;
+        osSemaphoreAcquire(tmp, osWaitForever); /* Wait for transfer to finish */
+        usart_tx_sem_id = NULL;
+        osSemaphoreDelete(tmp);
+    }
+#endif /* LWCELL_USART_USE_DMA_TX */
     initialized = 0;
     LWCELL_UNUSED(ll);
     return lwcellOK;
@@ -350,10 +580,14 @@ LWCELL_USART_IRQHANDLER(void) {
     LL_USART_ClearFlag_ORE(LWCELL_USART);
     LL_USART_ClearFlag_NE(LWCELL_USART);
 
+#if LWCELL_CFG_INPUT_FROM_ISR
+    usart_rx_check(); /* Write data to stack input buffer directly */
+#else  /* LWCELL_CFG_INPUT_FROM_ISR */
     if (usart_ll_mbox_id != NULL) {
         void* d = (void*)1;
         osMessageQueuePut(usart_ll_mbox_id, &d, 0, 0);
     }
+#endif /* !LWCELL_CFG_INPUT_FROM_ISR */
 }
 
 /**
@@ -364,10 +598,29 @@ LWCELL_USART_DMA_RX_IRQHANDLER(void) {
     LWCELL_USART_DMA_RX_CLEAR_TC;
     LWCELL_USART_DMA_RX_CLEAR_HT;
 
+#if LWCELL_CFG_INPUT_FROM_ISR
+    usart_rx_check(); /* Write data to stack input buffer directly */
+#else  /* LWCELL_CFG_INPUT_FROM_ISR */
     if (usart_ll_mbox_id != NULL) {
         void* d = (void*)1;
         osMessageQueuePut(usart_ll_mbox_id, &d, 0, 0);
     }
+#endif /* !LWCELL_CFG_INPUT_FROM_ISR */
+}
+
+#if LWCELL_USART_USE_DMA_TX
+
+/**
+ * \brief           UART TX DMA stream/channel handler
+ */
+void
+LWCELL_USART_DMA_TX_IRQHANDLER(void) {
+    if (LWCELL_USART_DMA_TX_IS_TC) {
+        LWCELL_USART_DMA_TX_CLEAR_TC;
+        osSemaphoreRelease(usart_tx_sem_id); /* Transfer completed, buffer is free again */
+    }
 }
 
+#endif /* LWCELL_USART_USE_DMA_TX */
+
 #endif /* !__DOXYGEN__ */
@@ -43,6 +43,8 @@
  * USART_DMA:           DMA2
  * USART_DMA_STREAM:    DMA_STREAM_1
  * USART_DMA_CHANNEL:   DMA_CHANNEL_5
+ * USART_DMA_TX_STREAM: DMA_STREAM_6
+ * USART_DMA_TX_CHANNEL:DMA_CHANNEL_5
  */
 #include "lwcell/lwcell_input.h"
 #include "lwcell/lwcell_mem.h"
@@ -63,6 +65,7 @@
 #define LWCELL_USART_IRQ               USART6_IRQn
 #define LWCELL_USART_IRQHANDLER        USART6_IRQHandler
 #define LWCELL_USART_RDR_NAME          DR
+#define LWCELL_USART_TDR_NAME          DR
 
 /* DMA settings */
 #define LWCELL_USART_DMA               DMA2
@@ -78,6 +81,14 @@
 #define LWCELL_USART_DMA_RX_CLEAR_TC   LL_DMA_ClearFlag_TC1(LWCELL_USART_DMA)
 #define LWCELL_USART_DMA_RX_CLEAR_HT   LL_DMA_ClearFlag_HT1(LWCELL_USART_DMA)
 
+/* TX DMA settings */
+#define LWCELL_USART_DMA_TX_STREAM     LL_DMA_STREAM_6
+#define LWCELL_USART_DMA_TX_CH         LL_DMA_CHANNEL_5
+#define LWCELL_USART_DMA_TX_IRQ        DMA2_Stream6_IRQn
+#define LWCELL_USART_DMA_TX_IRQHANDLER DMA2_Stream6_IRQHandler
+#define LWCELL_USART_DMA_TX_IS_TC      LL_DMA_IsActiveFlag_TC6(LWCELL_USART_DMA)
+#define LWCELL_USART_DMA_TX_CLEAR_TC   LL_DMA_ClearFlag_TC6(LWCELL_USART_DMA)
+
 /* USART TX PIN */
 #define LWCELL_USART_TX_PORT_CLK       LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_GPIOC)
 #define LWCELL_USART_TX_PORT           GPIOC
@@ -57,9 +57,9 @@
 #if !LWCELL_CFG_INPUT_USE_PROCESS
 #error "LWCELL_CFG_INPUT_USE_PROCESS must be enabled in `lwcell_opts.h` to use this driver."
 #endif /* LWCELL_CFG_INPUT_USE_PROCESS */
-#if !LWCELL_CFG_MEM_CUSTOM
-#error "LWCELL_CFG_MEM_CUSTOM must be used instead. This driver does not set memory regions for LwESP."
-#endif /* !LWCELL_CFG_MEM_CUSTOM */
+#if !LWCELL_CFG_MEM_CUSTOM && !LWCELL_CFG_MEM_CLASSES
+#error "LWCELL_CFG_MEM_CUSTOM or LWCELL_CFG_MEM_CLASSES must be used. Packet buffers must not be in DTCM."
+#endif /* !LWCELL_CFG_MEM_CUSTOM && !LWCELL_CFG_MEM_CLASSES */
 
 /*
  * USART setup
@@ -107,8 +107,21 @@
 #define LWCELL_USART_RX_PORT_CLK_EN     LL_AHB1_GRP1_EnableClock(LL_AHB4_GRP1_PERIPH_GPIOF)
 #define LWCELL_USART_RX_PIN_AF          LL_GPIO_AF_7
 
+/*
+ * DMA buffers are 32-bytes aligned and their sizes are multiple of cache line,
+ * they do not share cache lines with other variables. Data cache may stay enabled,
+ * driver invalidates and cleans only lines of regions, used by DMA.
+ */
+#define LWCELL_DCACHE_LINE              32
+#define LWCELL_USART_DMA_TX_BUFF_SIZE   2048
+#define LWCELL_USART_DMA_RX_BUFF_SIZE   256
+
+#if (LWCELL_USART_DMA_RX_BUFF_SIZE % LWCELL_DCACHE_LINE) || (LWCELL_USART_DMA_TX_BUFF_SIZE % LWCELL_DCACHE_LINE)
+#error "DMA buffer sizes must be multiple of cache line size!"
+#endif
+
 /* TX data buffers, must be 32-bytes aligned (cache) and in dma buffer section to make sure DMA has access to the memory region */
-ALIGN_32BYTES(static uint8_t __attribute__((section(".dma_buffer"))) lwcell_tx_rb_data[2048]);
+ALIGN_32BYTES(static uint8_t __attribute__((section(".dma_buffer"))) lwcell_tx_rb_data[LWCELL_USART_DMA_TX_BUFF_SIZE]);
 static lwrb_t lwcell_tx_rb;
 volatile size_t lwcell_tx_len;
 
@@ -121,7 +134,29 @@ volatile size_t lwcell_tx_len;
 #define LWCELL_LL_MAX_TX_LEN 64
 
 /* Raw DMA memory for UART received data */
-ALIGN_32BYTES(static uint8_t __attribute__((section(".dma_buffer"))) lwcell_usart_rx_dma_buffer[256]);
+ALIGN_32BYTES(static uint8_t
+                  __attribute__((section(".dma_buffer"))) lwcell_usart_rx_dma_buffer[LWCELL_USART_DMA_RX_BUFF_SIZE]);
+
+#if !LWCELL_CFG_MEM_CUSTOM
+/*
+ * Memory regions for built-in allocator
+ *
+ * DTCM is fastest for CPU, but DMA cannot reach it. It keeps messages and parser data.
+ * Packet buffers and bulk data go to DMA buffer section, set in linker script.
+ */
+#if !defined(LWCELL_MEM_FAST_SIZE)
+#define LWCELL_MEM_FAST_SIZE 0x2000
+#endif /* !defined(LWCELL_MEM_FAST_SIZE) */
+#if !defined(LWCELL_MEM_FAST_SECTION)
+#define LWCELL_MEM_FAST_SECTION ".dtcm_data"
+#endif /* !defined(LWCELL_MEM_FAST_SECTION) */
+#if !defined(LWCELL_MEM_DMA_SIZE)
+#define LWCELL_MEM_DMA_SIZE 0x4000
+#endif /* !defined(LWCELL_MEM_DMA_SIZE) */
+
+ALIGN_32BYTES(static uint8_t __attribute__((section(LWCELL_MEM_FAST_SECTION))) lwcell_mem_fast[LWCELL_MEM_FAST_SIZE]);
+ALIGN_32BYTES(static uint8_t __attribute__((section(".dma_buffer"))) lwcell_mem_dma[LWCELL_MEM_DMA_SIZE]);
+#endif /* !LWCELL_CFG_MEM_CUSTOM */
 
 /* USART thread for read and data processing */
 static void prv_lwcell_read_thread_entry(ULONG arg);
@@ -137,6 +172,50 @@ static TX_EVENT_FLAGS_GROUP lwcell_ll_event_group;
 static uint8_t lwcell_is_running = 0;
 static uint8_t lwcell_initialized = 0;
 
+/**
+ * \brief           Invalidate data cache lines, covering memory region
+ *
+ * Called just before region is passed to the stack, so CPU reads data written by DMA.
+ * Lines outside region may still be written by DMA and stay untouched
+ * \param[in]       mem: Start of memory region
+ * \param[in]       len: Length of memory region in units of bytes
+ */
+static void
+prv_dcache_invalidate(const void* mem, size_t len) {
+    uint32_t start = (uint32_t)mem & ~(uint32_t)(LWCELL_DCACHE_LINE - 1);
+    uint32_t end = ((uint32_t)mem + len + LWCELL_DCACHE_LINE - 1) & ~(uint32_t)(LWCELL_DCACHE_LINE - 1);
+
+    if (SCB->CCR & SCB_CCR_DC_Msk) {
+        SCB_InvalidateDCache_by_Addr((void*)start, (int32_t)(end - start));
+    }
+}
+
+/**
+ * \brief           Clean data cache lines, covering memory region
+ * \param[in]       mem: Start of memory region
+ * \param[in]       len: Length of memory region in units of bytes
+ */
+static void
+prv_dcache_clean(const void* mem, size_t len) {
+    uint32_t start = (uint32_t)mem & ~(uint32_t)(LWCELL_DCACHE_LINE - 1);
+    uint32_t end = ((uint32_t)mem + len + LWCELL_DCACHE_LINE - 1) & ~(uint32_t)(LWCELL_DCACHE_LINE - 1);
+
+    if (SCB->CCR & SCB_CCR_DC_Msk) {
+        SCB_CleanDCache_by_Addr((void*)start, (int32_t)(end - start));
+    }
+}
+
+/**
+ * \brief           Pass received region to the stack
+ * \param[in]       mem: Start of memory region
+ * \param[in]       len: Length of memory region in units of bytes
+ */
+static void
+prv_input_process(const void* mem, size_t len) {
+    prv_dcache_invalidate(mem, len);
+    lwcell_input_process(mem, len);
+}
+
 /**
  * \brief           USART data processing thread
  * This is the thread used to enter received data from UART to the LwESP stack for further processing
@@ -157,14 +236,13 @@ prv_lwcell_read_thread_entry(ULONG arg) {
         /* Read data */
         pos = sizeof(lwcell_usart_rx_dma_buffer) - LL_DMA_GetDataLength(LWCELL_USART_DMA_RX, LWCELL_USART_DMA_RX_STREAM);
         if (pos != lwcell_read_old_pos && lwcell_is_running) {
-            SCB_InvalidateDCache_by_Addr(lwcell_usart_rx_dma_buffer, sizeof(lwcell_usart_rx_dma_buffer));
             if (pos > lwcell_read_old_pos) {
-                lwcell_input_process(&lwcell_usart_rx_dma_buffer[lwcell_read_old_pos], pos - lwcell_read_old_pos);
+                prv_input_process(&lwcell_usart_rx_dma_buffer[lwcell_read_old_pos], pos - lwcell_read_old_pos);
             } else {
-                lwcell_input_process(&lwcell_usart_rx_dma_buffer[lwcell_read_old_pos],
-                                    sizeof(lwcell_usart_rx_dma_buffer) - lwcell_read_old_pos);
+                prv_input_process(&lwcell_usart_rx_dma_buffer[lwcell_read_old_pos],
+                                  sizeof(lwcell_usart_rx_dma_buffer) - lwcell_read_old_pos);
                 if (pos > 0) {
-                    lwcell_input_process(&lwcell_usart_rx_dma_buffer[0], pos);
+                    prv_input_process(&lwcell_usart_rx_dma_buffer[0], pos);
                 }
             }
             lwcell_read_old_pos = pos;
@@ -186,7 +264,7 @@ prv_start_tx_transfer(void) {
         lwcell_tx_len = LWCELL_MIN(lwcell_tx_len, LWCELL_LL_MAX_TX_LEN);
 
         /* Cleanup cache to make sure we have latest data in memory visible by DMA */
-        SCB_CleanDCache_by_Addr((void*)d, lwcell_tx_len);
+        prv_dcache_clean(d, lwcell_tx_len);
 
         /* Clear all DMA flags prior transfer */
         LWCELL_USART_DMA_TX_CLEAR_TC;
@@ -414,6 +492,19 @@ prv_send_data(const void* data, size_t len) {
  */
 lwcellr_t
 lwcell_ll_init(lwcell_ll_t* ll) {
+#if !LWCELL_CFG_MEM_CUSTOM
+    /* DTCM is placed below AXI and D2 SRAM, regions are in ascending order */
+    lwcell_mem_region_t mem_regions[] = {
+        {lwcell_mem_fast, sizeof(lwcell_mem_fast), LWCELL_MEM_CLASS_BIT(LWCELL_MEM_CLASS_FAST)},
+        {lwcell_mem_dma, sizeof(lwcell_mem_dma),
+         LWCELL_MEM_CLASS_BIT(LWCELL_MEM_CLASS_DMA) | LWCELL_MEM_CLASS_BIT(LWCELL_MEM_CLASS_BULK)},
+    };
+
+    if (!lwcell_initialized) {
+        lwcell_mem_assignmemory(mem_regions, LWCELL_ARRAYSIZE(mem_regions)); /* Assign memory for allocations */
+    }
+#endif /* !LWCELL_CFG_MEM_CUSTOM */
+
     if (!lwcell_initialized) {
         ll->send_fn = prv_send_data; /* Set callback function to send data */
 #if defined(LWCELL_RST_PIN)
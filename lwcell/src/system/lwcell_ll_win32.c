@@ -31,6 +31,7 @@
  * Author:          Tilen MAJERLE <tilen@majerle.eu>
  * Version:         v0.1.1
  */
+#include "lwcell/lwcell_buff.h"
 #include "lwcell/lwcell_input.h"
 #include "lwcell/lwcell_mem.h"
 #include "lwcell/lwcell_types.h"
@@ -41,13 +42,126 @@
 
 #if !__DOXYGEN__
 
+/*
+ * Define to file path to record received data for replay.
+ * Every read is stored as 32-bit timestamp in milliseconds and 32-bit length,
+ * both in host byte order, followed by received bytes
+ */
+/* #define LWCELL_LL_WIN32_CAPTURE_FILE "lwcell_capture.bin" */
+
+/*
+ * Set to `1` to mirror AT traffic to console and received data to log file.
+ * Mirroring is done in separate thread from log ring buffer,
+ * records are dropped when ring is full, receive path is never blocked by console
+ */
+#ifndef LWCELL_LL_WIN32_CONSOLE_LOG
+#define LWCELL_LL_WIN32_CONSOLE_LOG 1
+#endif
+
+/* Size of console log ring buffer in units of bytes */
+#ifndef LWCELL_LL_WIN32_LOG_RING_SIZE
+#define LWCELL_LL_WIN32_LOG_RING_SIZE 0x4000
+#endif
+
+/* Log record direction */
+#define LOG_DIR_TX 0x00
+#define LOG_DIR_RX 0x01
+
 static uint8_t initialized = 0;
 static HANDLE thread_handle;
 static volatile HANDLE com_port;    /*!< COM port handle */
 static uint8_t data_buffer[0x1000]; /*!< Received data array */
+static OVERLAPPED write_ov;         /*!< Overlapped structure for write operation */
 
 static void uart_thread(void* param);
 
+#if LWCELL_LL_WIN32_CONSOLE_LOG
+
+static HANDLE log_thread_handle;
+static HANDLE log_event;          /*!< Event signaled when new record is written to ring */
+static CRITICAL_SECTION log_lock; /*!< Ring buffer access lock */
+static lwcell_buff_t log_buff;    /*!< Log ring buffer */
+static volatile size_t log_dropped;
+
+/**
+ * \brief           Write traffic record to log ring buffer
+ * \param[in]       dir: Record direction, \ref LOG_DIR_TX or \ref LOG_DIR_RX
+ * \param[in]       data: Record data
+ * \param[in]       len: Length of data
+ */
+static void
+log_write(uint8_t dir, const void* data, size_t len) {
+    uint8_t hdr[3];
+
+    if (len == 0 || log_buff.buff == NULL) {
+        return;
+    }
+    len = LWCELL_MIN(len, 0xFFFF);
+    hdr[0] = dir;
+    hdr[1] = LWCELL_U8(len);
+    hdr[2] = LWCELL_U8(len >> 8);
+
+    EnterCriticalSection(&log_lock);
+    if (lwcell_buff_get_free(&log_buff) >= sizeof(hdr) + len) {
+        lwcell_buff_write(&log_buff, hdr, sizeof(hdr));
+        lwcell_buff_write(&log_buff, data, len);
+    } else {
+        ++log_dropped;
+    }
+    LeaveCriticalSection(&log_lock);
+    SetEvent(log_event);
+}
+
+/**
+ * \brief           Log thread, mirrors records to console and received data to log file
+ * \param[in]       param: Thread parameter
+ */
+static void
+log_thread(void* param) {
+    HANDLE h_console = GetStdHandle(STD_OUTPUT_HANDLE);
+    FILE* file = NULL;
+    uint8_t chunk[256], hdr[3];
+    size_t dropped = 0;
+
+    LWCELL_UNUSED(param);
+
+    fopen_s(&file, "log_file.txt", "w+"); /* Open debug file in write mode */
+    while (1) {
+        WaitForSingleObject(log_event, INFINITE);
+        while (1) {
+            size_t len, rd;
+
+            EnterCriticalSection(&log_lock);
+            rd = lwcell_buff_read(&log_buff, hdr, sizeof(hdr));
+            LeaveCriticalSection(&log_lock);
+            if (rd != sizeof(hdr)) {
+                break;
+            }
+            SetConsoleTextAttribute(h_console, hdr[0] == LOG_DIR_RX ? FOREGROUND_GREEN : FOREGROUND_RED);
+            for (len = (size_t)hdr[1] | ((size_t)hdr[2] << 8); len > 0; len -= rd) {
+                EnterCriticalSection(&log_lock);
+                rd = lwcell_buff_read(&log_buff, chunk, LWCELL_MIN(len, sizeof(chunk)));
+                LeaveCriticalSection(&log_lock);
+                fwrite(chunk, 1, rd, stdout);
+                if (hdr[0] == LOG_DIR_RX && file != NULL) {
+                    fwrite(chunk, 1, rd, file);
+                }
+            }
+            SetConsoleTextAttribute(h_console, FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE);
+        }
+        fflush(stdout);
+        if (file != NULL) {
+            fflush(file);
+        }
+        if (dropped != log_dropped) {
+            dropped = log_dropped;
+            printf("\r\n[LL WIN32] %u log record(s) dropped\r\n", (unsigned)dropped);
+        }
+    }
+}
+
+#endif /* LWCELL_LL_WIN32_CONSOLE_LOG */
+
 /**
  * \brief           Send data to GSM device, function called from GSM stack when we have data to send
  * \param[in]       data: Pointer to data to send
@@ -56,22 +170,18 @@ static void uart_thread(void* param);
  */
 static size_t
 send_data(const void* data, size_t len) {
-    DWORD written;
+    DWORD written = 0;
     if (com_port != NULL) {
-#if !LWCELL_CFG_AT_ECHO
-        const uint8_t* d = data;
-        HANDLE hConsole;
-
-        hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
-        SetConsoleTextAttribute(hConsole, FOREGROUND_RED);
-        for (DWORD i = 0; i < len; ++i) {
-            printf("%c", d[i]);
-        }
-        SetConsoleTextAttribute(hConsole, FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE);
-#endif /* !LWCELL_CFG_AT_ECHO */
+#if LWCELL_LL_WIN32_CONSOLE_LOG && !LWCELL_CFG_AT_ECHO
+        log_write(LOG_DIR_TX, data, len);
+#endif /* LWCELL_LL_WIN32_CONSOLE_LOG && !LWCELL_CFG_AT_ECHO */
 
-        /* Write data to AT port */
-        WriteFile(com_port, data, len, &written, NULL);
+        /* Write data to AT port, port is opened for overlapped operations */
+        if (!WriteFile(com_port, data, len, &written, &write_ov)) {
+            if (GetLastError() != ERROR_IO_PENDING || !GetOverlappedResult(com_port, &write_ov, &written, TRUE)) {
+                written = 0;
+            }
+        }
         FlushFileBuffers(com_port);
         return written;
     }
@@ -89,17 +199,19 @@ configure_uart(uint32_t baudrate) {
     /*
      * On first call,
      * create virtual file on selected COM port and open it
-     * as generic read and write
+     * as generic read and write with overlapped operations
      */
     if (!initialized) {
         static const char* com_ports[] = {"\\\\.\\COM23", "\\\\.\\COM12", "\\\\.\\COM9", "\\\\.\\COM8", "\\\\.\\COM4"};
         for (size_t i = 0; i < sizeof(com_ports) / sizeof(com_ports[0]); ++i) {
-            com_port = CreateFileA(com_ports[i], GENERIC_READ | GENERIC_WRITE, 0, 0, OPEN_EXISTING, 0, NULL);
+            com_port = CreateFileA(com_ports[i], GENERIC_READ | GENERIC_WRITE, 0, 0, OPEN_EXISTING,
+                                   FILE_FLAG_OVERLAPPED, NULL);
             if (GetCommState(com_port, &dcb)) {
                 printf("COM PORT %s opened!\r\n", (const char*)com_ports[i]);
                 break;
             }
         }
+        write_ov.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
     }
 
     /* Configure COM port parameters */
@@ -116,7 +228,7 @@ configure_uart(uint32_t baudrate) {
             return 0;
         }
         if (GetCommTimeouts(com_port, &timeouts)) {
-            /* Set timeout to return immediately from ReadFile function */
+            /* Set timeout to return immediately from ReadFile function, thread waits for RX event instead */
             timeouts.ReadIntervalTimeout = MAXDWORD;
             timeouts.ReadTotalTimeoutConstant = 0;
             timeouts.ReadTotalTimeoutMultiplier = 0;
@@ -128,6 +240,10 @@ configure_uart(uint32_t baudrate) {
             printf("Cannot get COM PORT timeouts\r\n");
             return 0;
         }
+        if (!SetCommMask(com_port, EV_RXCHAR)) {
+            printf("Cannot set COM PORT event mask\r\n");
+            return 0;
+        }
     } else {
         printf("Cannot get COM PORT info\r\n");
         return 0;
@@ -135,44 +251,72 @@ configure_uart(uint32_t baudrate) {
 
     /* On first function call, create a thread to read data from COM port */
     if (!initialized) {
+#if LWCELL_LL_WIN32_CONSOLE_LOG
+        InitializeCriticalSection(&log_lock);
+        log_event = CreateEvent(NULL, FALSE, FALSE, NULL);
+        lwcell_buff_init(&log_buff, LWCELL_LL_WIN32_LOG_RING_SIZE);
+        lwcell_sys_thread_create(&log_thread_handle, "lwcell_ll_log", log_thread, NULL, 0, 0);
+#endif /* LWCELL_LL_WIN32_CONSOLE_LOG */
         lwcell_sys_thread_create(&thread_handle, "lwcell_ll_thread", uart_thread, NULL, 0, 0);
     }
     return 1;
 }
 
+/**
+ * \brief           Read data from COM port
+ * \param[in]       ov: Overlapped structure for read operation
+ * \return          Number of bytes read to \ref data_buffer
+ */
+static DWORD
+uart_read(OVERLAPPED* ov) {
+    DWORD bytes_read = 0;
+
+    if (!ReadFile(com_port, data_buffer, sizeof(data_buffer), &bytes_read, ov)) {
+        if (GetLastError() != ERROR_IO_PENDING || !GetOverlappedResult(com_port, ov, &bytes_read, TRUE)) {
+            bytes_read = 0;
+        }
+    }
+    return bytes_read;
+}
+
 /**
  * \brief            UART thread
  */
 static void
 uart_thread(void* param) {
-    DWORD bytes_read;
+    DWORD bytes_read, evt_mask, tmp, errors;
+    COMSTAT com_stat;
+    OVERLAPPED read_ov = {0}, evt_ov = {0};
+    uint8_t evt_pending = 0;
     lwcell_sys_sem_t sem;
-    FILE* file = NULL;
+#ifdef LWCELL_LL_WIN32_CAPTURE_FILE
+    FILE* capture = NULL;
+#endif /* LWCELL_LL_WIN32_CAPTURE_FILE */
 
     LWCELL_UNUSED(param);
 
     lwcell_sys_sem_create(&sem, 0); /* Create semaphore for delay functions */
+    read_ov.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+    evt_ov.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
 
     while (com_port == NULL) {
         lwcell_sys_sem_wait(&sem, 1); /* Add some delay with yield */
     }
 
-    fopen_s(&file, "log_file.txt", "w+"); /* Open debug file in write mode */
+#ifdef LWCELL_LL_WIN32_CAPTURE_FILE
+    fopen_s(&capture, LWCELL_LL_WIN32_CAPTURE_FILE, "wb"); /* Open capture file for replay */
+#endif /* LWCELL_LL_WIN32_CAPTURE_FILE */
     while (1) {
         /*
-         * Try to read data from COM port
+         * Read all data available in COM port
          * and send it to upper layer for processing
          */
         do {
-            ReadFile(com_port, data_buffer, sizeof(data_buffer), &bytes_read, NULL);
+            bytes_read = uart_read(&read_ov);
             if (bytes_read > 0) {
-                HANDLE hConsole;
-                hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
-                SetConsoleTextAttribute(hConsole, FOREGROUND_GREEN);
-                for (DWORD i = 0; i < bytes_read; ++i) {
-                    printf("%c", data_buffer[i]);
-                }
-                SetConsoleTextAttribute(hConsole, FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE);
+#if LWCELL_LL_WIN32_CONSOLE_LOG
+                log_write(LOG_DIR_RX, data_buffer, bytes_read);
+#endif /* LWCELL_LL_WIN32_CONSOLE_LOG */
 
                 /* Send received data to input processing module */
 #if LWCELL_CFG_INPUT_USE_PROCESS
@@ -181,19 +325,39 @@ uart_thread(void* param) {
                 lwcell_input(data_buffer, (size_t)bytes_read);
 #endif /* !LWCELL_CFG_INPUT_USE_PROCESS */
 
-                /* Write received data to output debug file */
-                if (file != NULL) {
-                    fwrite(data_buffer, 1, bytes_read, file);
-                    fflush(file);
+#ifdef LWCELL_LL_WIN32_CAPTURE_FILE
+                /* Write received data with timestamp to capture file */
+                if (capture != NULL) {
+                    uint32_t hdr[2] = {lwcell_sys_now(), (uint32_t)bytes_read};
+
+                    fwrite(hdr, sizeof(hdr), 1, capture);
+                    fwrite(data_buffer, 1, bytes_read, capture);
+                    fflush(capture);
                 }
+#endif /* LWCELL_LL_WIN32_CAPTURE_FILE */
             }
         } while (bytes_read == (DWORD)sizeof(data_buffer));
 
-        /* Implement delay to allow other tasks processing */
-        lwcell_sys_sem_wait(&sem, 1);
+        /* Wait for next received character, no polling */
+        if (!evt_pending) {
+            if (WaitCommEvent(com_port, &evt_mask, &evt_ov)) {
+                continue; /* Event already occurred */
+            }
+            if (GetLastError() != ERROR_IO_PENDING) {
+                lwcell_sys_sem_wait(&sem, 1); /* Port error, retry later */
+                continue;
+            }
+            evt_pending = 1;
+        }
+
+        /* Characters received before wait was armed do not trigger new event */
+        if (ClearCommError(com_port, &errors, &com_stat) && com_stat.cbInQue > 0) {
+            continue;
+        }
+        GetOverlappedResult(com_port, &evt_ov, &tmp, TRUE);
+        evt_pending = 0;
     }
 }
-
 /**
  * \brief           Callback function called from initialization process
  *
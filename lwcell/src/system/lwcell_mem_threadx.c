@@ -1,6 +1,6 @@
 /**
- * \file            lwcell_mem_lwmem.c
- * \brief           Dynamic memory manager implemented with LwMEM
+ * \file            lwcell_mem_threadx.c
+ * \brief           Dynamic memory manager implemented with ThreadX byte and block pools
  */
 
 /*
@@ -31,6 +31,7 @@
  * Author:          Tilen MAJERLE <tilen@majerle.eu>
  * Version:         v0.1.1
  */
+#include "lwcell/lwcell_private.h"
 #include "lwcell/lwcell_types.h"
 #include "tx_api.h"
 
@@ -39,9 +40,108 @@
 /* Byte pool is defined externally, in the lwcell_sys_threadx.c file */
 extern TX_BYTE_POOL* lwcell_threadx_byte_pool;
 
+#if LWCELL_CFG_THREADX_MEM_BLOCK_POOLS
+
+/*
+ * Block sizes, every block is preceded by ThreadX pointer-size overhead.
+ * Messages are allocated with their command payload size only,
+ * smaller ones are served by small block pool
+ */
+#define BLOCK_SMALL_SIZE            LWCELL_MEM_ALIGN(LWCELL_CFG_THREADX_MEM_BLOCK_SMALL_SIZE)
+#define BLOCK_MSG_SIZE              LWCELL_MEM_ALIGN(sizeof(lwcell_msg_t))
+#define BLOCK_DATA_SIZE                                                                                                \
+    (LWCELL_MEM_ALIGN(sizeof(lwcell_pbuf_t)) + LWCELL_MEM_ALIGN(LWCELL_CFG_CONN_MAX_DATA_LEN))
+#define BLOCK_POOL_MEM_SIZE(size, cnt) ((cnt) * ((size) + sizeof(void*)))
+
+/**
+ * \brief           Block pool descriptor
+ */
+typedef struct {
+    TX_BLOCK_POOL pool; /*!< ThreadX block pool */
+    UCHAR* mem;         /*!< Pool memory */
+    ULONG mem_size;     /*!< Size of pool memory */
+    ULONG block_size;   /*!< Size of single block */
+    CHAR* name;         /*!< Pool name */
+} block_pool_t;
+
+static UCHAR block_small_mem[BLOCK_POOL_MEM_SIZE(BLOCK_SMALL_SIZE, LWCELL_CFG_THREADX_MEM_BLOCK_SMALL_COUNT)];
+static UCHAR block_msg_mem[BLOCK_POOL_MEM_SIZE(BLOCK_MSG_SIZE, LWCELL_CFG_THREADX_MEM_BLOCK_MSG_COUNT)];
+static UCHAR block_data_mem[BLOCK_POOL_MEM_SIZE(BLOCK_DATA_SIZE, LWCELL_CFG_THREADX_MEM_BLOCK_DATA_COUNT)];
+
+/* Pools, ordered by block size */
+static block_pool_t block_pools[] = {
+    {.mem = block_small_mem, .mem_size = sizeof(block_small_mem), .block_size = BLOCK_SMALL_SIZE,
+     .name = "lwcell_blk_small"},
+    {.mem = block_msg_mem, .mem_size = sizeof(block_msg_mem), .block_size = BLOCK_MSG_SIZE, .name = "lwcell_blk_msg"},
+    {.mem = block_data_mem, .mem_size = sizeof(block_data_mem), .block_size = BLOCK_DATA_SIZE,
+     .name = "lwcell_blk_data"},
+};
+static uint8_t block_pools_ready;
+
+/**
+ * \brief           Create block pools, called from system initialization
+ * \return          `TX_SUCCESS` on success, ThreadX error code otherwise
+ */
+UINT
+lwcell_mem_threadx_block_pools_init(void) {
+    UINT status = TX_SUCCESS;
+
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(block_pools) && status == TX_SUCCESS; ++i) {
+        block_pool_t* bp = &block_pools[i];
+        status = tx_block_pool_create(&bp->pool, bp->name, bp->block_size, bp->mem, bp->mem_size);
+    }
+    block_pools_ready = status == TX_SUCCESS;
+    return status;
+}
+
+/**
+ * \brief           Allocate block from smallest fitting block pool with free blocks
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Pointer to block or `NULL` if no pool can serve the request
+ */
+static void*
+prv_block_allocate(size_t size) {
+    void* pointer;
+
+    if (!block_pools_ready) {
+        return NULL;
+    }
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(block_pools); ++i) {
+        block_pool_t* bp = &block_pools[i];
+        if (size <= bp->block_size && bp->pool.tx_block_pool_available > 0
+            && tx_block_allocate(&bp->pool, &pointer, TX_NO_WAIT) == TX_SUCCESS) {
+            return pointer;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Check if memory belongs to any of block pools
+ * \param[in]       ptr: Memory pointer
+ * \return          `1` if block pool memory, `0` otherwise
+ */
+static uint8_t
+prv_is_block(const void* ptr) {
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(block_pools); ++i) {
+        const block_pool_t* bp = &block_pools[i];
+        if ((const UCHAR*)ptr >= bp->mem && (const UCHAR*)ptr < bp->mem + bp->mem_size) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+#endif /* LWCELL_CFG_THREADX_MEM_BLOCK_POOLS */
+
 void*
 lwcell_mem_malloc(size_t size) {
     void* pointer;
+#if LWCELL_CFG_THREADX_MEM_BLOCK_POOLS
+    if ((pointer = prv_block_allocate(size)) != NULL) {
+        return pointer;
+    }
+#endif /* LWCELL_CFG_THREADX_MEM_BLOCK_POOLS */
     return tx_byte_allocate(lwcell_threadx_byte_pool, &pointer, size, TX_NO_WAIT) == TX_SUCCESS ? pointer : NULL;
 }
 
@@ -55,12 +155,20 @@ void*
 lwcell_mem_calloc(size_t num, size_t size) {
     size_t total = num * size;
     void* pointer = lwcell_mem_malloc(total);
-    TX_MEMSET(pointer, 0, total);
+    if (pointer != NULL) {
+        TX_MEMSET(pointer, 0, total);
+    }
     return pointer;
 }
 
 void
 lwcell_mem_free(void* ptr) {
+#if LWCELL_CFG_THREADX_MEM_BLOCK_POOLS
+    if (prv_is_block(ptr)) {
+        (VOID) tx_block_release(ptr);
+        return;
+    }
+#endif /* LWCELL_CFG_THREADX_MEM_BLOCK_POOLS */
     (VOID) tx_byte_release(ptr);
 }
 
@@ -0,0 +1,138 @@
+/**
+ * \file            lwcell_prof_dwt.c
+ * \brief           Cycle profiling of stack pipeline with Cortex-M DWT cycle counter
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "system/lwcell_prof_dwt.h"
+#include "lwcell/lwcell_utils.h"
+#include "system/lwcell_sys.h"
+
+#if !__DOXYGEN__
+
+/* Debug registers, accessed directly to avoid dependency on device CMSIS header */
+#define PROF_DEMCR         (*(volatile uint32_t*)0xE000EDFCUL)
+#define PROF_DEMCR_TRCENA  (1UL << 24)
+#define PROF_DWT_CTRL      (*(volatile uint32_t*)0xE0001000UL)
+#define PROF_DWT_CTRL_CYC  (1UL << 0)
+#define PROF_DWT_CYCCNT    (*(volatile uint32_t*)0xE0001004UL)
+#define PROF_DWT_LAR       (*(volatile uint32_t*)0xE0001FB0UL)
+#define PROF_DWT_LAR_KEY   0xC5ACCE55UL
+
+/**
+ * \brief           Profiling state of single trace point
+ */
+typedef struct {
+    lwcell_prof_dwt_stats_t stats; /*!< Accumulated statistics */
+    uint32_t start;                /*!< Cycle counter at begin of outermost span */
+    uint32_t depth;                /*!< Number of currently open spans */
+} prof_point_t;
+
+static prof_point_t prof_points[LWCELL_TRACE_POINT_END];
+
+#endif /* !__DOXYGEN__ */
+
+/**
+ * \brief           Enable cycle counter
+ * \note            Function must be called before \ref lwcell_init
+ */
+void
+lwcell_prof_dwt_init(void) {
+    PROF_DEMCR |= PROF_DEMCR_TRCENA;
+    PROF_DWT_LAR = PROF_DWT_LAR_KEY; /* Unlock access on cores with lock access register */
+    PROF_DWT_CYCCNT = 0;
+    PROF_DWT_CTRL |= PROF_DWT_CTRL_CYC;
+}
+
+/**
+ * \brief           Trace hook, set as \ref LWCELL_TRACE_HOOK
+ * \param[in]       point: Member of \ref lwcell_trace_point_t enumeration
+ * \param[in]       phase: Member of \ref lwcell_trace_phase_t enumeration
+ * \param[in]       val: Operation specific value, not used
+ */
+void
+lwcell_prof_dwt_hook(unsigned point, unsigned phase, uint32_t val) {
+    uint32_t now = PROF_DWT_CYCCNT;
+    prof_point_t* p;
+
+    LWCELL_UNUSED(val);
+    if (point >= LWCELL_ARRAYSIZE(prof_points)) {
+        return;
+    }
+    p = &prof_points[point];
+    if (phase == LWCELL_TRACE_BEGIN) {
+        if (p->depth++ == 0) {
+            p->start = now;
+        }
+    } else if (phase == LWCELL_TRACE_END) {
+        if (p->depth > 0 && --p->depth == 0) {
+            uint32_t cycles = now - p->start; /* Unsigned difference handles counter overflow */
+
+            ++p->stats.count;
+            p->stats.cycles += cycles;
+            if (cycles > p->stats.max) {
+                p->stats.max = cycles;
+            }
+        }
+    } else {
+        ++p->stats.count;
+    }
+}
+
+/**
+ * \brief           Get accumulated statistics of trace point
+ * \param[in]       point: Trace point
+ * \param[out]      stats: Output statistics
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwcell_prof_dwt_get(lwcell_trace_point_t point, lwcell_prof_dwt_stats_t* stats) {
+    if ((size_t)point >= LWCELL_ARRAYSIZE(prof_points) || stats == NULL) {
+        return 0;
+    }
+    lwcell_sys_protect();
+    *stats = prof_points[point].stats;
+    lwcell_sys_unprotect();
+    return 1;
+}
+
+/**
+ * \brief           Reset accumulated statistics of all trace points
+ */
+void
+lwcell_prof_dwt_reset(void) {
+    lwcell_sys_protect();
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(prof_points); ++i) {
+        prof_points[i].stats.count = 0;
+        prof_points[i].stats.cycles = 0;
+        prof_points[i].stats.max = 0;
+    }
+    lwcell_sys_unprotect();
+}
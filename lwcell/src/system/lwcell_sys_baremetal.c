@@ -0,0 +1,253 @@
+/**
+ * \file            lwcell_sys_baremetal.c
+ * \brief           System dependant functions for bare-metal single loop mode
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#include "lwcell/lwcell_private.h"
+#include "system/lwcell_sys.h"
+
+#if !__DOXYGEN__
+
+/*
+ * Library runs from single loop with lwcell_poll, hence there is nothing to protect
+ * and nobody else can release an object while caller waits for it.
+ * Wait functions therefore never block, they return LWCELL_SYS_TIMEOUT when object is not available.
+ *
+ * Application implements lwcell_sys_now, for example with HAL_GetTick
+ */
+
+/**
+ * \brief           Semaphore, a single token
+ */
+struct lwcell_sys_bm_sem {
+    uint8_t cnt; /*!< Number of available tokens, `0` or `1` */
+};
+
+/**
+ * \brief           Message queue, a ring of pointers
+ */
+struct lwcell_sys_bm_mbox {
+    size_t in, out, cnt, size;
+    void* entries[1];
+};
+
+uint8_t
+lwcell_sys_init(void) {
+    return 1;
+}
+
+uint8_t
+lwcell_sys_protect(void) {
+    return 1;
+}
+
+uint8_t
+lwcell_sys_unprotect(void) {
+    return 1;
+}
+
+#if LWCELL_CFG_PBUF_REF_ATOMIC && !LWCELL_PBUF_REF_STDATOMIC
+
+size_t
+lwcell_sys_atomic_add(size_t* var, int delta) {
+    *var += (size_t)delta; /* Single loop, nothing can interrupt the update */
+    return *var;
+}
+
+#endif /* LWCELL_CFG_PBUF_REF_ATOMIC && !LWCELL_PBUF_REF_STDATOMIC */
+
+uint8_t
+lwcell_sys_mutex_create(lwcell_sys_mutex_t* p) {
+    *p = 1;
+    return 1;
+}
+
+uint8_t
+lwcell_sys_mutex_delete(lwcell_sys_mutex_t* p) {
+    LWCELL_UNUSED(p);
+    return 1;
+}
+
+uint8_t
+lwcell_sys_mutex_lock(lwcell_sys_mutex_t* p) {
+    LWCELL_UNUSED(p);
+    return 1;
+}
+
+uint8_t
+lwcell_sys_mutex_unlock(lwcell_sys_mutex_t* p) {
+    LWCELL_UNUSED(p);
+    return 1;
+}
+
+uint8_t
+lwcell_sys_mutex_isvalid(lwcell_sys_mutex_t* p) {
+    return p != NULL && *p != LWCELL_SYS_MUTEX_NULL;
+}
+
+uint8_t
+lwcell_sys_mutex_invalid(lwcell_sys_mutex_t* p) {
+    *p = LWCELL_SYS_MUTEX_NULL;
+    return 1;
+}
+
+uint8_t
+lwcell_sys_sem_create(lwcell_sys_sem_t* p, uint8_t cnt) {
+    if ((*p = lwcell_mem_malloc(sizeof(**p))) == NULL) {
+        return 0;
+    }
+    (*p)->cnt = cnt > 0 ? 1 : 0;
+    return 1;
+}
+
+uint8_t
+lwcell_sys_sem_delete(lwcell_sys_sem_t* p) {
+    lwcell_mem_free(*p);
+    return 1;
+}
+
+uint32_t
+lwcell_sys_sem_wait(lwcell_sys_sem_t* p, uint32_t timeout) {
+    LWCELL_UNUSED(timeout);
+    if ((*p)->cnt == 0) {
+        return LWCELL_SYS_TIMEOUT;
+    }
+    (*p)->cnt = 0;
+    return 0;
+}
+
+uint8_t
+lwcell_sys_sem_release(lwcell_sys_sem_t* p) {
+    (*p)->cnt = 1;
+    return 1;
+}
+
+uint8_t
+lwcell_sys_sem_isvalid(lwcell_sys_sem_t* p) {
+    return p != NULL && *p != LWCELL_SYS_SEM_NULL;
+}
+
+uint8_t
+lwcell_sys_sem_invalid(lwcell_sys_sem_t* p) {
+    *p = LWCELL_SYS_SEM_NULL;
+    return 1;
+}
+
+uint8_t
+lwcell_sys_mbox_create(lwcell_sys_mbox_t* b, size_t size) {
+    if ((*b = lwcell_mem_calloc(1, sizeof(**b) + (size - 1) * sizeof((*b)->entries[0]))) == NULL) {
+        return 0;
+    }
+    (*b)->size = size;
+    return 1;
+}
+
+uint8_t
+lwcell_sys_mbox_delete(lwcell_sys_mbox_t* b) {
+    if ((*b)->cnt > 0) {
+        return 0;
+    }
+    lwcell_mem_free(*b);
+    return 1;
+}
+
+uint32_t
+lwcell_sys_mbox_put(lwcell_sys_mbox_t* b, void* m) {
+    return lwcell_sys_mbox_putnow(b, m) ? 0 : LWCELL_SYS_TIMEOUT;
+}
+
+uint32_t
+lwcell_sys_mbox_get(lwcell_sys_mbox_t* b, void** m, uint32_t timeout) {
+    LWCELL_UNUSED(timeout);
+    return lwcell_sys_mbox_getnow(b, m) ? 0 : LWCELL_SYS_TIMEOUT;
+}
+
+uint8_t
+lwcell_sys_mbox_putnow(lwcell_sys_mbox_t* b, void* m) {
+    lwcell_sys_mbox_t mb = *b;
+
+    if (mb->cnt == mb->size) {
+        return 0;
+    }
+    mb->entries[mb->in] = m;
+    mb->in = (mb->in + 1) % mb->size;
+    ++mb->cnt;
+    return 1;
+}
+
+uint8_t
+lwcell_sys_mbox_getnow(lwcell_sys_mbox_t* b, void** m) {
+    lwcell_sys_mbox_t mb = *b;
+
+    if (mb->cnt == 0) {
+        return 0;
+    }
+    *m = mb->entries[mb->out];
+    mb->out = (mb->out + 1) % mb->size;
+    --mb->cnt;
+    return 1;
+}
+
+uint8_t
+lwcell_sys_mbox_isvalid(lwcell_sys_mbox_t* b) {
+    return b != NULL && *b != LWCELL_SYS_MBOX_NULL;
+}
+
+uint8_t
+lwcell_sys_mbox_invalid(lwcell_sys_mbox_t* b) {
+    *b = LWCELL_SYS_MBOX_NULL;
+    return 1;
+}
+
+uint8_t
+lwcell_sys_thread_create(lwcell_sys_thread_t* t, const char* name, lwcell_sys_thread_fn thread_func, void* const arg,
+                         size_t stack_size, lwcell_sys_thread_prio_t prio) {
+    LWCELL_UNUSED(t);
+    LWCELL_UNUSED(name);
+    LWCELL_UNUSED(thread_func);
+    LWCELL_UNUSED(arg);
+    LWCELL_UNUSED(stack_size);
+    LWCELL_UNUSED(prio);
+    return 0; /* No threads without operating system */
+}
+
+uint8_t
+lwcell_sys_thread_terminate(lwcell_sys_thread_t* t) {
+    LWCELL_UNUSED(t);
+    return 0;
+}
+
+uint8_t
+lwcell_sys_thread_yield(void) {
+    return 1;
+}
+
+#endif /* !__DOXYGEN__ */
@@ -61,6 +61,20 @@ lwcell_sys_unprotect(void) {
     return 1;
 }
 
+#if LWCELL_CFG_PBUF_REF_ATOMIC && !LWCELL_PBUF_REF_STDATOMIC
+
+size_t
+lwcell_sys_atomic_add(size_t* var, int delta) {
+    size_t val;
+    int32_t lock = osKernelLock(); /* Prevent thread switch during update */
+
+    val = (*var += (size_t)delta);
+    osKernelRestoreLock(lock);
+    return val;
+}
+
+#endif /* LWCELL_CFG_PBUF_REF_ATOMIC && !LWCELL_PBUF_REF_STDATOMIC */
+
 uint8_t
 lwcell_sys_mutex_create(lwcell_sys_mutex_t* p) {
     const osMutexAttr_t attr = {
@@ -166,6 +180,15 @@ lwcell_sys_mbox_putnow(lwcell_sys_mbox_t* b, void* m) {
     return osMessageQueuePut(*b, &m, 0, 0) == osOK;
 }
 
+#if LWCELL_CFG_INPUT_FROM_ISR
+
+uint8_t
+lwcell_sys_mbox_putnow_from_isr(lwcell_sys_mbox_t* b, void* m) {
+    return lwcell_sys_mbox_putnow(b, m); /* Put with zero timeout is allowed in interrupt */
+}
+
+#endif /* LWCELL_CFG_INPUT_FROM_ISR */
+
 uint8_t
 lwcell_sys_mbox_getnow(lwcell_sys_mbox_t* b, void** m) {
     return osMessageQueueGet(*b, m, NULL, 0) == osOK;
@@ -182,6 +205,56 @@ lwcell_sys_mbox_invalid(lwcell_sys_mbox_t* b) {
     return 1;
 }
 
+#if LWCELL_CFG_THREAD_PROCESS_NOTIFY
+
+uint8_t
+lwcell_sys_notify_create(lwcell_sys_notify_t* n) {
+    const osEventFlagsAttr_t attr = {
+        .name = "lwcell_notify",
+    };
+    return (*n = osEventFlagsNew(&attr)) != NULL;
+}
+
+uint8_t
+lwcell_sys_notify_delete(lwcell_sys_notify_t* n) {
+    return osEventFlagsDelete(*n) == osOK;
+}
+
+uint8_t
+lwcell_sys_notify_post(lwcell_sys_notify_t* n) {
+    return (osEventFlagsSet(*n, 0x01) & osFlagsError) == 0;
+}
+
+uint32_t
+lwcell_sys_notify_wait(lwcell_sys_notify_t* n, uint32_t timeout) {
+    uint32_t tick = osKernelSysTick();
+    return (osEventFlagsWait(*n, 0x01, osFlagsWaitAny, timeout == 0 ? osWaitForever : timeout) & osFlagsError) == 0
+               ? (osKernelSysTick() - tick)
+               : LWCELL_SYS_TIMEOUT;
+}
+
+uint8_t
+lwcell_sys_notify_isvalid(lwcell_sys_notify_t* n) {
+    return n != NULL && *n != NULL;
+}
+
+uint8_t
+lwcell_sys_notify_invalid(lwcell_sys_notify_t* n) {
+    *n = LWCELL_SYS_NOTIFY_NULL;
+    return 1;
+}
+
+#if LWCELL_CFG_INPUT_FROM_ISR
+
+uint8_t
+lwcell_sys_notify_post_from_isr(lwcell_sys_notify_t* n) {
+    return lwcell_sys_notify_post(n); /* Event flags may be set from interrupt */
+}
+
+#endif /* LWCELL_CFG_INPUT_FROM_ISR */
+
+#endif /* LWCELL_CFG_THREAD_PROCESS_NOTIFY */
+
 uint8_t
 lwcell_sys_thread_create(lwcell_sys_thread_t* t, const char* name, lwcell_sys_thread_fn thread_func, void* const arg,
                         size_t stack_size, lwcell_sys_thread_prio_t prio) {
@@ -213,4 +286,40 @@ lwcell_sys_thread_yield(void) {
     return 1;
 }
 
+#if LWCELL_CFG_THREAD_AFFINITY
+
+uint8_t
+lwcell_sys_thread_create_pinned(lwcell_sys_thread_t* t, const char* name, lwcell_sys_thread_fn thread_func,
+                                void* const arg, size_t stack_size, lwcell_sys_thread_prio_t prio, int core) {
+    LWCELL_UNUSED(core); /* Core affinity is not part of CMSIS-OS v2 API */
+    return lwcell_sys_thread_create(t, name, thread_func, arg, stack_size, prio);
+}
+
+#endif /* LWCELL_CFG_THREAD_AFFINITY */
+
+#if LWCELL_CFG_THREAD_PROCESS_IPD_BOOST
+
+uint8_t
+lwcell_sys_thread_set_prio(lwcell_sys_thread_t* t, lwcell_sys_thread_prio_t prio) {
+    return osThreadSetPriority(*t, (osPriority_t)prio) == osOK;
+}
+
+#endif /* LWCELL_CFG_THREAD_PROCESS_IPD_BOOST */
+
+#if LWCELL_CFG_STATS_THREADS
+
+uint8_t
+lwcell_sys_thread_get_info(lwcell_sys_thread_t* t, lwcell_sys_thread_info_t* info) {
+    uint32_t size;
+
+    if ((size = osThreadGetStackSize(*t)) > 0) {
+        info->stack_size = size;
+    }
+    info->stack_unused = osThreadGetStackSpace(*t); /* Run time is not available in CMSIS-OS v2 API */
+    info->stack_valid = 1;
+    return 1;
+}
+
+#endif /* LWCELL_CFG_STATS_THREADS */
+
 #endif /* !__DOXYGEN__ */
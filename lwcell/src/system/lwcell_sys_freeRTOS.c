@@ -31,6 +31,7 @@
  * Version:         v0.1.1
  */
 #include "FreeRTOS.h"
+#include "lwcell/lwcell_utils.h"
 #include "semphr.h"
 #include "system/lwcell_sys.h"
 #include "task.h"
@@ -44,9 +45,116 @@ typedef struct {
     void* d;
 } freertos_mbox_t;
 
+#if LWCELL_CFG_SYS_STATIC_ALLOC
+
+#if !configSUPPORT_STATIC_ALLOCATION
+#error "configSUPPORT_STATIC_ALLOCATION must be enabled when LWCELL_CFG_SYS_STATIC_ALLOC is enabled"
+#endif /* !configSUPPORT_STATIC_ALLOCATION */
+
+/* Number of stack entries of thread slot */
+#define STATIC_THREAD_STACK_LEN (LWCELL_CFG_SYS_STATIC_THREAD_SS / sizeof(StackType_t))
+
+/* Preallocated system objects, taken instead of kernel heap */
+typedef struct {
+    StaticSemaphore_t buff;   /*!< Mutex or semaphore control block */
+    SemaphoreHandle_t handle; /*!< Handle of object created in slot */
+} freertos_sem_slot_t;
+
+typedef struct {
+    StaticQueue_t buff;                                                         /*!< Queue control block */
+    uint8_t storage[LWCELL_CFG_SYS_STATIC_MBOX_SIZE * sizeof(freertos_mbox_t)]; /*!< Queue entries */
+    QueueHandle_t handle;                                                       /*!< Handle of queue created in slot */
+} freertos_mbox_slot_t;
+
+typedef struct {
+    StaticTask_t tcb;                           /*!< Task control block */
+    StackType_t stack[STATIC_THREAD_STACK_LEN]; /*!< Task stack */
+    TaskHandle_t handle;                        /*!< Handle of task created in slot */
+} freertos_thread_slot_t;
+
+static StaticSemaphore_t sys_mutex_buff;
+static freertos_sem_slot_t sem_slots[LWCELL_CFG_SYS_STATIC_SEM_CNT];
+static uint8_t sem_slots_used[LWCELL_CFG_SYS_STATIC_SEM_CNT];
+static freertos_mbox_slot_t mbox_slots[LWCELL_CFG_SYS_STATIC_MBOX_CNT];
+static uint8_t mbox_slots_used[LWCELL_CFG_SYS_STATIC_MBOX_CNT];
+static freertos_thread_slot_t thread_slots[LWCELL_CFG_SYS_STATIC_THREAD_CNT];
+static uint8_t thread_slots_used[LWCELL_CFG_SYS_STATIC_THREAD_CNT];
+
+/**
+ * \brief           Reserve first free slot
+ * \param[in]       used: Array of slot usage flags
+ * \param[in]       cnt: Number of slots
+ * \return          Slot index on success, `-1` when all slots are used
+ */
+static int
+prv_slot_take(uint8_t* used, size_t cnt) {
+    int idx = -1;
+
+    vTaskSuspendAll(); /* Objects are never created from interrupt */
+    for (size_t i = 0; i < cnt; ++i) {
+        if (!used[i]) {
+            used[i] = 1;
+            idx = (int)i;
+            break;
+        }
+    }
+    (void)xTaskResumeAll();
+    return idx;
+}
+
+#endif /* LWCELL_CFG_SYS_STATIC_ALLOC */
+
+/**
+ * \brief           Create binary semaphore or recursive mutex
+ * \param[in]       recursive: Set to `1` to create recursive mutex
+ * \return          Object handle on success, `NULL` otherwise
+ */
+static SemaphoreHandle_t
+prv_sem_create(uint8_t recursive) {
+#if LWCELL_CFG_SYS_STATIC_ALLOC
+    int idx = prv_slot_take(sem_slots_used, LWCELL_ARRAYSIZE(sem_slots_used));
+
+    if (idx >= 0) {
+        freertos_sem_slot_t* slot = &sem_slots[idx];
+
+        slot->handle = recursive ? xSemaphoreCreateRecursiveMutexStatic(&slot->buff)
+                                 : xSemaphoreCreateBinaryStatic(&slot->buff);
+        return slot->handle;
+    }
+#endif /* LWCELL_CFG_SYS_STATIC_ALLOC */
+#if configSUPPORT_DYNAMIC_ALLOCATION
+    return recursive ? xSemaphoreCreateRecursiveMutex() : xSemaphoreCreateBinary();
+#else
+    LWCELL_UNUSED(recursive);
+    return NULL;
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+
+/**
+ * \brief           Delete mutex or semaphore and release its slot
+ * \param[in]       h: Object handle
+ */
+static void
+prv_sem_delete(SemaphoreHandle_t h) {
+    vSemaphoreDelete(h);
+#if LWCELL_CFG_SYS_STATIC_ALLOC
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(sem_slots); ++i) {
+        if (sem_slots_used[i] && sem_slots[i].handle == h) {
+            sem_slots[i].handle = NULL;
+            sem_slots_used[i] = 0;
+            break;
+        }
+    }
+#endif /* LWCELL_CFG_SYS_STATIC_ALLOC */
+}
+
 uint8_t
 lwcell_sys_init(void) {
+#if LWCELL_CFG_SYS_STATIC_ALLOC
+    sys_mutex = xSemaphoreCreateMutexStatic(&sys_mutex_buff);
+#else
     sys_mutex = xSemaphoreCreateMutex();
+#endif /* LWCELL_CFG_SYS_STATIC_ALLOC */
     return sys_mutex == NULL ? 0 : 1;
 }
 
@@ -67,15 +175,29 @@ lwcell_sys_unprotect(void) {
     return 1;
 }
 
+#if LWCELL_CFG_PBUF_REF_ATOMIC && !LWCELL_PBUF_REF_STDATOMIC
+
+size_t
+lwcell_sys_atomic_add(size_t* var, int delta) {
+    size_t val;
+
+    taskENTER_CRITICAL();
+    val = (*var += (size_t)delta);
+    taskEXIT_CRITICAL();
+    return val;
+}
+
+#endif /* LWCELL_CFG_PBUF_REF_ATOMIC && !LWCELL_PBUF_REF_STDATOMIC */
+
 uint8_t
 lwcell_sys_mutex_create(lwcell_sys_mutex_t* p) {
-    *p = xSemaphoreCreateRecursiveMutex();
+    *p = prv_sem_create(1);
     return *p != NULL;
 }
 
 uint8_t
 lwcell_sys_mutex_delete(lwcell_sys_mutex_t* p) {
-    vSemaphoreDelete(*p);
+    prv_sem_delete(*p);
     return 1;
 }
 
@@ -102,7 +224,7 @@ lwcell_sys_mutex_invalid(lwcell_sys_mutex_t* p) {
 
 uint8_t
 lwcell_sys_sem_create(lwcell_sys_sem_t* p, uint8_t cnt) {
-    *p = xSemaphoreCreateBinary();
+    *p = prv_sem_create(0);
 
     if (*p != NULL && cnt) {
         xSemaphoreGive(*p);
@@ -112,7 +234,7 @@ lwcell_sys_sem_create(lwcell_sys_sem_t* p, uint8_t cnt) {
 
 uint8_t
 lwcell_sys_sem_delete(lwcell_sys_sem_t* p) {
-    vSemaphoreDelete(*p);
+    prv_sem_delete(*p);
     return 1;
 }
 
@@ -142,7 +264,24 @@ lwcell_sys_sem_invalid(lwcell_sys_sem_t* p) {
 
 uint8_t
 lwcell_sys_mbox_create(lwcell_sys_mbox_t* b, size_t size) {
+#if LWCELL_CFG_SYS_STATIC_ALLOC
+    if (size <= LWCELL_CFG_SYS_STATIC_MBOX_SIZE) {
+        int idx = prv_slot_take(mbox_slots_used, LWCELL_ARRAYSIZE(mbox_slots_used));
+
+        if (idx >= 0) {
+            freertos_mbox_slot_t* slot = &mbox_slots[idx];
+
+            slot->handle = xQueueCreateStatic(size, sizeof(freertos_mbox_t), slot->storage, &slot->buff);
+            *b = slot->handle;
+            return *b != NULL;
+        }
+    }
+#endif /* LWCELL_CFG_SYS_STATIC_ALLOC */
+#if configSUPPORT_DYNAMIC_ALLOCATION
     *b = xQueueCreate(size, sizeof(freertos_mbox_t));
+#else
+    *b = NULL;
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
     return *b != NULL;
 }
 
@@ -152,6 +291,15 @@ lwcell_sys_mbox_delete(lwcell_sys_mbox_t* b) {
         return 0;
     }
     vQueueDelete(*b);
+#if LWCELL_CFG_SYS_STATIC_ALLOC
+    for (size_t i = 0; i < LWCELL_ARRAYSIZE(mbox_slots); ++i) {
+        if (mbox_slots_used[i] && mbox_slots[i].handle == *b) {
+            mbox_slots[i].handle = NULL;
+            mbox_slots_used[i] = 0;
+            break;
+        }
+    }
+#endif /* LWCELL_CFG_SYS_STATIC_ALLOC */
     return 1;
 }
 
@@ -185,6 +333,23 @@ lwcell_sys_mbox_putnow(lwcell_sys_mbox_t* b, void* m) {
     return xQueueSendFromISR(*b, &mb, 0) == pdPASS;
 }
 
+#if LWCELL_CFG_INPUT_FROM_ISR
+
+uint8_t
+lwcell_sys_mbox_putnow_from_isr(lwcell_sys_mbox_t* b, void* m) {
+    BaseType_t woken = pdFALSE;
+    freertos_mbox_t mb;
+
+    mb.d = m;
+    if (xQueueSendFromISR(*b, &mb, &woken) != pdPASS) {
+        return 0;
+    }
+    portYIELD_FROM_ISR(woken); /* Switch to processing thread on interrupt exit */
+    return 1;
+}
+
+#endif /* LWCELL_CFG_INPUT_FROM_ISR */
+
 uint8_t
 lwcell_sys_mbox_getnow(lwcell_sys_mbox_t* b, void** m) {
     freertos_mbox_t mb;
@@ -207,14 +372,120 @@ lwcell_sys_mbox_invalid(lwcell_sys_mbox_t* b) {
     return 1;
 }
 
+#if LWCELL_CFG_THREAD_PROCESS_NOTIFY
+
+uint8_t
+lwcell_sys_notify_create(lwcell_sys_notify_t* n) {
+    n->task = NULL; /* Bound to waiting task on first wait */
+    n->created = 1;
+    return 1;
+}
+
+uint8_t
+lwcell_sys_notify_delete(lwcell_sys_notify_t* n) {
+    n->task = NULL;
+    return 1;
+}
+
+uint8_t
+lwcell_sys_notify_post(lwcell_sys_notify_t* n) {
+    TaskHandle_t task = n->task;
+
+    if (task == NULL) {
+        return 0; /* Nobody is waiting yet */
+    }
+    vTaskNotifyGiveFromISR(task, NULL);
+    return 1;
+}
+
+uint32_t
+lwcell_sys_notify_wait(lwcell_sys_notify_t* n, uint32_t timeout) {
+    uint32_t t = xTaskGetTickCount();
+
+    if (n->task == NULL) {
+        n->task = xTaskGetCurrentTaskHandle();
+    }
+    if (ulTaskNotifyTake(pdTRUE, !timeout ? portMAX_DELAY : pdMS_TO_TICKS(timeout)) > 0) {
+        return (xTaskGetTickCount() - t) * portTICK_PERIOD_MS;
+    }
+    return LWCELL_SYS_TIMEOUT;
+}
+
+uint8_t
+lwcell_sys_notify_isvalid(lwcell_sys_notify_t* n) {
+    return n != NULL && n->created;
+}
+
+uint8_t
+lwcell_sys_notify_invalid(lwcell_sys_notify_t* n) {
+    n->task = NULL;
+    n->created = 0;
+    return 1;
+}
+
+#if LWCELL_CFG_INPUT_FROM_ISR
+
+uint8_t
+lwcell_sys_notify_post_from_isr(lwcell_sys_notify_t* n) {
+    BaseType_t woken = pdFALSE;
+    TaskHandle_t task = n->task;
+
+    if (task == NULL) {
+        return 0; /* Nobody is waiting yet */
+    }
+    vTaskNotifyGiveFromISR(task, &woken);
+    portYIELD_FROM_ISR(woken); /* Switch to processing thread on interrupt exit */
+    return 1;
+}
+
+#endif /* LWCELL_CFG_INPUT_FROM_ISR */
+
+#endif /* LWCELL_CFG_THREAD_PROCESS_NOTIFY */
+
 uint8_t
 lwcell_sys_thread_create(lwcell_sys_thread_t* t, const char* name, lwcell_sys_thread_fn thread_func, void* const arg,
                         size_t stack_size, lwcell_sys_thread_prio_t prio) {
+#if LWCELL_CFG_SYS_STATIC_ALLOC
+    if (stack_size <= LWCELL_CFG_SYS_STATIC_THREAD_SS) {
+        int idx = prv_slot_take(thread_slots_used, LWCELL_ARRAYSIZE(thread_slots_used));
+
+        if (idx >= 0) {
+            freertos_thread_slot_t* slot = &thread_slots[idx];
+
+            slot->handle = xTaskCreateStatic(thread_func, name, STATIC_THREAD_STACK_LEN, arg, prio, slot->stack,
+                                             &slot->tcb);
+            if (t != NULL) {
+                *t = slot->handle;
+            }
+            return slot->handle != NULL;
+        }
+    }
+#endif /* LWCELL_CFG_SYS_STATIC_ALLOC */
+#if configSUPPORT_DYNAMIC_ALLOCATION
     return xTaskCreate(thread_func, name, stack_size / sizeof(portSTACK_TYPE), arg, prio, t) == pdPASS ? 1 : 0;
+#else
+    return 0;
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 }
 
 uint8_t
 lwcell_sys_thread_terminate(lwcell_sys_thread_t* t) {
+#if LWCELL_CFG_SYS_STATIC_ALLOC
+    /*
+     * Slot of other task is released immediately,
+     * while deleted self keeps its slot, as idle task still uses control block
+     */
+    if (*t != xTaskGetCurrentTaskHandle()) {
+        for (size_t i = 0; i < LWCELL_ARRAYSIZE(thread_slots); ++i) {
+            if (thread_slots_used[i] && thread_slots[i].handle == *t) {
+                vTaskDelete(*t);
+                thread_slots[i].handle = NULL;
+                thread_slots_used[i] = 0;
+                return 1;
+            }
+        }
+    }
+#endif /* LWCELL_CFG_SYS_STATIC_ALLOC */
     vTaskDelete(*t);
     return 1;
 }
@@ -225,4 +496,60 @@ lwcell_sys_thread_yield(void) {
     return 1;
 }
 
+#if LWCELL_CFG_THREAD_AFFINITY
+
+uint8_t
+lwcell_sys_thread_create_pinned(lwcell_sys_thread_t* t, const char* name, lwcell_sys_thread_fn thread_func,
+                                void* const arg, size_t stack_size, lwcell_sys_thread_prio_t prio, int core) {
+#if defined(ESP_PLATFORM)
+    return xTaskCreatePinnedToCore(thread_func, name, stack_size / sizeof(portSTACK_TYPE), arg, prio, t, core) == pdPASS
+               ? 1
+               : 0;
+#elif configUSE_CORE_AFFINITY && configNUMBER_OF_CORES > 1
+    return xTaskCreateAffinitySet(thread_func, name, stack_size / sizeof(portSTACK_TYPE), arg, prio,
+                                  (UBaseType_t)1 << core, t)
+                   == pdPASS
+               ? 1
+               : 0;
+#else
+    LWCELL_UNUSED(core); /* Single core, no affinity */
+    return lwcell_sys_thread_create(t, name, thread_func, arg, stack_size, prio);
+#endif
+}
+
+#endif /* LWCELL_CFG_THREAD_AFFINITY */
+
+#if LWCELL_CFG_THREAD_PROCESS_IPD_BOOST
+
+uint8_t
+lwcell_sys_thread_set_prio(lwcell_sys_thread_t* t, lwcell_sys_thread_prio_t prio) {
+    vTaskPrioritySet(*t, prio);
+    return 1;
+}
+
+#endif /* LWCELL_CFG_THREAD_PROCESS_IPD_BOOST */
+
+#if LWCELL_CFG_STATS_THREADS
+
+uint8_t
+lwcell_sys_thread_get_info(lwcell_sys_thread_t* t, lwcell_sys_thread_info_t* info) {
+#if INCLUDE_uxTaskGetStackHighWaterMark
+    info->stack_unused = (size_t)uxTaskGetStackHighWaterMark(*t) * sizeof(portSTACK_TYPE);
+    info->stack_valid = 1;
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+#if configGENERATE_RUN_TIME_STATS && configUSE_TRACE_FACILITY && defined(portGET_RUN_TIME_COUNTER_VALUE)
+    {
+        TaskStatus_t status;
+
+        vTaskGetInfo(*t, &status, pdFALSE, eInvalid); /* Skip stack check, it walks entire stack */
+        info->run_time = status.ulRunTimeCounter;
+        info->run_time_total = portGET_RUN_TIME_COUNTER_VALUE();
+        info->run_time_valid = 1;
+    }
+#endif /* configGENERATE_RUN_TIME_STATS && configUSE_TRACE_FACILITY && defined(portGET_RUN_TIME_COUNTER_VALUE) */
+    return 1;
+}
+
+#endif /* LWCELL_CFG_STATS_THREADS */
+
 #endif /* !__DOXYGEN__ */
\ No newline at end of file
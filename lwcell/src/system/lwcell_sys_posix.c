@@ -0,0 +1,676 @@
+/**
+ * \file            lwcell_sys_posix.c
+ * \brief           System dependant functions for POSIX
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwCELL - Lightweight cellular modem AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v0.1.1
+ */
+#ifndef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 700 /* Recursive mutexes and monotonic condition clock */
+#endif
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* Thread CPU affinity */
+#endif
+#include <errno.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include "lwcell/lwcell_private.h"
+#include "system/lwcell_sys.h"
+
+#if !__DOXYGEN__
+
+/**
+ * \brief           Semaphore implementation with mutex and condition variable
+ */
+struct lwcell_sys_posix_sem {
+    pthread_mutex_t mutex; /*!< Mutex to protect counter */
+    pthread_cond_t cond;   /*!< Condition signalled on release */
+    uint8_t cnt;           /*!< Number of available tokens, `0` or `1` */
+};
+
+/**
+ * \brief           Single message queue entry
+ */
+struct lwcell_sys_posix_mbox_cell {
+    atomic_size_t seq; /*!< Sequence number, tells if cell is ready for write or read at queue position */
+    void* entry;       /*!< Message pointer */
+};
+
+/**
+ * \brief           Lock-free message queue implementation
+ *
+ * Bounded multi-producer multi-consumer queue, where every cell keeps its own sequence number.
+ * Writers and readers claim position with compare-and-swap, without mutex.
+ * Semaphores are used only to put thread to sleep on empty or full queue
+ * and are released only when other side has waiting threads.
+ */
+struct lwcell_sys_posix_mbox {
+    atomic_size_t in;           /*!< Next position to write */
+    atomic_size_t out;          /*!< Next position to read */
+    atomic_uint get_waiters;    /*!< Number of threads, waiting for entry */
+    atomic_uint put_waiters;    /*!< Number of threads, waiting for free cell */
+    lwcell_sys_sem_t not_empty; /*!< Released when entry is written and reader waits */
+    lwcell_sys_sem_t not_full;  /*!< Released when entry is read and writer waits */
+    size_t mask;                /*!< Number of cells minus `1`, number of cells is power of `2` */
+    struct lwcell_sys_posix_mbox_cell cells[1];
+};
+static struct timespec sys_start_time;
+static pthread_mutex_t sys_mutex; /* Recursive mutex for main protection */
+static lwcell_sys_mutex_t sys_mutex_ptr;
+
+/**
+ * \brief           Initialize condition variable on monotonic clock
+ * \param[in]       cond: Condition variable to initialize
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+cond_init(pthread_cond_t* cond) {
+    pthread_condattr_t attr;
+    uint8_t ret;
+
+    if (pthread_condattr_init(&attr) != 0) {
+        return 0;
+    }
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    ret = pthread_cond_init(cond, &attr) == 0;
+    pthread_condattr_destroy(&attr);
+    return ret;
+}
+
+/**
+ * \brief           Get absolute monotonic time after timeout
+ * \param[out]      ts: Output absolute time
+ * \param[in]       timeout: Timeout in units of milliseconds
+ */
+static void
+deadline_get(struct timespec* ts, uint32_t timeout) {
+    clock_gettime(CLOCK_MONOTONIC, ts);
+    ts->tv_sec += timeout / 1000;
+    ts->tv_nsec += (long)(timeout % 1000) * 1000000L;
+    if (ts->tv_nsec >= 1000000000L) {
+        ++ts->tv_sec;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+/**
+ * \brief           Wait for condition variable
+ * \param[in]       cond: Condition variable
+ * \param[in]       mutex: Locked mutex
+ * \param[in]       ts: Absolute deadline or `NULL` to wait forever
+ * \return          `1` when signalled, `0` on timeout
+ */
+static uint8_t
+cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex, const struct timespec* ts) {
+    if (ts == NULL) {
+        pthread_cond_wait(cond, mutex);
+        return 1;
+    }
+    return pthread_cond_timedwait(cond, mutex, ts) != ETIMEDOUT;
+}
+
+uint8_t
+lwcell_sys_init(void) {
+    pthread_mutexattr_t attr;
+
+    clock_gettime(CLOCK_MONOTONIC, &sys_start_time);
+
+    /* Core lock is taken recursively */
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&sys_mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+    sys_mutex_ptr = &sys_mutex;
+    return 1;
+}
+
+uint32_t
+lwcell_sys_now(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((now.tv_sec - sys_start_time.tv_sec) * 1000
+                      + (now.tv_nsec - sys_start_time.tv_nsec) / 1000000L);
+}
+
+uint8_t
+lwcell_sys_protect(void) {
+    lwcell_sys_mutex_lock(&sys_mutex_ptr);
+    return 1;
+}
+
+uint8_t
+lwcell_sys_unprotect(void) {
+    lwcell_sys_mutex_unlock(&sys_mutex_ptr);
+    return 1;
+}
+
+uint8_t
+lwcell_sys_mutex_create(lwcell_sys_mutex_t* p) {
+    pthread_mutexattr_t attr;
+
+    if ((*p = malloc(sizeof(**p))) == NULL) {
+        return 0;
+    }
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    if (pthread_mutex_init(*p, &attr) != 0) {
+        free(*p);
+        *p = LWCELL_SYS_MUTEX_NULL;
+    }
+    pthread_mutexattr_destroy(&attr);
+    return *p != LWCELL_SYS_MUTEX_NULL;
+}
+
+uint8_t
+lwcell_sys_mutex_delete(lwcell_sys_mutex_t* p) {
+    pthread_mutex_destroy(*p);
+    free(*p);
+    return 1;
+}
+
+uint8_t
+lwcell_sys_mutex_lock(lwcell_sys_mutex_t* p) {
+    return pthread_mutex_lock(*p) == 0;
+}
+
+uint8_t
+lwcell_sys_mutex_unlock(lwcell_sys_mutex_t* p) {
+    return pthread_mutex_unlock(*p) == 0;
+}
+
+uint8_t
+lwcell_sys_mutex_isvalid(lwcell_sys_mutex_t* p) {
+    return p != NULL && *p != LWCELL_SYS_MUTEX_NULL;
+}
+
+uint8_t
+lwcell_sys_mutex_invalid(lwcell_sys_mutex_t* p) {
+    *p = LWCELL_SYS_MUTEX_NULL;
+    return 1;
+}
+
+uint8_t
+lwcell_sys_sem_create(lwcell_sys_sem_t* p, uint8_t cnt) {
+    struct lwcell_sys_posix_sem* sem;
+
+    *p = LWCELL_SYS_SEM_NULL;
+    if ((sem = malloc(sizeof(*sem))) == NULL) {
+        return 0;
+    }
+    if (pthread_mutex_init(&sem->mutex, NULL) != 0) {
+        free(sem);
+        return 0;
+    }
+    if (!cond_init(&sem->cond)) {
+        pthread_mutex_destroy(&sem->mutex);
+        free(sem);
+        return 0;
+    }
+    sem->cnt = !!cnt;
+    *p = sem;
+    return 1;
+}
+
+uint8_t
+lwcell_sys_sem_delete(lwcell_sys_sem_t* p) {
+    pthread_cond_destroy(&(*p)->cond);
+    pthread_mutex_destroy(&(*p)->mutex);
+    free(*p);
+    return 1;
+}
+
+uint32_t
+lwcell_sys_sem_wait(lwcell_sys_sem_t* p, uint32_t timeout) {
+    struct lwcell_sys_posix_sem* sem = *p;
+    struct timespec ts;
+    uint32_t time = lwcell_sys_now();
+
+    if (timeout > 0) {
+        deadline_get(&ts, timeout);
+    }
+    pthread_mutex_lock(&sem->mutex);
+    while (sem->cnt == 0) {
+        if (!cond_wait(&sem->cond, &sem->mutex, timeout > 0 ? &ts : NULL) && sem->cnt == 0) {
+            pthread_mutex_unlock(&sem->mutex);
+            return LWCELL_SYS_TIMEOUT;
+        }
+    }
+    sem->cnt = 0;
+    pthread_mutex_unlock(&sem->mutex);
+    return lwcell_sys_now() - time;
+}
+
+uint8_t
+lwcell_sys_sem_release(lwcell_sys_sem_t* p) {
+    struct lwcell_sys_posix_sem* sem = *p;
+
+    pthread_mutex_lock(&sem->mutex);
+    sem->cnt = 1;
+    pthread_cond_signal(&sem->cond);
+    pthread_mutex_unlock(&sem->mutex);
+    return 1;
+}
+
+uint8_t
+lwcell_sys_sem_isvalid(lwcell_sys_sem_t* p) {
+    return p != NULL && *p != LWCELL_SYS_SEM_NULL;
+}
+
+uint8_t
+lwcell_sys_sem_invalid(lwcell_sys_sem_t* p) {
+    *p = LWCELL_SYS_SEM_NULL;
+    return 1;
+}
+
+/**
+ * \brief           Try to write entry to message queue, without waiting
+ * \param[in]       mbox: Message queue
+ * \param[in]       m: Message to write
+ * \return          `1` on success, `0` if queue is full
+ */
+static uint8_t
+mbox_try_put(struct lwcell_sys_posix_mbox* mbox, void* m) {
+    struct lwcell_sys_posix_mbox_cell* cell;
+    size_t pos = atomic_load_explicit(&mbox->in, memory_order_relaxed);
+    ptrdiff_t diff;
+
+    for (;;) {
+        cell = &mbox->cells[pos & mbox->mask];
+        diff = (ptrdiff_t)(atomic_load(&cell->seq) - pos);
+        if (diff == 0) { /* Cell is free, try to claim position */
+            if (atomic_compare_exchange_weak_explicit(&mbox->in, &pos, pos + 1, memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) { /* Cell still holds entry from previous round */
+            return 0;
+        } else { /* Other writer claimed position */
+            pos = atomic_load_explicit(&mbox->in, memory_order_relaxed);
+        }
+    }
+    cell->entry = m;
+    atomic_store(&cell->seq, pos + 1);
+    return 1;
+}
+
+/**
+ * \brief           Try to read entry from message queue, without waiting
+ * \param[in]       mbox: Message queue
+ * \param[out]      m: Output message
+ * \return          `1` on success, `0` if queue is empty
+ */
+static uint8_t
+mbox_try_get(struct lwcell_sys_posix_mbox* mbox, void** m) {
+    struct lwcell_sys_posix_mbox_cell* cell;
+    size_t pos = atomic_load_explicit(&mbox->out, memory_order_relaxed);
+    ptrdiff_t diff;
+
+    for (;;) {
+        cell = &mbox->cells[pos & mbox->mask];
+        diff = (ptrdiff_t)(atomic_load(&cell->seq) - (pos + 1));
+        if (diff == 0) { /* Cell holds entry, try to claim position */
+            if (atomic_compare_exchange_weak_explicit(&mbox->out, &pos, pos + 1, memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) { /* Cell not written yet */
+            return 0;
+        } else { /* Other reader claimed position */
+            pos = atomic_load_explicit(&mbox->out, memory_order_relaxed);
+        }
+    }
+    *m = cell->entry;
+    atomic_store(&cell->seq, pos + mbox->mask + 1);
+    return 1;
+}
+
+/**
+ * \brief           Wake thread, waiting on message queue semaphore
+ *
+ * Semaphore is touched only when any thread waits. Waiter increments its counter before
+ * it checks queue again. Cell sequence and waiter counter accesses are sequentially consistent,
+ * either waiter sees queue change or this function sees the waiter.
+ * \param[in]       waiters: Number of waiting threads
+ * \param[in]       sem: Semaphore to release
+ */
+static void
+mbox_wake(atomic_uint* waiters, lwcell_sys_sem_t* sem) {
+    if (atomic_load(waiters) > 0) {
+        lwcell_sys_sem_release(sem);
+    }
+}
+
+uint8_t
+lwcell_sys_mbox_create(lwcell_sys_mbox_t* b, size_t size) {
+    struct lwcell_sys_posix_mbox* mbox;
+    size_t cnt = 2;
+
+    *b = LWCELL_SYS_MBOX_NULL;
+    if (size == 0) {
+        return 0;
+    }
+    /* Positions are masked, number of cells is power of 2, with at least 2 cells */
+    for (; cnt < size; cnt <<= 1) {}
+    if ((mbox = malloc(sizeof(*mbox) + (cnt - 1) * sizeof(mbox->cells[0]))) == NULL) {
+        return 0;
+    }
+    memset(mbox, 0x00, sizeof(*mbox));
+    mbox->mask = cnt - 1;
+    for (size_t i = 0; i < cnt; ++i) {
+        atomic_init(&mbox->cells[i].seq, i);
+    }
+    if (!lwcell_sys_sem_create(&mbox->not_empty, 0)) {
+        free(mbox);
+        return 0;
+    }
+    if (!lwcell_sys_sem_create(&mbox->not_full, 0)) {
+        lwcell_sys_sem_delete(&mbox->not_empty);
+        free(mbox);
+        return 0;
+    }
+    *b = mbox;
+    return 1;
+}
+
+uint8_t
+lwcell_sys_mbox_delete(lwcell_sys_mbox_t* b) {
+    struct lwcell_sys_posix_mbox* mbox = *b;
+
+    lwcell_sys_sem_delete(&mbox->not_full);
+    lwcell_sys_sem_delete(&mbox->not_empty);
+    free(mbox);
+    return 1;
+}
+
+uint32_t
+lwcell_sys_mbox_put(lwcell_sys_mbox_t* b, void* m) {
+    struct lwcell_sys_posix_mbox* mbox = *b;
+    uint32_t time = lwcell_sys_now();
+
+    if (!mbox_try_put(mbox, m)) {
+        atomic_fetch_add(&mbox->put_waiters, 1);
+        while (!mbox_try_put(mbox, m)) {
+            lwcell_sys_sem_wait(&mbox->not_full, 0);
+        }
+        atomic_fetch_sub(&mbox->put_waiters, 1);
+        mbox_wake(&mbox->put_waiters, &mbox->not_full); /* Release may be coalesced, pass it to next writer */
+    }
+    mbox_wake(&mbox->get_waiters, &mbox->not_empty);
+    return lwcell_sys_now() - time;
+}
+
+uint32_t
+lwcell_sys_mbox_get(lwcell_sys_mbox_t* b, void** m, uint32_t timeout) {
+    struct lwcell_sys_posix_mbox* mbox = *b;
+    uint32_t time = lwcell_sys_now(), elapsed;
+
+    if (!mbox_try_get(mbox, m)) {
+        atomic_fetch_add(&mbox->get_waiters, 1);
+        while (!mbox_try_get(mbox, m)) {
+            elapsed = lwcell_sys_now() - time;
+            if (timeout > 0 && elapsed >= timeout) {
+                atomic_fetch_sub(&mbox->get_waiters, 1);
+                return LWCELL_SYS_TIMEOUT;
+            }
+            lwcell_sys_sem_wait(&mbox->not_empty, timeout > 0 ? timeout - elapsed : 0);
+        }
+        atomic_fetch_sub(&mbox->get_waiters, 1);
+        mbox_wake(&mbox->get_waiters, &mbox->not_empty); /* Release may be coalesced, pass it to next reader */
+    }
+    mbox_wake(&mbox->put_waiters, &mbox->not_full);
+    return lwcell_sys_now() - time;
+}
+
+uint8_t
+lwcell_sys_mbox_putnow(lwcell_sys_mbox_t* b, void* m) {
+    struct lwcell_sys_posix_mbox* mbox = *b;
+
+    if (mbox_try_put(mbox, m)) {
+        mbox_wake(&mbox->get_waiters, &mbox->not_empty);
+        return 1;
+    }
+    return 0;
+}
+
+#if LWCELL_CFG_INPUT_FROM_ISR
+
+uint8_t
+lwcell_sys_mbox_putnow_from_isr(lwcell_sys_mbox_t* b, void* m) {
+    return lwcell_sys_mbox_putnow(b, m); /* No interrupts, driver thread acts as one */
+}
+
+#endif /* LWCELL_CFG_INPUT_FROM_ISR */
+
+uint8_t
+lwcell_sys_mbox_getnow(lwcell_sys_mbox_t* b, void** m) {
+    struct lwcell_sys_posix_mbox* mbox = *b;
+
+    if (mbox_try_get(mbox, m)) {
+        mbox_wake(&mbox->put_waiters, &mbox->not_full);
+        return 1;
+    }
+    return 0;
+}
+
+uint8_t
+lwcell_sys_mbox_isvalid(lwcell_sys_mbox_t* b) {
+    return b != NULL && *b != LWCELL_SYS_MBOX_NULL;
+}
+
+uint8_t
+lwcell_sys_mbox_invalid(lwcell_sys_mbox_t* b) {
+    *b = LWCELL_SYS_MBOX_NULL;
+    return 1;
+}
+
+#if LWCELL_CFG_THREAD_PROCESS_NOTIFY
+
+/*
+ * Binary semaphore already coalesces multiple releases to single token,
+ * notification is implemented on top of it
+ */
+
+uint8_t
+lwcell_sys_notify_create(lwcell_sys_notify_t* n) {
+    return lwcell_sys_sem_create(n, 0);
+}
+
+uint8_t
+lwcell_sys_notify_delete(lwcell_sys_notify_t* n) {
+    return lwcell_sys_sem_delete(n);
+}
+
+uint8_t
+lwcell_sys_notify_post(lwcell_sys_notify_t* n) {
+    return lwcell_sys_sem_release(n);
+}
+
+uint32_t
+lwcell_sys_notify_wait(lwcell_sys_notify_t* n, uint32_t timeout) {
+    return lwcell_sys_sem_wait(n, timeout);
+}
+
+uint8_t
+lwcell_sys_notify_isvalid(lwcell_sys_notify_t* n) {
+    return lwcell_sys_sem_isvalid(n);
+}
+
+uint8_t
+lwcell_sys_notify_invalid(lwcell_sys_notify_t* n) {
+    return lwcell_sys_sem_invalid(n);
+}
+
+#if LWCELL_CFG_INPUT_FROM_ISR
+
+uint8_t
+lwcell_sys_notify_post_from_isr(lwcell_sys_notify_t* n) {
+    return lwcell_sys_notify_post(n); /* No interrupts, driver thread acts as one */
+}
+
+#endif /* LWCELL_CFG_INPUT_FROM_ISR */
+
+#endif /* LWCELL_CFG_THREAD_PROCESS_NOTIFY */
+
+/**
+ * \brief           Thread start parameters
+ */
+typedef struct {
+    lwcell_sys_thread_fn fn; /*!< Thread function */
+    void* arg;               /*!< Thread function argument */
+} posix_thread_start_t;
+
+/**
+ * \brief           Common thread entry, converts pthread prototype to library prototype
+ * \param[in]       param: Pointer to \ref posix_thread_start_t structure
+ * \return          `NULL`
+ */
+static void*
+thread_entry(void* param) {
+    posix_thread_start_t start = *(posix_thread_start_t*)param;
+
+    free(param);
+    start.fn(start.arg);
+    return NULL;
+}
+
+uint8_t
+lwcell_sys_thread_create(lwcell_sys_thread_t* t, const char* name, lwcell_sys_thread_fn thread_func, void* const arg,
+                         size_t stack_size, lwcell_sys_thread_prio_t prio) {
+    posix_thread_start_t* start;
+    pthread_attr_t attr;
+    pthread_t thread;
+    int ret;
+
+    LWCELL_UNUSED(name);
+    LWCELL_UNUSED(prio);
+
+    if ((start = malloc(sizeof(*start))) == NULL) {
+        return 0;
+    }
+    start->fn = thread_func;
+    start->arg = arg;
+
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    if (stack_size > 0) {
+        pthread_attr_setstacksize(&attr,
+                                  stack_size < (size_t)PTHREAD_STACK_MIN ? (size_t)PTHREAD_STACK_MIN : stack_size);
+    }
+    ret = pthread_create(&thread, &attr, thread_entry, start);
+    pthread_attr_destroy(&attr);
+    if (ret != 0) {
+        free(start);
+        return 0;
+    }
+    if (t != NULL) {
+        *t = thread;
+    }
+    return 1;
+}
+
+uint8_t
+lwcell_sys_thread_terminate(lwcell_sys_thread_t* t) {
+    if (t == NULL) { /* Shall we terminate ourself? */
+        pthread_exit(NULL);
+    } else {
+        pthread_cancel(*t);
+    }
+    return 1;
+}
+
+uint8_t
+lwcell_sys_thread_yield(void) {
+    sched_yield();
+    return 1;
+}
+
+#if LWCELL_CFG_THREAD_AFFINITY
+
+uint8_t
+lwcell_sys_thread_create_pinned(lwcell_sys_thread_t* t, const char* name, lwcell_sys_thread_fn thread_func,
+                                void* const arg, size_t stack_size, lwcell_sys_thread_prio_t prio, int core) {
+    lwcell_sys_thread_t thread;
+
+    if (!lwcell_sys_thread_create(&thread, name, thread_func, arg, stack_size, prio)) {
+        return 0;
+    }
+#if defined(__linux__)
+    {
+        cpu_set_t set;
+
+        CPU_ZERO(&set);
+        CPU_SET(core, &set);
+        pthread_setaffinity_np(thread, sizeof(set), &set);
+    }
+#else
+    LWCELL_UNUSED(core); /* Affinity is not part of POSIX API */
+#endif /* defined(__linux__) */
+    if (t != NULL) {
+        *t = thread;
+    }
+    return 1;
+}
+
+#endif /* LWCELL_CFG_THREAD_AFFINITY */
+
+#if LWCELL_CFG_THREAD_PROCESS_IPD_BOOST
+
+uint8_t
+lwcell_sys_thread_set_prio(lwcell_sys_thread_t* t, lwcell_sys_thread_prio_t prio) {
+    return pthread_setschedprio(*t, prio) == 0;
+}
+
+#endif /* LWCELL_CFG_THREAD_PROCESS_IPD_BOOST */
+
+#if LWCELL_CFG_STATS_THREADS
+
+uint8_t
+lwcell_sys_thread_get_info(lwcell_sys_thread_t* t, lwcell_sys_thread_info_t* info) {
+    struct timespec cpu, now;
+    clockid_t cid;
+
+    /* Stack usage is not tracked, run time is reported in units of microseconds */
+    if (pthread_getcpuclockid(*t, &cid) != 0 || clock_gettime(cid, &cpu) != 0) {
+        return 0;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    info->run_time = (uint64_t)cpu.tv_sec * 1000000ULL + (uint64_t)cpu.tv_nsec / 1000U;
+    info->run_time_total = (uint64_t)(now.tv_sec - sys_start_time.tv_sec) * 1000000ULL
+                           + (uint64_t)((now.tv_nsec - sys_start_time.tv_nsec) / 1000L);
+    info->run_time_valid = 1;
+    return 1;
+}
+
+#endif /* LWCELL_CFG_STATS_THREADS */
+
+#endif /* !__DOXYGEN__ */
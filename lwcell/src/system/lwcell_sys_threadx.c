@@ -32,8 +32,12 @@
  * Version:         v0.1.1
  */
 #include "lwcell/lwcell_mem.h"
+#include "lwcell/lwcell_utils.h"
 #include "system/lwcell_sys.h"
 #include "tx_api.h"
+#if LWCELL_CFG_STATS_THREADS && defined(TX_EXECUTION_PROFILE_ENABLE)
+#include "tx_execution_profile.h"
+#endif /* LWCELL_CFG_STATS_THREADS && defined(TX_EXECUTION_PROFILE_ENABLE) */
 
 /* Custom memory ThreadX implementation must be done to use this feature */
 #if LWCELL_CFG_THREADX_IDLE_THREAD_EXTENSION && !LWCELL_CFG_MEM_CUSTOM
@@ -45,6 +49,11 @@
 /* Main LwCELL byte pool handle */
 TX_BYTE_POOL* lwcell_threadx_byte_pool;
 
+#if LWCELL_CFG_THREADX_MEM_BLOCK_POOLS
+/* Block pools are defined in the lwcell_mem_threadx.c file */
+extern UINT lwcell_mem_threadx_block_pools_init(void);
+#endif /* LWCELL_CFG_THREADX_MEM_BLOCK_POOLS */
+
 /* If user will not provide its own byte pool from app, create one here */
 #if !LWCELL_CFG_THREADX_CUSTOM_MEM_BYTE_POOL
 
@@ -75,6 +84,81 @@ lwcell_sys_preinit_threadx_set_bytepool_handle(TX_BYTE_POOL* bp) {
 /* Module private variables */
 static TX_MUTEX sys_mutex;
 
+#if LWCELL_CFG_SYS_STATIC_ALLOC
+
+/* Number of stack entries of thread slot */
+#define STATIC_THREAD_STACK_LEN ((LWCELL_CFG_SYS_STATIC_THREAD_SS + sizeof(ULONG) - 1) / sizeof(ULONG))
+
+/* Preallocated thread, used instead of byte pool allocation */
+typedef struct {
+    TX_THREAD thread;                     /*!< Control block, used when caller does not provide one */
+    ULONG stack[STATIC_THREAD_STACK_LEN]; /*!< Thread stack */
+} threadx_thread_slot_t;
+
+static void* mbox_slots[LWCELL_CFG_SYS_STATIC_MBOX_CNT][LWCELL_CFG_SYS_STATIC_MBOX_SIZE];
+static uint8_t mbox_slots_used[LWCELL_CFG_SYS_STATIC_MBOX_CNT];
+static threadx_thread_slot_t thread_slots[LWCELL_CFG_SYS_STATIC_THREAD_CNT];
+static uint8_t thread_slots_used[LWCELL_CFG_SYS_STATIC_THREAD_CNT];
+
+/**
+ * \brief           Reserve first free slot
+ * \param[in]       used: Array of slot usage flags
+ * \param[in]       cnt: Number of slots
+ * \return          Slot index on success, `-1` when all slots are used
+ */
+static int
+prv_slot_take(uint8_t* used, size_t cnt) {
+    int idx = -1;
+
+    lwcell_sys_protect();
+    for (size_t i = 0; i < cnt; ++i) {
+        if (!used[i]) {
+            used[i] = 1;
+            idx = (int)i;
+            break;
+        }
+    }
+    lwcell_sys_unprotect();
+    return idx;
+}
+
+/**
+ * \brief           Release slot of preallocated memory
+ * \param[in]       ptr: Memory to release
+ * \param[in]       base: Pointer to first slot
+ * \param[in]       used: Array of slot usage flags
+ * \param[in]       cnt: Number of slots
+ * \param[in]       stride: Size of one slot in units of bytes
+ * \return          `1` if memory belongs to slots and was released, `0` otherwise
+ */
+static uint8_t
+prv_slot_release(const void* ptr, const void* base, uint8_t* used, size_t cnt, size_t stride) {
+    const uint8_t* p = ptr;
+    const uint8_t* b = base;
+
+    if (p < b || p >= b + cnt * stride) {
+        return 0;
+    }
+    used[(size_t)(p - b) / stride] = 0;
+    return 1;
+}
+
+#endif /* LWCELL_CFG_SYS_STATIC_ALLOC */
+
+/**
+ * \brief           Free message queue storage, allocated by \ref lwcell_sys_mbox_create
+ * \param[in]       mem: Queue storage
+ */
+static void
+prv_mbox_mem_free(void* mem) {
+#if LWCELL_CFG_SYS_STATIC_ALLOC
+    if (prv_slot_release(mem, mbox_slots, mbox_slots_used, LWCELL_ARRAYSIZE(mbox_slots), sizeof(mbox_slots[0]))) {
+        return;
+    }
+#endif /* LWCELL_CFG_SYS_STATIC_ALLOC */
+    lwcell_mem_free(mem);
+}
+
 /* Macros to convert from milliseconds to ticks and opposite */
 #define TICKS_TO_MS(ticks) ((ticks) * (1000 / TX_TIMER_TICKS_PER_SECOND))
 #define MS_TO_TICKS(ms)    ((ms)*TX_TIMER_TICKS_PER_SECOND / 1000)
@@ -92,6 +176,11 @@ lwcell_sys_init(void) {
 #else  /* LWCELL_CFG_THREADX_CUSTOM_MEM_BYTE_POOL */
     lwcell_sys_mutex_create(&sys_mutex);
 #endif /* !LWCELL_CFG_THREADX_CUSTOM_MEM_BYTE_POOL */
+#if LWCELL_CFG_THREADX_MEM_BLOCK_POOLS
+    if (status == TX_SUCCESS) {
+        status = lwcell_mem_threadx_block_pools_init();
+    }
+#endif /* LWCELL_CFG_THREADX_MEM_BLOCK_POOLS */
     return status == TX_SUCCESS ? 1 : 0;
 }
 
@@ -110,6 +199,21 @@ lwcell_sys_unprotect(void) {
     return lwcell_sys_mutex_unlock(&sys_mutex);
 }
 
+#if LWCELL_CFG_PBUF_REF_ATOMIC && !LWCELL_PBUF_REF_STDATOMIC
+
+size_t
+lwcell_sys_atomic_add(size_t* var, int delta) {
+    size_t val;
+    TX_INTERRUPT_SAVE_AREA
+
+    TX_DISABLE
+    val = (*var += (size_t)delta);
+    TX_RESTORE
+    return val;
+}
+
+#endif /* LWCELL_CFG_PBUF_REF_ATOMIC && !LWCELL_PBUF_REF_STDATOMIC */
+
 uint8_t
 lwcell_sys_mutex_create(lwcell_sys_mutex_t* p) {
     return tx_mutex_create(p, TX_NULL, TX_INHERIT) == TX_SUCCESS ? 1 : 0;
@@ -179,12 +283,24 @@ uint8_t
 lwcell_sys_mbox_create(lwcell_sys_mbox_t* b, size_t size) {
     uint8_t rt = 0;
     ULONG queue_total_size = size * sizeof(void*);
-    void* queue_mem = lwcell_mem_malloc(queue_total_size);
+    void* queue_mem = NULL;
+
+#if LWCELL_CFG_SYS_STATIC_ALLOC
+    if (size <= LWCELL_CFG_SYS_STATIC_MBOX_SIZE) {
+        int idx = prv_slot_take(mbox_slots_used, LWCELL_ARRAYSIZE(mbox_slots_used));
+        if (idx >= 0) {
+            queue_mem = mbox_slots[idx];
+        }
+    }
+#endif /* LWCELL_CFG_SYS_STATIC_ALLOC */
+    if (queue_mem == NULL) {
+        queue_mem = lwcell_mem_malloc(queue_total_size);
+    }
     if (queue_mem != NULL) {
         if (tx_queue_create(b, TX_NULL, sizeof(void*) / sizeof(ULONG), queue_mem, queue_total_size) == TX_SUCCESS) {
             rt = 1;
         } else {
-            lwcell_mem_free(queue_mem);
+            prv_mbox_mem_free(queue_mem);
         }
     }
     return rt;
@@ -193,7 +309,7 @@ lwcell_sys_mbox_create(lwcell_sys_mbox_t* b, size_t size) {
 uint8_t
 lwcell_sys_mbox_delete(lwcell_sys_mbox_t* b) {
     (VOID) tx_queue_delete(b);
-    lwcell_mem_free(b->tx_queue_start);
+    prv_mbox_mem_free(b->tx_queue_start);
     return 1;
 }
 
@@ -217,6 +333,15 @@ lwcell_sys_mbox_putnow(lwcell_sys_mbox_t* b, void* m) {
     return tx_queue_send(b, &m, TX_NO_WAIT) == TX_SUCCESS ? 1 : 0;
 }
 
+#if LWCELL_CFG_INPUT_FROM_ISR
+
+uint8_t
+lwcell_sys_mbox_putnow_from_isr(lwcell_sys_mbox_t* b, void* m) {
+    return lwcell_sys_mbox_putnow(b, m); /* Send without wait is allowed in interrupt */
+}
+
+#endif /* LWCELL_CFG_INPUT_FROM_ISR */
+
 uint8_t
 lwcell_sys_mbox_getnow(lwcell_sys_mbox_t* b, void** m) {
     return tx_queue_receive(b, m, TX_NO_WAIT) == TX_SUCCESS ? 1 : 0;
@@ -233,17 +358,82 @@ lwcell_sys_mbox_invalid(lwcell_sys_mbox_t* b) {
     return 1;
 }
 
+#if LWCELL_CFG_THREAD_PROCESS_NOTIFY
+
+uint8_t
+lwcell_sys_notify_create(lwcell_sys_notify_t* n) {
+    return tx_event_flags_create(n, "lwcell_notify") == TX_SUCCESS ? 1 : 0;
+}
+
+uint8_t
+lwcell_sys_notify_delete(lwcell_sys_notify_t* n) {
+    return tx_event_flags_delete(n) == TX_SUCCESS ? 1 : 0;
+}
+
+uint8_t
+lwcell_sys_notify_post(lwcell_sys_notify_t* n) {
+    return tx_event_flags_set(n, 0x01, TX_OR) == TX_SUCCESS ? 1 : 0;
+}
+
+uint32_t
+lwcell_sys_notify_wait(lwcell_sys_notify_t* n, uint32_t timeout) {
+    ULONG start = tx_time_get(), flags;
+    return tx_event_flags_get(n, 0x01, TX_OR_CLEAR, &flags, !timeout ? TX_WAIT_FOREVER : MS_TO_TICKS(timeout))
+                   == TX_SUCCESS
+               ? TICKS_TO_MS(tx_time_get() - start)
+               : LWCELL_SYS_TIMEOUT;
+}
+
+uint8_t
+lwcell_sys_notify_isvalid(lwcell_sys_notify_t* n) {
+    return n->tx_event_flags_group_id != TX_CLEAR_ID ? 1 : 0;
+}
+
+uint8_t
+lwcell_sys_notify_invalid(lwcell_sys_notify_t* n) {
+    /* No need actions since all invalid are following delete, and delete make sure it is invalid */
+    return 1;
+}
+
+#if LWCELL_CFG_INPUT_FROM_ISR
+
+uint8_t
+lwcell_sys_notify_post_from_isr(lwcell_sys_notify_t* n) {
+    return lwcell_sys_notify_post(n); /* Event flags may be set from interrupt */
+}
+
+#endif /* LWCELL_CFG_INPUT_FROM_ISR */
+
+#endif /* LWCELL_CFG_THREAD_PROCESS_NOTIFY */
+
 #if LWCELL_CFG_THREADX_IDLE_THREAD_EXTENSION
 
 uint8_t
 lwcell_sys_thread_create(lwcell_sys_thread_t* t, const char* name, lwcell_sys_thread_fn thread_func, void* const arg,
                         size_t stack_size, lwcell_sys_thread_prio_t prio) {
     void* stack_ptr = NULL;
-    lwcell_sys_thread_t* t_handle;
-    uint8_t t_handle_dynamic = 0;
+    lwcell_sys_thread_t* t_handle = NULL;
+    uint8_t t_handle_dynamic = 0, stack_dynamic = 0;
+
+#if LWCELL_CFG_SYS_STATIC_ALLOC
+    /*
+     * Take handle and stack from preallocated slot.
+     * Slot is not released, since idle thread only cleans up dynamic memory
+     */
+    if (stack_size <= LWCELL_CFG_SYS_STATIC_THREAD_SS) {
+        int idx = prv_slot_take(thread_slots_used, LWCELL_ARRAYSIZE(thread_slots_used));
+        if (idx >= 0) {
+            t_handle = t != NULL ? t : &thread_slots[idx].thread;
+            stack_ptr = thread_slots[idx].stack;
+            stack_size = sizeof(thread_slots[idx].stack);
+        }
+    }
+#endif /* LWCELL_CFG_SYS_STATIC_ALLOC */
 
     /* First process thread object */
-    if (t != NULL) {
+    if (t_handle != NULL) {
+        /* Handle is already set from slot */
+    } else if (t != NULL) {
         t_handle = t; /* Use static handle from parameter */
     } else if (tx_byte_allocate(lwcell_threadx_byte_pool, (void*)&t_handle, sizeof(*t_handle), TX_NO_WAIT)
                == TX_SUCCESS) {
@@ -253,8 +443,11 @@ lwcell_sys_thread_create(lwcell_sys_thread_t* t, const char* name, lwcell_sys_th
     }
 
     /* Allocate memory for stack */
-    if (tx_byte_allocate(lwcell_threadx_byte_pool, &stack_ptr, stack_size, TX_NO_WAIT) != TX_SUCCESS) {
-        goto cleanup;
+    if (stack_ptr == NULL) {
+        if (tx_byte_allocate(lwcell_threadx_byte_pool, &stack_ptr, stack_size, TX_NO_WAIT) != TX_SUCCESS) {
+            goto cleanup;
+        }
+        stack_dynamic = 1;
     }
 
     /* Allocate thread stack */
@@ -282,16 +475,22 @@ lwcell_sys_thread_create(lwcell_sys_thread_t* t, const char* name, lwcell_sys_th
      * And later for sure create idle thread in charge of ThreadX cleanup process
      */
     t_handle->tx_thread_user_is_handle_alloc_dynamic = t_handle_dynamic;
-    t_handle->tx_thread_user_is_stack_alloc_dynamic = 1;
+    t_handle->tx_thread_user_is_stack_alloc_dynamic = stack_dynamic;
     return 1;
 
 cleanup:
     if (t_handle_dynamic && t_handle != NULL) {
         tx_byte_release(t_handle);
     }
-    if (stack_ptr != NULL) {
+    if (stack_dynamic && stack_ptr != NULL) {
         tx_byte_release(stack_ptr);
     }
+#if LWCELL_CFG_SYS_STATIC_ALLOC
+    if (!stack_dynamic && stack_ptr != NULL) {
+        prv_slot_release(stack_ptr, thread_slots, thread_slots_used, LWCELL_ARRAYSIZE(thread_slots),
+                         sizeof(thread_slots[0]));
+    }
+#endif /* LWCELL_CFG_SYS_STATIC_ALLOC */
     return 0;
 }
 
@@ -311,21 +510,48 @@ lwcell_sys_thread_terminate(lwcell_sys_thread_t* t) {
 
 #else /* LWCELL_CFG_THREADX_IDLE_THREAD_EXTENSION */
 
+/**
+ * \brief           Free thread stack, allocated by \ref lwcell_sys_thread_create
+ * \param[in]       mem: Thread stack
+ */
+static void
+prv_stack_mem_free(void* mem) {
+#if LWCELL_CFG_SYS_STATIC_ALLOC
+    if (prv_slot_release(mem, thread_slots, thread_slots_used, LWCELL_ARRAYSIZE(thread_slots),
+                         sizeof(thread_slots[0]))) {
+        return;
+    }
+#endif /* LWCELL_CFG_SYS_STATIC_ALLOC */
+    lwcell_mem_free(mem);
+}
+
 uint8_t
 lwcell_sys_thread_create(lwcell_sys_thread_t* t, const char* name, lwcell_sys_thread_fn thread_func, void* const arg,
                         size_t stack_size, lwcell_sys_thread_prio_t prio) {
 
     typedef VOID (*threadx_entry_t)(ULONG);
     uint8_t rt = 0;
-
-    void* stack_mem = lwcell_mem_malloc(stack_size);
+    void* stack_mem = NULL;
+
+#if LWCELL_CFG_SYS_STATIC_ALLOC
+    if (stack_size <= LWCELL_CFG_SYS_STATIC_THREAD_SS) {
+        int idx = prv_slot_take(thread_slots_used, LWCELL_ARRAYSIZE(thread_slots_used));
+        if (idx >= 0) {
+            stack_mem = thread_slots[idx].stack;
+            stack_size = sizeof(thread_slots[idx].stack);
+        }
+    }
+#endif /* LWCELL_CFG_SYS_STATIC_ALLOC */
+    if (stack_mem == NULL) {
+        stack_mem = lwcell_mem_malloc(stack_size);
+    }
     if (stack_mem != NULL) {
         if (tx_thread_create(t, (CHAR*)name, (VOID(*)(ULONG))(thread_func), (ULONG)arg, stack_mem, stack_size, prio,
                              prio, TX_NO_TIME_SLICE, TX_AUTO_START)
             == TX_SUCCESS) {
             rt = 1;
         } else {
-            lwcell_mem_free(stack_mem);
+            prv_stack_mem_free(stack_mem);
         }
     }
     return rt;
@@ -342,7 +568,7 @@ lwcell_sys_thread_terminate(lwcell_sys_thread_t* t) {
     if ((t != NULL) && (t != tx_thread_identify())) {
         if (tx_thread_terminate(t) == TX_SUCCESS) {
             if (tx_thread_delete(t) == TX_SUCCESS) {
-                lwcell_mem_free(t->tx_thread_stack_start);
+                prv_stack_mem_free(t->tx_thread_stack_start);
                 rt = 1;
             }
         }
@@ -358,4 +584,64 @@ lwcell_sys_thread_yield(void) {
     return 0;
 }
 
+#if LWCELL_CFG_THREAD_AFFINITY
+
+uint8_t
+lwcell_sys_thread_create_pinned(lwcell_sys_thread_t* t, const char* name, lwcell_sys_thread_fn thread_func,
+                                void* const arg, size_t stack_size, lwcell_sys_thread_prio_t prio, int core) {
+    if (!lwcell_sys_thread_create(t, name, thread_func, arg, stack_size, prio)) {
+        return 0;
+    }
+#ifdef TX_THREAD_SMP_MAX_CORES
+    /* Exclude all cores but selected one */
+    if (t != NULL) {
+        tx_thread_smp_core_exclude(t, ~((ULONG)1 << core));
+    }
+#else
+    LWCELL_UNUSED(core); /* Single core, no affinity */
+#endif /* TX_THREAD_SMP_MAX_CORES */
+    return 1;
+}
+
+#endif /* LWCELL_CFG_THREAD_AFFINITY */
+
+#if LWCELL_CFG_THREAD_PROCESS_IPD_BOOST
+
+uint8_t
+lwcell_sys_thread_set_prio(lwcell_sys_thread_t* t, lwcell_sys_thread_prio_t prio) {
+    UINT old;
+
+    return tx_thread_priority_change(t, prio, &old) == TX_SUCCESS;
+}
+
+#endif /* LWCELL_CFG_THREAD_PROCESS_IPD_BOOST */
+
+#if LWCELL_CFG_STATS_THREADS
+
+uint8_t
+lwcell_sys_thread_get_info(lwcell_sys_thread_t* t, lwcell_sys_thread_info_t* info) {
+    info->stack_size = (size_t)t->tx_thread_stack_size;
+#ifdef TX_ENABLE_STACK_CHECKING
+    /* Stack grows down, highest pointer is the lowest address ever used */
+    info->stack_unused = (size_t)((UCHAR*)t->tx_thread_stack_highest_ptr - (UCHAR*)t->tx_thread_stack_start);
+    info->stack_valid = 1;
+#endif /* TX_ENABLE_STACK_CHECKING */
+#ifdef TX_EXECUTION_PROFILE_ENABLE
+    {
+        EXECUTION_TIME thread, threads, isr, idle;
+
+        if (_tx_execution_thread_time_get(t, &thread) == TX_SUCCESS
+            && _tx_execution_thread_total_time_get(&threads) == TX_SUCCESS
+            && _tx_execution_isr_time_get(&isr) == TX_SUCCESS && _tx_execution_idle_time_get(&idle) == TX_SUCCESS) {
+            info->run_time = (uint64_t)thread;
+            info->run_time_total = (uint64_t)threads + (uint64_t)isr + (uint64_t)idle;
+            info->run_time_valid = 1;
+        }
+    }
+#endif /* TX_EXECUTION_PROFILE_ENABLE */
+    return 1;
+}
+
+#endif /* LWCELL_CFG_STATS_THREADS */
+
 #endif /* !__DOXYGEN__ */
@@ -39,33 +39,121 @@
 #if !__DOXYGEN__
 
 /**
- * \brief           Custom message queue implementation for WIN32
+ * \brief           Single message queue entry
  */
 typedef struct {
-    lwcell_sys_sem_t sem_not_empty; /*!< Semaphore indicates not empty */
-    lwcell_sys_sem_t sem_not_full;  /*!< Semaphore indicates not full */
-    lwcell_sys_sem_t sem;           /*!< Semaphore to lock access */
-    size_t in, out, size;
-    void* entries[1];
+    volatile LONG seq; /*!< Sequence number, tells if cell is ready for write or read at queue position */
+    void* entry;       /*!< Message pointer */
+} win32_mbox_cell_t;
+
+/**
+ * \brief           Lock-free message queue implementation for WIN32
+ *
+ * Bounded multi-producer multi-consumer queue, where every cell keeps its own sequence number.
+ * Writers and readers claim position with interlocked compare-and-swap, without kernel objects.
+ * Auto-reset events are used only to put thread to sleep on empty or full queue
+ * and are set only when other side has waiting threads.
+ */
+typedef struct {
+    volatile LONG in;          /*!< Next position to write */
+    volatile LONG out;         /*!< Next position to read */
+    volatile LONG get_waiters; /*!< Number of threads, waiting for entry */
+    volatile LONG put_waiters; /*!< Number of threads, waiting for free cell */
+    HANDLE not_empty;          /*!< Set when entry is written and reader waits */
+    HANDLE not_full;           /*!< Set when entry is read and writer waits */
+    LONG mask;                 /*!< Number of cells minus `1`, number of cells is power of `2` */
+    win32_mbox_cell_t cells[1];
 } win32_mbox_t;
 
 static LARGE_INTEGER freq, sys_start_time;
 static lwcell_sys_mutex_t sys_mutex; /* Mutex ID for main protection */
 
+/**
+ * \brief           Read shared variable with full barrier
+ * \param[in]       p: Variable to read
+ * \return          Variable value
+ */
+static LONG
+mbox_load(volatile LONG* p) {
+    return InterlockedOr(p, 0);
+}
+
+/**
+ * \brief           Try to write entry to message queue, without waiting
+ * \param[in]       mbox: Message queue
+ * \param[in]       m: Message to write
+ * \return          `1` on success, `0` if queue is full
+ */
 static uint8_t
-mbox_is_full(win32_mbox_t* m) {
-    size_t size = 0;
-    if (m->in > m->out) {
-        size = (m->in - m->out);
-    } else if (m->out > m->in) {
-        size = m->size - m->out + m->in;
+mbox_try_put(win32_mbox_t* mbox, void* m) {
+    win32_mbox_cell_t* cell;
+    LONG pos = mbox->in, diff; /* Position is only a hint, it is validated with compare-and-swap */
+
+    for (;;) {
+        cell = &mbox->cells[pos & mbox->mask];
+        diff = (LONG)((ULONG)mbox_load(&cell->seq) - (ULONG)pos);
+        if (diff == 0) { /* Cell is free, try to claim position */
+            LONG prev = InterlockedCompareExchange(&mbox->in, (LONG)((ULONG)pos + 1), pos);
+            if (prev == pos) {
+                break;
+            }
+            pos = prev;
+        } else if (diff < 0) { /* Cell still holds entry from previous round */
+            return 0;
+        } else { /* Other writer claimed position */
+            pos = mbox->in;
+        }
     }
-    return size == m->size - 1;
+    cell->entry = m;
+    InterlockedExchange(&cell->seq, (LONG)((ULONG)pos + 1));
+    return 1;
 }
 
+/**
+ * \brief           Try to read entry from message queue, without waiting
+ * \param[in]       mbox: Message queue
+ * \param[out]      m: Output message
+ * \return          `1` on success, `0` if queue is empty
+ */
 static uint8_t
-mbox_is_empty(win32_mbox_t* m) {
-    return m->in == m->out;
+mbox_try_get(win32_mbox_t* mbox, void** m) {
+    win32_mbox_cell_t* cell;
+    LONG pos = mbox->out, diff; /* Position is only a hint, it is validated with compare-and-swap */
+
+    for (;;) {
+        cell = &mbox->cells[pos & mbox->mask];
+        diff = (LONG)((ULONG)mbox_load(&cell->seq) - ((ULONG)pos + 1));
+        if (diff == 0) { /* Cell holds entry, try to claim position */
+            LONG prev = InterlockedCompareExchange(&mbox->out, (LONG)((ULONG)pos + 1), pos);
+            if (prev == pos) {
+                break;
+            }
+            pos = prev;
+        } else if (diff < 0) { /* Cell not written yet */
+            return 0;
+        } else { /* Other reader claimed position */
+            pos = mbox->out;
+        }
+    }
+    *m = cell->entry;
+    InterlockedExchange(&cell->seq, (LONG)((ULONG)pos + (ULONG)mbox->mask + 1));
+    return 1;
+}
+
+/**
+ * \brief           Wake thread, waiting on message queue event
+ *
+ * Event is touched only when any thread waits. Waiter increments its counter before
+ * it checks queue again, interlocked operations on both sides guarantee
+ * either waiter sees queue change or this function sees the waiter.
+ * \param[in]       waiters: Number of waiting threads
+ * \param[in]       ev: Event to set
+ */
+static void
+mbox_wake(volatile LONG* waiters, HANDLE ev) {
+    if (mbox_load(waiters) > 0) {
+        SetEvent(ev);
+    }
 }
 
 static uint32_t
@@ -105,6 +193,15 @@ lwcell_sys_unprotect(void) {
     return 1;
 }
 
+#if LWCELL_CFG_PBUF_REF_ATOMIC && !LWCELL_PBUF_REF_STDATOMIC
+
+size_t
+lwcell_sys_atomic_add(size_t* var, int delta) {
+    return (size_t)InterlockedExchangeAddSizeT(var, (SIZE_T)(SSIZE_T)delta) + (size_t)delta;
+}
+
+#endif /* LWCELL_CFG_PBUF_REF_ATOMIC && !LWCELL_PBUF_REF_STDATOMIC */
+
 uint8_t
 lwcell_sys_mutex_create(lwcell_sys_mutex_t* p) {
     *p = CreateMutex(NULL, FALSE, NULL);
@@ -191,27 +288,43 @@ lwcell_sys_sem_invalid(lwcell_sys_sem_t* p) {
 uint8_t
 lwcell_sys_mbox_create(lwcell_sys_mbox_t* b, size_t size) {
     win32_mbox_t* mbox;
+    size_t cnt = 2;
 
-    *b = NULL;
-
-    mbox = malloc(sizeof(*mbox) + size * sizeof(void*));
-    if (mbox != NULL) {
-        memset(mbox, 0x00, sizeof(*mbox));
-        mbox->size = size + 1; /* Set it to 1 more as cyclic buffer has only one less than size */
-        lwcell_sys_sem_create(&mbox->sem, 1);
-        lwcell_sys_sem_create(&mbox->sem_not_empty, 0);
-        lwcell_sys_sem_create(&mbox->sem_not_full, 0);
-        *b = mbox;
+    *b = LWCELL_SYS_MBOX_NULL;
+    if (size == 0) {
+        return 0;
+    }
+    /* Positions are masked, number of cells is power of 2, with at least 2 cells */
+    for (; cnt < size; cnt <<= 1) {}
+    if ((mbox = malloc(sizeof(*mbox) + (cnt - 1) * sizeof(mbox->cells[0]))) == NULL) {
+        return 0;
+    }
+    memset(mbox, 0x00, sizeof(*mbox));
+    mbox->mask = (LONG)(cnt - 1);
+    for (size_t i = 0; i < cnt; ++i) {
+        mbox->cells[i].seq = (LONG)i;
+    }
+    mbox->not_empty = CreateEvent(NULL, FALSE, FALSE, NULL);
+    mbox->not_full = CreateEvent(NULL, FALSE, FALSE, NULL);
+    if (mbox->not_empty == NULL || mbox->not_full == NULL) {
+        if (mbox->not_empty != NULL) {
+            CloseHandle(mbox->not_empty);
+        }
+        if (mbox->not_full != NULL) {
+            CloseHandle(mbox->not_full);
+        }
+        free(mbox);
+        return 0;
     }
-    return *b != NULL;
+    *b = mbox;
+    return 1;
 }
 
 uint8_t
 lwcell_sys_mbox_delete(lwcell_sys_mbox_t* b) {
     win32_mbox_t* mbox = *b;
-    lwcell_sys_sem_delete(&mbox->sem);
-    lwcell_sys_sem_delete(&mbox->sem_not_full);
-    lwcell_sys_sem_delete(&mbox->sem_not_empty);
+    CloseHandle(mbox->not_empty);
+    CloseHandle(mbox->not_full);
     free(mbox);
     return 1;
 }
@@ -219,54 +332,39 @@ lwcell_sys_mbox_delete(lwcell_sys_mbox_t* b) {
 uint32_t
 lwcell_sys_mbox_put(lwcell_sys_mbox_t* b, void* m) {
     win32_mbox_t* mbox = *b;
-    uint32_t time = osKernelSysTick(); /* Get start time */
-
-    lwcell_sys_sem_wait(&mbox->sem, 0); /* Wait for access */
-
-    /*
-     * Since function is blocking until ready to write something to queue,
-     * wait and release the semaphores to allow other threads
-     * to process the queue before we can write new value.
-     */
-    while (mbox_is_full(mbox)) {
-        lwcell_sys_sem_release(&mbox->sem);          /* Release semaphore */
-        lwcell_sys_sem_wait(&mbox->sem_not_full, 0); /* Wait for semaphore indicating not full */
-        lwcell_sys_sem_wait(&mbox->sem, 0);          /* Wait availability again */
-    }
-    mbox->entries[mbox->in] = m;
-    if (++mbox->in >= mbox->size) {
-        mbox->in = 0;
+    uint32_t time = osKernelSysTick();
+
+    if (!mbox_try_put(mbox, m)) {
+        InterlockedIncrement(&mbox->put_waiters);
+        while (!mbox_try_put(mbox, m)) {
+            WaitForSingleObject(mbox->not_full, INFINITE);
+        }
+        InterlockedDecrement(&mbox->put_waiters);
+        mbox_wake(&mbox->put_waiters, mbox->not_full); /* Set may be coalesced, pass it to next writer */
     }
-    lwcell_sys_sem_release(&mbox->sem_not_empty); /* Signal non-empty state */
-    lwcell_sys_sem_release(&mbox->sem);           /* Release access for other threads */
+    mbox_wake(&mbox->get_waiters, mbox->not_empty);
     return osKernelSysTick() - time;
 }
 
 uint32_t
 lwcell_sys_mbox_get(lwcell_sys_mbox_t* b, void** m, uint32_t timeout) {
     win32_mbox_t* mbox = *b;
-    uint32_t time;
-
-    time = osKernelSysTick();
-
-    /* Get exclusive access to message queue */
-    if (lwcell_sys_sem_wait(&mbox->sem, timeout) == LWCELL_SYS_TIMEOUT) {
-        return LWCELL_SYS_TIMEOUT;
-    }
-    while (mbox_is_empty(mbox)) {
-        lwcell_sys_sem_release(&mbox->sem);
-        if (lwcell_sys_sem_wait(&mbox->sem_not_empty, timeout) == LWCELL_SYS_TIMEOUT) {
-            return LWCELL_SYS_TIMEOUT;
+    uint32_t time = osKernelSysTick(), elapsed;
+
+    if (!mbox_try_get(mbox, m)) {
+        InterlockedIncrement(&mbox->get_waiters);
+        while (!mbox_try_get(mbox, m)) {
+            elapsed = osKernelSysTick() - time;
+            if (timeout > 0 && elapsed >= timeout) {
+                InterlockedDecrement(&mbox->get_waiters);
+                return LWCELL_SYS_TIMEOUT;
+            }
+            WaitForSingleObject(mbox->not_empty, timeout > 0 ? timeout - elapsed : INFINITE);
         }
-        lwcell_sys_sem_wait(&mbox->sem, timeout);
+        InterlockedDecrement(&mbox->get_waiters);
+        mbox_wake(&mbox->get_waiters, mbox->not_empty); /* Set may be coalesced, pass it to next reader */
     }
-    *m = mbox->entries[mbox->out];
-    if (++mbox->out >= mbox->size) {
-        mbox->out = 0;
-    }
-    lwcell_sys_sem_release(&mbox->sem_not_full);
-    lwcell_sys_sem_release(&mbox->sem);
-
+    mbox_wake(&mbox->put_waiters, mbox->not_full);
     return osKernelSysTick() - time;
 }
 
@@ -274,39 +372,31 @@ uint8_t
 lwcell_sys_mbox_putnow(lwcell_sys_mbox_t* b, void* m) {
     win32_mbox_t* mbox = *b;
 
-    lwcell_sys_sem_wait(&mbox->sem, 0);
-    if (mbox_is_full(mbox)) {
-        lwcell_sys_sem_release(&mbox->sem);
-        return 0;
-    }
-    mbox->entries[mbox->in] = m;
-    if (mbox->in == mbox->out) {
-        lwcell_sys_sem_release(&mbox->sem_not_empty);
-    }
-    if (++mbox->in >= mbox->size) {
-        mbox->in = 0;
+    if (mbox_try_put(mbox, m)) {
+        mbox_wake(&mbox->get_waiters, mbox->not_empty);
+        return 1;
     }
-    lwcell_sys_sem_release(&mbox->sem);
-    return 1;
+    return 0;
 }
 
+#if LWCELL_CFG_INPUT_FROM_ISR
+
+uint8_t
+lwcell_sys_mbox_putnow_from_isr(lwcell_sys_mbox_t* b, void* m) {
+    return lwcell_sys_mbox_putnow(b, m); /* No interrupts, driver thread acts as one */
+}
+
+#endif /* LWCELL_CFG_INPUT_FROM_ISR */
+
 uint8_t
 lwcell_sys_mbox_getnow(lwcell_sys_mbox_t* b, void** m) {
     win32_mbox_t* mbox = *b;
 
-    lwcell_sys_sem_wait(&mbox->sem, 0); /* Wait exclusive access */
-    if (mbox->in == mbox->out) {
-        lwcell_sys_sem_release(&mbox->sem); /* Release access */
-        return 0;
-    }
-
-    *m = mbox->entries[mbox->out];
-    if (++mbox->out >= mbox->size) {
-        mbox->out = 0;
+    if (mbox_try_get(mbox, m)) {
+        mbox_wake(&mbox->put_waiters, mbox->not_full);
+        return 1;
     }
-    lwcell_sys_sem_release(&mbox->sem_not_full); /* Queue not full anymore */
-    lwcell_sys_sem_release(&mbox->sem);          /* Release semaphore */
-    return 1;
+    return 0;
 }
 
 uint8_t
@@ -320,6 +410,56 @@ lwcell_sys_mbox_invalid(lwcell_sys_mbox_t* b) {
     return 1;
 }
 
+#if LWCELL_CFG_THREAD_PROCESS_NOTIFY
+
+uint8_t
+lwcell_sys_notify_create(lwcell_sys_notify_t* n) {
+    *n = CreateEvent(NULL, FALSE, FALSE, NULL); /* Auto-reset event, released waiter clears it */
+    return *n != NULL;
+}
+
+uint8_t
+lwcell_sys_notify_delete(lwcell_sys_notify_t* n) {
+    return CloseHandle(*n);
+}
+
+uint8_t
+lwcell_sys_notify_post(lwcell_sys_notify_t* n) {
+    return SetEvent(*n);
+}
+
+uint32_t
+lwcell_sys_notify_wait(lwcell_sys_notify_t* n, uint32_t timeout) {
+    uint32_t time = osKernelSysTick();
+
+    if (WaitForSingleObject(*n, timeout == 0 ? INFINITE : timeout) == WAIT_OBJECT_0) {
+        return osKernelSysTick() - time;
+    }
+    return LWCELL_SYS_TIMEOUT;
+}
+
+uint8_t
+lwcell_sys_notify_isvalid(lwcell_sys_notify_t* n) {
+    return n != NULL && *n != NULL;
+}
+
+uint8_t
+lwcell_sys_notify_invalid(lwcell_sys_notify_t* n) {
+    *n = LWCELL_SYS_NOTIFY_NULL;
+    return 1;
+}
+
+#if LWCELL_CFG_INPUT_FROM_ISR
+
+uint8_t
+lwcell_sys_notify_post_from_isr(lwcell_sys_notify_t* n) {
+    return lwcell_sys_notify_post(n); /* No interrupts, driver thread acts as one */
+}
+
+#endif /* LWCELL_CFG_INPUT_FROM_ISR */
+
+#endif /* LWCELL_CFG_THREAD_PROCESS_NOTIFY */
+
 uint8_t
 lwcell_sys_thread_create(lwcell_sys_thread_t* t, const char* name, lwcell_sys_thread_fn thread_func, void* const arg,
                         size_t stack_size, lwcell_sys_thread_prio_t prio) {
@@ -354,4 +494,61 @@ lwcell_sys_thread_yield(void) {
     return 1;
 }
 
+#if LWCELL_CFG_THREAD_AFFINITY
+
+uint8_t
+lwcell_sys_thread_create_pinned(lwcell_sys_thread_t* t, const char* name, lwcell_sys_thread_fn thread_func,
+                                void* const arg, size_t stack_size, lwcell_sys_thread_prio_t prio, int core) {
+    HANDLE h;
+    DWORD id;
+
+    LWCELL_UNUSED(name);
+    LWCELL_UNUSED(stack_size);
+    LWCELL_UNUSED(prio);
+
+    /* Set affinity before thread starts */
+    h = CreateThread(0, 0, (LPTHREAD_START_ROUTINE)thread_func, arg, CREATE_SUSPENDED, &id);
+    if (h == NULL) {
+        return 0;
+    }
+    SetThreadAffinityMask(h, (DWORD_PTR)1 << core);
+    ResumeThread(h);
+    if (t != NULL) {
+        *t = h;
+    }
+    return 1;
+}
+
+#endif /* LWCELL_CFG_THREAD_AFFINITY */
+
+#if LWCELL_CFG_THREAD_PROCESS_IPD_BOOST
+
+uint8_t
+lwcell_sys_thread_set_prio(lwcell_sys_thread_t* t, lwcell_sys_thread_prio_t prio) {
+    return SetThreadPriority(*t, prio) ? 1 : 0;
+}
+
+#endif /* LWCELL_CFG_THREAD_PROCESS_IPD_BOOST */
+
+#if LWCELL_CFG_STATS_THREADS
+
+uint8_t
+lwcell_sys_thread_get_info(lwcell_sys_thread_t* t, lwcell_sys_thread_info_t* info) {
+    FILETIME creation, exit, kernel, user;
+    LARGE_INTEGER now;
+
+    /* Stack usage is not tracked, run time is reported in units of 100 ns */
+    if (!GetThreadTimes(*t, &creation, &exit, &kernel, &user)) {
+        return 0;
+    }
+    QueryPerformanceCounter(&now);
+    info->run_time = (((uint64_t)kernel.dwHighDateTime << 32) | kernel.dwLowDateTime)
+                     + (((uint64_t)user.dwHighDateTime << 32) | user.dwLowDateTime);
+    info->run_time_total = (uint64_t)(now.QuadPart - sys_start_time.QuadPart) * 10000000ULL / (uint64_t)freq.QuadPart;
+    info->run_time_valid = 1;
+    return 1;
+}
+
+#endif /* LWCELL_CFG_STATS_THREADS */
+
 #endif /* !__DOXYGEN__ */
@@ -0,0 +1,333 @@
+/*
+ * Throughput and latency benchmark with GSM device.
+ *
+ * Once device is connected to network, it runs following tests one after another:
+ *
+ *  - TCP upload to discard server (port 9), measured in bytes per second
+ *  - TCP download from chargen server (port 19), measured in bytes per second
+ *  - TCP round-trip time of small packets against echo server (port 7)
+ *  - MQTT QoS0 and QoS1 publish rate, with per-message latency
+ *  - MQTT round-trip time, publishing to topic client is subscribed to
+ *
+ * Results are printed with printf to debug output. Latencies are reported
+ * with minimum, percentiles and maximum, to compare modems and firmware versions.
+ *
+ * Use your own server with standard echo, discard and chargen TCP services enabled
+ * (for example inetd or xinetd on Linux) and set BENCHMARK_HOST accordingly.
+ */
+
+#include "benchmark.h"
+#include "lwcell/lwcell.h"
+#include "lwcell/lwcell_network_api.h"
+
+#if LWCELL_CFG_NETCONN
+#include "lwcell/apps/lwcell_mqtt_client_api.h"
+
+/**
+ * \brief           Server with TCP echo, discard and chargen services
+ */
+#define BENCHMARK_HOST         "example.com"
+#define BENCHMARK_ECHO_PORT    7
+#define BENCHMARK_DISCARD_PORT 9
+#define BENCHMARK_CHARGEN_PORT 19
+
+/**
+ * \brief           MQTT broker and topic used for publish tests
+ */
+#define BENCHMARK_MQTT_HOST  "test.mosquitto.org"
+#define BENCHMARK_MQTT_PORT  1883
+#define BENCHMARK_MQTT_TOPIC "lwcell/benchmark"
+
+/**
+ * \brief           Duration of single throughput test in units of milliseconds
+ */
+#define BENCHMARK_DURATION 10000
+
+/**
+ * \brief           Number of probes for latency tests
+ */
+#define BENCHMARK_PROBES 32
+
+/**
+ * \brief           Size of single probe for TCP round-trip test and MQTT publish payload
+ */
+#define BENCHMARK_PROBE_SIZE 32
+
+/**
+ * \brief           Size of single write for TCP upload test
+ */
+#define BENCHMARK_CHUNK_SIZE 1024
+
+/**
+ * \brief           Connection information for MQTT CONNECT packet
+ */
+static const lwcell_mqtt_client_info_t mqtt_client_info = {
+    .id = "lwcell_benchmark",
+    .keep_alive = 60,
+};
+
+static uint8_t chunk[BENCHMARK_CHUNK_SIZE];
+static uint32_t samples[BENCHMARK_PROBES];
+
+/**
+ * \brief           Print throughput result
+ * \param[in]       name: Test name
+ * \param[in]       count: Number of transferred bytes or messages
+ * \param[in]       unit: Unit of count, printed per second
+ * \param[in]       time: Test duration in units of milliseconds
+ */
+static void
+print_rate(const char* name, uint32_t count, const char* unit, uint32_t time) {
+    if (time == 0) {
+        time = 1;
+    }
+    printf("[BENCH] %s: %u %s in %u ms, %u %s/s\r\n", name, (unsigned)count, unit, (unsigned)time,
+           (unsigned)((uint64_t)count * 1000 / time), unit);
+}
+
+/**
+ * \brief           Sort latency samples and print percentiles
+ * \param[in]       name: Test name
+ * \param[in]       cnt: Number of valid samples
+ */
+static void
+print_latency(const char* name, size_t cnt) {
+    uint32_t tmp;
+
+    if (cnt == 0) {
+        printf("[BENCH] %s: no samples\r\n", name);
+        return;
+    }
+
+    /* Insertion sort, number of samples is small */
+    for (size_t i = 1; i < cnt; ++i) {
+        tmp = samples[i];
+        size_t j = i;
+        for (; j > 0 && samples[j - 1] > tmp; --j) {
+            samples[j] = samples[j - 1];
+        }
+        samples[j] = tmp;
+    }
+    printf("[BENCH] %s: %u samples, min %u, p50 %u, p90 %u, p99 %u, max %u ms\r\n", name, (unsigned)cnt,
+           (unsigned)samples[0], (unsigned)samples[(cnt - 1) * 50 / 100], (unsigned)samples[(cnt - 1) * 90 / 100],
+           (unsigned)samples[(cnt - 1) * 99 / 100], (unsigned)samples[cnt - 1]);
+}
+
+/**
+ * \brief           Create new TCP netconn and connect to benchmark server
+ * \param[in]       port: Server port to connect to
+ * \return          Connected netconn handle on success, `NULL` otherwise
+ */
+static lwcell_netconn_p
+tcp_connect(lwcell_port_t port) {
+    lwcell_netconn_p nc;
+
+    if ((nc = lwcell_netconn_new(LWCELL_NETCONN_TYPE_TCP)) != NULL) {
+        if (lwcell_netconn_connect(nc, BENCHMARK_HOST, port) == lwcellOK) {
+            return nc;
+        }
+        printf("[BENCH] Cannot connect to %s:%d\r\n", BENCHMARK_HOST, (int)port);
+        lwcell_netconn_delete(nc);
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Close and delete netconn
+ * \param[in]       nc: Netconn handle
+ */
+static void
+tcp_close(lwcell_netconn_p nc) {
+    if (lwcell_netconn_is_connected(nc)) {
+        lwcell_netconn_close(nc);
+    }
+    lwcell_netconn_delete(nc);
+}
+
+/**
+ * \brief           Upload data to discard server for fixed time
+ */
+static void
+bench_tcp_upload(void) {
+    lwcell_netconn_p nc;
+    uint32_t start, bytes = 0;
+
+    if ((nc = tcp_connect(BENCHMARK_DISCARD_PORT)) == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < sizeof(chunk); ++i) {
+        chunk[i] = (uint8_t)('A' + i % 26);
+    }
+    start = lwcell_sys_now();
+    while (lwcell_sys_now() - start < BENCHMARK_DURATION) {
+        if (lwcell_netconn_write(nc, chunk, sizeof(chunk)) != lwcellOK) {
+            break;
+        }
+        bytes += sizeof(chunk);
+    }
+    if (lwcell_netconn_flush(nc) != lwcellOK) {
+        printf("[BENCH] TCP upload flush failed\r\n");
+    }
+    print_rate("TCP upload", bytes, "B", lwcell_sys_now() - start);
+    tcp_close(nc);
+}
+
+/**
+ * \brief           Download data from chargen server for fixed time
+ */
+static void
+bench_tcp_download(void) {
+    lwcell_netconn_p nc;
+    lwcell_pbuf_p pbuf;
+    lwcellr_t res;
+    uint32_t start, bytes = 0;
+
+    if ((nc = tcp_connect(BENCHMARK_CHARGEN_PORT)) == NULL) {
+        return;
+    }
+    lwcell_netconn_set_receive_timeout(nc, 1000);
+    start = lwcell_sys_now();
+    while (lwcell_sys_now() - start < BENCHMARK_DURATION) {
+        res = lwcell_netconn_receive(nc, &pbuf);
+        if (res == lwcellOK) {
+            bytes += (uint32_t)lwcell_pbuf_length(pbuf, 1);
+            lwcell_pbuf_free_s(&pbuf);
+        } else if (res != lwcellTIMEOUT) {
+            break;
+        }
+    }
+    print_rate("TCP download", bytes, "B", lwcell_sys_now() - start);
+    tcp_close(nc);
+}
+
+/**
+ * \brief           Measure round-trip time of small packets against echo server
+ */
+static void
+bench_tcp_rtt(void) {
+    lwcell_netconn_p nc;
+    uint32_t start;
+    size_t cnt = 0;
+
+    if ((nc = tcp_connect(BENCHMARK_ECHO_PORT)) == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < BENCHMARK_PROBES; ++i) {
+        start = lwcell_sys_now();
+        if (lwcell_netconn_write(nc, chunk, BENCHMARK_PROBE_SIZE) != lwcellOK || lwcell_netconn_flush(nc) != lwcellOK
+            || lwcell_netconn_read(nc, chunk, BENCHMARK_PROBE_SIZE, NULL, 5000) != lwcellOK) {
+            break;
+        }
+        samples[cnt++] = lwcell_sys_now() - start;
+    }
+    print_latency("TCP RTT", cnt);
+    tcp_close(nc);
+}
+
+/**
+ * \brief           Publish messages for fixed time and report rate and latency
+ * \param[in]       client: Connected MQTT API client
+ * \param[in]       qos: Quality of service for publish
+ * \param[in]       name: Test name
+ */
+static void
+bench_mqtt_publish(lwcell_mqtt_client_api_p client, lwcell_mqtt_qos_t qos, const char* name) {
+    uint32_t start, t, msgs = 0;
+    size_t cnt = 0;
+
+    start = lwcell_sys_now();
+    while ((t = lwcell_sys_now()) - start < BENCHMARK_DURATION) {
+        if (lwcell_mqtt_client_api_publish(client, BENCHMARK_MQTT_TOPIC "/rate", chunk, BENCHMARK_PROBE_SIZE, qos, 0)
+            != lwcellOK) {
+            break;
+        }
+        ++msgs;
+        if (cnt < BENCHMARK_PROBES) {
+            samples[cnt++] = lwcell_sys_now() - t;
+        }
+    }
+    print_rate(name, msgs, "msg", lwcell_sys_now() - start);
+    print_latency(name, cnt);
+}
+
+/**
+ * \brief           Measure round-trip time of messages published to subscribed topic
+ * \param[in]       client: Connected MQTT API client
+ */
+static void
+bench_mqtt_rtt(lwcell_mqtt_client_api_p client) {
+    lwcell_mqtt_client_api_buf_p buf;
+    uint32_t start;
+    size_t cnt = 0;
+
+    if (lwcell_mqtt_client_api_subscribe(client, BENCHMARK_MQTT_TOPIC "/rtt", LWCELL_MQTT_QOS_AT_MOST_ONCE)
+        != lwcellOK) {
+        printf("[BENCH] Cannot subscribe to MQTT topic\r\n");
+        return;
+    }
+    for (size_t i = 0; i < BENCHMARK_PROBES; ++i) {
+        start = lwcell_sys_now();
+        if (lwcell_mqtt_client_api_publish(client, BENCHMARK_MQTT_TOPIC "/rtt", chunk, BENCHMARK_PROBE_SIZE,
+                                           LWCELL_MQTT_QOS_AT_MOST_ONCE, 0)
+                != lwcellOK
+            || lwcell_mqtt_client_api_receive(client, &buf, 5000) != lwcellOK) {
+            break;
+        }
+        samples[cnt++] = lwcell_sys_now() - start;
+        lwcell_mqtt_client_api_buf_free(buf);
+    }
+    print_latency("MQTT RTT", cnt);
+}
+
+/**
+ * \brief           Run MQTT benchmarks
+ */
+static void
+bench_mqtt(void) {
+    lwcell_mqtt_client_api_p client;
+    lwcell_mqtt_conn_status_t conn_status;
+
+    if ((client = lwcell_mqtt_client_api_new(256, 256)) == NULL) {
+        return;
+    }
+    conn_status = lwcell_mqtt_client_api_connect(client, BENCHMARK_MQTT_HOST, BENCHMARK_MQTT_PORT, &mqtt_client_info);
+    if (conn_status == LWCELL_MQTT_CONN_STATUS_ACCEPTED) {
+        bench_mqtt_publish(client, LWCELL_MQTT_QOS_AT_MOST_ONCE, "MQTT QoS0 publish");
+        bench_mqtt_publish(client, LWCELL_MQTT_QOS_AT_LEAST_ONCE, "MQTT QoS1 publish");
+        bench_mqtt_rtt(client);
+        lwcell_mqtt_client_api_close(client);
+    } else {
+        printf("[BENCH] MQTT connect response: %d\r\n", (int)conn_status);
+    }
+    lwcell_mqtt_client_api_delete(client);
+}
+
+/**
+ * \brief           Benchmark thread implementation
+ * \param[in]       arg: User argument, semaphore released when benchmark finishes, or `NULL`
+ */
+void
+benchmark_thread(void const* arg) {
+    lwcell_sys_sem_t* sem = (void*)arg;
+
+    /* Request attach to network */
+    while (lwcell_network_request_attach() != lwcellOK) {
+        lwcell_delay(1000);
+    }
+
+    printf("[BENCH] Benchmark started\r\n");
+    bench_tcp_upload();
+    bench_tcp_download();
+    bench_tcp_rtt();
+    bench_mqtt();
+    printf("[BENCH] Benchmark finished\r\n");
+
+    lwcell_network_request_detach(); /* Detach from network */
+
+    if (sem != NULL && lwcell_sys_sem_isvalid(sem)) {
+        lwcell_sys_sem_release(sem);
+    }
+    lwcell_sys_thread_terminate(NULL); /* Terminate current thread */
+}
+
+#endif /* LWCELL_CFG_NETCONN */
@@ -0,0 +1,14 @@
+#ifndef SNIPPET_HDR_PPP_LWIP_H
+#define SNIPPET_HDR_PPP_LWIP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+void ppp_lwip_thread(void const* arg);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* SNIPPET_HDR_PPP_LWIP_H */
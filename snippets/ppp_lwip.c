@@ -0,0 +1,102 @@
+/*
+ * PPP data mode as lwIP network interface.
+ *
+ * Snippet requires lwIP with PPP_SUPPORT, PPPOS_SUPPORT and PPP_IPV4_SUPPORT enabled
+ * and running tcpip thread. Once link is up, lwIP sockets and netconn API run over cellular connection.
+ */
+#include "ppp_lwip.h"
+#include "lwcell/lwcell.h"
+#include "lwcell/lwcell_network_api.h"
+
+#if LWCELL_CFG_PPP
+#include "lwip/pppapi.h"
+#include "lwip/tcpip.h"
+#include "netif/ppp/pppos.h"
+
+static struct netif cell_netif;
+static ppp_pcb* ppp;
+static lwcell_sys_sem_t link_sem;
+
+/**
+ * \brief           lwIP PPP output callback, called from tcpip thread
+ * \param[in]       pcb: PPP control block
+ * \param[in]       data: Data to send to device
+ * \param[in]       len: Length of data
+ * \param[in]       ctx: User context
+ * \return          Number of bytes written
+ */
+static u32_t
+prv_ppp_output(ppp_pcb* pcb, const void* data, u32_t len, void* ctx) {
+    LWCELL_UNUSED(pcb);
+    LWCELL_UNUSED(ctx);
+    return (u32_t)lwcell_ppp_output(data, len);
+}
+
+/**
+ * \brief           lwIP PPP link status callback, called from tcpip thread
+ * \param[in]       pcb: PPP control block
+ * \param[in]       err_code: Link status
+ * \param[in]       ctx: User context
+ */
+static void
+prv_ppp_status(ppp_pcb* pcb, int err_code, void* ctx) {
+    LWCELL_UNUSED(ctx);
+    if (err_code == PPPERR_NONE) {
+        printf("PPP link up, IP: %s\r\n", ip4addr_ntoa(netif_ip4_addr(ppp_netif(pcb))));
+    } else {
+        printf("PPP link down, error: %d\r\n", err_code);
+    }
+    lwcell_sys_sem_release(&link_sem);
+}
+
+/**
+ * \brief           PPP data received from device, called from LwCELL processing thread
+ * \note            Data is copied to lwIP buffer and processed later in tcpip thread,
+ *                  lwIP API that waits for tcpip thread must not be called here
+ * \param[in]       data: Received data
+ * \param[in]       len: Length of data
+ * \param[in]       arg: User argument
+ */
+static void
+prv_ppp_input(const void* data, size_t len, void* arg) {
+    LWCELL_UNUSED(arg);
+    pppos_input_tcpip(ppp, (u8_t*)data, (int)len);
+}
+
+/**
+ * \brief           PPP thread, attaches to packet service and brings lwIP interface up
+ * \param[in]       arg: User argument
+ */
+void
+ppp_lwip_thread(void const* arg) {
+    LWCELL_UNUSED(arg);
+
+    /* Network must be attached to packet service with APN configured */
+    while (lwcell_network_request_attach() != lwcellOK) {
+        lwcell_delay(1000);
+    }
+    lwcell_sys_sem_create(&link_sem, 0);
+    if ((ppp = pppapi_pppos_create(&cell_netif, prv_ppp_output, prv_ppp_status, NULL)) == NULL) {
+        printf("Cannot create PPP control block\r\n");
+        return;
+    }
+    pppapi_set_default(ppp);
+
+    /* Enter data mode first, then start LCP negotiation */
+    if (lwcell_ppp_start(0, prv_ppp_input, NULL, NULL, NULL, 1) == lwcellOK) {
+        pppapi_connect(ppp, 0);
+        lwcell_sys_sem_wait(&link_sem, 0);
+
+        /* Use lwIP sockets here, then shut down the link */
+
+        pppapi_close(ppp, 0);
+        lwcell_sys_sem_wait(&link_sem, 0);
+        lwcell_ppp_stop(NULL, NULL, 1);
+    } else {
+        printf("Cannot enter PPP data mode\r\n");
+    }
+    pppapi_free(ppp);
+    lwcell_sys_sem_delete(&link_sem);
+}
+
+#endif /* LWCELL_CFG_PPP */